@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+// GC pause and allocation throughput benchmarks for the jsc shell:
+//
+//     jsc PerformanceTests/JSGC/gc-benchmark.js [-- scenario-name ...] [--json]
+//
+// For each scenario this reports the p50, p99 and maximum Eden and full collection pauses, how much
+// the heap grew, and how many objects were allocated per millisecond.
+
+"use strict";
+
+var scenarios = [];
+
+function addScenario(name, description, run)
+{
+    scenarios.push({ name: name, description: description, run: run });
+}
+
+var peakHeapSize = 0;
+
+// Scenarios call this now and then so that we can report the peak heap size without forcing a GC.
+function sampleHeapSize()
+{
+    var heapSize = gcHeapSize();
+    if (heapSize > peakHeapSize)
+        peakHeapSize = heapSize;
+}
+
+function makeTree(depth)
+{
+    if (!depth)
+        return { left: null, right: null, value: 0 };
+    return { left: makeTree(depth - 1), right: makeTree(depth - 1), value: depth };
+}
+
+addScenario("retained-tree", "Short-lived allocation while a large tree stays live, so full collections have a big live set to mark.", function() {
+    var allocations = 0;
+    var tree = makeTree(18);
+    allocations += (1 << 19) - 1;
+    for (var i = 0; i < 200; ++i) {
+        var temporaries = makeTree(10);
+        allocations += (1 << 11) - 1;
+        // Replace a subtree now and then so that old objects point at young ones.
+        if (!(i % 10)) {
+            tree.left.right = makeTree(12);
+            allocations += (1 << 13) - 1;
+        }
+        sampleHeapSize();
+    }
+    return allocations + (tree.value ? 0 : 1);
+});
+
+addScenario("churn", "High-churn temporaries: small objects, arrays and strings that die young.", function() {
+    var allocations = 0;
+    var sum = 0;
+    for (var i = 0; i < 2000000; ++i) {
+        var point = { x: i, y: i + 1 };
+        var pair = [point, point.x + point.y];
+        var label = "item" + i;
+        sum += pair[1] + label.length;
+        allocations += 3;
+        if (!(i % 10000))
+            sampleHeapSize();
+    }
+    return allocations + (sum ? 0 : 1);
+});
+
+addScenario("typed-arrays", "Typed arrays of mixed sizes, mostly short-lived, with a rolling set kept alive.", function() {
+    var allocations = 0;
+    var retained = new Array(256);
+    var sizes = [16, 256, 4096, 65536];
+    for (var i = 0; i < 200000; ++i) {
+        var size = sizes[i % sizes.length];
+        var array = (i & 1) ? new Float64Array(size >> 3) : new Uint8Array(size);
+        array[0] = i;
+        if (!(i % 64))
+            retained[(i >> 6) % retained.length] = array;
+        allocations++;
+        if (!(i % 1000))
+            sampleHeapSize();
+    }
+    return allocations;
+});
+
+addScenario("cache", "A bounded cache that keeps replacing entries, so objects survive a few collections before dying.", function() {
+    var allocations = 0;
+    var cache = new Map();
+    var cacheSize = 50000;
+    for (var i = 0; i < 1000000; ++i) {
+        cache.set(i % cacheSize, { key: i, payload: [i, i * 2, i * 3], name: "entry" + i });
+        allocations += 3;
+        if (!(i % 10000))
+            sampleHeapSize();
+    }
+    return allocations + cache.size - cacheSize;
+});
+
+function percentile(sortedValues, fraction)
+{
+    if (!sortedValues.length)
+        return 0;
+    var index = Math.min(sortedValues.length - 1, Math.ceil(fraction * sortedValues.length) - 1);
+    return sortedValues[Math.max(index, 0)];
+}
+
+function pauseSummary(pauses, type)
+{
+    var times = pauses.filter(function(pause) { return pause.type == type; }).map(function(pause) { return pause.pause; });
+    times.sort(function(a, b) { return a - b; });
+    return {
+        count: times.length,
+        p50: percentile(times, 0.5),
+        p99: percentile(times, 0.99),
+        max: times.length ? times[times.length - 1] : 0
+    };
+}
+
+function runScenario(scenario)
+{
+    gc();
+    clearGCPauses();
+    var heapSizeBefore = gcHeapSize();
+    peakHeapSize = heapSizeBefore;
+
+    var startTime = preciseTime();
+    var allocations = scenario.run();
+    var elapsedTime = (preciseTime() - startTime) * 1000;
+
+    sampleHeapSize();
+    var pauses = gcPauses();
+    return {
+        name: scenario.name,
+        time: elapsedTime,
+        allocationsPerMillisecond: allocations / elapsedTime,
+        heapGrowth: (peakHeapSize - heapSizeBefore) / (1024 * 1024),
+        eden: pauseSummary(pauses, "Eden"),
+        full: pauseSummary(pauses, "Full")
+    };
+}
+
+function formatNumber(value, width, digits)
+{
+    var string = value.toFixed(digits === undefined ? 1 : digits);
+    while (string.length < width)
+        string = " " + string;
+    return string;
+}
+
+function formatName(name, width)
+{
+    while (name.length < width)
+        name += " ";
+    return name;
+}
+
+function main(args)
+{
+    var printJSON = args.indexOf("--json") != -1;
+    var names = args.filter(function(arg) { return arg != "--json"; });
+    var selectedScenarios = names.length ? scenarios.filter(function(scenario) { return names.indexOf(scenario.name) != -1; }) : scenarios;
+
+    var results = selectedScenarios.map(runScenario);
+
+    if (printJSON) {
+        print(JSON.stringify(results, null, 4));
+        return;
+    }
+
+    print(formatName("scenario", 14) + "   time ms  alloc/ms  heap MB | eden  p50    p99    max | full  p50    p99    max");
+    results.forEach(function(result) {
+        print(formatName(result.name, 14)
+            + formatNumber(result.time, 10) + formatNumber(result.allocationsPerMillisecond, 10) + formatNumber(result.heapGrowth, 9)
+            + " |" + formatNumber(result.eden.count, 5, 0) + formatNumber(result.eden.p50, 7) + formatNumber(result.eden.p99, 7) + formatNumber(result.eden.max, 7)
+            + " |" + formatNumber(result.full.count, 5, 0) + formatNumber(result.full.p50, 7) + formatNumber(result.full.p99, 7) + formatNumber(result.full.max, 7));
+    });
+}
+
+main(typeof arguments != "undefined" ? arguments : []);
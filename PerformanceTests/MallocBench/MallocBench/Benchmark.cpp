@@ -37,6 +37,7 @@
 #include "message.h"
 #include "reddit.h"
 #include "realloc.h"
+#include "replay.h"
 #include "stress.h"
 #include "stress_aligned.h"
 #include "theverge.h"
@@ -78,6 +79,7 @@ static const BenchmarkPair benchmarkPairs[] = {
     { "realloc", benchmark_realloc },
     { "reddit", benchmark_reddit },
     { "reddit_memory_warning", benchmark_reddit_memory_warning },
+    { "replay", benchmark_replay },
     { "stress", benchmark_stress },
     { "stress_aligned", benchmark_stress_aligned },
     { "theverge", benchmark_theverge },
@@ -27,26 +27,53 @@
 #include "Interpreter.h"
 #include <assert.h>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <errno.h>
 #include <fcntl.h>
 #include <string>
+#include <strings.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/uio.h>
+#include <thread>
 #include <unistd.h>
+#include <unordered_map>
 #include <vector>
 
 #include "mbmalloc.h"
 
+// Keep these in sync with bmalloc/Trace.h.
+static const char traceMagic[8] = { 'b', 'm', 't', 'r', 'a', 'c', 'e', '1' };
+
+struct TraceRecord {
+    enum Opcode : uint32_t { Malloc, Free, Realloc };
+
+    uint32_t opcode;
+    uint32_t thread;
+    uint64_t size;
+    uint64_t object;
+    uint64_t oldObject;
+};
+
 Interpreter::Interpreter(const char* fileName, bool shouldFreeAllObjects)
     : m_shouldFreeAllObjects(shouldFreeAllObjects)
+    , m_isTrace(false)
 {
     m_fd = open(fileName, O_RDWR, S_IRUSR | S_IWUSR);
     if (m_fd == -1)
         fprintf(stderr, "failed to open\n");
 
+    char magic[sizeof(traceMagic)];
+    if (read(m_fd, magic, sizeof(magic)) == sizeof(magic) && !memcmp(magic, traceMagic, sizeof(magic))) {
+        m_isTrace = true;
+        loadTrace();
+        return;
+    }
+    lseek(m_fd, 0, SEEK_SET);
+
     struct stat buf;
     fstat(m_fd, &buf);
 
@@ -80,8 +107,142 @@ Interpreter::~Interpreter()
         fprintf(stderr, "failed to close\n");
 }
 
+void Interpreter::loadTrace()
+{
+    // Traces name objects by address, and addresses get reused, so give each
+    // allocation its own slot. A realloc keeps its object's slot.
+    std::unordered_map<uint64_t, size_t> slots;
+    std::vector<size_t> slotOpCounts;
+
+    auto append = [&](uint32_t thread, Opcode opcode, size_t slot, size_t size) {
+        if (thread >= m_threadOps.size())
+            m_threadOps.resize(thread + 1);
+        m_threadOps[thread].push_back({ opcode, slot, size, slotOpCounts[slot]++ });
+        ++m_opCount;
+    };
+
+    auto allocateSlot = [&](uint64_t object) {
+        size_t slot = slotOpCounts.size();
+        slotOpCounts.push_back(0);
+        slots[object] = slot;
+        return slot;
+    };
+
+    m_opCount = 0;
+
+    std::vector<TraceRecord> records(1024);
+    while (true) {
+        ssize_t bytes = read(m_fd, records.data(), records.size() * sizeof(TraceRecord));
+        if (bytes <= 0)
+            break;
+
+        size_t recordCount = bytes / sizeof(TraceRecord);
+        assert(recordCount * sizeof(TraceRecord) == static_cast<size_t>(bytes));
+        for (size_t i = 0; i < recordCount; ++i) {
+            const TraceRecord& record = records[i];
+            switch (record.opcode) {
+            case TraceRecord::Malloc: {
+                append(record.thread, op_malloc, allocateSlot(record.object), record.size);
+                break;
+            }
+            case TraceRecord::Free: {
+                // Objects allocated before recording started are not ours to free.
+                auto it = slots.find(record.object);
+                if (it == slots.end())
+                    continue;
+                append(record.thread, op_free, it->second, 0);
+                slots.erase(it);
+                break;
+            }
+            case TraceRecord::Realloc: {
+                auto it = slots.find(record.oldObject);
+                if (it == slots.end()) {
+                    append(record.thread, op_malloc, allocateSlot(record.object), record.size);
+                    break;
+                }
+                size_t slot = it->second;
+                slots.erase(it);
+                append(record.thread, op_realloc, slot, record.size);
+                slots[record.object] = slot;
+                break;
+            }
+            default: {
+                fprintf(stderr, "bad trace opcode: %d\n", record.opcode);
+                abort();
+                break;
+            }
+            }
+        }
+    }
+
+    m_objects.resize(slotOpCounts.size());
+    m_slotSequences.reset(new std::atomic<size_t>[slotOpCounts.size()]);
+}
+
+void Interpreter::runTraceThread(const std::vector<ThreadOp>& ops)
+{
+    for (const ThreadOp& op : ops) {
+        std::atomic<size_t>& sequence = m_slotSequences[op.slot];
+        while (sequence.load(std::memory_order_acquire) != op.sequence)
+            std::this_thread::yield();
+
+        Record& record = m_objects[op.slot];
+        switch (op.opcode) {
+        case op_malloc: {
+            record = { mbmalloc(op.size), op.size };
+            assert(record.object);
+            bzero(record.object, op.size);
+            break;
+        }
+        case op_free: {
+            mbfree(record.object, record.size);
+            record = { 0, 0 };
+            break;
+        }
+        case op_realloc: {
+            record = { mbrealloc(record.object, record.size, op.size), op.size };
+            break;
+        }
+        }
+
+        sequence.store(op.sequence + 1, std::memory_order_release);
+    }
+}
+
+void Interpreter::runTrace()
+{
+    for (size_t i = 0; i < m_objects.size(); ++i)
+        m_slotSequences[i].store(0, std::memory_order_relaxed);
+
+    std::vector<std::thread> threads;
+    for (const std::vector<ThreadOp>& ops : m_threadOps)
+        threads.push_back(std::thread(&Interpreter::runTraceThread, this, std::cref(ops)));
+
+    for (std::thread& thread : threads)
+        thread.join();
+}
+
+void Interpreter::freeAllObjects()
+{
+    for (size_t i = 0; i < m_objects.size(); ++i) {
+        if (!m_objects[i].object)
+            continue;
+        mbfree(m_objects[i].object, m_objects[i].size);
+        m_objects[i] = { 0, 0 };
+    }
+}
+
 void Interpreter::run()
 {
+    if (m_isTrace) {
+        runTrace();
+
+        // A trace might not free all of its allocations.
+        if (m_shouldFreeAllObjects)
+            freeAllObjects();
+        return;
+    }
+
     std::vector<Op> ops(1024);
     lseek(m_fd, 0, SEEK_SET);
     size_t remaining = m_opCount * sizeof(Op);
@@ -126,10 +287,5 @@ void Interpreter::run()
     if (!m_shouldFreeAllObjects)
         return;
 
-    for (size_t i = 0; i < m_objects.size(); ++i) {
-        if (!m_objects[i].object)
-            continue;
-        mbfree(m_objects[i].object, m_objects[i].size);
-        m_objects[i] = { 0, 0 };
-    }
+    freeAllObjects();
 }
@@ -26,8 +26,12 @@
 #ifndef Interpreter_h
 #define Interpreter_h
 
+#include <atomic>
+#include <memory>
 #include <vector>
 
+// Interprets either a MallocBench .ops recording or a trace written by a bmalloc built
+// with BMALLOC_TRACE. Traces replay each recorded thread on its own thread.
 class Interpreter {
 public:
     Interpreter(const char* fileName, bool shouldFreeAllObjects = true);
@@ -40,10 +44,23 @@ private:
     struct Op { Opcode opcode; size_t slot; size_t size; };
     struct Record { void* object; size_t size; };
 
+    // A traced op runs once every earlier op on the same slot has run, which preserves
+    // the recorded lifetimes without serializing unrelated threads.
+    struct ThreadOp { Opcode opcode; size_t slot; size_t size; size_t sequence; };
+
+    void loadTrace();
+    void runTrace();
+    void runTraceThread(const std::vector<ThreadOp>&);
+    void freeAllObjects();
+
     bool m_shouldFreeAllObjects;
     int m_fd;
     size_t m_opCount;
     std::vector<Record> m_objects;
+
+    bool m_isTrace;
+    std::vector<std::vector<ThreadOp>> m_threadOps;
+    std::unique_ptr<std::atomic<size_t>[]> m_slotSequences;
 };
 
 #endif // Interpreter_h
@@ -173,6 +173,30 @@ void JSDisableGCTimer(void)
     GCActivityCallback::s_shouldCreateGCTimer = false;
 }
 
+bool JSGetLastGarbageCollectionStatistics(JSContextRef ctx, JSGarbageCollectionStatistics* statistics)
+{
+    if (!ctx || !statistics) {
+        ASSERT_NOT_REACHED();
+        return false;
+    }
+    ExecState* exec = toJS(ctx);
+    JSLockHolder locker(exec);
+
+    const HeapCollectionEvent& event = exec->vm().heap.lastCollectionEvent();
+    if (event.operation == NoOperation)
+        return false;
+
+    statistics->isFullCollection = event.operation == FullCollection;
+    statistics->pauseDuration = event.pauseLength;
+    statistics->markingDuration = event.markingLength;
+    statistics->copyingDuration = event.copyingLength;
+    statistics->bytesVisited = event.bytesVisited;
+    statistics->bytesCopied = event.bytesCopied;
+    statistics->heapSizeBefore = event.sizeBefore;
+    statistics->heapSizeAfter = event.sizeAfter;
+    return true;
+}
+
 #if PLATFORM(IOS)
 // FIXME: Expose symbols to tell dyld where to find JavaScriptCore on older versions of
 // iOS (< 7.0). We should remove these symbols once we no longer need to support such
@@ -47,6 +47,39 @@ JS_EXPORT void JSReportExtraMemoryCost(JSContextRef ctx, size_t size) CF_AVAILAB
 
 JS_EXPORT void JSDisableGCTimer(void);
 
+/*!
+@struct JSGarbageCollectionStatistics
+@abstract Describes the most recent garbage collection of a context's heap.
+@field isFullCollection true if the whole heap was collected, false if only newly allocated objects were.
+@field pauseDuration Total time the collection paused execution, in seconds.
+@field markingDuration Time spent marking live objects, in seconds.
+@field copyingDuration Time spent copying object storage, in seconds.
+@field bytesVisited Bytes of live objects visited while marking.
+@field bytesCopied Bytes of object storage copied.
+@field heapSizeBefore Estimated heap size when the collection started, in bytes.
+@field heapSizeAfter Estimated heap size when the collection finished, in bytes.
+*/
+typedef struct {
+    bool isFullCollection;
+    double pauseDuration;
+    double markingDuration;
+    double copyingDuration;
+    size_t bytesVisited;
+    size_t bytesCopied;
+    size_t heapSizeBefore;
+    size_t heapSizeAfter;
+} JSGarbageCollectionStatistics;
+
+/*!
+@function
+@abstract Gets statistics about the most recent garbage collection.
+@param ctx The execution context to use.
+@param statistics A pointer to a JSGarbageCollectionStatistics to fill in.
+@result true if there has been a collection since ctx's heap was created, otherwise false; statistics is left untouched in that case.
+@discussion This is cheap enough to call after every collection, and is meant for collecting GC telemetry.
+*/
+JS_EXPORT bool JSGetLastGarbageCollectionStatistics(JSContextRef ctx, JSGarbageCollectionStatistics* statistics);
+
 #ifdef __cplusplus
 }
 #endif
@@ -112,6 +112,34 @@ void JSContextGroupClearExecutionTimeLimit(JSContextGroupRef group)
         vm.watchdog->setTimeLimit(Watchdog::noTimeLimit);
 }
 
+static void internalScriptSoftTimeLimitCallback(ExecState* exec, void* callbackPtr, void* callbackData)
+{
+    JSSoftTimeLimitCallback callback = reinterpret_cast<JSSoftTimeLimitCallback>(callbackPtr);
+    JSContextRef contextRef = toRef(exec);
+    ASSERT(callback);
+    callback(contextRef, callbackData);
+}
+
+void JSContextGroupSetExecutionSoftTimeLimit(JSContextGroupRef group, double limit, JSSoftTimeLimitCallback callback, void* callbackData)
+{
+    VM& vm = *toJS(group);
+    JSLockHolder locker(&vm);
+    Watchdog& watchdog = vm.ensureWatchdog();
+    if (callback) {
+        void* callbackPtr = reinterpret_cast<void*>(callback);
+        watchdog.setSoftTimeLimit(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::duration<double>(limit)), internalScriptSoftTimeLimitCallback, callbackPtr, callbackData);
+    } else
+        watchdog.setSoftTimeLimit(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::duration<double>(limit)));
+}
+
+void JSContextGroupClearExecutionSoftTimeLimit(JSContextGroupRef group)
+{
+    VM& vm = *toJS(group);
+    JSLockHolder locker(&vm);
+    if (vm.watchdog)
+        vm.watchdog->setSoftTimeLimit(Watchdog::noTimeLimit);
+}
+
 // From the API's perspective, a global context remains alive iff it has been JSGlobalContextRetained.
 
 JSGlobalContextRef JSGlobalContextCreate(JSClassRef globalObjectClass)
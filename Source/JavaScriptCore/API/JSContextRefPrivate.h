@@ -94,6 +94,44 @@ JS_EXPORT void JSContextGroupSetExecutionTimeLimit(JSContextGroupRef, double lim
 */
 JS_EXPORT void JSContextGroupClearExecutionTimeLimit(JSContextGroupRef) CF_AVAILABLE(10_6, 7_0);
 
+/*!
+@typedef JSSoftTimeLimitCallback
+@abstract The callback invoked each time script execution has used up the soft
+ time limit previously specified via JSContextGroupSetExecutionSoftTimeLimit.
+@param ctx The execution context to use.
+@param context User specified context data previously passed to
+ JSContextGroupSetExecutionSoftTimeLimit.
+@discussion The script cannot be terminated from this callback. The callback may
+ block, for example to let scripts in other context groups run, and the script
+ resumes when it returns.
+*/
+typedef void
+(*JSSoftTimeLimitCallback) (JSContextRef ctx, void* context);
+
+/*!
+@function
+@abstract Sets the script execution soft time limit.
+@param group The JavaScript context group that this soft time limit applies to.
+@param limit The CPU time in seconds that script may run between two calls of
+ the callback.
+@param callback The callback function that will be invoked each time script has
+ run for the soft time limit.
+@param context User data that you can provide to be passed back to you
+ in your callback.
+
+ The soft time limit is independent of the time limit set with
+ JSContextGroupSetExecutionTimeLimit. As with that limit, you will need to call
+ JSContextGroupSetExecutionSoftTimeLimit before you start executing any scripts.
+*/
+JS_EXPORT void JSContextGroupSetExecutionSoftTimeLimit(JSContextGroupRef, double limit, JSSoftTimeLimitCallback, void* context) CF_AVAILABLE(10_11, 9_0);
+
+/*!
+@function
+@abstract Clears the script execution soft time limit.
+@param group The JavaScript context group that the soft time limit is cleared on.
+*/
+JS_EXPORT void JSContextGroupClearExecutionSoftTimeLimit(JSContextGroupRef) CF_AVAILABLE(10_11, 9_0);
+
 /*!
 @function
 @abstract Gets a whether or not remote inspection is enabled on the context.
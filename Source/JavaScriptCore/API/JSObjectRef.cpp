@@ -35,11 +35,13 @@
 #include "DateConstructor.h"
 #include "ErrorConstructor.h"
 #include "Exception.h"
+#include "ExceptionHelpers.h"
 #include "FunctionConstructor.h"
 #include "Identifier.h"
 #include "InitializeThreading.h"
 #include "JSAPIWrapperObject.h"
 #include "JSArray.h"
+#include "JSArrayBufferView.h"
 #include "JSCallbackConstructor.h"
 #include "JSCallbackFunction.h"
 #include "JSCallbackObject.h"
@@ -54,6 +56,7 @@
 #include "ObjectPrototype.h"
 #include "JSCInlines.h"
 #include "PropertyNameArray.h"
+#include "PureNaN.h"
 #include "RegExpConstructor.h"
 
 #if ENABLE(REMOTE_INSPECTOR)
@@ -523,6 +526,99 @@ bool JSObjectDeletePrivateProperty(JSContextRef ctx, JSObjectRef object, JSStrin
     return false;
 }
 
+bool JSObjectGetProperties(JSContextRef ctx, JSObjectRef object, size_t propertyCount, const JSStringRef propertyNames[], JSValueRef values[], JSValueRef* exception)
+{
+    if (!ctx) {
+        ASSERT_NOT_REACHED();
+        return false;
+    }
+    ExecState* exec = toJS(ctx);
+    JSLockHolder locker(exec);
+
+    JSObject* jsObject = toJS(object);
+    VM* vm = &exec->vm();
+
+    for (size_t i = 0; i < propertyCount; ++i) {
+        JSValue jsValue = jsObject->get(exec, propertyNames[i]->identifier(vm));
+        if (handleExceptionIfNeeded(exec, exception) == ExceptionStatus::DidThrow)
+            return false;
+        values[i] = toRef(exec, jsValue);
+    }
+    return true;
+}
+
+bool JSObjectSetProperties(JSContextRef ctx, JSObjectRef object, size_t propertyCount, const JSStringRef propertyNames[], const JSValueRef values[], JSValueRef* exception)
+{
+    if (!ctx) {
+        ASSERT_NOT_REACHED();
+        return false;
+    }
+    ExecState* exec = toJS(ctx);
+    JSLockHolder locker(exec);
+
+    JSObject* jsObject = toJS(object);
+    VM* vm = &exec->vm();
+
+    for (size_t i = 0; i < propertyCount; ++i) {
+        PutPropertySlot slot(jsObject);
+        jsObject->methodTable()->put(jsObject, exec, propertyNames[i]->identifier(vm), toJS(exec, values[i]), slot);
+        if (handleExceptionIfNeeded(exec, exception) == ExceptionStatus::DidThrow)
+            return false;
+    }
+    return true;
+}
+
+JSObjectRef JSObjectMakeArrayFromNumbers(JSContextRef ctx, const double numbers[], size_t numberCount, JSValueRef* exception)
+{
+    if (!ctx) {
+        ASSERT_NOT_REACHED();
+        return 0;
+    }
+    ExecState* exec = toJS(ctx);
+    JSLockHolder locker(exec);
+
+    if (!numberCount)
+        return toRef(constructEmptyArray(exec, 0));
+
+    // Numbers never need to be marked, so the elements can be stored directly into an uninitialized
+    // double array instead of going through JSValueRefs and a MarkedArgumentBuffer.
+    VM& vm = exec->vm();
+    JSArray* result = nullptr;
+    if (numberCount <= std::numeric_limits<unsigned>::max())
+        result = JSArray::tryCreateUninitialized(vm, exec->lexicalGlobalObject()->arrayStructureForIndexingTypeDuringAllocation(ArrayWithDouble), numberCount);
+    if (!result) {
+        throwOutOfMemoryError(exec);
+        handleExceptionIfNeeded(exec, exception);
+        return 0;
+    }
+
+    for (size_t i = 0; i < numberCount; ++i)
+        result->initializeIndex(vm, i, jsNumber(purifyNaN(numbers[i])));
+
+    return toRef(result);
+}
+
+size_t JSObjectCopyTypedArrayBytes(JSContextRef ctx, JSObjectRef object, void* buffer, size_t bufferLength)
+{
+    if (!ctx) {
+        ASSERT_NOT_REACHED();
+        return 0;
+    }
+    ExecState* exec = toJS(ctx);
+    JSLockHolder locker(exec);
+
+    JSObject* jsObject = toJS(object);
+    TypedArrayType type = jsObject->classInfo()->typedArrayStorageType;
+    if (!isTypedView(type))
+        return 0;
+
+    JSArrayBufferView* view = jsCast<JSArrayBufferView*>(jsObject);
+    size_t byteLength = std::min<size_t>(static_cast<size_t>(view->length()) * elementSize(type), bufferLength);
+    if (byteLength)
+        memcpy(buffer, view->vector(), byteLength);
+    return byteLength;
+}
+
 bool JSObjectIsFunction(JSContextRef ctx, JSObjectRef object)
 {
     if (!object)
@@ -67,6 +67,57 @@ JS_EXPORT JSValueRef JSObjectGetPrivateProperty(JSContextRef ctx, JSObjectRef ob
  */
 JS_EXPORT bool JSObjectDeletePrivateProperty(JSContextRef ctx, JSObjectRef object, JSStringRef propertyName);
 
+/*!
+ @function
+ @abstract Gets several properties from an object at once.
+ @param ctx The execution context to use.
+ @param object The JSObject whose properties you want to get.
+ @param propertyCount The number of properties to get.
+ @param propertyNames A C array of propertyCount JSStrings containing the properties' names.
+ @param values A C array of propertyCount JSValues that receives the properties' values.
+ @param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+ @result true if all the properties were read, false if getting one of them threw an exception.
+ @discussion This is equivalent to calling JSObjectGetProperty for each name, but takes the JavaScript lock only once.
+ */
+JS_EXPORT bool JSObjectGetProperties(JSContextRef ctx, JSObjectRef object, size_t propertyCount, const JSStringRef propertyNames[], JSValueRef values[], JSValueRef* exception);
+
+/*!
+ @function
+ @abstract Sets several properties on an object at once.
+ @param ctx The execution context to use.
+ @param object The JSObject whose properties you want to set.
+ @param propertyCount The number of properties to set.
+ @param propertyNames A C array of propertyCount JSStrings containing the properties' names.
+ @param values A C array of propertyCount JSValues to use as the properties' values.
+ @param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+ @result true if all the properties were set, false if setting one of them threw an exception. Properties after the one that threw are left unset.
+ @discussion This is equivalent to calling JSObjectSetProperty with no attributes for each name, but takes the JavaScript lock only once.
+ */
+JS_EXPORT bool JSObjectSetProperties(JSContextRef ctx, JSObjectRef object, size_t propertyCount, const JSStringRef propertyNames[], const JSValueRef values[], JSValueRef* exception);
+
+/*!
+ @function
+ @abstract Creates a JavaScript Array object from a C array of numbers.
+ @param ctx The execution context to use.
+ @param numbers A C array of numberCount doubles to use as the array's elements.
+ @param numberCount The number of elements in numbers.
+ @param exception A pointer to a JSValueRef in which to store an exception, if any. Pass NULL if you do not care to store an exception.
+ @result A JSObject that is an Array, or NULL if the array could not be allocated.
+ @discussion Unlike JSObjectMakeArray, this does not require a JSValueRef for each element.
+ */
+JS_EXPORT JSObjectRef JSObjectMakeArrayFromNumbers(JSContextRef ctx, const double numbers[], size_t numberCount, JSValueRef* exception);
+
+/*!
+ @function
+ @abstract Copies the contents of a typed array into a native buffer.
+ @param ctx The execution context to use.
+ @param object The typed array whose contents you want to copy.
+ @param buffer The buffer to copy the bytes into.
+ @param bufferLength The size of buffer in bytes.
+ @result The number of bytes copied, which is at most bufferLength. Returns 0 if object is not a typed array or has been neutered.
+ */
+JS_EXPORT size_t JSObjectCopyTypedArrayBytes(JSContextRef ctx, JSObjectRef object, void* buffer, size_t bufferLength);
+
 #ifdef __cplusplus
 }
 #endif
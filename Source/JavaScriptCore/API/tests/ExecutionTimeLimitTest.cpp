@@ -77,6 +77,12 @@ static bool extendTerminateCallback(JSContextRef ctx, void*)
     return true;
 }
 
+int softTimeLimitCallbackCalled = 0;
+static void softTimeLimitCallback(JSContextRef, void*)
+{
+    softTimeLimitCallbackCalled++;
+}
+
 struct TierOptions {
     const char* tier;
     unsigned timeLimitAdjustmentMillis;
@@ -323,6 +329,37 @@ int testExecutionTimeLimit()
             }
         }
 
+        /* Test script soft time limit: */
+        JSContextGroupClearExecutionTimeLimit(contextGroup);
+        timeLimit = (50 + tierAdjustmentMillis) / 1000.0;
+        JSContextGroupSetExecutionSoftTimeLimit(contextGroup, timeLimit, softTimeLimitCallback, 0);
+        {
+            unsigned busyLoopTime = 4 * (50 + tierAdjustmentMillis);
+
+            StringBuilder scriptBuilder;
+            scriptBuilder.append("function foo() { var startTime = currentCPUTime(); while (true) { for (var i = 0; i < 1000; i++); if (currentCPUTime() - startTime > ");
+            scriptBuilder.appendNumber(busyLoopTime / 1000.0); // in seconds.
+            scriptBuilder.append(") break; } } foo();");
+
+            JSStringRef script = JSStringCreateWithUTF8CString(scriptBuilder.toString().utf8().data());
+            exception = nullptr;
+            softTimeLimitCallbackCalled = 0;
+
+            scriptResult = JSEvaluateScript(context, script, nullptr, nullptr, 1, &exception);
+
+            // The callback is due 4 times, but the last call may race with the end of the loop.
+            if (softTimeLimitCallbackCalled >= 3 && !exception)
+                printf("PASS: %s script soft time limit callback was called repeatedly as expected.\n", tierOptions.tier);
+            else {
+                if (softTimeLimitCallbackCalled < 3)
+                    printf("FAIL: %s script soft time limit callback was called %d times.\n", tierOptions.tier, softTimeLimitCallbackCalled);
+                if (exception)
+                    printf("FAIL: %s script was terminated by its soft time limit.\n", tierOptions.tier);
+                failed = true;
+            }
+        }
+        JSContextGroupClearExecutionSoftTimeLimit(contextGroup);
+
         JSGlobalContextRelease(context);
 
         Options::setOptions(savedOptionsBuilder.toString().ascii().data());
@@ -1343,6 +1343,15 @@ int main(int argc, char* argv[])
     } else
         printf("PASS: Cannot access private property through ordinary property lookup.\n");
 
+    JSSynchronousGarbageCollectForDebugging(context);
+    JSGarbageCollectionStatistics gcStatistics;
+    if (!JSGetLastGarbageCollectionStatistics(context, &gcStatistics) || !gcStatistics.isFullCollection || !gcStatistics.bytesVisited
+        || gcStatistics.pauseDuration < gcStatistics.markingDuration + gcStatistics.copyingDuration) {
+        printf("FAIL: Garbage collection statistics do not describe the last full collection.\n");
+        failed = 1;
+    } else
+        printf("PASS: Garbage collection statistics describe the last full collection.\n");
+
     JSGarbageCollect(context);
 
     for (int i = 0; i < 10000; i++)
@@ -861,6 +861,23 @@ private:
         FPDataOp_FNMUL
     };
 
+    // Full base encodings, with Q set, for the 128-bit forms we emit.
+    enum SIMDOpThreeSame {
+        SIMDOp_ADD_4S = 0x4ea08400,
+        SIMDOp_SUB_4S = 0x6ea08400,
+        SIMDOp_MUL_4S = 0x4ea09c00,
+        SIMDOp_FADD_4S = 0x4e20d400,
+        SIMDOp_FSUB_4S = 0x4ea0d400,
+        SIMDOp_FMUL_4S = 0x6e20dc00,
+        SIMDOp_ORR_16B = 0x4ea01c00,
+    };
+
+    enum SIMDCopyOp {
+        SIMDCopyOp_DUP_element = 0x4e000400,
+        SIMDCopyOp_DUP_general = 0x4e000c00,
+        SIMDCopyOp_INS_element = 0x6e000400,
+    };
+
     enum FPIntConvOp {
         FPIntConvOp_FCVTNS = 0x00,
         FPIntConvOp_FCVTNU = 0x01,
@@ -2575,7 +2592,7 @@ public:
     template<int datasize>
     ALWAYS_INLINE void stur(FPRegisterID rt, RegisterID rn, int simm)
     {
-        CHECK_DATASIZE();
+        CHECK_FP_MEMOP_DATASIZE();
         insn(loadStoreRegisterUnscaledImmediate(MEMOPSIZE, true, datasize == 128 ? MemOp_STORE_V128 : MemOp_STORE, simm, rn, rt));
     }
 
@@ -2587,6 +2604,62 @@ public:
         insn(floatingPointIntegerConversions(DATASIZE_OF(srcsize), DATASIZE_OF(dstsize), FPIntConvOp_UCVTF, rn, vd));
     }
 
+    // Advanced SIMD instructions. These all operate on the full 128-bit register, treated
+    // as four 32-bit lanes (the .4S arrangement).
+
+    ALWAYS_INLINE void vadd_4s(FPRegisterID vd, FPRegisterID vn, FPRegisterID vm)
+    {
+        insn(simdThreeSame(SIMDOp_ADD_4S, vm, vn, vd));
+    }
+
+    ALWAYS_INLINE void vsub_4s(FPRegisterID vd, FPRegisterID vn, FPRegisterID vm)
+    {
+        insn(simdThreeSame(SIMDOp_SUB_4S, vm, vn, vd));
+    }
+
+    ALWAYS_INLINE void vmul_4s(FPRegisterID vd, FPRegisterID vn, FPRegisterID vm)
+    {
+        insn(simdThreeSame(SIMDOp_MUL_4S, vm, vn, vd));
+    }
+
+    ALWAYS_INLINE void vfadd_4s(FPRegisterID vd, FPRegisterID vn, FPRegisterID vm)
+    {
+        insn(simdThreeSame(SIMDOp_FADD_4S, vm, vn, vd));
+    }
+
+    ALWAYS_INLINE void vfsub_4s(FPRegisterID vd, FPRegisterID vn, FPRegisterID vm)
+    {
+        insn(simdThreeSame(SIMDOp_FSUB_4S, vm, vn, vd));
+    }
+
+    ALWAYS_INLINE void vfmul_4s(FPRegisterID vd, FPRegisterID vn, FPRegisterID vm)
+    {
+        insn(simdThreeSame(SIMDOp_FMUL_4S, vm, vn, vd));
+    }
+
+    // ORR Vd.16B, Vn.16B, Vn.16B, the preferred full-width register move.
+    ALWAYS_INLINE void vmov(FPRegisterID vd, FPRegisterID vn)
+    {
+        insn(simdThreeSame(SIMDOp_ORR_16B, vn, vn, vd));
+    }
+
+    ALWAYS_INLINE void vdup_4s(FPRegisterID vd, RegisterID rn)
+    {
+        insn(simdCopy(SIMDCopyOp_DUP_general, 0, 0, xOrZrAsFPR(rn), vd));
+    }
+
+    ALWAYS_INLINE void vdup_4s(FPRegisterID vd, FPRegisterID vn, unsigned lane)
+    {
+        ASSERT(lane < 4);
+        insn(simdCopy(SIMDCopyOp_DUP_element, lane, 0, vn, vd));
+    }
+
+    ALWAYS_INLINE void vins_4s(FPRegisterID vd, unsigned dstLane, FPRegisterID vn, unsigned srcLane)
+    {
+        ASSERT(dstLane < 4 && srcLane < 4);
+        insn(simdCopy(SIMDCopyOp_INS_element, dstLane, srcLane, vn, vd));
+    }
+
     // Admin methods:
 
     AssemblerLabel labelIgnoringWatchpoints()
@@ -3459,6 +3532,19 @@ private:
         return floatingPointIntegerConversions(sf, type, rmodeOpcode, xOrZrAsFPR(rn), rd);
     }
 
+    ALWAYS_INLINE static int simdThreeSame(SIMDOpThreeSame opcode, FPRegisterID rm, FPRegisterID rn, FPRegisterID rd)
+    {
+        return (opcode | rm << 16 | rn << 5 | rd);
+    }
+
+    // Only the 32-bit element size is supported, so imm5 is always (lane << 3) | 0b100.
+    ALWAYS_INLINE static int simdCopy(SIMDCopyOp opcode, unsigned dstLane, unsigned srcLane, FPRegisterID rn, FPRegisterID rd)
+    {
+        int imm5 = (dstLane << 3) | 4;
+        int imm4 = srcLane << 2;
+        return (opcode | imm5 << 16 | imm4 << 11 | rn << 5 | rd);
+    }
+
     ALWAYS_INLINE static int floatingPointDataProcessing1Source(Datasize type, FPDataOp1Source opcode, FPRegisterID rn, FPRegisterID rd)
     {
         const int M = 0;
@@ -1122,6 +1122,7 @@ public:
         return s_isVFPPresent;
     }
     static bool supportsFloatingPointAbs() { return false; }
+    static bool supportsVector() { return false; }
 
     void loadFloat(BaseIndex address, FPRegisterID dest)
     {
@@ -1169,6 +1169,7 @@ public:
     static bool supportsFloatingPointTruncate() { return true; }
     static bool supportsFloatingPointSqrt() { return true; }
     static bool supportsFloatingPointAbs() { return true; }
+    static bool supportsVector() { return true; }
 
     enum BranchTruncateType { BranchIfTruncateFailed, BranchIfTruncateSuccessful };
 
@@ -1480,6 +1481,106 @@ public:
     }
 
 
+    // Vector operations:
+    //
+    // These treat an FPRegisterID as a 128-bit vector of four 32-bit lanes.
+
+    void loadVector(ImplicitAddress address, FPRegisterID dest)
+    {
+        if (tryLoadWithOffset<128>(dest, address.base, address.offset))
+            return;
+
+        signExtend32ToPtr(TrustedImm32(address.offset), getCachedMemoryTempRegisterIDAndInvalidate());
+        m_assembler.ldr<128>(dest, address.base, memoryTempRegister);
+    }
+
+    void loadVector(BaseIndex address, FPRegisterID dest)
+    {
+        if (!address.offset && (!address.scale || address.scale == 4)) {
+            m_assembler.ldr<128>(dest, address.base, address.index, ARM64Assembler::UXTX, address.scale);
+            return;
+        }
+
+        signExtend32ToPtr(TrustedImm32(address.offset), getCachedMemoryTempRegisterIDAndInvalidate());
+        m_assembler.add<64>(memoryTempRegister, memoryTempRegister, address.index, ARM64Assembler::UXTX, address.scale);
+        m_assembler.ldr<128>(dest, address.base, memoryTempRegister);
+    }
+
+    void storeVector(FPRegisterID src, ImplicitAddress address)
+    {
+        if (tryStoreWithOffset<128>(src, address.base, address.offset))
+            return;
+
+        signExtend32ToPtr(TrustedImm32(address.offset), getCachedMemoryTempRegisterIDAndInvalidate());
+        m_assembler.str<128>(src, address.base, memoryTempRegister);
+    }
+
+    void storeVector(FPRegisterID src, BaseIndex address)
+    {
+        if (!address.offset && (!address.scale || address.scale == 4)) {
+            m_assembler.str<128>(src, address.base, address.index, ARM64Assembler::UXTX, address.scale);
+            return;
+        }
+
+        signExtend32ToPtr(TrustedImm32(address.offset), getCachedMemoryTempRegisterIDAndInvalidate());
+        m_assembler.add<64>(memoryTempRegister, memoryTempRegister, address.index, ARM64Assembler::UXTX, address.scale);
+        m_assembler.str<128>(src, address.base, memoryTempRegister);
+    }
+
+    void moveVector(FPRegisterID src, FPRegisterID dest)
+    {
+        if (src != dest)
+            m_assembler.vmov(dest, src);
+    }
+
+    void addInt32x4(FPRegisterID src, FPRegisterID dest)
+    {
+        m_assembler.vadd_4s(dest, dest, src);
+    }
+
+    void subInt32x4(FPRegisterID src, FPRegisterID dest)
+    {
+        m_assembler.vsub_4s(dest, dest, src);
+    }
+
+    void addFloat32x4(FPRegisterID src, FPRegisterID dest)
+    {
+        m_assembler.vfadd_4s(dest, dest, src);
+    }
+
+    void subFloat32x4(FPRegisterID src, FPRegisterID dest)
+    {
+        m_assembler.vfsub_4s(dest, dest, src);
+    }
+
+    void mulFloat32x4(FPRegisterID src, FPRegisterID dest)
+    {
+        m_assembler.vfmul_4s(dest, dest, src);
+    }
+
+    void splatInt32x4(RegisterID src, FPRegisterID dest)
+    {
+        m_assembler.vdup_4s(dest, src);
+    }
+
+    void splatFloat32x4(FPRegisterID src, FPRegisterID dest)
+    {
+        m_assembler.vdup_4s(dest, src, 0);
+    }
+
+    // Lane i of dest gets lane ((order >> (2 * i)) & 3) of src, the same encoding as x86's pshufd.
+    void shuffle32x4(TrustedImm32 order, FPRegisterID src, FPRegisterID dest)
+    {
+        ASSERT(order.m_value >= 0 && order.m_value <= 0xff);
+        if (src == dest) {
+            m_assembler.vmov(fpTempRegister, src);
+            src = fpTempRegister;
+        }
+        for (unsigned lane = 0; lane < 4; ++lane)
+            m_assembler.vins_4s(dest, lane, src, (order.m_value >> (2 * lane)) & 3);
+    }
+
+
     // Stack manipulation operations:
     //
     // The ABI is assumed to provide a stack abstraction to memory,
@@ -845,6 +845,7 @@ public:
     static bool supportsFloatingPointTruncate() { return true; }
     static bool supportsFloatingPointSqrt() { return true; }
     static bool supportsFloatingPointAbs() { return true; }
+    static bool supportsVector() { return false; }
 
     void loadDouble(ImplicitAddress address, FPRegisterID dest)
     {
@@ -286,6 +286,7 @@ public:
     static bool supportsFloatingPointTruncate() { return isSSE2Present(); }
     static bool supportsFloatingPointSqrt() { return isSSE2Present(); }
     static bool supportsFloatingPointAbs() { return isSSE2Present(); }
+    static bool supportsVector() { return isSSE2Present(); }
     
     static FunctionPtr readCallTarget(CodeLocationCall call)
     {
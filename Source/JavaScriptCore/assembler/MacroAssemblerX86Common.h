@@ -1013,6 +1013,92 @@ public:
         m_assembler.movd_rr(src, dst);
     }
 
+    // Vector operations:
+    //
+    // These treat an FPRegisterID as a 128-bit vector of four 32-bit lanes. Memory operands
+    // need not be 16-byte aligned.
+
+    void loadVector(ImplicitAddress address, FPRegisterID dest)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.movups_mr(address.offset, address.base, dest);
+    }
+
+    void loadVector(BaseIndex address, FPRegisterID dest)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.movups_mr(address.offset, address.base, address.index, address.scale, dest);
+    }
+
+    void storeVector(FPRegisterID src, ImplicitAddress address)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.movups_rm(src, address.offset, address.base);
+    }
+
+    void storeVector(FPRegisterID src, BaseIndex address)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.movups_rm(src, address.offset, address.base, address.index, address.scale);
+    }
+
+    void moveVector(FPRegisterID src, FPRegisterID dest)
+    {
+        ASSERT(isSSE2Present());
+        if (src != dest)
+            m_assembler.movups_rr(src, dest);
+    }
+
+    void addInt32x4(FPRegisterID src, FPRegisterID dest)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.paddd_rr(src, dest);
+    }
+
+    void subInt32x4(FPRegisterID src, FPRegisterID dest)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.psubd_rr(src, dest);
+    }
+
+    void addFloat32x4(FPRegisterID src, FPRegisterID dest)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.addps_rr(src, dest);
+    }
+
+    void subFloat32x4(FPRegisterID src, FPRegisterID dest)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.subps_rr(src, dest);
+    }
+
+    void mulFloat32x4(FPRegisterID src, FPRegisterID dest)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.mulps_rr(src, dest);
+    }
+
+    void splatInt32x4(RegisterID src, FPRegisterID dest)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.movd_rr(src, dest);
+        m_assembler.pshufd_irr(0, dest, dest);
+    }
+
+    void splatFloat32x4(FPRegisterID src, FPRegisterID dest)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.pshufd_irr(0, src, dest);
+    }
+
+    // Lane i of dest gets lane ((order >> (2 * i)) & 3) of src.
+    void shuffle32x4(TrustedImm32 order, FPRegisterID src, FPRegisterID dest)
+    {
+        ASSERT(isSSE2Present());
+        m_assembler.pshufd_irr(order.m_value, src, dest);
+    }
+
     // Stack manipulation operations:
     //
     // The ABI is assumed to provide a stack abstraction to memory,
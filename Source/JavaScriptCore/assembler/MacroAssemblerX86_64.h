@@ -909,6 +909,7 @@ public:
     static bool supportsFloatingPointTruncate() { return true; }
     static bool supportsFloatingPointSqrt() { return true; }
     static bool supportsFloatingPointAbs() { return true; }
+    static bool supportsVector() { return true; }
     
     static FunctionPtr readCallTarget(CodeLocationCall call)
     {
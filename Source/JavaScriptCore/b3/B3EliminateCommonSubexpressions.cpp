@@ -0,0 +1,248 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "B3EliminateCommonSubexpressions.h"
+
+#if ENABLE(B3_JIT)
+
+#include "B3BasicBlockInlines.h"
+#include "B3BlockWorklist.h"
+#include "B3Dominators.h"
+#include "B3IndexMap.h"
+#include "B3MemoryValue.h"
+#include "B3PhaseScope.h"
+#include "B3ProcedureInlines.h"
+#include "B3ValueInlines.h"
+#include "B3ValueKeyInlines.h"
+#include <wtf/HashMap.h>
+
+namespace JSC { namespace B3 {
+
+namespace {
+
+const bool verbose = false;
+
+Value* pointerOf(MemoryValue* memory)
+{
+    return memory->lastChild();
+}
+
+// Returns true if the load can take its result from the given memory value, which must have
+// executed before it without any clobbering writes in between.
+bool canReplaceLoad(MemoryValue* load, MemoryValue* memory)
+{
+    if (pointerOf(memory) != pointerOf(load)
+        || memory->offset() != load->offset()
+        || memory->range() != load->range())
+        return false;
+
+    if (MemoryValue::isLoad(memory->opcode()))
+        return memory->opcode() == load->opcode() && memory->type() == load->type();
+
+    // The narrow stores truncate and StoreFloat rounds, so only a full-width Store gives us back
+    // exactly the value that was stored.
+    return memory->opcode() == Store
+        && load->opcode() == Load
+        && memory->child(0)->type() == load->type();
+}
+
+struct ImpureBlockData {
+    // All of the heap that this block may write.
+    HeapRange writes;
+
+    // Loads and stores whose memory is known to be unchanged at the tail of the block.
+    Vector<MemoryValue*> memoryValuesAtTail;
+};
+
+class CSE {
+public:
+    CSE(Procedure& proc)
+        : m_proc(proc)
+        , m_dominators(proc)
+        , m_impureBlockData(proc.size())
+    {
+    }
+
+    bool run()
+    {
+        m_proc.resetValueOwners();
+
+        for (BasicBlock* block : m_proc) {
+            HeapRange& writes = m_impureBlockData[block].writes;
+            for (Value* value : *block)
+                writes = writes.merge(value->effects().writes);
+        }
+
+        // Pre-order guarantees that we see a block's dominators before we see it.
+        for (BasicBlock* block : m_proc.blocksInPreOrder()) {
+            m_block = block;
+            m_writesSoFar = HeapRange();
+            m_memoryValues.clear();
+
+            for (Value* value : *block)
+                process(value);
+
+            m_impureBlockData[block].memoryValuesAtTail = WTF::move(m_memoryValues);
+        }
+
+        return m_changed;
+    }
+
+private:
+    void process(Value* value)
+    {
+        value->performSubstitution();
+
+        if (replacePure(value))
+            return;
+
+        MemoryValue* memory = value->as<MemoryValue>();
+        if (memory && MemoryValue::isLoad(memory->opcode()) && replaceLoad(memory))
+            return;
+
+        HeapRange writes = value->effects().writes;
+        if (writes) {
+            m_memoryValues.removeAllMatching(
+                [&] (MemoryValue* memoryValue) {
+                    return memoryValue->range().overlaps(writes);
+                });
+            m_writesSoFar = m_writesSoFar.merge(writes);
+        }
+
+        if (memory)
+            m_memoryValues.append(memory);
+    }
+
+    bool replacePure(Value* value)
+    {
+        if (value->opcode() == Identity)
+            return false;
+
+        ValueKey key = value->key();
+        if (!key || value->effects().mustExecute())
+            return false;
+
+        Vector<Value*>& matches = m_pureValues.add(key, Vector<Value*>()).iterator->value;
+        for (Value* match : matches) {
+            if (!m_dominators.dominates(match->owner, m_block))
+                continue;
+
+            if (verbose)
+                dataLog("Replacing ", *value, " with ", *match, "\n");
+            value->replaceWithIdentity(match);
+            m_changed = true;
+            return true;
+        }
+
+        matches.append(value);
+        return false;
+    }
+
+    bool replaceLoad(MemoryValue* load)
+    {
+        MemoryValue* match = findMemoryValue(load);
+        if (!match)
+            return false;
+
+        Value* replacement = MemoryValue::isStore(match->opcode()) ? match->child(0) : match;
+        if (verbose)
+            dataLog("Replacing ", *load, " with ", *replacement, "\n");
+        load->replaceWithIdentity(replacement);
+        m_changed = true;
+        return true;
+    }
+
+    MemoryValue* findMemoryValue(MemoryValue* load)
+    {
+        for (unsigned i = m_memoryValues.size(); i--;) {
+            if (canReplaceLoad(load, m_memoryValues[i]))
+                return m_memoryValues[i];
+        }
+
+        if (m_writesSoFar.overlaps(load->range()))
+            return nullptr;
+
+        for (BasicBlock* dominator = m_dominators.immediateDominatorOf(m_block); dominator;
+            dominator = m_dominators.immediateDominatorOf(dominator)) {
+            // If some block between this dominator and us clobbers the load, then so does every
+            // block between a higher dominator and us.
+            if (isClobberedBetween(dominator, load->range()))
+                return nullptr;
+
+            const Vector<MemoryValue*>& memoryValues = m_impureBlockData[dominator].memoryValuesAtTail;
+            for (unsigned i = memoryValues.size(); i--;) {
+                if (canReplaceLoad(load, memoryValues[i]))
+                    return memoryValues[i];
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Returns true if any path from the tail of the dominator to the head of the current block may
+    // write to the range. Note that such a path may pass through the whole of the current block if
+    // it is in a loop.
+    bool isClobberedBetween(BasicBlock* dominator, const HeapRange& range)
+    {
+        BlockWorklist worklist;
+        worklist.push(dominator);
+        for (BasicBlock* predecessor : m_block->predecessors())
+            worklist.push(predecessor);
+        while (BasicBlock* block = worklist.pop()) {
+            if (block == dominator)
+                continue;
+            if (m_impureBlockData[block].writes.overlaps(range))
+                return true;
+            for (BasicBlock* predecessor : block->predecessors())
+                worklist.push(predecessor);
+        }
+        return false;
+    }
+
+    Procedure& m_proc;
+    Dominators m_dominators;
+    IndexMap<BasicBlock, ImpureBlockData> m_impureBlockData;
+    HashMap<ValueKey, Vector<Value*>> m_pureValues;
+
+    BasicBlock* m_block { nullptr };
+    HeapRange m_writesSoFar;
+    Vector<MemoryValue*> m_memoryValues;
+    bool m_changed { false };
+};
+
+} // anonymous namespace
+
+bool eliminateCommonSubexpressions(Procedure& proc)
+{
+    PhaseScope phaseScope(proc, "eliminateCommonSubexpressions");
+
+    CSE cse(proc);
+    return cse.run();
+}
+
+} } // namespace JSC::B3
+
+#endif // ENABLE(B3_JIT)
@@ -32,6 +32,8 @@
 #include "AirGenerate.h"
 #include "AirInstInlines.h"
 #include "B3Common.h"
+#include "B3EliminateCommonSubexpressions.h"
+#include "B3HoistLoopInvariantValues.h"
 #include "B3LowerMacros.h"
 #include "B3LowerToAir.h"
 #include "B3MoveConstants.h"
@@ -48,7 +50,7 @@ void generate(Procedure& procedure, CCallHelpers& jit, unsigned optLevel)
 
     Air::Code code(procedure);
     generateToAir(procedure, code, optLevel);
-    Air::generate(code, jit);
+    Air::generate(code, jit, optLevel);
 }
 
 void generateToAir(Procedure& procedure, Air::Code& code, unsigned optLevel)
@@ -70,6 +72,10 @@ void generateToAir(Procedure& procedure, Air::Code& code, unsigned optLevel)
 
     if (optLevel >= 1) {
         reduceStrength(procedure);
+        bool changed = eliminateCommonSubexpressions(procedure);
+        changed |= hoistLoopInvariantValues(procedure);
+        if (changed)
+            reduceStrength(procedure);
         
         // FIXME: Add more optimizations here.
         // https://bugs.webkit.org/show_bug.cgi?id=150507
@@ -84,6 +84,17 @@ public:
         return WTF::rangesOverlap(m_begin, m_end, other.m_begin, other.m_end);
     }
 
+    // Returns the smallest range that covers both ranges. This may include heap that neither of them
+    // covers, since a HeapRange cannot have holes.
+    HeapRange merge(const HeapRange& other) const
+    {
+        if (!*this)
+            return other;
+        if (!other)
+            return *this;
+        return HeapRange(std::min(m_begin, other.m_begin), std::max(m_end, other.m_end));
+    }
+
     void dump(PrintStream& out) const;
 
 private:
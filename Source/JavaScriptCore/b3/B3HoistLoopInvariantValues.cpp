@@ -0,0 +1,224 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "B3HoistLoopInvariantValues.h"
+
+#if ENABLE(B3_JIT)
+
+#include "B3BasicBlockInlines.h"
+#include "B3BlockInsertionSet.h"
+#include "B3ControlValue.h"
+#include "B3Dominators.h"
+#include "B3IndexSet.h"
+#include "B3NaturalLoops.h"
+#include "B3PhaseScope.h"
+#include "B3ProcedureInlines.h"
+#include "B3ValueInlines.h"
+
+namespace JSC { namespace B3 {
+
+namespace {
+
+const bool verbose = false;
+
+Vector<BasicBlock*> outsidePredecessors(const NaturalLoop& loop)
+{
+    Vector<BasicBlock*> result;
+    for (BasicBlock* predecessor : loop.header()->predecessors()) {
+        if (!loop.contains(predecessor))
+            result.append(predecessor);
+    }
+    return result;
+}
+
+// A preheader is a block outside the loop that jumps straight to the header and that is the only
+// way into the loop.
+BasicBlock* preheaderOf(const NaturalLoop& loop)
+{
+    Vector<BasicBlock*> predecessors = outsidePredecessors(loop);
+    if (predecessors.size() != 1 || predecessors[0]->numSuccessors() != 1)
+        return nullptr;
+    return predecessors[0];
+}
+
+bool createPreheaders(Procedure& proc)
+{
+    Dominators dominators(proc);
+    NaturalLoops loops(proc, dominators);
+
+    BlockInsertionSet insertionSet(proc);
+    for (unsigned loopIndex = loops.numLoops(); loopIndex--;) {
+        const NaturalLoop& loop = loops.loop(loopIndex);
+        BasicBlock* header = loop.header();
+
+        // We cannot make a new root, and we don't need to if we already have a preheader.
+        if (header == proc[0] || preheaderOf(loop))
+            continue;
+
+        BasicBlock* preheader = insertionSet.insertBefore(header);
+        preheader->appendNew<ControlValue>(
+            proc, Jump, header->at(0)->origin(), FrequentedBlock(header));
+        for (BasicBlock* predecessor : outsidePredecessors(loop))
+            predecessor->replaceSuccessor(header, preheader);
+    }
+
+    if (!insertionSet.execute())
+        return false;
+
+    proc.resetReachability();
+    return true;
+}
+
+class LICM {
+public:
+    LICM(Procedure& proc)
+        : m_proc(proc)
+        , m_dominators(proc)
+        , m_loops(proc, m_dominators)
+    {
+    }
+
+    bool run()
+    {
+        m_proc.resetValueOwners();
+
+        // Hoisting out of an inner loop first lets the same values keep moving out of the outer
+        // loops, since the inner loop's preheader is part of the outer loop.
+        Vector<const NaturalLoop*> loops;
+        for (unsigned loopIndex = m_loops.numLoops(); loopIndex--;)
+            loops.append(&m_loops.loop(loopIndex));
+        std::sort(
+            loops.begin(), loops.end(),
+            [&] (const NaturalLoop* a, const NaturalLoop* b) {
+                return m_loops.loopDepth(a->header()) > m_loops.loopDepth(b->header());
+            });
+
+        Vector<BasicBlock*> blocksInPreOrder = m_proc.blocksInPreOrder();
+        for (const NaturalLoop* loop : loops) {
+            if (BasicBlock* preheader = preheaderOf(*loop))
+                hoist(*loop, preheader, blocksInPreOrder);
+        }
+
+        return m_changed;
+    }
+
+private:
+    void hoist(const NaturalLoop& loop, BasicBlock* preheader, const Vector<BasicBlock*>& blocksInPreOrder)
+    {
+        HeapRange writes;
+        for (unsigned i = loop.size(); i--;) {
+            for (Value* value : *loop[i])
+                writes = writes.merge(value->effects().writes);
+        }
+
+        Vector<Value*> hoistedValues;
+        IndexSet<Value> hoisted;
+
+        // Pre-order means that we see a value's children before we see the value.
+        for (BasicBlock* block : blocksInPreOrder) {
+            if (!m_loops.belongsTo(block, loop))
+                continue;
+
+            // The header runs every time that the preheader does. As long as nothing before a value
+            // in the header can leave the loop, that value would have run, too.
+            bool mayHaveExited = block != loop.header();
+
+            for (Value* value : *block) {
+                Effects effects = value->effects();
+                if (canHoist(value, effects, loop, writes, mayHaveExited)) {
+                    if (verbose)
+                        dataLog("Hoisting ", *value, " into ", *preheader, "\n");
+                    value->owner = preheader;
+                    hoistedValues.append(value);
+                    hoisted.add(value);
+                    continue;
+                }
+                if (effects.exitsSideways || effects.terminal)
+                    mayHaveExited = true;
+            }
+        }
+
+        if (hoistedValues.isEmpty())
+            return;
+
+        for (unsigned i = loop.size(); i--;) {
+            loop[i]->values().removeAllMatching(
+                [&] (Value* value) {
+                    return hoisted.contains(value);
+                });
+        }
+        preheader->values().insertVector(preheader->size() - 1, hoistedValues);
+        m_changed = true;
+    }
+
+    bool canHoist(Value* value, const Effects& effects, const NaturalLoop& loop, const HeapRange& loopWrites, bool mayHaveExited)
+    {
+        switch (value->opcode()) {
+        case ArgumentReg:
+        case Phi:
+        case Upsilon:
+            return false;
+        default:
+            break;
+        }
+
+        if (effects.mustExecute() || effects.readsSSAState)
+            return false;
+        if (effects.reads && effects.reads.overlaps(loopWrites))
+            return false;
+        if ((effects.controlDependent || effects.reads) && mayHaveExited)
+            return false;
+
+        for (Value* child : value->children()) {
+            if (m_loops.belongsTo(child->owner, loop))
+                return false;
+        }
+        return true;
+    }
+
+    Procedure& m_proc;
+    Dominators m_dominators;
+    NaturalLoops m_loops;
+    bool m_changed { false };
+};
+
+} // anonymous namespace
+
+bool hoistLoopInvariantValues(Procedure& proc)
+{
+    PhaseScope phaseScope(proc, "hoistLoopInvariantValues");
+
+    // Adding blocks invalidates dominators and loops, so we do it before computing the ones that we
+    // use for hoisting.
+    bool changed = createPreheaders(proc);
+
+    LICM licm(proc);
+    return licm.run() || changed;
+}
+
+} } // namespace JSC::B3
+
+#endif // ENABLE(B3_JIT)
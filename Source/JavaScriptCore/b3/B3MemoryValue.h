@@ -54,6 +54,24 @@ public:
         }
     }
 
+    static bool isStore(Opcode opcode)
+    {
+        switch (opcode) {
+        case Store8:
+        case Store16:
+        case StoreFloat:
+        case Store:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    static bool isLoad(Opcode opcode)
+    {
+        return accepts(opcode) && !isStore(opcode);
+    }
+
     ~MemoryValue();
 
     int32_t offset() const { return m_offset; }
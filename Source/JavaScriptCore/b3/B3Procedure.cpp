@@ -31,6 +31,7 @@
 #include "B3BasicBlockInlines.h"
 #include "B3BasicBlockUtils.h"
 #include "B3BlockWorklist.h"
+#include "B3CFG.h"
 #include "B3DataSection.h"
 #include "B3OpaqueByproducts.h"
 #include "B3ValueInlines.h"
@@ -40,6 +41,7 @@ namespace JSC { namespace B3 {
 Procedure::Procedure()
     : m_lastPhaseName("initial")
     , m_byproducts(std::make_unique<OpaqueByproducts>())
+    , m_cfg(std::make_unique<CFG>(*this))
 {
 }
 
@@ -42,6 +42,7 @@ namespace JSC { namespace B3 {
 
 class BasicBlock;
 class BlockInsertionSet;
+class CFG;
 class OpaqueByproducts;
 class Value;
 
@@ -127,6 +128,10 @@ public:
     Vector<BasicBlock*> blocksInPreOrder();
     Vector<BasicBlock*> blocksInPostOrder();
 
+    // This is a view of the procedure's control flow graph that can be handed to the generic graph
+    // algorithms in WTF, like WTF::Dominators.
+    CFG& cfg() const { return *m_cfg; }
+
     class ValuesCollection {
     public:
         ValuesCollection(const Procedure& procedure)
@@ -228,6 +233,7 @@ private:
     Vector<size_t> m_valueIndexFreeList;
     const char* m_lastPhaseName;
     std::unique_ptr<OpaqueByproducts> m_byproducts;
+    std::unique_ptr<CFG> m_cfg;
 };
 
 } } // namespace JSC::B3
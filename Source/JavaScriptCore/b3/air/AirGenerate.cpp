@@ -34,6 +34,7 @@
 #include "AirGenerationContext.h"
 #include "AirHandleCalleeSaves.h"
 #include "AirIteratedRegisterCoalescing.h"
+#include "AirLinearScanRegisterAllocation.h"
 #include "AirReportUsedRegisters.h"
 #include "AirSimplifyCFG.h"
 #include "AirSpillEverything.h"
@@ -42,10 +43,26 @@
 #include "B3IndexMap.h"
 #include "B3TimingScope.h"
 #include "CCallHelpers.h"
+#include "Options.h"
 
 namespace JSC { namespace B3 { namespace Air {
 
-void generate(Code& code, CCallHelpers& jit)
+static bool shouldUseLinearScan(Code& code, unsigned optLevel)
+{
+    if (!optLevel || Options::useAirLinearScan())
+        return true;
+
+    unsigned threshold = Options::airLinearScanThreshold();
+    if (!threshold)
+        return false;
+
+    unsigned numInsts = 0;
+    for (BasicBlock* block : code)
+        numInsts += block->size();
+    return numInsts >= threshold;
+}
+
+void generate(Code& code, CCallHelpers& jit, unsigned optLevel)
 {
     TimingScope timingScope("Air::generate");
     
@@ -67,9 +84,13 @@ void generate(Code& code, CCallHelpers& jit)
     
     eliminateDeadCode(code);
 
-    // This is where we would have a real register allocator. Then, we could use spillEverything()
-    // in place of the register allocator only for testing.
-    iteratedRegisterCoalescing(code);
+    // Iterated register coalescing produces much better code, but its interference graph can get
+    // very expensive for huge functions. Linear scan is the fast tier for those and for optLevel 0.
+    // Either way, we could use spillEverything() in place of the register allocator for testing.
+    if (shouldUseLinearScan(code, optLevel))
+        linearScanRegisterAllocation(code);
+    else
+        iteratedRegisterCoalescing(code);
 
     // Prior to this point the prologue and epilogue is implicit. This makes it explicit. It also
     // does things like identify which callee-saves we're using and saves them.
@@ -39,8 +39,8 @@ class Code;
 // This takes an Air::Code that hasn't had any stack allocation and optionally hasn't had any
 // register allocation and does both of those things, and then generates the code using the given
 // CCallHelpers instance. Note that this may call callbacks in the supplied code as it is
-// generating.
-void generate(Code&, CCallHelpers&);
+// generating. At optLevel 0, it uses the cheaper register allocator.
+void generate(Code&, CCallHelpers&, unsigned optLevel = 1);
 
 } } } // namespace JSC::B3::Air
 
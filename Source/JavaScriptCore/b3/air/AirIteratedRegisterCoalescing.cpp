@@ -29,11 +29,11 @@
 #if ENABLE(B3_JIT)
 
 #include "AirCode.h"
-#include "AirInsertionSet.h"
 #include "AirInstInlines.h"
 #include "AirLiveness.h"
 #include "AirPhaseScope.h"
 #include "AirRegisterPriority.h"
+#include "AirSpillTmps.h"
 #include <wtf/ListHashSet.h>
 
 namespace JSC { namespace B3 { namespace Air {
@@ -812,62 +812,6 @@ static void assignRegisterToTmpInProgram(Code& code, const IteratedRegisterCoale
     }
 }
 
-template<Arg::Type type>
-static void addSpillAndFillToProgram(Code& code, const HashSet<Tmp>& spilledTmp)
-{
-    // Allocate stack slot for each spilled value.
-    HashMap<Tmp, StackSlot*> stackSlots;
-    for (Tmp tmp : spilledTmp) {
-        bool isNewTmp = stackSlots.add(tmp, code.addStackSlot(8, StackSlotKind::Anonymous)).isNewEntry;
-        ASSERT_UNUSED(isNewTmp, isNewTmp);
-    }
-
-    // Rewrite the program to get rid of the spilled Tmp.
-    InsertionSet insertionSet(code);
-    for (BasicBlock* block : code) {
-        for (unsigned instIndex = 0; instIndex < block->size(); ++instIndex) {
-            Inst& inst = block->at(instIndex);
-
-            // Try to replace the register use by memory use when possible.
-            for (unsigned i = 0; i < inst.args.size(); ++i) {
-                Arg& arg = inst.args[i];
-                if (arg.isTmp() && arg.type() == type && !arg.isReg()) {
-                    auto stackSlotEntry = stackSlots.find(arg.tmp());
-                    if (stackSlotEntry == stackSlots.end())
-                        continue;
-
-                    if (inst.admitsStack(i)) {
-                        arg = Arg::stack(stackSlotEntry->value);
-                        continue;
-                    }
-                }
-            }
-
-            // For every other case, add Load/Store as needed.
-            inst.forEachTmp([&] (Tmp& tmp, Arg::Role role, Arg::Type argType) {
-                if (tmp.isReg() || argType != type)
-                    return;
-
-                auto stackSlotEntry = stackSlots.find(tmp);
-                if (stackSlotEntry == stackSlots.end())
-                    return;
-
-                Arg arg = Arg::stack(stackSlotEntry->value);
-                Opcode move = type == Arg::GP ? Move : MoveDouble;
-
-                if (Arg::isUse(role)) {
-                    Tmp newTmp = code.newTmp(type);
-                    insertionSet.insert(instIndex, move, inst.origin, arg, newTmp);
-                    tmp = newTmp;
-                }
-                if (Arg::isDef(role))
-                    insertionSet.insert(instIndex + 1, move, inst.origin, tmp, arg);
-            });
-        }
-        insertionSet.execute(block);
-    }
-}
-
 template<Arg::Type type>
 static void iteratedRegisterCoalescingOnType(Code& code)
 {
@@ -888,7 +832,7 @@ static void iteratedRegisterCoalescingOnType(Code& code)
             assignRegisterToTmpInProgram(code, allocator);
             return;
         }
-        addSpillAndFillToProgram<type>(code, allocator.spilledTmp());
+        spillTmps(code, type, allocator.spilledTmp());
     }
 }
 
@@ -924,14 +868,14 @@ void iteratedRegisterCoalescing(Code& code)
             assignRegisterToTmpInProgram(code, gpAllocator);
             gpIsColored = true;
         } else
-            addSpillAndFillToProgram<Arg::GP>(code, gpAllocator.spilledTmp());
+            spillTmps(code, Arg::GP, gpAllocator.spilledTmp());
 
         fpAllocator.allocate();
         if (fpAllocator.spilledTmp().isEmpty()) {
             assignRegisterToTmpInProgram(code, fpAllocator);
             fpIsColored = true;
         } else
-            addSpillAndFillToProgram<Arg::FP>(code, fpAllocator.spilledTmp());
+            spillTmps(code, Arg::FP, fpAllocator.spilledTmp());
     };
 
     if (!gpIsColored)
@@ -0,0 +1,299 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "AirLinearScanRegisterAllocation.h"
+
+#if ENABLE(B3_JIT)
+
+#include "AirCode.h"
+#include "AirInstInlines.h"
+#include "AirLiveness.h"
+#include "AirPhaseScope.h"
+#include "AirRegisterPriority.h"
+#include "AirSpillTmps.h"
+#include <algorithm>
+
+namespace JSC { namespace B3 { namespace Air {
+
+namespace {
+
+// Every instruction owns two consecutive points. It reads its uses at the first and writes its
+// defs at the second. So, a Tmp that dies at an instruction does not overlap with a Tmp that the
+// same instruction defines, which matches the interference rules of iteratedRegisterCoalescing().
+unsigned usePoint(unsigned instPosition)
+{
+    return instPosition * 2;
+}
+
+unsigned defPoint(unsigned instPosition)
+{
+    return instPosition * 2 + 1;
+}
+
+struct Interval {
+    bool isEmpty() const { return start > end; }
+
+    void add(unsigned point)
+    {
+        start = std::min(start, point);
+        end = std::max(end, point);
+    }
+
+    unsigned start { UINT_MAX };
+    unsigned end { 0 };
+};
+
+bool hasPointInRange(const Vector<unsigned>& sortedPoints, unsigned low, unsigned high)
+{
+    auto iter = std::lower_bound(sortedPoints.begin(), sortedPoints.end(), low);
+    return iter != sortedPoints.end() && *iter <= high;
+}
+
+template<Arg::Type type>
+class LinearScanAllocator {
+public:
+    LinearScanAllocator(Code& code)
+        : m_code(code)
+        , m_intervals(code.numTmps(type))
+        , m_assignedRegs(code.numTmps(type))
+        , m_busyPoints(Reg::last().index() + 1)
+        , m_clobberPoints(Reg::last().index() + 1)
+    {
+    }
+
+    void build(Liveness<Tmp>& liveness)
+    {
+        unsigned blockStart = 0;
+        for (BasicBlock* block : m_code) {
+            Liveness<Tmp>::LocalCalc localCalc(liveness, block);
+            for (unsigned instIndex = block->size(); instIndex--;) {
+                Inst& inst = block->at(instIndex);
+                unsigned instPosition = blockStart + instIndex;
+
+                for (Tmp tmp : localCalc.live())
+                    addPoint(tmp, defPoint(instPosition));
+
+                // Dead defs still need a register of their own.
+                inst.forEachTmp([&] (Tmp& tmp, Arg::Role role, Arg::Type argType) {
+                    if (argType != type)
+                        return;
+                    if (Arg::isDef(role))
+                        addPoint(tmp, defPoint(instPosition));
+                });
+
+                // A clobbered register is only a problem for Tmps that live across the instruction.
+                if (inst.hasSpecial()) {
+                    inst.extraClobberedRegs().forEach([&] (Reg reg) {
+                        if (reg.isGPR() == (type == Arg::GP))
+                            m_clobberPoints[reg.index()].append(usePoint(instPosition));
+                    });
+                }
+
+                localCalc.execute(inst);
+
+                for (Tmp tmp : localCalc.live())
+                    addPoint(tmp, usePoint(instPosition));
+            }
+            blockStart += block->size();
+        }
+
+        for (Vector<unsigned>& points : m_busyPoints)
+            std::sort(points.begin(), points.end());
+        for (Vector<unsigned>& points : m_clobberPoints)
+            std::sort(points.begin(), points.end());
+    }
+
+    void allocate()
+    {
+        Vector<unsigned> unhandled;
+        for (unsigned tmpIndex = 0; tmpIndex < m_intervals.size(); ++tmpIndex) {
+            if (!m_intervals[tmpIndex].isEmpty())
+                unhandled.append(tmpIndex);
+        }
+        std::sort(
+            unhandled.begin(), unhandled.end(),
+            [&] (unsigned a, unsigned b) {
+                return m_intervals[a].start < m_intervals[b].start;
+            });
+
+        const Vector<Reg>& registers = regsInPriorityOrder(type);
+        Vector<unsigned> active;
+        for (unsigned tmpIndex : unhandled) {
+            const Interval& interval = m_intervals[tmpIndex];
+
+            active.removeAllMatching(
+                [&] (unsigned activeIndex) {
+                    return m_intervals[activeIndex].end < interval.start;
+                });
+
+            RegisterSet activeRegs;
+            for (unsigned activeIndex : active)
+                activeRegs.set(m_assignedRegs[activeIndex]);
+
+            Reg reg;
+            for (Reg candidate : registers) {
+                if (!activeRegs.get(candidate) && isAvailable(candidate, interval)) {
+                    reg = candidate;
+                    break;
+                }
+            }
+
+            if (!reg) {
+                // Spill whichever interval ends last, provided that its register can hold this one.
+                size_t victim = notFound;
+                for (size_t i = 0; i < active.size(); ++i) {
+                    unsigned activeIndex = active[i];
+                    if (m_intervals[activeIndex].end <= interval.end)
+                        continue;
+                    if (!isAvailable(m_assignedRegs[activeIndex], interval))
+                        continue;
+                    if (victim == notFound || m_intervals[activeIndex].end > m_intervals[active[victim]].end)
+                        victim = i;
+                }
+
+                if (victim == notFound) {
+                    m_spilledTmps.add(tmpForIndex(tmpIndex));
+                    continue;
+                }
+
+                unsigned victimIndex = active[victim];
+                reg = m_assignedRegs[victimIndex];
+                m_assignedRegs[victimIndex] = Reg();
+                m_spilledTmps.add(tmpForIndex(victimIndex));
+                active.remove(victim);
+            }
+
+            m_assignedRegs[tmpIndex] = reg;
+            active.append(tmpIndex);
+        }
+    }
+
+    const HashSet<Tmp>& spilledTmps() const { return m_spilledTmps; }
+
+    void assignRegistersInProgram()
+    {
+        Opcode move = type == Arg::GP ? Move : MoveDouble;
+
+        for (BasicBlock* block : m_code) {
+            for (Inst& inst : block->insts()) {
+                inst.forEachTmpFast([&] (Tmp& tmp) {
+                    if (tmp.isReg() || tmp.isGP() != (type == Arg::GP))
+                        return;
+
+                    Reg reg = m_assignedRegs[tmp.tmpIndex()];
+                    ASSERT(reg);
+                    tmp = Tmp(reg);
+                });
+            }
+
+            block->insts().removeAllMatching(
+                [&] (const Inst& inst) {
+                    return inst.opcode == move
+                        && inst.args[0].isTmp() && inst.args[1].isTmp()
+                        && inst.args[0].tmp() == inst.args[1].tmp();
+                });
+        }
+    }
+
+private:
+    static Tmp tmpForIndex(unsigned tmpIndex)
+    {
+        return type == Arg::GP ? Tmp::gpTmpForIndex(tmpIndex) : Tmp::fpTmpForIndex(tmpIndex);
+    }
+
+    void addPoint(Tmp tmp, unsigned point)
+    {
+        if (tmp.isGP() != (type == Arg::GP))
+            return;
+
+        if (tmp.isReg())
+            m_busyPoints[tmp.reg().index()].append(point);
+        else
+            m_intervals[tmp.tmpIndex()].add(point);
+    }
+
+    bool isAvailable(Reg reg, const Interval& interval) const
+    {
+        if (hasPointInRange(m_busyPoints[reg.index()], interval.start, interval.end))
+            return false;
+
+        // A clobber at an instruction conflicts only with intervals that cover both of its points.
+        if (interval.start == interval.end)
+            return true;
+        return !hasPointInRange(m_clobberPoints[reg.index()], interval.start, interval.end - 1);
+    }
+
+    Code& m_code;
+
+    // Indexed by Tmp index.
+    Vector<Interval> m_intervals;
+    Vector<Reg> m_assignedRegs;
+
+    // Indexed by Reg index. These are sorted once build() is done.
+    Vector<Vector<unsigned>> m_busyPoints;
+    Vector<Vector<unsigned>> m_clobberPoints;
+
+    HashSet<Tmp> m_spilledTmps;
+};
+
+template<Arg::Type type>
+bool linearScanRegisterAllocationOnType(Code& code, Liveness<Tmp>& liveness)
+{
+    LinearScanAllocator<type> allocator(code);
+    allocator.build(liveness);
+    allocator.allocate();
+    if (!allocator.spilledTmps().isEmpty()) {
+        spillTmps(code, type, allocator.spilledTmps());
+        return false;
+    }
+    allocator.assignRegistersInProgram();
+    return true;
+}
+
+} // anonymous namespace
+
+void linearScanRegisterAllocation(Code& code)
+{
+    PhaseScope phaseScope(code, "linearScanRegisterAllocation");
+
+    bool gpIsAllocated = false;
+    bool fpIsAllocated = false;
+
+    while (!gpIsAllocated || !fpIsAllocated) {
+        // Liveness is the most expensive part of this phase, so both banks share it. Spilling one
+        // bank does not change the liveness of the other.
+        Liveness<Tmp> liveness(code);
+
+        if (!gpIsAllocated)
+            gpIsAllocated = linearScanRegisterAllocationOnType<Arg::GP>(code, liveness);
+        if (!fpIsAllocated)
+            fpIsAllocated = linearScanRegisterAllocationOnType<Arg::FP>(code, liveness);
+    }
+}
+
+} } } // namespace JSC::B3::Air
+
+#endif // ENABLE(B3_JIT)
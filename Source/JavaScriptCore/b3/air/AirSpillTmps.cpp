@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "AirSpillTmps.h"
+
+#if ENABLE(B3_JIT)
+
+#include "AirCode.h"
+#include "AirInsertionSet.h"
+#include "AirInstInlines.h"
+#include <wtf/HashMap.h>
+
+namespace JSC { namespace B3 { namespace Air {
+
+void spillTmps(Code& code, Arg::Type type, const HashSet<Tmp>& spilledTmps)
+{
+    // Allocate stack slot for each spilled value.
+    HashMap<Tmp, StackSlot*> stackSlots;
+    for (Tmp tmp : spilledTmps) {
+        bool isNewTmp = stackSlots.add(tmp, code.addStackSlot(8, StackSlotKind::Anonymous)).isNewEntry;
+        ASSERT_UNUSED(isNewTmp, isNewTmp);
+    }
+
+    // Rewrite the program to get rid of the spilled Tmp.
+    InsertionSet insertionSet(code);
+    for (BasicBlock* block : code) {
+        for (unsigned instIndex = 0; instIndex < block->size(); ++instIndex) {
+            Inst& inst = block->at(instIndex);
+
+            // Try to replace the register use by memory use when possible.
+            for (unsigned i = 0; i < inst.args.size(); ++i) {
+                Arg& arg = inst.args[i];
+                if (arg.isTmp() && arg.type() == type && !arg.isReg()) {
+                    auto stackSlotEntry = stackSlots.find(arg.tmp());
+                    if (stackSlotEntry == stackSlots.end())
+                        continue;
+
+                    if (inst.admitsStack(i)) {
+                        arg = Arg::stack(stackSlotEntry->value);
+                        continue;
+                    }
+                }
+            }
+
+            // For every other case, add Load/Store as needed.
+            inst.forEachTmp([&] (Tmp& tmp, Arg::Role role, Arg::Type argType) {
+                if (tmp.isReg() || argType != type)
+                    return;
+
+                auto stackSlotEntry = stackSlots.find(tmp);
+                if (stackSlotEntry == stackSlots.end())
+                    return;
+
+                Arg arg = Arg::stack(stackSlotEntry->value);
+                Opcode move = type == Arg::GP ? Move : MoveDouble;
+
+                if (Arg::isUse(role)) {
+                    Tmp newTmp = code.newTmp(type);
+                    insertionSet.insert(instIndex, move, inst.origin, arg, newTmp);
+                    tmp = newTmp;
+                }
+                if (Arg::isDef(role))
+                    insertionSet.insert(instIndex + 1, move, inst.origin, tmp, arg);
+            });
+        }
+        insertionSet.execute(block);
+    }
+}
+
+} } } // namespace JSC::B3::Air
+
+#endif // ENABLE(B3_JIT)
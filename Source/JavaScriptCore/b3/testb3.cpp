@@ -2054,50 +2054,303 @@ void testLoad(B3::Opcode opcode, int32_t value)
     }
 }
 
-void testSpillGP()
+unsigned countOpcode(Procedure& proc, B3::Opcode opcode)
+{
+    unsigned result = 0;
+    for (Value* value : proc.values()) {
+        if (value->opcode() == opcode)
+            result++;
+    }
+    return result;
+}
+
+void testPureCSE(int a, int b)
 {
     Procedure proc;
     BasicBlock* root = proc.addBlock();
+    BasicBlock* thenCase = proc.addBlock();
+    BasicBlock* elseCase = proc.addBlock();
 
-    Vector<Value*> sources;
-    sources.append(root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0));
-    sources.append(root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR1));
+    Value* argA = root->appendNew<Value>(
+        proc, Trunc, Origin(),
+        root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0));
+    Value* argB = root->appendNew<Value>(
+        proc, Trunc, Origin(),
+        root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR1));
+    Value* mul = root->appendNew<Value>(proc, Mul, Origin(), argA, argB);
+    root->appendNew<ControlValue>(
+        proc, Branch, Origin(), mul,
+        FrequentedBlock(thenCase), FrequentedBlock(elseCase));
 
-    for (unsigned i = 0; i < 30; ++i) {
-        sources.append(
-            root->appendNew<Value>(proc, Add, Origin(), sources[sources.size() - 1], sources[sources.size() - 2])
-        );
-    }
+    thenCase->appendNew<ControlValue>(
+        proc, Return, Origin(),
+        thenCase->appendNew<Value>(
+            proc, Add, Origin(),
+            thenCase->appendNew<Value>(proc, Mul, Origin(), argA, argB),
+            thenCase->appendNew<Const32Value>(proc, Origin(), 1)));
 
-    Value* total = root->appendNew<Const64Value>(proc, Origin(), 0);
-    for (Value* value : sources)
-        total = root->appendNew<Value>(proc, Add, Origin(), total, value);
+    elseCase->appendNew<ControlValue>(
+        proc, Return, Origin(),
+        elseCase->appendNew<Const32Value>(proc, Origin(), 0));
 
-    root->appendNew<ControlValue>(proc, Return, Origin(), total);
-    compileAndRun<int>(proc, 1, 2);
+    auto code = compile(proc);
+    CHECK(countOpcode(proc, Mul) == 1);
+    CHECK(invoke<int>(*code, a, b) == (a * b ? a * b + 1 : 0));
 }
 
-void testSpillFP()
+void testLoadCSEAcrossBlocks(int value)
 {
     Procedure proc;
     BasicBlock* root = proc.addBlock();
+    BasicBlock* thenCase = proc.addBlock();
+    BasicBlock* elseCase = proc.addBlock();
 
-    Vector<Value*> sources;
-    sources.append(root->appendNew<ArgumentRegValue>(proc, Origin(), FPRInfo::argumentFPR0));
-    sources.append(root->appendNew<ArgumentRegValue>(proc, Origin(), FPRInfo::argumentFPR1));
+    int slot = value;
+    Value* load = root->appendNew<MemoryValue>(
+        proc, Load, Int32, Origin(),
+        root->appendNew<ConstPtrValue>(proc, Origin(), &slot));
+    root->appendNew<ControlValue>(
+        proc, Branch, Origin(), load,
+        FrequentedBlock(thenCase), FrequentedBlock(elseCase));
 
-    for (unsigned i = 0; i < 30; ++i) {
-        sources.append(
-            root->appendNew<Value>(proc, Add, Origin(), sources[sources.size() - 1], sources[sources.size() - 2])
-        );
-    }
+    thenCase->appendNew<ControlValue>(
+        proc, Return, Origin(),
+        thenCase->appendNew<Value>(
+            proc, Add, Origin(), load,
+            thenCase->appendNew<MemoryValue>(
+                proc, Load, Int32, Origin(),
+                thenCase->appendNew<ConstPtrValue>(proc, Origin(), &slot))));
+
+    elseCase->appendNew<ControlValue>(
+        proc, Return, Origin(),
+        elseCase->appendNew<Const32Value>(proc, Origin(), 42));
+
+    auto code = compile(proc);
+    CHECK(countOpcode(proc, Load) == 1);
+    CHECK(invoke<int>(*code) == (value ? value * 2 : 42));
+}
+
+void testLoadCSEClobberedByStore(int value)
+{
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    BasicBlock* thenCase = proc.addBlock();
+    BasicBlock* elseCase = proc.addBlock();
+    BasicBlock* continuation = proc.addBlock();
+
+    int slot = value;
+    int otherSlot = 0;
+    Value* load = root->appendNew<MemoryValue>(
+        proc, Load, Int32, Origin(),
+        root->appendNew<ConstPtrValue>(proc, Origin(), &slot));
+    root->appendNew<ControlValue>(
+        proc, Branch, Origin(), load,
+        FrequentedBlock(thenCase), FrequentedBlock(elseCase));
+
+    // Nothing tells B3 that these two slots don't alias, so this store has to kill the load.
+    thenCase->appendNew<MemoryValue>(
+        proc, Store, Origin(),
+        thenCase->appendNew<Const32Value>(proc, Origin(), 1),
+        thenCase->appendNew<ConstPtrValue>(proc, Origin(), &otherSlot));
+    thenCase->appendNew<ControlValue>(proc, Jump, Origin(), FrequentedBlock(continuation));
+
+    elseCase->appendNew<ControlValue>(proc, Jump, Origin(), FrequentedBlock(continuation));
+
+    continuation->appendNew<ControlValue>(
+        proc, Return, Origin(),
+        continuation->appendNew<Value>(
+            proc, Add, Origin(), load,
+            continuation->appendNew<MemoryValue>(
+                proc, Load, Int32, Origin(),
+                continuation->appendNew<ConstPtrValue>(proc, Origin(), &slot))));
+
+    auto code = compile(proc);
+    CHECK(countOpcode(proc, Load) == 2);
+    CHECK(invoke<int>(*code) == value * 2);
+    CHECK(otherSlot == !!value);
+}
+
+void testStoreLoadForwarding(int value)
+{
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+
+    int slot = 0;
+    Value* argument = root->appendNew<Value>(
+        proc, Trunc, Origin(),
+        root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0));
+    root->appendNew<MemoryValue>(
+        proc, Store, Origin(), argument,
+        root->appendNew<ConstPtrValue>(proc, Origin(), &slot));
+    root->appendNew<ControlValue>(
+        proc, Return, Origin(),
+        root->appendNew<MemoryValue>(
+            proc, Load, Int32, Origin(),
+            root->appendNew<ConstPtrValue>(proc, Origin(), &slot)));
+
+    auto code = compile(proc);
+    CHECK(!countOpcode(proc, Load));
+    CHECK(invoke<int>(*code, value) == value);
+    CHECK(slot == value);
+}
+
+// Builds a do-while loop that adds 'makeInvariant()' to a sum 'n' times and returns the sum.
+template<typename Functor>
+BasicBlock* buildInvariantSumLoop(Procedure& proc, const Functor& makeInvariant)
+{
+    BasicBlock* root = proc.addBlock();
+    BasicBlock* loop = proc.addBlock();
+    BasicBlock* done = proc.addBlock();
+
+    Value* n = root->appendNew<Value>(
+        proc, Trunc, Origin(),
+        root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0));
+    UpsilonValue* initialIndex = root->appendNew<UpsilonValue>(
+        proc, Origin(), root->appendNew<Const32Value>(proc, Origin(), 0));
+    UpsilonValue* initialSum = root->appendNew<UpsilonValue>(
+        proc, Origin(), root->appendNew<Const32Value>(proc, Origin(), 0));
+    root->appendNew<ControlValue>(proc, Jump, Origin(), FrequentedBlock(loop));
+
+    Value* index = loop->appendNew<Value>(proc, Phi, Int32, Origin());
+    Value* sum = loop->appendNew<Value>(proc, Phi, Int32, Origin());
+    Value* newSum = loop->appendNew<Value>(proc, Add, Origin(), sum, makeInvariant(root, loop));
+    Value* newIndex = loop->appendNew<Value>(
+        proc, Add, Origin(), index, loop->appendNew<Const32Value>(proc, Origin(), 1));
+    initialIndex->setPhi(index);
+    initialSum->setPhi(sum);
+    loop->appendNew<UpsilonValue>(proc, Origin(), newIndex, index);
+    loop->appendNew<UpsilonValue>(proc, Origin(), newSum, sum);
+    loop->appendNew<ControlValue>(
+        proc, Branch, Origin(),
+        loop->appendNew<Value>(proc, LessThan, Origin(), newIndex, n),
+        FrequentedBlock(loop), FrequentedBlock(done));
+
+    done->appendNew<ControlValue>(proc, Return, Origin(), newSum);
+    return loop;
+}
+
+void testHoistPureValue(int n, int a, int b)
+{
+    Procedure proc;
+    Value* mul = nullptr;
+    BasicBlock* loop = buildInvariantSumLoop(
+        proc,
+        [&] (BasicBlock* root, BasicBlock* loop) -> Value* {
+            Value* argA = root->appendNew<Value>(
+                proc, Trunc, Origin(),
+                root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR1));
+            Value* argB = root->appendNew<Value>(
+                proc, Trunc, Origin(),
+                root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR2));
+            mul = loop->appendNew<Value>(proc, Mul, Origin(), argA, argB);
+            return mul;
+        });
+
+    auto code = compile(proc);
+    CHECK(!loop->values().contains(mul));
+    CHECK(invoke<int>(*code, n, a, b) == std::max(n, 1) * a * b);
+}
+
+void testHoistLoad(int n, int value)
+{
+    Procedure proc;
+    int slot = value;
+    Value* load = nullptr;
+    BasicBlock* loop = buildInvariantSumLoop(
+        proc,
+        [&] (BasicBlock*, BasicBlock* loop) -> Value* {
+            load = loop->appendNew<MemoryValue>(
+                proc, Load, Int32, Origin(),
+                loop->appendNew<ConstPtrValue>(proc, Origin(), &slot));
+            return load;
+        });
+
+    auto code = compile(proc);
+    CHECK(!loop->values().contains(load));
+    CHECK(invoke<int>(*code, n) == std::max(n, 1) * value);
+}
+
+void testDontHoistClobberedLoad(int n, int value)
+{
+    Procedure proc;
+    int slot = value;
+    Value* load = nullptr;
+    BasicBlock* loop = buildInvariantSumLoop(
+        proc,
+        [&] (BasicBlock*, BasicBlock* loop) -> Value* {
+            Value* pointer = loop->appendNew<ConstPtrValue>(proc, Origin(), &slot);
+            load = loop->appendNew<MemoryValue>(proc, Load, Int32, Origin(), pointer);
+            loop->appendNew<MemoryValue>(
+                proc, Store, Origin(),
+                loop->appendNew<Value>(
+                    proc, Add, Origin(), load, loop->appendNew<Const32Value>(proc, Origin(), 1)),
+                pointer);
+            return load;
+        });
+
+    auto code = compile(proc);
+    CHECK(loop->values().contains(load));
+
+    // The loop adds value, value + 1, ..., value + n - 1.
+    int iterations = std::max(n, 1);
+    CHECK(invoke<int>(*code, n) == iterations * value + iterations * (iterations - 1) / 2);
+    CHECK(slot == value + iterations);
+}
+
+void testSpillGP()
+{
+    auto test = [&] (unsigned optLevel) {
+        Procedure proc;
+        BasicBlock* root = proc.addBlock();
+
+        Vector<Value*> sources;
+        sources.append(root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0));
+        sources.append(root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR1));
+
+        for (unsigned i = 0; i < 30; ++i) {
+            sources.append(
+                root->appendNew<Value>(proc, Add, Origin(), sources[sources.size() - 1], sources[sources.size() - 2])
+            );
+        }
+
+        Value* total = root->appendNew<Const64Value>(proc, Origin(), 0);
+        for (Value* value : sources)
+            total = root->appendNew<Value>(proc, Add, Origin(), total, value);
 
-    Value* total = root->appendNew<ConstDoubleValue>(proc, Origin(), 0.);
-    for (Value* value : sources)
-        total = root->appendNew<Value>(proc, Add, Origin(), total, value);
+        root->appendNew<ControlValue>(proc, Return, Origin(), total);
+        invoke<int>(*compile(proc, optLevel), 1, 2);
+    };
 
-    root->appendNew<ControlValue>(proc, Return, Origin(), total);
-    compileAndRun<double>(proc, 1.1, 2.5);
+    test(0);
+    test(1);
+}
+
+void testSpillFP()
+{
+    auto test = [&] (unsigned optLevel) {
+        Procedure proc;
+        BasicBlock* root = proc.addBlock();
+
+        Vector<Value*> sources;
+        sources.append(root->appendNew<ArgumentRegValue>(proc, Origin(), FPRInfo::argumentFPR0));
+        sources.append(root->appendNew<ArgumentRegValue>(proc, Origin(), FPRInfo::argumentFPR1));
+
+        for (unsigned i = 0; i < 30; ++i) {
+            sources.append(
+                root->appendNew<Value>(proc, Add, Origin(), sources[sources.size() - 1], sources[sources.size() - 2])
+            );
+        }
+
+        Value* total = root->appendNew<ConstDoubleValue>(proc, Origin(), 0.);
+        for (Value* value : sources)
+            total = root->appendNew<Value>(proc, Add, Origin(), total, value);
+
+        root->appendNew<ControlValue>(proc, Return, Origin(), total);
+        invoke<double>(*compile(proc, optLevel), 1.1, 2.5);
+    };
+
+    test(0);
+    test(1);
 }
 
 void testBranch()
@@ -2693,6 +2946,55 @@ void testPatchpointCallArg()
     CHECK(compileAndRun<int>(proc, 1, 2) == 3);
 }
 
+void testVectorPatchpoint()
+{
+    if (!MacroAssembler::supportsVector())
+        return;
+
+    Procedure proc;
+    BasicBlock* root = proc.addBlock();
+    Value* left = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR0);
+    Value* right = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR1);
+    Value* result = root->appendNew<ArgumentRegValue>(proc, Origin(), GPRInfo::argumentGPR2);
+    PatchpointValue* patchpoint = root->appendNew<PatchpointValue>(proc, Void, Origin());
+    patchpoint->append(ConstrainedValue(left, ValueRep::SomeRegister));
+    patchpoint->append(ConstrainedValue(right, ValueRep::SomeRegister));
+    patchpoint->append(ConstrainedValue(result, ValueRep::SomeRegister));
+    RegisterSet clobbered;
+    clobbered.set(FPRInfo::fpRegT0);
+    clobbered.set(FPRInfo::fpRegT1);
+    patchpoint->clobber(clobbered);
+    patchpoint->effects = Effects::forCall();
+    patchpoint->setGenerator(
+        [&] (CCallHelpers& jit, const StackmapGenerationParams& params) {
+            CHECK(params.reps.size() == 3);
+            GPRReg leftGPR = params.reps[0].gpr();
+            GPRReg rightGPR = params.reps[1].gpr();
+            GPRReg resultGPR = params.reps[2].gpr();
+            jit.loadVector(CCallHelpers::Address(leftGPR), FPRInfo::fpRegT0);
+            jit.loadVector(CCallHelpers::Address(rightGPR), FPRInfo::fpRegT1);
+            jit.addInt32x4(FPRInfo::fpRegT1, FPRInfo::fpRegT0);
+            jit.storeVector(FPRInfo::fpRegT0, CCallHelpers::Address(resultGPR));
+            jit.subInt32x4(FPRInfo::fpRegT1, FPRInfo::fpRegT0);
+            jit.shuffle32x4(CCallHelpers::TrustedImm32(0x1b), FPRInfo::fpRegT0, FPRInfo::fpRegT0);
+            jit.storeVector(FPRInfo::fpRegT0, CCallHelpers::Address(resultGPR, 16));
+            jit.splatInt32x4(leftGPR, FPRInfo::fpRegT1);
+            jit.moveVector(FPRInfo::fpRegT1, FPRInfo::fpRegT0);
+            jit.storeVector(FPRInfo::fpRegT0, CCallHelpers::Address(resultGPR, 32));
+        });
+    root->appendNew<ControlValue>(proc, Return, Origin(), root->appendNew<Const32Value>(proc, Origin(), 0));
+
+    int32_t leftValues[4] = { 1, 2, 3, 4 };
+    int32_t rightValues[4] = { 10, 20, 30, 40 };
+    int32_t resultValues[12];
+    CHECK(!compileAndRun<int>(proc, leftValues, rightValues, resultValues));
+    for (unsigned i = 0; i < 4; ++i) {
+        CHECK(resultValues[i] == leftValues[i] + rightValues[i]);
+        CHECK(resultValues[4 + i] == leftValues[3 - i]);
+        CHECK(resultValues[8 + i] == static_cast<int32_t>(bitwise_cast<intptr_t>(leftValues)));
+    }
+}
+
 void testSimpleCheck()
 {
     Procedure proc;
@@ -3841,6 +4143,7 @@ void run(const char* filter)
 
     RUN(testSimplePatchpoint());
     RUN(testPatchpointCallArg());
+    RUN(testVectorPatchpoint());
     RUN(testSimpleCheck());
     RUN(testCheckLessThan());
     RUN(testCheckMegaCombo());
@@ -3904,6 +4207,22 @@ void run(const char* filter)
     RUN(testLoad<uint16_t>(Load16Z, 1000000000));
     RUN(testLoad<uint16_t>(Load16Z, -1000000000));
 
+    RUN(testPureCSE(3, 4));
+    RUN(testPureCSE(0, 4));
+    RUN(testLoadCSEAcrossBlocks(0));
+    RUN(testLoadCSEAcrossBlocks(21));
+    RUN(testLoadCSEClobberedByStore(0));
+    RUN(testLoadCSEClobberedByStore(21));
+    RUN(testStoreLoadForwarding(0));
+    RUN(testStoreLoadForwarding(42));
+
+    RUN(testHoistPureValue(0, 3, 4));
+    RUN(testHoistPureValue(10, 3, 4));
+    RUN(testHoistLoad(0, 5));
+    RUN(testHoistLoad(10, 5));
+    RUN(testDontHoistClobberedLoad(0, 5));
+    RUN(testDontHoistClobberedLoad(10, 5));
+
     RUN(testSpillGP());
     RUN(testSpillFP());
 
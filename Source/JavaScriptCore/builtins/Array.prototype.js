@@ -488,6 +488,13 @@ function sort(comparator)
         var right = leftEnd;
         var rightEnd = min(right + width, srcEnd);
 
+        // Runs that are already in order, as in mostly sorted input, are copied without being merged.
+        if (right < rightEnd && comparator(src[right], src[leftEnd - 1]) >= 0) {
+            for (var dstIndex = left; dstIndex < rightEnd; ++dstIndex)
+                dst[dstIndex] = src[dstIndex];
+            return;
+        }
+
         for (var dstIndex = left; dstIndex < rightEnd; ++dstIndex) {
             if (right < rightEnd) {
                 if (left >= leftEnd || comparator(src[right], src[left]) < 0) {
@@ -500,14 +507,30 @@ function sort(comparator)
         }
     }
 
+    function insertionSort(array, begin, end, comparator)
+    {
+        for (var i = begin + 1; i < end; ++i) {
+            var value = array[i];
+            var j = i;
+            for (; j > begin && comparator(value, array[j - 1]) < 0; --j)
+                array[j] = array[j - 1];
+            array[j] = value;
+        }
+    }
+
     function mergeSort(array, valueCount, comparator)
     {
+        // Merging from runs of one element spends most of its time on tiny merges, so sort short runs in place first.
+        var runWidth = 8;
+        for (var begin = 0; begin < valueCount; begin += runWidth)
+            insertionSort(array, begin, min(begin + runWidth, valueCount), comparator);
+
         var buffer = [ ];
         buffer.length = valueCount;
 
         var dst = buffer;
         var src = array;
-        for (var width = 1; width < valueCount; width *= 2) {
+        for (var width = runWidth; width < valueCount; width *= 2) {
             for (var srcIndex = 0; srcIndex < valueCount; srcIndex += 2 * width)
                 merge(dst, src, srcIndex, valueCount, width, comparator);
 
@@ -577,6 +600,9 @@ function sort(comparator)
         if (length < 2)
             return;
 
+        if (@arraySortWithoutComparator(array, length))
+            return;
+
         var valueCount = compact(array, length);
 
         var strings = new @Array(valueCount);
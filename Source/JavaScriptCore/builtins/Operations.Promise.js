@@ -85,7 +85,7 @@ function triggerPromiseReactions(reactions, argument)
     "use strict";
 
     for (var index = 0, length = reactions.length; index < length; ++index)
-        @enqueueJob(@promiseReactionJob, [reactions[index], argument]);
+        @enqueueJob(@promiseReactionJob, reactions[index], argument);
 }
 
 function rejectPromise(promise, reason)
@@ -145,7 +145,7 @@ function createResolvingFunctions(promise)
         if (typeof then !== 'function')
             return @fulfillPromise(promise, resolution);
 
-        @enqueueJob(@promiseResolveThenableJob, [promise, resolution, then]);
+        @enqueueJob(@promiseResolveThenableJob, promise, resolution, then);
 
         return undefined;
     };
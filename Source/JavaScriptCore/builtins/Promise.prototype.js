@@ -49,18 +49,16 @@ function then(onFulfilled, onRejected)
     if (typeof onRejected !== "function")
         onRejected = function (argument) { throw argument; };
 
-    var fulfillReaction = @newPromiseReaction(resultCapability, onFulfilled);
-    var rejectReaction = @newPromiseReaction(resultCapability, onRejected);
-
     var state = this.@promiseState;
 
+    // A settled promise only needs the reaction that runs now.
     if (state === @promisePending) {
-        @putByValDirect(this.@promiseFulfillReactions, this.@promiseFulfillReactions.length, fulfillReaction)
-        @putByValDirect(this.@promiseRejectReactions, this.@promiseRejectReactions.length, rejectReaction)
+        @putByValDirect(this.@promiseFulfillReactions, this.@promiseFulfillReactions.length, @newPromiseReaction(resultCapability, onFulfilled))
+        @putByValDirect(this.@promiseRejectReactions, this.@promiseRejectReactions.length, @newPromiseReaction(resultCapability, onRejected))
     } else if (state === @promiseFulfilled)
-        @enqueueJob(@promiseReactionJob, [fulfillReaction, this.@promiseResult]);
+        @enqueueJob(@promiseReactionJob, @newPromiseReaction(resultCapability, onFulfilled), this.@promiseResult);
     else if (state === @promiseRejected)
-        @enqueueJob(@promiseReactionJob, [rejectReaction, this.@promiseResult]);
+        @enqueueJob(@promiseReactionJob, @newPromiseReaction(resultCapability, onRejected), this.@promiseResult);
 
     return resultCapability.@promise;
 }
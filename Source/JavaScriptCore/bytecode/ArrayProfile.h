@@ -228,6 +228,16 @@ public:
     bool outOfBounds(const ConcurrentJITLocker&) const { return m_outOfBounds; }
     
     bool usesOriginalArrayStructures(const ConcurrentJITLocker&) const { return m_usesOriginalArrayStructures; }
+
+    // Seeds the profile with what an earlier run observed at the same access.
+    void mergeObservations(const ConcurrentJITLocker&, ArrayModes arrayModes, bool mayStoreToHole, bool outOfBounds, bool mayInterceptIndexedAccesses, bool usesOriginalArrayStructures)
+    {
+        m_observedArrayModes |= arrayModes;
+        m_mayStoreToHole |= mayStoreToHole;
+        m_outOfBounds |= outOfBounds;
+        m_mayInterceptIndexedAccesses |= mayInterceptIndexedAccesses;
+        m_usesOriginalArrayStructures &= usesOriginalArrayStructures;
+    }
     
     CString briefDescription(const ConcurrentJITLocker&, CodeBlock*);
     CString briefDescriptionWithoutUpdating(const ConcurrentJITLocker&);
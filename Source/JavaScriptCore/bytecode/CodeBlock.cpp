@@ -53,6 +53,7 @@
 #include "LowLevelInterpreter.h"
 #include "JSCInlines.h"
 #include "PolymorphicAccess.h"
+#include "ProfileSnapshot.h"
 #include "ProfilerDatabase.h"
 #include "ReduceWhitespace.h"
 #include "Repatch.h"
@@ -1685,6 +1686,7 @@ CodeBlock::CodeBlock(VM* vm, Structure* structure, CopyParsedBlockTag, CodeBlock
     , m_optimizationDelayCounter(0)
     , m_reoptimizationRetryCounter(0)
     , m_creationTime(std::chrono::steady_clock::now())
+    , m_lastExecutionTime(m_creationTime)
     , m_hash(other.m_hash)
 #if ENABLE(JIT)
     , m_capabilityLevelState(DFG::CapabilityLevelNotSet)
@@ -1747,6 +1749,7 @@ CodeBlock::CodeBlock(VM* vm, Structure* structure, ScriptExecutable* ownerExecut
     , m_optimizationDelayCounter(0)
     , m_reoptimizationRetryCounter(0)
     , m_creationTime(std::chrono::steady_clock::now())
+    , m_lastExecutionTime(m_creationTime)
 #if ENABLE(JIT)
     , m_capabilityLevelState(DFG::CapabilityLevelNotSet)
 #endif
@@ -2197,6 +2200,9 @@ void CodeBlock::finishCreation(VM& vm, ScriptExecutable* ownerExecutable, Unlink
     optimizeAfterWarmUp();
     jitAfterWarmUp();
 
+    if (ProfileSnapshot* profileSnapshot = vm.profileSnapshot())
+        profileSnapshot->apply(this);
+
     // If the concurrent thread will want the code block's hash, then compute it here
     // synchronously.
     if (Options::alwaysComputeHash())
@@ -2232,6 +2238,7 @@ CodeBlock::CodeBlock(VM* vm, Structure* structure, WebAssemblyExecutable* ownerE
     , m_optimizationDelayCounter(0)
     , m_reoptimizationRetryCounter(0)
     , m_creationTime(std::chrono::steady_clock::now())
+    , m_lastExecutionTime(m_creationTime)
 #if ENABLE(JIT)
     , m_capabilityLevelState(DFG::CannotCompile)
 #endif
@@ -2415,9 +2422,47 @@ bool CodeBlock::shouldJettisonDueToWeakReference()
     return !Heap::isMarked(this);
 }
 
+static std::chrono::milliseconds timeToLive(JITCode::JITType jitType)
+{
+    switch (jitType) {
+    case JITCode::InterpreterThunk:
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::seconds(5));
+    case JITCode::BaselineJIT:
+        // Effectively 10 additional seconds, since BaselineJIT and
+        // InterpreterThunk share a CodeBlock.
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::seconds(15));
+    case JITCode::DFGJIT:
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::seconds(20));
+    case JITCode::FTLJIT:
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::seconds(60));
+    default:
+        return std::chrono::milliseconds::max();
+    }
+}
+
 bool CodeBlock::shouldJettisonDueToOldAge()
 {
-    return false;
+    if (!Options::useCodeAging())
+        return false;
+
+    if (Heap::isMarked(this))
+        return false;
+
+    std::chrono::milliseconds ttl = timeToLive(jitType());
+#if ENABLE(JIT)
+    // Age machine code out faster as the executable pool fills up, so that we reclaim cold code
+    // before compilations start failing for lack of executable memory.
+    if (JITCode::isJIT(jitType())) {
+        double multiplier = ExecutableAllocator::memoryPressureMultiplier(0);
+        if (multiplier > 1)
+            ttl = std::chrono::milliseconds(static_cast<std::chrono::milliseconds::rep>(ttl.count() / multiplier));
+    }
+#endif
+
+    if (timeSinceLastExecution() < ttl)
+        return false;
+
+    return true;
 }
 
 #if ENABLE(DFG_JIT)
@@ -489,6 +489,7 @@ public:
 
     unsigned numberOfArrayProfiles() const { return m_arrayProfiles.size(); }
     const ArrayProfileVector& arrayProfiles() { return m_arrayProfiles; }
+    ArrayProfile* arrayProfile(unsigned index) { return &m_arrayProfiles[index]; }
     ArrayProfile* addArrayProfile(unsigned bytecodeOffset)
     {
         m_arrayProfiles.append(ArrayProfile(bytecodeOffset));
@@ -994,6 +995,12 @@ private:
             std::chrono::steady_clock::now() - m_creationTime);
     }
 
+    std::chrono::milliseconds timeSinceLastExecution()
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - m_lastExecutionTime);
+    }
+
     void createRareDataIfNecessary()
     {
         if (!m_rareData)
@@ -1076,6 +1083,8 @@ private:
     uint16_t m_reoptimizationRetryCounter;
 
     std::chrono::steady_clock::time_point m_creationTime;
+    // Updated whenever the GC finds this CodeBlock executing on the stack.
+    std::chrono::steady_clock::time_point m_lastExecutionTime;
 
     mutable CodeBlockHash m_hash;
 
@@ -1372,6 +1381,17 @@ inline void CodeBlockSet::mark(void* candidateCodeBlock)
     mark(codeBlock);
 }
 
+inline bool CodeBlockSet::contains(void* candidateCodeBlock)
+{
+    // As in mark(), 0 and -1 cannot be looked up in the HashSets.
+    uintptr_t value = reinterpret_cast<uintptr_t>(candidateCodeBlock);
+    if (value + 1 <= 1)
+        return false;
+
+    CodeBlock* codeBlock = static_cast<CodeBlock*>(candidateCodeBlock);
+    return m_oldCodeBlocks.contains(codeBlock) || m_newCodeBlocks.contains(codeBlock);
+}
+
 inline void CodeBlockSet::mark(CodeBlock* codeBlock)
 {
     if (!codeBlock)
@@ -1382,6 +1402,7 @@ inline void CodeBlockSet::mark(CodeBlock* codeBlock)
     // have always done it.
     Heap::heap(codeBlock)->writeBarrier(codeBlock);
 
+    codeBlock->m_lastExecutionTime = std::chrono::steady_clock::now();
     m_currentlyExecuting.add(codeBlock);
 }
 
@@ -208,6 +208,7 @@ GetByIdStatus GetByIdStatus::computeForStubInfoWithoutExitSiteFeedback(
             case ComplexGetStatus::Inlineable: {
                 std::unique_ptr<CallLinkStatus> callLinkStatus;
                 JSFunction* intrinsicFunction = nullptr;
+                PropertySlot::GetValueFunc customGetter = nullptr;
 
                 switch (access.type()) {
                 case AccessCase::Load: {
@@ -217,6 +218,16 @@ GetByIdStatus GetByIdStatus::computeForStubInfoWithoutExitSiteFeedback(
                     intrinsicFunction = access.intrinsicFunction();
                     break;
                 }
+#if USE(JSVALUE64)
+                case AccessCase::CustomGetter: {
+                    // We can only call custom getters directly if they have no side effects, and if they
+                    // live on a prototype so that the slot base is a constant.
+                    if (!isCustomGetterIntrinsic(access.customGetterIntrinsic()) || access.conditionSet().isEmpty())
+                        return GetByIdStatus(slowPathState, true);
+                    customGetter = access.customGetter();
+                    break;
+                }
+#endif
                 case AccessCase::Getter: {
                     CallLinkInfo* callLinkInfo = access.callLinkInfo();
                     ASSERT(callLinkInfo);
@@ -235,6 +246,10 @@ GetByIdStatus GetByIdStatus::computeForStubInfoWithoutExitSiteFeedback(
                     StructureSet(structure), complexGetStatus.offset(),
                     complexGetStatus.conditionSet(), WTF::move(callLinkStatus),
                     intrinsicFunction);
+                if (customGetter) {
+                    variant.m_customGetter = customGetter;
+                    variant.m_customGetterIntrinsic = access.customGetterIntrinsic();
+                }
 
                 if (!result.appendVariant(variant))
                     return GetByIdStatus(slowPathState, true);
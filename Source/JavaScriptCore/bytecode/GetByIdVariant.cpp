@@ -42,6 +42,8 @@ GetByIdVariant::GetByIdVariant(
     , m_offset(offset)
     , m_callLinkStatus(WTF::move(callLinkStatus))
     , m_intrinsicFunction(intrinsicFunction)
+    , m_customGetter(nullptr)
+    , m_customGetterIntrinsic(NoIntrinsic)
 {
     if (!structureSet.size()) {
         ASSERT(offset == invalidOffset);
@@ -65,6 +67,8 @@ GetByIdVariant& GetByIdVariant::operator=(const GetByIdVariant& other)
     m_conditionSet = other.m_conditionSet;
     m_offset = other.m_offset;
     m_intrinsicFunction = other.m_intrinsicFunction;
+    m_customGetter = other.m_customGetter;
+    m_customGetterIntrinsic = other.m_customGetterIntrinsic;
     if (other.m_callLinkStatus)
         m_callLinkStatus = std::make_unique<CallLinkStatus>(*other.m_callLinkStatus);
     else
@@ -99,6 +103,8 @@ bool GetByIdVariant::attemptToMerge(const GetByIdVariant& other)
         return false;
     if (m_callLinkStatus || other.m_callLinkStatus)
         return false;
+    if (m_customGetter != other.m_customGetter)
+        return false;
 
     if (!canMergeIntrinsicStructures(other))
         return false;
@@ -138,6 +144,8 @@ void GetByIdVariant::dumpInContext(PrintStream& out, DumpContext* context) const
         out.print(", call = ", *m_callLinkStatus);
     if (m_intrinsicFunction)
         out.print(", intrinsic = ", *m_intrinsicFunction);
+    if (m_customGetter)
+        out.print(", custom getter = ", RawPointer(bitwise_cast<void*>(m_customGetter)));
     out.print(">");
 }
 
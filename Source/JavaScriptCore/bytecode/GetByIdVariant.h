@@ -30,6 +30,7 @@
 #include "JSCJSValue.h"
 #include "ObjectPropertyConditionSet.h"
 #include "PropertyOffset.h"
+#include "PropertySlot.h"
 #include "StructureSet.h"
 
 namespace JSC {
@@ -64,6 +65,10 @@ public:
     JSFunction* intrinsicFunction() const { return m_intrinsicFunction; }
     Intrinsic intrinsic() const { return m_intrinsicFunction ? m_intrinsicFunction->intrinsic() : NoIntrinsic; }
 
+    // Set for custom getters that are known to have no side effects, see isCustomGetterIntrinsic().
+    PropertySlot::GetValueFunc customGetter() const { return m_customGetter; }
+    Intrinsic customGetterIntrinsic() const { return m_customGetterIntrinsic; }
+
     bool attemptToMerge(const GetByIdVariant& other);
     
     void dump(PrintStream&) const;
@@ -79,6 +84,8 @@ private:
     PropertyOffset m_offset;
     std::unique_ptr<CallLinkStatus> m_callLinkStatus;
     JSFunction* m_intrinsicFunction;
+    PropertySlot::GetValueFunc m_customGetter;
+    Intrinsic m_customGetterIntrinsic;
 };
 
 } // namespace JSC
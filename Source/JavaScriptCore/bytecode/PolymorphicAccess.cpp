@@ -36,6 +36,7 @@
 #include "JITOperations.h"
 #include "JSCInlines.h"
 #include "LinkBuffer.h"
+#include "MegamorphicCache.h"
 #include "ScratchRegisterAllocator.h"
 #include "StructureStubClearingWatchpoint.h"
 #include "StructureStubInfo.h"
@@ -155,7 +156,7 @@ AccessCase::AccessCase()
 std::unique_ptr<AccessCase> AccessCase::get(
     VM& vm, JSCell* owner, AccessType type, PropertyOffset offset, Structure* structure,
     const ObjectPropertyConditionSet& conditionSet, bool viaProxy, WatchpointSet* additionalSet,
-    PropertySlot::GetValueFunc customGetter, JSObject* customSlotBase)
+    PropertySlot::GetValueFunc customGetter, JSObject* customSlotBase, Intrinsic customGetterIntrinsic)
 {
     std::unique_ptr<AccessCase> result(new AccessCase());
 
@@ -170,6 +171,7 @@ std::unique_ptr<AccessCase> AccessCase::get(
         result->m_rareData->additionalSet = additionalSet;
         result->m_rareData->customAccessor.getter = customGetter;
         result->m_rareData->customSlotBase.setMayBeNull(vm, owner, customSlotBase);
+        result->m_rareData->customGetterIntrinsic = customGetterIntrinsic;
     }
 
     return result;
@@ -258,6 +260,15 @@ std::unique_ptr<AccessCase> AccessCase::getLength(VM&, JSCell*, AccessType type)
     return result;
 }
 
+std::unique_ptr<AccessCase> AccessCase::megamorphicLoad(VM&, JSCell*)
+{
+    std::unique_ptr<AccessCase> result(new AccessCase());
+
+    result->m_type = MegamorphicLoad;
+
+    return result;
+}
+
 std::unique_ptr<AccessCase> AccessCase::getIntrinsic(
     VM& vm, JSCell* owner, JSFunction* getter, PropertyOffset offset,
     Structure* structure, const ObjectPropertyConditionSet& conditionSet)
@@ -312,6 +323,7 @@ std::unique_ptr<AccessCase> AccessCase::clone() const
         result->m_rareData->customAccessor.opaque = rareData->customAccessor.opaque;
         result->m_rareData->customSlotBase = rareData->customSlotBase;
         result->m_rareData->intrinsicFunction = rareData->intrinsicFunction;
+        result->m_rareData->customGetterIntrinsic = rareData->customGetterIntrinsic;
     }
     return result;
 }
@@ -324,6 +336,7 @@ bool AccessCase::guardedByStructureCheck() const
     switch (m_type) {
     case ArrayLength:
     case StringLength:
+    case MegamorphicLoad:
         return false;
     default:
         return true;
@@ -431,6 +444,12 @@ void AccessCase::generateWithGuard(
         break;
     }
 
+    case MegamorphicLoad: {
+        // The probe is its own guard, so there is nothing left for generate() to do.
+        emitMegamorphicLoad(state, fallThrough);
+        return;
+    }
+
     default: {
         if (viaProxy()) {
             fallThrough.append(
@@ -989,6 +1008,7 @@ void AccessCase::generate(AccessGenerationState& state)
                 CCallHelpers::BaseIndex(
                     scratchGPR, scratchGPR2, CCallHelpers::ScalePtr,
                     static_cast<int32_t>(-sizeof(void*))));
+            jit.setCellStateToRemembered(baseGPR);
 
             CCallHelpers::Jump doneWithBarrier = jit.jump();
             needToFlush.link(&jit);
@@ -1084,14 +1104,104 @@ void AccessCase::generate(AccessGenerationState& state)
 
         emitIntrinsicGetter(state);
         return;
-    } }
+    }
+
+    case MegamorphicLoad:
+        // Handled by generateWithGuard(), since it is not guarded by a structure check.
+        break;
+    }
     
     RELEASE_ASSERT_NOT_REACHED();
 }
 
+void AccessCase::emitMegamorphicLoad(AccessGenerationState& state, CCallHelpers::JumpList& fallThrough)
+{
+#if USE(JSVALUE64)
+    CCallHelpers& jit = *state.jit;
+    VM& vm = *jit.vm();
+    UniquedStringImpl* uid = state.ident->impl();
+    GPRReg baseGPR = state.baseGPR;
+    GPRReg structureIDGPR = state.scratchGPR;
+    GPRReg entryGPR = state.secondScratchGPR;
+    GPRReg valueGPR = state.valueRegs.payloadGPR();
+
+    static_assert(sizeof(MegamorphicCache::Entry) == 16, "The probe scales the entry index by a shift");
+
+    jit.load32(CCallHelpers::Address(baseGPR, JSCell::structureIDOffset()), structureIDGPR);
+    jit.move(structureIDGPR, entryGPR);
+    jit.xor32(CCallHelpers::TrustedImm32(MegamorphicCache::hashFor(uid)), entryGPR);
+    jit.and32(CCallHelpers::TrustedImm32(MegamorphicCache::entryIndexMask), entryGPR);
+    jit.lshift32(CCallHelpers::TrustedImm32(4), entryGPR);
+    jit.addPtr(CCallHelpers::TrustedImmPtr(vm.megamorphicCache()->entries()), entryGPR);
+    fallThrough.append(
+        jit.branch32(
+            CCallHelpers::NotEqual,
+            CCallHelpers::Address(entryGPR, MegamorphicCache::Entry::offsetOfStructureID()),
+            structureIDGPR));
+    fallThrough.append(
+        jit.branchPtr(
+            CCallHelpers::NotEqual,
+            CCallHelpers::Address(entryGPR, MegamorphicCache::Entry::offsetOfUid()),
+            CCallHelpers::TrustedImmPtr(uid)));
+
+    GPRReg offsetGPR = structureIDGPR;
+    jit.load32(CCallHelpers::Address(entryGPR, MegamorphicCache::Entry::offsetOfOffset()), offsetGPR);
+    CCallHelpers::Jump isOutOfLine = jit.branch32(
+        CCallHelpers::GreaterThanOrEqual, offsetGPR, CCallHelpers::TrustedImm32(firstOutOfLineOffset));
+
+    jit.load64(
+        CCallHelpers::BaseIndex(baseGPR, offsetGPR, CCallHelpers::TimesEight, JSObject::offsetOfInlineStorage()),
+        valueGPR);
+    state.succeed();
+
+    // Out-of-line properties grow down from the property storage, so index by -offset.
+    isOutOfLine.link(&jit);
+    jit.loadPtr(CCallHelpers::Address(baseGPR, JSObject::butterflyOffset()), entryGPR);
+    jit.removeSpaceBits(entryGPR);
+    jit.neg32(offsetGPR);
+    jit.signExtend32ToPtr(offsetGPR, offsetGPR);
+    jit.load64(
+        CCallHelpers::BaseIndex(
+            entryGPR, offsetGPR, CCallHelpers::TimesEight,
+            (firstOutOfLineOffset - 1) * sizeof(EncodedJSValue) + Butterfly::offsetOfPropertyStorage()),
+        valueGPR);
+    state.succeed();
+#else
+    UNUSED_PARAM(state);
+    UNUSED_PARAM(fallThrough);
+    RELEASE_ASSERT_NOT_REACHED();
+#endif
+}
+
 PolymorphicAccess::PolymorphicAccess() { }
 PolymorphicAccess::~PolymorphicAccess() { }
 
+// A megamorphic stub can only answer own data property loads, so we only switch to one if that is
+// all the site has seen so far.
+bool PolymorphicAccess::canGoMegamorphic(const StructureStubInfo& stubInfo, const ListType& cases)
+{
+#if USE(JSVALUE64)
+    if (!Options::useMegamorphicCache() || stubInfo.accessType != AccessType::Get)
+        return false;
+
+    for (auto& accessCase : cases) {
+        if (accessCase->type() != AccessCase::Load
+            || accessCase->viaProxy()
+            || !accessCase->conditionSet().isEmpty()
+            || accessCase->additionalSet())
+            return false;
+        Structure* structure = accessCase->structure();
+        if (structure->isDictionary() || structure->needImpurePropertyWatchpoint())
+            return false;
+    }
+    return true;
+#else
+    UNUSED_PARAM(stubInfo);
+    UNUSED_PARAM(cases);
+    return false;
+#endif
+}
+
 MacroAssemblerCodePtr PolymorphicAccess::regenerateWithCases(
     VM& vm, CodeBlock* codeBlock, StructureStubInfo& stubInfo, const Identifier& ident,
     Vector<std::unique_ptr<AccessCase>> originalCasesToAdd)
@@ -1166,9 +1276,21 @@ MacroAssemblerCodePtr PolymorphicAccess::regenerateWithCases(
         dataLog("newCases: ", listDump(newCases), "\n");
 
     if (newCases.size() > Options::maxAccessVariantListSize()) {
+        if (!canGoMegamorphic(stubInfo, newCases)) {
+            if (verbose)
+                dataLog("Too many cases.\n");
+            return MacroAssemblerCodePtr();
+        }
+
         if (verbose)
-            dataLog("Too many cases.\n");
-        return MacroAssemblerCodePtr();
+            dataLog("Too many cases, going megamorphic.\n");
+
+        // The cases we had are still good, so hand them over to the cache.
+        MegamorphicCache* cache = vm.megamorphicCache();
+        for (auto& oldCase : newCases)
+            cache->add(oldCase->structure()->id(), ident.impl(), oldCase->offset());
+        newCases.clear();
+        newCases.append(AccessCase::megamorphicLoad(vm, codeBlock));
     }
 
     MacroAssemblerCodePtr result = regenerate(vm, codeBlock, stubInfo, ident, newCases);
@@ -1241,6 +1363,12 @@ MacroAssemblerCodePtr PolymorphicAccess::regenerate(
 #endif
 
     state.scratchGPR = allocator.allocateScratchGPR();
+    for (auto& entry : cases) {
+        if (entry->type() == AccessCase::MegamorphicLoad) {
+            state.secondScratchGPR = allocator.allocateScratchGPR();
+            break;
+        }
+    }
     
     CCallHelpers jit(&vm, codeBlock);
     state.jit = &jit;
@@ -1437,6 +1565,9 @@ void printInternal(PrintStream& out, AccessCase::AccessType type)
     case AccessCase::StringLength:
         out.print("StringLength");
         return;
+    case AccessCase::MegamorphicLoad:
+        out.print("MegamorphicLoad");
+        return;
     }
 
     RELEASE_ASSERT_NOT_REACHED();
@@ -63,7 +63,8 @@ public:
         InHit,
         InMiss,
         ArrayLength,
-        StringLength
+        StringLength,
+        MegamorphicLoad
     };
 
     static bool isGet(AccessType type)
@@ -83,6 +84,7 @@ public:
         case IntrinsicGetter:
         case ArrayLength:
         case StringLength:
+        case MegamorphicLoad:
             return true;
         }
     }
@@ -99,6 +101,7 @@ public:
         case InMiss:
         case ArrayLength:
         case StringLength:
+        case MegamorphicLoad:
             return false;
         case Transition:
         case Replace:
@@ -122,6 +125,7 @@ public:
         case CustomSetter:
         case ArrayLength:
         case StringLength:
+        case MegamorphicLoad:
             return false;
         case InHit:
         case InMiss:
@@ -135,7 +139,8 @@ public:
         bool viaProxy = false,
         WatchpointSet* additionalSet = nullptr,
         PropertySlot::GetValueFunc = nullptr,
-        JSObject* customSlotBase = nullptr);
+        JSObject* customSlotBase = nullptr,
+        Intrinsic customGetterIntrinsic = NoIntrinsic);
 
     static std::unique_ptr<AccessCase> replace(VM&, JSCell* owner, Structure*, PropertyOffset);
 
@@ -153,6 +158,7 @@ public:
         const ObjectPropertyConditionSet& = ObjectPropertyConditionSet());
 
     static std::unique_ptr<AccessCase> getLength(VM&, JSCell* owner, AccessType);
+    static std::unique_ptr<AccessCase> megamorphicLoad(VM&, JSCell* owner);
     static std::unique_ptr<AccessCase> getIntrinsic(VM&, JSCell* owner, JSFunction* intrinsic, PropertyOffset, Structure*, const ObjectPropertyConditionSet&);
     
     static std::unique_ptr<AccessCase> fromStructureStubInfo(VM&, JSCell* owner, StructureStubInfo&);
@@ -189,6 +195,15 @@ public:
     {
         return intrinsicFunction()->intrinsic();
     }
+    PropertySlot::GetValueFunc customGetter() const
+    {
+        ASSERT(type() == CustomGetter && m_rareData);
+        return m_rareData->customAccessor.getter;
+    }
+    Intrinsic customGetterIntrinsic() const
+    {
+        return m_rareData ? m_rareData->customGetterIntrinsic : NoIntrinsic;
+    }
 
     WatchpointSet* additionalSet() const
     {
@@ -261,6 +276,7 @@ private:
     // Fall through on success, add a jump to the failure list on failure.
     void generate(AccessGenerationState&);
     void emitIntrinsicGetter(AccessGenerationState&);
+    void emitMegamorphicLoad(AccessGenerationState&, MacroAssembler::JumpList& fallThrough);
     
     AccessType m_type { Load };
     PropertyOffset m_offset { invalidOffset };
@@ -277,6 +293,7 @@ private:
     public:
         RareData()
             : viaProxy(false)
+            , customGetterIntrinsic(NoIntrinsic)
         {
             customAccessor.opaque = nullptr;
         }
@@ -291,6 +308,7 @@ private:
         } customAccessor;
         WriteBarrier<JSObject> customSlotBase;
         WriteBarrier<JSFunction> intrinsicFunction;
+        Intrinsic customGetterIntrinsic;
     };
 
     std::unique_ptr<RareData> m_rareData;
@@ -313,6 +331,7 @@ public:
         VM&, CodeBlock*, StructureStubInfo&, const Identifier&, std::unique_ptr<AccessCase>);
     
     bool isEmpty() const { return m_list.isEmpty(); }
+    bool isMegamorphic() const { return m_list.size() == 1 && m_list[0]->type() == AccessCase::MegamorphicLoad; }
     unsigned size() const { return m_list.size(); }
     const AccessCase& at(unsigned i) const { return *m_list[i]; }
     const AccessCase& operator[](unsigned i) const { return *m_list[i]; }
@@ -334,6 +353,8 @@ private:
     MacroAssemblerCodePtr regenerate(
         VM&, CodeBlock*, StructureStubInfo&, const Identifier&, ListType& cases);
 
+    static bool canGoMegamorphic(const StructureStubInfo&, const ListType& cases);
+
     ListType m_list;
     RefPtr<JITStubRoutine> m_stubRoutine;
     std::unique_ptr<WatchpointsOnStructureStubInfo> m_watchpoints;
@@ -358,6 +379,7 @@ struct AccessGenerationState {
     GPRReg baseGPR { InvalidGPRReg };
     JSValueRegs valueRegs;
     GPRReg scratchGPR { InvalidGPRReg };
+    GPRReg secondScratchGPR { InvalidGPRReg };
     Vector<std::function<void(LinkBuffer&)>> callbacks;
     const Identifier* ident;
     std::unique_ptr<WatchpointsOnStructureStubInfo> watchpoints;
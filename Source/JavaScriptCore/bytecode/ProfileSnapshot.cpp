@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "ProfileSnapshot.h"
+
+#include "CodeBlock.h"
+#include "HeapInlines.h"
+#include "JSCInlines.h"
+#include <stdio.h>
+
+namespace JSC {
+
+static const uint32_t magic = 0x4a535050; // "PPSJ" when read as bytes.
+static const uint32_t formatVersion = 1;
+
+template<typename T>
+static bool writeValue(FILE* file, const T& value)
+{
+    return fwrite(&value, sizeof(T), 1, file) == 1;
+}
+
+template<typename T>
+static bool readValue(FILE* file, T& value)
+{
+    return fread(&value, sizeof(T), 1, file) == 1;
+}
+
+template<typename T>
+static bool writeVector(FILE* file, const Vector<T>& vector)
+{
+    if (!writeValue<uint32_t>(file, vector.size()))
+        return false;
+    return fwrite(vector.data(), sizeof(T), vector.size(), file) == vector.size();
+}
+
+template<typename T>
+static bool readVector(FILE* file, Vector<T>& vector)
+{
+    uint32_t size;
+    if (!readValue(file, size))
+        return false;
+    // Grow in bounded steps so that a corrupt size cannot make us allocate a huge buffer.
+    static const uint32_t chunkSize = 1024;
+    for (uint32_t offset = 0; offset < size; offset += chunkSize) {
+        uint32_t count = std::min(chunkSize, size - offset);
+        vector.grow(offset + count);
+        if (fread(vector.data() + offset, sizeof(T), count, file) != count)
+            return false;
+    }
+    return true;
+}
+
+static bool isHotBaselineCodeBlock(CodeBlock* codeBlock)
+{
+    return codeBlock->jitType() == JITCode::BaselineJIT
+        && codeBlock->codeType() == FunctionCode
+        && codeBlock->isSafeToComputeHash();
+}
+
+ProfileSnapshot::Record ProfileSnapshot::record(CodeBlock* codeBlock)
+{
+    codeBlock->updateAllPredictions();
+
+    Record result;
+    result.instructionCount = codeBlock->instructionCount();
+    result.highestTier = JITCode::BaselineJIT;
+    if (CodeBlock* replacement = codeBlock->replacement())
+        result.highestTier = std::max(result.highestTier, replacement->jitType());
+
+    ConcurrentJITLocker locker(codeBlock->m_lock);
+    for (unsigned i = 0; i < codeBlock->totalNumberOfValueProfiles(); ++i)
+        result.valueProfiles.append(codeBlock->getFromAllValueProfiles(i)->m_prediction);
+    for (unsigned i = 0; i < codeBlock->numberOfArrayProfiles(); ++i) {
+        ArrayProfile* profile = codeBlock->arrayProfile(i);
+        ArrayProfileRecord profileRecord;
+        profileRecord.observedArrayModes = profile->observedArrayModes(locker);
+        profileRecord.mayStoreToHole = profile->mayStoreToHole(locker);
+        profileRecord.outOfBounds = profile->outOfBounds(locker);
+        profileRecord.mayInterceptIndexedAccesses = profile->mayInterceptIndexedAccesses(locker);
+        profileRecord.usesOriginalArrayStructures = profile->usesOriginalArrayStructures(locker);
+        result.arrayProfiles.append(profileRecord);
+    }
+    return result;
+}
+
+bool ProfileSnapshot::save(VM& vm, const char* filename)
+{
+    ProfileSnapshot snapshot;
+    // Identical functions share a hash. Drop the record if their profile layouts disagree,
+    // since we could not tell which one a later code block corresponds to.
+    HashSet<unsigned> conflictingHashes;
+    auto functor = [&] (CodeBlock* codeBlock) -> bool {
+        if (!isHotBaselineCodeBlock(codeBlock))
+            return false;
+        unsigned hash = codeBlock->hash().hash();
+        if (conflictingHashes.contains(hash))
+            return false;
+        Record record = ProfileSnapshot::record(codeBlock);
+        auto result = snapshot.m_records.add(hash, record);
+        if (result.isNewEntry)
+            return false;
+        Record& existing = result.iterator->value;
+        if (existing.instructionCount != record.instructionCount
+            || existing.valueProfiles.size() != record.valueProfiles.size()
+            || existing.arrayProfiles.size() != record.arrayProfiles.size()) {
+            snapshot.m_records.remove(result.iterator);
+            conflictingHashes.add(hash);
+            return false;
+        }
+        existing.highestTier = std::max(existing.highestTier, record.highestTier);
+        for (unsigned i = existing.valueProfiles.size(); i--;)
+            mergeSpeculation(existing.valueProfiles[i], record.valueProfiles[i]);
+        for (unsigned i = existing.arrayProfiles.size(); i--;) {
+            ArrayProfileRecord& target = existing.arrayProfiles[i];
+            const ArrayProfileRecord& source = record.arrayProfiles[i];
+            target.observedArrayModes |= source.observedArrayModes;
+            target.mayStoreToHole |= source.mayStoreToHole;
+            target.outOfBounds |= source.outOfBounds;
+            target.mayInterceptIndexedAccesses |= source.mayInterceptIndexedAccesses;
+            target.usesOriginalArrayStructures &= source.usesOriginalArrayStructures;
+        }
+        return false;
+    };
+    vm.heap.forEachCodeBlock(functor);
+
+    FILE* file = fopen(filename, "wb");
+    if (!file)
+        return false;
+    bool ok = writeValue(file, magic)
+        && writeValue(file, formatVersion)
+        && writeValue<uint32_t>(file, snapshot.m_records.size());
+    for (auto iter = snapshot.m_records.begin(); ok && iter != snapshot.m_records.end(); ++iter) {
+        const Record& record = iter->value;
+        ok = writeValue<uint32_t>(file, iter->key)
+            && writeValue<uint32_t>(file, record.instructionCount)
+            && writeValue<uint8_t>(file, static_cast<uint8_t>(record.highestTier))
+            && writeVector(file, record.valueProfiles)
+            && writeVector(file, record.arrayProfiles);
+    }
+    ok &= !fclose(file);
+    return ok;
+}
+
+std::unique_ptr<ProfileSnapshot> ProfileSnapshot::load(const char* filename)
+{
+    FILE* file = fopen(filename, "rb");
+    if (!file)
+        return nullptr;
+
+    auto snapshot = std::make_unique<ProfileSnapshot>();
+    uint32_t fileMagic;
+    uint32_t fileFormatVersion;
+    uint32_t count;
+    bool ok = readValue(file, fileMagic) && fileMagic == magic
+        && readValue(file, fileFormatVersion) && fileFormatVersion == formatVersion
+        && readValue(file, count);
+    for (uint32_t i = 0; ok && i < count; ++i) {
+        uint32_t hash;
+        uint8_t highestTier;
+        Record record;
+        ok = readValue(file, hash)
+            && readValue(file, record.instructionCount)
+            && readValue(file, highestTier)
+            && highestTier <= JITCode::FTLJIT
+            && readVector(file, record.valueProfiles)
+            && readVector(file, record.arrayProfiles)
+            && snapshot->m_records.isValidKey(hash);
+        if (!ok)
+            break;
+        record.highestTier = static_cast<JITCode::JITType>(highestTier);
+        snapshot->m_records.set(hash, WTF::move(record));
+    }
+    fclose(file);
+    if (!ok)
+        return nullptr;
+    return snapshot;
+}
+
+void ProfileSnapshot::apply(CodeBlock* codeBlock) const
+{
+    if (codeBlock->codeType() != FunctionCode)
+        return;
+
+    auto iter = m_records.find(codeBlock->hash().hash());
+    if (iter == m_records.end())
+        return;
+    const Record& record = iter->value;
+    if (record.instructionCount != codeBlock->instructionCount()
+        || record.valueProfiles.size() != codeBlock->totalNumberOfValueProfiles()
+        || record.arrayProfiles.size() != codeBlock->numberOfArrayProfiles())
+        return;
+
+    {
+        ConcurrentJITLocker locker(codeBlock->m_lock);
+        for (unsigned i = record.valueProfiles.size(); i--;)
+            mergeSpeculation(codeBlock->getFromAllValueProfiles(i)->m_prediction, record.valueProfiles[i]);
+        for (unsigned i = record.arrayProfiles.size(); i--;) {
+            const ArrayProfileRecord& profileRecord = record.arrayProfiles[i];
+            codeBlock->arrayProfile(i)->mergeObservations(
+                locker, profileRecord.observedArrayModes, profileRecord.mayStoreToHole, profileRecord.outOfBounds,
+                profileRecord.mayInterceptIndexedAccesses, profileRecord.usesOriginalArrayStructures);
+        }
+    }
+
+    // The profiles are already warm, so there is no point in waiting for them to warm up again.
+    codeBlock->jitSoon();
+#if ENABLE(DFG_JIT)
+    if (JITCode::isOptimizingJIT(record.highestTier))
+        codeBlock->optimizeSoon();
+#endif
+}
+
+} // namespace JSC
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef ProfileSnapshot_h
+#define ProfileSnapshot_h
+
+#include "ArrayProfile.h"
+#include "JITCode.h"
+#include "SpeculatedType.h"
+#include <wtf/HashMap.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+class CodeBlock;
+class VM;
+
+// A snapshot of the profiling state of the hot code blocks in a VM, which can be written to a
+// file at the end of one run and used to seed the code blocks of the next. Code blocks are
+// matched by their CodeBlockHash, and a record is only applied when the code block has the same
+// instruction count and profile layout as the one it was taken from.
+//
+// Only state that does not refer to heap objects survives: value profile predictions, array
+// profile modes and flags, and how far the code block tiered up. Call link state and last seen
+// structures are rediscovered as usual.
+class ProfileSnapshot {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    // Returns false if the file could not be written.
+    JS_EXPORT_PRIVATE static bool save(VM&, const char* filename);
+
+    // Returns nullptr if the file does not exist or was written by an incompatible build.
+    JS_EXPORT_PRIVATE static std::unique_ptr<ProfileSnapshot> load(const char* filename);
+
+    // Called for every new baseline code block.
+    void apply(CodeBlock*) const;
+
+    size_t size() const { return m_records.size(); }
+
+private:
+    struct ArrayProfileRecord {
+        ArrayModes observedArrayModes;
+        uint8_t mayStoreToHole;
+        uint8_t outOfBounds;
+        uint8_t mayInterceptIndexedAccesses;
+        uint8_t usesOriginalArrayStructures;
+    };
+
+    struct Record {
+        unsigned instructionCount;
+        JITCode::JITType highestTier;
+        Vector<SpeculatedType> valueProfiles;
+        Vector<ArrayProfileRecord> arrayProfiles;
+    };
+
+    static Record record(CodeBlock*);
+
+    HashMap<unsigned, Record> m_records;
+};
+
+} // namespace JSC
+
+#endif // ProfileSnapshot_h
@@ -71,6 +71,9 @@ public:
     MacroAssemblerCodePtr addAccessCase(
         CodeBlock*, const Identifier&, std::unique_ptr<AccessCase>);
 
+    // True once a get_by_id has seen too many structures and probes the VM's MegamorphicCache.
+    bool isMegamorphic() const { return cacheType == CacheType::Stub && u.stub->isMegamorphic(); }
+
     void reset(CodeBlock*);
 
     void deref();
@@ -352,6 +352,8 @@ public:
     void dumpExpressionRangeInfo(); // For debugging purpose only.
 
 protected:
+    friend class UnlinkedCodeBlockSerializer;
+
     UnlinkedCodeBlock(VM*, Structure*, CodeType, const ExecutableInfo&);
     ~UnlinkedCodeBlock();
 
@@ -472,6 +474,7 @@ protected:
 class UnlinkedProgramCodeBlock final : public UnlinkedGlobalCodeBlock {
 private:
     friend class CodeCache;
+    friend class UnlinkedCodeBlockSerializer;
     static UnlinkedProgramCodeBlock* create(VM* vm, const ExecutableInfo& info)
     {
         UnlinkedProgramCodeBlock* instance = new (NotNull, allocateCell<UnlinkedProgramCodeBlock>(vm->heap)) UnlinkedProgramCodeBlock(vm, vm->unlinkedProgramCodeBlockStructure.get(), info);
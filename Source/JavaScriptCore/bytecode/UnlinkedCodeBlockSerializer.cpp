@@ -0,0 +1,825 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "UnlinkedCodeBlockSerializer.h"
+
+#include "DeferGC.h"
+#include "JSCInlines.h"
+#include "Opcode.h"
+#include "UnlinkedCodeBlock.h"
+#include "UnlinkedInstructionStream.h"
+#include <mutex>
+#include <wtf/HashMap.h>
+
+namespace JSC {
+
+static const uint32_t magic = 0x4243534a; // "JSCB" when read as bytes.
+static const uint32_t formatVersion = 1;
+static const uint32_t nullStringLength = UINT_MAX;
+
+enum ValueTag : uint8_t {
+    EmptyTag,
+    UndefinedTag,
+    NullTag,
+    TrueTag,
+    FalseTag,
+    Int32Tag,
+    DoubleTag,
+    StringTag
+};
+
+// Opcode numbering and lengths are baked into the instruction stream, so data written by a
+// build with a different opcode table must not be read.
+static const SHA1::Digest& opcodeTableDigest()
+{
+    static SHA1::Digest digest;
+    static std::once_flag onceFlag;
+    std::call_once(onceFlag, [] {
+#define OPCODE_SIGNATURE(opcode, length) #opcode ":" #length ","
+        static const char signature[] = FOR_EACH_OPCODE_ID(OPCODE_SIGNATURE);
+#undef OPCODE_SIGNATURE
+        SHA1 sha1;
+        sha1.addBytes(reinterpret_cast<const uint8_t*>(signature), sizeof(signature) - 1);
+        sha1.computeHash(digest);
+    });
+    return digest;
+}
+
+// The stream is decoded without bounds checks when it is executed, so make sure that every
+// instruction is well formed and that the operand count adds up before we adopt it.
+static bool isValidInstructionStream(const unsigned char* data, size_t size, unsigned instructionCount)
+{
+    size_t index = 0;
+    size_t count = 0;
+    while (index < size) {
+        unsigned opcode = data[index++];
+        if (opcode >= static_cast<unsigned>(numOpcodeIDs))
+            return false;
+        unsigned length = opcodeLengths[opcode];
+        for (unsigned i = 1; i < length; ++i) {
+            if (index >= size)
+                return false;
+            switch (data[index] >> 5) {
+            case Positive5Bit:
+            case Negative5Bit:
+            case ConstantRegister5Bit:
+                index += 1;
+                break;
+            case Positive13Bit:
+            case Negative13Bit:
+            case ConstantRegister13Bit:
+                index += 2;
+                break;
+            case Full32Bit:
+                index += 5;
+                break;
+            default:
+                return false;
+            }
+        }
+        if (index > size)
+            return false;
+        count += length;
+    }
+    return count == instructionCount;
+}
+
+class UnlinkedCodeBlockSerializer::Encoder {
+public:
+    explicit Encoder(Vector<uint8_t>& buffer)
+        : m_buffer(buffer)
+    {
+    }
+
+    void writeBytes(const void* data, size_t size)
+    {
+        m_buffer.append(static_cast<const uint8_t*>(data), size);
+    }
+
+    template<typename T>
+    void write(const T& value)
+    {
+        writeBytes(&value, sizeof(T));
+    }
+
+    // Only for vectors of plain data.
+    template<typename T, size_t inlineCapacity>
+    void writeVector(const Vector<T, inlineCapacity>& vector)
+    {
+        write<uint32_t>(vector.size());
+        writeBytes(vector.data(), vector.size() * sizeof(T));
+    }
+
+    void writeString(const String& string)
+    {
+        if (string.isNull()) {
+            write(nullStringLength);
+            return;
+        }
+        write<uint32_t>(string.length());
+        write<uint8_t>(string.is8Bit());
+        if (string.is8Bit())
+            writeBytes(string.characters8(), string.length() * sizeof(LChar));
+        else
+            writeBytes(string.characters16(), string.length() * sizeof(UChar));
+    }
+
+    bool writeIdentifier(const Identifier& identifier)
+    {
+        // Private names are symbols, and there is no way to get the same symbol back.
+        if (identifier.isSymbol())
+            return false;
+        writeString(identifier.string());
+        return true;
+    }
+
+private:
+    Vector<uint8_t>& m_buffer;
+};
+
+class UnlinkedCodeBlockSerializer::Decoder {
+public:
+    Decoder(VM& vm, const uint8_t* data, size_t size)
+        : m_vm(vm)
+        , m_data(data)
+        , m_size(size)
+    {
+    }
+
+    VM& vm() { return m_vm; }
+    size_t remaining() const { return m_size - m_offset; }
+    bool atEnd() const { return !remaining(); }
+
+    bool readBytes(void* result, size_t size)
+    {
+        if (size > remaining())
+            return false;
+        memcpy(result, m_data + m_offset, size);
+        m_offset += size;
+        return true;
+    }
+
+    template<typename T>
+    bool read(T& result)
+    {
+        return readBytes(&result, sizeof(T));
+    }
+
+    template<typename T, size_t inlineCapacity>
+    bool readVector(Vector<T, inlineCapacity>& result)
+    {
+        uint32_t size;
+        if (!read(size) || size > remaining() / sizeof(T))
+            return false;
+        result.resize(size);
+        return readBytes(result.data(), size * sizeof(T));
+    }
+
+    bool readString(String& result)
+    {
+        uint32_t length;
+        if (!read(length))
+            return false;
+        if (length == nullStringLength) {
+            result = String();
+            return true;
+        }
+
+        uint8_t is8Bit;
+        if (!read(is8Bit))
+            return false;
+        if (is8Bit) {
+            if (length > remaining())
+                return false;
+            result = String(m_data + m_offset, length);
+            m_offset += length;
+            return true;
+        }
+
+        if (length > remaining() / sizeof(UChar))
+            return false;
+        UChar* characters;
+        result = String::createUninitialized(length, characters);
+        return readBytes(characters, length * sizeof(UChar));
+    }
+
+    bool readIdentifier(Identifier& result)
+    {
+        String string;
+        if (!readString(string))
+            return false;
+        result = string.isNull() ? Identifier() : Identifier::fromString(&m_vm, string);
+        return true;
+    }
+
+private:
+    VM& m_vm;
+    const uint8_t* m_data;
+    size_t m_size;
+    size_t m_offset { 0 };
+};
+
+bool UnlinkedCodeBlockSerializer::encodeValue(Encoder& encoder, JSValue value)
+{
+    if (!value)
+        encoder.write(EmptyTag);
+    else if (value.isUndefined())
+        encoder.write(UndefinedTag);
+    else if (value.isNull())
+        encoder.write(NullTag);
+    else if (value.isBoolean())
+        encoder.write(value.asBoolean() ? TrueTag : FalseTag);
+    else if (value.isInt32()) {
+        encoder.write(Int32Tag);
+        encoder.write(value.asInt32());
+    } else if (value.isDouble()) {
+        encoder.write(DoubleTag);
+        encoder.write(value.asDouble());
+    } else if (value.isString()) {
+        const String& string = asString(value)->tryGetValue();
+        if (string.isNull())
+            return false;
+        encoder.write(StringTag);
+        encoder.writeString(string);
+    } else
+        return false;
+    return true;
+}
+
+bool UnlinkedCodeBlockSerializer::decodeValue(Decoder& decoder, JSValue& result)
+{
+    uint8_t tag;
+    if (!decoder.read(tag))
+        return false;
+    switch (tag) {
+    case EmptyTag:
+        result = JSValue();
+        return true;
+    case UndefinedTag:
+        result = jsUndefined();
+        return true;
+    case NullTag:
+        result = jsNull();
+        return true;
+    case TrueTag:
+        result = jsBoolean(true);
+        return true;
+    case FalseTag:
+        result = jsBoolean(false);
+        return true;
+    case Int32Tag: {
+        int32_t value;
+        if (!decoder.read(value))
+            return false;
+        result = jsNumber(value);
+        return true;
+    }
+    case DoubleTag: {
+        double value;
+        if (!decoder.read(value))
+            return false;
+        result = JSValue(JSValue::EncodeAsDouble, value);
+        return true;
+    }
+    case StringTag: {
+        String value;
+        if (!decoder.readString(value) || value.isNull())
+            return false;
+        result = jsString(&decoder.vm(), value);
+        return true;
+    }
+    default:
+        return false;
+    }
+}
+
+bool UnlinkedCodeBlockSerializer::encodeVariableEnvironment(Encoder& encoder, const VariableEnvironment& environment)
+{
+    encoder.write<uint8_t>(environment.isEverythingCaptured());
+    encoder.write<uint32_t>(environment.size());
+    for (const auto& entry : environment) {
+        if (entry.key->isSymbol())
+            return false;
+        encoder.writeString(String(entry.key.get()));
+        uint8_t bits = entry.value.isCaptured()
+            | entry.value.isConst() << 1
+            | entry.value.isVar() << 2
+            | entry.value.isLet() << 3
+            | entry.value.isExported() << 4
+            | entry.value.isImported() << 5
+            | entry.value.isImportedNamespace() << 6;
+        encoder.write(bits);
+    }
+    return true;
+}
+
+bool UnlinkedCodeBlockSerializer::decodeVariableEnvironment(Decoder& decoder, VariableEnvironment& environment)
+{
+    uint8_t isEverythingCaptured;
+    uint32_t size;
+    if (!decoder.read(isEverythingCaptured) || !decoder.read(size))
+        return false;
+    for (uint32_t i = 0; i < size; ++i) {
+        String name;
+        uint8_t bits;
+        if (!decoder.readString(name) || name.isNull() || !decoder.read(bits))
+            return false;
+        VariableEnvironmentEntry& entry = environment.add(Identifier::fromString(&decoder.vm(), name)).iterator->value;
+        if (bits & 1)
+            entry.setIsCaptured();
+        if (bits & 1 << 1)
+            entry.setIsConst();
+        if (bits & 1 << 2)
+            entry.setIsVar();
+        if (bits & 1 << 3)
+            entry.setIsLet();
+        if (bits & 1 << 4)
+            entry.setIsExported();
+        if (bits & 1 << 5)
+            entry.setIsImported();
+        if (bits & 1 << 6)
+            entry.setIsImportedNamespace();
+    }
+    if (isEverythingCaptured)
+        environment.markAllVariablesAsCaptured();
+    return true;
+}
+
+bool UnlinkedCodeBlockSerializer::encodeFunctionExecutable(Encoder& encoder, UnlinkedFunctionExecutable* executable)
+{
+    // Builtins bring their own source, which is not part of the cache key.
+    if (executable->m_sourceOverride)
+        return false;
+
+    const String& nameValue = executable->nameValue()->tryGetValue();
+    if (nameValue.isNull())
+        return false;
+
+    if (!encoder.writeIdentifier(executable->m_name) || !encoder.writeIdentifier(executable->m_inferredName))
+        return false;
+    encoder.writeString(nameValue);
+    if (!encodeVariableEnvironment(encoder, executable->m_parentScopeTDZVariables))
+        return false;
+
+    encoder.write<uint32_t>(executable->m_firstLineOffset);
+    encoder.write<uint32_t>(executable->m_lineCount);
+    encoder.write<uint32_t>(executable->m_unlinkedFunctionNameStart);
+    encoder.write<uint32_t>(executable->m_unlinkedBodyStartColumn);
+    encoder.write<uint32_t>(executable->m_unlinkedBodyEndColumn);
+    encoder.write<uint32_t>(executable->m_startOffset);
+    encoder.write<uint32_t>(executable->m_sourceLength);
+    encoder.write<uint32_t>(executable->m_parametersStartOffset);
+    encoder.write<uint32_t>(executable->m_typeProfilingStartOffset);
+    encoder.write<uint32_t>(executable->m_typeProfilingEndOffset);
+    encoder.write<uint32_t>(executable->m_parameterCount);
+    encoder.write<uint32_t>(static_cast<uint32_t>(executable->m_parseMode));
+    encoder.write<uint32_t>(executable->m_features);
+
+    uint32_t flags = executable->m_isInStrictContext
+        | executable->m_hasCapturedVariables << 1
+        | executable->m_isBuiltinFunction << 2
+        | executable->m_constructAbility << 3
+        | executable->m_functionMode << 4
+        | executable->m_isArrowFunction << 5
+        | executable->m_constructorKind << 6;
+    encoder.write(flags);
+    return true;
+}
+
+UnlinkedFunctionExecutable* UnlinkedCodeBlockSerializer::decodeFunctionExecutable(Decoder& decoder)
+{
+    VM& vm = decoder.vm();
+    UnlinkedFunctionExecutable* executable = new (NotNull, allocateCell<UnlinkedFunctionExecutable>(vm.heap))
+        UnlinkedFunctionExecutable(&vm, vm.unlinkedFunctionExecutableStructure.get());
+    executable->finishCreation(vm);
+
+    String nameValue;
+    uint32_t parseMode;
+    uint32_t flags;
+    if (!decoder.readIdentifier(executable->m_name)
+        || !decoder.readIdentifier(executable->m_inferredName)
+        || !decoder.readString(nameValue)
+        || nameValue.isNull()
+        || !decodeVariableEnvironment(decoder, executable->m_parentScopeTDZVariables)
+        || !decoder.read(executable->m_firstLineOffset)
+        || !decoder.read(executable->m_lineCount)
+        || !decoder.read(executable->m_unlinkedFunctionNameStart)
+        || !decoder.read(executable->m_unlinkedBodyStartColumn)
+        || !decoder.read(executable->m_unlinkedBodyEndColumn)
+        || !decoder.read(executable->m_startOffset)
+        || !decoder.read(executable->m_sourceLength)
+        || !decoder.read(executable->m_parametersStartOffset)
+        || !decoder.read(executable->m_typeProfilingStartOffset)
+        || !decoder.read(executable->m_typeProfilingEndOffset)
+        || !decoder.read(executable->m_parameterCount)
+        || !decoder.read(parseMode)
+        || !decoder.read(executable->m_features)
+        || !decoder.read(flags))
+        return nullptr;
+
+    executable->setNameValue(vm, jsString(&vm, nameValue));
+    executable->m_parseMode = static_cast<SourceParseMode>(parseMode);
+    executable->m_isInStrictContext = flags & 1;
+    executable->m_hasCapturedVariables = (flags >> 1) & 1;
+    executable->m_isBuiltinFunction = (flags >> 2) & 1;
+    executable->m_constructAbility = (flags >> 3) & 1;
+    executable->m_functionMode = (flags >> 4) & 1;
+    executable->m_isArrowFunction = (flags >> 5) & 1;
+    executable->m_constructorKind = (flags >> 6) & 3;
+    return executable;
+}
+
+bool UnlinkedCodeBlockSerializer::encodeCodeBlock(Encoder& encoder, UnlinkedCodeBlock* codeBlock)
+{
+    // These only exist when a profiler is on, and CodeCache does not cache those compilations.
+    if (!codeBlock->m_typeProfilerInfoMap.isEmpty() || !codeBlock->m_opProfileControlFlowBytecodeOffsets.isEmpty())
+        return false;
+
+    encoder.write<int32_t>(codeBlock->m_numVars);
+    encoder.write<int32_t>(codeBlock->m_numCapturedVars);
+    encoder.write<int32_t>(codeBlock->m_numCalleeRegisters);
+    encoder.write<int32_t>(codeBlock->m_numParameters);
+    encoder.write<int32_t>(codeBlock->m_thisRegister.offset());
+    encoder.write<int32_t>(codeBlock->m_scopeRegister.offset());
+    encoder.write<int32_t>(codeBlock->m_lexicalEnvironmentRegister.offset());
+    encoder.write<int32_t>(codeBlock->m_globalObjectRegister.offset());
+
+    uint32_t flags = codeBlock->m_needsFullScopeChain
+        | codeBlock->m_usesEval << 1
+        | codeBlock->m_isStrictMode << 2
+        | codeBlock->m_isConstructor << 3
+        | codeBlock->m_hasCapturedVariables << 4
+        | codeBlock->m_isBuiltinFunction << 5
+        | codeBlock->m_isArrowFunction << 6
+        | codeBlock->m_constructorKind << 7;
+    encoder.write(flags);
+    encoder.write<uint32_t>(codeBlock->m_firstLine);
+    encoder.write<uint32_t>(codeBlock->m_lineCount);
+    encoder.write<uint32_t>(codeBlock->m_endColumn);
+    encoder.write<uint32_t>(codeBlock->m_features);
+    encoder.write<uint32_t>(codeBlock->m_codeType);
+
+    const UnlinkedInstructionStream& instructions = codeBlock->instructions();
+    encoder.write<uint32_t>(instructions.m_instructionCount);
+    encoder.write<uint32_t>(instructions.m_data.size());
+    encoder.writeBytes(instructions.m_data.data(), instructions.m_data.size());
+
+    encoder.writeVector(codeBlock->m_jumpTargets);
+
+    encoder.write<uint32_t>(codeBlock->m_identifiers.size());
+    for (const Identifier& identifier : codeBlock->m_identifiers) {
+        if (!encoder.writeIdentifier(identifier))
+            return false;
+    }
+
+    // Strings in constant buffers are the same cells as some constant registers, which is what
+    // keeps them alive. Record those as references so the decoded buffers share cells the same way.
+    HashMap<JSCell*, unsigned> constantIndices;
+    encoder.write<uint32_t>(codeBlock->m_constantRegisters.size());
+    for (unsigned i = 0; i < codeBlock->m_constantRegisters.size(); ++i) {
+        JSValue value = codeBlock->m_constantRegisters[i].get();
+        if (!encodeValue(encoder, value))
+            return false;
+        if (value.isCell())
+            constantIndices.add(value.asCell(), i);
+        encoder.write(static_cast<uint8_t>(codeBlock->m_constantsSourceCodeRepresentation[i]));
+    }
+    for (unsigned constantRegisterIndex : codeBlock->m_linkTimeConstants)
+        encoder.write<uint32_t>(constantRegisterIndex);
+
+    for (auto* functions : { &codeBlock->m_functionDecls, &codeBlock->m_functionExprs }) {
+        encoder.write<uint32_t>(functions->size());
+        for (auto& function : *functions) {
+            if (!encodeFunctionExecutable(encoder, function.get()))
+                return false;
+        }
+    }
+
+    encoder.writeVector(codeBlock->m_propertyAccessInstructions);
+    encoder.write<uint32_t>(codeBlock->m_arrayProfileCount);
+    encoder.write<uint32_t>(codeBlock->m_arrayAllocationProfileCount);
+    encoder.write<uint32_t>(codeBlock->m_objectAllocationProfileCount);
+    encoder.write<uint32_t>(codeBlock->m_valueProfileCount);
+    encoder.write<uint32_t>(codeBlock->m_llintCallLinkInfoCount);
+    encoder.writeVector(codeBlock->m_expressionInfo);
+
+    UnlinkedCodeBlock::RareData* rareData = codeBlock->m_rareData.get();
+    encoder.write<uint8_t>(!!rareData);
+    if (!rareData)
+        return true;
+
+    encoder.write<uint32_t>(rareData->m_exceptionHandlers.size());
+    for (const UnlinkedHandlerInfo& handler : rareData->m_exceptionHandlers) {
+        encoder.write<uint32_t>(handler.start);
+        encoder.write<uint32_t>(handler.end);
+        encoder.write<uint32_t>(handler.target);
+        encoder.write<uint32_t>(static_cast<uint32_t>(handler.type()));
+    }
+
+    encoder.write<uint32_t>(rareData->m_regexps.size());
+    for (const auto& regExp : rareData->m_regexps) {
+        uint32_t regExpFlags = NoFlags;
+        if (regExp->global())
+            regExpFlags |= FlagGlobal;
+        if (regExp->ignoreCase())
+            regExpFlags |= FlagIgnoreCase;
+        if (regExp->multiline())
+            regExpFlags |= FlagMultiline;
+        encoder.writeString(regExp->pattern());
+        encoder.write(regExpFlags);
+    }
+
+    encoder.write<uint32_t>(rareData->m_constantBuffers.size());
+    for (const UnlinkedCodeBlock::ConstantBuffer& buffer : rareData->m_constantBuffers) {
+        encoder.write<uint32_t>(buffer.size());
+        for (JSValue value : buffer) {
+            if (value.isCell()) {
+                auto iter = constantIndices.find(value.asCell());
+                if (iter == constantIndices.end())
+                    return false;
+                encoder.write<uint8_t>(true);
+                encoder.write<uint32_t>(iter->value);
+                continue;
+            }
+            encoder.write<uint8_t>(false);
+            if (!encodeValue(encoder, value))
+                return false;
+        }
+    }
+
+    encoder.write<uint32_t>(rareData->m_switchJumpTables.size());
+    for (const UnlinkedSimpleJumpTable& table : rareData->m_switchJumpTables) {
+        encoder.writeVector(table.branchOffsets);
+        encoder.write<int32_t>(table.min);
+    }
+
+    encoder.write<uint32_t>(rareData->m_stringSwitchJumpTables.size());
+    for (const UnlinkedStringJumpTable& table : rareData->m_stringSwitchJumpTables) {
+        encoder.write<uint32_t>(table.offsetTable.size());
+        for (const auto& entry : table.offsetTable) {
+            encoder.writeString(String(entry.key.get()));
+            encoder.write<int32_t>(entry.value);
+        }
+    }
+
+    encoder.writeVector(rareData->m_expressionInfoFatPositions);
+    return true;
+}
+
+bool UnlinkedCodeBlockSerializer::decodeCodeBlock(Decoder& decoder, UnlinkedCodeBlock* codeBlock)
+{
+    VM& vm = decoder.vm();
+
+    int32_t thisRegister;
+    int32_t scopeRegister;
+    int32_t lexicalEnvironmentRegister;
+    int32_t globalObjectRegister;
+    uint32_t flags;
+    uint32_t codeType;
+    if (!decoder.read(codeBlock->m_numVars)
+        || !decoder.read(codeBlock->m_numCapturedVars)
+        || !decoder.read(codeBlock->m_numCalleeRegisters)
+        || !decoder.read(codeBlock->m_numParameters)
+        || !decoder.read(thisRegister)
+        || !decoder.read(scopeRegister)
+        || !decoder.read(lexicalEnvironmentRegister)
+        || !decoder.read(globalObjectRegister)
+        || !decoder.read(flags)
+        || !decoder.read(codeBlock->m_firstLine)
+        || !decoder.read(codeBlock->m_lineCount)
+        || !decoder.read(codeBlock->m_endColumn)
+        || !decoder.read(codeBlock->m_features)
+        || !decoder.read(codeType)
+        || codeType != static_cast<uint32_t>(codeBlock->m_codeType))
+        return false;
+
+    codeBlock->m_thisRegister = VirtualRegister(thisRegister);
+    codeBlock->m_scopeRegister = VirtualRegister(scopeRegister);
+    codeBlock->m_lexicalEnvironmentRegister = VirtualRegister(lexicalEnvironmentRegister);
+    codeBlock->m_globalObjectRegister = VirtualRegister(globalObjectRegister);
+    codeBlock->m_needsFullScopeChain = flags & 1;
+    codeBlock->m_usesEval = (flags >> 1) & 1;
+    codeBlock->m_isStrictMode = (flags >> 2) & 1;
+    codeBlock->m_isConstructor = (flags >> 3) & 1;
+    codeBlock->m_hasCapturedVariables = (flags >> 4) & 1;
+    codeBlock->m_isBuiltinFunction = (flags >> 5) & 1;
+    codeBlock->m_isArrowFunction = (flags >> 6) & 1;
+    codeBlock->m_constructorKind = (flags >> 7) & 3;
+
+    uint32_t instructionCount;
+    uint32_t instructionDataSize;
+    if (!decoder.read(instructionCount) || !decoder.read(instructionDataSize) || instructionDataSize > decoder.remaining())
+        return false;
+    RefCountedArray<unsigned char> instructionData(instructionDataSize);
+    if (!decoder.readBytes(instructionData.data(), instructionDataSize)
+        || !isValidInstructionStream(instructionData.data(), instructionDataSize, instructionCount))
+        return false;
+    codeBlock->setInstructions(std::make_unique<UnlinkedInstructionStream>(instructionData, instructionCount));
+
+    if (!decoder.readVector(codeBlock->m_jumpTargets))
+        return false;
+
+    uint32_t identifierCount;
+    if (!decoder.read(identifierCount))
+        return false;
+    for (uint32_t i = 0; i < identifierCount; ++i) {
+        Identifier identifier;
+        if (!decoder.readIdentifier(identifier))
+            return false;
+        codeBlock->m_identifiers.append(identifier);
+    }
+
+    uint32_t constantCount;
+    if (!decoder.read(constantCount))
+        return false;
+    for (uint32_t i = 0; i < constantCount; ++i) {
+        JSValue value;
+        uint8_t sourceCodeRepresentation;
+        if (!decodeValue(decoder, value) || !decoder.read(sourceCodeRepresentation))
+            return false;
+        codeBlock->m_constantRegisters.append(WriteBarrier<Unknown>());
+        if (value)
+            codeBlock->m_constantRegisters.last().set(vm, codeBlock, value);
+        codeBlock->m_constantsSourceCodeRepresentation.append(static_cast<SourceCodeRepresentation>(sourceCodeRepresentation));
+    }
+    for (unsigned& constantRegisterIndex : codeBlock->m_linkTimeConstants) {
+        if (!decoder.read(constantRegisterIndex) || constantRegisterIndex >= constantCount)
+            return false;
+    }
+
+    for (auto* functions : { &codeBlock->m_functionDecls, &codeBlock->m_functionExprs }) {
+        uint32_t functionCount;
+        if (!decoder.read(functionCount))
+            return false;
+        for (uint32_t i = 0; i < functionCount; ++i) {
+            UnlinkedFunctionExecutable* executable = decodeFunctionExecutable(decoder);
+            if (!executable)
+                return false;
+            functions->append(WriteBarrier<UnlinkedFunctionExecutable>(vm, codeBlock, executable));
+        }
+    }
+
+    uint8_t hasRareData;
+    if (!decoder.readVector(codeBlock->m_propertyAccessInstructions)
+        || !decoder.read(codeBlock->m_arrayProfileCount)
+        || !decoder.read(codeBlock->m_arrayAllocationProfileCount)
+        || !decoder.read(codeBlock->m_objectAllocationProfileCount)
+        || !decoder.read(codeBlock->m_valueProfileCount)
+        || !decoder.read(codeBlock->m_llintCallLinkInfoCount)
+        || !decoder.readVector(codeBlock->m_expressionInfo)
+        || !decoder.read(hasRareData))
+        return false;
+    if (!hasRareData)
+        return true;
+
+    codeBlock->createRareDataIfNecessary();
+    UnlinkedCodeBlock::RareData* rareData = codeBlock->m_rareData.get();
+
+    uint32_t handlerCount;
+    if (!decoder.read(handlerCount))
+        return false;
+    for (uint32_t i = 0; i < handlerCount; ++i) {
+        uint32_t start;
+        uint32_t end;
+        uint32_t target;
+        uint32_t type;
+        if (!decoder.read(start) || !decoder.read(end) || !decoder.read(target) || !decoder.read(type) || type > 3)
+            return false;
+        rareData->m_exceptionHandlers.append(UnlinkedHandlerInfo(start, end, target, static_cast<HandlerType>(type)));
+    }
+
+    uint32_t regExpCount;
+    if (!decoder.read(regExpCount))
+        return false;
+    for (uint32_t i = 0; i < regExpCount; ++i) {
+        String pattern;
+        uint32_t regExpFlags;
+        if (!decoder.readString(pattern) || !decoder.read(regExpFlags) || regExpFlags >= InvalidFlags)
+            return false;
+        RegExp* regExp = RegExp::create(vm, pattern, static_cast<RegExpFlags>(regExpFlags));
+        rareData->m_regexps.append(WriteBarrier<RegExp>(vm, codeBlock, regExp));
+    }
+
+    uint32_t constantBufferCount;
+    if (!decoder.read(constantBufferCount))
+        return false;
+    for (uint32_t i = 0; i < constantBufferCount; ++i) {
+        uint32_t length;
+        if (!decoder.read(length))
+            return false;
+        UnlinkedCodeBlock::ConstantBuffer buffer;
+        for (uint32_t j = 0; j < length; ++j) {
+            uint8_t isConstantReference;
+            if (!decoder.read(isConstantReference))
+                return false;
+            JSValue value;
+            if (isConstantReference) {
+                uint32_t constantIndex;
+                if (!decoder.read(constantIndex) || constantIndex >= constantCount)
+                    return false;
+                value = codeBlock->m_constantRegisters[constantIndex].get();
+            } else if (!decodeValue(decoder, value) || value.isCell())
+                return false;
+            buffer.append(value);
+        }
+        rareData->m_constantBuffers.append(WTF::move(buffer));
+    }
+
+    uint32_t switchJumpTableCount;
+    if (!decoder.read(switchJumpTableCount))
+        return false;
+    for (uint32_t i = 0; i < switchJumpTableCount; ++i) {
+        UnlinkedSimpleJumpTable table;
+        if (!decoder.readVector(table.branchOffsets) || !decoder.read(table.min))
+            return false;
+        rareData->m_switchJumpTables.append(WTF::move(table));
+    }
+
+    uint32_t stringSwitchJumpTableCount;
+    if (!decoder.read(stringSwitchJumpTableCount))
+        return false;
+    for (uint32_t i = 0; i < stringSwitchJumpTableCount; ++i) {
+        UnlinkedStringJumpTable table;
+        uint32_t entryCount;
+        if (!decoder.read(entryCount))
+            return false;
+        for (uint32_t j = 0; j < entryCount; ++j) {
+            String key;
+            int32_t offset;
+            if (!decoder.readString(key) || key.isNull() || !decoder.read(offset))
+                return false;
+            table.offsetTable.add(Identifier::fromString(&vm, key).impl(), offset);
+        }
+        rareData->m_stringSwitchJumpTables.append(WTF::move(table));
+    }
+
+    return decoder.readVector(rareData->m_expressionInfoFatPositions);
+}
+
+bool UnlinkedCodeBlockSerializer::encode(UnlinkedProgramCodeBlock* codeBlock, const SHA1::Digest& key, Vector<uint8_t>& result)
+{
+    Vector<uint8_t> buffer;
+    Encoder encoder(buffer);
+    encoder.write(magic);
+    encoder.write(formatVersion);
+    encoder.write(opcodeTableDigest());
+    encoder.write(key);
+
+    if (!encodeCodeBlock(encoder, codeBlock)
+        || !encodeVariableEnvironment(encoder, codeBlock->m_varDeclarations)
+        || !encodeVariableEnvironment(encoder, codeBlock->m_lexicalDeclarations))
+        return false;
+
+    result.swap(buffer);
+    return true;
+}
+
+UnlinkedProgramCodeBlock* UnlinkedCodeBlockSerializer::decode(VM& vm, const ExecutableInfo& info, const SHA1::Digest& key, const uint8_t* data, size_t size)
+{
+    Decoder decoder(vm, data, size);
+    uint32_t dataMagic;
+    uint32_t dataFormatVersion;
+    SHA1::Digest dataOpcodeTableDigest;
+    SHA1::Digest dataKey;
+    if (!decoder.read(dataMagic) || dataMagic != magic
+        || !decoder.read(dataFormatVersion) || dataFormatVersion != formatVersion
+        || !decoder.read(dataOpcodeTableDigest) || dataOpcodeTableDigest != opcodeTableDigest()
+        || !decoder.read(dataKey) || dataKey != key)
+        return nullptr;
+
+    // None of the cells we create are reachable from a root until we return.
+    DeferGC deferGC(vm.heap);
+
+    UnlinkedProgramCodeBlock* codeBlock = UnlinkedProgramCodeBlock::create(&vm, info);
+    if (!decodeCodeBlock(decoder, codeBlock)
+        || !decodeVariableEnvironment(decoder, codeBlock->m_varDeclarations)
+        || !decodeVariableEnvironment(decoder, codeBlock->m_lexicalDeclarations)
+        || !decoder.atEnd())
+        return nullptr;
+    return codeBlock;
+}
+
+} // namespace JSC
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef UnlinkedCodeBlockSerializer_h
+#define UnlinkedCodeBlockSerializer_h
+
+#include <wtf/SHA1.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+class JSValue;
+class UnlinkedCodeBlock;
+class UnlinkedFunctionExecutable;
+class UnlinkedProgramCodeBlock;
+class VariableEnvironment;
+class VM;
+struct ExecutableInfo;
+
+// Flattens the bytecode for a top-level program into a pointer-free byte format and reads it
+// back, so that CodeCache can keep it on disk between runs. Nested functions are stored as
+// UnlinkedFunctionExecutables only. Their code blocks are generated lazily on first call, the
+// same as when the program was just parsed.
+//
+// The data starts with a header recording the format version, a digest of the opcode table and
+// a caller-supplied key digest. Data whose header does not match this build is rejected.
+class UnlinkedCodeBlockSerializer {
+public:
+    // Returns false if the code block holds something the format does not cover, such as
+    // symbol table or template registry constants. Such programs are simply not cached.
+    static bool encode(UnlinkedProgramCodeBlock*, const SHA1::Digest& key, Vector<uint8_t>& result);
+
+    // Returns nullptr if the data was written for another key or build, or is malformed.
+    static UnlinkedProgramCodeBlock* decode(VM&, const ExecutableInfo&, const SHA1::Digest& key, const uint8_t* data, size_t size);
+
+private:
+    class Encoder;
+    class Decoder;
+
+    static bool encodeCodeBlock(Encoder&, UnlinkedCodeBlock*);
+    static bool decodeCodeBlock(Decoder&, UnlinkedCodeBlock*);
+    static bool encodeFunctionExecutable(Encoder&, UnlinkedFunctionExecutable*);
+    static UnlinkedFunctionExecutable* decodeFunctionExecutable(Decoder&);
+    static bool encodeVariableEnvironment(Encoder&, const VariableEnvironment&);
+    static bool decodeVariableEnvironment(Decoder&, VariableEnvironment&);
+    static bool encodeValue(Encoder&, JSValue);
+    static bool decodeValue(Decoder&, JSValue&);
+};
+
+} // namespace JSC
+
+#endif // UnlinkedCodeBlockSerializer_h
@@ -60,6 +60,7 @@ enum UnlinkedFunctionKind {
 class UnlinkedFunctionExecutable final : public JSCell {
 public:
     friend class CodeCache;
+    friend class UnlinkedCodeBlockSerializer;
     friend class VM;
 
     typedef JSCell Base;
@@ -129,6 +130,8 @@ public:
 
 private:
     UnlinkedFunctionExecutable(VM*, Structure*, const SourceCode&, RefPtr<SourceProvider>&& sourceOverride, FunctionMetadataNode*, UnlinkedFunctionKind, ConstructAbility, VariableEnvironment&);
+    // For UnlinkedCodeBlockSerializer, which fills in the fields itself.
+    UnlinkedFunctionExecutable(VM*, Structure*);
     WriteBarrier<UnlinkedFunctionCodeBlock> m_unlinkedCodeBlockForCall;
     WriteBarrier<UnlinkedFunctionCodeBlock> m_unlinkedCodeBlockForConstruct;
 
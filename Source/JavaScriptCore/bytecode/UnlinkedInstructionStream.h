@@ -37,6 +37,13 @@ class UnlinkedInstructionStream {
 public:
     explicit UnlinkedInstructionStream(const Vector<UnlinkedInstruction, 0, UnsafeVectorOverflow>&);
 
+    // Adopts an already packed stream, as written out by UnlinkedCodeBlockSerializer.
+    UnlinkedInstructionStream(const RefCountedArray<unsigned char>& data, unsigned instructionCount)
+        : m_data(data)
+        , m_instructionCount(instructionCount)
+    {
+    }
+
     unsigned count() const { return m_instructionCount; }
 
     class Reader {
@@ -61,6 +68,7 @@ public:
 
 private:
     friend class Reader;
+    friend class UnlinkedCodeBlockSerializer;
 
 #ifndef NDEBUG
     mutable RefCountedArray<UnlinkedInstruction> m_unpackedInstructionsForDebugging;
@@ -2144,6 +2144,11 @@ bool AbstractInterpreter<AbstractStateType>::executeEffects(unsigned clobberLimi
         break;
     }
         
+    case CallCustomGetter: {
+        forNode(node).setType(m_graph, node->callCustomGetterData()->resultType());
+        break;
+    }
+
     case MultiGetByOffset: {
         // This code will filter the base value in a manner that is possibly different (either more
         // or less precise) than the way it would be filtered if this was strength-reduced to a
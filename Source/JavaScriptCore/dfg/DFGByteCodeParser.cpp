@@ -2771,7 +2771,7 @@ Node* ByteCodeParser::load(
     
     SpeculatedType loadPrediction;
     NodeType loadOp;
-    if (variant.callLinkStatus() || variant.intrinsic() != NoIntrinsic) {
+    if (variant.callLinkStatus() || variant.intrinsic() != NoIntrinsic || variant.customGetter()) {
         loadPrediction = SpecCellOther;
         loadOp = GetGetterSetterByOffset;
     } else {
@@ -2842,7 +2842,7 @@ void ByteCodeParser::handleGetById(
         //    optimal, if there is some rarely executed case in the chain that requires a lot
         //    of checks and those checks are not watchpointable.
         for (const GetByIdVariant& variant : getByIdStatus.variants()) {
-            if (variant.intrinsic() != NoIntrinsic) {
+            if (variant.intrinsic() != NoIntrinsic || variant.customGetter()) {
                 set(VirtualRegister(destinationOperand),
                     addToGraph(getById, OpInfo(identifierNumber), OpInfo(prediction), base));
                 return;
@@ -2891,6 +2891,20 @@ void ByteCodeParser::handleGetById(
     if (m_graph.compilation())
         m_graph.compilation()->noticeInlinedGetById();
 
+    if (variant.customGetter()) {
+        // The checks that load() emitted are the ones the inline cache relies on to call the custom
+        // getter, so we don't need the CustomGetterSetter it loaded.
+        CallCustomGetterData* data = m_graph.m_callCustomGetterData.add();
+        data->customGetter = variant.customGetter();
+        data->intrinsic = variant.customGetterIntrinsic();
+        data->slotBase = m_graph.freeze(variant.conditionSet().slotBaseCondition().object());
+        data->structureSet = m_graph.addStructureSet(variant.structureSet());
+        data->identifierNumber = identifierNumber;
+        set(VirtualRegister(destinationOperand),
+            addToGraph(CallCustomGetter, OpInfo(data), OpInfo(prediction), base));
+        return;
+    }
+
     if (!variant.callLinkStatus() && variant.intrinsic() == NoIntrinsic) {
         set(VirtualRegister(destinationOperand), loadedValue);
         return;
@@ -793,6 +793,15 @@ void clobberize(Graph& graph, Node* node, const ReadFunctor& read, const WriteFu
         return;
     }
         
+    case CallCustomGetter: {
+        // The getter may allocate the wrapper of its result, but that is the only effect it has.
+        AbstractHeap heap(CustomGetterState, node->callCustomGetterData()->identifierNumber);
+        read(heap);
+        write(HeapObjectCount);
+        def(HeapLocation(CustomGetterLoc, heap, node->child1()), LazyNode(node));
+        return;
+    }
+
     case MultiPutByOffset: {
         read(JSCell_structureID);
         read(JSObject_butterfly);
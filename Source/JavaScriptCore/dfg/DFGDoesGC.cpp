@@ -254,6 +254,7 @@ bool doesGC(Graph& graph, Node* node)
     case MaterializeNewObject:
     case MaterializeCreateActivation:
     case StrCat:
+    case CallCustomGetter:
         return true;
         
     case MultiPutByOffset:
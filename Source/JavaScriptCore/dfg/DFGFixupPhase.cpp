@@ -1116,7 +1116,8 @@ private:
             break;
         }
             
-        case MultiGetByOffset: {
+        case MultiGetByOffset:
+        case CallCustomGetter: {
             fixEdge<CellUse>(node->child1());
             break;
         }
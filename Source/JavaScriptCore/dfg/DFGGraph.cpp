@@ -277,6 +277,12 @@ void Graph::dump(PrintStream& out, const char* prefix, Node* node, DumpContext*
                 out.print(" (inferred value = ", inContext(inferredValueForProperty(data.cases[i].set(), identifiers()[data.identifierNumber]), context), ")");
         }
     }
+    if (node->hasCallCustomGetterData()) {
+        CallCustomGetterData* data = node->callCustomGetterData();
+        out.print(comma, "id", data->identifierNumber, "{", identifiers()[data->identifierNumber], "}");
+        out.print(comma, "slotBase = ", inContext(*data->slotBase, context));
+        out.print(comma, inContext(*data->structureSet, context));
+    }
     if (node->hasMultiPutByOffsetData()) {
         MultiPutByOffsetData& data = node->multiPutByOffsetData();
         out.print(comma, "id", data.identifierNumber, "{", identifiers()[data.identifierNumber], "}");
@@ -1294,6 +1300,11 @@ void Graph::visitChildren(SlotVisitor& visitor)
                         visitor.appendUnbarrieredReadOnlyPointer(structure);
                 }
                 break;
+
+            case CallCustomGetter:
+                for (Structure* structure : *node->callCustomGetterData()->structureSet)
+                    visitor.appendUnbarrieredReadOnlyPointer(structure);
+                break;
                     
             case MultiPutByOffset:
                 for (unsigned i = node->multiPutByOffsetData().variants.size(); i--;) {
@@ -888,6 +888,7 @@ public:
     Bag<BranchData> m_branchData;
     Bag<SwitchData> m_switchData;
     Bag<MultiGetByOffsetData> m_multiGetByOffsetData;
+    Bag<CallCustomGetterData> m_callCustomGetterData;
     Bag<MultiPutByOffsetData> m_multiPutByOffsetData;
     Bag<ObjectMaterializationData> m_objectMaterializationData;
     Bag<CallVarargsData> m_callVarargsData;
@@ -71,6 +71,10 @@ void printInternal(PrintStream& out, LocationKind kind)
     case GetterLoc:
         out.print("GetterLoc");
         return;
+
+    case CustomGetterLoc:
+        out.print("CustomGetterLoc");
+        return;
         
     case SetterLoc:
         out.print("SetterLoc");
@@ -42,6 +42,7 @@ enum LocationKind {
     ButterflyReadOnlyLoc,
     CheckHasInstanceLoc,
     ClosureVariableLoc,
+    CustomGetterLoc,
     DirectArgumentsLoc,
     GetterLoc,
     GlobalVariableLoc,
@@ -219,6 +219,33 @@ struct StackAccessData {
     FlushedAt flushedAt() { return FlushedAt(format, machineLocal); }
 };
 
+// A custom getter that isCustomGetterIntrinsic() says has no side effects, called directly once the
+// structure of the base is known.
+struct CallCustomGetterData {
+    SpeculatedType resultType() const
+    {
+        switch (intrinsic) {
+        case CustomGetterReturningInt32Intrinsic:
+            return SpecInt32;
+        case CustomGetterReturningBooleanIntrinsic:
+            return SpecBoolean;
+        case CustomGetterReturningStringIntrinsic:
+            return SpecString;
+        case CustomGetterReturningObjectOrNullIntrinsic:
+            return SpecObject | SpecOther;
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+            return SpecHeapTop;
+        }
+    }
+
+    PropertySlot::GetValueFunc customGetter;
+    Intrinsic intrinsic;
+    FrozenValue* slotBase;
+    StructureSet* structureSet;
+    unsigned identifierNumber;
+};
+
 // This type used in passing an immediate argument to Node constructor;
 // distinguishes an immediate value (typically an index into a CodeBlock data structure - 
 // a constant index, argument, or identifier) from a Node*.
@@ -1059,6 +1086,17 @@ struct Node {
         return bitwise_cast<CallVarargsData*>(m_opInfo);
     }
     
+    bool hasCallCustomGetterData()
+    {
+        return op() == CallCustomGetter;
+    }
+
+    CallCustomGetterData* callCustomGetterData()
+    {
+        ASSERT(hasCallCustomGetterData());
+        return bitwise_cast<CallCustomGetterData*>(m_opInfo);
+    }
+
     bool hasLoadVarargsData()
     {
         return op() == LoadVarargs || op() == ForwardVarargs;
@@ -1324,6 +1362,7 @@ struct Node {
         case RegExpTest:
         case GetGlobalVar:
         case GetGlobalLexicalVariable:
+        case CallCustomGetter:
             return true;
         default:
             return false;
@@ -203,6 +203,7 @@ namespace JSC { namespace DFG {
     macro(GetByOffset, NodeResultJS) \
     macro(GetGetterSetterByOffset, NodeResultJS) \
     macro(MultiGetByOffset, NodeResultJS | NodeMustGenerate) \
+    macro(CallCustomGetter, NodeResultJS) \
     macro(PutByOffset, NodeMustGenerate) \
     macro(MultiPutByOffset, NodeMustGenerate) \
     macro(GetArrayLength, NodeResultInt32) \
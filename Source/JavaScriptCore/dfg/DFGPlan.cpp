@@ -81,6 +81,7 @@
 #include "ProfilerDatabase.h"
 #include "TrackedReferences.h"
 #include <wtf/CurrentTime.h>
+#include <wtf/TraceEvent.h>
 
 #if ENABLE(FTL_JIT)
 #include "FTLCapabilities.h"
@@ -146,6 +147,7 @@ Plan::Plan(CodeBlock* passedCodeBlock, CodeBlock* profiledDFGCodeBlock,
     , identifiers(codeBlock)
     , weakReferences(codeBlock)
     , willTryToTierUp(false)
+    , hotness(passedCodeBlock->alternative()->jitExecuteCounter().count())
     , stage(Preparing)
 {
 }
@@ -168,6 +170,8 @@ bool Plan::reportCompileTimes() const
 
 void Plan::compileInThread(LongLivedState& longLivedState, ThreadData* threadData)
 {
+    TraceScope traceScope(TraceCategory::JITCompilation, "DFG::Plan::compileInThread");
+
     this->threadData = threadData;
     
     double before = 0;
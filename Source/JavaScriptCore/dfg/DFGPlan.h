@@ -100,6 +100,10 @@ struct Plan : public ThreadSafeRefCounted<Plan> {
     
     bool willTryToTierUp;
 
+    // How many times the baseline version had executed when this plan was created. The worklist
+    // compiles hotter plans first. This is sampled on the main thread, so it never changes later.
+    double hotness;
+
     enum Stage { Preparing, Compiling, Compiled, Ready, Cancelled };
     Stage stage;
 
@@ -181,6 +181,7 @@ private:
         case GetByIdFlush:
         case GetByOffset:
         case MultiGetByOffset:
+        case CallCustomGetter:
         case GetDirectPname:
         case Call:
         case TailCallInlinedCaller:
@@ -403,6 +403,10 @@ bool safeToExecute(AbstractStateType& state, Graph& graph, Node* node)
         return true;
     }
 
+    case CallCustomGetter:
+        // The getter may rely on the class of the base; the structure check tells us what it is.
+        return state.forNode(node->child1()).m_structure.isSubsetOf(*node->callCustomGetterData()->structureSet);
+
     case LastNodeType:
         RELEASE_ASSERT_NOT_REACHED();
         return false;
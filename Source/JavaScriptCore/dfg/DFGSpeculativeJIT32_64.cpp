@@ -4862,6 +4862,7 @@ void SpeculativeJIT::compile(Node* node)
     case KillStack:
     case GetStack:
     case GetMyArgumentByVal:
+    case CallCustomGetter:
         DFG_CRASH(m_jit.graph(), node, "unexpected node in DFG backend");
         break;
     }
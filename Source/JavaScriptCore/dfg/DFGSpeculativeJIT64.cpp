@@ -4689,6 +4689,21 @@ void SpeculativeJIT::compile(Node* node)
         jsValueResult(resultGPR, node);
         break;
     }
+    case CallCustomGetter: {
+        CallCustomGetterData* data = node->callCustomGetterData();
+        SpeculateCellOperand base(this, node->child1());
+        GPRFlushedCallResult result(this);
+        GPRReg resultGPR = result.gpr();
+
+        flushRegisters();
+        callOperation(
+            bitwise_cast<J_JITOperation_ECJI>(data->customGetter), resultGPR,
+            data->slotBase->cell(), base.gpr(), identifierUID(data->identifierNumber));
+        m_jit.exceptionCheck();
+        jsValueResult(resultGPR, node);
+        break;
+    }
+
     case GetPropertyEnumerator: {
         SpeculateCellOperand base(this, node->child1());
         GPRFlushedCallResult result(this);
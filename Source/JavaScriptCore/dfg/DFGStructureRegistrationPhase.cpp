@@ -98,6 +98,10 @@ public:
                         registerStructures(getCase.set());
                     break;
                     
+                case CallCustomGetter:
+                    registerStructures(*node->callCustomGetterData()->structureSet);
+                    break;
+                    
                 case MultiPutByOffset:
                     for (unsigned i = node->multiPutByOffsetData().variants.size(); i--;) {
                         PutByIdVariant& variant = node->multiPutByOffsetData().variants[i];
@@ -47,8 +47,8 @@ Worklist::~Worklist()
 {
     {
         LockHolder locker(m_lock);
-        for (unsigned i = m_threads.size(); i--;)
-            m_queue.append(nullptr); // Use null plan to indicate that we want the thread to terminate.
+        // Threads drain the queue before they honor this.
+        m_numberOfThreadsToShutDown = m_threads.size();
         m_planEnqueued.notifyAll();
     }
     for (unsigned i = m_threads.size(); i--;)
@@ -274,13 +274,10 @@ void Worklist::removeDeadPlans(VM& vm)
         if (!deadPlanKeys.isEmpty()) {
             for (HashSet<CompilationKey>::iterator iter = deadPlanKeys.begin(); iter != deadPlanKeys.end(); ++iter)
                 m_plans.take(*iter)->cancel();
-            Deque<RefPtr<Plan>> newQueue;
-            while (!m_queue.isEmpty()) {
-                RefPtr<Plan> plan = m_queue.takeFirst();
-                if (plan->stage != Plan::Cancelled)
-                    newQueue.append(plan);
-            }
-            m_queue.swap(newQueue);
+            m_queue.removeAllMatching(
+                [] (const RefPtr<Plan>& plan) {
+                    return plan->stage == Plan::Cancelled;
+                });
             for (unsigned i = 0; i < m_readyPlans.size(); ++i) {
                 if (m_readyPlans[i]->stage != Plan::Cancelled)
                     continue;
@@ -324,6 +321,41 @@ void Worklist::dump(const LockHolder&, PrintStream& out) const
         ", Num Active Threads = ", m_numberOfActiveThreads, "/", m_threads.size(), "]");
 }
 
+RefPtr<Plan> Worklist::takeNextPlan(const LockHolder&)
+{
+    ASSERT(!m_queue.isEmpty());
+
+    // Compile the hottest plan first, so that hot functions do not wait behind cold ones. A VM
+    // that already has its share of plans compiling yields to other VMs' plans, but if nobody
+    // else is waiting we still let it use the idle thread.
+    unsigned cap = Options::maximumCompilingPlansPerVM();
+    size_t hottest = notFound;
+    size_t hottestUnderCap = notFound;
+    for (size_t i = 0; i < m_queue.size(); ++i) {
+        Plan& plan = *m_queue[i];
+        if (hottest == notFound || plan.hotness > m_queue[hottest]->hotness)
+            hottest = i;
+        if (cap && m_numberOfActivePlansForVM.get(&plan.vm) >= cap)
+            continue;
+        if (hottestUnderCap == notFound || plan.hotness > m_queue[hottestUnderCap]->hotness)
+            hottestUnderCap = i;
+    }
+
+    size_t index = hottestUnderCap != notFound ? hottestUnderCap : hottest;
+    RefPtr<Plan> plan = m_queue[index];
+    m_queue.remove(index);
+    return plan;
+}
+
+void Worklist::didFinishWithPlan(const LockHolder&, Plan& plan)
+{
+    m_numberOfActiveThreads--;
+    auto iter = m_numberOfActivePlansForVM.find(&plan.vm);
+    ASSERT(iter != m_numberOfActivePlansForVM.end());
+    if (!--iter->value)
+        m_numberOfActivePlansForVM.remove(iter);
+}
+
 void Worklist::runThread(ThreadData* data)
 {
     CompilationScope compilationScope;
@@ -337,18 +369,19 @@ void Worklist::runThread(ThreadData* data)
         RefPtr<Plan> plan;
         {
             LockHolder locker(m_lock);
-            while (m_queue.isEmpty())
+            while (m_queue.isEmpty() && !m_numberOfThreadsToShutDown)
                 m_planEnqueued.wait(m_lock);
             
-            plan = m_queue.takeFirst();
-            if (plan)
-                m_numberOfActiveThreads++;
-        }
-        
-        if (!plan) {
-            if (Options::verboseCompilationQueue())
-                dataLog(*this, ": Thread shutting down\n");
-            return;
+            if (m_queue.isEmpty()) {
+                m_numberOfThreadsToShutDown--;
+                if (Options::verboseCompilationQueue())
+                    dataLog(*this, ": Thread shutting down\n");
+                return;
+            }
+            
+            plan = takeNextPlan(locker);
+            m_numberOfActiveThreads++;
+            m_numberOfActivePlansForVM.add(&plan->vm, 0).iterator->value++;
         }
         
         {
@@ -356,7 +389,7 @@ void Worklist::runThread(ThreadData* data)
             {
                 LockHolder locker(m_lock);
                 if (plan->stage == Plan::Cancelled) {
-                    m_numberOfActiveThreads--;
+                    didFinishWithPlan(locker, *plan);
                     continue;
                 }
                 plan->notifyCompiling();
@@ -372,7 +405,7 @@ void Worklist::runThread(ThreadData* data)
             {
                 LockHolder locker(m_lock);
                 if (plan->stage == Plan::Cancelled) {
-                    m_numberOfActiveThreads--;
+                    didFinishWithPlan(locker, *plan);
                     continue;
                 }
                 plan->notifyCompiled();
@@ -386,7 +419,7 @@ void Worklist::runThread(ThreadData* data)
             // We could have been cancelled between releasing rightToRun and acquiring m_lock.
             // This would mean that we might be in the middle of GC right now.
             if (plan->stage == Plan::Cancelled) {
-                m_numberOfActiveThreads--;
+                didFinishWithPlan(locker, *plan);
                 continue;
             }
             
@@ -400,7 +433,7 @@ void Worklist::runThread(ThreadData* data)
             m_readyPlans.append(plan);
             
             m_planCompiled.notifyAll();
-            m_numberOfActiveThreads--;
+            didFinishWithPlan(locker, *plan);
         }
     }
 }
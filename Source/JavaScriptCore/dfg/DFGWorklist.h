@@ -31,7 +31,6 @@
 #include "DFGPlan.h"
 #include "DFGThreadData.h"
 #include <wtf/Condition.h>
-#include <wtf/Deque.h>
 #include <wtf/HashMap.h>
 #include <wtf/Lock.h>
 #include <wtf/Noncopyable.h>
@@ -87,12 +86,16 @@ private:
     
     void removeAllReadyPlansForVM(VM&, Vector<RefPtr<Plan>, 8>&);
 
+    RefPtr<Plan> takeNextPlan(const LockHolder&);
+    void didFinishWithPlan(const LockHolder&, Plan&);
+
     void dump(const LockHolder&, PrintStream&) const;
     
     CString m_threadName;
     
-    // Used to inform the thread about what work there is left to do.
-    Deque<RefPtr<Plan>> m_queue;
+    // Used to inform the thread about what work there is left to do. This is kept in
+    // enqueue order; takeNextPlan() picks the hottest plan and breaks ties by age.
+    Vector<RefPtr<Plan>> m_queue;
     
     // Used to answer questions about the current state of a code block. This
     // is particularly great for the cti_optimize OSR slow path, which wants
@@ -113,6 +116,10 @@ private:
     
     Vector<std::unique_ptr<ThreadData>> m_threads;
     unsigned m_numberOfActiveThreads;
+    unsigned m_numberOfThreadsToShutDown { 0 };
+
+    // Number of plans each VM has being compiled right now, for the fairness cap.
+    HashMap<VM*, unsigned> m_numberOfActivePlansForVM;
 };
 
 // For DFGMode compilations.
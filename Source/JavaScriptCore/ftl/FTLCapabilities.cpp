@@ -150,6 +150,7 @@ inline CapabilityLevel canCompile(Node* node)
     case ConstantStoragePointer:
     case Check:
     case CountExecution:
+    case ProfileControlFlow:
     case GetExecutable:
     case GetScope:
     case LoadArrowFunctionThis:
@@ -163,6 +164,7 @@ inline CapabilityLevel canCompile(Node* node)
     case GetByIdFlush:
     case ToThis:
     case MultiGetByOffset:
+    case CallCustomGetter:
     case MultiPutByOffset:
     case ToPrimitive:
     case Throw:
@@ -731,6 +731,9 @@ private:
         case MultiGetByOffset:
             compileMultiGetByOffset();
             break;
+        case CallCustomGetter:
+            compileCallCustomGetter();
+            break;
         case PutByOffset:
             compilePutByOffset();
             break;
@@ -874,6 +877,9 @@ private:
         case CountExecution:
             compileCountExecution();
             break;
+        case ProfileControlFlow:
+            compileProfileControlFlow();
+            break;
         case StoreBarrier:
             compileStoreBarrier();
             break;
@@ -4116,6 +4122,16 @@ private:
             lowStorage(m_node->child1()), data.identifierNumber, data.offset));
     }
     
+    void compileCallCustomGetter()
+    {
+        CallCustomGetterData* data = m_node->callCustomGetterData();
+        LValue base = lowCell(m_node->child1());
+        setJSValue(vmCall(
+            m_out.operation(bitwise_cast<J_JITOperation_ECJI>(data->customGetter)), m_callFrame,
+            weakPointer(data->slotBase->cell()), base,
+            m_out.constIntPtr(m_graph.identifiers()[data->identifierNumber])));
+    }
+
     void compileGetGetter()
     {
         setJSValue(m_out.loadPtr(lowCell(m_node->child1()), m_heaps.GetterSetter_getter));
@@ -5336,6 +5352,16 @@ private:
         TypedPointer counter = m_out.absolute(m_node->executionCounter()->address());
         m_out.store64(m_out.add(m_out.load64(counter), m_out.constInt64(1)), counter);
     }
+
+    void compileProfileControlFlow()
+    {
+        TypedPointer counter = m_out.absolute(m_node->basicBlockLocation()->executionCountAddress());
+        if (Options::useBasicBlockCoverage()) {
+            m_out.store64(m_out.constInt64(1), counter);
+            return;
+        }
+        m_out.store64(m_out.add(m_out.load64(counter), m_out.constInt64(1)), counter);
+    }
     
     void compileStoreBarrier()
     {
@@ -8758,6 +8784,7 @@ private:
                             CCallHelpers::BaseIndex(
                                 scratch1, scratch2, CCallHelpers::ScalePtr,
                                 static_cast<int32_t>(-sizeof(void*))));
+                        jit.setCellStateToRemembered(baseGPR);
 
                         scratchRegisterAllocator.restoreReusedRegistersByPopping(jit, bytesPushed, ScratchRegisterAllocator::ExtraStackSpace::SpaceForCCall);
 
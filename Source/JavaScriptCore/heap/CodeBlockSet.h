@@ -64,6 +64,9 @@ public:
     // blocks. This is defined in CodeBlock.h.
     void mark(CodeBlock* candidateCodeBlock);
     void mark(void* candidateCodeBlock);
+
+    // Returns true if the pointer is a live CodeBlock. The pointer may be any value.
+    bool contains(void* candidateCodeBlock);
     
     // Delete all code blocks that are only referenced by this set (i.e. owned
     // by this set), and that have not been marked.
@@ -39,6 +39,7 @@ public:
     CheckedBoolean tryAllocate(size_t bytes, void** outPtr);
     CheckedBoolean tryAllocateDuringCopying(size_t bytes, void** outPtr);
     CheckedBoolean tryReallocate(void *oldPtr, size_t oldBytes, size_t newBytes);
+    size_t bytesAvailableForInPlaceGrowth(void* ptr, size_t bytes);
     void* forceAllocate(size_t bytes);
     CopiedBlock* resetCurrentBlock();
     void setCurrentBlock(CopiedBlock*);
@@ -124,6 +125,13 @@ inline CheckedBoolean CopiedAllocator::tryReallocate(
     return true;
 }
 
+inline size_t CopiedAllocator::bytesAvailableForInPlaceGrowth(void* ptr, size_t bytes)
+{
+    if (m_currentPayloadEnd - m_currentRemaining - bytes != static_cast<char*>(ptr))
+        return 0;
+    return m_currentRemaining;
+}
+
 inline void* CopiedAllocator::forceAllocate(size_t bytes)
 {
     void* result = 0; // Needed because compilers don't realize this will always be assigned.
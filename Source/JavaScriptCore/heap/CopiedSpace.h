@@ -52,6 +52,8 @@ public:
 
     CheckedBoolean tryAllocate(size_t, void**);
     CheckedBoolean tryReallocate(void**, size_t, size_t);
+    // How many bytes the allocation at ptr could grow by in tryReallocate() without being moved.
+    size_t bytesAvailableForInPlaceGrowth(void* ptr, size_t);
     
     CopiedAllocator& allocator() { return m_allocator; }
 
@@ -159,6 +159,13 @@ inline CheckedBoolean CopiedSpace::tryAllocate(size_t bytes, void** outPtr)
     return true;
 }
 
+inline size_t CopiedSpace::bytesAvailableForInPlaceGrowth(void* ptr, size_t bytes)
+{
+    if (isOversize(bytes) || CopiedSpace::blockFor(ptr)->isOversize())
+        return 0;
+    return std::min(m_allocator.bytesAvailableForInPlaceGrowth(ptr, bytes), s_maxAllocationSize - bytes);
+}
+
 inline bool CopiedSpace::isOversize(size_t bytes)
 {
     return bytes > s_maxAllocationSize;
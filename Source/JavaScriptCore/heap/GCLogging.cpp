@@ -113,6 +113,49 @@ void GCLogging::dumpObjectGraph(Heap* heap)
     loggingFunctor.log();
 }
 
+void GCLogging::PauseStatistics::Record::add(double markingTime, double copyingTime, double pauseTime)
+{
+    count++;
+    totalPauseTime += pauseTime;
+    maxPauseTime = std::max(maxPauseTime, pauseTime);
+    totalMarkingTime += markingTime;
+    maxMarkingTime = std::max(maxMarkingTime, markingTime);
+    totalCopyingTime += copyingTime;
+    maxCopyingTime = std::max(maxCopyingTime, copyingTime);
+}
+
+void GCLogging::PauseStatistics::Record::dump(PrintStream& out, const char* name) const
+{
+    if (!count) {
+        out.print(name, ": none");
+        return;
+    }
+    out.printf("%s: %zu, pause avg %.2lfms max %.2lfms, marking avg %.2lfms max %.2lfms, copying avg %.2lfms max %.2lfms",
+        name, count,
+        totalPauseTime * 1000 / count, maxPauseTime * 1000,
+        totalMarkingTime * 1000 / count, maxMarkingTime * 1000,
+        totalCopyingTime * 1000 / count, maxCopyingTime * 1000);
+}
+
+void GCLogging::PauseStatistics::didFinishCollection(HeapOperation collectionType, double markingTime, double copyingTime, double pauseTime)
+{
+    ASSERT(collectionType == EdenCollection || collectionType == FullCollection);
+    Record& record = collectionType == EdenCollection ? m_edenCollections : m_fullCollections;
+    record.add(markingTime, copyingTime, pauseTime);
+
+    static const size_t maxRecentPauses = 10000;
+    if (m_recentPauses.size() == maxRecentPauses)
+        m_recentPauses.removeFirst();
+    m_recentPauses.append({ collectionType, pauseTime });
+}
+
+void GCLogging::PauseStatistics::dump(PrintStream& out) const
+{
+    m_edenCollections.dump(out, "Eden");
+    out.print("; ");
+    m_fullCollections.dump(out, "Full");
+}
+
 } // namespace JSC
 
 namespace WTF {
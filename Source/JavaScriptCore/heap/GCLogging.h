@@ -26,7 +26,10 @@
 #ifndef GCLogging_h
 #define GCLogging_h
 
+#include "HeapOperation.h"
 #include <wtf/Assertions.h>
+#include <wtf/Deque.h>
+#include <wtf/PrintStream.h>
 
 namespace JSC {
 
@@ -42,6 +45,42 @@ public:
 
     static const char* levelAsString(Level);
     static void dumpObjectGraph(Heap*);
+
+    // Tracks how long the mutator was paused by each kind of collection, and how much of each
+    // pause was spent marking and copying. Times are in seconds.
+    class PauseStatistics {
+    public:
+        struct Pause {
+            HeapOperation collectionType;
+            double pauseTime;
+        };
+
+        void didFinishCollection(HeapOperation collectionType, double markingTime, double copyingTime, double pauseTime);
+
+        void dump(PrintStream&) const;
+
+        // The most recent pauses, oldest first, so that tools can compute pause time percentiles.
+        const Deque<Pause>& recentPauses() const { return m_recentPauses; }
+        void clearRecentPauses() { m_recentPauses.clear(); }
+
+    private:
+        struct Record {
+            void add(double markingTime, double copyingTime, double pauseTime);
+            void dump(PrintStream&, const char* name) const;
+
+            size_t count { 0 };
+            double totalPauseTime { 0 };
+            double maxPauseTime { 0 };
+            double totalMarkingTime { 0 };
+            double maxMarkingTime { 0 };
+            double totalCopyingTime { 0 };
+            double maxCopyingTime { 0 };
+        };
+
+        Record m_edenCollections;
+        Record m_fullCollections;
+        Deque<Pause> m_recentPauses;
+    };
 };
 
 typedef GCLogging::Level gcLogLevel;
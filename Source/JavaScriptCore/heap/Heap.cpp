@@ -34,6 +34,7 @@
 #include "HeapHelperPool.h"
 #include "HeapIterationScope.h"
 #include "HeapRootVisitor.h"
+#include "HeapSnapshotWriter.h"
 #include "HeapStatistics.h"
 #include "HeapVerifier.h"
 #include "IncrementalSweeper.h"
@@ -42,6 +43,8 @@
 #include "JSGlobalObject.h"
 #include "JSLock.h"
 #include "JSVirtualMachineInternal.h"
+#include "MegamorphicCache.h"
+#include "SamplingProfiler.h"
 #include "Tracing.h"
 #include "TypeProfilerLog.h"
 #include "UnlinkedCodeBlock.h"
@@ -52,6 +55,7 @@
 #include <wtf/ParallelVectorIterator.h>
 #include <wtf/ProcessID.h>
 #include <wtf/RAMSize.h>
+#include <wtf/TraceEvent.h>
 
 using namespace std;
 
@@ -212,8 +216,10 @@ static inline size_t minHeapSize(HeapType heapType, size_t ramSize)
     return smallHeapSize;
 }
 
-static inline size_t proportionalHeapSize(size_t heapSize, size_t ramSize)
+static inline size_t proportionalHeapSize(size_t heapSize, size_t ramSize, bool isUnderMemoryPressure)
 {
+    if (isUnderMemoryPressure)
+        return 1.25 * heapSize;
     // Try to stay under 1/2 RAM size to leave room for the DOM, rendering, networking, etc.
     if (heapSize < ramSize / 4)
         return 2 * heapSize;
@@ -315,6 +321,7 @@ Heap::Heap(VM* vm, HeapType heapType)
     : m_heapType(heapType)
     , m_ramSize(Options::forceRAMSize() ? Options::forceRAMSize() : ramSize())
     , m_minBytesPerCycle(minHeapSize(m_heapType, m_ramSize))
+    , m_targetHeapSize(Options::gcTargetHeapSize())
     , m_sizeAfterLastCollect(0)
     , m_sizeAfterLastFullCollect(0)
     , m_sizeBeforeLastFullCollect(0)
@@ -362,6 +369,9 @@ Heap::Heap(VM* vm, HeapType heapType)
 
 Heap::~Heap()
 {
+    if (Options::logGC())
+        dataLog("[GC pauses: ", m_pauseStatistics, "]\n");
+
     for (WeakBlock* block : m_logicallyEmptyWeakBlocks)
         WeakBlock::destroy(*this, block);
 }
@@ -572,7 +582,7 @@ void Heap::markRoots(double gcStartTime, void* stackOrigin, void* stackTop, Mach
     {
         ParallelModeEnabler enabler(m_slotVisitor);
 
-        m_slotVisitor.donateAndDrain();
+        donateOrDrainRoots();
         visitExternalRememberedSet();
         visitSmallStrings();
         visitConservativeRoots(conservativeRoots);
@@ -620,8 +630,14 @@ void Heap::copyBackingStores()
             WTF::copyToVector(m_storageSpace.m_blockSet, m_blocksToCopy);
         }
 
-        ParallelVectorIterator<Vector<CopiedBlock*>> iterator(
-            m_blocksToCopy, s_blockFragmentLength);
+        // Hand out blocks in fragments that are small enough for every copying thread to get
+        // several of them. Otherwise a small copy phase ends up with one thread copying the last
+        // fragment while everyone else waits.
+        size_t numberOfCopyingThreads = m_helperClient.pool().numberOfThreads() + 1;
+        size_t fragmentLength = std::max<size_t>(1, std::min(
+            s_blockFragmentLength, m_blocksToCopy.size() / (numberOfCopyingThreads * s_fragmentsPerCopyingThread)));
+
+        ParallelVectorIterator<Vector<CopiedBlock*>> iterator(m_blocksToCopy, fragmentLength);
 
         // Note that it's safe to use the [&] capture list here, even though we're creating a task
         // that other threads run. That's because after runFunctionInParallel() returns, the task
@@ -694,6 +710,18 @@ void Heap::clearLivenessData()
     m_objectSpace.clearMarks();
 }
 
+void Heap::donateOrDrainRoots()
+{
+    // By default, the collector thread drains whatever a root set pushed before it moves on to the
+    // next one. If we have helper threads, we can instead hand all of that work off to them and keep
+    // scanning roots on this thread while they trace. Either way, converge() finishes the job.
+    if (Options::useConcurrentRootScanning() && Options::numberOfGCMarkers() > 1) {
+        m_slotVisitor.donateAll();
+        return;
+    }
+    m_slotVisitor.donateAndDrain();
+}
+
 void Heap::visitExternalRememberedSet()
 {
 #if JSC_OBJC_API_ENABLED
@@ -710,7 +738,7 @@ void Heap::visitSmallStrings()
     m_vm->smallStrings.visitStrongReferences(m_slotVisitor);
     if (Options::logGC() == GCLogging::Verbose)
         dataLog("Small strings:\n", m_slotVisitor);
-    m_slotVisitor.donateAndDrain();
+    donateOrDrainRoots();
 }
 
 void Heap::visitConservativeRoots(ConservativeRoots& roots)
@@ -721,7 +749,7 @@ void Heap::visitConservativeRoots(ConservativeRoots& roots)
     if (Options::logGC() == GCLogging::Verbose)
         dataLog("Conservative Roots:\n", m_slotVisitor);
 
-    m_slotVisitor.donateAndDrain();
+    donateOrDrainRoots();
 }
 
 void Heap::visitCompilerWorklistWeakReferences()
@@ -754,7 +782,7 @@ void Heap::visitProtectedObjects(HeapRootVisitor& heapRootVisitor)
     if (Options::logGC() == GCLogging::Verbose)
         dataLog("Protected Objects:\n", m_slotVisitor);
 
-    m_slotVisitor.donateAndDrain();
+    donateOrDrainRoots();
 }
 
 void Heap::visitArgumentBuffers(HeapRootVisitor& visitor)
@@ -768,7 +796,7 @@ void Heap::visitArgumentBuffers(HeapRootVisitor& visitor)
     if (Options::logGC() == GCLogging::Verbose)
         dataLog("Argument Buffers:\n", m_slotVisitor);
 
-    m_slotVisitor.donateAndDrain();
+    donateOrDrainRoots();
 }
 
 void Heap::visitException(HeapRootVisitor& visitor)
@@ -783,7 +811,7 @@ void Heap::visitException(HeapRootVisitor& visitor)
     if (Options::logGC() == GCLogging::Verbose)
         dataLog("Exceptions:\n", m_slotVisitor);
 
-    m_slotVisitor.donateAndDrain();
+    donateOrDrainRoots();
 }
 
 void Heap::visitStrongHandles(HeapRootVisitor& visitor)
@@ -794,7 +822,7 @@ void Heap::visitStrongHandles(HeapRootVisitor& visitor)
     if (Options::logGC() == GCLogging::Verbose)
         dataLog("Strong Handles:\n", m_slotVisitor);
 
-    m_slotVisitor.donateAndDrain();
+    donateOrDrainRoots();
 }
 
 void Heap::visitHandleStack(HeapRootVisitor& visitor)
@@ -805,7 +833,7 @@ void Heap::visitHandleStack(HeapRootVisitor& visitor)
     if (Options::logGC() == GCLogging::Verbose)
         dataLog("Handle Stack:\n", m_slotVisitor);
 
-    m_slotVisitor.donateAndDrain();
+    donateOrDrainRoots();
 }
 
 void Heap::traceCodeBlocksAndJITStubRoutines()
@@ -816,7 +844,7 @@ void Heap::traceCodeBlocksAndJITStubRoutines()
     if (Options::logGC() == GCLogging::Verbose)
         dataLog("Code Blocks and JIT Stub Routines:\n", m_slotVisitor);
 
-    m_slotVisitor.donateAndDrain();
+    donateOrDrainRoots();
 }
 
 void Heap::converge()
@@ -990,6 +1018,16 @@ void Heap::addToRememberedSet(const JSCell* cell)
     m_slotVisitor.appendToMarkStack(const_cast<JSCell*>(cell));
 }
 
+void Heap::addBufferedCellToRememberedSet(const JSCell* cell)
+{
+    ASSERT(cell);
+    // The JITs mark a cell as remembered as soon as they put it in the WriteBarrierBuffer, which
+    // keeps repeated stores into the same old object from filling the buffer. All that's left to do
+    // is to push it onto the mark stack.
+    ASSERT(cell->cellState() == CellState::OldGrey);
+    m_slotVisitor.appendToMarkStack(const_cast<JSCell*>(cell));
+}
+
 void* Heap::copyBarrier(const JSCell*, void*& pointer)
 {
     // Do nothing for now, except making sure that the low bits are masked off. This helps to
@@ -1022,12 +1060,15 @@ NEVER_INLINE void Heap::collect(HeapOperation collectionType)
     ALLOCATE_AND_GET_REGISTER_STATE(registers);
 
     collectImpl(collectionType, wtfThreadData().stack().origin(), &stackTop, registers);
+    sweepDeadLargeBlocks();
 
     sanitizeStackForVM(m_vm);
 }
 
 NEVER_INLINE void Heap::collectImpl(HeapOperation collectionType, void* stackOrigin, void* stackTop, MachineThreads::RegisterState& calleeSavedRegisters)
 {
+    TraceScope traceScope(TraceCategory::GarbageCollection, "Heap::collect");
+
 #if ENABLE(ALLOCATION_LOGGING)
     dataLogF("JSC GC starting collection.\n");
 #endif
@@ -1044,6 +1085,14 @@ NEVER_INLINE void Heap::collectImpl(HeapOperation collectionType, void* stackOri
         DeferGCForAWhile awhile(*this);
         vm()->typeProfilerLog()->processLogEntries(ASCIILiteral("GC"));
     }
+
+#if ENABLE(JIT)
+    // Samples name CodeBlocks by address, so they have to be resolved before this collection can free any.
+    if (vm()->samplingProfiler()) {
+        DeferGCForAWhile awhile(*this);
+        vm()->samplingProfiler()->processUnverifiedStackTraces();
+    }
+#endif
     
     RELEASE_ASSERT(!m_deferralDepth);
     ASSERT(vm()->currentThreadIsHoldingAPILock());
@@ -1070,7 +1119,9 @@ NEVER_INLINE void Heap::collectImpl(HeapOperation collectionType, void* stackOri
     stopAllocation();
     flushWriteBarrierBuffer();
 
+    double markingStartTime = WTF::monotonicallyIncreasingTime();
     markRoots(gcStartTime, stackOrigin, stackTop, calleeSavedRegisters);
+    m_lastMarkingLength = WTF::monotonicallyIncreasingTime() - markingStartTime;
 
     if (m_verifier) {
         m_verifier->gatherLiveObjects(HeapVerifier::Phase::AfterMarking);
@@ -1081,21 +1132,27 @@ NEVER_INLINE void Heap::collectImpl(HeapOperation collectionType, void* stackOri
     if (vm()->typeProfiler())
         vm()->typeProfiler()->invalidateTypeSetCache();
 
+    // Dead structures will give up their IDs when they are swept.
+    vm()->megamorphicCache()->clear();
+
     reapWeakHandles();
     pruneStaleEntriesFromWeakGCMaps();
     sweepArrayBuffers();
     snapshotMarkedSpace();
 
+    double copyingStartTime = WTF::monotonicallyIncreasingTime();
     copyBackingStores();
+    m_lastCopyingLength = WTF::monotonicallyIncreasingTime() - copyingStartTime;
 
     finalizeUnconditionalFinalizers();
     removeDeadCompilerWorklistEntries();
     deleteUnmarkedCompiledCode();
-    deleteSourceProviderCaches();
+    pruneSourceProviderCaches();
     notifyIncrementalSweeper();
     writeBarrierCurrentlyExecutingCodeBlocks();
 
     resetAllocators();
+    presweepBlocksWithoutDestructors();
     updateAllocationLimits();
     didFinishCollection(gcStartTime);
     resumeCompilerThreads();
@@ -1107,7 +1164,9 @@ NEVER_INLINE void Heap::collectImpl(HeapOperation collectionType, void* stackOri
 
     if (Options::logGC()) {
         double after = currentTimeMS();
-        dataLog(after - before, " ms]\n");
+        dataLog(m_lastMarkingLength * 1000, " ms marking, ", m_lastCopyingLength * 1000, " ms copying, ", after - before, " ms]\n");
+        if (Options::logGC() == GCLogging::Verbose)
+            dataLog("[GC pauses: ", m_pauseStatistics, "]\n");
     }
 }
 
@@ -1165,6 +1224,10 @@ void Heap::flushOldStructureIDTables()
 {
     GCPHASE(FlushOldStructureIDTables);
     m_structureIDTable.flushOldTables();
+
+    // Only full collections free enough Structures to make repacking the ID table worthwhile.
+    if (m_operationInProgress == FullCollection)
+        m_structureIDTable.compact();
 }
 
 void Heap::flushWriteBarrierBuffer()
@@ -1235,10 +1298,11 @@ void Heap::snapshotMarkedSpace()
     }
 }
 
-void Heap::deleteSourceProviderCaches()
+void Heap::pruneSourceProviderCaches()
 {
-    GCPHASE(DeleteSourceProviderCaches);
-    m_vm->clearSourceProviderCaches();
+    GCPHASE(PruneSourceProviderCaches);
+    if (m_operationInProgress == FullCollection)
+        m_vm->pruneSourceProviderCaches();
 }
 
 void Heap::notifyIncrementalSweeper()
@@ -1265,6 +1329,29 @@ void Heap::resetAllocators()
     m_objectSpace.resetAllocators();
 }
 
+void Heap::presweepBlocksWithoutDestructors()
+{
+    GCPHASE(PresweepBlocksWithoutDestructors);
+    // Zombie and immortal object modes need to see the dead cells that presweeping overwrites.
+    if (!Options::useParallelPresweeping() || Options::useZombieMode() || Options::useImmortalObjects())
+        return;
+
+    // Blocks without destructors don't need anything from the mutator's thread to be swept, so we
+    // build their free lists here, on all of the helper threads, rather than one at a time when the
+    // mutator first allocates from them. Blocks with no marked cells are left for the incremental
+    // sweeper, which will most likely free them.
+    ParallelVectorIterator<Vector<MarkedBlock*>> iterator(m_blockSnapshot, s_blockFragmentLength);
+    m_helperClient.runFunctionInParallel(
+        [&] () {
+            iterator.iterate(
+                [&] (MarkedBlock* block) {
+                    if (block->needsDestruction() || !block->markCount())
+                        return;
+                    block->presweep();
+                });
+        });
+}
+
 void Heap::updateAllocationLimits()
 {
     GCPHASE(UpdateAllocationLimits);
@@ -1311,7 +1398,8 @@ void Heap::updateAllocationLimits()
         // To avoid pathological GC churn in very small and very large heaps, we set
         // the new allocation limit based on the current size of the heap, with a
         // fixed minimum.
-        m_maxHeapSize = max(minHeapSize(m_heapType, m_ramSize), proportionalHeapSize(currentHeapSize, m_ramSize));
+        size_t budget = heapSizingBudget();
+        m_maxHeapSize = max(minHeapSize(m_heapType, budget), proportionalHeapSize(currentHeapSize, budget, isUnderMemoryPressure()));
         m_maxEdenSize = m_maxHeapSize - currentHeapSize;
         m_sizeAfterLastFullCollect = currentHeapSize;
         m_bytesAbandonedSinceLastFullCollect = 0;
@@ -1332,6 +1420,9 @@ void Heap::updateAllocationLimits()
         double minEdenToOldGenerationRatio = 1.0 / 3.0;
         if (edenToOldGenerationRatio < minEdenToOldGenerationRatio)
             m_shouldDoFullCollection = true;
+        // Eden collections can't give memory back from the old generation.
+        if (isUnderMemoryPressure())
+            m_shouldDoFullCollection = true;
         // This seems suspect at first, but what it does is ensure that the nursery size is fixed.
         m_maxHeapSize += currentHeapSize - m_sizeAfterLastCollect;
         m_maxEdenSize = m_maxHeapSize - currentHeapSize;
@@ -1348,6 +1439,15 @@ void Heap::updateAllocationLimits()
         dataLog(currentHeapSize / 1024, " kb, ");
 }
 
+size_t Heap::heapSizingBudget() const
+{
+    // The sizing heuristics try to keep the heap under half of the budget, so a target footprint
+    // stands in for a machine with twice that much RAM.
+    if (m_targetHeapSize)
+        return 2 * m_targetHeapSize;
+    return m_ramSize;
+}
+
 void Heap::didFinishCollection(double gcStartTime)
 {
     GCPHASE(FinishingCollection);
@@ -1358,8 +1458,22 @@ void Heap::didFinishCollection(double gcStartTime)
     else
         m_lastEdenGCLength = gcEndTime - gcStartTime;
 
-    if (Options::recordGCPauseTimes())
+    if (Options::recordGCPauseTimes()) {
         HeapStatistics::recordGCPauseTime(gcStartTime, gcEndTime);
+        HeapStatistics::recordGCPhaseTimes(m_lastMarkingLength, m_lastCopyingLength);
+    }
+
+    m_pauseStatistics.didFinishCollection(operation, m_lastMarkingLength, m_lastCopyingLength, gcEndTime - gcStartTime);
+
+    m_lastCollectionEvent.operation = operation;
+    m_lastCollectionEvent.startTime = gcStartTime;
+    m_lastCollectionEvent.pauseLength = gcEndTime - gcStartTime;
+    m_lastCollectionEvent.markingLength = m_lastMarkingLength;
+    m_lastCollectionEvent.copyingLength = m_lastCopyingLength;
+    m_lastCollectionEvent.bytesVisited = m_totalBytesVisitedThisCycle;
+    m_lastCollectionEvent.bytesCopied = m_totalBytesCopiedThisCycle;
+    m_lastCollectionEvent.sizeBefore = operation == FullCollection ? m_sizeBeforeLastFullCollect : m_sizeBeforeLastEdenCollect;
+    m_lastCollectionEvent.sizeAfter = m_sizeAfterLastCollect;
 
     if (Options::useZombieMode())
         zombifyDeadObjects();
@@ -1370,15 +1484,33 @@ void Heap::didFinishCollection(double gcStartTime)
     if (Options::dumpObjectStatistics())
         HeapStatistics::dumpObjectStatistics(this);
 
+    if (Options::dumpExecutableMemoryStatistics() && operation == FullCollection)
+        HeapStatistics::dumpExecutableMemoryStatistics(this);
+
     if (Options::logGC() == GCLogging::Verbose)
         GCLogging::dumpObjectGraph(this);
 
+    if (m_snapshotFileDescriptor != -1 && operation == FullCollection)
+        m_didWriteSnapshot = HeapSnapshotWriter(*this, m_snapshotFileDescriptor).write();
+
     RELEASE_ASSERT(m_operationInProgress == EdenCollection || m_operationInProgress == FullCollection);
     m_operationInProgress = NoOperation;
     JAVASCRIPTCORE_GC_END();
 
-    for (auto* observer : m_observers)
+    for (auto* observer : m_observers) {
         observer->didGarbageCollect(operation);
+        observer->didFinishCollection(m_lastCollectionEvent);
+    }
+}
+
+bool Heap::writeSnapshot(int fileDescriptor)
+{
+    ASSERT(m_snapshotFileDescriptor == -1);
+    m_snapshotFileDescriptor = fileDescriptor;
+    m_didWriteSnapshot = false;
+    collectAllGarbage();
+    m_snapshotFileDescriptor = -1;
+    return m_didWriteSnapshot;
 }
 
 void Heap::resumeCompilerThreads()
@@ -1524,7 +1656,7 @@ void Heap::zombifyDeadObjects()
 void Heap::flushWriteBarrierBuffer(JSCell* cell)
 {
     m_writeBarrierBuffer.flush(*this);
-    m_writeBarrierBuffer.add(cell);
+    writeBarrier(cell);
 }
 
 bool Heap::shouldDoFullCollection(HeapOperation requestedCollectionType) const
@@ -1552,6 +1684,23 @@ void Heap::addLogicallyEmptyWeakBlock(WeakBlock* block)
     m_logicallyEmptyWeakBlocks.append(block);
 }
 
+void Heap::sweepDeadLargeBlocks()
+{
+    // Each large block holds a single cell, so once that cell is dead the whole block is garbage.
+    // Rather than holding on to it until the incremental sweeper gets there, give it back now.
+    DeferGCForAWhile deferGC(*this);
+    Vector<MarkedBlock*> freedBlocks;
+    m_objectSpace.sweepDeadLargeBlocks(freedBlocks);
+    if (freedBlocks.isEmpty())
+        return;
+
+    // The incremental sweeper must not visit the blocks we just freed.
+    std::sort(freedBlocks.begin(), freedBlocks.end());
+    m_blockSnapshot.removeAllMatching([&] (MarkedBlock* block) {
+        return std::binary_search(freedBlocks.begin(), freedBlocks.end(), block);
+    });
+}
+
 void Heap::sweepAllLogicallyEmptyWeakBlocks()
 {
     if (m_logicallyEmptyWeakBlocks.isEmpty())
@@ -119,6 +119,7 @@ public:
     MarkedSpace& objectSpace() { return m_objectSpace; }
     CopiedSpace& storageSpace() { return m_storageSpace; }
     MachineThreads& machineThreads() { return m_machineThreads; }
+    CodeBlockSet& codeBlockSet() { return m_codeBlocks; }
 
     const SlotVisitor& slotVisitor() const { return m_slotVisitor; }
 
@@ -202,6 +203,15 @@ public:
 
     double lastFullGCLength() const { return m_lastFullGCLength; }
     double lastEdenGCLength() const { return m_lastEdenGCLength; }
+    double lastMarkingLength() const { return m_lastMarkingLength; }
+    double lastCopyingLength() const { return m_lastCopyingLength; }
+    const GCLogging::PauseStatistics& pauseStatistics() const { return m_pauseStatistics; }
+    void clearRecentGCPauses() { m_pauseStatistics.clearRecentPauses(); }
+    const HeapCollectionEvent& lastCollectionEvent() const { return m_lastCollectionEvent; }
+
+    // Does a full collection and streams the resulting object graph to the file descriptor in the
+    // format described in HeapSnapshotWriter.h. Returns false if the snapshot could not be written.
+    JS_EXPORT_PRIVATE bool writeSnapshot(int fileDescriptor);
     void increaseLastFullGCLength(double amount) { m_lastFullGCLength += amount; }
 
     size_t sizeBeforeLastEdenCollection() const { return m_sizeBeforeLastEdenCollect; }
@@ -209,6 +219,12 @@ public:
     size_t sizeBeforeLastFullCollection() const { return m_sizeBeforeLastFullCollect; }
     size_t sizeAfterLastFullCollection() const { return m_sizeAfterLastFullCollect; }
 
+    // A target of 0 means that collections are scheduled based on the size of RAM.
+    size_t targetHeapSize() const { return m_targetHeapSize; }
+    void setTargetHeapSize(size_t targetHeapSize) { m_targetHeapSize = targetHeapSize; }
+    // Consulted after each collection. Under memory pressure, we trade throughput for footprint.
+    void setMemoryPressureCallback(std::function<bool ()> callback) { m_memoryPressureCallback = WTF::move(callback); }
+
     void deleteAllCodeBlocks();
     void deleteAllUnlinkedCodeBlocks();
 
@@ -262,9 +278,11 @@ private:
     friend class CopyVisitor;
     friend class SlotVisitor;
     friend class IncrementalSweeper;
+    friend class HeapSnapshotWriter;
     friend class HeapStatistics;
     friend class VM;
     friend class WeakSet;
+    friend class WriteBarrierBuffer;
     template<typename T> friend void* allocateCell(Heap&);
     template<typename T> friend void* allocateCell(Heap&, size_t);
 
@@ -297,6 +315,7 @@ private:
     void gatherJSStackRoots(ConservativeRoots&);
     void gatherScratchBufferRoots(ConservativeRoots&);
     void clearLivenessData();
+    void donateOrDrainRoots();
     void visitExternalRememberedSet();
     void visitSmallStrings();
     void visitConservativeRoots(ConservativeRoots&);
@@ -317,22 +336,25 @@ private:
     void pruneStaleEntriesFromWeakGCMaps();
     void sweepArrayBuffers();
     void snapshotMarkedSpace();
-    void deleteSourceProviderCaches();
+    void pruneSourceProviderCaches();
     void notifyIncrementalSweeper();
     void writeBarrierCurrentlyExecutingCodeBlocks();
     void resetAllocators();
+    void presweepBlocksWithoutDestructors();
     void copyBackingStores();
     void harvestWeakReferences();
     void finalizeUnconditionalFinalizers();
     void clearUnmarkedExecutables();
     void deleteUnmarkedCompiledCode();
     JS_EXPORT_PRIVATE void addToRememberedSet(const JSCell*);
+    void addBufferedCellToRememberedSet(const JSCell*);
     void updateAllocationLimits();
     void didFinishCollection(double gcStartTime);
     void resumeCompilerThreads();
     void zombifyDeadObjects();
     void markDeadObjects();
 
+    void sweepDeadLargeBlocks();
     void sweepAllLogicallyEmptyWeakBlocks();
     bool sweepNextLogicallyEmptyWeakBlock();
 
@@ -348,9 +370,14 @@ private:
     size_t threadBytesVisited();
     size_t threadBytesCopied();
 
+    size_t heapSizingBudget() const;
+    bool isUnderMemoryPressure() const { return m_memoryPressureCallback && m_memoryPressureCallback(); }
+
     const HeapType m_heapType;
     const size_t m_ramSize;
     const size_t m_minBytesPerCycle;
+    size_t m_targetHeapSize;
+    std::function<bool ()> m_memoryPressureCallback;
     size_t m_sizeAfterLastCollect;
     size_t m_sizeAfterLastFullCollect;
     size_t m_sizeBeforeLastFullCollect;
@@ -405,6 +432,12 @@ private:
     VM* m_vm;
     double m_lastFullGCLength;
     double m_lastEdenGCLength;
+    double m_lastMarkingLength { 0 };
+    double m_lastCopyingLength { 0 };
+    GCLogging::PauseStatistics m_pauseStatistics;
+    HeapCollectionEvent m_lastCollectionEvent;
+    int m_snapshotFileDescriptor { -1 };
+    bool m_didWriteSnapshot { false };
 
     Vector<ExecutableBase*> m_executables;
 
@@ -441,6 +474,7 @@ private:
 
     Vector<CopiedBlock*> m_blocksToCopy;
     static const size_t s_blockFragmentLength = 32;
+    static const size_t s_fragmentsPerCopyingThread = 8;
 
     ListableHandler<WeakReferenceHarvester>::List m_weakReferenceHarvesters;
     ListableHandler<UnconditionalFinalizer>::List m_unconditionalFinalizers;
@@ -30,11 +30,28 @@
 
 namespace JSC {
 
+// Summary of a single collection, handed to observers once the collection is over. Times are in
+// seconds and sizes are in bytes.
+struct HeapCollectionEvent {
+    HeapOperation operation { NoOperation };
+    double startTime { 0 };
+    double pauseLength { 0 };
+    double markingLength { 0 };
+    double copyingLength { 0 };
+    size_t bytesVisited { 0 };
+    size_t bytesCopied { 0 };
+    size_t sizeBefore { 0 };
+    size_t sizeAfter { 0 };
+
+    size_t bytesFreed() const { return sizeBefore > sizeAfter ? sizeBefore - sizeAfter : 0; }
+};
+
 class HeapObserver {
 public:
     virtual ~HeapObserver() { }
     virtual void willGarbageCollect() = 0;
     virtual void didGarbageCollect(HeapOperation) = 0;
+    virtual void didFinishCollection(const HeapCollectionEvent&) { }
 };
 
 } // namespace JSC
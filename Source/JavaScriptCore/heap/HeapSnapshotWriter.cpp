@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "HeapSnapshotWriter.h"
+
+#include "Heap.h"
+#include "HeapIterationScope.h"
+#include "JSCInlines.h"
+#include "SlotVisitor.h"
+
+#if OS(UNIX)
+#include <errno.h>
+#include <unistd.h>
+#endif
+
+namespace JSC {
+
+static inline size_t atomIndexFor(MarkedBlock* block, const JSCell* cell)
+{
+    return (bitwise_cast<uintptr_t>(cell) - bitwise_cast<uintptr_t>(block)) / MarkedBlock::atomSize;
+}
+
+HeapSnapshotWriter::HeapSnapshotWriter(Heap& heap, int fileDescriptor)
+    : m_heap(heap)
+    , m_fileDescriptor(fileDescriptor)
+{
+    m_buffer.reserveInitialCapacity(s_bufferCapacity);
+}
+
+class RecordLiveCellsFunctor : public MarkedBlock::VoidFunctor {
+public:
+    RecordLiveCellsFunctor(Vector<HeapSnapshotWriter::LiveCells>& liveCells)
+        : m_liveCells(liveCells)
+    {
+    }
+
+    IterationStatus operator()(JSCell* cell)
+    {
+        MarkedBlock* block = MarkedBlock::blockFor(cell);
+        if (m_liveCells.isEmpty() || m_liveCells.last().block != block) {
+            m_liveCells.grow(m_liveCells.size() + 1);
+            m_liveCells.last().block = block;
+        }
+        m_liveCells.last().atoms.set(atomIndexFor(block, cell));
+        return IterationStatus::Continue;
+    }
+
+private:
+    Vector<HeapSnapshotWriter::LiveCells>& m_liveCells;
+};
+
+void HeapSnapshotWriter::recordLiveCells()
+{
+    RecordLiveCellsFunctor functor(m_liveCells);
+    HeapIterationScope iterationScope(m_heap);
+    m_heap.objectSpace().forEachLiveCell(iterationScope, functor);
+}
+
+template<typename Functor>
+static void forEachRecordedCell(Vector<HeapSnapshotWriter::LiveCells>& liveCells, const Functor& functor)
+{
+    for (auto& entry : liveCells) {
+        for (size_t i = 0; i < MarkedBlock::atomsPerBlock; ++i) {
+            if (entry.atoms.get(i))
+                functor(entry.block, bitwise_cast<JSCell*>(bitwise_cast<char*>(entry.block) + i * MarkedBlock::atomSize));
+        }
+    }
+}
+
+bool HeapSnapshotWriter::write()
+{
+    SlotVisitor& visitor = m_heap.m_slotVisitor;
+
+    // Like GCLogging::dumpObjectGraph(), we find a cell's outgoing edges by visiting it with every cell
+    // unmarked, so that the visitor pushes all of its neighbors. Cells that are remembered for the
+    // next collection are on the mark stack and need to be put back afterwards.
+    Vector<const JSCell*> savedMarkStack(visitor.markStack().size());
+    visitor.markStack().fillVector(savedMarkStack);
+    visitor.clearMarkStack();
+
+    visitor.m_isSnapshotting = true;
+
+    recordLiveCells();
+    forEachRecordedCell(m_liveCells, [] (MarkedBlock* block, JSCell* cell) {
+        block->clearMarked(cell);
+    });
+
+    writeBytes("JSCHEAP1", 8);
+    forEachRecordedCell(m_liveCells, [this] (MarkedBlock*, JSCell* cell) {
+        writeCell(cell);
+    });
+    writeValue(EndRecord);
+    flush();
+
+    visitor.reset();
+    visitor.m_isSnapshotting = false;
+    forEachRecordedCell(m_liveCells, [] (MarkedBlock* block, JSCell* cell) {
+        block->setMarked(cell);
+    });
+    for (const JSCell* cell : savedMarkStack) {
+        visitor.markStack().append(cell);
+        cell->setCellState(CellState::OldGrey);
+    }
+
+    return !m_failed;
+}
+
+void HeapSnapshotWriter::writeCell(JSCell* cell)
+{
+    SlotVisitor& visitor = m_heap.m_slotVisitor;
+    cell->methodTable()->visitChildren(cell, visitor);
+
+    writeValue(CellRecord);
+    writeValue(static_cast<uint64_t>(bitwise_cast<uintptr_t>(cell)));
+    writeValue(static_cast<uint32_t>(classID(cell->classInfo())));
+    writeValue(static_cast<uint32_t>(MarkedBlock::blockFor(cell)->cellSize()));
+    writeValue(static_cast<uint32_t>(visitor.markStack().size()));
+    for (const JSCell* neighbor : visitor.markStack()) {
+        writeValue(static_cast<uint64_t>(bitwise_cast<uintptr_t>(neighbor)));
+        // Undo what the visitor did to the neighbor, which was black before we started.
+        MarkedBlock::blockFor(neighbor)->clearMarked(neighbor);
+        const_cast<JSCell*>(neighbor)->setCellState(CellState::OldBlack);
+    }
+    visitor.clearMarkStack();
+}
+
+unsigned HeapSnapshotWriter::classID(const ClassInfo* classInfo)
+{
+    auto result = m_classIDs.add(classInfo, m_classIDs.size());
+    unsigned id = result.iterator->value;
+    if (result.isNewEntry) {
+        const char* name = classInfo ? classInfo->className : "";
+        uint32_t length = strlen(name);
+        writeValue(ClassNameRecord);
+        writeValue(static_cast<uint32_t>(id));
+        writeValue(length);
+        writeBytes(name, length);
+    }
+    return id;
+}
+
+void HeapSnapshotWriter::writeBytes(const void* data, size_t size)
+{
+    if (m_buffer.size() + size > s_bufferCapacity)
+        flush();
+    m_buffer.append(static_cast<const uint8_t*>(data), size);
+}
+
+void HeapSnapshotWriter::flush()
+{
+#if OS(UNIX)
+    size_t offset = 0;
+    while (!m_failed && offset < m_buffer.size()) {
+        ssize_t written = ::write(m_fileDescriptor, m_buffer.data() + offset, m_buffer.size() - offset);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            m_failed = true;
+            break;
+        }
+        offset += written;
+    }
+#else
+    m_failed = true;
+#endif
+    m_buffer.shrink(0);
+}
+
+} // namespace JSC
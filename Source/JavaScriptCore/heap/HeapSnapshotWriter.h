@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HeapSnapshotWriter_h
+#define HeapSnapshotWriter_h
+
+#include "MarkedBlock.h"
+#include <wtf/Bitmap.h>
+#include <wtf/HashMap.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+
+namespace JSC {
+
+class Heap;
+class JSCell;
+struct ClassInfo;
+
+// Streams the live object graph to a file descriptor with a fixed-size output buffer. The only
+// per-object memory used is one bit per MarkedBlock atom, so large heaps can be captured without
+// holding the graph in memory.
+//
+// The format is a sequence of records in host byte order, after an 8-byte "JSCHEAP1" header:
+//     0: end of snapshot
+//     1: class name: uint32 id, uint32 length, length bytes of name
+//     2: cell: uint64 address, uint32 class id, uint32 size, uint32 edge count, edge count uint64 addresses
+class HeapSnapshotWriter {
+    WTF_MAKE_NONCOPYABLE(HeapSnapshotWriter);
+public:
+    HeapSnapshotWriter(Heap&, int fileDescriptor);
+
+    // Must be called at the end of a full collection, when mark bits reflect liveness. Returns false
+    // if writing failed.
+    bool write();
+
+    struct LiveCells {
+        MarkedBlock* block;
+        WTF::Bitmap<MarkedBlock::atomsPerBlock> atoms;
+    };
+
+private:
+    enum RecordType : uint8_t {
+        EndRecord,
+        ClassNameRecord,
+        CellRecord
+    };
+
+    void recordLiveCells();
+    void writeCell(JSCell*);
+    unsigned classID(const ClassInfo*);
+
+    void writeBytes(const void*, size_t);
+    template<typename T> void writeValue(T value) { writeBytes(&value, sizeof(value)); }
+    void flush();
+
+    Heap& m_heap;
+    int m_fileDescriptor;
+    bool m_failed { false };
+    Vector<LiveCells> m_liveCells;
+    HashMap<const ClassInfo*, unsigned> m_classIDs;
+    Vector<uint8_t> m_buffer;
+    static const size_t s_bufferCapacity = 64 * KB;
+};
+
+} // namespace JSC
+
+#endif // HeapSnapshotWriter_h
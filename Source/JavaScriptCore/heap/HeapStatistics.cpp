@@ -26,11 +26,14 @@
 #include "config.h"
 #include "HeapStatistics.h"
 
+#include "CodeBlock.h"
+#include "ExecutableAllocator.h"
 #include "Heap.h"
 #include "HeapIterationScope.h"
 #include "JSCInlines.h"
 #include "JSObject.h"
 #include "Options.h"
+#include "PropertyMapHashTable.h"
 #include <stdlib.h>
 #include <wtf/CurrentTime.h>
 #include <wtf/DataLog.h>
@@ -46,6 +49,8 @@ double HeapStatistics::s_startTime = 0.0;
 double HeapStatistics::s_endTime = 0.0;
 Vector<double>* HeapStatistics::s_pauseTimeStarts = 0;
 Vector<double>* HeapStatistics::s_pauseTimeEnds = 0;
+Vector<double>* HeapStatistics::s_markingTimes = 0;
+Vector<double>* HeapStatistics::s_copyingTimes = 0;
 
 #if OS(UNIX) 
 
@@ -55,6 +60,8 @@ void HeapStatistics::initialize()
     s_startTime = WTF::monotonicallyIncreasingTime();
     s_pauseTimeStarts = new Vector<double>();
     s_pauseTimeEnds = new Vector<double>();
+    s_markingTimes = new Vector<double>();
+    s_copyingTimes = new Vector<double>();
 }
 
 void HeapStatistics::recordGCPauseTime(double start, double end)
@@ -66,6 +73,23 @@ void HeapStatistics::recordGCPauseTime(double start, double end)
     s_pauseTimeEnds->append(end);
 }
 
+void HeapStatistics::recordGCPhaseTimes(double markingTime, double copyingTime)
+{
+    ASSERT(Options::recordGCPauseTimes());
+    ASSERT(s_markingTimes);
+    ASSERT(s_copyingTimes);
+    s_markingTimes->append(markingTime);
+    s_copyingTimes->append(copyingTime);
+}
+
+static void logTimes(const char* name, const Vector<double>& times)
+{
+    dataLogF(", \"%s\": [", name);
+    for (size_t i = 0; i < times.size(); ++i)
+        dataLogF(i ? ", %f" : "%f", times[i]);
+    dataLogF("]");
+}
+
 void HeapStatistics::logStatistics()
 {
     struct rusage usage;
@@ -98,6 +122,8 @@ void HeapStatistics::logStatistics()
             ++endIt;
         }
         dataLogF("], \"start_time\": %f, \"end_time\": %f", s_startTime, s_endTime);
+        logTimes("marking_times", *s_markingTimes);
+        logTimes("copying_times", *s_copyingTimes);
     }
     dataLogF("}\n");
 }
@@ -127,6 +153,10 @@ void HeapStatistics::recordGCPauseTime(double, double)
 {
 }
 
+void HeapStatistics::recordGCPhaseTimes(double, double)
+{
+}
+
 void HeapStatistics::logStatistics()
 {
 }
@@ -216,6 +246,24 @@ inline size_t StorageStatistics::storageCapacity()
     return m_storageCapacity;
 }
 
+class StructureStatistics : public MarkedBlock::VoidFunctor {
+public:
+    IterationStatus operator()(JSCell* cell)
+    {
+        if (cell->classInfo() == Structure::info())
+            structureCount++;
+        else if (cell->classInfo() == PropertyTable::info()) {
+            propertyTableCount++;
+            propertyTableBytes += jsCast<PropertyTable*>(cell)->sizeInMemory();
+        }
+        return IterationStatus::Continue;
+    }
+
+    size_t structureCount { 0 };
+    size_t propertyTableCount { 0 };
+    size_t propertyTableBytes { 0 };
+};
+
 void HeapStatistics::dumpObjectStatistics(Heap* heap)
 {
     dataLogF("\n=== Heap Statistics: ===\n");
@@ -241,6 +289,62 @@ void HeapStatistics::dumpObjectStatistics(Heap* heap)
     }
     dataLogF("wasted .property storage: %ldkB (%ld%%)\n", wastedPropertyStorageBytes, wastedPropertyStoragePercent);
     dataLogF("objects with out-of-line .property storage: %ld (%ld%%)\n", objectWithOutOfLineStorageCount, objectsWithOutOfLineStoragePercent);
+
+    StructureStatistics structureStatistics;
+    {
+        HeapIterationScope iterationScope(*heap);
+        heap->m_objectSpace.forEachLiveCell(iterationScope, structureStatistics);
+    }
+    dataLogF("structures: %ld (%ldkB)\n", static_cast<long>(structureStatistics.structureCount),
+        static_cast<long>(structureStatistics.structureCount * sizeof(Structure) / KB));
+    dataLogF("property tables: %ld (%ldkB)\n", static_cast<long>(structureStatistics.propertyTableCount),
+        static_cast<long>(structureStatistics.propertyTableBytes / KB));
+    StructureIDTable& structureIDTable = heap->structureIDTable();
+    dataLogF("structure ID table: %ld used of %ld (%ld free)\n",
+        static_cast<long>(structureIDTable.size()), static_cast<long>(structureIDTable.capacity()), static_cast<long>(structureIDTable.freeCount()));
+}
+
+void HeapStatistics::dumpExecutableMemoryStatistics(Heap* heap)
+{
+    dataLogF("\n=== Executable Memory Statistics: ===\n");
+
+    struct TierUsage {
+        size_t codeBlockCount { 0 };
+        size_t bytes { 0 };
+    };
+    TierUsage baseline;
+    TierUsage dfg;
+    TierUsage ftl;
+    auto accumulate = [&] (CodeBlock* codeBlock) -> bool {
+        RefPtr<JITCode> jitCode = codeBlock->jitCode();
+        if (!jitCode)
+            return false;
+        TierUsage* usage;
+        switch (jitCode->jitType()) {
+        case JITCode::BaselineJIT:
+            usage = &baseline;
+            break;
+        case JITCode::DFGJIT:
+            usage = &dfg;
+            break;
+        case JITCode::FTLJIT:
+            usage = &ftl;
+            break;
+        default:
+            return false;
+        }
+        usage->codeBlockCount++;
+        usage->bytes += jitCode->size();
+        return false;
+    };
+    heap->m_codeBlocks.iterate(accumulate);
+
+    dataLogF("baseline: %ldkB in %ld code blocks\n", static_cast<long>(baseline.bytes / KB), static_cast<long>(baseline.codeBlockCount));
+    dataLogF("DFG: %ldkB in %ld code blocks\n", static_cast<long>(dfg.bytes / KB), static_cast<long>(dfg.codeBlockCount));
+    dataLogF("FTL: %ldkB in %ld code blocks\n", static_cast<long>(ftl.bytes / KB), static_cast<long>(ftl.codeBlockCount));
+#if ENABLE(ASSEMBLER)
+    ExecutableAllocator::dumpStatistics(WTF::dataFile());
+#endif
 }
 
 } // namespace JSC
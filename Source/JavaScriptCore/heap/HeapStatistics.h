@@ -40,13 +40,17 @@ public:
 
     static void initialize();
     static void recordGCPauseTime(double start, double end);
+    static void recordGCPhaseTimes(double markingTime, double copyingTime);
 
     static void dumpObjectStatistics(Heap*);
+    static void dumpExecutableMemoryStatistics(Heap*);
 
 private:
     static void logStatistics();
     static Vector<double>* s_pauseTimeStarts;
     static Vector<double>* s_pauseTimeEnds;
+    static Vector<double>* s_markingTimes;
+    static Vector<double>* s_copyingTimes;
     static double s_startTime;
     static double s_endTime;
 };
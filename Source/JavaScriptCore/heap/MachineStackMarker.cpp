@@ -160,8 +160,9 @@ static inline PlatformThread getCurrentPlatformThread()
 class MachineThreads::Thread {
     WTF_MAKE_FAST_ALLOCATED;
 
-    Thread(const PlatformThread& platThread, void* base, void* end)
+    Thread(const PlatformThread& platThread, ThreadIdentifier threadIdentifier, void* base, void* end)
         : platformThread(platThread)
+        , identifier(threadIdentifier)
         , stackBase(base)
         , stackEnd(end)
     {
@@ -197,7 +198,7 @@ public:
     static Thread* createForCurrentThread()
     {
         auto stackBounds = wtfThreadData().stack();
-        return new Thread(getCurrentPlatformThread(), stackBounds.origin(), stackBounds.end());
+        return new Thread(getCurrentPlatformThread(), currentThread(), stackBounds.origin(), stackBounds.end());
     }
 
     struct Registers {
@@ -242,6 +243,7 @@ public:
 
     Thread* next;
     PlatformThread platformThread;
+    ThreadIdentifier identifier;
     void* stackBase;
     void* stackEnd;
 #if OS(WINDOWS)
@@ -590,12 +592,13 @@ void MachineThreads::tryCopyOtherThreadStack(Thread* thread, void* buffer, size_
     thread->freeRegisters(registers);
 }
 
+// Prevent two VMs from suspending each other's threads at the same time,
+// which can cause deadlock: <rdar://problem/20300842>.
+static StaticLock threadSuspensionLock;
+
 bool MachineThreads::tryCopyOtherThreadStacks(LockHolder&, void* buffer, size_t capacity, size_t* size)
 {
-    // Prevent two VMs from suspending each other's threads at the same time,
-    // which can cause deadlock: <rdar://problem/20300842>.
-    static StaticLock mutex;
-    std::lock_guard<StaticLock> lock(mutex);
+    std::lock_guard<StaticLock> lock(threadSuspensionLock);
 
     *size = 0;
 
@@ -668,6 +671,25 @@ bool MachineThreads::tryCopyOtherThreadStacks(LockHolder&, void* buffer, size_t
     return *size <= capacity;
 }
 
+bool MachineThreads::suspendThreadAndCall(ThreadIdentifier threadIdentifier, const ScopedLambda<void ()>& function)
+{
+    // Take the locks in the same order as gatherConservativeRoots() does.
+    LockHolder registeredThreadsLock(m_registeredThreadsMutex);
+    std::lock_guard<StaticLock> lock(threadSuspensionLock);
+
+    for (Thread* thread = m_registeredThreads; thread; thread = thread->next) {
+        if (thread->identifier != threadIdentifier)
+            continue;
+        ASSERT(*thread != getCurrentPlatformThread());
+        if (!thread->suspend())
+            return false;
+        function();
+        thread->resume();
+        return true;
+    }
+    return false;
+}
+
 static void growBuffer(size_t size, void** buffer, size_t* capacity)
 {
     if (*buffer)
@@ -25,7 +25,9 @@
 #include <setjmp.h>
 #include <wtf/Lock.h>
 #include <wtf/Noncopyable.h>
+#include <wtf/ScopedLambda.h>
 #include <wtf/ThreadSpecific.h>
+#include <wtf/Threading.h>
 
 namespace JSC {
 
@@ -46,6 +48,11 @@ namespace JSC {
 
         JS_EXPORT_PRIVATE void addCurrentThread(); // Only needs to be called by clients that can use the same heap from multiple threads.
 
+        // Suspends the given registered thread, calls the function, and resumes the thread. Returns
+        // false if the thread is not registered or could not be suspended. The function must not
+        // take any lock the suspended thread might hold, including the malloc lock.
+        bool suspendThreadAndCall(ThreadIdentifier, const ScopedLambda<void ()>&);
+
     private:
         class Thread;
 
@@ -77,6 +77,38 @@ void MarkStackArray::donateSomeCellsTo(MarkStackArray& other)
     other.validatePrevious();
 }
 
+void MarkStackArray::donateAllCellsTo(MarkStackArray& other)
+{
+    // Hand over every full segment wholesale, and then move the cells in our head segment one at a
+    // time. This leaves us with just an empty head segment, like a stack that was fully drained.
+
+    validatePrevious();
+    other.validatePrevious();
+
+    if (m_numberOfSegments > 1) {
+        GCArraySegment<const JSCell*>* myHead = m_segments.removeHead();
+        GCArraySegment<const JSCell*>* otherHead = other.m_segments.removeHead();
+
+        while (m_numberOfSegments > 1) {
+            GCArraySegment<const JSCell*>* current = m_segments.removeHead();
+            ASSERT(current);
+            other.m_segments.push(current);
+            m_numberOfSegments--;
+            other.m_numberOfSegments++;
+        }
+
+        m_segments.push(myHead);
+        other.m_segments.push(otherHead);
+    }
+
+    while (canRemoveLast())
+        other.append(removeLast());
+
+    ASSERT(isEmpty());
+    validatePrevious();
+    other.validatePrevious();
+}
+
 void MarkStackArray::stealSomeCellsFrom(MarkStackArray& other, size_t idleThreadCount)
 {
     // Try to steal 1 / Nth of the shared array, where N is the number of idle threads.
@@ -37,6 +37,7 @@ public:
     MarkStackArray();
 
     void donateSomeCellsTo(MarkStackArray& other);
+    void donateAllCellsTo(MarkStackArray& other);
     void stealSomeCellsFrom(MarkStackArray& other, size_t idleThreadCount);
 };
 
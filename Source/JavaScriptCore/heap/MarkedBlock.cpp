@@ -42,7 +42,10 @@ MarkedBlock* MarkedBlock::create(Heap& heap, MarkedAllocator* allocator, size_t
         if (!(balance % 10))
             dataLog("MarkedBlock Balance: ", balance, "\n");
     }
-    MarkedBlock* block = new (NotNull, fastAlignedMalloc(blockSize, capacity)) MarkedBlock(allocator, capacity, cellSize, needsDestruction);
+    void* memory = capacity == blockSize ? heap.objectSpace().takeCachedBlockMemory() : nullptr;
+    if (!memory)
+        memory = fastAlignedMalloc(blockSize, capacity);
+    MarkedBlock* block = new (NotNull, memory) MarkedBlock(allocator, capacity, cellSize, needsDestruction);
     heap.didAllocateBlock(capacity);
     return block;
 }
@@ -56,7 +59,8 @@ void MarkedBlock::destroy(Heap& heap, MarkedBlock* block)
     }
     size_t capacity = block->capacity();
     block->~MarkedBlock();
-    fastAlignedFree(block);
+    if (capacity != blockSize || !heap.objectSpace().cacheBlockMemory(block))
+        fastAlignedFree(block);
     heap.didFreeBlock(capacity);
 }
 
@@ -69,6 +73,7 @@ MarkedBlock::MarkedBlock(MarkedAllocator* allocator, size_t capacity, size_t cel
     , m_allocator(allocator)
     , m_state(New) // All cells start out unmarked.
     , m_weakSet(allocator->heap()->vm(), *this)
+    , m_hasPresweptFreeList(false)
 {
     ASSERT(allocator);
     HEAP_LOG_BLOCK_STATE_TRANSITION(this);
@@ -133,6 +138,14 @@ MarkedBlock::FreeList MarkedBlock::sweep(SweepMode sweepMode)
 
     m_weakSet.sweep();
 
+    if (m_hasPresweptFreeList && sweepMode == SweepToFreeList) {
+        ASSERT(m_state == Marked && !m_needsDestruction);
+        m_hasPresweptFreeList = false;
+        m_newlyAllocated = nullptr;
+        m_state = FreeListed;
+        return m_presweptFreeList;
+    }
+
     if (sweepMode == SweepOnly && !m_needsDestruction)
         return FreeList();
 
@@ -141,6 +154,28 @@ MarkedBlock::FreeList MarkedBlock::sweep(SweepMode sweepMode)
     return sweepHelper<false>(sweepMode);
 }
 
+void MarkedBlock::presweep()
+{
+    ASSERT(!m_needsDestruction);
+    if (m_state != Marked || m_hasPresweptFreeList)
+        return;
+
+    FreeCell* head = 0;
+    size_t count = 0;
+    for (size_t i = firstAtom(); i < m_endAtom; i += m_atomsPerCell) {
+        if (m_marks.get(i) || (m_newlyAllocated && m_newlyAllocated->get(i)))
+            continue;
+
+        FreeCell* freeCell = reinterpret_cast_ptr<FreeCell*>(&atoms()[i]);
+        freeCell->next = head;
+        head = freeCell;
+        ++count;
+    }
+
+    m_presweptFreeList = FreeList(head, count * cellSize());
+    m_hasPresweptFreeList = true;
+}
+
 template<bool callDestructors>
 MarkedBlock::FreeList MarkedBlock::sweepHelper(SweepMode sweepMode)
 {
@@ -237,6 +272,7 @@ void MarkedBlock::clearMarksWithCollectionType()
     HEAP_LOG_BLOCK_STATE_TRANSITION(this);
 
     ASSERT(m_state != New && m_state != FreeListed);
+    m_hasPresweptFreeList = false;
     if (collectionType == FullCollection) {
         m_marks.clearAll();
         // This will become true at the end of the mark phase. We set it now to
@@ -122,6 +122,10 @@ namespace JSC {
         
         enum SweepMode { SweepOnly, SweepToFreeList };
         FreeList sweep(SweepMode = SweepOnly);
+        // Builds the free list that sweep(SweepToFreeList) would return, without changing any
+        // liveness data. Only valid for blocks without destructors. Helper threads may call this on
+        // distinct blocks while the world is stopped.
+        void presweep();
 
         void shrink();
 
@@ -200,6 +204,8 @@ namespace JSC {
         MarkedAllocator* m_allocator;
         BlockState m_state;
         WeakSet m_weakSet;
+        FreeList m_presweptFreeList;
+        bool m_hasPresweptFreeList;
     };
 
     inline MarkedBlock::FreeList::FreeList()
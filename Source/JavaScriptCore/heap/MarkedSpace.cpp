@@ -41,6 +41,31 @@ private:
     MarkedSpace& m_markedSpace;
 };
 
+struct SweepDeadLargeBlock : MarkedBlock::VoidFunctor {
+    SweepDeadLargeBlock(MarkedSpace& space, Vector<MarkedBlock*>& freedBlocks)
+        : m_markedSpace(space)
+        , m_freedBlocks(freedBlocks)
+    {
+    }
+
+    void operator()(MarkedBlock* block)
+    {
+        if (!block->needsSweeping() || block->markCount())
+            return;
+        block->sweep();
+        if (!block->isEmpty()) {
+            block->shrink();
+            return;
+        }
+        m_freedBlocks.append(block);
+        m_markedSpace.freeBlock(block);
+    }
+
+private:
+    MarkedSpace& m_markedSpace;
+    Vector<MarkedBlock*>& m_freedBlocks;
+};
+
 struct VisitWeakSet : MarkedBlock::VoidFunctor {
     VisitWeakSet(HeapRootVisitor& heapRootVisitor) : m_heapRootVisitor(heapRootVisitor) { }
     void operator()(MarkedBlock* block) { block->visitWeakSet(m_heapRootVisitor); }
@@ -76,6 +101,7 @@ MarkedSpace::~MarkedSpace()
     Free free(*this);
     forEachBlock(free);
     ASSERT(!m_blocks.set().size());
+    releaseCachedBlockMemory();
 }
 
 struct LastChanceToFinalize {
@@ -226,6 +252,36 @@ void MarkedSpace::shrink()
 {
     FreeOrShrink freeOrShrink(*this);
     forEachBlock(freeOrShrink);
+    releaseCachedBlockMemory();
+}
+
+void MarkedSpace::sweepDeadLargeBlocks(Vector<MarkedBlock*>& freedBlocks)
+{
+    SweepDeadLargeBlock sweepDeadLargeBlock(*this, freedBlocks);
+    m_normalSpace.largeAllocator.forEachBlock(sweepDeadLargeBlock);
+    m_destructorSpace.largeAllocator.forEachBlock(sweepDeadLargeBlock);
+}
+
+void* MarkedSpace::takeCachedBlockMemory()
+{
+    if (m_cachedBlockMemory.isEmpty())
+        return nullptr;
+    return m_cachedBlockMemory.takeLast();
+}
+
+bool MarkedSpace::cacheBlockMemory(void* memory)
+{
+    if (m_cachedBlockMemory.size() == s_maxCachedBlocks)
+        return false;
+    m_cachedBlockMemory.append(memory);
+    return true;
+}
+
+void MarkedSpace::releaseCachedBlockMemory()
+{
+    for (void* memory : m_cachedBlockMemory)
+        fastAlignedFree(memory);
+    m_cachedBlockMemory.clear();
 }
 
 static void clearNewlyAllocatedInBlock(MarkedBlock* block)
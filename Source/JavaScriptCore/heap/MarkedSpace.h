@@ -121,6 +121,13 @@ public:
     void shrink();
     void freeBlock(MarkedBlock*);
     void freeOrShrinkBlock(MarkedBlock*);
+    void sweepDeadLargeBlocks(Vector<MarkedBlock*>& freedBlocks);
+
+    // Memory for standard-size blocks that died is kept here for reuse, so that steady-state
+    // allocation does not go back to the system allocator (and its locks) for every new block.
+    void* takeCachedBlockMemory();
+    bool cacheBlockMemory(void*);
+    void releaseCachedBlockMemory();
 
     void didAddBlock(MarkedBlock*);
     void didConsumeFreeList(MarkedBlock*);
@@ -153,6 +160,8 @@ private:
     bool m_isIterating;
     MarkedBlockSet m_blocks;
     Vector<MarkedBlock*> m_blocksWithNewObjects;
+    static const size_t s_maxCachedBlocks = 16;
+    Vector<void*, s_maxCachedBlocks> m_cachedBlockMemory;
 };
 
 template<typename Functor> inline typename Functor::ReturnType MarkedSpace::forEachLiveCell(HeapIterationScope&, Functor& functor)
@@ -348,6 +348,22 @@ void SlotVisitor::donate()
     donateKnownParallel();
 }
 
+void SlotVisitor::donateAll()
+{
+    ASSERT(m_isInParallelMode);
+
+    // Anything we hand off may add opaque roots on another thread, and nobody drains our local
+    // stack after a full donation, so publish our opaque roots now.
+    mergeOpaqueRootsIfNecessary();
+
+    if (m_stack.isEmpty())
+        return;
+
+    std::lock_guard<Lock> lock(m_heap.m_markingMutex);
+    m_stack.donateAllCellsTo(m_heap.m_sharedMarkStack);
+    m_heap.m_markingConditionVariable.notifyAll();
+}
+
 void SlotVisitor::donateAndDrain()
 {
     donate();
@@ -357,6 +373,8 @@ void SlotVisitor::donateAndDrain()
 void SlotVisitor::copyLater(JSCell* owner, CopyToken token, void* ptr, size_t bytes)
 {
     ASSERT(bytes);
+    if (m_isSnapshotting)
+        return;
     CopiedBlock* block = CopiedSpace::blockFor(ptr);
     if (block->isOversize()) {
         ASSERT(bytes <= block->size());
@@ -93,6 +93,7 @@ public:
     size_t visitCount() const { return m_visitCount; }
 
     void donate();
+    void donateAll();
     void drain();
     void donateAndDrain();
     
@@ -112,6 +113,7 @@ public:
     void dump(PrintStream&) const;
 
 private:
+    friend class HeapSnapshotWriter;
     friend class ParallelModeEnabler;
     
     JS_EXPORT_PRIVATE void append(JSValue); // This is private to encourage clients to use WriteBarrier<T>.
@@ -139,6 +141,10 @@ private:
 
     CellState m_currentObjectCellStateBeforeVisiting { CellState::NewWhite };
 
+    // Set while HeapSnapshotWriter visits cells only to discover their edges. Visiting must then not
+    // report copying work, extra memory or finalizers, since the collection they belong to is over.
+    bool m_isSnapshotting { false };
+
 public:
 #if !ASSERT_DISABLED
     bool m_isCheckingForDefaultMarkViolation;
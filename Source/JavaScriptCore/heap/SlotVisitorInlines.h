@@ -84,16 +84,22 @@ inline void SlotVisitor::appendValues(WriteBarrierBase<Unknown>* barriers, size_
 
 inline void SlotVisitor::addWeakReferenceHarvester(WeakReferenceHarvester* weakReferenceHarvester)
 {
+    if (m_isSnapshotting)
+        return;
     m_heap.m_weakReferenceHarvesters.addThreadSafe(weakReferenceHarvester);
 }
 
 inline void SlotVisitor::addUnconditionalFinalizer(UnconditionalFinalizer* unconditionalFinalizer)
 {
+    if (m_isSnapshotting)
+        return;
     m_heap.m_unconditionalFinalizers.addThreadSafe(unconditionalFinalizer);
 }
 
 inline void SlotVisitor::reportExtraMemoryVisited(size_t size)
 {
+    if (m_isSnapshotting)
+        return;
     heap()->reportExtraMemoryVisited(m_currentObjectCellStateBeforeVisiting, size);
 }
 
@@ -61,6 +61,12 @@ public:
         set(other.get());
     }
 
+    Strong(Strong&& other)
+        : Handle<T>()
+    {
+        swap(other);
+    }
+
     template <typename U> Strong(const Strong<U>& other)
         : Handle<T>()
     {
@@ -117,6 +123,12 @@ public:
         return *this;
     }
 
+    Strong& operator=(Strong&& other)
+    {
+        swap(other);
+        return *this;
+    }
+
     void clear()
     {
         if (!slot())
@@ -50,7 +50,7 @@ void WriteBarrierBuffer::flush(Heap& heap)
 {
     ASSERT(m_currentIndex <= m_capacity);
     for (size_t i = 0; i < m_currentIndex; ++i)
-        heap.writeBarrier(m_buffer[i]);
+        heap.addBufferedCellToRememberedSet(m_buffer[i]);
     m_currentIndex = 0;
 }
 
@@ -62,6 +62,7 @@ void WriteBarrierBuffer::reset()
 void WriteBarrierBuffer::add(JSCell* cell)
 {
     ASSERT_GC_OBJECT_LOOKS_VALID(cell);
+    ASSERT(cell->cellState() == CellState::OldGrey);
     ASSERT(m_currentIndex < m_capacity);
     m_buffer[m_currentIndex++] = cell;
 }
@@ -1245,6 +1245,13 @@ public:
         uint8_t* address = reinterpret_cast<uint8_t*>(cell) + JSCell::cellStateOffset();
         return branchTest8(MacroAssembler::NonZero, MacroAssembler::AbsoluteAddress(address));
     }
+
+    // Call this after adding a cell to the WriteBarrierBuffer. The cell becomes remembered right away,
+    // so any further stores into it skip the barrier until the next collection.
+    void setCellStateToRemembered(GPRReg cell)
+    {
+        store8(TrustedImm32(static_cast<int32_t>(CellState::OldGrey)), MacroAssembler::Address(cell, JSCell::cellStateOffset()));
+    }
     
     // Emits the branch structure for typeof. The code emitted by this doesn't fall through. The
     // functor is called at those points where we have pinpointed a type. One way to use this is to
@@ -225,6 +225,11 @@ size_t ExecutableAllocator::committedByteCount()
     return DemandExecutableAllocator::bytesCommittedByAllocactors();
 }
 
+void ExecutableAllocator::dumpStatistics(PrintStream& out)
+{
+    out.print("Executable memory: ", DemandExecutableAllocator::bytesAllocatedByAllAllocators() / KB, "kB allocated, ", committedByteCount() / KB, "kB committed\n");
+}
+
 #if ENABLE(META_ALLOCATOR_PROFILE)
 void ExecutableAllocator::dumpProfile()
 {
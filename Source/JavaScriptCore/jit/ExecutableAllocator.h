@@ -32,6 +32,7 @@
 #include <wtf/MetaAllocatorHandle.h>
 #include <wtf/MetaAllocator.h>
 #include <wtf/PageAllocation.h>
+#include <wtf/PrintStream.h>
 #include <wtf/RefCounted.h>
 #include <wtf/Vector.h>
 
@@ -111,6 +112,8 @@ public:
     RefPtr<ExecutableMemoryHandle> allocate(VM&, size_t sizeInBytes, void* ownerUID, JITCompilationEffort);
 
     static size_t committedByteCount();
+
+    static void dumpStatistics(PrintStream&);
 };
 
 #endif // ENABLE(JIT) && ENABLE(ASSEMBLER)
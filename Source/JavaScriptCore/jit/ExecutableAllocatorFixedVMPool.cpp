@@ -204,6 +204,16 @@ size_t ExecutableAllocator::committedByteCount()
     return allocator->bytesCommitted();
 }
 
+void ExecutableAllocator::dumpStatistics(PrintStream& out)
+{
+    MetaAllocator::Statistics statistics = allocator->currentStatistics();
+    size_t bytesFree = statistics.bytesReserved - statistics.bytesAllocated;
+    // The share of free space that a single allocation can't use because it isn't contiguous.
+    double fragmentation = bytesFree ? 1 - static_cast<double>(statistics.largestFreeSpaceChunk) / bytesFree : 0;
+    out.print("Executable pool: ", statistics.bytesAllocated / KB, "kB allocated, ", statistics.bytesCommitted / KB, "kB committed, ", statistics.bytesReserved / KB, "kB reserved\n");
+    out.print("Executable pool free space: ", statistics.freeSpaceChunkCount, " chunks, largest ", statistics.largestFreeSpaceChunk / KB, "kB, ", fragmentation * 100, "% fragmented\n");
+}
+
 #if ENABLE(META_ALLOCATOR_PROFILE)
 void ExecutableAllocator::dumpProfile()
 {
@@ -51,6 +51,7 @@
 #include "JSStackInlines.h"
 #include "JSWithScope.h"
 #include "LegacyProfiler.h"
+#include "MegamorphicCache.h"
 #include "ObjectConstructor.h"
 #include "PropertyName.h"
 #include "Repatch.h"
@@ -184,7 +185,9 @@ EncodedJSValue JIT_OPERATION operationGetByIdOptimize(ExecState* exec, Structure
     PropertySlot slot(baseValue);
     
     bool hasResult = baseValue.getPropertySlot(exec, ident, slot);
-    if (stubInfo->considerCaching())
+    if (stubInfo->isMegamorphic())
+        vm->megamorphicCache()->addIfCacheable(*vm, baseValue, uid, slot);
+    else if (stubInfo->considerCaching())
         repatchGetByID(exec, baseValue, ident, slot, *stubInfo);
     
     return JSValue::encode(hasResult? slot.getValue(exec, ident) : jsUndefined());
@@ -32,6 +32,8 @@
 #include "JIT.h"
 #include "VM.h"
 #include "JSCInlines.h"
+#include "ThunkGenerators.h"
+#include <wtf/NeverDestroyed.h>
 
 namespace JSC {
 
@@ -64,6 +66,31 @@ MacroAssemblerCodePtr JITThunks::ctiNativeTailCall(VM* vm)
     return ctiStub(vm, nativeTailCallGenerator).code();
 }
 
+// These thunks emit neither VM pointers nor calls to other per-VM thunks, so the code that one VM
+// generates is correct for every VM. With a per-VM executable allocator, the code would die with
+// the VM that allocated it, so we can't share there.
+static bool canShareAcrossVMs(ThunkGenerator generator)
+{
+#if ENABLE(ASSEMBLER_WX_EXCLUSIVE)
+    UNUSED_PARAM(generator);
+    return false;
+#else
+    return generator == arityFixupGenerator || generator == unreachableGenerator;
+#endif
+}
+
+static MacroAssemblerCodeRef sharedCTIStub(VM* vm, ThunkGenerator generator)
+{
+    static StaticLock sharedLock;
+    static NeverDestroyed<HashMap<ThunkGenerator, MacroAssemblerCodeRef>> sharedStubs;
+
+    std::lock_guard<StaticLock> locker(sharedLock);
+    auto entry = sharedStubs.get().add(generator, MacroAssemblerCodeRef());
+    if (entry.isNewEntry)
+        entry.iterator->value = generator(vm);
+    return entry.iterator->value;
+}
+
 MacroAssemblerCodeRef JITThunks::ctiStub(VM* vm, ThunkGenerator generator)
 {
     LockHolder locker(m_lock);
@@ -71,7 +98,10 @@ MacroAssemblerCodeRef JITThunks::ctiStub(VM* vm, ThunkGenerator generator)
     if (entry.isNewEntry) {
         // Compilation thread can only retrieve existing entries.
         ASSERT(!isCompilationThread());
-        entry.iterator->value = generator(vm);
+        if (Options::shareJITThunksAcrossVMs() && canShareAcrossVMs(generator))
+            entry.iterator->value = sharedCTIStub(vm, generator);
+        else
+            entry.iterator->value = generator(vm);
     }
     return entry.iterator->value;
 }
@@ -311,7 +311,8 @@ static InlineCacheAction tryCacheGetByID(ExecState* exec, JSValue baseValue, con
         newCase = AccessCase::get(
             vm, codeBlock, type, offset, structure, conditionSet, loadTargetFromProxy,
             slot.watchpointSet(), slot.isCacheableCustom() ? slot.customGetter() : nullptr,
-            slot.isCacheableCustom() ? slot.slotBase() : nullptr);
+            slot.isCacheableCustom() ? slot.slotBase() : nullptr,
+            slot.isCacheableCustom() ? slot.customIntrinsic() : NoIntrinsic);
     }
 
     MacroAssemblerCodePtr codePtr =
@@ -47,7 +47,9 @@
 #include "JSProxy.h"
 #include "JSString.h"
 #include "JSWASMModule.h"
+#include "ObjectConstructor.h"
 #include "ProfilerDatabase.h"
+#include "SamplingProfiler.h"
 #include "SamplingTool.h"
 #include "StackVisitor.h"
 #include "StructureInlines.h"
@@ -510,6 +512,8 @@ static EncodedJSValue JSC_HOST_CALL functionFullGC(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionEdenGC(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionForceGCSlowPaths(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionHeapSize(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionGCPauses(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionClearGCPauses(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionAddressOf(ExecState*);
 #ifndef NDEBUG
 static EncodedJSValue JSC_HOST_CALL functionDumpCallFrame(ExecState*);
@@ -553,6 +557,10 @@ static EncodedJSValue JSC_HOST_CALL functionLoadWebAssembly(ExecState*);
 #endif
 static EncodedJSValue JSC_HOST_CALL functionLoadModule(ExecState*);
 static EncodedJSValue JSC_HOST_CALL functionCheckModuleSyntax(ExecState*);
+#if ENABLE(JIT)
+static EncodedJSValue JSC_HOST_CALL functionStartSamplingProfiler(ExecState*);
+static EncodedJSValue JSC_HOST_CALL functionSamplingProfilerStackTraces(ExecState*);
+#endif
 
 #if ENABLE(SAMPLING_FLAGS)
 static EncodedJSValue JSC_HOST_CALL functionSetSamplingFlags(ExecState*);
@@ -673,6 +681,8 @@ protected:
         addFunction(vm, "edenGC", functionEdenGC, 0);
         addFunction(vm, "forceGCSlowPaths", functionForceGCSlowPaths, 0);
         addFunction(vm, "gcHeapSize", functionHeapSize, 0);
+        addFunction(vm, "gcPauses", functionGCPauses, 0);
+        addFunction(vm, "clearGCPauses", functionClearGCPauses, 0);
         addFunction(vm, "addressOf", functionAddressOf, 1);
 #ifndef NDEBUG
         addFunction(vm, "dumpCallFrame", functionDumpCallFrame, 0);
@@ -739,6 +749,10 @@ protected:
 #endif
         addFunction(vm, "loadModule", functionLoadModule, 1);
         addFunction(vm, "checkModuleSyntax", functionCheckModuleSyntax, 1);
+#if ENABLE(JIT)
+        addFunction(vm, "startSamplingProfiler", functionStartSamplingProfiler, 0);
+        addFunction(vm, "samplingProfilerStackTraces", functionSamplingProfilerStackTraces, 0);
+#endif
 
         JSArray* array = constructEmptyArray(globalExec(), 0);
         for (size_t i = 0; i < arguments.size(); ++i)
@@ -1207,6 +1221,36 @@ EncodedJSValue JSC_HOST_CALL functionHeapSize(ExecState* exec)
     return JSValue::encode(jsNumber(exec->heap()->size()));
 }
 
+// Returns the recent GC pauses, oldest first, as objects of the form { type: "Eden" or "Full", pause: milliseconds }.
+EncodedJSValue JSC_HOST_CALL functionGCPauses(ExecState* exec)
+{
+    JSLockHolder lock(exec);
+    VM& vm = exec->vm();
+
+    // Copy the pauses first, since allocating the result may itself trigger a collection.
+    Vector<GCLogging::PauseStatistics::Pause> pauses;
+    for (auto& pause : exec->heap()->pauseStatistics().recentPauses())
+        pauses.append(pause);
+
+    JSArray* result = constructEmptyArray(exec, nullptr);
+    Identifier typeIdentifier = Identifier::fromString(exec, "type");
+    Identifier pauseIdentifier = Identifier::fromString(exec, "pause");
+    for (unsigned i = 0; i < pauses.size(); ++i) {
+        JSObject* pause = constructEmptyObject(exec);
+        pause->putDirect(vm, typeIdentifier, jsString(exec, pauses[i].collectionType == EdenCollection ? ASCIILiteral("Eden") : ASCIILiteral("Full")));
+        pause->putDirect(vm, pauseIdentifier, jsNumber(pauses[i].pauseTime * 1000));
+        result->putDirectIndex(exec, i, pause);
+    }
+    return JSValue::encode(result);
+}
+
+EncodedJSValue JSC_HOST_CALL functionClearGCPauses(ExecState* exec)
+{
+    JSLockHolder lock(exec);
+    exec->heap()->clearRecentGCPauses();
+    return JSValue::encode(jsUndefined());
+}
+
 // This function is not generally very helpful in 64-bit code as the tag and payload
 // share a register. But in 32-bit JITed code the tag may not be checked if an
 // optimization removes type checking requirements, such as in ===.
@@ -1540,6 +1584,22 @@ EncodedJSValue JSC_HOST_CALL functionDrainMicrotasks(ExecState* exec)
     return JSValue::encode(jsUndefined());
 }
 
+#if ENABLE(JIT)
+EncodedJSValue JSC_HOST_CALL functionStartSamplingProfiler(ExecState* exec)
+{
+    exec->vm().ensureSamplingProfiler().start();
+    return JSValue::encode(jsUndefined());
+}
+
+EncodedJSValue JSC_HOST_CALL functionSamplingProfilerStackTraces(ExecState* exec)
+{
+    SamplingProfiler* samplingProfiler = exec->vm().samplingProfiler();
+    if (!samplingProfiler)
+        return JSValue::encode(exec->vm().throwException(exec, createError(exec, ASCIILiteral("Sampling profiler was never started."))));
+    return JSValue::encode(samplingProfiler->toJS(exec));
+}
+#endif
+
 EncodedJSValue JSC_HOST_CALL functionIs32BitPlatform(ExecState*)
 {
 #if USE(JSVALUE64)
@@ -120,6 +120,11 @@ namespace JSC {
             return m_data;
         }
 
+        void appendData(const uint8_t* data, size_t length)
+        {
+            m_data.append(data, length);
+        }
+
     private:
         WebAssemblySourceProvider(const Vector<uint8_t>& data, const String& url)
             : SourceProvider(url, TextPosition::minimumPosition())
@@ -26,10 +26,101 @@
 #include "config.h"
 #include "SourceProviderCache.h"
 
+#include "Identifier.h"
 #include "JSCInlines.h"
+#include "SourceCode.h"
 
 namespace JSC {
 
+static const uint32_t magic = 0x5053534a; // "JSSP" when read as bytes.
+static const uint32_t formatVersion = 1;
+
+enum ItemFlag {
+    NeedsFullActivationFlag = 1 << 0,
+    UsesEvalFlag = 1 << 1,
+    StrictModeFlag = 1 << 2,
+    IsBodyArrowExpressionFlag = 1 << 3
+};
+
+static void appendUInt32(Vector<uint8_t>& result, uint32_t value)
+{
+    result.append(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+}
+
+static void appendOffset(Vector<uint8_t>& result, int offset)
+{
+    appendUInt32(result, static_cast<uint32_t>(offset));
+}
+
+static void appendIdentifier(Vector<uint8_t>& result, const UniquedStringImpl* identifier)
+{
+    appendUInt32(result, identifier->length());
+    result.append(identifier->is8Bit());
+    if (identifier->is8Bit())
+        result.append(identifier->characters8(), identifier->length());
+    else
+        result.append(reinterpret_cast<const uint8_t*>(identifier->characters16()), identifier->length() * sizeof(UChar));
+}
+
+namespace {
+
+class Reader {
+public:
+    Reader(const uint8_t* data, size_t size)
+        : m_cursor(data)
+        , m_end(data + size)
+    {
+    }
+
+    bool atEnd() const { return m_cursor == m_end; }
+
+    bool readBytes(void* result, size_t size)
+    {
+        if (static_cast<size_t>(m_end - m_cursor) < size)
+            return false;
+        memcpy(result, m_cursor, size);
+        m_cursor += size;
+        return true;
+    }
+
+    bool readUInt32(uint32_t& result) { return readBytes(&result, sizeof(result)); }
+
+    bool readOffset(int& result)
+    {
+        uint32_t value;
+        if (!readUInt32(value))
+            return false;
+        result = static_cast<int32_t>(value);
+        return true;
+    }
+
+    bool readIdentifier(VM& vm, RefPtr<UniquedStringImpl>& result)
+    {
+        uint32_t length;
+        uint8_t is8Bit;
+        if (!readUInt32(length) || !readBytes(&is8Bit, sizeof(is8Bit)))
+            return false;
+        size_t characterSize = is8Bit ? sizeof(LChar) : sizeof(UChar);
+        if (static_cast<size_t>(m_end - m_cursor) / characterSize < length)
+            return false;
+        if (is8Bit) {
+            result = Identifier::fromString(&vm, reinterpret_cast<const LChar*>(m_cursor), length).impl();
+            m_cursor += length;
+            return true;
+        }
+        Vector<UChar> characters(length);
+        readBytes(characters.data(), length * sizeof(UChar));
+        result = Identifier::fromString(&vm, characters.data(), length).impl();
+        return true;
+    }
+
+private:
+    const uint8_t* m_cursor;
+    const uint8_t* m_end;
+};
+
+} // anonymous namespace
+
 SourceProviderCache::~SourceProviderCache()
 {
     clear();
@@ -45,4 +136,137 @@ void SourceProviderCache::add(int sourcePosition, std::unique_ptr<SourceProvider
     m_map.add(sourcePosition, WTF::move(item));
 }
 
+void SourceProviderCache::encode(const SourceCode& source, const SHA1::Digest& key, Vector<uint8_t>& result) const
+{
+    int start = source.startOffset();
+    int firstLine = source.firstLine();
+
+    appendUInt32(result, magic);
+    appendUInt32(result, formatVersion);
+    result.append(key.data(), key.size());
+
+    Vector<int> positions;
+    for (auto& entry : m_map) {
+        if (entry.key >= start && entry.key < source.endOffset())
+            positions.append(entry.key);
+    }
+    // Sorting makes the output independent of hash table order.
+    std::sort(positions.begin(), positions.end());
+    appendUInt32(result, positions.size());
+
+    for (int position : positions) {
+        const SourceProviderCacheItem* item = m_map.get(position);
+        appendOffset(result, position - start);
+        appendOffset(result, item->functionNameStart - start);
+        appendOffset(result, item->lastTockenLine - firstLine);
+        appendOffset(result, item->lastTockenStartOffset - start);
+        appendOffset(result, item->lastTockenEndOffset - start);
+        appendOffset(result, item->lastTockenLineStartOffset - start);
+        appendOffset(result, item->endFunctionOffset - start);
+        appendUInt32(result, item->parameterCount);
+        uint32_t flags = 0;
+        if (item->needsFullActivation)
+            flags |= NeedsFullActivationFlag;
+        if (item->usesEval)
+            flags |= UsesEvalFlag;
+        if (item->strictMode)
+            flags |= StrictModeFlag;
+        if (item->isBodyArrowExpression)
+            flags |= IsBodyArrowExpressionFlag;
+        appendUInt32(result, flags);
+        appendUInt32(result, item->tokenType);
+        appendUInt32(result, item->usedVariablesCount);
+        for (unsigned i = 0; i < item->usedVariablesCount; ++i)
+            appendIdentifier(result, item->usedVariables()[i]);
+        appendUInt32(result, item->writtenVariablesCount);
+        for (unsigned i = 0; i < item->writtenVariablesCount; ++i)
+            appendIdentifier(result, item->writtenVariables()[i]);
+    }
+}
+
+bool SourceProviderCache::decode(VM& vm, const SourceCode& source, const SHA1::Digest& key, const uint8_t* data, size_t size)
+{
+    Reader reader(data, size);
+    uint32_t fileMagic;
+    uint32_t fileFormatVersion;
+    SHA1::Digest fileKey;
+    if (!reader.readUInt32(fileMagic) || fileMagic != magic)
+        return false;
+    if (!reader.readUInt32(fileFormatVersion) || fileFormatVersion != formatVersion)
+        return false;
+    if (!reader.readBytes(fileKey.data(), fileKey.size()) || fileKey != key)
+        return false;
+
+    int start = source.startOffset();
+    int length = source.length();
+    int firstLine = source.firstLine();
+    auto isValidOffset = [&] (int offset) { return offset >= 0 && offset <= length; };
+
+    // Decode everything before adding anything, so that malformed data leaves the cache as it was.
+    uint32_t itemCount;
+    if (!reader.readUInt32(itemCount))
+        return false;
+    Vector<std::pair<int, std::unique_ptr<SourceProviderCacheItem>>> items;
+    for (uint32_t i = 0; i < itemCount; ++i) {
+        int position;
+        int functionNameStart;
+        int lastTokenLine;
+        int lastTokenStartOffset;
+        int lastTokenEndOffset;
+        int lastTokenLineStartOffset;
+        int endFunctionOffset;
+        uint32_t flags;
+        uint32_t tokenType;
+        SourceProviderCacheItemCreationParameters parameters;
+        if (!reader.readOffset(position) || !reader.readOffset(functionNameStart) || !reader.readOffset(lastTokenLine)
+            || !reader.readOffset(lastTokenStartOffset) || !reader.readOffset(lastTokenEndOffset) || !reader.readOffset(lastTokenLineStartOffset)
+            || !reader.readOffset(endFunctionOffset) || !reader.readUInt32(parameters.parameterCount)
+            || !reader.readUInt32(flags) || !reader.readUInt32(tokenType))
+            return false;
+        if (!isValidOffset(position) || !isValidOffset(functionNameStart) || lastTokenLine < 0
+            || !isValidOffset(lastTokenStartOffset) || !isValidOffset(lastTokenEndOffset) || lastTokenLineStartOffset > lastTokenStartOffset
+            || !isValidOffset(endFunctionOffset))
+            return false;
+
+        parameters.functionNameStart = functionNameStart + start;
+        parameters.lastTockenLine = lastTokenLine + firstLine;
+        parameters.lastTockenStartOffset = lastTokenStartOffset + start;
+        parameters.lastTockenEndOffset = lastTokenEndOffset + start;
+        parameters.lastTockenLineStartOffset = lastTokenLineStartOffset + start;
+        parameters.endFunctionOffset = endFunctionOffset + start;
+        parameters.needsFullActivation = flags & NeedsFullActivationFlag;
+        parameters.usesEval = flags & UsesEvalFlag;
+        parameters.strictMode = flags & StrictModeFlag;
+        parameters.isBodyArrowExpression = flags & IsBodyArrowExpressionFlag;
+        parameters.tokenType = static_cast<JSTokenType>(tokenType);
+
+        uint32_t usedVariablesCount;
+        if (!reader.readUInt32(usedVariablesCount))
+            return false;
+        for (uint32_t j = 0; j < usedVariablesCount; ++j) {
+            RefPtr<UniquedStringImpl> identifier;
+            if (!reader.readIdentifier(vm, identifier))
+                return false;
+            parameters.usedVariables.append(WTF::move(identifier));
+        }
+        uint32_t writtenVariablesCount;
+        if (!reader.readUInt32(writtenVariablesCount))
+            return false;
+        for (uint32_t j = 0; j < writtenVariablesCount; ++j) {
+            RefPtr<UniquedStringImpl> identifier;
+            if (!reader.readIdentifier(vm, identifier))
+                return false;
+            parameters.writtenVariables.append(WTF::move(identifier));
+        }
+
+        items.append(std::make_pair(position + start, SourceProviderCacheItem::create(parameters)));
+    }
+    if (!reader.atEnd())
+        return false;
+
+    for (auto& item : items)
+        m_map.add(item.first, WTF::move(item.second));
+    return true;
+}
+
 }
@@ -29,9 +29,13 @@
 #include "SourceProviderCacheItem.h"
 #include <wtf/HashMap.h>
 #include <wtf/RefCounted.h>
+#include <wtf/SHA1.h>
 
 namespace JSC {
 
+class SourceCode;
+class VM;
+
 class SourceProviderCache : public RefCounted<SourceProviderCache> {
     WTF_MAKE_FAST_ALLOCATED;
 public:
@@ -42,8 +46,21 @@ public:
     void add(int sourcePosition, std::unique_ptr<SourceProviderCacheItem>);
     const SourceProviderCacheItem* get(int sourcePosition) const { return m_map.get(sourcePosition); }
 
+    // The number of full collections since a parser last asked for this cache.
+    unsigned age() const { return m_age; }
+    void didUse() { m_age = 0; }
+    void didAge() { m_age++; }
+
+    // Flattens the items for functions inside the given source into a byte format that does not
+    // depend on where that source starts in its provider, so that CodeCache can keep them on disk
+    // next to the program's bytecode. decode() returns false if the data was written for another
+    // key or format version, or is malformed.
+    void encode(const SourceCode&, const SHA1::Digest& key, Vector<uint8_t>& result) const;
+    bool decode(VM&, const SourceCode&, const SHA1::Digest& key, const uint8_t* data, size_t size);
+
 private:
     HashMap<int, std::unique_ptr<SourceProviderCacheItem>, WTF::IntHash<int>, WTF::UnsignedWithZeroKeyHashTraits<int>> m_map;
+    unsigned m_age { 0 };
 };
 
 }
@@ -837,6 +837,129 @@ EncodedJSValue JSC_HOST_CALL arrayProtoFuncUnShift(ExecState* exec)
     return JSValue::encode(result);
 }
 
+static inline unsigned decimalDigitCount(uint64_t value)
+{
+    unsigned count = 1;
+    while (value >= 10) {
+        value /= 10;
+        ++count;
+    }
+    return count;
+}
+
+// Orders two integers the way sort() without a comparator does, by their decimal strings.
+static bool int32StringLessThan(int32_t a, int32_t b)
+{
+    // '-' sorts before every digit.
+    if ((a < 0) != (b < 0))
+        return a < 0;
+
+    uint64_t aDigits = a < 0 ? -static_cast<int64_t>(a) : a;
+    uint64_t bDigits = b < 0 ? -static_cast<int64_t>(b) : b;
+    unsigned aCount = decimalDigitCount(aDigits);
+    unsigned bCount = decimalDigitCount(bDigits);
+
+    // Line up the leading digits. If they all agree, the shorter string is a prefix of the longer.
+    for (unsigned i = aCount; i < bCount; ++i)
+        aDigits *= 10;
+    for (unsigned i = bCount; i < aCount; ++i)
+        bDigits *= 10;
+    if (aDigits != bDigits)
+        return aDigits < bDigits;
+    return aCount < bCount;
+}
+
+template<typename Entry>
+static void stableSortByString(Vector<Entry>& entries)
+{
+    std::stable_sort(entries.begin(), entries.end(), [] (const Entry& a, const Entry& b) {
+        return codePointCompareLessThan(a.first, b.first);
+    });
+}
+
+// Sorts the first length elements of the object in place, in the order sort() without a comparator uses, when
+// they are all stored in its butterfly and turning them into strings has no observable effect. Returns false,
+// without touching the object, when the caller has to sort it generically.
+EncodedJSValue JSC_HOST_CALL arrayPrivateFuncSortWithoutComparator(ExecState* exec)
+{
+    VM& vm = exec->vm();
+    JSObject* thisObject = asObject(exec->argument(0));
+    unsigned length = exec->argument(1).toUInt32(exec);
+
+    switch (thisObject->indexingType()) {
+    case ALL_INT32_INDEXING_TYPES: {
+        auto& butterfly = *thisObject->butterfly();
+        if (length > butterfly.publicLength())
+            break;
+        auto data = butterfly.contiguousInt32().data();
+        if (containsHole(data, length))
+            break;
+
+        // Distinct integers have distinct strings, so there is nothing for a stable sort to preserve.
+        Vector<int32_t> values;
+        values.reserveInitialCapacity(length);
+        for (unsigned i = 0; i < length; ++i)
+            values.uncheckedAppend(data[i].get().asInt32());
+        std::sort(values.begin(), values.end(), int32StringLessThan);
+        for (unsigned i = 0; i < length; ++i)
+            data[i].setWithoutWriteBarrier(jsNumber(values[i]));
+        return JSValue::encode(jsBoolean(true));
+    }
+    case ALL_DOUBLE_INDEXING_TYPES: {
+        auto& butterfly = *thisObject->butterfly();
+        if (length > butterfly.publicLength())
+            break;
+        auto data = butterfly.contiguousDouble().data();
+        if (containsHole(data, length))
+            break;
+
+        // 0 and -0 have the same string, so their order has to be kept.
+        Vector<std::pair<String, double>> entries;
+        entries.reserveInitialCapacity(length);
+        for (unsigned i = 0; i < length; ++i)
+            entries.uncheckedAppend(std::make_pair(String::numberToStringECMAScript(data[i]), data[i]));
+        stableSortByString(entries);
+        for (unsigned i = 0; i < length; ++i)
+            data[i] = entries[i].second;
+        return JSValue::encode(jsBoolean(true));
+    }
+    case ALL_CONTIGUOUS_INDEXING_TYPES: {
+        auto& butterfly = *thisObject->butterfly();
+        if (length > butterfly.publicLength())
+            break;
+        auto data = butterfly.contiguous().data();
+        if (containsHole(data, length))
+            break;
+
+        // Objects and symbols could run code or throw when converted, so they send the whole array to the caller.
+        Vector<std::pair<String, JSValue>> entries;
+        entries.reserveInitialCapacity(length);
+        for (unsigned i = 0; i < length; ++i) {
+            JSValue value = data[i].get();
+            if (value.isUndefined())
+                continue;
+            if (!value.isString() && !value.isNumber() && !value.isBoolean() && !value.isNull())
+                return JSValue::encode(jsBoolean(false));
+            entries.uncheckedAppend(std::make_pair(value.toWTFString(exec), value));
+            if (exec->hadException())
+                return JSValue::encode(jsUndefined());
+        }
+        stableSortByString(entries);
+
+        // Resolving ropes may have allocated, so the butterfly may have moved.
+        data = thisObject->butterfly()->contiguous().data();
+        for (unsigned i = 0; i < entries.size(); ++i)
+            data[i].set(vm, thisObject, entries[i].second);
+        // Undefineds go last.
+        for (unsigned i = entries.size(); i < length; ++i)
+            data[i].setWithoutWriteBarrier(jsUndefined());
+        return JSValue::encode(jsBoolean(true));
+    }
+    }
+
+    return JSValue::encode(jsBoolean(false));
+}
+
 EncodedJSValue JSC_HOST_CALL arrayProtoFuncIndexOf(ExecState* exec)
 {
     // 15.4.4.14
@@ -48,6 +48,7 @@ protected:
 
 EncodedJSValue JSC_HOST_CALL arrayProtoFuncToString(ExecState*);
 EncodedJSValue JSC_HOST_CALL arrayProtoFuncValues(ExecState*);
+EncodedJSValue JSC_HOST_CALL arrayPrivateFuncSortWithoutComparator(ExecState*);
 
 } // namespace JSC
 
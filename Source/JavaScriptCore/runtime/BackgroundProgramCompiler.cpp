@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "BackgroundProgramCompiler.h"
+
+#include "Executable.h"
+#include "JSCInlines.h"
+#include "ParserError.h"
+#include "SourceProvider.h"
+#include "StrongInlines.h"
+#include "UnlinkedCodeBlock.h"
+#include "UnlinkedCodeBlockSerializer.h"
+
+namespace JSC {
+
+BackgroundProgramCompiler::Job::Job(const SHA1::Digest& digest, const SourceCode& sourceCode)
+    : source(sourceCode.provider()->source().isolatedCopy())
+    , url(sourceCode.provider()->url().isolatedCopy())
+    , startPosition(sourceCode.provider()->startPosition())
+    , startOffset(sourceCode.startOffset())
+    , endOffset(sourceCode.endOffset())
+    , firstLine(sourceCode.firstLine())
+    , startColumn(sourceCode.startColumn())
+    , digest(digest)
+{
+}
+
+BackgroundProgramCompiler::BackgroundProgramCompiler()
+{
+}
+
+BackgroundProgramCompiler::~BackgroundProgramCompiler()
+{
+    if (!m_thread)
+        return;
+    {
+        LockHolder locker(m_lock);
+        m_shouldStop = true;
+        m_queue.clear();
+        m_jobEnqueued.notifyAll();
+    }
+    waitForThreadCompletion(m_thread);
+}
+
+void BackgroundProgramCompiler::enqueue(const SourceCodeKey& key, const SHA1::Digest& digest, const SourceCode& source)
+{
+    auto addResult = m_jobs.add(key, nullptr);
+    if (!addResult.isNewEntry)
+        return;
+    RefPtr<Job> job = adoptRef(new Job(digest, source));
+    addResult.iterator->value = job;
+
+    LockHolder locker(m_lock);
+    if (!m_thread)
+        m_thread = createThread(threadFunction, this, "JSC Background Program Compiler");
+    m_queue.append(WTF::move(job));
+    m_jobEnqueued.notifyOne();
+}
+
+bool BackgroundProgramCompiler::takeResult(const SourceCodeKey& key, SHA1::Digest& digest, Vector<uint8_t>& result)
+{
+    RefPtr<Job> job = m_jobs.take(key);
+    if (!job)
+        return false;
+
+    LockHolder locker(m_lock);
+    if (job->state == Job::Queued) {
+        auto iterator = m_queue.findIf([&] (const RefPtr<Job>& queuedJob) { return queuedJob == job; });
+        ASSERT(iterator != m_queue.end());
+        m_queue.remove(iterator);
+        return false;
+    }
+    while (job->state == Job::Compiling)
+        m_jobFinished.wait(m_lock);
+    if (job->state != Job::Succeeded)
+        return false;
+    digest = job->digest;
+    result.swap(job->result);
+    return true;
+}
+
+void BackgroundProgramCompiler::threadFunction(void* argument)
+{
+    static_cast<BackgroundProgramCompiler*>(argument)->runThread();
+}
+
+void BackgroundProgramCompiler::runThread()
+{
+    // A VM created on this thread uses this thread's identifier table.
+    RefPtr<VM> vm = VM::create();
+    Strong<JSGlobalObject> globalObject;
+    {
+        JSLockHolder locker(vm.get());
+        globalObject.set(*vm, JSGlobalObject::create(*vm, JSGlobalObject::createStructure(*vm, jsNull())));
+    }
+
+    for (;;) {
+        RefPtr<Job> job;
+        {
+            LockHolder locker(m_lock);
+            while (!m_shouldStop && m_queue.isEmpty())
+                m_jobEnqueued.wait(m_lock);
+            if (m_shouldStop)
+                break;
+            job = m_queue.takeFirst();
+            job->state = Job::Compiling;
+        }
+
+        Vector<uint8_t> result;
+        bool succeeded;
+        {
+            JSLockHolder locker(vm.get());
+            succeeded = compile(*vm, globalObject.get(), *job, result);
+        }
+
+        LockHolder locker(m_lock);
+        job->state = succeeded ? Job::Succeeded : Job::Failed;
+        job->result.swap(result);
+        m_jobFinished.notifyAll();
+    }
+
+    JSLockHolder locker(vm.get());
+    globalObject.clear();
+    vm = nullptr;
+}
+
+bool BackgroundProgramCompiler::compile(VM& vm, JSGlobalObject* globalObject, Job& job, Vector<uint8_t>& result)
+{
+    SourceCode source(StringSourceProvider::create(job.source, job.url, job.startPosition), job.startOffset, job.endOffset, job.firstLine, job.startColumn);
+    job.source = String();
+    job.url = String();
+
+    ProgramExecutable* executable = ProgramExecutable::create(globalObject->globalExec(), source);
+    ParserError error;
+    UnlinkedProgramCodeBlock* codeBlock = vm.codeCache()->getProgramCodeBlock(
+        vm, executable, source, JSParserBuiltinMode::NotBuiltin, JSParserStrictMode::NotStrict, DebuggerOff, ProfilerOff, error);
+    bool succeeded = codeBlock && UnlinkedCodeBlockSerializer::encode(codeBlock, job.digest, result);
+
+    // The result goes to another VM, so there is no point in keeping it around in this one.
+    vm.codeCache()->clear();
+    return succeeded;
+}
+
+} // namespace JSC
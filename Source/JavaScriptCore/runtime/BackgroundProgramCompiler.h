@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef BackgroundProgramCompiler_h
+#define BackgroundProgramCompiler_h
+
+#include "CodeCache.h"
+#include <wtf/Condition.h>
+#include <wtf/Deque.h>
+#include <wtf/HashMap.h>
+#include <wtf/Lock.h>
+#include <wtf/SHA1.h>
+#include <wtf/Threading.h>
+#include <wtf/ThreadSafeRefCounted.h>
+#include <wtf/text/TextPosition.h>
+
+namespace JSC {
+
+class JSGlobalObject;
+
+// Parses and generates bytecode for top-level programs on a helper thread, so that the thread
+// that runs them only has to decode the result. The helper thread has its own VM, and with it
+// its own heap, parser arena and identifier table. Nothing it allocates is shared with the VM
+// that asked for the compilation: the program source goes in as an isolated copy and the code
+// block comes back in the format of UnlinkedCodeBlockSerializer.
+class BackgroundProgramCompiler {
+    WTF_MAKE_NONCOPYABLE(BackgroundProgramCompiler);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    BackgroundProgramCompiler();
+    ~BackgroundProgramCompiler();
+
+    void enqueue(const SourceCodeKey&, const SHA1::Digest&, const SourceCode&);
+
+    // Returns false if the key was never enqueued or the helper thread could not compile the
+    // program, in which case the caller should compile it itself. A program whose compilation
+    // has not started yet is taken off the queue, since waiting for it would take longer than
+    // compiling it on the calling thread. A program that is being compiled is waited for.
+    bool takeResult(const SourceCodeKey&, SHA1::Digest&, Vector<uint8_t>& result);
+
+private:
+    class Job : public ThreadSafeRefCounted<Job> {
+    public:
+        enum State { Queued, Compiling, Succeeded, Failed };
+
+        Job(const SHA1::Digest&, const SourceCode&);
+
+        // Only the helper thread uses these, and clears them when it is done, so that the
+        // strings die on that thread.
+        String source;
+        String url;
+        TextPosition startPosition;
+        int startOffset;
+        int endOffset;
+        int firstLine;
+        int startColumn;
+
+        SHA1::Digest digest;
+        State state { Queued };
+        Vector<uint8_t> result;
+    };
+
+    static void threadFunction(void*);
+    void runThread();
+    static bool compile(VM&, JSGlobalObject*, Job&, Vector<uint8_t>& result);
+
+    HashMap<SourceCodeKey, RefPtr<Job>, SourceCodeKeyHash, SourceCodeKeyHashTraits> m_jobs; // Only used by the VM's thread.
+
+    Lock m_lock;
+    Condition m_jobEnqueued;
+    Condition m_jobFinished;
+    Deque<RefPtr<Job>> m_queue;
+    bool m_shouldStop { false };
+    ThreadIdentifier m_thread { 0 };
+};
+
+} // namespace JSC
+
+#endif // BackgroundProgramCompiler_h
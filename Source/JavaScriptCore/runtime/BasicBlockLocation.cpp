@@ -28,6 +28,7 @@
 #include "BasicBlockLocation.h"
 
 #include "CCallHelpers.h"
+#include "Options.h"
 #include <climits>
 #include <wtf/DataLog.h>
 
@@ -83,12 +84,22 @@ void BasicBlockLocation::dumpData() const
 void BasicBlockLocation::emitExecuteCode(CCallHelpers& jit) const
 {
     static_assert(sizeof(size_t) == 8, "Assuming size_t is 64 bits on 64 bit platforms.");
+    if (Options::useBasicBlockCoverage()) {
+        // There is no store of an immediate to an absolute 64-bit address. Setting the low half
+        // is enough to make the count nonzero, since all 64-bit targets are little endian.
+        jit.store32(CCallHelpers::TrustedImm32(1), bitwise_cast<void*>(&m_executionCount));
+        return;
+    }
     jit.add64(CCallHelpers::TrustedImm32(1), CCallHelpers::AbsoluteAddress(&m_executionCount));
 }
 #else
 void BasicBlockLocation::emitExecuteCode(CCallHelpers& jit, MacroAssembler::RegisterID scratch) const
 {
     static_assert(sizeof(size_t) == 4, "Assuming size_t is 32 bits on 32 bit platforms.");
+    if (Options::useBasicBlockCoverage()) {
+        jit.store32(CCallHelpers::TrustedImm32(1), bitwise_cast<void*>(&m_executionCount));
+        return;
+    }
     jit.load32(&m_executionCount, scratch);
     CCallHelpers::Jump done = jit.branchAdd32(CCallHelpers::Zero, scratch, CCallHelpers::TrustedImm32(1), scratch);
     jit.store32(scratch, bitwise_cast<void*>(&m_executionCount));
@@ -49,6 +49,7 @@ public:
     void setEndOffset(int endOffset) { m_endOffset = endOffset; }
     bool hasExecuted() const { return m_executionCount > 0; }
     size_t executionCount() const { return m_executionCount; }
+    size_t* executionCountAddress() { return &m_executionCount; }
     void insertGap(int, int);
     Vector<Gap> getExecutedRanges() const;
     JS_EXPORT_PRIVATE void dumpData() const;
@@ -27,12 +27,16 @@
 
 #include "CodeCache.h"
 
+#include "BackgroundProgramCompiler.h"
 #include "BytecodeGenerator.h"
 #include "CodeSpecializationKind.h"
 #include "JSCInlines.h"
 #include "Parser.h"
+#include "SourceProviderCache.h"
 #include "StrongInlines.h"
 #include "UnlinkedCodeBlock.h"
+#include "UnlinkedCodeBlockSerializer.h"
+#include <stdio.h>
 
 namespace JSC {
 
@@ -82,6 +86,136 @@ template <> struct CacheTypes<UnlinkedModuleProgramCodeBlock> {
     static const SourceParseMode parseMode = SourceParseMode::ModuleEvaluateMode;
 };
 
+static SHA1::Digest diskCacheKey(const SourceCodeKey& key)
+{
+    SHA1 sha1;
+    unsigned flags = key.flags();
+    sha1.addBytes(reinterpret_cast<const uint8_t*>(&flags), sizeof(flags));
+    sha1.addBytes(key.name().utf8());
+    String source = key.string();
+    uint8_t is8Bit = source.is8Bit();
+    sha1.addBytes(&is8Bit, sizeof(is8Bit));
+    if (source.is8Bit())
+        sha1.addBytes(source.characters8(), source.length() * sizeof(LChar));
+    else
+        sha1.addBytes(reinterpret_cast<const uint8_t*>(source.characters16()), source.length() * sizeof(UChar));
+    SHA1::Digest digest;
+    sha1.computeHash(digest);
+    return digest;
+}
+
+static CString diskCacheFileName(const SHA1::Digest& digest, const char* suffix = "")
+{
+    return makeString(Options::diskCachePath(), "/", SHA1::hexDigest(digest).data(), suffix).utf8();
+}
+
+static const char* const preparseDataSuffix = ".functions";
+
+static bool readDiskCacheFile(const CString& fileName, Vector<uint8_t>& data)
+{
+    FILE* file = fopen(fileName.data(), "rb");
+    if (!file)
+        return false;
+
+    uint8_t chunk[16 * KB];
+    while (size_t size = fread(chunk, 1, sizeof(chunk), file))
+        data.append(chunk, size);
+    bool failed = ferror(file);
+    fclose(file);
+    return !failed;
+}
+
+static void writeDiskCacheFile(const CString& fileName, const Vector<uint8_t>& data)
+{
+    // Write to a temporary file and rename it into place, so that a concurrent reader never
+    // sees a partially written entry.
+    CString temporaryFileName = makeString(fileName.data(), ".tmp").utf8();
+    FILE* file = fopen(temporaryFileName.data(), "wb");
+    if (!file)
+        return;
+    bool failed = fwrite(data.data(), 1, data.size(), file) != data.size();
+    failed |= !!fclose(file);
+    if (failed || rename(temporaryFileName.data(), fileName.data()))
+        remove(temporaryFileName.data());
+}
+
+static bool canUseDiskCache(JSParserBuiltinMode builtinMode)
+{
+    return Options::diskCachePath() && builtinMode == JSParserBuiltinMode::NotBuiltin;
+}
+
+// Only program code is cached on disk. Eval code depends on the variables under TDZ at the call
+// site, and neither it nor module code is common enough at startup to be worth the disk traffic.
+template <class UnlinkedCodeBlockType>
+static UnlinkedCodeBlockType* readFromDiskCache(VM&, const ExecutableInfo&, const SourceCode&, const SHA1::Digest&)
+{
+    return nullptr;
+}
+
+template <class UnlinkedCodeBlockType>
+static void writeToDiskCache(VM&, UnlinkedCodeBlockType*, const SourceCode&, const SHA1::Digest&)
+{
+}
+
+template <>
+UnlinkedProgramCodeBlock* readFromDiskCache(VM& vm, const ExecutableInfo& info, const SourceCode& source, const SHA1::Digest& digest)
+{
+    Vector<uint8_t> data;
+    if (!readDiskCacheFile(diskCacheFileName(digest), data))
+        return nullptr;
+
+    UnlinkedProgramCodeBlock* codeBlock = UnlinkedCodeBlockSerializer::decode(vm, info, digest, data.data(), data.size());
+    if (!codeBlock)
+        return nullptr;
+
+    // The program's functions are parsed again when they are first called. Restoring what the
+    // first parse learned about their inner functions lets those reparses skip them.
+    Vector<uint8_t> preparseData;
+    if (readDiskCacheFile(diskCacheFileName(digest, preparseDataSuffix), preparseData))
+        vm.addSourceProviderCache(source.provider())->decode(vm, source, digest, preparseData.data(), preparseData.size());
+    return codeBlock;
+}
+
+template <>
+void writeToDiskCache(VM& vm, UnlinkedProgramCodeBlock* codeBlock, const SourceCode& source, const SHA1::Digest& digest)
+{
+    Vector<uint8_t> data;
+    if (!UnlinkedCodeBlockSerializer::encode(codeBlock, digest, data))
+        return;
+    writeDiskCacheFile(diskCacheFileName(digest), data);
+
+    Vector<uint8_t> preparseData;
+    vm.addSourceProviderCache(source.provider())->encode(source, digest, preparseData);
+    writeDiskCacheFile(diskCacheFileName(digest, preparseDataSuffix), preparseData);
+}
+
+template <class UnlinkedCodeBlockType>
+static UnlinkedCodeBlockType* takeFromBackgroundCompiler(VM&, BackgroundProgramCompiler*, const ExecutableInfo&, const SourceCodeKey&)
+{
+    return nullptr;
+}
+
+template <>
+UnlinkedProgramCodeBlock* takeFromBackgroundCompiler(VM& vm, BackgroundProgramCompiler* compiler, const ExecutableInfo& info, const SourceCodeKey& key)
+{
+    SHA1::Digest digest;
+    Vector<uint8_t> data;
+    if (!compiler || !compiler->takeResult(key, digest, data))
+        return nullptr;
+    return UnlinkedCodeBlockSerializer::decode(vm, info, digest, data.data(), data.size());
+}
+
+template <class UnlinkedCodeBlockType, class ExecutableType>
+static void recordParseFromCachedCodeBlock(ExecutableType* executable, UnlinkedCodeBlockType* unlinkedCodeBlock, const SourceCode& source)
+{
+    unsigned firstLine = source.firstLine() + unlinkedCodeBlock->firstLine();
+    unsigned lineCount = unlinkedCodeBlock->lineCount();
+    unsigned startColumn = unlinkedCodeBlock->startColumn() + source.startColumn();
+    bool endColumnIsOnStartLine = !lineCount;
+    unsigned endColumn = unlinkedCodeBlock->endColumn() + (endColumnIsOnStartLine ? startColumn : 1);
+    executable->recordParse(unlinkedCodeBlock->codeFeatures(), unlinkedCodeBlock->hasCapturedVariables(), firstLine, firstLine + lineCount, startColumn, endColumn);
+}
+
 template <class UnlinkedCodeBlockType, class ExecutableType>
 UnlinkedCodeBlockType* CodeCache::getGlobalCodeBlock(VM& vm, ExecutableType* executable, const SourceCode& source, JSParserBuiltinMode builtinMode,
     JSParserStrictMode strictMode, ThisTDZMode thisTDZMode, DebuggerMode debuggerMode, ProfilerMode profilerMode, ParserError& error, const VariableEnvironment* variablesUnderTDZ)
@@ -91,15 +225,29 @@ UnlinkedCodeBlockType* CodeCache::getGlobalCodeBlock(VM& vm, ExecutableType* exe
     bool canCache = debuggerMode == DebuggerOff && profilerMode == ProfilerOff && !vm.typeProfiler() && !vm.controlFlowProfiler();
     if (cache && canCache) {
         UnlinkedCodeBlockType* unlinkedCodeBlock = jsCast<UnlinkedCodeBlockType*>(cache->cell.get());
-        unsigned firstLine = source.firstLine() + unlinkedCodeBlock->firstLine();
-        unsigned lineCount = unlinkedCodeBlock->lineCount();
-        unsigned startColumn = unlinkedCodeBlock->startColumn() + source.startColumn();
-        bool endColumnIsOnStartLine = !lineCount;
-        unsigned endColumn = unlinkedCodeBlock->endColumn() + (endColumnIsOnStartLine ? startColumn : 1);
-        executable->recordParse(unlinkedCodeBlock->codeFeatures(), unlinkedCodeBlock->hasCapturedVariables(), firstLine, firstLine + lineCount, startColumn, endColumn);
+        recordParseFromCachedCodeBlock(executable, unlinkedCodeBlock, source);
         return unlinkedCodeBlock;
     }
 
+    bool useDiskCache = canCache && canUseDiskCache(builtinMode);
+    SHA1::Digest diskKey;
+    if (useDiskCache) {
+        diskKey = diskCacheKey(key);
+        if (UnlinkedCodeBlockType* unlinkedCodeBlock = readFromDiskCache<UnlinkedCodeBlockType>(vm, executable->executableInfo(), source, diskKey)) {
+            recordParseFromCachedCodeBlock(executable, unlinkedCodeBlock, source);
+            m_sourceCode.addCache(key, SourceCodeValue(vm, unlinkedCodeBlock, m_sourceCode.age()));
+            return unlinkedCodeBlock;
+        }
+    }
+
+    if (canCache) {
+        if (UnlinkedCodeBlockType* unlinkedCodeBlock = takeFromBackgroundCompiler<UnlinkedCodeBlockType>(vm, m_backgroundProgramCompiler.get(), executable->executableInfo(), key)) {
+            recordParseFromCachedCodeBlock(executable, unlinkedCodeBlock, source);
+            m_sourceCode.addCache(key, SourceCodeValue(vm, unlinkedCodeBlock, m_sourceCode.age()));
+            return unlinkedCodeBlock;
+        }
+    }
+
     typedef typename CacheTypes<UnlinkedCodeBlockType>::RootNode RootNode;
     std::unique_ptr<RootNode> rootNode = parse<RootNode>(
         &vm, source, Identifier(), builtinMode, strictMode,
@@ -126,9 +274,21 @@ UnlinkedCodeBlockType* CodeCache::getGlobalCodeBlock(VM& vm, ExecutableType* exe
         return unlinkedCodeBlock;
 
     m_sourceCode.addCache(key, SourceCodeValue(vm, unlinkedCodeBlock, m_sourceCode.age()));
+    if (useDiskCache)
+        writeToDiskCache(vm, unlinkedCodeBlock, source, diskKey);
     return unlinkedCodeBlock;
 }
 
+void CodeCache::compileProgramInBackground(const SourceCode& source)
+{
+    SourceCodeKey key(source, String(), SourceCodeKey::ProgramType, JSParserBuiltinMode::NotBuiltin, JSParserStrictMode::NotStrict);
+    if (m_sourceCode.findCacheAndUpdateAge(key))
+        return;
+    if (!m_backgroundProgramCompiler)
+        m_backgroundProgramCompiler = std::make_unique<BackgroundProgramCompiler>();
+    m_backgroundProgramCompiler->enqueue(key, diskCacheKey(key), source);
+}
+
 UnlinkedProgramCodeBlock* CodeCache::getProgramCodeBlock(VM& vm, ProgramExecutable* executable, const SourceCode& source, JSParserBuiltinMode builtinMode, JSParserStrictMode strictMode, DebuggerMode debuggerMode, ProfilerMode profilerMode, ParserError& error)
 {
     VariableEnvironment emptyParentTDZVariables;
@@ -39,6 +39,7 @@
 
 namespace JSC {
 
+class BackgroundProgramCompiler;
 class EvalExecutable;
 class FunctionMetadataNode;
 class Identifier;
@@ -94,6 +95,9 @@ public:
     // providers cache their strings to make this efficient.
     String string() const { return m_sourceCode.toString(); }
 
+    const String& name() const { return m_name; }
+    unsigned flags() const { return m_flags; }
+
     bool operator==(const SourceCodeKey& other) const
     {
         return m_hash == other.m_hash
@@ -262,6 +266,10 @@ public:
     UnlinkedModuleProgramCodeBlock* getModuleProgramCodeBlock(VM&, ModuleProgramExecutable*, const SourceCode&, JSParserBuiltinMode, DebuggerMode, ProfilerMode, ParserError&);
     UnlinkedFunctionExecutable* getFunctionExecutableFromGlobalCode(VM&, const Identifier&, const SourceCode&, ParserError&);
 
+    // Starts parsing and generating bytecode for a non-strict program on a helper thread. A later
+    // getProgramCodeBlock() for the same source picks up the result instead of compiling it again.
+    JS_EXPORT_PRIVATE void compileProgramInBackground(const SourceCode&);
+
     void clear()
     {
         m_sourceCode.clear();
@@ -272,6 +280,7 @@ private:
     UnlinkedCodeBlockType* getGlobalCodeBlock(VM&, ExecutableType*, const SourceCode&, JSParserBuiltinMode, JSParserStrictMode, ThisTDZMode, DebuggerMode, ProfilerMode, ParserError&, const VariableEnvironment*);
 
     CodeCacheMap m_sourceCode;
+    std::unique_ptr<BackgroundProgramCompiler> m_backgroundProgramCompiler;
 };
 
 }
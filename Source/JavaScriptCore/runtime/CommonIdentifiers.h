@@ -180,6 +180,7 @@
     macro(sourceURL) \
     macro(sourceCode) \
     macro(stack) \
+    macro(stackTraces) \
     macro(subarray) \
     macro(target) \
     macro(test) \
@@ -303,6 +304,7 @@
     macro(TypeError) \
     macro(typedArrayLength) \
     macro(typedArraySort) \
+    macro(arraySortWithoutComparator) \
     macro(undefined) \
     macro(BuiltinLog) \
     macro(homeObject) \
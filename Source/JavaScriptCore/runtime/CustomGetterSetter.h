@@ -26,6 +26,7 @@
 #ifndef CustomGetterSetter_h
 #define CustomGetterSetter_h
 
+#include "Intrinsic.h"
 #include "JSCell.h"
 #include "PropertySlot.h"
 #include "PutPropertySlot.h"
@@ -41,15 +42,16 @@ public:
     typedef PropertySlot::GetValueFunc CustomGetter;
     typedef PutPropertySlot::PutValueFunc CustomSetter;
 
-    static CustomGetterSetter* create(VM& vm, CustomGetter customGetter, CustomSetter customSetter)
+    static CustomGetterSetter* create(VM& vm, CustomGetter customGetter, CustomSetter customSetter, Intrinsic getterIntrinsic = NoIntrinsic)
     {
-        CustomGetterSetter* customGetterSetter = new (NotNull, allocateCell<CustomGetterSetter>(vm.heap)) CustomGetterSetter(vm, customGetter, customSetter);
+        CustomGetterSetter* customGetterSetter = new (NotNull, allocateCell<CustomGetterSetter>(vm.heap)) CustomGetterSetter(vm, customGetter, customSetter, getterIntrinsic);
         customGetterSetter->finishCreation(vm);
         return customGetterSetter;
     }
 
     CustomGetterSetter::CustomGetter getter() const { return m_getter; }
     CustomGetterSetter::CustomSetter setter() const { return m_setter; }
+    Intrinsic getterIntrinsic() const { return m_getterIntrinsic; }
 
     static Structure* createStructure(VM& vm, JSGlobalObject* globalObject, JSValue prototype)
     {
@@ -59,15 +61,17 @@ public:
     DECLARE_EXPORT_INFO;
 
 private:
-    CustomGetterSetter(VM& vm, CustomGetter getter, CustomSetter setter)
+    CustomGetterSetter(VM& vm, CustomGetter getter, CustomSetter setter, Intrinsic getterIntrinsic)
         : JSCell(vm, vm.customGetterSetterStructure.get())
         , m_getter(getter)
         , m_setter(setter)
+        , m_getterIntrinsic(getterIntrinsic)
     {
     }
 
     CustomGetter m_getter;
     CustomSetter m_setter;
+    Intrinsic m_getterIntrinsic;
 };
 
 void callCustomSetter(ExecState*, JSValue customGetterSetter, JSObject* base, JSValue thisValue, JSValue value);
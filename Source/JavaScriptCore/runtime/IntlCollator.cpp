@@ -36,6 +36,10 @@
 #include "JSCellInlines.h"
 #include "SlotVisitorInlines.h"
 #include "StructureInlines.h"
+#include <unicode/ucol.h>
+#include <wtf/text/ASCIIFastPath.h>
+#include <wtf/text/StringBuilder.h>
+#include <wtf/text/StringView.h>
 
 namespace JSC {
 
@@ -84,6 +88,123 @@ void IntlCollator::setBoundCompare(VM& vm, JSBoundFunction* format)
     m_boundCompare.set(vm, this, format);
 }
 
+IntlCollatorCache::~IntlCollatorCache()
+{
+    for (UCollator* collator : m_collators.values())
+        ucol_close(collator);
+}
+
+static String cacheKey(const IntlCollator& collator)
+{
+    StringBuilder key;
+    key.append(collator.locale());
+    key.append('|');
+    key.append(collator.usage());
+    key.append('|');
+    key.append(collator.collation());
+    key.append('|');
+    key.append(collator.sensitivity());
+    key.append(collator.numeric() ? "|kn" : "|");
+    key.append(collator.ignorePunctuation() ? "|ip" : "|");
+    return key.toString();
+}
+
+static UCollator* openCollator(const IntlCollator& collator)
+{
+    // The resolved locale is a BCP 47 tag. ICU accepts the language and region subtags as they
+    // are; the collation type is requested through an ICU keyword instead of the -u-co- extension.
+    String locale = collator.locale();
+    size_t extensionIndex = locale.find("-u-");
+    if (extensionIndex != notFound)
+        locale = locale.left(extensionIndex);
+
+    StringBuilder localeID;
+    localeID.append(locale);
+    if (collator.usage() == "search")
+        localeID.appendLiteral("@collation=search");
+    else if (collator.collation() != "default") {
+        localeID.appendLiteral("@collation=");
+        localeID.append(collator.collation());
+    }
+
+    UErrorCode status = U_ZERO_ERROR;
+    UCollator* result = ucol_open(localeID.toString().utf8().data(), &status);
+    if (U_FAILURE(status))
+        return nullptr;
+
+    UColAttributeValue strength = UCOL_PRIMARY;
+    UColAttributeValue caseLevel = UCOL_OFF;
+    const String& sensitivity = collator.sensitivity();
+    if (sensitivity == "accent")
+        strength = UCOL_SECONDARY;
+    else if (sensitivity == "case")
+        caseLevel = UCOL_ON;
+    else if (sensitivity == "variant")
+        strength = UCOL_TERTIARY;
+    else
+        ASSERT(sensitivity == "base");
+
+    ucol_setAttribute(result, UCOL_STRENGTH, strength, &status);
+    ucol_setAttribute(result, UCOL_CASE_LEVEL, caseLevel, &status);
+    ucol_setAttribute(result, UCOL_NUMERIC_COLLATION, collator.numeric() ? UCOL_ON : UCOL_OFF, &status);
+    ucol_setAttribute(result, UCOL_ALTERNATE_HANDLING, collator.ignorePunctuation() ? UCOL_SHIFTED : UCOL_DEFAULT, &status);
+    ucol_setAttribute(result, UCOL_NORMALIZATION_MODE, UCOL_ON, &status);
+    if (U_FAILURE(status)) {
+        ucol_close(result);
+        return nullptr;
+    }
+    return result;
+}
+
+UCollator* IntlCollatorCache::collatorFor(const IntlCollator& collator)
+{
+    auto addResult = m_collators.add(cacheKey(collator), nullptr);
+    if (addResult.isNewEntry) {
+        addResult.iterator->value = openCollator(collator);
+        if (!addResult.iterator->value) {
+            m_collators.remove(addResult.iterator);
+            return nullptr;
+        }
+    }
+    return addResult.iterator->value;
+}
+
+static inline bool is8BitASCII(StringView string)
+{
+    return string.is8Bit() && charactersAreAllASCII(string.characters8(), string.length());
+}
+
+JSValue IntlCollator::compareStrings(ExecState* exec, StringView x, StringView y)
+{
+    // 10.3.4 CompareStrings abstract operation (ECMA-402 2.0)
+    if (!m_collator) {
+        m_collator = exec->vm().intlCollatorCache().collatorFor(*this);
+        if (!m_collator)
+            return throwTypeError(exec, ASCIILiteral("failed to initialize Collator"));
+    }
+
+    // Identical strings compare equal under every sensitivity. This is common when sorting
+    // tables with many repeated values.
+    if (x == y)
+        return jsNumber(0);
+
+    UErrorCode status = U_ZERO_ERROR;
+    UCollationResult result;
+    if (is8BitASCII(x) && is8BitASCII(y)) {
+        // ASCII is valid UTF-8, so 8-bit strings can be collated in place without widening them.
+        UCharIterator iteratorX;
+        UCharIterator iteratorY;
+        uiter_setUTF8(&iteratorX, reinterpret_cast<const char*>(x.characters8()), x.length());
+        uiter_setUTF8(&iteratorY, reinterpret_cast<const char*>(y.characters8()), y.length());
+        result = ucol_strcollIter(m_collator, &iteratorX, &iteratorY, &status);
+    } else
+        result = ucol_strcoll(m_collator, x.upconvertedCharacters(), x.length(), y.upconvertedCharacters(), y.length());
+
+    if (U_FAILURE(status))
+        return throwTypeError(exec, ASCIILiteral("failed to compare strings"));
+    return jsNumber(result);
+}
+
 EncodedJSValue JSC_HOST_CALL IntlCollatorFuncCompare(ExecState* exec)
 {
     // 10.3.4 Collator Compare Functions (ECMA-402 2.0)
@@ -109,12 +230,7 @@ EncodedJSValue JSC_HOST_CALL IntlCollatorFuncCompare(ExecState* exec)
         return JSValue::encode(jsUndefined());
 
     // 9. Return CompareStrings(collator, X, Y).
-
-    // 10.3.4 CompareStrings abstract operation (ECMA-402 2.0)
-    // FIXME: Implement CompareStrings.
-
-    // Return simple check until properly implemented.
-    return JSValue::encode(jsNumber(codePointCompare(a->value(exec).impl(), b->value(exec).impl())));
+    return JSValue::encode(collator->compareStrings(exec, a->view(exec), b->view(exec)));
 }
 
 } // namespace JSC
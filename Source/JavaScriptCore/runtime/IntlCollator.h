@@ -29,12 +29,33 @@
 #if ENABLE(INTL)
 
 #include "JSDestructibleObject.h"
+#include <wtf/HashMap.h>
+#include <wtf/text/WTFString.h>
+
+struct UCollator;
 
 namespace JSC {
 
+class IntlCollator;
 class IntlCollatorConstructor;
 class JSBoundFunction;
 
+// Opening a UCollator loads and parses the locale's tailoring rules, which costs far more than
+// a comparison. The VM keeps one collator per distinct set of resolved options and hands it to
+// every IntlCollator that resolves to the same options.
+class IntlCollatorCache {
+    WTF_MAKE_NONCOPYABLE(IntlCollatorCache);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    IntlCollatorCache() { }
+    ~IntlCollatorCache();
+
+    UCollator* collatorFor(const IntlCollator&);
+
+private:
+    HashMap<String, UCollator*> m_collators;
+};
+
 class IntlCollator : public JSDestructibleObject {
 public:
     typedef JSDestructibleObject Base;
@@ -59,6 +80,8 @@ public:
     JSBoundFunction* boundCompare() const { return m_boundCompare.get(); }
     void setBoundCompare(VM&, JSBoundFunction*);
 
+    JSValue compareStrings(ExecState*, StringView, StringView);
+
 protected:
     IntlCollator(VM&, Structure*);
     void finishCreation(VM&);
@@ -71,6 +94,7 @@ private:
     String m_collation;
     String m_sensitivity;
     WriteBarrier<JSBoundFunction> m_boundCompare;
+    UCollator* m_collator { nullptr }; // Owned by the VM's IntlCollatorCache.
     bool m_numeric;
     bool m_ignorePunctuation;
 };
@@ -60,6 +60,14 @@ enum Intrinsic {
     TypedArrayByteLengthIntrinsic,
     TypedArrayByteOffsetIntrinsic,
 
+    // Custom accessor intrinsics. These mark getters of host objects, like the DOM bindings, that
+    // have no side effects and only read state that script can only change by calling out of the
+    // JIT. The name gives the type of the value they return.
+    CustomGetterReturningInt32Intrinsic,
+    CustomGetterReturningBooleanIntrinsic,
+    CustomGetterReturningStringIntrinsic,
+    CustomGetterReturningObjectOrNullIntrinsic,
+
     // Debugging intrinsics. These are meant to be used as testing hacks within
     // jsc.cpp and should never be exposed to users.
     DFGTrueIntrinsic,
@@ -70,6 +78,19 @@ enum Intrinsic {
     FiatInt52Intrinsic,
 };
 
+inline bool isCustomGetterIntrinsic(Intrinsic intrinsic)
+{
+    switch (intrinsic) {
+    case CustomGetterReturningInt32Intrinsic:
+    case CustomGetterReturningBooleanIntrinsic:
+    case CustomGetterReturningStringIntrinsic:
+    case CustomGetterReturningObjectOrNullIntrinsic:
+        return true;
+    default:
+        return false;
+    }
+}
+
 } // namespace JSC
 
 #endif // Intrinsic_h
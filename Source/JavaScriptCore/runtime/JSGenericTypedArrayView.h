@@ -181,10 +181,18 @@ public:
         if (exec->hadException())
             return false;
 
-        // We might want to do something faster here (e.g. SIMD) if this is too slow.
         typename Adaptor::Type* array = typedVector();
-        for (unsigned i = start; i < end; ++i)
-            array[i] = value;
+
+        // Byte-sized elements and zeros of any type, which are all zero bits, can be filled with memset.
+        typename Adaptor::Type zero = 0;
+        if (elementSize == 1 || !memcmp(&value, &zero, elementSize)) {
+            uint8_t byte;
+            memcpy(&byte, &value, 1);
+            memset(array + start, byte, (end - start) * elementSize);
+            return true;
+        }
+
+        std::fill(array + start, array + end, value);
 
         return true;
     }
@@ -185,37 +185,55 @@ bool JSGenericTypedArrayView<Adaptor>::setWithSpecificType(
     // specialization.
 
     unsigned otherElementSize = sizeof(typename OtherAdaptor::Type);
-    
-    // Handle cases (1) and (2B).
+
+    // Integers of the same size convert by reinterpreting their bits, unless the destination clamps.
+    bool conversionIsBitwiseCopy = elementSize == otherElementSize
+        && std::is_integral<typename Adaptor::Type>::value
+        && std::is_integral<typename OtherAdaptor::Type>::value
+        && Adaptor::typeValue != TypeUint8Clamped;
+
+    // The loops below read and write through local pointers. Going through typedVector() for each
+    // element would reload the vector after every store, since a store of a byte-sized element may
+    // alias it, and that keeps the compiler from vectorizing the conversion.
+    typename Adaptor::Type* destination = typedVector() + offset;
+    typename OtherAdaptor::Type* source = other->typedVector();
+
+    // Handle case (1).
     if (!hasArrayBuffer() || !other->hasArrayBuffer()
-        || existingBuffer() != other->existingBuffer()
-        || (elementSize == otherElementSize && vector() > other->vector())) {
-        for (unsigned i = length; i--;) {
-            setIndexQuicklyToNativeValue(
-                offset + i, OtherAdaptor::template convertTo<Adaptor>(
-                    other->getIndexQuicklyAsNativeValue(i)));
+        || existingBuffer() != other->existingBuffer()) {
+        if (conversionIsBitwiseCopy) {
+            memcpy(destination, source, length * elementSize);
+            return true;
         }
+        for (unsigned i = 0; i < length; ++i)
+            destination[i] = OtherAdaptor::template convertTo<Adaptor>(source[i]);
+        return true;
+    }
+
+    if (conversionIsBitwiseCopy) {
+        memmove(destination, source, length * elementSize);
+        return true;
+    }
+
+    // Handle case (2B).
+    if (elementSize == otherElementSize && vector() > other->vector()) {
+        for (unsigned i = length; i--;)
+            destination[i] = OtherAdaptor::template convertTo<Adaptor>(source[i]);
         return true;
     }
     
     // Now we either have (2A) or (3) - so first we try to cover (2A).
     if (elementSize == otherElementSize) {
-        for (unsigned i = 0; i < length; ++i) {
-            setIndexQuicklyToNativeValue(
-                offset + i, OtherAdaptor::template convertTo<Adaptor>(
-                    other->getIndexQuicklyAsNativeValue(i)));
-        }
+        for (unsigned i = 0; i < length; ++i)
+            destination[i] = OtherAdaptor::template convertTo<Adaptor>(source[i]);
         return true;
     }
     
     // Fail: we need an intermediate transfer buffer (i.e. case (3)).
     Vector<typename Adaptor::Type, 32> transferBuffer(length);
-    for (unsigned i = length; i--;) {
-        transferBuffer[i] = OtherAdaptor::template convertTo<Adaptor>(
-            other->getIndexQuicklyAsNativeValue(i));
-    }
-    for (unsigned i = length; i--;)
-        setIndexQuicklyToNativeValue(offset + i, transferBuffer[i]);
+    for (unsigned i = 0; i < length; ++i)
+        transferBuffer[i] = OtherAdaptor::template convertTo<Adaptor>(source[i]);
+    memcpy(destination, transferBuffer.data(), length * elementSize);
     
     return true;
 }
@@ -233,7 +251,7 @@ bool JSGenericTypedArrayView<Adaptor>::set(
         if (!validateRange(exec, offset, length))
             return false;
         
-        memmove(typedVector() + offset, other->typedVector(), other->byteLength());
+        memmove(typedVector() + offset, other->typedVector(), length * elementSize);
         return true;
     }
     
@@ -170,6 +170,19 @@ EncodedJSValue JSC_HOST_CALL genericTypedArrayViewProtoFuncIndexOf(ExecState* ex
     if (exec->hadException())
         return JSValue::encode(jsUndefined());
 
+    if (index >= length)
+        return JSValue::encode(jsNumber(-1));
+
+    // The C library's memchr is much faster than a loop for bytes.
+    if (ViewClass::elementSize == 1) {
+        uint8_t byte;
+        memcpy(&byte, &target, 1);
+        const void* result = memchr(array + index, byte, length - index);
+        if (!result)
+            return JSValue::encode(jsNumber(-1));
+        return JSValue::encode(jsNumber(static_cast<const typename ViewClass::ElementType*>(result) - array));
+    }
+
     for (; index < length; ++index) {
         if (array[index] == target)
             return JSValue::encode(jsNumber(index));
@@ -39,10 +39,12 @@ namespace JSC {
 
 class JSJobMicrotask final : public Microtask {
 public:
-    JSJobMicrotask(VM& vm, JSValue job, JSArray* arguments)
+    JSJobMicrotask(VM& vm, JSValue job, const ArgList& arguments)
+        : m_job(vm, job)
     {
-        m_job.set(vm, job);
-        m_arguments.set(vm, arguments);
+        m_arguments.reserveInitialCapacity(arguments.size());
+        for (unsigned index = 0; index < arguments.size(); ++index)
+            m_arguments.uncheckedAppend(Strong<Unknown>(vm, arguments.at(index)));
     }
 
     virtual ~JSJobMicrotask()
@@ -53,10 +55,10 @@ private:
     virtual void run(ExecState*) override;
 
     Strong<Unknown> m_job;
-    Strong<JSArray> m_arguments;
+    Vector<Strong<Unknown>, 3> m_arguments;
 };
 
-Ref<Microtask> createJSJob(VM& vm, JSValue job, JSArray* arguments)
+Ref<Microtask> createJSJob(VM& vm, JSValue job, const ArgList& arguments)
 {
     return adoptRef(*new JSJobMicrotask(vm, job, arguments));
 }
@@ -68,8 +70,8 @@ void JSJobMicrotask::run(ExecState* exec)
     ASSERT(handlerCallType != CallTypeNone);
 
     MarkedArgumentBuffer handlerArguments;
-    for (unsigned index = 0, length = m_arguments->length(); index < length; ++index)
-        handlerArguments.append(m_arguments->JSArray::get(exec, index));
+    for (auto& argument : m_arguments)
+        handlerArguments.append(argument.get());
     call(exec, m_job.get(), handlerCallType, handlerCallData, jsUndefined(), handlerArguments);
 }
 
@@ -38,8 +38,9 @@
 #include "ObjectConstructor.h"
 #include "JSCInlines.h"
 #include "PropertyNameArray.h"
+#include <wtf/MallocPtr.h>
 #include <wtf/MathExtras.h>
-#include <wtf/text/StringBuilder.h>
+#include <wtf/dtoa.h>
 
 namespace JSC {
 
@@ -81,11 +82,101 @@ private:
     mutable JSValue m_value;
 };
 
+// Collects the output of a Stringifier in a list of segments that are never reallocated, so the
+// output is only copied once, into a string of exactly the right size, or not at all when it is
+// streamed to a JSONStringifySink. Segments start out 8-bit and a 16-bit one is only started for
+// 16-bit input, so the final string is 8-bit whenever every input was.
+class SegmentedJSONBuilder {
+    WTF_MAKE_NONCOPYABLE(SegmentedJSONBuilder);
+public:
+    explicit SegmentedJSONBuilder(JSONStringifySink* sink = nullptr)
+        : m_sink(sink)
+    {
+    }
+
+    unsigned length() const { return m_flushedLength + m_bufferedLength; }
+    UChar lastCharacter() const;
+
+    void append(char character)
+    {
+        LChar latin1Character = character;
+        appendCharacters(&latin1Character, 1);
+    }
+
+    void append(const String& string)
+    {
+        if (string.is8Bit())
+            appendCharacters(string.characters8(), string.length());
+        else
+            appendCharacters(string.characters16(), string.length());
+    }
+
+    template<unsigned characterCount>
+    void appendLiteral(const char (&characters)[characterCount])
+    {
+        appendCharacters(reinterpret_cast<const LChar*>(characters), characterCount - 1);
+    }
+
+    void appendQuotedJSONString(const String&);
+    void appendNumber(int32_t);
+    void appendECMAScriptNumber(double);
+
+    // Only the characters appended since the last flush can be removed.
+    void resize(unsigned newLength);
+
+    // Hands every full segment to the sink. This must only be called when no caller can still want
+    // to roll back to an earlier length.
+    void flushFullSegments();
+    void flushAll();
+    bool sinkFailed() const { return m_sinkFailed; }
+
+    String toString() const;
+
+private:
+    struct Segment {
+        Segment(unsigned capacity, bool is8Bit)
+            : capacity(capacity)
+            , is8Bit(is8Bit)
+        {
+            if (is8Bit)
+                characters8 = MallocPtr<LChar>::malloc(capacity * sizeof(LChar));
+            else
+                characters16 = MallocPtr<UChar>::malloc(capacity * sizeof(UChar));
+        }
+
+        unsigned available() const { return capacity - length; }
+
+        MallocPtr<LChar> characters8;
+        MallocPtr<UChar> characters16;
+        unsigned length { 0 };
+        unsigned capacity;
+        bool is8Bit;
+    };
+
+    static const unsigned initialSegmentCapacity = 64;
+    static const unsigned maximumSegmentCapacity = 64 * KB;
+
+    Segment& segmentWithRoom(unsigned minimumAvailable, bool needs16Bit);
+    void appendCharacters(const LChar*, unsigned length);
+    void appendCharacters(const UChar*, unsigned length);
+    template<typename CharacterType> void appendEscapedCharacters(const CharacterType*, unsigned length);
+    void flushSegments(size_t count);
+
+    Vector<Segment, 4> m_segments;
+    JSONStringifySink* m_sink;
+    unsigned m_flushedLength { 0 };
+    unsigned m_bufferedLength { 0 };
+    unsigned m_nextSegmentCapacity { initialSegmentCapacity };
+    UChar m_lastFlushedCharacter { 0 };
+    bool m_sinkFailed { false };
+};
+
 class Stringifier {
     WTF_MAKE_NONCOPYABLE(Stringifier);
 public:
     Stringifier(ExecState*, const Local<Unknown>& replacer, const Local<Unknown>& space);
     Local<Unknown> stringify(Handle<Unknown>);
+    bool stringify(Handle<Unknown>, JSONStringifySink&);
 
     void visitAggregate(SlotVisitor&);
 
@@ -96,7 +187,7 @@ private:
 
         JSObject* object() const { return m_object.get(); }
 
-        bool appendNextProperty(Stringifier&, StringBuilder&);
+        bool appendNextProperty(Stringifier&, SegmentedJSONBuilder&);
 
     private:
         Local<JSObject> m_object;
@@ -113,12 +204,13 @@ private:
     JSValue toJSONImpl(JSValue, const PropertyNameForFunctionCall&);
 
     enum StringifyResult { StringifyFailed, StringifySucceeded, StringifyFailedDueToUndefinedOrSymbolValue };
-    StringifyResult appendStringifiedValue(StringBuilder&, JSValue, JSObject* holder, const PropertyNameForFunctionCall&);
+    StringifyResult appendTopLevelValue(SegmentedJSONBuilder&, Handle<Unknown>);
+    StringifyResult appendStringifiedValue(SegmentedJSONBuilder&, JSValue, JSObject* holder, const PropertyNameForFunctionCall&);
 
     bool willIndent() const;
     void indent();
     void unindent();
-    void startNewLine(StringBuilder&) const;
+    void startNewLine(SegmentedJSONBuilder&) const;
 
     ExecState* const m_exec;
     const Local<Unknown> m_replacer;
@@ -167,7 +259,7 @@ static inline String gap(ExecState* exec, JSValue space)
             count = 0;
         else
             count = static_cast<int>(spaceCount);
-        UChar spaces[maxGapLength];
+        LChar spaces[maxGapLength];
         for (int i = 0; i < count; ++i)
             spaces[i] = ' ';
         return String(spaces, count);
@@ -205,6 +297,253 @@ JSValue PropertyNameForFunctionCall::value(ExecState* exec) const
     return m_value;
 }
 
+// ------------------------------ SegmentedJSONBuilder --------------------------------
+
+UChar SegmentedJSONBuilder::lastCharacter() const
+{
+    for (size_t i = m_segments.size(); i--;) {
+        const Segment& segment = m_segments[i];
+        if (!segment.length)
+            continue;
+        if (segment.is8Bit)
+            return segment.characters8.get()[segment.length - 1];
+        return segment.characters16.get()[segment.length - 1];
+    }
+    return m_lastFlushedCharacter;
+}
+
+auto SegmentedJSONBuilder::segmentWithRoom(unsigned minimumAvailable, bool needs16Bit) -> Segment&
+{
+    if (!m_segments.isEmpty()) {
+        Segment& segment = m_segments.last();
+        if (segment.available() >= minimumAvailable && (!needs16Bit || !segment.is8Bit))
+            return segment;
+    }
+
+    unsigned capacity = std::max(minimumAvailable, m_nextSegmentCapacity);
+    RELEASE_ASSERT(length() <= static_cast<unsigned>(std::numeric_limits<int32_t>::max()) - capacity);
+    m_nextSegmentCapacity = std::min(m_nextSegmentCapacity * 2, maximumSegmentCapacity);
+    m_segments.append(Segment(capacity, !needs16Bit));
+    return m_segments.last();
+}
+
+void SegmentedJSONBuilder::appendCharacters(const LChar* characters, unsigned length)
+{
+    while (length) {
+        Segment& segment = segmentWithRoom(1, false);
+        unsigned count = std::min(length, segment.available());
+        if (segment.is8Bit)
+            StringImpl::copyChars(segment.characters8.get() + segment.length, characters, count);
+        else
+            StringImpl::copyChars(segment.characters16.get() + segment.length, characters, count);
+        segment.length += count;
+        m_bufferedLength += count;
+        characters += count;
+        length -= count;
+    }
+}
+
+void SegmentedJSONBuilder::appendCharacters(const UChar* characters, unsigned length)
+{
+    while (length) {
+        Segment& segment = segmentWithRoom(1, true);
+        unsigned count = std::min(length, segment.available());
+        StringImpl::copyChars(segment.characters16.get() + segment.length, characters, count);
+        segment.length += count;
+        m_bufferedLength += count;
+        characters += count;
+        length -= count;
+    }
+}
+
+template<typename OutputCharacterType, typename InputCharacterType>
+static OutputCharacterType* escapeJSONCharacters(OutputCharacterType* output, const InputCharacterType* input, unsigned length)
+{
+    for (const InputCharacterType* end = input + length; input != end; ++input) {
+        if (LIKELY(*input > 0x1F)) {
+            if (*input == '"' || *input == '\\')
+                *output++ = '\\';
+            *output++ = *input;
+            continue;
+        }
+        switch (*input) {
+        case '\t':
+            *output++ = '\\';
+            *output++ = 't';
+            break;
+        case '\r':
+            *output++ = '\\';
+            *output++ = 'r';
+            break;
+        case '\n':
+            *output++ = '\\';
+            *output++ = 'n';
+            break;
+        case '\f':
+            *output++ = '\\';
+            *output++ = 'f';
+            break;
+        case '\b':
+            *output++ = '\\';
+            *output++ = 'b';
+            break;
+        default:
+            static const char hexDigits[] = "0123456789abcdef";
+            *output++ = '\\';
+            *output++ = 'u';
+            *output++ = '0';
+            *output++ = '0';
+            *output++ = static_cast<LChar>(hexDigits[(*input >> 4) & 0xF]);
+            *output++ = static_cast<LChar>(hexDigits[*input & 0xF]);
+            break;
+        }
+    }
+    return output;
+}
+
+template<typename CharacterType>
+void SegmentedJSONBuilder::appendEscapedCharacters(const CharacterType* characters, unsigned length)
+{
+    // Each input character takes at most 6 output characters, for "\u00XX". Escape in pieces that
+    // are guaranteed to fit in the current segment, and start a new one once less than a useful
+    // piece fits, rather than reserving 6 times the input up front.
+    const unsigned maximumEscapedLength = 6;
+    const unsigned minimumPieceLength = 16;
+    while (length) {
+        Segment& segment = segmentWithRoom(std::min(length, minimumPieceLength) * maximumEscapedLength, sizeof(CharacterType) == sizeof(UChar));
+        unsigned count = std::min(length, segment.available() / maximumEscapedLength);
+        unsigned written;
+        if (segment.is8Bit) {
+            LChar* start = segment.characters8.get() + segment.length;
+            written = escapeJSONCharacters(start, characters, count) - start;
+        } else {
+            UChar* start = segment.characters16.get() + segment.length;
+            written = escapeJSONCharacters(start, characters, count) - start;
+        }
+        segment.length += written;
+        m_bufferedLength += written;
+        characters += count;
+        length -= count;
+    }
+}
+
+void SegmentedJSONBuilder::appendQuotedJSONString(const String& string)
+{
+    append('"');
+    if (string.is8Bit())
+        appendEscapedCharacters(string.characters8(), string.length());
+    else
+        appendEscapedCharacters(string.characters16(), string.length());
+    append('"');
+}
+
+void SegmentedJSONBuilder::appendNumber(int32_t number)
+{
+    LChar buffer[sizeof(int32_t) * 3 + 1];
+    LChar* end = buffer + WTF_ARRAY_LENGTH(buffer);
+    LChar* start = end;
+    uint32_t magnitude = number < 0 ? -static_cast<uint32_t>(number) : number;
+    do {
+        *--start = static_cast<LChar>((magnitude % 10) + '0');
+        magnitude /= 10;
+    } while (magnitude);
+    if (number < 0)
+        *--start = '-';
+    appendCharacters(start, end - start);
+}
+
+void SegmentedJSONBuilder::appendECMAScriptNumber(double number)
+{
+    NumberToStringBuffer buffer;
+    const char* characters = numberToString(number, buffer);
+    appendCharacters(reinterpret_cast<const LChar*>(characters), strlen(characters));
+}
+
+void SegmentedJSONBuilder::resize(unsigned newLength)
+{
+    RELEASE_ASSERT(newLength >= m_flushedLength && newLength <= length());
+    unsigned excess = length() - newLength;
+    while (excess) {
+        Segment& segment = m_segments.last();
+        if (segment.length > excess) {
+            segment.length -= excess;
+            m_bufferedLength -= excess;
+            return;
+        }
+        excess -= segment.length;
+        m_bufferedLength -= segment.length;
+        m_segments.removeLast();
+    }
+}
+
+void SegmentedJSONBuilder::flushSegments(size_t count)
+{
+    ASSERT(m_sink);
+    for (size_t i = 0; i < count; ++i) {
+        Segment& segment = m_segments[i];
+        if (!segment.length)
+            continue;
+        if (!m_sinkFailed) {
+            if (segment.is8Bit)
+                m_sinkFailed = !m_sink->append(segment.characters8.get(), segment.length);
+            else
+                m_sinkFailed = !m_sink->append(segment.characters16.get(), segment.length);
+        }
+        m_lastFlushedCharacter = segment.is8Bit ? segment.characters8.get()[segment.length - 1] : segment.characters16.get()[segment.length - 1];
+        m_flushedLength += segment.length;
+        m_bufferedLength -= segment.length;
+    }
+    m_segments.remove(0, count);
+}
+
+void SegmentedJSONBuilder::flushFullSegments()
+{
+    if (!m_sink || m_segments.isEmpty())
+        return;
+    size_t count = m_segments.size() - 1;
+    if (!m_segments.last().available())
+        ++count;
+    flushSegments(count);
+}
+
+void SegmentedJSONBuilder::flushAll()
+{
+    if (m_sink)
+        flushSegments(m_segments.size());
+}
+
+String SegmentedJSONBuilder::toString() const
+{
+    ASSERT(!m_flushedLength);
+    if (!m_bufferedLength)
+        return emptyString();
+
+    bool is8Bit = true;
+    for (const Segment& segment : m_segments)
+        is8Bit &= segment.is8Bit;
+
+    if (is8Bit) {
+        LChar* characters;
+        RefPtr<StringImpl> result = StringImpl::createUninitialized(m_bufferedLength, characters);
+        for (const Segment& segment : m_segments) {
+            StringImpl::copyChars(characters, segment.characters8.get(), segment.length);
+            characters += segment.length;
+        }
+        return result.release();
+    }
+
+    UChar* characters;
+    RefPtr<StringImpl> result = StringImpl::createUninitialized(m_bufferedLength, characters);
+    for (const Segment& segment : m_segments) {
+        if (segment.is8Bit)
+            StringImpl::copyChars(characters, segment.characters8.get(), segment.length);
+        else
+            StringImpl::copyChars(characters, segment.characters16.get(), segment.length);
+        characters += segment.length;
+    }
+    return result.release();
+}
+
 // ------------------------------ Stringifier --------------------------------
 
 Stringifier::Stringifier(ExecState* exec, const Local<Unknown>& replacer, const Local<Unknown>& space)
@@ -241,22 +580,44 @@ Stringifier::Stringifier(ExecState* exec, const Local<Unknown>& replacer, const
     m_replacerCallType = m_replacer.asObject()->methodTable()->getCallData(m_replacer.asObject().get(), m_replacerCallData);
 }
 
-Local<Unknown> Stringifier::stringify(Handle<Unknown> value)
+Stringifier::StringifyResult Stringifier::appendTopLevelValue(SegmentedJSONBuilder& builder, Handle<Unknown> value)
 {
     JSObject* object = constructEmptyObject(m_exec);
     if (m_exec->hadException())
-        return Local<Unknown>(m_exec->vm(), jsNull());
+        return StringifyFailed;
 
     PropertyNameForFunctionCall emptyPropertyName(m_exec->vm().propertyNames->emptyIdentifier);
     object->putDirect(m_exec->vm(), m_exec->vm().propertyNames->emptyIdentifier, value.get());
 
-    StringBuilder result;
-    if (appendStringifiedValue(result, value.get(), object, emptyPropertyName) != StringifySucceeded)
+    StringifyResult result = appendStringifiedValue(builder, value.get(), object, emptyPropertyName);
+    if (result == StringifySucceeded && m_exec->hadException())
+        return StringifyFailed;
+    return result;
+}
+
+Local<Unknown> Stringifier::stringify(Handle<Unknown> value)
+{
+    SegmentedJSONBuilder result;
+    switch (appendTopLevelValue(result, value)) {
+    case StringifySucceeded:
+        return Local<Unknown>(m_exec->vm(), jsString(m_exec, result.toString()));
+    case StringifyFailedDueToUndefinedOrSymbolValue:
         return Local<Unknown>(m_exec->vm(), jsUndefined());
+    case StringifyFailed:
+        break;
+    }
     if (m_exec->hadException())
         return Local<Unknown>(m_exec->vm(), jsNull());
+    return Local<Unknown>(m_exec->vm(), jsUndefined());
+}
 
-    return Local<Unknown>(m_exec->vm(), jsString(m_exec, result.toString()));
+bool Stringifier::stringify(Handle<Unknown> value, JSONStringifySink& sink)
+{
+    SegmentedJSONBuilder result(&sink);
+    if (appendTopLevelValue(result, value) != StringifySucceeded)
+        return false;
+    result.flushAll();
+    return !result.sinkFailed();
 }
 
 ALWAYS_INLINE JSValue Stringifier::toJSON(JSValue value, const PropertyNameForFunctionCall& propertyName)
@@ -287,7 +648,7 @@ JSValue Stringifier::toJSONImpl(JSValue value, const PropertyNameForFunctionCall
     return call(m_exec, object, callType, callData, value, args);
 }
 
-Stringifier::StringifyResult Stringifier::appendStringifiedValue(StringBuilder& builder, JSValue value, JSObject* holder, const PropertyNameForFunctionCall& propertyName)
+Stringifier::StringifyResult Stringifier::appendStringifiedValue(SegmentedJSONBuilder& builder, JSValue value, JSObject* holder, const PropertyNameForFunctionCall& propertyName)
 {
     // Call the toJSON function.
     value = toJSON(value, propertyName);
@@ -373,6 +734,10 @@ Stringifier::StringifyResult Stringifier::appendStringifiedValue(StringBuilder&
         while (m_holderStack.last().appendNextProperty(*this, builder)) {
             if (m_exec->hadException())
                 return StringifyFailed;
+            // Between properties nothing is left to roll back, so this is where output is streamed.
+            builder.flushFullSegments();
+            if (builder.sinkFailed())
+                return StringifyFailed;
         }
         m_holderStack.removeLast();
     } while (!m_holderStack.isEmpty());
@@ -400,7 +765,7 @@ inline void Stringifier::unindent()
     m_indent = m_repeatedGap.substringSharingImpl(0, m_indent.length() - m_gap.length());
 }
 
-inline void Stringifier::startNewLine(StringBuilder& builder) const
+inline void Stringifier::startNewLine(SegmentedJSONBuilder& builder) const
 {
     if (m_gap.isEmpty())
         return;
@@ -418,7 +783,7 @@ inline Stringifier::Holder::Holder(VM& vm, JSObject* object)
 {
 }
 
-bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBuilder& builder)
+bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, SegmentedJSONBuilder& builder)
 {
     ASSERT(m_index <= m_size);
 
@@ -450,7 +815,7 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBui
     // Last time through, finish up and return false.
     if (m_index == m_size) {
         stringifier.unindent();
-        if (m_size && builder[builder.length() - 1] != '{')
+        if (m_size && builder.lastCharacter() != '{')
             stringifier.startNewLine(builder);
         builder.append(m_isArray ? ']' : '}');
         return false;
@@ -495,7 +860,7 @@ bool Stringifier::Holder::appendNextProperty(Stringifier& stringifier, StringBui
         rollBackPoint = builder.length();
 
         // Append the separator string.
-        if (builder[rollBackPoint - 1] != '{')
+        if (builder.lastCharacter() != '{')
             builder.append(',');
         stringifier.startNewLine(builder);
 
@@ -793,4 +1158,10 @@ String JSONStringify(ExecState* exec, JSValue value, unsigned indent)
     return result.getString(exec);
 }
 
+bool JSONStringify(ExecState* exec, JSValue value, unsigned indent, JSONStringifySink& sink)
+{
+    LocalScope scope(exec->vm());
+    return Stringifier(exec, Local<Unknown>(exec->vm(), jsNull()), Local<Unknown>(exec->vm(), jsNumber(indent))).stringify(Local<Unknown>(exec->vm(), value), sink);
+}
+
 } // namespace JSC
@@ -57,8 +57,21 @@ private:
     static bool getOwnPropertySlot(JSObject*, ExecState*, PropertyName, PropertySlot&);
 };
 
+// Receives the output of a streaming JSONStringify in order, one piece at a time. Returning false
+// stops stringification.
+class JSONStringifySink {
+public:
+    virtual ~JSONStringifySink() { }
+    virtual bool append(const LChar*, unsigned length) = 0;
+    virtual bool append(const UChar*, unsigned length) = 0;
+};
+
 JS_EXPORT_PRIVATE JSValue JSONParse(ExecState*, const String&);
 JS_EXPORT_PRIVATE String JSONStringify(ExecState*, JSValue, unsigned indent);
+// Streams the JSON text to the sink instead of building a string, so it is never held in full.
+// Returns false if the value could not be stringified, an exception was thrown or the sink gave up;
+// the sink may have received part of the output by then.
+JS_EXPORT_PRIVATE bool JSONStringify(ExecState*, JSValue, unsigned indent, JSONStringifySink&);
 
     
 } // namespace JSC
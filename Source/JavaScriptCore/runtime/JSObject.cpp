@@ -2482,6 +2482,19 @@ void JSObject::ensureLengthSlow(VM& vm, unsigned length)
         length << 1,
         MAX_STORAGE_VECTOR_LENGTH);
     unsigned oldVectorLength = butterfly->vectorLength();
+
+    // If the butterfly was the last thing allocated in the current copied block, growing it in place
+    // is just a bump of the allocator. When doubling would not fit there but growing by half would,
+    // settle for the smaller in-place growth rather than copying the butterfly into a new block.
+    size_t propertyCapacity = structure()->outOfLineCapacity();
+    size_t oldSize = Butterfly::totalSize(0, propertyCapacity, true, oldVectorLength * sizeof(EncodedJSValue));
+    size_t bytesAvailableInPlace = vm.heap.storageSpace().bytesAvailableForInPlaceGrowth(butterfly->base(0, propertyCapacity), oldSize);
+    if (bytesAvailableInPlace) {
+        unsigned inPlaceVectorLength = oldVectorLength + std::min<size_t>(bytesAvailableInPlace / sizeof(EncodedJSValue), MAX_STORAGE_VECTOR_LENGTH - oldVectorLength);
+        if (inPlaceVectorLength < newVectorLength && inPlaceVectorLength >= std::max(length, timesThreePlusOneDividedByTwo(oldVectorLength)))
+            newVectorLength = inPlaceVectorLength;
+    }
+
     DeferGC deferGC(vm.heap);
     butterfly = butterfly->growArrayRight(
         vm, this, structure(), structure()->outOfLineCapacity(), true,
@@ -1106,7 +1106,8 @@ ALWAYS_INLINE void JSObject::fillCustomGetterPropertySlot(PropertySlot& slot, JS
         slot.setCustom(this, attributes, jsCast<CustomGetterSetter*>(customGetterSetter)->getter());
         return;
     }
-    slot.setCacheableCustom(this, attributes, jsCast<CustomGetterSetter*>(customGetterSetter)->getter());
+    CustomGetterSetter* cell = jsCast<CustomGetterSetter*>(customGetterSetter);
+    slot.setCacheableCustom(this, attributes, cell->getter(), cell->getterIntrinsic());
 }
 
 // It may seem crazy to inline a function this large, especially a virtual function,
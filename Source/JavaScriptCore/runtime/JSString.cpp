@@ -237,7 +237,9 @@ void JSRopeString::resolveRope(ExecState* exec) const
     
     if (isSubstring()) {
         ASSERT(!substringBase()->isRope());
-        m_value = substringBase()->m_value.substring(substringOffset(), m_length);
+        // Share the base's characters instead of copying them, so that repeatedly slicing and
+        // flattening the rest of a large string does not copy the rest every time.
+        m_value = substringBase()->m_value.substringSharingImpl(substringOffset(), m_length);
         substringBase().clear();
         return;
     }
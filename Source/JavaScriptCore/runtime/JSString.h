@@ -172,6 +172,7 @@ public:
 
     bool canGetIndex(unsigned i) { return i < m_length; }
     JSString* getIndex(ExecState*, unsigned);
+    UChar characterAt(ExecState*, unsigned) const;
 
     static Structure* createStructure(VM&, JSGlobalObject*, JSValue);
 
@@ -369,6 +370,11 @@ public:
 
     static const unsigned s_maxInternalRopeLength = 3;
 
+    // Reading a character near the top of a rope is cheaper than resolving the whole rope, which
+    // matters when a string is read from while it is still being appended to.
+    static const unsigned s_maxDepthToReadWithoutResolving = 8;
+    bool tryGetCharacterWithoutResolving(unsigned index, UChar&) const;
+
 private:
     friend JSValue jsStringFromRegisterArray(ExecState*, Register*, unsigned);
     friend JSValue jsStringFromArguments(ExecState*, JSValue);
@@ -522,7 +528,7 @@ inline const String& JSString::tryGetValue() const
 inline JSString* JSString::getIndex(ExecState* exec, unsigned i)
 {
     ASSERT(canGetIndex(i));
-    return jsSingleCharacterString(exec, unsafeView(*exec)[i]);
+    return jsSingleCharacterString(exec, characterAt(exec, i));
 }
 
 inline JSString* jsString(VM* vm, const String& s)
@@ -707,6 +713,41 @@ inline bool JSString::isSubstring() const
     return isRope() && static_cast<const JSRopeString*>(this)->isSubstring();
 }
 
+inline bool JSRopeString::tryGetCharacterWithoutResolving(unsigned index, UChar& result) const
+{
+    ASSERT(index < m_length);
+    const JSString* current = this;
+    for (unsigned depth = 0; depth < s_maxDepthToReadWithoutResolving; ++depth) {
+        if (!current->isRope()) {
+            result = current->m_value[index];
+            return true;
+        }
+        const JSRopeString* rope = static_cast<const JSRopeString*>(current);
+        if (rope->isSubstring()) {
+            result = rope->substringBase()->m_value[rope->substringOffset() + index];
+            return true;
+        }
+        for (unsigned i = 0; i < s_maxInternalRopeLength; ++i) {
+            JSString* fiber = rope->fiber(i).get();
+            if (index < fiber->length()) {
+                current = fiber;
+                break;
+            }
+            index -= fiber->length();
+        }
+    }
+    return false;
+}
+
+inline UChar JSString::characterAt(ExecState* exec, unsigned i) const
+{
+    ASSERT(i < m_length);
+    UChar result;
+    if (isRope() && static_cast<const JSRopeString*>(this)->tryGetCharacterWithoutResolving(i, result))
+        return result;
+    return unsafeView(*exec)[i];
+}
+
 inline JSString::SafeView::SafeView()
 {
 }
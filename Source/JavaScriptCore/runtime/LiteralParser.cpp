@@ -40,6 +40,12 @@
 #include <wtf/dtoa.h>
 #include <wtf/text/StringBuilder.h>
 
+#if COMPILER(GCC_OR_CLANG) && (CPU(X86) || CPU(X86_64)) && defined(__SSE2__)
+#include <emmintrin.h>
+#elif COMPILER(GCC_OR_CLANG) && CPU(ARM64)
+#include <arm_neon.h>
+#endif
+
 namespace JSC {
 
 template <typename CharType>
@@ -346,6 +352,73 @@ template <ParserMode mode, typename CharType, UChar terminator> static inline bo
     return (c >= ' ' && (mode == StrictJSON || c <= 0xff) && c != '\\' && c != terminator) || (c == '\t' && mode != StrictJSON);
 }
 
+// These skip the run of characters at the start of [ptr, end) that a strict JSON string can contain
+// verbatim, a vector at a time. They stop at or before the first '"', '\\' or control character,
+// and before the last partial vector; lexString's scalar loop picks up from wherever they stop.
+static ALWAYS_INLINE const LChar* skipStrictJSONStringCharacters(const LChar* ptr, const LChar* end)
+{
+#if COMPILER(GCC_OR_CLANG) && (CPU(X86) || CPU(X86_64)) && defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i lastControlCharacter = _mm_set1_epi8(0x1f);
+    while (end - ptr >= 16) {
+        __m128i characters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+        __m128i isControlCharacter = _mm_cmpeq_epi8(_mm_min_epu8(characters, lastControlCharacter), characters);
+        __m128i isSpecial = _mm_or_si128(_mm_cmpeq_epi8(characters, quote), _mm_cmpeq_epi8(characters, backslash));
+        if (int mask = _mm_movemask_epi8(_mm_or_si128(isControlCharacter, isSpecial)))
+            return ptr + __builtin_ctz(mask);
+        ptr += 16;
+    }
+#elif COMPILER(GCC_OR_CLANG) && CPU(ARM64)
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t space = vdupq_n_u8(' ');
+    while (end - ptr >= 16) {
+        uint8x16_t characters = vld1q_u8(ptr);
+        uint8x16_t isSpecial = vorrq_u8(vceqq_u8(characters, quote), vceqq_u8(characters, backslash));
+        if (vmaxvq_u8(vorrq_u8(vcltq_u8(characters, space), isSpecial)))
+            return ptr;
+        ptr += 16;
+    }
+#else
+    UNUSED_PARAM(end);
+#endif
+    return ptr;
+}
+
+static ALWAYS_INLINE const UChar* skipStrictJSONStringCharacters(const UChar* ptr, const UChar* end)
+{
+#if COMPILER(GCC_OR_CLANG) && (CPU(X86) || CPU(X86_64)) && defined(__SSE2__)
+    // SSE2 only has signed 16-bit compares, so flip the sign bit to compare against ' ' unsigned.
+    const __m128i signBit = _mm_set1_epi16(static_cast<short>(0x8000));
+    const __m128i space = _mm_set1_epi16(static_cast<short>(' ' ^ 0x8000));
+    const __m128i quote = _mm_set1_epi16('"');
+    const __m128i backslash = _mm_set1_epi16('\\');
+    while (end - ptr >= 8) {
+        __m128i characters = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+        __m128i isControlCharacter = _mm_cmplt_epi16(_mm_xor_si128(characters, signBit), space);
+        __m128i isSpecial = _mm_or_si128(_mm_cmpeq_epi16(characters, quote), _mm_cmpeq_epi16(characters, backslash));
+        if (int mask = _mm_movemask_epi8(_mm_or_si128(isControlCharacter, isSpecial)))
+            return ptr + __builtin_ctz(mask) / sizeof(UChar);
+        ptr += 8;
+    }
+#elif COMPILER(GCC_OR_CLANG) && CPU(ARM64)
+    const uint16x8_t quote = vdupq_n_u16('"');
+    const uint16x8_t backslash = vdupq_n_u16('\\');
+    const uint16x8_t space = vdupq_n_u16(' ');
+    while (end - ptr >= 8) {
+        uint16x8_t characters = vld1q_u16(reinterpret_cast<const uint16_t*>(ptr));
+        uint16x8_t isSpecial = vorrq_u16(vceqq_u16(characters, quote), vceqq_u16(characters, backslash));
+        if (vmaxvq_u16(vorrq_u16(vcltq_u16(characters, space), isSpecial)))
+            return ptr;
+        ptr += 8;
+    }
+#else
+    UNUSED_PARAM(end);
+#endif
+    return ptr;
+}
+
 template <typename CharType>
 template <ParserMode mode, char terminator> ALWAYS_INLINE TokenType LiteralParser<CharType>::Lexer::lexString(LiteralParserToken<CharType>& token)
 {
@@ -354,6 +427,8 @@ template <ParserMode mode, char terminator> ALWAYS_INLINE TokenType LiteralParse
     StringBuilder builder;
     do {
         runStart = m_ptr;
+        if (mode == StrictJSON && terminator == '"')
+            m_ptr = skipStrictJSONStringCharacters(m_ptr, m_end);
         while (m_ptr < m_end && isSafeStringCharacter<mode, CharType, terminator>(*m_ptr))
             ++m_ptr;
         if (builder.length())
@@ -550,6 +625,16 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
     Vector<ParserState, 16, UnsafeVectorOverflow> stateStack;
     Vector<Identifier, 16, UnsafeVectorOverflow> identifierStack;
     HashSet<JSObject*> visitedUnderscoreProto;
+    // The number of properties in the last object finished at each depth of objectStack. Payloads are
+    // usually arrays of records with the same keys, so an object that is too big for the default inline
+    // capacity is a good hint that its next sibling will be too.
+    Vector<unsigned, 16, UnsafeVectorOverflow> siblingObjectSizes;
+    auto recordSiblingObjectSize = [&] (JSObject* object) {
+        unsigned depth = objectStack.size() - 1;
+        if (depth >= siblingObjectSizes.size())
+            siblingObjectSizes.grow(depth + 1);
+        siblingObjectSizes[depth] = object->structure()->totalStorageSize();
+    };
     while (1) {
         switch(state) {
             startParseArray:
@@ -594,7 +679,11 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
             }
             startParseObject:
             case StartParseObject: {
-                JSObject* object = constructEmptyObject(m_exec);
+                unsigned depth = objectStack.size();
+                unsigned inlineCapacity = JSFinalObject::defaultInlineCapacity();
+                if (depth < siblingObjectSizes.size() && siblingObjectSizes[depth] > inlineCapacity)
+                    inlineCapacity = std::min(siblingObjectSizes[depth], JSFinalObject::maxInlineCapacity());
+                JSObject* object = constructEmptyObject(m_exec, m_exec->lexicalGlobalObject()->objectPrototype(), inlineCapacity);
                 objectStack.append(object);
 
                 TokenType type = m_lexer.next();
@@ -620,6 +709,7 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
                     return JSValue();
                 }
                 m_lexer.next();
+                recordSiblingObjectSize(object);
                 lastValue = objectStack.last();
                 objectStack.removeLast();
                 break;
@@ -673,6 +763,7 @@ JSValue LiteralParser<CharType>::parse(ParserState initialState)
                     return JSValue();
                 }
                 m_lexer.next();
+                recordSiblingObjectSize(object);
                 lastValue = objectStack.last();
                 objectStack.removeLast();
                 break;
@@ -69,6 +69,7 @@ struct HashTableValue {
     unsigned attributes() const { return m_attributes; }
 
     Intrinsic intrinsic() const { ASSERT(m_attributes & Function); return m_intrinsic; }
+    Intrinsic propertyGetterIntrinsic() const { ASSERT(!(m_attributes & BuiltinOrFunctionOrAccessorOrConstant)); return m_intrinsic; }
     BuiltinGenerator builtinGenerator() const { ASSERT(m_attributes & Builtin); return reinterpret_cast<BuiltinGenerator>(m_values.value1); }
     NativeFunction function() const { ASSERT(m_attributes & Function); return reinterpret_cast<NativeFunction>(m_values.value1); }
     unsigned char functionLength() const { ASSERT(m_attributes & Function); return static_cast<unsigned char>(m_values.value2); }
@@ -221,7 +222,7 @@ inline bool getStaticPropertySlot(ExecState* exec, const HashTable& table, ThisI
         return true;
     }
 
-    slot.setCacheableCustom(thisObj, attributesForStructure(entry->attributes()), entry->propertyGetter());
+    slot.setCacheableCustom(thisObj, attributesForStructure(entry->attributes()), entry->propertyGetter(), entry->propertyGetterIntrinsic());
     return true;
 }
 
@@ -262,7 +263,7 @@ inline bool getStaticValueSlot(ExecState* exec, const HashTable& table, ThisImp*
         return true;
     }
 
-    slot.setCacheableCustom(thisObj, attributesForStructure(entry->attributes()), entry->propertyGetter());
+    slot.setCacheableCustom(thisObj, attributesForStructure(entry->attributes()), entry->propertyGetter(), entry->propertyGetterIntrinsic());
     return true;
 }
 
@@ -332,7 +333,7 @@ inline void reifyStaticProperties(VM& vm, const HashTableValue (&values)[numberO
             continue;
         }
 
-        CustomGetterSetter* customGetterSetter = CustomGetterSetter::create(vm, value.propertyGetter(), value.propertyPutter());
+        CustomGetterSetter* customGetterSetter = CustomGetterSetter::create(vm, value.propertyGetter(), value.propertyPutter(), value.propertyGetterIntrinsic());
         thisObj.putDirectCustomAccessor(vm, propertyName, customGetterSetter, attributesForStructure(value.attributes()));
     }
 }
@@ -113,13 +113,26 @@ public:
 private:
     typedef WTF::UnsignedWithZeroKeyHashTraits<int32_t> IndexTraits;
 
-    typedef HashMap<JSCell*, int32_t, typename WTF::DefaultHash<JSCell*>::Hash, WTF::HashTraits<JSCell*>, IndexTraits> CellKeyedMap;
-    typedef HashMap<EncodedJSValue, int32_t, EncodedJSValueHash, EncodedJSValueHashTraits, IndexTraits> ValueKeyedMap;
     typedef HashMap<StringImpl*, int32_t, typename WTF::DefaultHash<StringImpl*>::Hash, WTF::HashTraits<StringImpl*>, IndexTraits> StringKeyedMap;
     typedef HashMap<SymbolImpl*, int32_t, typename WTF::PtrHash<SymbolImpl*>, WTF::HashTraits<SymbolImpl*>, IndexTraits> SymbolKeyedMap;
 
+    // Keys that are compared by identity (everything but strings and symbols) are found through an
+    // open-addressed table of indices into m_entries. The table is probed linearly and stores no
+    // keys of its own; a probe compares against the key in the insertion-ordered entry it points at.
+    enum : int32_t {
+        emptyIndex = -1,
+        deletedIndex = -2,
+        minimumIndexTableSize = 16
+    };
+
     size_t capacityInBytes() { return m_capacity * sizeof(Entry); }
 
+    static unsigned hashIdentityKey(JSValue key) { return WTF::intHash(static_cast<uint64_t>(JSValue::encode(key))); }
+    ALWAYS_INLINE int32_t* findIdentityKeySlot(Entry* entries, JSValue key);
+    void addIdentityKey(Entry* entries, JSValue key, int32_t index);
+    void rehashIndexTable(Entry* entries, unsigned newTableSize);
+    ALWAYS_INLINE Entry* addIdentityKeyed(ExecState*, JSCell* owner, KeyType);
+
     ALWAYS_INLINE Entry* find(ExecState*, KeyType);
     ALWAYS_INLINE Entry* add(ExecState*, JSCell* owner, KeyType);
     template <typename Map, typename Key> ALWAYS_INLINE Entry* add(ExecState*, JSCell* owner, Map&, Key, KeyType);
@@ -130,8 +143,9 @@ private:
     ALWAYS_INLINE void replaceAndPackBackingStore(Entry* destination, int32_t newSize);
     ALWAYS_INLINE void replaceBackingStore(Entry* destination, int32_t newSize);
 
-    CellKeyedMap m_cellKeyedTable;
-    ValueKeyedMap m_valueKeyedTable;
+    Vector<int32_t> m_indexTable;
+    int32_t m_indexTableKeyCount;
+    int32_t m_indexTableDeletedCount;
     StringKeyedMap m_stringKeyedTable;
     SymbolKeyedMap m_symbolKeyedTable;
     int32_t m_capacity;
@@ -144,7 +158,9 @@ private:
 
 template<typename Entry, typename JSIterator>
 ALWAYS_INLINE MapDataImpl<Entry, JSIterator>::MapDataImpl(VM& vm, JSCell* owner)
-    : m_capacity(0)
+    : m_indexTableKeyCount(0)
+    , m_indexTableDeletedCount(0)
+    , m_capacity(0)
     , m_size(0)
     , m_deletedCount(0)
     , m_owner(owner)
@@ -40,8 +40,9 @@ namespace JSC {
 template<typename Entry, typename JSIterator>
 inline void MapDataImpl<Entry, JSIterator>::clear()
 {
-    m_cellKeyedTable.clear();
-    m_valueKeyedTable.clear();
+    m_indexTable.clear();
+    m_indexTableKeyCount = 0;
+    m_indexTableDeletedCount = 0;
     m_stringKeyedTable.clear();
     m_symbolKeyedTable.clear();
     m_capacity = 0;
@@ -53,6 +54,64 @@ inline void MapDataImpl<Entry, JSIterator>::clear()
     });
 }
 
+template<typename Entry, typename JSIterator>
+inline int32_t* MapDataImpl<Entry, JSIterator>::findIdentityKeySlot(Entry* entries, JSValue key)
+{
+    if (m_indexTable.isEmpty())
+        return nullptr;
+    unsigned mask = m_indexTable.size() - 1;
+    int32_t* table = m_indexTable.data();
+    for (unsigned i = hashIdentityKey(key) & mask; ; i = (i + 1) & mask) {
+        int32_t index = table[i];
+        if (index == emptyIndex)
+            return nullptr;
+        if (index >= 0 && entries[index].key().get() == key)
+            return &table[i];
+    }
+}
+
+template<typename Entry, typename JSIterator>
+inline void MapDataImpl<Entry, JSIterator>::rehashIndexTable(Entry* entries, unsigned newTableSize)
+{
+    ASSERT(hasOneBitSet(newTableSize));
+    Vector<int32_t> oldTable;
+    oldTable.swap(m_indexTable);
+    m_indexTable.fill(emptyIndex, newTableSize);
+    m_indexTableDeletedCount = 0;
+
+    unsigned mask = newTableSize - 1;
+    for (int32_t index : oldTable) {
+        if (index < 0)
+            continue;
+        unsigned i = hashIdentityKey(entries[index].key().get()) & mask;
+        while (m_indexTable[i] != emptyIndex)
+            i = (i + 1) & mask;
+        m_indexTable[i] = index;
+    }
+}
+
+template<typename Entry, typename JSIterator>
+inline void MapDataImpl<Entry, JSIterator>::addIdentityKey(Entry* entries, JSValue key, int32_t index)
+{
+    // Keep the table at most half full, counting deleted slots, so probe sequences stay short.
+    unsigned tableSize = m_indexTable.size();
+    if ((m_indexTableKeyCount + m_indexTableDeletedCount + 1) * 2 > static_cast<int32_t>(tableSize)) {
+        unsigned newTableSize = minimumIndexTableSize;
+        if (tableSize)
+            newTableSize = (m_indexTableKeyCount + 1) * 4 > static_cast<int32_t>(tableSize) ? tableSize * 2 : tableSize;
+        rehashIndexTable(entries, newTableSize);
+    }
+
+    unsigned mask = m_indexTable.size() - 1;
+    unsigned i = hashIdentityKey(key) & mask;
+    while (m_indexTable[i] >= 0)
+        i = (i + 1) & mask;
+    if (m_indexTable[i] == deletedIndex)
+        m_indexTableDeletedCount--;
+    m_indexTable[i] = index;
+    m_indexTableKeyCount++;
+}
+
 template<typename Entry, typename JSIterator>
 inline Entry* MapDataImpl<Entry, JSIterator>::find(ExecState* exec, KeyType key)
 {
@@ -68,17 +127,12 @@ inline Entry* MapDataImpl<Entry, JSIterator>::find(ExecState* exec, KeyType key)
             return 0;
         return &m_entries.get(m_owner)[iter->value];
     }
-    if (key.value.isCell()) {
-        auto iter = m_cellKeyedTable.find(key.value.asCell());
-        if (iter == m_cellKeyedTable.end())
-            return 0;
-        return &m_entries.get(m_owner)[iter->value];
-    }
 
-    auto iter = m_valueKeyedTable.find(JSValue::encode(key.value));
-    if (iter == m_valueKeyedTable.end())
+    Entry* entries = m_entries.get(m_owner);
+    int32_t* slot = findIdentityKeySlot(entries, key.value);
+    if (!slot)
         return 0;
-    return &m_entries.get(m_owner)[iter->value];
+    return &entries[*slot];
 }
 
 template<typename Entry, typename JSIterator>
@@ -106,6 +160,23 @@ inline Entry* MapDataImpl<Entry, JSIterator>::add(ExecState* exec, JSCell* owner
     return entry;
 }
 
+template<typename Entry, typename JSIterator>
+inline Entry* MapDataImpl<Entry, JSIterator>::addIdentityKeyed(ExecState* exec, JSCell* owner, KeyType keyValue)
+{
+    if (int32_t* slot = findIdentityKeySlot(m_entries.get(m_owner), keyValue.value))
+        return &m_entries.get(m_owner)[*slot];
+
+    if (!ensureSpaceForAppend(exec, owner))
+        return 0;
+
+    Entry* entries = m_entries.get(m_owner);
+    addIdentityKey(entries, keyValue.value, m_size);
+    Entry* entry = &entries[m_size++];
+    new (entry) Entry();
+    entry->setKey(exec->vm(), owner, keyValue.value);
+    return entry;
+}
+
 template<typename Entry, typename JSIterator>
 inline void MapDataImpl<Entry, JSIterator>::set(ExecState* exec, JSCell* owner, KeyType key, JSValue value)
 {
@@ -122,9 +193,7 @@ inline Entry* MapDataImpl<Entry, JSIterator>::add(ExecState* exec, JSCell* owner
         return add(exec, owner, m_stringKeyedTable, asString(key.value)->value(exec).impl(), key);
     if (key.value.isSymbol())
         return add(exec, owner, m_symbolKeyedTable, asSymbol(key.value)->privateName().uid(), key);
-    if (key.value.isCell())
-        return add(exec, owner, m_cellKeyedTable, key.value.asCell(), key);
-    return add(exec, owner, m_valueKeyedTable, JSValue::encode(key.value), key);
+    return addIdentityKeyed(exec, owner, key);
 }
 
 template<typename Entry, typename JSIterator>
@@ -151,18 +220,14 @@ inline bool MapDataImpl<Entry, JSIterator>::remove(ExecState* exec, KeyType key)
             return false;
         location = iter->value;
         m_symbolKeyedTable.remove(iter);
-    } else if (key.value.isCell()) {
-        auto iter = m_cellKeyedTable.find(key.value.asCell());
-        if (iter == m_cellKeyedTable.end())
-            return false;
-        location = iter->value;
-        m_cellKeyedTable.remove(iter);
     } else {
-        auto iter = m_valueKeyedTable.find(JSValue::encode(key.value));
-        if (iter == m_valueKeyedTable.end())
+        int32_t* slot = findIdentityKeySlot(m_entries.get(m_owner), key.value);
+        if (!slot)
             return false;
-        location = iter->value;
-        m_valueKeyedTable.remove(iter);
+        location = *slot;
+        *slot = deletedIndex;
+        m_indexTableKeyCount--;
+        m_indexTableDeletedCount++;
     }
     m_entries.get(m_owner)[location].clear();
     m_deletedCount++;
@@ -193,11 +258,12 @@ inline void MapDataImpl<Entry, JSIterator>::replaceAndPackBackingStore(Entry* de
         newEnd++;
     }
 
-    // Fixup for the hashmaps
-    for (auto ptr = m_valueKeyedTable.begin(); ptr != m_valueKeyedTable.end(); ++ptr)
-        ptr->value = m_entries.getWithoutBarrier()[ptr->value].key().get().asInt32();
-    for (auto ptr = m_cellKeyedTable.begin(); ptr != m_cellKeyedTable.end(); ++ptr)
-        ptr->value = m_entries.getWithoutBarrier()[ptr->value].key().get().asInt32();
+    // Fixup for the hashmaps. Slots in the index table were placed by the hash of their key, not
+    // by their index, so they stay where they are and only need their index forwarded.
+    for (int32_t& index : m_indexTable) {
+        if (index >= 0)
+            index = m_entries.getWithoutBarrier()[index].key().get().asInt32();
+    }
     for (auto ptr = m_stringKeyedTable.begin(); ptr != m_stringKeyedTable.end(); ++ptr)
         ptr->value = m_entries.getWithoutBarrier()[ptr->value].key().get().asInt32();
     for (auto ptr = m_symbolKeyedTable.begin(); ptr != m_symbolKeyedTable.end(); ++ptr)
@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef MegamorphicCache_h
+#define MegamorphicCache_h
+
+#include "PropertyOffset.h"
+#include "StructureIDTable.h"
+#include <wtf/FastMalloc.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/text/UniquedStringImpl.h>
+
+namespace JSC {
+
+class JSValue;
+class PropertySlot;
+class VM;
+
+// A VM-wide, direct-mapped cache from (StructureID, property name) to the offset of an own data
+// property. Get-by-id sites that have seen too many structures for a polymorphic stub probe it
+// from their stub instead of calling into the runtime for a full lookup.
+//
+// Only structures whose property table cannot change in place are entered, so an entry stays
+// correct as long as its structure is alive. The table is cleared on every collection, before
+// dead structures can give their IDs to new ones.
+class MegamorphicCache {
+    WTF_MAKE_NONCOPYABLE(MegamorphicCache);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    static const unsigned numberOfEntries = 4096;
+    static const unsigned entryIndexMask = numberOfEntries - 1;
+
+    struct Entry {
+        static ptrdiff_t offsetOfUid() { return OBJECT_OFFSETOF(Entry, uid); }
+        static ptrdiff_t offsetOfStructureID() { return OBJECT_OFFSETOF(Entry, structureID); }
+        static ptrdiff_t offsetOfOffset() { return OBJECT_OFFSETOF(Entry, offset); }
+
+        UniquedStringImpl* uid;
+        StructureID structureID;
+        int32_t offset;
+    };
+
+    MegamorphicCache()
+    {
+        clear();
+    }
+
+    static uint32_t hashFor(UniquedStringImpl* uid)
+    {
+        return uid->existingSymbolAwareHash();
+    }
+
+    static unsigned indexFor(StructureID structureID, UniquedStringImpl* uid)
+    {
+#if USE(JSVALUE64)
+        uint32_t structureBits = structureID;
+#else
+        uint32_t structureBits = static_cast<uint32_t>(bitwise_cast<uintptr_t>(structureID));
+#endif
+        return (structureBits ^ hashFor(uid)) & entryIndexMask;
+    }
+
+    PropertyOffset get(StructureID structureID, UniquedStringImpl* uid) const
+    {
+        const Entry& entry = m_entries[indexFor(structureID, uid)];
+        if (entry.uid != uid || entry.structureID != structureID)
+            return invalidOffset;
+        return entry.offset;
+    }
+
+    void add(StructureID structureID, UniquedStringImpl* uid, PropertyOffset offset)
+    {
+        ASSERT(uid);
+        ASSERT(isValidOffset(offset));
+        Entry& entry = m_entries[indexFor(structureID, uid)];
+        entry.uid = uid;
+        entry.structureID = structureID;
+        entry.offset = offset;
+    }
+
+    // Adds the result of a lookup if it was an own data property of a structure we can cache.
+    void addIfCacheable(VM&, JSValue base, UniquedStringImpl*, const PropertySlot&);
+
+    void clear()
+    {
+        for (Entry& entry : m_entries)
+            entry.uid = nullptr;
+    }
+
+    Entry* entries() { return m_entries; }
+
+private:
+    Entry m_entries[numberOfEntries];
+};
+
+} // namespace JSC
+
+#endif // MegamorphicCache_h
@@ -132,6 +132,14 @@ static unsigned computeNumberOfWorkerThreads(int maxNumberOfWorkerThreads, int m
     return std::max(cpusToUse, minimum);
 }
 
+// Compiler threads keep the old fixed caps on small machines, but past that grow with the
+// core count so that big servers running many pages are not bottlenecked on a few threads.
+static unsigned computeNumberOfCompilerThreads(int minimumCap, int coresPerThread)
+{
+    int cap = std::max(minimumCap, WTF::numberOfProcessorCores() / coresPerThread);
+    return computeNumberOfWorkerThreads(cap, 2) - 1;
+}
+
 static int32_t computePriorityDeltaOfWorkerThreads(int32_t twoCorePriorityDelta, int32_t multiCorePriorityDelta)
 {
     if (WTF::numberOfProcessorCores() <= 2)
@@ -107,7 +107,12 @@ typedef const char* optionString;
     v(bool, useLLInt,  true, "allows the LLINT to be used if true") \
     v(bool, useJIT,    true, "allows the baseline JIT to be used if true") \
     v(bool, useDFGJIT, true, "allows the DFG JIT to be used if true") \
+    v(bool, shareJITThunksAcrossVMs, false, "lets all VMs in the process use one copy of the JIT thunks that do not depend on VM state") \
     v(bool, useRegExpJIT, true, "allows the RegExp JIT to be used if true") \
+    v(bool, reportRegExpInterpreterFallbacks, false, "logs each RegExp that runs in the interpreter, with the reason, whenever its interpreter match count reaches a power of two") \
+    v(unsigned, regExpCacheStrongEntries, 32, "number of recently used compiled RegExps that the RegExpCache keeps alive") \
+    v(unsigned, regExpCacheJITCodeBudget, 1024 * 1024, "total bytes of RegExp JIT code that the RegExpCache keeps alive") \
+    v(bool, dumpRegExpCacheStatistics, false, "dumps RegExpCache hits, misses and compile times when the VM is destroyed") \
     \
     v(bool, reportMustSucceedExecutableAllocations, false, nullptr) \
     \
@@ -117,8 +122,10 @@ typedef const char* optionString;
     \
     v(bool, crashIfCantAllocateJITMemory, false, nullptr) \
     v(unsigned, jitMemoryReservationSize, 0, nullptr) \
+    v(bool, dumpExecutableMemoryStatistics, false, "dumps executable memory use per tier and pool fragmentation after each full GC") \
     \
     v(bool, forceCodeBlockLiveness, false, nullptr) \
+    v(bool, useCodeAging, true, "jettison CodeBlocks that have not been seen executing for a while") \
     v(bool, forceICFailure, false, nullptr) \
     \
     v(unsigned, repatchCountForCoolDown, 10, nullptr) \
@@ -192,6 +199,7 @@ typedef const char* optionString;
     v(bool, assumeAllRegsInFTLICAreLive, false, nullptr) \
     v(bool, useAccessInlining, true, nullptr) \
     v(unsigned, maxAccessVariantListSize, 8, nullptr) \
+    v(bool, useMegamorphicCache, true, "lets get_by_id sites with too many structures for a polymorphic stub probe a VM-wide property offset cache") \
     v(bool, usePolyvariantDevirtualization, true, nullptr) \
     v(bool, usePolymorphicAccessInlining, true, nullptr) \
     v(bool, usePolymorphicCallInlining, true, nullptr) \
@@ -207,8 +215,9 @@ typedef const char* optionString;
     v(bool, useCopyBarrierOptimization, true, nullptr) \
     \
     v(bool, useConcurrentJIT, true, "allows the DFG / FTL compilation in threads other than the executing JS thread") \
-    v(unsigned, numberOfDFGCompilerThreads, computeNumberOfWorkerThreads(2, 2) - 1, nullptr) \
-    v(unsigned, numberOfFTLCompilerThreads, computeNumberOfWorkerThreads(8, 2) - 1, nullptr) \
+    v(unsigned, numberOfDFGCompilerThreads, computeNumberOfCompilerThreads(2, 8), nullptr) \
+    v(unsigned, numberOfFTLCompilerThreads, computeNumberOfCompilerThreads(8, 2), nullptr) \
+    v(unsigned, maximumCompilingPlansPerVM, 4, "when plans from other VMs are waiting, a VM may not have more than this many plans compiling on one worklist (0 means no limit)") \
     v(int32, priorityDeltaOfDFGCompilerThreads, computePriorityDeltaOfWorkerThreads(-1, 0), nullptr) \
     v(int32, priorityDeltaOfFTLCompilerThreads, computePriorityDeltaOfWorkerThreads(-2, 0), nullptr) \
     \
@@ -294,6 +303,8 @@ typedef const char* optionString;
     \
     v(unsigned, minimumNumberOfScansBetweenRebalance, 100, nullptr) \
     v(unsigned, numberOfGCMarkers, computeNumberOfGCMarkers(7), nullptr) \
+    v(bool, useConcurrentRootScanning, false, "lets GC helper threads trace from donated roots while the collector thread keeps scanning root sets") \
+    v(bool, useParallelPresweeping, true, "lets GC helper threads build the free lists of blocks without destructors before the mutator resumes") \
     v(unsigned, opaqueRootMergeThreshold, 1000, nullptr) \
     v(double, minHeapUtilization, 0.8, nullptr) \
     v(double, minCopiedBlockUtilization, 0.9, nullptr) \
@@ -316,10 +327,14 @@ typedef const char* optionString;
     v(bool, forceGCSlowPaths, false, "If true, we will force all JIT fast allocations down their slow paths.")\
     v(unsigned, gcMaxHeapSize, 0, nullptr) \
     v(unsigned, forceRAMSize, 0, nullptr) \
+    v(unsigned, gcTargetHeapSize, 0, "if non-zero, the footprint in bytes that GC scheduling tries to keep the heap under, instead of a fraction of RAM") \
     v(bool, recordGCPauseTimes, false, nullptr) \
     v(bool, logHeapStatisticsAtExit, false, nullptr) \
     v(bool, useTypeProfiler, false, nullptr) \
     v(bool, useControlFlowProfiler, false, nullptr) \
+    v(bool, useBasicBlockCoverage, false, "makes JIT code mark basic blocks with a single store when the control flow profiler is on, so basic block execution counts become 0 or 1") \
+    v(bool, useSamplingProfiler, false, nullptr) \
+    v(unsigned, sampleInterval, 1000, "microseconds between two samples taken by the sampling profiler") \
     \
     v(bool, verifyHeap, false, nullptr) \
     v(unsigned, numberOfGCCyclesToRecordForVerification, 3, nullptr) \
@@ -338,9 +353,16 @@ typedef const char* optionString;
     v(unsigned, fireOSRExitFuzzAtOrAfter, 0, nullptr) \
     \
     v(bool, logB3PhaseTimes, false, nullptr) \
+    v(bool, useB3ForWebAssembly, false, "compiles WebAssembly functions with B3, falling back to the baseline WebAssembly JIT for functions B3 cannot compile yet") \
+    v(bool, useAirLinearScan, false, "always use linear scan instead of iterated register coalescing to allocate Air registers") \
+    v(unsigned, airLinearScanThreshold, 0, "use linear scan register allocation for Air code with at least this many instructions (0 = only at optLevel 0)") \
     \
     v(bool, useDollarVM, false, "installs the $vm debugging tool in global objects") \
     v(optionString, functionOverrides, nullptr, "file with debugging overrides for function bodies") \
+    v(optionString, profileSnapshotInputFile, nullptr, "file with value and array profiles from an earlier run, used to seed new code blocks") \
+    v(optionString, profileSnapshotOutputFile, nullptr, "file to which the VM writes the value and array profiles of its hot code blocks when it is destroyed") \
+    v(optionString, diskCachePath, nullptr, "directory in which to cache the bytecode of top-level program code across runs") \
+    v(unsigned, sourceProviderCacheMaxAge, 2, "number of full collections that the parser's record of a source's functions survives without being used (0 = discard at every full collection)") \
     \
     v(unsigned, watchdog, 0, "watchdog timeout (0 = Disabled, N = a timeout period of N milliseconds)") \
     \
@@ -187,8 +187,11 @@ public:
     // Copy this PropertyTable, ensuring the copy has at least the capacity provided.
     PropertyTable* copy(VM&, unsigned newCapacity);
 
-#ifndef NDEBUG
+    // Copy this PropertyTable, leaving out deleted entries and unused capacity.
+    PropertyTable* copyCompacted(VM&);
+
     size_t sizeInMemory();
+#ifndef NDEBUG
     void checkConsistency();
 #endif
 
@@ -243,7 +246,9 @@ private:
     unsigned m_deletedCount;
     std::unique_ptr<Vector<PropertyOffset>> m_deletedOffsets;
 
-    static const unsigned MinimumTableSize = 16;
+    // Objects that become dictionaries each get their own table, and most of them only have a
+    // few properties, so keep the smallest table small.
+    static const unsigned MinimumTableSize = 8;
     static const unsigned EmptyEntryIndex = 0;
 };
 
@@ -460,7 +465,15 @@ inline PropertyTable* PropertyTable::copy(VM& vm, unsigned newCapacity)
     return PropertyTable::clone(vm, newCapacity, *this);
 }
 
-#ifndef NDEBUG
+inline PropertyTable* PropertyTable::copyCompacted(VM& vm)
+{
+    // A table without deleted entries that is already as small as it can be is copied with a
+    // memcpy. Anything else is rehashed into the smallest table that holds its keys.
+    if (!m_deletedCount && sizeForCapacity(m_keyCount) == m_indexSize)
+        return PropertyTable::clone(vm, *this);
+    return PropertyTable::clone(vm, m_keyCount, *this);
+}
+
 inline size_t PropertyTable::sizeInMemory()
 {
     size_t result = sizeof(PropertyTable) + dataSize();
@@ -468,7 +481,6 @@ inline size_t PropertyTable::sizeInMemory()
         result += (m_deletedOffsets->capacity() * sizeof(PropertyOffset));
     return result;
 }
-#endif
 
 inline void PropertyTable::reinsert(const ValueType& entry)
 {
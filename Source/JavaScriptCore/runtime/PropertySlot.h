@@ -21,6 +21,7 @@
 #ifndef PropertySlot_h
 #define PropertySlot_h
 
+#include "Intrinsic.h"
 #include "JSCJSValue.h"
 #include "PropertyName.h"
 #include "PropertyOffset.h"
@@ -121,6 +122,12 @@ public:
         return m_data.custom.getValue;
     }
 
+    Intrinsic customIntrinsic() const
+    {
+        ASSERT(isCacheableCustom());
+        return m_data.custom.intrinsic;
+    }
+
     JSObject* slotBase() const
     {
         return m_slotBase;
@@ -177,6 +184,7 @@ public:
         
         ASSERT(getValue);
         m_data.custom.getValue = getValue;
+        m_data.custom.intrinsic = NoIntrinsic;
         m_attributes = attributes;
 
         ASSERT(slotBase);
@@ -185,12 +193,13 @@ public:
         m_offset = invalidOffset;
     }
     
-    void setCacheableCustom(JSObject* slotBase, unsigned attributes, GetValueFunc getValue)
+    void setCacheableCustom(JSObject* slotBase, unsigned attributes, GetValueFunc getValue, Intrinsic intrinsic = NoIntrinsic)
     {
         ASSERT(attributes == attributesForStructure(attributes));
         
         ASSERT(getValue);
         m_data.custom.getValue = getValue;
+        m_data.custom.intrinsic = intrinsic;
         m_attributes = attributes;
 
         ASSERT(slotBase);
@@ -258,6 +267,7 @@ private:
         } getter;
         struct {
             GetValueFunc getValue;
+            Intrinsic intrinsic;
         } custom;
     } m_data;
 
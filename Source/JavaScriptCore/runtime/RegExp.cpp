@@ -28,6 +28,7 @@
 #include "RegExpCache.h"
 #include "Yarr.h"
 #include "YarrJIT.h"
+#include <string.h>
 #include <wtf/Assertions.h>
 
 #define REGEXP_FUNC_TEST_DATA_GEN 0
@@ -42,6 +43,35 @@ namespace JSC {
 
 const ClassInfo RegExp::s_info = { "RegExp", 0, 0, CREATE_METHOD_TABLE(RegExp) };
 
+// Prefixes shorter than this are cheaper to let the matcher find than to search for twice.
+static const unsigned minimumLiteralPrefixLength = 2;
+static const unsigned maximumLiteralPrefixLength = 64;
+
+static size_t findLiteralPrefix(const String& subject, unsigned startOffset, const String& prefix)
+{
+    if (!subject.is8Bit() || !prefix.is8Bit())
+        return subject.find(prefix, startOffset);
+
+    unsigned subjectLength = subject.length();
+    unsigned prefixLength = prefix.length();
+    if (startOffset > subjectLength || prefixLength > subjectLength - startOffset)
+        return notFound;
+
+    const LChar* characters = subject.characters8();
+    const LChar* prefixCharacters = prefix.characters8();
+    const LChar* cursor = characters + startOffset;
+    const LChar* lastCandidate = characters + subjectLength - prefixLength;
+    while (cursor <= lastCandidate) {
+        cursor = static_cast<const LChar*>(memchr(cursor, prefixCharacters[0], lastCandidate - cursor + 1));
+        if (!cursor)
+            return notFound;
+        if (!memcmp(cursor + 1, prefixCharacters + 1, prefixLength - 1))
+            return cursor - characters;
+        ++cursor;
+    }
+    return notFound;
+}
+
 RegExpFlags regExpFlags(const String& string)
 {
     RegExpFlags flags = NoFlags;
@@ -226,6 +256,9 @@ RegExp::RegExp(VM& vm, const String& patternString, RegExpFlags flags)
     , m_flags(flags)
     , m_constructionError(0)
     , m_numSubpatterns(0)
+    , m_interpreterMatchCount(0)
+    , m_jitFallBackReason(nullptr)
+    , m_matchOnlyUsesSubpatternCode(false)
 #if ENABLE(REGEXP_TRACING)
     , m_rtMatchOnlyTotalSubjectStringLen(0.0)
     , m_rtMatchTotalSubjectStringLen(0.0)
@@ -243,8 +276,13 @@ void RegExp::finishCreation(VM& vm)
     Yarr::YarrPattern pattern(m_patternString, ignoreCase(), multiline(), &m_constructionError);
     if (m_constructionError)
         m_state = ParseError;
-    else
+    else {
         m_numSubpatterns = pattern.m_numSubpatterns;
+        m_matchOnlyUsesSubpatternCode = pattern.m_containsBackreferences;
+        String literalPrefix = pattern.literalPrefix(maximumLiteralPrefixLength);
+        if (literalPrefix.length() >= minimumLiteralPrefixLength)
+            m_literalPrefix = literalPrefix;
+    }
 }
 
 void RegExp::destroy(JSCell* cell)
@@ -282,20 +320,25 @@ void RegExp::compile(VM* vm, Yarr::YarrCharSize charSize)
 
     if (!hasCode()) {
         ASSERT(m_state == NotCompiled);
-        vm->regExpCache()->addToStrongCache(this);
         m_state = ByteCode;
     }
 
 #if ENABLE(YARR_JIT)
-    if (!pattern.m_containsBackreferences && !pattern.containsUnsignedLengthPattern() && vm->canUseRegExpJIT()) {
+    if (pattern.containsUnsignedLengthPattern())
+        m_jitFallBackReason = "pattern can match more than INT_MAX characters";
+    else if (!vm->canUseRegExpJIT())
+        m_jitFallBackReason = "RegExp JIT is disabled";
+    else {
         Yarr::jitCompile(pattern, charSize, vm, m_regExpJITCode);
         if (!m_regExpJITCode.isFallBack()) {
             m_state = JITCode;
             return;
         }
+        m_jitFallBackReason = m_regExpJITCode.fallBackReason();
     }
 #else
     UNUSED_PARAM(charSize);
+    m_jitFallBackReason = "RegExp JIT is not enabled";
 #endif
 
     m_state = ByteCode;
@@ -317,7 +360,9 @@ void RegExp::compileIfNecessary(VM& vm, Yarr::YarrCharSize charSize)
 #endif
     }
 
+    double before = monotonicallyIncreasingTime();
     compile(&vm, charSize);
+    vm.regExpCache()->didCompile(this, monotonicallyIncreasingTime() - before);
 }
 
 int RegExp::match(VM& vm, const String& s, unsigned startOffset, Vector<int, 32>& ovector)
@@ -334,6 +379,12 @@ int RegExp::match(VM& vm, const String& s, unsigned startOffset, Vector<int, 32>
     ovector.resize(offsetVectorSize);
     int* offsetVector = ovector.data();
 
+    if (!skipToLiteralPrefix(s, startOffset)) {
+        for (int i = 0; i < offsetVectorSize; ++i)
+            offsetVector[i] = -1;
+        return -1;
+    }
+
     int result;
 #if ENABLE(YARR_JIT)
     if (m_state == JITCode) {
@@ -346,7 +397,10 @@ int RegExp::match(VM& vm, const String& s, unsigned startOffset, Vector<int, 32>
 #endif
     } else
 #endif
+    {
+        didFallBackToInterpreter();
         result = Yarr::interpret(m_regExpBytecode.get(), s, startOffset, reinterpret_cast<unsigned*>(offsetVector));
+    }
 
     // FIXME: The YARR engine should handle unsigned or size_t length matches.
     // The YARR Interpreter is "unsigned" clean, while the YARR JIT hasn't been addressed.
@@ -401,20 +455,25 @@ void RegExp::compileMatchOnly(VM* vm, Yarr::YarrCharSize charSize)
 
     if (!hasCode()) {
         ASSERT(m_state == NotCompiled);
-        vm->regExpCache()->addToStrongCache(this);
         m_state = ByteCode;
     }
 
 #if ENABLE(YARR_JIT)
-    if (!pattern.m_containsBackreferences && !pattern.containsUnsignedLengthPattern() && vm->canUseRegExpJIT()) {
-        Yarr::jitCompile(pattern, charSize, vm, m_regExpJITCode, Yarr::MatchOnly);
+    if (pattern.containsUnsignedLengthPattern())
+        m_jitFallBackReason = "pattern can match more than INT_MAX characters";
+    else if (!vm->canUseRegExpJIT())
+        m_jitFallBackReason = "RegExp JIT is disabled";
+    else {
+        Yarr::jitCompile(pattern, charSize, vm, m_regExpJITCode, m_matchOnlyUsesSubpatternCode ? Yarr::IncludeSubpatterns : Yarr::MatchOnly);
         if (!m_regExpJITCode.isFallBack()) {
             m_state = JITCode;
             return;
         }
+        m_jitFallBackReason = m_regExpJITCode.fallBackReason();
     }
 #else
     UNUSED_PARAM(charSize);
+    m_jitFallBackReason = "RegExp JIT is not enabled";
 #endif
 
     m_state = ByteCode;
@@ -427,6 +486,12 @@ void RegExp::compileIfNecessaryMatchOnly(VM& vm, Yarr::YarrCharSize charSize)
 #if ENABLE(YARR_JIT)
         if (m_state != JITCode)
             return;
+        if (m_matchOnlyUsesSubpatternCode) {
+            if ((charSize == Yarr::Char8) && (m_regExpJITCode.has8BitCode()))
+                return;
+            if ((charSize == Yarr::Char16) && (m_regExpJITCode.has16BitCode()))
+                return;
+        }
         if ((charSize == Yarr::Char8) && (m_regExpJITCode.has8BitCodeMatchOnly()))
             return;
         if ((charSize == Yarr::Char16) && (m_regExpJITCode.has16BitCodeMatchOnly()))
@@ -436,7 +501,9 @@ void RegExp::compileIfNecessaryMatchOnly(VM& vm, Yarr::YarrCharSize charSize)
 #endif
     }
 
+    double before = monotonicallyIncreasingTime();
     compileMatchOnly(&vm, charSize);
+    vm.regExpCache()->didCompile(this, monotonicallyIncreasingTime() - before);
 }
 
 MatchResult RegExp::match(VM& vm, const String& s, unsigned startOffset)
@@ -449,11 +516,27 @@ MatchResult RegExp::match(VM& vm, const String& s, unsigned startOffset)
     ASSERT(m_state != ParseError);
     compileIfNecessaryMatchOnly(vm, s.is8Bit() ? Yarr::Char8 : Yarr::Char16);
 
+    if (!skipToLiteralPrefix(s, startOffset))
+        return MatchResult::failed();
+
+    int offsetVectorSize = (m_numSubpatterns + 1) * 2;
+    int* offsetVector;
+    Vector<int, 32> nonReturnedOvector;
+
 #if ENABLE(YARR_JIT)
     if (m_state == JITCode) {
-        MatchResult result = s.is8Bit() ?
-            m_regExpJITCode.execute(s.characters8(), startOffset, s.length()) :
-            m_regExpJITCode.execute(s.characters16(), startOffset, s.length());
+        MatchResult result = MatchResult::failed();
+        if (m_matchOnlyUsesSubpatternCode) {
+            nonReturnedOvector.resize(offsetVectorSize);
+            offsetVector = nonReturnedOvector.data();
+            result = s.is8Bit() ?
+                m_regExpJITCode.execute(s.characters8(), startOffset, s.length(), offsetVector) :
+                m_regExpJITCode.execute(s.characters16(), startOffset, s.length(), offsetVector);
+        } else {
+            result = s.is8Bit() ?
+                m_regExpJITCode.execute(s.characters8(), startOffset, s.length()) :
+                m_regExpJITCode.execute(s.characters16(), startOffset, s.length());
+        }
 #if ENABLE(REGEXP_TRACING)
         if (!result)
             m_rtMatchOnlyFoundCount++;
@@ -462,9 +545,7 @@ MatchResult RegExp::match(VM& vm, const String& s, unsigned startOffset)
     }
 #endif
 
-    int offsetVectorSize = (m_numSubpatterns + 1) * 2;
-    int* offsetVector;
-    Vector<int, 32> nonReturnedOvector;
+    didFallBackToInterpreter();
     nonReturnedOvector.resize(offsetVectorSize);
     offsetVector = nonReturnedOvector.data();
     int r = Yarr::interpret(m_regExpBytecode.get(), s, startOffset, reinterpret_cast<unsigned*>(offsetVector));
@@ -482,6 +563,25 @@ MatchResult RegExp::match(VM& vm, const String& s, unsigned startOffset)
     return MatchResult::failed();
 }
 
+bool RegExp::skipToLiteralPrefix(const String& s, unsigned& startOffset)
+{
+    if (m_literalPrefix.isNull())
+        return true;
+    size_t candidate = findLiteralPrefix(s, startOffset, m_literalPrefix);
+    if (candidate == notFound)
+        return false;
+    startOffset = candidate;
+    return true;
+}
+
+void RegExp::didFallBackToInterpreter()
+{
+    ++m_interpreterMatchCount;
+    if (!Options::reportRegExpInterpreterFallbacks() || !hasOneBitSet(m_interpreterMatchCount))
+        return;
+    dataLog("RegExp /", m_patternString, "/ has run in the interpreter ", m_interpreterMatchCount, " times: ", m_jitFallBackReason ? m_jitFallBackReason : "unknown reason", "\n");
+}
+
 void RegExp::deleteCode()
 {
     if (!hasCode())
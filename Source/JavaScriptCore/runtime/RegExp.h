@@ -64,6 +64,10 @@ public:
     JS_EXPORT_PRIVATE MatchResult match(VM&, const String&, unsigned startOffset);
     unsigned numSubpatterns() const { return m_numSubpatterns; }
 
+    // How many matches had to run in the Yarr interpreter, and why the JIT could not be used.
+    unsigned interpreterMatchCount() const { return m_interpreterMatchCount; }
+    const char* jitFallBackReason() const { return m_jitFallBackReason; }
+
     bool hasCode()
     {
         return m_state != NotCompiled;
@@ -71,6 +75,15 @@ public:
 
     void deleteCode();
 
+    size_t jitCodeSize()
+    {
+#if ENABLE(YARR_JIT)
+        return m_regExpJITCode.size();
+#else
+        return 0;
+#endif
+    }
+
 #if ENABLE(REGEXP_TRACING)
     void printTraceData();
 #endif
@@ -108,6 +121,10 @@ private:
     void compileMatchOnly(VM*, Yarr::YarrCharSize);
     void compileIfNecessaryMatchOnly(VM&, Yarr::YarrCharSize);
 
+    // Moves startOffset to the first place a match could begin. Returns false if there is none.
+    bool skipToLiteralPrefix(const String&, unsigned& startOffset);
+    void didFallBackToInterpreter();
+
 #if ENABLE(YARR_JIT_DEBUG)
     void matchCompareWithInterpreter(const String&, int startOffset, int* offsetVector, int jitResult);
 #endif
@@ -116,6 +133,13 @@ private:
     RegExpFlags m_flags;
     const char* m_constructionError;
     unsigned m_numSubpatterns;
+    unsigned m_interpreterMatchCount;
+    const char* m_jitFallBackReason;
+    // Match-only code cannot record the captures that back references compare against, so such
+    // patterns run their full code for match-only calls too.
+    bool m_matchOnlyUsesSubpatternCode;
+    // Every match starts with these characters; null if the pattern has no useful literal prefix.
+    String m_literalPrefix;
 #if ENABLE(REGEXP_TRACING)
     double m_rtMatchOnlyTotalSubjectStringLen;
     double m_rtMatchTotalSubjectStringLen;
@@ -38,9 +38,14 @@ namespace JSC {
 RegExp* RegExpCache::lookupOrCreate(const String& patternString, RegExpFlags flags)
 {
     RegExpKey key(flags, patternString);
-    if (RegExp* regExp = m_weakCache.get(key))
+    if (RegExp* regExp = m_weakCache.get(key)) {
+        m_statistics.hits++;
+        if (m_strongCache.contains(key))
+            m_strongCacheOrder.appendOrMoveToLast(key);
         return regExp;
+    }
 
+    m_statistics.misses++;
     RegExp* regExp = RegExp::createWithoutCaching(*m_vm, patternString, flags);
 #if ENABLE(REGEXP_TRACING)
     m_vm->addRegExpToTrace(regExp);
@@ -51,33 +56,68 @@ RegExp* RegExpCache::lookupOrCreate(const String& patternString, RegExpFlags fla
 }
 
 RegExpCache::RegExpCache(VM* vm)
-    : m_nextEntryInStrongCache(0)
+    : m_strongCacheJITCodeSize(0)
     , m_vm(vm)
 {
 }
 
+RegExpCache::~RegExpCache()
+{
+    if (Options::dumpRegExpCacheStatistics())
+        dataLog("RegExpCache: ", m_statistics, "\n");
+}
+
 void RegExpCache::finalize(Handle<Unknown> handle, void*)
 {
     RegExp* regExp = static_cast<RegExp*>(handle.get().asCell());
     weakRemove(m_weakCache, regExp->key(), regExp);
 }
 
+void RegExpCache::didCompile(RegExp* regExp, double compileTime)
+{
+    m_statistics.compilations++;
+    m_statistics.compileTime += compileTime;
+    addToStrongCache(regExp);
+}
+
 void RegExpCache::addToStrongCache(RegExp* regExp)
 {
     String pattern = regExp->pattern();
-    if (pattern.length() > maxStrongCacheablePatternLength)
+    if (pattern.length() > maxStrongCacheablePatternLength || !Options::regExpCacheStrongEntries())
         return;
-    m_strongCache[m_nextEntryInStrongCache].set(*m_vm, regExp);
-    m_nextEntryInStrongCache++;
-    if (m_nextEntryInStrongCache == maxStrongCacheableEntries)
-        m_nextEntryInStrongCache = 0;
+
+    RegExpKey key = regExp->key();
+    auto result = m_strongCache.add(key, StrongCacheEntry());
+    StrongCacheEntry& entry = result.iterator->value;
+    if (result.isNewEntry)
+        entry.regExp.set(*m_vm, regExp);
+
+    // A RegExp gains code each time it is compiled for another character size or match mode.
+    size_t jitCodeSize = regExp->jitCodeSize();
+    m_strongCacheJITCodeSize += jitCodeSize - entry.jitCodeSize;
+    entry.jitCodeSize = jitCodeSize;
+
+    m_strongCacheOrder.appendOrMoveToLast(key);
+    pruneStrongCache();
+}
+
+void RegExpCache::pruneStrongCache()
+{
+    // Always keep the most recently used entry, even if its code alone is over budget.
+    while (m_strongCacheOrder.size() > 1
+        && (m_strongCacheOrder.size() > Options::regExpCacheStrongEntries()
+            || m_strongCacheJITCodeSize > Options::regExpCacheJITCodeBudget())) {
+        StrongCacheEntry entry = m_strongCache.take(m_strongCacheOrder.takeFirst());
+        m_strongCacheJITCodeSize -= entry.jitCodeSize;
+        m_statistics.evictions++;
+    }
 }
 
 void RegExpCache::deleteAllCode()
 {
-    for (int i = 0; i < maxStrongCacheableEntries; i++)
-        m_strongCache[i].clear();
-    m_nextEntryInStrongCache = 0;
+    m_strongCache.clear();
+    m_strongCacheOrder.clear();
+    m_strongCacheJITCodeSize = 0;
 
     RegExpCacheMap::iterator end = m_weakCache.end();
     for (RegExpCacheMap::iterator it = m_weakCache.begin(); it != end; ++it) {
@@ -88,4 +128,9 @@ void RegExpCache::deleteAllCode()
     }
 }
 
+void RegExpCache::Statistics::dump(PrintStream& out) const
+{
+    out.print(hits, " hits, ", misses, " misses, ", compilations, " compilations taking ", compileTime * 1000, " ms, ", evictions, " evictions");
+}
+
 }
@@ -30,8 +30,9 @@
 #include "Strong.h"
 #include "Weak.h"
 #include "WeakInlines.h"
-#include <array>
 #include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/PrintStream.h>
 
 #ifndef RegExpCache_h
 #define RegExpCache_h
@@ -45,22 +46,46 @@ class RegExpCache : private WeakHandleOwner {
     typedef HashMap<RegExpKey, Weak<RegExp>> RegExpCacheMap;
 
 public:
+    struct Statistics {
+        unsigned hits { 0 };
+        unsigned misses { 0 };
+        unsigned compilations { 0 };
+        unsigned evictions { 0 };
+        double compileTime { 0 }; // In seconds.
+
+        void dump(PrintStream&) const;
+    };
+
     RegExpCache(VM* vm);
+    ~RegExpCache();
     void deleteAllCode();
 
+    const Statistics& statistics() const { return m_statistics; }
+    unsigned strongCacheSize() const { return m_strongCache.size(); }
+    size_t strongCacheJITCodeSize() const { return m_strongCacheJITCodeSize; }
+
 private:
     
     static const unsigned maxStrongCacheablePatternLength = 256;
 
-    static const int maxStrongCacheableEntries = 32;
+    struct StrongCacheEntry {
+        Strong<RegExp> regExp;
+        size_t jitCodeSize { 0 };
+    };
+    typedef HashMap<RegExpKey, StrongCacheEntry> StrongCacheMap;
 
     virtual void finalize(Handle<Unknown>, void* context) override;
 
     RegExp* lookupOrCreate(const WTF::String& patternString, RegExpFlags);
+    void didCompile(RegExp*, double compileTime);
     void addToStrongCache(RegExp*);
+    void pruneStrongCache();
+
     RegExpCacheMap m_weakCache; // Holds all regular expressions currently live.
-    int m_nextEntryInStrongCache;
-    std::array<Strong<RegExp>, maxStrongCacheableEntries> m_strongCache; // Holds a select few regular expressions that have compiled and executed
+    StrongCacheMap m_strongCache; // Keeps the most recently used compiled regular expressions, and their code, alive.
+    ListHashSet<RegExpKey> m_strongCacheOrder; // Least recently used first.
+    size_t m_strongCacheJITCodeSize;
+    Statistics m_statistics;
     VM* m_vm;
 };
 
@@ -0,0 +1,288 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+#include "SamplingProfiler.h"
+
+#if ENABLE(JIT)
+
+#include "CodeBlock.h"
+#include "HeapInlines.h"
+#include "InlineCallFrame.h"
+#include "Interpreter.h"
+#include "JSCInlines.h"
+#include "JSGlobalObject.h"
+#include "JSONObject.h"
+#include "ObjectConstructor.h"
+#include "ProfilerCompilationKind.h"
+#include "VMEntryScope.h"
+#include <thread>
+#include <wtf/StringPrintStream.h>
+
+namespace JSC {
+
+static Profiler::CompilationKind compilationKindFor(JITCode::JITType jitType)
+{
+    switch (jitType) {
+    case JITCode::BaselineJIT:
+        return Profiler::Baseline;
+    case JITCode::DFGJIT:
+        return Profiler::DFG;
+    case JITCode::FTLJIT:
+        return Profiler::FTL;
+    default:
+        return Profiler::LLInt;
+    }
+}
+
+SamplingProfiler::SamplingProfiler(VM& vm)
+    : m_vm(vm)
+    , m_samplerThread(0)
+    , m_jscExecutionThread(0)
+    , m_stackOrigin(nullptr)
+    , m_stackEnd(nullptr)
+    , m_timingInterval(std::chrono::microseconds(Options::sampleInterval()))
+    , m_isPaused(true)
+    , m_isShutDown(false)
+{
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    {
+        LockHolder locker(m_lock);
+        m_isShutDown = true;
+    }
+    if (m_samplerThread)
+        waitForThreadCompletion(m_samplerThread);
+}
+
+void SamplingProfiler::start()
+{
+    // The thread must be registered for the sampler thread to be able to suspend it.
+    m_vm.heap.machineThreads().addCurrentThread();
+
+    LockHolder locker(m_lock);
+    const StackBounds& stack = wtfThreadData().stack();
+    m_jscExecutionThread = currentThread();
+    m_stackOrigin = stack.origin();
+    m_stackEnd = stack.end();
+    m_isPaused = false;
+
+    if (!m_samplerThread)
+        m_samplerThread = createThread("JSC Sampling Profiler Thread", [this] { timerLoop(); });
+}
+
+void SamplingProfiler::stop()
+{
+    LockHolder locker(m_lock);
+    m_isPaused = true;
+}
+
+void SamplingProfiler::timerLoop()
+{
+    while (true) {
+        {
+            LockHolder locker(m_lock);
+            if (m_isShutDown)
+                return;
+            if (!m_isPaused)
+                takeSample();
+        }
+        std::this_thread::sleep_for(m_timingInterval);
+    }
+}
+
+bool SamplingProfiler::isValidFramePointer(void* pointer) const
+{
+    // The stack grows down, and the whole header of the frame has to be on the stack.
+    char* frame = static_cast<char*>(pointer);
+    return frame >= static_cast<char*>(m_stackEnd)
+        && frame + JSStack::CallFrameHeaderSize * sizeof(Register) <= static_cast<char*>(m_stackOrigin);
+}
+
+void SamplingProfiler::takeSample()
+{
+    ASSERT(m_lock.isLocked());
+
+    // The suspended thread may be holding the malloc lock, so make space beforehand.
+    m_unverifiedFrames.reserveCapacity(m_unverifiedFrames.size() + maxStackDepth);
+    m_unverifiedStackTraceSizes.reserveCapacity(m_unverifiedStackTraceSizes.size() + 1);
+
+    m_vm.heap.machineThreads().suspendThreadAndCall(m_jscExecutionThread, scopedLambda<void ()>([&] () {
+        // Collections can destroy the CodeBlocks of the frames, and outside of JavaScript
+        // topCallFrame is stale.
+        if (!m_vm.entryScope || m_vm.heap.isBusy())
+            return;
+
+        // Nothing read here can be trusted yet: topCallFrame may point at a frame that has since
+        // returned. Pointers are only followed while they stay on the stack of the thread.
+        unsigned frameCount = 0;
+        CallFrame* callFrame = m_vm.topCallFrame;
+        VMEntryFrame* vmEntryFrame = m_vm.topVMEntryFrame;
+        while (frameCount < maxStackDepth && isValidFramePointer(callFrame)) {
+            UnverifiedStackFrame frame;
+            frame.codeBlock = callFrame->codeBlock();
+            frame.callSiteBits = callFrame->callSiteAsRawBits();
+            m_unverifiedFrames.uncheckedAppend(frame);
+            frameCount++;
+
+            if (callFrame->callerFrameOrVMEntryFrame() == vmEntryFrame && !isValidFramePointer(vmEntryFrame))
+                break;
+            callFrame = callFrame->callerFrame(vmEntryFrame);
+        }
+        if (frameCount)
+            m_unverifiedStackTraceSizes.uncheckedAppend(frameCount);
+    }));
+}
+
+unsigned SamplingProfiler::sampledCodeIndex(CodeBlock* codeBlock)
+{
+    String key = toString(codeBlock->ownerScriptExecutable()->sourceID(), ":", codeBlock->sourceOffset(), ":", codeBlock->specializationKind());
+    auto addResult = m_sampledCodeIndices.add(key, m_sampledCode.size());
+    if (addResult.isNewEntry) {
+        SampledCode sampledCode;
+        sampledCode.inferredName = codeBlock->inferredName();
+        sampledCode.sourceCode = codeBlock->sourceCodeForTools();
+        sampledCode.hash = toCString(codeBlock->hash());
+        sampledCode.instructionCount = codeBlock->instructionCount();
+        m_sampledCode.append(sampledCode);
+    }
+    return addResult.iterator->value;
+}
+
+void SamplingProfiler::appendFrames(Vector<StackFrame>& stackTrace, CodeBlock* codeBlock, uint32_t callSiteBits)
+{
+    JITCode::JITType jitType = codeBlock->jitType();
+
+#if ENABLE(DFG_JIT)
+    if (JITCode::isOptimizingJIT(jitType)) {
+        CallSiteIndex callSiteIndex(callSiteBits);
+        if (!codeBlock->canGetCodeOrigin(callSiteIndex)) {
+            stackTrace.append(StackFrame(sampledCodeIndex(codeBlock), std::numeric_limits<unsigned>::max(), jitType));
+            return;
+        }
+
+        // Inlined functions get a frame of their own, attributed to the machine frame's tier.
+        CodeOrigin codeOrigin = codeBlock->codeOrigin(callSiteIndex);
+        while (InlineCallFrame* inlineCallFrame = codeOrigin.inlineCallFrame) {
+            stackTrace.append(StackFrame(sampledCodeIndex(inlineCallFrame->baselineCodeBlock.get()), codeOrigin.bytecodeIndex, jitType));
+            codeOrigin = inlineCallFrame->directCaller;
+        }
+        stackTrace.append(StackFrame(sampledCodeIndex(codeBlock), codeOrigin.bytecodeIndex, jitType));
+        return;
+    }
+#endif
+
+#if USE(JSVALUE64)
+    unsigned bytecodeIndex = callSiteBits;
+#else
+    unsigned bytecodeIndex = bitwise_cast<Instruction*>(callSiteBits) - codeBlock->instructions().begin();
+#endif
+    // The frame may have been reused since topCallFrame was last set, leaving junk in its header.
+    if (bytecodeIndex >= codeBlock->instructionCount())
+        bytecodeIndex = std::numeric_limits<unsigned>::max();
+    stackTrace.append(StackFrame(sampledCodeIndex(codeBlock), bytecodeIndex, jitType));
+}
+
+void SamplingProfiler::processUnverifiedStackTraces()
+{
+    ASSERT(m_vm.currentThreadIsHoldingAPILock());
+    LockHolder locker(m_lock);
+
+    CodeBlockSet& codeBlockSet = m_vm.heap.codeBlockSet();
+    size_t frameIndex = 0;
+    for (unsigned stackTraceSize : m_unverifiedStackTraceSizes) {
+        Vector<StackFrame> stackTrace;
+        for (unsigned i = 0; i < stackTraceSize; ++i) {
+            const UnverifiedStackFrame& frame = m_unverifiedFrames[frameIndex++];
+            if (!codeBlockSet.contains(frame.codeBlock)) {
+                stackTrace.append(StackFrame());
+                continue;
+            }
+            appendFrames(stackTrace, static_cast<CodeBlock*>(frame.codeBlock), frame.callSiteBits);
+        }
+        m_stackTraces.append(WTF::move(stackTrace));
+    }
+
+    // Keep the buffers' capacity for the samples to come.
+    m_unverifiedFrames.shrink(0);
+    m_unverifiedStackTraceSizes.shrink(0);
+}
+
+JSValue SamplingProfiler::toJS(ExecState* exec)
+{
+    processUnverifiedStackTraces();
+
+    VM& vm = exec->vm();
+    JSObject* result = constructEmptyObject(exec);
+
+    JSArray* bytecodes = constructEmptyArray(exec, 0);
+    for (unsigned i = 0; i < m_sampledCode.size(); ++i) {
+        const SampledCode& sampledCode = m_sampledCode[i];
+        JSObject* object = constructEmptyObject(exec);
+        object->putDirect(vm, exec->propertyNames().bytecodesID, jsNumber(i));
+        object->putDirect(vm, exec->propertyNames().inferredName, jsString(exec, String::fromUTF8(sampledCode.inferredName)));
+        object->putDirect(vm, exec->propertyNames().sourceCode, jsString(exec, String::fromUTF8(sampledCode.sourceCode)));
+        object->putDirect(vm, exec->propertyNames().hash, jsString(exec, String::fromUTF8(sampledCode.hash)));
+        object->putDirect(vm, exec->propertyNames().instructionCount, jsNumber(sampledCode.instructionCount));
+        bytecodes->putDirectIndex(exec, i, object);
+    }
+    result->putDirect(vm, exec->propertyNames().bytecodes, bytecodes);
+
+    JSArray* stackTraces = constructEmptyArray(exec, 0);
+    for (unsigned i = 0; i < m_stackTraces.size(); ++i) {
+        const Vector<StackFrame>& stackTrace = m_stackTraces[i];
+        JSArray* frames = constructEmptyArray(exec, 0);
+        for (unsigned j = 0; j < stackTrace.size(); ++j) {
+            const StackFrame& frame = stackTrace[j];
+            JSObject* object = constructEmptyObject(exec);
+            if (frame.hasSampledCode()) {
+                object->putDirect(vm, exec->propertyNames().bytecodesID, jsNumber(frame.sampledCodeIndex));
+                if (frame.hasBytecodeIndex())
+                    object->putDirect(vm, exec->propertyNames().bytecodeIndex, jsNumber(frame.bytecodeIndex));
+                object->putDirect(vm, exec->propertyNames().compilationKind, jsString(exec, String::fromUTF8(toCString(compilationKindFor(frame.jitType)))));
+            } else
+                object->putDirect(vm, exec->propertyNames().bytecodesID, jsNumber(-1));
+            frames->putDirectIndex(exec, j, object);
+        }
+        stackTraces->putDirectIndex(exec, i, frames);
+    }
+    result->putDirect(vm, exec->propertyNames().stackTraces, stackTraces);
+
+    return result;
+}
+
+String SamplingProfiler::toJSON()
+{
+    JSGlobalObject* globalObject = JSGlobalObject::create(
+        m_vm, JSGlobalObject::createStructure(m_vm, jsNull()));
+
+    return JSONStringify(globalObject->globalExec(), toJS(globalObject->globalExec()), 0);
+}
+
+} // namespace JSC
+
+#endif // ENABLE(JIT)
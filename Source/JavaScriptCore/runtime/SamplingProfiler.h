@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef SamplingProfiler_h
+#define SamplingProfiler_h
+
+#if ENABLE(JIT)
+
+#include "JITCode.h"
+#include <chrono>
+#include <wtf/HashMap.h>
+#include <wtf/Lock.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+#include <wtf/text/CString.h>
+#include <wtf/text/StringHash.h>
+
+namespace JSC {
+
+class CodeBlock;
+class ExecState;
+class VM;
+
+// SamplingProfiler periodically suspends the thread that started it and records the JavaScript
+// stack of that thread, starting at vm.topCallFrame. The sampler thread only copies the CodeBlock
+// and call site index of each frame while the thread is suspended. These are verified against the
+// CodeBlockSet and turned into bytecode locations later, on the thread holding the API lock, which
+// is also the only thread that can destroy CodeBlocks.
+//
+// Since topCallFrame is only updated when JavaScript calls out of JIT code, a sample taken while a
+// JIT code loop runs without calls is attributed to the last frame that called out.
+class SamplingProfiler {
+    WTF_MAKE_NONCOPYABLE(SamplingProfiler);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    SamplingProfiler(VM&);
+    ~SamplingProfiler();
+
+    // These must be called on the thread that runs JavaScript in the VM.
+    JS_EXPORT_PRIVATE void start();
+    JS_EXPORT_PRIVATE void stop();
+
+    // Must be called with the API lock held. The collector calls this before it destroys CodeBlocks.
+    void processUnverifiedStackTraces();
+
+    // The result has the same "bytecodes" format as a Profiler::Database dump, so a sampled
+    // CodeBlock can be matched with the Database's by its hash. Each entry of "stackTraces" is
+    // an array of frames, innermost first, with the "bytecodesID", "bytecodeIndex" and
+    // "compilationKind" of the frame. Frames that did not have a CodeBlock, like host function
+    // frames, have a "bytecodesID" of -1.
+    JS_EXPORT_PRIVATE JSValue toJS(ExecState*);
+    JS_EXPORT_PRIVATE String toJSON();
+
+private:
+    struct UnverifiedStackFrame {
+        void* codeBlock;
+        uint32_t callSiteBits;
+    };
+
+    struct StackFrame {
+        StackFrame()
+            : sampledCodeIndex(std::numeric_limits<unsigned>::max())
+            , bytecodeIndex(std::numeric_limits<unsigned>::max())
+            , jitType(JITCode::None)
+        {
+        }
+
+        StackFrame(unsigned sampledCodeIndex, unsigned bytecodeIndex, JITCode::JITType jitType)
+            : sampledCodeIndex(sampledCodeIndex)
+            , bytecodeIndex(bytecodeIndex)
+            , jitType(jitType)
+        {
+        }
+
+        bool hasSampledCode() const { return sampledCodeIndex != std::numeric_limits<unsigned>::max(); }
+        bool hasBytecodeIndex() const { return bytecodeIndex != std::numeric_limits<unsigned>::max(); }
+
+        unsigned sampledCodeIndex;
+        unsigned bytecodeIndex;
+        JITCode::JITType jitType;
+    };
+
+    struct SampledCode {
+        CString inferredName;
+        CString sourceCode;
+        CString hash;
+        unsigned instructionCount;
+    };
+
+    void timerLoop();
+    void takeSample();
+    bool isValidFramePointer(void*) const;
+    void appendFrames(Vector<StackFrame>&, CodeBlock*, uint32_t callSiteBits);
+    unsigned sampledCodeIndex(CodeBlock*);
+
+    static const unsigned maxStackDepth = 128;
+
+    VM& m_vm;
+    Lock m_lock;
+    ThreadIdentifier m_samplerThread;
+    ThreadIdentifier m_jscExecutionThread;
+    void* m_stackOrigin;
+    void* m_stackEnd;
+    std::chrono::microseconds m_timingInterval;
+    bool m_isPaused;
+    bool m_isShutDown;
+
+    // Filled by the sampler thread.
+    Vector<UnverifiedStackFrame> m_unverifiedFrames;
+    Vector<unsigned> m_unverifiedStackTraceSizes;
+
+    // Filled by processUnverifiedStackTraces().
+    Vector<Vector<StackFrame>> m_stackTraces;
+    Vector<SampledCode> m_sampledCode;
+    HashMap<String, unsigned> m_sampledCodeIndices;
+};
+
+} // namespace JSC
+
+#endif // ENABLE(JIT)
+
+#endif // SamplingProfiler_h
@@ -789,17 +789,17 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncCharAt(ExecState* exec)
     JSValue thisValue = exec->thisValue();
     if (!checkObjectCoercible(thisValue))
         return throwVMTypeError(exec);
-    StringView string = thisValue.toString(exec)->view(exec);
+    JSString* string = thisValue.toString(exec);
     JSValue a0 = exec->argument(0);
     if (a0.isUInt32()) {
         uint32_t i = a0.asUInt32();
-        if (i < string.length())
-            return JSValue::encode(jsSingleCharacterString(exec, string[i]));
+        if (i < string->length())
+            return JSValue::encode(jsSingleCharacterString(exec, string->characterAt(exec, i)));
         return JSValue::encode(jsEmptyString(exec));
     }
     double dpos = a0.toInteger(exec);
-    if (dpos >= 0 && dpos < string.length())
-        return JSValue::encode(jsSingleCharacterString(exec, string[static_cast<unsigned>(dpos)]));
+    if (dpos >= 0 && dpos < string->length())
+        return JSValue::encode(jsSingleCharacterString(exec, string->characterAt(exec, static_cast<unsigned>(dpos))));
     return JSValue::encode(jsEmptyString(exec));
 }
 
@@ -808,17 +808,17 @@ EncodedJSValue JSC_HOST_CALL stringProtoFuncCharCodeAt(ExecState* exec)
     JSValue thisValue = exec->thisValue();
     if (!checkObjectCoercible(thisValue))
         return throwVMTypeError(exec);
-    StringView string = thisValue.toString(exec)->view(exec);
+    JSString* string = thisValue.toString(exec);
     JSValue a0 = exec->argument(0);
     if (a0.isUInt32()) {
         uint32_t i = a0.asUInt32();
-        if (i < string.length())
-            return JSValue::encode(jsNumber(string[i]));
+        if (i < string->length())
+            return JSValue::encode(jsNumber(string->characterAt(exec, i)));
         return JSValue::encode(jsNaN());
     }
     double dpos = a0.toInteger(exec);
-    if (dpos >= 0 && dpos < string.length())
-        return JSValue::encode(jsNumber(string[static_cast<int>(dpos)]));
+    if (dpos >= 0 && dpos < string->length())
+        return JSValue::encode(jsNumber(string->characterAt(exec, static_cast<unsigned>(dpos))));
     return JSValue::encode(jsNaN());
 }
 
@@ -938,13 +938,13 @@ PropertyTable* Structure::copyPropertyTable(VM& vm)
 {
     if (!propertyTable())
         return 0;
-    return PropertyTable::clone(vm, *propertyTable().get());
+    return propertyTable()->copyCompacted(vm);
 }
 
 PropertyTable* Structure::copyPropertyTableForPinning(VM& vm)
 {
     if (propertyTable())
-        return PropertyTable::clone(vm, *propertyTable().get());
+        return propertyTable()->copyCompacted(vm);
     return PropertyTable::create(vm, numberOfSlotsForLastOffset(m_offset, m_inlineCapacity));
 }
 
@@ -29,6 +29,7 @@
 #include <limits.h>
 #include <wtf/Atomics.h>
 #include <wtf/DataLog.h>
+#include <wtf/MathExtras.h>
 
 namespace JSC {
 
@@ -69,6 +70,53 @@ void StructureIDTable::flushOldTables()
     m_oldTables.clear();
 }
 
+size_t StructureIDTable::freeCount() const
+{
+    size_t result = 0;
+    for (uint32_t offset = m_firstFreeOffset; offset; offset = table()[offset].offset)
+        result++;
+    return result;
+}
+
+void StructureIDTable::compact()
+{
+#if USE(JSVALUE64)
+    if (!m_firstFreeOffset)
+        return;
+
+    BitVector freeOffsets;
+    freeOffsets.ensureSize(m_size);
+    for (uint32_t offset = m_firstFreeOffset; offset; offset = table()[offset].offset)
+        freeOffsets.quickSet(offset);
+
+    // s_unusedID is never handed out, so it can be trimmed along with the free entries. Offset 0 is
+    // the null Structure and always stays allocated.
+    while (m_size > 1 && (freeOffsets.quickGet(m_size - 1) || m_size - 1 == s_unusedID))
+        m_size--;
+
+    m_firstFreeOffset = 0;
+    for (size_t offset = m_size; offset-- > 1;) {
+        if (!freeOffsets.quickGet(offset))
+            continue;
+        table()[offset].offset = m_firstFreeOffset;
+        m_firstFreeOffset = offset;
+    }
+
+    if (m_capacity <= s_initialSize || m_size > m_capacity / 4)
+        return;
+
+    size_t newCapacity = std::max(s_initialSize, static_cast<size_t>(roundUpToPowerOfTwo(static_cast<uint32_t>(m_size * 2))));
+    auto newTable = std::make_unique<StructureOrOffset[]>(newCapacity);
+    memcpy(newTable.get(), table(), m_size * sizeof(StructureOrOffset));
+
+    // Same protocol as resize(): concurrent readers may still be looking at the old table.
+    WTF::storeStoreFence();
+    swap(m_table, newTable);
+    m_oldTables.append(WTF::move(newTable));
+    m_capacity = newCapacity;
+#endif
+}
+
 StructureID StructureIDTable::allocateID(Structure* structure)
 {
 #if USE(JSVALUE64)
@@ -27,6 +27,7 @@
 #define StructureIDTable_h
 
 #include "UnusedPointer.h"
+#include <wtf/BitVector.h>
 #include <wtf/Vector.h>
 
 namespace JSC {
@@ -52,6 +53,15 @@ public:
 
     void flushOldTables();
 
+    // Trims freed IDs off the end of the table, rethreads the free list so that the lowest free IDs
+    // are handed out first, and shrinks the table once it is mostly unused. Old tables are kept alive
+    // until the next flushOldTables(), just like after a resize.
+    void compact();
+
+    size_t size() const { return m_size; }
+    size_t capacity() const { return m_capacity; }
+    size_t freeCount() const;
+
 private:
     void resize(size_t newCapacity);
 
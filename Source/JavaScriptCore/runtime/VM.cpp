@@ -53,6 +53,7 @@
 #include "IncrementalSweeper.h"
 #include "InferredTypeTable.h"
 #include "Interpreter.h"
+#include "IntlCollator.h"
 #include "JITCode.h"
 #include "JSAPIValueWrapper.h"
 #include "JSArray.h"
@@ -70,15 +71,18 @@
 #include "Lexer.h"
 #include "Lookup.h"
 #include "MapData.h"
+#include "MegamorphicCache.h"
 #include "NativeStdFunctionCell.h"
 #include "Nodes.h"
 #include "Parser.h"
+#include "ProfileSnapshot.h"
 #include "ProfilerDatabase.h"
 #include "PropertyMapHashTable.h"
 #include "RegExpCache.h"
 #include "RegExpObject.h"
 #include "RegisterAtOffsetList.h"
 #include "RuntimeType.h"
+#include "SamplingProfiler.h"
 #include "SimpleTypedArrayController.h"
 #include "SourceProviderCache.h"
 #include "StackVisitor.h"
@@ -191,6 +195,7 @@ VM::VM(VMType vmType, HeapType heapType)
     , m_codeCache(std::make_unique<CodeCache>())
     , m_enabledProfiler(nullptr)
     , m_builtinExecutables(std::make_unique<BuiltinExecutables>(*this))
+    , m_megamorphicCache(std::make_unique<MegamorphicCache>())
     , m_typeProfilerEnabledCount(0)
     , m_controlFlowProfilerEnabledCount(0)
 {
@@ -292,6 +297,9 @@ VM::VM(VMType vmType, HeapType heapType)
         m_perBytecodeProfiler->registerToSaveAtExit(pathOut.toCString().data());
     }
 
+    if (Options::profileSnapshotInputFile())
+        m_profileSnapshot = ProfileSnapshot::load(Options::profileSnapshotInputFile());
+
     callFrameForCatch = nullptr;
 
 #if ENABLE(DFG_JIT)
@@ -307,6 +315,10 @@ VM::VM(VMType vmType, HeapType heapType)
         enableTypeProfiler();
     if (Options::useControlFlowProfiler())
         enableControlFlowProfiler();
+#if ENABLE(JIT)
+    if (Options::useSamplingProfiler())
+        ensureSamplingProfiler().start();
+#endif
 
     if (Options::watchdog()) {
         std::chrono::milliseconds timeoutMillis(Options::watchdog());
@@ -330,11 +342,20 @@ VM::~VM()
         }
     }
 #endif // ENABLE(DFG_JIT)
+
+    if (Options::profileSnapshotOutputFile()) {
+        if (!ProfileSnapshot::save(*this, Options::profileSnapshotOutputFile()))
+            dataLog("Could not save profile snapshot to ", Options::profileSnapshotOutputFile(), ".\n");
+    }
     
     waitForAsynchronousDisassembly();
     
     // Clear this first to ensure that nobody tries to remove themselves from it.
     m_perBytecodeProfiler = nullptr;
+#if ENABLE(JIT)
+    // The sampler thread must be gone before the heap it samples.
+    m_samplingProfiler = nullptr;
+#endif
 
     ASSERT(m_apiLock->currentThreadIsHoldingLock());
     m_apiLock->willDestroyVM(this);
@@ -510,6 +531,7 @@ void VM::deleteAllCode()
     whenIdle([this]() {
         m_codeCache->clear();
         m_regExpCache->deleteAllCode();
+        clearSourceProviderCaches();
         heap.deleteAllCodeBlocks();
         heap.deleteAllUnlinkedCodeBlocks();
         heap.reportAbandonedObjectGraph();
@@ -529,9 +551,26 @@ SourceProviderCache* VM::addSourceProviderCache(SourceProvider* sourceProvider)
     auto addResult = sourceProviderCacheMap.add(sourceProvider, nullptr);
     if (addResult.isNewEntry)
         addResult.iterator->value = adoptRef(new SourceProviderCache);
+    addResult.iterator->value->didUse();
     return addResult.iterator->value.get();
 }
 
+void VM::pruneSourceProviderCaches()
+{
+    // Keep the function info of recently parsed sources, so that functions parsed lazily soon after
+    // their enclosing program can still skip over their own inner functions.
+    unsigned maxAge = Options::sourceProviderCacheMaxAge();
+    Vector<SourceProvider*> staleProviders;
+    for (auto& entry : sourceProviderCacheMap) {
+        if (entry.value->age() >= maxAge)
+            staleProviders.append(entry.key.get());
+        else
+            entry.value->didAge();
+    }
+    for (SourceProvider* provider : staleProviders)
+        sourceProviderCacheMap.remove(provider);
+}
+
 void VM::clearSourceProviderCaches()
 {
     sourceProviderCacheMap.clear();
@@ -766,6 +805,12 @@ static bool disableProfilerWithRespectToCount(unsigned& counter, std::function<v
     return needsToRecompile;
 }
 
+void VM::setProfileSnapshot(std::unique_ptr<ProfileSnapshot> profileSnapshot)
+{
+    // Code blocks that already exist keep their profiles. Only new ones get seeded.
+    m_profileSnapshot = WTF::move(profileSnapshot);
+}
+
 bool VM::enableTypeProfiler()
 {
     auto enableTypeProfiler = [this] () {
@@ -804,6 +849,24 @@ bool VM::disableControlFlowProfiler()
     return disableProfilerWithRespectToCount(m_controlFlowProfilerEnabledCount, disableControlFlowProfiler);
 }
 
+#if ENABLE(JIT)
+SamplingProfiler& VM::ensureSamplingProfiler()
+{
+    if (!m_samplingProfiler)
+        m_samplingProfiler = std::make_unique<SamplingProfiler>(*this);
+    return *m_samplingProfiler;
+}
+#endif
+
+#if ENABLE(INTL)
+IntlCollatorCache& VM::intlCollatorCache()
+{
+    if (!m_intlCollatorCache)
+        m_intlCollatorCache = std::make_unique<IntlCollatorCache>();
+    return *m_intlCollatorCache;
+}
+#endif
+
 void VM::dumpTypeProfilerData()
 {
     if (!typeProfiler())
@@ -815,13 +878,13 @@ void VM::dumpTypeProfilerData()
 
 void VM::queueMicrotask(JSGlobalObject* globalObject, PassRefPtr<Microtask> task)
 {
-    m_microtaskQueue.append(std::make_unique<QueuedTask>(*this, globalObject, task));
+    m_microtaskQueue.append(QueuedTask(*this, globalObject, task));
 }
 
 void VM::drainMicrotasks()
 {
     while (!m_microtaskQueue.isEmpty())
-        m_microtaskQueue.takeFirst()->run();
+        m_microtaskQueue.takeFirst().run();
 }
 
 void QueuedTask::run()
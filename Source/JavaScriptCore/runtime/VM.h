@@ -82,6 +82,9 @@ class CommonIdentifiers;
 class ExecState;
 class Exception;
 class HandleStack;
+#if ENABLE(INTL)
+class IntlCollatorCache;
+#endif
 class TypeProfiler;
 class TypeProfilerLog;
 class Identifier;
@@ -90,9 +93,14 @@ class JSGlobalObject;
 class JSObject;
 class LLIntOffsetsExtractor;
 class LegacyProfiler;
+class MegamorphicCache;
 class NativeExecutable;
+class ProfileSnapshot;
 class RegExpCache;
 class RegisterAtOffsetList;
+#if ENABLE(JIT)
+class SamplingProfiler;
+#endif
 class ScriptExecutable;
 class SourceProvider;
 class SourceProviderCache;
@@ -158,8 +166,6 @@ struct LocalTimeOffsetCache {
 };
 
 class QueuedTask {
-    WTF_MAKE_NONCOPYABLE(QueuedTask);
-    WTF_MAKE_FAST_ALLOCATED;
 public:
     void run();
 
@@ -359,6 +365,7 @@ public:
 #endif
 
     SourceProviderCache* addSourceProviderCache(SourceProvider*);
+    void pruneSourceProviderCaches();
     void clearSourceProviderCaches();
 
     PrototypeMap prototypeMap;
@@ -520,6 +527,9 @@ public:
     double cachedDateStringValue;
 
     std::unique_ptr<Profiler::Database> m_perBytecodeProfiler;
+    ProfileSnapshot* profileSnapshot() { return m_profileSnapshot.get(); }
+    MegamorphicCache* megamorphicCache() { return m_megamorphicCache.get(); }
+    JS_EXPORT_PRIVATE void setProfileSnapshot(std::unique_ptr<ProfileSnapshot>);
     RefPtr<TypedArrayController> m_typedArrayController;
     RegExpCache* m_regExpCache;
     BumpPointerAllocator m_regExpAllocator;
@@ -579,6 +589,15 @@ public:
     bool enableControlFlowProfiler();
     bool disableControlFlowProfiler();
 
+#if ENABLE(JIT)
+    SamplingProfiler* samplingProfiler() { return m_samplingProfiler.get(); }
+    JS_EXPORT_PRIVATE SamplingProfiler& ensureSamplingProfiler();
+#endif
+
+#if ENABLE(INTL)
+    IntlCollatorCache& intlCollatorCache();
+#endif
+
     JS_EXPORT_PRIVATE void queueMicrotask(JSGlobalObject*, PassRefPtr<Microtask>);
     JS_EXPORT_PRIVATE void drainMicrotasks();
     JS_EXPORT_PRIVATE void setShouldRewriteConstAsVar(bool shouldRewrite) { m_shouldRewriteConstAsVar = shouldRewrite; }
@@ -641,13 +660,21 @@ private:
     LegacyProfiler* m_enabledProfiler;
     std::unique_ptr<BuiltinExecutables> m_builtinExecutables;
     HashMap<String, RefPtr<WatchpointSet>> m_impurePropertyWatchpointSets;
+    std::unique_ptr<ProfileSnapshot> m_profileSnapshot;
+    std::unique_ptr<MegamorphicCache> m_megamorphicCache;
     std::unique_ptr<TypeProfiler> m_typeProfiler;
     std::unique_ptr<TypeProfilerLog> m_typeProfilerLog;
     unsigned m_typeProfilerEnabledCount;
     FunctionHasExecutedCache m_functionHasExecutedCache;
     std::unique_ptr<ControlFlowProfiler> m_controlFlowProfiler;
     unsigned m_controlFlowProfilerEnabledCount;
-    Deque<std::unique_ptr<QueuedTask>> m_microtaskQueue;
+#if ENABLE(JIT)
+    std::unique_ptr<SamplingProfiler> m_samplingProfiler;
+#endif
+#if ENABLE(INTL)
+    std::unique_ptr<IntlCollatorCache> m_intlCollatorCache;
+#endif
+    Deque<QueuedTask> m_microtaskQueue;
     MallocPtr<EncodedJSValue> m_exceptionFuzzBuffer;
 };
 
@@ -43,11 +43,16 @@ static std::chrono::microseconds currentWallClockTime()
 Watchdog::Watchdog()
     : m_timerDidFire(false)
     , m_timeLimit(noTimeLimit)
+    , m_softTimeLimit(noTimeLimit)
     , m_cpuDeadline(noTimeLimit)
+    , m_softCPUDeadline(noTimeLimit)
     , m_wallClockDeadline(noTimeLimit)
     , m_callback(0)
     , m_callbackData1(0)
     , m_callbackData2(0)
+    , m_softCallback(0)
+    , m_softCallbackData1(0)
+    , m_softCallbackData2(0)
     , m_timerQueue(WorkQueue::create("jsc.watchdog.queue", WorkQueue::Type::Serial, WorkQueue::QOS::Utility))
 {
     m_timerHandler = [this] {
@@ -73,6 +78,22 @@ void Watchdog::setTimeLimit(std::chrono::microseconds limit,
         startTimer(locker, m_timeLimit);
 }
 
+void Watchdog::setSoftTimeLimit(std::chrono::microseconds limit,
+    SoftTimeLimitCallback callback, void* data1, void* data2)
+{
+    LockHolder locker(m_lock);
+
+    m_softTimeLimit = limit;
+    m_softCallback = callback;
+    m_softCallbackData1 = data1;
+    m_softCallbackData2 = data2;
+
+    if (!hasSoftTimeLimit())
+        m_softCPUDeadline = noTimeLimit;
+    else if (m_hasEnteredVM)
+        startSoftTimer(locker, m_softTimeLimit);
+}
+
 JS_EXPORT_PRIVATE void Watchdog::terminateSoon()
 {
     LockHolder locker(m_lock);
@@ -85,6 +106,8 @@ JS_EXPORT_PRIVATE void Watchdog::terminateSoon()
 
 bool Watchdog::didFireSlow(ExecState* exec)
 {
+    bool softLimitReached;
+    bool limitReached;
     {
         LockHolder locker(m_lock);
 
@@ -99,16 +122,42 @@ bool Watchdog::didFireSlow(ExecState* exec)
         m_wallClockDeadline = noTimeLimit;
 
         auto cpuTime = currentCPUTime();
-        if (cpuTime < m_cpuDeadline) {
-            auto remainingCPUTime = m_cpuDeadline - cpuTime;
-            startTimer(locker, remainingCPUTime);
+        softLimitReached = cpuTime >= m_softCPUDeadline;
+        limitReached = cpuTime >= m_cpuDeadline;
+        if (!softLimitReached && !limitReached) {
+            armTimer(locker, std::min(m_cpuDeadline, m_softCPUDeadline) - cpuTime);
             return false;
         }
+
+        // Clear the deadlines that were reached so that we can tell below whether the callbacks
+        // started new timers.
+        if (softLimitReached)
+            m_softCPUDeadline = noTimeLimit;
+        if (limitReached)
+            m_cpuDeadline = noTimeLimit;
     }
 
     // Note: we should not be holding the lock while calling the callbacks. The callbacks may
     // call setTimeLimit() which will try to lock as well.
 
+    if (softLimitReached) {
+        if (m_softCallback)
+            m_softCallback(exec, m_softCallbackData1, m_softCallbackData2);
+
+        LockHolder locker(m_lock);
+        ASSERT(m_hasEnteredVM);
+        if (hasSoftTimeLimit() && m_softCPUDeadline == noTimeLimit)
+            startSoftTimer(locker, m_softTimeLimit);
+        if (!limitReached && m_cpuDeadline != noTimeLimit) {
+            // The time limit is still ahead, but the timer that fired may have been the one for it.
+            auto cpuTime = currentCPUTime();
+            armTimer(locker, m_cpuDeadline > cpuTime ? m_cpuDeadline - cpuTime : std::chrono::microseconds(0));
+        }
+    }
+
+    if (!limitReached)
+        return false;
+
     // If m_callback is not set, then we terminate by default.
     // Else, we let m_callback decide if we should terminate or not.
     bool needsTermination = !m_callback
@@ -133,6 +182,12 @@ bool Watchdog::didFireSlow(ExecState* exec)
         bool callbackAlreadyStartedTimer = (m_cpuDeadline != noTimeLimit);
         if (hasTimeLimit() && !callbackAlreadyStartedTimer)
             startTimer(locker, m_timeLimit);
+
+        // The timer that fired may also have been the one for a soft time limit that is still ahead.
+        if (m_softCPUDeadline != noTimeLimit) {
+            auto cpuTime = currentCPUTime();
+            armTimer(locker, m_softCPUDeadline > cpuTime ? m_softCPUDeadline - cpuTime : std::chrono::microseconds(0));
+        }
     }
     return false;
 }
@@ -142,12 +197,20 @@ bool Watchdog::hasTimeLimit()
     return (m_timeLimit != noTimeLimit);
 }
 
+bool Watchdog::hasSoftTimeLimit()
+{
+    return (m_softTimeLimit != noTimeLimit);
+}
+
 void Watchdog::enteredVM()
 {
     m_hasEnteredVM = true;
-    if (hasTimeLimit()) {
+    if (hasTimeLimit() || hasSoftTimeLimit()) {
         LockHolder locker(m_lock);
-        startTimer(locker, m_timeLimit);
+        if (hasTimeLimit())
+            startTimer(locker, m_timeLimit);
+        if (hasSoftTimeLimit())
+            startSoftTimer(locker, m_softTimeLimit);
     }
 }
 
@@ -159,15 +222,31 @@ void Watchdog::exitedVM()
     m_hasEnteredVM = false;
 }
 
-void Watchdog::startTimer(LockHolder&, std::chrono::microseconds timeLimit)
+void Watchdog::startTimer(LockHolder& locker, std::chrono::microseconds timeLimit)
 {
     ASSERT(m_hasEnteredVM);
     ASSERT(hasTimeLimit());
     ASSERT(timeLimit <= m_timeLimit);
 
     m_cpuDeadline = currentCPUTime() + timeLimit;
+    armTimer(locker, timeLimit);
+}
+
+void Watchdog::startSoftTimer(LockHolder& locker, std::chrono::microseconds timeLimit)
+{
+    ASSERT(m_hasEnteredVM);
+    ASSERT(hasSoftTimeLimit());
+
+    m_softCPUDeadline = currentCPUTime() + timeLimit;
+    armTimer(locker, timeLimit);
+}
+
+void Watchdog::armTimer(LockHolder&, std::chrono::microseconds delay)
+{
+    // CPU time never passes faster than wall clock time, so a timer that fires after the CPU time
+    // left is never late. didFireSlow() arms it again if the thread was not running all along.
     auto wallClockTime = currentWallClockTime();
-    auto wallClockDeadline = wallClockTime + timeLimit;
+    auto wallClockDeadline = wallClockTime + delay;
 
     if ((wallClockTime < m_wallClockDeadline)
         && (m_wallClockDeadline <= wallClockDeadline))
@@ -177,12 +256,13 @@ void Watchdog::startTimer(LockHolder&, std::chrono::microseconds timeLimit)
     this->ref(); // m_timerHandler will deref to match later.
     m_wallClockDeadline = wallClockDeadline;
 
-    m_timerQueue->dispatchAfter(std::chrono::nanoseconds(timeLimit), m_timerHandler);
+    m_timerQueue->dispatchAfter(std::chrono::nanoseconds(delay), m_timerHandler);
 }
 
 void Watchdog::stopTimer(LockHolder&)
 {
     m_cpuDeadline = noTimeLimit;
+    m_softCPUDeadline = noTimeLimit;
 }
 
 } // namespace JSC
@@ -47,6 +47,12 @@ public:
     void setTimeLimit(std::chrono::microseconds limit, ShouldTerminateCallback = 0, void* data1 = 0, void* data2 = 0);
     JS_EXPORT_PRIVATE void terminateSoon();
 
+    // The soft limit callback is called after every limit's worth of CPU time that script runs, from
+    // the same loop header checks that enforce the time limit. It cannot stop the script, but it may
+    // block, which lets an embedder running many VMs on a pool of threads make a script yield.
+    typedef void (*SoftTimeLimitCallback)(ExecState*, void* data1, void* data2);
+    void setSoftTimeLimit(std::chrono::microseconds limit, SoftTimeLimitCallback = 0, void* data1 = 0, void* data2 = 0);
+
     bool didFire(ExecState* exec)
     {
         if (!m_timerDidFire)
@@ -55,6 +61,7 @@ public:
     }
 
     bool hasTimeLimit();
+    bool hasSoftTimeLimit();
     void enteredVM();
     void exitedVM();
 
@@ -64,6 +71,8 @@ public:
 
 private:
     void startTimer(LockHolder&, std::chrono::microseconds timeLimit);
+    void startSoftTimer(LockHolder&, std::chrono::microseconds timeLimit);
+    void armTimer(LockHolder&, std::chrono::microseconds delay);
     void stopTimer(LockHolder&);
 
     bool didFireSlow(ExecState*);
@@ -77,11 +86,14 @@ private:
 
     std::chrono::microseconds m_timeLimit;
 
+    std::chrono::microseconds m_softTimeLimit;
+
     std::chrono::microseconds m_cpuDeadline;
+    std::chrono::microseconds m_softCPUDeadline;
     std::chrono::microseconds m_wallClockDeadline;
 
-    // Writes to m_timerDidFire and m_timeLimit, and Reads+Writes to m_cpuDeadline and m_wallClockDeadline
-    // must be guarded by this lock.
+    // Writes to m_timerDidFire, m_timeLimit and m_softTimeLimit, and Reads+Writes to m_cpuDeadline,
+    // m_softCPUDeadline and m_wallClockDeadline must be guarded by this lock.
     Lock m_lock;
 
     bool m_hasEnteredVM { false };
@@ -90,6 +102,10 @@ private:
     void* m_callbackData1;
     void* m_callbackData2;
 
+    SoftTimeLimitCallback m_softCallback;
+    void* m_softCallbackData1;
+    void* m_softCallbackData2;
+
     Ref<WorkQueue> m_timerQueue;
     std::function<void ()> m_timerHandler;
 
@@ -0,0 +1,940 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef WASMFunctionB3Generator_h
+#define WASMFunctionB3Generator_h
+
+#if ENABLE(WEBASSEMBLY) && ENABLE(B3_JIT)
+
+#include "B3ArgumentRegValue.h"
+#include "B3BasicBlockInlines.h"
+#include "B3CCallValue.h"
+#include "B3Compilation.h"
+#include "B3Const32Value.h"
+#include "B3ConstDoubleValue.h"
+#include "B3ConstPtrValue.h"
+#include "B3ControlValue.h"
+#include "B3MemoryValue.h"
+#include "B3Procedure.h"
+#include "B3StackSlotValue.h"
+#include "B3SwitchCase.h"
+#include "B3SwitchValue.h"
+#include "B3UpsilonValue.h"
+#include "B3ValueInlines.h"
+#include "Interpreter.h"
+#include "WASMFunctionCompiler.h"
+
+namespace JSC {
+
+static void JIT_OPERATION operationWASMUnboxArguments(ExecState* exec, uint64_t* locals, const Vector<WASMType>* arguments)
+{
+    VM* vm = &exec->vm();
+    NativeCallFrameTracer tracer(vm, exec);
+
+    for (size_t i = 0; i < arguments->size(); ++i) {
+        JSValue value = exec->argument(i);
+        switch (arguments->at(i)) {
+        case WASMType::I32: {
+            int32_t intValue = value.toInt32(exec);
+            memcpy(&locals[i], &intValue, sizeof(intValue));
+            break;
+        }
+        case WASMType::F64: {
+            double doubleValue = value.toNumber(exec);
+            memcpy(&locals[i], &doubleValue, sizeof(doubleValue));
+            break;
+        }
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+        if (vm->exception())
+            return;
+    }
+}
+
+static int32_t JIT_OPERATION operationWASMCountLeadingZeros(int32_t value)
+{
+    int32_t result = 0;
+    for (uint32_t bits = value; result < 32 && !(bits & 0x80000000); bits <<= 1)
+        result++;
+    return result;
+}
+
+static int32_t JIT_OPERATION operationWASMMod(int32_t left, int32_t right)
+{
+    return left % right;
+}
+
+static uint32_t JIT_OPERATION operationWASMUnsignedDiv(uint32_t left, uint32_t right)
+{
+    return left / right;
+}
+
+static uint32_t JIT_OPERATION operationWASMUnsignedMod(uint32_t left, uint32_t right)
+{
+    return left % right;
+}
+
+// Keeps the B3 compilation that the entry thunk calls into alive for as long as the code block.
+class WASMB3JITCode : public DirectJITCode {
+public:
+    WASMB3JITCode(CodeRef ref, CodePtr withArityCheck, std::unique_ptr<B3::Compilation> compilation)
+        : DirectJITCode(ref, withArityCheck, JITCode::BaselineJIT)
+        , m_compilation(WTF::move(compilation))
+    {
+    }
+
+private:
+    std::unique_ptr<B3::Compilation> m_compilation;
+};
+
+// Builds a B3 procedure for a WebAssembly function. The procedure is an ordinary C function taking
+// the CallFrame of a small entry thunk, which converts between the JS calling convention and
+// unboxed values and propagates any exception the procedure raised. B3 in this tree cannot yet
+// lower every operation WebAssembly needs (notably float32 arithmetic, most double arithmetic and
+// int/double conversions), and calls are not supported either; when a function uses any of them,
+// didCompile() stays false and the caller compiles the function with WASMFunctionCompiler instead.
+class WASMFunctionB3Generator {
+public:
+    typedef B3::Value* Expression;
+    typedef int Statement;
+    typedef Vector<B3::Value*> ExpressionList;
+    struct MemoryAddress {
+        MemoryAddress(void*) { }
+        MemoryAddress(B3::Value* index, uint32_t offset)
+            : index(index)
+            , offset(offset)
+        {
+        }
+        B3::Value* index { nullptr };
+        uint32_t offset { 0 };
+    };
+    struct JumpTarget {
+        B3::BasicBlock* block { nullptr };
+        Vector<B3::UpsilonValue*> upsilons;
+    };
+    enum class JumpCondition { Zero, NonZero };
+
+    WASMFunctionB3Generator(VM& vm, CodeBlock* codeBlock, JSWASMModule* module, unsigned stackHeight, WASMExpressionType returnType)
+        : m_vm(vm)
+        , m_codeBlock(codeBlock)
+        , m_module(module)
+        , m_stackHeight(stackHeight)
+        , m_returnType(returnType)
+    {
+    }
+
+    bool didCompile() const { return m_didCompile; }
+
+    void startFunction(const Vector<WASMType>& arguments, uint32_t numberOfI32LocalVariables, uint32_t numberOfF32LocalVariables, uint32_t numberOfF64LocalVariables)
+    {
+        m_codeBlock->setNumParameters(1 + arguments.size());
+        m_arguments = &arguments;
+
+        m_currentBlock = m_proc.addBlock();
+        m_callFrame = m_currentBlock->appendNew<B3::ArgumentRegValue>(m_proc, B3::Origin(), GPRInfo::argumentGPR0);
+
+        for (WASMType argument : arguments) {
+            if (argument == WASMType::F32)
+                m_isSupported = false;
+        }
+        if (!m_isSupported)
+            return;
+
+        // All locals live in one slot so that the runtime can unbox the arguments into it directly.
+        unsigned numberOfLocals = arguments.size() + numberOfI32LocalVariables + numberOfF32LocalVariables + numberOfF64LocalVariables;
+        m_locals = m_currentBlock->appendNew<B3::StackSlotValue>(m_proc, B3::Origin(), std::max(1u, numberOfLocals) * sizeof(uint64_t), B3::StackSlotKind::Locked);
+
+        if (!arguments.isEmpty()) {
+            m_currentBlock->appendNew<B3::CCallValue>(m_proc, B3::Void, B3::Origin(),
+                constantPointer(bitwise_cast<void*>(operationWASMUnboxArguments)), m_callFrame, m_locals, constantPointer(&arguments));
+            branchToExceptionReturnIfNeeded();
+        }
+
+        unsigned localIndex = arguments.size();
+        for (uint32_t i = 0; i < numberOfI32LocalVariables + numberOfF32LocalVariables; ++i)
+            storeLocal(localIndex++, constant32(0));
+        for (uint32_t i = 0; i < numberOfF64LocalVariables; ++i)
+            storeLocal(localIndex++, constantDouble(0));
+    }
+
+    void endFunction()
+    {
+        if (!m_isSupported)
+            return;
+
+        m_currentBlock->appendNew<B3::ControlValue>(m_proc, B3::Return, B3::Origin(), zeroForType(m_returnType));
+
+        std::unique_ptr<B3::Compilation> compilation = std::make_unique<B3::Compilation>(m_vm, m_proc);
+        generateEntryThunk(compilation->code(), WTF::move(compilation));
+        m_didCompile = true;
+    }
+
+    B3::Value* buildSetLocal(WASMOpKind, uint32_t localIndex, B3::Value* value, WASMType type)
+    {
+        if (type == WASMType::F32)
+            return unsupported(WASMExpressionType::F32);
+        storeLocal(localIndex, value);
+        return value;
+    }
+
+    B3::Value* buildSetGlobal(WASMOpKind, uint32_t globalIndex, B3::Value* value, WASMType type)
+    {
+        if (type == WASMType::F32)
+            return unsupported(WASMExpressionType::F32);
+        m_currentBlock->appendNew<B3::MemoryValue>(m_proc, B3::Store, B3::Origin(), value, constantPointer(&m_module->globalVariables()[globalIndex]));
+        return value;
+    }
+
+    void buildReturn(B3::Value* value, WASMExpressionType returnType)
+    {
+        if (returnType == WASMExpressionType::Void)
+            value = constant32(0);
+        terminateCurrentBlock(B3::Return, value);
+    }
+
+    B3::Value* buildImmediateI32(uint32_t immediate)
+    {
+        return constant32(immediate);
+    }
+
+    B3::Value* buildImmediateF32(float)
+    {
+        return unsupported(WASMExpressionType::F32);
+    }
+
+    B3::Value* buildImmediateF64(double immediate)
+    {
+        return constantDouble(immediate);
+    }
+
+    B3::Value* buildGetLocal(uint32_t localIndex, WASMType type)
+    {
+        if (type == WASMType::F32)
+            return unsupported(WASMExpressionType::F32);
+        return m_currentBlock->appendNew<B3::MemoryValue>(m_proc, B3::Load, b3Type(WASMExpressionType(type)), B3::Origin(), m_locals, localOffset(localIndex));
+    }
+
+    B3::Value* buildGetGlobal(uint32_t globalIndex, WASMType type)
+    {
+        if (type == WASMType::F32)
+            return unsupported(WASMExpressionType::F32);
+        return m_currentBlock->appendNew<B3::MemoryValue>(m_proc, B3::Load, b3Type(WASMExpressionType(type)), B3::Origin(), constantPointer(&m_module->globalVariables()[globalIndex]));
+    }
+
+    B3::Value* buildConvertType(B3::Value*, WASMExpressionType, WASMExpressionType toType, WASMTypeConversion)
+    {
+        return unsupported(toType);
+    }
+
+    B3::Value* buildLoad(const MemoryAddress& memoryAddress, WASMExpressionType expressionType, WASMMemoryType memoryType, MemoryAccessConversion conversion)
+    {
+        if (expressionType == WASMExpressionType::F32)
+            return unsupported(expressionType);
+
+        B3::Value* pointer = boundsCheckedPointer(memoryAddress, memoryType);
+        switch (memoryType) {
+        case WASMMemoryType::I8:
+            return m_currentBlock->appendNew<B3::MemoryValue>(m_proc, conversion == MemoryAccessConversion::SignExtend ? B3::Load8S : B3::Load8Z, B3::Origin(), pointer);
+        case WASMMemoryType::I16:
+            return m_currentBlock->appendNew<B3::MemoryValue>(m_proc, conversion == MemoryAccessConversion::SignExtend ? B3::Load16S : B3::Load16Z, B3::Origin(), pointer);
+        case WASMMemoryType::I32:
+        case WASMMemoryType::F64:
+            return m_currentBlock->appendNew<B3::MemoryValue>(m_proc, B3::Load, b3Type(expressionType), B3::Origin(), pointer);
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+        return nullptr;
+    }
+
+    B3::Value* buildStore(WASMOpKind, const MemoryAddress& memoryAddress, WASMExpressionType expressionType, WASMMemoryType memoryType, B3::Value* value)
+    {
+        // B3 cannot lower narrow or float stores yet.
+        if (memoryType != WASMMemoryType::I32 && memoryType != WASMMemoryType::F64)
+            return unsupported(expressionType);
+
+        B3::Value* pointer = boundsCheckedPointer(memoryAddress, memoryType);
+        m_currentBlock->appendNew<B3::MemoryValue>(m_proc, B3::Store, B3::Origin(), value, pointer);
+        return value;
+    }
+
+    B3::Value* buildUnaryI32(B3::Value* value, WASMOpExpressionI32 op)
+    {
+        switch (op) {
+        case WASMOpExpressionI32::Negate:
+            return binary(B3::Sub, constant32(0), value);
+        case WASMOpExpressionI32::BitNot:
+            return binary(B3::BitXor, value, constant32(-1));
+        case WASMOpExpressionI32::CountLeadingZeros:
+            return callOperation(B3::Int32, operationWASMCountLeadingZeros, value);
+        case WASMOpExpressionI32::LogicalNot:
+            return binary(B3::Equal, value, constant32(0));
+        case WASMOpExpressionI32::Abs: {
+            B3::Value* sign = binary(B3::SShr, value, constant32(31));
+            return binary(B3::Sub, binary(B3::BitXor, value, sign), sign);
+        }
+        default:
+            ASSERT_NOT_REACHED();
+        }
+        return unsupported(WASMExpressionType::I32);
+    }
+
+    B3::Value* buildUnaryF32(B3::Value*, WASMOpExpressionF32)
+    {
+        return unsupported(WASMExpressionType::F32);
+    }
+
+    B3::Value* buildUnaryF64(B3::Value* value, WASMOpExpressionF64 op)
+    {
+        D_JITOperation_D operation;
+        switch (op) {
+        case WASMOpExpressionF64::Abs:
+            operation = fabs;
+            break;
+        case WASMOpExpressionF64::Sqrt:
+            operation = sqrt;
+            break;
+        case WASMOpExpressionF64::Ceil:
+            operation = ceil;
+            break;
+        case WASMOpExpressionF64::Floor:
+            operation = floor;
+            break;
+        case WASMOpExpressionF64::Cos:
+            operation = cos;
+            break;
+        case WASMOpExpressionF64::Sin:
+            operation = sin;
+            break;
+        case WASMOpExpressionF64::Tan:
+            operation = tan;
+            break;
+        case WASMOpExpressionF64::ACos:
+            operation = acos;
+            break;
+        case WASMOpExpressionF64::ASin:
+            operation = asin;
+            break;
+        case WASMOpExpressionF64::ATan:
+            operation = atan;
+            break;
+        case WASMOpExpressionF64::Exp:
+            operation = exp;
+            break;
+        case WASMOpExpressionF64::Ln:
+            operation = log;
+            break;
+        default:
+            // B3 cannot negate a double yet.
+            return unsupported(WASMExpressionType::F64);
+        }
+        return callOperation(B3::Double, operation, value);
+    }
+
+    B3::Value* buildBinaryI32(B3::Value* left, B3::Value* right, WASMOpExpressionI32 op)
+    {
+        switch (op) {
+        case WASMOpExpressionI32::Add:
+            return binary(B3::Add, left, right);
+        case WASMOpExpressionI32::Sub:
+            return binary(B3::Sub, left, right);
+        case WASMOpExpressionI32::Mul:
+            return binary(B3::Mul, left, right);
+        case WASMOpExpressionI32::SDiv:
+        case WASMOpExpressionI32::SMod:
+            branchToTrapIf(binary(B3::Equal, right, constant32(0)), divideErrorBlock());
+            branchToTrapIf(binary(B3::BitAnd,
+                binary(B3::Equal, right, constant32(-1)),
+                binary(B3::Equal, left, constant32(std::numeric_limits<int32_t>::min()))), divideErrorBlock());
+            if (op == WASMOpExpressionI32::SDiv)
+                return binary(B3::Div, left, right);
+            return callOperation(B3::Int32, operationWASMMod, left, right);
+        case WASMOpExpressionI32::UDiv:
+        case WASMOpExpressionI32::UMod:
+            branchToTrapIf(binary(B3::Equal, right, constant32(0)), divideErrorBlock());
+            if (op == WASMOpExpressionI32::UDiv)
+                return callOperation(B3::Int32, operationWASMUnsignedDiv, left, right);
+            return callOperation(B3::Int32, operationWASMUnsignedMod, left, right);
+        case WASMOpExpressionI32::BitOr:
+            return binary(B3::BitOr, left, right);
+        case WASMOpExpressionI32::BitAnd:
+            return binary(B3::BitAnd, left, right);
+        case WASMOpExpressionI32::BitXor:
+            return binary(B3::BitXor, left, right);
+        case WASMOpExpressionI32::LeftShift:
+            return binary(B3::Shl, left, right);
+        case WASMOpExpressionI32::ArithmeticRightShift:
+            return binary(B3::SShr, left, right);
+        case WASMOpExpressionI32::LogicalRightShift:
+            return binary(B3::ZShr, left, right);
+        default:
+            ASSERT_NOT_REACHED();
+        }
+        return unsupported(WASMExpressionType::I32);
+    }
+
+    B3::Value* buildBinaryF32(B3::Value*, B3::Value*, WASMOpExpressionF32)
+    {
+        return unsupported(WASMExpressionType::F32);
+    }
+
+    B3::Value* buildBinaryF64(B3::Value* left, B3::Value* right, WASMOpExpressionF64 op)
+    {
+        D_JITOperation_DD operation;
+        switch (op) {
+        case WASMOpExpressionF64::Add:
+            return binary(B3::Add, left, right);
+        case WASMOpExpressionF64::Mod:
+            operation = fmod;
+            break;
+        case WASMOpExpressionF64::ATan2:
+            operation = atan2;
+            break;
+        case WASMOpExpressionF64::Pow:
+            operation = pow;
+            break;
+        default:
+            // B3 cannot lower double subtraction, multiplication or division yet.
+            return unsupported(WASMExpressionType::F64);
+        }
+        return callOperation(B3::Double, operation, left, right);
+    }
+
+    B3::Value* buildRelationalI32(B3::Value* left, B3::Value* right, WASMOpExpressionI32 op)
+    {
+        B3::Opcode opcode;
+        switch (op) {
+        case WASMOpExpressionI32::EqualI32:
+            opcode = B3::Equal;
+            break;
+        case WASMOpExpressionI32::NotEqualI32:
+            opcode = B3::NotEqual;
+            break;
+        case WASMOpExpressionI32::SLessThanI32:
+            opcode = B3::LessThan;
+            break;
+        case WASMOpExpressionI32::ULessThanI32:
+            opcode = B3::Below;
+            break;
+        case WASMOpExpressionI32::SLessThanOrEqualI32:
+            opcode = B3::LessEqual;
+            break;
+        case WASMOpExpressionI32::ULessThanOrEqualI32:
+            opcode = B3::BelowEqual;
+            break;
+        case WASMOpExpressionI32::SGreaterThanI32:
+            opcode = B3::GreaterThan;
+            break;
+        case WASMOpExpressionI32::UGreaterThanI32:
+            opcode = B3::Above;
+            break;
+        case WASMOpExpressionI32::SGreaterThanOrEqualI32:
+            opcode = B3::GreaterEqual;
+            break;
+        case WASMOpExpressionI32::UGreaterThanOrEqualI32:
+            opcode = B3::AboveEqual;
+            break;
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+        return binary(opcode, left, right);
+    }
+
+    B3::Value* buildRelationalF32(B3::Value*, B3::Value*, WASMOpExpressionI32)
+    {
+        return unsupported(WASMExpressionType::I32);
+    }
+
+    B3::Value* buildRelationalF64(B3::Value* left, B3::Value* right, WASMOpExpressionI32 op)
+    {
+        B3::Opcode opcode;
+        switch (op) {
+        case WASMOpExpressionI32::EqualF64:
+            opcode = B3::Equal;
+            break;
+        case WASMOpExpressionI32::NotEqualF64:
+            opcode = B3::NotEqual;
+            break;
+        case WASMOpExpressionI32::LessThanF64:
+            opcode = B3::LessThan;
+            break;
+        case WASMOpExpressionI32::LessThanOrEqualF64:
+            opcode = B3::LessEqual;
+            break;
+        case WASMOpExpressionI32::GreaterThanF64:
+            opcode = B3::GreaterThan;
+            break;
+        case WASMOpExpressionI32::GreaterThanOrEqualF64:
+            opcode = B3::GreaterEqual;
+            break;
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+        // Double comparisons can only be lowered as branches, so materialize the result with one.
+        return select(binary(opcode, left, right), constant32(1), constant32(0));
+    }
+
+    B3::Value* buildMinOrMaxI32(B3::Value* left, B3::Value* right, WASMOpExpressionI32 op)
+    {
+        B3::Opcode opcode;
+        switch (op) {
+        case WASMOpExpressionI32::SMin:
+            opcode = B3::LessEqual;
+            break;
+        case WASMOpExpressionI32::UMin:
+            opcode = B3::BelowEqual;
+            break;
+        case WASMOpExpressionI32::SMax:
+            opcode = B3::GreaterEqual;
+            break;
+        case WASMOpExpressionI32::UMax:
+            opcode = B3::AboveEqual;
+            break;
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+        return select(binary(opcode, left, right), left, right);
+    }
+
+    B3::Value* buildMinOrMaxF64(B3::Value* left, B3::Value* right, WASMOpExpressionF64 op)
+    {
+        B3::Opcode opcode;
+        switch (op) {
+        case WASMOpExpressionF64::Min:
+            opcode = B3::LessEqual;
+            break;
+        case WASMOpExpressionF64::Max:
+            opcode = B3::GreaterEqual;
+            break;
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+        return select(binary(opcode, left, right), left, right);
+    }
+
+    B3::Value* buildCallInternal(uint32_t, const Vector<B3::Value*>&, const WASMSignature&, WASMExpressionType returnType)
+    {
+        return unsupported(returnType);
+    }
+
+    B3::Value* buildCallIndirect(uint32_t, B3::Value*, const Vector<B3::Value*>&, const WASMSignature&, WASMExpressionType returnType)
+    {
+        return unsupported(returnType);
+    }
+
+    B3::Value* buildCallImport(uint32_t, const Vector<B3::Value*>&, const WASMSignature&, WASMExpressionType returnType)
+    {
+        return unsupported(returnType);
+    }
+
+    void appendExpressionList(Vector<B3::Value*>& expressionList, B3::Value* value)
+    {
+        expressionList.append(value);
+    }
+
+    void discard(B3::Value*)
+    {
+    }
+
+    void linkTarget(JumpTarget& target)
+    {
+        B3::BasicBlock* block = blockForTarget(target);
+        m_currentBlock->appendNew<B3::ControlValue>(m_proc, B3::Jump, B3::Origin(), B3::FrequentedBlock(block));
+        m_currentBlock = block;
+    }
+
+    void jumpToTarget(JumpTarget& target)
+    {
+        terminateCurrentBlock(B3::Jump, B3::FrequentedBlock(blockForTarget(target)));
+    }
+
+    void jumpToTargetIf(JumpCondition condition, B3::Value* value, JumpTarget& target)
+    {
+        B3::BasicBlock* next = m_proc.addBlock();
+        B3::FrequentedBlock taken(blockForTarget(target));
+        B3::FrequentedBlock notTaken(next);
+        if (condition == JumpCondition::Zero)
+            std::swap(taken, notTaken);
+        m_currentBlock->appendNew<B3::ControlValue>(m_proc, B3::Branch, B3::Origin(), value, taken, notTaken);
+        m_currentBlock = next;
+    }
+
+    void jumpToTargetWithValue(JumpTarget& target, B3::Value* value, WASMExpressionType type)
+    {
+        if (type != WASMExpressionType::Void)
+            target.upsilons.append(m_currentBlock->appendNew<B3::UpsilonValue>(m_proc, B3::Origin(), value));
+        jumpToTarget(target);
+    }
+
+    B3::Value* linkTargetWithValue(JumpTarget& target, B3::Value* value, WASMExpressionType type)
+    {
+        if (type == WASMExpressionType::Void) {
+            linkTarget(target);
+            return nullptr;
+        }
+        target.upsilons.append(m_currentBlock->appendNew<B3::UpsilonValue>(m_proc, B3::Origin(), value));
+        linkTarget(target);
+        B3::Value* phi = m_currentBlock->appendNew<B3::Value>(m_proc, B3::Phi, b3Type(type), B3::Origin());
+        for (B3::UpsilonValue* upsilon : target.upsilons)
+            upsilon->setPhi(phi);
+        return phi;
+    }
+
+    void startLoop()
+    {
+        m_breakTargets.append(JumpTarget());
+        m_continueTargets.append(JumpTarget());
+    }
+
+    void endLoop()
+    {
+        m_breakTargets.removeLast();
+        m_continueTargets.removeLast();
+    }
+
+    void startSwitch()
+    {
+        m_breakTargets.append(JumpTarget());
+    }
+
+    void endSwitch()
+    {
+        m_breakTargets.removeLast();
+    }
+
+    void startLabel()
+    {
+        m_breakLabelTargets.append(JumpTarget());
+        m_continueLabelTargets.append(JumpTarget());
+
+        linkTarget(m_continueLabelTargets.last());
+    }
+
+    void endLabel()
+    {
+        linkTarget(m_breakLabelTargets.last());
+
+        m_breakLabelTargets.removeLast();
+        m_continueLabelTargets.removeLast();
+    }
+
+    JumpTarget& breakTarget()
+    {
+        return m_breakTargets.last();
+    }
+
+    JumpTarget& continueTarget()
+    {
+        return m_continueTargets.last();
+    }
+
+    JumpTarget& breakLabelTarget(uint32_t labelIndex)
+    {
+        return m_breakLabelTargets[labelIndex];
+    }
+
+    JumpTarget& continueLabelTarget(uint32_t labelIndex)
+    {
+        return m_continueLabelTargets[labelIndex];
+    }
+
+    void buildSwitch(B3::Value* value, const Vector<int64_t>& cases, Vector<JumpTarget>& targets, JumpTarget& defaultTarget)
+    {
+        B3::SwitchValue* switchValue = m_currentBlock->appendNew<B3::SwitchValue>(m_proc, B3::Origin(), value, B3::FrequentedBlock(blockForTarget(defaultTarget)));
+        for (size_t i = 0; i < cases.size(); ++i)
+            switchValue->appendCase(B3::SwitchCase(cases[i], B3::FrequentedBlock(blockForTarget(targets[i]))));
+        m_currentBlock = m_proc.addBlock();
+    }
+
+private:
+    static B3::Type b3Type(WASMExpressionType type)
+    {
+        switch (type) {
+        case WASMExpressionType::I32:
+        case WASMExpressionType::Void:
+            return B3::Int32;
+        case WASMExpressionType::F32:
+        case WASMExpressionType::F64:
+            return B3::Double;
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+        return B3::Void;
+    }
+
+    static int32_t localOffset(uint32_t localIndex)
+    {
+        return localIndex * sizeof(uint64_t);
+    }
+
+    B3::Value* unsupported(WASMExpressionType type)
+    {
+        m_isSupported = false;
+        return zeroForType(type);
+    }
+
+    B3::Value* constant32(int32_t value)
+    {
+        return m_currentBlock->appendNew<B3::Const32Value>(m_proc, B3::Origin(), value);
+    }
+
+    B3::Value* constantDouble(double value)
+    {
+        return m_currentBlock->appendNew<B3::ConstDoubleValue>(m_proc, B3::Origin(), value);
+    }
+
+    B3::Value* constantPointer(const void* pointer)
+    {
+        return m_currentBlock->appendNew<B3::ConstPtrValue>(m_proc, B3::Origin(), pointer);
+    }
+
+    B3::Value* zeroForType(WASMExpressionType type)
+    {
+        if (b3Type(type) == B3::Double)
+            return constantDouble(0);
+        return constant32(0);
+    }
+
+    B3::Value* binary(B3::Opcode opcode, B3::Value* left, B3::Value* right)
+    {
+        return m_currentBlock->appendNew<B3::Value>(m_proc, opcode, B3::Origin(), left, right);
+    }
+
+    template<typename Function, typename... Arguments>
+    B3::Value* callOperation(B3::Type resultType, Function function, Arguments... arguments)
+    {
+        return m_currentBlock->appendNew<B3::CCallValue>(m_proc, resultType, B3::Origin(), constantPointer(bitwise_cast<void*>(function)), arguments...);
+    }
+
+    void storeLocal(uint32_t localIndex, B3::Value* value)
+    {
+        m_currentBlock->appendNew<B3::MemoryValue>(m_proc, B3::Store, B3::Origin(), value, m_locals, localOffset(localIndex));
+    }
+
+    B3::BasicBlock* blockForTarget(JumpTarget& target)
+    {
+        if (!target.block)
+            target.block = m_proc.addBlock();
+        return target.block;
+    }
+
+    // Code after a terminal is unreachable; it is still built, into a block without predecessors.
+    template<typename... Arguments>
+    void terminateCurrentBlock(B3::Opcode opcode, Arguments... arguments)
+    {
+        m_currentBlock->appendNew<B3::ControlValue>(m_proc, opcode, B3::Origin(), arguments...);
+        m_currentBlock = m_proc.addBlock();
+    }
+
+    B3::Value* select(B3::Value* condition, B3::Value* thenValue, B3::Value* elseValue)
+    {
+        B3::BasicBlock* thenBlock = m_proc.addBlock();
+        B3::BasicBlock* elseBlock = m_proc.addBlock();
+        B3::BasicBlock* join = m_proc.addBlock();
+        m_currentBlock->appendNew<B3::ControlValue>(m_proc, B3::Branch, B3::Origin(), condition, B3::FrequentedBlock(thenBlock), B3::FrequentedBlock(elseBlock));
+
+        B3::UpsilonValue* thenUpsilon = thenBlock->appendNew<B3::UpsilonValue>(m_proc, B3::Origin(), thenValue);
+        thenBlock->appendNew<B3::ControlValue>(m_proc, B3::Jump, B3::Origin(), B3::FrequentedBlock(join));
+        B3::UpsilonValue* elseUpsilon = elseBlock->appendNew<B3::UpsilonValue>(m_proc, B3::Origin(), elseValue);
+        elseBlock->appendNew<B3::ControlValue>(m_proc, B3::Jump, B3::Origin(), B3::FrequentedBlock(join));
+
+        m_currentBlock = join;
+        B3::Value* phi = m_currentBlock->appendNew<B3::Value>(m_proc, B3::Phi, thenValue->type(), B3::Origin());
+        thenUpsilon->setPhi(phi);
+        elseUpsilon->setPhi(phi);
+        return phi;
+    }
+
+    void branchToTrapIf(B3::Value* condition, B3::BasicBlock* trap)
+    {
+        B3::BasicBlock* next = m_proc.addBlock();
+        m_currentBlock->appendNew<B3::ControlValue>(m_proc, B3::Branch, B3::Origin(), condition, B3::FrequentedBlock(trap, B3::FrequencyClass::Rare), B3::FrequentedBlock(next));
+        m_currentBlock = next;
+    }
+
+    void branchToExceptionReturnIfNeeded()
+    {
+        B3::Value* exception = m_currentBlock->appendNew<B3::MemoryValue>(m_proc, B3::Load, B3::pointerType(), B3::Origin(), constantPointer(m_vm.addressOfException()));
+        branchToTrapIf(exception, exceptionReturnBlock());
+    }
+
+    // The entry thunk checks for an exception after the procedure returns, so raising one only
+    // requires calling into the runtime and returning.
+    B3::BasicBlock* exceptionReturnBlock()
+    {
+        if (!m_exceptionReturnBlock) {
+            m_exceptionReturnBlock = m_proc.addBlock();
+            B3::Value* zero = m_exceptionReturnBlock->appendNew<B3::Const32Value>(m_proc, B3::Origin(), 0);
+            if (b3Type(m_returnType) == B3::Double)
+                zero = m_exceptionReturnBlock->appendNew<B3::ConstDoubleValue>(m_proc, B3::Origin(), 0);
+            m_exceptionReturnBlock->appendNew<B3::ControlValue>(m_proc, B3::Return, B3::Origin(), zero);
+        }
+        return m_exceptionReturnBlock;
+    }
+
+    B3::BasicBlock* throwingBlock(B3::BasicBlock*& block, V_JITOperation_E operation)
+    {
+        if (!block) {
+            block = m_proc.addBlock();
+            block->appendNew<B3::CCallValue>(m_proc, B3::Void, B3::Origin(),
+                block->appendNew<B3::ConstPtrValue>(m_proc, B3::Origin(), bitwise_cast<void*>(operation)), m_callFrame);
+            block->appendNew<B3::ControlValue>(m_proc, B3::Jump, B3::Origin(), B3::FrequentedBlock(exceptionReturnBlock()));
+        }
+        return block;
+    }
+
+    B3::BasicBlock* divideErrorBlock() { return throwingBlock(m_divideErrorBlock, operationThrowDivideError); }
+    B3::BasicBlock* outOfBoundsErrorBlock() { return throwingBlock(m_outOfBoundsErrorBlock, operationThrowOutOfBoundsAccessError); }
+
+    B3::Value* boundsCheckedPointer(const MemoryAddress& memoryAddress, WASMMemoryType memoryType)
+    {
+        const ArrayBuffer* arrayBuffer = m_module->arrayBuffer()->impl();
+        size_t size = sizeOfMemoryType(memoryType);
+
+        B3::Value* index = memoryAddress.index;
+        if (memoryAddress.offset)
+            index = binary(B3::Add, index, constant32(memoryAddress.offset));
+        index = binary(B3::BitAnd, index, constant32(~(size - 1)));
+
+        ASSERT(arrayBuffer->byteLength() < (1u << 31));
+        if (arrayBuffer->byteLength() >= size)
+            branchToTrapIf(binary(B3::Above, index, constant32(arrayBuffer->byteLength() - size)), outOfBoundsErrorBlock());
+        else
+            terminateCurrentBlock(B3::Jump, B3::FrequentedBlock(outOfBoundsErrorBlock()));
+
+        B3::Value* offset = m_currentBlock->appendNew<B3::Value>(m_proc, B3::ZExt32, B3::Origin(), index);
+        return binary(B3::Add, constantPointer(arrayBuffer->data()), offset);
+    }
+
+    // The thunk speaks the JS calling convention the same way WASMFunctionCompiler's prologue and
+    // epilogue do, and calls the procedure with its own CallFrame as the only argument.
+    void generateEntryThunk(MacroAssemblerCodePtr procedure, std::unique_ptr<B3::Compilation> compilation)
+    {
+        CCallHelpers jit(&m_vm, m_codeBlock);
+
+        unsigned calleeSaveSpace = WTF::roundUpToMultipleOf(stackAlignmentBytes(), RegisterSet::webAssemblyCalleeSaveRegisters().numberOfSetRegisters() * sizeof(void*));
+        m_codeBlock->setCalleeSaveRegisters(RegisterSet::webAssemblyCalleeSaveRegisters());
+
+        jit.emitFunctionPrologue();
+        jit.emitPutToCallFrameHeader(m_codeBlock, JSStack::CodeBlock);
+        CCallHelpers::Label begin = jit.label();
+
+        // The procedure's frame size is not known here. The stack height the syntax checker
+        // computed bounds its locals and temporaries, which is what it spills.
+        unsigned frameSize = calleeSaveSpace + maxFrameExtentForSlowPathCall;
+        unsigned procedureFrameEstimate = WTF::roundUpToMultipleOf(stackAlignmentBytes(), m_stackHeight * sizeof(Register));
+        jit.addPtr(CCallHelpers::TrustedImm32(-static_cast<int32_t>(frameSize + procedureFrameEstimate)), GPRInfo::callFrameRegister, GPRInfo::regT1);
+        CCallHelpers::Jump stackOverflow = jit.branchPtr(CCallHelpers::Above, CCallHelpers::AbsoluteAddress(m_vm.addressOfStackLimit()), GPRInfo::regT1);
+
+        jit.addPtr(CCallHelpers::TrustedImm32(-static_cast<int32_t>(frameSize)), GPRInfo::callFrameRegister, CCallHelpers::stackPointerRegister);
+        jit.checkStackPointerAlignment();
+
+        jit.emitSaveCalleeSaves();
+        jit.emitMaterializeTagCheckRegisters();
+
+        jit.move(GPRInfo::callFrameRegister, GPRInfo::argumentGPR0);
+        jit.move(CCallHelpers::TrustedImmPtr(procedure.executableAddress()), GPRInfo::nonArgGPR0);
+        jit.call(GPRInfo::nonArgGPR0);
+        CCallHelpers::Jump exceptionCheck = jit.emitExceptionCheck();
+
+        switch (m_returnType) {
+        case WASMExpressionType::I32:
+            jit.zeroExtend32ToPtr(GPRInfo::returnValueGPR, GPRInfo::returnValueGPR);
+            jit.or64(GPRInfo::tagTypeNumberRegister, GPRInfo::returnValueGPR);
+            break;
+        case WASMExpressionType::F64:
+            jit.purifyNaN(FPRInfo::returnValueFPR);
+            jit.boxDouble(FPRInfo::returnValueFPR, GPRInfo::returnValueGPR);
+            break;
+        case WASMExpressionType::Void:
+            jit.moveTrustedValue(jsUndefined(), JSValueRegs(GPRInfo::returnValueGPR));
+            break;
+        default:
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+        jit.emitRestoreCalleeSaves();
+        jit.emitFunctionEpilogue();
+        jit.ret();
+
+        stackOverflow.link(&jit);
+        if (maxFrameExtentForSlowPathCall)
+            jit.addPtr(CCallHelpers::TrustedImm32(-maxFrameExtentForSlowPathCall), CCallHelpers::stackPointerRegister);
+        jit.setupArgumentsWithExecState(CCallHelpers::TrustedImmPtr(m_codeBlock));
+        CCallHelpers::Call throwStackOverflow = jit.call();
+        CCallHelpers::Jump stackOverflowExceptionCheck = jit.jump();
+
+        // FIXME: Implement arity check.
+        CCallHelpers::Label arityCheck = jit.label();
+        jit.emitFunctionPrologue();
+        jit.emitPutToCallFrameHeader(m_codeBlock, JSStack::CodeBlock);
+        jit.jump(begin);
+
+        exceptionCheck.link(&jit);
+        stackOverflowExceptionCheck.link(&jit);
+        jit.copyCalleeSavesToVMCalleeSavesBuffer();
+        jit.move(CCallHelpers::TrustedImmPtr(&m_vm), GPRInfo::argumentGPR0);
+        jit.move(GPRInfo::callFrameRegister, GPRInfo::argumentGPR1);
+        CCallHelpers::Call lookupExceptionHandler = jit.call();
+        jit.jumpToExceptionHandler();
+
+        LinkBuffer patchBuffer(m_vm, jit, m_codeBlock, JITCompilationMustSucceed);
+        patchBuffer.link(throwStackOverflow, FunctionPtr(operationThrowStackOverflowError));
+        patchBuffer.link(lookupExceptionHandler, FunctionPtr(lookupExceptionHandlerFromCallerFrame));
+
+        MacroAssemblerCodePtr withArityCheck = patchBuffer.locationOf(arityCheck);
+        MacroAssemblerCodeRef result = FINALIZE_CODE(patchBuffer, ("B3 JIT code for WebAssembly"));
+        m_codeBlock->setJITCode(adoptRef(new WASMB3JITCode(result, withArityCheck, WTF::move(compilation))));
+        m_codeBlock->capabilityLevel();
+    }
+
+    VM& m_vm;
+    CodeBlock* m_codeBlock;
+    JSWASMModule* m_module;
+    unsigned m_stackHeight;
+    WASMExpressionType m_returnType;
+    const Vector<WASMType>* m_arguments { nullptr };
+
+    B3::Procedure m_proc;
+    B3::BasicBlock* m_currentBlock { nullptr };
+    B3::Value* m_callFrame { nullptr };
+    B3::Value* m_locals { nullptr };
+    B3::BasicBlock* m_exceptionReturnBlock { nullptr };
+    B3::BasicBlock* m_divideErrorBlock { nullptr };
+    B3::BasicBlock* m_outOfBoundsErrorBlock { nullptr };
+
+    Vector<JumpTarget> m_breakTargets;
+    Vector<JumpTarget> m_continueTargets;
+    Vector<JumpTarget> m_breakLabelTargets;
+    Vector<JumpTarget> m_continueLabelTargets;
+
+    bool m_isSupported { true };
+    bool m_didCompile { false };
+};
+
+} // namespace JSC
+
+#endif // ENABLE(WEBASSEMBLY) && ENABLE(B3_JIT)
+
+#endif // WASMFunctionB3Generator_h
@@ -1120,6 +1120,17 @@ public:
             target.jumpList.append(jump());
     }
 
+    void jumpToTargetWithValue(JumpTarget& target, int, WASMExpressionType)
+    {
+        jumpToTarget(target);
+    }
+
+    int linkTargetWithValue(JumpTarget& target, int, WASMExpressionType)
+    {
+        linkTarget(target);
+        return UNUSED;
+    }
+
     void jumpToTargetIf(JumpCondition condition, int, JumpTarget& target)
     {
         load32(temporaryAddress(m_tempStackTop - 1), GPRInfo::regT0);
@@ -314,6 +314,21 @@ public:
         UNUSED_PARAM(target);
     }
 
+    void jumpToTargetWithValue(LBasicBlock target, LValue value, WASMExpressionType)
+    {
+        // FIXME: Implement this method.
+        UNUSED_PARAM(target);
+        UNUSED_PARAM(value);
+    }
+
+    LValue linkTargetWithValue(LBasicBlock target, LValue value, WASMExpressionType)
+    {
+        // FIXME: Implement this method.
+        UNUSED_PARAM(target);
+        UNUSED_PARAM(value);
+        return UNUSED;
+    }
+
     void jumpToTargetIf(JumpCondition, LValue value, LBasicBlock target)
     {
         // FIXME: Implement this method.
@@ -30,6 +30,7 @@
 
 #include "JSCJSValueInlines.h"
 #include "JSWASMModule.h"
+#include "WASMFunctionB3Generator.h"
 #include "WASMFunctionCompiler.h"
 #include "WASMFunctionLLVMIRGenerator.h"
 #include "WASMFunctionSyntaxChecker.h"
@@ -68,7 +69,7 @@ static String nameOfType(WASMType type)
     }
 }
 
-bool WASMFunctionParser::checkSyntax(JSWASMModule* module, const SourceCode& source, size_t functionIndex, unsigned startOffsetInSource, unsigned& endOffsetInSource, unsigned& stackHeight, String& errorMessage)
+bool WASMFunctionParser::checkSyntax(JSWASMModule* module, const SourceCode& source, size_t functionIndex, unsigned startOffsetInSource, unsigned& endOffsetInSource, unsigned& stackHeight, String& errorMessage, bool& didReadPastEnd)
 {
     WASMFunctionParser parser(module, source, functionIndex);
     WASMFunctionSyntaxChecker syntaxChecker;
@@ -76,6 +77,7 @@ bool WASMFunctionParser::checkSyntax(JSWASMModule* module, const SourceCode& sou
     parser.parseFunction(syntaxChecker);
     if (!parser.m_errorMessage.isNull()) {
         errorMessage = parser.m_errorMessage;
+        didReadPastEnd = parser.m_reader.didReadPastEnd();
         return false;
     }
     endOffsetInSource = parser.m_reader.offset();
@@ -85,6 +87,19 @@ bool WASMFunctionParser::checkSyntax(JSWASMModule* module, const SourceCode& sou
 
 void WASMFunctionParser::compile(VM& vm, CodeBlock* codeBlock, JSWASMModule* module, const SourceCode& source, size_t functionIndex)
 {
+#if ENABLE(B3_JIT)
+    if (Options::useB3ForWebAssembly()) {
+        const WASMSignature& signature = module->signatures()[module->functionDeclarations()[functionIndex].signatureIndex];
+        WASMFunctionParser parser(module, source, functionIndex);
+        WASMFunctionB3Generator generator(vm, codeBlock, module, module->functionStackHeights()[functionIndex], signature.returnType);
+        parser.m_reader.setOffset(module->functionStartOffsetsInSource()[functionIndex]);
+        parser.parseFunction(generator);
+        ASSERT(parser.m_errorMessage.isNull());
+        if (generator.didCompile())
+            return;
+    }
+#endif
+
     WASMFunctionParser parser(module, source, functionIndex);
     WASMFunctionCompiler compiler(vm, codeBlock, module, module->functionStackHeights()[functionIndex]);
     parser.m_reader.setOffset(module->functionStartOffsetsInSource()[functionIndex]);
@@ -1117,7 +1132,8 @@ ContextExpressionList WASMFunctionParser::parseCallArguments(Context& context, c
     ContextExpressionList argumentList;
     for (size_t i = 0; i < arguments.size(); ++i) {
         ContextExpression expression = parseExpression(context, WASMExpressionType(arguments[i]));
-        PROPAGATE_ERROR();
+        if (!m_errorMessage.isNull())
+            return ContextExpressionList();
         context.appendExpressionList(argumentList, expression);
     }
     return argumentList;
@@ -1184,19 +1200,18 @@ ContextExpression WASMFunctionParser::parseConditional(Context& context, WASMExp
 
     context.jumpToTargetIf(Context::JumpCondition::Zero, condition, elseTarget);
 
-    parseExpression(context, expressionType);
+    ContextExpression trueExpression = parseExpression(context, expressionType);
     PROPAGATE_ERROR();
     
-    context.jumpToTarget(end);
+    context.jumpToTargetWithValue(end, trueExpression, expressionType);
     context.linkTarget(elseTarget);
 
     // We use discard() here to decrement the stack top in the baseline JIT.
-    context.discard(UNUSED);
-    parseExpression(context, expressionType);
+    context.discard(trueExpression);
+    ContextExpression falseExpression = parseExpression(context, expressionType);
     PROPAGATE_ERROR();
     
-    context.linkTarget(end);
-    return UNUSED;
+    return context.linkTargetWithValue(end, falseExpression, expressionType);
 }
 
 template <class Context>
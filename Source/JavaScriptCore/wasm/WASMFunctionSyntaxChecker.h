@@ -233,6 +233,8 @@ public:
 
     void linkTarget(const int&) { }
     void jumpToTarget(const int&) { }
+    void jumpToTargetWithValue(const int&, int, WASMExpressionType) { }
+    int linkTargetWithValue(const int&, int, WASMExpressionType) { return UNUSED; }
     void jumpToTargetIf(JumpCondition, int, const int&)
     {
         m_tempStackTop--;
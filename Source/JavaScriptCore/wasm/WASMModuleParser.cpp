@@ -57,20 +57,149 @@ WASMModuleParser::WASMModuleParser(VM& vm, JSGlobalObject* globalObject, const S
     , m_imports(vm, imports)
     , m_reader(static_cast<WebAssemblySourceProvider*>(source.provider())->data())
     , m_module(vm, JSWASMModule::create(vm, globalObject->wasmModuleStructure(), arrayBuffer))
+    , m_section(Section::Header)
+    , m_hasAllBytes(false)
+    , m_functionDidReadPastEnd(false)
 {
 }
 
 JSWASMModule* WASMModuleParser::parse(ExecState* exec, String& errorMessage)
 {
-    parseModule(exec);
+    return finish(exec, errorMessage);
+}
+
+bool WASMModuleParser::appendBytes(ExecState* exec, const uint8_t* data, size_t length, String& errorMessage)
+{
+    ASSERT(!m_hasAllBytes);
+    if (!m_errorMessage.isNull()) {
+        errorMessage = m_errorMessage;
+        return false;
+    }
+
+    // Appending may move the buffer the reader points into.
+    unsigned offset = m_reader.offset();
+    static_cast<WebAssemblySourceProvider*>(m_source.provider())->appendData(data, length);
+    m_reader.setOffset(offset);
+
+    parseAvailableBytes(exec);
+    if (!m_errorMessage.isNull()) {
+        errorMessage = m_errorMessage;
+        return false;
+    }
+    return true;
+}
+
+JSWASMModule* WASMModuleParser::finish(ExecState* exec, String& errorMessage)
+{
+    m_hasAllBytes = true;
+    if (m_errorMessage.isNull())
+        parseAvailableBytes(exec);
     if (!m_errorMessage.isNull()) {
         errorMessage = m_errorMessage;
         return nullptr;
     }
+    ASSERT(m_section == Section::Done);
     return m_module.get();
 }
 
-void WASMModuleParser::parseModule(ExecState* exec)
+void WASMModuleParser::parseAvailableBytes(ExecState* exec)
+{
+    while (m_section != Section::Done) {
+        unsigned sectionStartOffset = m_reader.offset();
+        m_functionDidReadPastEnd = false;
+        parseSection(exec);
+        if (m_errorMessage.isNull()) {
+            m_section = static_cast<Section>(static_cast<unsigned>(m_section) + 1);
+            continue;
+        }
+
+        if (m_hasAllBytes || !(m_reader.didReadPastEnd() || m_functionDidReadPastEnd))
+            return;
+
+        // The section runs past the bytes received so far. Function definitions are kept one by
+        // one, so only a partial function is retried; any other section is parsed again in full.
+        m_errorMessage = String();
+        if (m_section == Section::FunctionDefinitions)
+            return;
+        discardPartialSection();
+        m_reader.setOffset(sectionStartOffset);
+        return;
+    }
+}
+
+void WASMModuleParser::parseSection(ExecState* exec)
+{
+    switch (m_section) {
+    case Section::Header:
+        parseHeader();
+        break;
+    case Section::ConstantPool:
+        parseConstantPoolSection();
+        break;
+    case Section::Signatures:
+        parseSignatureSection();
+        break;
+    case Section::FunctionImports:
+        parseFunctionImportSection(exec);
+        break;
+    case Section::Globals:
+        parseGlobalSection(exec);
+        break;
+    case Section::FunctionDeclarations:
+        parseFunctionDeclarationSection();
+        break;
+    case Section::FunctionPointerTables:
+        parseFunctionPointerTableSection();
+        break;
+    case Section::FunctionDefinitions:
+        parseFunctionDefinitionSection();
+        break;
+    case Section::Exports:
+        parseExportSection();
+        PROPAGATE_ERROR();
+        FAIL_IF_FALSE(!m_module->arrayBuffer() || m_module->arrayBuffer()->impl()->byteLength() < (1u << 31), "The ArrayBuffer's length must be less than 2^31.");
+        break;
+    default:
+        ASSERT_NOT_REACHED();
+    }
+}
+
+void WASMModuleParser::discardPartialSection()
+{
+    switch (m_section) {
+    case Section::ConstantPool:
+        m_module->i32Constants().clear();
+        m_module->f32Constants().clear();
+        m_module->f64Constants().clear();
+        break;
+    case Section::Signatures:
+        m_module->signatures().clear();
+        break;
+    case Section::FunctionImports:
+        m_module->functionImports().clear();
+        m_module->functionImportSignatures().clear();
+        m_module->importedFunctions().clear();
+        break;
+    case Section::Globals:
+        m_module->globalVariableTypes().clear();
+        m_module->globalVariables().clear();
+        break;
+    case Section::FunctionDeclarations:
+        m_module->functionDeclarations().clear();
+        m_module->functions().clear();
+        m_module->functionStartOffsetsInSource().clear();
+        m_module->functionStackHeights().clear();
+        break;
+    case Section::FunctionPointerTables:
+        m_module->functionPointerTables().clear();
+        break;
+    default:
+        // The header has no side effects, and exports are plain puts that are safe to repeat.
+        break;
+    }
+}
+
+void WASMModuleParser::parseHeader()
 {
     uint32_t magicNumber;
     READ_UINT32_OR_FAIL(magicNumber, "Cannot read the magic number.");
@@ -78,25 +207,6 @@ void WASMModuleParser::parseModule(ExecState* exec)
 
     uint32_t outputSizeInASMJS;
     READ_UINT32_OR_FAIL(outputSizeInASMJS, "Cannot read the output size in asm.js format.");
-
-    parseConstantPoolSection();
-    PROPAGATE_ERROR();
-    parseSignatureSection();
-    PROPAGATE_ERROR();
-    parseFunctionImportSection(exec);
-    PROPAGATE_ERROR();
-    parseGlobalSection(exec);
-    PROPAGATE_ERROR();
-    parseFunctionDeclarationSection();
-    PROPAGATE_ERROR();
-    parseFunctionPointerTableSection();
-    PROPAGATE_ERROR();
-    parseFunctionDefinitionSection();
-    PROPAGATE_ERROR();
-    parseExportSection();
-    PROPAGATE_ERROR();
-
-    FAIL_IF_FALSE(!m_module->arrayBuffer() || m_module->arrayBuffer()->impl()->byteLength() < (1u << 31), "The ArrayBuffer's length must be less than 2^31.");
 }
 
 void WASMModuleParser::parseConstantPoolSection()
@@ -293,7 +403,7 @@ void WASMModuleParser::parseFunctionPointerTableSection()
 
 void WASMModuleParser::parseFunctionDefinitionSection()
 {
-    for (size_t functionIndex = 0; functionIndex < m_module->functionDeclarations().size(); ++functionIndex) {
+    for (size_t functionIndex = m_module->functions().size(); functionIndex < m_module->functionDeclarations().size(); ++functionIndex) {
         parseFunctionDefinition(functionIndex);
         PROPAGATE_ERROR();
     }
@@ -310,7 +420,7 @@ void WASMModuleParser::parseFunctionDefinition(size_t functionIndex)
     unsigned endOffsetInSource;
     unsigned stackHeight;
     String errorMessage;
-    if (!WASMFunctionParser::checkSyntax(m_module.get(), m_source, functionIndex, startOffsetInSource, endOffsetInSource, stackHeight, errorMessage)) {
+    if (!WASMFunctionParser::checkSyntax(m_module.get(), m_source, functionIndex, startOffsetInSource, endOffsetInSource, stackHeight, errorMessage, m_functionDidReadPastEnd)) {
         m_errorMessage = errorMessage;
         return;
     }
@@ -41,13 +41,36 @@ class JSWASMModule;
 class SourceCode;
 class VM;
 
+// The parser can also be fed a module as its bytes arrive. The embedder creates the SourceCode
+// over a WebAssemblySourceProvider holding whatever has been received so far, hands each later
+// chunk to appendBytes(), and calls finish() at the end of the stream. Each call parses as far as
+// the available bytes allow, so function bodies are validated while the rest is still loading.
 class WASMModuleParser {
 public:
-    WASMModuleParser(VM&, JSGlobalObject*, const SourceCode&, JSObject* imports, JSArrayBuffer*);
+    JS_EXPORT_PRIVATE WASMModuleParser(VM&, JSGlobalObject*, const SourceCode&, JSObject* imports, JSArrayBuffer*);
     JSWASMModule* parse(ExecState*, String& errorMessage);
 
+    JS_EXPORT_PRIVATE bool appendBytes(ExecState*, const uint8_t*, size_t length, String& errorMessage);
+    JS_EXPORT_PRIVATE JSWASMModule* finish(ExecState*, String& errorMessage);
+
 private:
-    void parseModule(ExecState*);
+    enum class Section {
+        Header,
+        ConstantPool,
+        Signatures,
+        FunctionImports,
+        Globals,
+        FunctionDeclarations,
+        FunctionPointerTables,
+        FunctionDefinitions,
+        Exports,
+        Done
+    };
+
+    void parseAvailableBytes(ExecState*);
+    void parseSection(ExecState*);
+    void discardPartialSection();
+    void parseHeader();
     void parseConstantPoolSection();
     void parseSignatureSection();
     void parseFunctionImportSection(ExecState*);
@@ -66,6 +89,9 @@ private:
     WASMReader m_reader;
     Strong<JSWASMModule> m_module;
     String m_errorMessage;
+    Section m_section;
+    bool m_hasAllBytes;
+    bool m_functionDidReadPastEnd;
 };
 
 JS_EXPORT_PRIVATE JSWASMModule* parseWebAssembly(ExecState*, const SourceCode&, JSObject* imports, JSArrayBuffer*, String& errorMessage);
@@ -47,7 +47,7 @@
 
 #include <wtf/text/StringBuilder.h>
 
-#define CHECK_READ(length) do { if (m_cursor + length > m_buffer.end()) return false; } while (0)
+#define CHECK_READ(length) do { if (m_cursor + length > m_buffer.end()) { m_didReadPastEnd = true; return false; } } while (0)
 
 namespace JSC {
 
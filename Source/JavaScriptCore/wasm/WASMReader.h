@@ -39,11 +39,20 @@ public:
     WASMReader(const Vector<uint8_t>& buffer)
         : m_buffer(buffer)
         , m_cursor(buffer.data())
+        , m_didReadPastEnd(false)
     {
     }
 
     unsigned offset() const { return m_cursor - m_buffer.data(); }
-    void setOffset(unsigned offset) { m_cursor = m_buffer.data() + offset; }
+    void setOffset(unsigned offset)
+    {
+        m_cursor = m_buffer.data() + offset;
+        m_didReadPastEnd = false;
+    }
+
+    // True if a read failed only because the buffer ended, which for a module that is still
+    // arriving means that the read should be retried once more bytes have been appended.
+    bool didReadPastEnd() const { return m_didReadPastEnd; }
 
     bool readUInt32(uint32_t& result);
     bool readFloat(float& result);
@@ -70,6 +79,7 @@ private:
 
     const Vector<uint8_t>& m_buffer;
     const uint8_t* m_cursor;
+    bool m_didReadPastEnd;
 };
 
 } // namespace JSC
@@ -375,6 +375,11 @@ class YarrGenerator : private MacroAssembler {
         // FIXME: should be able to ASSERT(compileMode == IncludeSubpatterns), but then this function is conditionally NORETURN. :-(
         store32(TrustedImm32(-1), Address(output, (subpattern << 1) * sizeof(int)));
     }
+    void clearSubpatternEnd(unsigned subpattern)
+    {
+        ASSERT(subpattern);
+        store32(TrustedImm32(-1), Address(output, ((subpattern << 1) + 1) * sizeof(int)));
+    }
 
     // We use one of three different strategies to track the start of the current match,
     // while matching.
@@ -1225,6 +1230,92 @@ class YarrGenerator : private MacroAssembler {
     {
         backtrackTermDefault(opIndex);
     }
+
+    // A back reference compares the input at the current position against the text last captured
+    // by its subpattern, consuming as many characters as that capture spans. Only a single,
+    // unquantified back reference is compiled; opCompileAlternative falls back for anything else.
+    void generateBackReference(size_t opIndex)
+    {
+        YarrOp& op = m_ops[opIndex];
+        PatternTerm* term = op.m_term;
+        unsigned subpatternId = term->backReferenceSubpatternId;
+
+        const RegisterID sourceIndex = regT0;
+        const RegisterID character = regT1;
+        // There are only two temporaries, so length is spilled to the frame while comparing.
+        const RegisterID sourceCharacter = length;
+
+        ASSERT(compileMode == IncludeSubpatterns);
+        ASSERT(term->quantityType == QuantifierFixedCount && term->quantityCount == 1);
+
+        storeToFrame(index, term->frameLocation);
+
+        // Like the interpreter, treat a subpattern that has not matched, or is still being matched
+        // as in /(a\1)/, as having captured the empty string.
+        JumpList matchedEmpty;
+        load32(Address(output, (subpatternId << 1) * sizeof(int)), sourceIndex);
+        matchedEmpty.append(branch32(Equal, sourceIndex, TrustedImm32(-1)));
+        load32(Address(output, ((subpatternId << 1) + 1) * sizeof(int)), character);
+        matchedEmpty.append(branch32(Equal, character, TrustedImm32(-1)));
+        sub32(sourceIndex, character);
+        matchedEmpty.append(branchTest32(Zero, character));
+
+        add32(index, character);
+        op.m_jumps.append(branch32(Above, character, length));
+
+        storeToFrame(length, term->frameLocation + 1);
+
+        JumpList mismatches;
+        Label loop(this);
+        readCharacter(term->inputPosition - m_checked, character);
+        if (m_charSize == Char8)
+            load8(BaseIndex(input, sourceIndex, TimesOne, 0), sourceCharacter);
+        else
+            load16(BaseIndex(input, sourceIndex, TimesTwo, 0), sourceCharacter);
+
+        if (m_pattern.m_ignoreCase) {
+            Jump charactersMatch = branch32(Equal, character, sourceCharacter);
+            or32(TrustedImm32(0x20), character);
+            or32(TrustedImm32(0x20), sourceCharacter);
+            mismatches.append(branch32(NotEqual, character, sourceCharacter));
+            // The two now only differ in case if they are letters: ASCII ones, or the Latin-1
+            // letters 0xe0-0xfe other than the division sign. Wider characters never get here.
+            ASSERT(m_charSize == Char8);
+            sub32(TrustedImm32('a'), character);
+            Jump isASCIILetter = branch32(BelowOrEqual, character, TrustedImm32('z' - 'a'));
+            mismatches.append(branch32(Equal, character, TrustedImm32(0xf7 - 'a')));
+            sub32(TrustedImm32(0xe0 - 'a'), character);
+            mismatches.append(branch32(Above, character, TrustedImm32(0xfe - 0xe0)));
+            isASCIILetter.link(this);
+            charactersMatch.link(this);
+        } else
+            mismatches.append(branch32(NotEqual, character, sourceCharacter));
+
+        add32(TrustedImm32(1), index);
+        add32(TrustedImm32(1), sourceIndex);
+        branch32(NotEqual, sourceIndex, Address(output, ((subpatternId << 1) + 1) * sizeof(int))).linkTo(loop, this);
+        loadFromFrame(term->frameLocation + 1, length);
+        Jump matched = jump();
+
+        mismatches.link(this);
+        loadFromFrame(term->frameLocation + 1, length);
+        op.m_jumps.append(jump());
+
+        matched.link(this);
+        matchedEmpty.link(this);
+    }
+    void backtrackBackReference(size_t opIndex)
+    {
+        YarrOp& op = m_ops[opIndex];
+        PatternTerm* term = op.m_term;
+
+        // There is only one way to match a back reference, so on any failure restore the index
+        // from before it and keep backtracking.
+        m_backtrackingState.link(this);
+        op.m_jumps.link(this);
+        loadFromFrame(term->frameLocation, index);
+        m_backtrackingState.fallthrough();
+    }
     
     // Code generation/backtracking for simple terms
     // (pattern characters, character classes, and assertions).
@@ -1288,7 +1379,7 @@ class YarrGenerator : private MacroAssembler {
         case PatternTerm::TypeParentheticalAssertion:
             RELEASE_ASSERT_NOT_REACHED();
         case PatternTerm::TypeBackReference:
-            m_shouldFallBack = true;
+            generateBackReference(opIndex);
             break;
         case PatternTerm::TypeDotStarEnclosure:
             generateDotStarEnclosure(opIndex);
@@ -1359,7 +1450,7 @@ class YarrGenerator : private MacroAssembler {
             break;
 
         case PatternTerm::TypeBackReference:
-            m_shouldFallBack = true;
+            backtrackBackReference(opIndex);
             break;
         }
     }
@@ -2163,9 +2254,13 @@ class YarrGenerator : private MacroAssembler {
                 if ((term->capture() && compileMode == IncludeSubpatterns) || term->quantityType == QuantifierGreedy) {
                     m_backtrackingState.link(this);
 
-                    // If capturing, clear the capture (we only need to reset start).
-                    if (term->capture() && compileMode == IncludeSubpatterns)
+                    // If capturing, clear the capture. Resetting start is enough for the results,
+                    // but a back reference reads both ends.
+                    if (term->capture() && compileMode == IncludeSubpatterns) {
                         clearSubpatternStart(term->parentheses.subpatternId);
+                        if (m_pattern.m_containsBackreferences)
+                            clearSubpatternEnd(term->parentheses.subpatternId);
+                    }
 
                     // If Greedy, jump to the end.
                     if (term->quantityType == QuantifierGreedy) {
@@ -2334,7 +2429,7 @@ class YarrGenerator : private MacroAssembler {
             parenthesesEndOpCode = OpParenthesesSubpatternTerminalEnd;
         } else {
             // This subpattern is not supported by the JIT.
-            m_shouldFallBack = true;
+            fallBack("quantified parentheses that can backtrack");
             return;
         }
 
@@ -2448,6 +2543,19 @@ class YarrGenerator : private MacroAssembler {
                 opCompileParentheticalAssertion(term);
                 break;
 
+            case PatternTerm::TypeBackReference:
+                // Back references need the captures, which are only recorded when matching with
+                // subpatterns. Case-insensitive ones are only compiled for 8-bit input, where
+                // case folding is a matter of one bit.
+                if (compileMode == MatchOnly)
+                    fallBack("back reference when matching without subpatterns");
+                else if (term->quantityType != QuantifierFixedCount || term->quantityCount != 1)
+                    fallBack("quantified back reference");
+                else if (m_pattern.m_ignoreCase && m_charSize == Char16)
+                    fallBack("case-insensitive back reference in 16-bit input");
+                m_ops.append(term);
+                break;
+
             default:
                 m_ops.append(term);
             }
@@ -2613,12 +2721,20 @@ class YarrGenerator : private MacroAssembler {
         ret();
     }
 
+    void fallBack(const char* reason)
+    {
+        if (!m_shouldFallBack)
+            m_fallBackReason = reason;
+        m_shouldFallBack = true;
+    }
+
 public:
     YarrGenerator(YarrPattern& pattern, YarrCharSize charSize)
         : m_pattern(pattern)
         , m_charSize(charSize)
         , m_charScale(m_charSize == Char8 ? TimesOne: TimesTwo)
         , m_shouldFallBack(false)
+        , m_fallBackReason(nullptr)
         , m_checked(0)
     {
     }
@@ -2646,7 +2762,7 @@ public:
         opCompileBody(m_pattern.m_body);
 
         if (m_shouldFallBack) {
-            jitObject.setFallBack(true);
+            jitObject.setFallBack(true, m_fallBackReason);
             return;
         }
 
@@ -2655,7 +2771,7 @@ public:
 
         LinkBuffer linkBuffer(*vm, *this, REGEXP_CODE_ID, JITCompilationCanFail);
         if (linkBuffer.didFailToAllocate()) {
-            jitObject.setFallBack(true);
+            jitObject.setFallBack(true, "executable memory exhausted");
             return;
         }
 
@@ -2672,7 +2788,7 @@ public:
             else
                 jitObject.set16BitCode(FINALIZE_CODE(linkBuffer, ("16-bit regular expression")));
         }
-        jitObject.setFallBack(m_shouldFallBack);
+        jitObject.setFallBack(m_shouldFallBack, m_fallBackReason);
     }
 
 private:
@@ -2685,6 +2801,7 @@ private:
     // Used to detect regular expression constructs that are not currently
     // supported in the JIT; fall back to the interpreter when this is detected.
     bool m_shouldFallBack;
+    const char* m_fallBackReason;
 
     // The regular expression expressed as a linear sequence of operations.
     Vector<YarrOp, 128> m_ops;
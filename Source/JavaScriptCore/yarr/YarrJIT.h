@@ -63,6 +63,7 @@ class YarrCodeBlock {
 public:
     YarrCodeBlock()
         : m_needFallBack(false)
+        , m_fallBackReason(nullptr)
     {
     }
 
@@ -70,8 +71,13 @@ public:
     {
     }
 
-    void setFallBack(bool fallback) { m_needFallBack = fallback; }
+    void setFallBack(bool fallback, const char* reason = nullptr)
+    {
+        m_needFallBack = fallback;
+        m_fallBackReason = fallback ? reason : nullptr;
+    }
     bool isFallBack() { return m_needFallBack; }
+    const char* fallBackReason() const { return m_fallBackReason; }
 
     bool has8BitCode() { return m_ref8.size(); }
     bool has16BitCode() { return m_ref16.size(); }
@@ -83,6 +89,8 @@ public:
     void set8BitCodeMatchOnly(MacroAssemblerCodeRef matchOnly) { m_matchOnly8 = matchOnly; }
     void set16BitCodeMatchOnly(MacroAssemblerCodeRef matchOnly) { m_matchOnly16 = matchOnly; }
 
+    size_t size() const { return m_ref8.size() + m_ref16.size() + m_matchOnly8.size() + m_matchOnly16.size(); }
+
     MatchResult execute(const LChar* input, unsigned start, unsigned length, int* output)
     {
         ASSERT(has8BitCode());
@@ -148,6 +156,7 @@ public:
         m_matchOnly8 = MacroAssemblerCodeRef();
         m_matchOnly16 = MacroAssemblerCodeRef();
         m_needFallBack = false;
+        m_fallBackReason = nullptr;
     }
 
 private:
@@ -156,6 +165,7 @@ private:
     MacroAssemblerCodeRef m_matchOnly8;
     MacroAssemblerCodeRef m_matchOnly16;
     bool m_needFallBack;
+    const char* m_fallBackReason;
 };
 
 enum YarrJITCompileMode {
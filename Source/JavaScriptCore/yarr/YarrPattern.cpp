@@ -31,6 +31,7 @@
 #include "YarrCanonicalizeUCS2.h"
 #include "YarrParser.h"
 #include <wtf/Vector.h>
+#include <wtf/text/StringBuilder.h>
 
 using namespace WTF;
 
@@ -861,6 +862,28 @@ const char* YarrPattern::compile(const String& patternString)
     return 0;
 }
 
+String YarrPattern::literalPrefix(unsigned maximumLength) const
+{
+    if (m_body->m_alternatives.size() != 1)
+        return String();
+
+    StringBuilder prefix;
+    for (const PatternTerm& term : m_body->m_alternatives[0]->m_terms) {
+        if (term.type != PatternTerm::TypePatternCharacter || term.quantityType != QuantifierFixedCount)
+            break;
+        // When ignoring case, characters with more than one case are either ASCII letters or
+        // have already been turned into character classes.
+        if (m_ignoreCase && isASCIIAlpha(term.patternCharacter))
+            break;
+        unsigned count = term.quantityCount.unsafeGet();
+        if (count > maximumLength - prefix.length())
+            break;
+        for (unsigned i = 0; i < count; ++i)
+            prefix.append(term.patternCharacter);
+    }
+    return prefix.toString();
+}
+
 YarrPattern::YarrPattern(const String& pattern, bool ignoreCase, bool multiline, const char** error)
     : m_ignoreCase(ignoreCase)
     , m_multiline(multiline)
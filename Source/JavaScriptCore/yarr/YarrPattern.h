@@ -333,6 +333,10 @@ struct YarrPattern {
         return m_containsUnsignedLengthPattern;
     }
 
+    // The characters every match has to start with, up to maximumLength of them. Empty if the
+    // pattern has more than one top-level alternative or does not start with a literal.
+    String literalPrefix(unsigned maximumLength) const;
+
     CharacterClass* newlineCharacterClass()
     {
         if (!newlineCached) {
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+// On Mac, you can build this like so:
+// clang++ -o HashMapSpeedTest Source/WTF/benchmarks/HashMapSpeedTest.cpp -O3 -W -ISource/WTF -LWebKitBuild/Release -lWTF -framework Foundation -licucore -std=c++11
+
+#include "config.h"
+
+#include <stdio.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/HashMap.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/SwissHashMap.h>
+#include <wtf/Vector.h>
+
+namespace {
+
+unsigned numEntries;
+unsigned numLookups;
+
+NO_RETURN void usage()
+{
+    printf("Usage: HashMapSpeedTest hashmap|swisshashmap|all <num entries> <num lookups>\n");
+    exit(1);
+}
+
+// Keys are spread out so that the tables, rather than the keys, decide where entries land. Half
+// of the lookups miss.
+unsigned keyForIndex(unsigned index)
+{
+    return index * 2654435761U | 1;
+}
+
+template<typename MapType>
+void runBenchmark(const char* name)
+{
+    Vector<unsigned> keys;
+    keys.reserveInitialCapacity(numLookups);
+    for (unsigned i = 0; i < numLookups; ++i) {
+        unsigned index = (i * 7919) % numEntries;
+        keys.uncheckedAppend(i & 1 ? keyForIndex(index) : keyForIndex(index) + 1);
+    }
+
+    MapType map;
+
+    double before = monotonicallyIncreasingTimeMS();
+    for (unsigned i = 0; i < numEntries; ++i)
+        map.add(keyForIndex(i), i);
+    double afterAdding = monotonicallyIncreasingTimeMS();
+
+    unsigned found = 0;
+    for (unsigned key : keys)
+        found += map.contains(key);
+    double afterLookups = monotonicallyIncreasingTimeMS();
+
+    for (unsigned i = 0; i < numEntries; ++i)
+        map.remove(keyForIndex(i));
+    double afterRemoving = monotonicallyIncreasingTimeMS();
+
+    printf("%s: add %.3lf ms, lookup %.3lf ms (%u found), remove %.3lf ms.\n",
+        name, afterAdding - before, afterLookups - afterAdding, found, afterRemoving - afterLookups);
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    if (argc != 4
+        || sscanf(argv[2], "%u", &numEntries) != 1
+        || sscanf(argv[3], "%u", &numLookups) != 1
+        || !numEntries)
+        usage();
+
+    bool didRun = false;
+    if (!strcmp(argv[1], "hashmap") || !strcmp(argv[1], "all")) {
+        runBenchmark<HashMap<unsigned, unsigned>>("WTF HashMap");
+        didRun = true;
+    }
+    if (!strcmp(argv[1], "swisshashmap") || !strcmp(argv[1], "all")) {
+        runBenchmark<SwissHashMap<unsigned, unsigned>>("WTF SwissHashMap");
+        didRun = true;
+    }
+
+    if (!didRun)
+        usage();
+
+    return 0;
+}
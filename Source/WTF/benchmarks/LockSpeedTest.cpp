@@ -31,6 +31,8 @@
 #include <unistd.h>
 #include <wtf/CurrentTime.h>
 #include <wtf/Lock.h>
+#include <wtf/RWLock.h>
+#include <wtf/SeqLock.h>
 #include <wtf/StdLibExtras.h>
 #include <wtf/Threading.h>
 #include <wtf/ThreadingPrimitives.h>
@@ -72,13 +74,33 @@ unsigned numThreadsPerGroup;
 unsigned workPerCriticalSection;
 unsigned numNoiseThreads;
 unsigned numIterations;
+unsigned percentWrites = 100;
     
 NO_RETURN void usage()
 {
-    printf("Usage: LockSpeedTest spinlock|wordlock|lock|mutex|all <num thread groups> <num threads per group> <work per critical section> <num noise threads> <num iterations>\n");
+    printf("Usage: LockSpeedTest spinlock|wordlock|lock|mutex|rwlock|seqlock|all <num thread groups> <num threads per group> <work per critical section> <num noise threads> <num iterations> [<percent writes>]\n");
     exit(1);
 }
 
+// Iterations that don't write only read the protected word. Exclusive locks have to serialize those
+// readers anyway, which is what we want to compare the reader-writer locks against.
+template<typename LockType>
+struct ReadLocking {
+    static void lockShared(LockType& lock) { lock.lock(); }
+    static void unlockShared(LockType& lock) { lock.unlock(); }
+};
+
+template<>
+struct ReadLocking<RWLock> {
+    static void lockShared(RWLock& lock) { lock.lockShared(); }
+    static void unlockShared(RWLock& lock) { lock.unlockShared(); }
+};
+
+bool isWriteIteration(unsigned iteration)
+{
+    return iteration % 100 < percentWrites;
+}
+
 template<typename LockType>
 void runBenchmark(const char* name)
 {
@@ -108,7 +130,17 @@ void runBenchmark(const char* name)
             threads[threadGroupIndex * numThreadsPerGroup + threadIndex] = createThread(
                 "Benchmark thread",
                 [threadGroupIndex, &locks, &words] () {
+                    volatile double readResult;
                     for (unsigned i = numIterations; i--;) {
+                        if (!isWriteIteration(i)) {
+                            ReadLocking<LockType>::lockShared(locks[threadGroupIndex]);
+                            double value = words[threadGroupIndex];
+                            for (unsigned j = workPerCriticalSection; j--;)
+                                value = (value + 1) * 1.01;
+                            readResult = value;
+                            ReadLocking<LockType>::unlockShared(locks[threadGroupIndex]);
+                            continue;
+                        }
                         locks[threadGroupIndex].lock();
                         for (unsigned j = workPerCriticalSection; j--;) {
                             words[threadGroupIndex]++;
@@ -134,18 +166,80 @@ void runBenchmark(const char* name)
     printf("%s: %.3lf ms, %.0lf noise.\n", name, after - before, noiseCount);
 }
 
+// A SeqLock holds its data, so it can't share runBenchmark(). The work happens on a copy of the word.
+void runSeqLockBenchmark(const char* name)
+{
+    std::unique_ptr<SeqLock<double>[]> words = std::make_unique<SeqLock<double>[]>(numThreadGroups);
+    std::unique_ptr<ThreadIdentifier[]> threads = std::make_unique<ThreadIdentifier[]>(numThreadGroups * numThreadsPerGroup);
+    std::unique_ptr<ThreadIdentifier[]> noiseThreads = std::make_unique<ThreadIdentifier[]>(numNoiseThreads);
+    std::unique_ptr<double[]> noiseCounts = std::make_unique<double[]>(numNoiseThreads);
+
+    volatile bool shouldStop = false;
+    for (unsigned threadIndex = numNoiseThreads; threadIndex--;) {
+        noiseCounts[threadIndex] = 0;
+        noiseThreads[threadIndex] = createThread(
+            "Noise Thread",
+            [&shouldStop, &noiseCounts, threadIndex] () {
+                while (!shouldStop)
+                    noiseCounts[threadIndex]++;
+            });
+    }
+
+    double before = monotonicallyIncreasingTimeMS();
+
+    for (unsigned threadGroupIndex = numThreadGroups; threadGroupIndex--;) {
+        for (unsigned threadIndex = numThreadsPerGroup; threadIndex--;) {
+            threads[threadGroupIndex * numThreadsPerGroup + threadIndex] = createThread(
+                "Benchmark thread",
+                [threadGroupIndex, &words] () {
+                    volatile double readResult;
+                    for (unsigned i = numIterations; i--;) {
+                        if (!isWriteIteration(i)) {
+                            double value = words[threadGroupIndex].load();
+                            for (unsigned j = workPerCriticalSection; j--;)
+                                value = (value + 1) * 1.01;
+                            readResult = value;
+                            continue;
+                        }
+                        words[threadGroupIndex].update(
+                            [] (double& value) {
+                                for (unsigned j = workPerCriticalSection; j--;) {
+                                    value++;
+                                    value *= 1.01;
+                                }
+                            });
+                    }
+                });
+        }
+    }
+
+    for (unsigned threadIndex = numThreadGroups * numThreadsPerGroup; threadIndex--;)
+        waitForThreadCompletion(threads[threadIndex]);
+    shouldStop = true;
+    double noiseCount = 0;
+    for (unsigned threadIndex = numNoiseThreads; threadIndex--;) {
+        waitForThreadCompletion(noiseThreads[threadIndex]);
+        noiseCount += noiseCounts[threadIndex];
+    }
+
+    double after = monotonicallyIncreasingTimeMS();
+
+    printf("%s: %.3lf ms, %.0lf noise.\n", name, after - before, noiseCount);
+}
+
 } // anonymous namespace
 
 int main(int argc, char** argv)
 {
     WTF::initializeThreading();
     
-    if (argc != 7
+    if ((argc != 7 && argc != 8)
         || sscanf(argv[2], "%u", &numThreadGroups) != 1
         || sscanf(argv[3], "%u", &numThreadsPerGroup) != 1
         || sscanf(argv[4], "%u", &workPerCriticalSection) != 1
         || sscanf(argv[5], "%u", &numNoiseThreads) != 1
-        || sscanf(argv[6], "%u", &numIterations) != 1)
+        || sscanf(argv[6], "%u", &numIterations) != 1
+        || (argc == 8 && (sscanf(argv[7], "%u", &percentWrites) != 1 || percentWrites > 100)))
         usage();
 
     bool didRun = false;
@@ -165,6 +259,14 @@ int main(int argc, char** argv)
         runBenchmark<Mutex>("Platform Mutex");
         didRun = true;
     }
+    if (!strcmp(argv[1], "rwlock") || !strcmp(argv[1], "all")) {
+        runBenchmark<RWLock>("WTF RWLock");
+        didRun = true;
+    }
+    if (!strcmp(argv[1], "seqlock") || !strcmp(argv[1], "all")) {
+        runSeqLockBenchmark("WTF SeqLock");
+        didRun = true;
+    }
 
     if (!didRun)
         usage();
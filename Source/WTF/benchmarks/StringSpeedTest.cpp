@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+// On Mac, you can build this like so:
+// clang++ -o StringSpeedTest Source/WTF/benchmarks/StringSpeedTest.cpp -O3 -W -ISource/WTF -LWebKitBuild/Release -lWTF -framework Foundation -licucore -std=c++11
+
+#include "config.h"
+
+#include <stdio.h>
+#include <wtf/CurrentTime.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/text/WTFString.h>
+
+namespace {
+
+unsigned stringLength;
+unsigned numIterations;
+
+NO_RETURN void usage()
+{
+    printf("Usage: StringSpeedTest find|reverseFind|containsOnlyASCII|lower|all <string length> <num iterations>\n");
+    exit(1);
+}
+
+// Builds a string of lowercase ASCII letters in which 'z' only appears as the last character, so
+// that find('z') and reverseFind('{') both have to scan the whole string.
+String makeString(bool is8Bit)
+{
+    Vector<UChar> characters(stringLength);
+    for (unsigned i = 0; i < stringLength; ++i)
+        characters[i] = 'a' + i % 25;
+    if (stringLength)
+        characters[stringLength - 1] = 'z';
+    if (is8Bit)
+        return String::make8BitFrom16BitSource(characters.data(), characters.size());
+    return String(characters.data(), characters.size());
+}
+
+template<typename Functor>
+void runBenchmark(const char* name, const Functor& functor)
+{
+    for (bool is8Bit : { true, false }) {
+        String string = makeString(is8Bit);
+        size_t checksum = 0;
+
+        double before = monotonicallyIncreasingTimeMS();
+        for (unsigned i = numIterations; i--;)
+            checksum += functor(string);
+        double after = monotonicallyIncreasingTimeMS();
+
+        printf("%s (%s): %.3lf ms, checksum %zu.\n", name, is8Bit ? "8-bit" : "16-bit", after - before, checksum);
+    }
+}
+
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    if (argc != 4
+        || sscanf(argv[2], "%u", &stringLength) != 1
+        || sscanf(argv[3], "%u", &numIterations) != 1)
+        usage();
+
+    bool didRun = false;
+    if (!strcmp(argv[1], "find") || !strcmp(argv[1], "all")) {
+        runBenchmark("find", [] (const String& string) { return string.find('z'); });
+        didRun = true;
+    }
+    if (!strcmp(argv[1], "reverseFind") || !strcmp(argv[1], "all")) {
+        runBenchmark("reverseFind", [] (const String& string) { return string.reverseFind('{'); });
+        didRun = true;
+    }
+    if (!strcmp(argv[1], "containsOnlyASCII") || !strcmp(argv[1], "all")) {
+        runBenchmark("containsOnlyASCII", [] (const String& string) { return static_cast<size_t>(string.containsOnlyASCII()); });
+        didRun = true;
+    }
+    if (!strcmp(argv[1], "lower") || !strcmp(argv[1], "all")) {
+        runBenchmark("lower", [] (const String& string) { return string.lower().length(); });
+        didRun = true;
+    }
+
+    if (!didRun)
+        usage();
+
+    return 0;
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+#include "config.h"
+#include "Arena.h"
+
+namespace WTF {
+
+Arena::Arena(size_t chunkSize)
+    : m_chunkSize(chunkSize)
+    , m_chunks(nullptr)
+    , m_current(nullptr)
+    , m_end(nullptr)
+    , m_lastAllocation(nullptr)
+    , m_bytesReserved(0)
+{
+    ASSERT(chunkSize > chunkHeaderSize);
+}
+
+Arena::~Arena()
+{
+    clear();
+}
+
+void Arena::clear()
+{
+    while (Chunk* chunk = m_chunks) {
+        m_chunks = chunk->next;
+        fastFree(chunk);
+    }
+    m_current = nullptr;
+    m_end = nullptr;
+    m_lastAllocation = nullptr;
+    m_bytesReserved = 0;
+}
+
+Arena::Chunk* Arena::allocateChunk(size_t payloadSize)
+{
+    if (payloadSize > std::numeric_limits<size_t>::max() - chunkHeaderSize)
+        CRASH();
+    size_t size = chunkHeaderSize + payloadSize;
+    Chunk* chunk = static_cast<Chunk*>(fastMalloc(size));
+    chunk->next = m_chunks;
+    chunk->size = size;
+    m_chunks = chunk;
+    m_bytesReserved += size;
+    return chunk;
+}
+
+void* Arena::allocateSlow(size_t allocationSize)
+{
+    size_t payloadSize = m_chunkSize - chunkHeaderSize;
+
+    // Allocations that would use up most of a chunk get a chunk of their own, so that the
+    // space left in the current chunk is not wasted.
+    if (allocationSize > payloadSize / 2) {
+        Chunk* chunk = allocateChunk(allocationSize);
+        char* result = reinterpret_cast<char*>(chunk) + chunkHeaderSize + headerSize;
+        sizeOfAllocation(result) = allocationSize;
+        return result;
+    }
+
+    Chunk* chunk = allocateChunk(payloadSize);
+    m_current = reinterpret_cast<char*>(chunk) + chunkHeaderSize;
+    m_end = reinterpret_cast<char*>(chunk) + chunk->size;
+    return bump(allocationSize);
+}
+
+void* Arena::reallocate(void* p, size_t newSize)
+{
+    if (!p)
+        return allocate(newSize);
+
+    size_t oldAllocationSize = sizeOfAllocation(p);
+    size_t newAllocationSize = allocationSizeFor(newSize);
+
+    // Grow or shrink in place if this is the most recent allocation.
+    if (p == m_lastAllocation) {
+        char* start = static_cast<char*>(p) - headerSize;
+        if (newAllocationSize <= static_cast<size_t>(m_end - start)) {
+            m_current = start + newAllocationSize;
+            sizeOfAllocation(p) = newAllocationSize;
+            return p;
+        }
+    } else if (newAllocationSize <= oldAllocationSize)
+        return p;
+
+    void* result = allocate(newSize);
+    memcpy(result, p, std::min(oldAllocationSize, newAllocationSize) - headerSize);
+    return result;
+}
+
+} // namespace WTF
@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+#ifndef WTF_Arena_h
+#define WTF_Arena_h
+
+#include <limits>
+#include <string.h>
+#include <wtf/FastMalloc.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/StdLibExtras.h>
+#include <wtf/WTFThreadData.h>
+
+namespace WTF {
+
+// A bump pointer allocator for short-lived temporaries. All memory handed out by an Arena is
+// released at once when the arena is cleared or destroyed; deallocate() only gives memory back
+// if it was the most recent allocation.
+//
+// Containers can place their storage in the arena that is current on this thread by using the
+// ArenaMalloc policy, for example Vector<T, 0, CrashOnOverflow, 16, ArenaMalloc> or
+// HashMap<K, V, H, KT, VT, ArenaMalloc>. Such containers must only grow while the arena is
+// current, and must be destroyed before the arena is.
+class Arena {
+    WTF_MAKE_NONCOPYABLE(Arena);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    static const size_t defaultChunkSize = 16 * KB;
+    static const size_t alignment = 8;
+
+    WTF_EXPORT_PRIVATE explicit Arena(size_t chunkSize = defaultChunkSize);
+    WTF_EXPORT_PRIVATE ~Arena();
+
+    void* allocate(size_t size)
+    {
+        size_t allocationSize = allocationSizeFor(size);
+        if (allocationSize > static_cast<size_t>(m_end - m_current))
+            return allocateSlow(allocationSize);
+        return bump(allocationSize);
+    }
+
+    WTF_EXPORT_PRIVATE void* reallocate(void*, size_t);
+
+    void deallocate(void* p)
+    {
+        if (!p || p != m_lastAllocation)
+            return;
+        m_current = static_cast<char*>(p) - headerSize;
+        m_lastAllocation = nullptr;
+    }
+
+    // Releases all memory owned by this arena.
+    WTF_EXPORT_PRIVATE void clear();
+
+    size_t bytesReserved() const { return m_bytesReserved; }
+
+    static Arena* current() { return wtfThreadData().currentArena(); }
+
+    // Makes an arena the current one on this thread for the lifetime of the scope.
+    class Scope {
+        WTF_MAKE_NONCOPYABLE(Scope);
+    public:
+        explicit Scope(Arena& arena)
+            : m_previousArena(wtfThreadData().setCurrentArena(&arena))
+        {
+        }
+
+        ~Scope()
+        {
+            wtfThreadData().setCurrentArena(m_previousArena);
+        }
+
+    private:
+        Arena* m_previousArena;
+    };
+
+private:
+    struct Chunk {
+        Chunk* next;
+        size_t size;
+    };
+
+    static const size_t headerSize = alignment;
+    static const size_t chunkHeaderSize = (sizeof(Chunk) + alignment - 1) & ~(alignment - 1);
+
+    static size_t allocationSizeFor(size_t size)
+    {
+        if (size > std::numeric_limits<size_t>::max() - headerSize - alignment)
+            CRASH();
+        return roundUpToMultipleOf<alignment>(size + headerSize);
+    }
+
+    static size_t& sizeOfAllocation(void* p) { return *reinterpret_cast<size_t*>(static_cast<char*>(p) - headerSize); }
+
+    void* bump(size_t allocationSize)
+    {
+        char* result = m_current + headerSize;
+        m_current += allocationSize;
+        m_lastAllocation = result;
+        sizeOfAllocation(result) = allocationSize;
+        return result;
+    }
+
+    WTF_EXPORT_PRIVATE void* allocateSlow(size_t allocationSize);
+    Chunk* allocateChunk(size_t payloadSize);
+
+    size_t m_chunkSize;
+    Chunk* m_chunks;
+    char* m_current;
+    char* m_end;
+    void* m_lastAllocation;
+    size_t m_bytesReserved;
+};
+
+// Allocation policy that places container storage in Arena::current().
+struct ArenaMalloc {
+    static void* malloc(size_t size) { return currentArena().allocate(size); }
+
+    static void* tryMalloc(size_t size) { return malloc(size); }
+
+    static void* zeroedMalloc(size_t size)
+    {
+        void* result = malloc(size);
+        memset(result, 0, size);
+        return result;
+    }
+
+    static void* realloc(void* p, size_t size) { return currentArena().reallocate(p, size); }
+
+    // Freeing is allowed after the scope has ended. The memory is then reclaimed along with
+    // the rest of the arena.
+    static void free(void* p)
+    {
+        if (Arena* arena = Arena::current())
+            arena->deallocate(p);
+    }
+
+private:
+    static Arena& currentArena()
+    {
+        Arena* arena = Arena::current();
+        RELEASE_ASSERT(arena);
+        return *arena;
+    }
+};
+
+} // namespace WTF
+
+using WTF::Arena;
+using WTF::ArenaMalloc;
+
+#endif // WTF_Arena_h
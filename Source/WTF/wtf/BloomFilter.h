@@ -61,6 +61,11 @@ public:
     bool mayContain(const AtomicString& string) const { return mayContain(string.impl()->existingHash()); }
     bool mayContain(const String& string) const { return mayContain(string.impl()->hash()); }
 
+    // The raw table, for persisting the filter.
+    static const size_t dataSize = tableSize / 8;
+    const uint8_t* data() const { return reinterpret_cast<const uint8_t*>(m_bitArray.data()); }
+    uint8_t* data() { return reinterpret_cast<uint8_t*>(m_bitArray.data()); }
+
 private:
     static const unsigned bitsPerPosition = 8 * sizeof(unsigned);
     static const unsigned keyMask = (1 << keyBits) - 1;
@@ -161,6 +161,7 @@ void* fastRealloc(void* p, size_t n)
 
 void releaseFastMallocFreeMemory() { }
 void releaseFastMallocFreeMemoryForThisThread() { }
+void setFastMallocIsUnderMemoryPressure(bool) { }
     
 FastMallocStatistics fastMallocStatistics()
 {
@@ -168,6 +169,22 @@ FastMallocStatistics fastMallocStatistics()
     return statistics;
 }
 
+void* fastIsolatedMalloc(FastMallocIsolatedHeap, size_t size)
+{
+    return fastMalloc(size);
+}
+
+void fastIsolatedFree(FastMallocIsolatedHeap, void* p)
+{
+    fastFree(p);
+}
+
+FastMallocStatistics fastIsolatedMallocStatistics(FastMallocIsolatedHeap)
+{
+    FastMallocStatistics statistics = { 0, 0, 0 };
+    return statistics;
+}
+
 size_t fastMallocSize(const void* p)
 {
 #if OS(DARWIN)
@@ -260,6 +277,33 @@ void releaseFastMallocFreeMemory()
     bmalloc::api::scavenge();
 }
 
+void setFastMallocIsUnderMemoryPressure(bool isUnderMemoryPressure)
+{
+    bmalloc::api::setIsUnderMemoryPressure(isUnderMemoryPressure);
+}
+
+static_assert(static_cast<size_t>(FastMallocIsolatedHeap::CSSValues) < bmalloc::isolatedHeapCount, "bmalloc must have a heap for every FastMallocIsolatedHeap");
+
+void* fastIsolatedMalloc(FastMallocIsolatedHeap heap, size_t size)
+{
+    return bmalloc::api::isolatedMalloc(static_cast<size_t>(heap), size);
+}
+
+void fastIsolatedFree(FastMallocIsolatedHeap heap, void* p)
+{
+    bmalloc::api::isolatedFree(static_cast<size_t>(heap), p);
+}
+
+FastMallocStatistics fastIsolatedMallocStatistics(FastMallocIsolatedHeap heap)
+{
+    bmalloc::HeapStatistics heapStatistics = bmalloc::api::isolatedHeapStatistics(static_cast<size_t>(heap));
+    FastMallocStatistics statistics;
+    statistics.reservedVMBytes = 0;
+    statistics.committedVMBytes = heapStatistics.footprint;
+    statistics.freeListBytes = 0;
+    return statistics;
+}
+
 FastMallocStatistics fastMallocStatistics()
 {
 
@@ -63,6 +63,9 @@ WTF_EXPORT_PRIVATE size_t fastMallocGoodSize(size_t);
 WTF_EXPORT_PRIVATE void releaseFastMallocFreeMemory();
 WTF_EXPORT_PRIVATE void releaseFastMallocFreeMemoryForThisThread();
 
+// Lets the allocator return free memory to the OS more eagerly while the process is under memory pressure.
+WTF_EXPORT_PRIVATE void setFastMallocIsUnderMemoryPressure(bool);
+
 struct FastMallocStatistics {
     size_t reservedVMBytes;
     size_t committedVMBytes;
@@ -70,6 +73,20 @@ struct FastMallocStatistics {
 };
 WTF_EXPORT_PRIVATE FastMallocStatistics fastMallocStatistics();
 
+// Isolated heaps give a high-churn family of objects its own pages and thread caches,
+// so the family stays dense and can be scavenged and measured on its own. Memory from
+// an isolated heap must be freed with fastIsolatedFree on the same heap; classes opt in
+// with WTF_MAKE_ISOLATED_ALLOCATED.
+enum class FastMallocIsolatedHeap : unsigned {
+    DOMNodes,
+    RenderObjects,
+    CSSValues,
+};
+
+WTF_EXPORT_PRIVATE void* fastIsolatedMalloc(FastMallocIsolatedHeap, size_t);
+WTF_EXPORT_PRIVATE void fastIsolatedFree(FastMallocIsolatedHeap, void*);
+WTF_EXPORT_PRIVATE FastMallocStatistics fastIsolatedMallocStatistics(FastMallocIsolatedHeap);
+
 // This defines a type which holds an unsigned integer and is the same
 // size as the minimally aligned memory allocation.
 typedef unsigned long long AllocAlignmentInteger;
@@ -97,6 +114,27 @@ template<typename T> inline bool TryMallocReturnValue::getValue(T*& data)
     return data;
 }
 
+// Allocation policy for containers that take a Malloc template parameter (Vector,
+// HashTable). Each policy provides malloc, tryMalloc (which returns null on failure),
+// zeroedMalloc, realloc and free.
+struct FastMalloc {
+    static void* malloc(size_t size) { return fastMalloc(size); }
+
+    static void* tryMalloc(size_t size)
+    {
+        void* result;
+        if (!tryFastMalloc(size).getValue(result))
+            return nullptr;
+        return result;
+    }
+
+    static void* zeroedMalloc(size_t size) { return fastZeroedMalloc(size); }
+
+    static void* realloc(void* p, size_t size) { return fastRealloc(p, size); }
+
+    static void free(void* p) { fastFree(p); }
+};
+
 } // namespace WTF
 
 using WTF::fastCalloc;
@@ -112,6 +150,10 @@ using WTF::tryFastMalloc;
 using WTF::tryFastZeroedMalloc;
 using WTF::fastAlignedMalloc;
 using WTF::fastAlignedFree;
+using WTF::FastMalloc;
+using WTF::FastMallocIsolatedHeap;
+using WTF::fastIsolatedFree;
+using WTF::fastIsolatedMalloc;
 
 #if COMPILER(GCC_OR_CLANG) && OS(DARWIN)
 #define WTF_PRIVATE_INLINE __private_extern__ inline __attribute__((always_inline))
@@ -155,4 +197,36 @@ public: \
 private: \
 typedef int __thisIsHereToForceASemicolonAfterThisMacro
 
+#define WTF_MAKE_ISOLATED_ALLOCATED(heap) \
+public: \
+    void* operator new(size_t, void* p) { return p; } \
+    void* operator new[](size_t, void* p) { return p; } \
+    \
+    void* operator new(size_t size) \
+    { \
+        return ::WTF::fastIsolatedMalloc(::WTF::FastMallocIsolatedHeap::heap, size); \
+    } \
+    \
+    void operator delete(void* p) \
+    { \
+        ::WTF::fastIsolatedFree(::WTF::FastMallocIsolatedHeap::heap, p); \
+    } \
+    \
+    void* operator new[](size_t size) \
+    { \
+        return ::WTF::fastIsolatedMalloc(::WTF::FastMallocIsolatedHeap::heap, size); \
+    } \
+    \
+    void operator delete[](void* p) \
+    { \
+        ::WTF::fastIsolatedFree(::WTF::FastMallocIsolatedHeap::heap, p); \
+    } \
+    void* operator new(size_t, NotNullTag, void* location) \
+    { \
+        ASSERT(location); \
+        return location; \
+    } \
+private: \
+typedef int __thisIsHereToForceASemicolonAfterThisMacro
+
 #endif /* WTF_FastMalloc_h */
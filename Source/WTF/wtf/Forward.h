@@ -33,7 +33,7 @@ template<typename T> class RefPtr;
 template<typename T> class Ref;
 template<typename T> class StringBuffer;
 
-template<typename T, size_t inlineCapacity, typename OverflowHandler, size_t minCapacity> class Vector;
+template<typename T, size_t inlineCapacity, typename OverflowHandler, size_t minCapacity, typename Malloc> class Vector;
 
 class AtomicString;
 class AtomicStringImpl;
@@ -32,7 +32,7 @@ template<typename T> struct KeyValuePairKeyExtractor {
 };
 
 template<typename KeyArg, typename MappedArg, typename HashArg = typename DefaultHash<KeyArg>::Hash,
-    typename KeyTraitsArg = HashTraits<KeyArg>, typename MappedTraitsArg = HashTraits<MappedArg>>
+    typename KeyTraitsArg = HashTraits<KeyArg>, typename MappedTraitsArg = HashTraits<MappedArg>, typename MallocArg = FastMalloc>
 class HashMap final {
     WTF_MAKE_FAST_ALLOCATED;
 private:
@@ -58,7 +58,7 @@ private:
     typedef HashArg HashFunctions;
 
     typedef HashTable<KeyType, KeyValuePairType, KeyValuePairKeyExtractor<KeyValuePairType>,
-        HashFunctions, KeyValuePairTraits, KeyTraits> HashTableType;
+        HashFunctions, KeyValuePairTraits, KeyTraits, MallocArg> HashTableType;
 
     class HashMapKeysProxy;
     class HashMapValuesProxy;
@@ -188,98 +188,98 @@ struct HashMapTranslatorAdapter {
     }
 };
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline void HashMap<T, U, V, W, X>::swap(HashMap& other)
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline void HashMap<T, U, V, W, X, Y>::swap(HashMap& other)
 {
     m_impl.swap(other.m_impl); 
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline unsigned HashMap<T, U, V, W, X>::size() const
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline unsigned HashMap<T, U, V, W, X, Y>::size() const
 {
     return m_impl.size(); 
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline unsigned HashMap<T, U, V, W, X>::capacity() const
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline unsigned HashMap<T, U, V, W, X, Y>::capacity() const
 { 
     return m_impl.capacity(); 
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline bool HashMap<T, U, V, W, X>::isEmpty() const
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline bool HashMap<T, U, V, W, X, Y>::isEmpty() const
 {
     return m_impl.isEmpty();
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline auto HashMap<T, U, V, W, X>::begin() -> iterator
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline auto HashMap<T, U, V, W, X, Y>::begin() -> iterator
 {
     return m_impl.begin();
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline auto HashMap<T, U, V, W, X>::end() -> iterator
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline auto HashMap<T, U, V, W, X, Y>::end() -> iterator
 {
     return m_impl.end();
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline auto HashMap<T, U, V, W, X>::begin() const -> const_iterator
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline auto HashMap<T, U, V, W, X, Y>::begin() const -> const_iterator
 {
     return m_impl.begin();
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline auto HashMap<T, U, V, W, X>::end() const -> const_iterator
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline auto HashMap<T, U, V, W, X, Y>::end() const -> const_iterator
 {
     return m_impl.end();
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline auto HashMap<T, U, V, W, X>::find(const KeyType& key) -> iterator
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline auto HashMap<T, U, V, W, X, Y>::find(const KeyType& key) -> iterator
 {
     return m_impl.find(key);
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline auto HashMap<T, U, V, W, X>::find(const KeyType& key) const -> const_iterator
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline auto HashMap<T, U, V, W, X, Y>::find(const KeyType& key) const -> const_iterator
 {
     return m_impl.find(key);
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline bool HashMap<T, U, V, W, X>::contains(const KeyType& key) const
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline bool HashMap<T, U, V, W, X, Y>::contains(const KeyType& key) const
 {
     return m_impl.contains(key);
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
 template<typename HashTranslator, typename TYPE>
-inline typename HashMap<T, U, V, W, X>::iterator
-HashMap<T, U, V, W, X>::find(const TYPE& value)
+inline typename HashMap<T, U, V, W, X, Y>::iterator
+HashMap<T, U, V, W, X, Y>::find(const TYPE& value)
 {
     return m_impl.template find<HashMapTranslatorAdapter<KeyValuePairTraits, HashTranslator>>(value);
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
 template<typename HashTranslator, typename TYPE>
-inline typename HashMap<T, U, V, W, X>::const_iterator 
-HashMap<T, U, V, W, X>::find(const TYPE& value) const
+inline typename HashMap<T, U, V, W, X, Y>::const_iterator 
+HashMap<T, U, V, W, X, Y>::find(const TYPE& value) const
 {
     return m_impl.template find<HashMapTranslatorAdapter<KeyValuePairTraits, HashTranslator>>(value);
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
 template<typename HashTranslator, typename TYPE>
-inline bool HashMap<T, U, V, W, X>::contains(const TYPE& value) const
+inline bool HashMap<T, U, V, W, X, Y>::contains(const TYPE& value) const
 {
     return m_impl.template contains<HashMapTranslatorAdapter<KeyValuePairTraits, HashTranslator>>(value);
 }
 
-template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg>
+template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg, typename MallocArg>
 template<typename K, typename V>
-auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg>::inlineSet(K&& key, V&& value) -> AddResult
+auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg, MallocArg>::inlineSet(K&& key, V&& value) -> AddResult
 {
     AddResult result = inlineAdd(std::forward<K>(key), std::forward<V>(value));
     if (!result.isNewEntry) {
@@ -289,64 +289,64 @@ auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg>::inlineS
     return result;
 }
 
-template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg>
+template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg, typename MallocArg>
 template<typename K, typename V>
-ALWAYS_INLINE auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg>::inlineAdd(K&& key, V&& value) -> AddResult
+ALWAYS_INLINE auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg, MallocArg>::inlineAdd(K&& key, V&& value) -> AddResult
 {
     return m_impl.template add<HashMapTranslator<KeyValuePairTraits, HashFunctions>>(std::forward<K>(key), std::forward<V>(value));
 }
 
-template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg>
+template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg, typename MallocArg>
 template<typename T>
-auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg>::set(const KeyType& key, T&& mapped) -> AddResult
+auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg, MallocArg>::set(const KeyType& key, T&& mapped) -> AddResult
 {
     return inlineSet(key, std::forward<T>(mapped));
 }
 
-template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg>
+template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg, typename MallocArg>
 template<typename T>
-auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg>::set(KeyType&& key, T&& mapped) -> AddResult
+auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg, MallocArg>::set(KeyType&& key, T&& mapped) -> AddResult
 {
     return inlineSet(WTF::move(key), std::forward<T>(mapped));
 }
 
-template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg>
+template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg, typename MallocArg>
 template<typename HashTranslator, typename K, typename V>
-auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg>::add(K&& key, V&& value) -> AddResult
+auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg, MallocArg>::add(K&& key, V&& value) -> AddResult
 {
     return m_impl.template addPassingHashCode<HashMapTranslatorAdapter<KeyValuePairTraits, HashTranslator>>(std::forward<K>(key), std::forward<V>(value));
 }
 
-template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg>
+template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg, typename MallocArg>
 template<typename T>
-auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg>::add(const KeyType& key, T&& mapped) -> AddResult
+auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg, MallocArg>::add(const KeyType& key, T&& mapped) -> AddResult
 {
     return inlineAdd(key, std::forward<T>(mapped));
 }
 
-template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg>
+template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg, typename MallocArg>
 template<typename T>
-auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg>::add(KeyType&& key, T&& mapped) -> AddResult
+auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg, MallocArg>::add(KeyType&& key, T&& mapped) -> AddResult
 {
     return inlineAdd(WTF::move(key), std::forward<T>(mapped));
 }
 
-template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg>
+template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg, typename MallocArg>
 template<typename T>
-ALWAYS_INLINE auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg>::fastAdd(const KeyType& key, T&& mapped) -> AddResult
+ALWAYS_INLINE auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg, MallocArg>::fastAdd(const KeyType& key, T&& mapped) -> AddResult
 {
     return inlineAdd(key, std::forward<T>(mapped));
 }
 
-template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg>
+template<typename KeyArg, typename MappedArg, typename HashArg, typename KeyTraitsArg, typename MappedTraitsArg, typename MallocArg>
 template<typename T>
-ALWAYS_INLINE auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg>::fastAdd(KeyType&& key, T&& mapped) -> AddResult
+ALWAYS_INLINE auto HashMap<KeyArg, MappedArg, HashArg, KeyTraitsArg, MappedTraitsArg, MallocArg>::fastAdd(KeyType&& key, T&& mapped) -> AddResult
 {
     return inlineAdd(WTF::move(key), std::forward<T>(mapped));
 }
 
-template<typename T, typename U, typename V, typename W, typename MappedTraits>
-auto HashMap<T, U, V, W, MappedTraits>::get(const KeyType& key) const -> MappedPeekType
+template<typename T, typename U, typename V, typename W, typename MappedTraits, typename Y>
+auto HashMap<T, U, V, W, MappedTraits, Y>::get(const KeyType& key) const -> MappedPeekType
 {
     KeyValuePairType* entry = const_cast<HashTableType&>(m_impl).lookup(key);
     if (!entry)
@@ -354,8 +354,8 @@ auto HashMap<T, U, V, W, MappedTraits>::get(const KeyType& key) const -> MappedP
     return MappedTraits::peek(entry->value);
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline bool HashMap<T, U, V, W, X>::remove(iterator it)
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline bool HashMap<T, U, V, W, X, Y>::remove(iterator it)
 {
     if (it.m_impl == m_impl.end())
         return false;
@@ -364,27 +364,27 @@ inline bool HashMap<T, U, V, W, X>::remove(iterator it)
     return true;
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
 template<typename Functor>
-inline void HashMap<T, U, V, W, X>::removeIf(const Functor& functor)
+inline void HashMap<T, U, V, W, X, Y>::removeIf(const Functor& functor)
 {
     m_impl.removeIf(functor);
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline bool HashMap<T, U, V, W, X>::remove(const KeyType& key)
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline bool HashMap<T, U, V, W, X, Y>::remove(const KeyType& key)
 {
     return remove(find(key));
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline void HashMap<T, U, V, W, X>::clear()
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline void HashMap<T, U, V, W, X, Y>::clear()
 {
     m_impl.clear();
 }
 
-template<typename T, typename U, typename V, typename W, typename MappedTraits>
-auto HashMap<T, U, V, W, MappedTraits>::take(const KeyType& key) -> MappedType
+template<typename T, typename U, typename V, typename W, typename MappedTraits, typename Y>
+auto HashMap<T, U, V, W, MappedTraits, Y>::take(const KeyType& key) -> MappedType
 {
     iterator it = find(key);
     if (it == end())
@@ -394,30 +394,30 @@ auto HashMap<T, U, V, W, MappedTraits>::take(const KeyType& key) -> MappedType
     return value;
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
 template<typename K>
-inline auto HashMap<T, U, V, W, X>::find(typename GetPtrHelper<K>::PtrType key) -> typename std::enable_if<IsSmartPtr<K>::value, iterator>::type
+inline auto HashMap<T, U, V, W, X, Y>::find(typename GetPtrHelper<K>::PtrType key) -> typename std::enable_if<IsSmartPtr<K>::value, iterator>::type
 {
     return m_impl.template find<HashMapTranslator<KeyValuePairTraits, HashFunctions>>(key);
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
 template<typename K>
-inline auto HashMap<T, U, V, W, X>::find(typename GetPtrHelper<K>::PtrType key) const -> typename std::enable_if<IsSmartPtr<K>::value, const_iterator>::type
+inline auto HashMap<T, U, V, W, X, Y>::find(typename GetPtrHelper<K>::PtrType key) const -> typename std::enable_if<IsSmartPtr<K>::value, const_iterator>::type
 {
     return m_impl.template find<HashMapTranslator<KeyValuePairTraits, HashFunctions>>(key);
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
 template<typename K>
-inline auto HashMap<T, U, V, W, X>::contains(typename GetPtrHelper<K>::PtrType key) const -> typename std::enable_if<IsSmartPtr<K>::value, bool>::type
+inline auto HashMap<T, U, V, W, X, Y>::contains(typename GetPtrHelper<K>::PtrType key) const -> typename std::enable_if<IsSmartPtr<K>::value, bool>::type
 {
     return m_impl.template contains<HashMapTranslator<KeyValuePairTraits, HashFunctions>>(key);
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
 template<typename K>
-inline auto HashMap<T, U, V, W, X>::inlineGet(typename GetPtrHelper<K>::PtrType key) const -> typename std::enable_if<IsSmartPtr<K>::value, MappedPeekType>::type
+inline auto HashMap<T, U, V, W, X, Y>::inlineGet(typename GetPtrHelper<K>::PtrType key) const -> typename std::enable_if<IsSmartPtr<K>::value, MappedPeekType>::type
 {
     KeyValuePairType* entry = const_cast<HashTableType&>(m_impl).template lookup<HashMapTranslator<KeyValuePairTraits, HashFunctions>>(key);
     if (!entry)
@@ -425,23 +425,23 @@ inline auto HashMap<T, U, V, W, X>::inlineGet(typename GetPtrHelper<K>::PtrType
     return MappedTraits::peek(entry->value);
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
 template<typename K>
-auto HashMap<T, U, V, W, X>::get(typename GetPtrHelper<K>::PtrType key) const -> typename std::enable_if<IsSmartPtr<K>::value, MappedPeekType>::type
+auto HashMap<T, U, V, W, X, Y>::get(typename GetPtrHelper<K>::PtrType key) const -> typename std::enable_if<IsSmartPtr<K>::value, MappedPeekType>::type
 {
     return inlineGet(key);
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
 template<typename K>
-inline auto HashMap<T, U, V, W, X>::remove(typename GetPtrHelper<K>::PtrType key) -> typename std::enable_if<IsSmartPtr<K>::value, bool>::type
+inline auto HashMap<T, U, V, W, X, Y>::remove(typename GetPtrHelper<K>::PtrType key) -> typename std::enable_if<IsSmartPtr<K>::value, bool>::type
 {
     return remove(find(key));
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
 template<typename K>
-inline auto HashMap<T, U, V, W, X>::take(typename GetPtrHelper<K>::PtrType key) -> typename std::enable_if<IsSmartPtr<K>::value, MappedType>::type
+inline auto HashMap<T, U, V, W, X, Y>::take(typename GetPtrHelper<K>::PtrType key) -> typename std::enable_if<IsSmartPtr<K>::value, MappedType>::type
 {
     iterator it = find(key);
     if (it == end())
@@ -451,14 +451,14 @@ inline auto HashMap<T, U, V, W, X>::take(typename GetPtrHelper<K>::PtrType key)
     return value;
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline void HashMap<T, U, V, W, X>::checkConsistency() const
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline void HashMap<T, U, V, W, X, Y>::checkConsistency() const
 {
     m_impl.checkTableConsistency();
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline bool HashMap<T, U, V, W, X>::isValidKey(const KeyType& key)
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline bool HashMap<T, U, V, W, X, Y>::isValidKey(const KeyType& key)
 {
     if (KeyTraits::isDeletedValue(key))
         return false;
@@ -474,13 +474,13 @@ inline bool HashMap<T, U, V, W, X>::isValidKey(const KeyType& key)
     return true;
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-bool operator==(const HashMap<T, U, V, W, X>& a, const HashMap<T, U, V, W, X>& b)
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+bool operator==(const HashMap<T, U, V, W, X, Y>& a, const HashMap<T, U, V, W, X, Y>& b)
 {
     if (a.size() != b.size())
         return false;
 
-    typedef typename HashMap<T, U, V, W, X>::const_iterator const_iterator;
+    typedef typename HashMap<T, U, V, W, X, Y>::const_iterator const_iterator;
 
     const_iterator end = a.end();
     const_iterator notFound = b.end();
@@ -493,16 +493,16 @@ bool operator==(const HashMap<T, U, V, W, X>& a, const HashMap<T, U, V, W, X>& b
     return true;
 }
 
-template<typename T, typename U, typename V, typename W, typename X>
-inline bool operator!=(const HashMap<T, U, V, W, X>& a, const HashMap<T, U, V, W, X>& b)
+template<typename T, typename U, typename V, typename W, typename X, typename Y>
+inline bool operator!=(const HashMap<T, U, V, W, X, Y>& a, const HashMap<T, U, V, W, X, Y>& b)
 {
     return !(a == b);
 }
 
-template<typename T, typename U, typename V, typename W, typename X, typename Y>
-inline void copyToVector(const HashMap<T, U, V, W, X>& collection, Y& vector)
+template<typename T, typename U, typename V, typename W, typename X, typename Y, typename Z>
+inline void copyToVector(const HashMap<T, U, V, W, X, Y>& collection, Z& vector)
 {
-    typedef typename HashMap<T, U, V, W, X>::const_iterator iterator;
+    typedef typename HashMap<T, U, V, W, X, Y>::const_iterator iterator;
 
     vector.resize(collection.size());
 
@@ -512,10 +512,10 @@ inline void copyToVector(const HashMap<T, U, V, W, X>& collection, Y& vector)
         vector[i] = { (*it).key, (*it).value };
 }
 
-template<typename T, typename U, typename V, typename W, typename X, typename Y>
-inline void copyKeysToVector(const HashMap<T, U, V, W, X>& collection, Y& vector)
+template<typename T, typename U, typename V, typename W, typename X, typename Y, typename Z>
+inline void copyKeysToVector(const HashMap<T, U, V, W, X, Y>& collection, Z& vector)
 {
-    typedef typename HashMap<T, U, V, W, X>::const_iterator::Keys iterator;
+    typedef typename HashMap<T, U, V, W, X, Y>::const_iterator::Keys iterator;
     
     vector.resize(collection.size());
     
@@ -525,10 +525,10 @@ inline void copyKeysToVector(const HashMap<T, U, V, W, X>& collection, Y& vector
         vector[i] = *it;
 }  
 
-template<typename T, typename U, typename V, typename W, typename X, typename Y>
-inline void copyValuesToVector(const HashMap<T, U, V, W, X>& collection, Y& vector)
+template<typename T, typename U, typename V, typename W, typename X, typename Y, typename Z>
+inline void copyValuesToVector(const HashMap<T, U, V, W, X, Y>& collection, Z& vector)
 {
-    typedef typename HashMap<T, U, V, W, X>::const_iterator::Values iterator;
+    typedef typename HashMap<T, U, V, W, X, Y>::const_iterator::Values iterator;
     
     vector.resize(collection.size());
     
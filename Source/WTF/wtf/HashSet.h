@@ -30,10 +30,10 @@ namespace WTF {
 
     struct IdentityExtractor;
     
-    template<typename Value, typename HashFunctions, typename Traits> class HashSet;
+    template<typename Value, typename HashFunctions, typename Traits, typename Malloc> class HashSet;
 
     template<typename ValueArg, typename HashArg = typename DefaultHash<ValueArg>::Hash,
-        typename TraitsArg = HashTraits<ValueArg>> class HashSet final {
+        typename TraitsArg = HashTraits<ValueArg>, typename MallocArg = FastMalloc> class HashSet final {
         WTF_MAKE_FAST_ALLOCATED;
     private:
         typedef HashArg HashFunctions;
@@ -44,7 +44,7 @@ namespace WTF {
 
     private:
         typedef HashTable<ValueType, ValueType, IdentityExtractor,
-            HashFunctions, ValueTraits, ValueTraits> HashTableType;
+            HashFunctions, ValueTraits, ValueTraits, MallocArg> HashTableType;
 
     public:
         typedef HashTableConstIteratorAdapter<HashTableType, ValueType> iterator;
@@ -143,90 +143,90 @@ namespace WTF {
         }
     };
 
-    template<typename T, typename U, typename V>
-    inline void HashSet<T, U, V>::swap(HashSet& other)
+    template<typename T, typename U, typename V, typename W>
+    inline void HashSet<T, U, V, W>::swap(HashSet& other)
     {
         m_impl.swap(other.m_impl); 
     }
 
-    template<typename T, typename U, typename V>
-    inline unsigned HashSet<T, U, V>::size() const
+    template<typename T, typename U, typename V, typename W>
+    inline unsigned HashSet<T, U, V, W>::size() const
     {
         return m_impl.size(); 
     }
 
-    template<typename T, typename U, typename V>
-    inline unsigned HashSet<T, U, V>::capacity() const
+    template<typename T, typename U, typename V, typename W>
+    inline unsigned HashSet<T, U, V, W>::capacity() const
     {
         return m_impl.capacity(); 
     }
 
-    template<typename T, typename U, typename V>
-    inline bool HashSet<T, U, V>::isEmpty() const
+    template<typename T, typename U, typename V, typename W>
+    inline bool HashSet<T, U, V, W>::isEmpty() const
     {
         return m_impl.isEmpty(); 
     }
 
-    template<typename T, typename U, typename V>
-    inline auto HashSet<T, U, V>::begin() const -> iterator
+    template<typename T, typename U, typename V, typename W>
+    inline auto HashSet<T, U, V, W>::begin() const -> iterator
     {
         return m_impl.begin(); 
     }
 
-    template<typename T, typename U, typename V>
-    inline auto HashSet<T, U, V>::end() const -> iterator
+    template<typename T, typename U, typename V, typename W>
+    inline auto HashSet<T, U, V, W>::end() const -> iterator
     {
         return m_impl.end(); 
     }
 
-    template<typename T, typename U, typename V>
-    inline auto HashSet<T, U, V>::find(const ValueType& value) const -> iterator
+    template<typename T, typename U, typename V, typename W>
+    inline auto HashSet<T, U, V, W>::find(const ValueType& value) const -> iterator
     {
         return m_impl.find(value); 
     }
 
-    template<typename T, typename U, typename V>
-    inline bool HashSet<T, U, V>::contains(const ValueType& value) const
+    template<typename T, typename U, typename V, typename W>
+    inline bool HashSet<T, U, V, W>::contains(const ValueType& value) const
     {
         return m_impl.contains(value); 
     }
 
-    template<typename Value, typename HashFunctions, typename Traits>
+    template<typename Value, typename HashFunctions, typename Traits, typename Malloc>
     template<typename HashTranslator, typename T>
-    inline auto HashSet<Value, HashFunctions, Traits>::find(const T& value) const -> iterator
+    inline auto HashSet<Value, HashFunctions, Traits, Malloc>::find(const T& value) const -> iterator
     {
         return m_impl.template find<HashSetTranslatorAdapter<HashTranslator>>(value);
     }
 
-    template<typename Value, typename HashFunctions, typename Traits>
+    template<typename Value, typename HashFunctions, typename Traits, typename Malloc>
     template<typename HashTranslator, typename T>
-    inline bool HashSet<Value, HashFunctions, Traits>::contains(const T& value) const
+    inline bool HashSet<Value, HashFunctions, Traits, Malloc>::contains(const T& value) const
     {
         return m_impl.template contains<HashSetTranslatorAdapter<HashTranslator>>(value);
     }
 
-    template<typename T, typename U, typename V>
-    inline auto HashSet<T, U, V>::add(const ValueType& value) -> AddResult
+    template<typename T, typename U, typename V, typename W>
+    inline auto HashSet<T, U, V, W>::add(const ValueType& value) -> AddResult
     {
         return m_impl.add(value);
     }
 
-    template<typename T, typename U, typename V>
-    inline auto HashSet<T, U, V>::add(ValueType&& value) -> AddResult
+    template<typename T, typename U, typename V, typename W>
+    inline auto HashSet<T, U, V, W>::add(ValueType&& value) -> AddResult
     {
         return m_impl.add(WTF::move(value));
     }
 
-    template<typename Value, typename HashFunctions, typename Traits>
+    template<typename Value, typename HashFunctions, typename Traits, typename Malloc>
     template<typename HashTranslator, typename T>
-    inline auto HashSet<Value, HashFunctions, Traits>::add(const T& value) -> AddResult
+    inline auto HashSet<Value, HashFunctions, Traits, Malloc>::add(const T& value) -> AddResult
     {
         return m_impl.template addPassingHashCode<HashSetTranslatorAdapter<HashTranslator>>(value, value);
     }
 
-    template<typename T, typename U, typename V>
+    template<typename T, typename U, typename V, typename W>
     template<typename IteratorType>
-    inline bool HashSet<T, U, V>::add(IteratorType begin, IteratorType end)
+    inline bool HashSet<T, U, V, W>::add(IteratorType begin, IteratorType end)
     {
         bool changed = false;
         for (IteratorType iter = begin; iter != end; ++iter)
@@ -234,8 +234,8 @@ namespace WTF {
         return changed;
     }
 
-    template<typename T, typename U, typename V>
-    inline bool HashSet<T, U, V>::remove(iterator it)
+    template<typename T, typename U, typename V, typename W>
+    inline bool HashSet<T, U, V, W>::remove(iterator it)
     {
         if (it.m_impl == m_impl.end())
             return false;
@@ -244,20 +244,20 @@ namespace WTF {
         return true;
     }
 
-    template<typename T, typename U, typename V>
-    inline bool HashSet<T, U, V>::remove(const ValueType& value)
+    template<typename T, typename U, typename V, typename W>
+    inline bool HashSet<T, U, V, W>::remove(const ValueType& value)
     {
         return remove(find(value));
     }
 
-    template<typename T, typename U, typename V>
-    inline void HashSet<T, U, V>::clear()
+    template<typename T, typename U, typename V, typename W>
+    inline void HashSet<T, U, V, W>::clear()
     {
         m_impl.clear(); 
     }
 
-    template<typename T, typename U, typename V>
-    inline auto HashSet<T, U, V>::take(iterator it) -> ValueType
+    template<typename T, typename U, typename V, typename W>
+    inline auto HashSet<T, U, V, W>::take(iterator it) -> ValueType
     {
         if (it == end())
             return ValueTraits::emptyValue();
@@ -267,48 +267,48 @@ namespace WTF {
         return result;
     }
 
-    template<typename T, typename U, typename V>
-    inline auto HashSet<T, U, V>::take(const ValueType& value) -> ValueType
+    template<typename T, typename U, typename V, typename W>
+    inline auto HashSet<T, U, V, W>::take(const ValueType& value) -> ValueType
     {
         return take(find(value));
     }
 
-    template<typename T, typename U, typename V>
-    inline auto HashSet<T, U, V>::takeAny() -> ValueType
+    template<typename T, typename U, typename V, typename W>
+    inline auto HashSet<T, U, V, W>::takeAny() -> ValueType
     {
         return take(begin());
     }
 
-    template<typename Value, typename HashFunctions, typename Traits>
+    template<typename Value, typename HashFunctions, typename Traits, typename Malloc>
     template<typename V>
-    inline auto HashSet<Value, HashFunctions, Traits>::find(typename GetPtrHelper<V>::PtrType value) const -> typename std::enable_if<IsSmartPtr<V>::value, iterator>::type
+    inline auto HashSet<Value, HashFunctions, Traits, Malloc>::find(typename GetPtrHelper<V>::PtrType value) const -> typename std::enable_if<IsSmartPtr<V>::value, iterator>::type
     {
         return m_impl.template find<HashSetTranslator<HashFunctions>>(value);
     }
 
-    template<typename Value, typename HashFunctions, typename Traits>
+    template<typename Value, typename HashFunctions, typename Traits, typename Malloc>
     template<typename V>
-    inline auto HashSet<Value, HashFunctions, Traits>::contains(typename GetPtrHelper<V>::PtrType value) const -> typename std::enable_if<IsSmartPtr<V>::value, bool>::type
+    inline auto HashSet<Value, HashFunctions, Traits, Malloc>::contains(typename GetPtrHelper<V>::PtrType value) const -> typename std::enable_if<IsSmartPtr<V>::value, bool>::type
     {
         return m_impl.template contains<HashSetTranslator<HashFunctions>>(value);
     }
 
-    template<typename Value, typename HashFunctions, typename Traits>
+    template<typename Value, typename HashFunctions, typename Traits, typename Malloc>
     template<typename V>
-    inline auto HashSet<Value, HashFunctions, Traits>::remove(typename GetPtrHelper<V>::PtrType value) -> typename std::enable_if<IsSmartPtr<V>::value, bool>::type
+    inline auto HashSet<Value, HashFunctions, Traits, Malloc>::remove(typename GetPtrHelper<V>::PtrType value) -> typename std::enable_if<IsSmartPtr<V>::value, bool>::type
     {
         return remove(find(value));
     }
 
-    template<typename Value, typename HashFunctions, typename Traits>
+    template<typename Value, typename HashFunctions, typename Traits, typename Malloc>
     template<typename V>
-    inline auto HashSet<Value, HashFunctions, Traits>::take(typename GetPtrHelper<V>::PtrType value) -> typename std::enable_if<IsSmartPtr<V>::value, ValueType>::type
+    inline auto HashSet<Value, HashFunctions, Traits, Malloc>::take(typename GetPtrHelper<V>::PtrType value) -> typename std::enable_if<IsSmartPtr<V>::value, ValueType>::type
     {
         return take(find(value));
     }
 
-    template<typename T, typename U, typename V>
-    inline bool HashSet<T, U, V>::isValidValue(const ValueType& value)
+    template<typename T, typename U, typename V, typename W>
+    inline bool HashSet<T, U, V, W>::isValidValue(const ValueType& value)
     {
         if (ValueTraits::isDeletedValue(value))
             return false;
@@ -337,9 +337,9 @@ namespace WTF {
             vector[i] = *it;
     }  
 
-    template<typename T, typename U, typename V>
+    template<typename T, typename U, typename V, typename W>
     template<typename OtherCollection>
-    inline bool HashSet<T, U, V>::operator==(const OtherCollection& otherCollection) const
+    inline bool HashSet<T, U, V, W>::operator==(const OtherCollection& otherCollection) const
     {
         if (size() != otherCollection.size())
             return false;
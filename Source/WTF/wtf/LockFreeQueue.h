@@ -0,0 +1,468 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+#ifndef LockFreeQueue_h
+#define LockFreeQueue_h
+
+#include <atomic>
+#include <thread>
+#include <type_traits>
+#include <wtf/Assertions.h>
+#include <wtf/FastMalloc.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Optional.h>
+#include <wtf/ParkingLot.h>
+#include <wtf/StdLibExtras.h>
+
+namespace WTF {
+
+// These are queues for handing values from producer threads to a single consumer thread without
+// taking a lock. MPSCQueue is unbounded and takes any number of producers. BoundedSPSCQueue and
+// BoundedMPSCQueue are ring buffers that never allocate after construction; the SPSC one is cheaper
+// when there is only ever one producer thread at a time.
+//
+// tryEnqueue() and tryDequeue() never block. dequeue() blocks until there is a value or the queue
+// has been killed, and the bounded queues' enqueue() blocks while the queue is full. Blocked threads
+// spin for a bit and then sleep in the ParkingLot, so the fast paths only pay for a fence when nobody
+// is waiting. Like MessageQueue, a killed queue makes dequeue() return Nullopt right away, even if it
+// still holds values.
+
+namespace LockFreeQueueInternal {
+
+// This magic number turns out to be optimal based on past JikesRVM experiments.
+static const unsigned spinLimit = 40;
+
+// Padding that keeps the producer and consumer sides of a queue on different cache lines.
+static const size_t cacheLineSize = 64;
+
+class Waiters {
+public:
+    // Call this after making the condition that waiters wait for true.
+    void notifyAll()
+    {
+        // Pairs with the fence in waitUntil(): either we see the waiter, or it sees our change.
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (m_numberOfWaiters.load(std::memory_order_relaxed))
+            ParkingLot::unparkAll(&m_numberOfWaiters);
+    }
+
+    template<typename Functor>
+    void waitUntil(const Functor& isReady)
+    {
+        unsigned spinCount = 0;
+        while (!isReady()) {
+            if (spinCount < spinLimit) {
+                spinCount++;
+                std::this_thread::yield();
+                continue;
+            }
+
+            m_numberOfWaiters.fetch_add(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            ParkingLot::parkConditionally(
+                &m_numberOfWaiters,
+                [&] () -> bool {
+                    return !isReady();
+                },
+                [] () { },
+                ParkingLot::Clock::time_point::max());
+            m_numberOfWaiters.fetch_sub(1);
+        }
+    }
+
+private:
+    std::atomic<unsigned> m_numberOfWaiters { 0 };
+};
+
+template<typename T>
+class Slot {
+public:
+    template<typename U>
+    void construct(U&& value) { new (NotNull, &m_storage) T(std::forward<U>(value)); }
+
+    T take()
+    {
+        T& value = *reinterpret_cast<T*>(&m_storage);
+        T result = WTF::move(value);
+        value.~T();
+        return result;
+    }
+
+private:
+    typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type m_storage;
+};
+
+inline size_t roundUpToPowerOfTwo(size_t capacity)
+{
+    RELEASE_ASSERT(capacity);
+    size_t result = 1;
+    while (result < capacity)
+        result <<= 1;
+    return result;
+}
+
+} // namespace LockFreeQueueInternal
+
+// This is Dmitry Vyukov's node-based MPSC queue, with a node allocated per value. Enqueueing is one
+// atomic exchange, no matter how many producers there are.
+template<typename T>
+class MPSCQueue {
+    WTF_MAKE_NONCOPYABLE(MPSCQueue);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    MPSCQueue()
+        : m_head(new Node)
+    {
+        m_tail.store(m_head, std::memory_order_relaxed);
+    }
+
+    ~MPSCQueue()
+    {
+        while (tryDequeue()) { }
+        delete m_head;
+    }
+
+    // Any thread.
+    template<typename U>
+    void enqueue(U&& value)
+    {
+        Node* node = new Node;
+        node->slot.construct(std::forward<U>(value));
+        Node* previous = m_tail.exchange(node, std::memory_order_acq_rel);
+        // Until this store, the consumer can't see the new value or anything enqueued after it.
+        previous->next.store(node, std::memory_order_release);
+        m_consumerWaiters.notifyAll();
+    }
+
+    // Consumer thread only.
+    Optional<T> tryDequeue()
+    {
+        Node* next = m_head->next.load(std::memory_order_acquire);
+        if (!next)
+            return Nullopt;
+
+        // The next node becomes the new empty head node.
+        Optional<T> result(next->slot.take());
+        delete m_head;
+        m_head = next;
+        return result;
+    }
+
+    // Consumer thread only.
+    Optional<T> dequeue()
+    {
+        for (;;) {
+            if (killed())
+                return Nullopt;
+            if (Optional<T> result = tryDequeue())
+                return result;
+            m_consumerWaiters.waitUntil(
+                [this] () -> bool {
+                    return killed() || m_head->next.load(std::memory_order_acquire);
+                });
+        }
+    }
+
+    // Consumer thread only. A value that is still being enqueued may not be seen yet.
+    bool isEmpty() const { return !m_head->next.load(std::memory_order_acquire); }
+
+    void kill()
+    {
+        m_isKilled.store(true);
+        m_consumerWaiters.notifyAll();
+    }
+
+    bool killed() const { return m_isKilled.load(); }
+
+private:
+    struct Node {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        std::atomic<Node*> next { nullptr };
+        LockFreeQueueInternal::Slot<T> slot;
+    };
+
+    // The consumer side. m_head is the node whose value was dequeued last.
+    Node* m_head;
+    LockFreeQueueInternal::Waiters m_consumerWaiters;
+    std::atomic<bool> m_isKilled { false };
+    char m_padding[LockFreeQueueInternal::cacheLineSize];
+
+    std::atomic<Node*> m_tail;
+};
+
+// A ring buffer for exactly one producer thread and one consumer thread at a time. The capacity is
+// rounded up to a power of two.
+template<typename T>
+class BoundedSPSCQueue {
+    WTF_MAKE_NONCOPYABLE(BoundedSPSCQueue);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    explicit BoundedSPSCQueue(size_t capacity)
+        : m_mask(LockFreeQueueInternal::roundUpToPowerOfTwo(capacity) - 1)
+        , m_slots(std::make_unique<LockFreeQueueInternal::Slot<T>[]>(m_mask + 1))
+    {
+    }
+
+    ~BoundedSPSCQueue()
+    {
+        while (tryDequeue()) { }
+    }
+
+    size_t capacity() const { return m_mask + 1; }
+
+    // Producer thread only. Returns false without touching the value if the queue is full.
+    template<typename U>
+    bool tryEnqueue(U&& value)
+    {
+        size_t tail = m_tail.load(std::memory_order_relaxed);
+        if (tail - m_cachedHead > m_mask) {
+            m_cachedHead = m_head.load(std::memory_order_acquire);
+            if (tail - m_cachedHead > m_mask)
+                return false;
+        }
+        m_slots[tail & m_mask].construct(std::forward<U>(value));
+        m_tail.store(tail + 1, std::memory_order_release);
+        m_consumerWaiters.notifyAll();
+        return true;
+    }
+
+    // Producer thread only. Waits for space, and returns false if the queue got killed first.
+    template<typename U>
+    bool enqueue(U&& value)
+    {
+        for (;;) {
+            if (killed())
+                return false;
+            if (tryEnqueue(std::forward<U>(value)))
+                return true;
+            m_producerWaiters.waitUntil(
+                [this] () -> bool {
+                    return killed() || m_tail.load(std::memory_order_relaxed) - m_head.load(std::memory_order_acquire) <= m_mask;
+                });
+        }
+    }
+
+    // Consumer thread only.
+    Optional<T> tryDequeue()
+    {
+        size_t head = m_head.load(std::memory_order_relaxed);
+        if (head == m_cachedTail) {
+            m_cachedTail = m_tail.load(std::memory_order_acquire);
+            if (head == m_cachedTail)
+                return Nullopt;
+        }
+        Optional<T> result(m_slots[head & m_mask].take());
+        m_head.store(head + 1, std::memory_order_release);
+        m_producerWaiters.notifyAll();
+        return result;
+    }
+
+    // Consumer thread only.
+    Optional<T> dequeue()
+    {
+        for (;;) {
+            if (killed())
+                return Nullopt;
+            if (Optional<T> result = tryDequeue())
+                return result;
+            m_consumerWaiters.waitUntil(
+                [this] () -> bool {
+                    return killed() || m_tail.load(std::memory_order_acquire) != m_head.load(std::memory_order_relaxed);
+                });
+        }
+    }
+
+    // Consumer thread only.
+    bool isEmpty() const { return m_head.load(std::memory_order_relaxed) == m_tail.load(std::memory_order_acquire); }
+
+    void kill()
+    {
+        m_isKilled.store(true);
+        m_consumerWaiters.notifyAll();
+        m_producerWaiters.notifyAll();
+    }
+
+    bool killed() const { return m_isKilled.load(); }
+
+private:
+    size_t m_mask;
+    std::unique_ptr<LockFreeQueueInternal::Slot<T>[]> m_slots;
+    std::atomic<bool> m_isKilled { false };
+    char m_padding1[LockFreeQueueInternal::cacheLineSize];
+
+    // The consumer side.
+    std::atomic<size_t> m_head { 0 };
+    size_t m_cachedTail { 0 };
+    LockFreeQueueInternal::Waiters m_consumerWaiters;
+    char m_padding2[LockFreeQueueInternal::cacheLineSize];
+
+    // The producer side.
+    std::atomic<size_t> m_tail { 0 };
+    size_t m_cachedHead { 0 };
+    LockFreeQueueInternal::Waiters m_producerWaiters;
+};
+
+// Dmitry Vyukov's bounded queue, where each slot has a sequence number that says whether it is ready
+// to be written or read. Producers claim a slot with a CAS, so any number of them can enqueue at once.
+// The capacity is rounded up to a power of two.
+template<typename T>
+class BoundedMPSCQueue {
+    WTF_MAKE_NONCOPYABLE(BoundedMPSCQueue);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    explicit BoundedMPSCQueue(size_t capacity)
+        : m_mask(LockFreeQueueInternal::roundUpToPowerOfTwo(capacity) - 1)
+        , m_cells(std::make_unique<Cell[]>(m_mask + 1))
+    {
+        for (size_t i = 0; i <= m_mask; ++i)
+            m_cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    ~BoundedMPSCQueue()
+    {
+        while (tryDequeue()) { }
+    }
+
+    size_t capacity() const { return m_mask + 1; }
+
+    // Any thread. Returns false without touching the value if the queue is full.
+    template<typename U>
+    bool tryEnqueue(U&& value)
+    {
+        size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &m_cells[position & m_mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence - position);
+            if (!difference) {
+                if (m_enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                    break;
+            } else if (difference < 0)
+                return false;
+            else
+                position = m_enqueuePosition.load(std::memory_order_relaxed);
+        }
+        cell->slot.construct(std::forward<U>(value));
+        cell->sequence.store(position + 1, std::memory_order_release);
+        m_consumerWaiters.notifyAll();
+        return true;
+    }
+
+    // Any thread. Waits for space, and returns false if the queue got killed first.
+    template<typename U>
+    bool enqueue(U&& value)
+    {
+        for (;;) {
+            if (killed())
+                return false;
+            if (tryEnqueue(std::forward<U>(value)))
+                return true;
+            m_producerWaiters.waitUntil(
+                [this] () -> bool {
+                    return killed() || hasSpace();
+                });
+        }
+    }
+
+    // Consumer thread only.
+    Optional<T> tryDequeue()
+    {
+        Cell& cell = m_cells[m_dequeuePosition & m_mask];
+        if (cell.sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1)
+            return Nullopt;
+        Optional<T> result(cell.slot.take());
+        // The slot is ready for the producer that comes around the ring next time.
+        cell.sequence.store(m_dequeuePosition + m_mask + 1, std::memory_order_release);
+        m_dequeuePosition++;
+        m_producerWaiters.notifyAll();
+        return result;
+    }
+
+    // Consumer thread only.
+    Optional<T> dequeue()
+    {
+        for (;;) {
+            if (killed())
+                return Nullopt;
+            if (Optional<T> result = tryDequeue())
+                return result;
+            m_consumerWaiters.waitUntil(
+                [this] () -> bool {
+                    return killed() || !isEmpty();
+                });
+        }
+    }
+
+    // Consumer thread only. A value that is still being enqueued may not be seen yet.
+    bool isEmpty() const
+    {
+        return m_cells[m_dequeuePosition & m_mask].sequence.load(std::memory_order_acquire) != m_dequeuePosition + 1;
+    }
+
+    void kill()
+    {
+        m_isKilled.store(true);
+        m_consumerWaiters.notifyAll();
+        m_producerWaiters.notifyAll();
+    }
+
+    bool killed() const { return m_isKilled.load(); }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        LockFreeQueueInternal::Slot<T> slot;
+    };
+
+    bool hasSpace() const
+    {
+        size_t position = m_enqueuePosition.load(std::memory_order_relaxed);
+        size_t sequence = m_cells[position & m_mask].sequence.load(std::memory_order_acquire);
+        return static_cast<intptr_t>(sequence - position) >= 0;
+    }
+
+    size_t m_mask;
+    std::unique_ptr<Cell[]> m_cells;
+    std::atomic<bool> m_isKilled { false };
+    char m_padding1[LockFreeQueueInternal::cacheLineSize];
+
+    // The consumer side.
+    size_t m_dequeuePosition { 0 };
+    LockFreeQueueInternal::Waiters m_consumerWaiters;
+    char m_padding2[LockFreeQueueInternal::cacheLineSize];
+
+    // The producer side.
+    std::atomic<size_t> m_enqueuePosition { 0 };
+    LockFreeQueueInternal::Waiters m_producerWaiters;
+};
+
+} // namespace WTF
+
+using WTF::BoundedMPSCQueue;
+using WTF::BoundedSPSCQueue;
+using WTF::MPSCQueue;
+
+#endif // LockFreeQueue_h
@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+#include "config.h"
+#include "MappedHashMap.h"
+
+#include <algorithm>
+#include <limits>
+#include <string.h>
+#include <wtf/text/ASCIIFastPath.h>
+
+namespace WTF {
+
+struct MappedHashTable::Header {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t count;
+    uint32_t numberOfBuckets;
+    uint32_t numberOfSlots;
+    uint32_t valueSize;
+    uint32_t seedsOffset;
+    uint32_t keysOffset;
+    uint32_t valuesOffset;
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+    uint32_t totalSize;
+};
+
+namespace {
+
+struct KeyEntry {
+    uint32_t offset;
+    uint32_t length;
+};
+
+const uint32_t emptySlot = std::numeric_limits<uint32_t>::max();
+const uint32_t maximumSeed = 1 << 20;
+
+uint64_t hashKey(const char* key, size_t length)
+{
+    // FNV-1a.
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (size_t i = 0; i < length; ++i) {
+        hash ^= static_cast<uint8_t>(key[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+unsigned bucketFor(uint64_t hash, uint32_t numberOfBuckets)
+{
+    return static_cast<uint32_t>(hash >> 32) % numberOfBuckets;
+}
+
+unsigned slotFor(uint64_t hash, uint32_t seed, uint32_t numberOfSlots)
+{
+    // The splitmix64 finalizer, so that each seed gives an unrelated placement.
+    uint64_t x = hash ^ (seed * 0x9e3779b97f4a7c15ULL);
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x % numberOfSlots;
+}
+
+uint64_t roundUpToMultipleOf8(uint64_t x)
+{
+    return (x + 7) & ~static_cast<uint64_t>(7);
+}
+
+} // anonymous namespace
+
+MappedHashTable::MappedHashTable(const void* data, size_t size, size_t valueSize)
+    : m_data(static_cast<const uint8_t*>(data))
+    , m_header(nullptr)
+{
+    if (!data || size < sizeof(Header) || reinterpret_cast<uintptr_t>(data) % 8)
+        return;
+
+    const Header* header = static_cast<const Header*>(data);
+    if (header->magic != magic || header->version != version || header->valueSize != valueSize)
+        return;
+    if (header->totalSize > size || !header->numberOfBuckets || !header->numberOfSlots || header->count > header->numberOfSlots)
+        return;
+    if (header->seedsOffset % 4 || header->keysOffset % 4 || header->valuesOffset % 8)
+        return;
+
+    uint64_t totalSize = header->totalSize;
+    if (static_cast<uint64_t>(header->seedsOffset) + static_cast<uint64_t>(header->numberOfBuckets) * sizeof(uint32_t) > totalSize)
+        return;
+    if (static_cast<uint64_t>(header->keysOffset) + static_cast<uint64_t>(header->numberOfSlots) * sizeof(KeyEntry) > totalSize)
+        return;
+    if (static_cast<uint64_t>(header->valuesOffset) + static_cast<uint64_t>(header->numberOfSlots) * valueSize > totalSize)
+        return;
+    if (static_cast<uint64_t>(header->stringsOffset) + header->stringsSize > totalSize)
+        return;
+
+    m_header = header;
+}
+
+unsigned MappedHashTable::size() const
+{
+    return m_header ? m_header->count : 0;
+}
+
+const void* MappedHashTable::find(const char* key, size_t length) const
+{
+    if (!m_header)
+        return nullptr;
+
+    uint64_t hash = hashKey(key, length);
+    const uint32_t* seeds = reinterpret_cast<const uint32_t*>(m_data + m_header->seedsOffset);
+    uint32_t seed = seeds[bucketFor(hash, m_header->numberOfBuckets)];
+    unsigned slot = slotFor(hash, seed, m_header->numberOfSlots);
+
+    const KeyEntry& entry = reinterpret_cast<const KeyEntry*>(m_data + m_header->keysOffset)[slot];
+    if (entry.offset == emptySlot || entry.length != length)
+        return nullptr;
+    // Keys are not validated up front, so that opening a table does not touch all of it.
+    if (static_cast<uint64_t>(entry.offset) + entry.length > m_header->stringsSize)
+        return nullptr;
+    if (memcmp(m_data + m_header->stringsOffset + entry.offset, key, length))
+        return nullptr;
+
+    return m_data + m_header->valuesOffset + static_cast<size_t>(slot) * m_header->valueSize;
+}
+
+const void* MappedHashTable::find(StringView key) const
+{
+    if (key.is8Bit() && charactersAreAllASCII(key.characters8(), key.length()))
+        return find(reinterpret_cast<const char*>(key.characters8()), key.length());
+    CString utf8 = key.utf8();
+    return find(utf8.data(), utf8.length());
+}
+
+Vector<uint8_t> MappedHashTable::build(const Vector<CString>& keys, const Vector<uint8_t>& values, size_t valueSize)
+{
+    ASSERT(values.size() == keys.size() * valueSize);
+
+    size_t count = keys.size();
+    if (count > std::numeric_limits<uint32_t>::max() / 2)
+        return { };
+
+    // About four keys per bucket and a load factor of about 0.9 keep the seed search short.
+    uint32_t numberOfBuckets = std::max<size_t>(1, (count + 3) / 4);
+    uint32_t numberOfSlots = std::max<size_t>(1, count + count / 8);
+
+    Vector<uint64_t> hashes(count);
+    Vector<Vector<unsigned>> buckets(numberOfBuckets);
+    uint64_t stringsSize = 0;
+    for (size_t i = 0; i < count; ++i) {
+        hashes[i] = hashKey(keys[i].data(), keys[i].length());
+        buckets[bucketFor(hashes[i], numberOfBuckets)].append(i);
+        stringsSize += keys[i].length();
+    }
+
+    // Keys that hash identically can never be separated, whatever the seed. This is how
+    // duplicate keys are caught.
+    for (auto& bucket : buckets) {
+        for (size_t i = 0; i < bucket.size(); ++i) {
+            for (size_t j = i + 1; j < bucket.size(); ++j) {
+                if (hashes[bucket[i]] == hashes[bucket[j]])
+                    return { };
+            }
+        }
+    }
+
+    // Place the largest buckets first, while there are still many free slots.
+    Vector<unsigned> order(numberOfBuckets);
+    for (unsigned i = 0; i < numberOfBuckets; ++i)
+        order[i] = i;
+    std::stable_sort(order.begin(), order.end(), [&] (unsigned a, unsigned b) {
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    Vector<uint32_t> seeds(numberOfBuckets, 0);
+    Vector<uint32_t> slotToKey(numberOfSlots, emptySlot);
+    Vector<unsigned> slots;
+    for (unsigned bucketIndex : order) {
+        const Vector<unsigned>& bucket = buckets[bucketIndex];
+        if (bucket.isEmpty())
+            break;
+
+        bool placed = false;
+        for (uint32_t seed = 0; seed < maximumSeed && !placed; ++seed) {
+            slots.shrink(0);
+            placed = true;
+            for (unsigned key : bucket) {
+                unsigned slot = slotFor(hashes[key], seed, numberOfSlots);
+                if (slotToKey[slot] != emptySlot || slots.contains(slot)) {
+                    placed = false;
+                    break;
+                }
+                slots.append(slot);
+            }
+            if (placed) {
+                for (size_t i = 0; i < bucket.size(); ++i)
+                    slotToKey[slots[i]] = bucket[i];
+                seeds[bucketIndex] = seed;
+            }
+        }
+        if (!placed)
+            return { };
+    }
+
+    uint64_t seedsOffset = sizeof(Header);
+    uint64_t keysOffset = roundUpToMultipleOf8(seedsOffset + static_cast<uint64_t>(numberOfBuckets) * sizeof(uint32_t));
+    uint64_t valuesOffset = roundUpToMultipleOf8(keysOffset + static_cast<uint64_t>(numberOfSlots) * sizeof(KeyEntry));
+    uint64_t stringsOffset = roundUpToMultipleOf8(valuesOffset + static_cast<uint64_t>(numberOfSlots) * valueSize);
+    uint64_t totalSize = stringsOffset + stringsSize;
+    if (totalSize > std::numeric_limits<uint32_t>::max())
+        return { };
+
+    Vector<uint8_t> result(totalSize, 0);
+
+    Header header;
+    header.magic = magic;
+    header.version = version;
+    header.count = count;
+    header.numberOfBuckets = numberOfBuckets;
+    header.numberOfSlots = numberOfSlots;
+    header.valueSize = valueSize;
+    header.seedsOffset = seedsOffset;
+    header.keysOffset = keysOffset;
+    header.valuesOffset = valuesOffset;
+    header.stringsOffset = stringsOffset;
+    header.stringsSize = stringsSize;
+    header.totalSize = totalSize;
+    memcpy(result.data(), &header, sizeof(Header));
+    memcpy(result.data() + seedsOffset, seeds.data(), numberOfBuckets * sizeof(uint32_t));
+
+    KeyEntry* entries = reinterpret_cast<KeyEntry*>(result.data() + keysOffset);
+    uint32_t stringOffset = 0;
+    for (unsigned slot = 0; slot < numberOfSlots; ++slot) {
+        uint32_t key = slotToKey[slot];
+        if (key == emptySlot) {
+            entries[slot].offset = emptySlot;
+            entries[slot].length = 0;
+            continue;
+        }
+        const CString& string = keys[key];
+        entries[slot].offset = stringOffset;
+        entries[slot].length = string.length();
+        memcpy(result.data() + stringsOffset + stringOffset, string.data(), string.length());
+        stringOffset += string.length();
+        memcpy(result.data() + valuesOffset + static_cast<size_t>(slot) * valueSize, values.data() + static_cast<size_t>(key) * valueSize, valueSize);
+    }
+
+    return result;
+}
+
+} // namespace WTF
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+#ifndef WTF_MappedHashMap_h
+#define WTF_MappedHashMap_h
+
+#include <string.h>
+#include <type_traits>
+#include <wtf/Vector.h>
+#include <wtf/text/CString.h>
+#include <wtf/text/StringView.h>
+
+namespace WTF {
+
+// MappedHashTable is a read-only hash table from UTF-8 string keys to fixed-size values,
+// stored in a single position-independent buffer. Lookups work directly on the buffer, so
+// a table written to a file can be mapped into memory and used without deserializing it,
+// and the mapped pages can be shared between processes.
+//
+// Keys are placed with a perfect hash built with the hash and displace method: each key is first
+// hashed to a bucket, and every bucket stores the seed that sends all of its keys to
+// distinct slots. A lookup is one hash, one seed load and one key comparison.
+//
+// The format uses native byte order and is meant to be produced and consumed on the same
+// kind of machine. The buffer passed to the reader must be 8-byte aligned.
+class MappedHashTable {
+public:
+    static const uint32_t magic = 0x4d485457; // "WTHM"
+    static const uint32_t version = 1;
+
+    MappedHashTable()
+        : m_data(nullptr)
+        , m_header(nullptr)
+    {
+    }
+
+    // Leaves the table invalid if data does not hold a well-formed table with the given
+    // value size.
+    WTF_EXPORT_PRIVATE MappedHashTable(const void* data, size_t size, size_t valueSize);
+
+    bool isValid() const { return m_header; }
+    WTF_EXPORT_PRIVATE unsigned size() const;
+
+    // Returns a pointer to the value for key, or null if the key is not in the table.
+    WTF_EXPORT_PRIVATE const void* find(const char* key, size_t length) const;
+    WTF_EXPORT_PRIVATE const void* find(StringView key) const;
+
+    // Returns an empty vector if keys contains duplicates.
+    WTF_EXPORT_PRIVATE static Vector<uint8_t> build(const Vector<CString>& keys, const Vector<uint8_t>& values, size_t valueSize);
+
+private:
+    struct Header;
+
+    const uint8_t* m_data;
+    const Header* m_header;
+};
+
+template<typename T>
+class MappedHashMap {
+    static_assert(std::is_trivial<T>::value, "MappedHashMap values are used in place, so they must be trivial.");
+    static_assert(alignof(T) <= 8, "MappedHashMap values can be aligned to at most 8 bytes.");
+public:
+    MappedHashMap()
+    {
+    }
+
+    MappedHashMap(const void* data, size_t size)
+        : m_table(data, size, sizeof(T))
+    {
+    }
+
+    bool isValid() const { return m_table.isValid(); }
+    unsigned size() const { return m_table.size(); }
+    bool isEmpty() const { return !size(); }
+
+    const T* get(StringView key) const { return static_cast<const T*>(m_table.find(key)); }
+    const T* get(const char* key, size_t length) const { return static_cast<const T*>(m_table.find(key, length)); }
+    const T* get(const char* key) const { return get(key, strlen(key)); }
+    bool contains(StringView key) const { return get(key); }
+
+private:
+    MappedHashTable m_table;
+};
+
+template<typename T>
+class MappedHashMapBuilder {
+    static_assert(std::is_trivial<T>::value, "MappedHashMap values are used in place, so they must be trivial.");
+    static_assert(alignof(T) <= 8, "MappedHashMap values can be aligned to at most 8 bytes.");
+public:
+    void add(StringView key, const T& value)
+    {
+        m_keys.append(key.utf8());
+        const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+        m_values.append(bytes, sizeof(T));
+    }
+
+    template<typename HashMapType>
+    void addAll(const HashMapType& map)
+    {
+        for (auto& entry : map)
+            add(entry.key, entry.value);
+    }
+
+    // Returns an empty vector if the same key was added more than once.
+    Vector<uint8_t> build() const { return MappedHashTable::build(m_keys, m_values, sizeof(T)); }
+
+private:
+    Vector<CString> m_keys;
+    Vector<uint8_t> m_values;
+};
+
+} // namespace WTF
+
+using WTF::MappedHashMap;
+using WTF::MappedHashMapBuilder;
+using WTF::MappedHashTable;
+
+#endif // WTF_MappedHashMap_h
@@ -201,6 +201,9 @@ MetaAllocator::Statistics MetaAllocator::currentStatistics()
     result.bytesAllocated = m_bytesAllocated;
     result.bytesReserved = m_bytesReserved;
     result.bytesCommitted = m_bytesCommitted;
+    result.freeSpaceChunkCount = m_freeSpaceStartAddressMap.size();
+    FreeSpaceNode* largestNode = m_freeSpaceSizeMap.last();
+    result.largestFreeSpaceChunk = largestNode ? largestNode->m_sizeInBytes : 0;
     return result;
 }
 
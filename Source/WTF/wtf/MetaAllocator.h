@@ -85,6 +85,8 @@ public:
         size_t bytesAllocated;
         size_t bytesReserved;
         size_t bytesCommitted;
+        size_t freeSpaceChunkCount;
+        size_t largestFreeSpaceChunk;
     };
     WTF_EXPORT_PRIVATE Statistics currentStatistics();
 
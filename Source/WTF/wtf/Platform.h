@@ -784,6 +784,12 @@
 #define ENABLE_B3_JIT 1
 #endif
 
+/* FTL_USES_B3 selects B3, rather than LLVM, as the FTL's backend. The FTL cannot be lowered to B3
+   yet, so this must stay off; it exists so that the port can land incrementally behind it. */
+#if !defined(FTL_USES_B3)
+#define FTL_USES_B3 0
+#endif
+
 /* If the baseline jit is not available, then disable upper tiers as well: */
 #if !ENABLE(JIT)
 #undef ENABLE_DFG_JIT
@@ -791,7 +797,7 @@
 #undef ENABLE_B3_JIT
 #define ENABLE_DFG_JIT 0
 #define ENABLE_FTL_JIT 0
-#define Enable_B3_JIT 0
+#define ENABLE_B3_JIT 0
 #endif
 
 /* Counts uses of write barriers using sampling counters. Be sure to also
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+#include "config.h"
+#include "RWLock.h"
+
+#include "ParkingLot.h"
+#include <thread>
+
+namespace WTF {
+
+// This magic number turns out to be optimal based on past JikesRVM experiments.
+static const unsigned spinLimit = 40;
+
+// Parked threads are readers and writers mixed together, so every release that finds hasParkedBit set
+// clears it and unparks everyone. The woken threads race for the lock and the losers park again. The
+// parked bit is only ever set while the lock is held, so the thread that releases the lock last
+// always sees it.
+
+void RWLockBase::lockSlow()
+{
+    unsigned spinCount = 0;
+
+    for (;;) {
+        unsigned currentWordValue = m_word.load();
+
+        // Keep the parked bit, so that our unlock() wakes up everyone else.
+        if (!(currentWordValue & (isWriteHeldBit | readerCountMask))) {
+            if (m_word.compareExchangeWeak(currentWordValue, currentWordValue | isWriteHeldBit))
+                return;
+            continue;
+        }
+
+        if (!(currentWordValue & hasParkedBit) && spinCount < spinLimit) {
+            spinCount++;
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (!(currentWordValue & hasParkedBit)
+            && !m_word.compareExchangeWeak(currentWordValue, currentWordValue | hasParkedBit))
+            continue;
+
+        ParkingLot::compareAndPark(&m_word, currentWordValue | hasParkedBit);
+    }
+}
+
+void RWLockBase::unlockSlow()
+{
+    for (;;) {
+        unsigned oldWordValue = m_word.load();
+        RELEASE_ASSERT(oldWordValue == isWriteHeldBit || oldWordValue == (isWriteHeldBit | hasParkedBit));
+
+        if (!m_word.compareExchangeWeak(oldWordValue, 0))
+            continue;
+
+        if (oldWordValue & hasParkedBit)
+            ParkingLot::unparkAll(&m_word);
+        return;
+    }
+}
+
+void RWLockBase::lockSharedSlow()
+{
+    unsigned spinCount = 0;
+
+    for (;;) {
+        unsigned currentWordValue = m_word.load();
+
+        if (canLockShared(currentWordValue)) {
+            if (m_word.compareExchangeWeak(currentWordValue, currentWordValue + readerCountUnit))
+                return;
+            continue;
+        }
+
+        if (!(currentWordValue & hasParkedBit) && spinCount < spinLimit) {
+            spinCount++;
+            std::this_thread::yield();
+            continue;
+        }
+
+        if (!(currentWordValue & hasParkedBit)
+            && !m_word.compareExchangeWeak(currentWordValue, currentWordValue | hasParkedBit))
+            continue;
+
+        ParkingLot::compareAndPark(&m_word, currentWordValue | hasParkedBit);
+    }
+}
+
+void RWLockBase::unlockSharedSlow()
+{
+    for (;;) {
+        unsigned oldWordValue = m_word.load();
+        RELEASE_ASSERT(oldWordValue & readerCountMask);
+        RELEASE_ASSERT(!(oldWordValue & isWriteHeldBit));
+
+        // Only the last reader out has to wake anyone up.
+        if ((oldWordValue & readerCountMask) == readerCountUnit && (oldWordValue & hasParkedBit)) {
+            if (!m_word.compareExchangeWeak(oldWordValue, 0))
+                continue;
+            ParkingLot::unparkAll(&m_word);
+            return;
+        }
+
+        if (m_word.compareExchangeWeak(oldWordValue, oldWordValue - readerCountUnit))
+            return;
+    }
+}
+
+} // namespace WTF
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+#ifndef WTF_RWLock_h
+#define WTF_RWLock_h
+
+#include <wtf/Atomics.h>
+#include <wtf/Compiler.h>
+#include <wtf/Locker.h>
+#include <wtf/Noncopyable.h>
+
+namespace TestWebKitAPI {
+struct LockInspector;
+};
+
+namespace WTF {
+
+// This is a reader-writer lock that only requires 4 bytes of storage. Any number of threads can hold
+// it for reading at once, while holding it for writing excludes everyone else. Like Lock, it is
+// adaptive: uncontended locking and unlocking is inlined and is just a CAS, microcontention is
+// handled by spinning and yielding, and longer waits park the thread in the ParkingLot.
+//
+// The lock prefers writers. Once a writer has parked, new readers wait until it had its turn instead
+// of barging in, so a steady stream of readers can't starve the writers. The price is that readers
+// must not recursively lock for reading: a writer parked between the two read locks would deadlock.
+//
+// lock() and unlock() take the lock for writing, so WriteLockHolder is just a Locker. Use
+// ReadLockHolder to hold the lock for reading.
+
+// This is a struct without a constructor or destructor so that it can be statically initialized.
+// Use RWLock in instance variables.
+struct RWLockBase {
+    void lock()
+    {
+        if (LIKELY(m_word.compareExchangeWeak(0, isWriteHeldBit, std::memory_order_acquire)))
+            return;
+
+        lockSlow();
+    }
+
+    bool tryLock()
+    {
+        for (;;) {
+            unsigned currentWordValue = m_word.load();
+            if (currentWordValue & (isWriteHeldBit | readerCountMask))
+                return false;
+            if (m_word.compareExchangeWeak(currentWordValue, currentWordValue | isWriteHeldBit))
+                return true;
+        }
+    }
+
+    void unlock()
+    {
+        if (LIKELY(m_word.compareExchangeWeak(isWriteHeldBit, 0, std::memory_order_release)))
+            return;
+
+        unlockSlow();
+    }
+
+    void lockShared()
+    {
+        unsigned currentWordValue = m_word.load(std::memory_order_relaxed);
+        if (LIKELY(!(currentWordValue & (isWriteHeldBit | hasParkedBit))
+            && m_word.compareExchangeWeak(currentWordValue, currentWordValue + readerCountUnit, std::memory_order_acquire)))
+            return;
+
+        lockSharedSlow();
+    }
+
+    bool tryLockShared()
+    {
+        for (;;) {
+            unsigned currentWordValue = m_word.load();
+            if (!canLockShared(currentWordValue))
+                return false;
+            if (m_word.compareExchangeWeak(currentWordValue, currentWordValue + readerCountUnit))
+                return true;
+        }
+    }
+
+    void unlockShared()
+    {
+        unsigned currentWordValue = m_word.load(std::memory_order_relaxed);
+        if (LIKELY(!(currentWordValue & hasParkedBit)
+            && m_word.compareExchangeWeak(currentWordValue, currentWordValue - readerCountUnit, std::memory_order_release)))
+            return;
+
+        unlockSharedSlow();
+    }
+
+    // Need these versions for std::unique_lock and std::shared_lock.
+    bool try_lock() { return tryLock(); }
+    void lock_shared() { lockShared(); }
+    bool try_lock_shared() { return tryLockShared(); }
+    void unlock_shared() { unlockShared(); }
+
+    bool isHeld() const
+    {
+        return m_word.load(std::memory_order_acquire) & (isWriteHeldBit | readerCountMask);
+    }
+
+    bool isLocked() const
+    {
+        return isHeld();
+    }
+
+    bool isWriteHeld() const
+    {
+        return m_word.load(std::memory_order_acquire) & isWriteHeldBit;
+    }
+
+protected:
+    friend struct TestWebKitAPI::LockInspector;
+
+    static const unsigned isWriteHeldBit = 1;
+    static const unsigned hasParkedBit = 2;
+    static const unsigned readerCountUnit = 4;
+    static const unsigned readerCountMask = ~(isWriteHeldBit | hasParkedBit);
+
+    // Readers stay out while a writer holds the lock, and while someone is parked waiting for the
+    // current readers to leave. The only thing that parks while readers hold the lock is a writer.
+    static bool canLockShared(unsigned wordValue)
+    {
+        if (wordValue & isWriteHeldBit)
+            return false;
+        return !(wordValue & hasParkedBit) || !(wordValue & readerCountMask);
+    }
+
+    WTF_EXPORT_PRIVATE void lockSlow();
+    WTF_EXPORT_PRIVATE void unlockSlow();
+    WTF_EXPORT_PRIVATE void lockSharedSlow();
+    WTF_EXPORT_PRIVATE void unlockSharedSlow();
+
+    // Method used for testing only.
+    bool isFullyReset() const
+    {
+        return !m_word.load();
+    }
+
+    Atomic<unsigned> m_word;
+};
+
+class RWLock : public RWLockBase {
+    WTF_MAKE_NONCOPYABLE(RWLock);
+public:
+    RWLock()
+    {
+        m_word.store(0, std::memory_order_relaxed);
+    }
+};
+
+template<typename T> class ReadLocker {
+    WTF_MAKE_NONCOPYABLE(ReadLocker);
+public:
+    explicit ReadLocker(T& lockable)
+        : m_lockable(&lockable)
+    {
+        m_lockable->lockShared();
+    }
+
+    ~ReadLocker()
+    {
+        if (m_lockable)
+            m_lockable->unlockShared();
+    }
+
+    void unlockEarly()
+    {
+        m_lockable->unlockShared();
+        m_lockable = nullptr;
+    }
+
+private:
+    T* m_lockable;
+};
+
+typedef RWLockBase StaticRWLock;
+typedef ReadLocker<RWLockBase> ReadLockHolder;
+typedef Locker<RWLockBase> WriteLockHolder;
+
+} // namespace WTF
+
+using WTF::ReadLockHolder;
+using WTF::RWLock;
+using WTF::StaticRWLock;
+using WTF::WriteLockHolder;
+
+#endif // WTF_RWLock_h
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+#ifndef WTF_SeqLock_h
+#define WTF_SeqLock_h
+
+#include <string.h>
+#include <thread>
+#include <type_traits>
+#include <wtf/Atomics.h>
+#include <wtf/Noncopyable.h>
+
+namespace WTF {
+
+// A SeqLock guards a small POD value that is read far more often than it is written. Readers never
+// write to shared memory. They copy the value optimistically and retry if a writer got in the way, so
+// unlike with RWLock, readers on different cores don't fight over the cache line. Writers exclude each
+// other by spinning, so writes should be short and rare. The value is stored as machine words that
+// are accessed atomically, so a torn read is never observed, it is just retried.
+template<typename T>
+class SeqLock {
+    WTF_MAKE_NONCOPYABLE(SeqLock);
+    static_assert(std::is_pod<T>::value, "SeqLock can only copy its value with memcpy");
+public:
+    SeqLock()
+        : SeqLock(T())
+    {
+    }
+
+    explicit SeqLock(const T& value)
+    {
+        m_sequence.store(0, std::memory_order_relaxed);
+        storeWords(value);
+    }
+
+    T load() const
+    {
+        for (;;) {
+            unsigned sequence = m_sequence.load(std::memory_order_acquire);
+            if (sequence & 1) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            T result = loadWords();
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_sequence.load(std::memory_order_relaxed) == sequence)
+                return result;
+        }
+    }
+
+    void store(const T& value)
+    {
+        unsigned sequence = lockForWriting();
+        storeWords(value);
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // Atomically replaces the value with what the functor makes of it.
+    template<typename Functor>
+    void update(const Functor& functor)
+    {
+        unsigned sequence = lockForWriting();
+        T value = loadWords();
+        functor(value);
+        storeWords(value);
+        m_sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+private:
+    static const size_t numberOfWords = (sizeof(T) + sizeof(uintptr_t) - 1) / sizeof(uintptr_t);
+
+    unsigned lockForWriting()
+    {
+        for (;;) {
+            unsigned sequence = m_sequence.load(std::memory_order_relaxed);
+            if (!(sequence & 1) && m_sequence.compareExchangeWeak(sequence, sequence + 1)) {
+                // Keep our stores to the value from becoming visible before the odd sequence number.
+                std::atomic_thread_fence(std::memory_order_release);
+                return sequence;
+            }
+            std::this_thread::yield();
+        }
+    }
+
+    T loadWords() const
+    {
+        uintptr_t words[numberOfWords];
+        for (size_t i = 0; i < numberOfWords; ++i)
+            words[i] = m_words[i].load(std::memory_order_relaxed);
+        T result;
+        memcpy(&result, words, sizeof(T));
+        return result;
+    }
+
+    void storeWords(const T& value)
+    {
+        uintptr_t words[numberOfWords] = { };
+        memcpy(words, &value, sizeof(T));
+        for (size_t i = 0; i < numberOfWords; ++i)
+            m_words[i].store(words[i], std::memory_order_relaxed);
+    }
+
+    Atomic<unsigned> m_sequence;
+    Atomic<uintptr_t> m_words[numberOfWords];
+};
+
+} // namespace WTF
+
+using WTF::SeqLock;
+
+#endif // WTF_SeqLock_h
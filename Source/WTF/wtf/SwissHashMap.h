@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef WTF_SwissHashMap_h
+#define WTF_SwissHashMap_h
+
+#include <wtf/HashMap.h>
+#include <wtf/SwissHashTable.h>
+
+namespace WTF {
+
+// A map with the core of HashMap's interface, backed by a SwissHashTable. It suits large maps that
+// are mostly looked up, where HashTable's probing misses the cache. See SwissHashTable.h.
+template<typename KeyArg, typename MappedArg, typename HashArg = typename DefaultHash<KeyArg>::Hash>
+class SwissHashMap final {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    typedef KeyArg KeyType;
+    typedef MappedArg MappedType;
+    typedef KeyValuePair<KeyType, MappedType> KeyValuePairType;
+
+private:
+    typedef SwissHashTable<KeyValuePairType, KeyType, KeyValuePairKeyExtractor<KeyValuePairType>, HashArg> HashTableType;
+
+public:
+    typedef typename HashTableType::iterator iterator;
+    typedef typename HashTableType::const_iterator const_iterator;
+    typedef typename HashTableType::AddResult AddResult;
+
+    void swap(SwissHashMap& other) { m_impl.swap(other.m_impl); }
+
+    unsigned size() const { return m_impl.size(); }
+    unsigned capacity() const { return m_impl.capacity(); }
+    bool isEmpty() const { return m_impl.isEmpty(); }
+
+    iterator begin() { return m_impl.begin(); }
+    iterator end() { return m_impl.end(); }
+    const_iterator begin() const { return m_impl.begin(); }
+    const_iterator end() const { return m_impl.end(); }
+
+    iterator find(const KeyType& key) { return m_impl.find(key); }
+    const_iterator find(const KeyType& key) const { return m_impl.find(key); }
+    bool contains(const KeyType& key) const { return m_impl.contains(key); }
+
+    // Returns a default constructed value if the key is not in the map.
+    MappedType get(const KeyType& key) const
+    {
+        auto iterator = find(key);
+        if (iterator == end())
+            return MappedType();
+        return iterator->value;
+    }
+
+    // Replaces the value if the key is already in the map.
+    template<typename K, typename V> AddResult set(K&& key, V&& value)
+    {
+        AddResult result = m_impl.add(key, std::forward<K>(key), std::forward<V>(value));
+        if (!result.isNewEntry)
+            result.iterator->value = std::forward<V>(value);
+        return result;
+    }
+
+    // Does nothing if the key is already in the map.
+    template<typename K, typename V> AddResult add(K&& key, V&& value)
+    {
+        return m_impl.add(key, std::forward<K>(key), std::forward<V>(value));
+    }
+
+    bool remove(const KeyType& key) { return m_impl.remove(key); }
+    void remove(iterator iterator) { m_impl.remove(iterator); }
+    void clear() { m_impl.clear(); }
+
+    MappedType take(const KeyType& key)
+    {
+        auto iterator = find(key);
+        if (iterator == end())
+            return MappedType();
+        MappedType value = WTF::move(iterator->value);
+        remove(iterator);
+        return value;
+    }
+
+private:
+    HashTableType m_impl;
+};
+
+} // namespace WTF
+
+using WTF::SwissHashMap;
+
+#endif // WTF_SwissHashMap_h
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef WTF_SwissHashSet_h
+#define WTF_SwissHashSet_h
+
+#include <wtf/HashSet.h>
+#include <wtf/SwissHashTable.h>
+
+namespace WTF {
+
+// A set with the core of HashSet's interface, backed by a SwissHashTable. See SwissHashTable.h.
+template<typename ValueArg, typename HashArg = typename DefaultHash<ValueArg>::Hash>
+class SwissHashSet final {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    typedef ValueArg ValueType;
+
+private:
+    typedef SwissHashTable<ValueType, ValueType, IdentityExtractor, HashArg> HashTableType;
+
+public:
+    typedef typename HashTableType::const_iterator iterator;
+    typedef typename HashTableType::const_iterator const_iterator;
+    typedef typename HashTableType::AddResult AddResult;
+
+    SwissHashSet() { }
+
+    SwissHashSet(std::initializer_list<ValueType> initializerList)
+    {
+        for (const auto& value : initializerList)
+            add(value);
+    }
+
+    void swap(SwissHashSet& other) { m_impl.swap(other.m_impl); }
+
+    unsigned size() const { return m_impl.size(); }
+    unsigned capacity() const { return m_impl.capacity(); }
+    bool isEmpty() const { return m_impl.isEmpty(); }
+
+    iterator begin() const { return m_impl.begin(); }
+    iterator end() const { return m_impl.end(); }
+
+    iterator find(const ValueType& value) const { return m_impl.find(value); }
+    bool contains(const ValueType& value) const { return m_impl.contains(value); }
+
+    template<typename V> AddResult add(V&& value) { return m_impl.add(value, std::forward<V>(value)); }
+
+    bool remove(const ValueType& value) { return m_impl.remove(value); }
+    void clear() { m_impl.clear(); }
+
+private:
+    HashTableType m_impl;
+};
+
+} // namespace WTF
+
+using WTF::SwissHashSet;
+
+#endif // WTF_SwissHashSet_h
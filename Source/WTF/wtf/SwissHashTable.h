@@ -0,0 +1,461 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef WTF_SwissHashTable_h
+#define WTF_SwissHashTable_h
+
+#include <cstring>
+#include <iterator>
+#include <wtf/Assertions.h>
+#include <wtf/FastMalloc.h>
+#include <wtf/HashTable.h>
+#include <wtf/StdLibExtras.h>
+
+#if CPU(X86_64)
+#include <emmintrin.h>
+#endif
+
+namespace WTF {
+
+// A hash table in the style of Abseil's "Swiss tables". Besides the buckets, it keeps one control
+// byte per bucket that holds either 7 bits of the entry's hash or a marker for an empty or deleted
+// bucket. A lookup compares a whole group of 16 control bytes against the hash at once, so it
+// usually touches one cache line of metadata and only the buckets whose 7 bits match, instead of
+// one bucket per probe as HashTable's double hashing does.
+//
+// Keys do not need an empty or a deleted value, so only the hash functions are used from the
+// traits. Any addition or removal invalidates all iterators.
+
+namespace SwissHashTableInternal {
+
+typedef int8_t ControlByte;
+
+const ControlByte emptyControl = -128;
+const ControlByte deletedControl = -2;
+const unsigned groupWidth = 16;
+const unsigned minimumCapacity = groupWidth;
+
+inline bool isFull(ControlByte control) { return control >= 0; }
+
+inline unsigned countTrailingZeros(uint32_t bits)
+{
+    ASSERT(bits);
+#if COMPILER(GCC_OR_CLANG)
+    return __builtin_ctz(bits);
+#else
+    unsigned count = 0;
+    while (!(bits & 1)) {
+        bits >>= 1;
+        ++count;
+    }
+    return count;
+#endif
+}
+
+inline unsigned countLeadingZerosInGroup(uint32_t bits)
+{
+    ASSERT(bits);
+    unsigned count = 0;
+    for (uint32_t bit = 1 << (groupWidth - 1); !(bits & bit); bit >>= 1)
+        ++count;
+    return count;
+}
+
+// One bit per control byte in a group, set for the bytes that matched.
+class GroupMask {
+public:
+    explicit GroupMask(uint32_t bits)
+        : m_bits(bits)
+    {
+    }
+
+    explicit operator bool() const { return m_bits; }
+    uint32_t bits() const { return m_bits; }
+    unsigned lowest() const { return countTrailingZeros(m_bits); }
+    void clearLowest() { m_bits &= m_bits - 1; }
+
+private:
+    uint32_t m_bits;
+};
+
+class Group {
+public:
+    explicit Group(const ControlByte* controls)
+#if CPU(X86_64)
+        : m_controls(_mm_loadu_si128(reinterpret_cast<const __m128i*>(controls)))
+#else
+        : m_controls(controls)
+#endif
+    {
+    }
+
+    GroupMask match(ControlByte control) const
+    {
+#if CPU(X86_64)
+        return GroupMask(_mm_movemask_epi8(_mm_cmpeq_epi8(m_controls, _mm_set1_epi8(control))));
+#else
+        uint32_t bits = 0;
+        for (unsigned i = 0; i < groupWidth; ++i)
+            bits |= static_cast<uint32_t>(m_controls[i] == control) << i;
+        return GroupMask(bits);
+#endif
+    }
+
+    GroupMask matchEmpty() const { return match(emptyControl); }
+
+    GroupMask matchEmptyOrDeleted() const
+    {
+        // Both markers are negative and smaller than -1; full buckets hold values in [0, 127].
+#if CPU(X86_64)
+        return GroupMask(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1), m_controls)));
+#else
+        uint32_t bits = 0;
+        for (unsigned i = 0; i < groupWidth; ++i)
+            bits |= static_cast<uint32_t>(m_controls[i] < -1) << i;
+        return GroupMask(bits);
+#endif
+    }
+
+private:
+#if CPU(X86_64)
+    __m128i m_controls;
+#else
+    const ControlByte* m_controls;
+#endif
+};
+
+// The bucket index comes from the low bits of the hash. The 7 bits kept in the control byte come
+// from the high bits of a multiplicative mix, so that they are independent of the bucket index,
+// even for hashes like StringHasher's that leave their top bits clear.
+inline ControlByte controlForHash(unsigned hash)
+{
+    return static_cast<ControlByte>((hash * 0x9E3779B1U) >> 25);
+}
+
+} // namespace SwissHashTableInternal
+
+template<typename Table, typename ValueType> class SwissHashTableIterator : public std::iterator<std::forward_iterator_tag, ValueType> {
+public:
+    SwissHashTableIterator(Table* table, unsigned index)
+        : m_table(table)
+        , m_index(index)
+    {
+        skipNonFullBuckets();
+    }
+
+    template<typename OtherTable, typename OtherValueType>
+    SwissHashTableIterator(const SwissHashTableIterator<OtherTable, OtherValueType>& other)
+        : m_table(other.m_table)
+        , m_index(other.m_index)
+    {
+    }
+
+    ValueType& operator*() const { return m_table->bucket(m_index); }
+    ValueType* operator->() const { return &m_table->bucket(m_index); }
+
+    SwissHashTableIterator& operator++()
+    {
+        ++m_index;
+        skipNonFullBuckets();
+        return *this;
+    }
+
+    bool operator==(const SwissHashTableIterator& other) const { return m_index == other.m_index; }
+    bool operator!=(const SwissHashTableIterator& other) const { return m_index != other.m_index; }
+
+private:
+    template<typename, typename> friend class SwissHashTableIterator;
+    template<typename, typename, typename, typename> friend class SwissHashTable;
+
+    void skipNonFullBuckets()
+    {
+        while (m_index < m_table->capacity() && !SwissHashTableInternal::isFull(m_table->m_controls[m_index]))
+            ++m_index;
+    }
+
+    Table* m_table;
+    unsigned m_index;
+};
+
+template<typename Value, typename Key, typename Extractor, typename HashFunctions>
+class SwissHashTable {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    typedef Value ValueType;
+    typedef Key KeyType;
+    typedef SwissHashTableIterator<SwissHashTable, ValueType> iterator;
+    typedef SwissHashTableIterator<const SwissHashTable, const ValueType> const_iterator;
+
+    typedef HashTableAddResult<iterator> AddResult;
+
+    SwissHashTable() { }
+
+    SwissHashTable(const SwissHashTable& other)
+    {
+        if (!other.m_size)
+            return;
+        allocate(other.m_capacity);
+        memcpy(m_controls, other.m_controls, m_capacity + SwissHashTableInternal::groupWidth);
+        for (unsigned i = 0; i < m_capacity; ++i) {
+            if (SwissHashTableInternal::isFull(m_controls[i]))
+                new (NotNull, &m_buckets[i]) ValueType(other.m_buckets[i]);
+        }
+        m_size = other.m_size;
+        m_growthLeft = other.m_growthLeft;
+    }
+
+    SwissHashTable(SwissHashTable&& other)
+    {
+        swap(other);
+    }
+
+    SwissHashTable& operator=(const SwissHashTable& other)
+    {
+        SwissHashTable copy(other);
+        swap(copy);
+        return *this;
+    }
+
+    SwissHashTable& operator=(SwissHashTable&& other)
+    {
+        SwissHashTable moved(WTF::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~SwissHashTable()
+    {
+        deallocate();
+    }
+
+    void swap(SwissHashTable& other)
+    {
+        std::swap(m_controls, other.m_controls);
+        std::swap(m_buckets, other.m_buckets);
+        std::swap(m_capacity, other.m_capacity);
+        std::swap(m_size, other.m_size);
+        std::swap(m_growthLeft, other.m_growthLeft);
+    }
+
+    unsigned size() const { return m_size; }
+    unsigned capacity() const { return m_capacity; }
+    bool isEmpty() const { return !m_size; }
+
+    iterator begin() { return iterator(this, 0); }
+    iterator end() { return iterator(this, m_capacity); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, m_capacity); }
+
+    iterator find(const KeyType& key) { return iterator(this, findIndex(key)); }
+    const_iterator find(const KeyType& key) const { return const_iterator(this, findIndex(key)); }
+    bool contains(const KeyType& key) const { return findIndex(key) != m_capacity; }
+
+    // Constructs a ValueType from arguments in a new bucket if no entry has the given key.
+    template<typename... Arguments>
+    AddResult add(const KeyType& key, Arguments&&... arguments)
+    {
+        unsigned index = findIndex(key);
+        if (index != m_capacity)
+            return AddResult(iterator(this, index), false);
+
+        unsigned hash = HashFunctions::hash(key);
+        if (!m_capacity)
+            grow();
+        index = findInsertionIndex(hash);
+        if (!m_growthLeft && m_controls[index] != SwissHashTableInternal::deletedControl) {
+            grow();
+            index = findInsertionIndex(hash);
+        }
+
+        if (m_controls[index] == SwissHashTableInternal::emptyControl)
+            --m_growthLeft;
+        setControl(index, SwissHashTableInternal::controlForHash(hash));
+        new (NotNull, &m_buckets[index]) ValueType(std::forward<Arguments>(arguments)...);
+        ++m_size;
+        return AddResult(iterator(this, index), true);
+    }
+
+    void remove(iterator position)
+    {
+        ASSERT(position.m_table == this);
+        removeAtIndex(position.m_index);
+    }
+
+    bool remove(const KeyType& key)
+    {
+        unsigned index = findIndex(key);
+        if (index == m_capacity)
+            return false;
+        removeAtIndex(index);
+        return true;
+    }
+
+    void clear()
+    {
+        SwissHashTable empty;
+        swap(empty);
+    }
+
+private:
+    template<typename, typename> friend class SwissHashTableIterator;
+
+    static unsigned maximumLoad(unsigned capacity) { return capacity - capacity / 8; }
+
+    ValueType& bucket(unsigned index) { return m_buckets[index]; }
+    const ValueType& bucket(unsigned index) const { return m_buckets[index]; }
+
+    void allocate(unsigned capacity)
+    {
+        ASSERT(!m_controls);
+        ASSERT(capacity >= SwissHashTableInternal::minimumCapacity && !(capacity & (capacity - 1)));
+        // The control bytes are followed by a copy of the first group's, so that a group can be
+        // loaded starting at any bucket without wrapping around.
+        size_t controlsSize = roundUpToMultipleOf<alignof(ValueType)>(capacity + SwissHashTableInternal::groupWidth);
+        char* memory = static_cast<char*>(fastMalloc(controlsSize + static_cast<size_t>(capacity) * sizeof(ValueType)));
+        m_controls = reinterpret_cast<SwissHashTableInternal::ControlByte*>(memory);
+        m_buckets = reinterpret_cast<ValueType*>(memory + controlsSize);
+        memset(m_controls, static_cast<uint8_t>(SwissHashTableInternal::emptyControl), capacity + SwissHashTableInternal::groupWidth);
+        m_capacity = capacity;
+        m_size = 0;
+        m_growthLeft = maximumLoad(capacity);
+    }
+
+    void deallocate()
+    {
+        if (!m_controls)
+            return;
+        for (unsigned i = 0; i < m_capacity; ++i) {
+            if (SwissHashTableInternal::isFull(m_controls[i]))
+                m_buckets[i].~ValueType();
+        }
+        fastFree(m_controls);
+        m_controls = nullptr;
+        m_buckets = nullptr;
+        m_capacity = 0;
+        m_size = 0;
+        m_growthLeft = 0;
+    }
+
+    void setControl(unsigned index, SwissHashTableInternal::ControlByte control)
+    {
+        m_controls[index] = control;
+        if (index < SwissHashTableInternal::groupWidth)
+            m_controls[m_capacity + index] = control;
+    }
+
+    // Returns m_capacity if there is no entry with the given key.
+    unsigned findIndex(const KeyType& key) const
+    {
+        if (!m_size)
+            return m_capacity;
+
+        unsigned hash = HashFunctions::hash(key);
+        SwissHashTableInternal::ControlByte control = SwissHashTableInternal::controlForHash(hash);
+        unsigned mask = m_capacity - 1;
+        unsigned position = hash & mask;
+        // Probing by a growing number of groups visits every group when the number of groups is a power of two.
+        for (unsigned step = SwissHashTableInternal::groupWidth; ; step += SwissHashTableInternal::groupWidth) {
+            SwissHashTableInternal::Group group(m_controls + position);
+            for (SwissHashTableInternal::GroupMask matches = group.match(control); matches; matches.clearLowest()) {
+                unsigned index = (position + matches.lowest()) & mask;
+                if (HashFunctions::equal(Extractor::extract(m_buckets[index]), key))
+                    return index;
+            }
+            // A lookup would have stopped at this group's empty bucket, so no insertion went past it.
+            if (group.matchEmpty())
+                return m_capacity;
+            position = (position + step) & mask;
+        }
+    }
+
+    unsigned findInsertionIndex(unsigned hash) const
+    {
+        ASSERT(m_capacity);
+        unsigned mask = m_capacity - 1;
+        unsigned position = hash & mask;
+        for (unsigned step = SwissHashTableInternal::groupWidth; ; step += SwissHashTableInternal::groupWidth) {
+            SwissHashTableInternal::GroupMask available = SwissHashTableInternal::Group(m_controls + position).matchEmptyOrDeleted();
+            if (available)
+                return (position + available.lowest()) & mask;
+            position = (position + step) & mask;
+        }
+    }
+
+    void removeAtIndex(unsigned index)
+    {
+        ASSERT(index < m_capacity && SwissHashTableInternal::isFull(m_controls[index]));
+        m_buckets[index].~ValueType();
+        --m_size;
+
+        // The bucket can become empty again only if no lookup could have probed past it, which is the
+        // case when every group that contains it also contains an empty bucket.
+        unsigned mask = m_capacity - 1;
+        SwissHashTableInternal::GroupMask emptyAfter = SwissHashTableInternal::Group(m_controls + index).matchEmpty();
+        SwissHashTableInternal::GroupMask emptyBefore = SwissHashTableInternal::Group(m_controls + ((index - SwissHashTableInternal::groupWidth) & mask)).matchEmpty();
+        if (emptyAfter && emptyBefore
+            && SwissHashTableInternal::countTrailingZeros(emptyAfter.bits()) + SwissHashTableInternal::countLeadingZerosInGroup(emptyBefore.bits()) < SwissHashTableInternal::groupWidth) {
+            setControl(index, SwissHashTableInternal::emptyControl);
+            ++m_growthLeft;
+            return;
+        }
+        setControl(index, SwissHashTableInternal::deletedControl);
+    }
+
+    void grow()
+    {
+        // If deleted buckets take up much of the table, reclaim them instead of growing.
+        unsigned newCapacity = SwissHashTableInternal::minimumCapacity;
+        if (m_capacity)
+            newCapacity = m_size * 32 <= m_capacity * 25 ? m_capacity : m_capacity * 2;
+        rehash(newCapacity);
+    }
+
+    void rehash(unsigned newCapacity)
+    {
+        SwissHashTable oldTable;
+        swap(oldTable);
+        allocate(newCapacity);
+        for (unsigned i = 0; i < oldTable.m_capacity; ++i) {
+            if (!SwissHashTableInternal::isFull(oldTable.m_controls[i]))
+                continue;
+            unsigned hash = HashFunctions::hash(Extractor::extract(oldTable.m_buckets[i]));
+            unsigned index = findInsertionIndex(hash);
+            setControl(index, SwissHashTableInternal::controlForHash(hash));
+            new (NotNull, &m_buckets[index]) ValueType(WTF::move(oldTable.m_buckets[i]));
+            ++m_size;
+            --m_growthLeft;
+        }
+    }
+
+    SwissHashTableInternal::ControlByte* m_controls { nullptr };
+    ValueType* m_buckets { nullptr };
+    unsigned m_capacity { 0 };
+    unsigned m_size { 0 };
+    unsigned m_growthLeft { 0 };
+};
+
+} // namespace WTF
+
+#endif // WTF_SwissHashTable_h
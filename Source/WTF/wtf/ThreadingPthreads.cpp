@@ -43,6 +43,7 @@
 #include "ThreadFunctionInvocation.h"
 #include "ThreadIdentifierDataPthreads.h"
 #include "ThreadSpecific.h"
+#include "TraceEvent.h"
 #include <wtf/DataLog.h>
 #include <wtf/RawPointer.h>
 #include <wtf/WTFThreadData.h>
@@ -125,6 +126,7 @@ void initializeThreading()
     ThreadIdentifierData::initializeOnce();
     wtfThreadData();
     initializeDates();
+    TraceEventLog::initializeFromEnvironment();
 }
 
 static ThreadMap& threadMap()
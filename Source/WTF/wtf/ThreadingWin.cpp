@@ -100,6 +100,7 @@
 #include <wtf/HashMap.h>
 #include <wtf/MathExtras.h>
 #include <wtf/RandomNumberSeed.h>
+#include <wtf/TraceEvent.h>
 #include <wtf/WTFThreadData.h>
 
 #if !USE(PTHREADS) && OS(WINDOWS)
@@ -166,6 +167,7 @@ void initializeThreading()
     initializeRandomNumberGenerator();
     wtfThreadData();
     initializeDates();
+    TraceEventLog::initializeFromEnvironment();
 }
 
 static HashMap<DWORD, HANDLE>& threadMap()
@@ -0,0 +1,241 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "TraceEvent.h"
+
+#include "FilePrintStream.h"
+#include "Lock.h"
+#include "NeverDestroyed.h"
+#include "ProcessID.h"
+#include "ThreadSpecific.h"
+#include "Threading.h"
+#include "Vector.h"
+#include "text/CString.h"
+#include "text/StringBuilder.h"
+#include "text/StringConcatenate.h"
+#include "text/WTFString.h"
+#include <mutex>
+#include <stdlib.h>
+
+namespace WTF {
+
+std::atomic<unsigned> enabledTraceCategories;
+
+static const size_t maxEventsPerThread = 8192;
+
+static const struct {
+    TraceCategory category;
+    const char* name;
+} traceCategoryNames[] = {
+    { TraceCategory::Style, "style" },
+    { TraceCategory::Layout, "layout" },
+    { TraceCategory::Paint, "paint" },
+    { TraceCategory::GarbageCollection, "gc" },
+    { TraceCategory::JITCompilation, "jit" },
+    { TraceCategory::IPC, "ipc" },
+    { TraceCategory::Network, "network" },
+    { TraceCategory::Parsing, "parsing" },
+    { TraceCategory::JavaScript, "js" },
+};
+
+static const char* nameForCategory(TraceCategory category)
+{
+    for (auto& entry : traceCategoryNames) {
+        if (entry.category == category)
+            return entry.name;
+    }
+    ASSERT_NOT_REACHED();
+    return "";
+}
+
+struct TraceEvent {
+    const char* name;
+    TraceCategory category;
+    double startTime;
+    double endTime;
+};
+
+class ThreadTraceBuffer;
+
+static StaticLock threadTraceBuffersLock;
+
+static Vector<ThreadTraceBuffer*>& threadTraceBuffers()
+{
+    static NeverDestroyed<Vector<ThreadTraceBuffer*>> buffers;
+    return buffers;
+}
+
+// Only the owning thread appends to a buffer, so its lock is uncontended except while exporting.
+class ThreadTraceBuffer {
+    WTF_MAKE_NONCOPYABLE(ThreadTraceBuffer); WTF_MAKE_FAST_ALLOCATED;
+public:
+    ThreadTraceBuffer()
+        : m_threadID(currentThread())
+    {
+        LockHolder locker(threadTraceBuffersLock);
+        threadTraceBuffers().append(this);
+    }
+
+    ~ThreadTraceBuffer()
+    {
+        LockHolder locker(threadTraceBuffersLock);
+        threadTraceBuffers().removeFirst(this);
+    }
+
+    void add(const TraceEvent& event)
+    {
+        LockHolder locker(m_lock);
+        if (m_events.size() < maxEventsPerThread) {
+            m_events.append(event);
+            return;
+        }
+        m_events[m_oldestEventIndex] = event;
+        m_oldestEventIndex = (m_oldestEventIndex + 1) % maxEventsPerThread;
+    }
+
+    void clear()
+    {
+        LockHolder locker(m_lock);
+        m_events.clear();
+        m_oldestEventIndex = 0;
+    }
+
+    template<typename Functor>
+    void forEachEvent(const Functor& functor)
+    {
+        LockHolder locker(m_lock);
+        for (size_t i = 0; i < m_events.size(); ++i)
+            functor(m_events[(m_oldestEventIndex + i) % m_events.size()]);
+    }
+
+    ThreadIdentifier threadID() const { return m_threadID; }
+
+private:
+    Lock m_lock;
+    Vector<TraceEvent> m_events;
+    size_t m_oldestEventIndex { 0 };
+    ThreadIdentifier m_threadID;
+};
+
+static ThreadSpecific<ThreadTraceBuffer>& threadTraceBuffer()
+{
+    static std::once_flag onceFlag;
+    static LazyNeverDestroyed<ThreadSpecific<ThreadTraceBuffer>> buffer;
+    std::call_once(onceFlag, [] {
+        buffer.construct();
+    });
+    return buffer;
+}
+
+void TraceEventLog::setEnabledCategories(unsigned categories)
+{
+    enabledTraceCategories.store(categories, std::memory_order_relaxed);
+}
+
+static const char* traceFilePrefix;
+
+static void writeTraceFileAtExit()
+{
+    CString path = makeString(traceFilePrefix, '.', String::number(getCurrentProcessID()), ".json").utf8();
+    std::unique_ptr<FilePrintStream> file = FilePrintStream::open(path.data(), "w");
+    if (!file)
+        return;
+    file->print(TraceEventLog::exportChromeTraceJSON());
+}
+
+void TraceEventLog::initializeFromEnvironment()
+{
+    const char* value = getenv("WEBKIT_TRACE_CATEGORIES");
+    if (!value)
+        return;
+
+    traceFilePrefix = getenv("WEBKIT_TRACE_FILE");
+    if (traceFilePrefix)
+        atexit(writeTraceFileAtExit);
+
+    unsigned categories = 0;
+    Vector<String> names;
+    String(value).split(',', names);
+    for (auto& name : names) {
+        String trimmedName = name.stripWhiteSpace();
+        for (auto& entry : traceCategoryNames) {
+            if (trimmedName == "all" || trimmedName == entry.name)
+                categories |= static_cast<unsigned>(entry.category);
+        }
+    }
+    setEnabledCategories(categories);
+}
+
+void TraceEventLog::addCompleteEvent(TraceCategory category, const char* name, double startTime, double endTime)
+{
+    threadTraceBuffer()->add({ name, category, startTime, endTime });
+}
+
+String TraceEventLog::exportChromeTraceJSON()
+{
+    int processID = getCurrentProcessID();
+
+    StringBuilder builder;
+    builder.appendLiteral("{\"traceEvents\":[");
+    bool isFirstEvent = true;
+
+    LockHolder locker(threadTraceBuffersLock);
+    for (auto* buffer : threadTraceBuffers()) {
+        ThreadIdentifier threadID = buffer->threadID();
+        buffer->forEachEvent([&] (const TraceEvent& event) {
+            if (!isFirstEvent)
+                builder.append(',');
+            isFirstEvent = false;
+
+            // Chrome trace timestamps and durations are in microseconds.
+            builder.appendLiteral("{\"name\":");
+            builder.appendQuotedJSONString(String(event.name));
+            builder.appendLiteral(",\"cat\":\"");
+            builder.append(nameForCategory(event.category));
+            builder.appendLiteral("\",\"ph\":\"X\",\"ts\":");
+            builder.appendECMAScriptNumber(event.startTime * 1000000);
+            builder.appendLiteral(",\"dur\":");
+            builder.appendECMAScriptNumber((event.endTime - event.startTime) * 1000000);
+            builder.appendLiteral(",\"pid\":");
+            builder.appendNumber(processID);
+            builder.appendLiteral(",\"tid\":");
+            builder.appendNumber(threadID);
+            builder.append('}');
+        });
+    }
+
+    builder.appendLiteral("]}");
+    return builder.toString();
+}
+
+void TraceEventLog::clear()
+{
+    LockHolder locker(threadTraceBuffersLock);
+    for (auto* buffer : threadTraceBuffers())
+        buffer->clear();
+}
+
+} // namespace WTF
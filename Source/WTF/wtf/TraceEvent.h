@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef TraceEvent_h
+#define TraceEvent_h
+
+#include <atomic>
+#include <wtf/CurrentTime.h>
+#include <wtf/Forward.h>
+#include <wtf/Noncopyable.h>
+
+namespace WTF {
+
+enum class TraceCategory : unsigned {
+    Style = 1 << 0,
+    Layout = 1 << 1,
+    Paint = 1 << 2,
+    GarbageCollection = 1 << 3,
+    JITCompilation = 1 << 4,
+    IPC = 1 << 5,
+    Network = 1 << 6,
+    Parsing = 1 << 7,
+    JavaScript = 1 << 8,
+};
+
+extern WTF_EXPORTDATA std::atomic<unsigned> enabledTraceCategories;
+
+// A process-wide trace event log. Each thread records into its own fixed size ring buffer, so recording
+// never contends with other threads; exporting produces the Chrome trace event JSON format, which lets
+// traces from several processes be loaded side by side. Categories are off unless enabled at runtime,
+// either through setEnabledCategories() or the WEBKIT_TRACE_CATEGORIES environment variable (a comma
+// separated list of category names, or "all"). If WEBKIT_TRACE_FILE is also set, each process writes its
+// trace to "<WEBKIT_TRACE_FILE>.<pid>.json" when it exits.
+class TraceEventLog {
+public:
+    static bool isEnabled(TraceCategory category) { return enabledTraceCategories.load(std::memory_order_relaxed) & static_cast<unsigned>(category); }
+
+    WTF_EXPORT_PRIVATE static void setEnabledCategories(unsigned);
+    WTF_EXPORT_PRIVATE static void initializeFromEnvironment();
+
+    // The name must be a string literal, it is not copied.
+    WTF_EXPORT_PRIVATE static void addCompleteEvent(TraceCategory, const char* name, double startTime, double endTime);
+
+    WTF_EXPORT_PRIVATE static String exportChromeTraceJSON();
+    WTF_EXPORT_PRIVATE static void clear();
+};
+
+class TraceScope {
+    WTF_MAKE_NONCOPYABLE(TraceScope);
+public:
+    TraceScope(TraceCategory category, const char* name)
+        : m_category(category)
+        , m_name(name)
+        , m_startTime(TraceEventLog::isEnabled(category) ? monotonicallyIncreasingTime() : 0)
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (m_startTime)
+            TraceEventLog::addCompleteEvent(m_category, m_name, m_startTime, monotonicallyIncreasingTime());
+    }
+
+private:
+    TraceCategory m_category;
+    const char* m_name;
+    double m_startTime;
+};
+
+} // namespace WTF
+
+using WTF::TraceCategory;
+using WTF::TraceEventLog;
+using WTF::TraceScope;
+
+#endif // TraceEvent_h
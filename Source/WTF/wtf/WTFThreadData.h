@@ -51,6 +51,7 @@
 
 namespace WTF {
 
+class Arena;
 class AtomicStringTable;
 
 typedef void (*AtomicStringTableDestructor)(AtomicStringTable*);
@@ -78,6 +79,18 @@ public:
         m_currentAtomicStringTable = m_defaultAtomicStringTable;
     }
 
+    Arena* currentArena()
+    {
+        return m_currentArena;
+    }
+
+    Arena* setCurrentArena(Arena* arena)
+    {
+        Arena* oldArena = m_currentArena;
+        m_currentArena = arena;
+        return oldArena;
+    }
+
     const StackBounds& stack()
     {
         // We need to always get a fresh StackBounds from the OS due to how fibers work.
@@ -121,6 +134,7 @@ private:
     AtomicStringTable* m_currentAtomicStringTable;
     AtomicStringTable* m_defaultAtomicStringTable;
     AtomicStringTableDestructor m_atomicStringTableDestructor;
+    Arena* m_currentArena;
 
     StackBounds m_stackBounds;
 #if ENABLE(STACK_STATS)
@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+#include "config.h"
+#include "WorkStealingScheduler.h"
+
+#include "NumberOfCores.h"
+#include "ParkingLot.h"
+#include "WeakRandom.h"
+#include <algorithm>
+#include <mutex>
+
+namespace WTF {
+
+struct WorkStealingScheduler::Job {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    Job(RefPtr<SharedTask<void ()>> task, WorkStealingTaskGroup* group, Priority priority)
+        : task(task)
+        , group(group)
+        , priority(static_cast<unsigned>(priority))
+    {
+    }
+
+    RefPtr<SharedTask<void ()>> task;
+    WorkStealingTaskGroup* group;
+    unsigned priority;
+};
+
+struct WorkStealingScheduler::Worker {
+    WTF_MAKE_NONCOPYABLE(Worker);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    Worker(unsigned index)
+        : random(index + 1)
+    {
+    }
+
+    WorkStealingDeque<Job> deques[numberOfPriorities];
+    WeakRandom random;
+    std::atomic<ThreadIdentifier> thread { 0 };
+};
+
+Ref<WorkStealingScheduler> WorkStealingScheduler::create(unsigned numberOfWorkers)
+{
+    if (!numberOfWorkers)
+        numberOfWorkers = std::max(numberOfProcessorCores() - 1, 1);
+    return adoptRef(*new WorkStealingScheduler(numberOfWorkers));
+}
+
+WorkStealingScheduler::WorkStealingScheduler(unsigned numberOfWorkers)
+{
+    RELEASE_ASSERT(numberOfWorkers);
+
+    // Every worker has to exist before any thread starts, since workers steal from each other.
+    for (unsigned i = 0; i < numberOfWorkers; ++i)
+        m_workers.append(std::make_unique<Worker>(i));
+
+    for (auto& worker : m_workers) {
+        Worker* workerPtr = worker.get();
+        m_threads.append(createThread(
+            "WTF Work Stealing Worker",
+            [this, workerPtr] () {
+                workerThreadBody(*workerPtr);
+            }));
+    }
+}
+
+WorkStealingScheduler::~WorkStealingScheduler()
+{
+    RELEASE_ASSERT(!currentWorker());
+
+    m_isShuttingDown.store(true);
+    ParkingLot::unparkAll(&m_numberOfQueuedJobs);
+
+    for (ThreadIdentifier threadIdentifier : m_threads)
+        waitForThreadCompletion(threadIdentifier);
+
+    RELEASE_ASSERT(m_numberOfQueuedJobs.load() <= 0);
+}
+
+WorkStealingScheduler& WorkStealingScheduler::shared()
+{
+    static std::once_flag initializeSchedulerOnceFlag;
+    static WorkStealingScheduler* scheduler;
+    std::call_once(
+        initializeSchedulerOnceFlag,
+        [] {
+            scheduler = &create().leakRef();
+        });
+    return *scheduler;
+}
+
+void WorkStealingScheduler::schedule(RefPtr<SharedTask<void ()>> task, Priority priority)
+{
+    RELEASE_ASSERT(task);
+    enqueue(new Job(task, nullptr, priority));
+}
+
+void WorkStealingScheduler::enqueue(Job* job)
+{
+    if (Worker* worker = currentWorker())
+        worker->deques[job->priority].push(job);
+    else {
+        LockHolder locker(m_injectionLock);
+        m_injectionQueues[job->priority].append(job);
+        m_numberOfInjectedJobs.fetch_add(1);
+    }
+
+    // This has to happen after the job is visible, and before we look for sleepers. A thread that
+    // registered as a sleeper after this point will see the job when it validates its park.
+    m_numberOfQueuedJobs.fetch_add(1);
+    if (m_numberOfSleepingWorkers.load())
+        ParkingLot::unparkOne(&m_numberOfQueuedJobs);
+    if (m_numberOfSleepingWaiters.load())
+        ParkingLot::unparkOne(&m_numberOfSleepingWaiters);
+}
+
+auto WorkStealingScheduler::findJob(Worker* worker) -> Job*
+{
+    for (unsigned priority = 0; priority < numberOfPriorities; ++priority) {
+        if (worker) {
+            if (Job* job = worker->deques[priority].pop())
+                return job;
+        }
+
+        if (m_numberOfInjectedJobs.load()) {
+            LockHolder locker(m_injectionLock);
+            if (!m_injectionQueues[priority].isEmpty()) {
+                m_numberOfInjectedJobs.fetch_sub(1);
+                return m_injectionQueues[priority].takeFirst();
+            }
+        }
+
+        if (Job* job = stealJob(worker, priority))
+            return job;
+    }
+    return nullptr;
+}
+
+auto WorkStealingScheduler::stealJob(Worker* thief, unsigned priority) -> Job*
+{
+    // Threads that aren't workers always start with the first worker. That's fine, since they
+    // only steal while waiting for a group.
+    unsigned startIndex = thief ? thief->random.getUint32(m_workers.size()) : 0;
+    for (unsigned i = 0; i < m_workers.size(); ++i) {
+        Worker* victim = m_workers[(startIndex + i) % m_workers.size()].get();
+        if (victim == thief || victim->deques[priority].isEmpty())
+            continue;
+        if (Job* job = victim->deques[priority].steal())
+            return job;
+    }
+    return nullptr;
+}
+
+void WorkStealingScheduler::runJob(Job* job)
+{
+    m_numberOfQueuedJobs.fetch_sub(1);
+
+    job->task->run();
+
+    // Destroy the task before telling the group, since the task may refer to things that only live
+    // until the group's wait() returns.
+    WorkStealingTaskGroup* group = job->group;
+    delete job;
+
+    if (!group)
+        return;
+    if (group->m_numberOfPendingJobs.fetch_sub(1) != 1)
+        return;
+    // The group may be gone by now, so only use its address.
+    if (m_numberOfSleepingWaiters.load())
+        ParkingLot::unparkAll(&m_numberOfSleepingWaiters);
+}
+
+void WorkStealingScheduler::waitFor(WorkStealingTaskGroup& group)
+{
+    Worker* worker = currentWorker();
+    while (group.m_numberOfPendingJobs.load()) {
+        if (Job* job = findJob(worker)) {
+            runJob(job);
+            continue;
+        }
+
+        // Waiters share one address, so that a waiter wakes up to help whenever new work shows up.
+        // If we only woke up when our group finished, then workers blocked in wait() could end up
+        // parked while there are jobs that nobody is running.
+        m_numberOfSleepingWaiters.fetch_add(1);
+        ParkingLot::parkConditionally(
+            &m_numberOfSleepingWaiters,
+            [&] () -> bool {
+                return group.m_numberOfPendingJobs.load() && m_numberOfQueuedJobs.load() <= 0;
+            },
+            [] () { },
+            ParkingLot::Clock::time_point::max());
+        m_numberOfSleepingWaiters.fetch_sub(1);
+    }
+}
+
+auto WorkStealingScheduler::currentWorker() -> Worker*
+{
+    ThreadIdentifier thread = currentThread();
+    for (auto& worker : m_workers) {
+        if (worker->thread.load(std::memory_order_relaxed) == thread)
+            return worker.get();
+    }
+    return nullptr;
+}
+
+void WorkStealingScheduler::workerThreadBody(Worker& worker)
+{
+    worker.thread.store(currentThread(), std::memory_order_relaxed);
+
+    for (;;) {
+        if (Job* job = findJob(&worker)) {
+            runJob(job);
+            continue;
+        }
+
+        // All queued jobs get run before we quit, including the ones without a group.
+        if (m_isShuttingDown.load())
+            return;
+
+        m_numberOfSleepingWorkers.fetch_add(1);
+        ParkingLot::parkConditionally(
+            &m_numberOfQueuedJobs,
+            [this] () -> bool {
+                return m_numberOfQueuedJobs.load() <= 0 && !m_isShuttingDown.load();
+            },
+            [] () { },
+            ParkingLot::Clock::time_point::max());
+        m_numberOfSleepingWorkers.fetch_sub(1);
+    }
+}
+
+WorkStealingTaskGroup::WorkStealingTaskGroup(WorkStealingScheduler& scheduler)
+    : m_scheduler(scheduler)
+{
+}
+
+WorkStealingTaskGroup::~WorkStealingTaskGroup()
+{
+    wait();
+}
+
+void WorkStealingTaskGroup::schedule(RefPtr<SharedTask<void ()>> task, WorkStealingScheduler::Priority priority)
+{
+    RELEASE_ASSERT(task);
+    m_numberOfPendingJobs.fetch_add(1);
+    m_scheduler->enqueue(new WorkStealingScheduler::Job(task, this, priority));
+}
+
+void WorkStealingTaskGroup::wait()
+{
+    m_scheduler->waitFor(*this);
+}
+
+} // namespace WTF
@@ -0,0 +1,263 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+#ifndef WorkStealingScheduler_h
+#define WorkStealingScheduler_h
+
+#include <atomic>
+#include <memory>
+#include <wtf/Deque.h>
+#include <wtf/FastMalloc.h>
+#include <wtf/Lock.h>
+#include <wtf/Noncopyable.h>
+#include <wtf/Ref.h>
+#include <wtf/RefPtr.h>
+#include <wtf/SharedTask.h>
+#include <wtf/ThreadSafeRefCounted.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace WTF {
+
+// A WorkStealingDeque is the Chase-Lev deque from "Dynamic Circular Work-Stealing Deque", using
+// the C11 memory orderings from "Correct and Efficient Work-Stealing for Weak Memory Models". The
+// owning thread pushes and pops at the bottom without taking any lock, while any other thread may
+// steal from the top. Only the owner may call push() and pop(). The buffer grows as needed. Old
+// buffers are kept alive until the deque dies, since a thief may still be reading from one.
+template<typename T>
+class WorkStealingDeque {
+    WTF_MAKE_NONCOPYABLE(WorkStealingDeque);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    WorkStealingDeque(size_t initialCapacity = 64)
+    {
+        ASSERT(initialCapacity && !(initialCapacity & (initialCapacity - 1)));
+        m_buffers.append(std::make_unique<Buffer>(initialCapacity));
+        m_buffer.store(m_buffers.last().get(), std::memory_order_relaxed);
+    }
+
+    void push(T* item)
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+        int64_t top = m_top.load(std::memory_order_acquire);
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        if (bottom - top > static_cast<int64_t>(buffer->mask))
+            buffer = grow(buffer, top, bottom);
+        buffer->at(bottom).store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+    }
+
+    T* pop()
+    {
+        int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+        Buffer* buffer = m_buffer.load(std::memory_order_relaxed);
+        m_bottom.store(bottom, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t top = m_top.load(std::memory_order_relaxed);
+
+        if (top > bottom) {
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+
+        T* result = buffer->at(bottom).load(std::memory_order_relaxed);
+        if (top == bottom) {
+            // This is the last item, so we race with the thieves for it.
+            if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+                result = nullptr;
+            m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+        return result;
+    }
+
+    // Returns null if the deque was empty or if another thread won the race for the top item.
+    T* steal()
+    {
+        int64_t top = m_top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t bottom = m_bottom.load(std::memory_order_acquire);
+        if (top >= bottom)
+            return nullptr;
+
+        Buffer* buffer = m_buffer.load(std::memory_order_acquire);
+        T* result = buffer->at(top).load(std::memory_order_relaxed);
+        if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return nullptr;
+        return result;
+    }
+
+    // This is only a hint when called from a thread other than the owner.
+    bool isEmpty() const
+    {
+        return m_top.load(std::memory_order_relaxed) >= m_bottom.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Buffer {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        Buffer(size_t capacity)
+            : mask(capacity - 1)
+            , slots(std::make_unique<std::atomic<T*>[]>(capacity))
+        {
+        }
+
+        std::atomic<T*>& at(int64_t index) { return slots[static_cast<size_t>(index) & mask]; }
+
+        size_t mask;
+        std::unique_ptr<std::atomic<T*>[]> slots;
+    };
+
+    Buffer* grow(Buffer* oldBuffer, int64_t top, int64_t bottom)
+    {
+        m_buffers.append(std::make_unique<Buffer>((oldBuffer->mask + 1) * 2));
+        Buffer* newBuffer = m_buffers.last().get();
+        for (int64_t index = top; index < bottom; ++index)
+            newBuffer->at(index).store(oldBuffer->at(index).load(std::memory_order_relaxed), std::memory_order_relaxed);
+        m_buffer.store(newBuffer, std::memory_order_release);
+        return newBuffer;
+    }
+
+    std::atomic<int64_t> m_top { 0 };
+    std::atomic<int64_t> m_bottom { 0 };
+    std::atomic<Buffer*> m_buffer { nullptr };
+    Vector<std::unique_ptr<Buffer>> m_buffers; // Only touched by the owner.
+};
+
+class WorkStealingTaskGroup;
+
+// A WorkStealingScheduler runs many small, independent tasks on a fixed set of worker threads. Unlike
+// ParallelHelperPool, which hands one long-running task to every helper and leaves load balancing to
+// the task, the scheduler does the load balancing: each worker owns one WorkStealingDeque per
+// priority, tasks scheduled from a worker go onto that worker's deques, and idle workers steal from
+// the others. Tasks scheduled from any other thread go onto a shared injection queue. Workers take
+// High tasks before Normal tasks, and Normal tasks before Low ones, but a running task is never
+// preempted. Workers with nothing to do sleep in the ParkingLot, so an idle scheduler costs nothing.
+//
+// Most clients want to wait for the tasks they scheduled, so they should schedule through a
+// WorkStealingTaskGroup:
+//
+//    WorkStealingTaskGroup group;
+//    for (auto& item : items)
+//        group.scheduleFunction([&] () { process(item); });
+//    group.wait();
+//
+// While waiting, the calling thread runs scheduled tasks too. Tasks may schedule more tasks into
+// their own group or into any other group. Use WorkStealingScheduler::shared() unless you need a
+// separate set of threads.
+class WorkStealingScheduler : public ThreadSafeRefCounted<WorkStealingScheduler> {
+public:
+    enum class Priority : unsigned {
+        High,
+        Normal,
+        Low
+    };
+    static const unsigned numberOfPriorities = 3;
+
+    // Zero workers means one fewer than the number of cores, but always at least one.
+    WTF_EXPORT_PRIVATE static Ref<WorkStealingScheduler> create(unsigned numberOfWorkers = 0);
+    WTF_EXPORT_PRIVATE ~WorkStealingScheduler();
+
+    WTF_EXPORT_PRIVATE static WorkStealingScheduler& shared();
+
+    // Schedules a task that nobody waits for. The scheduler runs all such tasks before it dies.
+    WTF_EXPORT_PRIVATE void schedule(RefPtr<SharedTask<void ()>>, Priority = Priority::Normal);
+
+    template<typename Functor>
+    void scheduleFunction(const Functor& functor, Priority priority = Priority::Normal)
+    {
+        schedule(createSharedTask<void ()>(functor), priority);
+    }
+
+    unsigned numberOfWorkers() const { return m_workers.size(); }
+
+private:
+    friend class WorkStealingTaskGroup;
+
+    struct Job;
+    struct Worker;
+
+    WorkStealingScheduler(unsigned numberOfWorkers);
+
+    void enqueue(Job*);
+    Job* findJob(Worker*);
+    Job* stealJob(Worker*, unsigned priority);
+    void runJob(Job*);
+    void waitFor(WorkStealingTaskGroup&);
+    Worker* currentWorker();
+    void workerThreadBody(Worker&);
+
+    Vector<std::unique_ptr<Worker>> m_workers;
+    Vector<ThreadIdentifier> m_threads;
+
+    Lock m_injectionLock;
+    Deque<Job*> m_injectionQueues[numberOfPriorities];
+
+    // Idle workers park on m_numberOfQueuedJobs, and threads waiting for a group park on
+    // m_numberOfSleepingWaiters. Nobody parks while m_numberOfQueuedJobs is positive. It only goes
+    // negative briefly, when a job gets taken before the thread that queued it has counted it.
+    std::atomic<int> m_numberOfQueuedJobs { 0 };
+    std::atomic<unsigned> m_numberOfInjectedJobs { 0 };
+    std::atomic<unsigned> m_numberOfSleepingWorkers { 0 };
+    std::atomic<unsigned> m_numberOfSleepingWaiters { 0 };
+    std::atomic<bool> m_isShuttingDown { false };
+};
+
+// A group of tasks that can be waited for together. The destructor waits for all of the group's
+// tasks. A group can be reused after wait() returns.
+class WorkStealingTaskGroup {
+    WTF_MAKE_NONCOPYABLE(WorkStealingTaskGroup);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    WTF_EXPORT_PRIVATE WorkStealingTaskGroup(WorkStealingScheduler& = WorkStealingScheduler::shared());
+    WTF_EXPORT_PRIVATE ~WorkStealingTaskGroup();
+
+    WTF_EXPORT_PRIVATE void schedule(RefPtr<SharedTask<void ()>>, WorkStealingScheduler::Priority = WorkStealingScheduler::Priority::Normal);
+
+    template<typename Functor>
+    void scheduleFunction(const Functor& functor, WorkStealingScheduler::Priority priority = WorkStealingScheduler::Priority::Normal)
+    {
+        schedule(createSharedTask<void ()>(functor), priority);
+    }
+
+    // Runs scheduled tasks on the calling thread until every task in this group has finished.
+    WTF_EXPORT_PRIVATE void wait();
+
+    WorkStealingScheduler& scheduler() { return m_scheduler.get(); }
+
+private:
+    friend class WorkStealingScheduler;
+
+    Ref<WorkStealingScheduler> m_scheduler;
+    std::atomic<unsigned> m_numberOfPendingJobs { 0 };
+};
+
+} // namespace WTF
+
+using WTF::WorkStealingDeque;
+using WTF::WorkStealingScheduler;
+using WTF::WorkStealingTaskGroup;
+
+#endif // WorkStealingScheduler_h
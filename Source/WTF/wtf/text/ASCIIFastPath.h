@@ -27,8 +27,10 @@
 #include <wtf/StdLibExtras.h>
 #include <wtf/text/LChar.h>
 
-#if OS(DARWIN) && (CPU(X86) || CPU(X86_64))
+#if (OS(DARWIN) && CPU(X86)) || CPU(X86_64)
 #include <emmintrin.h>
+#elif CPU(ARM64) && COMPILER(GCC_OR_CLANG)
+#include <arm_neon.h>
 #endif
 
 namespace WTF {
@@ -83,6 +85,35 @@ inline bool charactersAreAllASCII(const CharacterType* characters, size_t length
     MachineWord allCharBits = 0;
     const CharacterType* end = characters + length;
 
+#if CPU(X86_64) || (CPU(ARM64) && COMPILER(GCC_OR_CLANG))
+    // Accumulate 64 bytes per iteration. Both halves of the vector start on a character boundary,
+    // so folding them into a machine word keeps the non-ASCII mask below valid.
+    const size_t vectorLoopIncrement = 64 / sizeof(CharacterType);
+    if (length >= vectorLoopIncrement) {
+        const CharacterType* vectorEnd = end - vectorLoopIncrement;
+#if CPU(X86_64)
+        __m128i allVectorBits = _mm_setzero_si128();
+        for (; characters <= vectorEnd; characters += vectorLoopIncrement) {
+            const __m128i* vectors = reinterpret_cast<const __m128i*>(characters);
+            allVectorBits = _mm_or_si128(allVectorBits, _mm_or_si128(
+                _mm_or_si128(_mm_loadu_si128(vectors), _mm_loadu_si128(vectors + 1)),
+                _mm_or_si128(_mm_loadu_si128(vectors + 2), _mm_loadu_si128(vectors + 3))));
+        }
+        allCharBits |= _mm_cvtsi128_si64(allVectorBits) | _mm_cvtsi128_si64(_mm_unpackhi_epi64(allVectorBits, allVectorBits));
+#else
+        uint8x16_t allVectorBits = vdupq_n_u8(0);
+        for (; characters <= vectorEnd; characters += vectorLoopIncrement) {
+            const uint8_t* bytes = reinterpret_cast<const uint8_t*>(characters);
+            allVectorBits = vorrq_u8(allVectorBits, vorrq_u8(
+                vorrq_u8(vld1q_u8(bytes), vld1q_u8(bytes + 16)),
+                vorrq_u8(vld1q_u8(bytes + 32), vld1q_u8(bytes + 48))));
+        }
+        uint64x2_t allWordBits = vreinterpretq_u64_u8(allVectorBits);
+        allCharBits |= vgetq_lane_u64(allWordBits, 0) | vgetq_lane_u64(allWordBits, 1);
+#endif
+    }
+#endif
+
     // Prologue: align the input.
     while (!isAlignedToMachineWord(characters) && characters != end) {
         allCharBits |= *characters;
@@ -42,40 +42,50 @@ using namespace Unicode;
 
 #if USE(WEB_THREAD)
 
-class AtomicStringTableLocker : public LockHolder {
+// Only the table shared by the main UI thread and the WebThread needs a lock. Tables owned by a
+// single thread, such as those of worker threads, are never contended, so they skip locking.
+class AtomicStringTableLocker {
     WTF_MAKE_NONCOPYABLE(AtomicStringTableLocker);
-
-    static StaticLock s_stringTableLock;
 public:
-    AtomicStringTableLocker()
-        : LockHolder(&s_stringTableLock)
+    explicit AtomicStringTableLocker(AtomicStringTable& table)
+        : m_lock(table.isShared() ? &table.lock() : nullptr)
     {
+        if (m_lock)
+            m_lock->lock();
+    }
+
+    ~AtomicStringTableLocker()
+    {
+        if (m_lock)
+            m_lock->unlock();
     }
-};
 
-StaticLock AtomicStringTableLocker::s_stringTableLock;
+private:
+    Lock* m_lock;
+};
 
 #else
 
 class AtomicStringTableLocker {
     WTF_MAKE_NONCOPYABLE(AtomicStringTableLocker);
 public:
-    AtomicStringTableLocker() { }
+    explicit AtomicStringTableLocker(AtomicStringTable&) { }
 };
 
 #endif // USE(WEB_THREAD)
 
-static ALWAYS_INLINE HashSet<StringImpl*>& stringTable()
+static ALWAYS_INLINE AtomicStringTable& currentStringTable()
 {
-    return wtfThreadData().atomicStringTable()->table();
+    return *wtfThreadData().atomicStringTable();
 }
 
 template<typename T, typename HashTranslator>
 static inline Ref<AtomicStringImpl> addToStringTable(const T& value)
 {
-    AtomicStringTableLocker locker;
+    AtomicStringTable& stringTable = currentStringTable();
+    AtomicStringTableLocker locker(stringTable);
 
-    HashSet<StringImpl*>::AddResult addResult = stringTable().add<HashTranslator>(value);
+    HashSet<StringImpl*>::AddResult addResult = stringTable.table().add<HashTranslator>(value);
 
     // If the string is newly-translated, then we need to adopt it.
     // The boolean in the pair tells us if that is so.
@@ -409,8 +419,9 @@ Ref<AtomicStringImpl> AtomicStringImpl::addSlowCase(StringImpl& string)
 
     ASSERT_WITH_MESSAGE(!string.isAtomic(), "AtomicStringImpl should not hit the slow case if the string is already atomic.");
 
-    AtomicStringTableLocker locker;
-    auto addResult = stringTable().add(&string);
+    AtomicStringTable& stringTable = currentStringTable();
+    AtomicStringTableLocker locker(stringTable);
+    auto addResult = stringTable.table().add(&string);
 
     if (addResult.isNewEntry) {
         ASSERT(*addResult.iterator == &string);
@@ -433,7 +444,7 @@ Ref<AtomicStringImpl> AtomicStringImpl::addSlowCase(AtomicStringTable& stringTab
 
     ASSERT_WITH_MESSAGE(!string.isAtomic(), "AtomicStringImpl should not hit the slow case if the string is already atomic.");
 
-    AtomicStringTableLocker locker;
+    AtomicStringTableLocker locker(stringTable);
     auto addResult = stringTable.table().add(&string);
 
     if (addResult.isNewEntry) {
@@ -447,8 +458,9 @@ Ref<AtomicStringImpl> AtomicStringImpl::addSlowCase(AtomicStringTable& stringTab
 void AtomicStringImpl::remove(AtomicStringImpl* string)
 {
     ASSERT(string->isAtomic());
-    AtomicStringTableLocker locker;
-    HashSet<StringImpl*>& atomicStringTable = stringTable();
+    AtomicStringTable& stringTable = currentStringTable();
+    AtomicStringTableLocker locker(stringTable);
+    HashSet<StringImpl*>& atomicStringTable = stringTable.table();
     HashSet<StringImpl*>::iterator iterator = atomicStringTable.find(string);
     ASSERT_WITH_MESSAGE(iterator != atomicStringTable.end(), "The string being removed is atomic in the string table of an other thread!");
     atomicStringTable.remove(iterator);
@@ -467,8 +479,9 @@ RefPtr<AtomicStringImpl> AtomicStringImpl::lookUpSlowCase(StringImpl& string)
         return lookUpInternal(string.characters16(), string.length());
     }
 
-    AtomicStringTableLocker locker;
-    HashSet<StringImpl*>& atomicStringTable = stringTable();
+    AtomicStringTable& stringTable = currentStringTable();
+    AtomicStringTableLocker locker(stringTable);
+    HashSet<StringImpl*>& atomicStringTable = stringTable.table();
     auto iterator = atomicStringTable.find(&string);
     if (iterator != atomicStringTable.end())
         return static_cast<AtomicStringImpl*>(*iterator);
@@ -489,8 +502,9 @@ RefPtr<AtomicStringImpl> AtomicStringImpl::addUTF8(const char* charactersStart,
 
 RefPtr<AtomicStringImpl> AtomicStringImpl::lookUpInternal(const LChar* characters, unsigned length)
 {
-    AtomicStringTableLocker locker;
-    auto& table = stringTable();
+    AtomicStringTable& stringTable = currentStringTable();
+    AtomicStringTableLocker locker(stringTable);
+    auto& table = stringTable.table();
 
     LCharBuffer buffer = { characters, length };
     auto iterator = table.find<LCharBufferTranslator>(buffer);
@@ -501,8 +515,9 @@ RefPtr<AtomicStringImpl> AtomicStringImpl::lookUpInternal(const LChar* character
 
 RefPtr<AtomicStringImpl> AtomicStringImpl::lookUpInternal(const UChar* characters, unsigned length)
 {
-    AtomicStringTableLocker locker;
-    auto& table = stringTable();
+    AtomicStringTable& stringTable = currentStringTable();
+    AtomicStringTableLocker locker(stringTable);
+    auto& table = stringTable.table();
 
     UCharBuffer buffer = { characters, length };
     auto iterator = table.find<UCharBufferTranslator>(buffer);
@@ -514,8 +529,9 @@ RefPtr<AtomicStringImpl> AtomicStringImpl::lookUpInternal(const UChar* character
 #if !ASSERT_DISABLED
 bool AtomicStringImpl::isInAtomicStringTable(StringImpl* string)
 {
-    AtomicStringTableLocker locker;
-    return stringTable().contains(string);
+    AtomicStringTable& stringTable = currentStringTable();
+    AtomicStringTableLocker locker(stringTable);
+    return stringTable.table().contains(string);
 }
 #endif
 
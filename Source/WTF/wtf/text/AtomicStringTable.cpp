@@ -33,7 +33,11 @@ void AtomicStringTable::create(WTFThreadData& data)
 {
 #if USE(WEB_THREAD)
     // On iOS, one AtomicStringTable is shared between the main UI thread and the WebThread.
-    static AtomicStringTable* sharedStringTable = new AtomicStringTable;
+    static AtomicStringTable* sharedStringTable = [] {
+        AtomicStringTable* table = new AtomicStringTable;
+        table->m_isShared = true;
+        return table;
+    }();
 
     bool currentThreadIsWebThread = isWebThread();
     if (currentThreadIsWebThread || isUIThread())
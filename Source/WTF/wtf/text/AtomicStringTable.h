@@ -26,6 +26,10 @@
 #include <wtf/HashSet.h>
 #include <wtf/WTFThreadData.h>
 
+#if USE(WEB_THREAD)
+#include <wtf/Lock.h>
+#endif
+
 namespace WTF {
 
 class StringImpl;
@@ -38,10 +42,21 @@ public:
     static void create(WTFThreadData&);
     HashSet<StringImpl*>& table() { return m_table; }
 
+#if USE(WEB_THREAD)
+    // True for the table that the main UI thread and the WebThread share. It is the only
+    // table used from more than one thread, and the only one that needs locking.
+    bool isShared() const { return m_isShared; }
+    Lock& lock() { return m_lock; }
+#endif
+
 private:
     static void destroy(AtomicStringTable*);
 
     HashSet<StringImpl*> m_table;
+#if USE(WEB_THREAD)
+    Lock m_lock;
+    bool m_isShared { false };
+#endif
 };
 
 }
@@ -29,6 +29,12 @@
 #include <unicode/uchar.h>
 #include <wtf/ASCIICType.h>
 
+#if CPU(X86_64)
+#include <emmintrin.h>
+#elif CPU(ARM64) && COMPILER(GCC_OR_CLANG)
+#include <arm_neon.h>
+#endif
+
 namespace WTF {
 
 template<typename T>
@@ -490,9 +496,43 @@ ALWAYS_INLINE static size_t findInner(const SearchCharacterType* searchCharacter
     return index + i;
 }
 
+#if CPU(X86_64) || (CPU(ARM64) && COMPILER(GCC_OR_CLANG))
+#define WTF_HAS_CHARACTER_VECTOR_SEARCH 1
+const unsigned characterVectorSize = 16;
+
+// Returns whether any of the 16 bytes worth of characters starting at characters is matchCharacter.
+ALWAYS_INLINE bool vectorContainsCharacter(const LChar* characters, LChar matchCharacter)
+{
+#if CPU(X86_64)
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters));
+    return _mm_movemask_epi8(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(matchCharacter)));
+#else
+    return vmaxvq_u8(vceqq_u8(vld1q_u8(characters), vdupq_n_u8(matchCharacter)));
+#endif
+}
+
+ALWAYS_INLINE bool vectorContainsCharacter(const UChar* characters, UChar matchCharacter)
+{
+#if CPU(X86_64)
+    __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters));
+    return _mm_movemask_epi8(_mm_cmpeq_epi16(chunk, _mm_set1_epi16(matchCharacter)));
+#else
+    return vmaxvq_u16(vceqq_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(characters)), vdupq_n_u16(matchCharacter)));
+#endif
+}
+#else
+#define WTF_HAS_CHARACTER_VECTOR_SEARCH 0
+#endif
+
 template<typename CharacterType>
 inline size_t find(const CharacterType* characters, unsigned length, CharacterType matchCharacter, unsigned index = 0)
 {
+#if WTF_HAS_CHARACTER_VECTOR_SEARCH
+    // Skip whole vectors that cannot contain the match; the loop below finds it within the first one that does.
+    const unsigned charactersPerVector = characterVectorSize / sizeof(CharacterType);
+    while (index < length && length - index >= charactersPerVector && !vectorContainsCharacter(characters + index, matchCharacter))
+        index += charactersPerVector;
+#endif
     while (index < length) {
         if (characters[index] == matchCharacter)
             return index;
@@ -361,6 +361,39 @@ UChar32 StringImpl::characterStartingAt(unsigned i)
     return 0;
 }
 
+// Returns an index such that no character before it is uppercase or non-ASCII, skipping over
+// whole vectors at a time. The characters from the returned index on still need to be checked.
+static inline unsigned skipLowercaseASCIIVectors(const LChar* characters, unsigned length)
+{
+    unsigned i = 0;
+#if CPU(X86_64)
+    // Non-ASCII characters have their sign bit set. Offsetting by 0x80 - 'A' maps 'A'-'Z', and only
+    // those, to the 26 smallest signed byte values.
+    const __m128i uppercaseOffset = _mm_set1_epi8(static_cast<char>(0x80 - 'A'));
+    const __m128i uppercaseLimit = _mm_set1_epi8(static_cast<char>(-0x80 + 26));
+    for (; length - i >= sizeof(__m128i); i += sizeof(__m128i)) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(characters + i));
+        __m128i uppercase = _mm_cmplt_epi8(_mm_add_epi8(chunk, uppercaseOffset), uppercaseLimit);
+        if (_mm_movemask_epi8(_mm_or_si128(chunk, uppercase)))
+            break;
+    }
+#elif CPU(ARM64) && COMPILER(GCC_OR_CLANG)
+    const uint8x16_t nonASCIIThreshold = vdupq_n_u8(0x80);
+    const uint8x16_t uppercaseOffset = vdupq_n_u8('A');
+    const uint8x16_t uppercaseLimit = vdupq_n_u8(26);
+    for (; length - i >= 16; i += 16) {
+        uint8x16_t chunk = vld1q_u8(characters + i);
+        uint8x16_t uppercase = vcltq_u8(vsubq_u8(chunk, uppercaseOffset), uppercaseLimit);
+        if (vmaxvq_u8(vorrq_u8(vcgeq_u8(chunk, nonASCIIThreshold), uppercase)))
+            break;
+    }
+#else
+    UNUSED_PARAM(characters);
+    UNUSED_PARAM(length);
+#endif
+    return i;
+}
+
 Ref<StringImpl> StringImpl::lower()
 {
     // Note: This is a hot function in the Dromaeo benchmark, specifically the
@@ -369,7 +402,7 @@ Ref<StringImpl> StringImpl::lower()
     // First scan the string for uppercase and non-ASCII characters:
     if (is8Bit()) {
         unsigned failingIndex;
-        for (unsigned i = 0; i < m_length; ++i) {
+        for (unsigned i = skipLowercaseASCIIVectors(m_data8, m_length); i < m_length; ++i) {
             LChar character = m_data8[i];
             if (UNLIKELY((character & ~0x7F) || isASCIIUpper(character))) {
                 failingIndex = i;
@@ -683,7 +716,7 @@ Ref<StringImpl> StringImpl::convertToASCIILowercase()
 {
     if (is8Bit()) {
         unsigned failingIndex;
-        for (unsigned i = 0; i < m_length; ++i) {
+        for (unsigned i = skipLowercaseASCIIVectors(m_data8, m_length); i < m_length; ++i) {
             LChar character = m_data8[i];
             if (UNLIKELY(isASCIIUpper(character))) {
                 failingIndex = i;
@@ -1058,6 +1058,17 @@ inline size_t reverseFind(const CharacterType* characters, unsigned length, Char
         return notFound;
     if (index >= length)
         index = length - 1;
+#if WTF_HAS_CHARACTER_VECTOR_SEARCH
+    // Skip whole vectors ending at index that cannot contain the match.
+    const unsigned charactersPerVector = characterVectorSize / sizeof(CharacterType);
+    while (index >= charactersPerVector - 1) {
+        if (vectorContainsCharacter(characters + index + 1 - charactersPerVector, matchCharacter))
+            break;
+        if (index < charactersPerVector)
+            return notFound;
+        index -= charactersPerVector;
+    }
+#endif
     while (characters[index] != matchCharacter) {
         if (!index--)
             return notFound;
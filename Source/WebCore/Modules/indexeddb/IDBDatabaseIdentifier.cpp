@@ -28,6 +28,8 @@
 
 #if ENABLE(INDEXED_DATABASE)
 
+#include "FileSystem.h"
+#include "SecurityOrigin.h"
 #include <wtf/Ref.h>
 #include <wtf/RefCounted.h>
 #include <wtf/text/WTFString.h>
@@ -55,6 +57,24 @@ IDBDatabaseIdentifier IDBDatabaseIdentifier::isolatedCopy() const
     return WTF::move(identifier);
 }
 
+String IDBDatabaseIdentifier::databaseDirectoryRelativeToRoot(const String& rootDirectory) const
+{
+    // Databases live in a directory for their main frame origin, with a subdirectory for the opening
+    // origin when that is a different one, so third-party frames get their own storage.
+    String directory = pathByAppendingComponent(rootDirectory, m_mainFrameOrigin.securityOrigin()->databaseIdentifier());
+    if (!(m_openingOrigin == m_mainFrameOrigin))
+        directory = pathByAppendingComponent(directory, m_openingOrigin.securityOrigin()->databaseIdentifier());
+
+    // The empty string is a valid database name, but not a valid file name.
+    if (m_databaseName.isEmpty())
+        return pathByAppendingComponent(directory, ASCIILiteral("%00"));
+
+    String databaseName = encodeForFileName(m_databaseName);
+    databaseName.replace('.', "%2E");
+
+    return pathByAppendingComponent(directory, databaseName);
+}
+
 #ifndef NDEBUG
 String IDBDatabaseIdentifier::debugString() const
 {
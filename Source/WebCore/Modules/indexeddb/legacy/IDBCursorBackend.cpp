@@ -42,6 +42,12 @@
 
 namespace WebCore {
 
+// Prefetching starts once a script has called continue() this many times in a row.
+static const unsigned prefetchContinueThreshold = 2;
+// The first batch is small; each batch the script uses up entirely doubles the next one.
+static const unsigned minimumPrefetchAmount = 5;
+static const unsigned maximumPrefetchAmount = 100;
+
 IDBCursorBackend::IDBCursorBackend(int64_t cursorID, IndexedDB::CursorType cursorType, IDBDatabaseBackend::TaskType taskType, IDBTransactionBackend& transaction, int64_t objectStoreID)
     : m_taskType(taskType)
     , m_cursorType(cursorType)
@@ -49,6 +55,9 @@ IDBCursorBackend::IDBCursorBackend(int64_t cursorID, IndexedDB::CursorType curso
     , m_objectStoreID(objectStoreID)
     , m_cursorID(cursorID)
     , m_savedCursorID(0)
+    , m_usedPrefetchCount(0)
+    , m_continueCount(0)
+    , m_prefetchAmount(minimumPrefetchAmount)
     , m_closed(false)
 {
     m_transaction->registerOpenCursor(this);
@@ -102,6 +111,61 @@ void IDBCursorBackend::clear()
     m_currentKey = nullptr;
     m_currentPrimaryKey = nullptr;
     m_currentValueBuffer = nullptr;
+
+    m_prefetchedRecords.clear();
+    m_usedPrefetchCount = 0;
+    m_continueCount = 0;
+}
+
+unsigned IDBCursorBackend::prefetchCountForContinue()
+{
+    ASSERT(m_prefetchedRecords.isEmpty());
+
+    if (++m_continueCount < prefetchContinueThreshold)
+        return 0;
+
+    return m_prefetchAmount;
+}
+
+void IDBCursorBackend::didPrefetchRecords(Vector<PrefetchedRecord> records)
+{
+    ASSERT(m_prefetchedRecords.isEmpty());
+
+    for (auto& record : records)
+        m_prefetchedRecords.append(WTF::move(record));
+    m_usedPrefetchCount = 0;
+}
+
+bool IDBCursorBackend::takePrefetchedRecord(PrefetchedRecord& record)
+{
+    if (m_prefetchedRecords.isEmpty())
+        return false;
+
+    record = m_prefetchedRecords.takeFirst();
+    ++m_usedPrefetchCount;
+
+    // The script kept up with the whole batch, so ask for more next time.
+    if (m_prefetchedRecords.isEmpty())
+        m_prefetchAmount = std::min(m_prefetchAmount * 2, maximumPrefetchAmount);
+
+    return true;
+}
+
+void IDBCursorBackend::resetPrefetch()
+{
+    m_continueCount = 0;
+
+    // Once every prefetched record has been handed out the server's cursor is already where this one is.
+    if (m_prefetchedRecords.isEmpty())
+        return;
+
+    LOG(StorageAPI, "IDBCursorBackend::resetPrefetch - discarding %zu prefetched records", m_prefetchedRecords.size());
+
+    m_transaction->database().serverConnection().cursorPrefetchReset(*this, m_usedPrefetchCount);
+
+    m_prefetchedRecords.clear();
+    m_usedPrefetchCount = 0;
+    m_prefetchAmount = minimumPrefetchAmount;
 }
 
 } // namespace WebCore
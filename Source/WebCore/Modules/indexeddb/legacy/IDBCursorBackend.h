@@ -31,6 +31,7 @@
 
 #include "IDBDatabaseBackend.h"
 #include "IDBTransactionBackend.h"
+#include <wtf/Deque.h>
 #include <wtf/RefPtr.h>
 
 namespace WebCore {
@@ -71,6 +72,24 @@ public:
     void clear();
     void setSavedCursorID(int64_t cursorID) { m_savedCursorID = cursorID; }
 
+    // Records the server read ahead of the cursor along with the last iteration, so that
+    // consecutive continue() calls don't each need a round trip. A record without a key
+    // marks the end of the cursor.
+    struct PrefetchedRecord {
+        RefPtr<IDBKey> key;
+        RefPtr<IDBKey> primaryKey;
+        RefPtr<SharedBuffer> valueBuffer;
+    };
+
+    unsigned prefetchCountForContinue();
+    void didPrefetchRecords(Vector<PrefetchedRecord>);
+    bool takePrefetchedRecord(PrefetchedRecord&);
+
+    // Throws away the records not yet handed out and moves the server's cursor back to
+    // the record this cursor is on. Must happen before anything that could change the
+    // records the cursor is iterating, or that moves it some other way than by continue().
+    void resetPrefetch();
+
 private:
     IDBCursorBackend(int64_t cursorID, IndexedDB::CursorType, IDBDatabaseBackend::TaskType, IDBTransactionBackend&, int64_t objectStoreID);
 
@@ -86,6 +105,11 @@ private:
     RefPtr<IDBKey> m_currentPrimaryKey;
     RefPtr<SharedBuffer> m_currentValueBuffer;
 
+    Deque<PrefetchedRecord> m_prefetchedRecords;
+    unsigned m_usedPrefetchCount;
+    unsigned m_continueCount;
+    unsigned m_prefetchAmount;
+
     bool m_closed;
 };
 
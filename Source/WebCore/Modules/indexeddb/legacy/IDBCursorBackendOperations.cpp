@@ -56,6 +56,7 @@ void CursorAdvanceOperation::perform(std::function<void()> completionCallback)
         completionCallback();
     };
 
+    m_cursor->resetPrefetch();
     m_cursor->transaction().database().serverConnection().cursorAdvance(*m_cursor, *this, callback);
 }
 
@@ -81,6 +82,17 @@ void CursorIterationOperation::perform(std::function<void()> completionCallback)
         completionCallback();
     };
 
+    if (!m_key) {
+        IDBCursorBackend::PrefetchedRecord record;
+        if (m_cursor->takePrefetchedRecord(record)) {
+            callback(record.key.release(), record.primaryKey.release(), record.valueBuffer.release(), nullptr);
+            return;
+        }
+
+        m_prefetchCount = m_cursor->prefetchCountForContinue();
+    } else
+        m_cursor->resetPrefetch();
+
     m_cursor->transaction().database().serverConnection().cursorIterate(*m_cursor, *this, callback);
 }
 
@@ -44,18 +44,21 @@ public:
 
     int64_t cursorID() const { return m_cursor->id(); }
     IDBKey* key() const { return m_key.get(); }
+    unsigned prefetchCount() const { return m_prefetchCount; }
 
 private:
     CursorIterationOperation(PassRefPtr<IDBCursorBackend> cursor, PassRefPtr<IDBKey> key, PassRefPtr<IDBCallbacks> callbacks)
         : m_cursor(cursor)
         , m_key(key)
         , m_callbacks(callbacks)
+        , m_prefetchCount(0)
     {
     }
 
     RefPtr<IDBCursorBackend> m_cursor;
     RefPtr<IDBKey> m_key;
     RefPtr<IDBCallbacks> m_callbacks;
+    unsigned m_prefetchCount;
 };
 
 class CursorAdvanceOperation : public IDBOperation {
@@ -190,6 +190,13 @@ void IDBTransactionBackend::unregisterOpenCursor(IDBCursorBackend* cursor)
     m_openCursors.remove(cursor);
 }
 
+void IDBTransactionBackend::resetOpenCursorPrefetches()
+{
+    // Records a cursor prefetched may be about to change, so each cursor has to read them again.
+    for (auto& cursor : m_openCursors)
+        cursor->resetPrefetch();
+}
+
 void IDBTransactionBackend::run()
 {
     // TransactionCoordinator has started this transaction. Schedule a timer
@@ -124,6 +124,7 @@ void PutOperation::perform(std::function<void()> completionCallback)
     ASSERT(m_transaction->mode() != IndexedDB::TransactionMode::ReadOnly);
     ASSERT(m_indexIDs.size() == m_indexKeys.size());
 
+    m_transaction->resetOpenCursorPrefetches();
     m_transaction->database().serverConnection().put(*m_transaction, *this, [this, completionCallback](PassRefPtr<IDBKey> key, PassRefPtr<IDBDatabaseError> prpError) {
         RefPtr<IDBDatabaseError> error = prpError;
         if (key) {
@@ -200,6 +201,7 @@ void DeleteRangeOperation::perform(std::function<void()> completionCallback)
         completionCallback();
     };
 
+    m_transaction->resetOpenCursorPrefetches();
     m_transaction->database().serverConnection().deleteRange(*m_transaction, *this, callback);
 }
 
@@ -221,6 +223,7 @@ void ClearObjectStoreOperation::perform(std::function<void()> completionCallback
         completionCallback();
     };
 
+    m_transaction->resetOpenCursorPrefetches();
     m_transaction->database().serverConnection().clearObjectStore(*m_transaction, *this, clearCallback);
 }
 
@@ -0,0 +1,366 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "IDBKeyDataBTree.h"
+
+#if ENABLE(INDEXED_DATABASE)
+
+#include <algorithm>
+
+namespace WebCore {
+namespace IDBServer {
+
+// Leaves that drop below this many keys are merged with a sibling when the keys fit in one node.
+static const size_t minimumKeysPerLeaf = 8;
+
+struct IDBKeyDataBTree::Node {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    explicit Node(bool isLeaf)
+        : isLeaf(isLeaf)
+    {
+    }
+    virtual ~Node() { }
+
+    const bool isLeaf;
+};
+
+struct IDBKeyDataBTree::LeafNode : public IDBKeyDataBTree::Node {
+    LeafNode()
+        : Node(true)
+    {
+    }
+
+    Vector<IDBKeyData, maximumKeysPerNode + 1> keys;
+    LeafNode* previous { nullptr };
+    LeafNode* next { nullptr };
+};
+
+struct IDBKeyDataBTree::InternalNode : public IDBKeyDataBTree::Node {
+    InternalNode()
+        : Node(false)
+    {
+    }
+
+    // keys[i] is the lowest key of the subtree at children[i + 1].
+    Vector<IDBKeyData, maximumKeysPerNode + 1> keys;
+    Vector<std::unique_ptr<Node>, maximumKeysPerNode + 2> children;
+};
+
+inline IDBKeyDataBTree::LeafNode& IDBKeyDataBTree::asLeaf(Node& node)
+{
+    ASSERT(node.isLeaf);
+    return static_cast<LeafNode&>(node);
+}
+
+inline IDBKeyDataBTree::InternalNode& IDBKeyDataBTree::asInternal(Node& node)
+{
+    ASSERT(!node.isLeaf);
+    return static_cast<InternalNode&>(node);
+}
+
+template<typename KeyVector> static inline size_t lowerBoundIndex(const KeyVector& keys, const IDBKeyData& key)
+{
+    return std::lower_bound(keys.begin(), keys.end(), key) - keys.begin();
+}
+
+// The child of an internal node that holds the given key is the one after every separator not greater than it.
+template<typename KeyVector> static inline size_t childIndexForKey(const KeyVector& keys, const IDBKeyData& key)
+{
+    return std::upper_bound(keys.begin(), keys.end(), key) - keys.begin();
+}
+
+const IDBKeyData& IDBKeyDataBTree::Iterator::operator*() const
+{
+    ASSERT(m_leaf);
+    ASSERT(m_index < m_leaf->keys.size());
+    return m_leaf->keys[m_index];
+}
+
+IDBKeyDataBTree::Iterator& IDBKeyDataBTree::Iterator::operator++()
+{
+    ASSERT(m_leaf);
+    if (++m_index < m_leaf->keys.size())
+        return *this;
+
+    m_leaf = m_leaf->next;
+    m_index = 0;
+    return *this;
+}
+
+IDBKeyDataBTree::IDBKeyDataBTree()
+{
+}
+
+IDBKeyDataBTree::~IDBKeyDataBTree()
+{
+}
+
+IDBKeyDataBTree::Iterator IDBKeyDataBTree::begin() const
+{
+    return Iterator(m_firstLeaf, 0);
+}
+
+IDBKeyDataBTree::Iterator IDBKeyDataBTree::lowerBound(const IDBKeyData& key) const
+{
+    if (!m_root)
+        return end();
+
+    Node* node = m_root.get();
+    while (!node->isLeaf) {
+        auto& internal = asInternal(*node);
+        node = internal.children[childIndexForKey(internal.keys, key)].get();
+    }
+
+    auto& leaf = asLeaf(*node);
+    size_t index = lowerBoundIndex(leaf.keys, key);
+    if (index < leaf.keys.size())
+        return Iterator(&leaf, index);
+
+    // Every key in this leaf is lower, so the bound is the first key of the next one.
+    return Iterator(leaf.next, 0);
+}
+
+IDBKeyDataBTree::Iterator IDBKeyDataBTree::find(const IDBKeyData& key) const
+{
+    auto iterator = lowerBound(key);
+    if (iterator == end() || *iterator != key)
+        return end();
+
+    return iterator;
+}
+
+const IDBKeyData* IDBKeyDataBTree::first() const
+{
+    if (!m_firstLeaf)
+        return nullptr;
+
+    ASSERT(!m_firstLeaf->keys.isEmpty());
+    return &m_firstLeaf->keys.first();
+}
+
+bool IDBKeyDataBTree::add(const IDBKeyData& key)
+{
+    if (!m_root) {
+        auto leaf = std::make_unique<LeafNode>();
+        m_firstLeaf = leaf.get();
+        m_root = WTF::move(leaf);
+    }
+
+    bool added = false;
+    IDBKeyData splitKey;
+    auto newSibling = addToNode(*m_root, key, splitKey, added);
+
+    if (newSibling) {
+        auto newRoot = std::make_unique<InternalNode>();
+        newRoot->keys.append(WTF::move(splitKey));
+        newRoot->children.append(WTF::move(m_root));
+        newRoot->children.append(WTF::move(newSibling));
+        m_root = WTF::move(newRoot);
+    }
+
+    if (added)
+        ++m_size;
+
+    return added;
+}
+
+std::unique_ptr<IDBKeyDataBTree::Node> IDBKeyDataBTree::addToNode(Node& node, const IDBKeyData& key, IDBKeyData& splitKey, bool& added)
+{
+    if (node.isLeaf) {
+        auto& leaf = asLeaf(node);
+        size_t index = lowerBoundIndex(leaf.keys, key);
+        if (index < leaf.keys.size() && leaf.keys[index] == key)
+            return nullptr;
+
+        leaf.keys.insert(index, key);
+        added = true;
+
+        if (leaf.keys.size() <= maximumKeysPerNode)
+            return nullptr;
+
+        auto newLeaf = std::make_unique<LeafNode>();
+        size_t splitIndex = leaf.keys.size() / 2;
+        newLeaf->keys.append(leaf.keys.data() + splitIndex, leaf.keys.size() - splitIndex);
+        leaf.keys.shrink(splitIndex);
+
+        newLeaf->previous = &leaf;
+        newLeaf->next = leaf.next;
+        if (leaf.next)
+            leaf.next->previous = newLeaf.get();
+        leaf.next = newLeaf.get();
+
+        splitKey = newLeaf->keys.first();
+        return WTF::move(newLeaf);
+    }
+
+    auto& internal = asInternal(node);
+    size_t childIndex = childIndexForKey(internal.keys, key);
+    IDBKeyData childSplitKey;
+    auto newChild = addToNode(*internal.children[childIndex], key, childSplitKey, added);
+    if (!newChild)
+        return nullptr;
+
+    internal.keys.insert(childIndex, WTF::move(childSplitKey));
+    internal.children.insert(childIndex + 1, WTF::move(newChild));
+
+    if (internal.keys.size() <= maximumKeysPerNode)
+        return nullptr;
+
+    // The middle separator moves up to the parent rather than staying in either half.
+    auto newInternal = std::make_unique<InternalNode>();
+    size_t splitIndex = internal.keys.size() / 2;
+    splitKey = WTF::move(internal.keys[splitIndex]);
+
+    for (size_t i = splitIndex + 1; i < internal.keys.size(); ++i)
+        newInternal->keys.append(WTF::move(internal.keys[i]));
+    for (size_t i = splitIndex + 1; i < internal.children.size(); ++i)
+        newInternal->children.append(WTF::move(internal.children[i]));
+
+    internal.keys.shrink(splitIndex);
+    internal.children.shrink(splitIndex + 1);
+
+    return WTF::move(newInternal);
+}
+
+bool IDBKeyDataBTree::remove(const IDBKeyData& key)
+{
+    if (!m_root || !removeFromNode(*m_root, key))
+        return false;
+
+    --m_size;
+
+    while (!m_root->isLeaf) {
+        auto& internal = asInternal(*m_root);
+        if (internal.children.size() > 1)
+            break;
+        if (internal.children.isEmpty()) {
+            m_root = nullptr;
+            m_firstLeaf = nullptr;
+            return true;
+        }
+        std::unique_ptr<Node> onlyChild = WTF::move(internal.children.first());
+        m_root = WTF::move(onlyChild);
+    }
+
+    if (m_root->isLeaf && asLeaf(*m_root).keys.isEmpty()) {
+        m_root = nullptr;
+        m_firstLeaf = nullptr;
+    }
+
+    return true;
+}
+
+bool IDBKeyDataBTree::removeFromNode(Node& node, const IDBKeyData& key)
+{
+    if (node.isLeaf) {
+        auto& leaf = asLeaf(node);
+        size_t index = lowerBoundIndex(leaf.keys, key);
+        if (index == leaf.keys.size() || leaf.keys[index] != key)
+            return false;
+
+        leaf.keys.remove(index);
+        return true;
+    }
+
+    auto& internal = asInternal(node);
+    size_t childIndex = childIndexForKey(internal.keys, key);
+    Node& child = *internal.children[childIndex];
+    if (!removeFromNode(child, key))
+        return false;
+
+    // Separators stay valid lower bounds as keys go away, so only empty or sparse children need attention.
+    // Underfull internal nodes are left alone; they only shrink when leaves below them are merged away.
+    if (!child.isLeaf) {
+        if (asInternal(child).children.isEmpty())
+            removeChild(internal, childIndex);
+        return true;
+    }
+
+    size_t keyCount = asLeaf(child).keys.size();
+    if (!keyCount) {
+        removeChild(internal, childIndex);
+        return true;
+    }
+
+    if (keyCount >= minimumKeysPerLeaf)
+        return true;
+
+    if (childIndex + 1 < internal.children.size() && keyCount + asLeaf(*internal.children[childIndex + 1]).keys.size() <= maximumKeysPerNode)
+        mergeLeaves(internal, childIndex);
+    else if (childIndex && keyCount + asLeaf(*internal.children[childIndex - 1]).keys.size() <= maximumKeysPerNode)
+        mergeLeaves(internal, childIndex - 1);
+
+    return true;
+}
+
+void IDBKeyDataBTree::removeChild(InternalNode& parent, size_t childIndex)
+{
+    Node& child = *parent.children[childIndex];
+    if (child.isLeaf) {
+        auto& leaf = asLeaf(child);
+        if (leaf.previous)
+            leaf.previous->next = leaf.next;
+        else {
+            ASSERT(m_firstLeaf == &leaf);
+            m_firstLeaf = leaf.next;
+        }
+        if (leaf.next)
+            leaf.next->previous = leaf.previous;
+    }
+
+    parent.children.remove(childIndex);
+
+    // Removing the first child makes the next one the first, which needs no lower bound.
+    if (childIndex)
+        parent.keys.remove(childIndex - 1);
+    else if (!parent.keys.isEmpty())
+        parent.keys.remove(0);
+}
+
+void IDBKeyDataBTree::mergeLeaves(InternalNode& parent, size_t leftChildIndex)
+{
+    auto& left = asLeaf(*parent.children[leftChildIndex]);
+    auto& right = asLeaf(*parent.children[leftChildIndex + 1]);
+    ASSERT(left.next == &right);
+
+    left.keys.appendVector(right.keys);
+    right.keys.clear();
+
+    removeChild(parent, leftChildIndex + 1);
+}
+
+void IDBKeyDataBTree::clear()
+{
+    m_root = nullptr;
+    m_firstLeaf = nullptr;
+    m_size = 0;
+}
+
+} // namespace IDBServer
+} // namespace WebCore
+
+#endif // ENABLE(INDEXED_DATABASE)
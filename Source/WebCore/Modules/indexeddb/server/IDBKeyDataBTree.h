@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef IDBKeyDataBTree_h
+#define IDBKeyDataBTree_h
+
+#if ENABLE(INDEXED_DATABASE)
+
+#include "IDBKeyData.h"
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+namespace IDBServer {
+
+// An ordered set of keys kept in a B+tree. Keys are stored by value in fixed-capacity nodes and the
+// leaves are linked in key order, so a range scan walks contiguous arrays instead of chasing one
+// allocation per key like std::set does.
+class IDBKeyDataBTree {
+    WTF_MAKE_NONCOPYABLE(IDBKeyDataBTree);
+    WTF_MAKE_FAST_ALLOCATED;
+private:
+    static const size_t maximumKeysPerNode = 32;
+
+    struct Node;
+    struct LeafNode;
+    struct InternalNode;
+
+public:
+    IDBKeyDataBTree();
+    ~IDBKeyDataBTree();
+
+    class Iterator {
+    public:
+        const IDBKeyData& operator*() const;
+        const IDBKeyData* operator->() const { return &**this; }
+        Iterator& operator++();
+
+        bool operator==(const Iterator& other) const { return m_leaf == other.m_leaf && m_index == other.m_index; }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        friend class IDBKeyDataBTree;
+        Iterator(const LeafNode* leaf, size_t index)
+            : m_leaf(leaf)
+            , m_index(index)
+        {
+        }
+
+        const LeafNode* m_leaf;
+        size_t m_index;
+    };
+
+    Iterator begin() const;
+    Iterator end() const { return Iterator(nullptr, 0); }
+
+    // Returns the first key that is not less than the given key.
+    Iterator lowerBound(const IDBKeyData&) const;
+    Iterator find(const IDBKeyData&) const;
+    bool contains(const IDBKeyData& key) const { return find(key) != end(); }
+
+    const IDBKeyData* first() const;
+    size_t size() const { return m_size; }
+    bool isEmpty() const { return !m_size; }
+
+    // add() returns false if the key was already present, remove() if it wasn't.
+    bool add(const IDBKeyData&);
+    bool remove(const IDBKeyData&);
+
+    void clear();
+
+private:
+    static LeafNode& asLeaf(Node&);
+    static InternalNode& asInternal(Node&);
+
+    std::unique_ptr<Node> addToNode(Node&, const IDBKeyData&, IDBKeyData& splitKey, bool& added);
+    bool removeFromNode(Node&, const IDBKeyData&);
+    void removeChild(InternalNode&, size_t childIndex);
+    void mergeLeaves(InternalNode&, size_t leftChildIndex);
+
+    std::unique_ptr<Node> m_root;
+    LeafNode* m_firstLeaf { nullptr };
+    size_t m_size { 0 };
+};
+
+} // namespace IDBServer
+} // namespace WebCore
+
+#endif // ENABLE(INDEXED_DATABASE)
+#endif // IDBKeyDataBTree_h
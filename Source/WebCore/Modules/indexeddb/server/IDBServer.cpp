@@ -32,18 +32,51 @@
 #include "IDBResultData.h"
 #include "Logging.h"
 #include "MemoryIDBBackingStore.h"
+#include "SQLiteIDBBackingStore.h"
+#include <heap/StrongInlines.h>
+#include <runtime/JSGlobalObject.h>
 #include <wtf/Locker.h>
 #include <wtf/MainThread.h>
+#include <wtf/NeverDestroyed.h>
 
 namespace WebCore {
 namespace IDBServer {
 
+using namespace JSC;
+
+VM& databaseThreadVM()
+{
+    ASSERT(!isMainThread());
+    static NeverDestroyed<RefPtr<VM>> vm = VM::create();
+    return *vm.get();
+}
+
+ExecState& databaseThreadExecState()
+{
+    ASSERT(!isMainThread());
+    static NeverDestroyed<Strong<JSGlobalObject>> globalObject;
+    static bool initialized = false;
+    if (!initialized) {
+        globalObject.get().set(databaseThreadVM(), JSGlobalObject::create(databaseThreadVM(), JSGlobalObject::createStructure(databaseThreadVM(), jsNull())));
+        initialized = true;
+    }
+
+    RELEASE_ASSERT(globalObject.get()->globalExec());
+    return *globalObject.get()->globalExec();
+}
+
 Ref<IDBServer> IDBServer::create()
 {
-    return adoptRef(*new IDBServer());
+    return adoptRef(*new IDBServer(String()));
+}
+
+Ref<IDBServer> IDBServer::create(const String& databaseDirectoryPath)
+{
+    return adoptRef(*new IDBServer(databaseDirectoryPath));
 }
 
-IDBServer::IDBServer()
+IDBServer::IDBServer(const String& databaseDirectoryPath)
+    : m_databaseDirectoryPath(databaseDirectoryPath.isolatedCopy())
 {
     Locker<Lock> locker(m_databaseThreadCreationLock);
     m_threadID = createThread(IDBServer::databaseThreadEntry, this, "IndexedDatabase Server");
@@ -102,11 +135,11 @@ std::unique_ptr<IDBBackingStore> IDBServer::createBackingStore(const IDBDatabase
 {
     ASSERT(!isMainThread());
 
-    // FIXME: For now we only have the in-memory backing store, which we'll continue to use for private browsing.
-    // Once it's time for persistent backing stores this is where we'll calculate the correct path on disk
-    // and create it.
+    // Servers without a database directory (private browsing, for one) keep everything in memory.
+    if (m_databaseDirectoryPath.isEmpty())
+        return MemoryIDBBackingStore::create(identifier);
 
-    return MemoryIDBBackingStore::create(identifier);
+    return SQLiteIDBBackingStore::create(identifier, m_databaseDirectoryPath);
 }
 
 void IDBServer::openDatabase(const IDBRequestData& requestData)
@@ -286,13 +319,13 @@ void IDBServer::databaseConnectionClosed(uint64_t databaseConnectionIdentifier)
 void IDBServer::postDatabaseTask(std::unique_ptr<CrossThreadTask>&& task)
 {
     ASSERT(isMainThread());
-    m_databaseQueue.append(WTF::move(task));
+    m_databaseQueue.enqueue(WTF::move(task));
 }
 
 void IDBServer::postDatabaseTaskReply(std::unique_ptr<CrossThreadTask>&& task)
 {
     ASSERT(!isMainThread());
-    m_databaseReplyQueue.append(WTF::move(task));
+    m_databaseReplyQueue.enqueue(WTF::move(task));
 
 
     Locker<Lock> locker(m_mainThreadReplyLock);
@@ -319,8 +352,8 @@ void IDBServer::databaseRunLoop()
         Locker<Lock> locker(m_databaseThreadCreationLock);
     }
 
-    while (auto task = m_databaseQueue.waitForMessage())
-        task->performTask();
+    while (auto task = m_databaseQueue.dequeue())
+        (*task)->performTask();
 }
 
 void IDBServer::handleTaskRepliesOnMainThread()
@@ -330,8 +363,8 @@ void IDBServer::handleTaskRepliesOnMainThread()
         m_mainThreadReplyScheduled = false;
     }
 
-    while (auto task = m_databaseReplyQueue.tryGetMessage())
-        task->performTask();
+    while (auto task = m_databaseReplyQueue.tryDequeue())
+        (*task)->performTask();
 }
 
 } // namespace IDBServer
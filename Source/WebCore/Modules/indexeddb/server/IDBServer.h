@@ -35,11 +35,16 @@
 #include "UniqueIDBDatabaseConnection.h"
 #include <wtf/HashMap.h>
 #include <wtf/Lock.h>
-#include <wtf/MessageQueue.h>
+#include <wtf/LockFreeQueue.h>
 #include <wtf/Ref.h>
 #include <wtf/RefCounted.h>
 #include <wtf/RefPtr.h>
 
+namespace JSC {
+class ExecState;
+class VM;
+}
+
 namespace WebCore {
 
 class CrossThreadTask;
@@ -47,9 +52,14 @@ class IDBRequestData;
 
 namespace IDBServer {
 
+// The JavaScript environment backing stores use on the database thread to extract index keys from record values.
+JSC::VM& databaseThreadVM();
+JSC::ExecState& databaseThreadExecState();
+
 class IDBServer : public RefCounted<IDBServer> {
 public:
     static Ref<IDBServer> create();
+    static Ref<IDBServer> create(const String& databaseDirectoryPath);
 
     void registerConnection(IDBConnectionToClient&);
     void unregisterConnection(IDBConnectionToClient&);
@@ -81,7 +91,7 @@ public:
     std::unique_ptr<IDBBackingStore> createBackingStore(const IDBDatabaseIdentifier&);
 
 private:
-    IDBServer();
+    IDBServer(const String& databaseDirectoryPath);
 
     UniqueIDBDatabase& getOrCreateUniqueIDBDatabase(const IDBDatabaseIdentifier&);
 
@@ -92,13 +102,15 @@ private:
     HashMap<uint64_t, RefPtr<IDBConnectionToClient>> m_connectionMap;
     HashMap<IDBDatabaseIdentifier, RefPtr<UniqueIDBDatabase>> m_uniqueIDBDatabaseMap;
 
+    String m_databaseDirectoryPath;
+
     ThreadIdentifier m_threadID { 0 };
     Lock m_databaseThreadCreationLock;
     Lock m_mainThreadReplyLock;
     bool m_mainThreadReplyScheduled { false };
 
-    MessageQueue<CrossThreadTask> m_databaseQueue;
-    MessageQueue<CrossThreadTask> m_databaseReplyQueue;
+    MPSCQueue<std::unique_ptr<CrossThreadTask>> m_databaseQueue;
+    MPSCQueue<std::unique_ptr<CrossThreadTask>> m_databaseReplyQueue;
 
     HashMap<uint64_t, UniqueIDBDatabaseConnection*> m_databaseConnections;
     HashMap<IDBResourceIdentifier, UniqueIDBDatabaseTransaction*> m_transactions;
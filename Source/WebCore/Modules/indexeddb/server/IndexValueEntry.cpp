@@ -37,7 +37,7 @@ IndexValueEntry::IndexValueEntry(bool unique)
     if (m_unique)
         m_key = nullptr;
     else
-        m_orderedKeys = new std::set<IDBKeyData>;
+        m_orderedKeys = new IDBKeyDataBTree;
 }
 
 IndexValueEntry::~IndexValueEntry()
@@ -56,19 +56,21 @@ void IndexValueEntry::addKey(const IDBKeyData& key)
         return;
     }
 
-    m_orderedKeys->insert(key);
+    m_orderedKeys->add(key);
 }
 
 bool IndexValueEntry::removeKey(const IDBKeyData& key)
 {
-    if (m_unique && m_key && *m_key == key) {
-        delete m_key;
-        m_key = nullptr;
-        return true;
+    if (m_unique) {
+        if (m_key && *m_key == key) {
+            delete m_key;
+            m_key = nullptr;
+        }
+        return !m_key;
     }
 
-    m_orderedKeys->erase(key);
-    return m_orderedKeys->empty();
+    m_orderedKeys->remove(key);
+    return m_orderedKeys->isEmpty();
 }
 
 const IDBKeyData* IndexValueEntry::getLowest() const
@@ -76,10 +78,7 @@ const IDBKeyData* IndexValueEntry::getLowest() const
     if (m_unique)
         return m_key;
 
-    if (m_orderedKeys->empty())
-        return nullptr;
-
-    return &(*m_orderedKeys->begin());
+    return m_orderedKeys->first();
 }
 
 uint64_t IndexValueEntry::getCount() const
@@ -29,7 +29,7 @@
 #if ENABLE(INDEXED_DATABASE)
 
 #include "IDBKeyData.h"
-#include <set>
+#include "IDBKeyDataBTree.h"
 
 namespace WebCore {
 namespace IDBServer {
@@ -50,7 +50,7 @@ public:
 
 private:
     union {
-        std::set<IDBKeyData>* m_orderedKeys;
+        IDBKeyDataBTree* m_orderedKeys;
         IDBKeyData* m_key;
     };
 
@@ -79,7 +79,7 @@ IDBError IndexValueStore::addRecord(const IDBKeyData& indexKey, const IDBKeyData
         result.iterator->value = std::make_unique<IndexValueEntry>(m_unique);
 
     result.iterator->value->addKey(valueKey);
-    m_orderedKeys.insert(indexKey);
+    m_orderedKeys.add(indexKey);
 
     return { };
 }
@@ -87,11 +87,13 @@ IDBError IndexValueStore::addRecord(const IDBKeyData& indexKey, const IDBKeyData
 void IndexValueStore::removeRecord(const IDBKeyData& indexKey, const IDBKeyData& valueKey)
 {
     auto iterator = m_records.find(indexKey);
-    if (!iterator->value)
+    if (iterator == m_records.end())
         return;
 
-    if (iterator->value->removeKey(valueKey))
+    if (iterator->value->removeKey(valueKey)) {
+        m_orderedKeys.remove(indexKey);
         m_records.remove(iterator);
+    }
 }
 
 void IndexValueStore::removeEntriesWithValueKey(const IDBKeyData& valueKey)
@@ -104,7 +106,7 @@ void IndexValueStore::removeEntriesWithValueKey(const IDBKeyData& valueKey)
     }
 
     for (auto* entry : entryKeysToRemove) {
-        m_orderedKeys.erase(*entry);
+        m_orderedKeys.remove(*entry);
         m_records.remove(*entry);
     }
 }
@@ -114,7 +116,7 @@ IDBKeyData IndexValueStore::lowestKeyWithRecordInRange(const IDBKeyRangeData& ra
     if (range.isExactlyOneKey())
         return m_records.contains(range.lowerKey) ? range.lowerKey : IDBKeyData();
 
-    auto lowestInRange = m_orderedKeys.lower_bound(range.lowerKey);
+    auto lowestInRange = m_orderedKeys.lowerBound(range.lowerKey);
 
     if (lowestInRange == m_orderedKeys.end())
         return { };
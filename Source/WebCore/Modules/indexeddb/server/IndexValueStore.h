@@ -29,8 +29,8 @@
 #if ENABLE(INDEXED_DATABASE)
 
 #include "IDBKeyData.h"
+#include "IDBKeyDataBTree.h"
 #include "IndexValueEntry.h"
-#include <set>
 #include <wtf/HashMap.h>
 
 namespace WebCore {
@@ -59,7 +59,7 @@ public:
 
 private:
     IndexKeyValueMap m_records;
-    std::set<IDBKeyData> m_orderedKeys;
+    IDBKeyDataBTree m_orderedKeys;
     
     bool m_unique;
 };
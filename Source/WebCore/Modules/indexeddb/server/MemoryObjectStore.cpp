@@ -32,12 +32,11 @@
 #include "IDBDatabaseException.h"
 #include "IDBError.h"
 #include "IDBKeyRangeData.h"
+#include "IDBServer.h"
 #include "IndexKey.h"
 #include "Logging.h"
 #include "MemoryBackingStoreTransaction.h"
 
-#include <wtf/NeverDestroyed.h>
-
 using namespace JSC;
 
 namespace WebCore {
@@ -106,6 +105,7 @@ void MemoryObjectStore::clear()
     ASSERT(m_writeTransaction);
 
     m_writeTransaction->objectStoreCleared(*this, WTF::move(m_keyValueStore));
+    m_orderedKeys = nullptr;
     for (auto& index : m_indexesByIdentifier.values())
         index->objectStoreCleared();
 }
@@ -116,6 +116,14 @@ void MemoryObjectStore::replaceKeyValueStore(std::unique_ptr<KeyValueMap>&& stor
     ASSERT(m_writeTransaction->isAborting());
 
     m_keyValueStore = WTF::move(store);
+
+    m_orderedKeys = nullptr;
+    if (!m_keyValueStore)
+        return;
+
+    m_orderedKeys = std::make_unique<IDBKeyDataBTree>();
+    for (auto& key : m_keyValueStore->keys())
+        m_orderedKeys->add(key);
 }
 
 void MemoryObjectStore::deleteRecord(const IDBKeyData& key)
@@ -139,7 +147,7 @@ void MemoryObjectStore::deleteRecord(const IDBKeyData& key)
 
     m_writeTransaction->recordValueChanged(*this, key, &iterator->value);
     m_keyValueStore->remove(iterator);
-    m_orderedKeys->erase(key);
+    m_orderedKeys->remove(key);
 
     updateIndexesForDeleteRecord(key);
 }
@@ -175,50 +183,29 @@ IDBError MemoryObjectStore::addRecord(MemoryBackingStoreTransaction& transaction
     ASSERT(m_writeTransaction);
     ASSERT_UNUSED(transaction, m_writeTransaction == &transaction);
     ASSERT(!m_keyValueStore || !m_keyValueStore->contains(keyData));
-    ASSERT(!m_orderedKeys || m_orderedKeys->find(keyData) == m_orderedKeys->end());
+    ASSERT(!m_orderedKeys || !m_orderedKeys->contains(keyData));
 
     if (!m_keyValueStore) {
         ASSERT(!m_orderedKeys);
         m_keyValueStore = std::make_unique<KeyValueMap>();
-        m_orderedKeys = std::make_unique<std::set<IDBKeyData>>();
+        m_orderedKeys = std::make_unique<IDBKeyDataBTree>();
     }
 
     auto mapResult = m_keyValueStore->set(keyData, value);
     ASSERT(mapResult.isNewEntry);
-    auto listResult = m_orderedKeys->insert(keyData);
-    ASSERT(listResult.second);
+    bool addedToOrderedKeys = m_orderedKeys->add(keyData);
+    ASSERT_UNUSED(addedToOrderedKeys, addedToOrderedKeys);
 
     // If there was an error indexing this addition, then revert it.
     auto error = updateIndexesForPutRecord(keyData, value);
     if (!error.isNull()) {
         m_keyValueStore->remove(mapResult.iterator);
-        m_orderedKeys->erase(listResult.first);
+        m_orderedKeys->remove(keyData);
     }
 
     return error;
 }
 
-static VM& indexVM()
-{
-    ASSERT(!isMainThread());
-    static NeverDestroyed<RefPtr<VM>> vm = VM::create();
-    return *vm.get();
-}
-
-static ExecState& indexGlobalExec()
-{
-    ASSERT(!isMainThread());
-    static NeverDestroyed<Strong<JSGlobalObject>> globalObject;
-    static bool initialized = false;
-    if (!initialized) {
-        globalObject.get().set(indexVM(), JSGlobalObject::create(indexVM(), JSGlobalObject::createStructure(indexVM(), jsNull())));
-        initialized = true;
-    }
-
-    RELEASE_ASSERT(globalObject.get()->globalExec());
-    return *globalObject.get()->globalExec();
-}
-
 void MemoryObjectStore::updateIndexesForDeleteRecord(const IDBKeyData& value)
 {
     for (auto* index : m_indexesByName.values())
@@ -227,9 +214,9 @@ void MemoryObjectStore::updateIndexesForDeleteRecord(const IDBKeyData& value)
 
 IDBError MemoryObjectStore::updateIndexesForPutRecord(const IDBKeyData& key, const ThreadSafeDataBuffer& value)
 {
-    JSLockHolder locker(indexVM());
+    JSLockHolder locker(databaseThreadVM());
 
-    auto jsValue = idbValueDataToJSValue(indexGlobalExec(), value);
+    auto jsValue = idbValueDataToJSValue(databaseThreadExecState(), value);
     if (jsValue.isUndefinedOrNull())
         return { };
 
@@ -238,7 +225,7 @@ IDBError MemoryObjectStore::updateIndexesForPutRecord(const IDBKeyData& key, con
 
     for (auto* index : m_indexesByName.values()) {
         IndexKey indexKey;
-        generateIndexKeyForValue(indexGlobalExec(), index->info(), jsValue, indexKey);
+        generateIndexKeyForValue(databaseThreadExecState(), index->info(), jsValue, indexKey);
 
         if (indexKey.isNull())
             continue;
@@ -318,7 +305,7 @@ IDBKeyData MemoryObjectStore::lowestKeyWithRecordInRange(const IDBKeyRangeData&
 
     ASSERT(m_orderedKeys);
 
-    auto lowestInRange = m_orderedKeys->lower_bound(keyRangeData.lowerKey);
+    auto lowestInRange = m_orderedKeys->lowerBound(keyRangeData.lowerKey);
 
     if (lowestInRange == m_orderedKeys->end())
         return { };
@@ -29,10 +29,10 @@
 #if ENABLE(INDEXED_DATABASE)
 
 #include "IDBKeyData.h"
+#include "IDBKeyDataBTree.h"
 #include "IDBObjectStoreInfo.h"
 #include "MemoryIndex.h"
 #include "ThreadSafeDataBuffer.h"
-#include <set>
 #include <wtf/HashMap.h>
 
 namespace WebCore {
@@ -96,7 +96,7 @@ private:
     uint64_t m_keyGeneratorValue { 1 };
 
     std::unique_ptr<KeyValueMap> m_keyValueStore;
-    std::unique_ptr<std::set<IDBKeyData>> m_orderedKeys;
+    std::unique_ptr<IDBKeyDataBTree> m_orderedKeys;
 
     void registerIndex(std::unique_ptr<MemoryIndex>&&);
     void unregisterIndex(MemoryIndex&);
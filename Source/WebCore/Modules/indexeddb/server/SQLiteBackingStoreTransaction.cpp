@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SQLiteBackingStoreTransaction.h"
+
+#if ENABLE(INDEXED_DATABASE)
+
+namespace WebCore {
+namespace IDBServer {
+
+std::unique_ptr<SQLiteBackingStoreTransaction> SQLiteBackingStoreTransaction::create(const IDBTransactionInfo& info, const IDBDatabaseInfo& databaseInfo)
+{
+    return std::make_unique<SQLiteBackingStoreTransaction>(info, databaseInfo);
+}
+
+SQLiteBackingStoreTransaction::SQLiteBackingStoreTransaction(const IDBTransactionInfo& info, const IDBDatabaseInfo& databaseInfo)
+    : m_info(info)
+{
+    if (isVersionChange())
+        m_originalDatabaseInfo = std::make_unique<IDBDatabaseInfo>(databaseInfo);
+}
+
+const IDBDatabaseInfo& SQLiteBackingStoreTransaction::originalDatabaseInfo() const
+{
+    ASSERT(m_originalDatabaseInfo);
+    return *m_originalDatabaseInfo;
+}
+
+bool SQLiteBackingStoreTransaction::hasOriginalValue(uint64_t objectStoreIdentifier, const IDBKeyData& key) const
+{
+    auto* values = m_originalValues.get(objectStoreIdentifier);
+    return values && values->contains(key);
+}
+
+void SQLiteBackingStoreTransaction::recordOriginalValue(uint64_t objectStoreIdentifier, const IDBKeyData& key, const ThreadSafeDataBuffer& value)
+{
+    ASSERT(isWriting());
+
+    auto addResult = m_originalValues.add(objectStoreIdentifier, nullptr);
+    if (addResult.isNewEntry)
+        addResult.iterator->value = std::make_unique<KeyValueMap>();
+
+    // Only the value from before this transaction first touched the record matters.
+    addResult.iterator->value->add(key, value);
+}
+
+void SQLiteBackingStoreTransaction::recordOriginalKeyGeneratorValue(uint64_t objectStoreIdentifier, uint64_t value)
+{
+    ASSERT(isWriting());
+    m_originalKeyGeneratorValues.add(objectStoreIdentifier, value);
+}
+
+} // namespace IDBServer
+} // namespace WebCore
+
+#endif // ENABLE(INDEXED_DATABASE)
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLiteBackingStoreTransaction_h
+#define SQLiteBackingStoreTransaction_h
+
+#if ENABLE(INDEXED_DATABASE)
+
+#include "IDBDatabaseInfo.h"
+#include "IDBKeyData.h"
+#include "IDBTransactionInfo.h"
+#include "ThreadSafeDataBuffer.h"
+#include <wtf/HashMap.h>
+
+namespace WebCore {
+namespace IDBServer {
+
+typedef HashMap<IDBKeyData, ThreadSafeDataBuffer, IDBKeyDataHash, IDBKeyDataHashTraits> KeyValueMap;
+
+// Write transactions that overlap in time share a single SQLite transaction, so one of them aborting
+// cannot simply roll back. Each transaction therefore remembers the value every record it touched had
+// before it first touched it (a null buffer meaning there was no record), and the key generator values
+// it started from, so that the backing store can put them back.
+class SQLiteBackingStoreTransaction {
+    friend std::unique_ptr<SQLiteBackingStoreTransaction> std::make_unique<SQLiteBackingStoreTransaction>(const WebCore::IDBTransactionInfo&, const WebCore::IDBDatabaseInfo&);
+public:
+    static std::unique_ptr<SQLiteBackingStoreTransaction> create(const IDBTransactionInfo&, const IDBDatabaseInfo&);
+
+    bool isVersionChange() const { return m_info.mode() == IndexedDB::TransactionMode::VersionChange; }
+    bool isWriting() const { return m_info.mode() != IndexedDB::TransactionMode::ReadOnly; }
+
+    const IDBTransactionInfo& info() const { return m_info; }
+    const IDBDatabaseInfo& originalDatabaseInfo() const;
+
+    bool hasOriginalValue(uint64_t objectStoreIdentifier, const IDBKeyData&) const;
+    void recordOriginalValue(uint64_t objectStoreIdentifier, const IDBKeyData&, const ThreadSafeDataBuffer&);
+    void recordOriginalKeyGeneratorValue(uint64_t objectStoreIdentifier, uint64_t);
+
+    const HashMap<uint64_t, std::unique_ptr<KeyValueMap>>& originalValues() const { return m_originalValues; }
+    const HashMap<uint64_t, uint64_t>& originalKeyGeneratorValues() const { return m_originalKeyGeneratorValues; }
+
+private:
+    SQLiteBackingStoreTransaction(const IDBTransactionInfo&, const IDBDatabaseInfo&);
+
+    IDBTransactionInfo m_info;
+    std::unique_ptr<IDBDatabaseInfo> m_originalDatabaseInfo;
+
+    HashMap<uint64_t, std::unique_ptr<KeyValueMap>> m_originalValues;
+    HashMap<uint64_t, uint64_t> m_originalKeyGeneratorValues;
+};
+
+} // namespace IDBServer
+} // namespace WebCore
+
+#endif // ENABLE(INDEXED_DATABASE)
+#endif // SQLiteBackingStoreTransaction_h
@@ -0,0 +1,1178 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SQLiteIDBBackingStore.h"
+
+#if ENABLE(INDEXED_DATABASE)
+
+#include "FileSystem.h"
+#include "IDBBindingUtilities.h"
+#include "IDBDatabaseException.h"
+#include "IDBGetResult.h"
+#include "IDBIndexInfo.h"
+#include "IDBKeyData.h"
+#include "IDBKeyRangeData.h"
+#include "IDBServer.h"
+#include "IndexKey.h"
+#include "KeyedCoding.h"
+#include "Logging.h"
+#include "SQLiteDatabase.h"
+#include "SQLiteFileSystem.h"
+#include "SQLiteStatement.h"
+#include "SQLiteTransaction.h"
+#include "SharedBuffer.h"
+#include <wtf/MainThread.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/text/StringBuilder.h>
+
+using namespace JSC;
+
+namespace WebCore {
+namespace IDBServer {
+
+// Current version of the metadata schema being used in the database.
+static const int currentMetadataVersion = 1;
+
+// The key generator of a new object store starts at 1, as it does in the memory backing store.
+static const uint64_t initialKeyGeneratorValue = 1;
+
+static const String& databaseFilename()
+{
+    static NeverDestroyed<String> filename(ASCIILiteral("IndexedDB.sqlite3"));
+    return filename;
+}
+
+static RefPtr<SharedBuffer> serializeIDBKeyPath(const IDBKeyPath& keyPath)
+{
+    auto encoder = KeyedEncoder::encoder();
+    keyPath.encode(*encoder);
+    return encoder->finishEncoding();
+}
+
+static bool deserializeIDBKeyPath(const uint8_t* data, size_t size, IDBKeyPath& result)
+{
+    if (!data || !size)
+        return false;
+
+    auto decoder = KeyedDecoder::decoder(data, size);
+    return IDBKeyPath::decode(*decoder, result);
+}
+
+static RefPtr<SharedBuffer> serializeIDBKeyData(const IDBKeyData& key)
+{
+    auto encoder = KeyedEncoder::encoder();
+    key.encode(*encoder);
+    return encoder->finishEncoding();
+}
+
+static bool deserializeIDBKeyData(const uint8_t* data, size_t size, IDBKeyData& result)
+{
+    if (!data || !size)
+        return false;
+
+    auto decoder = KeyedDecoder::decoder(data, size);
+    return IDBKeyData::decode(*decoder, result);
+}
+
+static int idbKeyCollate(int aLength, const void* aBuffer, int bLength, const void* bBuffer)
+{
+    IDBKeyData a, b;
+    if (!deserializeIDBKeyData(static_cast<const uint8_t*>(aBuffer), aLength, a)) {
+        LOG_ERROR("Unable to deserialize key A in collation function.");
+
+        // There's no way to indicate an error to SQLite - we have to return a sorting decision.
+        // We arbitrarily choose "A > B"
+        return 1;
+    }
+    if (!deserializeIDBKeyData(static_cast<const uint8_t*>(bBuffer), bLength, b)) {
+        LOG_ERROR("Unable to deserialize key B in collation function.");
+        return 1;
+    }
+
+    return a.compare(b);
+}
+
+static int bindKey(SQLiteStatement& statement, int index, const IDBKeyData& key)
+{
+    RefPtr<SharedBuffer> buffer = serializeIDBKeyData(key);
+    return statement.bindBlob(index, buffer->data(), buffer->size());
+}
+
+static bool bindValue(SQLiteStatement& statement, int index, const ThreadSafeDataBuffer& value)
+{
+    auto* data = value.data();
+    if (!data)
+        return statement.bindBlob(index, nullptr, 0) == SQLITE_OK;
+    return statement.bindBlob(index, data->data(), data->size()) == SQLITE_OK;
+}
+
+static bool columnAsKey(SQLiteStatement& statement, int column, IDBKeyData& key)
+{
+    Vector<uint8_t> keyBuffer;
+    statement.getColumnBlobAsVector(column, keyBuffer);
+    return deserializeIDBKeyData(keyBuffer.data(), keyBuffer.size(), key);
+}
+
+static ThreadSafeDataBuffer columnAsValue(SQLiteStatement& statement, int column)
+{
+    Vector<uint8_t> valueBuffer;
+    statement.getColumnBlobAsVector(column, valueBuffer);
+    return ThreadSafeDataBuffer::adoptVector(valueBuffer);
+}
+
+// Builds the "key > ? AND key <= ?" style condition for a key range. An unbounded end of the range is
+// expressed with the minimum or maximum key, so every range needs two bound parameters and there are
+// only four distinct queries per table, which keeps the statement cache small.
+static void appendKeyRangeCondition(StringBuilder& builder, const IDBKeyRangeData& range)
+{
+    builder.appendLiteral(" AND key ");
+    if (!range.lowerKey.isNull() && !range.lowerOpen)
+        builder.appendLiteral(">=");
+    else
+        builder.append('>');
+
+    builder.appendLiteral(" CAST(? AS TEXT) AND key ");
+    if (!range.upperKey.isNull() && !range.upperOpen)
+        builder.appendLiteral("<=");
+    else
+        builder.append('<');
+
+    builder.appendLiteral(" CAST(? AS TEXT)");
+}
+
+static int bindKeyRange(SQLiteStatement& statement, int firstIndex, const IDBKeyRangeData& range)
+{
+    int result = bindKey(statement, firstIndex, range.lowerKey.isNull() ? IDBKeyData::minimum() : range.lowerKey);
+    if (result != SQLITE_OK)
+        return result;
+    return bindKey(statement, firstIndex + 1, range.upperKey.isNull() ? IDBKeyData::maximum() : range.upperKey);
+}
+
+std::unique_ptr<SQLiteIDBBackingStore> SQLiteIDBBackingStore::create(const IDBDatabaseIdentifier& identifier, const String& databaseRootDirectory)
+{
+    return std::make_unique<SQLiteIDBBackingStore>(identifier, databaseRootDirectory);
+}
+
+SQLiteIDBBackingStore::SQLiteIDBBackingStore(const IDBDatabaseIdentifier& identifier, const String& databaseRootDirectory)
+    : m_identifier(identifier)
+{
+    m_absoluteDatabaseDirectory = identifier.databaseDirectoryRelativeToRoot(databaseRootDirectory);
+}
+
+SQLiteIDBBackingStore::~SQLiteIDBBackingStore()
+{
+    ASSERT(!isMainThread());
+
+    // Statements have to be finalized before the database they belong to is closed.
+    m_cachedStatements.clear();
+    m_sqliteTransaction = nullptr;
+    m_sqliteDB = nullptr;
+}
+
+SQLiteStatement* SQLiteIDBBackingStore::cachedStatement(const String& query)
+{
+    ASSERT(m_sqliteDB);
+
+    auto addResult = m_cachedStatements.add(query, nullptr);
+    if (addResult.isNewEntry) {
+        auto statement = std::make_unique<SQLiteStatement>(*m_sqliteDB, query);
+        if (statement->prepare() != SQLITE_OK) {
+            LOG_ERROR("Could not prepare statement '%s' (%i) - %s", query.utf8().data(), m_sqliteDB->lastError(), m_sqliteDB->lastErrorMsg());
+            m_cachedStatements.remove(addResult.iterator);
+            return nullptr;
+        }
+        addResult.iterator->value = WTF::move(statement);
+        return addResult.iterator->value.get();
+    }
+
+    auto* statement = addResult.iterator->value.get();
+    if (statement->reset() != SQLITE_OK) {
+        LOG_ERROR("Could not reset statement '%s' (%i) - %s", query.utf8().data(), m_sqliteDB->lastError(), m_sqliteDB->lastErrorMsg());
+        return nullptr;
+    }
+    return statement;
+}
+
+bool SQLiteIDBBackingStore::createTablesIfNecessary()
+{
+    ASSERT(m_sqliteDB);
+
+    if (m_sqliteDB->tableExists(ASCIILiteral("IDBDatabaseInfo")))
+        return true;
+
+    SQLiteTransaction transaction(*m_sqliteDB);
+    transaction.begin();
+
+    static const char* const schemaCommands[] = {
+        "CREATE TABLE IDBDatabaseInfo (key TEXT NOT NULL ON CONFLICT FAIL UNIQUE ON CONFLICT REPLACE, value TEXT NOT NULL ON CONFLICT FAIL);",
+        "CREATE TABLE ObjectStoreInfo (id INTEGER PRIMARY KEY NOT NULL ON CONFLICT FAIL UNIQUE ON CONFLICT FAIL, name TEXT NOT NULL ON CONFLICT FAIL UNIQUE ON CONFLICT FAIL, keyPath BLOB NOT NULL ON CONFLICT FAIL, autoInc INTEGER NOT NULL ON CONFLICT FAIL);",
+        "CREATE TABLE IndexInfo (id INTEGER NOT NULL ON CONFLICT FAIL, name TEXT NOT NULL ON CONFLICT FAIL, objectStoreID INTEGER NOT NULL ON CONFLICT FAIL, keyPath BLOB NOT NULL ON CONFLICT FAIL, isUnique INTEGER NOT NULL ON CONFLICT FAIL, multiEntry INTEGER NOT NULL ON CONFLICT FAIL);",
+        "CREATE TABLE KeyGenerators (objectStoreID INTEGER NOT NULL ON CONFLICT FAIL UNIQUE ON CONFLICT REPLACE, currentKey INTEGER NOT NULL ON CONFLICT FAIL);",
+        "CREATE TABLE Records (objectStoreID INTEGER NOT NULL ON CONFLICT FAIL, key TEXT COLLATE IDBKEY NOT NULL ON CONFLICT FAIL, value NOT NULL ON CONFLICT FAIL);",
+        "CREATE UNIQUE INDEX RecordsIndex ON Records (objectStoreID, key);",
+        "CREATE TABLE IndexRecords (indexID INTEGER NOT NULL ON CONFLICT FAIL, objectStoreID INTEGER NOT NULL ON CONFLICT FAIL, key TEXT COLLATE IDBKEY NOT NULL ON CONFLICT FAIL, value TEXT COLLATE IDBKEY NOT NULL ON CONFLICT FAIL);",
+        "CREATE INDEX IndexRecordsIndex ON IndexRecords (objectStoreID, indexID, key, value);",
+        "CREATE INDEX IndexRecordsValueIndex ON IndexRecords (objectStoreID, value);",
+    };
+
+    for (auto* command : schemaCommands) {
+        if (!m_sqliteDB->executeCommand(command)) {
+            LOG_ERROR("Could not create IndexedDB schema (%i) - %s", m_sqliteDB->lastError(), m_sqliteDB->lastErrorMsg());
+            transaction.rollback();
+            return false;
+        }
+    }
+
+    transaction.commit();
+    return true;
+}
+
+std::unique_ptr<IDBDatabaseInfo> SQLiteIDBBackingStore::createAndPopulateInitialDatabaseInfo()
+{
+    ASSERT(m_sqliteDB);
+
+    SQLiteStatement sql(*m_sqliteDB, ASCIILiteral("INSERT INTO IDBDatabaseInfo VALUES (?, ?);"));
+    if (sql.prepare() != SQLITE_OK) {
+        LOG_ERROR("Could not prepare statement to insert initial database info (%i) - %s", m_sqliteDB->lastError(), m_sqliteDB->lastErrorMsg());
+        return nullptr;
+    }
+
+    std::pair<const char*, String> initialValues[] = {
+        { "MetadataVersion", String::number(currentMetadataVersion) },
+        { "DatabaseName", m_identifier.databaseName() },
+        { "DatabaseVersion", String::number(0) },
+    };
+
+    for (auto& value : initialValues) {
+        if (sql.reset() != SQLITE_OK
+            || sql.bindText(1, value.first) != SQLITE_OK
+            || sql.bindText(2, value.second) != SQLITE_OK
+            || sql.step() != SQLITE_DONE) {
+            LOG_ERROR("Could not insert '%s' into database info (%i) - %s", value.first, m_sqliteDB->lastError(), m_sqliteDB->lastErrorMsg());
+            return nullptr;
+        }
+    }
+
+    return std::make_unique<IDBDatabaseInfo>(m_identifier.databaseName(), 0);
+}
+
+std::unique_ptr<IDBDatabaseInfo> SQLiteIDBBackingStore::extractExistingDatabaseInfo()
+{
+    ASSERT(m_sqliteDB);
+
+    String databaseName;
+    uint64_t databaseVersion = 0;
+    {
+        SQLiteStatement sql(*m_sqliteDB, ASCIILiteral("SELECT key, value FROM IDBDatabaseInfo;"));
+        if (sql.prepare() != SQLITE_OK)
+            return nullptr;
+
+        bool hasMetadataVersion = false;
+        int result = sql.step();
+        while (result == SQLITE_ROW) {
+            String key = sql.getColumnText(0);
+            if (key == "MetadataVersion") {
+                if (sql.getColumnInt(1) > currentMetadataVersion) {
+                    LOG_ERROR("IndexedDB database was written with a newer metadata version than this one can read");
+                    return nullptr;
+                }
+                hasMetadataVersion = true;
+            } else if (key == "DatabaseName")
+                databaseName = sql.getColumnText(1);
+            else if (key == "DatabaseVersion")
+                databaseVersion = sql.getColumnInt64(1);
+            result = sql.step();
+        }
+
+        if (result != SQLITE_DONE || !hasMetadataVersion)
+            return nullptr;
+    }
+
+    if (databaseName != m_identifier.databaseName()) {
+        LOG_ERROR("Database name '%s' on disk does not match the expected name", databaseName.utf8().data());
+        return nullptr;
+    }
+
+    auto databaseInfo = std::make_unique<IDBDatabaseInfo>(databaseName, databaseVersion);
+
+    {
+        SQLiteStatement sql(*m_sqliteDB, ASCIILiteral("SELECT id, name, keyPath, autoInc FROM ObjectStoreInfo;"));
+        if (sql.prepare() != SQLITE_OK)
+            return nullptr;
+
+        int result = sql.step();
+        while (result == SQLITE_ROW) {
+            Vector<uint8_t> keyPathBuffer;
+            sql.getColumnBlobAsVector(2, keyPathBuffer);
+
+            IDBKeyPath keyPath;
+            if (!deserializeIDBKeyPath(keyPathBuffer.data(), keyPathBuffer.size(), keyPath)) {
+                LOG_ERROR("Unable to extract key path for an object store from the database");
+                return nullptr;
+            }
+
+            databaseInfo->addExistingObjectStore(IDBObjectStoreInfo(sql.getColumnInt64(0), sql.getColumnText(1), keyPath, sql.getColumnInt(3)));
+            result = sql.step();
+        }
+
+        if (result != SQLITE_DONE)
+            return nullptr;
+    }
+
+    {
+        SQLiteStatement sql(*m_sqliteDB, ASCIILiteral("SELECT id, name, objectStoreID, keyPath, isUnique, multiEntry FROM IndexInfo;"));
+        if (sql.prepare() != SQLITE_OK)
+            return nullptr;
+
+        int result = sql.step();
+        while (result == SQLITE_ROW) {
+            Vector<uint8_t> keyPathBuffer;
+            sql.getColumnBlobAsVector(3, keyPathBuffer);
+
+            IDBKeyPath keyPath;
+            if (!deserializeIDBKeyPath(keyPathBuffer.data(), keyPathBuffer.size(), keyPath)) {
+                LOG_ERROR("Unable to extract key path for an index from the database");
+                return nullptr;
+            }
+
+            uint64_t objectStoreIdentifier = sql.getColumnInt64(2);
+            auto* objectStoreInfo = databaseInfo->infoForExistingObjectStore(objectStoreIdentifier);
+            if (!objectStoreInfo) {
+                LOG_ERROR("Found an index for an object store that doesn't exist");
+                return nullptr;
+            }
+
+            objectStoreInfo->addExistingIndex(IDBIndexInfo(sql.getColumnInt64(0), objectStoreIdentifier, sql.getColumnText(1), keyPath, sql.getColumnInt(4), sql.getColumnInt(5)));
+            result = sql.step();
+        }
+
+        if (result != SQLITE_DONE)
+            return nullptr;
+    }
+
+    return databaseInfo;
+}
+
+bool SQLiteIDBBackingStore::openDatabase()
+{
+    ASSERT(!m_sqliteDB);
+
+    makeAllDirectories(m_absoluteDatabaseDirectory);
+    String databasePath = SQLiteFileSystem::appendDatabaseFileNameToPath(m_absoluteDatabaseDirectory, databaseFilename());
+
+    // SQLiteDatabase::open() puts the database in write-ahead logging mode. With WAL, a normal sync
+    // level is enough to keep the database consistent and avoids an fsync on every commit.
+    m_sqliteDB = std::make_unique<SQLiteDatabase>();
+    if (!m_sqliteDB->open(databasePath)) {
+        LOG_ERROR("Failed to open IndexedDB database at %s", databasePath.utf8().data());
+        m_sqliteDB = nullptr;
+        return false;
+    }
+    m_sqliteDB->setSynchronous(SQLiteDatabase::SyncNormal);
+
+    m_sqliteDB->setCollationFunction("IDBKEY", [](int aLength, const void* a, int bLength, const void* b) {
+        return idbKeyCollate(aLength, a, bLength, b);
+    });
+
+    if (!createTablesIfNecessary()) {
+        m_sqliteDB = nullptr;
+        return false;
+    }
+
+    return true;
+}
+
+const IDBDatabaseInfo& SQLiteIDBBackingStore::getOrEstablishDatabaseInfo()
+{
+    LOG(IndexedDB, "SQLiteIDBBackingStore::getOrEstablishDatabaseInfo - database %s", m_identifier.databaseName().utf8().data());
+
+    if (m_databaseInfo)
+        return *m_databaseInfo;
+
+    if (openDatabase()) {
+        m_databaseInfo = extractExistingDatabaseInfo();
+        if (!m_databaseInfo)
+            m_databaseInfo = createAndPopulateInitialDatabaseInfo();
+    }
+
+    // If the database couldn't be read, carry on with an empty database; every operation will then fail.
+    if (!m_databaseInfo) {
+        m_cachedStatements.clear();
+        m_sqliteDB = nullptr;
+        m_databaseInfo = std::make_unique<IDBDatabaseInfo>(m_identifier.databaseName(), 0);
+    }
+
+    return *m_databaseInfo;
+}
+
+bool SQLiteIDBBackingStore::setDatabaseVersion(uint64_t version)
+{
+    auto* sql = cachedStatement(ASCIILiteral("INSERT INTO IDBDatabaseInfo VALUES ('DatabaseVersion', ?);"));
+    if (!sql
+        || sql->bindText(1, String::number(version)) != SQLITE_OK
+        || sql->step() != SQLITE_DONE) {
+        LOG_ERROR("Could not update database version (%i) - %s", m_sqliteDB->lastError(), m_sqliteDB->lastErrorMsg());
+        return false;
+    }
+
+    return true;
+}
+
+void SQLiteIDBBackingStore::beginSQLiteTransactionIfNecessary()
+{
+    ASSERT(m_sqliteDB);
+
+    ++m_writeTransactionsInSQLiteTransaction;
+    if (m_sqliteTransaction)
+        return;
+
+    m_sqliteTransaction = std::make_unique<SQLiteTransaction>(*m_sqliteDB);
+    m_sqliteTransaction->begin();
+}
+
+IDBError SQLiteIDBBackingStore::endSQLiteTransactionIfPossible()
+{
+    ASSERT(m_writeTransactionsInSQLiteTransaction);
+
+    if (--m_writeTransactionsInSQLiteTransaction)
+        return { };
+
+    ASSERT(m_sqliteTransaction);
+    auto transaction = WTF::move(m_sqliteTransaction);
+    if (!transaction->inProgress())
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("SQLite transaction was rolled back"));
+
+    transaction->commit();
+    if (transaction->inProgress()) {
+        transaction->rollback();
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to commit SQLite transaction in database backing store"));
+    }
+
+    return { };
+}
+
+IDBError SQLiteIDBBackingStore::beginTransaction(const IDBTransactionInfo& info)
+{
+    LOG(IndexedDB, "SQLiteIDBBackingStore::beginTransaction");
+
+    ASSERT(m_databaseInfo);
+
+    if (!m_sqliteDB)
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("No backing store database to begin transaction in"));
+
+    if (m_transactions.contains(info.identifier()))
+        return IDBError(IDBExceptionCode::InvalidStateError, "Backing store asked to create transaction it already has a record of");
+
+    auto transaction = SQLiteBackingStoreTransaction::create(info, *m_databaseInfo);
+
+    if (transaction->isWriting())
+        beginSQLiteTransactionIfNecessary();
+
+    if (transaction->isVersionChange()) {
+        // Version change transactions run on their own, so nothing else can be sharing the SQLite transaction.
+        ASSERT(m_writeTransactionsInSQLiteTransaction == 1);
+
+        if (!setDatabaseVersion(info.newVersion())) {
+            endSQLiteTransactionIfPossible();
+            return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Failed to store new database version in database"));
+        }
+        m_databaseInfo->setVersion(info.newVersion());
+    }
+
+    m_transactions.set(info.identifier(), WTF::move(transaction));
+
+    return { };
+}
+
+IDBError SQLiteIDBBackingStore::abortTransaction(const IDBResourceIdentifier& transactionIdentifier)
+{
+    LOG(IndexedDB, "SQLiteIDBBackingStore::abortTransaction");
+
+    auto transaction = m_transactions.take(transactionIdentifier);
+    if (!transaction)
+        return IDBError(IDBExceptionCode::InvalidStateError, "Backing store asked to abort transaction it didn't have record of");
+
+    if (transaction->isVersionChange())
+        m_databaseInfo = std::make_unique<IDBDatabaseInfo>(transaction->originalDatabaseInfo());
+
+    if (!transaction->isWriting())
+        return { };
+
+    // When no other write transaction shares the SQLite transaction, rolling it back is the cheapest way to undo everything.
+    if (m_writeTransactionsInSQLiteTransaction == 1) {
+        m_writeTransactionsInSQLiteTransaction = 0;
+        auto sqliteTransaction = WTF::move(m_sqliteTransaction);
+        if (sqliteTransaction->inProgress())
+            sqliteTransaction->rollback();
+        return { };
+    }
+
+    IDBError error = revertTransactionChanges(*transaction);
+    IDBError endError = endSQLiteTransactionIfPossible();
+    return error.isNull() ? endError : error;
+}
+
+IDBError SQLiteIDBBackingStore::commitTransaction(const IDBResourceIdentifier& transactionIdentifier)
+{
+    LOG(IndexedDB, "SQLiteIDBBackingStore::commitTransaction");
+
+    auto transaction = m_transactions.take(transactionIdentifier);
+    if (!transaction)
+        return IDBError(IDBExceptionCode::InvalidStateError, "Backing store asked to commit transaction it didn't have record of");
+
+    if (!transaction->isWriting())
+        return { };
+
+    return endSQLiteTransactionIfPossible();
+}
+
+IDBError SQLiteIDBBackingStore::revertTransactionChanges(SQLiteBackingStoreTransaction& transaction)
+{
+    ASSERT(!transaction.isVersionChange());
+
+    for (auto& objectStoreEntry : transaction.originalValues()) {
+        auto* objectStoreInfo = m_databaseInfo->infoForExistingObjectStore(objectStoreEntry.key);
+        if (!objectStoreInfo)
+            continue;
+
+        for (auto& record : *objectStoreEntry.value) {
+            IDBError error = deleteRecord(objectStoreEntry.key, record.key);
+            if (!error.isNull())
+                return error;
+
+            if (!record.value.data())
+                continue;
+
+            error = insertRecord(objectStoreEntry.key, record.key, record.value);
+            if (error.isNull())
+                error = updateIndexesForPutRecord(*objectStoreInfo, record.key, record.value);
+            if (!error.isNull())
+                return error;
+        }
+    }
+
+    for (auto& keyGenerator : transaction.originalKeyGeneratorValues()) {
+        if (!writeKeyGeneratorValue(keyGenerator.key, keyGenerator.value))
+            return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to restore key generator value while aborting transaction"));
+    }
+
+    return { };
+}
+
+IDBError SQLiteIDBBackingStore::createObjectStore(const IDBResourceIdentifier& transactionIdentifier, const IDBObjectStoreInfo& info)
+{
+    LOG(IndexedDB, "SQLiteIDBBackingStore::createObjectStore - adding OS %s with ID %" PRIu64, info.name().utf8().data(), info.identifier());
+
+    ASSERT(m_databaseInfo);
+    if (m_databaseInfo->hasObjectStore(info.name()))
+        return IDBError(IDBExceptionCode::ConstraintError);
+
+    auto* transaction = m_transactions.get(transactionIdentifier);
+    if (!transaction || !transaction->isVersionChange())
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Attempt to create an object store outside of a version change transaction"));
+
+    RefPtr<SharedBuffer> keyPathBuffer = serializeIDBKeyPath(info.keyPath());
+    if (!keyPathBuffer)
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to serialize IDBKeyPath to create object store"));
+
+    auto* sql = cachedStatement(ASCIILiteral("INSERT INTO ObjectStoreInfo VALUES (?, ?, ?, ?);"));
+    if (!sql
+        || sql->bindInt64(1, info.identifier()) != SQLITE_OK
+        || sql->bindText(2, info.name()) != SQLITE_OK
+        || sql->bindBlob(3, keyPathBuffer->data(), keyPathBuffer->size()) != SQLITE_OK
+        || sql->bindInt(4, info.autoIncrement()) != SQLITE_OK
+        || sql->step() != SQLITE_DONE) {
+        LOG_ERROR("Could not add object store '%s' to ObjectStoreInfo table (%i) - %s", info.name().utf8().data(), m_sqliteDB->lastError(), m_sqliteDB->lastErrorMsg());
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Could not create object store"));
+    }
+
+    if (!writeKeyGeneratorValue(info.identifier(), initialKeyGeneratorValue))
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Could not seed key generator for object store"));
+
+    m_databaseInfo->addExistingObjectStore(info);
+
+    return { };
+}
+
+IDBError SQLiteIDBBackingStore::deleteObjectStore(const IDBResourceIdentifier& transactionIdentifier, const String& objectStoreName)
+{
+    LOG(IndexedDB, "SQLiteIDBBackingStore::deleteObjectStore - %s", objectStoreName.utf8().data());
+
+    ASSERT(m_databaseInfo);
+    auto* objectStoreInfo = m_databaseInfo->infoForExistingObjectStore(objectStoreName);
+    if (!objectStoreInfo)
+        return IDBError(IDBExceptionCode::ConstraintError);
+
+    auto* transaction = m_transactions.get(transactionIdentifier);
+    if (!transaction || !transaction->isVersionChange())
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Attempt to delete an object store outside of a version change transaction"));
+
+    static const char* const deleteCommands[] = {
+        "DELETE FROM ObjectStoreInfo WHERE id = ?;",
+        "DELETE FROM KeyGenerators WHERE objectStoreID = ?;",
+        "DELETE FROM Records WHERE objectStoreID = ?;",
+        "DELETE FROM IndexInfo WHERE objectStoreID = ?;",
+        "DELETE FROM IndexRecords WHERE objectStoreID = ?;",
+    };
+
+    uint64_t objectStoreIdentifier = objectStoreInfo->identifier();
+    for (auto* command : deleteCommands) {
+        auto* sql = cachedStatement(command);
+        if (!sql
+            || sql->bindInt64(1, objectStoreIdentifier) != SQLITE_OK
+            || sql->step() != SQLITE_DONE) {
+            LOG_ERROR("Could not delete object store (%i) - %s", m_sqliteDB->lastError(), m_sqliteDB->lastErrorMsg());
+            return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Could not delete object store"));
+        }
+    }
+
+    m_databaseInfo->deleteObjectStore(objectStoreName);
+
+    return { };
+}
+
+IDBError SQLiteIDBBackingStore::clearObjectStore(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier)
+{
+    LOG(IndexedDB, "SQLiteIDBBackingStore::clearObjectStore - %" PRIu64, objectStoreIdentifier);
+
+    ASSERT(objectStoreIdentifier);
+
+    auto* transaction = m_transactions.get(transactionIdentifier);
+    if (!transaction || !transaction->isWriting())
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("No writing backing store transaction found to clear object store"));
+
+    if (!m_databaseInfo->infoForExistingObjectStore(objectStoreIdentifier))
+        return IDBError(IDBExceptionCode::ConstraintError);
+
+    // Version change transactions are undone by rolling back, so only other writers need to remember what is cleared.
+    if (!transaction->isVersionChange()) {
+        auto* sql = cachedStatement(ASCIILiteral("SELECT key, value FROM Records WHERE objectStoreID = ?;"));
+        if (!sql || sql->bindInt64(1, objectStoreIdentifier) != SQLITE_OK)
+            return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to read records to clear object store"));
+
+        int result = sql->step();
+        while (result == SQLITE_ROW) {
+            IDBKeyData key;
+            if (!columnAsKey(*sql, 0, key))
+                return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to deserialize key while clearing object store"));
+            if (!transaction->hasOriginalValue(objectStoreIdentifier, key))
+                transaction->recordOriginalValue(objectStoreIdentifier, key, columnAsValue(*sql, 1));
+            result = sql->step();
+        }
+
+        if (result != SQLITE_DONE)
+            return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to read records to clear object store"));
+    }
+
+    static const char* const clearCommands[] = {
+        "DELETE FROM Records WHERE objectStoreID = ?;",
+        "DELETE FROM IndexRecords WHERE objectStoreID = ?;",
+    };
+
+    for (auto* command : clearCommands) {
+        auto* sql = cachedStatement(command);
+        if (!sql
+            || sql->bindInt64(1, objectStoreIdentifier) != SQLITE_OK
+            || sql->step() != SQLITE_DONE) {
+            LOG_ERROR("Could not clear object store (%i) - %s", m_sqliteDB->lastError(), m_sqliteDB->lastErrorMsg());
+            return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to clear object store"));
+        }
+    }
+
+    return { };
+}
+
+IDBError SQLiteIDBBackingStore::createIndex(const IDBResourceIdentifier& transactionIdentifier, const IDBIndexInfo& info)
+{
+    LOG(IndexedDB, "SQLiteIDBBackingStore::createIndex - %s", info.name().utf8().data());
+
+    auto* transaction = m_transactions.get(transactionIdentifier);
+    if (!transaction || !transaction->isVersionChange())
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Attempt to create an index outside of a version change transaction"));
+
+    auto* objectStoreInfo = m_databaseInfo->infoForExistingObjectStore(info.objectStoreIdentifier());
+    if (!objectStoreInfo)
+        return IDBError(IDBExceptionCode::ConstraintError);
+
+    RefPtr<SharedBuffer> keyPathBuffer = serializeIDBKeyPath(info.keyPath());
+    if (!keyPathBuffer)
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to serialize IDBKeyPath to create index"));
+
+    auto* sql = cachedStatement(ASCIILiteral("INSERT INTO IndexInfo VALUES (?, ?, ?, ?, ?, ?);"));
+    if (!sql
+        || sql->bindInt64(1, info.identifier()) != SQLITE_OK
+        || sql->bindText(2, info.name()) != SQLITE_OK
+        || sql->bindInt64(3, info.objectStoreIdentifier()) != SQLITE_OK
+        || sql->bindBlob(4, keyPathBuffer->data(), keyPathBuffer->size()) != SQLITE_OK
+        || sql->bindInt(5, info.unique()) != SQLITE_OK
+        || sql->bindInt(6, info.multiEntry()) != SQLITE_OK
+        || sql->step() != SQLITE_DONE) {
+        LOG_ERROR("Could not add index '%s' to IndexInfo table (%i) - %s", info.name().utf8().data(), m_sqliteDB->lastError(), m_sqliteDB->lastErrorMsg());
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to create index in database"));
+    }
+
+    // Index the records the object store already has. Collect them first, since indexing a record
+    // reuses cached statements that may also be needed to walk the Records table.
+    Vector<std::pair<IDBKeyData, ThreadSafeDataBuffer>> existingRecords;
+    {
+        auto* recordsSQL = cachedStatement(ASCIILiteral("SELECT key, value FROM Records WHERE objectStoreID = ?;"));
+        if (!recordsSQL || recordsSQL->bindInt64(1, info.objectStoreIdentifier()) != SQLITE_OK)
+            return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to read records to populate new index"));
+
+        int result = recordsSQL->step();
+        while (result == SQLITE_ROW) {
+            IDBKeyData key;
+            if (!columnAsKey(*recordsSQL, 0, key))
+                return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to deserialize key while populating new index"));
+            existingRecords.append(std::make_pair(key, columnAsValue(*recordsSQL, 1)));
+            result = recordsSQL->step();
+        }
+
+        if (result != SQLITE_DONE)
+            return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to read records to populate new index"));
+    }
+
+    if (!existingRecords.isEmpty()) {
+        JSLockHolder locker(databaseThreadVM());
+
+        for (auto& record : existingRecords) {
+            auto jsValue = idbValueDataToJSValue(databaseThreadExecState(), record.second);
+            if (jsValue.isUndefinedOrNull())
+                continue;
+
+            IndexKey indexKey;
+            generateIndexKeyForValue(databaseThreadExecState(), info, jsValue, indexKey);
+            if (indexKey.isNull())
+                continue;
+
+            // The transaction is rolled back if index creation fails, so there is nothing to clean up here.
+            IDBError error = putIndexKey(info, record.first, indexKey);
+            if (!error.isNull())
+                return error;
+        }
+    }
+
+    objectStoreInfo->addExistingIndex(info);
+
+    return { };
+}
+
+bool SQLiteIDBBackingStore::recordInRange(uint64_t objectStoreIdentifier, const IDBKeyRangeData& range, IDBKeyData* outKey, ThreadSafeDataBuffer* outValue)
+{
+    SQLiteStatement* sql;
+    if (range.isExactlyOneKey()) {
+        sql = cachedStatement(ASCIILiteral("SELECT key, value FROM Records WHERE objectStoreID = ? AND key = CAST(? AS TEXT);"));
+        if (!sql
+            || sql->bindInt64(1, objectStoreIdentifier) != SQLITE_OK
+            || bindKey(*sql, 2, range.lowerKey) != SQLITE_OK)
+            return false;
+    } else {
+        StringBuilder builder;
+        builder.appendLiteral("SELECT key, value FROM Records WHERE objectStoreID = ?");
+        appendKeyRangeCondition(builder, range);
+        builder.appendLiteral(" ORDER BY key LIMIT 1;");
+
+        sql = cachedStatement(builder.toString());
+        if (!sql
+            || sql->bindInt64(1, objectStoreIdentifier) != SQLITE_OK
+            || bindKeyRange(*sql, 2, range) != SQLITE_OK)
+            return false;
+    }
+
+    if (sql->step() != SQLITE_ROW)
+        return false;
+
+    if (outKey && !columnAsKey(*sql, 0, *outKey))
+        return false;
+    if (outValue)
+        *outValue = columnAsValue(*sql, 1);
+
+    return true;
+}
+
+bool SQLiteIDBBackingStore::indexRecordInRange(uint64_t objectStoreIdentifier, uint64_t indexIdentifier, const IDBKeyRangeData& range, IDBKeyData& outPrimaryKey)
+{
+    StringBuilder builder;
+    builder.appendLiteral("SELECT value FROM IndexRecords WHERE objectStoreID = ? AND indexID = ?");
+    appendKeyRangeCondition(builder, range);
+    builder.appendLiteral(" ORDER BY key, value LIMIT 1;");
+
+    auto* sql = cachedStatement(builder.toString());
+    if (!sql
+        || sql->bindInt64(1, objectStoreIdentifier) != SQLITE_OK
+        || sql->bindInt64(2, indexIdentifier) != SQLITE_OK
+        || bindKeyRange(*sql, 3, range) != SQLITE_OK
+        || sql->step() != SQLITE_ROW)
+        return false;
+
+    return columnAsKey(*sql, 0, outPrimaryKey);
+}
+
+IDBError SQLiteIDBBackingStore::keyExistsInObjectStore(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier, const IDBKeyData& keyData, bool& keyExists)
+{
+    LOG(IndexedDB, "SQLiteIDBBackingStore::keyExistsInObjectStore");
+
+    ASSERT(objectStoreIdentifier);
+    keyExists = false;
+
+    if (!m_transactions.contains(transactionIdentifier))
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("No backing store transaction found to check for key existence"));
+
+    auto* sql = cachedStatement(ASCIILiteral("SELECT 1 FROM Records WHERE objectStoreID = ? AND key = CAST(? AS TEXT) LIMIT 1;"));
+    if (!sql
+        || sql->bindInt64(1, objectStoreIdentifier) != SQLITE_OK
+        || bindKey(*sql, 2, keyData) != SQLITE_OK)
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to check for key existence in object store"));
+
+    int result = sql->step();
+    if (result == SQLITE_ROW)
+        keyExists = true;
+    else if (result != SQLITE_DONE)
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to check for key existence in object store"));
+
+    return { };
+}
+
+IDBError SQLiteIDBBackingStore::deleteRecord(uint64_t objectStoreIdentifier, const IDBKeyData& key)
+{
+    RefPtr<SharedBuffer> keyBuffer = serializeIDBKeyData(key);
+
+    static const char* const deleteCommands[] = {
+        "DELETE FROM Records WHERE objectStoreID = ? AND key = CAST(? AS TEXT);",
+        "DELETE FROM IndexRecords WHERE objectStoreID = ? AND value = CAST(? AS TEXT);",
+    };
+
+    for (auto* command : deleteCommands) {
+        auto* sql = cachedStatement(command);
+        if (!sql
+            || sql->bindInt64(1, objectStoreIdentifier) != SQLITE_OK
+            || sql->bindBlob(2, keyBuffer->data(), keyBuffer->size()) != SQLITE_OK
+            || sql->step() != SQLITE_DONE) {
+            LOG_ERROR("Could not delete record (%i) - %s", m_sqliteDB->lastError(), m_sqliteDB->lastErrorMsg());
+            return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to delete record from object store"));
+        }
+    }
+
+    return { };
+}
+
+IDBError SQLiteIDBBackingStore::deleteRange(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier, const IDBKeyRangeData& range)
+{
+    LOG(IndexedDB, "SQLiteIDBBackingStore::deleteRange");
+
+    ASSERT(objectStoreIdentifier);
+
+    auto* transaction = m_transactions.get(transactionIdentifier);
+    if (!transaction || !transaction->isWriting())
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("No backing store transaction found to delete from"));
+
+    // Collect the doomed records first; their values are only needed when this transaction might have to undo the deletion.
+    bool needsOriginalValues = !transaction->isVersionChange();
+    Vector<IDBKeyData> keys;
+
+    if (range.isExactlyOneKey()) {
+        ThreadSafeDataBuffer value;
+        if (!recordInRange(objectStoreIdentifier, range, nullptr, needsOriginalValues ? &value : nullptr))
+            return { };
+        if (needsOriginalValues && !transaction->hasOriginalValue(objectStoreIdentifier, range.lowerKey))
+            transaction->recordOriginalValue(objectStoreIdentifier, range.lowerKey, value);
+        keys.append(range.lowerKey);
+    } else {
+        StringBuilder builder;
+        builder.appendLiteral("SELECT key, value FROM Records WHERE objectStoreID = ?");
+        appendKeyRangeCondition(builder, range);
+        builder.appendLiteral(" ORDER BY key;");
+
+        auto* sql = cachedStatement(builder.toString());
+        if (!sql
+            || sql->bindInt64(1, objectStoreIdentifier) != SQLITE_OK
+            || bindKeyRange(*sql, 2, range) != SQLITE_OK)
+            return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to find records to delete"));
+
+        int result = sql->step();
+        while (result == SQLITE_ROW) {
+            IDBKeyData key;
+            if (!columnAsKey(*sql, 0, key))
+                return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to deserialize key of record to delete"));
+            if (needsOriginalValues && !transaction->hasOriginalValue(objectStoreIdentifier, key))
+                transaction->recordOriginalValue(objectStoreIdentifier, key, columnAsValue(*sql, 1));
+            keys.append(key);
+            result = sql->step();
+        }
+
+        if (result != SQLITE_DONE)
+            return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to find records to delete"));
+    }
+
+    for (auto& key : keys) {
+        IDBError error = deleteRecord(objectStoreIdentifier, key);
+        if (!error.isNull())
+            return error;
+    }
+
+    return { };
+}
+
+IDBError SQLiteIDBBackingStore::insertRecord(uint64_t objectStoreIdentifier, const IDBKeyData& key, const ThreadSafeDataBuffer& value)
+{
+    auto* sql = cachedStatement(ASCIILiteral("INSERT INTO Records VALUES (?, CAST(? AS TEXT), ?);"));
+    if (!sql
+        || sql->bindInt64(1, objectStoreIdentifier) != SQLITE_OK
+        || bindKey(*sql, 2, key) != SQLITE_OK
+        || !bindValue(*sql, 3, value)
+        || sql->step() != SQLITE_DONE) {
+        LOG_ERROR("Could not put record (%i) - %s", m_sqliteDB->lastError(), m_sqliteDB->lastErrorMsg());
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to store record in object store"));
+    }
+
+    return { };
+}
+
+IDBError SQLiteIDBBackingStore::uncheckedPutIndexRecord(const IDBIndexInfo& info, const IDBKeyData& indexKey, const IDBKeyData& primaryKey)
+{
+    auto* sql = cachedStatement(ASCIILiteral("INSERT INTO IndexRecords VALUES (?, ?, CAST(? AS TEXT), CAST(? AS TEXT));"));
+    if (!sql
+        || sql->bindInt64(1, info.identifier()) != SQLITE_OK
+        || sql->bindInt64(2, info.objectStoreIdentifier()) != SQLITE_OK
+        || bindKey(*sql, 3, indexKey) != SQLITE_OK
+        || bindKey(*sql, 4, primaryKey) != SQLITE_OK
+        || sql->step() != SQLITE_DONE) {
+        LOG_ERROR("Could not put index record (%i) - %s", m_sqliteDB->lastError(), m_sqliteDB->lastErrorMsg());
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to store index record"));
+    }
+
+    return { };
+}
+
+IDBError SQLiteIDBBackingStore::putIndexKey(const IDBIndexInfo& info, const IDBKeyData& primaryKey, const IndexKey& indexKey)
+{
+    Vector<IDBKeyData> keys;
+    if (info.multiEntry())
+        keys = indexKey.multiEntry();
+    else
+        keys.append(indexKey.asOneKey());
+
+    if (info.unique()) {
+        for (auto& key : keys) {
+            IDBKeyData existingPrimaryKey;
+            if (indexRecordInRange(info.objectStoreIdentifier(), info.identifier(), IDBKeyRangeData(key), existingPrimaryKey))
+                return IDBError(IDBExceptionCode::ConstraintError);
+        }
+    }
+
+    for (auto& key : keys) {
+        IDBError error = uncheckedPutIndexRecord(info, key, primaryKey);
+        if (!error.isNull())
+            return error;
+    }
+
+    return { };
+}
+
+IDBError SQLiteIDBBackingStore::updateIndexesForPutRecord(const IDBObjectStoreInfo& objectStoreInfo, const IDBKeyData& key, const ThreadSafeDataBuffer& value)
+{
+    if (objectStoreInfo.indexMap().isEmpty())
+        return { };
+
+    JSLockHolder locker(databaseThreadVM());
+
+    auto jsValue = idbValueDataToJSValue(databaseThreadExecState(), value);
+    if (jsValue.isUndefinedOrNull())
+        return { };
+
+    for (auto& info : objectStoreInfo.indexMap().values()) {
+        IndexKey indexKey;
+        generateIndexKeyForValue(databaseThreadExecState(), info, jsValue, indexKey);
+
+        if (indexKey.isNull())
+            continue;
+
+        IDBError error = putIndexKey(info, key, indexKey);
+        if (!error.isNull())
+            return error;
+    }
+
+    return { };
+}
+
+IDBError SQLiteIDBBackingStore::addRecord(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier, const IDBKeyData& keyData, const ThreadSafeDataBuffer& value)
+{
+    LOG(IndexedDB, "SQLiteIDBBackingStore::addRecord");
+
+    ASSERT(objectStoreIdentifier);
+
+    auto* transaction = m_transactions.get(transactionIdentifier);
+    if (!transaction || !transaction->isWriting())
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("No backing store transaction found to put record"));
+
+    auto* objectStoreInfo = m_databaseInfo->infoForExistingObjectStore(objectStoreIdentifier);
+    if (!objectStoreInfo)
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("No backing store object store found to put record"));
+
+    // The caller has either checked that the key is unused or deleted its previous record (which
+    // recorded the original value), so if nothing is recorded yet there was no record before.
+    if (!transaction->isVersionChange() && !transaction->hasOriginalValue(objectStoreIdentifier, keyData))
+        transaction->recordOriginalValue(objectStoreIdentifier, keyData, ThreadSafeDataBuffer());
+
+    IDBError error = insertRecord(objectStoreIdentifier, keyData, value);
+    if (!error.isNull())
+        return error;
+
+    // If there was an error indexing this addition, then revert it.
+    error = updateIndexesForPutRecord(*objectStoreInfo, keyData, value);
+    if (!error.isNull())
+        deleteRecord(objectStoreIdentifier, keyData);
+
+    return error;
+}
+
+IDBError SQLiteIDBBackingStore::getRecord(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier, const IDBKeyRangeData& range, ThreadSafeDataBuffer& outValue)
+{
+    LOG(IndexedDB, "SQLiteIDBBackingStore::getRecord");
+
+    ASSERT(objectStoreIdentifier);
+
+    if (!m_transactions.contains(transactionIdentifier))
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("No backing store transaction found to get record"));
+
+    if (!recordInRange(objectStoreIdentifier, range, nullptr, &outValue))
+        outValue = ThreadSafeDataBuffer();
+
+    return { };
+}
+
+IDBError SQLiteIDBBackingStore::getIndexRecord(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier, uint64_t indexIdentifier, IndexedDB::IndexRecordType recordType, const IDBKeyRangeData& range, IDBGetResult& outValue)
+{
+    LOG(IndexedDB, "SQLiteIDBBackingStore::getIndexRecord");
+
+    ASSERT(objectStoreIdentifier);
+
+    if (!m_transactions.contains(transactionIdentifier))
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("No backing store transaction found to get record"));
+
+    IDBKeyData primaryKey;
+    if (!indexRecordInRange(objectStoreIdentifier, indexIdentifier, range, primaryKey)) {
+        outValue = { };
+        return { };
+    }
+
+    if (recordType == IndexedDB::IndexRecordType::Key) {
+        outValue = IDBGetResult(primaryKey);
+        return { };
+    }
+
+    ThreadSafeDataBuffer value;
+    recordInRange(objectStoreIdentifier, IDBKeyRangeData(primaryKey), nullptr, &value);
+    outValue = IDBGetResult(value);
+
+    return { };
+}
+
+IDBError SQLiteIDBBackingStore::getCount(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier, uint64_t indexIdentifier, const IDBKeyRangeData& range, uint64_t& outCount)
+{
+    LOG(IndexedDB, "SQLiteIDBBackingStore::getCount");
+
+    ASSERT(objectStoreIdentifier);
+    outCount = 0;
+
+    if (!m_transactions.contains(transactionIdentifier))
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("No backing store transaction found to get count"));
+
+    StringBuilder builder;
+    if (indexIdentifier)
+        builder.appendLiteral("SELECT COUNT(*) FROM IndexRecords WHERE objectStoreID = ? AND indexID = ?");
+    else
+        builder.appendLiteral("SELECT COUNT(*) FROM Records WHERE objectStoreID = ?");
+    appendKeyRangeCondition(builder, range);
+    builder.append(';');
+
+    auto* sql = cachedStatement(builder.toString());
+    if (!sql || sql->bindInt64(1, objectStoreIdentifier) != SQLITE_OK)
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to count records"));
+
+    int nextParameter = 2;
+    if (indexIdentifier && sql->bindInt64(nextParameter++, indexIdentifier) != SQLITE_OK)
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to count records"));
+
+    if (bindKeyRange(*sql, nextParameter, range) != SQLITE_OK || sql->step() != SQLITE_ROW)
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to count records"));
+
+    outCount = sql->getColumnInt64(0);
+    return { };
+}
+
+bool SQLiteIDBBackingStore::readKeyGeneratorValue(uint64_t objectStoreIdentifier, uint64_t& value)
+{
+    auto* sql = cachedStatement(ASCIILiteral("SELECT currentKey FROM KeyGenerators WHERE objectStoreID = ?;"));
+    if (!sql
+        || sql->bindInt64(1, objectStoreIdentifier) != SQLITE_OK
+        || sql->step() != SQLITE_ROW)
+        return false;
+
+    value = sql->getColumnInt64(0);
+    return true;
+}
+
+bool SQLiteIDBBackingStore::writeKeyGeneratorValue(uint64_t objectStoreIdentifier, uint64_t value)
+{
+    auto* sql = cachedStatement(ASCIILiteral("INSERT INTO KeyGenerators VALUES (?, ?);"));
+    if (!sql
+        || sql->bindInt64(1, objectStoreIdentifier) != SQLITE_OK
+        || sql->bindInt64(2, value) != SQLITE_OK
+        || sql->step() != SQLITE_DONE) {
+        LOG_ERROR("Could not update key generator value (%i) - %s", m_sqliteDB->lastError(), m_sqliteDB->lastErrorMsg());
+        return false;
+    }
+
+    return true;
+}
+
+IDBError SQLiteIDBBackingStore::generateKeyNumber(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier, uint64_t& keyNumber)
+{
+    LOG(IndexedDB, "SQLiteIDBBackingStore::generateKeyNumber");
+
+    ASSERT(objectStoreIdentifier);
+
+    auto* transaction = m_transactions.get(transactionIdentifier);
+    if (!transaction || !transaction->isWriting())
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("No writing backing store transaction found to generate key"));
+
+    if (!readKeyGeneratorValue(objectStoreIdentifier, keyNumber))
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to read key generator value"));
+
+    if (!transaction->isVersionChange())
+        transaction->recordOriginalKeyGeneratorValue(objectStoreIdentifier, keyNumber);
+
+    if (!writeKeyGeneratorValue(objectStoreIdentifier, keyNumber + 1))
+        return IDBError(IDBExceptionCode::Unknown, WTF::ASCIILiteral("Unable to update key generator value"));
+
+    return { };
+}
+
+} // namespace IDBServer
+} // namespace WebCore
+
+#endif // ENABLE(INDEXED_DATABASE)
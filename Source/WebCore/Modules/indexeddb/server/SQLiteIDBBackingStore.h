@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SQLiteIDBBackingStore_h
+#define SQLiteIDBBackingStore_h
+
+#if ENABLE(INDEXED_DATABASE)
+
+#include "IDBBackingStore.h"
+#include "IDBDatabaseIdentifier.h"
+#include "IDBResourceIdentifier.h"
+#include "SQLiteBackingStoreTransaction.h"
+#include <wtf/HashMap.h>
+#include <wtf/text/StringHash.h>
+
+namespace WebCore {
+
+class IndexKey;
+class SQLiteDatabase;
+class SQLiteStatement;
+class SQLiteTransaction;
+
+namespace IDBServer {
+
+class SQLiteIDBBackingStore : public IDBBackingStore {
+    friend std::unique_ptr<SQLiteIDBBackingStore> std::make_unique<SQLiteIDBBackingStore>(const WebCore::IDBDatabaseIdentifier&, const WTF::String&);
+public:
+    static std::unique_ptr<SQLiteIDBBackingStore> create(const IDBDatabaseIdentifier&, const String& databaseRootDirectory);
+
+    virtual ~SQLiteIDBBackingStore() override final;
+
+    virtual const IDBDatabaseInfo& getOrEstablishDatabaseInfo() override final;
+
+    virtual IDBError beginTransaction(const IDBTransactionInfo&) override final;
+    virtual IDBError abortTransaction(const IDBResourceIdentifier& transactionIdentifier) override final;
+    virtual IDBError commitTransaction(const IDBResourceIdentifier& transactionIdentifier) override final;
+    virtual IDBError createObjectStore(const IDBResourceIdentifier& transactionIdentifier, const IDBObjectStoreInfo&) override final;
+    virtual IDBError deleteObjectStore(const IDBResourceIdentifier& transactionIdentifier, const String& objectStoreName) override final;
+    virtual IDBError clearObjectStore(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier) override final;
+    virtual IDBError createIndex(const IDBResourceIdentifier& transactionIdentifier, const IDBIndexInfo&) override final;
+    virtual IDBError keyExistsInObjectStore(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier, const IDBKeyData&, bool& keyExists) override final;
+    virtual IDBError deleteRange(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier, const IDBKeyRangeData&) override final;
+    virtual IDBError addRecord(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier, const IDBKeyData&, const ThreadSafeDataBuffer& value) override final;
+    virtual IDBError getRecord(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier, const IDBKeyRangeData&, ThreadSafeDataBuffer& outValue) override final;
+    virtual IDBError getIndexRecord(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier, uint64_t indexIdentifier, IndexedDB::IndexRecordType, const IDBKeyRangeData&, IDBGetResult& outValue) override final;
+    virtual IDBError getCount(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier, uint64_t indexIdentifier, const IDBKeyRangeData&, uint64_t& outCount) override final;
+    virtual IDBError generateKeyNumber(const IDBResourceIdentifier& transactionIdentifier, uint64_t objectStoreIdentifier, uint64_t& keyNumber) override final;
+
+private:
+    SQLiteIDBBackingStore(const IDBDatabaseIdentifier&, const String& databaseRootDirectory);
+
+    bool openDatabase();
+    bool createTablesIfNecessary();
+    std::unique_ptr<IDBDatabaseInfo> extractExistingDatabaseInfo();
+    std::unique_ptr<IDBDatabaseInfo> createAndPopulateInitialDatabaseInfo();
+    bool setDatabaseVersion(uint64_t);
+
+    // Statements are prepared the first time a query is used and then kept for the lifetime of the
+    // database. The returned statement has been reset and is ready to have its parameters bound.
+    SQLiteStatement* cachedStatement(const String& query);
+
+    bool recordInRange(uint64_t objectStoreIdentifier, const IDBKeyRangeData&, IDBKeyData* outKey, ThreadSafeDataBuffer* outValue);
+    bool indexRecordInRange(uint64_t objectStoreIdentifier, uint64_t indexIdentifier, const IDBKeyRangeData&, IDBKeyData& outPrimaryKey);
+
+    IDBError insertRecord(uint64_t objectStoreIdentifier, const IDBKeyData&, const ThreadSafeDataBuffer& value);
+    IDBError deleteRecord(uint64_t objectStoreIdentifier, const IDBKeyData&);
+    IDBError updateIndexesForPutRecord(const IDBObjectStoreInfo&, const IDBKeyData&, const ThreadSafeDataBuffer& value);
+    IDBError putIndexKey(const IDBIndexInfo&, const IDBKeyData& primaryKey, const IndexKey&);
+    IDBError uncheckedPutIndexRecord(const IDBIndexInfo&, const IDBKeyData& indexKey, const IDBKeyData& primaryKey);
+
+    bool readKeyGeneratorValue(uint64_t objectStoreIdentifier, uint64_t& value);
+    bool writeKeyGeneratorValue(uint64_t objectStoreIdentifier, uint64_t value);
+
+    void beginSQLiteTransactionIfNecessary();
+    IDBError endSQLiteTransactionIfPossible();
+    IDBError revertTransactionChanges(SQLiteBackingStoreTransaction&);
+
+    IDBDatabaseIdentifier m_identifier;
+    String m_absoluteDatabaseDirectory;
+
+    std::unique_ptr<IDBDatabaseInfo> m_databaseInfo;
+    std::unique_ptr<SQLiteDatabase> m_sqliteDB;
+    HashMap<String, std::unique_ptr<SQLiteStatement>> m_cachedStatements;
+
+    HashMap<IDBResourceIdentifier, std::unique_ptr<SQLiteBackingStoreTransaction>> m_transactions;
+
+    // All write transactions in progress run inside this one SQLite transaction, which is committed
+    // once the last of them finishes, batching their writes into a single commit.
+    std::unique_ptr<SQLiteTransaction> m_sqliteTransaction;
+    unsigned m_writeTransactionsInSQLiteTransaction { 0 };
+};
+
+} // namespace IDBServer
+} // namespace WebCore
+
+#endif // ENABLE(INDEXED_DATABASE)
+#endif // SQLiteIDBBackingStore_h
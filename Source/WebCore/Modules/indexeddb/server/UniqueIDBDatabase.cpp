@@ -671,6 +671,16 @@ void UniqueIDBDatabase::invokeTransactionScheduler()
         m_transactionSchedulingTimer.startOneShot(0);
 }
 
+template<typename T> bool scopesOverlap(const T& aScopes, const Vector<uint64_t>& bScopes)
+{
+    for (auto scope : bScopes) {
+        if (aScopes.contains(scope))
+            return true;
+    }
+
+    return false;
+}
+
 void UniqueIDBDatabase::transactionSchedulingTimerFired()
 {
     LOG(IndexedDB, "(main) UniqueIDBDatabase::transactionSchedulingTimerFired");
@@ -682,20 +692,60 @@ void UniqueIDBDatabase::transactionSchedulingTimerFired()
         }
     }
 
-    bool hadDeferredTransactions = false;
-    auto transaction = takeNextRunnableTransaction(hadDeferredTransactions);
+    // Start every queued transaction that is compatible with both the running transactions and the
+    // ones that have to keep waiting ahead of it, rather than stopping at the first one that must wait.
+    Deque<RefPtr<UniqueIDBDatabaseTransaction>> waitingTransactions;
+    HashSet<uint64_t> scopesWaitingToRead;
+    HashSet<uint64_t> scopesWaitingToWrite;
+
+    while (!m_pendingTransactions.isEmpty()) {
+        auto transaction = m_pendingTransactions.takeFirst();
+
+        if (isTransactionRunnable(*transaction, scopesWaitingToRead, scopesWaitingToWrite)) {
+            startTransaction(transaction.releaseNonNull());
+            continue;
+        }
 
-    if (transaction) {
-        m_inProgressTransactions.set(transaction->info().identifier(), transaction);
+        auto& scopesWaiting = transaction->info().mode() == IndexedDB::TransactionMode::ReadOnly ? scopesWaitingToRead : scopesWaitingToWrite;
         for (auto objectStore : transaction->objectStoreIdentifiers())
-            m_objectStoreTransactionCounts.add(objectStore);
+            scopesWaiting.add(objectStore);
+
+        waitingTransactions.append(WTF::move(transaction));
+    }
+
+    m_pendingTransactions = WTF::move(waitingTransactions);
+}
+
+bool UniqueIDBDatabase::isTransactionRunnable(UniqueIDBDatabaseTransaction& transaction, const HashSet<uint64_t>& scopesWaitingToRead, const HashSet<uint64_t>& scopesWaitingToWrite)
+{
+    auto& scopes = transaction.objectStoreIdentifiers();
 
-        activateTransactionInBackingStore(*transaction);
+    switch (transaction.info().mode()) {
+    case IndexedDB::TransactionMode::ReadOnly:
+        // Readers only have to wait for writers, whether those are running or were queued ahead of them.
+        return !scopesOverlap(m_objectStoreWriteTransactionCounts, scopes) && !scopesOverlap(scopesWaitingToWrite, scopes);
+    case IndexedDB::TransactionMode::ReadWrite:
+        // Writers need their object stores to themselves, and may not overtake anything queued ahead of them on those stores.
+        return !scopesOverlap(m_objectStoreTransactionCounts, scopes) && !scopesOverlap(scopesWaitingToRead, scopes) && !scopesOverlap(scopesWaitingToWrite, scopes);
+    case IndexedDB::TransactionMode::VersionChange:
+        // Version change transactions should never be scheduled in the traditional manner.
+        RELEASE_ASSERT_NOT_REACHED();
+    }
+
+    RELEASE_ASSERT_NOT_REACHED();
+}
 
-        // If no transactions were deferred, it's possible we can start another transaction right now.
-        if (!hadDeferredTransactions)
-            invokeTransactionScheduler();
+void UniqueIDBDatabase::startTransaction(Ref<UniqueIDBDatabaseTransaction>&& transaction)
+{
+    bool isWriting = transaction->info().mode() != IndexedDB::TransactionMode::ReadOnly;
+    for (auto objectStore : transaction->objectStoreIdentifiers()) {
+        m_objectStoreTransactionCounts.add(objectStore);
+        if (isWriting)
+            m_objectStoreWriteTransactionCounts.add(objectStore);
     }
+
+    m_inProgressTransactions.set(transaction->info().identifier(), transaction.ptr());
+    activateTransactionInBackingStore(transaction.get());
 }
 
 void UniqueIDBDatabase::activateTransactionInBackingStore(UniqueIDBDatabaseTransaction& transaction)
@@ -730,62 +780,6 @@ void UniqueIDBDatabase::didPerformActivateTransactionInBackingStore(uint64_t cal
     performErrorCallback(callbackIdentifier, error);
 }
 
-template<typename T> bool scopesOverlap(const T& aScopes, const Vector<uint64_t>& bScopes)
-{
-    for (auto scope : bScopes) {
-        if (aScopes.contains(scope))
-            return true;
-    }
-
-    return false;
-}
-
-RefPtr<UniqueIDBDatabaseTransaction> UniqueIDBDatabase::takeNextRunnableTransaction(bool& hadDeferredTransactions)
-{
-    Deque<RefPtr<UniqueIDBDatabaseTransaction>> deferredTransactions;
-    RefPtr<UniqueIDBDatabaseTransaction> currentTransaction;
-
-    while (!m_pendingTransactions.isEmpty()) {
-        currentTransaction = m_pendingTransactions.takeFirst();
-
-        switch (currentTransaction->info().mode()) {
-        case IndexedDB::TransactionMode::ReadOnly:
-            // If there are any deferred transactions, the first one is a read-write transaction we need to unblock.
-            // Therefore, skip this read-only transaction if its scope overlaps with that read-write transaction.
-            if (!deferredTransactions.isEmpty()) {
-                ASSERT(deferredTransactions.first()->info().mode() == IndexedDB::TransactionMode::ReadWrite);
-                if (scopesOverlap(deferredTransactions.first()->objectStoreIdentifiers(), currentTransaction->objectStoreIdentifiers()))
-                    deferredTransactions.append(WTF::move(currentTransaction));
-            }
-
-            break;
-        case IndexedDB::TransactionMode::ReadWrite:
-            // If this read-write transaction's scope overlaps with running transactions, it must be deferred.
-            if (scopesOverlap(m_objectStoreTransactionCounts, currentTransaction->objectStoreIdentifiers()))
-                deferredTransactions.append(WTF::move(currentTransaction));
-
-            break;
-        case IndexedDB::TransactionMode::VersionChange:
-            // Version change transactions should never be scheduled in the traditional manner.
-            RELEASE_ASSERT_NOT_REACHED();
-        }
-
-        // If we didn't defer the currentTransaction above, it can be run now.
-        if (currentTransaction)
-            break;
-    }
-
-    hadDeferredTransactions = !deferredTransactions.isEmpty();
-    if (!hadDeferredTransactions)
-        return WTF::move(currentTransaction);
-
-    // Prepend the deferred transactions back on the beginning of the deque for future scheduling passes.
-    while (!deferredTransactions.isEmpty())
-        m_pendingTransactions.prepend(deferredTransactions.takeLast());
-
-    return WTF::move(currentTransaction);
-}
-
 void UniqueIDBDatabase::inProgressTransactionCompleted(const IDBResourceIdentifier& transactionIdentifier)
 {
     auto transaction = m_inProgressTransactions.take(transactionIdentifier);
@@ -794,8 +788,12 @@ void UniqueIDBDatabase::inProgressTransactionCompleted(const IDBResourceIdentifi
     if (m_versionChangeTransaction == transaction)
         m_versionChangeTransaction = nullptr;
 
-    for (auto objectStore : transaction->objectStoreIdentifiers())
+    bool isWriting = transaction->info().mode() != IndexedDB::TransactionMode::ReadOnly;
+    for (auto objectStore : transaction->objectStoreIdentifiers()) {
         m_objectStoreTransactionCounts.remove(objectStore);
+        if (isWriting)
+            m_objectStoreWriteTransactionCounts.remove(objectStore);
+    }
 
     // Previously blocked transactions might now be unblocked.
     invokeTransactionScheduler();
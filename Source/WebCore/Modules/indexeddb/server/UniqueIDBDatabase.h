@@ -145,7 +145,8 @@ private:
 
     void invokeTransactionScheduler();
     void transactionSchedulingTimerFired();
-    RefPtr<UniqueIDBDatabaseTransaction> takeNextRunnableTransaction(bool& hadDeferredTransactions);
+    bool isTransactionRunnable(UniqueIDBDatabaseTransaction&, const HashSet<uint64_t>& scopesWaitingToRead, const HashSet<uint64_t>& scopesWaitingToWrite);
+    void startTransaction(Ref<UniqueIDBDatabaseTransaction>&&);
 
     IDBServer& m_server;
     IDBDatabaseIdentifier m_identifier;
@@ -177,6 +178,10 @@ private:
     // This helps make sure opening narrowly scoped transactions (one or two object stores)
     // doesn't continuously block widely scoped write transactions.
     HashCountedSet<uint64_t> m_objectStoreTransactionCounts;
+
+    // Like m_objectStoreTransactionCounts, but only counting read-write transactions.
+    // Read-only transactions only need to wait for the object stores in here.
+    HashCountedSet<uint64_t> m_objectStoreWriteTransactionCounts;
 };
 
 } // namespace IDBServer
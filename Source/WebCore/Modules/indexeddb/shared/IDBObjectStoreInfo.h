@@ -53,6 +53,7 @@ public:
     void addExistingIndex(const IDBIndexInfo&);
     bool hasIndex(const String& name) const;
     IDBIndexInfo* infoForExistingIndex(const String& name);
+    const HashMap<uint64_t, IDBIndexInfo>& indexMap() const { return m_indexMap; }
 
 private:
     uint64_t m_identifier { 0 };
@@ -41,13 +41,20 @@ namespace WebCore {
 
 Ref<InProcessIDBServer> InProcessIDBServer::create()
 {
-    Ref<InProcessIDBServer> server = adoptRef(*new InProcessIDBServer);
+    Ref<InProcessIDBServer> server = adoptRef(*new InProcessIDBServer(String()));
     server->m_server->registerConnection(server->connectionToClient());
     return WTF::move(server);
 }
 
-InProcessIDBServer::InProcessIDBServer()
-    : m_server(IDBServer::IDBServer::create())
+Ref<InProcessIDBServer> InProcessIDBServer::create(const String& databaseDirectoryPath)
+{
+    Ref<InProcessIDBServer> server = adoptRef(*new InProcessIDBServer(databaseDirectoryPath));
+    server->m_server->registerConnection(server->connectionToClient());
+    return WTF::move(server);
+}
+
+InProcessIDBServer::InProcessIDBServer(const String& databaseDirectoryPath)
+    : m_server(IDBServer::IDBServer::create(databaseDirectoryPath))
 {
     relaxAdoptionRequirement();
     m_connectionToServer = IDBClient::IDBConnectionToServer::create(*this);
@@ -72,30 +72,6 @@ public:
     }
 };
 
-// SamplePresentationTimeIsInsideRangeComparator matches (range.first, range.second]
-struct SamplePresentationTimeIsInsideRangeComparator {
-    bool operator()(std::pair<MediaTime, MediaTime> range, const std::pair<MediaTime, RefPtr<MediaSample>>& value)
-    {
-        return range.second < value.first;
-    }
-    bool operator()(const std::pair<MediaTime, RefPtr<MediaSample>>& value, std::pair<MediaTime, MediaTime> range)
-    {
-        return value.first <= range.first;
-    }
-};
-
-// SamplePresentationTimeIsWithinRangeComparator matches [range.first, range.second)
-struct SamplePresentationTimeIsWithinRangeComparator {
-    bool operator()(std::pair<MediaTime, MediaTime> range, const std::pair<MediaTime, RefPtr<MediaSample>>& value)
-    {
-        return range.second <= value.first;
-    }
-    bool operator()(const std::pair<MediaTime, RefPtr<MediaSample>>& value, std::pair<MediaTime, MediaTime> range)
-    {
-        return value.first < range.first;
-    }
-};
-
 bool SampleMap::empty() const
 {
     return presentationOrder().m_samples.empty();
@@ -146,10 +122,15 @@ PresentationOrderSampleMap::iterator PresentationOrderSampleMap::findSampleWithP
 
 PresentationOrderSampleMap::iterator PresentationOrderSampleMap::findSampleContainingPresentationTime(const MediaTime& time)
 {
-    auto range = std::equal_range(begin(), end(), time, SampleIsLessThanMediaTimeComparator<MapType>());
-    if (range.first == range.second)
+    // Samples don't overlap in presentation order, so the only candidate is the last one starting on or before time.
+    // std::equal_range() would walk the map linearly, since its iterators aren't random access.
+    auto iter = m_samples.upper_bound(time);
+    if (iter == begin())
         return end();
-    return range.first;
+    --iter;
+    if (SampleIsLessThanMediaTimeComparator<MapType>()(*iter, time))
+        return end();
+    return iter;
 }
 
 PresentationOrderSampleMap::iterator PresentationOrderSampleMap::findSampleOnOrAfterPresentationTime(const MediaTime& time)
@@ -164,15 +145,16 @@ DecodeOrderSampleMap::iterator DecodeOrderSampleMap::findSampleWithDecodeKey(con
 
 PresentationOrderSampleMap::reverse_iterator PresentationOrderSampleMap::reverseFindSampleContainingPresentationTime(const MediaTime& time)
 {
-    auto range = std::equal_range(rbegin(), rend(), time, SampleIsGreaterThanMediaTimeComparator<MapType>());
-    if (range.first == range.second)
+    auto found = reverseFindSampleBeforePresentationTime(time);
+    if (found == rend() || SampleIsGreaterThanMediaTimeComparator<MapType>()(time, *found))
         return rend();
-    return range.first;
+    return found;
 }
 
 PresentationOrderSampleMap::reverse_iterator PresentationOrderSampleMap::reverseFindSampleBeforePresentationTime(const MediaTime& time)
 {
-    return std::lower_bound(rbegin(), rend(), time, SampleIsGreaterThanMediaTimeComparator<MapType>());
+    // The first sample, in reverse order, starting on or before time.
+    return reverse_iterator(m_samples.upper_bound(time));
 }
 
 DecodeOrderSampleMap::reverse_iterator DecodeOrderSampleMap::reverseFindSampleWithDecodeKey(const KeyType& key)
@@ -230,29 +212,30 @@ DecodeOrderSampleMap::iterator DecodeOrderSampleMap::findSyncSampleAfterDecodeIt
     return std::find_if(++currentSampleDTS, end(), SampleIsRandomAccess());
 }
 
+// The map is keyed by presentation time, so ranges of samples are found with the map's own O(log n) bounds
+// rather than std::equal_range(), which is linear over bidirectional iterators.
 PresentationOrderSampleMap::iterator_range PresentationOrderSampleMap::findSamplesBetweenPresentationTimes(const MediaTime& beginTime, const MediaTime& endTime)
 {
-    std::pair<MediaTime, MediaTime> range(beginTime, endTime);
-    return std::equal_range(begin(), end(), range, SamplePresentationTimeIsInsideRangeComparator());
+    // Matches (beginTime, endTime].
+    iterator rangeStart = m_samples.upper_bound(beginTime);
+    if (endTime <= beginTime)
+        return iterator_range(rangeStart, rangeStart);
+    return iterator_range(rangeStart, m_samples.upper_bound(endTime));
 }
 
 PresentationOrderSampleMap::iterator_range PresentationOrderSampleMap::findSamplesWithinPresentationRange(const MediaTime& beginTime, const MediaTime& endTime)
 {
-    std::pair<MediaTime, MediaTime> range(beginTime, endTime);
-    return std::equal_range(begin(), end(), range, SamplePresentationTimeIsWithinRangeComparator());
+    // Matches [beginTime, endTime).
+    iterator rangeStart = m_samples.lower_bound(beginTime);
+    if (endTime <= beginTime)
+        return iterator_range(rangeStart, rangeStart);
+    return iterator_range(rangeStart, m_samples.lower_bound(endTime));
 }
 
 PresentationOrderSampleMap::iterator_range PresentationOrderSampleMap::findSamplesWithinPresentationRangeFromEnd(const MediaTime& beginTime, const MediaTime& endTime)
 {
-    reverse_iterator rangeEnd = std::find_if(rbegin(), rend(), [&beginTime] (PresentationOrderSampleMap::MapType::value_type value) {
-        return value.second->presentationTime() <= beginTime;
-    });
-
-    reverse_iterator rangeStart = std::find_if(rbegin(), rangeEnd, [&endTime] (PresentationOrderSampleMap::MapType::value_type value) {
-        return value.second->presentationTime() <= endTime;
-    });
-
-    return iterator_range(rangeEnd.base(), rangeStart.base());
+    // Matches (beginTime, endTime], like findSamplesBetweenPresentationTimes().
+    return findSamplesBetweenPresentationTimes(beginTime, endTime);
 }
 
 DecodeOrderSampleMap::reverse_iterator_range DecodeOrderSampleMap::findDependentSamples(MediaSample* sample)
@@ -36,6 +36,7 @@
 #include "AudioListener.h"
 #include "AudioNodeInput.h"
 #include "AudioNodeOutput.h"
+#include "AudioParallelRenderer.h"
 #include "BiquadFilterNode.h"
 #include "ChannelMergerNode.h"
 #include "ChannelSplitterNode.h"
@@ -138,6 +139,9 @@ AudioContext::AudioContext(Document& document)
 
     m_destinationNode = DefaultAudioDestinationNode::create(this);
 
+    // Loaders are shared by all the contexts in the process that run at the same sample rate.
+    m_hrtfDatabaseLoader = HRTFDatabaseLoader::createAndLoadAsynchronouslyIfNecessary(sampleRate());
+
     // Initialize the destination node's muted state to match the page's current muted state.
     pageMutedStateDidChange();
 }
@@ -235,6 +239,8 @@ void AudioContext::clear()
     if (m_destinationNode)
         m_destinationNode = nullptr;
 
+    m_hrtfDatabaseLoader = nullptr;
+
     // Audio thread is dead. Nobody will schedule node deletion action. Let's do it ourselves.
     do {
         deleteMarkedNodes();
@@ -666,6 +672,7 @@ PassRefPtr<PeriodicWave> AudioContext::createPeriodicWave(Float32Array* real, Fl
 void AudioContext::notifyNodeFinishedProcessing(AudioNode* node)
 {
     ASSERT(isAudioThread());
+    LockHolder locker(m_finishedNodesLock);
     m_finishedNodes.append(node);
 }
 
@@ -728,7 +735,7 @@ void AudioContext::lock(bool& mustReleaseLock)
 bool AudioContext::tryLock(bool& mustReleaseLock)
 {
     ThreadIdentifier thisThread = currentThread();
-    bool isAudioThread = thisThread == audioThread();
+    bool isAudioThread = this->isAudioThread();
 
     // Try to catch cases of using try lock on main thread - it should use regular lock.
     ASSERT(isAudioThread || isAudioThreadFinished());
@@ -768,7 +775,51 @@ void AudioContext::unlock()
 
 bool AudioContext::isAudioThread() const
 {
-    return currentThread() == m_audioThread;
+    ThreadIdentifier thisThread = currentThread();
+    if (thisThread == m_audioThread)
+        return true;
+
+    unsigned parallelRenderingThreadCount = m_parallelRenderingThreadCount;
+    for (unsigned i = 0; i < parallelRenderingThreadCount; ++i) {
+        if (thisThread == m_parallelRenderingThreads[i])
+            return true;
+    }
+    return false;
+}
+
+void AudioContext::addParallelRenderingThread(ThreadIdentifier thread)
+{
+    // Helper threads can run more than one task per render quantum.
+    unsigned parallelRenderingThreadCount = m_parallelRenderingThreadCount;
+    for (unsigned i = 0; i < parallelRenderingThreadCount; ++i) {
+        if (thread == m_parallelRenderingThreads[i])
+            return;
+    }
+
+    static Lock parallelRenderingThreadsLock;
+    LockHolder locker(parallelRenderingThreadsLock);
+    unsigned index = m_parallelRenderingThreadCount;
+    RELEASE_ASSERT(index < maxParallelRenderingThreads);
+    m_parallelRenderingThreads[index] = thread;
+    m_parallelRenderingThreadCount = index + 1;
+}
+
+void AudioContext::clearParallelRenderingThreads()
+{
+    ASSERT(currentThread() == m_audioThread);
+    m_parallelRenderingThreadCount = 0;
+}
+
+void AudioContext::renderIndependentSubgraphs(size_t framesToProcess)
+{
+    ASSERT(isAudioThread());
+
+    if (!m_destinationNode)
+        return;
+
+    if (!m_parallelRenderer)
+        m_parallelRenderer = std::make_unique<AudioParallelRenderer>(*this);
+    m_parallelRenderer->renderIndependentSubgraphs(*m_destinationNode, framesToProcess);
 }
 
 bool AudioContext::isGraphOwner() const
@@ -779,6 +830,7 @@ bool AudioContext::isGraphOwner() const
 void AudioContext::addDeferredFinishDeref(AudioNode* node)
 {
     ASSERT(isAudioThread());
+    LockHolder locker(m_deferredFinishDerefListLock);
     m_deferredFinishDerefList.append(node);
 }
 
@@ -60,8 +60,10 @@ class ChannelMergerNode;
 class ChannelSplitterNode;
 class GainNode;
 class GenericEventQueue;
+class HRTFDatabaseLoader;
 class PannerNode;
 class AudioListener;
+class AudioParallelRenderer;
 class AudioSummingJunction;
 class BiquadFilterNode;
 class DelayNode;
@@ -157,6 +159,18 @@ public:
     // Called at the end of each render quantum.
     void handlePostRenderTasks();
 
+    // Called by the destination node before it pulls the graph, to render the parts of it that do not depend on each other on several threads.
+    void renderIndependentSubgraphs(size_t framesToProcess);
+
+    // The threads rendering subgraphs in parallel are treated as audio threads while the audio thread waits for them.
+    static const unsigned maxParallelRenderingThreads = 8;
+    void addParallelRenderingThread(ThreadIdentifier);
+    void clearParallelRenderingThreads();
+
+    // AudioParams driven by another node's output make the graph pull across subgraph boundaries, so such graphs render serially.
+    bool hasAudioParamRenderingConnections() const { return m_audioParamRenderingConnectionCount; }
+    void didChangeAudioParamRenderingConnections(bool hasRenderingConnections) { m_audioParamRenderingConnectionCount += hasRenderingConnections ? 1 : -1; }
+
     // Called periodically at the end of each render quantum to dereference finished source nodes.
     void derefFinishedSourceNodes();
 
@@ -334,8 +348,9 @@ private:
     void addReaction(State, Promise&&);
     void updateAutomaticPullNodes();
 
-    // Only accessed in the audio thread.
+    // Only accessed in the audio threads.
     Vector<AudioNode*> m_finishedNodes;
+    Lock m_finishedNodesLock;
 
     // We don't use RefPtr<AudioNode> here because AudioNode has a more complex ref() / deref() implementation
     // with an optional argument for refType.  We need to use the special refType: RefTypeConnection
@@ -366,13 +381,17 @@ private:
     // It will be copied from m_automaticPullNodes by updateAutomaticPullNodes() at the very start or end of the rendering quantum.
     HashSet<AudioNode*> m_automaticPullNodes;
     Vector<AudioNode*> m_renderingAutomaticPullNodes;
-    // Only accessed in the audio thread.
+    // Only accessed in the audio threads.
     Vector<AudioNode*> m_deferredFinishDerefList;
+    Lock m_deferredFinishDerefListLock;
     Vector<Vector<Promise>> m_stateReactions;
 
     std::unique_ptr<PlatformMediaSession> m_mediaSession;
     std::unique_ptr<GenericEventQueue> m_eventQueue;
 
+    // Starts loading the HRTF database when a realtime context is created, so the first PannerNode finds it ready.
+    RefPtr<HRTFDatabaseLoader> m_hrtfDatabaseLoader;
+
     RefPtr<AudioBuffer> m_renderTarget;
     RefPtr<AudioDestinationNode> m_destinationNode;
     RefPtr<AudioListener> m_listener;
@@ -384,6 +403,11 @@ private:
     volatile ThreadIdentifier m_audioThread { 0 };
     volatile ThreadIdentifier m_graphOwnerThread; // if the lock is held then this is the thread which owns it, otherwise == UndefinedThreadIdentifier
 
+    // Only created and used in the audio thread.
+    std::unique_ptr<AudioParallelRenderer> m_parallelRenderer;
+    ThreadIdentifier m_parallelRenderingThreads[maxParallelRenderingThreads];
+    std::atomic<unsigned> m_parallelRenderingThreadCount { 0 };
+
     AsyncAudioDecoder m_audioDecoder;
 
     // This is considering 32 is large enough for multiple channels audio. 
@@ -393,6 +417,9 @@ private:
     // Number of AudioBufferSourceNodes that are active (playing).
     std::atomic<int> m_activeSourceCount { 0 };
 
+    // Number of AudioParams with rendering connections from other nodes.
+    std::atomic<int> m_audioParamRenderingConnectionCount { 0 };
+
     BehaviorRestrictions m_restrictions { NoRestrictions };
 
     State m_state { State::Suspended };
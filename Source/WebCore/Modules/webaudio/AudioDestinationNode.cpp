@@ -71,6 +71,9 @@ void AudioDestinationNode::render(AudioBus*, AudioBus* destinationBus, size_t nu
     // Let the context take care of any business at the start of each render quantum.
     context()->handlePreRenderTasks();
 
+    // Render the independent parts of the graph on several threads when that is worth it. The pull below picks up their results.
+    context()->renderIndependentSubgraphs(numberOfFrames);
+
     // This will cause the node(s) connected to us to process, which in turn will pull on their input(s),
     // all the way backwards through the rendering graph.
     AudioBus* renderedBus = input(0)->pull(destinationBus, numberOfFrames);
@@ -34,6 +34,7 @@
 #include "AudioParam.h"
 #include "ExceptionCode.h"
 #include <wtf/Atomics.h>
+#include <wtf/CurrentTime.h>
 #include <wtf/MainThread.h>
 
 #if DEBUG_AUDIONODE_REFERENCES
@@ -315,7 +316,10 @@ void AudioNode::processIfNecessary(size_t framesToProcess)
         if (silentInputs && propagatesSilence())
             silenceOutputs();
         else {
+            double processStartTime = monotonicallyIncreasingTime();
             process(framesToProcess);
+            m_lastProcessDuration = monotonicallyIncreasingTime() - processStartTime;
+            m_totalProcessDuration += m_lastProcessDuration;
             unsilenceOutputs();
         }
     }
@@ -138,6 +138,24 @@ public:
     // Called from context's audio thread.
     void processIfNecessary(size_t framesToProcess);
 
+    // Time spent in process() the last time this node processed, and since it was created.
+    // Called from context's audio thread.
+    double lastProcessDuration() const { return m_lastProcessDuration; }
+    double totalProcessDuration() const { return m_totalProcessDuration; }
+
+    // Used by AudioParallelRenderer to tag the nodes of each subgraph it finds during a partitioning pass.
+    // Called from context's audio thread.
+    void setRenderingSubgraph(uint64_t pass, unsigned subgraph)
+    {
+        m_renderingSubgraphPass = pass;
+        m_renderingSubgraph = subgraph;
+    }
+    bool renderingSubgraph(uint64_t pass, unsigned& subgraph) const
+    {
+        subgraph = m_renderingSubgraph;
+        return m_renderingSubgraphPass == pass;
+    }
+
     // Called when a new connection has been made to one of our inputs or the connection number of channels has changed.
     // This potentially gives us enough information to perform a lazy initialization or, if necessary, a re-initialization.
     // Called from main thread.
@@ -206,6 +224,12 @@ private:
     double m_lastProcessingTime;
     double m_lastNonSilentTime;
 
+    double m_lastProcessDuration { 0 };
+    double m_totalProcessDuration { 0 };
+
+    uint64_t m_renderingSubgraphPass { 0 };
+    unsigned m_renderingSubgraph { 0 };
+
     // Ref-counting
     std::atomic<int> m_normalRefCount;
     std::atomic<int> m_connectionRefCount;
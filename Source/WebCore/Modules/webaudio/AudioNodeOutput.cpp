@@ -109,6 +109,11 @@ AudioBus* AudioNodeOutput::pull(AudioBus* inPlaceBus, size_t framesToProcess)
 {
     ASSERT(context()->isAudioThread());
     ASSERT(m_renderingFanOutCount > 0 || m_renderingParamFanOutCount > 0);
+
+    if (m_wasRenderedInAdvance) {
+        m_wasRenderedInAdvance = false;
+        return bus();
+    }
     
     // Causes our AudioNode to process if it hasn't already for this render quantum.
     // We try to do in-place processing (using inPlaceBus) if at all possible,
@@ -124,6 +129,17 @@ AudioBus* AudioNodeOutput::pull(AudioBus* inPlaceBus, size_t framesToProcess)
     return bus();
 }
 
+void AudioNodeOutput::renderInAdvance(size_t framesToProcess)
+{
+    ASSERT(context()->isAudioThread());
+
+    m_isInPlace = false;
+    m_inPlaceBus = nullptr;
+
+    node()->processIfNecessary(framesToProcess);
+    m_wasRenderedInAdvance = true;
+}
+
 AudioBus* AudioNodeOutput::bus() const
 {
     ASSERT(const_cast<AudioNodeOutput*>(this)->context()->isAudioThread());
@@ -54,6 +54,11 @@ public:
     // Called from context's audio thread.
     AudioBus* pull(AudioBus* inPlaceBus, size_t framesToProcess);
 
+    // Causes our AudioNode to process into our own bus ahead of the pull() for this render quantum, which then just returns it.
+    // Used to render independent parts of the graph in parallel.
+    // Called from context's audio thread or, while it waits, one of the threads rendering in parallel.
+    void renderInAdvance(size_t framesToProcess);
+
     // bus() will contain the rendered audio after pull() is called for each rendering time quantum.
     // Called from context's audio thread.
     AudioBus* bus() const;
@@ -134,6 +139,8 @@ private:
     RefPtr<AudioBus> m_inPlaceBus;
     // If m_isInPlace is true, use m_inPlaceBus as the valid AudioBus; If false, use the default m_internalBus.
     bool m_isInPlace;
+    // Set by renderInAdvance() until the next pull().
+    bool m_wasRenderedInAdvance { false };
 
     HashSet<AudioNodeInput*> m_inputs;
     typedef HashSet<AudioNodeInput*>::iterator InputsIterator;
@@ -0,0 +1,219 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+
+#if ENABLE(WEB_AUDIO)
+
+#include "AudioParallelRenderer.h"
+
+#include "AudioContext.h"
+#include "AudioNode.h"
+#include "AudioNodeInput.h"
+#include "AudioNodeOutput.h"
+#include "DenormalDisabler.h"
+#include <mutex>
+#include <wtf/NumberOfCores.h>
+#include <wtf/ParallelHelperPool.h>
+
+namespace WebCore {
+
+// Handing subgraphs to other threads costs tens of microseconds per render quantum, so only do it when the subgraphs other
+// than the most expensive one took at least this long to process in the previous render quantum.
+static const double minimumParallelProcessDuration = 0.0001;
+
+// Subgraph index of the nodes between the split and the destination, which must be rendered on the audio thread.
+static const unsigned serialSubgraph = std::numeric_limits<unsigned>::max();
+
+static ParallelHelperPool& renderingHelperPool()
+{
+    static std::once_flag initializeHelperPoolOnceFlag;
+    static ParallelHelperPool* helperPool;
+    std::call_once(
+        initializeHelperPoolOnceFlag,
+        [] {
+            helperPool = new ParallelHelperPool();
+            helperPool->ensureThreads(std::min<unsigned>(std::max(numberOfProcessorCores(), 1) - 1, AudioContext::maxParallelRenderingThreads));
+        });
+    return *helperPool;
+}
+
+AudioParallelRenderer::AudioParallelRenderer(AudioContext& context)
+    : m_context(context)
+{
+}
+
+AudioParallelRenderer::~AudioParallelRenderer()
+{
+}
+
+unsigned AudioParallelRenderer::findSubgraph(unsigned root)
+{
+    while (m_rootParents[root] != root) {
+        m_rootParents[root] = m_rootParents[m_rootParents[root]];
+        root = m_rootParents[root];
+    }
+    return root;
+}
+
+void AudioParallelRenderer::mergeSubgraphs(unsigned root, unsigned otherRoot)
+{
+    unsigned subgraph = findSubgraph(root);
+    unsigned otherSubgraph = findSubgraph(otherRoot);
+    if (subgraph == otherSubgraph)
+        return;
+
+    m_rootParents[otherSubgraph] = subgraph;
+    m_subgraphProcessDurations[subgraph] += m_subgraphProcessDurations[otherSubgraph];
+}
+
+static void appendUpstreamOutputs(AudioNode& node, Vector<AudioNodeOutput*>& outputs)
+{
+    for (unsigned i = 0; i < node.numberOfInputs(); ++i) {
+        AudioNodeInput* input = node.input(i);
+        for (unsigned j = 0; j < input->numberOfRenderingConnections(); ++j)
+            outputs.append(input->renderingOutput(j));
+    }
+}
+
+bool AudioParallelRenderer::partition(AudioNode& destination)
+{
+    ++m_pass;
+    m_roots.shrink(0);
+
+    // Walk up from the destination through nodes fed by a single connection.
+    AudioNode* node = &destination;
+    while (true) {
+        node->setRenderingSubgraph(m_pass, serialSubgraph);
+        appendUpstreamOutputs(*node, m_roots);
+        if (m_roots.size() != 1)
+            break;
+
+        node = m_roots[0]->node();
+        unsigned subgraph;
+        if (node->renderingSubgraph(m_pass, subgraph))
+            return false; // A feedback loop.
+        m_roots.shrink(0);
+    }
+
+    if (m_roots.size() < 2)
+        return false;
+
+    m_rootParents.resize(m_roots.size());
+    m_subgraphProcessDurations.resize(m_roots.size());
+    for (unsigned i = 0; i < m_roots.size(); ++i) {
+        m_rootParents[i] = i;
+        m_subgraphProcessDurations[i] = 0;
+    }
+
+    for (unsigned i = 0; i < m_roots.size(); ++i) {
+        AudioNode* rootNode = m_roots[i]->node();
+        unsigned subgraph;
+        if (rootNode->renderingSubgraph(m_pass, subgraph)) {
+            if (subgraph == serialSubgraph)
+                return false;
+            mergeSubgraphs(subgraph, i);
+            continue;
+        }
+
+        rootNode->setRenderingSubgraph(m_pass, i);
+        m_nodesToVisit.shrink(0);
+        m_nodesToVisit.append(rootNode);
+        while (!m_nodesToVisit.isEmpty()) {
+            AudioNode* node = m_nodesToVisit.takeLast();
+            m_subgraphProcessDurations[findSubgraph(i)] += node->lastProcessDuration();
+
+            for (unsigned j = 0; j < node->numberOfInputs(); ++j) {
+                AudioNodeInput* input = node->input(j);
+                for (unsigned k = 0; k < input->numberOfRenderingConnections(); ++k) {
+                    AudioNode* upstreamNode = input->renderingOutput(k)->node();
+                    if (upstreamNode->renderingSubgraph(m_pass, subgraph)) {
+                        if (subgraph == serialSubgraph)
+                            return false;
+                        mergeSubgraphs(subgraph, i);
+                        continue;
+                    }
+                    upstreamNode->setRenderingSubgraph(m_pass, i);
+                    m_nodesToVisit.append(upstreamNode);
+                }
+            }
+        }
+    }
+
+    // Group the roots by subgraph.
+    m_subgraphRoots.shrink(0);
+    m_subgraphStarts.shrink(0);
+    double totalProcessDuration = 0;
+    double largestProcessDuration = 0;
+    for (unsigned subgraph = 0; subgraph < m_roots.size(); ++subgraph) {
+        if (findSubgraph(subgraph) != subgraph)
+            continue;
+
+        m_subgraphStarts.append(m_subgraphRoots.size());
+        for (unsigned i = subgraph; i < m_roots.size(); ++i) {
+            if (findSubgraph(i) == subgraph)
+                m_subgraphRoots.append(m_roots[i]);
+        }
+        totalProcessDuration += m_subgraphProcessDurations[subgraph];
+        largestProcessDuration = std::max(largestProcessDuration, m_subgraphProcessDurations[subgraph]);
+    }
+    m_subgraphStarts.append(m_subgraphRoots.size());
+
+    return m_subgraphStarts.size() > 2 && totalProcessDuration - largestProcessDuration >= minimumParallelProcessDuration;
+}
+
+void AudioParallelRenderer::renderIndependentSubgraphs(AudioNode& destination, size_t framesToProcess)
+{
+    ASSERT(m_context.isAudioThread());
+
+    // An AudioParam pulls the outputs connected to it when its node processes, and those outputs can't be found by walking
+    // up from the destination, so subgraphs can't be told apart.
+    if (m_context.hasAudioParamRenderingConnections())
+        return;
+
+    if (!partition(destination))
+        return;
+
+    if (!m_helperClient)
+        m_helperClient = std::make_unique<ParallelHelperClient>(&renderingHelperPool());
+
+    unsigned subgraphCount = m_subgraphStarts.size() - 1;
+    m_nextSubgraph = 0;
+    m_helperClient->runFunctionInParallel([this, framesToProcess, subgraphCount] {
+        // We don't want denormals slowing down any of the audio processing on this thread either.
+        DenormalDisabler denormalDisabler;
+        m_context.addParallelRenderingThread(currentThread());
+
+        for (unsigned subgraph = m_nextSubgraph++; subgraph < subgraphCount; subgraph = m_nextSubgraph++) {
+            for (unsigned i = m_subgraphStarts[subgraph]; i < m_subgraphStarts[subgraph + 1]; ++i)
+                m_subgraphRoots[i]->renderInAdvance(framesToProcess);
+        }
+    });
+    m_context.clearParallelRenderingThreads();
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(WEB_AUDIO)
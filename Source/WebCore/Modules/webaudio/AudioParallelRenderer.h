@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef AudioParallelRenderer_h
+#define AudioParallelRenderer_h
+
+#include <atomic>
+#include <memory>
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+
+namespace WTF {
+class ParallelHelperClient;
+}
+
+namespace WebCore {
+
+class AudioContext;
+class AudioNode;
+class AudioNodeOutput;
+
+// Renders the independent subgraphs of an AudioContext's rendering graph on several threads at the start of each render quantum.
+//
+// Walking up from the destination, the first node fed by more than one connection splits the graph. The nodes upstream of each
+// of its connections form a subgraph; subgraphs sharing a node are merged. Each subgraph is rendered on whichever thread of a
+// shared helper pool (or the audio thread) claims it, leaving its outputs rendered for the regular pull from the destination to
+// pick up. Everything below the split is still rendered by that pull on the audio thread.
+class AudioParallelRenderer {
+    WTF_MAKE_NONCOPYABLE(AudioParallelRenderer);
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    explicit AudioParallelRenderer(AudioContext&);
+    ~AudioParallelRenderer();
+
+    // Called from context's audio thread, before the destination pulls its input.
+    void renderIndependentSubgraphs(AudioNode& destination, size_t framesToProcess);
+
+private:
+    bool partition(AudioNode& destination);
+    unsigned findSubgraph(unsigned root);
+    void mergeSubgraphs(unsigned root, unsigned otherRoot);
+
+    AudioContext& m_context;
+    std::unique_ptr<WTF::ParallelHelperClient> m_helperClient;
+
+    // All of these are only accessed from context's audio thread, and reused across render quanta to avoid allocating.
+    uint64_t m_pass { 0 };
+    Vector<AudioNodeOutput*> m_roots;
+    Vector<unsigned> m_rootParents;
+    Vector<double> m_subgraphProcessDurations;
+    Vector<AudioNode*> m_nodesToVisit;
+
+    // Roots grouped by subgraph: the roots of subgraph i are m_subgraphRoots[m_subgraphStarts[i]] up to m_subgraphStarts[i + 1].
+    Vector<AudioNodeOutput*> m_subgraphRoots;
+    Vector<unsigned> m_subgraphStarts;
+    std::atomic<unsigned> m_nextSubgraph { 0 };
+};
+
+} // namespace WebCore
+
+#endif // AudioParallelRenderer_h
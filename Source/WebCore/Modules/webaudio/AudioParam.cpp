@@ -40,6 +40,22 @@ namespace WebCore {
 const double AudioParam::DefaultSmoothingConstant = 0.05;
 const double AudioParam::SnapThreshold = 0.001;
 
+AudioParam::~AudioParam()
+{
+    if (m_hasRenderingConnections && context())
+        context()->didChangeAudioParamRenderingConnections(false);
+}
+
+void AudioParam::didUpdate()
+{
+    bool hasRenderingConnections = isConnected();
+    if (hasRenderingConnections == m_hasRenderingConnections)
+        return;
+
+    m_hasRenderingConnections = hasRenderingConnections;
+    context()->didChangeAudioParamRenderingConnections(hasRenderingConnections);
+}
+
 float AudioParam::value()
 {
     // Update value for timeline.
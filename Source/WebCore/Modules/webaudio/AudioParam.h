@@ -52,9 +52,11 @@ public:
         return adoptRef(*new AudioParam(context, name, defaultValue, minValue, maxValue, units));
     }
 
+    virtual ~AudioParam();
+
     // AudioSummingJunction
     virtual bool canUpdateState() override { return true; }
-    virtual void didUpdate() override { }
+    virtual void didUpdate() override;
 
     // Intrinsic value.
     float value();
@@ -133,6 +135,9 @@ private:
     double m_smoothingConstant;
     
     AudioParamTimeline m_timeline;
+
+    // Whether this has been counted in the context's number of AudioParams with rendering connections.
+    bool m_hasRenderingConnections { false };
 };
 
 } // namespace WebCore
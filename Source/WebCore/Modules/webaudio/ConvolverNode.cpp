@@ -44,6 +44,10 @@
 // Very large FFTs will have worse phase errors. Given these constraints 32768 is a good compromise.
 const size_t MaxFFTSize = 32768;
 
+// The stages processed in the real-time audio thread are capped at this size, splitting the leading part of the
+// impulse response into uniform partitions.
+const size_t MaxRealtimeFFTSize = 2048;
+
 namespace WebCore {
 
 ConvolverNode::ConvolverNode(AudioContext* context, float sampleRate)
@@ -147,7 +151,7 @@ void ConvolverNode::setBuffer(AudioBuffer* buffer, ExceptionCode& ec)
 
     // Create the reverb with the given impulse response.
     bool useBackgroundThreads = !context()->isOfflineContext();
-    auto reverb = std::make_unique<Reverb>(bufferBus.get(), AudioNode::ProcessingSizeInFrames, MaxFFTSize, 2, useBackgroundThreads, m_normalize);
+    auto reverb = std::make_unique<Reverb>(bufferBus.get(), AudioNode::ProcessingSizeInFrames, MaxFFTSize, MaxRealtimeFFTSize, 2, useBackgroundThreads, m_normalize);
 
     {
         // Synchronize with process().
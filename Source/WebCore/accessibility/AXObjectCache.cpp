@@ -822,6 +822,7 @@ void AXObjectCache::notificationPostTimerFired()
     // In tests, posting notifications has a tendency to immediately queue up other notifications, which can lead to unexpected behavior
     // when the notification list is cleared at the end. Instead copy this list at the start.
     auto notifications = WTF::move(m_notificationsToPost);
+    m_queuedNotifications.clear();
     
     for (const auto& note : notifications) {
         AccessibilityObject* obj = note.first.get();
@@ -927,6 +928,10 @@ void AXObjectCache::postNotification(AccessibilityObject* object, Document* docu
         return;
 
     if (postType == PostAsynchronously) {
+        // A burst of DOM or render tree mutations tends to post the same notification on the same object many times
+        // before the timer fires, and each platform notification makes assistive technologies query the tree again.
+        if (!m_queuedNotifications.add(std::make_pair(object, static_cast<unsigned>(notification))).isNewEntry)
+            return;
         m_notificationsToPost.append(std::make_pair(object, notification));
         if (!m_notificationPostTimer.isActive())
             m_notificationPostTimer.startOneShot(0);
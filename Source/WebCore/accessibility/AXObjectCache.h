@@ -294,6 +294,8 @@ private:
 
     Timer m_notificationPostTimer;
     Vector<std::pair<RefPtr<AccessibilityObject>, AXNotification>> m_notificationsToPost;
+    // The same notification is only posted once per object for each firing of m_notificationPostTimer.
+    HashSet<std::pair<AccessibilityObject*, unsigned>> m_queuedNotifications;
 
     Timer m_passwordNotificationPostTimer;
 
@@ -23,6 +23,7 @@
 
 #include "JSDOMWindow.h"
 #include "ScriptController.h"
+#include "ScriptWrappable.h"
 #include "WebCoreJSClientData.h"
 #include <wtf/MainThread.h>
 
@@ -45,6 +46,8 @@ DOMWrapperWorld::~DOMWrapperWorld()
     ASSERT(clientData);
     static_cast<JSVMClientData*>(clientData)->forgetWorld(*this);
 
+    clearIsolatedWorldWrappers();
+
     // These items are created lazily.
     while (!m_scriptControllersWithWindowShells.isEmpty())
         (*m_scriptControllersWithWindowShells.begin())->destroyWindowShell(*this);
@@ -53,12 +56,20 @@ DOMWrapperWorld::~DOMWrapperWorld()
 void DOMWrapperWorld::clearWrappers()
 {
     m_wrappers.clear();
+    clearIsolatedWorldWrappers();
 
     // These items are created lazily.
     while (!m_scriptControllersWithWindowShells.isEmpty())
         (*m_scriptControllersWithWindowShells.begin())->destroyWindowShell(*this);
 }
 
+void DOMWrapperWorld::clearIsolatedWorldWrappers()
+{
+    auto objects = WTF::move(m_objectsWithIsolatedWorldWrappers);
+    for (auto* object : objects)
+        object->clearIsolatedWorldWrapper(*this);
+}
+
 DOMWrapperWorld& normalWorld(JSC::VM& vm)
 {
     VM::ClientData* clientData = vm.clientData;
@@ -29,6 +29,7 @@ namespace WebCore {
 
 class CSSValue;
 class ScriptController;
+class ScriptWrappable;
 
 typedef HashMap<void*, JSC::Weak<JSC::JSObject>> DOMObjectWrapperMap;
 
@@ -46,6 +47,9 @@ public:
     void didCreateWindowShell(ScriptController* scriptController) { m_scriptControllersWithWindowShells.add(scriptController); }
     void didDestroyWindowShell(ScriptController* scriptController) { m_scriptControllersWithWindowShells.remove(scriptController); }
 
+    void didCacheIsolatedWorldWrapper(ScriptWrappable& object) { m_objectsWithIsolatedWorldWrappers.add(&object); }
+    void didUncacheIsolatedWorldWrapper(ScriptWrappable& object) { m_objectsWithIsolatedWorldWrappers.remove(&object); }
+
     // FIXME: can we make this private?
     DOMObjectWrapperMap m_wrappers;
     HashMap<CSSValue*, void*> m_cssValueRoots;
@@ -58,8 +62,11 @@ protected:
     DOMWrapperWorld(JSC::VM&, bool isNormal);
 
 private:
+    void clearIsolatedWorldWrappers();
+
     JSC::VM& m_vm;
     HashSet<ScriptController*> m_scriptControllersWithWindowShells;
+    HashSet<ScriptWrappable*> m_objectsWithIsolatedWorldWrappers;
     bool m_isNormal;
 };
 
@@ -177,7 +177,7 @@ inline bool clearInlineCachedWrapper(DOMWrapperWorld&, void*, JSDOMObject*) { re
 inline JSDOMObject* getInlineCachedWrapper(DOMWrapperWorld& world, ScriptWrappable* domObject)
 {
     if (!world.isNormal())
-        return nullptr;
+        return domObject->isolatedWorldWrapper(world);
     return domObject->wrapper();
 }
 
@@ -191,8 +191,9 @@ inline JSC::JSArrayBuffer* getInlineCachedWrapper(DOMWrapperWorld& world, JSC::A
 inline bool setInlineCachedWrapper(DOMWrapperWorld& world, ScriptWrappable* domObject, JSDOMObject* wrapper, JSC::WeakHandleOwner* wrapperOwner)
 {
     if (!world.isNormal())
-        return false;
-    domObject->setWrapper(wrapper, wrapperOwner, &world);
+        domObject->setIsolatedWorldWrapper(world, wrapper, wrapperOwner);
+    else
+        domObject->setWrapper(wrapper, wrapperOwner, &world);
     return true;
 }
 
@@ -207,8 +208,9 @@ inline bool setInlineCachedWrapper(DOMWrapperWorld& world, JSC::ArrayBuffer* dom
 inline bool clearInlineCachedWrapper(DOMWrapperWorld& world, ScriptWrappable* domObject, JSDOMObject* wrapper)
 {
     if (!world.isNormal())
-        return false;
-    domObject->clearWrapper(wrapper);
+        domObject->clearIsolatedWorldWrapper(world, wrapper);
+    else
+        domObject->clearWrapper(wrapper);
     return true;
 }
 
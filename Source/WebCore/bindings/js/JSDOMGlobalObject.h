@@ -37,7 +37,12 @@ namespace WebCore {
     class DOMWrapperWorld;
     class ScriptExecutionContext;
 
-    typedef HashMap<const JSC::ClassInfo*, JSC::WriteBarrier<JSC::Structure>> JSDOMStructureMap;
+    // A document touching the DOM from script creates dozens of wrapper structures for every global
+    // object, so start the structure map out large enough to skip the first few rehashes.
+    struct JSDOMStructureMapKeyTraits : HashTraits<const JSC::ClassInfo*> {
+        static const unsigned minimumTableSize = 64;
+    };
+    typedef HashMap<const JSC::ClassInfo*, JSC::WriteBarrier<JSC::Structure>, PtrHash<const JSC::ClassInfo*>, JSDOMStructureMapKeyTraits> JSDOMStructureMap;
     typedef HashMap<const JSC::ClassInfo*, JSC::WriteBarrier<JSC::JSObject>> JSDOMConstructorMap;
 
     class WEBCORE_EXPORT JSDOMGlobalObject : public JSC::JSGlobalObject {
@@ -33,6 +33,7 @@
 #include "JSModuleLoader.h"
 #include "JSNode.h"
 #include "Logging.h"
+#include "MemoryPressureHandler.h"
 #include "Page.h"
 #include "RuntimeApplicationChecks.h"
 #include "ScriptController.h"
@@ -268,6 +269,8 @@ VM& JSDOMWindowBase::commonVM()
             vm->setShouldRewriteConstAsVar(true);
 #endif
 
+        vm->heap.setMemoryPressureCallback([] { return MemoryPressureHandler::singleton().isUnderMemoryPressure(); });
+
         initNormalWorldClientData(vm);
     }
 
@@ -30,6 +30,7 @@
 #include <runtime/Completion.h>
 #include <runtime/Microtask.h>
 #include <wtf/MainThread.h>
+#include <wtf/TraceEvent.h>
 
 #if PLATFORM(IOS)
 #include "WebCoreThread.h"
@@ -80,6 +81,7 @@ private:
     explicit JSMainThreadExecState(JSC::ExecState* exec)
         : m_previousState(s_mainThreadState)
         , m_lock(exec)
+        , m_traceScope(TraceCategory::JavaScript, "JSMainThreadExecState")
     {
         ASSERT(isMainThread());
         s_mainThreadState = exec;
@@ -101,6 +103,7 @@ private:
     static JSC::ExecState* s_mainThreadState;
     JSC::ExecState* m_previousState;
     JSC::JSLockHolder m_lock;
+    TraceScope m_traceScope;
 
     static void didLeaveScriptContext();
 };
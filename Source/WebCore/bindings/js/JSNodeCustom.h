@@ -34,7 +34,6 @@
 namespace WebCore {
 
 WEBCORE_EXPORT JSC::JSValue createWrapper(JSC::ExecState*, JSDOMGlobalObject*, Node*);
-WEBCORE_EXPORT JSC::JSObject* getOutOfLineCachedWrapper(JSDOMGlobalObject*, Node*);
 
 inline JSC::JSValue toJS(JSC::ExecState* exec, JSDOMGlobalObject* globalObject, Node* node)
 {
@@ -45,7 +44,7 @@ inline JSC::JSValue toJS(JSC::ExecState* exec, JSDOMGlobalObject* globalObject,
         if (auto* wrapper = node->wrapper())
             return wrapper;
     } else {
-        if (auto* wrapper = getOutOfLineCachedWrapper(globalObject, node))
+        if (auto* wrapper = node->isolatedWorldWrapper(globalObject->world()))
             return wrapper;
     }
 
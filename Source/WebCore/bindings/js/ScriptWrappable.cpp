@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ScriptWrappable.h"
+
+#include "DOMWrapperWorld.h"
+#include "ScriptWrappableInlines.h"
+
+namespace WebCore {
+
+void ScriptWrappable::setIsolatedWorldWrapper(DOMWrapperWorld& world, JSDOMObject* wrapper, JSC::WeakHandleOwner* wrapperOwner)
+{
+    ASSERT(!world.isNormal());
+
+    if (!m_isolatedWorldWrappers)
+        m_isolatedWorldWrappers = std::make_unique<Vector<IsolatedWorldWrapper, 1>>();
+
+    for (auto& entry : *m_isolatedWorldWrappers) {
+        if (entry.world == &world) {
+            // The previous wrapper died but has not been finalized yet.
+            ASSERT(!entry.wrapper);
+            entry.wrapper = JSC::Weak<JSDOMObject>(wrapper, wrapperOwner, &world);
+            return;
+        }
+    }
+
+    m_isolatedWorldWrappers->append({ &world, JSC::Weak<JSDOMObject>(wrapper, wrapperOwner, &world) });
+    world.didCacheIsolatedWorldWrapper(*this);
+}
+
+void ScriptWrappable::clearIsolatedWorldWrapper(DOMWrapperWorld& world, JSDOMObject* wrapper)
+{
+    ASSERT(m_isolatedWorldWrappers);
+
+    for (unsigned i = 0; i < m_isolatedWorldWrappers->size(); ++i) {
+        auto& entry = m_isolatedWorldWrappers->at(i);
+        if (entry.world != &world)
+            continue;
+        // A newer wrapper may have replaced this one before it was finalized.
+        if (!entry.wrapper.was(wrapper))
+            return;
+        weakClear(entry.wrapper, wrapper);
+        m_isolatedWorldWrappers->remove(i);
+        world.didUncacheIsolatedWorldWrapper(*this);
+        return;
+    }
+    ASSERT_NOT_REACHED();
+}
+
+void ScriptWrappable::clearIsolatedWorldWrapper(DOMWrapperWorld& world)
+{
+    if (!m_isolatedWorldWrappers)
+        return;
+
+    m_isolatedWorldWrappers->removeFirstMatching([&world] (const IsolatedWorldWrapper& entry) {
+        return entry.world == &world;
+    });
+    world.didUncacheIsolatedWorldWrapper(*this);
+}
+
+void ScriptWrappable::clearIsolatedWorldWrappers()
+{
+    for (auto& entry : *m_isolatedWorldWrappers)
+        entry.world->didUncacheIsolatedWorldWrapper(*this);
+    m_isolatedWorldWrappers = nullptr;
+}
+
+} // namespace WebCore
@@ -33,6 +33,8 @@
 #define ScriptWrappable_h
 
 #include <heap/Weak.h>
+#include <memory>
+#include <wtf/Vector.h>
 
 namespace JSC {
 class WeakHandleOwner;
@@ -40,6 +42,7 @@ class WeakHandleOwner;
 
 namespace WebCore {
 
+class DOMWrapperWorld;
 class JSDOMObject;
 
 class ScriptWrappable {
@@ -48,11 +51,30 @@ public:
     void setWrapper(JSDOMObject*, JSC::WeakHandleOwner*, void*);
     void clearWrapper(JSDOMObject*);
 
+    // Wrappers in isolated worlds are kept in a small table allocated on first use, so that
+    // looking them up does not need a hash lookup in the world's wrapper map.
+    JSDOMObject* isolatedWorldWrapper(DOMWrapperWorld&) const;
+    void setIsolatedWorldWrapper(DOMWrapperWorld&, JSDOMObject*, JSC::WeakHandleOwner*);
+    void clearIsolatedWorldWrapper(DOMWrapperWorld&, JSDOMObject*);
+    void clearIsolatedWorldWrapper(DOMWrapperWorld&);
+
 protected:
-    ~ScriptWrappable() { }
+    ~ScriptWrappable()
+    {
+        if (m_isolatedWorldWrappers)
+            clearIsolatedWorldWrappers();
+    }
 
 private:
+    void clearIsolatedWorldWrappers();
+
+    struct IsolatedWorldWrapper {
+        DOMWrapperWorld* world;
+        JSC::Weak<JSDOMObject> wrapper;
+    };
+
     JSC::Weak<JSDOMObject> m_wrapper;
+    std::unique_ptr<Vector<IsolatedWorldWrapper, 1>> m_isolatedWorldWrappers;
 };
 
 } // namespace WebCore
@@ -54,6 +54,17 @@ inline void ScriptWrappable::clearWrapper(JSDOMObject* wrapper)
     weakClear(m_wrapper, wrapper);
 }
 
+inline JSDOMObject* ScriptWrappable::isolatedWorldWrapper(DOMWrapperWorld& world) const
+{
+    if (!m_isolatedWorldWrappers)
+        return nullptr;
+    for (auto& entry : *m_isolatedWorldWrappers) {
+        if (entry.world == &world)
+            return entry.wrapper.get();
+    }
+    return nullptr;
+}
+
 } // namespace WebCore
 
 #endif // ScriptWrappableInlines_h
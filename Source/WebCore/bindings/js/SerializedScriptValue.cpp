@@ -131,6 +131,8 @@ enum SerializationTag {
 #if ENABLE(SUBTLE_CRYPTO)
     CryptoKeyTag = 33,
 #endif
+    LargeStringTag = 34,
+    ArrayBufferSegmentTag = 35,
     ErrorTag = 255
 };
 
@@ -248,8 +250,9 @@ static unsigned countUsages(CryptoKeyUsage usages)
  * Version 4. added support for serializing non-index properties of arrays.
  * Version 5. added support for Map and Set types.
  * Version 6. added support for 8-bit strings.
+ * Version 7. added LargeStringTag and ArrayBufferSegmentTag for payloads kept out of line.
  */
-static const unsigned CurrentVersion = 6;
+static const unsigned CurrentVersion = 7;
 static const unsigned TerminatorTag = 0xFFFFFFFF;
 static const unsigned StringPoolTag = 0xFFFFFFFE;
 static const unsigned NonIndexPropertiesTag = 0xFFFFFFFD;
@@ -257,6 +260,12 @@ static const unsigned NonIndexPropertiesTag = 0xFFFFFFFD;
 // The high bit of a StringData's length determines the character size.
 static const unsigned StringDataIs8BitFlag = 0x80000000;
 
+// A LargeString with this segment index has its characters inline.
+static const unsigned InlineLargeStringIndex = 0xFFFFFFFF;
+
+// String and ArrayBuffer payloads at least this large are kept in a separate segment.
+static const unsigned minimumSegmentSizeInBytes = 64 * 1024;
+
 /*
  * Object serialization is performed according to the following grammar, all tags
  * are recorded as a single uint8_t.
@@ -295,6 +304,7 @@ static const unsigned StringDataIs8BitFlag = 0x80000000;
  *    | NumberObjectTag <value:double>
  *    | DateTag <value:double>
  *    | String
+ *    | LargeString
  *    | EmptyStringTag
  *    | EmptyStringObjectTag
  *    | File
@@ -306,6 +316,7 @@ static const unsigned StringDataIs8BitFlag = 0x80000000;
  *    | ArrayBuffer
  *    | ArrayBufferViewTag ArrayBufferViewSubtag <byteOffset:uint32_t> <byteLength:uint32_t> (ArrayBuffer | ObjectReference)
  *    | ArrayBufferTransferTag <value:uint32_t>
+ *    | ArrayBufferSegmentTag <segmentIndex:uint32_t>
  *    | CryptoKeyTag <wrappedKeyLength:uint32_t> <factor:byte{wrappedKeyLength}>
  *
  * Inside wrapped crypto key, data is serialized in this format:
@@ -316,6 +327,10 @@ static const unsigned StringDataIs8BitFlag = 0x80000000;
  *      EmptyStringTag
  *      StringTag StringData
  *
+ * LargeString :- // Not added to the constant pool.
+ *      LargeStringTag <segmentIndex:uint32_t>
+ *      LargeStringTag InlineLargeStringIndex <is8Bit:uint32_t:1><length:uint32_t:31><characters:CharType{length}>
+ *
  * StringObject:
  *      EmptyStringObjectTag
  *      StringObjectTag StringData
@@ -464,13 +479,34 @@ template <> bool writeLittleEndian<uint8_t>(Vector<uint8_t>& buffer, const uint8
     return true;
 }
 
+// Writes a value kept in a segment the way it is encoded when its payload is inline.
+static bool writeInlineSegment(Vector<uint8_t>& buffer, uint8_t tag, const SerializedScriptValue::Segment& segment)
+{
+    if (tag == ArrayBufferSegmentTag) {
+        writeLittleEndian<uint8_t>(buffer, ArrayBufferTag);
+        writeLittleEndian<uint32_t>(buffer, segment.arrayBufferData.size());
+        return writeLittleEndian(buffer, segment.arrayBufferData.data(), segment.arrayBufferData.size());
+    }
+
+    ASSERT(tag == LargeStringTag);
+    const String& string = segment.string;
+    writeLittleEndian<uint8_t>(buffer, LargeStringTag);
+    writeLittleEndian<uint32_t>(buffer, InlineLargeStringIndex);
+    if (string.is8Bit()) {
+        writeLittleEndian<uint32_t>(buffer, string.length() | StringDataIs8BitFlag);
+        return writeLittleEndian(buffer, string.characters8(), string.length());
+    }
+    writeLittleEndian<uint32_t>(buffer, string.length());
+    return writeLittleEndian(buffer, string.characters16(), string.length());
+}
+
 class CloneSerializer : CloneBase {
 public:
     static SerializationReturnCode serialize(ExecState* exec, JSValue value,
                                              MessagePortArray* messagePorts, ArrayBufferArray* arrayBuffers,
-                                             Vector<String>& blobURLs, Vector<uint8_t>& out)
+                                             Vector<String>& blobURLs, Vector<uint8_t>& out, Vector<SerializedScriptValue::Segment>& segments)
     {
-        CloneSerializer serializer(exec, messagePorts, arrayBuffers, blobURLs, out);
+        CloneSerializer serializer(exec, messagePorts, arrayBuffers, blobURLs, out, &segments);
         return serializer.serialize(value);
     }
 
@@ -517,10 +553,11 @@ public:
 private:
     typedef HashMap<JSObject*, uint32_t> ObjectPool;
 
-    CloneSerializer(ExecState* exec, MessagePortArray* messagePorts, ArrayBufferArray* arrayBuffers, Vector<String>& blobURLs, Vector<uint8_t>& out)
+    CloneSerializer(ExecState* exec, MessagePortArray* messagePorts, ArrayBufferArray* arrayBuffers, Vector<String>& blobURLs, Vector<uint8_t>& out, Vector<SerializedScriptValue::Segment>* segments = nullptr)
         : CloneBase(exec)
         , m_buffer(out)
         , m_blobURLs(blobURLs)
+        , m_segments(segments)
         , m_emptyIdentifier(Identifier::fromString(exec, emptyString()))
     {
         write(CurrentVersion);
@@ -679,7 +716,12 @@ private:
     {
         if (string.isEmpty())
             write(EmptyStringTag);
-        else {
+        else if (m_segments && string.length() * (string.is8Bit() ? sizeof(LChar) : sizeof(UChar)) >= minimumSegmentSizeInBytes) {
+            // Large strings skip the constant pool, which would otherwise atomize them.
+            SerializedScriptValue::Segment segment;
+            segment.string = string.isolatedCopy();
+            writeSegment(LargeStringTag, WTF::move(segment));
+        } else {
             write(StringTag);
             write(string);
         }
@@ -852,6 +894,12 @@ private:
                 }
                 if (!startObjectInternal(obj)) // handle duplicates
                     return true;
+                if (m_segments && arrayBuffer->byteLength() >= minimumSegmentSizeInBytes) {
+                    SerializedScriptValue::Segment segment;
+                    segment.arrayBufferData.append(static_cast<const uint8_t*>(arrayBuffer->data()), arrayBuffer->byteLength());
+                    writeSegment(ArrayBufferSegmentTag, WTF::move(segment));
+                    return true;
+                }
                 write(ArrayBufferTag);
                 write(arrayBuffer->byteLength());
                 write(static_cast<const uint8_t*>(arrayBuffer->data()), arrayBuffer->byteLength());
@@ -1199,8 +1247,18 @@ private:
         m_buffer.append(data, length);
     }
 
+    void writeSegment(SerializationTag tag, SerializedScriptValue::Segment&& segment)
+    {
+        ASSERT(m_segments);
+        segment.offset = m_buffer.size();
+        write(tag);
+        write(static_cast<uint32_t>(m_segments->size()));
+        m_segments->append(WTF::move(segment));
+    }
+
     Vector<uint8_t>& m_buffer;
     Vector<String>& m_blobURLs;
+    Vector<SerializedScriptValue::Segment>* m_segments;
     ObjectPool m_objectPool;
     ObjectPool m_transferredMessagePorts;
     ObjectPool m_transferredArrayBuffers;
@@ -1466,7 +1524,13 @@ public:
         if (!readLittleEndian(ptr, end, version) || version > CurrentVersion)
             return String();
         uint8_t tag;
-        if (!readLittleEndian(ptr, end, tag) || tag != StringTag)
+        if (!readLittleEndian(ptr, end, tag))
+            return String();
+        if (tag == LargeStringTag) {
+            uint32_t index;
+            if (!readLittleEndian(ptr, end, index) || index != InlineLargeStringIndex)
+                return String();
+        } else if (tag != StringTag)
             return String();
         uint32_t length;
         if (!readLittleEndian(ptr, end, length))
@@ -1481,11 +1545,11 @@ public:
 
     static DeserializationResult deserialize(ExecState* exec, JSGlobalObject* globalObject,
                                              MessagePortArray* messagePorts, ArrayBufferContentsArray* arrayBufferContentsArray,
-                                             const Vector<uint8_t>& buffer)
+                                             const Vector<uint8_t>& buffer, const Vector<SerializedScriptValue::Segment>& segments)
     {
         if (!buffer.size())
             return std::make_pair(jsNull(), UnspecifiedError);
-        CloneDeserializer deserializer(exec, globalObject, messagePorts, arrayBufferContentsArray, buffer);
+        CloneDeserializer deserializer(exec, globalObject, messagePorts, arrayBufferContentsArray, buffer, segments);
         if (!deserializer.isValid())
             return std::make_pair(JSValue(), ValidationError);
         return deserializer.deserialize();
@@ -1532,7 +1596,7 @@ private:
 
     CloneDeserializer(ExecState* exec, JSGlobalObject* globalObject, 
                       MessagePortArray* messagePorts, ArrayBufferContentsArray* arrayBufferContents,
-                      const Vector<uint8_t>& buffer)
+                      const Vector<uint8_t>& buffer, const Vector<SerializedScriptValue::Segment>& segments)
         : CloneBase(exec)
         , m_globalObject(globalObject)
         , m_isDOMGlobalObject(globalObject->inherits(JSDOMGlobalObject::info()))
@@ -1542,6 +1606,7 @@ private:
         , m_messagePorts(messagePorts)
         , m_arrayBufferContents(arrayBufferContents)
         , m_arrayBuffers(arrayBufferContents ? arrayBufferContents->size() : 0)
+        , m_segments(segments)
     {
         if (!read(m_version))
             m_version = 0xFFFFFFFF;
@@ -1689,6 +1754,26 @@ private:
         return true;
     }
 
+    bool readLargeString(String& string)
+    {
+        uint32_t index;
+        if (!read(index))
+            return false;
+        if (index != InlineLargeStringIndex) {
+            if (index >= m_segments.size() || m_segments[index].string.isNull())
+                return false;
+            // Segment strings are isolated copies owned by the serialized value, so they can be shared.
+            string = m_segments[index].string;
+            return true;
+        }
+        uint32_t length;
+        if (!read(length))
+            return false;
+        bool is8Bit = length & StringDataIs8BitFlag;
+        length &= ~StringDataIs8BitFlag;
+        return readString(m_ptr, m_end, string, length, is8Bit);
+    }
+
     bool readStringData(CachedStringRef& cachedString)
     {
         bool scratch;
@@ -2278,6 +2363,14 @@ private:
                 return JSValue();
             return cachedString->jsString(m_exec);
         }
+        case LargeStringTag: {
+            String string;
+            if (!readLargeString(string)) {
+                fail();
+                return JSValue();
+            }
+            return jsString(m_exec, string);
+        }
         case EmptyStringTag:
             return jsEmptyString(&m_exec->vm());
         case StringObjectTag: {
@@ -2334,6 +2427,19 @@ private:
             m_gcBuffer.append(result);
             return result;
         }
+        case ArrayBufferSegmentTag: {
+            uint32_t index;
+            if (!read(index) || index >= m_segments.size()) {
+                fail();
+                return JSValue();
+            }
+            // The segment may be deserialized again, so the new buffer gets its own copy.
+            const Vector<uint8_t>& data = m_segments[index].arrayBufferData;
+            RefPtr<ArrayBuffer> arrayBuffer = ArrayBuffer::create(data.data(), data.size());
+            JSValue result = getJSValue(arrayBuffer.get());
+            m_gcBuffer.append(result);
+            return result;
+        }
         case ArrayBufferTransferTag: {
             uint32_t index;
             bool indexSuccessfullyRead = read(index);
@@ -2369,7 +2475,7 @@ private:
                 return JSValue();
             }
             JSValue cryptoKey;
-            CloneDeserializer rawKeyDeserializer(m_exec, m_globalObject, nullptr, nullptr, serializedKey);
+            CloneDeserializer rawKeyDeserializer(m_exec, m_globalObject, nullptr, nullptr, serializedKey, Vector<SerializedScriptValue::Segment>());
             if (!rawKeyDeserializer.readCryptoKey(cryptoKey)) {
                 fail();
                 return JSValue();
@@ -2402,6 +2508,7 @@ private:
     MessagePortArray* m_messagePorts;
     ArrayBufferContentsArray* m_arrayBufferContents;
     ArrayBufferArray m_arrayBuffers;
+    const Vector<SerializedScriptValue::Segment>& m_segments;
 };
 
 DeserializationResult CloneDeserializer::deserialize()
@@ -2612,8 +2719,9 @@ SerializedScriptValue::SerializedScriptValue(Vector<uint8_t>& buffer, Vector<Str
         addBlobURL(string);
 }
 
-SerializedScriptValue::SerializedScriptValue(Vector<uint8_t>& buffer, Vector<String>& blobURLs, std::unique_ptr<ArrayBufferContentsArray> arrayBufferContentsArray)
-    : m_arrayBufferContentsArray(WTF::move(arrayBufferContentsArray))
+SerializedScriptValue::SerializedScriptValue(Vector<uint8_t>& buffer, Vector<String>& blobURLs, std::unique_ptr<ArrayBufferContentsArray> arrayBufferContentsArray, Vector<Segment>&& segments)
+    : m_segments(WTF::move(segments))
+    , m_arrayBufferContentsArray(WTF::move(arrayBufferContentsArray))
 {
     m_data.swap(buffer);
     for (auto& string : blobURLs)
@@ -2653,7 +2761,8 @@ RefPtr<SerializedScriptValue> SerializedScriptValue::create(ExecState* exec, JSV
 {
     Vector<uint8_t> buffer;
     Vector<String> blobURLs;
-    SerializationReturnCode code = CloneSerializer::serialize(exec, value, messagePorts, arrayBuffers, blobURLs, buffer);
+    Vector<Segment> segments;
+    SerializationReturnCode code = CloneSerializer::serialize(exec, value, messagePorts, arrayBuffers, blobURLs, buffer, segments);
 
     std::unique_ptr<ArrayBufferContentsArray> arrayBufferContentsArray;
 
@@ -2666,7 +2775,7 @@ RefPtr<SerializedScriptValue> SerializedScriptValue::create(ExecState* exec, JSV
     if (!serializationDidCompleteSuccessfully(code))
         return nullptr;
 
-    return adoptRef(*new SerializedScriptValue(buffer, blobURLs, WTF::move(arrayBufferContentsArray)));
+    return adoptRef(*new SerializedScriptValue(buffer, blobURLs, WTF::move(arrayBufferContentsArray), WTF::move(segments)));
 }
 
 RefPtr<SerializedScriptValue> SerializedScriptValue::create(const String& string)
@@ -2709,16 +2818,45 @@ RefPtr<SerializedScriptValue> SerializedScriptValue::create(JSContextRef originC
     return serializedValue;
 }
 
+const Vector<uint8_t>& SerializedScriptValue::data() const
+{
+    if (!m_segments.isEmpty())
+        inlineSegments();
+    return m_data;
+}
+
+void SerializedScriptValue::inlineSegments() const
+{
+    size_t size = m_data.size();
+    for (auto& segment : m_segments)
+        size += segment.string.sizeInBytes() + segment.arrayBufferData.size() + sizeof(uint32_t);
+
+    Vector<uint8_t> data;
+    data.reserveInitialCapacity(size);
+    size_t position = 0;
+    for (auto& segment : m_segments) {
+        data.append(m_data.data() + position, segment.offset - position);
+        uint8_t tag = m_data[segment.offset];
+        position = segment.offset + sizeof(uint8_t) + sizeof(uint32_t);
+        bool success = writeInlineSegment(data, tag, segment);
+        ASSERT_UNUSED(success, success);
+    }
+    data.append(m_data.data() + position, m_data.size() - position);
+
+    m_data.swap(data);
+    m_segments.clear();
+}
+
 String SerializedScriptValue::toString()
 {
-    return CloneDeserializer::deserializeString(m_data);
+    return CloneDeserializer::deserializeString(data());
 }
 
 JSValue SerializedScriptValue::deserialize(ExecState* exec, JSGlobalObject* globalObject,
                                            MessagePortArray* messagePorts, SerializationErrorMode throwExceptions)
 {
     DeserializationResult result = CloneDeserializer::deserialize(exec, globalObject, messagePorts,
-                                                                  m_arrayBufferContentsArray.get(), m_data);
+                                                                  m_arrayBufferContentsArray.get(), m_data, m_segments);
     if (throwExceptions == Throwing)
         maybeThrowExceptionIfSerializationFailed(exec, result.second);
     return result.first ? result.first : jsNull();
@@ -86,7 +86,7 @@ public:
     WEBCORE_EXPORT static RefPtr<SerializedScriptValue> create(JSContextRef, JSValueRef, JSValueRef* exception);
     WEBCORE_EXPORT JSValueRef deserialize(JSContextRef, JSValueRef* exception);
 
-    const Vector<uint8_t>& data() const { return m_data; }
+    const Vector<uint8_t>& data() const;
     bool hasBlobURLs() const { return !m_blobURLs.isEmpty(); }
     void blobURLs(Vector<String>&) const;
 
@@ -100,10 +100,19 @@ public:
     {
         return adoptRef(*new SerializedScriptValue(data));
     }
-    const Vector<uint8_t>& toWireBytes() const { return m_data; }
+    const Vector<uint8_t>& toWireBytes() const { return data(); }
 
     WEBCORE_EXPORT ~SerializedScriptValue();
 
+    // Large strings and ArrayBuffers are kept out of the serialized data, which refers to them by
+    // index. Strings are isolated copies that deserialization hands to the VM without copying them
+    // again. The data is rewritten with the payloads inline the first time the wire bytes are needed.
+    struct Segment {
+        size_t offset; // Offset in the serialized data of the tag that refers to this segment.
+        String string;
+        Vector<uint8_t> arrayBufferData;
+    };
+
 private:
     typedef Vector<JSC::ArrayBufferContents> ArrayBufferContentsArray;
     static void maybeThrowExceptionIfSerializationFailed(JSC::ExecState*, SerializationReturnCode);
@@ -114,9 +123,12 @@ private:
     SerializedScriptValue(const Vector<unsigned char>&);
     WEBCORE_EXPORT SerializedScriptValue(Vector<unsigned char>&);
     SerializedScriptValue(Vector<unsigned char>&, Vector<String>& blobURLs);
-    SerializedScriptValue(Vector<unsigned char>&, Vector<String>& blobURLs, std::unique_ptr<ArrayBufferContentsArray>);
+    SerializedScriptValue(Vector<unsigned char>&, Vector<String>& blobURLs, std::unique_ptr<ArrayBufferContentsArray>, Vector<Segment>&&);
+
+    void inlineSegments() const;
 
-    Vector<unsigned char> m_data;
+    mutable Vector<unsigned char> m_data;
+    mutable Vector<Segment> m_segments;
     std::unique_ptr<ArrayBufferContentsArray> m_arrayBufferContentsArray;
     Vector<Vector<uint16_t>> m_blobURLs;
 };
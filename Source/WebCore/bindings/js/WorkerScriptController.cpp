@@ -50,8 +50,8 @@ using namespace JSC;
 
 namespace WebCore {
 
-WorkerScriptController::WorkerScriptController(WorkerGlobalScope* workerGlobalScope)
-    : m_vm(VM::create())
+WorkerScriptController::WorkerScriptController(WorkerGlobalScope* workerGlobalScope, RefPtr<VM>&& vm)
+    : m_vm(vm ? WTF::move(vm) : VM::create())
     , m_workerGlobalScope(workerGlobalScope)
     , m_workerGlobalScopeWrapper(*m_vm)
     , m_executionForbidden(false)
@@ -51,7 +51,8 @@ namespace WebCore {
     class WorkerScriptController {
         WTF_MAKE_NONCOPYABLE(WorkerScriptController); WTF_MAKE_FAST_ALLOCATED;
     public:
-        WorkerScriptController(WorkerGlobalScope*);
+        // Uses the given VM if the worker thread created one ahead of time.
+        WorkerScriptController(WorkerGlobalScope*, RefPtr<JSC::VM>&& = nullptr);
         ~WorkerScriptController();
 
         JSWorkerGlobalScope* workerGlobalScopeWrapper()
@@ -36,12 +36,15 @@
 #include "ContentExtensionRule.h"
 #include "ContentExtensionsDebugging.h"
 #include "DFABytecodeCompiler.h"
+#include "DFACache.h"
 #include "DFACombiner.h"
 #include "NFA.h"
 #include "NFAToDFA.h"
 #include "URLFilterParser.h"
 #include <wtf/CurrentTime.h>
 #include <wtf/DataLog.h>
+#include <wtf/NumberOfCores.h>
+#include <wtf/WorkQueue.h>
 #include <wtf/text/CString.h>
 #include <wtf/text/StringBuilder.h>
 
@@ -223,7 +226,110 @@ static void addUniversalActionsToDFA(DFA& dfa, const UniversalActionSet& univers
     root.setActions(actionsStart, static_cast<uint16_t>(actionsLength));
 }
 
-std::error_code compileRuleList(ContentExtensionCompilationClient& client, String&& ruleList)
+// Smaller maxNFASizes risk high compiling and interpreting times from having too many DFAs,
+// larger maxNFASizes use too much memory when compiling.
+static const unsigned maxNFASize = 75000;
+
+// DFAs smaller than this are combined with each other before being lowered to bytecode.
+static const unsigned smallDFASize = 100;
+
+// Every NFA of a batch and its DFA are in memory at the same time, so keep batches small.
+static const unsigned maxNFABatchSize = 4;
+
+// Only filled in with CONTENT_EXTENSIONS_PERFORMANCE_REPORTING. Times spent on other threads are added up.
+struct PhaseTimes {
+    double nfaToDFA { 0 };
+    double dfaMinimizer { 0 };
+    double dfaBytecodeCompiler { 0 };
+};
+
+struct NFAGroupDFA {
+    DFA dfa;
+    bool isSmall { false };
+    double nfaToDFATime { 0 };
+    double dfaMinimizerTime { 0 };
+};
+
+// Builds the DFA of each NFA group of the filters and hands them to the handler in the order CombinedURLFilters
+// produces the groups. Groups found in the cache are reused, the others are converted in parallel a batch at a time.
+static void buildDFAs(CombinedURLFilters& filters, const char* filtersName, bool minimize, DFACache* cache, PhaseTimes& phaseTimes, std::function<void(DFA&&, bool isSmall)> handler)
+{
+    UNUSED_PARAM(filtersName);
+    UNUSED_PARAM(phaseTimes);
+
+    const unsigned batchSize = std::max(1u, std::min(maxNFABatchSize, static_cast<unsigned>(numberOfProcessorCores())));
+    Vector<NFA> batch;
+
+    auto processBatch = [&] {
+        Vector<String> keys(batch.size());
+        Vector<NFAGroupDFA> groups(batch.size());
+        Vector<unsigned> groupsToBuild;
+        for (unsigned i = 0; i < batch.size(); ++i) {
+            if (cache) {
+                keys[i] = DFACache::key(batch[i], minimize);
+                if (const DFACache::Entry* entry = cache->find(keys[i])) {
+                    groups[i].dfa = entry->dfa;
+                    groups[i].isSmall = entry->isSmall;
+                    continue;
+                }
+            }
+            groupsToBuild.append(i);
+        }
+
+        WorkQueue::concurrentApply(groupsToBuild.size(), [&](size_t index) {
+            unsigned i = groupsToBuild[index];
+            NFAGroupDFA& group = groups[i];
+#if CONTENT_EXTENSIONS_PERFORMANCE_REPORTING
+            double nfaToDFAStart = monotonicallyIncreasingTime();
+#endif
+            group.dfa = NFAToDFA::convert(batch[i]);
+            LOG_LARGE_STRUCTURES(dfa, group.dfa.memoryUsed());
+            group.isSmall = group.dfa.graphSize() < smallDFASize;
+#if CONTENT_EXTENSIONS_PERFORMANCE_REPORTING
+            double dfaMinimizerStart = monotonicallyIncreasingTime();
+            group.nfaToDFATime = dfaMinimizerStart - nfaToDFAStart;
+#endif
+            if (minimize)
+                group.dfa.minimize();
+#if CONTENT_EXTENSIONS_PERFORMANCE_REPORTING
+            group.dfaMinimizerTime = monotonicallyIncreasingTime() - dfaMinimizerStart;
+#endif
+        });
+        batch.clear();
+
+        for (unsigned i : groupsToBuild) {
+            if (cache)
+                cache->add(keys[i], groups[i].dfa, groups[i].isSmall);
+#if CONTENT_EXTENSIONS_PERFORMANCE_REPORTING
+            phaseTimes.nfaToDFA += groups[i].nfaToDFATime;
+            phaseTimes.dfaMinimizer += groups[i].dfaMinimizerTime;
+#endif
+        }
+
+        for (NFAGroupDFA& group : groups) {
+#if CONTENT_EXTENSIONS_STATE_MACHINE_DEBUGGING
+            dataLogF("%s DFA\n", filtersName);
+            group.dfa.debugPrintDot();
+#endif
+            handler(WTF::move(group.dfa), group.isSmall);
+        }
+    };
+
+    filters.processNFAs(maxNFASize, [&](NFA&& nfa) {
+#if CONTENT_EXTENSIONS_STATE_MACHINE_DEBUGGING
+        dataLogF("%s NFA\n", filtersName);
+        nfa.debugPrintDot();
+#endif
+        LOG_LARGE_STRUCTURES(nfa, nfa.memoryUsed());
+        batch.append(WTF::move(nfa));
+        if (batch.size() == batchSize)
+            processBatch();
+    });
+    if (!batch.isEmpty())
+        processBatch();
+}
+
+std::error_code compileRuleList(ContentExtensionCompilationClient& client, String&& ruleList, DFACache* cache)
 {
     Vector<ContentExtensionRule> parsedRuleList;
     auto parserError = parseRuleList(ruleList, parsedRuleList);
@@ -316,18 +422,29 @@ std::error_code compileRuleList(ContentExtensionCompilationClient& client, Strin
     double totalNFAToByteCodeBuildTimeStart = monotonicallyIncreasingTime();
 #endif
 
-    // Smaller maxNFASizes risk high compiling and interpreting times from having too many DFAs,
-    // larger maxNFASizes use too much memory when compiling.
-    const unsigned maxNFASize = 75000;
-    
+    if (cache)
+        cache->beginCompilation();
+
+    PhaseTimes phaseTimes;
+
+    auto compileDFAToBytecode = [&](const DFA& dfa) {
+#if CONTENT_EXTENSIONS_PERFORMANCE_REPORTING
+        double dfaBytecodeCompilerStart = monotonicallyIncreasingTime();
+#endif
+        Vector<DFABytecode> bytecode;
+        DFABytecodeCompiler compiler(dfa, bytecode);
+        compiler.compile();
+        LOG_LARGE_STRUCTURES(bytecode, bytecode.capacity() * sizeof(uint8_t));
+#if CONTENT_EXTENSIONS_PERFORMANCE_REPORTING
+        phaseTimes.dfaBytecodeCompiler += monotonicallyIncreasingTime() - dfaBytecodeCompilerStart;
+#endif
+        return bytecode;
+    };
+
     bool firstNFAWithoutDomainsSeen = false;
 
     auto lowerFiltersWithoutDomainsDFAToBytecode = [&](DFA&& dfa)
     {
-#if CONTENT_EXTENSIONS_STATE_MACHINE_DEBUGGING
-        dataLogF("filtersWithoutDomains DFA\n");
-        dfa.debugPrintDot();
-#endif
         ASSERT_WITH_MESSAGE(!dfa.nodes[dfa.root].hasActions(), "All actions on the DFA root should come from regular expressions that match everything.");
 
         if (!firstNFAWithoutDomainsSeen) {
@@ -335,10 +452,7 @@ std::error_code compileRuleList(ContentExtensionCompilationClient& client, Strin
             addUniversalActionsToDFA(dfa, universalActionsWithoutDomains);
         }
 
-        Vector<DFABytecode> bytecode;
-        DFABytecodeCompiler compiler(dfa, bytecode);
-        compiler.compile();
-        LOG_LARGE_STRUCTURES(bytecode, bytecode.capacity() * sizeof(uint8_t));
+        Vector<DFABytecode> bytecode = compileDFAToBytecode(dfa);
 #if CONTENT_EXTENSIONS_PERFORMANCE_REPORTING
         ++machinesWithoutDomainsCount;
         totalBytecodeSizeForMachinesWithoutDomains += bytecode.size();
@@ -348,27 +462,14 @@ std::error_code compileRuleList(ContentExtensionCompilationClient& client, Strin
         firstNFAWithoutDomainsSeen = true;
     };
 
-    const unsigned smallDFASize = 100;
     DFACombiner smallFiltersWithoutDomainsDFACombiner;
-    filtersWithoutDomains.processNFAs(maxNFASize, [&](NFA&& nfa) {
-#if CONTENT_EXTENSIONS_STATE_MACHINE_DEBUGGING
-        dataLogF("filtersWithoutDomains NFA\n");
-        nfa.debugPrintDot();
-#endif
-
-        LOG_LARGE_STRUCTURES(nfa, nfa.memoryUsed());
-        DFA dfa = NFAToDFA::convert(nfa);
-        LOG_LARGE_STRUCTURES(dfa, dfa.memoryUsed());
-
-        if (dfa.graphSize() < smallDFASize)
+    buildDFAs(filtersWithoutDomains, "filtersWithoutDomains", true, cache, phaseTimes, [&](DFA&& dfa, bool isSmall) {
+        if (isSmall)
             smallFiltersWithoutDomainsDFACombiner.addDFA(WTF::move(dfa));
-        else {
-            dfa.minimize();
+        else
             lowerFiltersWithoutDomainsDFAToBytecode(WTF::move(dfa));
-        }
     });
 
-
     smallFiltersWithoutDomainsDFACombiner.combineDFAs(smallDFASize, [&](DFA&& dfa) {
         LOG_LARGE_STRUCTURES(dfa, dfa.memoryUsed());
         lowerFiltersWithoutDomainsDFAToBytecode(WTF::move(dfa));
@@ -382,12 +483,7 @@ std::error_code compileRuleList(ContentExtensionCompilationClient& client, Strin
 
         DFA dummyDFA = DFA::empty();
         addUniversalActionsToDFA(dummyDFA, universalActionsWithoutDomains);
-
-        Vector<DFABytecode> bytecode;
-        DFABytecodeCompiler compiler(dummyDFA, bytecode);
-        compiler.compile();
-        LOG_LARGE_STRUCTURES(bytecode, bytecode.capacity() * sizeof(uint8_t));
-        client.writeFiltersWithoutDomainsBytecode(WTF::move(bytecode));
+        client.writeFiltersWithoutDomainsBytecode(compileDFAToBytecode(dummyDFA));
     }
     LOG_LARGE_STRUCTURES(universalActionsWithoutDomains, universalActionsWithoutDomains.capacity() * sizeof(unsigned));
     universalActionsWithoutDomains.clear();
@@ -400,10 +496,7 @@ std::error_code compileRuleList(ContentExtensionCompilationClient& client, Strin
             addUniversalActionsToDFA(dfa, universalActionsWithDomains);
         }
 
-        Vector<DFABytecode> bytecode;
-        DFABytecodeCompiler compiler(dfa, bytecode);
-        compiler.compile();
-        LOG_LARGE_STRUCTURES(bytecode, bytecode.capacity() * sizeof(uint8_t));
+        Vector<DFABytecode> bytecode = compileDFAToBytecode(dfa);
 #if CONTENT_EXTENSIONS_PERFORMANCE_REPORTING
         ++machinesWithDomainsCount;
         totalBytecodeSizeForMachinesWithDomains += bytecode.size();
@@ -414,27 +507,13 @@ std::error_code compileRuleList(ContentExtensionCompilationClient& client, Strin
     };
 
     DFACombiner smallFiltersWithDomainsDFACombiner;
-    filtersWithDomains.processNFAs(maxNFASize, [&](NFA&& nfa) {
-#if CONTENT_EXTENSIONS_STATE_MACHINE_DEBUGGING
-        dataLogF("filtersWithDomains NFA\n");
-        nfa.debugPrintDot();
-#endif
-        LOG_LARGE_STRUCTURES(nfa, nfa.memoryUsed());
-        DFA dfa = NFAToDFA::convert(nfa);
-#if CONTENT_EXTENSIONS_STATE_MACHINE_DEBUGGING
-        dataLogF("filtersWithDomains PRE MINIMIZING DFA\n");
-        dfa.debugPrintDot();
-#endif
-        LOG_LARGE_STRUCTURES(dfa, dfa.memoryUsed());
-
+    buildDFAs(filtersWithDomains, "filtersWithDomains", true, cache, phaseTimes, [&](DFA&& dfa, bool isSmall) {
         ASSERT_WITH_MESSAGE(!dfa.nodes[dfa.root].hasActions(), "Filters with domains that match everything are not allowed right now.");
 
-        if (dfa.graphSize() < smallDFASize)
+        if (isSmall)
             smallFiltersWithDomainsDFACombiner.addDFA(WTF::move(dfa));
-        else {
-            dfa.minimize();
+        else
             lowerFiltersWithDomainsDFAToBytecode(WTF::move(dfa));
-        }
     });
     smallFiltersWithDomainsDFACombiner.combineDFAs(smallDFASize, [&](DFA&& dfa) {
         LOG_LARGE_STRUCTURES(dfa, dfa.memoryUsed());
@@ -448,37 +527,16 @@ std::error_code compileRuleList(ContentExtensionCompilationClient& client, Strin
 
         DFA dummyDFA = DFA::empty();
         addUniversalActionsToDFA(dummyDFA, universalActionsWithDomains);
-        
-        Vector<DFABytecode> bytecode;
-        DFABytecodeCompiler compiler(dummyDFA, bytecode);
-        compiler.compile();
-        LOG_LARGE_STRUCTURES(bytecode, bytecode.capacity() * sizeof(uint8_t));
-        client.writeFiltersWithDomainsBytecode(WTF::move(bytecode));
+        client.writeFiltersWithDomainsBytecode(compileDFAToBytecode(dummyDFA));
     }
     LOG_LARGE_STRUCTURES(universalActionsWithDomains, universalActionsWithDomains.capacity() * sizeof(unsigned));
     universalActionsWithDomains.clear();
 
-    domainFilters.processNFAs(maxNFASize, [&](NFA&& nfa) {
-#if CONTENT_EXTENSIONS_STATE_MACHINE_DEBUGGING
-        dataLogF("domainFilters NFA\n");
-        nfa.debugPrintDot();
-#endif
-        LOG_LARGE_STRUCTURES(nfa, nfa.memoryUsed());
-        DFA dfa = NFAToDFA::convert(nfa);
-#if CONTENT_EXTENSIONS_STATE_MACHINE_DEBUGGING
-        dataLogF("domainFilters DFA\n");
-        dfa.debugPrintDot();
-#endif
-        LOG_LARGE_STRUCTURES(dfa, dfa.memoryUsed());
-        // Minimizing this DFA would not be effective because all actions are unique
-        // and because of the tree-like structure of this DFA.
+    // Minimizing this DFA would not be effective because all actions are unique
+    // and because of the tree-like structure of this DFA.
+    buildDFAs(domainFilters, "domainFilters", false, cache, phaseTimes, [&](DFA&& dfa, bool) {
         ASSERT_WITH_MESSAGE(!dfa.nodes[dfa.root].hasActions(), "There should not be any domains that match everything.");
-
-        Vector<DFABytecode> bytecode;
-        DFABytecodeCompiler compiler(dfa, bytecode);
-        compiler.compile();
-        LOG_LARGE_STRUCTURES(bytecode, bytecode.capacity() * sizeof(uint8_t));
-        client.writeDomainFiltersBytecode(WTF::move(bytecode));
+        client.writeDomainFiltersBytecode(compileDFAToBytecode(dfa));
     });
     ASSERT(domainFilters.isEmpty());    
     
@@ -488,8 +546,16 @@ std::error_code compileRuleList(ContentExtensionCompilationClient& client, Strin
 
     dataLogF("    Number of machines without domain filters: %d (total bytecode size = %d)\n", machinesWithoutDomainsCount, totalBytecodeSizeForMachinesWithoutDomains);
     dataLogF("    Number of machines with domain filters: %d (total bytecode size = %d)\n", machinesWithDomainsCount, totalBytecodeSizeForMachinesWithDomains);
+    dataLogF("    Time spent in NFAToDFA: %f\n", phaseTimes.nfaToDFA);
+    dataLogF("    Time spent in DFAMinimizer: %f\n", phaseTimes.dfaMinimizer);
+    dataLogF("    Time spent in DFABytecodeCompiler: %f\n", phaseTimes.dfaBytecodeCompiler);
+    if (cache)
+        dataLogF("    DFA cache: %u groups reused, %u groups built\n", cache->hitCount(), cache->missCount());
 #endif
 
+    if (cache)
+        cache->endCompilation();
+
     client.finalize();
 
     return { };
@@ -36,6 +36,8 @@
 namespace WebCore {
 namespace ContentExtensions {
 
+class DFACache;
+
 class ContentExtensionCompilationClient {
 public:
     virtual ~ContentExtensionCompilationClient() { }
@@ -48,7 +50,8 @@ public:
     virtual void finalize() = 0;
 };
 
-WEBCORE_EXPORT std::error_code compileRuleList(ContentExtensionCompilationClient&, String&&);
+// Passing the same DFACache to successive compilations of a rule list lets them reuse the DFAs of unchanged rule groups.
+WEBCORE_EXPORT std::error_code compileRuleList(ContentExtensionCompilationClient&, String&&, DFACache* = nullptr);
 
 } // namespace ContentExtensions
 } // namespace WebCore
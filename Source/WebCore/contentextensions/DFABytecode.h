@@ -83,8 +83,13 @@ enum class DFABytecodeInstruction : uint8_t {
 const uint8_t DFABytecodeInstructionMask = 0x0F;
 const uint8_t DFABytecodeJumpSizeMask = 0xF0;
 
-// DFA bytecode starts with a 4 byte header which contains the size of this DFA.
+// DFA bytecode starts with a header which contains the size of this DFA (4 bytes), followed by
+// the set of characters every string matched by the DFA contains (128 bits, one per ASCII character).
+// Letters are only in the set in lower case and stand for both cases. A string that lacks any of
+// these characters cannot match, so the interpreter skips the DFA without running it.
 typedef uint32_t DFAHeader;
+typedef uint64_t DFARequiredCharacters[2];
+const uint32_t DFAHeaderSize = sizeof(DFAHeader) + sizeof(DFARequiredCharacters);
 
 // A DFABytecodeJumpSize is stored in the top four bits of the DFABytecodeInstructions that have a jump.
 enum DFABytecodeJumpSize {
@@ -31,6 +31,7 @@
 #include "ContentExtensionRule.h"
 #include "DFA.h"
 #include "DFANode.h"
+#include <wtf/ASCIICType.h>
 
 namespace WebCore {
     
@@ -70,6 +71,63 @@ inline void setBits(Vector<DFABytecode>& bytecode, uint32_t index, IntType value
     *reinterpret_cast<IntType*>(&bytecode[index]) = value;
 }
 
+static void computeRequiredCharacters(const DFA& dfa, DFARequiredCharacters requiredCharacters)
+{
+    requiredCharacters[0] = 0;
+    requiredCharacters[1] = 0;
+
+    const DFANode& root = dfa.nodes[dfa.root];
+    if (root.hasActions())
+        return;
+
+    // Only a transition on a single character (in either case) can be cut by a URL lacking that character,
+    // so those are the only candidates.
+    DFARequiredCharacters candidates = { 0, 0 };
+    for (const DFANode& node : dfa.nodes) {
+        if (node.isKilled())
+            continue;
+        for (const auto& transition : node.transitions(dfa)) {
+            if (transition.first() != transition.last())
+                continue;
+            uint8_t character = toASCIILower(transition.first());
+            if (character < 128)
+                candidates[character / 64] |= static_cast<uint64_t>(1) << (character % 64);
+        }
+    }
+
+    // A candidate is required if no node with actions can be reached from the root without a transition on it.
+    Vector<bool> visited(dfa.nodes.size());
+    Vector<uint32_t> stack;
+    for (unsigned candidate = 0; candidate < 128; ++candidate) {
+        if (!(candidates[candidate / 64] & (static_cast<uint64_t>(1) << (candidate % 64))))
+            continue;
+
+        visited.fill(false);
+        stack.clear();
+        stack.append(dfa.root);
+        visited[dfa.root] = true;
+        bool reachesActions = false;
+        while (!stack.isEmpty() && !reachesActions) {
+            const DFANode& node = dfa.nodes[stack.takeLast()];
+            for (const auto& transition : node.transitions(dfa)) {
+                if (transition.first() == transition.last() && toASCIILower(transition.first()) == static_cast<char>(candidate))
+                    continue;
+                uint32_t target = transition.target();
+                if (visited[target])
+                    continue;
+                if (dfa.nodes[target].hasActions()) {
+                    reachesActions = true;
+                    break;
+                }
+                visited[target] = true;
+                stack.append(target);
+            }
+        }
+        if (!reachesActions)
+            requiredCharacters[candidate / 64] |= static_cast<uint64_t>(1) << (candidate % 64);
+    }
+}
+
 static unsigned appendActionBytecodeSize(uint64_t action)
 {
     if (action & ActionFlagMask)
@@ -423,6 +481,10 @@ void DFABytecodeCompiler::compile()
 {
     uint32_t startLocation = m_bytecode.size();
     append<DFAHeader>(m_bytecode, 0); // This will be set when we are finished compiling this DFA.
+    DFARequiredCharacters requiredCharacters;
+    computeRequiredCharacters(m_dfa, requiredCharacters);
+    append<uint64_t>(m_bytecode, requiredCharacters[0]);
+    append<uint64_t>(m_bytecode, requiredCharacters[1]);
 
     m_nodeStartOffsets.resize(m_dfa.nodes.size());
     for (unsigned i = 0; i < m_dfa.nodes.size(); ++i)
@@ -436,8 +498,8 @@ void DFABytecodeCompiler::compile()
     unsigned rootActionsSize = 0;
     for (uint64_t action : m_dfa.nodes[m_dfa.root].actions(m_dfa))
         rootActionsSize += appendActionBytecodeSize(action);
-    m_maxNodeStartOffsets[m_dfa.root] = sizeof(DFAHeader) + rootActionsSize;
-    unsigned nextIndex = sizeof(DFAHeader) + compiledNodeMaxBytecodeSize(m_dfa.root);
+    m_maxNodeStartOffsets[m_dfa.root] = DFAHeaderSize + rootActionsSize;
+    unsigned nextIndex = DFAHeaderSize + compiledNodeMaxBytecodeSize(m_dfa.root);
     for (uint32_t i = 0; i < m_dfa.nodes.size(); i++) {
         if (i != m_dfa.root) {
             m_maxNodeStartOffsets[i] = nextIndex;
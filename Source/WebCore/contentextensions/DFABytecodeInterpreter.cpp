@@ -151,7 +151,7 @@ DFABytecodeInterpreter::Actions DFABytecodeInterpreter::actionsMatchingEverythin
 
     // DFA header.
     uint32_t dfaBytecodeLength = getBits<uint32_t>(m_bytecode, m_bytecodeLength, 0);
-    uint32_t programCounter = sizeof(uint32_t);
+    uint32_t programCounter = DFAHeaderSize;
 
     while (programCounter < dfaBytecodeLength) {
         DFABytecodeInstruction instruction = getInstruction(m_bytecode, m_bytecodeLength, programCounter);
@@ -184,6 +184,15 @@ DFABytecodeInterpreter::Actions DFABytecodeInterpreter::interpret(const CString&
     ASSERT(url);
     
     Actions actions;
+
+    // The characters of the URL, with letters in lower case, to test against each DFA's required characters.
+    // The terminating null character is matched by end of string anchors.
+    DFARequiredCharacters urlCharacters = { 1, 0 };
+    for (const char* character = url; *character; ++character) {
+        uint8_t lowerCharacter = toASCIILower(*character);
+        if (lowerCharacter < 128)
+            urlCharacters[lowerCharacter / 64] |= static_cast<uint64_t>(1) << (lowerCharacter % 64);
+    }
     
     uint32_t programCounter = 0;
     while (programCounter < m_bytecodeLength) {
@@ -191,7 +200,15 @@ DFABytecodeInterpreter::Actions DFABytecodeInterpreter::interpret(const CString&
         // DFA header.
         uint32_t dfaStart = programCounter;
         uint32_t dfaBytecodeLength = getBits<uint32_t>(m_bytecode, m_bytecodeLength, programCounter);
-        programCounter += sizeof(uint32_t);
+        uint64_t requiredCharactersLow = getBits<uint64_t>(m_bytecode, m_bytecodeLength, programCounter + sizeof(DFAHeader));
+        uint64_t requiredCharactersHigh = getBits<uint64_t>(m_bytecode, m_bytecodeLength, programCounter + sizeof(DFAHeader) + sizeof(uint64_t));
+        programCounter += DFAHeaderSize;
+
+        // A DFA with actions on its root has no required characters.
+        if ((requiredCharactersLow & ~urlCharacters[0]) || (requiredCharactersHigh & ~urlCharacters[1])) {
+            programCounter = dfaStart + dfaBytecodeLength;
+            continue;
+        }
 
         // Skip the actions without flags on the DFA root. These are accessed via actionsMatchingEverything.
         if (!dfaStart) {
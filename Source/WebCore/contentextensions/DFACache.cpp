@@ -0,0 +1,127 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "DFACache.h"
+
+#if ENABLE(CONTENT_EXTENSIONS)
+
+#include <wtf/SHA1.h>
+
+namespace WebCore {
+
+namespace ContentExtensions {
+
+DFACache::DFACache()
+{
+}
+
+DFACache::~DFACache()
+{
+}
+
+template<typename T>
+static inline void addValue(SHA1& sha1, T value)
+{
+    sha1.addBytes(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+}
+
+String DFACache::key(const NFA& nfa, bool minimized)
+{
+    SHA1 sha1;
+    addValue(sha1, minimized);
+
+    addValue(sha1, nfa.nodes.size());
+    for (const ImmutableNFANode& node : nfa.nodes) {
+        addValue(sha1, node.rangesStart);
+        addValue(sha1, node.rangesEnd);
+        addValue(sha1, node.epsilonTransitionTargetsStart);
+        addValue(sha1, node.epsilonTransitionTargetsEnd);
+        addValue(sha1, node.actionStart);
+        addValue(sha1, node.actionEnd);
+    }
+
+    // ImmutableRange has padding, so hash its fields rather than its bytes.
+    addValue(sha1, nfa.transitions.size());
+    for (const ImmutableCharRange& range : nfa.transitions) {
+        addValue(sha1, range.targetStart);
+        addValue(sha1, range.targetEnd);
+        addValue(sha1, range.first);
+        addValue(sha1, range.last);
+    }
+
+    addValue(sha1, nfa.targets.size());
+    sha1.addBytes(reinterpret_cast<const uint8_t*>(nfa.targets.data()), nfa.targets.size() * sizeof(uint32_t));
+    addValue(sha1, nfa.epsilonTransitionsTargets.size());
+    sha1.addBytes(reinterpret_cast<const uint8_t*>(nfa.epsilonTransitionsTargets.data()), nfa.epsilonTransitionsTargets.size() * sizeof(uint32_t));
+    addValue(sha1, nfa.actions.size());
+    sha1.addBytes(reinterpret_cast<const uint8_t*>(nfa.actions.data()), nfa.actions.size() * sizeof(uint64_t));
+
+    SHA1::Digest digest;
+    sha1.computeHash(digest);
+    return String(SHA1::hexDigest(digest).data());
+}
+
+void DFACache::beginCompilation()
+{
+    m_hitCount = 0;
+    m_missCount = 0;
+    for (auto& entry : m_entries.values())
+        entry.wasUsed = false;
+}
+
+void DFACache::endCompilation()
+{
+    m_entries.removeIf([](HashMap<String, Entry>::KeyValuePairType& entry) {
+        return !entry.value.wasUsed;
+    });
+}
+
+const DFACache::Entry* DFACache::find(const String& key)
+{
+    auto iterator = m_entries.find(key);
+    if (iterator == m_entries.end()) {
+        ++m_missCount;
+        return nullptr;
+    }
+    ++m_hitCount;
+    iterator->value.wasUsed = true;
+    return &iterator->value;
+}
+
+void DFACache::add(const String& key, const DFA& dfa, bool isSmall)
+{
+    Entry entry;
+    entry.dfa = dfa;
+    entry.isSmall = isSmall;
+    entry.wasUsed = true;
+    m_entries.set(key, WTF::move(entry));
+}
+
+}
+
+} // namespace WebCore
+
+#endif // ENABLE(CONTENT_EXTENSIONS)
@@ -107,6 +107,15 @@ void CSSDefaultStyleSheets::initDefaultStyle(Element* root)
     }
 }
 
+void CSSDefaultStyleSheets::loadFullDefaultStyleIfNeeded()
+{
+    // Once the simple style is in use, replacing it is up to ensureDefaultStyleSheetsForElement, which
+    // lets the style resolver know.
+    if (defaultStyle)
+        return;
+    loadFullDefaultStyle();
+}
+
 void CSSDefaultStyleSheets::loadFullDefaultStyle()
 {
     if (simpleDefaultStyleSheet) {
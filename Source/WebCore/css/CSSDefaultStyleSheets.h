@@ -49,6 +49,8 @@ public:
     static void loadFullDefaultStyle();
     static void loadSimpleDefaultStyle();
     static void initDefaultStyle(Element*);
+    // Parses the full user agent style sheets ahead of the first document that needs them.
+    WEBCORE_EXPORT static void loadFullDefaultStyleIfNeeded();
 };
 
 } // namespace WebCore
@@ -271,6 +271,7 @@ CSSParserContext::CSSParserContext(CSSParserMode mode, const URL& baseURL)
     , needsSiteSpecificQuirks(false)
     , enforcesCSSMIMETypeInNoQuirksMode(true)
     , useLegacyBackgroundSizeShorthandBehavior(false)
+    , lazyStyleRuleParsingEnabled(false)
 {
 #if PLATFORM(IOS)
     // FIXME: Force the site specific quirk below to work on iOS. Investigating other site specific quirks
@@ -290,6 +291,7 @@ CSSParserContext::CSSParserContext(Document& document, const URL& baseURL, const
     , needsSiteSpecificQuirks(document.settings() ? document.settings()->needsSiteSpecificQuirks() : false)
     , enforcesCSSMIMETypeInNoQuirksMode(!document.settings() || document.settings()->enforceCSSMIMETypeInNoQuirksMode())
     , useLegacyBackgroundSizeShorthandBehavior(document.settings() ? document.settings()->useLegacyBackgroundSizeShorthandBehavior() : false)
+    , lazyStyleRuleParsingEnabled(document.settings() ? document.settings()->lazyStyleRuleParsingEnabled() : false)
 {
 #if PLATFORM(IOS)
     // FIXME: Force the site specific quirk below to work on iOS. Investigating other site specific quirks
@@ -309,7 +311,8 @@ bool operator==(const CSSParserContext& a, const CSSParserContext& b)
         && a.isCSSCompositingEnabled == b.isCSSCompositingEnabled
         && a.needsSiteSpecificQuirks == b.needsSiteSpecificQuirks
         && a.enforcesCSSMIMETypeInNoQuirksMode == b.enforcesCSSMIMETypeInNoQuirksMode
-        && a.useLegacyBackgroundSizeShorthandBehavior == b.useLegacyBackgroundSizeShorthandBehavior;
+        && a.useLegacyBackgroundSizeShorthandBehavior == b.useLegacyBackgroundSizeShorthandBehavior
+        && a.lazyStyleRuleParsingEnabled == b.lazyStyleRuleParsingEnabled;
 }
 
 CSSParser::CSSParser(const CSSParserContext& context)
@@ -333,6 +336,11 @@ CSSParser::CSSParser(const CSSParserContext& context)
     , m_propertyRange(UINT_MAX, UINT_MAX)
     , m_ruleSourceDataResult(nullptr)
     , m_parsingMode(NormalMode)
+    , m_declarationFastPathState(DeclarationFastPathState::Disabled)
+    , m_declarationFastPathNestingLevel(0)
+    , m_declarationBlockIsDeferred(false)
+    , m_deferredDeclarationBlockOffset(0)
+    , m_deferredDeclarationBlockLength(0)
     , m_is8BitSource(false)
     , m_currentCharacter8(nullptr)
     , m_currentCharacter16(nullptr)
@@ -395,6 +403,7 @@ void CSSParserString::lower()
 void CSSParser::setupParser(const char* prefix, unsigned prefixLength, StringView string, const char* suffix, unsigned suffixLength)
 {
     m_parsedTextPrefixLength = prefixLength;
+    m_declarationFastPathState = DeclarationFastPathState::Disabled;
     unsigned stringLength = string.length();
     unsigned length = stringLength + m_parsedTextPrefixLength + suffixLength + 1;
     m_length = length;
@@ -457,8 +466,12 @@ void CSSParser::parseSheet(StyleSheetContents* sheet, const String& string, cons
     m_sheetStartColumnNumber = textPosition.m_column.zeroBasedInt();
     m_lineNumber = m_sheetStartLineNumber;
     m_columnOffsetForLine = 0;
+    // The inspector needs the source ranges of every property, so it always parses eagerly.
+    if (m_context.lazyStyleRuleParsingEnabled && !ruleSourceDataResult)
+        m_deferredParser = CSSDeferredParser::create(m_context, string);
     setupParser("", string, "");
     cssyyparse(this);
+    m_deferredParser = nullptr;
     sheet->shrinkToFit();
     m_currentRuleDataStack.reset();
     m_ruleSourceDataResult = nullptr;
@@ -534,25 +547,33 @@ static bool validPrimitiveValueColor(CSSValueID valueID, bool strict = false)
         || (valueID >= CSSValueWebkitFocusRingColor && valueID < CSSValueWebkitText && !strict));
 }
 
-static CSSParser::ParseResult parseColorValue(MutableStyleProperties* declaration, CSSPropertyID propertyId, const String& string, bool important, CSSParserMode cssParserMode)
+static RefPtr<CSSValue> parseColorValue(CSSPropertyID propertyId, const CSSParserString& string, CSSParserMode cssParserMode)
 {
-    ASSERT(!string.isEmpty());
+    ASSERT(string.length());
     bool strict = isStrictParserMode(cssParserMode);
     if (!isColorPropertyID(propertyId))
-        return CSSParser::ParseResult::Error;
+        return nullptr;
+
+    CSSValueID valueID = cssValueKeywordID(string);
+    if (validPrimitiveValueColor(valueID, strict))
+        return CSSValuePool::singleton().createIdentifierValue(valueID);
 
-    CSSParserString cssString;
-    cssString.init(string);
-    CSSValueID valueID = cssValueKeywordID(cssString);
-    if (validPrimitiveValueColor(valueID, strict)) {
-        RefPtr<CSSValue> value = CSSValuePool::singleton().createIdentifierValue(valueID);
-        return declaration->addParsedProperty(CSSProperty(propertyId, value.release(), important)) ? CSSParser::ParseResult::Changed : CSSParser::ParseResult::Unchanged;
-    }
     RGBA32 color;
     if (!CSSParser::fastParseColor(color, string, strict && string[0] != '#'))
+        return nullptr;
+
+    return CSSValuePool::singleton().createColorValue(color);
+}
+
+static CSSParser::ParseResult parseColorValue(MutableStyleProperties* declaration, CSSPropertyID propertyId, const String& string, bool important, CSSParserMode cssParserMode)
+{
+    ASSERT(!string.isEmpty());
+    CSSParserString cssString;
+    cssString.init(string);
+    RefPtr<CSSValue> value = parseColorValue(propertyId, cssString, cssParserMode);
+    if (!value)
         return CSSParser::ParseResult::Error;
 
-    RefPtr<CSSValue> value = CSSValuePool::singleton().createColorValue(color);
     return declaration->addParsedProperty(CSSProperty(propertyId, value.release(), important)) ? CSSParser::ParseResult::Changed : CSSParser::ParseResult::Unchanged;
 }
 
@@ -632,12 +653,12 @@ static inline bool parseSimpleLength(const CharacterType* characters, unsigned&
     return ok;
 }
 
-static CSSParser::ParseResult parseSimpleLengthValue(MutableStyleProperties* declaration, CSSPropertyID propertyId, const String& string, bool important, CSSParserMode cssParserMode)
+static RefPtr<CSSValue> parseSimpleLengthValue(CSSPropertyID propertyId, const CSSParserString& string, CSSParserMode cssParserMode)
 {
-    ASSERT(!string.isEmpty());
+    ASSERT(string.length());
     bool acceptsNegativeNumbers;
     if (!isSimpleLengthPropertyID(propertyId, acceptsNegativeNumbers))
-        return CSSParser::ParseResult::Error;
+        return nullptr;
 
     unsigned length = string.length();
     double number;
@@ -645,23 +666,34 @@ static CSSParser::ParseResult parseSimpleLengthValue(MutableStyleProperties* dec
 
     if (string.is8Bit()) {
         if (!parseSimpleLength(string.characters8(), length, unit, number))
-            return CSSParser::ParseResult::Error;
+            return nullptr;
     } else {
         if (!parseSimpleLength(string.characters16(), length, unit, number))
-            return CSSParser::ParseResult::Error;
+            return nullptr;
     }
 
     if (unit == CSSPrimitiveValue::CSS_NUMBER) {
         if (number && isStrictParserMode(cssParserMode))
-            return CSSParser::ParseResult::Error;
+            return nullptr;
         unit = CSSPrimitiveValue::CSS_PX;
     }
     if (number < 0 && !acceptsNegativeNumbers)
-        return CSSParser::ParseResult::Error;
+        return nullptr;
     if (std::isinf(number))
+        return nullptr;
+
+    return CSSValuePool::singleton().createValue(number, unit);
+}
+
+static CSSParser::ParseResult parseSimpleLengthValue(MutableStyleProperties* declaration, CSSPropertyID propertyId, const String& string, bool important, CSSParserMode cssParserMode)
+{
+    ASSERT(!string.isEmpty());
+    CSSParserString cssString;
+    cssString.init(string);
+    RefPtr<CSSValue> value = parseSimpleLengthValue(propertyId, cssString, cssParserMode);
+    if (!value)
         return CSSParser::ParseResult::Error;
 
-    RefPtr<CSSValue> value = CSSValuePool::singleton().createValue(number, unit);
     return declaration->addParsedProperty(CSSProperty(propertyId, value.release(), important)) ? CSSParser::ParseResult::Changed : CSSParser::ParseResult::Unchanged;
 }
 
@@ -1202,40 +1234,44 @@ static inline bool isKeywordPropertyID(CSSPropertyID propertyId)
     }
 }
 
-static CSSParser::ParseResult parseKeywordValue(MutableStyleProperties* declaration, CSSPropertyID propertyId, const String& string, bool important, const CSSParserContext& parserContext, StyleSheetContents* styleSheetContents)
+static RefPtr<CSSValue> parseKeywordValue(CSSPropertyID propertyId, const CSSParserString& string, const CSSParserContext& parserContext, StyleSheetContents* styleSheetContents)
 {
-    ASSERT(!string.isEmpty());
+    ASSERT(string.length());
+
+    CSSValueID valueID = cssValueKeywordID(string);
+    if (!valueID)
+        return nullptr;
 
     if (!isKeywordPropertyID(propertyId)) {
         // All properties accept the values of "initial" and "inherit".
-        String lowerCaseString = string.lower();
-        if (lowerCaseString != "initial" && lowerCaseString != "inherit" && lowerCaseString != "unset" && lowerCaseString != "revert")
-            return CSSParser::ParseResult::Error;
+        if (valueID != CSSValueInitial && valueID != CSSValueInherit && valueID != CSSValueUnset && valueID != CSSValueRevert)
+            return nullptr;
 
         // Parse initial/inherit/unset/revert shorthands using the CSSParser.
         if (shorthandForProperty(propertyId).length())
-            return CSSParser::ParseResult::Error;
+            return nullptr;
     }
 
+    if (valueID == CSSValueInherit)
+        return CSSValuePool::singleton().createInheritedValue();
+    if (valueID == CSSValueInitial)
+        return CSSValuePool::singleton().createExplicitInitialValue();
+    if (valueID == CSSValueUnset)
+        return CSSValuePool::singleton().createUnsetValue();
+    if (valueID == CSSValueRevert)
+        return CSSValuePool::singleton().createRevertValue();
+    if (isValidKeywordPropertyAndValue(propertyId, valueID, parserContext, styleSheetContents))
+        return CSSValuePool::singleton().createIdentifierValue(valueID);
+    return nullptr;
+}
+
+static CSSParser::ParseResult parseKeywordValue(MutableStyleProperties* declaration, CSSPropertyID propertyId, const String& string, bool important, const CSSParserContext& parserContext, StyleSheetContents* styleSheetContents)
+{
+    ASSERT(!string.isEmpty());
     CSSParserString cssString;
     cssString.init(string);
-    CSSValueID valueID = cssValueKeywordID(cssString);
-
-    if (!valueID)
-        return CSSParser::ParseResult::Error;
-
-    RefPtr<CSSValue> value;
-    if (valueID == CSSValueInherit)
-        value = CSSValuePool::singleton().createInheritedValue();
-    else if (valueID == CSSValueInitial)
-        value = CSSValuePool::singleton().createExplicitInitialValue();
-    else if (valueID == CSSValueUnset)
-        value = CSSValuePool::singleton().createUnsetValue();
-    else if (valueID == CSSValueRevert)
-        value = CSSValuePool::singleton().createRevertValue();
-    else if (isValidKeywordPropertyAndValue(propertyId, valueID, parserContext, styleSheetContents))
-        value = CSSValuePool::singleton().createIdentifierValue(valueID);
-    else
+    RefPtr<CSSValue> value = parseKeywordValue(propertyId, cssString, parserContext, styleSheetContents);
+    if (!value)
         return CSSParser::ParseResult::Error;
 
     return declaration->addParsedProperty(CSSProperty(propertyId, value.release(), important)) ? CSSParser::ParseResult::Changed : CSSParser::ParseResult::Unchanged;
@@ -1503,6 +1539,12 @@ Ref<ImmutableStyleProperties> CSSParser::parseDeclaration(const String& string,
 }
 
 
+Ref<ImmutableStyleProperties> CSSDeferredParser::parseDeclarationBlock(unsigned offset, unsigned length) const
+{
+    // The block was checked not to need the style sheet when it was deferred.
+    return CSSParser(m_context).parseDeclaration(m_sheetText.substringSharingImpl(offset, length), nullptr);
+}
+
 bool CSSParser::parseDeclaration(MutableStyleProperties* declaration, const String& string, PassRefPtr<CSSRuleSourceData> prpRuleSourceData, StyleSheetContents* contextStyleSheet)
 {
     // Length of the "@-webkit-decls{" prefix.
@@ -1860,7 +1902,7 @@ inline Ref<CSSPrimitiveValue> CSSParser::createPrimitiveNumericValue(ValueWithCa
         || (value.unit >= CSSPrimitiveValue::CSS_TURN && value.unit <= CSSPrimitiveValue::CSS_CHS)
         || (value.unit >= CSSPrimitiveValue::CSS_VW && value.unit <= CSSPrimitiveValue::CSS_VMAX));
 #endif
-    return CSSValuePool::singleton().createValue(value.fValue, static_cast<CSSPrimitiveValue::UnitTypes>(value.unit));
+    return CSSValuePool::singleton().createSharedValue(value.fValue, static_cast<CSSPrimitiveValue::UnitTypes>(value.unit));
 }
 
 inline Ref<CSSPrimitiveValue> CSSParser::createPrimitiveStringValue(CSSParserValue& value)
@@ -12052,6 +12094,258 @@ inline void CSSParser::detectSupportsToken(int length)
     }
 }
 
+// Matches what the lexer reads as one number, percentage or px dimension token, optionally after a minus sign.
+template <typename CharacterType>
+static bool isSimpleLengthToken(const CharacterType* characters, unsigned length)
+{
+    unsigned i = 0;
+    if (characters[0] == '-')
+        ++i;
+    bool digitSeen = false;
+    bool dotSeen = false;
+    for (; i < length; ++i) {
+        if (isASCIIDigit(characters[i])) {
+            digitSeen = true;
+            continue;
+        }
+        if (characters[i] != '.' || dotSeen || i + 1 >= length || !isASCIIDigit(characters[i + 1]))
+            break;
+        dotSeen = true;
+    }
+    if (!digitSeen)
+        return false;
+
+    unsigned unitLength = length - i;
+    if (unitLength == 1)
+        return characters[i] == '%';
+    if (unitLength == 2)
+        return isASCIIAlphaCaselessEqual(characters[i], 'p') && isASCIIAlphaCaselessEqual(characters[i + 1], 'x');
+    return !unitLength;
+}
+
+RefPtr<CSSValue> CSSParser::parseSimpleDeclarationValue(CSSPropertyID propertyID, const CSSParserString& string)
+{
+    ASSERT(string.length());
+    UChar firstCharacter = string[0];
+    if (firstCharacter == '#')
+        return parseColorValue(propertyID, string, m_context.mode);
+
+    if (isASCIIAlpha(firstCharacter) || (firstCharacter == '-' && string.length() > 1 && isASCIIAlpha(string[1]))) {
+        if (RefPtr<CSSValue> value = parseColorValue(propertyID, string, m_context.mode))
+            return value;
+        return parseKeywordValue(propertyID, string, m_context, m_styleSheet);
+    }
+
+    // Anything else the lexer would split into several tokens, like 1e3px or a hashless color
+    // starting with a digit, is left to the grammar.
+    if (!(string.is8Bit() ? isSimpleLengthToken(string.characters8(), string.length()) : isSimpleLengthToken(string.characters16(), string.length())))
+        return nullptr;
+    return parseSimpleLengthValue(propertyID, string, m_context.mode);
+}
+
+template <typename CharacterType>
+static inline CharacterType* skipSpacesAndTabs(CharacterType* character)
+{
+    while (*character == ' ' || *character == '\t')
+        ++character;
+    return character;
+}
+
+template <typename SrcCharacterType>
+void CSSParser::consumeSimpleDeclarations()
+{
+    ASSERT(m_declarationFastPathState == DeclarationFastPathState::InDeclaration);
+    SrcCharacterType*& current = currentCharacter<SrcCharacterType>();
+
+    while (true) {
+        while (*current <= ' ' && typesOfASCIICharacters[*current] == CharacterWhiteSpace) {
+            if (*current == '\n') {
+                ++m_lineNumber;
+                m_columnOffsetForLine = currentCharacterOffset() + 1;
+            }
+            ++current;
+        }
+
+        // Only accept "name: value [!important]" where both parts are plain ASCII without escapes or
+        // comments, and the value is a single token. Anything else is left to the grammar.
+        SrcCharacterType* name = current;
+        SrcCharacterType* position = name;
+        if (*position == '-')
+            ++position;
+        if (!isASCIIAlpha(*position))
+            return;
+        while (isASCIIAlphanumeric(*position) || *position == '-')
+            ++position;
+        unsigned nameLength = position - name;
+
+        position = skipSpacesAndTabs(position);
+        if (*position != ':')
+            return;
+        position = skipSpacesAndTabs(position + 1);
+
+        SrcCharacterType* value = position;
+        while (isASCIIAlphanumeric(*position) || *position == '-' || *position == '.' || *position == '%' || *position == '#')
+            ++position;
+        unsigned valueLength = position - value;
+        if (!valueLength)
+            return;
+
+        position = skipSpacesAndTabs(position);
+        bool important = false;
+        if (*position == '!') {
+            if (!isEqualToCSSIdentifier(position + 1, "important"))
+                return;
+            important = true;
+            position = skipSpacesAndTabs(position + 10);
+        }
+        if (*position != ';' && *position != '}')
+            return;
+
+        CSSParserString nameString;
+        nameString.init(name, nameLength);
+        CSSPropertyID propertyID = cssPropertyID(nameString);
+        if (propertyID == CSSPropertyInvalid)
+            return;
+
+        CSSParserString valueString;
+        valueString.init(value, valueLength);
+        RefPtr<CSSValue> parsedValue = parseSimpleDeclarationValue(propertyID, valueString);
+        if (!parsedValue)
+            return;
+
+        addProperty(propertyID, parsedValue.release(), important);
+
+        // The closing brace is left for the grammar.
+        if (*position == '}') {
+            current = position;
+            return;
+        }
+        current = position + 1;
+    }
+}
+
+template <typename SrcCharacterType>
+void CSSParser::updateDeclarationFastPathState()
+{
+    // Only a semicolon outside of any parentheses or brackets starts a new declaration. Braces end
+    // the fast path for the rest of the block, since error recovery may have left the block.
+    switch (m_token) {
+    case ';':
+        if (!m_declarationFastPathNestingLevel)
+            m_declarationFastPathState = DeclarationFastPathState::AtDeclarationStart;
+        return;
+    case '[':
+        ++m_declarationFastPathNestingLevel;
+        return;
+    case ')':
+    case ']':
+        if (m_declarationFastPathNestingLevel)
+            --m_declarationFastPathNestingLevel;
+        return;
+    case '{':
+    case '}':
+    case TOKEN_EOF:
+        m_declarationFastPathState = DeclarationFastPathState::Disabled;
+        return;
+    default:
+        // '(' and all function tokens.
+        if (currentCharacter<SrcCharacterType>() > tokenStart<SrcCharacterType>() && currentCharacter<SrcCharacterType>()[-1] == '(')
+            ++m_declarationFastPathNestingLevel;
+        return;
+    }
+}
+
+template <typename CharacterType>
+static bool containsIgnoringASCIICase(const CharacterType* characters, unsigned length, const char* lowercaseString)
+{
+    unsigned stringLength = strlen(lowercaseString);
+    for (unsigned start = 0; start + stringLength <= length; ++start) {
+        unsigned i = 0;
+        while (i < stringLength && toASCIILower(characters[start + i]) == lowercaseString[i])
+            ++i;
+        if (i == stringLength)
+            return true;
+    }
+    return false;
+}
+
+template <typename SrcCharacterType>
+bool CSSParser::deferDeclarationBlock()
+{
+    // Only skip blocks that the grammar is known to end at the first closing brace: no strings or
+    // escapes that could hide a brace, no nested blocks, and parentheses that are balanced.
+    SrcCharacterType* start = currentCharacter<SrcCharacterType>();
+    SrcCharacterType* character = start;
+    SrcCharacterType* lastNewline = nullptr;
+    unsigned newlineCount = 0;
+    unsigned nestingLevel = 0;
+    bool hasContent = false;
+    while (*character != '}') {
+        switch (*character) {
+        case '\0':
+        case '"':
+        case '\'':
+        case '\\':
+        case '{':
+        case '[':
+        case ']':
+            return false;
+        case '(':
+            ++nestingLevel;
+            break;
+        case ')':
+            if (!nestingLevel)
+                return false;
+            --nestingLevel;
+            break;
+        case '\n':
+            ++newlineCount;
+            lastNewline = character;
+            break;
+        case '/':
+            if (character[1] == '*') {
+                character += 2;
+                while (character[0] != '*' || character[1] != '/') {
+                    if (!*character)
+                        return false;
+                    if (*character == '\n') {
+                        ++newlineCount;
+                        lastNewline = character;
+                    }
+                    ++character;
+                }
+                ++character;
+                break;
+            }
+            hasContent = true;
+            break;
+        default:
+            if (*character > ' ' || typesOfASCIICharacters[*character] != CharacterWhiteSpace)
+                hasContent = true;
+            break;
+        }
+        ++character;
+    }
+    if (nestingLevel || !hasContent)
+        return false;
+
+    // These may call StyleSheetContents::parserSetUsesStyleBasedEditability(), which has to happen
+    // while the sheet is parsed.
+    unsigned length = character - start;
+    if (containsIgnoringASCIICase(start, length, "user-modify") || containsIgnoringASCIICase(start, length, "user-select"))
+        return false;
+
+    unsigned startOffset = currentCharacterOffset();
+    if (newlineCount) {
+        m_lineNumber += newlineCount;
+        m_columnOffsetForLine = startOffset + (lastNewline - start) + 1;
+    }
+    m_deferredDeclarationBlockOffset = startOffset - m_parsedTextPrefixLength;
+    m_deferredDeclarationBlockLength = length;
+    currentCharacter<SrcCharacterType>() = character;
+    return true;
+}
+
 template <typename SrcCharacterType>
 int CSSParser::realLex(void* yylvalWithoutType)
 {
@@ -12068,6 +12362,11 @@ int CSSParser::realLex(void* yylvalWithoutType)
     yylval->string.clear();
 #endif
 
+    if (UNLIKELY(m_declarationFastPathState == DeclarationFastPathState::AtDeclarationStart)) {
+        m_declarationFastPathState = DeclarationFastPathState::InDeclaration;
+        consumeSimpleDeclarations<SrcCharacterType>();
+    }
+
 restartAfterComment:
     result = currentCharacter<SrcCharacterType>();
     setTokenStart(result);
@@ -12466,6 +12765,9 @@ restartAfterComment:
         break;
     }
 
+    if (UNLIKELY(m_declarationFastPathState != DeclarationFastPathState::Disabled))
+        updateDeclarationFastPathState<SrcCharacterType>();
+
     return token();
 }
 
@@ -12644,11 +12946,16 @@ RefPtr<StyleRuleBase> CSSParser::createStyleRule(Vector<std::unique_ptr<CSSParse
         m_allowNamespaceDeclarations = false;
         if (m_hasFontFaceOnlyValues)
             deleteFontFaceOnlyValues();
-        rule = StyleRule::create(m_lastSelectorLineNumber, createStyleProperties());
+        if (m_declarationBlockIsDeferred) {
+            ASSERT(m_parsedProperties.isEmpty());
+            rule = StyleRule::create(m_lastSelectorLineNumber, *m_deferredParser, m_deferredDeclarationBlockOffset, m_deferredDeclarationBlockLength);
+        } else
+            rule = StyleRule::create(m_lastSelectorLineNumber, createStyleProperties());
         rule->parserAdoptSelectorVector(*selectors);
         processAndAddNewRuleToSourceTreeIfNeeded();
     } else
         popRuleData();
+    m_declarationBlockIsDeferred = false;
     clearProperties();
     return rule;
 }
@@ -13011,6 +13318,21 @@ void CSSParser::markRuleBodyStart()
     m_currentRuleDataStack->last()->ruleBodyRange.start = offset;
 }
 
+void CSSParser::markDeclarationBlockStart()
+{
+    m_declarationBlockIsDeferred = false;
+    // Neither the deferred parser nor the fast path record property ranges.
+    if (isExtractingSourceData() || m_parsingMode != NormalMode || m_context.mode == SVGAttributeMode)
+        return;
+    if (m_deferredParser) {
+        m_declarationBlockIsDeferred = is8BitSource() ? deferDeclarationBlock<LChar>() : deferDeclarationBlock<UChar>();
+        if (m_declarationBlockIsDeferred)
+            return;
+    }
+    m_declarationFastPathState = DeclarationFastPathState::AtDeclarationStart;
+    m_declarationFastPathNestingLevel = 0;
+}
+
 void CSSParser::markRuleBodyEnd()
 {
     // Precondition: (!isExtractingSourceData())
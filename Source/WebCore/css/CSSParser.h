@@ -38,6 +38,7 @@
 #include <memory>
 #include <wtf/HashMap.h>
 #include <wtf/HashSet.h>
+#include <wtf/RefCounted.h>
 #include <wtf/Vector.h>
 #include <wtf/text/AtomicString.h>
 #include <wtf/text/TextPosition.h>
@@ -72,8 +73,31 @@ class StyleKeyframe;
 class StyleSheetContents;
 class StyledElement;
 
+// Keeps the text of a style sheet and the context it was parsed with, so that the declaration blocks
+// of its style rules can be parsed the first time they are needed.
+class CSSDeferredParser : public RefCounted<CSSDeferredParser> {
+public:
+    static Ref<CSSDeferredParser> create(const CSSParserContext& context, const String& sheetText)
+    {
+        return adoptRef(*new CSSDeferredParser(context, sheetText));
+    }
+
+    Ref<ImmutableStyleProperties> parseDeclarationBlock(unsigned offset, unsigned length) const;
+
+private:
+    CSSDeferredParser(const CSSParserContext& context, const String& sheetText)
+        : m_context(context)
+        , m_sheetText(sheetText)
+    {
+    }
+
+    CSSParserContext m_context;
+    String m_sheetText;
+};
+
 class CSSParser {
     friend inline int cssyylex(void*, CSSParser*);
+    friend class CSSDeferredParser;
 
 public:
     struct Location;
@@ -444,6 +468,7 @@ public:
 
     void markRuleBodyStart();
     void markRuleBodyEnd();
+    void markDeclarationBlockStart();
     void markPropertyStart();
     void markPropertyEnd(bool isImportantFound, bool isPropertyParsed);
     void processAndAddNewRuleToSourceTreeIfNeeded();
@@ -481,6 +506,14 @@ private:
     template <typename SourceCharacterType>
     int realLex(void* yylval);
 
+    template <typename SrcCharacterType>
+    void consumeSimpleDeclarations();
+    template <typename SrcCharacterType>
+    void updateDeclarationFastPathState();
+    template <typename SrcCharacterType>
+    bool deferDeclarationBlock();
+    RefPtr<CSSValue> parseSimpleDeclarationValue(CSSPropertyID, const CSSParserString&);
+
     UChar*& currentCharacter16();
 
     template <typename CharacterType>
@@ -611,6 +644,24 @@ private:
     };
 
     ParsingMode m_parsingMode;
+
+    // Inside a declaration block, the lexer consumes runs of declarations whose value is a single
+    // length, color or keyword itself and adds them to m_parsedProperties, so that the grammar
+    // only sees the declarations that need the full value parser.
+    enum class DeclarationFastPathState {
+        Disabled,
+        AtDeclarationStart,
+        InDeclaration
+    };
+    DeclarationFastPathState m_declarationFastPathState;
+    unsigned m_declarationFastPathNestingLevel;
+
+    // Set while parsing a style sheet whose style rule bodies are parsed when first used.
+    RefPtr<CSSDeferredParser> m_deferredParser;
+    bool m_declarationBlockIsDeferred;
+    unsigned m_deferredDeclarationBlockOffset;
+    unsigned m_deferredDeclarationBlockLength;
+
     bool m_is8BitSource;
     std::unique_ptr<LChar[]> m_dataStart8;
     std::unique_ptr<UChar[]> m_dataStart16;
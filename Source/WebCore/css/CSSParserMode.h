@@ -69,6 +69,7 @@ public:
     bool needsSiteSpecificQuirks;
     bool enforcesCSSMIMETypeInNoQuirksMode;
     bool useLegacyBackgroundSizeShorthandBehavior;
+    bool lazyStyleRuleParsingEnabled;
 };
 
 bool operator==(const CSSParserContext&, const CSSParserContext&);
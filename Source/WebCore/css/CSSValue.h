@@ -40,6 +40,7 @@ enum CSSPropertyID : uint16_t;
 
 // Please don't expose more CSSValue types to the web.
 class CSSValue : public RefCounted<CSSValue> {
+    WTF_MAKE_ISOLATED_ALLOCATED(CSSValues);
 public:
     enum Type {
         CSS_INHERIT = 0,
@@ -121,6 +121,25 @@ Ref<CSSPrimitiveValue> CSSValuePool::createValue(double value, CSSPrimitiveValue
     return *cache[intValue];
 }
 
+Ref<CSSPrimitiveValue> CSSValuePool::createSharedValue(double value, CSSPrimitiveValue::UnitTypes type)
+{
+    ASSERT(std::isfinite(value));
+
+    if (value >= 0 && value <= maximumCacheableIntegerValue && value == static_cast<int>(value)
+        && (type == CSSPrimitiveValue::CSS_PX || type == CSSPrimitiveValue::CSS_PERCENTAGE || type == CSSPrimitiveValue::CSS_NUMBER))
+        return createValue(value, type);
+
+    // Remove one entry at random if the cache grows too large.
+    const int maximumNumericValueCacheSize = 512;
+    if (m_numericValueCache.size() >= maximumNumericValueCacheSize)
+        m_numericValueCache.remove(m_numericValueCache.begin());
+
+    NumericValueCache::AddResult entry = m_numericValueCache.add(std::make_pair(value, static_cast<unsigned>(type)), nullptr);
+    if (entry.isNewEntry)
+        entry.iterator->value = CSSPrimitiveValue::create(value, type);
+    return *entry.iterator->value;
+}
+
 Ref<CSSPrimitiveValue> CSSValuePool::createFontFamilyValue(const String& familyName, FromSystemFontID fromSystemFontID)
 {
     // Remove one entry at random if the cache grows too large.
@@ -151,6 +170,7 @@ PassRefPtr<CSSValueList> CSSValuePool::createFontFaceValue(const AtomicString& s
 void CSSValuePool::drain()
 {
     m_colorValueCache.clear();
+    m_numericValueCache.clear();
     m_fontFaceValueCache.clear();
     m_fontFamilyValueCache.clear();
 
@@ -62,6 +62,9 @@ public:
     Ref<CSSPrimitiveValue> createIdentifierValue(CSSPropertyID identifier);
     Ref<CSSPrimitiveValue> createColorValue(unsigned rgbValue);
     Ref<CSSPrimitiveValue> createValue(double value, CSSPrimitiveValue::UnitTypes);
+    // Like createValue(), but also shares values that aren't small integers, like 1.5em. Meant for
+    // values held by style sheets, where the same numbers recur across many declarations.
+    Ref<CSSPrimitiveValue> createSharedValue(double value, CSSPrimitiveValue::UnitTypes);
     Ref<CSSPrimitiveValue> createValue(const String& value, CSSPrimitiveValue::UnitTypes type) { return CSSPrimitiveValue::create(value, type); }
     Ref<CSSPrimitiveValue> createValue(const Length& value, const RenderStyle& style) { return CSSPrimitiveValue::create(value, style); }
     Ref<CSSPrimitiveValue> createValue(const LengthSize& value, const RenderStyle& style) { return CSSPrimitiveValue::create(value, style); }
@@ -92,6 +95,9 @@ private:
     RefPtr<CSSPrimitiveValue> m_percentValueCache[maximumCacheableIntegerValue + 1];
     RefPtr<CSSPrimitiveValue> m_numberValueCache[maximumCacheableIntegerValue + 1];
 
+    typedef HashMap<std::pair<double, unsigned>, RefPtr<CSSPrimitiveValue>> NumericValueCache;
+    NumericValueCache m_numericValueCache;
+
     typedef HashMap<AtomicString, RefPtr<CSSValueList>> FontFaceValueCache;
     FontFaceValueCache m_fontFaceValueCache;
 
@@ -41,9 +41,11 @@
 #include "SVGElement.h"
 #include "SelectorCompiler.h"
 #include "ShadowRoot.h"
+#include "StyleCostProfile.h"
 #include "StyleProperties.h"
 #include "StyledElement.h"
 
+#include <wtf/CurrentTime.h>
 #include <wtf/TemporaryChange.h>
 
 namespace WebCore {
@@ -346,20 +348,30 @@ void ElementRuleCollector::collectMatchingRulesForList(const RuleSet::RuleDataVe
     if (!rules)
         return;
 
+    // Mirrors the local name comparison in SelectorChecker's tagMatches().
+    bool usesLowercaseTagNames = m_element.isHTMLElement() && m_element.document().isHTMLDocument();
+    const AtomicString& localName = m_element.localName();
+
     for (unsigned i = 0, size = rules->size(); i < size; ++i) {
         const RuleData& ruleData = rules->data()[i];
 
         if (!ruleData.canMatchPseudoElement() && m_pseudoStyleRequest.pseudoId != NOPSEUDO)
             continue;
 
+        if (const CSSSelector* tagSelector = ruleData.rightmostTagSelector()) {
+            if ((usesLowercaseTagNames ? tagSelector->tagLowercaseLocalName() : tagSelector->tagQName().localName()) != localName)
+                continue;
+        }
+
         if (m_canUseFastReject && m_selectorFilter.fastRejectSelector<RuleData::maximumIdentifierCount>(ruleData.descendantSelectorIdentifierHashes()))
             continue;
 
         StyleRule* rule = ruleData.rule();
 
         // If the rule has no properties to apply, then ignore it in the non-debug mode.
-        const StyleProperties& properties = rule->properties();
-        if (properties.isEmpty() && !matchRequest.includeEmptyRules)
+        // A deferred declaration block is only parsed once its rule matches.
+        bool hasDeferredProperties = rule->hasDeferredProperties();
+        if (!hasDeferredProperties && rule->properties().isEmpty() && !matchRequest.includeEmptyRules)
             continue;
 
         // FIXME: Exposing the non-standard getMatchedCSSRules API to web is the only reason this is needed.
@@ -367,7 +379,11 @@ void ElementRuleCollector::collectMatchingRulesForList(const RuleSet::RuleDataVe
             continue;
 
         unsigned specificity;
-        if (ruleMatches(ruleData, specificity)) {
+        bool matches = UNLIKELY(m_costProfile) ? ruleMatchesWithCostProfile(ruleData, specificity) : ruleMatches(ruleData, specificity);
+        if (matches) {
+            if (hasDeferredProperties && rule->properties().isEmpty() && !matchRequest.includeEmptyRules)
+                continue;
+
             // Update our first/last rule indices in the matched rules array.
             ++ruleRange.lastRuleIndex;
             if (ruleRange.firstRuleIndex == -1)
@@ -379,6 +395,22 @@ void ElementRuleCollector::collectMatchingRulesForList(const RuleSet::RuleDataVe
     }
 }
 
+bool ElementRuleCollector::ruleMatchesWithCostProfile(const RuleData& ruleData, unsigned& specificity)
+{
+    if (!m_costProfile->shouldTimeNextRuleMatch()) {
+        bool matches = ruleMatches(ruleData, specificity);
+        m_costProfile->didMatchRule(*ruleData.rule(), matches);
+        return matches;
+    }
+
+    double startTime = monotonicallyIncreasingTime();
+    bool matches = ruleMatches(ruleData, specificity);
+    double elapsedTime = monotonicallyIncreasingTime() - startTime;
+    m_costProfile->didMatchRule(*ruleData.rule(), matches);
+    m_costProfile->didTimeRuleMatch(*ruleData.rule(), elapsedTime);
+    return matches;
+}
+
 static inline bool compareRules(MatchedRule r1, MatchedRule r2)
 {
     unsigned specificity1 = r1.specificity;
@@ -38,6 +38,10 @@ class RuleData;
 class RuleSet;
 class SelectorFilter;
 
+namespace Style {
+class CostProfile;
+}
+
 struct MatchedRule {
     const RuleData* ruleData;
     unsigned specificity;
@@ -51,6 +55,7 @@ public:
         , m_ruleSets(ruleSets)
         , m_selectorFilter(selectorFilter)
         , m_canUseFastReject(m_selectorFilter.parentStackIsConsistent(element.parentNode()))
+        , m_costProfile(element.document().styleCostProfile())
     {
     }
 
@@ -85,6 +90,7 @@ private:
     void collectMatchingRulesForRegion(const MatchRequest&, StyleResolver::RuleRange&);
     void collectMatchingRulesForList(const RuleSet::RuleDataVector*, const MatchRequest&, StyleResolver::RuleRange&);
     bool ruleMatches(const RuleData&, unsigned &specificity);
+    bool ruleMatchesWithCostProfile(const RuleData&, unsigned &specificity);
 
     void sortMatchedRules();
     void sortAndTransferMatchedRules();
@@ -102,6 +108,7 @@ private:
     bool m_sameOriginOnly { false };
     SelectorChecker::Mode m_mode { SelectorChecker::Mode::ResolvingStyle };
     bool m_canUseFastReject;
+    Style::CostProfile* m_costProfile;
 
     Vector<MatchedRule, 64> m_matchedRules;
 
@@ -79,10 +79,90 @@ void RuleFeatureSet::collectFeaturesFromSelector(const CSSSelector& firstSelecto
     recursivelyCollectFeaturesFromSelector(*this, firstSelector, hasSiblingSelector);
 }
 
+static bool subjectCompoundStylesOtherElements(const CSSSelector& rootSelector)
+{
+    for (const CSSSelector* selector = &rootSelector; selector; selector = selector->tagHistory()) {
+        if (selector->match() == CSSSelector::PseudoElement) {
+            switch (selector->pseudoElementType()) {
+            case CSSSelector::PseudoElementBefore:
+            case CSSSelector::PseudoElementAfter:
+                break;
+            default:
+                return true;
+            }
+        }
+        if (selector->relation() != CSSSelector::SubSelector)
+            break;
+    }
+    return false;
+}
+
+static void collectClassesRequiringSubtreeInvalidation(RuleFeatureSet& features, const CSSSelector& rootSelector)
+{
+    for (const CSSSelector* selector = &rootSelector; selector; selector = selector->tagHistory()) {
+        if (selector->match() == CSSSelector::Class)
+            features.classesRequiringSubtreeInvalidation.add(selector->value().impl());
+        if (const CSSSelectorList* selectorList = selector->selectorList()) {
+            for (const CSSSelector* subSelector = selectorList->first(); subSelector; subSelector = CSSSelectorList::next(subSelector))
+                collectClassesRequiringSubtreeInvalidation(features, *subSelector);
+        }
+    }
+}
+
+void RuleFeatureSet::collectClassInvalidationFeatures(const CSSSelector& rootSelector, const RuleFeature& ruleFeature)
+{
+    enum class MatchElement { Subject, Ancestor, Other };
+    MatchElement matchElement = subjectCompoundStylesOtherElements(rootSelector) ? MatchElement::Other : MatchElement::Subject;
+
+    for (const CSSSelector* selector = &rootSelector; selector; selector = selector->tagHistory()) {
+        if (selector->match() == CSSSelector::Class) {
+            switch (matchElement) {
+            case MatchElement::Subject:
+                break;
+            case MatchElement::Ancestor: {
+                auto& rules = ancestorClassRules.add(selector->value().impl(), nullptr).iterator->value;
+                if (!rules)
+                    rules = std::make_unique<Vector<RuleFeature>>();
+                rules->append(ruleFeature);
+                break;
+            }
+            case MatchElement::Other:
+                classesRequiringSubtreeInvalidation.add(selector->value().impl());
+                break;
+            }
+        }
+
+        if (const CSSSelectorList* selectorList = selector->selectorList()) {
+            for (const CSSSelector* subSelector = selectorList->first(); subSelector; subSelector = CSSSelectorList::next(subSelector))
+                collectClassesRequiringSubtreeInvalidation(*this, *subSelector);
+        }
+
+        switch (selector->relation()) {
+        case CSSSelector::SubSelector:
+            break;
+        case CSSSelector::Descendant:
+        case CSSSelector::Child:
+            if (matchElement == MatchElement::Subject)
+                matchElement = MatchElement::Ancestor;
+            break;
+        default:
+            matchElement = MatchElement::Other;
+            break;
+        }
+    }
+}
+
 void RuleFeatureSet::add(const RuleFeatureSet& other)
 {
     idsInRules.add(other.idsInRules.begin(), other.idsInRules.end());
     classesInRules.add(other.classesInRules.begin(), other.classesInRules.end());
+    for (auto& keyValue : other.ancestorClassRules) {
+        auto& rules = ancestorClassRules.add(keyValue.key, nullptr).iterator->value;
+        if (!rules)
+            rules = std::make_unique<Vector<RuleFeature>>();
+        rules->appendVector(*keyValue.value);
+    }
+    classesRequiringSubtreeInvalidation.add(other.classesRequiringSubtreeInvalidation.begin(), other.classesRequiringSubtreeInvalidation.end());
     attributeCanonicalLocalNamesInRules.add(other.attributeCanonicalLocalNamesInRules.begin(), other.attributeCanonicalLocalNamesInRules.end());
     attributeLocalNamesInRules.add(other.attributeLocalNamesInRules.begin(), other.attributeLocalNamesInRules.end());
     siblingRules.appendVector(other.siblingRules);
@@ -95,6 +175,8 @@ void RuleFeatureSet::clear()
 {
     idsInRules.clear();
     classesInRules.clear();
+    ancestorClassRules.clear();
+    classesRequiringSubtreeInvalidation.clear();
     attributeCanonicalLocalNamesInRules.clear();
     attributeLocalNamesInRules.clear();
     siblingRules.clear();
@@ -107,6 +189,8 @@ void RuleFeatureSet::shrinkToFit()
 {
     siblingRules.shrinkToFit();
     uncommonAttributeRules.shrinkToFit();
+    for (auto& rules : ancestorClassRules.values())
+        rules->shrinkToFit();
 }
 
 } // namespace WebCore
@@ -54,9 +54,16 @@ struct RuleFeatureSet {
     void clear();
     void shrinkToFit();
     void collectFeaturesFromSelector(const CSSSelector&, bool& hasSiblingSelector);
+    void collectClassInvalidationFeatures(const CSSSelector&, const RuleFeature&);
 
     HashSet<AtomicStringImpl*> idsInRules;
     HashSet<AtomicStringImpl*> classesInRules;
+    // Classes used in ancestor compounds of descendant and child selectors, with the rules using them.
+    // Changing one of these on an element only requires restyling the descendants matching the rules.
+    HashMap<AtomicStringImpl*, std::unique_ptr<Vector<RuleFeature>>> ancestorClassRules;
+    // Classes used in sibling or shadow tree selectors, in selector lists of pseudo classes, or with
+    // pseudo elements that style descendants. Changing one of these restyles the element's subtree.
+    HashSet<AtomicStringImpl*> classesRequiringSubtreeInvalidation;
     HashSet<AtomicStringImpl*> attributeCanonicalLocalNamesInRules;
     HashSet<AtomicStringImpl*> attributeLocalNamesInRules;
     Vector<RuleFeature> siblingRules;
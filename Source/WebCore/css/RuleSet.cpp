@@ -153,6 +153,22 @@ static inline PropertyWhitelistType determinePropertyWhitelistType(const AddRule
     return PropertyWhitelistNone;
 }
 
+static unsigned computeRightmostTagSelectorOffset(const CSSSelector& rootSelector)
+{
+    unsigned offset = 0;
+    for (const CSSSelector* selector = &rootSelector; selector; selector = selector->tagHistory(), ++offset) {
+        if (selector->match() == CSSSelector::Tag) {
+            const QualifiedName& tagQName = selector->tagQName();
+            if (tagQName == anyQName() || tagQName.localName() == starAtom || offset >= RuleData::maximumRightmostTagSelectorOffset)
+                return 0;
+            return offset + 1;
+        }
+        if (selector->relation() != CSSSelector::SubSelector)
+            return 0;
+    }
+    return 0;
+}
+
 RuleData::RuleData(StyleRule* rule, unsigned selectorIndex, unsigned position, AddRuleFlags addRuleFlags)
     : m_rule(rule)
     , m_selectorIndex(selectorIndex)
@@ -163,6 +179,7 @@ RuleData::RuleData(StyleRule* rule, unsigned selectorIndex, unsigned position, A
     , m_containsUncommonAttributeSelector(WebCore::containsUncommonAttributeSelector(*selector()))
     , m_linkMatchType(SelectorChecker::determineLinkMatchType(selector()))
     , m_propertyWhitelistType(determinePropertyWhitelistType(addRuleFlags, selector()))
+    , m_rightmostTagSelectorOffset(computeRightmostTagSelectorOffset(*selector()))
 #if ENABLE(CSS_SELECTOR_JIT) && CSS_SELECTOR_JIT_PROFILING
     , m_compiledSelectorUseCount(0)
 #endif
@@ -176,6 +193,7 @@ static void collectFeaturesFromRuleData(RuleFeatureSet& features, const RuleData
 {
     bool hasSiblingSelector;
     features.collectFeaturesFromSelector(*ruleData.selector(), hasSiblingSelector);
+    features.collectClassInvalidationFeatures(*ruleData.selector(), RuleFeature(ruleData.rule(), ruleData.selectorIndex(), ruleData.hasDocumentSecurityOrigin()));
 
     if (hasSiblingSelector)
         features.siblingRules.append(RuleFeature(ruleData.rule(), ruleData.selectorIndex(), ruleData.hasDocumentSecurityOrigin()));
@@ -84,6 +84,11 @@ public:
     static const unsigned maximumIdentifierCount = 4;
     const unsigned* descendantSelectorIdentifierHashes() const { return m_descendantSelectorIdentifierHashes; }
 
+    // The tag selector of the rightmost compound selector, if any. Rules sharing a bucket often differ
+    // by tag only, so ElementRuleCollector checks it before calling into the selector checker.
+    const CSSSelector* rightmostTagSelector() const { return m_rightmostTagSelectorOffset ? selector() + m_rightmostTagSelectorOffset - 1 : nullptr; }
+    static const unsigned maximumRightmostTagSelectorOffset = 127;
+
 #if ENABLE(CSS_SELECTOR_JIT)
     SelectorCompilationStatus compilationStatus() const { return m_compilationStatus; }
     JSC::MacroAssemblerCodeRef compiledSelectorCodeRef() const { return m_compiledSelectorCodeRef; }
@@ -114,6 +119,7 @@ private:
     unsigned m_containsUncommonAttributeSelector : 1;
     unsigned m_linkMatchType : 2; //  SelectorChecker::LinkMatchMask
     unsigned m_propertyWhitelistType : 2;
+    unsigned m_rightmostTagSelectorOffset : 7; // Offset from selector() plus one, 0 if there is none.
     // Use plain array instead of a Vector to minimize memory overhead.
     unsigned m_descendantSelectorIdentifierHashes[maximumIdentifierCount];
 #if ENABLE(CSS_SELECTOR_JIT)
@@ -102,6 +102,34 @@ void SelectorFilter::setupParentStack(Element* parent)
         pushParentStackFrame(ancestors[n - 1]);
 }
 
+void SelectorFilter::updateParentStack(Element* parent)
+{
+    ASSERT(m_parentStack.isEmpty() == !m_ancestorIdentifierFilter);
+    Vector<Element*, 30> ancestors;
+    for (Element* ancestor = parent; ancestor; ancestor = ancestor->parentOrShadowHostElement())
+        ancestors.append(ancestor);
+
+    size_t sharedFrameCount = 0;
+    size_t ancestorCount = ancestors.size();
+    while (sharedFrameCount < m_parentStack.size() && sharedFrameCount < ancestorCount && m_parentStack[sharedFrameCount].element == ancestors[ancestorCount - sharedFrameCount - 1])
+        ++sharedFrameCount;
+    if (!sharedFrameCount) {
+        setupParentStack(parent);
+        return;
+    }
+
+    while (m_parentStack.size() > sharedFrameCount)
+        popParentStackFrame();
+    for (size_t n = ancestorCount - sharedFrameCount; n; --n)
+        pushParentStackFrame(ancestors[n - 1]);
+}
+
+void SelectorFilter::clearParentStack()
+{
+    m_parentStack.clear();
+    m_ancestorIdentifierFilter = nullptr;
+}
+
 void SelectorFilter::pushParent(Element* parent)
 {
     ASSERT(m_ancestorIdentifierFilter);
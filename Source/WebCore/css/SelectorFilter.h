@@ -44,6 +44,9 @@ public:
     void popParentStackFrame();
 
     void setupParentStack(Element* parent);
+    // Like setupParentStack(), but keeps the frames of the ancestors that are already on the stack.
+    void updateParentStack(Element* parent);
+    void clearParentStack();
     void pushParent(Element* parent);
     void popParent() { popParentStackFrame(); }
     bool parentStackIsEmpty() const { return m_parentStack.isEmpty(); }
@@ -28,6 +28,7 @@
 
 #include "CSSSelectorList.h"
 #include "Document.h"
+#include "ElementChildIterator.h"
 #include "ElementIterator.h"
 #include "ElementRuleCollector.h"
 #include "SelectorFilter.h"
@@ -87,6 +88,15 @@ StyleInvalidationAnalysis::StyleInvalidationAnalysis(const Vector<StyleSheetCont
     m_hasShadowPseudoElementRulesInAuthorSheet = m_ruleSets.authorStyle()->hasShadowPseudoElementRules();
 }
 
+StyleInvalidationAnalysis::StyleInvalidationAnalysis(const Vector<RuleFeature>& rules)
+{
+    m_ruleSets.resetAuthorStyle();
+    for (auto& rule : rules)
+        m_ruleSets.authorStyle()->addRule(rule.rule, rule.selectorIndex, rule.hasDocumentSecurityOrigin ? RuleHasDocumentSecurityOrigin : RuleHasNoSpecialState);
+
+    m_hasShadowPseudoElementRulesInAuthorSheet = m_ruleSets.authorStyle()->hasShadowPseudoElementRules();
+}
+
 StyleInvalidationAnalysis::CheckDescendants StyleInvalidationAnalysis::invalidateIfNeeded(Element& element, SelectorFilter& filter)
 {
     if (m_hasShadowPseudoElementRulesInAuthorSheet) {
@@ -101,8 +111,10 @@ StyleInvalidationAnalysis::CheckDescendants StyleInvalidationAnalysis::invalidat
         ruleCollector.setMode(SelectorChecker::Mode::CollectingRulesIgnoringVirtualPseudoElements);
         ruleCollector.matchAuthorRules(false);
 
-        if (ruleCollector.hasMatchedRules())
+        if (ruleCollector.hasMatchedRules()) {
             element.setNeedsStyleRecalc(InlineStyleChange);
+            ++m_invalidatedElementCount;
+        }
         return CheckDescendants::Yes;
     }
     case InlineStyleChange:
@@ -167,4 +179,14 @@ void StyleInvalidationAnalysis::invalidateStyle(Document& document)
     invalidateStyleForTree(*documentElement, filter);
 }
 
+void StyleInvalidationAnalysis::invalidateDescendantStyle(Element& root)
+{
+    ASSERT(!m_dirtiesAllStyle);
+
+    SelectorFilter filter;
+    filter.setupParentStack(&root);
+    for (auto& child : childrenOfType<Element>(root))
+        invalidateStyleForTree(child, filter);
+}
+
 }
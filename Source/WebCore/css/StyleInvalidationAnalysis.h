@@ -35,14 +35,19 @@ namespace WebCore {
 class Document;
 class SelectorFilter;
 class StyleSheetContents;
+struct RuleFeature;
 
 class StyleInvalidationAnalysis {
 public:
     StyleInvalidationAnalysis(const Vector<StyleSheetContents*>&, const MediaQueryEvaluator&);
+    explicit StyleInvalidationAnalysis(const Vector<RuleFeature>&);
 
     bool dirtiesAllStyle() const { return m_dirtiesAllStyle; }
     bool hasShadowPseudoElementRulesInAuthorSheet() const { return m_hasShadowPseudoElementRulesInAuthorSheet; }
     void invalidateStyle(Document&);
+    void invalidateDescendantStyle(Element&);
+
+    unsigned invalidatedElementCount() const { return m_invalidatedElementCount; }
 
 private:
     enum class CheckDescendants { Yes, No };
@@ -51,6 +56,7 @@ private:
 
     bool m_dirtiesAllStyle { false };
     bool m_hasShadowPseudoElementRulesInAuthorSheet { false };
+    unsigned m_invalidatedElementCount { 0 };
     DocumentRuleSets m_ruleSets;
 };
 
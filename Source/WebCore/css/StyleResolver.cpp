@@ -117,6 +117,7 @@
 #include "ShadowRoot.h"
 #include "StyleBuilder.h"
 #include "StyleCachedImage.h"
+#include "StyleCostProfile.h"
 #include "StyleFontSizeFunctions.h"
 #include "StyleGeneratedImage.h"
 #include "StylePendingImage.h"
@@ -315,6 +316,25 @@ void StyleResolver::popParentElement(Element* parent)
         m_selectorFilter.popParent();
 }
 
+const SelectorFilter& StyleResolver::selectorFilterForElement(const Element& element)
+{
+    if (m_selectorFilter.parentStackIsConsistent(element.parentNode()))
+        return m_selectorFilter;
+
+    // Resolution entered the tree somewhere the tree walk didn't push. Rather than giving up on fast
+    // rejection, bring the second filter up to the element's parent, reusing the ancestor frames
+    // from the previous such request (siblings and cousins are typically resolved one after another).
+    Element* parent = element.parentElement();
+    if (!parent)
+        return m_selectorFilter;
+    if (m_outOfOrderSelectorFilterDOMTreeVersion != m_document.domTreeVersion()) {
+        m_outOfOrderSelectorFilter.clearParentStack();
+        m_outOfOrderSelectorFilterDOMTreeVersion = m_document.domTreeVersion();
+    }
+    m_outOfOrderSelectorFilter.updateParentStack(parent);
+    return m_outOfOrderSelectorFilter;
+}
+
 // This is a simplified style setting function for keyframe styles
 void StyleResolver::addKeyframeStyle(PassRefPtr<StyleRuleKeyframes> rule)
 {
@@ -739,6 +759,9 @@ Ref<RenderStyle> StyleResolver::styleForElement(Element* element, RenderStyle* d
         return *s_styleNotYetAvailable;
     }
 
+    if (auto* costProfile = document().styleCostProfile())
+        costProfile->didResolveElement(*element);
+
     State& state = m_state;
     initElement(element);
     state.initForStyleResolve(document(), element, defaultParent, regionForStyling);
@@ -773,7 +796,7 @@ Ref<RenderStyle> StyleResolver::styleForElement(Element* element, RenderStyle* d
     if (needsCollection)
         m_ruleSets.collectFeatures();
 
-    ElementRuleCollector collector(*element, state.style(), m_ruleSets, m_selectorFilter);
+    ElementRuleCollector collector(*element, state.style(), m_ruleSets, selectorFilterForElement(*element));
     collector.setRegionForStyling(regionForStyling);
     collector.setMedium(m_medium.get());
 
@@ -790,6 +813,9 @@ Ref<RenderStyle> StyleResolver::styleForElement(Element* element, RenderStyle* d
     if (state.style()->hasViewportUnits())
         document().setHasStyleWithViewportUnits();
 
+    // Elements matching different rules, and elements in other documents, often end up with equal rare data.
+    state.style()->shareRareDataWithEquivalentStyles();
+
     state.clear(); // Clear out for the next resolve.
 
     // Now return the style.
@@ -939,7 +965,7 @@ PassRefPtr<RenderStyle> StyleResolver::pseudoStyleForElement(Element* element, c
     // those rules.
 
     // Check UA, user and author rules.
-    ElementRuleCollector collector(*element, m_state.style(), m_ruleSets, m_selectorFilter);
+    ElementRuleCollector collector(*element, m_state.style(), m_ruleSets, selectorFilterForElement(*element));
     collector.setPseudoStyleRequest(pseudoStyleRequest);
     collector.setMedium(m_medium.get());
     collector.matchUARules();
@@ -174,6 +174,7 @@ public:
     DocumentRuleSets& ruleSets() { return m_ruleSets; }
     const DocumentRuleSets& ruleSets() const { return m_ruleSets; }
     SelectorFilter& selectorFilter() { return m_selectorFilter; }
+    const SelectorFilter& selectorFilterForElement(const Element&);
 
     const MediaQueryEvaluator& mediaQueryEvaluator() const { return *m_medium; }
 
@@ -573,6 +574,10 @@ private:
 
     Document& m_document;
     SelectorFilter m_selectorFilter;
+    // Covers elements resolved outside the tree walk that maintains m_selectorFilter, like the computed
+    // style of an element without a renderer. Its frames stay valid until the DOM changes.
+    SelectorFilter m_outOfOrderSelectorFilter;
+    uint64_t m_outOfOrderSelectorFilterDOMTreeVersion { 0 };
 
     bool m_matchAuthorAndUserStyles;
 
@@ -29,6 +29,7 @@
 #include "CSSKeyframesRule.h"
 #include "CSSMediaRule.h"
 #include "CSSPageRule.h"
+#include "CSSParser.h"
 #include "CSSStyleRule.h"
 #include "CSSSupportsRule.h"
 #include "CSSUnknownRule.h"
@@ -201,22 +202,46 @@ StyleRule::StyleRule(int sourceLine, Ref<StyleProperties>&& properties)
 {
 }
 
+StyleRule::StyleRule(int sourceLine, CSSDeferredParser& deferredParser, unsigned declarationsOffset, unsigned declarationsLength)
+    : StyleRuleBase(Style, sourceLine)
+    , m_deferredParser(&deferredParser)
+    , m_deferredDeclarationsOffset(declarationsOffset)
+    , m_deferredDeclarationsLength(declarationsLength)
+{
+}
+
 StyleRule::StyleRule(const StyleRule& o)
     : StyleRuleBase(o)
-    , m_properties(o.m_properties->mutableCopy())
     , m_selectorList(o.m_selectorList)
+    , m_deferredParser(o.m_deferredParser)
+    , m_deferredDeclarationsOffset(o.m_deferredDeclarationsOffset)
+    , m_deferredDeclarationsLength(o.m_deferredDeclarationsLength)
 {
+    if (!m_deferredParser)
+        m_properties = o.m_properties->mutableCopy();
 }
 
 StyleRule::~StyleRule()
 {
 }
 
+Ref<StyleRule> StyleRule::create(int sourceLine, CSSDeferredParser& deferredParser, unsigned declarationsOffset, unsigned declarationsLength)
+{
+    return adoptRef(*new StyleRule(sourceLine, deferredParser, declarationsOffset, declarationsLength));
+}
+
+void StyleRule::parseDeferredProperties() const
+{
+    ASSERT(m_deferredParser);
+    m_properties = m_deferredParser->parseDeclarationBlock(m_deferredDeclarationsOffset, m_deferredDeclarationsLength);
+    m_deferredParser = nullptr;
+}
+
 MutableStyleProperties& StyleRule::mutableProperties()
 {
-    if (!is<MutableStyleProperties>(m_properties.get()))
+    if (!is<MutableStyleProperties>(properties()))
         m_properties = m_properties->mutableCopy();
-    return downcast<MutableStyleProperties>(m_properties.get());
+    return downcast<MutableStyleProperties>(*m_properties);
 }
 
 Ref<StyleRule> StyleRule::create(int sourceLine, const Vector<const CSSSelector*>& selectors, Ref<StyleProperties>&& properties)
@@ -244,7 +269,7 @@ Vector<RefPtr<StyleRule>> StyleRule::splitIntoMultipleRulesWithMaximumSelectorCo
             componentsInThisSelector.append(component);
 
         if (componentsInThisSelector.size() + componentsSinceLastSplit.size() > maxCount && !componentsSinceLastSplit.isEmpty()) {
-            rules.append(create(sourceLine(), componentsSinceLastSplit, const_cast<StyleProperties&>(m_properties.get())));
+            rules.append(create(sourceLine(), componentsSinceLastSplit, const_cast<StyleProperties&>(properties())));
             componentsSinceLastSplit.clear();
         }
 
@@ -252,7 +277,7 @@ Vector<RefPtr<StyleRule>> StyleRule::splitIntoMultipleRulesWithMaximumSelectorCo
     }
 
     if (!componentsSinceLastSplit.isEmpty())
-        rules.append(create(sourceLine(), componentsSinceLastSplit, const_cast<StyleProperties&>(m_properties.get())));
+        rules.append(create(sourceLine(), componentsSinceLastSplit, const_cast<StyleProperties&>(properties())));
 
     return rules;
 }
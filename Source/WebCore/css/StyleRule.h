@@ -30,6 +30,7 @@
 
 namespace WebCore {
 
+class CSSDeferredParser;
 class CSSRule;
 class CSSStyleRule;
 class CSSStyleSheet;
@@ -107,12 +108,15 @@ public:
     {
         return adoptRef(*new StyleRule(sourceLine, WTF::move(properties)));
     }
+    // The declaration block is parsed from the style sheet text the first time the properties are needed.
+    static Ref<StyleRule> create(int sourceLine, CSSDeferredParser&, unsigned declarationsOffset, unsigned declarationsLength);
     
     ~StyleRule();
 
     const CSSSelectorList& selectorList() const { return m_selectorList; }
-    const StyleProperties& properties() const { return m_properties; }
+    const StyleProperties& properties() const;
     MutableStyleProperties& mutableProperties();
+    bool hasDeferredProperties() const { return !!m_deferredParser; }
     
     void parserAdoptSelectorVector(Vector<std::unique_ptr<CSSParserSelector>>& selectors) { m_selectorList.adoptSelectorVector(selectors); }
     void wrapperAdoptSelectorList(CSSSelectorList& selectors) { m_selectorList = WTF::move(selectors); }
@@ -126,14 +130,29 @@ public:
 
 private:
     StyleRule(int sourceLine, Ref<StyleProperties>&&);
+    StyleRule(int sourceLine, CSSDeferredParser&, unsigned declarationsOffset, unsigned declarationsLength);
     StyleRule(const StyleRule&);
 
     static Ref<StyleRule> create(int sourceLine, const Vector<const CSSSelector*>&, Ref<StyleProperties>&&);
 
-    Ref<StyleProperties> m_properties;
+    void parseDeferredProperties() const;
+
+    mutable RefPtr<StyleProperties> m_properties;
     CSSSelectorList m_selectorList;
+
+    // Only set until the declaration block has been parsed.
+    mutable RefPtr<CSSDeferredParser> m_deferredParser;
+    unsigned m_deferredDeclarationsOffset { 0 };
+    unsigned m_deferredDeclarationsLength { 0 };
 };
 
+inline const StyleProperties& StyleRule::properties() const
+{
+    if (UNLIKELY(m_deferredParser))
+        parseDeferredProperties();
+    return *m_properties;
+}
+
 class StyleRuleFontFace : public StyleRuleBase {
 public:
     static Ref<StyleRuleFontFace> create(Ref<StyleProperties>&& properties) { return adoptRef(*new StyleRuleFontFace(WTF::move(properties))); }
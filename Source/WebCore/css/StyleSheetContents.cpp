@@ -438,10 +438,13 @@ static bool traverseSubresourcesInRules(const Vector<RefPtr<StyleRuleBase>>& rul
 {
     for (auto& rule : rules) {
         switch (rule->type()) {
-        case StyleRuleBase::Style:
-            if (downcast<StyleRule>(*rule).properties().traverseSubresources(handler))
+        case StyleRuleBase::Style: {
+            // A declaration block that has not been parsed yet has not loaded anything.
+            auto& styleRule = downcast<StyleRule>(*rule);
+            if (!styleRule.hasDeferredProperties() && styleRule.properties().traverseSubresources(handler))
                 return true;
             break;
+        }
         case StyleRuleBase::FontFace:
             if (downcast<StyleRuleFontFace>(*rule).properties().traverseSubresources(handler))
                 return true;
@@ -35,7 +35,6 @@
 #include "DocumentFragment.h"
 #include "MutationObserverInterestGroup.h"
 #include "MutationRecord.h"
-#include "StaticNodeList.h"
 #include <wtf/StdLibExtras.h>
 
 namespace WebCore {
@@ -63,14 +62,17 @@ ChildListMutationAccumulator::~ChildListMutationAccumulator()
 
 PassRefPtr<ChildListMutationAccumulator> ChildListMutationAccumulator::getOrCreate(ContainerNode& target)
 {
-    AccumulatorMap::AddResult result = accumulatorMap().add(&target, nullptr);
-    RefPtr<ChildListMutationAccumulator> accumulator;
-    if (!result.isNewEntry)
-        accumulator = result.iterator->value;
-    else {
-        accumulator = adoptRef(new ChildListMutationAccumulator(target, MutationObserverInterestGroup::createForChildListMutation(target)));
-        result.iterator->value = accumulator.get();
-    }
+    if (ChildListMutationAccumulator* accumulator = accumulatorMap().get(&target))
+        return accumulator;
+
+    // Most mutations happen outside of any observed subtree, so avoid allocating an accumulator
+    // and registering it in the map when nobody is interested in this target.
+    std::unique_ptr<MutationObserverInterestGroup> observers = MutationObserverInterestGroup::createForChildListMutation(target);
+    if (!observers)
+        return nullptr;
+
+    RefPtr<ChildListMutationAccumulator> accumulator = adoptRef(new ChildListMutationAccumulator(target, WTF::move(observers)));
+    accumulatorMap().add(&target, accumulator.get());
     return accumulator.release();
 }
 
@@ -126,9 +128,7 @@ void ChildListMutationAccumulator::enqueueMutationRecord()
     ASSERT(hasObservers());
     ASSERT(!isEmpty());
 
-    RefPtr<NodeList> addedNodes = StaticNodeList::adopt(m_addedNodes);
-    RefPtr<NodeList> removedNodes = StaticNodeList::adopt(m_removedNodes);
-    RefPtr<MutationRecord> record = MutationRecord::createChildList(m_target, addedNodes.release(), removedNodes.release(), m_previousSibling.release(), m_nextSibling.release());
+    RefPtr<MutationRecord> record = MutationRecord::createChildList(m_target, WTF::move(m_addedNodes), WTF::move(m_removedNodes), m_previousSibling.release(), m_nextSibling.release());
     m_observers->enqueueMutationRecord(record.release());
     m_lastAdded = nullptr;
     ASSERT(isEmpty());
@@ -84,13 +84,13 @@ public:
 
     void childAdded(Node& child)
     {
-        if (m_accumulator && m_accumulator->hasObservers())
+        if (m_accumulator)
             m_accumulator->childAdded(child);
     }
 
     void willRemoveChild(Node& child)
     {
-        if (m_accumulator && m_accumulator->hasObservers())
+        if (m_accumulator)
             m_accumulator->willRemoveChild(child);
     }
 
@@ -56,6 +56,7 @@
 #include "Editor.h"
 #include "ElementIterator.h"
 #include "EntityReference.h"
+#include "EventDispatcher.h"
 #include "EventFactory.h"
 #include "EventHandler.h"
 #include "ExtensionStyleSheets.h"
@@ -146,6 +147,7 @@
 #include "SelectorQuery.h"
 #include "Settings.h"
 #include "ShadowRoot.h"
+#include "StyleCostProfile.h"
 #include "StyleProperties.h"
 #include "StyleResolver.h"
 #include "StyleSheetContents.h"
@@ -168,6 +170,7 @@
 #include <inspector/ScriptCallStack.h>
 #include <wtf/CurrentTime.h>
 #include <wtf/TemporaryChange.h>
+#include <wtf/TraceEvent.h>
 #include <wtf/text/StringBuffer.h>
 #include <yarr/RegularExpression.h>
 
@@ -252,6 +255,7 @@ using namespace HTMLNames;
 // #define INSTRUMENT_LAYOUT_SCHEDULING 1
 
 static const unsigned cMaxWriteRecursionDepth = 21;
+static const int timeToKeepSharedObjectPoolAliveInSeconds = 10;
 
 // DOM Level 2 says (letters added):
 //
@@ -1592,6 +1596,84 @@ void Document::unregisterForVisibilityStateChangedCallbacks(Element* element)
     m_visibilityStateCallbackElements.remove(element);
 }
 
+static IntRect deferredLoadRect(RenderElement& renderer)
+{
+    // Images without a size yet still need to be found by the intersection test.
+    IntRect rect = renderer.absoluteBoundingBoxRect();
+    rect.setSize(rect.size().expandedTo(IntSize(1, 1)));
+    return rect;
+}
+
+static IntRect nearViewportRect(const IntRect& visibleRect)
+{
+    IntRect rect = visibleRect;
+    rect.inflateX(visibleRect.width());
+    rect.inflateY(visibleRect.height());
+    return rect;
+}
+
+bool Document::shouldDeferLoadUntilNearViewport(Element& element)
+{
+    if (!settings() || !settings()->lazyLoadingOffscreenContentEnabled())
+        return false;
+
+    FrameView* view = this->view();
+    if (!view || !page() || printing())
+        return false;
+
+    // Without an up-to-date renderer we can't tell where the element is. Defer, and let the
+    // post-layout viewport check start the load if it turns out to be visible.
+    auto* renderer = element.renderer();
+    if (!renderer || view->needsLayout())
+        return true;
+
+    return !nearViewportRect(view->windowToContents(view->windowClipRect())).intersects(deferredLoadRect(*renderer));
+}
+
+void Document::deferLoadUntilNearViewport(Element& element)
+{
+    m_elementsWithDeferredLoads.add(&element);
+}
+
+void Document::cancelDeferredLoad(Element& element)
+{
+    m_elementsWithDeferredLoads.remove(&element);
+}
+
+void Document::startDeferredLoadsNearViewport(const IntRect& visibleRect)
+{
+    if (m_elementsWithDeferredLoads.isEmpty() || visibleRect.isEmpty())
+        return;
+
+    FrameView* view = this->view();
+    if (!view || view->needsLayout())
+        return;
+
+    IntRect nearbyRect = nearViewportRect(visibleRect);
+    Vector<std::pair<Ref<Element>, bool>> elementsToLoad;
+    for (auto* element : m_elementsWithDeferredLoads) {
+        auto* renderer = element->renderer();
+        if (!element->inDocument() || !renderer || renderer->style().visibility() != VISIBLE)
+            continue;
+        IntRect rect = deferredLoadRect(*renderer);
+        if (nearbyRect.intersects(rect))
+            elementsToLoad.append(std::make_pair(Ref<Element>(*element), visibleRect.intersects(rect)));
+    }
+
+    // Starting a load can run script and mutate the set, so take the elements out first.
+    for (auto& elementAndVisibility : elementsToLoad)
+        m_elementsWithDeferredLoads.remove(elementAndVisibility.first.ptr());
+
+    for (auto& elementAndVisibility : elementsToLoad) {
+        Element& element = elementAndVisibility.first.get();
+        // Images that are actually on screen jump ahead of the ones we are only prefetching.
+        if (is<HTMLImageElement>(element))
+            downcast<HTMLImageElement>(element).loadDeferredImage(elementAndVisibility.second ? ResourceLoadPriority::Medium : ResourceLoadPriority::VeryLow);
+        else if (is<HTMLFrameElementBase>(element))
+            downcast<HTMLFrameElementBase>(element).loadDeferredFrame();
+    }
+}
+
 void Document::visibilityStateChanged()
 {
     dispatchEvent(Event::create(eventNames().visibilitychangeEvent, false, false));
@@ -1788,6 +1870,7 @@ bool Document::hasPendingForcedStyleRecalc() const
 
 void Document::recalcStyle(Style::Change change)
 {
+    TraceScope traceScope(TraceCategory::Style, "Document::recalcStyle");
     ASSERT(!view() || !view()->isPainting());
 
     // NOTE: XSL code seems to be the only client stumbling in here without a RenderView.
@@ -1857,7 +1940,7 @@ void Document::recalcStyle(Style::Change change)
     
     ++m_styleRecalcCount;
 
-    InspectorInstrumentation::didRecalculateStyle(cookie);
+    InspectorInstrumentation::didRecalculateStyle(cookie, *this);
 
     // Some animated images may now be inside the viewport due to style recalc,
     // resume them if necessary if there is no layout pending. Otherwise, we'll
@@ -2303,6 +2386,7 @@ void Document::prepareForDestruction()
 #endif
 
     InspectorInstrumentation::documentDetached(*this);
+    EventDispatcher::clearCachedEventPath(*this);
 
     stopActiveDOMObjects();
     m_eventQueue.close();
@@ -2333,6 +2417,8 @@ void Document::prepareForDestruction()
     }
 #endif
 
+    m_elementsWithDeferredLoads.clear();
+
     disconnectFromFrame();
 
     m_hasPreparedForDestruction = true;
@@ -2851,7 +2937,11 @@ double Document::timerAlignmentInterval(bool hasReachedMaxNestingLevel) const
     Page* page = this->page();
     if (!page)
         return ScriptExecutionContext::timerAlignmentInterval(hasReachedMaxNestingLevel);
-    return page->settings().domTimerAlignmentInterval();
+
+    double alignmentInterval = page->settings().domTimerAlignmentInterval();
+    if (hasReachedMaxNestingLevel)
+        alignmentInterval = std::max(alignmentInterval, page->settings().nestedDOMTimerAlignmentInterval());
+    return alignmentInterval;
 }
 
 EventTarget* Document::errorEventTarget()
@@ -4131,8 +4221,12 @@ void Document::addListenerTypeIfNeeded(const AtomicString& eventType)
         addListenerType(ANIMATIONSTART_LISTENER);
     else if (eventType == eventNames().webkitAnimationEndEvent || eventType == eventNames().animationendEvent)
         addListenerType(ANIMATIONEND_LISTENER);
-    else if (eventType == eventNames().webkitAnimationIterationEvent || eventType == eventNames().animationiterationEvent)
+    else if (eventType == eventNames().webkitAnimationIterationEvent || eventType == eventNames().animationiterationEvent) {
+        bool hadAnimationIterationListener = hasListenerType(ANIMATIONITERATION_LISTENER);
         addListenerType(ANIMATIONITERATION_LISTENER);
+        if (!hadAnimationIterationListener && frame())
+            frame()->animation().animationIterationListenerAdded();
+    }
     else if (eventType == eventNames().webkitTransitionEndEvent || eventType == eventNames().transitionendEvent)
         addListenerType(TRANSITIONEND_LISTENER);
     else if (eventType == eventNames().beforeloadEvent)
@@ -4903,15 +4997,35 @@ void Document::finishedParsing()
     // so that dynamically inserted content can also benefit from sharing optimizations.
     // Note that we don't refresh the timer on pool access since that could lead to huge caches being kept
     // alive indefinitely by something innocuous like JS setting .innerHTML repeatedly on a timer.
-    static const int timeToKeepSharedObjectPoolAliveAfterParsingFinishedInSeconds = 10;
-    m_sharedObjectPoolClearTimer.startOneShot(timeToKeepSharedObjectPoolAliveAfterParsingFinishedInSeconds);
+    m_sharedObjectPoolClearTimer.startOneShot(timeToKeepSharedObjectPoolAliveInSeconds);
 
     // Parser should have picked up all preloads by now
     m_cachedResourceLoader->clearPreloads();
 }
 
+DocumentSharedObjectPool& Document::ensureSharedObjectPool()
+{
+    if (!m_sharedObjectPool) {
+        m_sharedObjectPool = std::make_unique<DocumentSharedObjectPool>();
+        // A pool created for script-built elements goes away on the same schedule as the one kept after parsing.
+        if (!m_bParsing)
+            m_sharedObjectPoolClearTimer.startOneShot(timeToKeepSharedObjectPoolAliveInSeconds);
+    }
+    return *m_sharedObjectPool;
+}
+
+size_t Document::elementDataBytesSavedBySharing() const
+{
+    size_t bytesSaved = m_elementDataBytesSavedByClearedSharedObjectPools;
+    if (m_sharedObjectPool)
+        bytesSaved += m_sharedObjectPool->bytesSavedBySharing();
+    return bytesSaved;
+}
+
 void Document::sharedObjectPoolClearTimerFired()
 {
+    if (m_sharedObjectPool)
+        m_elementDataBytesSavedByClearedSharedObjectPools += m_sharedObjectPool->bytesSavedBySharing();
     m_sharedObjectPool = nullptr;
 }
 
@@ -5924,7 +6038,7 @@ void Document::loadEventDelayTimerFired()
 }
 
 #if ENABLE(REQUEST_ANIMATION_FRAME)
-int Document::requestAnimationFrame(PassRefPtr<RequestAnimationFrameCallback> callback)
+ScriptedAnimationController& Document::ensureScriptedAnimationController()
 {
     if (!m_scriptedAnimationController) {
 #if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
@@ -5938,8 +6052,12 @@ int Document::requestAnimationFrame(PassRefPtr<RequestAnimationFrameCallback> ca
         if (!page() || page()->scriptedAnimationsSuspended())
             m_scriptedAnimationController->suspend();
     }
+    return *m_scriptedAnimationController;
+}
 
-    return m_scriptedAnimationController->registerCallback(callback);
+int Document::requestAnimationFrame(PassRefPtr<RequestAnimationFrameCallback> callback)
+{
+    return ensureScriptedAnimationController().registerCallback(callback);
 }
 
 void Document::cancelAnimationFrame(int id)
@@ -5949,6 +6067,18 @@ void Document::cancelAnimationFrame(int id)
     m_scriptedAnimationController->cancelCallback(id);
 }
 
+int Document::requestIdleCallback(PassRefPtr<IdleRequestCallback> callback, double timeout)
+{
+    return ensureScriptedAnimationController().registerIdleCallback(callback, timeout);
+}
+
+void Document::cancelIdleCallback(int id)
+{
+    if (!m_scriptedAnimationController)
+        return;
+    m_scriptedAnimationController->cancelIdleCallback(id);
+}
+
 void Document::serviceScriptedAnimations(double monotonicAnimationStartTime)
 {
     if (!m_scriptedAnimationController)
@@ -6268,6 +6398,16 @@ unsigned Document::styleRecalcCount() const
     return m_styleRecalcCount;
 }
 
+void Document::setStyleCostProfile(std::unique_ptr<Style::CostProfile> profile)
+{
+    m_styleCostProfile = WTF::move(profile);
+}
+
+std::unique_ptr<Style::CostProfile> Document::takeStyleCostProfile()
+{
+    return WTF::move(m_styleCostProfile);
+}
+
 DocumentLoader* Document::loader() const
 {
     if (!m_frame)
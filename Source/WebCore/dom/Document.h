@@ -55,6 +55,7 @@
 #include <memory>
 #include <wtf/Deque.h>
 #include <wtf/HashSet.h>
+#include <wtf/ListHashSet.h>
 #include <wtf/PassRefPtr.h>
 #include <wtf/WeakPtr.h>
 
@@ -188,6 +189,7 @@ class TouchList;
 #endif
 
 #if ENABLE(REQUEST_ANIMATION_FRAME)
+class IdleRequestCallback;
 class RequestAnimationFrameCallback;
 class ScriptedAnimationController;
 #endif
@@ -229,6 +231,10 @@ struct TextAutoSizingTraits : WTF::GenericHashTraits<TextAutoSizingKey> {
 class MediaSession;
 #endif
 
+namespace Style {
+class CostProfile;
+}
+
 const uint64_t HTMLMediaElementInvalidID = 0;
 
 enum PageshowEventPersistence {
@@ -1039,6 +1045,13 @@ public:
     void registerForVisibilityStateChangedCallbacks(Element*);
     void unregisterForVisibilityStateChangedCallbacks(Element*);
 
+    // Lazy loading of offscreen images and iframes. The element keeps its unstarted load and the
+    // document starts it once the element comes within a screenful of the visible rect.
+    bool shouldDeferLoadUntilNearViewport(Element&);
+    void deferLoadUntilNearViewport(Element&);
+    void cancelDeferredLoad(Element&);
+    void startDeferredLoadsNearViewport(const IntRect& visibleRect);
+
 #if ENABLE(VIDEO)
     void registerForAllowsMediaDocumentInlinePlaybackChangedCallbacks(HTMLMediaElement&);
     void unregisterForAllowsMediaDocumentInlinePlaybackChangedCallbacks(HTMLMediaElement&);
@@ -1167,6 +1180,8 @@ public:
 #if ENABLE(REQUEST_ANIMATION_FRAME)
     int requestAnimationFrame(PassRefPtr<RequestAnimationFrameCallback>);
     void cancelAnimationFrame(int id);
+    int requestIdleCallback(PassRefPtr<IdleRequestCallback>, double timeout);
+    void cancelIdleCallback(int id);
     void serviceScriptedAnimations(double monotonicAnimationStartTime);
 #endif
 
@@ -1196,6 +1211,11 @@ public:
     WEBCORE_EXPORT void startTrackingStyleRecalcs();
     WEBCORE_EXPORT unsigned styleRecalcCount() const;
 
+    // Only set while the Web Inspector timeline records a style recalc.
+    Style::CostProfile* styleCostProfile() const { return m_styleCostProfile.get(); }
+    void setStyleCostProfile(std::unique_ptr<Style::CostProfile>);
+    std::unique_ptr<Style::CostProfile> takeStyleCostProfile();
+
     void didAddTouchEventHandler(Node&);
     void didRemoveTouchEventHandler(Node&, EventHandlerRemoval = EventHandlerRemoval::One);
 
@@ -1240,6 +1260,8 @@ public:
     void decrementActiveParserCount();
 
     DocumentSharedObjectPool* sharedObjectPool() { return m_sharedObjectPool.get(); }
+    DocumentSharedObjectPool& ensureSharedObjectPool();
+    size_t elementDataBytesSavedBySharing() const;
 
     void didRemoveAllPendingStylesheet();
     void setNeedsNotifyRemoveAllPendingStylesheet() { m_needsNotifyRemoveAllPendingStylesheet = true; }
@@ -1508,6 +1530,7 @@ private:
     unsigned m_ignoreDestructiveWriteCount;
 
     unsigned m_styleRecalcCount { 0 };
+    std::unique_ptr<Style::CostProfile> m_styleCostProfile;
 
     StringWithDirection m_title;
     StringWithDirection m_rawTitle;
@@ -1587,6 +1610,7 @@ private:
 #endif
 
     HashSet<Element*> m_visibilityStateCallbackElements;
+    ListHashSet<Element*> m_elementsWithDeferredLoads;
 #if ENABLE(VIDEO)
     HashSet<HTMLMediaElement*> m_allowsMediaDocumentInlinePlaybackElements;
 #endif
@@ -1652,6 +1676,7 @@ private:
     double m_lastHandledUserGestureTimestamp;
 
 #if ENABLE(REQUEST_ANIMATION_FRAME)
+    ScriptedAnimationController& ensureScriptedAnimationController();
     void clearScriptedAnimationController();
     RefPtr<ScriptedAnimationController> m_scriptedAnimationController;
 #endif
@@ -1718,6 +1743,7 @@ private:
     Timer m_sharedObjectPoolClearTimer;
 
     std::unique_ptr<DocumentSharedObjectPool> m_sharedObjectPool;
+    size_t m_elementDataBytesSavedByClearedSharedObjectPools { 0 };
 
 #ifndef NDEBUG
     bool m_didDispatchViewportPropertiesChanged;
@@ -26,6 +26,7 @@
 #include "Document.h"
 #include "ElementDescendantIterator.h"
 #include "HTMLDocumentParser.h"
+#include "HTMLDocumentParserFastPath.h"
 #include "Page.h"
 #include "Settings.h"
 #include "XMLDocumentParser.h"
@@ -83,6 +84,8 @@ Ref<Node> DocumentFragment::cloneNodeInternal(Document& targetDocument, CloningO
 void DocumentFragment::parseHTML(const String& source, Element* contextElement, ParserContentPolicy parserContentPolicy)
 {
     ASSERT(contextElement);
+    if (tryFastParsingHTMLFragment(source, *this, *contextElement, parserContentPolicy))
+        return;
     HTMLDocumentParser::parseDocumentFragment(source, *this, *contextElement, parserContentPolicy);
 }
 
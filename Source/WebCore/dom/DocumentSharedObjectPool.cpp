@@ -55,6 +55,8 @@ Ref<ShareableElementData> DocumentSharedObjectPool::cachedShareableElementDataWi
 
     if (!cachedData)
         cachedData = ShareableElementData::createWithAttributes(attributes);
+    else
+        m_bytesSavedBySharing += sizeof(ShareableElementData) + attributes.size() * sizeof(Attribute);
 
     return *cachedData;
 }
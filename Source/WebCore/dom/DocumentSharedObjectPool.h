@@ -41,9 +41,13 @@ class DocumentSharedObjectPool {
 public:
     Ref<ShareableElementData> cachedShareableElementDataWithAttributes(const Vector<Attribute>&);
 
+    // ShareableElementData bytes not allocated because an identical attribute set was reused.
+    size_t bytesSavedBySharing() const { return m_bytesSavedBySharing; }
+
 private:
     typedef HashMap<unsigned, RefPtr<ShareableElementData>, AlreadyHashed> ShareableElementDataCache;
     ShareableElementDataCache m_shareableElementDataCache;
+    size_t m_bytesSavedBySharing { 0 };
 };
 
 }
@@ -31,6 +31,7 @@
 #include "CSSParser.h"
 #include "Chrome.h"
 #include "ChromeClient.h"
+#include "ClassChangeInvalidation.h"
 #include "ClientRect.h"
 #include "ClientRectList.h"
 #include "ComposedTreeAncestorIterator.h"
@@ -86,7 +87,6 @@
 #include "XMLNames.h"
 #include "htmlediting.h"
 #include "markup.h"
-#include <wtf/BitVector.h>
 #include <wtf/CurrentTime.h>
 #include <wtf/text/CString.h>
 
@@ -1292,66 +1292,19 @@ static inline bool classStringHasClassName(const AtomicString& newClassString)
     return classStringHasClassName(newClassString.characters16(), length);
 }
 
-static bool checkSelectorForClassChange(const SpaceSplitString& changedClasses, const StyleResolver& styleResolver)
-{
-    unsigned changedSize = changedClasses.size();
-    for (unsigned i = 0; i < changedSize; ++i) {
-        if (styleResolver.hasSelectorForClass(changedClasses[i]))
-            return true;
-    }
-    return false;
-}
-
-static bool checkSelectorForClassChange(const SpaceSplitString& oldClasses, const SpaceSplitString& newClasses, const StyleResolver& styleResolver)
-{
-    unsigned oldSize = oldClasses.size();
-    if (!oldSize)
-        return checkSelectorForClassChange(newClasses, styleResolver);
-    BitVector remainingClassBits;
-    remainingClassBits.ensureSize(oldSize);
-    // Class vectors tend to be very short. This is faster than using a hash table.
-    unsigned newSize = newClasses.size();
-    for (unsigned i = 0; i < newSize; ++i) {
-        bool foundFromBoth = false;
-        for (unsigned j = 0; j < oldSize; ++j) {
-            if (newClasses[i] == oldClasses[j]) {
-                remainingClassBits.quickSet(j);
-                foundFromBoth = true;
-            }
-        }
-        if (foundFromBoth)
-            continue;
-        if (styleResolver.hasSelectorForClass(newClasses[i]))
-            return true;
-    }
-    for (unsigned i = 0; i < oldSize; ++i) {
-        // If the bit is not set the the corresponding class has been removed.
-        if (remainingClassBits.quickGet(i))
-            continue;
-        if (styleResolver.hasSelectorForClass(oldClasses[i]))
-            return true;
-    }
-    return false;
-}
-
 void Element::classAttributeChanged(const AtomicString& newClassString)
 {
-    StyleResolver* styleResolver = document().styleResolverIfExists();
-    bool testShouldInvalidateStyle = inRenderedDocument() && styleResolver && styleChangeType() < FullStyleChange;
-    bool shouldInvalidateStyle = false;
-
     if (classStringHasClassName(newClassString)) {
         const bool shouldFoldCase = document().inQuirksMode();
         // Note: We'll need ElementData, but it doesn't have to be UniqueElementData.
         if (!elementData())
             ensureUniqueElementData();
-        const SpaceSplitString oldClasses = elementData()->classNames();
-        elementData()->setClass(newClassString, shouldFoldCase);
-        const SpaceSplitString& newClasses = elementData()->classNames();
-        shouldInvalidateStyle = testShouldInvalidateStyle && checkSelectorForClassChange(oldClasses, newClasses, *styleResolver);
+        {
+            Style::ClassChangeInvalidation styleInvalidation(*this, elementData()->classNames(), SpaceSplitString(newClassString, shouldFoldCase));
+            elementData()->setClass(newClassString, shouldFoldCase);
+        }
     } else if (elementData()) {
-        const SpaceSplitString& oldClasses = elementData()->classNames();
-        shouldInvalidateStyle = testShouldInvalidateStyle && checkSelectorForClassChange(oldClasses, *styleResolver);
+        Style::ClassChangeInvalidation styleInvalidation(*this, elementData()->classNames(), SpaceSplitString());
         elementData()->clearClass();
     }
 
@@ -1359,9 +1312,6 @@ void Element::classAttributeChanged(const AtomicString& newClassString)
         if (auto* classList = elementRareData()->classList())
             classList->attributeValueChanged(newClassString);
     }
-
-    if (shouldInvalidateStyle)
-        setNeedsStyleRecalc();
 }
 
 URL Element::absoluteLinkURL() const
@@ -2106,7 +2056,16 @@ void Element::addAttributeInternal(const QualifiedName& name, const AtomicString
 {
     if (!inSynchronizationOfLazyAttribute)
         willModifyAttribute(name, nullAtom, value);
-    ensureUniqueElementData().addAttribute(name, value);
+
+    // Script-built DOM tends to repeat the same first attribute (class="row") on many elements, so intern
+    // it like the parser does. Later changes copy the data through ensureUniqueElementData().
+    if (!m_elementData && !inSynchronizationOfLazyAttribute) {
+        Vector<Attribute> attributes;
+        attributes.append(Attribute(name, value));
+        m_elementData = document().ensureSharedObjectPool().cachedShareableElementDataWithAttributes(attributes);
+    } else
+        ensureUniqueElementData().addAttribute(name, value);
+
     if (!inSynchronizationOfLazyAttribute)
         didAddAttribute(name, value);
 }
@@ -3335,8 +3294,16 @@ void Element::cloneAttributesFromElement(const Element& other)
 
     if (!other.m_elementData->isUnique())
         m_elementData = other.m_elementData;
-    else
+    else if (other.m_elementData->isEmpty())
         m_elementData = other.m_elementData->makeUniqueCopy();
+    else {
+        // The attributeChanged() calls below recompute everything derived from the attributes, so an
+        // interned attribute set with the same contents is as good as a private copy.
+        Vector<Attribute> attributes;
+        for (const Attribute& attribute : other.attributesIterator())
+            attributes.append(attribute);
+        m_elementData = document().ensureSharedObjectPool().cachedShareableElementDataWithAttributes(attributes);
+    }
 
     for (const Attribute& attribute : attributesIterator())
         attributeChanged(attribute.name(), nullAtom, attribute.value(), ModifiedByCloning);
@@ -26,6 +26,7 @@
 #include "config.h"
 #include "EventDispatcher.h"
 
+#include "Document.h"
 #include "EventContext.h"
 #include "FocusEvent.h"
 #include "FrameView.h"
@@ -39,6 +40,8 @@
 #include "SVGNames.h"
 #include "SVGUseElement.h"
 #include "TouchEvent.h"
+#include <wtf/NeverDestroyed.h>
+#include <wtf/RefCounted.h>
 
 namespace WebCore {
 
@@ -76,9 +79,9 @@ bool WindowEventContext::handleLocalEvents(Event& event)
     return true;
 }
 
-class EventPath {
+class EventPath : public RefCounted<EventPath> {
 public:
-    EventPath(Node& origin, Event&);
+    static Ref<EventPath> create(Node& origin, Event& event) { return adoptRef(*new EventPath(origin, event)); }
 
     bool isEmpty() const { return m_path.isEmpty(); }
     size_t size() const { return m_path.size(); }
@@ -95,11 +98,13 @@ public:
     EventContext* lastContextIfExists() { return m_path.isEmpty() ? nullptr : m_path.last().get(); }
 
 private:
+    EventPath(Node& origin, Event&);
+
 #if ENABLE(TOUCH_EVENTS) && !PLATFORM(IOS)
     void updateTouchListsInEventPath(const TouchList*, TouchEventContext::TouchListType);
 #endif
 
-    Event& m_event;
+    AtomicString m_eventType;
     Vector<std::unique_ptr<EventContext>, 32> m_path;
 };
 
@@ -300,13 +305,87 @@ static void dispatchEventInDOM(Event& event, const EventPath& path, WindowEventC
     }
 }
 
+// Events dispatched in a row at the same target, like mousemove or scroll, would otherwise walk the
+// same ancestor chain and allocate the same contexts every time. Without a related target or touch
+// lists to retarget, the path only depends on the target, the event type and the DOM tree.
+struct CachedEventPath {
+    Document* document { nullptr };
+    uint64_t domTreeVersion { 0 };
+    Node* origin { nullptr };
+    AtomicString eventType;
+    bool isMouseOrFocusEvent { false };
+    RefPtr<EventPath> path;
+};
+
+static CachedEventPath& cachedEventPath()
+{
+    static NeverDestroyed<CachedEventPath> cache;
+    return cache;
+}
+
+static bool canCacheEventPath(Node& origin, Event& event)
+{
+    if (event.relatedTarget())
+        return false;
+#if ENABLE(TOUCH_EVENTS) && !PLATFORM(IOS)
+    if (event.isTouchEvent())
+        return false;
+#endif
+
+    // The cached path keeps its nodes alive; only documents in a frame clear it when they go away.
+    Document& document = origin.document();
+    if (!origin.inDocument() || !document.frame())
+        return false;
+
+#if ENABLE(FULLSCREEN_API) && ENABLE(VIDEO)
+    // The full screen element decides whether events leave a media element's shadow tree.
+    if (document.webkitCurrentFullScreenElement())
+        return false;
+#endif
+    return true;
+}
+
+static Ref<EventPath> eventPathForDispatch(Node& origin, Event& event)
+{
+    if (!canCacheEventPath(origin, event))
+        return EventPath::create(origin, event);
+
+    CachedEventPath& cache = cachedEventPath();
+    Document& document = origin.document();
+    bool isMouseOrFocusEvent = event.isMouseEvent() || event.isFocusEvent();
+    if (cache.path && cache.origin == &origin && cache.document == &document && cache.domTreeVersion == document.domTreeVersion()
+        && cache.eventType == event.type() && cache.isMouseOrFocusEvent == isMouseOrFocusEvent)
+        return *cache.path;
+
+    Ref<EventPath> path = EventPath::create(origin, event);
+    cache.document = &document;
+    cache.domTreeVersion = document.domTreeVersion();
+    cache.origin = &origin;
+    cache.eventType = event.type();
+    cache.isMouseOrFocusEvent = isMouseOrFocusEvent;
+    cache.path = path.ptr();
+    return path;
+}
+
+void EventDispatcher::clearCachedEventPath(Document& document)
+{
+    CachedEventPath& cache = cachedEventPath();
+    if (cache.document != &document)
+        return;
+    cache.document = nullptr;
+    cache.origin = nullptr;
+    cache.eventType = nullAtom;
+    cache.path = nullptr;
+}
+
 bool EventDispatcher::dispatchEvent(Node* origin, Event& event)
 {
     ASSERT_WITH_SECURITY_IMPLICATION(!NoEventDispatchAssertion::isEventDispatchForbidden());
     ASSERT(origin);
     RefPtr<Node> node(origin);
     RefPtr<FrameView> view = node->document().view();
-    EventPath eventPath(*node, event);
+    Ref<EventPath> protectedEventPath = eventPathForDispatch(*node, event);
+    EventPath& eventPath = protectedEventPath.get();
 
     if (EventTarget* relatedTarget = event.relatedTarget())
         eventPath.setRelatedTarget(*node, *relatedTarget);
@@ -395,7 +474,7 @@ static Node* nodeOrHostIfPseudoElement(Node* node)
 }
 
 EventPath::EventPath(Node& originalTarget, Event& event)
-    : m_event(event)
+    : m_eventType(event.type())
 {
 #if ENABLE(SHADOW_DOM) || ENABLE(DETAILS_ELEMENT)
     Vector<EventTarget*, 16> targetStack;
@@ -630,9 +709,9 @@ void EventPath::setRelatedTarget(Node& origin, EventTarget& relatedTarget)
 
     bool originIsRelatedTarget = &origin == relatedNode;
     // FIXME: We should add a new flag on Event instead.
-    bool shouldTrimEventPath = m_event.type() == eventNames().mouseoverEvent
-        || m_event.type() == eventNames().mousemoveEvent
-        || m_event.type() == eventNames().mouseoutEvent;
+    bool shouldTrimEventPath = m_eventType == eventNames().mouseoverEvent
+        || m_eventType == eventNames().mousemoveEvent
+        || m_eventType == eventNames().mouseoutEvent;
     Node& rootNodeInOriginTreeScope = origin.treeScope().rootNode();
     TreeScope* previousTreeScope = nullptr;
     size_t originalEventPathSize = m_path.size();
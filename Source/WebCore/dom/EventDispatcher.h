@@ -32,6 +32,7 @@
 
 namespace WebCore {
 
+class Document;
 class Element;
 class Event;
 class Node;
@@ -39,6 +40,7 @@ class Node;
 namespace EventDispatcher {
 
 bool dispatchEvent(Node*, Event&);
+void clearCachedEventPath(Document&);
 void dispatchScopedEvent(Node&, Event&);
 void dispatchSimulatedClick(Element*, Event* underlyingEvent, SimulatedClickMouseEventOptions, SimulatedClickVisualOptions);
 
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef IdleDeadline_h
+#define IdleDeadline_h
+
+#if ENABLE(REQUEST_ANIMATION_FRAME)
+
+#include <wtf/Ref.h>
+#include <wtf/RefCounted.h>
+
+namespace WebCore {
+
+class IdleDeadline : public RefCounted<IdleDeadline> {
+public:
+    static Ref<IdleDeadline> create(double deadline, bool didTimeout)
+    {
+        return adoptRef(*new IdleDeadline(deadline, didTimeout));
+    }
+
+    // In milliseconds, like DOMHighResTimeStamp.
+    double timeRemaining() const;
+    bool didTimeout() const { return m_didTimeout; }
+
+private:
+    IdleDeadline(double deadline, bool didTimeout)
+        : m_deadline(deadline)
+        , m_didTimeout(didTimeout)
+    {
+    }
+
+    double m_deadline;
+    bool m_didTimeout;
+};
+
+} // namespace WebCore
+
+#endif // ENABLE(REQUEST_ANIMATION_FRAME)
+
+#endif // IdleDeadline_h
@@ -38,12 +38,15 @@
 #include "MutationCallback.h"
 #include "MutationObserverRegistration.h"
 #include "MutationRecord.h"
+#include "Settings.h"
 #include <algorithm>
 #include <wtf/MainThread.h>
 
 namespace WebCore {
 
 static unsigned s_observerPriority = 0;
+static uint64_t s_createdRecordCount = 0;
+static uint64_t s_deliveredRecordCount = 0;
 
 Ref<MutationObserver> MutationObserver::create(PassRefPtr<MutationCallback> callback)
 {
@@ -117,6 +120,7 @@ Vector<RefPtr<MutationRecord>> MutationObserver::takeRecords()
 {
     Vector<RefPtr<MutationRecord>> records;
     records.swap(m_records);
+    s_deliveredRecordCount += records.size();
     return records;
 }
 
@@ -154,10 +158,24 @@ static MutationObserverSet& suspendedMutationObservers()
     return suspendedObservers;
 }
 
-void MutationObserver::enqueueMutationRecord(PassRefPtr<MutationRecord> mutation)
+static bool shouldCoalesceChildListMutations(Node& target)
+{
+    Settings* settings = target.document().settings();
+    return settings && settings->mutationRecordCoalescingEnabled();
+}
+
+void MutationObserver::enqueueMutationRecord(PassRefPtr<MutationRecord> prpMutation)
 {
     ASSERT(isMainThread());
-    m_records.append(mutation);
+    RefPtr<MutationRecord> mutation = prpMutation;
+    ++s_createdRecordCount;
+
+    // A record that is only queued for this observer can absorb a childList mutation that continues it,
+    // so that building a subtree one child at a time is delivered as a single record.
+    bool coalesced = !m_records.isEmpty() && m_records.last()->hasOneRef() && mutation->isChildListRecord()
+        && shouldCoalesceChildListMutations(*mutation->target()) && m_records.last()->coalesceChildListMutation(*mutation);
+    if (!coalesced)
+        m_records.append(mutation.release());
     activeMutationObservers().add(this);
 }
 
@@ -199,6 +217,7 @@ void MutationObserver::deliver()
 
     Vector<RefPtr<MutationRecord>> records;
     records.swap(m_records);
+    s_deliveredRecordCount += records.size();
 
     m_callback->call(records, this);
 }
@@ -242,4 +261,14 @@ void MutationObserver::deliverAllMutations()
     deliveryInProgress = false;
 }
 
+uint64_t MutationObserver::createdRecordCount()
+{
+    return s_createdRecordCount;
+}
+
+uint64_t MutationObserver::deliveredRecordCount()
+{
+    return s_deliveredRecordCount;
+}
+
 } // namespace WebCore
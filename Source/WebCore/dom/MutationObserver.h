@@ -75,6 +75,10 @@ public:
     static Ref<MutationObserver> create(PassRefPtr<MutationCallback>);
     static void deliverAllMutations();
 
+    // Records enqueued for observers, counted before coalescing, and records handed to script.
+    static uint64_t createdRecordCount();
+    static uint64_t deliveredRecordCount();
+
     ~MutationObserver();
 
     void observe(Node*, const Dictionary&, ExceptionCode&);
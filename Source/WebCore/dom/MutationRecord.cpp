@@ -41,10 +41,10 @@ namespace {
 
 class ChildListRecord : public MutationRecord {
 public:
-    ChildListRecord(ContainerNode& target, PassRefPtr<NodeList> added, PassRefPtr<NodeList> removed, PassRefPtr<Node> previousSibling, PassRefPtr<Node> nextSibling)
+    ChildListRecord(ContainerNode& target, Vector<Ref<Node>>&& added, Vector<Ref<Node>>&& removed, PassRefPtr<Node> previousSibling, PassRefPtr<Node> nextSibling)
         : m_target(target)
-        , m_addedNodes(added)
-        , m_removedNodes(removed)
+        , m_addedNodes(WTF::move(added))
+        , m_removedNodes(WTF::move(removed))
         , m_previousSibling(previousSibling)
         , m_nextSibling(nextSibling)
     {
@@ -53,14 +53,29 @@ public:
 private:
     virtual const AtomicString& type() override;
     virtual Node* target() override { return m_target.ptr(); }
-    virtual NodeList* addedNodes() override { return m_addedNodes.get(); }
-    virtual NodeList* removedNodes() override { return m_removedNodes.get(); }
+    virtual NodeList* addedNodes() override { return lazilyInitializeNodeList(m_addedNodeList, m_addedNodes); }
+    virtual NodeList* removedNodes() override { return lazilyInitializeNodeList(m_removedNodeList, m_removedNodes); }
     virtual Node* previousSibling() override { return m_previousSibling.get(); }
     virtual Node* nextSibling() override { return m_nextSibling.get(); }
+    virtual bool isChildListRecord() const override { return true; }
+    virtual bool coalesceChildListMutation(MutationRecord&) override;
+
+    bool hasNodeLists() const { return m_addedNodeList || m_removedNodeList; }
+
+    // The node lists are only created once script asks for them, which keeps the records that are
+    // coalesced away or never looked at cheap.
+    static NodeList* lazilyInitializeNodeList(RefPtr<NodeList>& nodeList, Vector<Ref<Node>>& nodes)
+    {
+        if (!nodeList)
+            nodeList = StaticNodeList::adopt(nodes);
+        return nodeList.get();
+    }
 
     Ref<ContainerNode> m_target;
-    RefPtr<NodeList> m_addedNodes;
-    RefPtr<NodeList> m_removedNodes;
+    Vector<Ref<Node>> m_addedNodes;
+    Vector<Ref<Node>> m_removedNodes;
+    RefPtr<NodeList> m_addedNodeList;
+    RefPtr<NodeList> m_removedNodeList;
     RefPtr<Node> m_previousSibling;
     RefPtr<Node> m_nextSibling;
 };
@@ -143,6 +158,39 @@ private:
     RefPtr<MutationRecord> m_record;
 };
 
+bool ChildListRecord::coalesceChildListMutation(MutationRecord& mutation)
+{
+    if (!mutation.isChildListRecord() || mutation.target() != target())
+        return false;
+
+    ChildListRecord& next = static_cast<ChildListRecord&>(mutation);
+    if (hasNodeLists() || next.hasNodeLists())
+        return false;
+
+    if (m_removedNodes.isEmpty() && next.m_removedNodes.isEmpty()) {
+        if (m_addedNodes.isEmpty() || next.m_addedNodes.isEmpty())
+            return false;
+        if (next.m_previousSibling != m_addedNodes.last().ptr() || next.m_nextSibling != m_nextSibling)
+            return false;
+        for (auto& node : next.m_addedNodes)
+            m_addedNodes.append(WTF::move(node));
+        return true;
+    }
+
+    if (m_addedNodes.isEmpty() && next.m_addedNodes.isEmpty()) {
+        if (m_removedNodes.isEmpty() || next.m_removedNodes.isEmpty())
+            return false;
+        if (next.m_previousSibling != m_previousSibling || next.m_removedNodes.first().ptr() != m_nextSibling)
+            return false;
+        for (auto& node : next.m_removedNodes)
+            m_removedNodes.append(WTF::move(node));
+        m_nextSibling = next.m_nextSibling;
+        return true;
+    }
+
+    return false;
+}
+
 const AtomicString& ChildListRecord::type()
 {
     DEPRECATED_DEFINE_STATIC_LOCAL(AtomicString, childList, ("childList", AtomicString::ConstructFromLiteral));
@@ -163,9 +211,9 @@ const AtomicString& CharacterDataRecord::type()
 
 } // namespace
 
-PassRefPtr<MutationRecord> MutationRecord::createChildList(ContainerNode& target, PassRefPtr<NodeList> added, PassRefPtr<NodeList> removed, PassRefPtr<Node> previousSibling, PassRefPtr<Node> nextSibling)
+PassRefPtr<MutationRecord> MutationRecord::createChildList(ContainerNode& target, Vector<Ref<Node>>&& added, Vector<Ref<Node>>&& removed, PassRefPtr<Node> previousSibling, PassRefPtr<Node> nextSibling)
 {
-    return adoptRef(static_cast<MutationRecord*>(new ChildListRecord(target, added, removed, previousSibling, nextSibling)));
+    return adoptRef(static_cast<MutationRecord*>(new ChildListRecord(target, WTF::move(added), WTF::move(removed), previousSibling, nextSibling)));
 }
 
 PassRefPtr<MutationRecord> MutationRecord::createAttributes(Element& target, const QualifiedName& name, const AtomicString& oldValue)
@@ -32,8 +32,10 @@
 #define MutationRecord_h
 
 #include <wtf/PassRefPtr.h>
+#include <wtf/Ref.h>
 #include <wtf/RefCounted.h>
 #include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
 #include <wtf/text/WTFString.h>
 
 namespace WebCore {
@@ -47,7 +49,7 @@ class QualifiedName;
 
 class MutationRecord : public RefCounted<MutationRecord> {
 public:
-    static PassRefPtr<MutationRecord> createChildList(ContainerNode& target, PassRefPtr<NodeList> added, PassRefPtr<NodeList> removed, PassRefPtr<Node> previousSibling, PassRefPtr<Node> nextSibling);
+    static PassRefPtr<MutationRecord> createChildList(ContainerNode& target, Vector<Ref<Node>>&& added, Vector<Ref<Node>>&& removed, PassRefPtr<Node> previousSibling, PassRefPtr<Node> nextSibling);
     static PassRefPtr<MutationRecord> createAttributes(Element& target, const QualifiedName&, const AtomicString& oldValue);
     static PassRefPtr<MutationRecord> createCharacterData(CharacterData& target, const String& oldValue);
 
@@ -67,6 +69,13 @@ public:
     virtual const AtomicString& attributeNamespace() { return nullAtom; }
 
     virtual String oldValue() { return String(); }
+
+    virtual bool isChildListRecord() const { return false; }
+
+    // Merges a childList record that immediately continues this one (nodes appended right after
+    // the ones this record added, or removed right after the ones it removed) into this record.
+    // Only valid while the record has not been handed out to script.
+    virtual bool coalesceChildListMutation(MutationRecord&) { return false; }
 };
 
 } // namespace WebCore
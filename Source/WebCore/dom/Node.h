@@ -114,7 +114,7 @@ private:
 };
 
 class Node : public EventTarget, public ScriptWrappable {
-    WTF_MAKE_FAST_ALLOCATED;
+    WTF_MAKE_ISOLATED_ALLOCATED(DOMNodes);
 
     friend class Document;
     friend class TreeScope;
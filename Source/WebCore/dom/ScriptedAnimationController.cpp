@@ -33,16 +33,18 @@
 #include "Document.h"
 #include "DocumentLoader.h"
 #include "FrameView.h"
+#include "IdleDeadline.h"
+#include "IdleRequestCallback.h"
 #include "InspectorInstrumentation.h"
 #include "Logging.h"
 #include "MainFrame.h"
 #include "RequestAnimationFrameCallback.h"
 #include "Settings.h"
+#include <algorithm>
+#include <wtf/CurrentTime.h>
 #include <wtf/Ref.h>
 
 #if USE(REQUEST_ANIMATION_FRAME_TIMER)
-#include <algorithm>
-#include <wtf/CurrentTime.h>
 
 // Allow a little more than 60fps to make sure we can at least hit that frame rate.
 #define MinimumAnimationInterval 0.015
@@ -51,8 +53,14 @@
 
 namespace WebCore {
 
+// While frames are being produced, idle callbacks only get the rest of a 60fps frame. Otherwise an idle
+// period is capped so that input arriving meanwhile is still handled promptly.
+static const double idleFrameInterval = 1.0 / 60;
+static const double maximumIdlePeriod = 0.05;
+
 ScriptedAnimationController::ScriptedAnimationController(Document* document, PlatformDisplayID displayID)
     : m_document(document)
+    , m_idleTimer(*this, &ScriptedAnimationController::idleTimerFired)
 #if USE(REQUEST_ANIMATION_FRAME_TIMER)
     , m_animationTimer(*this, &ScriptedAnimationController::animationTimerFired)
 #endif
@@ -64,6 +72,12 @@ ScriptedAnimationController::~ScriptedAnimationController()
 {
 }
 
+void ScriptedAnimationController::clearDocumentPointer()
+{
+    m_document = nullptr;
+    m_idleTimer.stop();
+}
+
 void ScriptedAnimationController::suspend()
 {
     ++m_suspendCount;
@@ -78,6 +92,7 @@ void ScriptedAnimationController::resume()
 
     if (!m_suspendCount && m_callbacks.size())
         scheduleAnimation();
+    scheduleIdlePeriod();
 }
 
 void ScriptedAnimationController::setThrottled(bool isThrottled)
@@ -169,10 +184,109 @@ void ScriptedAnimationController::serviceScriptedAnimations(double monotonicTime
             ++i;
     }
 
+    if (!m_document)
+        return;
+
+    // Finish the style and layout the callbacks caused as part of this frame rather than whenever the
+    // next paint gets to it, so that the idle period below really starts after the frame's work.
+    if (FrameView* view = m_document->view())
+        view->updateLayoutAndStyleIfNeededRecursive();
+
+    m_lastFrameTimeMonotonic = monotonicTimeNow;
+    if (!m_idleRequests.isEmpty() && !m_suspendCount) {
+        m_idleTimer.stop();
+        m_idleTimer.startOneShot(0);
+    }
+
     if (m_callbacks.size())
         scheduleAnimation();
 }
 
+ScriptedAnimationController::CallbackId ScriptedAnimationController::registerIdleCallback(PassRefPtr<IdleRequestCallback> callback, double timeout)
+{
+    CallbackId id = ++m_nextCallbackId;
+    double timeoutTime = timeout > 0 ? monotonicallyIncreasingTime() + timeout / 1000 : 0;
+    m_idleRequests.append({ id, callback, timeoutTime });
+    scheduleIdlePeriod();
+    return id;
+}
+
+void ScriptedAnimationController::cancelIdleCallback(CallbackId id)
+{
+    m_idleRequests.removeFirstMatching([id](const IdleRequest& request) {
+        return request.id == id;
+    });
+}
+
+bool ScriptedAnimationController::isProducingFrames() const
+{
+    return !m_callbacks.isEmpty() && m_document && (!m_document->settings() || m_document->settings()->requestAnimationFrameEnabled());
+}
+
+void ScriptedAnimationController::scheduleIdlePeriod()
+{
+    if (m_idleRequests.isEmpty() || m_suspendCount || !m_document || m_idleTimer.isActive())
+        return;
+
+    if (!isProducingFrames()) {
+        m_idleTimer.startOneShot(0);
+        return;
+    }
+
+    // The next frame starts the idle period; only wake up early for a callback that would time out first.
+    double earliestTimeoutTime = 0;
+    for (auto& request : m_idleRequests) {
+        if (request.timeoutTime && (!earliestTimeoutTime || request.timeoutTime < earliestTimeoutTime))
+            earliestTimeoutTime = request.timeoutTime;
+    }
+    if (earliestTimeoutTime)
+        m_idleTimer.startOneShot(std::max(0.0, earliestTimeoutTime - monotonicallyIncreasingTime()));
+}
+
+void ScriptedAnimationController::idleTimerFired()
+{
+    if (!m_document || m_suspendCount)
+        return;
+
+    double deadline = monotonicallyIncreasingTime() + maximumIdlePeriod;
+    if (isProducingFrames())
+        deadline = std::min(deadline, m_lastFrameTimeMonotonic + idleFrameInterval);
+
+    runIdleCallbacks(deadline);
+    scheduleIdlePeriod();
+}
+
+void ScriptedAnimationController::runIdleCallbacks(double deadline)
+{
+    // Callbacks registered from here on wait for the next idle period.
+    Vector<CallbackId> ids;
+    ids.reserveInitialCapacity(m_idleRequests.size());
+    for (auto& request : m_idleRequests)
+        ids.uncheckedAppend(request.id);
+
+    Ref<ScriptedAnimationController> protect(*this);
+
+    for (auto id : ids) {
+        size_t index = 0;
+        while (index < m_idleRequests.size() && m_idleRequests[index].id != id)
+            ++index;
+        if (index == m_idleRequests.size())
+            continue;
+
+        double now = monotonicallyIncreasingTime();
+        bool didTimeout = m_idleRequests[index].timeoutTime && now >= m_idleRequests[index].timeoutTime;
+        if (!didTimeout && now >= deadline)
+            continue;
+
+        RefPtr<IdleRequestCallback> callback = m_idleRequests[index].callback.release();
+        m_idleRequests.remove(index);
+        callback->handleEvent(IdleDeadline::create(deadline, didTimeout).ptr());
+
+        if (!m_document)
+            return;
+    }
+}
+
 void ScriptedAnimationController::windowScreenDidChange(PlatformDisplayID displayID)
 {
     if (m_document->settings() && !m_document->settings()->requestAnimationFrameEnabled())
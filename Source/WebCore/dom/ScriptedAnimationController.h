@@ -28,15 +28,13 @@
 
 #if ENABLE(REQUEST_ANIMATION_FRAME)
 #include "DOMTimeStamp.h"
-#if USE(REQUEST_ANIMATION_FRAME_TIMER)
-#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+#if USE(REQUEST_ANIMATION_FRAME_TIMER) && USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
 #include "Chrome.h"
 #include "ChromeClient.h"
 #include "DisplayRefreshMonitorClient.h"
 #endif
-#include "Timer.h"
-#endif
 #include "PlatformScreen.h"
+#include "Timer.h"
 #include <wtf/RefCounted.h>
 #include <wtf/RefPtr.h>
 #include <wtf/Vector.h>
@@ -44,6 +42,7 @@
 namespace WebCore {
 
 class Document;
+class IdleRequestCallback;
 class RequestAnimationFrameCallback;
 
 class ScriptedAnimationController : public RefCounted<ScriptedAnimationController>
@@ -57,7 +56,7 @@ public:
         return adoptRef(*new ScriptedAnimationController(document, displayID));
     }
     ~ScriptedAnimationController();
-    void clearDocumentPointer() { m_document = nullptr; }
+    void clearDocumentPointer();
 
     typedef int CallbackId;
 
@@ -65,6 +64,12 @@ public:
     void cancelCallback(CallbackId);
     void serviceScriptedAnimations(double monotonicTimeNow);
 
+    // Idle callbacks run after a frame's animation callbacks, style and layout, in whatever is left of
+    // the frame, or in an idle period of their own when no frames are being produced. The timeout is
+    // in milliseconds; 0 means none.
+    CallbackId registerIdleCallback(PassRefPtr<IdleRequestCallback>, double timeout);
+    void cancelIdleCallback(CallbackId);
+
     void suspend();
     void resume();
     void setThrottled(bool);
@@ -84,6 +89,21 @@ private:
 
     void scheduleAnimation();
 
+    struct IdleRequest {
+        CallbackId id;
+        RefPtr<IdleRequestCallback> callback;
+        double timeoutTime;
+    };
+
+    bool isProducingFrames() const;
+    void scheduleIdlePeriod();
+    void idleTimerFired();
+    void runIdleCallbacks(double deadline);
+
+    Vector<IdleRequest> m_idleRequests;
+    Timer m_idleTimer;
+    double m_lastFrameTimeMonotonic { 0 };
+
 #if USE(REQUEST_ANIMATION_FRAME_TIMER)
     void animationTimerFired();
     Timer m_animationTimer;
@@ -29,7 +29,9 @@
 
 #include "CSSParser.h"
 #include "ElementDescendantIterator.h"
+#include "HTMLNames.h"
 #include "SelectorChecker.h"
+#include "Settings.h"
 #include "StaticNodeList.h"
 #include "StyledElement.h"
 
@@ -68,15 +70,51 @@ static IdMatchingType findIdMatchingType(const CSSSelector& firstSelector)
     return IdMatchingType::None;
 }
 
+static bool selectorDependsOnlyOnDOMTree(const CSSSelector& firstSelector)
+{
+    for (const CSSSelector* selector = &firstSelector; selector; selector = selector->tagHistory()) {
+        if (selector->selectorList())
+            return false;
+        switch (selector->match()) {
+        case CSSSelector::Tag:
+        case CSSSelector::Id:
+        case CSSSelector::Class:
+            break;
+        case CSSSelector::Exact:
+        case CSSSelector::Set:
+        case CSSSelector::List:
+        case CSSSelector::Hyphen:
+        case CSSSelector::Contain:
+        case CSSSelector::Begin:
+        case CSSSelector::End:
+            // The style attribute is synchronized lazily, without bumping the DOM tree version.
+            if (selector->attribute().localName() == HTMLNames::styleAttr.localName())
+                return false;
+            break;
+        case CSSSelector::PseudoClass:
+            if (!pseudoClassIsRelativeToSiblings(selector->pseudoClassType()) && selector->pseudoClassType() != CSSSelector::PseudoClassRoot)
+                return false;
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
 SelectorDataList::SelectorDataList(const CSSSelectorList& selectorList)
+    : m_resultDependsOnlyOnDOMTree(true)
 {
     unsigned selectorCount = 0;
     for (const CSSSelector* selector = selectorList.first(); selector; selector = CSSSelectorList::next(selector))
         selectorCount++;
 
     m_selectors.reserveInitialCapacity(selectorCount);
-    for (const CSSSelector* selector = selectorList.first(); selector; selector = CSSSelectorList::next(selector))
+    for (const CSSSelector* selector = selectorList.first(); selector; selector = CSSSelectorList::next(selector)) {
         m_selectors.uncheckedAppend(SelectorData(selector));
+        if (!selectorDependsOnlyOnDOMTree(*selector))
+            m_resultDependsOnlyOnDOMTree = false;
+    }
 
     if (selectorCount == 1) {
         const CSSSelector& selector = *m_selectors.first().selector;
@@ -169,6 +207,11 @@ RefPtr<NodeList> SelectorDataList::queryAll(ContainerNode& rootNode) const
     return StaticElementList::adopt(result);
 }
 
+void SelectorDataList::queryAll(ContainerNode& rootNode, Vector<Ref<Element>>& result) const
+{
+    execute<AllElementExtractorSelectorQueryTrait>(rootNode, result);
+}
+
 struct SingleElementExtractorSelectorQueryTrait {
     typedef Element* OutputType;
     static const bool shouldOnlyMatchFirstElement = true;
@@ -609,6 +652,54 @@ SelectorQuery::SelectorQuery(CSSSelectorList&& selectorList)
 {
 }
 
+bool SelectorQuery::canCacheResult(const ContainerNode& rootNode) const
+{
+    if (!m_selectors.resultDependsOnlyOnDOMTree())
+        return false;
+
+    // Nodes in the document can't go away without bumping its DOM tree version, so the cached
+    // pointers stay valid as long as the version matches.
+    if (!rootNode.inDocument())
+        return false;
+
+    Document& document = rootNode.document();
+    // SVG animated attributes, including class, are synchronized lazily as well.
+    if (document.svgExtensions())
+        return false;
+
+    Settings* settings = document.settings();
+    return settings && settings->selectorQueryResultCacheEnabled();
+}
+
+RefPtr<NodeList> SelectorQuery::queryAll(ContainerNode& rootNode) const
+{
+    if (!canCacheResult(rootNode)) {
+        m_cachedResultRootNode = nullptr;
+        m_cachedResult.clear();
+        return m_selectors.queryAll(rootNode);
+    }
+
+    uint64_t domTreeVersion = rootNode.document().domTreeVersion();
+    Vector<Ref<Element>> result;
+    if (m_cachedResultRootNode == &rootNode && m_cachedResultDOMTreeVersion == domTreeVersion) {
+        result.reserveInitialCapacity(m_cachedResult.size());
+        for (auto* element : m_cachedResult)
+            result.uncheckedAppend(*element);
+        return StaticElementList::adopt(result);
+    }
+
+    m_selectors.queryAll(rootNode, result);
+
+    m_cachedResultRootNode = &rootNode;
+    m_cachedResultDOMTreeVersion = domTreeVersion;
+    m_cachedResult.clear();
+    m_cachedResult.reserveInitialCapacity(result.size());
+    for (auto& element : result)
+        m_cachedResult.uncheckedAppend(element.ptr());
+
+    return StaticElementList::adopt(result);
+}
+
 SelectorQuery* SelectorQueryCache::add(const String& selectors, Document& document, ExceptionCode& ec)
 {
     auto it = m_entries.find(selectors);
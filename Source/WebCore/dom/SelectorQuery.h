@@ -51,8 +51,12 @@ public:
     bool matches(Element&) const;
     Element* closest(Element&) const;
     RefPtr<NodeList> queryAll(ContainerNode& rootNode) const;
+    void queryAll(ContainerNode& rootNode, Vector<Ref<Element>>&) const;
     Element* queryFirst(ContainerNode& rootNode) const;
 
+    // True if the result only depends on state that bumps the document's DOM tree version when it changes.
+    bool resultDependsOnlyOnDOMTree() const { return m_resultDependsOnlyOnDOMTree; }
+
 private:
     struct SelectorData {
         SelectorData(const CSSSelector* selector)
@@ -110,6 +114,7 @@ private:
         ClassNameMatch,
         MultipleSelectorMatch,
     } m_matchType;
+    bool m_resultDependsOnlyOnDOMTree;
 };
 
 class SelectorQuery {
@@ -124,8 +129,15 @@ public:
     Element* queryFirst(ContainerNode& rootNode) const;
 
 private:
+    bool canCacheResult(const ContainerNode& rootNode) const;
+
     CSSSelectorList m_selectorList;
     SelectorDataList m_selectors;
+
+    // The last queryAll() result, valid while the document's DOM tree version is unchanged.
+    mutable const ContainerNode* m_cachedResultRootNode { nullptr };
+    mutable uint64_t m_cachedResultDOMTreeVersion { 0 };
+    mutable Vector<Element*> m_cachedResult;
 };
 
 class SelectorQueryCache {
@@ -148,11 +160,6 @@ inline Element* SelectorQuery::closest(Element& element) const
     return m_selectors.closest(element);
 }
 
-inline RefPtr<NodeList> SelectorQuery::queryAll(ContainerNode& rootNode) const
-{
-    return m_selectors.queryAll(rootNode);
-}
-
 inline Element* SelectorQuery::queryFirst(ContainerNode& rootNode) const
 {
     return m_selectors.queryFirst(rootNode);
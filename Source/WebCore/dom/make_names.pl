@@ -214,6 +214,7 @@ sub defaultParametersHash
         'guardFactoryWith' => '',
         'tagsNullNamespace' => 0,
         'attrsNullNamespace' => 0,
+        'attrsLookupFunction' => 0,
         'fallbackInterfaceName' => '',
         'fallbackJSInterfaceName' => '',
     );
@@ -743,6 +744,10 @@ sub printNamesHeaderFile
     if (keys %allAttrs) {
         print F "const unsigned $parameters{namespace}AttrsCount = ", scalar(keys %allAttrs), ";\n";
         print F "const WebCore::QualifiedName* const* get$parameters{namespace}Attrs();\n";
+        if ($parameters{attrsLookupFunction}) {
+            print F "// Returns the attribute with the given name, or null if there is none.\n";
+            print F "const WebCore::QualifiedName* find$parameters{namespace}AttributeName(const UChar*, unsigned length);\n";
+        }
     }
 
     printInit($F, 1);
@@ -793,6 +798,8 @@ sub printNamesCppFile
         print F "    };\n";
         print F "    return $parameters{namespace}Attrs;\n";
         print F "}\n";
+
+        printFindAttributeNameFunction($F, \%allAttrs) if $parameters{attrsLookupFunction};
     }
 
     printInit($F, 0);
@@ -817,6 +824,49 @@ sub printNamesCppFile
     close F;
 }
 
+sub printFindAttributeNameFunction
+{
+    my ($F, $namesRef) = @_;
+
+    # Bucket the names by length and first character, then compare the remaining characters
+    # inline, so a lookup costs two jumps and at most a few short comparisons.
+    my %buckets;
+    for my $name (keys %$namesRef) {
+        my $value = valueForName($name);
+        push @{$buckets{length($value)}{substr($value, 0, 1)}}, [$name, $value];
+    }
+
+    print F "\nconst WebCore::QualifiedName* find$parameters{namespace}AttributeName(const UChar* characters, unsigned length)\n";
+    print F "{\n";
+    print F "    switch (length) {\n";
+    for my $length (sort { $a <=> $b } keys %buckets) {
+        print F "    case $length:\n";
+        print F "        switch (characters[0]) {\n";
+        for my $firstCharacter (sort keys %{$buckets{$length}}) {
+            print F "        case '$firstCharacter':\n";
+            for my $entry (sort { $a->[1] cmp $b->[1] } @{$buckets{$length}{$firstCharacter}}) {
+                my ($name, $value) = @$entry;
+                my @comparisons;
+                for my $i (1 .. $length - 1) {
+                    push @comparisons, "characters[$i] == '" . substr($value, $i, 1) . "'";
+                }
+                if (@comparisons) {
+                    print F "            if (" . join(" && ", @comparisons) . ")\n";
+                    print F "                return &${name}Attr;\n";
+                } else {
+                    print F "            return &${name}Attr;\n";
+                }
+            }
+            print F "            break;\n" if (grep { length($_->[1]) > 1 } @{$buckets{$length}{$firstCharacter}});
+        }
+        print F "        }\n";
+        print F "        break;\n";
+    }
+    print F "    }\n";
+    print F "    return nullptr;\n";
+    print F "}\n";
+}
+
 sub printJSElementIncludes
 {
     my $F = shift;
@@ -3193,44 +3193,20 @@ unsigned Editor::countMatchesForText(const String& target, Range* range, FindOpt
     if (!searchRange)
         searchRange = rangeOfContents(document());
 
-    Node& originalEndContainer = searchRange->endContainer();
-    int originalEndOffset = searchRange->endOffset();
-
-    unsigned matchCount = 0;
-    do {
-        RefPtr<Range> resultRange(findPlainText(*searchRange, target, options & ~Backwards));
-        if (resultRange->collapsed()) {
-            if (!resultRange->startContainer().isInShadowTree())
-                break;
-
-            searchRange->setStartAfter(resultRange->startContainer().shadowHost(), IGNORE_EXCEPTION);
-            searchRange->setEnd(&originalEndContainer, originalEndOffset, IGNORE_EXCEPTION);
-            continue;
-        }
+    // Collect all the matches in one pass over the text rather than restarting the search after
+    // each match, which made counting matches quadratic in the size of the document.
+    Vector<Ref<Range>> resultRanges;
+    findPlainTextMatches(*searchRange, target, options & ~Backwards, limit, resultRanges);
 
-        ++matchCount;
+    for (auto& resultRange : resultRanges) {
         if (matches)
-            matches->append(resultRange);
-        
-        if (markMatches)
-            document().markers().addMarker(resultRange.get(), DocumentMarker::TextMatch);
-
-        // Stop looking if we hit the specified limit. A limit of 0 means no limit.
-        if (limit > 0 && matchCount >= limit)
-            break;
-
-        // Set the new start for the search range to be the end of the previous
-        // result range. There is no need to use a VisiblePosition here,
-        // since findPlainText will use a TextIterator to go over the visible
-        // text nodes. 
-        searchRange->setStart(&resultRange->endContainer(), resultRange->endOffset(), IGNORE_EXCEPTION);
+            matches->append(resultRange.ptr());
 
-        Node* shadowTreeRoot = searchRange->shadowRoot();
-        if (searchRange->collapsed() && shadowTreeRoot)
-            searchRange->setEnd(shadowTreeRoot, shadowTreeRoot->countChildNodes(), IGNORE_EXCEPTION);
-    } while (true);
+        if (markMatches)
+            document().markers().addMarker(resultRange.ptr(), DocumentMarker::TextMatch);
+    }
 
-    return matchCount;
+    return resultRanges.size();
 }
 
 void Editor::setMarkedTextMatchesAreHighlighted(bool flag)
@@ -2609,22 +2609,27 @@ static Ref<Range> collapsedToBoundary(const Range& range, bool forward)
     return result;
 }
 
+static void prependContextBeforeRange(SearchBuffer& buffer, const Range& range)
+{
+    if (!buffer.needsMoreContext())
+        return;
+
+    Ref<Range> beforeStartRange = range.ownerDocument().createRange();
+    beforeStartRange->setEnd(&range.startContainer(), range.startOffset());
+    for (SimplifiedBackwardsTextIterator backwardsIterator(beforeStartRange.get()); !backwardsIterator.atEnd(); backwardsIterator.advance()) {
+        buffer.prependContext(backwardsIterator.text());
+        if (!buffer.needsMoreContext())
+            break;
+    }
+}
+
 static size_t findPlainText(const Range& range, const String& target, FindOptions options, size_t& matchStart)
 {
     matchStart = 0;
     size_t matchLength = 0;
 
     SearchBuffer buffer(target, options);
-
-    if (buffer.needsMoreContext()) {
-        Ref<Range> beforeStartRange = range.ownerDocument().createRange();
-        beforeStartRange->setEnd(&range.startContainer(), range.startOffset());
-        for (SimplifiedBackwardsTextIterator backwardsIterator(beforeStartRange.get()); !backwardsIterator.atEnd(); backwardsIterator.advance()) {
-            buffer.prependContext(backwardsIterator.text());
-            if (!buffer.needsMoreContext())
-                break;
-        }
-    }
+    prependContextBeforeRange(buffer, range);
 
     CharacterIterator findIterator(range, TextIteratorEntersTextControls);
 
@@ -2669,4 +2674,54 @@ Ref<Range> findPlainText(const Range& range, const String& target, FindOptions o
     return characterSubrange(range.ownerDocument(), computeRangeIterator, matchStart, matchLength);
 }
 
+void findPlainTextMatches(const Range& range, const String& target, FindOptions options, unsigned limit, Vector<Ref<Range>>& matches)
+{
+    ASSERT(!(options & Backwards));
+
+    // Find the character offsets of all the matches in a single pass over the text. The search
+    // buffer reports overlapping matches, but a match is only counted once the previous one ended,
+    // which is what restarting the search after each match would give.
+    Vector<std::pair<size_t, size_t>> matchOffsets;
+    {
+        SearchBuffer buffer(target, options);
+        prependContextBeforeRange(buffer, range);
+
+        size_t previousMatchEnd = 0;
+        CharacterIterator findIterator(range, TextIteratorEntersTextControls);
+        while (!findIterator.atEnd() && (!limit || matchOffsets.size() < limit)) {
+            findIterator.advance(buffer.append(findIterator.text()));
+tryAgain:
+            size_t matchStartOffset;
+            if (size_t matchLength = buffer.search(matchStartOffset)) {
+                size_t lastCharacterInBufferOffset = findIterator.characterOffset();
+                ASSERT(lastCharacterInBufferOffset >= matchStartOffset);
+                size_t matchStart = lastCharacterInBufferOffset - matchStartOffset;
+                if (matchStart >= previousMatchEnd) {
+                    matchOffsets.append(std::make_pair(matchStart, matchLength));
+                    previousMatchEnd = matchStart + matchLength;
+                    if (limit && matchOffsets.size() >= limit)
+                        break;
+                }
+                goto tryAgain;
+            }
+            if (findIterator.atBreak() && !buffer.atBreak()) {
+                buffer.reachedBreak();
+                goto tryAgain;
+            }
+        }
+    }
+
+    // Then turn the offsets into ranges, walking the text only once more since matches are in order.
+    Document& document = range.ownerDocument();
+    CharacterIterator computeRangeIterator(range, TextIteratorEntersTextControls);
+    for (auto& matchOffset : matchOffsets) {
+        size_t currentOffset = computeRangeIterator.characterOffset();
+        ASSERT(matchOffset.first >= currentOffset);
+        Ref<Range> matchRange = characterSubrange(document, computeRangeIterator, matchOffset.first - currentOffset, matchOffset.second);
+        if (matchRange->collapsed())
+            break;
+        matches.append(WTF::move(matchRange));
+    }
+}
+
 }
@@ -46,6 +46,8 @@ class RunResolver;
 WEBCORE_EXPORT String plainText(const Range*, TextIteratorBehavior = TextIteratorDefaultBehavior, bool isDisplayString = false);
 WEBCORE_EXPORT String plainTextReplacingNoBreakSpace(const Range*, TextIteratorBehavior = TextIteratorDefaultBehavior, bool isDisplayString = false);
 Ref<Range> findPlainText(const Range&, const String&, FindOptions);
+// Appends the ranges of all non-overlapping forward matches, up to limit (0 means no limit).
+void findPlainTextMatches(const Range&, const String&, FindOptions, unsigned limit, Vector<Ref<Range>>&);
 
 // FIXME: Move this somewhere else in the editing directory. It doesn't belong here.
 bool isRendererReplacedElement(RenderObject*);
@@ -37,7 +37,7 @@
 #include "URL.h"
 #include <wtf/AutodrainedPool.h>
 #include <wtf/MainThread.h>
-#include <wtf/MessageQueue.h>
+#include <wtf/LockFreeQueue.h>
 #include <wtf/NeverDestroyed.h>
 
 namespace WebCore {
@@ -68,7 +68,7 @@ static void callOnFileThread(std::function<void()>&& function)
     ASSERT(isMainThread());
     ASSERT(function);
 
-    static NeverDestroyed<MessageQueue<std::function<void()>>> queue;
+    static NeverDestroyed<MPSCQueue<std::function<void()>>> queue;
 
     static std::once_flag createFileThreadOnce;
     std::call_once(createFileThreadOnce, [] {
@@ -76,9 +76,9 @@ static void callOnFileThread(std::function<void()>&& function)
             for (;;) {
                 AutodrainedPool pool;
 
-                auto function = queue.get().waitForMessage();
+                auto function = queue.get().dequeue();
 
-                // This can never be null because we never kill the MessageQueue.
+                // This can never be null because we never kill the queue.
                 ASSERT(function);
 
                 // This can bever be null because we never queue a function that is null.
@@ -89,7 +89,7 @@ static void callOnFileThread(std::function<void()>&& function)
         });
     });
 
-    queue.get().append(std::make_unique<std::function<void()>>(WTF::move(function)));
+    queue.get().enqueue(WTF::move(function));
 }
 
 AsyncFileStream::AsyncFileStream(FileStreamClient& client)
@@ -28,6 +28,7 @@
 
 #include "AnimationController.h"
 #include "CachedFramePlatformData.h"
+#include "CachedResourceLoader.h"
 #include "DOMWindow.h"
 #include "Document.h"
 #include "DocumentLoader.h"
@@ -59,6 +60,24 @@ namespace WebCore {
 
 DEFINE_DEBUG_ONLY_GLOBAL(WTF::RefCountedLeakCounter, cachedFrameCounter, ("CachedFrame"));
 
+// Decoded frames are recreated from the encoded data the first time the images are painted after restoring the page.
+static void destroyDecodedImageData(Document& document)
+{
+    for (auto& resource : document.cachedResourceLoader().allCachedResources().values()) {
+        if (resource->isImage())
+            resource->destroyDecodedData();
+    }
+}
+
+// This doesn't account for the DOM, render tree or JavaScript heap, only for the resources the document holds on to.
+static unsigned estimatedResourceMemoryCost(Document& document)
+{
+    unsigned cost = 0;
+    for (auto& resource : document.cachedResourceLoader().allCachedResources().values())
+        cost += resource->size();
+    return cost;
+}
+
 CachedFrameBase::CachedFrameBase(Frame& frame)
     : m_document(frame.document())
     , m_documentLoader(frame.loader().documentLoader())
@@ -177,6 +196,13 @@ CachedFrame::CachedFrame(Frame& frame)
     if (m_isComposited && PageCache::singleton().shouldClearBackingStores())
         frame.view()->clearBackingStores();
 
+    if (PageCache::singleton().shouldDestroyDecodedImageData())
+        destroyDecodedImageData(*m_document);
+
+    m_estimatedMemoryCost = estimatedResourceMemoryCost(*m_document);
+    for (auto& childFrame : m_childFrames)
+        m_estimatedMemoryCost += childFrame->estimatedMemoryCost();
+
     frame.view()->clearScrollableAreas();
 
     // documentWillSuspendForPageCache() can set up a layout timer on the FrameView, so clear timers after that.
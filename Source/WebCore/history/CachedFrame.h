@@ -83,6 +83,12 @@ public:
     DocumentLoader* documentLoader() const { return m_documentLoader.get(); }
 
     int descendantFrameCount() const;
+
+    // Rough number of bytes kept alive by this frame and its descendants, taken when they entered the cache.
+    unsigned estimatedMemoryCost() const { return m_estimatedMemoryCost; }
+
+private:
+    unsigned m_estimatedMemoryCost { 0 };
 };
 
 } // namespace WebCore
@@ -52,6 +52,7 @@ DEFINE_DEBUG_ONLY_GLOBAL(WTF::RefCountedLeakCounter, cachedPageCounter, ("Cached
 CachedPage::CachedPage(Page& page)
     : m_expirationTime(monotonicallyIncreasingTime() + page.settings().backForwardCacheExpirationInterval())
     , m_cachedMainFrame(std::make_unique<CachedFrame>(page.mainFrame()))
+    , m_estimatedMemoryCost(m_cachedMainFrame->estimatedMemoryCost())
 {
 #ifndef NDEBUG
     cachedPageCounter.increment();
@@ -50,6 +50,8 @@ public:
     
     CachedFrame* cachedMainFrame() { return m_cachedMainFrame.get(); }
 
+    unsigned estimatedMemoryCost() const { return m_estimatedMemoryCost; }
+
     void markForVisitedLinkStyleRecalc() { m_needStyleRecalcForVisitedLinks = true; }
     void markForFullStyleRecalc() { m_needsFullStyleRecalc = true; }
 #if ENABLE(VIDEO_TRACK)
@@ -63,6 +65,7 @@ public:
 private:
     double m_expirationTime;
     std::unique_ptr<CachedFrame> m_cachedMainFrame;
+    unsigned m_estimatedMemoryCost;
     bool m_needStyleRecalcForVisitedLinks { false };
     bool m_needsFullStyleRecalc { false };
 #if ENABLE(VIDEO_TRACK)
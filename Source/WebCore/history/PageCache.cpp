@@ -302,6 +302,12 @@ void PageCache::setMaxSize(unsigned maxSize)
     prune(PruningReason::None);
 }
 
+void PageCache::setMaxCostInBytes(unsigned maxCostInBytes)
+{
+    m_maxCostInBytes = maxCostInBytes;
+    prune(PruningReason::None);
+}
+
 unsigned PageCache::frameCount() const
 {
     unsigned frameCount = m_items.size();
@@ -384,6 +390,7 @@ void PageCache::add(HistoryItem& item, Page& page)
     item.m_cachedPage = std::make_unique<CachedPage>(page);
     item.m_pruningReason = PruningReason::None;
     m_items.add(&item);
+    m_totalCostInBytes += item.m_cachedPage->estimatedMemoryCost();
     
     prune(PruningReason::ReachedMaxSize);
 }
@@ -396,8 +403,7 @@ std::unique_ptr<CachedPage> PageCache::take(HistoryItem& item, Page* page)
         return nullptr;
     }
 
-    m_items.remove(&item);
-    std::unique_ptr<CachedPage> cachedPage = WTF::move(item.m_cachedPage);
+    std::unique_ptr<CachedPage> cachedPage = takeCachedPage(item);
 
     if (cachedPage->hasExpired()) {
         LOG(PageCache, "Not restoring page for %s from back/forward cache because cache entry has expired", item.url().string().ascii().data());
@@ -432,15 +438,30 @@ void PageCache::remove(HistoryItem& item)
     if (!item.m_cachedPage)
         return;
 
+    takeCachedPage(item);
+}
+
+std::unique_ptr<CachedPage> PageCache::takeCachedPage(HistoryItem& item)
+{
+    ASSERT(item.m_cachedPage);
     m_items.remove(&item);
-    item.m_cachedPage = nullptr;
+    ASSERT(m_totalCostInBytes >= item.m_cachedPage->estimatedMemoryCost());
+    m_totalCostInBytes -= item.m_cachedPage->estimatedMemoryCost();
+    return WTF::move(item.m_cachedPage);
+}
+
+bool PageCache::exceedsMaxSize() const
+{
+    if (pageCount() > maxSize())
+        return true;
+    return m_maxCostInBytes && m_totalCostInBytes > m_maxCostInBytes;
 }
 
 void PageCache::prune(PruningReason pruningReason)
 {
-    while (pageCount() > maxSize()) {
-        auto oldestItem = m_items.takeFirst();
-        oldestItem->m_cachedPage = nullptr;
+    while (!m_items.isEmpty() && exceedsMaxSize()) {
+        RefPtr<HistoryItem> oldestItem = m_items.first();
+        takeCachedPage(*oldestItem);
         oldestItem->m_pruningReason = pruningReason;
     }
 }
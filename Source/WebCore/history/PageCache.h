@@ -53,6 +53,11 @@ public:
     WEBCORE_EXPORT void setMaxSize(unsigned); // number of pages to cache.
     unsigned maxSize() const { return m_maxSize; }
 
+    // Pages are also pruned, oldest first, while their estimated memory cost exceeds this. 0 means no limit.
+    WEBCORE_EXPORT void setMaxCostInBytes(unsigned);
+    unsigned maxCostInBytes() const { return m_maxCostInBytes; }
+    unsigned totalCostInBytes() const { return m_totalCostInBytes; }
+
     void add(HistoryItem&, Page&); // Prunes if maxSize() is exceeded.
     WEBCORE_EXPORT void remove(HistoryItem&);
     CachedPage* get(HistoryItem&, Page*);
@@ -73,6 +78,10 @@ public:
     bool shouldClearBackingStores() const { return m_shouldClearBackingStores; }
     void setShouldClearBackingStores(bool flag) { m_shouldClearBackingStores = flag; }
 
+    // Whether pages drop the decoded data of their images when they enter the cache.
+    bool shouldDestroyDecodedImageData() const { return m_shouldDestroyDecodedImageData; }
+    void setShouldDestroyDecodedImageData(bool flag) { m_shouldDestroyDecodedImageData = flag; }
+
 private:
     PageCache() = default; // Use singleton() instead.
     ~PageCache() = delete; // Make sure nobody accidentally calls delete -- WebCore does not delete singletons.
@@ -80,10 +89,15 @@ private:
     static bool canCachePageContainingThisFrame(Frame&);
 
     void prune(PruningReason);
+    bool exceedsMaxSize() const;
+    std::unique_ptr<CachedPage> takeCachedPage(HistoryItem&);
 
     ListHashSet<RefPtr<HistoryItem>> m_items;
     unsigned m_maxSize {0};
+    unsigned m_maxCostInBytes {0};
+    unsigned m_totalCostInBytes {0};
     bool m_shouldClearBackingStores {false};
+    bool m_shouldDestroyDecodedImageData {false};
 
     friend class WTF::NeverDestroyed<PageCache>;
 };
@@ -52,6 +52,11 @@ HTMLFrameElementBase::HTMLFrameElementBase(const QualifiedName& tagName, Documen
     setHasCustomStyleResolveCallbacks();
 }
 
+HTMLFrameElementBase::~HTMLFrameElementBase()
+{
+    document().cancelDeferredLoad(*this);
+}
+
 bool HTMLFrameElementBase::isURLAllowed() const
 {
     if (document().page() && document().page()->subframeCount() >= Page::maxNumberOfFrames)
@@ -87,9 +92,37 @@ void HTMLFrameElementBase::openURL(LockHistory lockHistory, LockBackForwardList
     if (!parentFrame)
         return;
 
+    if (shouldDeferLoadUntilNearViewport()) {
+        document().deferLoadUntilNearViewport(*this);
+        return;
+    }
+    document().cancelDeferredLoad(*this);
+
     parentFrame->loader().subframeLoader().requestFrame(*this, m_URL, m_frameName, lockHistory, lockBackForwardList);
 }
 
+bool HTMLFrameElementBase::shouldDeferLoadUntilNearViewport()
+{
+    // Only the initial network load of an iframe is held back; frames that already exist navigate
+    // right away, and about:blank, srcdoc and javascript: URLs are cheap enough to load eagerly.
+    if (!hasTagName(iframeTag) || contentFrame())
+        return false;
+
+    if (!document().completeURL(m_URL).protocolIsInHTTPFamily())
+        return false;
+
+    return document().shouldDeferLoadUntilNearViewport(*this);
+}
+
+void HTMLFrameElementBase::loadDeferredFrame()
+{
+    if (!inDocument() || contentFrame() || !isURLAllowed())
+        return;
+
+    if (Frame* parentFrame = document().frame())
+        parentFrame->loader().subframeLoader().requestFrame(*this, m_URL, m_frameName, LockHistory::Yes, LockBackForwardList::Yes);
+}
+
 void HTMLFrameElementBase::parseAttribute(const QualifiedName& name, const AtomicString& value)
 {
     if (name == srcdocAttr)
@@ -165,6 +198,13 @@ void HTMLFrameElementBase::didAttachRenderers()
     }
 }
 
+void HTMLFrameElementBase::didMoveToNewDocument(Document* oldDocument)
+{
+    if (oldDocument)
+        oldDocument->cancelDeferredLoad(*this);
+    HTMLFrameOwnerElement::didMoveToNewDocument(oldDocument);
+}
+
 URL HTMLFrameElementBase::location() const
 {
     if (fastHasAttribute(srcdocAttr))
@@ -45,8 +45,12 @@ public:
 
     virtual bool canContainRangeEndPoint() const override final { return false; }
 
+    // Creates the frame that openURL() held back because the iframe was far offscreen.
+    void loadDeferredFrame();
+
 protected:
     HTMLFrameElementBase(const QualifiedName&, Document&);
+    virtual ~HTMLFrameElementBase();
 
     bool isURLAllowed() const;
 
@@ -54,6 +58,7 @@ protected:
     virtual InsertionNotificationRequest insertedInto(ContainerNode&) override final;
     virtual void finishedInsertingSubtree() override final;
     virtual void didAttachRenderers() override;
+    virtual void didMoveToNewDocument(Document* oldDocument) override;
 
 private:
     virtual bool supportsFocus() const override final;
@@ -66,6 +71,7 @@ private:
 
     void setNameAndOpenURL();
     void openURL(LockHistory = LockHistory::Yes, LockBackForwardList = LockBackForwardList::Yes);
+    bool shouldDeferLoadUntilNearViewport();
 
     AtomicString m_URL;
     AtomicString m_frameName;
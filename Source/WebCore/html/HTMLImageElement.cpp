@@ -76,6 +76,7 @@ Ref<HTMLImageElement> HTMLImageElement::create(const QualifiedName& tagName, Doc
 
 HTMLImageElement::~HTMLImageElement()
 {
+    document().cancelDeferredLoad(*this);
     if (m_form)
         m_form->removeImgElement(this);
 }
@@ -459,6 +460,8 @@ void HTMLImageElement::addSubresourceAttributeURLs(ListHashSet<URL>& urls) const
 
 void HTMLImageElement::didMoveToNewDocument(Document* oldDocument)
 {
+    if (oldDocument)
+        oldDocument->cancelDeferredLoad(*this);
     m_imageLoader.elementDidMoveToNewDocument();
     HTMLElement::didMoveToNewDocument(oldDocument);
 }
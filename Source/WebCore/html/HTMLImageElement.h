@@ -84,6 +84,8 @@ public:
 
     bool hasPendingActivity() const { return m_imageLoader.hasPendingActivity(); }
 
+    void loadDeferredImage(ResourceLoadPriority priority) { m_imageLoader.loadDeferredImage(priority); }
+
     virtual bool canContainRangeEndPoint() const override { return false; }
 
     virtual const AtomicString& imageSourceURL() const override;
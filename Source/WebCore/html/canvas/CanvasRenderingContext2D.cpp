@@ -40,6 +40,9 @@
 #include "CanvasGradient.h"
 #include "CanvasPattern.h"
 #include "DOMPath.h"
+#include "DisplayList.h"
+#include "DisplayListRecorder.h"
+#include "DisplayListReplayer.h"
 #include "ExceptionCodePlaceholder.h"
 #include "FloatQuad.h"
 #include "HTMLImageElement.h"
@@ -50,11 +53,13 @@
 #include "RenderLayer.h"
 #include "RenderTheme.h"
 #include "SecurityOrigin.h"
+#include "Settings.h"
 #include "StrokeStyleApplier.h"
 #include "StyleProperties.h"
 #include "StyleResolver.h"
 #include "TextMetrics.h"
 #include "TextRun.h"
+#include "Timer.h"
 
 #include <wtf/CheckedArithmetic.h>
 #include <wtf/MathExtras.h>
@@ -66,10 +71,6 @@
 #endif // !PLATFORM(IOS)
 #endif
 
-#if PLATFORM(IOS)
-#include "Settings.h"
-#endif
-
 #if USE(CG)
 #define DefaultSmoothingQuality SmoothingQuality::Low
 #else
@@ -84,6 +85,9 @@ static const int defaultFontSize = 10;
 static const char* const defaultFontFamily = "sans-serif";
 static const char* const defaultFont = "10px sans-serif";
 
+// Past this many recorded items the deferred drawing is flushed without waiting for the script to return.
+static const size_t maximumDeferredDrawingItemCount = 4096;
+
 class CanvasStrokeStyleApplier : public StrokeStyleApplier {
 public:
     CanvasStrokeStyleApplier(CanvasRenderingContext2D* canvasContext)
@@ -108,11 +112,40 @@ private:
     CanvasRenderingContext2D* m_canvasContext;
 };
 
+// In deferred mode the canvas draws into a recording context standing in for the buffer's, and what it
+// records is replayed into the buffer once the script that drew returns, or earlier when something
+// needs the pixels. Only state that changed between two draws gets recorded, and drawing outside of the
+// canvas is dropped. The recording context keeps the state for as long as the canvas isn't reset, so
+// the buffer's context catches up on it with each flush.
+struct CanvasRenderingContext2D::DeferredDrawing {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    DeferredDrawing(CanvasRenderingContext2D& canvasContext, GraphicsContext& bufferContext)
+        : context(static_cast<PlatformGraphicsContext*>(nullptr))
+        , baseCTM(bufferContext.getCTM())
+        , recorder(context, displayList, FloatRect(FloatPoint(), canvasContext.canvas()->size()), baseCTM)
+        , flushTimer(canvasContext, &CanvasRenderingContext2D::deferredDrawingFlushTimerFired)
+    {
+        // Start from the state HTMLCanvasElement gives the context of a new buffer.
+        context.setShadowsIgnoreTransforms(bufferContext.shadowsIgnoreTransforms());
+        context.setImageInterpolationQuality(bufferContext.imageInterpolationQuality());
+        context.setShouldAntialias(bufferContext.shouldAntialias());
+        context.setStrokeThickness(bufferContext.strokeThickness());
+    }
+
+    GraphicsContext context;
+    DisplayList::DisplayList displayList;
+    AffineTransform baseCTM;
+    DisplayList::Recorder recorder;
+    Timer flushTimer;
+};
+
 CanvasRenderingContext2D::CanvasRenderingContext2D(HTMLCanvasElement* canvas, bool usesCSSCompatibilityParseMode, bool usesDashboardCompatibilityMode)
     : CanvasRenderingContext(canvas)
     , m_stateStack(1)
     , m_unrealizedSaveCount(0)
     , m_usesCSSCompatibilityParseMode(usesCSSCompatibilityParseMode)
+    , m_usesDeferredDrawing(canvas->document().settings() && canvas->document().settings()->canvasUsesDeferredDrawing())
 #if ENABLE(DASHBOARD_SUPPORT)
     , m_usesDashboardCompatibilityMode(usesDashboardCompatibilityMode)
 #endif
@@ -128,11 +161,18 @@ void CanvasRenderingContext2D::unwindStateStack()
     // is cleared before destruction, to avoid assertions in the
     // GraphicsContext dtor.
     if (size_t stackSize = m_stateStack.size()) {
-        if (GraphicsContext* context = canvas()->existingDrawingContext()) {
+        if (GraphicsContext* context = m_deferredDrawing ? &m_deferredDrawing->context : canvas()->existingDrawingContext()) {
             while (--stackSize)
                 context->restore();
         }
     }
+
+    // The restores only got recorded when drawing is deferred; hand them to the buffer's context along
+    // with the pending drawing, and start recording anew from its reset state next time.
+    if (m_deferredDrawing) {
+        flushDeferredDrawing();
+        m_deferredDrawing = nullptr;
+    }
 }
 
 CanvasRenderingContext2D::~CanvasRenderingContext2D()
@@ -147,7 +187,7 @@ bool CanvasRenderingContext2D::isAccelerated() const
 #if USE(IOSURFACE_CANVAS_BACKING_STORE) || ENABLE(ACCELERATED_2D_CANVAS)
     if (!canvas()->hasCreatedImageBuffer())
         return false;
-    GraphicsContext* context = drawingContext();
+    GraphicsContext* context = canvas()->drawingContext();
     return context && context->isAcceleratedContext();
 #else
     return false;
@@ -1531,6 +1571,8 @@ void CanvasRenderingContext2D::drawImage(HTMLCanvasElement* sourceCanvas, const
     // FIXME: Implement an accelerated path for drawing from a WebGL canvas to a 2d canvas when possible.
     if (!isAccelerated() || !sourceContext || !sourceContext->isAccelerated() || !sourceContext->is2d())
         sourceCanvas->makeRenderingResultsAvailable();
+    else
+        static_cast<CanvasRenderingContext2D*>(sourceContext)->flushDeferredDrawing();
 #else
     sourceCanvas->makeRenderingResultsAvailable();
 #endif
@@ -1873,6 +1915,13 @@ void CanvasRenderingContext2D::didDraw(const FloatRect& r, unsigned options)
     if (!state().hasInvertibleTransform)
         return;
 
+    if (m_deferredDrawing) {
+        if (m_deferredDrawing->displayList.itemCount() > maximumDeferredDrawingItemCount)
+            flushDeferredDrawing();
+        else if (!m_deferredDrawing->flushTimer.isActive())
+            m_deferredDrawing->flushTimer.startOneShot(0);
+    }
+
 #if ENABLE(ACCELERATED_2D_CANVAS)
     // If we are drawing to hardware and we have a composited layer, just call contentChanged().
     if (isAccelerated()) {
@@ -1911,7 +1960,41 @@ void CanvasRenderingContext2D::didDraw(const FloatRect& r, unsigned options)
 
 GraphicsContext* CanvasRenderingContext2D::drawingContext() const
 {
-    return canvas()->drawingContext();
+    if (m_deferredDrawing)
+        return &m_deferredDrawing->context;
+
+    GraphicsContext* context = canvas()->drawingContext();
+    if (!context || !m_usesDeferredDrawing)
+        return context;
+
+    m_deferredDrawing = std::make_unique<DeferredDrawing>(const_cast<CanvasRenderingContext2D&>(*this), *context);
+    return &m_deferredDrawing->context;
+}
+
+void CanvasRenderingContext2D::flushDeferredDrawing() const
+{
+    if (!m_deferredDrawing)
+        return;
+
+    m_deferredDrawing->flushTimer.stop();
+
+    DisplayList::DisplayList& displayList = m_deferredDrawing->displayList;
+    if (displayList.isEmpty())
+        return;
+
+    if (GraphicsContext* context = canvas()->existingDrawingContext())
+        DisplayList::Replayer(*context, displayList).replayAndKeepState(m_deferredDrawing->baseCTM);
+    displayList.clear();
+}
+
+void CanvasRenderingContext2D::deferredDrawingFlushTimerFired()
+{
+    flushDeferredDrawing();
+}
+
+void CanvasRenderingContext2D::paintRenderingResultsToCanvas()
+{
+    flushDeferredDrawing();
 }
 
 static RefPtr<ImageData> createEmptyImageData(const IntSize& size)
@@ -2005,6 +2088,7 @@ RefPtr<ImageData> CanvasRenderingContext2D::getImageData(ImageBuffer::Coordinate
         return nullptr;
 
     IntRect imageDataRect = enclosingIntRect(logicalRect);
+    flushDeferredDrawing();
     ImageBuffer* buffer = canvas()->buffer();
     if (!buffer)
         return createEmptyImageData(imageDataRect.size());
@@ -2103,6 +2187,7 @@ void CanvasRenderingContext2D::putImageData(ImageData* data, ImageBuffer::Coordi
     IntRect sourceRect(destRect);
     sourceRect.move(-destOffset);
 
+    flushDeferredDrawing();
     buffer->putByteArray(Unmultiplied, data->data(), IntSize(data->width(), data->height()), sourceRect, IntPoint(destOffset), coordinateSystem);
 
     didDraw(destRect, CanvasDidDrawApplyNone); // ignore transform, shadow and clip
@@ -39,6 +39,7 @@
 #include "Path.h"
 #include "PlatformLayer.h"
 #include "TextFlags.h"
+#include <memory>
 #include <wtf/Vector.h>
 #include <wtf/text/WTFString.h>
 
@@ -322,6 +323,10 @@ private:
 
     GraphicsContext* drawingContext() const;
 
+    // Replays the drawing recorded in deferred mode into the canvas buffer.
+    void flushDeferredDrawing() const;
+    void deferredDrawingFlushTimerFired();
+
     void unwindStateStack();
     void realizeSaves()
     {
@@ -375,6 +380,7 @@ private:
 
     virtual bool is2d() const override { return true; }
     virtual bool isAccelerated() const override;
+    virtual void paintRenderingResultsToCanvas() override;
 
     virtual bool hasInvertibleTransform() const override { return state().hasInvertibleTransform; }
     TextDirection toTextDirection(Direction, RenderStyle** computedStyle = nullptr) const;
@@ -386,6 +392,10 @@ private:
     Vector<State, 1> m_stateStack;
     unsigned m_unrealizedSaveCount;
     bool m_usesCSSCompatibilityParseMode;
+    bool m_usesDeferredDrawing;
+
+    struct DeferredDrawing;
+    mutable std::unique_ptr<DeferredDrawing> m_deferredDrawing;
 #if ENABLE(DASHBOARD_SUPPORT)
     bool m_usesDashboardCompatibilityMode;
 #endif
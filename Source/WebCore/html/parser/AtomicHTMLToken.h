@@ -27,6 +27,8 @@
 #ifndef AtomicHTMLToken_h
 #define AtomicHTMLToken_h
 
+#include "CompactHTMLToken.h"
+#include "HTMLNames.h"
 #include "HTMLToken.h"
 
 namespace WebCore {
@@ -34,6 +36,7 @@ namespace WebCore {
 class AtomicHTMLToken {
 public:
     explicit AtomicHTMLToken(HTMLToken&);
+    explicit AtomicHTMLToken(CompactHTMLToken&);
     AtomicHTMLToken(HTMLToken::Type, const AtomicString& name, Vector<Attribute>&& = Vector<Attribute>()); // Only StartTag or EndTag.
 
     HTMLToken::Type type() const;
@@ -71,6 +74,7 @@ private:
     HTMLToken::Type m_type;
 
     void initializeAttributes(const HTMLToken::AttributeList& attributes);
+    void initializeAttributes(const Vector<CompactHTMLToken::Attribute>& attributes);
 
     AtomicString m_name; // StartTag, EndTag, DOCTYPE.
 
@@ -190,11 +194,30 @@ inline void AtomicHTMLToken::initializeAttributes(const HTMLToken::AttributeList
         if (attribute.name.isEmpty())
             continue;
 
-        QualifiedName name(nullAtom, AtomicString(attribute.name), nullAtom);
+        // Most attribute names are known HTML attributes, for which we can skip atomizing the
+        // name and looking up its QualifiedName.
+        const QualifiedName* knownName = HTMLNames::findHTMLAttributeName(attribute.name.data(), attribute.name.size());
+        QualifiedName name = knownName ? *knownName : QualifiedName(nullAtom, AtomicString(attribute.name), nullAtom);
 
         // FIXME: This is N^2 for the number of attributes.
         if (!findAttribute(m_attributes, name))
-            m_attributes.append(Attribute(name, AtomicString(attribute.value)));
+            m_attributes.uncheckedAppend(Attribute(name, AtomicString(attribute.value)));
+    }
+}
+
+inline void AtomicHTMLToken::initializeAttributes(const Vector<CompactHTMLToken::Attribute>& attributes)
+{
+    unsigned size = attributes.size();
+    if (!size)
+        return;
+
+    m_attributes.reserveInitialCapacity(size);
+    for (auto& attribute : attributes) {
+        QualifiedName name = attribute.knownName ? *attribute.knownName : QualifiedName(nullAtom, AtomicString(attribute.name), nullAtom);
+
+        // FIXME: This is N^2 for the number of attributes.
+        if (!findAttribute(m_attributes, name))
+            m_attributes.uncheckedAppend(Attribute(name, AtomicString(attribute.value)));
     }
 }
 
@@ -232,6 +255,38 @@ inline AtomicHTMLToken::AtomicHTMLToken(HTMLToken& token)
     ASSERT_NOT_REACHED();
 }
 
+inline AtomicHTMLToken::AtomicHTMLToken(CompactHTMLToken& token)
+    : m_type(token.type())
+{
+    switch (m_type) {
+    case HTMLToken::Uninitialized:
+        ASSERT_NOT_REACHED();
+        return;
+    case HTMLToken::DOCTYPE:
+        m_name = AtomicString(token.name());
+        m_doctypeData = token.releaseDoctypeData();
+        return;
+    case HTMLToken::EndOfFile:
+        return;
+    case HTMLToken::StartTag:
+    case HTMLToken::EndTag:
+        m_selfClosing = token.selfClosing();
+        m_name = AtomicString(token.name());
+        initializeAttributes(token.attributes());
+        return;
+    case HTMLToken::Comment:
+        m_data = token.comment();
+        return;
+    case HTMLToken::Character:
+        // As with HTMLToken, the characters stay owned by the CompactHTMLToken.
+        m_externalCharacters = token.characters().data();
+        m_externalCharactersLength = token.characters().size();
+        m_externalCharactersIsAll8BitData = token.charactersIsAll8BitData();
+        return;
+    }
+    ASSERT_NOT_REACHED();
+}
+
 inline AtomicHTMLToken::AtomicHTMLToken(HTMLToken::Type type, const AtomicString& name, Vector<Attribute>&& attributes)
     : m_type(type)
     , m_name(name)
@@ -0,0 +1,270 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "BackgroundHTMLTokenizer.h"
+
+#include <wtf/CurrentTime.h>
+#include <wtf/MainThread.h>
+#include <wtf/WorkQueue.h>
+
+namespace WebCore {
+
+static const unsigned defaultPreferredChunkSize = 256;
+
+static WorkQueue& tokenizerQueue()
+{
+    static auto& queue = WorkQueue::create("org.webkit.HTMLTokenizer").leakRef();
+    return queue;
+}
+
+// The tokenizer lowercases tag names, so an exact comparison is enough.
+template<size_t length>
+static bool tagNameIs(const HTMLToken::DataVector& name, const char (&expected)[length])
+{
+    if (name.size() != length - 1)
+        return false;
+    for (size_t i = 0; i < length - 1; ++i) {
+        if (name[i] != static_cast<LChar>(expected[i]))
+            return false;
+    }
+    return true;
+}
+
+static bool hasAttribute(const HTMLToken& token, const char* name)
+{
+    return findAttribute(token.attributes(), StringView(reinterpret_cast<const LChar*>(name), strlen(name)));
+}
+
+// https://html.spec.whatwg.org/multipage/syntax.html#parsing-main-inforeign
+static bool isHTMLBreakoutTag(const HTMLToken& token)
+{
+    auto& name = token.name();
+    if (tagNameIs(name, "font"))
+        return hasAttribute(token, "color") || hasAttribute(token, "face") || hasAttribute(token, "size");
+    return tagNameIs(name, "b") || tagNameIs(name, "big") || tagNameIs(name, "blockquote") || tagNameIs(name, "body")
+        || tagNameIs(name, "br") || tagNameIs(name, "center") || tagNameIs(name, "code") || tagNameIs(name, "dd")
+        || tagNameIs(name, "div") || tagNameIs(name, "dl") || tagNameIs(name, "dt") || tagNameIs(name, "em")
+        || tagNameIs(name, "embed") || tagNameIs(name, "h1") || tagNameIs(name, "h2") || tagNameIs(name, "h3")
+        || tagNameIs(name, "h4") || tagNameIs(name, "h5") || tagNameIs(name, "h6") || tagNameIs(name, "head")
+        || tagNameIs(name, "hr") || tagNameIs(name, "i") || tagNameIs(name, "img") || tagNameIs(name, "li")
+        || tagNameIs(name, "listing") || tagNameIs(name, "menu") || tagNameIs(name, "meta") || tagNameIs(name, "nobr")
+        || tagNameIs(name, "ol") || tagNameIs(name, "p") || tagNameIs(name, "pre") || tagNameIs(name, "ruby")
+        || tagNameIs(name, "s") || tagNameIs(name, "small") || tagNameIs(name, "span") || tagNameIs(name, "strong")
+        || tagNameIs(name, "strike") || tagNameIs(name, "sub") || tagNameIs(name, "sup") || tagNameIs(name, "table")
+        || tagNameIs(name, "tt") || tagNameIs(name, "u") || tagNameIs(name, "ul") || tagNameIs(name, "var");
+}
+
+static bool isSVGHTMLIntegrationPoint(const HTMLToken::DataVector& name)
+{
+    return tagNameIs(name, "foreignobject") || tagNameIs(name, "desc") || tagNameIs(name, "title");
+}
+
+static bool isMathMLTextIntegrationPoint(const HTMLToken::DataVector& name)
+{
+    return tagNameIs(name, "mi") || tagNameIs(name, "mo") || tagNameIs(name, "mn") || tagNameIs(name, "ms") || tagNameIs(name, "mtext");
+}
+
+Ref<BackgroundHTMLTokenizer> BackgroundHTMLTokenizer::create(Client& client, const HTMLParserOptions& options)
+{
+    return adoptRef(*new BackgroundHTMLTokenizer(client, options));
+}
+
+BackgroundHTMLTokenizer::BackgroundHTMLTokenizer(Client& client, const HTMLParserOptions& options)
+    : m_client(&client)
+    , m_tokenizer(options)
+    , m_scriptEnabled(options.scriptEnabled)
+    , m_pluginsEnabled(options.pluginsEnabled)
+    , m_preferredChunkSize(defaultPreferredChunkSize)
+{
+}
+
+BackgroundHTMLTokenizer::~BackgroundHTMLTokenizer()
+{
+}
+
+void BackgroundHTMLTokenizer::append(const String& source)
+{
+    ASSERT(isMainThread());
+    ASSERT(m_client);
+
+    RefPtr<BackgroundHTMLTokenizer> protectedThis(this);
+    StringCapture capturedSource(source);
+    tokenizerQueue().dispatch([protectedThis, capturedSource] {
+        protectedThis->m_input.append(SegmentedString(capturedSource.string()));
+        protectedThis->tokenize();
+    });
+}
+
+void BackgroundHTMLTokenizer::finish()
+{
+    ASSERT(isMainThread());
+    ASSERT(m_client);
+
+    RefPtr<BackgroundHTMLTokenizer> protectedThis(this);
+    tokenizerQueue().dispatch([protectedThis] {
+        protectedThis->m_input.append(SegmentedString(String(&kEndOfFileMarker, 1)));
+        protectedThis->m_input.close();
+        protectedThis->tokenize();
+    });
+}
+
+void BackgroundHTMLTokenizer::stop()
+{
+    ASSERT(isMainThread());
+    m_client = nullptr;
+    m_stopped.store(true);
+}
+
+std::unique_ptr<BackgroundHTMLTokenizer::TokenizedChunk> BackgroundHTMLTokenizer::takeChunk()
+{
+    ASSERT(isMainThread());
+    if (auto chunk = m_chunks.tryDequeue())
+        return WTF::move(*chunk);
+    return nullptr;
+}
+
+void BackgroundHTMLTokenizer::setPreferredChunkSize(unsigned size)
+{
+    ASSERT(isMainThread());
+    m_preferredChunkSize.store(std::max(size, 1u), std::memory_order_relaxed);
+}
+
+void BackgroundHTMLTokenizer::tokenize()
+{
+    ASSERT(!isMainThread());
+    if (m_stopped.load())
+        return;
+
+    double startTime = monotonicallyIncreasingTime();
+    if (!m_chunk)
+        m_chunk = std::make_unique<TokenizedChunk>();
+
+    while (auto token = m_tokenizer.nextToken(m_input)) {
+        HTMLToken::Type type = token->type();
+        bool isScriptEndTag = type == HTMLToken::EndTag && tagNameIs(token->name(), "script");
+        if (type == HTMLToken::StartTag || type == HTMLToken::EndTag)
+            simulateTreeBuilder(*token);
+
+        TextPosition textPosition(m_input.currentLine(), m_input.currentColumn());
+        m_chunk->tokens.append(SpeculativeToken { CompactHTMLToken(*token), textPosition, static_cast<unsigned>(m_input.numberOfCharactersConsumed()), m_tokenizer.speculativeState() });
+        token.clear();
+
+        // The main thread can't do anything past a script until it has run it, so hand
+        // the script over right away instead of waiting for the chunk to fill.
+        if (isScriptEndTag || type == HTMLToken::EndOfFile || m_chunk->tokens.size() >= m_preferredChunkSize.load(std::memory_order_relaxed)) {
+            flushChunk(startTime);
+            if (m_stopped.load())
+                return;
+            m_chunk = std::make_unique<TokenizedChunk>();
+        }
+    }
+
+    // We've run out of input. Don't sit on what we have while waiting for the network.
+    flushChunk(startTime);
+}
+
+void BackgroundHTMLTokenizer::simulateTreeBuilder(const HTMLToken& token)
+{
+    auto& name = token.name();
+    bool inTextInsertionMode = false;
+
+    if (token.type() == HTMLToken::StartTag) {
+        if (inForeignContent() && isHTMLBreakoutTag(token)) {
+            while (inForeignContent())
+                m_namespaceStack.removeLast();
+        }
+
+        if (!inForeignContent()) {
+            if (tagNameIs(name, "svg")) {
+                if (!token.selfClosing())
+                    m_namespaceStack.append(Namespace::SVG);
+            } else if (tagNameIs(name, "math")) {
+                if (!token.selfClosing())
+                    m_namespaceStack.append(Namespace::MathML);
+            } else if (tagNameIs(name, "textarea") || tagNameIs(name, "title")) {
+                m_tokenizer.setRCDATAState();
+                inTextInsertionMode = true;
+            } else if (tagNameIs(name, "plaintext"))
+                m_tokenizer.setPLAINTEXTState();
+            else if (tagNameIs(name, "script")) {
+                m_tokenizer.setScriptDataState();
+                inTextInsertionMode = true;
+            } else if (tagNameIs(name, "style")
+                || tagNameIs(name, "iframe")
+                || tagNameIs(name, "xmp")
+                || (tagNameIs(name, "noembed") && m_pluginsEnabled)
+                || tagNameIs(name, "noframes")
+                || (tagNameIs(name, "noscript") && m_scriptEnabled)) {
+                m_tokenizer.setRAWTEXTState();
+                inTextInsertionMode = true;
+            }
+        } else if (!token.selfClosing()) {
+            Namespace currentNamespace = m_namespaceStack.last();
+            if ((currentNamespace == Namespace::SVG && isSVGHTMLIntegrationPoint(name))
+                || (currentNamespace == Namespace::MathML && isMathMLTextIntegrationPoint(name)))
+                m_namespaceStack.append(Namespace::HTML);
+        }
+    } else {
+        ASSERT(token.type() == HTMLToken::EndTag);
+        if (!m_namespaceStack.isEmpty()) {
+            Namespace currentNamespace = m_namespaceStack.last();
+            Namespace enclosingNamespace = m_namespaceStack.size() > 1 ? m_namespaceStack[m_namespaceStack.size() - 2] : Namespace::HTML;
+            if ((currentNamespace == Namespace::SVG && tagNameIs(name, "svg"))
+                || (currentNamespace == Namespace::MathML && tagNameIs(name, "math"))
+                || (currentNamespace == Namespace::HTML && enclosingNamespace == Namespace::SVG && isSVGHTMLIntegrationPoint(name))
+                || (currentNamespace == Namespace::HTML && enclosingNamespace == Namespace::MathML && isMathMLTextIntegrationPoint(name)))
+                m_namespaceStack.removeLast();
+        }
+    }
+
+    // This mirrors the end of HTMLTreeBuilder::constructTree.
+    m_tokenizer.setForceNullCharacterReplacement(inTextInsertionMode || inForeignContent());
+    m_tokenizer.setShouldAllowCDATA(inForeignContent());
+}
+
+void BackgroundHTMLTokenizer::flushChunk(double& startTime)
+{
+    double now = monotonicallyIncreasingTime();
+    m_chunk->tokenizationTime += now - startTime;
+    startTime = now;
+
+    if (m_chunk->tokens.isEmpty())
+        return;
+
+    m_chunks.enqueue(WTF::move(m_chunk));
+
+    if (m_hasPendingNotification.exchange(true))
+        return;
+
+    RefPtr<BackgroundHTMLTokenizer> protectedThis(this);
+    callOnMainThread([protectedThis] {
+        protectedThis->m_hasPendingNotification.store(false);
+        if (protectedThis->m_client)
+            protectedThis->m_client->didTokenizeChunk();
+    });
+}
+
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef BackgroundHTMLTokenizer_h
+#define BackgroundHTMLTokenizer_h
+
+#include "CompactHTMLToken.h"
+#include "HTMLParserOptions.h"
+#include "HTMLTokenizer.h"
+#include "SegmentedString.h"
+#include <atomic>
+#include <wtf/LockFreeQueue.h>
+#include <wtf/ThreadSafeRefCounted.h>
+#include <wtf/text/TextPosition.h>
+
+namespace WebCore {
+
+// Tokenizes a document's network input on a background thread and hands the tokens to the main
+// thread in chunks. Nothing on the background thread knows about the tree builder, so the tokenizer
+// state switches the tree builder would make after each tag (RAWTEXT after <style>, CDATA in <svg>,
+// and so on) are predicted. Every token records the prediction it was tokenized under, and where in
+// the input it ended, so HTMLDocumentParser can check the prediction and fall back to tokenizing on
+// the main thread from the last token it accepted.
+class BackgroundHTMLTokenizer : public ThreadSafeRefCounted<BackgroundHTMLTokenizer> {
+public:
+    class Client {
+    public:
+        virtual ~Client() { }
+
+        // Called on the main thread after one or more chunks were tokenized.
+        virtual void didTokenizeChunk() = 0;
+    };
+
+    struct SpeculativeToken {
+        CompactHTMLToken token;
+        // Where the main thread's input would be positioned after this token.
+        TextPosition textPosition;
+        // The number of input characters consumed up to the end of this token.
+        unsigned inputOffset;
+        // The state the next token was tokenized in, after the simulated tree builder saw this one.
+        HTMLTokenizer::SpeculativeState tokenizerState;
+    };
+
+    struct TokenizedChunk {
+        WTF_MAKE_FAST_ALLOCATED;
+    public:
+        Vector<SpeculativeToken> tokens;
+        // Time spent tokenizing on the background thread, not including time waiting for input.
+        double tokenizationTime { 0 };
+    };
+
+    static Ref<BackgroundHTMLTokenizer> create(Client&, const HTMLParserOptions&);
+    ~BackgroundHTMLTokenizer();
+
+    // These are main thread only.
+    void append(const String&);
+    void finish();
+    void stop();
+    std::unique_ptr<TokenizedChunk> takeChunk();
+    void setPreferredChunkSize(unsigned);
+
+private:
+    BackgroundHTMLTokenizer(Client&, const HTMLParserOptions&);
+
+    enum class Namespace { HTML, SVG, MathML };
+
+    // These run on the tokenizer thread.
+    void tokenize();
+    void simulateTreeBuilder(const HTMLToken&);
+    bool inForeignContent() const { return !m_namespaceStack.isEmpty() && m_namespaceStack.last() != Namespace::HTML; }
+    void flushChunk(double& startTime);
+
+    Client* m_client;
+
+    HTMLTokenizer m_tokenizer;
+    SegmentedString m_input;
+    Vector<Namespace, 4> m_namespaceStack;
+    std::unique_ptr<TokenizedChunk> m_chunk;
+    const bool m_scriptEnabled;
+    const bool m_pluginsEnabled;
+
+    MPSCQueue<std::unique_ptr<TokenizedChunk>> m_chunks;
+    std::atomic<unsigned> m_preferredChunkSize;
+    std::atomic<bool> m_hasPendingNotification { false };
+    std::atomic<bool> m_stopped { false };
+};
+
+}
+
+#endif
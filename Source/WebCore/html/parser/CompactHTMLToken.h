@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CompactHTMLToken_h
+#define CompactHTMLToken_h
+
+#include "HTMLNames.h"
+#include "HTMLToken.h"
+#include <wtf/text/WTFString.h>
+
+namespace WebCore {
+
+// A finished HTMLToken that owns exactly the storage it needs, so that a background tokenizer can
+// batch thousands of them without carrying HTMLToken's inline buffers. It holds no AtomicStrings,
+// so it can be built on one thread and turned into an AtomicHTMLToken on another.
+class CompactHTMLToken {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    struct Attribute {
+        // Known HTML attribute names are resolved on the tokenizing thread; the QualifiedNames
+        // in HTMLNames are never destroyed, so the pointer can be handed to the main thread
+        // without touching their reference counts. name is only set when knownName is null.
+        const QualifiedName* knownName;
+        String name;
+        String value;
+    };
+
+    explicit CompactHTMLToken(HTMLToken&);
+    CompactHTMLToken(CompactHTMLToken&&) = default;
+    CompactHTMLToken& operator=(CompactHTMLToken&&) = default;
+
+    HTMLToken::Type type() const { return m_type; }
+
+    // StartTag, EndTag, DOCTYPE.
+    const String& name() const;
+
+    // DOCTYPE.
+    std::unique_ptr<DoctypeData> releaseDoctypeData();
+
+    // StartTag, EndTag.
+    bool selfClosing() const;
+    const Vector<Attribute>& attributes() const;
+
+    // Character.
+    const Vector<UChar>& characters() const;
+    bool charactersIsAll8BitData() const;
+
+    // Comment.
+    const String& comment() const;
+
+private:
+    HTMLToken::Type m_type;
+    bool m_selfClosing { false }; // StartTag, EndTag.
+    bool m_charactersIsAll8BitData { false }; // Character.
+    String m_data; // StartTag, EndTag, DOCTYPE, Comment.
+    Vector<UChar> m_characters; // Character.
+    Vector<Attribute> m_attributes; // StartTag, EndTag.
+    std::unique_ptr<DoctypeData> m_doctypeData; // DOCTYPE.
+};
+
+inline CompactHTMLToken::CompactHTMLToken(HTMLToken& token)
+    : m_type(token.type())
+{
+    switch (m_type) {
+    case HTMLToken::Uninitialized:
+        ASSERT_NOT_REACHED();
+        return;
+    case HTMLToken::DOCTYPE:
+        m_data = String(token.name().data(), token.name().size());
+        m_doctypeData = token.releaseDoctypeData();
+        return;
+    case HTMLToken::EndOfFile:
+        return;
+    case HTMLToken::StartTag:
+    case HTMLToken::EndTag:
+        m_selfClosing = token.selfClosing();
+        m_data = String(token.name().data(), token.name().size());
+        m_attributes.reserveInitialCapacity(token.attributes().size());
+        for (auto& attribute : token.attributes()) {
+            if (attribute.name.isEmpty())
+                continue;
+            const QualifiedName* knownName = HTMLNames::findHTMLAttributeName(attribute.name.data(), attribute.name.size());
+            m_attributes.uncheckedAppend({ knownName, knownName ? String() : String(attribute.name.data(), attribute.name.size()), StringImpl::create8BitIfPossible(attribute.value) });
+        }
+        return;
+    case HTMLToken::Comment:
+        if (token.commentIsAll8BitData())
+            m_data = String::make8BitFrom16BitSource(token.comment());
+        else
+            m_data = String(token.comment());
+        return;
+    case HTMLToken::Character:
+        m_characters.reserveInitialCapacity(token.characters().size());
+        m_characters.append(token.characters().data(), token.characters().size());
+        m_charactersIsAll8BitData = token.charactersIsAll8BitData();
+        return;
+    }
+    ASSERT_NOT_REACHED();
+}
+
+inline const String& CompactHTMLToken::name() const
+{
+    ASSERT(m_type == HTMLToken::StartTag || m_type == HTMLToken::EndTag || m_type == HTMLToken::DOCTYPE);
+    return m_data;
+}
+
+inline std::unique_ptr<DoctypeData> CompactHTMLToken::releaseDoctypeData()
+{
+    ASSERT(m_type == HTMLToken::DOCTYPE);
+    return WTF::move(m_doctypeData);
+}
+
+inline bool CompactHTMLToken::selfClosing() const
+{
+    ASSERT(m_type == HTMLToken::StartTag || m_type == HTMLToken::EndTag);
+    return m_selfClosing;
+}
+
+inline const Vector<CompactHTMLToken::Attribute>& CompactHTMLToken::attributes() const
+{
+    ASSERT(m_type == HTMLToken::StartTag || m_type == HTMLToken::EndTag);
+    return m_attributes;
+}
+
+inline const Vector<UChar>& CompactHTMLToken::characters() const
+{
+    ASSERT(m_type == HTMLToken::Character);
+    return m_characters;
+}
+
+inline bool CompactHTMLToken::charactersIsAll8BitData() const
+{
+    ASSERT(m_type == HTMLToken::Character);
+    return m_charactersIsAll8BitData;
+}
+
+inline const String& CompactHTMLToken::comment() const
+{
+    ASSERT(m_type == HTMLToken::Comment);
+    return m_data;
+}
+
+}
+
+#endif
@@ -34,6 +34,7 @@
 #include "HTMLPreloadScanner.h"
 #include "HTMLScriptRunner.h"
 #include "HTMLTreeBuilder.h"
+#include <wtf/TraceEvent.h>
 
 namespace WebCore {
 
@@ -80,6 +81,7 @@ HTMLDocumentParser::~HTMLDocumentParser()
     ASSERT(!m_pumpSessionNestingLevel);
     ASSERT(!m_preloadScanner);
     ASSERT(!m_insertionPreloadScanner);
+    ASSERT(!m_backgroundTokenizer);
 }
 
 void HTMLDocumentParser::detach()
@@ -93,12 +95,16 @@ void HTMLDocumentParser::detach()
     m_preloadScanner = nullptr;
     m_insertionPreloadScanner = nullptr;
     m_parserScheduler = nullptr; // Deleting the scheduler will clear any timers.
+    if (m_backgroundTokenizer)
+        stopBackgroundTokenizer();
 }
 
 void HTMLDocumentParser::stopParsing()
 {
     DocumentParser::stopParsing();
     m_parserScheduler = nullptr; // Deleting the scheduler will clear any timers.
+    if (m_backgroundTokenizer)
+        stopBackgroundTokenizer();
 }
 
 // This kicks off "Once the user agent stops parsing" as described by:
@@ -139,7 +145,8 @@ inline bool HTMLDocumentParser::inPumpSession() const
 
 inline bool HTMLDocumentParser::shouldDelayEnd() const
 {
-    return inPumpSession() || isWaitingForScripts() || isScheduledForResume() || isExecutingScript();
+    // A background tokenizer keeps us from ending until the tree builder has seen its end of file token.
+    return inPumpSession() || isWaitingForScripts() || isScheduledForResume() || isExecutingScript() || m_backgroundTokenizer;
 }
 
 bool HTMLDocumentParser::isParsingFragment() const
@@ -149,7 +156,7 @@ bool HTMLDocumentParser::isParsingFragment() const
 
 bool HTMLDocumentParser::processingData() const
 {
-    return isScheduledForResume() || inPumpSession();
+    return isScheduledForResume() || inPumpSession() || m_backgroundTokenizer;
 }
 
 void HTMLDocumentParser::pumpTokenizerIfPossible(SynchronousMode mode)
@@ -245,11 +252,18 @@ void HTMLDocumentParser::pumpTokenizer(SynchronousMode mode)
     // This is an attempt to check that this object is both attached to the Document and protected by something.
     ASSERT(refCount() >= 2);
 
+    TraceScope traceScope(TraceCategory::Parsing, "HTMLDocumentParser::pumpTokenizer");
     PumpSession session(m_pumpSessionNestingLevel, contextForParsingSession());
 
     m_xssAuditor.init(document(), &m_xssAuditorDelegate);
 
     while (canTakeNextToken(mode, session) && !session.needsYield) {
+        if (m_backgroundTokenizer) {
+            if (!constructTreeFromSpeculativeToken())
+                break;
+            continue;
+        }
+
         if (!isParsingFragment())
             m_sourceTracker.startToken(m_input.current(), m_tokenizer);
 
@@ -283,7 +297,7 @@ void HTMLDocumentParser::pumpTokenizer(SynchronousMode mode)
         ASSERT(m_tokenizer.isInDataState());
         if (!m_preloadScanner) {
             m_preloadScanner = std::make_unique<HTMLPreloadScanner>(m_options, document()->url(), document()->deviceScaleFactor());
-            m_preloadScanner->appendToEnd(m_input.current());
+            appendUnparsedInputToPreloadScanner();
         }
         m_preloadScanner->scan(*m_preloader, *document());
     }
@@ -312,6 +326,133 @@ void HTMLDocumentParser::constructTreeFromHTMLToken(HTMLTokenizer::TokenPtr& raw
     m_treeBuilder->constructTree(token);
 }
 
+void HTMLDocumentParser::startBackgroundTokenizerIfPossible()
+{
+    ASSERT(!m_didChooseTokenizer);
+    m_didChooseTokenizer = true;
+
+    if (!m_options.threadedTokenization || isParsingFragment() || wasCreatedByScript() || !m_parserScheduler)
+        return;
+
+    // The XSS auditor filters HTMLTokens along with their source, which only the main thread tokenizer has.
+    m_xssAuditor.init(document(), &m_xssAuditorDelegate);
+    if (m_xssAuditor.isEnabled())
+        return;
+
+    ASSERT(m_input.current().isEmpty());
+    ASSERT(!m_input.hasInsertionPoint());
+    m_backgroundTokenizer = BackgroundHTMLTokenizer::create(*this, m_options);
+}
+
+bool HTMLDocumentParser::constructTreeFromSpeculativeToken()
+{
+    ASSERT(m_backgroundTokenizer);
+
+    if (!m_speculativeChunk || m_speculativeTokenIndex == m_speculativeChunk->tokens.size()) {
+        m_speculativeChunk = m_backgroundTokenizer->takeChunk();
+        m_speculativeTokenIndex = 0;
+        if (!m_speculativeChunk)
+            return false;
+
+        m_parserScheduler->didConsumeTokenizedChunk(m_speculativeChunk->tokens.size(), m_speculativeChunk->tokenizationTime);
+        m_backgroundTokenizer->setPreferredChunkSize(m_parserScheduler->preferredTokenizedChunkSize());
+
+        while (!m_speculativeSource.isEmpty() && m_speculativeSourceOffset + m_speculativeSource.first().length() <= m_speculativeInputOffset)
+            m_speculativeSourceOffset += m_speculativeSource.takeFirst().length();
+    }
+
+    auto& speculativeToken = m_speculativeChunk->tokens[m_speculativeTokenIndex++];
+    HTMLToken::Type type = speculativeToken.token.type();
+    bool isTag = type == HTMLToken::StartTag || type == HTMLToken::EndTag;
+    auto predictedTokenizerState = speculativeToken.tokenizerState;
+
+    // Keep textPosition() and the insertion point where they would be if we had tokenized this ourselves.
+    m_input.current().setCurrentPosition(speculativeToken.textPosition.m_line, speculativeToken.textPosition.m_column, 0);
+    m_speculativeInputOffset = speculativeToken.inputOffset;
+
+    // The tokenizer emits every tag in the data state. After the tree builder is done with the tag,
+    // m_tokenizer is in the state the next token should have been tokenized in.
+    if (isTag)
+        m_tokenizer.setDataState();
+
+    AtomicHTMLToken token(speculativeToken.token);
+    m_treeBuilder->constructTree(token);
+
+    // Constructing the tree can run script that writes to the document, which discards the speculation.
+    if (!m_backgroundTokenizer)
+        return true;
+
+    if (type == HTMLToken::EndOfFile) {
+        stopBackgroundTokenizer();
+        m_input.closeWithoutMarkingEndOfFile();
+        return true;
+    }
+
+    if (isTag && m_tokenizer.speculativeState() != predictedTokenizerState)
+        discardSpeculation();
+
+    return true;
+}
+
+// Takes over tokenizing on the main thread, starting right after the last token the tree builder
+// saw. That is always a tag, after which the tokenizer has no partially consumed input, so m_tokenizer
+// is left exactly as the tree builder set it.
+void HTMLDocumentParser::discardSpeculation()
+{
+    ASSERT(m_backgroundTokenizer);
+
+    SegmentedString unparsedInput = unparsedSpeculativeInput();
+    bool sawEndOfFile = m_backgroundTokenizerSawEndOfFile;
+    stopBackgroundTokenizer();
+
+    m_input.appendToEnd(unparsedInput);
+    if (sawEndOfFile)
+        m_input.closeWithoutMarkingEndOfFile();
+}
+
+void HTMLDocumentParser::stopBackgroundTokenizer()
+{
+    m_backgroundTokenizer->stop();
+    m_backgroundTokenizer = nullptr;
+    m_speculativeChunk = nullptr;
+    m_speculativeTokenIndex = 0;
+    m_speculativeSource.clear();
+}
+
+SegmentedString HTMLDocumentParser::unparsedSpeculativeInput() const
+{
+    SegmentedString unparsedInput;
+    unsigned offset = m_speculativeSourceOffset;
+    for (auto& source : m_speculativeSource) {
+        unsigned end = offset + source.length();
+        if (end > m_speculativeInputOffset)
+            unparsedInput.append(SegmentedString(offset >= m_speculativeInputOffset ? source : source.substring(m_speculativeInputOffset - offset)));
+        offset = end;
+    }
+    return unparsedInput;
+}
+
+void HTMLDocumentParser::appendUnparsedInputToPreloadScanner()
+{
+    ASSERT(m_preloadScanner);
+    if (m_backgroundTokenizer)
+        m_preloadScanner->appendToEnd(unparsedSpeculativeInput());
+    else
+        m_preloadScanner->appendToEnd(m_input.current());
+}
+
+void HTMLDocumentParser::didTokenizeChunk()
+{
+    ASSERT(m_backgroundTokenizer);
+
+    // A pump in progress takes new chunks as it runs out of tokens, and a parser that
+    // is waiting for scripts pumps again once they have run.
+    if (isStopped() || inPumpSession() || isWaitingForScripts())
+        return;
+
+    m_parserScheduler->scheduleForResumeAfterTokenizedChunk();
+}
+
 bool HTMLDocumentParser::hasInsertionPoint()
 {
     // FIXME: The wasCreatedByScript() branch here might not be fully correct.
@@ -330,6 +471,12 @@ void HTMLDocumentParser::insert(const SegmentedString& source)
     // but we need to ensure it isn't deleted yet.
     Ref<HTMLDocumentParser> protect(*this);
 
+    // document.write() output is tokenized right here, after the script that wrote it. What the
+    // background tokenizer did past that point may no longer apply, so tokenize the rest ourselves.
+    m_didChooseTokenizer = true;
+    if (m_backgroundTokenizer)
+        discardSpeculation();
+
     SegmentedString excludedLineNumberSource(source);
     excludedLineNumberSource.setExcludeLineNumbers();
     m_input.insertAtCurrentInsertionPoint(excludedLineNumberSource);
@@ -358,6 +505,9 @@ void HTMLDocumentParser::append(RefPtr<StringImpl>&& inputSource)
 
     String source(WTF::move(inputSource));
 
+    if (!m_didChooseTokenizer)
+        startBackgroundTokenizerIfPossible();
+
     if (m_preloadScanner) {
         if (m_input.current().isEmpty() && !isWaitingForScripts()) {
             // We have parsed until the end of the current input and so are now moving ahead of the preload scanner.
@@ -370,6 +520,13 @@ void HTMLDocumentParser::append(RefPtr<StringImpl>&& inputSource)
         }
     }
 
+    if (m_backgroundTokenizer) {
+        // Tokens come back through didTokenizeChunk().
+        m_speculativeSource.append(source);
+        m_backgroundTokenizer->append(source);
+        return;
+    }
+
     m_input.appendToEnd(source);
 
     if (inPumpSession()) {
@@ -436,7 +593,13 @@ void HTMLDocumentParser::finish()
     // We're not going to get any more data off the network, so we tell the
     // input stream we've reached the end of file. finish() can be called more
     // than once, if the first time does not call end().
-    if (!m_input.haveSeenEndOfFile())
+    if (m_backgroundTokenizer) {
+        if (!m_backgroundTokenizerSawEndOfFile) {
+            m_backgroundTokenizerSawEndOfFile = true;
+            m_speculativeSource.append(String(&kEndOfFileMarker, 1));
+            m_backgroundTokenizer->finish();
+        }
+    } else if (!m_input.haveSeenEndOfFile())
         m_input.markEndOfFile();
 
     attemptToEnd();
@@ -504,8 +667,7 @@ void HTMLDocumentParser::stopWatchingForLoad(CachedResource* cachedScript)
 
 void HTMLDocumentParser::appendCurrentInputStreamToPreloadScannerAndScan()
 {
-    ASSERT(m_preloadScanner);
-    m_preloadScanner->appendToEnd(m_input.current());
+    appendUnparsedInputToPreloadScanner();
     m_preloadScanner->scan(*m_preloader, *document());
 }
 
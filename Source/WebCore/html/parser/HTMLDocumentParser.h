@@ -27,6 +27,7 @@
 #ifndef HTMLDocumentParser_h
 #define HTMLDocumentParser_h
 
+#include "BackgroundHTMLTokenizer.h"
 #include "CachedResourceClient.h"
 #include "HTMLInputStream.h"
 #include "HTMLScriptRunnerHost.h"
@@ -35,6 +36,7 @@
 #include "ScriptableDocumentParser.h"
 #include "XSSAuditor.h"
 #include "XSSAuditorDelegate.h"
+#include <wtf/Deque.h>
 
 namespace WebCore {
 
@@ -47,7 +49,7 @@ class HTMLTreeBuilder;
 class HTMLResourcePreloader;
 class PumpSession;
 
-class HTMLDocumentParser : public ScriptableDocumentParser, private HTMLScriptRunnerHost, private CachedResourceClient {
+class HTMLDocumentParser : public ScriptableDocumentParser, private HTMLScriptRunnerHost, private CachedResourceClient, private BackgroundHTMLTokenizer::Client {
     WTF_MAKE_FAST_ALLOCATED;
 public:
     static Ref<HTMLDocumentParser> create(HTMLDocument&);
@@ -99,6 +101,9 @@ private:
     // CachedResourceClient
     virtual void notifyFinished(CachedResource*) override final;
 
+    // BackgroundHTMLTokenizer::Client
+    virtual void didTokenizeChunk() override final;
+
     Document* contextForParsingSession();
 
     enum SynchronousMode { AllowYield, ForceSynchronous };
@@ -107,6 +112,13 @@ private:
     void pumpTokenizerIfPossible(SynchronousMode);
     void constructTreeFromHTMLToken(HTMLTokenizer::TokenPtr&);
 
+    void startBackgroundTokenizerIfPossible();
+    bool constructTreeFromSpeculativeToken();
+    void discardSpeculation();
+    void stopBackgroundTokenizer();
+    SegmentedString unparsedSpeculativeInput() const;
+    void appendUnparsedInputToPreloadScanner();
+
     void runScriptsForPausedTreeBuilder();
     void resumeParsingAfterScriptExecution();
 
@@ -136,6 +148,17 @@ private:
 
     std::unique_ptr<HTMLResourcePreloader> m_preloader;
 
+    // When tokenizing on a background thread, tokens arrive in chunks, and everything appended
+    // since the last token we consumed is kept so that we can take over tokenizing from there.
+    RefPtr<BackgroundHTMLTokenizer> m_backgroundTokenizer;
+    std::unique_ptr<BackgroundHTMLTokenizer::TokenizedChunk> m_speculativeChunk;
+    size_t m_speculativeTokenIndex { 0 };
+    Deque<String> m_speculativeSource;
+    unsigned m_speculativeSourceOffset { 0 };
+    unsigned m_speculativeInputOffset { 0 };
+    bool m_didChooseTokenizer { false };
+    bool m_backgroundTokenizerSawEndOfFile { false };
+
     bool m_endWasDelayed { false };
     unsigned m_pumpSessionNestingLevel { 0 };
 };
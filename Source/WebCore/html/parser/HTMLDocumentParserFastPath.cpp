@@ -0,0 +1,483 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "HTMLDocumentParserFastPath.h"
+
+#include "Document.h"
+#include "DocumentFragment.h"
+#include "HTMLElement.h"
+#include "HTMLElementFactory.h"
+#include "HTMLNames.h"
+#include "HTMLParserIdioms.h"
+#include "HTMLParserOptions.h"
+#include "Text.h"
+#include <wtf/HashMap.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/text/StringBuilder.h>
+#include <wtf/unicode/CharacterNames.h>
+
+namespace WebCore {
+
+using namespace HTMLNames;
+
+namespace {
+
+enum FastPathTagFlag {
+    VoidElement = 1 << 0,
+    ClosesParagraph = 1 << 1,
+    Heading = 1 << 2,
+    ListItem = 1 << 3,
+    List = 1 << 4,
+    Anchor = 1 << 5,
+};
+
+struct FastPathTag {
+    const QualifiedName* name;
+    unsigned flags;
+};
+
+// Every tag here is parsed "in body" the same way whatever its attributes are, never changes the
+// tokenizer state, is not form-associated and does not load anything.
+static const HashMap<AtomicString, FastPathTag>& fastPathTags()
+{
+    static NeverDestroyed<HashMap<AtomicString, FastPathTag>> tags = [] {
+        const FastPathTag table[] = {
+            { &aTag, Anchor },
+            { &articleTag, ClosesParagraph },
+            { &asideTag, ClosesParagraph },
+            { &bTag, 0 },
+            { &brTag, VoidElement },
+            { &codeTag, 0 },
+            { &divTag, ClosesParagraph },
+            { &emTag, 0 },
+            { &footerTag, ClosesParagraph },
+            { &h1Tag, ClosesParagraph | Heading },
+            { &h2Tag, ClosesParagraph | Heading },
+            { &h3Tag, ClosesParagraph | Heading },
+            { &h4Tag, ClosesParagraph | Heading },
+            { &h5Tag, ClosesParagraph | Heading },
+            { &h6Tag, ClosesParagraph | Heading },
+            { &headerTag, ClosesParagraph },
+            { &hrTag, VoidElement | ClosesParagraph },
+            { &iTag, 0 },
+            { &liTag, ClosesParagraph | ListItem },
+            { &navTag, ClosesParagraph },
+            { &olTag, ClosesParagraph | List },
+            { &pTag, ClosesParagraph },
+            { &sectionTag, ClosesParagraph },
+            { &smallTag, 0 },
+            { &spanTag, 0 },
+            { &strongTag, 0 },
+            { &subTag, 0 },
+            { &supTag, 0 },
+            { &uTag, 0 },
+            { &ulTag, ClosesParagraph | List },
+        };
+        HashMap<AtomicString, FastPathTag> map;
+        for (auto& tag : table)
+            map.add(tag.name->localName(), tag);
+        return map;
+    }();
+    return tags;
+}
+
+template<typename CharacterType>
+class HTMLFastPathParser {
+public:
+    HTMLFastPathParser(const CharacterType* characters, unsigned length, DocumentFragment& fragment, ParserContentPolicy parserContentPolicy)
+        : m_position(characters)
+        , m_end(characters + length)
+        , m_fragment(fragment)
+        , m_document(fragment.document())
+        , m_parserContentPolicy(parserContentPolicy)
+        , m_maximumDOMTreeDepth(HTMLParserOptions(m_document).maximumDOMTreeDepth)
+    {
+    }
+
+    bool parse()
+    {
+        while (m_position < m_end) {
+            if (*m_position == '<') {
+                if (!flushText())
+                    return false;
+                ++m_position;
+                if (m_position < m_end && *m_position == '/') {
+                    ++m_position;
+                    if (!parseEndTag())
+                        return false;
+                } else if (!parseStartTag())
+                    return false;
+                continue;
+            }
+            if (*m_position == '&') {
+                if (!parseCharacterReference(m_text))
+                    return false;
+                continue;
+            }
+            if (!*m_position || *m_position == '\r')
+                return false;
+            m_text.append(*m_position++);
+        }
+        if (!flushText())
+            return false;
+
+        // Like the end of the stream in the tree builder, this implicitly closes whatever is still open.
+        while (!m_openElements.isEmpty())
+            m_openElements.takeLast().element->finishParsingChildren();
+        return true;
+    }
+
+private:
+    struct OpenElement {
+        Element* element;
+        unsigned flags;
+    };
+
+    ContainerNode& currentNode() const
+    {
+        if (m_openElements.isEmpty())
+            return m_fragment;
+        return *m_openElements.last().element;
+    }
+
+    unsigned currentNodeFlags() const { return m_openElements.isEmpty() ? 0 : m_openElements.last().flags; }
+
+    bool hasOpenElementWithFlag(FastPathTagFlag flag) const
+    {
+        for (auto& openElement : m_openElements) {
+            if (openElement.flags & flag)
+                return true;
+        }
+        return false;
+    }
+
+    bool hasOpenParagraph() const
+    {
+        for (auto& openElement : m_openElements) {
+            if (openElement.element->hasTagName(pTag))
+                return true;
+        }
+        return false;
+    }
+
+    void skipWhitespace()
+    {
+        while (m_position < m_end && isHTMLSpace(*m_position))
+            ++m_position;
+    }
+
+    bool flushText()
+    {
+        if (m_text.isEmpty())
+            return true;
+
+        // The tree builder splits longer runs into several text nodes; leave that to it.
+        if (m_text.length() >= Text::defaultLengthLimit)
+            return false;
+
+        String characters = m_text.toString();
+        m_text.clear();
+        if (characters.isAllSpecialCharacters<isHTMLSpace>())
+            characters = AtomicString(characters).string();
+        currentNode().parserAppendChild(Text::create(m_document, characters));
+        return true;
+    }
+
+    AtomicString parseName()
+    {
+        Vector<LChar, 32> name;
+        while (m_position < m_end && isASCIIAlphanumeric(*m_position))
+            name.append(toASCIILower(static_cast<LChar>(*m_position++)));
+        if (name.isEmpty() || !isASCIIAlpha(name[0]))
+            return nullAtom;
+        return AtomicString(name.data(), name.size());
+    }
+
+    AtomicString parseAttributeName()
+    {
+        Vector<LChar, 32> name;
+        while (m_position < m_end && (isASCIIAlphanumeric(*m_position) || *m_position == '-' || *m_position == '_'))
+            name.append(toASCIILower(static_cast<LChar>(*m_position++)));
+        if (name.isEmpty())
+            return nullAtom;
+        return AtomicString(name.data(), name.size());
+    }
+
+    bool parseAttributeValue(AtomicString& value)
+    {
+        StringBuilder builder;
+        if (*m_position == '"' || *m_position == '\'') {
+            CharacterType quote = *m_position++;
+            while (m_position < m_end && *m_position != quote) {
+                if (*m_position == '&') {
+                    if (!parseCharacterReference(builder))
+                        return false;
+                    continue;
+                }
+                if (!*m_position || *m_position == '\r')
+                    return false;
+                builder.append(*m_position++);
+            }
+            if (m_position == m_end)
+                return false;
+            ++m_position;
+        } else {
+            while (m_position < m_end && !isHTMLSpace(*m_position) && *m_position != '>') {
+                CharacterType character = *m_position;
+                if (!character || character == '\r' || character == '"' || character == '\'' || character == '<' || character == '=' || character == '`')
+                    return false;
+                if (character == '&') {
+                    if (!parseCharacterReference(builder))
+                        return false;
+                    continue;
+                }
+                builder.append(*m_position++);
+            }
+            if (builder.isEmpty())
+                return false;
+        }
+        value = builder.toAtomicString();
+        return true;
+    }
+
+    bool parseStartTag()
+    {
+        AtomicString name = parseName();
+        if (name.isNull())
+            return false;
+        auto it = fastPathTags().find(name);
+        if (it == fastPathTags().end())
+            return false;
+        const FastPathTag& tag = it->value;
+
+        Vector<Attribute> attributes;
+        bool selfClosing = false;
+        while (true) {
+            bool sawWhitespace = m_position < m_end && isHTMLSpace(*m_position);
+            skipWhitespace();
+            if (m_position == m_end)
+                return false;
+            if (*m_position == '>') {
+                ++m_position;
+                break;
+            }
+            if (*m_position == '/') {
+                ++m_position;
+                if (m_position == m_end || *m_position != '>')
+                    return false;
+                ++m_position;
+                selfClosing = true;
+                break;
+            }
+            if (!sawWhitespace)
+                return false;
+
+            AtomicString attributeName = parseAttributeName();
+            if (attributeName.isNull())
+                return false;
+            AtomicString attributeValue = emptyAtom;
+            const CharacterType* afterName = m_position;
+            skipWhitespace();
+            if (m_position < m_end && *m_position == '=') {
+                ++m_position;
+                skipWhitespace();
+                if (m_position == m_end || !parseAttributeValue(attributeValue))
+                    return false;
+            } else
+                m_position = afterName;
+            for (auto& attribute : attributes) {
+                if (attribute.localName() == attributeName)
+                    return false;
+            }
+            attributes.append(Attribute(QualifiedName(nullAtom, attributeName, nullAtom), attributeValue));
+        }
+
+        if (selfClosing && !(tag.flags & VoidElement))
+            return false;
+
+        // The tree builder would implicitly close or reparent elements in these cases.
+        if ((tag.flags & ClosesParagraph) && hasOpenParagraph())
+            return false;
+        if ((tag.flags & ListItem) && !(currentNodeFlags() & List))
+            return false;
+        if ((tag.flags & Heading) && (currentNodeFlags() & Heading))
+            return false;
+        if ((tag.flags & Anchor) && hasOpenElementWithFlag(Anchor))
+            return false;
+
+        // The tree builder stops nesting past this depth. The html element it keeps at the bottom
+        // of its stack counts too.
+        if (m_openElements.size() + 1 >= m_maximumDOMTreeDepth)
+            return false;
+
+        Ref<HTMLElement> element = HTMLElementFactory::createElement(*tag.name, m_document, nullptr, true);
+        if (!scriptingContentIsAllowed(m_parserContentPolicy))
+            element->stripScriptingAttributes(attributes);
+        element->parserSetAttributes(attributes);
+        currentNode().parserAppendChild(element.copyRef());
+        element->beginParsingChildren();
+
+        if (tag.flags & VoidElement) {
+            element->finishParsingChildren();
+            return true;
+        }
+        m_openElements.append({ element.ptr(), tag.flags });
+        return true;
+    }
+
+    bool parseEndTag()
+    {
+        AtomicString name = parseName();
+        if (name.isNull())
+            return false;
+        skipWhitespace();
+        if (m_position == m_end || *m_position != '>')
+            return false;
+        ++m_position;
+
+        // Anything but closing the current node involves the tree builder's scope rules.
+        if (m_openElements.isEmpty() || m_openElements.last().element->localName() != name)
+            return false;
+        m_openElements.takeLast().element->finishParsingChildren();
+        return true;
+    }
+
+    template<typename Builder>
+    bool parseCharacterReference(Builder& builder)
+    {
+        ASSERT(*m_position == '&');
+        const CharacterType* start = m_position + 1;
+        const CharacterType* semicolon = start;
+        while (semicolon < m_end && semicolon - start < 8 && *semicolon != ';')
+            ++semicolon;
+        if (semicolon == m_end || *semicolon != ';' || semicolon == start)
+            return false;
+        unsigned length = semicolon - start;
+
+        UChar32 character;
+        if (*start == '#') {
+            if (!parseNumericCharacterReference(start + 1, length - 1, character))
+                return false;
+        } else if (matchesName(start, length, "amp"))
+            character = '&';
+        else if (matchesName(start, length, "lt"))
+            character = '<';
+        else if (matchesName(start, length, "gt"))
+            character = '>';
+        else if (matchesName(start, length, "quot"))
+            character = '"';
+        else if (matchesName(start, length, "apos"))
+            character = '\'';
+        else if (matchesName(start, length, "nbsp"))
+            character = noBreakSpace;
+        else
+            return false;
+
+        builder.append(character);
+        m_position = semicolon + 1;
+        return true;
+    }
+
+    static bool matchesName(const CharacterType* characters, unsigned length, const char* name)
+    {
+        if (strlen(name) != length)
+            return false;
+        for (unsigned i = 0; i < length; ++i) {
+            if (characters[i] != static_cast<LChar>(name[i]))
+                return false;
+        }
+        return true;
+    }
+
+    static bool parseNumericCharacterReference(const CharacterType* characters, unsigned length, UChar32& character)
+    {
+        bool isHex = length && (characters[0] == 'x' || characters[0] == 'X');
+        if (isHex) {
+            ++characters;
+            --length;
+        }
+        if (!length)
+            return false;
+
+        UChar32 value = 0;
+        for (unsigned i = 0; i < length; ++i) {
+            if (isHex ? !isASCIIHexDigit(characters[i]) : !isASCIIDigit(characters[i]))
+                return false;
+            value = value * (isHex ? 16 : 10) + (isHex ? toASCIIHexValue(characters[i]) : characters[i] - '0');
+            if (value > 0x10FFFF)
+                return false;
+        }
+
+        // Control characters, surrogates and the C1 range are remapped or rejected by the tokenizer.
+        if (value < 0x20 && value != '\t' && value != '\n')
+            return false;
+        if ((value >= 0x7F && value < 0xA0) || (value >= 0xD800 && value <= 0xDFFF) || value == 0xFFFE || value == 0xFFFF)
+            return false;
+        character = value;
+        return true;
+    }
+
+    const CharacterType* m_position;
+    const CharacterType* m_end;
+    DocumentFragment& m_fragment;
+    Document& m_document;
+    ParserContentPolicy m_parserContentPolicy;
+    unsigned m_maximumDOMTreeDepth;
+    Vector<OpenElement, 32> m_openElements;
+    StringBuilder m_text;
+};
+
+} // namespace
+
+static bool canUseFastPathForContextElement(Element& contextElement)
+{
+    if (!contextElement.isHTMLElement())
+        return false;
+    // The context decides the insertion mode and tokenizer state; these all parse their content "in body".
+    return contextElement.hasTagName(bodyTag) || fastPathTags().contains(contextElement.localName());
+}
+
+bool tryFastParsingHTMLFragment(const String& source, DocumentFragment& fragment, Element& contextElement, ParserContentPolicy parserContentPolicy)
+{
+    ASSERT(!fragment.hasChildNodes());
+    if (!canUseFastPathForContextElement(contextElement))
+        return false;
+
+    bool succeeded;
+    if (source.is8Bit()) {
+        HTMLFastPathParser<LChar> parser(source.characters8(), source.length(), fragment, parserContentPolicy);
+        succeeded = parser.parse();
+    } else {
+        HTMLFastPathParser<UChar> parser(source.characters16(), source.length(), fragment, parserContentPolicy);
+        succeeded = parser.parse();
+    }
+
+    if (!succeeded)
+        fragment.removeChildren();
+    return succeeded;
+}
+
+} // namespace WebCore
@@ -31,6 +31,7 @@
 namespace WebCore {
 
 struct HTMLEntityTableEntry;
+struct HTMLEntityTrieNode;
 
 class HTMLEntitySearch {
 public:
@@ -38,33 +39,21 @@ public:
 
     void advance(UChar);
 
-    bool isEntityPrefix() const { return !!m_first; }
+    bool isEntityPrefix() const { return !!m_currentNode; }
     int currentLength() const { return m_currentLength; }
 
     const HTMLEntityTableEntry* mostRecentMatch() const { return m_mostRecentMatch; }
 
 private:
-    enum CompareResult {
-        Before,
-        Prefix,
-        After,
-    };
-
-    CompareResult compare(const HTMLEntityTableEntry*, UChar) const;
-    const HTMLEntityTableEntry* findFirst(UChar) const;
-    const HTMLEntityTableEntry* findLast(UChar) const;
-
     void fail()
     {
-        m_first = 0;
-        m_last = 0;
+        m_currentNode = nullptr;
     }
 
     int m_currentLength;
 
     const HTMLEntityTableEntry* m_mostRecentMatch;
-    const HTMLEntityTableEntry* m_first;
-    const HTMLEntityTableEntry* m_last;
+    const HTMLEntityTrieNode* m_currentNode;
 };
 
 }
@@ -39,13 +39,20 @@ struct HTMLEntityTableEntry {
     UChar32 secondValue;
 };
 
+// A node in the trie of entity names generated by create-html-entity-table. The children of a
+// node are stored next to each other, sorted by character.
+struct HTMLEntityTrieNode {
+    LChar character;
+    uint8_t childCount;
+    uint16_t firstChild;
+    int16_t entryIndex; // The entity whose name ends at this node, or -1.
+};
+
 class HTMLEntityTable {
 public:
-    static const HTMLEntityTableEntry* firstEntry();
-    static const HTMLEntityTableEntry* lastEntry();
-
-    static const HTMLEntityTableEntry* firstEntryStartingWith(UChar);
-    static const HTMLEntityTableEntry* lastEntryStartingWith(UChar);
+    static const HTMLEntityTrieNode* root();
+    static const HTMLEntityTrieNode* child(const HTMLEntityTrieNode&, UChar);
+    static const HTMLEntityTableEntry* entry(const HTMLEntityTrieNode&);
 };
 
 }
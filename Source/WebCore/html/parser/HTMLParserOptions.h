@@ -38,6 +38,7 @@ public:
     bool scriptEnabled;
     bool pluginsEnabled;
     bool usePreHTML5ParserQuirks;
+    bool threadedTokenization;
     unsigned maximumDOMTreeDepth;
 };
 
@@ -27,21 +27,51 @@
 #include "config.h"
 #include "HTMLParserScheduler.h"
 
+#include "Chrome.h"
+#include "ChromeClient.h"
 #include "Document.h"
 #include "FrameView.h"
 #include "HTMLDocumentParser.h"
+#include "Logging.h"
 #include "Page.h"
+#include <wtf/MathExtras.h>
+
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+#include "DisplayRefreshMonitor.h"
+#include "DisplayRefreshMonitorManager.h"
+#endif
 
 // defaultParserChunkSize is used to define how many tokens the parser will
 // process before checking against parserTimeLimit and possibly yielding.
 // This is a performance optimization to prevent checking after every token.
+// Once we know how fast the parser is going, the chunk size shrinks so that the
+// clock is checked a few times per time budget.
 static const int defaultParserChunkSize = 4096;
+static const int minimumParserChunkSize = 128;
+static const int yieldChecksPerTimeBudget = 4;
 
 // defaultParserTimeLimit is the seconds the parser will run in one write() call
 // before yielding. Inline <script> execution can cause it to exceed the limit.
 // FIXME: We would like this value to be 0.2.
 static const double defaultParserTimeLimit = 0.500;
 
+// Once the page has painted, the parser shares the main thread with rendering and input
+// handling. It then yields in time for the next display refresh, leaving frameRenderingReserve
+// for style, layout and painting, but always runs for at least minimumParserTimeBudget so
+// that parsing makes progress. Without a display refresh cadence it uses paintedParserTimeLimit.
+static const double paintedParserTimeLimit = 0.050;
+static const double minimumParserTimeBudget = 0.004;
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+static const double frameRenderingReserve = 0.004;
+#endif
+
+// A background tokenizer hands over chunks sized to take about this long to tokenize, so that
+// the main thread has tokens soon after the network delivers data without paying for a
+// notification per handful of tokens.
+static const double targetTokenizedChunkTime = 0.002;
+static const unsigned minimumTokenizedChunkSize = 64;
+static const unsigned maximumTokenizedChunkSize = 4096;
+
 namespace WebCore {
 
 static double parserTimeLimit(Page* page)
@@ -75,6 +105,8 @@ PumpSession::PumpSession(unsigned& nestingLevel, Document* document)
     // At that time we'll initialize startTime.
     , processedTokens(INT_MAX)
     , startTime(0)
+    , lastCheckTime(0)
+    , deadline(0)
     , needsYield(false)
     , didSeeScript(false)
 {
@@ -87,12 +119,11 @@ PumpSession::~PumpSession()
 HTMLParserScheduler::HTMLParserScheduler(HTMLDocumentParser& parser)
     : m_parser(parser)
     , m_parserTimeLimit(parserTimeLimit(m_parser.document()->page()))
+    , m_hasCustomParserTimeLimit(m_parser.document()->page() && m_parser.document()->page()->hasCustomHTMLTokenizerTimeDelay())
     , m_parserChunkSize(defaultParserChunkSize)
     , m_continueNextChunkTimer(*this, &HTMLParserScheduler::continueNextChunkTimerFired)
     , m_isSuspendedWithActiveTimer(false)
-#if !ASSERT_DISABLED
     , m_suspended(false)
-#endif
 {
 }
 
@@ -114,6 +145,121 @@ void HTMLParserScheduler::continueNextChunkTimerFired()
     m_parser.resumeParsingAfterYield();
 }
 
+void HTMLParserScheduler::checkForYieldAtChunkBoundary(PumpSession& session)
+{
+    // monotonicallyIncreasingTime() can be expensive. By delaying, we avoided calling
+    // monotonicallyIncreasingTime() when constructing non-yielding PumpSessions.
+    double now = monotonicallyIncreasingTime();
+    if (!session.startTime) {
+        session.startTime = now;
+        session.deadline = now + timeBudgetForSession(now);
+    } else if (!session.didSeeScript) {
+        // Chunks that ran a script say nothing about how fast we tokenize and build the tree.
+        updateParserChunkSize(session.processedTokens, now - session.lastCheckTime, session.deadline - session.startTime);
+    }
+
+    session.lastCheckTime = now;
+    session.processedTokens = 0;
+    session.didSeeScript = false;
+
+    if (now > session.deadline) {
+        LOG(Parsing, "HTMLParserScheduler %p yielding after %.2fms, time budget was %.2fms", this, (now - session.startTime) * 1000, (session.deadline - session.startTime) * 1000);
+        session.needsYield = true;
+        return;
+    }
+
+    if (hasPendingUserInput()) {
+        LOG(Parsing, "HTMLParserScheduler %p yielding after %.2fms for pending user input", this, (now - session.startTime) * 1000);
+        session.needsYield = true;
+    }
+}
+
+double HTMLParserScheduler::timeBudgetForSession(double now) const
+{
+    if (m_hasCustomParserTimeLimit)
+        return m_parserTimeLimit;
+
+    // Until the first paint there is nothing on screen to keep responsive, so favor throughput.
+    Document* document = m_parser.document();
+    if (!document->view() || !document->view()->hasEverPainted())
+        return m_parserTimeLimit;
+
+    double timeBudget = paintedParserTimeLimit;
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+    if (m_displayRefreshInterval) {
+        double timeUntilNextFrame = m_displayRefreshInterval - fmod(now - m_lastDisplayRefreshTime, m_displayRefreshInterval);
+        timeBudget = timeUntilNextFrame - frameRenderingReserve;
+        // Too close to the next frame to get anything useful done; aim for the one after it.
+        if (timeBudget < minimumParserTimeBudget)
+            timeBudget += m_displayRefreshInterval;
+    }
+#else
+    UNUSED_PARAM(now);
+#endif
+    return std::max(std::min(timeBudget, m_parserTimeLimit), minimumParserTimeBudget);
+}
+
+void HTMLParserScheduler::updateParserChunkSize(int processedTokens, double elapsedTime, double timeBudget)
+{
+    if (processedTokens <= 0 || elapsedTime <= 0)
+        return;
+
+    double tokensPerSecond = processedTokens / elapsedTime;
+    m_tokensPerSecond = m_tokensPerSecond ? (3 * m_tokensPerSecond + tokensPerSecond) / 4 : tokensPerSecond;
+
+    double chunkSize = m_tokensPerSecond * timeBudget / yieldChecksPerTimeBudget;
+    m_parserChunkSize = static_cast<int>(std::max<double>(std::min<double>(chunkSize, defaultParserChunkSize), minimumParserChunkSize));
+}
+
+bool HTMLParserScheduler::hasPendingUserInput() const
+{
+    Page* page = m_parser.document()->page();
+    return page && page->chrome().client().hasPendingUserInput();
+}
+
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+void HTMLParserScheduler::scheduleDisplayRefreshIfNeeded()
+{
+    if (isScheduled() || m_hasCustomParserTimeLimit)
+        return;
+
+    // The display refresh cadence only matters once the parser has to share the main thread with painting.
+    Document* document = m_parser.document();
+    Page* page = document->page();
+    if (!page || !document->view() || !document->view()->hasEverPainted())
+        return;
+
+    DisplayRefreshMonitorManager::sharedManager().windowScreenDidChange(page->chrome().displayID(), *this);
+    DisplayRefreshMonitorManager::sharedManager().scheduleAnimation(*this);
+}
+
+void HTMLParserScheduler::displayRefreshFired(double timestamp)
+{
+    if (m_lastDisplayRefreshTime) {
+        // Ignore gaps where nobody asked for a refresh, they are not the display cadence.
+        double interval = timestamp - m_lastDisplayRefreshTime;
+        if (interval > 0 && interval < paintedParserTimeLimit)
+            m_displayRefreshInterval = m_displayRefreshInterval ? (7 * m_displayRefreshInterval + interval) / 8 : interval;
+    }
+    m_lastDisplayRefreshTime = timestamp;
+
+    if (isScheduledForResume())
+        scheduleDisplayRefreshIfNeeded();
+}
+
+RefPtr<DisplayRefreshMonitor> HTMLParserScheduler::createDisplayRefreshMonitor(PlatformDisplayID displayID) const
+{
+    Page* page = m_parser.document()->page();
+    if (!page)
+        return nullptr;
+
+    if (auto monitor = page->chrome().client().createDisplayRefreshMonitor(displayID))
+        return monitor;
+
+    return DisplayRefreshMonitor::createDefaultDisplayRefreshMonitor(displayID);
+}
+#endif
+
 void HTMLParserScheduler::checkForYieldBeforeScript(PumpSession& session)
 {
     // If we've never painted before and a layout is pending, yield prior to running
@@ -129,15 +275,43 @@ void HTMLParserScheduler::scheduleForResume()
 {
     ASSERT(!m_suspended);
     m_continueNextChunkTimer.startOneShot(0);
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+    scheduleDisplayRefreshIfNeeded();
+#endif
+}
+
+void HTMLParserScheduler::scheduleForResumeAfterTokenizedChunk()
+{
+    if (m_suspended) {
+        m_isSuspendedWithActiveTimer = true;
+        return;
+    }
+    if (!m_continueNextChunkTimer.isActive())
+        m_continueNextChunkTimer.startOneShot(0);
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+    scheduleDisplayRefreshIfNeeded();
+#endif
+}
+
+void HTMLParserScheduler::didConsumeTokenizedChunk(unsigned tokenCount, double tokenizationTime)
+{
+    m_tokenizedTokenCount += tokenCount;
+    m_tokenizationTime += tokenizationTime;
+}
+
+unsigned HTMLParserScheduler::preferredTokenizedChunkSize() const
+{
+    if (!m_tokenizationTime)
+        return minimumTokenizedChunkSize;
+    double tokensPerSecond = m_tokenizedTokenCount / m_tokenizationTime;
+    return std::min(std::max(static_cast<unsigned>(tokensPerSecond * targetTokenizedChunkTime), minimumTokenizedChunkSize), maximumTokenizedChunkSize);
 }
 
 void HTMLParserScheduler::suspend()
 {
     ASSERT(!m_suspended);
     ASSERT(!m_isSuspendedWithActiveTimer);
-#if !ASSERT_DISABLED
     m_suspended = true;
-#endif
 
     if (!m_continueNextChunkTimer.isActive())
         return;
@@ -149,9 +323,7 @@ void HTMLParserScheduler::resume()
 {
     ASSERT(m_suspended);
     ASSERT(!m_continueNextChunkTimer.isActive());
-#if !ASSERT_DISABLED
     m_suspended = false;
-#endif
 
     if (!m_isSuspendedWithActiveTimer)
         return;
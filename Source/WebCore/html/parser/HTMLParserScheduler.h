@@ -35,6 +35,10 @@
 #include "WebCoreThread.h"
 #endif
 
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+#include "DisplayRefreshMonitorClient.h"
+#endif
+
 namespace WebCore {
 
 class Document;
@@ -56,11 +60,17 @@ public:
 
     int processedTokens;
     double startTime;
+    double lastCheckTime;
+    double deadline;
     bool needsYield;
     bool didSeeScript;
 };
 
-class HTMLParserScheduler {
+class HTMLParserScheduler
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+    : public DisplayRefreshMonitorClient
+#endif
+{
     WTF_MAKE_NONCOPYABLE(HTMLParserScheduler); WTF_MAKE_FAST_ALLOCATED;
 public:
     explicit HTMLParserScheduler(HTMLDocumentParser&);
@@ -73,19 +83,8 @@ public:
         if (WebThreadShouldYield())
             session.needsYield = true;
 #endif
-        if (session.processedTokens > m_parserChunkSize || session.didSeeScript) {
-            // monotonicallyIncreasingTime() can be expensive. By delaying, we avoided calling
-            // monotonicallyIncreasingTime() when constructing non-yielding PumpSessions.
-            if (!session.startTime)
-                session.startTime = monotonicallyIncreasingTime();
-
-            session.processedTokens = 0;
-            session.didSeeScript = false;
-
-            double elapsedTime = monotonicallyIncreasingTime() - session.startTime;
-            if (elapsedTime > m_parserTimeLimit)
-                session.needsYield = true;
-        }
+        if (session.processedTokens > m_parserChunkSize || session.didSeeScript)
+            checkForYieldAtChunkBoundary(session);
         ++session.processedTokens;
     }
     void checkForYieldBeforeScript(PumpSession&);
@@ -93,21 +92,47 @@ public:
     void scheduleForResume();
     bool isScheduledForResume() const { return m_isSuspendedWithActiveTimer || m_continueNextChunkTimer.isActive(); }
 
+    // For parsers fed by a BackgroundHTMLTokenizer. New chunks are picked up by the resume timer,
+    // so they are tree built in the same yielding slices as network data on the main thread.
+    void scheduleForResumeAfterTokenizedChunk();
+    void didConsumeTokenizedChunk(unsigned tokenCount, double tokenizationTime);
+    unsigned preferredTokenizedChunkSize() const;
+
     void suspend();
     void resume();
 
 private:
     void continueNextChunkTimerFired();
 
+    void checkForYieldAtChunkBoundary(PumpSession&);
+    double timeBudgetForSession(double now) const;
+    void updateParserChunkSize(int processedTokens, double elapsedTime, double timeBudget);
+    bool hasPendingUserInput() const;
+
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+    void scheduleDisplayRefreshIfNeeded();
+
+    // DisplayRefreshMonitorClient.
+    virtual void displayRefreshFired(double timestamp) override;
+    virtual RefPtr<DisplayRefreshMonitor> createDisplayRefreshMonitor(PlatformDisplayID) const override;
+#endif
+
     HTMLDocumentParser& m_parser;
 
     double m_parserTimeLimit;
+    bool m_hasCustomParserTimeLimit;
     int m_parserChunkSize;
+    double m_tokensPerSecond { 0 };
+#if USE(REQUEST_ANIMATION_FRAME_DISPLAY_MONITOR)
+    double m_lastDisplayRefreshTime { 0 };
+    double m_displayRefreshInterval { 0 };
+#endif
     Timer m_continueNextChunkTimer;
     bool m_isSuspendedWithActiveTimer;
-#if !ASSERT_DISABLED
     bool m_suspended;
-#endif
+
+    unsigned m_tokenizedTokenCount { 0 };
+    double m_tokenizationTime { 0 };
 };
 
 }
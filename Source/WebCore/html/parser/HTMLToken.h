@@ -108,6 +108,8 @@ public:
     void beginAttribute(unsigned offset);
     void appendToAttributeName(UChar);
     void appendToAttributeValue(UChar);
+    void appendToAttributeValue(const LChar*, unsigned length);
+    void appendToAttributeValue(const UChar*, unsigned length);
     void endAttribute(unsigned offset);
 
     void setSelfClosing();
@@ -129,6 +131,8 @@ public:
     void appendToCharacter(LChar);
     void appendToCharacter(UChar);
     void appendToCharacter(const Vector<LChar, 32>&);
+    void appendToCharacter(const LChar*, unsigned length);
+    void appendToCharacter(const UChar*, unsigned length);
 
     // Comment.
 
@@ -139,6 +143,8 @@ public:
     void appendToComment(UChar);
 
 private:
+    void clearAttributes();
+
     Type m_type;
 
     DataVector m_data;
@@ -261,13 +267,24 @@ inline void HTMLToken::setSelfClosing()
     m_selfClosing = true;
 }
 
+inline void HTMLToken::clearAttributes()
+{
+    // An attribute heavy tag is usually followed by more like it, as in the rows of a table, so
+    // keep the out-of-line buffer it needed for the next tags unless it grew unreasonably large.
+    const size_t maximumRetainedAttributeCapacity = 64;
+    if (m_attributes.capacity() > maximumRetainedAttributeCapacity)
+        m_attributes.clear();
+    else
+        m_attributes.shrink(0);
+}
+
 inline void HTMLToken::beginStartTag(UChar character)
 {
     ASSERT(character);
     ASSERT(m_type == Uninitialized);
     m_type = StartTag;
     m_selfClosing = false;
-    m_attributes.clear();
+    clearAttributes();
 
 #if !ASSERT_DISABLED
     m_currentAttribute = nullptr;
@@ -282,7 +299,7 @@ inline void HTMLToken::beginEndTag(LChar character)
     ASSERT(m_type == Uninitialized);
     m_type = EndTag;
     m_selfClosing = false;
-    m_attributes.clear();
+    clearAttributes();
 
 #if !ASSERT_DISABLED
     m_currentAttribute = nullptr;
@@ -296,7 +313,7 @@ inline void HTMLToken::beginEndTag(const Vector<LChar, 32>& characters)
     ASSERT(m_type == Uninitialized);
     m_type = EndTag;
     m_selfClosing = false;
-    m_attributes.clear();
+    clearAttributes();
 
 #if !ASSERT_DISABLED
     m_currentAttribute = nullptr;
@@ -342,6 +359,20 @@ inline void HTMLToken::appendToAttributeValue(UChar character)
     m_currentAttribute->value.append(character);
 }
 
+inline void HTMLToken::appendToAttributeValue(const LChar* characters, unsigned length)
+{
+    ASSERT(m_type == StartTag || m_type == EndTag);
+    ASSERT(m_currentAttribute);
+    m_currentAttribute->value.append(characters, length);
+}
+
+inline void HTMLToken::appendToAttributeValue(const UChar* characters, unsigned length)
+{
+    ASSERT(m_type == StartTag || m_type == EndTag);
+    ASSERT(m_currentAttribute);
+    m_currentAttribute->value.append(characters, length);
+}
+
 inline void HTMLToken::appendToAttributeValue(unsigned i, StringView value)
 {
     ASSERT(!value.isEmpty());
@@ -397,6 +428,24 @@ inline void HTMLToken::appendToCharacter(const Vector<LChar, 32>& characters)
     m_data.appendVector(characters);
 }
 
+inline void HTMLToken::appendToCharacter(const LChar* characters, unsigned length)
+{
+    ASSERT(m_type == Uninitialized || m_type == Character);
+    m_type = Character;
+    m_data.append(characters, length);
+}
+
+inline void HTMLToken::appendToCharacter(const UChar* characters, unsigned length)
+{
+    ASSERT(m_type == Uninitialized || m_type == Character);
+    m_type = Character;
+    m_data.append(characters, length);
+    UChar allCharacterBits = 0;
+    for (unsigned i = 0; i < length; ++i)
+        allCharacterBits |= characters[i];
+    m_data8BitCheck |= allCharacterBits;
+}
+
 inline const HTMLToken::DataVector& HTMLToken::comment() const
 {
     ASSERT(m_type == Comment);
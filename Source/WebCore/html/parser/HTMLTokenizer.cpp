@@ -92,6 +92,32 @@ inline void HTMLTokenizer::bufferCharacter(UChar character)
     m_token.appendToCharacter(character);
 }
 
+inline bool HTMLTokenizer::bufferCharacterRun(SegmentedString& source)
+{
+    unsigned length = source.lengthOfRunBefore('<', '&');
+    if (!length)
+        return false;
+    if (source.runIs8Bit())
+        m_token.appendToCharacter(source.runCharacters8(), length);
+    else
+        m_token.appendToCharacter(source.runCharacters16(), length);
+    source.advancePastRun(length);
+    return true;
+}
+
+inline bool HTMLTokenizer::appendAttributeValueRun(SegmentedString& source, UChar quoteCharacter)
+{
+    unsigned length = source.lengthOfRunBefore(quoteCharacter, '&');
+    if (!length)
+        return false;
+    if (source.runIs8Bit())
+        m_token.appendToAttributeValue(source.runCharacters8(), length);
+    else
+        m_token.appendToAttributeValue(source.runCharacters16(), length);
+    source.advancePastRun(length);
+    return true;
+}
+
 inline bool HTMLTokenizer::emitAndResumeInDataState(SegmentedString& source)
 {
     saveEndTagNameIfNeeded();
@@ -220,6 +246,9 @@ bool HTMLTokenizer::processToken(SegmentedString& source)
         }
         if (character == kEndOfFileMarker)
             return emitEndOfFile(source);
+        // The run can only start here if the preprocessor left the current character alone.
+        if (character == source.currentChar() && bufferCharacterRun(source))
+            SWITCH_TO(DataState);
         bufferCharacter(character);
         ADVANCE_TO(DataState);
     END_STATE()
@@ -807,6 +836,8 @@ bool HTMLTokenizer::processToken(SegmentedString& source)
             m_token.endAttribute(source.numberOfCharactersConsumed());
             RECONSUME_IN(DataState);
         }
+        if (character == source.currentChar() && appendAttributeValueRun(source, '"'))
+            SWITCH_TO(AttributeValueDoubleQuotedState);
         m_token.appendToAttributeValue(character);
         ADVANCE_TO(AttributeValueDoubleQuotedState);
     END_STATE()
@@ -825,6 +856,8 @@ bool HTMLTokenizer::processToken(SegmentedString& source)
             m_token.endAttribute(source.numberOfCharactersConsumed());
             RECONSUME_IN(DataState);
         }
+        if (character == source.currentChar() && appendAttributeValueRun(source, '\''))
+            SWITCH_TO(AttributeValueSingleQuotedState);
         m_token.appendToAttributeValue(character);
         ADVANCE_TO(AttributeValueSingleQuotedState);
     END_STATE()
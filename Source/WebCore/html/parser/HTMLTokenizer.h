@@ -77,6 +77,11 @@ public:
 
     bool neverSkipNullCharacters() const;
 
+    // The part of the tokenizer's state that the tree builder controls between tokens. BackgroundHTMLTokenizer
+    // predicts it without a tree builder, and HTMLDocumentParser checks each prediction against the real one.
+    class SpeculativeState;
+    SpeculativeState speculativeState() const;
+
 private:
     enum State {
         DataState,
@@ -161,6 +166,11 @@ private:
     void bufferASCIICharacter(UChar);
     void bufferCharacter(UChar);
 
+    // Consume a run of characters that needs no per-character processing, starting at the current one,
+    // all at once. They return false, consuming nothing, if there is no run to consume.
+    bool bufferCharacterRun(SegmentedString&);
+    bool appendAttributeValueRun(SegmentedString&, UChar quoteCharacter);
+
     bool emitAndResumeInDataState(SegmentedString&);
     bool emitAndReconsumeInDataState();
     bool emitEndOfFile(SegmentedString&);
@@ -209,6 +219,30 @@ private:
     const HTMLParserOptions m_options;
 };
 
+class HTMLTokenizer::SpeculativeState {
+public:
+    bool operator==(const SpeculativeState& other) const
+    {
+        return m_state == other.m_state
+            && m_shouldAllowCDATA == other.m_shouldAllowCDATA
+            && m_forceNullCharacterReplacement == other.m_forceNullCharacterReplacement;
+    }
+    bool operator!=(const SpeculativeState& other) const { return !(*this == other); }
+
+private:
+    friend class HTMLTokenizer;
+    SpeculativeState(State state, bool shouldAllowCDATA, bool forceNullCharacterReplacement)
+        : m_state(state)
+        , m_shouldAllowCDATA(shouldAllowCDATA)
+        , m_forceNullCharacterReplacement(forceNullCharacterReplacement)
+    {
+    }
+
+    State m_state;
+    bool m_shouldAllowCDATA;
+    bool m_forceNullCharacterReplacement;
+};
+
 class HTMLTokenizer::TokenPtr {
 public:
     TokenPtr();
@@ -335,6 +369,11 @@ inline void HTMLTokenizer::setScriptDataState()
     m_state = ScriptDataState;
 }
 
+inline HTMLTokenizer::SpeculativeState HTMLTokenizer::speculativeState() const
+{
+    return SpeculativeState(m_state, m_shouldAllowCDATA, m_forceNullCharacterReplacement);
+}
+
 inline bool HTMLTokenizer::isNullCharacterSkippingState(State state)
 {
     return state == DataState || state == RCDATAState || state == RAWTEXTState;
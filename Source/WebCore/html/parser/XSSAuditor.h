@@ -62,6 +62,8 @@ public:
 
     std::unique_ptr<XSSInfo> filterToken(const FilterTokenRequest&);
 
+    bool isEnabled() const { return m_isEnabled; }
+
 private:
     static const size_t kMaximumFragmentLengthTarget = 100;
 
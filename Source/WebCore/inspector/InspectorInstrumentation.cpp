@@ -59,6 +59,7 @@
 #include "RenderObject.h"
 #include "RenderView.h"
 #include "ScriptController.h"
+#include "StyleCostProfile.h"
 #include "StyleResolver.h"
 #include "StyleRule.h"
 #include "WebConsoleAgent.h"
@@ -498,7 +499,7 @@ InspectorInstrumentationCookie InspectorInstrumentation::willRecalculateStyleImp
 {
     int timelineAgentId = 0;
     if (InspectorTimelineAgent* timelineAgent = instrumentingAgents.inspectorTimelineAgent()) {
-        timelineAgent->willRecalculateStyle(document.frame());
+        timelineAgent->willRecalculateStyle(document);
         timelineAgentId = timelineAgent->id();
     }
     if (InspectorNetworkAgent* networkAgent = instrumentingAgents.inspectorNetworkAgent())
@@ -506,15 +507,17 @@ InspectorInstrumentationCookie InspectorInstrumentation::willRecalculateStyleImp
     return InspectorInstrumentationCookie(instrumentingAgents, timelineAgentId);
 }
 
-void InspectorInstrumentation::didRecalculateStyleImpl(const InspectorInstrumentationCookie& cookie)
+void InspectorInstrumentation::didRecalculateStyleImpl(const InspectorInstrumentationCookie& cookie, Document& document)
 {
+    std::unique_ptr<Style::CostProfile> costProfile = document.takeStyleCostProfile();
+
     if (!cookie.isValid())
         return;
     
     InstrumentingAgents& instrumentingAgents = *cookie.instrumentingAgents();
 
     if (InspectorTimelineAgent* timelineAgent = retrieveTimelineAgent(cookie))
-        timelineAgent->didRecalculateStyle();
+        timelineAgent->didRecalculateStyle(costProfile.get());
     if (InspectorNetworkAgent* networkAgent = instrumentingAgents.inspectorNetworkAgent())
         networkAgent->didRecalculateStyle();
     if (InspectorPageAgent* pageAgent = instrumentingAgents.inspectorPageAgent())
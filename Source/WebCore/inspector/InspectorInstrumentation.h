@@ -166,7 +166,7 @@ public:
     static void willPaint(RenderObject*);
     static void didPaint(RenderObject*, const LayoutRect&);
     static InspectorInstrumentationCookie willRecalculateStyle(Document&);
-    static void didRecalculateStyle(const InspectorInstrumentationCookie&);
+    static void didRecalculateStyle(const InspectorInstrumentationCookie&, Document&);
     static void didScheduleStyleRecalculation(Document&);
 
     static void applyEmulatedMedia(Frame&, String&);
@@ -340,7 +340,7 @@ private:
     static void willPaintImpl(InstrumentingAgents&, RenderObject*);
     static void didPaintImpl(InstrumentingAgents&, RenderObject*, const LayoutRect&);
     static InspectorInstrumentationCookie willRecalculateStyleImpl(InstrumentingAgents&, Document&);
-    static void didRecalculateStyleImpl(const InspectorInstrumentationCookie&);
+    static void didRecalculateStyleImpl(const InspectorInstrumentationCookie&, Document&);
     static void didScheduleStyleRecalculationImpl(InstrumentingAgents&, Document&);
 
     static void applyEmulatedMediaImpl(InstrumentingAgents&, String&);
@@ -836,11 +836,11 @@ inline InspectorInstrumentationCookie InspectorInstrumentation::willRecalculateS
     return InspectorInstrumentationCookie();
 }
 
-inline void InspectorInstrumentation::didRecalculateStyle(const InspectorInstrumentationCookie& cookie)
+inline void InspectorInstrumentation::didRecalculateStyle(const InspectorInstrumentationCookie& cookie, Document& document)
 {
-    FAST_RETURN_IF_NO_FRONTENDS(void());
+    // No FAST_RETURN_IF_NO_FRONTENDS: a frontend closed during the recalc still leaves a style cost profile to clear.
     if (cookie.isValid())
-        didRecalculateStyleImpl(cookie);
+        didRecalculateStyleImpl(cookie, document);
 }
 
 inline void InspectorInstrumentation::didScheduleStyleRecalculation(Document& document)
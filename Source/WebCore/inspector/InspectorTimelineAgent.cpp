@@ -33,6 +33,7 @@
 #include "config.h"
 #include "InspectorTimelineAgent.h"
 
+#include "Document.h"
 #include "Event.h"
 #include "Frame.h"
 #include "InspectorPageAgent.h"
@@ -41,6 +42,7 @@
 #include "PageScriptDebugServer.h"
 #include "RenderView.h"
 #include "ScriptState.h"
+#include "StyleCostProfile.h"
 #include "TimelineRecordFactory.h"
 #include <inspector/ScriptBreakpoint.h>
 #include <profiler/LegacyProfiler.h>
@@ -59,6 +61,9 @@ using namespace Inspector;
 
 namespace WebCore {
 
+static const double flushPendingEventsInterval = 0.1;
+static const size_t maximumPendingEvents = 10000;
+
 #if PLATFORM(COCOA)
 static const CFIndex frameStopRunLoopOrder = (CFIndex)RunLoopObserver::WellKnownRunLoopOrders::CoreAnimationCommit + 1;
 
@@ -195,6 +200,7 @@ void InspectorTimelineAgent::internalStop()
     m_enabled = false;
     m_startedComposite = false;
 
+    flushPendingEvents();
     m_frontendDispatcher->recordingStopped(timestamp());
 }
 
@@ -345,13 +351,16 @@ void InspectorTimelineAgent::didScheduleStyleRecalculation(Frame* frame)
     appendRecord(InspectorObject::create(), TimelineRecordType::ScheduleStyleRecalculation, true, frame);
 }
 
-void InspectorTimelineAgent::willRecalculateStyle(Frame* frame)
+void InspectorTimelineAgent::willRecalculateStyle(Document& document)
 {
-    pushCurrentRecord(InspectorObject::create(), TimelineRecordType::RecalculateStyles, true, frame);
+    document.setStyleCostProfile(std::make_unique<Style::CostProfile>());
+    pushCurrentRecord(InspectorObject::create(), TimelineRecordType::RecalculateStyles, true, document.frame());
 }
 
-void InspectorTimelineAgent::didRecalculateStyle()
+void InspectorTimelineAgent::didRecalculateStyle(const Style::CostProfile* costProfile)
 {
+    if (costProfile && !m_recordStack.isEmpty() && m_recordStack.last().type == TimelineRecordType::RecalculateStyles)
+        TimelineRecordFactory::appendStyleRecalcCost(m_recordStack.last().data.get(), *costProfile);
     didCompleteCurrentRecord(TimelineRecordType::RecalculateStyles);
 }
 
@@ -600,6 +609,7 @@ InspectorTimelineAgent::InspectorTimelineAgent(WebAgentContext& context, Inspect
     , m_backendDispatcher(Inspector::TimelineBackendDispatcher::create(context.backendDispatcher, this))
     , m_pageAgent(pageAgent)
     , m_inspectorType(type)
+    , m_flushPendingEventsTimer(*this, &InspectorTimelineAgent::flushPendingEvents)
 {
 }
 
@@ -613,9 +623,31 @@ void InspectorTimelineAgent::appendRecord(RefPtr<InspectorObject>&& data, Timeli
 
 void InspectorTimelineAgent::sendEvent(RefPtr<InspectorObject>&& event)
 {
-    // FIXME: runtimeCast is a hack. We do it because we can't build TimelineEvent directly now.
-    auto recordChecked = BindingTraits<Inspector::Protocol::Timeline::TimelineEvent>::runtimeCast(WTF::move(event));
-    m_frontendDispatcher->eventRecorded(WTF::move(recordChecked));
+    // Behave like a ring buffer if the frontend falls behind: the oldest records are the least interesting.
+    if (m_pendingEvents.size() >= maximumPendingEvents) {
+        m_pendingEvents.removeFirst();
+        ++m_droppedEventCount;
+    }
+    m_pendingEvents.append(WTF::move(event));
+
+    if (!m_flushPendingEventsTimer.isActive())
+        m_flushPendingEventsTimer.startOneShot(flushPendingEventsInterval);
+}
+
+void InspectorTimelineAgent::flushPendingEvents()
+{
+    m_flushPendingEventsTimer.stop();
+
+    if (m_droppedEventCount) {
+        LOG_ERROR("Web Inspector timeline dropped %u records because the frontend was not keeping up", m_droppedEventCount);
+        m_droppedEventCount = 0;
+    }
+
+    while (!m_pendingEvents.isEmpty()) {
+        // FIXME: runtimeCast is a hack. We do it because we can't build TimelineEvent directly now.
+        auto recordChecked = BindingTraits<Inspector::Protocol::Timeline::TimelineEvent>::runtimeCast(m_pendingEvents.takeFirst());
+        m_frontendDispatcher->eventRecorded(WTF::move(recordChecked));
+    }
 }
 
 InspectorTimelineAgent::TimelineRecordEntry InspectorTimelineAgent::createRecordEntry(RefPtr<InspectorObject>&& data, TimelineRecordType type, bool captureCallStack, Frame* frame)
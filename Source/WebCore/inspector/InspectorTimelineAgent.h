@@ -35,10 +35,12 @@
 
 #include "InspectorWebAgentBase.h"
 #include "LayoutRect.h"
+#include "Timer.h"
 #include <inspector/InspectorBackendDispatchers.h>
 #include <inspector/InspectorFrontendDispatchers.h>
 #include <inspector/InspectorValues.h>
 #include <inspector/ScriptDebugListener.h>
+#include <wtf/Deque.h>
 #include <wtf/Vector.h>
 
 namespace JSC {
@@ -47,6 +49,7 @@ class Profile;
 
 namespace WebCore {
 
+class Document;
 class Event;
 class FloatQuad;
 class Frame;
@@ -54,6 +57,10 @@ class InspectorPageAgent;
 class RenderObject;
 class RunLoopObserver;
 
+namespace Style {
+class CostProfile;
+}
+
 typedef String ErrorString;
 
 enum class TimelineRecordType {
@@ -129,8 +136,8 @@ public:
     void didComposite();
     void willPaint(Frame&);
     void didPaint(RenderObject*, const LayoutRect&);
-    void willRecalculateStyle(Frame*);
-    void didRecalculateStyle();
+    void willRecalculateStyle(Document&);
+    void didRecalculateStyle(const Style::CostProfile*);
     void didScheduleStyleRecalculation(Frame*);
     void didTimeStamp(Frame&, const String&);
     void didRequestAnimationFrame(int callbackId, Frame*);
@@ -176,6 +183,7 @@ private:
     double timestamp();
 
     void sendEvent(RefPtr<Inspector::InspectorObject>&&);
+    void flushPendingEvents();
     void appendRecord(RefPtr<Inspector::InspectorObject>&& data, TimelineRecordType, bool captureCallStack, Frame*);
     void pushCurrentRecord(RefPtr<Inspector::InspectorObject>&&, TimelineRecordType, bool captureCallStack, Frame*);
     void pushCurrentRecord(const TimelineRecordEntry& record) { m_recordStack.append(record); }
@@ -204,6 +212,12 @@ private:
 
     Vector<TimelineRecordEntry> m_pendingConsoleProfileRecords;
 
+    // Completed top-level records are kept in a bounded queue and dispatched to the frontend in batches,
+    // so instrumentation hooks don't pay for serialization and dispatch on every event.
+    Deque<RefPtr<Inspector::InspectorObject>> m_pendingEvents;
+    Timer m_flushPendingEventsTimer;
+    unsigned m_droppedEventCount { 0 };
+
     bool m_enabled { false };
     bool m_enabledFromFrontend { false };
 
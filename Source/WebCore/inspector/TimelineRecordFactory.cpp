@@ -32,14 +32,18 @@
 #include "config.h"
 #include "TimelineRecordFactory.h"
 
+#include "Element.h"
 #include "Event.h"
 #include "FloatQuad.h"
 #include "JSMainThreadExecState.h"
+#include "StyleCostProfile.h"
+#include "StyleRule.h"
 #include <inspector/InspectorProtocolObjects.h>
 #include <inspector/ScriptBreakpoint.h>
 #include <inspector/ScriptCallStack.h>
 #include <inspector/ScriptCallStackFactory.h>
 #include <profiler/Profile.h>
+#include <wtf/text/StringBuilder.h>
 
 using namespace Inspector;
 
@@ -152,6 +156,52 @@ void TimelineRecordFactory::appendLayoutRoot(InspectorObject* data, const FloatQ
     data->setArray(ASCIILiteral("root"), createQuad(quad));
 }
 
+static String elementDescription(const Element& element)
+{
+    StringBuilder description;
+    description.append(element.localName());
+    if (element.hasID()) {
+        description.append('#');
+        description.append(element.getIdAttribute());
+    }
+    if (element.hasClass()) {
+        const SpaceSplitString& classNames = element.classNames();
+        for (size_t i = 0; i < classNames.size(); ++i) {
+            description.append('.');
+            description.append(classNames[i]);
+        }
+    }
+    return description.toString();
+}
+
+void TimelineRecordFactory::appendStyleRecalcCost(InspectorObject* data, const Style::CostProfile& profile)
+{
+    const unsigned maximumReportedRuleCount = 20;
+    const unsigned maximumReportedElementCount = 20;
+
+    data->setInteger(ASCIILiteral("resolvedElementCount"), profile.resolvedElementCount());
+
+    Ref<InspectorArray> rules = InspectorArray::create();
+    for (auto& entry : profile.costliestRules(maximumReportedRuleCount)) {
+        Ref<InspectorObject> rule = InspectorObject::create();
+        rule->setString(ASCIILiteral("selector"), entry.first->selectorList().selectorsText());
+        rule->setInteger(ASCIILiteral("matchAttempts"), entry.second.matchAttempts);
+        rule->setInteger(ASCIILiteral("matches"), entry.second.matches);
+        rule->setDouble(ASCIILiteral("estimatedTime"), entry.second.estimatedMatchSeconds());
+        rules->pushObject(WTF::move(rule));
+    }
+    data->setArray(ASCIILiteral("selectorCosts"), WTF::move(rules));
+
+    Ref<InspectorArray> elements = InspectorArray::create();
+    for (auto& entry : profile.mostResolvedElements(maximumReportedElementCount)) {
+        Ref<InspectorObject> element = InspectorObject::create();
+        element->setString(ASCIILiteral("element"), elementDescription(*entry.first));
+        element->setInteger(ASCIILiteral("resolveCount"), entry.second);
+        elements->pushObject(WTF::move(element));
+    }
+    data->setArray(ASCIILiteral("mostResolvedElements"), WTF::move(elements));
+}
+
 static Ref<Protocol::Timeline::CPUProfileNodeAggregateCallInfo> buildAggregateCallInfoInspectorObject(const JSC::ProfileNode* node)
 {
     double startTime = node->calls()[0].startTime();
@@ -49,6 +49,10 @@ namespace WebCore {
 class Event;
 class FloatQuad;
 
+namespace Style {
+class CostProfile;
+}
+
 class TimelineRecordFactory {
 public:
     static Ref<Inspector::InspectorObject> createGenericRecord(double startTime, int maxCallStackDepth);
@@ -66,6 +70,7 @@ public:
 
     static void appendLayoutRoot(Inspector::InspectorObject* data, const FloatQuad&);
     static void appendProfile(Inspector::InspectorObject*, RefPtr<JSC::Profile>&&);
+    static void appendStyleRecalcCost(Inspector::InspectorObject* data, const Style::CostProfile&);
 
 private:
     TimelineRecordFactory() { }
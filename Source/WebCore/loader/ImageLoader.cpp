@@ -31,6 +31,7 @@
 #include "Event.h"
 #include "EventSender.h"
 #include "Frame.h"
+#include "HTMLImageElement.h"
 #include "HTMLNames.h"
 #include "HTMLObjectElement.h"
 #include "HTMLParserIdioms.h"
@@ -184,6 +185,13 @@ void ImageLoader::updateFromElement()
             updateRequestForAccessControl(request.mutableResourceRequest(), document.securityOrigin(), allowCredentials);
         }
 
+        // Offscreen images only get a CachedImage for now; the document starts the load once the
+        // element gets near the viewport.
+        bool deferLoad = !m_loadManually && is<HTMLImageElement>(element()) && !request.resourceRequest().url().protocolIsData()
+            && document.shouldDeferLoadUntilNearViewport(element());
+        if (deferLoad)
+            request.setDefer(CachedResourceRequest::DeferredByClient);
+
         if (m_loadManually) {
             bool autoLoadOtherImages = document.cachedResourceLoader().autoLoadImages();
             document.cachedResourceLoader().setAutoLoadImages(false);
@@ -203,8 +211,11 @@ void ImageLoader::updateFromElement()
             m_failedLoadURL = attr;
             m_hasPendingErrorEvent = true;
             errorEventSender().dispatchEventSoon(*this);
-        } else
+        } else {
             clearFailedLoadURL();
+            if (deferLoad && newImage && newImage->stillNeedsLoad())
+                document.deferLoadUntilNearViewport(element());
+        }
     } else if (!attr.isNull()) {
         // Fire an error event if the url is empty.
         m_failedLoadURL = attr;
@@ -265,6 +276,15 @@ void ImageLoader::updateFromElement()
     updatedHasPendingEvent();
 }
 
+void ImageLoader::loadDeferredImage(ResourceLoadPriority priority)
+{
+    if (!m_image || !m_image->stillNeedsLoad())
+        return;
+
+    m_image->setLoadPriority(priority);
+    m_image->load(element().document().cachedResourceLoader(), CachedResourceLoader::defaultCachedResourceOptions());
+}
+
 void ImageLoader::updateFromElementIgnoringPreviousError()
 {
     clearFailedLoadURL();
@@ -25,6 +25,7 @@
 
 #include "CachedImageClient.h"
 #include "CachedResourceHandle.h"
+#include "ResourceLoadPriority.h"
 #include "Timer.h"
 #include <wtf/text/AtomicString.h>
 
@@ -50,6 +51,9 @@ public:
     // doesn't change; starts new load unconditionally (matches Firefox and Opera behavior).
     void updateFromElementIgnoringPreviousError();
 
+    // Starts the load that updateFromElement() held back because the element was far offscreen.
+    void loadDeferredImage(ResourceLoadPriority);
+
     void elementDidMoveToNewDocument();
 
     Element& element() { return m_element; }
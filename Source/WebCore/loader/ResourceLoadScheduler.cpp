@@ -37,6 +37,7 @@
 #include "ResourceRequest.h"
 #include "SubresourceLoader.h"
 #include "URL.h"
+#include <wtf/CurrentTime.h>
 #include <wtf/MainThread.h>
 #include <wtf/TemporaryChange.h>
 #include <wtf/text/CString.h>
@@ -165,6 +166,8 @@ void ResourceLoadScheduler::scheduleLoad(ResourceLoader* resourceLoader)
 
     bool hadRequests = host->hasRequests();
     host->schedule(resourceLoader, priority);
+    m_scheduleTimes.set(resourceLoader, monotonicallyIncreasingTime());
+    updateRenderBlockingLoads(resourceLoader, priority);
 
 #if PLATFORM(COCOA) || USE(CFNETWORK)
     if (ResourceRequest::resourcePrioritiesEnabled() && !isSuspendingPendingRequests()) {
@@ -198,6 +201,9 @@ void ResourceLoadScheduler::remove(ResourceLoader* resourceLoader)
 {
     ASSERT(resourceLoader);
 
+    m_scheduleTimes.remove(resourceLoader);
+    m_renderBlockingLoads.remove(resourceLoader);
+
     HostInformation* host = hostForURL(resourceLoader->url());
     if (host)
         host->remove(resourceLoader);
@@ -233,6 +239,28 @@ void ResourceLoadScheduler::crossOriginRedirectReceived(ResourceLoader* resource
     oldHost->remove(resourceLoader);
 }
 
+void ResourceLoadScheduler::setPriority(ResourceLoader* resourceLoader, ResourceLoadPriority priority)
+{
+    ASSERT(resourceLoader);
+
+    HostInformation* host = hostForURL(resourceLoader->url());
+    if (!host || !host->reschedule(resourceLoader, priority))
+        return;
+
+    LOG(ResourceLoading, "ResourceLoadScheduler::setPriority resource %p '%s' priority %d", resourceLoader, resourceLoader->url().string().latin1().data(), static_cast<int>(priority));
+
+    updateRenderBlockingLoads(resourceLoader, priority);
+    scheduleServePendingRequests();
+}
+
+void ResourceLoadScheduler::updateRenderBlockingLoads(ResourceLoader* resourceLoader, ResourceLoadPriority priority)
+{
+    if (isRenderBlocking(priority))
+        m_renderBlockingLoads.add(resourceLoader);
+    else
+        m_renderBlockingLoads.remove(resourceLoader);
+}
+
 void ResourceLoadScheduler::servePendingRequests(ResourceLoadPriority minimumPriority)
 {
     LOG(ResourceLoading, "ResourceLoadScheduler::servePendingRequests. m_suspendPendingRequestsCount=%d", m_suspendPendingRequestsCount); 
@@ -269,11 +297,15 @@ void ResourceLoadScheduler::servePendingRequests(HostInformation* host, Resource
             // and we don't know all stylesheets yet.
             Document* document = resourceLoader->frameLoader() ? resourceLoader->frameLoader()->frame().document() : 0;
             bool shouldLimitRequests = !host->name().isNull() || (document && (document->parsing() || !document->haveStylesheetsLoaded()));
-            if (shouldLimitRequests && host->limitRequests(priority))
+            if (shouldLimitRequests && host->limitRequests(priority, !m_renderBlockingLoads.isEmpty()))
                 return;
 
             requestsPending.removeFirst();
             host->addLoadInProgress(resourceLoader.get());
+
+            auto scheduleTime = m_scheduleTimes.take(resourceLoader.get());
+            if (scheduleTime)
+                resourceLoader->setQueueingDelay(static_cast<int>((monotonicallyIncreasingTime() - scheduleTime) * 1000));
 #if PLATFORM(IOS)
             if (!applicationIsWebProcess()) {
                 resourceLoader->startLoading();
@@ -350,6 +382,22 @@ void ResourceLoadScheduler::HostInformation::schedule(ResourceLoader* resourceLo
     m_requestsPending[priorityToIndex(priority)].append(resourceLoader);
 }
     
+bool ResourceLoadScheduler::HostInformation::reschedule(ResourceLoader* resourceLoader, ResourceLoadPriority priority)
+{
+    for (auto& requestQueue : m_requestsPending) {
+        for (auto it = requestQueue.begin(), end = requestQueue.end(); it != end; ++it) {
+            if (*it != resourceLoader)
+                continue;
+            RefPtr<ResourceLoader> protectedResourceLoader = *it;
+            requestQueue.remove(it);
+            schedule(protectedResourceLoader.get(), priority);
+            return true;
+        }
+    }
+    // Loads in progress keep their priority.
+    return false;
+}
+
 void ResourceLoadScheduler::HostInformation::addLoadInProgress(ResourceLoader* resourceLoader)
 {
     LOG(ResourceLoading, "HostInformation '%s' loading '%s'. Current count %d", m_name.latin1().data(), resourceLoader->url().string().latin1().data(), m_requestsLoading.size());
@@ -382,10 +430,13 @@ bool ResourceLoadScheduler::HostInformation::hasRequests() const
     return false;
 }
 
-bool ResourceLoadScheduler::HostInformation::limitRequests(ResourceLoadPriority priority) const 
+bool ResourceLoadScheduler::HostInformation::limitRequests(ResourceLoadPriority priority, bool hasRenderBlockingLoads) const
 {
     if (priority == ResourceLoadPriority::VeryLow && !m_requestsLoading.isEmpty())
         return true;
+    // Leave the bandwidth to the render-blocking loads, but keep one load going so the host doesn't stall.
+    if (hasRenderBlockingLoads && priority <= ResourceLoadPriority::Low && !m_requestsLoading.isEmpty())
+        return true;
     return m_requestsLoading.size() >= (resourceLoadScheduler()->isSerialLoadingEnabled() ? 1 : m_maxRequestsInFlight);
 }
 
@@ -56,6 +56,8 @@ public:
     WEBCORE_EXPORT virtual void remove(ResourceLoader*);
     virtual void setDefersLoading(ResourceLoader*, bool);
     virtual void crossOriginRedirectReceived(ResourceLoader*, const URL& redirectURL);
+    // For example when layout finds that an image is visible.
+    WEBCORE_EXPORT virtual void setPriority(ResourceLoader*, ResourceLoadPriority);
     
     WEBCORE_EXPORT virtual void servePendingRequests(ResourceLoadPriority minimumPriority = ResourceLoadPriority::VeryLow);
     WEBCORE_EXPORT virtual void suspendPendingRequests();
@@ -83,6 +85,10 @@ private:
 
     bool isSuspendingPendingRequests() const { return !!m_suspendPendingRequestsCount; }
 
+    // Style sheets. Main resources stream for a long time and would throttle everything else.
+    static bool isRenderBlocking(ResourceLoadPriority priority) { return priority == ResourceLoadPriority::High; }
+    void updateRenderBlockingLoads(ResourceLoader*, ResourceLoadPriority);
+
     class HostInformation {
         WTF_MAKE_NONCOPYABLE(HostInformation); WTF_MAKE_FAST_ALLOCATED;
     public:
@@ -91,10 +97,11 @@ private:
         
         const String& name() const { return m_name; }
         void schedule(ResourceLoader*, ResourceLoadPriority = ResourceLoadPriority::VeryLow);
+        bool reschedule(ResourceLoader*, ResourceLoadPriority);
         void addLoadInProgress(ResourceLoader*);
         void remove(ResourceLoader*);
         bool hasRequests() const;
-        bool limitRequests(ResourceLoadPriority) const;
+        bool limitRequests(ResourceLoadPriority, bool hasRenderBlockingLoads) const;
 
         typedef Deque<RefPtr<ResourceLoader>> RequestQueue;
         RequestQueue& requestsPending(ResourceLoadPriority priority) { return m_requestsPending[priorityToIndex(priority)]; }
@@ -120,6 +127,10 @@ private:
     typedef HashMap<String, HostInformation*, StringHash> HostMap;
     HostMap m_hosts;
     HostInformation* m_nonHTTPProtocolHost;
+
+    // Render-blocking loads, pending or in progress. While there are any, low priority loads are throttled.
+    HashSet<ResourceLoader*> m_renderBlockingLoads;
+    HashMap<ResourceLoader*, double> m_scheduleTimes;
         
     Timer m_requestTimer;
 
@@ -52,6 +52,7 @@
 #include "Settings.h"
 #include "SharedBuffer.h"
 #include <wtf/Ref.h>
+#include <wtf/TraceEvent.h>
 
 #if ENABLE(CONTENT_EXTENSIONS)
 #include "ResourceLoadInfo.h"
@@ -439,6 +440,8 @@ void ResourceLoader::didReceiveResponse(const ResourceResponse& r)
     logResourceResponseSource(m_frame.get(), r.source());
 
     m_response = r;
+    if (m_queueingDelay >= 0)
+        m_response.resourceLoadTiming().queueingDelay = m_queueingDelay;
 
     if (FormData* data = m_request.httpBody())
         data->removeGeneratedFilesIfNeeded();
@@ -465,6 +468,8 @@ void ResourceLoader::didReceiveBuffer(PassRefPtr<SharedBuffer> buffer, long long
 
 void ResourceLoader::didReceiveDataOrBuffer(const char* data, unsigned length, PassRefPtr<SharedBuffer> prpBuffer, long long encodedDataLength, DataPayloadType dataPayloadType)
 {
+    TraceScope traceScope(TraceCategory::Network, "ResourceLoader::didReceiveData");
+
     // This method should only get data+length *OR* a SharedBuffer.
     ASSERT(!prpBuffer || (!data && !length));
 
@@ -133,6 +133,8 @@ public:
 
     bool reachedTerminalState() const { return m_reachedTerminalState; }
 
+    // Set by the ResourceLoadScheduler when the load starts, reported in the response load timing.
+    void setQueueingDelay(int milliseconds) { m_queueingDelay = milliseconds; }
 
     const ResourceRequest& request() const { return m_request; }
 
@@ -228,6 +230,7 @@ private:
     ResourceRequest m_deferredRequest;
     ResourceLoaderOptions m_options;
     bool m_isQuickLookResource;
+    int m_queueingDelay { -1 };
 
 #if ENABLE(CONTENT_EXTENSIONS)
 protected:
@@ -26,12 +26,14 @@
 #include "DOMImplementation.h"
 #include "HTMLMetaCharsetParser.h"
 #include "HTMLNames.h"
+#include "SharedBuffer.h"
 #include "TextCodec.h"
 #include "TextEncoding.h"
 #include "TextEncodingDetector.h"
 #include "TextEncodingRegistry.h"
 #include <wtf/ASCIICType.h>
 #include <wtf/StringExtras.h>
+#include <wtf/text/StringBuilder.h>
 
 using namespace WTF;
 
@@ -671,4 +673,14 @@ String TextResourceDecoder::decodeAndFlush(const char* data, size_t length)
     return decoded + flush();
 }
 
+String TextResourceDecoder::decodeAndFlush(const SharedBuffer& buffer)
+{
+    StringBuilder decoded;
+    buffer.forEachSegment([this, &decoded](const char* segment, unsigned length) {
+        decoded.append(decode(segment, length));
+    });
+    decoded.append(flush());
+    return decoded.toString();
+}
+
 }
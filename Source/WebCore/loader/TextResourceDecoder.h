@@ -29,6 +29,7 @@
 namespace WebCore {
 
 class HTMLMetaCharsetParser;
+class SharedBuffer;
 
 class TextResourceDecoder : public RefCounted<TextResourceDecoder> {
 public:
@@ -56,6 +57,8 @@ public:
     WEBCORE_EXPORT String flush();
 
     WEBCORE_EXPORT String decodeAndFlush(const char* data, size_t length);
+    // Decodes the buffer segment by segment, so segmented buffers are not merged into a flat buffer first.
+    WEBCORE_EXPORT String decodeAndFlush(const SharedBuffer&);
 
     void setHintEncoding(const TextResourceDecoder* hintDecoder)
     {
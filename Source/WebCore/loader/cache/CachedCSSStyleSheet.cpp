@@ -87,7 +87,7 @@ const String CachedCSSStyleSheet::sheetText(MIMETypeCheck mimeTypeCheck, bool* h
         return m_decodedSheetText;
     
     // Don't cache the decoded text, regenerating is cheap and it can use quite a bit of memory
-    return m_decoder->decodeAndFlush(m_data->data(), m_data->size());
+    return m_decoder->decodeAndFlush(*m_data);
 }
 
 void CachedCSSStyleSheet::finishLoading(SharedBuffer* data)
@@ -95,8 +95,11 @@ void CachedCSSStyleSheet::finishLoading(SharedBuffer* data)
     m_data = data;
     setEncodedSize(data ? data->size() : 0);
     // Decode the data to find out the encoding and keep the sheet text around during checkNotify()
-    if (data)
-        m_decodedSheetText = m_decoder->decodeAndFlush(data->data(), data->size());
+    if (data) {
+        double startTime = monotonicallyIncreasingTime();
+        m_decodedSheetText = m_decoder->decodeAndFlush(*data);
+        setDecodeTime(monotonicallyIncreasingTime() - startTime);
+    }
     setLoading(false);
     checkNotify();
     // Clear the decoded text as it is unlikely to be needed immediately again and is cheap to regenerate.
@@ -128,7 +131,7 @@ bool CachedCSSStyleSheet::canUseSheet(MIMETypeCheck mimeTypeCheck, bool* hasVali
     //
     // This code defaults to allowing the stylesheet for non-HTTP protocols so
     // folks can use standards mode for local HTML documents.
-    String mimeType = extractMIMETypeFromMediaType(response().httpHeaderField(HTTPHeaderName::ContentType));
+    const String& mimeType = response().contentTypeHeaderMIMEType();
     bool typeOK = mimeType.isEmpty() || equalIgnoringCase(mimeType, "text/css") || equalIgnoringCase(mimeType, "application/x-unknown-content-type");
     if (hasValidMIMEType)
         *hasValidMIMEType = typeOK;
@@ -29,16 +29,21 @@
 
 #include "CachedFontClient.h"
 #include "CachedResourceClientWalker.h"
+#include "CachedResourceHandle.h"
 #include "CachedResourceLoader.h"
 #include "FontCustomPlatformData.h"
 #include "FontDescription.h"
 #include "FontPlatformData.h"
+#include "Logging.h"
 #include "MemoryCache.h"
 #include "SharedBuffer.h"
 #include "TextResourceDecoder.h"
 #include "TypedElementDescendantIterator.h"
 #include "WOFFFileFormat.h"
+#include <wtf/CurrentTime.h>
+#include <wtf/MainThread.h>
 #include <wtf/Vector.h>
+#include <wtf/WorkQueue.h>
 
 #if ENABLE(SVG_FONTS)
 #include "NodeList.h"
@@ -80,6 +85,73 @@ void CachedFont::finishLoading(SharedBuffer* data)
 {
     m_data = data;
     setEncodedSize(m_data.get() ? m_data->size() : 0);
+    m_convertedWOFFData = nullptr;
+
+#if (!PLATFORM(MAC) || __MAC_OS_X_VERSION_MIN_REQUIRED <= 1090) && !PLATFORM(IOS)
+    // Inflating a WOFF file can take long enough to drop frames, so it happens on a background queue.
+    // The font stays in the loading state until the sfnt data is back.
+    if (m_data && isWOFF(m_data.get())) {
+        convertWOFFInBackground();
+        return;
+    }
+#endif
+
+    setLoading(false);
+    checkNotify();
+}
+
+static WorkQueue& fontConversionQueue()
+{
+    static auto& queue = WorkQueue::create("org.webkit.FontConversion").leakRef();
+    return queue;
+}
+
+struct WOFFConversionTask {
+    // Only touched on the main thread.
+    CachedResourceHandle<CachedFont> font;
+    RefPtr<SharedBuffer> woffBuffer;
+
+    // Only touched on the conversion queue until the task is handed back.
+    Vector<char> woffData;
+    Vector<char> sfntData;
+    bool succeeded;
+    double conversionTime;
+};
+
+void CachedFont::convertWOFFInBackground()
+{
+    ASSERT(isMainThread());
+    ASSERT(isLoading());
+
+    auto* task = new WOFFConversionTask { this, m_data, Vector<char>(), Vector<char>(), false, 0 };
+    task->woffData.append(m_data->data(), m_data->size());
+
+    fontConversionQueue().dispatch([task] {
+        double startTime = monotonicallyIncreasingTime();
+        RefPtr<SharedBuffer> woff = SharedBuffer::adoptVector(task->woffData);
+        task->succeeded = convertWOFFToSfnt(woff.get(), task->sfntData);
+        task->conversionTime = monotonicallyIncreasingTime() - startTime;
+
+        callOnMainThread([task] {
+            std::unique_ptr<WOFFConversionTask> completedTask(task);
+            CachedFont& font = *completedTask->font;
+            LOG(Fonts, "CachedFont %p converted %zu bytes of WOFF data from %s in %.2fms", &font, completedTask->woffBuffer->size(), font.url().string().utf8().data(), completedTask->conversionTime * 1000);
+
+            // The load may have been restarted or failed while the conversion was running.
+            if (!font.isLoading() || font.m_data != completedTask->woffBuffer)
+                return;
+            font.didConvertWOFF(WTF::move(completedTask->sfntData), completedTask->succeeded);
+        });
+    });
+}
+
+void CachedFont::didConvertWOFF(Vector<char>&& sfnt, bool succeeded)
+{
+    if (succeeded)
+        m_convertedWOFFData = SharedBuffer::adoptVector(sfnt);
+    else
+        setStatus(DecodeError);
+
     setLoading(false);
     checkNotify();
 }
@@ -103,7 +175,9 @@ bool CachedFont::ensureCustomFontData(SharedBuffer* data)
         RefPtr<SharedBuffer> buffer(data);
 
 #if (!PLATFORM(MAC) || __MAC_OS_X_VERSION_MIN_REQUIRED <= 1090) && !PLATFORM(IOS)
-        if (isWOFF(buffer.get())) {
+        if (m_convertedWOFFData && data == m_data)
+            buffer = WTF::move(m_convertedWOFFData);
+        else if (isWOFF(buffer.get())) {
             Vector<char> convertedFont;
             if (!convertWOFFToSfnt(buffer.get(), convertedFont))
                 buffer = nullptr;
@@ -69,7 +69,12 @@ private:
 
     virtual void allClientsRemoved() override;
 
+    void convertWOFFInBackground();
+    void didConvertWOFF(Vector<char>&& sfnt, bool succeeded);
+
     std::unique_ptr<FontCustomPlatformData> m_fontCustomPlatformData;
+    // The sfnt data converted from a WOFF file off the main thread, until ensureCustomFontData() uses it.
+    RefPtr<SharedBuffer> m_convertedWOFFData;
     bool m_loadInitiated;
     bool m_hasCreatedFontDataWrappingResource;
 
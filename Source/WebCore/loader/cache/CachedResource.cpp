@@ -119,6 +119,7 @@ CachedResource::CachedResource(const ResourceRequest& request, Type type, Sessio
     , m_responseTimestamp(std::chrono::system_clock::now())
     , m_lastDecodedAccessTime(0)
     , m_loadFinishTime(0)
+    , m_decodeTime(0)
     , m_encodedSize(0)
     , m_decodedSize(0)
     , m_accessCount(0)
@@ -513,6 +514,21 @@ bool CachedResource::deleteIfPossible()
     return false;
 }
 
+void CachedResource::setDecodeTime(double decodeTime)
+{
+    if (decodeTime == m_decodeTime)
+        return;
+
+    // The decode time is part of the cost used to pick the LRU list, so move the resource like setDecodedSize() does.
+    if (inCache())
+        MemoryCache::singleton().removeFromLRUList(*this);
+
+    m_decodeTime = decodeTime;
+
+    if (inCache())
+        MemoryCache::singleton().insertInLRUList(*this);
+}
+
 void CachedResource::setDecodedSize(unsigned size)
 {
     if (size == m_decodedSize)
@@ -753,6 +769,16 @@ void CachedResource::setLoadPriority(const Optional<ResourceLoadPriority>& loadP
         m_loadPriority = defaultPriorityForResourceType(type());
 }
 
+void CachedResource::raiseLoadPriority(ResourceLoadPriority loadPriority)
+{
+    if (loadPriority <= m_loadPriority)
+        return;
+    m_loadPriority = loadPriority;
+
+    if (m_loader && isLoading())
+        platformStrategies()->loaderStrategy()->resourceLoadScheduler()->setPriority(m_loader.get(), loadPriority);
+}
+
 inline CachedResource::Callback::Callback(CachedResource& resource, CachedResourceClient& client)
     : m_resource(resource)
     , m_client(client)
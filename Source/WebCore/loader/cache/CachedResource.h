@@ -118,6 +118,8 @@ public:
     
     ResourceLoadPriority loadPriority() const { return m_loadPriority; }
     void setLoadPriority(const Optional<ResourceLoadPriority>&);
+    // Moves a pending load ahead, for example when the resource turns out to be visible.
+    void raiseLoadPriority(ResourceLoadPriority);
 
     WEBCORE_EXPORT void addClient(CachedResourceClient*);
     WEBCORE_EXPORT void removeClient(CachedResourceClient*);
@@ -147,6 +149,9 @@ public:
     unsigned encodedSize() const { return m_encodedSize; }
     unsigned decodedSize() const { return m_decodedSize; }
     unsigned overheadSize() const;
+    // Time, in seconds, it took to produce the decoded data the last time. MemoryCache uses it to
+    // keep resources that are expensive to re-create around longer than their size alone would.
+    double decodeTime() const { return m_decodeTime; }
 
     virtual bool decodedDataIsPurgeable() const { return false; }
     
@@ -265,6 +270,7 @@ public:
 protected:
     void setEncodedSize(unsigned);
     void setDecodedSize(unsigned);
+    void setDecodeTime(double);
     void didAccessDecodedData(double timeStamp);
 
     // FIXME: Make the rest of these data members private and use functions in derived classes instead.
@@ -304,6 +310,7 @@ private:
 
     double m_lastDecodedAccessTime; // Used as a "thrash guard" in the cache
     double m_loadFinishTime;
+    double m_decodeTime;
 
     unsigned m_encodedSize;
     unsigned m_decodedSize;
@@ -185,7 +185,9 @@ CachedResourceHandle<CachedImage> CachedResourceLoader::requestImage(CachedResou
         }
     }
     
-    request.setDefer(clientDefersImage(request.resourceRequest().url()) ? CachedResourceRequest::DeferredByClient : CachedResourceRequest::NoDefer);
+    // The caller may already have deferred the load, e.g. for an image that is far offscreen.
+    if (clientDefersImage(request.resourceRequest().url()))
+        request.setDefer(CachedResourceRequest::DeferredByClient);
     return downcast<CachedImage>(requestResource(CachedResource::ImageResource, request).get());
 }
 
@@ -1035,6 +1037,8 @@ void CachedResourceLoader::requestPreload(CachedResource::Type type, CachedResou
 
     request.setCharset(encoding);
     request.setForPreload(true);
+    // Lets the network cache remember what the preload scanner found, so the next load of this page can fetch it early.
+    request.mutableResourceRequest().setRequester(ResourceRequest::Requester::Preload);
 
     CachedResourceHandle<CachedResource> resource = requestResource(type, request);
     if (!resource || (m_preloads && m_preloads->contains(resource.get())))
@@ -81,7 +81,7 @@ bool CachedSVGFont::ensureCustomFontData(bool externalSVG, const AtomicString& r
     if (!m_externalSVGDocument && !errorOccurred() && !isLoading() && m_data) {
         m_externalSVGDocument = SVGDocument::create(nullptr, URL());
         RefPtr<TextResourceDecoder> decoder = TextResourceDecoder::create("application/xml");
-        m_externalSVGDocument->setContent(decoder->decodeAndFlush(m_data->data(), m_data->size()));
+        m_externalSVGDocument->setContent(decoder->decodeAndFlush(*m_data));
 #if !ENABLE(SVG_OTF_CONVERTER)
         if (decoder->sawError())
             m_externalSVGDocument = nullptr;
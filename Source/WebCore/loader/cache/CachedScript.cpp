@@ -36,6 +36,7 @@
 #include "RuntimeApplicationChecks.h"
 #include "SharedBuffer.h"
 #include "TextResourceDecoder.h"
+#include <wtf/CurrentTime.h>
 #include <wtf/Vector.h>
 
 namespace WebCore {
@@ -66,13 +67,15 @@ String CachedScript::encoding() const
 
 String CachedScript::mimeType() const
 {
-    return extractMIMETypeFromMediaType(m_response.httpHeaderField(HTTPHeaderName::ContentType)).lower();
+    return m_response.contentTypeHeaderMIMEType().lower();
 }
 
 const String& CachedScript::script()
 {
     if (!m_script && m_data) {
-        m_script = m_decoder->decodeAndFlush(m_data->data(), encodedSize());
+        double startTime = monotonicallyIncreasingTime();
+        m_script = m_decoder->decodeAndFlush(*m_data);
+        setDecodeTime(monotonicallyIncreasingTime() - startTime);
         setDecodedSize(m_script.sizeInBytes());
     }
     m_decodedDataDeletionTimer.restart();
@@ -52,6 +52,27 @@ static const int cDefaultCacheCapacity = 8192 * 1024;
 static const double cMinDelayBeforeLiveDecodedPrune = 1; // Seconds.
 static const float cTargetPrunePercentage = .95f; // Percentage of capacity toward which we prune, to avoid immediately pruning again.
 static const auto defaultDecodedDataDeletionInterval = std::chrono::seconds { 0 };
+static const unsigned cMaxRecreationCostFactor = 64;
+static const unsigned cOriginDeadBudgetDivisor = 2; // No single origin may keep more than this fraction of the dead capacity under pressure.
+
+static String originBudgetKey(CachedResource& resource)
+{
+#if ENABLE(CACHE_PARTITIONING)
+    if (!resource.cachePartition().isEmpty())
+        return resource.cachePartition();
+#endif
+    return resource.url().host();
+}
+
+// A resource that took a while to decode is worth more than its size suggests, since it
+// would have to be decoded again. Treat it as proportionally smaller when picking its LRU list.
+static unsigned recreationCostFactor(const CachedResource& resource)
+{
+    double decodeTimeInMilliseconds = resource.decodeTime() * 1000;
+    if (decodeTimeInMilliseconds >= cMaxRecreationCostFactor - 1)
+        return cMaxRecreationCostFactor;
+    return 1 + static_cast<unsigned>(decodeTimeInMilliseconds);
+}
 
 MemoryCache& MemoryCache::singleton()
 {
@@ -346,6 +367,12 @@ void MemoryCache::pruneDeadResourcesToSize(unsigned targetSize)
     if (targetSize && m_deadSize <= targetSize)
         return;
 
+    if (targetSize) {
+        pruneDeadResourcesOverOriginBudget(targetSize);
+        if (m_deadSize <= targetSize)
+            return;
+    }
+
     bool canShrinkLRULists = true;
     for (int i = m_allResources.size() - 1; i >= 0; i--) {
         LRUList& list = *m_allResources[i];
@@ -408,6 +435,53 @@ void MemoryCache::pruneDeadResourcesToSize(unsigned targetSize)
     }
 }
 
+void MemoryCache::pruneDeadResourcesOverOriginBudget(unsigned targetSize)
+{
+    unsigned originBudget = targetSize / cOriginDeadBudgetDivisor;
+
+    HashMap<String, unsigned> deadSizeByOrigin;
+    bool hasOriginOverBudget = false;
+    for (auto& list : m_allResources) {
+        for (auto* resource : *list) {
+            if (resource->hasClients())
+                continue;
+            unsigned& originSize = deadSizeByOrigin.add(originBudgetKey(*resource), 0).iterator->value;
+            originSize += resource->size();
+            if (originSize > originBudget)
+                hasOriginOverBudget = true;
+        }
+    }
+    if (!hasOriginOverBudget)
+        return;
+
+    // Evict the resources of origins over budget, starting with the lists holding the least valuable resources.
+    for (int i = m_allResources.size() - 1; i >= 0; i--) {
+        LRUList& list = *m_allResources[i];
+        auto it = list.begin();
+        while (it != list.end()) {
+            CachedResource& current = **it;
+
+            // Increment the iterator now as the call to remove() below will
+            // invalidate the current iterator.
+            ++it;
+
+            CachedResourceHandle<CachedResource> next = it != list.end() ? *it : nullptr;
+            ASSERT(!next || next->inCache());
+            if (!current.hasClients() && !current.isPreloaded() && !current.isCacheValidator()) {
+                auto originSize = deadSizeByOrigin.find(originBudgetKey(current));
+                if (originSize != deadSizeByOrigin.end() && originSize->value > originBudget) {
+                    originSize->value -= std::min(originSize->value, current.size());
+                    remove(current);
+                    if (m_deadSize <= targetSize)
+                        return;
+                }
+            }
+            if (next && !next->inCache())
+                break;
+        }
+    }
+}
+
 void MemoryCache::setCapacities(unsigned minDeadBytes, unsigned maxDeadBytes, unsigned totalBytes)
 {
     ASSERT(minDeadBytes <= maxDeadBytes);
@@ -453,7 +527,7 @@ void MemoryCache::remove(CachedResource& resource)
 auto MemoryCache::lruListFor(CachedResource& resource) -> LRUList&
 {
     unsigned accessCount = std::max(resource.accessCount(), 1U);
-    unsigned queueIndex = WTF::fastLog2(resource.size() / accessCount);
+    unsigned queueIndex = WTF::fastLog2(resource.size() / (accessCount * recreationCostFactor(resource)));
 #ifndef NDEBUG
     resource.m_lruIndex = queueIndex;
 #endif
@@ -782,18 +856,41 @@ void MemoryCache::dumpStats()
     printf("%-13s %13d %13d %13d %13d\n", "JavaScript", s.scripts.count, s.scripts.size, s.scripts.liveSize, s.scripts.decodedSize);
     printf("%-13s %13d %13d %13d %13d\n", "Fonts", s.fonts.count, s.fonts.size, s.fonts.liveSize, s.fonts.decodedSize);
     printf("%-13s %-13s %-13s %-13s %-13s\n\n", "-------------", "-------------", "-------------", "-------------", "-------------");
+
+    struct OriginStatistic {
+        int count { 0 };
+        int size { 0 };
+        int deadSize { 0 };
+        double decodeTime { 0 };
+    };
+    HashMap<String, OriginStatistic> originStatistics;
+    for (auto& list : m_allResources) {
+        for (auto* resource : *list) {
+            auto& statistic = originStatistics.add(originBudgetKey(*resource), OriginStatistic()).iterator->value;
+            statistic.count++;
+            statistic.size += resource->size();
+            if (!resource->hasClients())
+                statistic.deadSize += resource->size();
+            statistic.decodeTime += resource->decodeTime();
+        }
+    }
+    printf("Dead size budget per origin: %u\n", deadCapacity() / cOriginDeadBudgetDivisor);
+    printf("%-40s %-13s %-13s %-13s %-13s\n", "Origin", "Count", "Size", "DeadSize", "DecodeTime");
+    for (auto& origin : originStatistics)
+        printf("%-40s %13d %13d %13d %11.1fms\n", origin.key.utf8().data(), origin.value.count, origin.value.size, origin.value.deadSize, origin.value.decodeTime * 1000);
+    printf("\n");
 }
 
 void MemoryCache::dumpLRULists(bool includeLive) const
 {
-    printf("LRU-SP lists in eviction order (Kilobytes decoded, Kilobytes encoded, Access count, Referenced):\n");
+    printf("LRU-SP lists in eviction order (Kilobytes decoded, Kilobytes encoded, Access count, Decode time, Referenced):\n");
 
     int size = m_allResources.size();
     for (int i = size - 1; i >= 0; i--) {
         printf("\n\nList %d: ", i);
         for (auto* resource : *m_allResources[i]) {
             if (includeLive || !resource->hasClients())
-                printf("(%.1fK, %.1fK, %uA, %dR); ", resource->decodedSize() / 1024.0f, (resource->encodedSize() + resource->overheadSize()) / 1024.0f, resource->accessCount(), resource->hasClients());
+                printf("(%.1fK, %.1fK, %uA, %.1fms, %dR); ", resource->decodedSize() / 1024.0f, (resource->encodedSize() + resource->overheadSize()) / 1024.0f, resource->accessCount(), resource->decodeTime() * 1000, resource->hasClients());
         }
     }
 }
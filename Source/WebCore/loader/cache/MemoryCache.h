@@ -188,6 +188,8 @@ private:
     unsigned deadCapacity() const;
     bool needsPruning() const;
 
+    void pruneDeadResourcesOverOriginBudget(unsigned targetSize);
+
     CachedResource* resourceForRequestImpl(const ResourceRequest&, CachedResourceMap&);
 
     CachedResourceMap& ensureSessionResourceMap(SessionID);
@@ -297,6 +297,10 @@ public:
     virtual RefPtr<DisplayRefreshMonitor> createDisplayRefreshMonitor(PlatformDisplayID) const { return nullptr; }
 #endif
 
+    // Whether user input has arrived that the main thread has not handled yet. Long running
+    // main thread work, like the HTML parser, yields early when this returns true.
+    virtual bool hasPendingUserInput() const { return false; }
+
     // Pass 0 as the GraphicsLayer to detatch the root layer.
     virtual void attachRootGraphicsLayer(Frame*, GraphicsLayer*) = 0;
     virtual void attachViewOverlayGraphicsLayer(Frame*, GraphicsLayer*) = 0;
@@ -27,6 +27,7 @@
 #include "config.h"
 #include "DOMTimer.h"
 
+#include "Document.h"
 #include "HTMLPlugInElement.h"
 #include "InspectorInstrumentation.h"
 #include "Logging.h"
@@ -35,6 +36,8 @@
 #include "ScheduledAction.h"
 #include "ScriptExecutionContext.h"
 #include "Settings.h"
+#include "ThreadGlobalData.h"
+#include "ThreadTimers.h"
 #include "UserGestureIndicator.h"
 #include <wtf/CurrentTime.h>
 #include <wtf/HashMap.h>
@@ -306,6 +309,11 @@ void DOMTimer::fired()
 #endif
     context.setTimerNestingLevel(std::min(m_nestingLevel + 1, maxTimerNestingLevel));
 
+    if (is<Document>(context)) {
+        if (Page* page = downcast<Document>(context).page())
+            page->didFireDOMTimer(threadGlobalData().threadTimers().wakeUpCount());
+    }
+
     ASSERT(!isSuspended());
     ASSERT(!context.activeDOMObjectsAreSuspended());
     UserGestureIndicator gestureIndicator(m_shouldForwardUserGesture ? DefinitelyProcessingUserGesture : PossiblyProcessingUserGesture);
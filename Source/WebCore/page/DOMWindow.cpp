@@ -50,6 +50,7 @@
 #include "DOMWindowNotifications.h"
 #include "DeviceMotionController.h"
 #include "DeviceOrientationController.h"
+#include "Dictionary.h"
 #include "Document.h"
 #include "DocumentLoader.h"
 #include "Editor.h"
@@ -125,6 +126,7 @@
 #endif
 
 #if ENABLE(REQUEST_ANIMATION_FRAME)
+#include "IdleRequestCallback.h"
 #include "RequestAnimationFrameCallback.h"
 #endif
 
@@ -1668,6 +1670,21 @@ void DOMWindow::cancelAnimationFrame(int id)
     if (Document* d = document())
         d->cancelAnimationFrame(id);
 }
+
+int DOMWindow::requestIdleCallback(PassRefPtr<IdleRequestCallback> callback, const Dictionary& options)
+{
+    double timeout = 0;
+    options.get("timeout", timeout);
+    if (Document* d = document())
+        return d->requestIdleCallback(callback, timeout);
+    return 0;
+}
+
+void DOMWindow::cancelIdleCallback(int id)
+{
+    if (Document* d = document())
+        d->cancelIdleCallback(id);
+}
 #endif
 
 DOMWindowCSS* DOMWindow::css()
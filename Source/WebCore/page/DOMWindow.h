@@ -55,6 +55,7 @@ namespace WebCore {
     class Database;
     class DatabaseCallback;
     class Document;
+    class Dictionary;
     class Element;
     class EventListener;
     class FloatRect;
@@ -80,6 +81,7 @@ namespace WebCore {
     class WebKitPoint;
 
 #if ENABLE(REQUEST_ANIMATION_FRAME)
+    class IdleRequestCallback;
     class RequestAnimationFrameCallback;
 #endif
 
@@ -267,6 +269,8 @@ namespace WebCore {
         int requestAnimationFrame(PassRefPtr<RequestAnimationFrameCallback>);
         int webkitRequestAnimationFrame(PassRefPtr<RequestAnimationFrameCallback>);
         void cancelAnimationFrame(int id);
+        int requestIdleCallback(PassRefPtr<IdleRequestCallback>, const Dictionary& options);
+        void cancelIdleCallback(int id);
 #endif
 
         DOMWindowCSS* css();
@@ -30,6 +30,7 @@
 #include "AXObjectCache.h"
 #include "AnimationController.h"
 #include "BackForwardController.h"
+#include "BitmapImage.h"
 #include "CachedImage.h"
 #include "CachedResourceLoader.h"
 #include "Chrome.h"
@@ -94,6 +95,7 @@
 #include <wtf/CurrentTime.h>
 #include <wtf/Ref.h>
 #include <wtf/TemporaryChange.h>
+#include <wtf/TraceEvent.h>
 
 #if USE(COORDINATED_GRAPHICS)
 #include "TiledBackingStore.h"
@@ -1231,6 +1233,7 @@ inline void FrameView::forceLayoutParentViewIfNeeded()
 
 void FrameView::layout(bool allowSubtree)
 {
+    TraceScope traceScope(TraceCategory::Layout, "FrameView::layout");
     LOG(Layout, "FrameView %p (%dx%d) layout, main frameview %d, allowSubtree=%d", this, size().width(), size().height(), frame().isMainFrame(), allowSubtree);
     if (isInLayout()) {
         LOG(Layout, "  in layout, bailing");
@@ -1424,6 +1427,12 @@ void FrameView::layout(bool allowSubtree)
 
         ASSERT(m_layoutPhase == InLayout);
 
+        // FIXME: This always runs to completion. Yielding below the viewport and resuming later would need
+        // every container to be able to pick up its child loop where it stopped. RenderBlockFlow keeps its
+        // margin collapsing, float and pagination state in locals and LayoutState, RenderTableSection sizes
+        // all rows before it positions any of them, and RenderGrid sizes its tracks from every item. Until
+        // then, the document height, scroll offsets, hit testing and painting all need a renderer tree
+        // with no layout bits set when this returns.
         root->layout();
 #if ENABLE(IOS_TEXT_AUTOSIZING)
         if (Page* page = frame().page()) {
@@ -1883,10 +1892,12 @@ void FrameView::viewportContentsChanged()
     }
 
     // When the viewport contents changes (scroll, resize, style recalc, layout, ...),
-    // check if we should resume animated images or unthrottle DOM timers.
+    // check if we should resume animated images, unthrottle DOM timers or start deferred loads.
     applyRecursivelyWithVisibleRect([] (FrameView& frameView, const IntRect& visibleRect) {
         frameView.resumeVisibleImageAnimations(visibleRect);
         frameView.updateScriptedAnimationsAndTimersThrottlingState(visibleRect);
+        if (auto* document = frameView.frame().document())
+            document->startDeferredLoadsNearViewport(visibleRect);
     });
 }
 
@@ -4019,6 +4030,7 @@ void FrameView::didPaintContents(GraphicsContext& context, const IntRect& dirtyR
 
 void FrameView::paintContents(GraphicsContext& context, const IntRect& dirtyRect)
 {
+    TraceScope traceScope(TraceCategory::Paint, "FrameView::paintContents");
 #ifndef NDEBUG
     bool fillWithRed;
     if (frame().document()->printing())
@@ -4069,10 +4081,17 @@ void FrameView::paintContents(GraphicsContext& context, const IntRect& dirtyRect
     while (is<RenderInline>(renderer) && !downcast<RenderInline>(*renderer).firstLineBox())
         renderer = renderer->parent();
 
+    // Snapshots and printed pages are never repainted, so they can't wait for images to decode.
+    bool wasAllowingAsynchronousImageDecoding = context.allowsAsynchronousImageDecoding();
+    if (!frame().document()->printing() && !m_nodeToDraw && !(m_paintBehavior & (PaintBehaviorFlattenCompositingLayers | PaintBehaviorSelectionOnly)))
+        context.setAllowsAsynchronousImageDecoding(BitmapImage::asynchronousDecodingEnabled());
+
     rootLayer->paint(context, dirtyRect, LayoutSize(), m_paintBehavior, renderer);
     if (rootLayer->containsDirtyOverlayScrollbars())
         rootLayer->paintOverlayScrollbars(context, dirtyRect, m_paintBehavior, renderer);
 
+    context.setAllowsAsynchronousImageDecoding(wasAllowingAsynchronousImageDecoding);
+
     didPaintContents(context, dirtyRect, paintingState);
 }
 
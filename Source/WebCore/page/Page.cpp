@@ -1629,6 +1629,15 @@ bool Page::arePromptsAllowed()
     return !m_forbidPromptsDepth;
 }
 
+void Page::didFireDOMTimer(unsigned threadTimersWakeUpCount)
+{
+    ++m_domTimerFireCount;
+    if (m_lastDOMTimerWakeUpID == threadTimersWakeUpCount)
+        return;
+    m_lastDOMTimerWakeUpID = threadTimersWakeUpCount;
+    ++m_domTimerWakeUpCount;
+}
+
 void Page::setUserContentController(UserContentController* userContentController)
 {
     if (m_userContentController)
@@ -427,6 +427,11 @@ public:
     void allowPrompts();
     bool arePromptsAllowed();
 
+    // Timer wake-ups are counted once per batch of timers fired by the thread, however many of this page's timers ran in it.
+    void didFireDOMTimer(unsigned threadTimersWakeUpCount);
+    unsigned domTimerFireCount() const { return m_domTimerFireCount; }
+    unsigned domTimerWakeUpCount() const { return m_domTimerWakeUpCount; }
+
     void setLastSpatialNavigationCandidateCount(unsigned count) { m_lastSpatialNavigationCandidatesCount = count; }
     unsigned lastSpatialNavigationCandidateCount() const { return m_lastSpatialNavigationCandidatesCount; }
 
@@ -655,6 +660,10 @@ private:
     
     bool m_allowsMediaDocumentInlinePlayback { false };
     bool m_showAllPlugins { false };
+
+    unsigned m_domTimerFireCount { 0 };
+    unsigned m_domTimerWakeUpCount { 0 };
+    unsigned m_lastDOMTimerWakeUpID { 0 };
 };
 
 inline PageGroup& Page::group()
@@ -28,6 +28,7 @@
 
 #include "AudioSession.h"
 #include "BackForwardController.h"
+#include "BitmapImage.h"
 #include "CachedResourceLoader.h"
 #include "CookieStorage.h"
 #include "DOMTimer.h"
@@ -634,6 +635,16 @@ bool Settings::shouldRespectPriorityInCSSAttributeSetters()
     return gShouldRespectPriorityInCSSAttributeSetters;
 }
 
+void Settings::setAsynchronousImageDecodingEnabled(bool flag)
+{
+    BitmapImage::setAsynchronousDecodingEnabled(flag);
+}
+
+bool Settings::asynchronousImageDecodingEnabled()
+{
+    return BitmapImage::asynchronousDecodingEnabled();
+}
+
 #if ENABLE(HIDDEN_PAGE_DOM_TIMER_THROTTLING)
 void Settings::setHiddenPageDOMTimerThrottlingEnabled(bool flag)
 {
@@ -259,6 +259,8 @@ void AnimationControllerPrivate::animationTimerFired()
     // We need to keep the frame alive, since it owns us.
     Ref<Frame> protector(m_frame);
 
+    ++m_animationTimerWakeUpCount;
+
     // Make sure animationUpdateTime is updated, so that it is current even if no
     // styleChange has happened (e.g. accelerated animations)
     AnimationPrivateUpdateBlock updateBlock(*this);
@@ -718,6 +720,18 @@ void AnimationController::serviceAnimations()
 }
 #endif
 
+void AnimationController::animationIterationListenerAdded()
+{
+    // Accelerated animations skip servicing at iteration boundaries while nobody listens for them.
+    if (m_data->hasAnimations())
+        m_data->updateAnimationTimer();
+}
+
+unsigned AnimationController::animationTimerWakeUpCount() const
+{
+    return m_data->animationTimerWakeUpCount();
+}
+
 void AnimationController::suspendAnimationsForDocument(Document* document)
 {
     LOG(Animations, "suspending animations for document %p", document);
@@ -75,6 +75,11 @@ public:
     void serviceAnimations();
 #endif
 
+    void animationIterationListenerAdded();
+
+    // Number of times the animation timer woke up the main thread to service animations.
+    WEBCORE_EXPORT unsigned animationTimerWakeUpCount() const;
+
     void suspendAnimationsForDocument(Document*);
     void resumeAnimationsForDocument(Document*);
     void startAnimationsIfNotSuspended(Document*);
@@ -117,6 +117,8 @@ public:
     bool allowsNewAnimationsWhileSuspended() const { return m_allowsNewAnimationsWhileSuspended; }
     void setAllowsNewAnimationsWhileSuspended(bool);
 
+    unsigned animationTimerWakeUpCount() const { return m_animationTimerWakeUpCount; }
+
 #if ENABLE(CSS_ANIMATIONS_LEVEL_2)
     bool wantsScrollUpdates() const { return !m_animationsDependentOnScroll.isEmpty(); }
     void addToAnimationsDependentOnScroll(AnimationBase*);
@@ -165,6 +167,8 @@ private:
     // run even when this object is suspended.
     bool m_allowsNewAnimationsWhileSuspended;
 
+    unsigned m_animationTimerWakeUpCount { 0 };
+
 #if ENABLE(CSS_ANIMATIONS_LEVEL_2)
     AnimationsSet m_animationsDependentOnScroll;
     float m_scrollPosition { 0 };
@@ -498,6 +498,14 @@ double KeyframeAnimation::timeToNextService()
     if (acceleratedPropertiesOnly) {
         bool isLooping;
         getTimeToNextEvent(t, isLooping);
+
+        // The compositor runs every iteration by itself, the main thread only needs to be woken up at iteration
+        // boundaries to dispatch animationiteration events. Without listeners, wait for the end of the animation.
+        if (isLooping && !shouldSendEventForListener(Document::ANIMATIONITERATION_LISTENER)) {
+            if (m_totalDuration < 0)
+                return -1;
+            t = std::max(m_totalDuration - (beginAnimationUpdateTime() - m_startTime), 0.0);
+        }
     }
 
     return t;
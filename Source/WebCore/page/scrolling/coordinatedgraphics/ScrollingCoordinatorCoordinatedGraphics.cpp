@@ -29,6 +29,8 @@
 
 #include "ScrollingCoordinatorCoordinatedGraphics.h"
 
+#include "Chrome.h"
+#include "ChromeClient.h"
 #include "CoordinatedGraphicsLayer.h"
 #include "FrameView.h"
 #include "HostWindow.h"
@@ -65,12 +67,20 @@ void ScrollingCoordinatorCoordinatedGraphics::detachFromStateTree(ScrollingNodeI
     if (node && node->nodeType() == FixedNode)
         toCoordinatedGraphicsLayer(node->layer())->setFixedToViewport(false);
 
+    if (m_stickyNodes.remove(nodeID))
+        m_threadedScrollingStateChanged = true;
+
     m_scrollingStateTree->detachNode(nodeID);
 }
 
 void ScrollingCoordinatorCoordinatedGraphics::clearStateTree()
 {
     m_scrollingStateTree->clear();
+
+    if (!m_stickyNodes.isEmpty()) {
+        m_stickyNodes.clear();
+        m_threadedScrollingStateChanged = true;
+    }
 }
 
 void ScrollingCoordinatorCoordinatedGraphics::updateViewportConstrainedNode(ScrollingNodeID nodeID, const ViewportConstraints& constraints, GraphicsLayer* graphicsLayer)
@@ -88,7 +98,10 @@ void ScrollingCoordinatorCoordinatedGraphics::updateViewportConstrainedNode(Scro
         break;
     }
     case ViewportConstraints::StickyPositionConstraint:
-        break; // FIXME : Support sticky elements.
+        // FIXME : Support sticky elements.
+        if (m_stickyNodes.add(nodeID).isNewEntry)
+            m_threadedScrollingStateChanged = true;
+        break;
     default:
         ASSERT_NOT_REACHED();
     }
@@ -121,6 +134,39 @@ bool ScrollingCoordinatorCoordinatedGraphics::requestScrollPositionUpdate(FrameV
     return true;
 }
 
+void ScrollingCoordinatorCoordinatedGraphics::frameViewLayoutUpdated(FrameView&)
+{
+    // Layout moves the scrollable areas and the wheel event handlers of all the frames in the region.
+    m_threadedScrollingStateChanged = true;
+}
+
+void ScrollingCoordinatorCoordinatedGraphics::frameViewNonFastScrollableRegionChanged(FrameView&)
+{
+    m_threadedScrollingStateChanged = true;
+
+    // Adding a wheel event handler doesn't necessarily lead to a layer flush, which is when the
+    // threaded compositor picks up the new region.
+    if (m_page)
+        m_page->chrome().client().scheduleCompositingLayerFlush();
+}
+
+void ScrollingCoordinatorCoordinatedGraphics::setSynchronousScrollingReasons(SynchronousScrollingReasons)
+{
+    m_threadedScrollingStateChanged = true;
+}
+
+bool ScrollingCoordinatorCoordinatedGraphics::updateThreadedScrollingState(Region& nonFastScrollableRegion, bool& mustScrollOnMainThread)
+{
+    ASSERT(m_page);
+    if (!m_threadedScrollingStateChanged)
+        return false;
+
+    m_threadedScrollingStateChanged = false;
+    nonFastScrollableRegion = absoluteNonFastScrollableRegion();
+    mustScrollOnMainThread = shouldUpdateScrollLayerPositionSynchronously() || !m_stickyNodes.isEmpty();
+    return true;
+}
+
 } // namespace WebCore
 
 #endif // USE(COORDINATED_GRAPHICS)
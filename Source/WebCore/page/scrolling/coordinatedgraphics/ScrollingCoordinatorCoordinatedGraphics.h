@@ -28,7 +28,9 @@
 
 #if USE(COORDINATED_GRAPHICS)
 
+#include "Region.h"
 #include "ScrollingCoordinator.h"
+#include <wtf/HashSet.h>
 
 namespace WebCore {
 
@@ -52,8 +54,22 @@ public:
 
     virtual bool requestScrollPositionUpdate(FrameView&, const IntPoint&) override;
 
+    virtual void frameViewLayoutUpdated(FrameView&) override;
+    virtual void frameViewNonFastScrollableRegionChanged(FrameView&) override;
+
+    // A threaded compositor can scroll the main frame by itself when a wheel event lands outside of the
+    // non-fast scrollable region and nothing on the page has to be repositioned by the main thread while
+    // scrolling. Returns false if neither changed since the last call.
+    WEBCORE_EXPORT bool updateThreadedScrollingState(Region& nonFastScrollableRegion, bool& mustScrollOnMainThread);
+
 private:
+    virtual void setSynchronousScrollingReasons(SynchronousScrollingReasons) override;
+
     std::unique_ptr<ScrollingStateTree> m_scrollingStateTree;
+
+    // The compositor only keeps fixed layers in place, so sticky ones need the main thread to scroll.
+    HashSet<ScrollingNodeID> m_stickyNodes;
+    bool m_threadedScrollingStateChanged { true };
 };
 
 } // namespace WebCore
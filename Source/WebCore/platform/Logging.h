@@ -53,6 +53,7 @@ namespace WebCore {
     M(Events) \
     M(FTP) \
     M(FileAPI) \
+    M(Fonts) \
     M(Frames) \
     M(Fullscreen) \
     M(Gamepad) \
@@ -68,6 +69,7 @@ namespace WebCore {
     M(Network) \
     M(NotYetImplemented) \
     M(PageCache) \
+    M(Parsing) \
     M(PlatformLeaks) \
     M(Plugins) \
     M(PopupBlocking) \
@@ -79,6 +81,7 @@ namespace WebCore {
     M(Services) \
     M(SpellingAndGrammar) \
     M(StorageAPI) \
+    M(StyleInvalidation) \
     M(Threading) \
     M(WebAudio) \
     M(WebGL) \
@@ -36,7 +36,9 @@
 #include "MemoryCache.h"
 #include "Page.h"
 #include "PageCache.h"
+#include "RenderStyle.h"
 #include "ScrollingThread.h"
+#include "ShadowBlur.h"
 #include "StyledElement.h"
 #include "WorkerThread.h"
 #include <JavaScriptCore/IncrementalSweeper.h>
@@ -44,6 +46,10 @@
 #include <wtf/FastMalloc.h>
 #include <wtf/StdLibExtras.h>
 
+#if USE(HARFBUZZ)
+#include "HarfBuzzShapeCache.h"
+#endif
+
 namespace WebCore {
 
 WEBCORE_EXPORT bool MemoryPressureHandler::ReliefLogger::s_loggingEnabled = false;
@@ -74,6 +80,12 @@ MemoryPressureHandler::MemoryPressureHandler()
 {
 }
 
+void MemoryPressureHandler::setUnderMemoryPressure(bool underMemoryPressure)
+{
+    m_underMemoryPressure = underMemoryPressure;
+    WTF::setFastMallocIsUnderMemoryPressure(underMemoryPressure);
+}
+
 void MemoryPressureHandler::releaseNoncriticalMemory()
 {
     {
@@ -106,6 +118,23 @@ void MemoryPressureHandler::releaseNoncriticalMemory()
         ReliefLogger log("Prune presentation attribute cache");
         StyledElement::clearPresentationAttributeCache();
     }
+
+    {
+        ReliefLogger log("Clear shared RenderStyle data");
+        RenderStyle::clearSharedRareData();
+    }
+
+    {
+        ReliefLogger log("Clear shadow template cache");
+        ShadowBlur::clearTemplateCache();
+    }
+
+#if USE(HARFBUZZ)
+    {
+        ReliefLogger log("Clear HarfBuzz shape cache");
+        HarfBuzzShapeCache::singleton().clear();
+    }
+#endif
 }
 
 void MemoryPressureHandler::releaseCriticalMemory(Synchronous synchronous)
@@ -70,7 +70,7 @@ public:
     }
 
     bool isUnderMemoryPressure() const { return m_underMemoryPressure; }
-    void setUnderMemoryPressure(bool b) { m_underMemoryPressure = b; }
+    void setUnderMemoryPressure(bool);
 
 #if PLATFORM(IOS)
     // FIXME: Can we share more of this with OpenSource?
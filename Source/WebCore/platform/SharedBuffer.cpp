@@ -29,10 +29,13 @@
 #include "SharedBuffer.h"
 
 #include <algorithm>
+#include <atomic>
 #include <wtf/unicode/UTF8.h>
 
 namespace WebCore {
 
+static std::atomic<uint64_t> flattenedBytes;
+
 #if !USE(NETWORK_CFDATA_ARRAY_CALLBACK)
 
 static const unsigned segmentSize = 0x1000;
@@ -145,12 +148,11 @@ PassRefPtr<ArrayBuffer> SharedBuffer::createArrayBuffer() const
 {
     RefPtr<ArrayBuffer> arrayBuffer = ArrayBuffer::createUninitialized(static_cast<unsigned>(size()), sizeof(char));
 
-    const char* segment = 0;
     unsigned position = 0;
-    while (unsigned segmentSize = getSomeData(segment, position)) {
+    forEachSegment([&arrayBuffer, &position](const char* segment, unsigned segmentSize) {
         memcpy(static_cast<char*>(arrayBuffer->data()) + position, segment, segmentSize);
         position += segmentSize;
-    }
+    });
 
     if (position != arrayBuffer->byteLength()) {
         ASSERT_NOT_REACHED();
@@ -325,10 +327,16 @@ const Vector<char>& SharedBuffer::buffer() const
         duplicateDataBufferIfNecessary();
         m_buffer->data.resize(m_size);
         copyBufferAndClear(m_buffer->data.data() + bufferSize, m_size - bufferSize);
+        flattenedBytes += m_size - bufferSize;
     }
     return m_buffer->data;
 }
 
+uint64_t SharedBuffer::flattenedByteCount()
+{
+    return flattenedBytes;
+}
+
 unsigned SharedBuffer::getSomeData(const char*& someData, unsigned position) const
 {
     unsigned totalSize = size();
@@ -119,6 +119,13 @@ public:
     //      }
     WEBCORE_EXPORT unsigned getSomeData(const char*& data, unsigned position = 0) const;
 
+    // Calls the functor with each run of consecutive bytes, in order, without merging
+    // segmented buffers into a flat buffer.
+    template<typename Functor> void forEachSegment(const Functor&) const;
+
+    // The number of bytes copied so far, process-wide, to merge segmented buffers into flat ones.
+    WEBCORE_EXPORT static uint64_t flattenedByteCount();
+
     void tryReplaceContentsWithPlatformBuffer(SharedBuffer&);
     WEBCORE_EXPORT bool hasPlatformData() const;
 
@@ -179,6 +186,17 @@ private:
     MappedFileData m_fileData;
 };
 
+template<typename Functor>
+inline void SharedBuffer::forEachSegment(const Functor& functor) const
+{
+    const char* segment;
+    unsigned position = 0;
+    while (unsigned length = getSomeData(segment, position)) {
+        functor(segment, length);
+        position += length;
+    }
+}
+
 PassRefPtr<SharedBuffer> utf8Buffer(const String&);
 
 } // namespace WebCore
@@ -52,6 +52,7 @@ ThreadTimers::ThreadTimers()
     : m_sharedTimer(0)
     , m_firingTimers(false)
     , m_pendingSharedTimerFireTime(0)
+    , m_wakeUpCount(0)
 {
     if (isUIThread())
         setSharedTimer(&MainThreadSharedTimer::singleton());
@@ -108,6 +109,9 @@ void ThreadTimers::sharedTimerFiredInternal()
     double fireTime = monotonicallyIncreasingTime();
     double timeToQuit = fireTime + maxDurationOfFiringTimers;
 
+    if (!m_timerHeap.isEmpty() && m_timerHeap.first()->m_nextFireTime <= fireTime)
+        ++m_wakeUpCount;
+
     while (!m_timerHeap.isEmpty() && m_timerHeap.first()->m_nextFireTime <= fireTime) {
         TimerBase* timer = m_timerHeap.first();
         timer->m_nextFireTime = 0;
@@ -50,6 +50,9 @@ namespace WebCore {
         void updateSharedTimer();
         void fireTimersInNestedEventLoop();
 
+        // Number of times the shared timer woke this thread up and found at least one timer to fire.
+        unsigned wakeUpCount() const { return m_wakeUpCount; }
+
     private:
         void sharedTimerFiredInternal();
         void fireTimersInNestedEventLoopInternal();
@@ -58,6 +61,7 @@ namespace WebCore {
         SharedTimer* m_sharedTimer; // External object, can be a run loop on a worker thread. Normally set/reset by worker thread.
         bool m_firingTimers; // Reentrancy guard.
         double m_pendingSharedTimerFireTime;
+        unsigned m_wakeUpCount;
     };
 
 }
@@ -354,20 +354,15 @@ void AudioBus::speakersSumFrom5_1_ToMono(const AudioBus& sourceBus)
 
     float* destination = channelByType(ChannelLeft)->mutableData();
 
-    AudioFloatArray temp(length());
-    float* tempData = temp.data();
-
     // Sum in L and R.
-    vadd(sourceL, 1, sourceR, 1, tempData, 1, length());
     float scale = 0.7071;
-    vsmul(tempData, 1, &scale, tempData, 1, length());
-    vadd(tempData, 1, destination, 1, destination, 1, length());
+    vsma(sourceL, 1, &scale, destination, 1, length());
+    vsma(sourceR, 1, &scale, destination, 1, length());
 
     // Sum in SL and SR.
-    vadd(sourceSL, 1, sourceSR, 1, tempData, 1, length());
     scale = 0.5;
-    vsmul(tempData, 1, &scale, tempData, 1, length());
-    vadd(tempData, 1, destination, 1, destination, 1, length());
+    vsma(sourceSL, 1, &scale, destination, 1, length());
+    vsma(sourceSR, 1, &scale, destination, 1, length());
 
     // Sum in center.
     vadd(sourceC, 1, destination, 1, destination, 1, length());
@@ -603,8 +598,9 @@ RefPtr<AudioBus> AudioBus::createByMixingToMono(const AudioBus* sourceBus)
             float* destination = destinationBus->channel(0)->mutableData();
         
             // Do the mono mixdown.
-            for (unsigned i = 0; i < n; ++i)
-                destination[i] = (sourceL[i] + sourceR[i]) / 2;
+            vadd(sourceL, 1, sourceR, 1, destination, 1, n);
+            float scale = 0.5;
+            vsmul(destination, 1, &scale, destination, 1, n);
 
             destinationBus->clearSilentFlag();
             destinationBus->setSampleRate(sourceBus->sampleRate());    
@@ -40,6 +40,7 @@
 #include "HRTFPanner.h"
 #include <algorithm>
 #include <math.h>
+#include <wtf/Lock.h>
 
 namespace WebCore {
 
@@ -63,11 +64,15 @@ const float ResponseSampleRate = 44100;
 #endif
 
 #ifdef USE_CONCATENATED_IMPULSE_RESPONSES
+static StaticLock concatenatedImpulseResponsesLock;
+
 // Lazily load a concatenated HRTF database for given subject and store it in a
 // local hash table to ensure quick efficient future retrievals.
+// Loaders for different sample rates can run at the same time, and all of them read the same resource.
 static AudioBus* getConcatenatedImpulseResponsesForSubject(const String& subjectName)
 {
     typedef HashMap<String, AudioBus*> AudioBusMap;
+    LockHolder locker(concatenatedImpulseResponsesLock);
     DEPRECATED_DEFINE_STATIC_LOCAL(AudioBusMap, audioBusMap, ());
 
     AudioBus* bus;
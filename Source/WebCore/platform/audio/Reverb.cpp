@@ -85,7 +85,7 @@ static float calculateNormalizationScale(AudioBus* response)
     return scale;
 }
 
-Reverb::Reverb(AudioBus* impulseResponse, size_t renderSliceSize, size_t maxFFTSize, size_t numberOfChannels, bool useBackgroundThreads, bool normalize)
+Reverb::Reverb(AudioBus* impulseResponse, size_t renderSliceSize, size_t maxFFTSize, size_t maxRealtimeFFTSize, size_t numberOfChannels, bool useBackgroundThreads, bool normalize)
 {
     float scale = 1;
 
@@ -96,7 +96,7 @@ Reverb::Reverb(AudioBus* impulseResponse, size_t renderSliceSize, size_t maxFFTS
             impulseResponse->scale(scale);
     }
 
-    initialize(impulseResponse, renderSliceSize, maxFFTSize, numberOfChannels, useBackgroundThreads);
+    initialize(impulseResponse, renderSliceSize, maxFFTSize, maxRealtimeFFTSize, numberOfChannels, useBackgroundThreads);
 
     // Undo scaling since this shouldn't be a destructive operation on impulseResponse.
     // FIXME: What about roundoff? Perhaps consider making a temporary scaled copy
@@ -105,7 +105,7 @@ Reverb::Reverb(AudioBus* impulseResponse, size_t renderSliceSize, size_t maxFFTS
         impulseResponse->scale(1 / scale);
 }
 
-void Reverb::initialize(AudioBus* impulseResponseBuffer, size_t renderSliceSize, size_t maxFFTSize, size_t numberOfChannels, bool useBackgroundThreads)
+void Reverb::initialize(AudioBus* impulseResponseBuffer, size_t renderSliceSize, size_t maxFFTSize, size_t maxRealtimeFFTSize, size_t numberOfChannels, bool useBackgroundThreads)
 {
     m_impulseResponseLength = impulseResponseBuffer->length();
 
@@ -117,7 +117,7 @@ void Reverb::initialize(AudioBus* impulseResponseBuffer, size_t renderSliceSize,
     for (size_t i = 0; i < numResponseChannels; ++i) {
         AudioChannel* channel = impulseResponseBuffer->channel(i);
 
-        m_convolvers.append(std::make_unique<ReverbConvolver>(channel, renderSliceSize, maxFFTSize, convolverRenderPhase, useBackgroundThreads));
+        m_convolvers.append(std::make_unique<ReverbConvolver>(channel, renderSliceSize, maxFFTSize, maxRealtimeFFTSize, convolverRenderPhase, useBackgroundThreads));
 
         convolverRenderPhase += renderSliceSize;
     }
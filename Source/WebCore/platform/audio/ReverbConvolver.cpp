@@ -52,7 +52,6 @@ const int InputBufferSize = 8 * 16384;
 const size_t RealtimeFrameLimit = 8192  + 4096; // ~278msec @ 44.1KHz
 
 const size_t MinFFTSize = 128;
-const size_t MaxRealtimeFFTSize = 2048;
 
 static void backgroundThreadEntry(void* threadData)
 {
@@ -60,22 +59,22 @@ static void backgroundThreadEntry(void* threadData)
     reverbConvolver->backgroundThreadEntry();
 }
 
-ReverbConvolver::ReverbConvolver(AudioChannel* impulseResponse, size_t renderSliceSize, size_t maxFFTSize, size_t convolverRenderPhase, bool useBackgroundThreads)
+ReverbConvolver::ReverbConvolver(AudioChannel* impulseResponse, size_t renderSliceSize, size_t maxFFTSize, size_t maxRealtimeFFTSize, size_t convolverRenderPhase, bool useBackgroundThreads)
     : m_impulseResponseLength(impulseResponse->length())
     , m_accumulationBuffer(impulseResponse->length() + renderSliceSize)
     , m_inputBuffer(InputBufferSize)
     , m_minFFTSize(MinFFTSize) // First stage will have this size - successive stages will double in size each time
     , m_maxFFTSize(maxFFTSize) // until we hit m_maxFFTSize
+    , m_maxRealtimeFFTSize(std::max(maxRealtimeFFTSize, MinFFTSize))
     , m_useBackgroundThreads(useBackgroundThreads)
     , m_backgroundThread(0)
     , m_wantsToExit(false)
     , m_moreInputBuffered(false)
 {
-    // If we are using background threads then don't exceed this FFT size for the
+    // If we are using background threads then don't exceed m_maxRealtimeFFTSize for the
     // stages which run in the real-time thread.  This avoids having only one or two
     // large stages (size 16384 or so) at the end which take a lot of time every several
     // processing slices.  This way we amortize the cost over more processing slices.
-    m_maxRealtimeFFTSize = MaxRealtimeFFTSize;
 
     // For the moment, a good way to know if we have real-time constraint is to check if we're using background threads.
     // Otherwise, assume we're being run from a command-line tool.
@@ -128,7 +127,6 @@ ReverbConvolver::ReverbConvolver(AudioChannel* impulseResponse, size_t renderSli
     }
 
     // Start up background thread
-    // FIXME: would be better to up the thread priority here.  It doesn't need to be real-time, but higher than the default...
     if (this->useBackgroundThreads() && m_backgroundStages.size() > 0)
         m_backgroundThread = createThread(WebCore::backgroundThreadEntry, this, "convolution background thread");
 }
@@ -152,6 +150,9 @@ ReverbConvolver::~ReverbConvolver()
 
 void ReverbConvolver::backgroundThreadEntry()
 {
+    // The background stages don't need real-time scheduling, but they must keep ahead of the real-time thread.
+    setCurrentThreadIsUserInitiated();
+
     while (!m_wantsToExit) {
         // Wait for realtime thread to give us more input
         m_moreInputBuffered = false;        
@@ -53,7 +53,9 @@ public:
     // For certain tweaky de-convolving applications the phase errors add up quickly and lead to non-sensical results with
     // larger FFT sizes and single-precision floats.  In these cases 2048 is a good size.
     // If not doing multi-threaded convolution, then should not go > 8192.
-    ReverbConvolver(AudioChannel* impulseResponse, size_t renderSliceSize, size_t maxFFTSize, size_t convolverRenderPhase, bool useBackgroundThreads);
+    // When using background threads, the stages processed in the real-time thread don't exceed maxRealtimeFFTSize, so that the
+    // leading part of the impulse response is split into uniform partitions whose cost is spread evenly over the render quanta.
+    ReverbConvolver(AudioChannel* impulseResponse, size_t renderSliceSize, size_t maxFFTSize, size_t maxRealtimeFFTSize, size_t convolverRenderPhase, bool useBackgroundThreads);
     ~ReverbConvolver();
 
     void process(const AudioChannel* sourceChannel, AudioChannel* destinationChannel, size_t framesToProcess);
@@ -666,8 +666,38 @@ void vclip(const float* sourceP, int sourceStride, const float* lowThresholdP, c
     float lowThreshold = *lowThresholdP;
     float highThreshold = *highThresholdP;
 
-    // FIXME: Optimize for SSE2.
-#if HAVE(ARM_NEON_INTRINSICS)
+#ifdef __SSE2__
+    if ((sourceStride == 1) && (destStride == 1)) {
+        // If the sourceP address is not 16-byte aligned, the first several frames (at most three) should be processed separately.
+        while ((reinterpret_cast<size_t>(sourceP) & 0x0F) && n) {
+            *destP = std::max(std::min(*sourceP, highThreshold), lowThreshold);
+            sourceP++;
+            destP++;
+            n--;
+        }
+
+        // Now the sourceP address is aligned and start to apply SSE.
+        int group = n / 4;
+        __m128 low = _mm_set_ps1(lowThreshold);
+        __m128 high = _mm_set_ps1(highThreshold);
+        bool destAligned = !(reinterpret_cast<size_t>(destP) & 0x0F);
+
+        while (group--) {
+            __m128 source = _mm_load_ps(sourceP);
+            __m128 dest = _mm_max_ps(_mm_min_ps(source, high), low);
+            if (destAligned)
+                _mm_store_ps(destP, dest);
+            else
+                _mm_storeu_ps(destP, dest);
+
+            sourceP += 4;
+            destP += 4;
+        }
+
+        // Non-SSE handling for remaining frames which is less than 4.
+        n %= 4;
+    }
+#elif HAVE(ARM_NEON_INTRINSICS)
     if ((sourceStride == 1) && (destStride == 1)) {
         int tailFrames = n % 4;
         const float* endP = destP + n - tailFrames;
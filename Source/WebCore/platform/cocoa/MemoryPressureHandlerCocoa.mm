@@ -253,7 +253,7 @@ void MemoryPressureHandler::installMemoryReleaseBlock(void (^releaseMemoryBlock)
 
 void MemoryPressureHandler::setReceivedMemoryPressure(MemoryPressureReason reason)
 {
-    m_underMemoryPressure = true;
+    setUnderMemoryPressure(true);
 
     {
         LockHolder locker(m_observerMutex);
@@ -269,7 +269,7 @@ void MemoryPressureHandler::setReceivedMemoryPressure(MemoryPressureReason reaso
 
 void MemoryPressureHandler::clearMemoryPressure()
 {
-    m_underMemoryPressure = false;
+    setUnderMemoryPressure(false);
 
     {
         LockHolder locker(m_observerMutex);
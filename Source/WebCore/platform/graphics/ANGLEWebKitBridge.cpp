@@ -29,7 +29,12 @@
 
 #include "ANGLEWebKitBridge.h"
 #include "Logging.h"
+#include <wtf/HashMap.h>
+#include <wtf/Lock.h>
+#include <wtf/NeverDestroyed.h>
 #include <wtf/StdLibExtras.h>
+#include <wtf/text/StringBuilder.h>
+#include <wtf/text/StringHash.h>
 
 namespace WebCore {
 
@@ -120,6 +125,23 @@ static bool getSymbolInfo(ShHandle compiler, ANGLEShaderSymbolType symbolType, V
     return true;
 }
 
+struct ShaderTranslation {
+    bool isValid;
+    String translatedShaderSource;
+    String shaderValidationLog;
+    Vector<ANGLEShaderSymbol> symbols;
+};
+
+// Translations shared by all the ANGLEWebKitBridges of the process.
+static const unsigned maximumShaderTranslationCacheSize = 512;
+static StaticLock shaderTranslationCacheLock;
+
+static HashMap<String, ShaderTranslation>& shaderTranslationCache()
+{
+    static NeverDestroyed<HashMap<String, ShaderTranslation>> cache;
+    return cache;
+}
+
 ANGLEWebKitBridge::ANGLEWebKitBridge(ShShaderOutput shaderOutput, ShShaderSpec shaderSpec)
     : builtCompilers(false)
     , m_fragmentCompiler(0)
@@ -145,6 +167,7 @@ void ANGLEWebKitBridge::cleanupCompilers()
         ShDestruct(m_vertexCompiler);
     m_vertexCompiler = nullptr;
 
+    m_resourcesString = String();
     builtCompilers = false;
 }
     
@@ -156,19 +179,83 @@ void ANGLEWebKitBridge::setResources(ShBuiltInResources resources)
     m_resources = resources;
 }
 
+bool ANGLEWebKitBridge::buildCompilersIfNeeded()
+{
+    if (builtCompilers)
+        return true;
+
+    m_fragmentCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, m_shaderSpec, m_shaderOutput, &m_resources);
+    m_vertexCompiler = ShConstructCompiler(GL_VERTEX_SHADER, m_shaderSpec, m_shaderOutput, &m_resources);
+    if (!m_fragmentCompiler || !m_vertexCompiler) {
+        cleanupCompilers();
+        return false;
+    }
+
+    // Both compilers were built from the same resources.
+    m_resourcesString = ShGetBuiltInResourcesString(m_vertexCompiler).c_str();
+    builtCompilers = true;
+    return true;
+}
+
+String ANGLEWebKitBridge::translationCacheKey(const char* shaderSource, ANGLEShaderType shaderType, int extraCompileOptions) const
+{
+    StringBuilder key;
+    key.appendNumber(shaderType);
+    key.append(':');
+    key.appendNumber(m_shaderSpec);
+    key.append(':');
+    key.appendNumber(m_shaderOutput);
+    key.append(':');
+    key.appendNumber(extraCompileOptions);
+    key.append(':');
+    key.append(m_resourcesString);
+    key.append('\n');
+    key.append(shaderSource);
+    return key.toString();
+}
+
 bool ANGLEWebKitBridge::compileShaderSource(const char* shaderSource, ANGLEShaderType shaderType, String& translatedShaderSource, String& shaderValidationLog, Vector<ANGLEShaderSymbol>& symbols, int extraCompileOptions)
 {
-    if (!builtCompilers) {
-        m_fragmentCompiler = ShConstructCompiler(GL_FRAGMENT_SHADER, m_shaderSpec, m_shaderOutput, &m_resources);
-        m_vertexCompiler = ShConstructCompiler(GL_VERTEX_SHADER, m_shaderSpec, m_shaderOutput, &m_resources);
-        if (!m_fragmentCompiler || !m_vertexCompiler) {
-            cleanupCompilers();
-            return false;
-        }
+    if (!buildCompilersIfNeeded())
+        return false;
 
-        builtCompilers = true;
+    String cacheKey = translationCacheKey(shaderSource, shaderType, extraCompileOptions);
+    {
+        LockHolder locker(shaderTranslationCacheLock);
+        auto iterator = shaderTranslationCache().find(cacheKey);
+        if (iterator != shaderTranslationCache().end()) {
+            const ShaderTranslation& translation = iterator->value;
+            if (!translation.isValid) {
+                shaderValidationLog = translation.shaderValidationLog;
+                return false;
+            }
+            translatedShaderSource = translation.translatedShaderSource;
+            symbols.appendVector(translation.symbols);
+            return true;
+        }
     }
-    
+
+    ShaderTranslation translation;
+    bool isValid = compileShaderSourceUncached(shaderSource, shaderType, translation.translatedShaderSource, translation.shaderValidationLog, translation.symbols, extraCompileOptions);
+
+    translation.isValid = isValid;
+    if (isValid) {
+        translatedShaderSource = translation.translatedShaderSource;
+        symbols.appendVector(translation.symbols);
+    } else
+        shaderValidationLog = translation.shaderValidationLog;
+
+    LockHolder locker(shaderTranslationCacheLock);
+    auto& cache = shaderTranslationCache();
+    if (cache.size() >= maximumShaderTranslationCacheSize)
+        cache.remove(cache.begin());
+    cache.set(cacheKey, WTF::move(translation));
+
+    return isValid;
+}
+
+bool ANGLEWebKitBridge::compileShaderSourceUncached(const char* shaderSource, ANGLEShaderType shaderType, String& translatedShaderSource, String& shaderValidationLog, Vector<ANGLEShaderSymbol>& symbols, int extraCompileOptions)
+{
     ShHandle compiler;
 
     if (shaderType == SHADER_TYPE_VERTEX)
@@ -26,6 +26,7 @@
 #ifndef ANGLEWebKitBridge_h
 #define ANGLEWebKitBridge_h
 
+#include <wtf/Vector.h>
 #include <wtf/text/CString.h>
 #include <wtf/text/WTFString.h>
 
@@ -94,13 +95,19 @@ public:
     ShBuiltInResources getResources() { return m_resources; }
     void setResources(ShBuiltInResources);
     
+    // Results are cached for the whole process, keyed by the source, shader type, resources, output and options,
+    // so contexts compiling the same shaders only translate them once.
     bool compileShaderSource(const char* shaderSource, ANGLEShaderType, String& translatedShaderSource, String& shaderValidationLog, Vector<ANGLEShaderSymbol>& symbols, int extraCompileOptions = 0);
 
 private:
 
+    bool buildCompilersIfNeeded();
+    bool compileShaderSourceUncached(const char* shaderSource, ANGLEShaderType, String& translatedShaderSource, String& shaderValidationLog, Vector<ANGLEShaderSymbol>& symbols, int extraCompileOptions);
     void cleanupCompilers();
+    String translationCacheKey(const char* shaderSource, ANGLEShaderType, int extraCompileOptions) const;
 
     bool builtCompilers;
+    String m_resourcesString;
     
     ShHandle m_fragmentCompiler;
     ShHandle m_vertexCompiler;
@@ -33,10 +33,14 @@
 #include "ImageObserver.h"
 #include "IntRect.h"
 #include "MIMETypeRegistry.h"
+#include "SharedBuffer.h"
 #include "TextStream.h"
 #include "Timer.h"
 #include <wtf/CurrentTime.h>
+#include <wtf/MainThread.h>
+#include <wtf/ThreadSafeRefCounted.h>
 #include <wtf/Vector.h>
+#include <wtf/WorkQueue.h>
 #include <wtf/text/WTFString.h>
 
 #if PLATFORM(IOS)
@@ -75,6 +79,8 @@ BitmapImage::BitmapImage(ImageObserver* observer)
     , m_hasUniformFrameSize(true)
     , m_haveFrameCount(false)
     , m_animationFinishedWhenCatchingUp(false)
+    , m_asynchronousDecodePending(false)
+    , m_frameDecodeAheadPending(false)
 {
 }
 
@@ -138,6 +144,13 @@ void BitmapImage::destroyDecodedData(bool destroyAll)
 
     m_source.clear(destroyAll, clearBeforeFrame, data(), m_allDataReceived);
     destroyMetadataAndNotify(frameBytesCleared, ClearedSource::Yes);
+
+    // Let the next draw decode the frame again rather than install a frame the caller wanted gone.
+    ++m_decodeGeneration;
+    m_asynchronousDecodePending = false;
+    m_frameDecodeAheadPending = false;
+    if (destroyAll)
+        m_animationFrameDecoder = nullptr;
 }
 
 void BitmapImage::destroyDecodedDataIfNecessary(bool destroyAll)
@@ -330,6 +343,11 @@ bool BitmapImage::dataChanged(bool allDataReceived)
     destroyMetadataAndNotify(deltaBytes, ClearedSource::No);
 #endif
     
+    ++m_decodeGeneration;
+    m_asynchronousDecodePending = false;
+    m_frameDecodeAheadPending = false;
+    m_animationFrameDecoder = nullptr;
+
     // Feed all the data we've seen so far to the image decoder.
     m_allDataReceived = allDataReceived;
 #if PLATFORM(IOS)
@@ -424,6 +442,164 @@ PassNativeImagePtr BitmapImage::frameAtIndex(size_t index, float presentationSca
     return m_frames[index].m_frame;
 }
 
+static bool gAsynchronousDecodingEnabled = false;
+
+void BitmapImage::setAsynchronousDecodingEnabled(bool enabled)
+{
+    gAsynchronousDecodingEnabled = enabled;
+}
+
+bool BitmapImage::asynchronousDecodingEnabled()
+{
+    return gAsynchronousDecodingEnabled;
+}
+
+struct BitmapImage::AsynchronousDecode {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    // Only used on the main thread.
+    RefPtr<BitmapImage> image;
+    unsigned generation;
+
+    // Only used on the decoding queue until it is done.
+    RefPtr<SharedBuffer> data;
+    RefPtr<AnimationFrameDecoder> animationFrameDecoder; // Used instead of |data| for the frames of animations.
+    size_t index { 0 };
+    SubsamplingLevel subsamplingLevel { 0 };
+    FrameData frame;
+};
+
+// An ImageSource with its own copy of the data, used only on the decoding queue. It outlives the
+// individual decodes so that each frame of an animation is decoded over the previous one rather
+// than from the start.
+class BitmapImage::AnimationFrameDecoder : public ThreadSafeRefCounted<AnimationFrameDecoder> {
+public:
+    static Ref<AnimationFrameDecoder> create(PassRefPtr<SharedBuffer> data)
+    {
+        return adoptRef(*new AnimationFrameDecoder(data));
+    }
+
+    PassNativeImagePtr decodeFrameAtIndex(size_t index)
+    {
+        NativeImagePtr frame = m_source.createDecodedFrameAtIndex(index, 0);
+        // Only keep what decoding the following frames needs.
+        m_source.clear(false, index + 1, nullptr, true);
+        return frame;
+    }
+
+private:
+    explicit AnimationFrameDecoder(PassRefPtr<SharedBuffer> data)
+    {
+        m_source.setData(data.get(), true);
+    }
+
+    ImageSource m_source;
+};
+
+static WorkQueue& decodingQueue()
+{
+    static auto& queue = WorkQueue::create("org.webkit.ImageDecoding", WorkQueue::Type::Serial, WorkQueue::QOS::UserInitiated).leakRef();
+    return queue;
+}
+
+bool BitmapImage::decodeFrameAsynchronouslyIfNeeded(size_t index, float presentationScaleHint)
+{
+    if (!gAsynchronousDecodingEnabled)
+        return false;
+    if (m_asynchronousDecodePending)
+        return true;
+
+    // Animations need their frames in order and on time, and partial data is decoded
+    // progressively, so only complete still images are decoded in the background.
+    if (index || !m_allDataReceived || !data() || frameCount() != 1 || haveFrameAtIndex(index))
+        return false;
+
+    // Below this, decoding is quick enough that painting nothing first would just flash.
+    static const unsigned minimumFrameBytesForAsynchronousDecoding = 1024 * 1024;
+    updateSize();
+    if (static_cast<uint64_t>(m_size.width()) * m_size.height() * 4 < minimumFrameBytesForAsynchronousDecoding)
+        return false;
+
+    auto decode = std::make_unique<AsynchronousDecode>();
+    decode->image = this;
+    decode->generation = m_decodeGeneration;
+    // SharedBuffer isn't thread safe, so the queue gets its own copy of the data.
+    decode->data = SharedBuffer::create(data()->data(), data()->size());
+    decode->subsamplingLevel = std::min(m_source.subsamplingLevelForScale(presentationScaleHint), m_minimumSubsamplingLevel);
+    m_asynchronousDecodePending = true;
+
+    AsynchronousDecode* decodePtr = decode.release();
+    decodingQueue().dispatch([decodePtr] {
+        {
+            ImageSource source;
+            source.setData(decodePtr->data.get(), true);
+            decodePtr->frame.m_frame = source.createDecodedFrameAtIndex(0, decodePtr->subsamplingLevel);
+        }
+        callOnMainThread([decodePtr] {
+            std::unique_ptr<AsynchronousDecode> decode(decodePtr);
+            decode->image->asynchronousDecodeDidFinish(*decode);
+        });
+    });
+    return true;
+}
+
+void BitmapImage::decodeFrameAhead(size_t index)
+{
+    if (!gAsynchronousDecodingEnabled || m_frameDecodeAheadPending || !m_allDataReceived || !data())
+        return;
+    if (index >= frameCount() || haveFrameAtIndex(index))
+        return;
+
+    // SharedBuffer isn't thread safe, so the queue gets its own copy of the data.
+    if (!m_animationFrameDecoder)
+        m_animationFrameDecoder = AnimationFrameDecoder::create(SharedBuffer::create(data()->data(), data()->size()));
+
+    auto decode = std::make_unique<AsynchronousDecode>();
+    decode->image = this;
+    decode->generation = m_decodeGeneration;
+    decode->animationFrameDecoder = m_animationFrameDecoder;
+    decode->index = index;
+    m_frameDecodeAheadPending = true;
+
+    AsynchronousDecode* decodePtr = decode.release();
+    decodingQueue().dispatch([decodePtr] {
+        decodePtr->frame.m_frame = decodePtr->animationFrameDecoder->decodeFrameAtIndex(decodePtr->index);
+        callOnMainThread([decodePtr] {
+            std::unique_ptr<AsynchronousDecode> decode(decodePtr);
+            decode->image->asynchronousDecodeDidFinish(*decode);
+        });
+    });
+}
+
+void BitmapImage::asynchronousDecodeDidFinish(AsynchronousDecode& decode)
+{
+    if (decode.generation != m_decodeGeneration)
+        return;
+    if (decode.animationFrameDecoder)
+        m_frameDecodeAheadPending = false;
+    else
+        m_asynchronousDecodePending = false;
+
+    // Drawing into a context that needs the frame synchronously may have decoded it meanwhile.
+    size_t index = decode.index;
+    if (!decode.frame.m_frame || haveFrameAtIndex(index))
+        return;
+
+    if (m_frames.size() <= index)
+        m_frames.grow(index + 1);
+    std::swap(m_frames[index].m_frame, decode.frame.m_frame);
+    m_frames[index].m_subsamplingLevel = decode.subsamplingLevel;
+    if (frameCount() == 1)
+        checkForSolidColor();
+
+    // Now that the frame is in place, caching its metadata accounts for its bytes and tells
+    // the observer (and through it the memory cache) how much memory was decoded.
+    cacheFrame(index, decode.subsamplingLevel, CacheMetadataOnly);
+
+    if (index == m_currentFrame && imageObserver())
+        imageObserver()->changedInRect(this, IntRect(IntPoint(), m_size));
+}
+
 bool BitmapImage::frameIsCompleteAtIndex(size_t index)
 {
     if (!ensureFrameIsCached(index, CacheMetadataOnly))
@@ -555,6 +731,7 @@ void BitmapImage::startAnimation(CatchUpAnimation catchUpIfNecessary)
     if (catchUpIfNecessary == DoNotCatchUp || time < m_desiredFrameStartTime) {
         // Haven't yet reached time for next frame to start; delay until then.
         startTimer(std::max<double>(m_desiredFrameStartTime - time, 0));
+        decodeFrameAhead(nextFrame);
         return;
     }
 
@@ -183,6 +183,11 @@ public:
 
     bool allowSubsampling() const { return m_allowSubsampling; }
     void setAllowSubsampling(bool allowSubsampling) { m_allowSubsampling = allowSubsampling; }
+
+    // Large still images are decoded on a background queue rather than while they are painted.
+    // Nothing is painted until the decoded frame is ready; the observer is told to repaint then.
+    WEBCORE_EXPORT static void setAsynchronousDecodingEnabled(bool);
+    static bool asynchronousDecodingEnabled();
     
 private:
     virtual bool isBitmapImage() const override { return true; }
@@ -218,6 +223,10 @@ protected:
 
     bool haveFrameAtIndex(size_t);
 
+    // Returns true if the frame isn't decoded yet and is being decoded on the background queue,
+    // in which case the caller should not draw it now.
+    bool decodeFrameAsynchronouslyIfNeeded(size_t, float presentationScaleHint = 1);
+
     bool frameIsCompleteAtIndex(size_t);
     float frameDurationAtIndex(size_t);
     bool frameHasAlphaAtIndex(size_t);
@@ -324,6 +333,15 @@ private:
     mutable unsigned m_decodedPropertiesSize; // The size of data decoded by the source to determine image properties (e.g. size, frame count, etc).
     size_t m_frameCount;
 
+    struct AsynchronousDecode;
+    void asynchronousDecodeDidFinish(AsynchronousDecode&);
+    unsigned m_decodeGeneration { 0 }; // Bumped when frames decoded in the background would be out of date.
+
+    // Decodes the next frame of an animation on the background queue while the current one is shown.
+    void decodeFrameAhead(size_t);
+    class AnimationFrameDecoder;
+    RefPtr<AnimationFrameDecoder> m_animationFrameDecoder;
+
 #if PLATFORM(IOS)
     // FIXME: We should expose a setting to enable/disable progressive loading remove the PLATFORM(IOS)-guard.
     double m_progressiveLoadChunkTime;
@@ -342,6 +360,8 @@ private:
     mutable bool m_hasUniformFrameSize : 1;
     mutable bool m_haveFrameCount : 1;
     bool m_animationFinishedWhenCatchingUp : 1;
+    bool m_asynchronousDecodePending : 1;
+    bool m_frameDecodeAheadPending : 1;
 
     RefPtr<Image> m_cachedImage;
 };
@@ -44,6 +44,10 @@
 #include "OpenTypeVerticalData.h"
 #endif
 
+#if USE(HARFBUZZ)
+#include "HarfBuzzShapeCache.h"
+#endif
+
 namespace WebCore {
 
 unsigned GlyphPage::s_count = 0;
@@ -147,6 +151,9 @@ void Font::platformGlyphInit()
 Font::~Font()
 {
     removeFromSystemFallbackCache();
+#if USE(HARFBUZZ)
+    HarfBuzzShapeCache::singleton().removeEntriesForFont(this);
+#endif
 }
 
 static bool fillGlyphPage(GlyphPage& pageToFill, UChar* buffer, unsigned bufferLength, const Font& font)
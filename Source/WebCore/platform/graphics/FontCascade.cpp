@@ -228,10 +228,105 @@ void invalidateFontCascadeCache()
     fontCascadeCache().clear();
 }
 
+// The WidthCache lives on FontCascadeFonts, which are not shared between documents since each document
+// has its own font selector. Widths measured with nothing but the primary font only depend on that
+// font, the description and the text though, so this second level shares them process-wide.
+struct SharedWidthCacheKey {
+    RefPtr<const Font> font;
+    FontDescriptionKey fontDescriptionKey;
+    AtomicString locale;
+    bool enableKerning;
+    bool requiresShaping;
+    String text;
+};
+
+static bool operator==(const SharedWidthCacheKey& a, const SharedWidthCacheKey& b)
+{
+    return a.font == b.font && a.fontDescriptionKey == b.fontDescriptionKey && a.locale == b.locale
+        && a.enableKerning == b.enableKerning && a.requiresShaping == b.requiresShaping && a.text == b.text;
+}
+
+struct SharedWidthCacheEntry {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    SharedWidthCacheEntry(SharedWidthCacheKey&& key, float width)
+        : key(WTF::move(key))
+        , width(width)
+    { }
+    SharedWidthCacheKey key;
+    float width;
+};
+
+typedef HashMap<unsigned, std::unique_ptr<SharedWidthCacheEntry>, AlreadyHashed> SharedWidthCache;
+
+static SharedWidthCache& sharedWidthCache()
+{
+    static NeverDestroyed<SharedWidthCache> cache;
+    return cache.get();
+}
+
+static SharedWidthCacheStatistics& sharedWidthCacheCounts()
+{
+    static SharedWidthCacheStatistics counts = { 0, 0, 0 };
+    return counts;
+}
+
+static SharedWidthCacheKey makeSharedWidthCacheKey(const FontCascade& fontCascade, const TextRun& run)
+{
+    return SharedWidthCacheKey {
+        &fontCascade.primaryFont(),
+        FontDescriptionKey(fontCascade.fontDescription()),
+        fontCascade.fontDescription().locale(),
+        fontCascade.enableKerning(),
+        fontCascade.requiresShaping(),
+        run.is8Bit() ? String(run.characters8(), run.length()) : String(run.characters16(), run.length())
+    };
+}
+
+static unsigned computeSharedWidthCacheHash(const SharedWidthCacheKey& key)
+{
+    unsigned hashCodes[] = {
+        PtrHash<const Font*>::hash(key.font.get()),
+        key.fontDescriptionKey.computeHash(),
+        key.locale.isNull() ? 0 : key.locale.impl()->existingHash(),
+        static_cast<unsigned>(key.enableKerning) << 1 | static_cast<unsigned>(key.requiresShaping),
+        key.text.impl()->hash()
+    };
+    return StringHasher::hashMemory<sizeof(hashCodes)>(hashCodes);
+}
+
+static const float* findSharedWidth(const SharedWidthCacheKey& key, unsigned hash)
+{
+    auto it = sharedWidthCache().find(hash);
+    if (it == sharedWidthCache().end() || !(it->value->key == key)) {
+        ++sharedWidthCacheCounts().missCount;
+        return nullptr;
+    }
+    ++sharedWidthCacheCounts().hitCount;
+    return &it->value->width;
+}
+
+static void addSharedWidth(SharedWidthCacheKey&& key, unsigned hash, float width)
+{
+    static const int maximumEntries = 8192;
+    if (sharedWidthCache().size() >= maximumEntries)
+        sharedWidthCache().remove(sharedWidthCache().begin());
+    sharedWidthCache().set(hash, std::make_unique<SharedWidthCacheEntry>(WTF::move(key), width));
+}
+
+SharedWidthCacheStatistics sharedWidthCacheStatistics()
+{
+    SharedWidthCacheStatistics statistics = sharedWidthCacheCounts();
+    statistics.entryCount = sharedWidthCache().size();
+    return statistics;
+}
+
 void clearWidthCaches()
 {
     for (auto& value : fontCascadeCache().values())
         value->fonts.get().widthCache().clear();
+    // Also releases the fonts the shared entries keep alive.
+    sharedWidthCache().clear();
 }
 
 static FontCascadeCacheKey makeFontCascadeCacheKey(const FontCascadeDescription& description, FontSelector* fontSelector)
@@ -363,6 +458,17 @@ float FontCascade::width(const TextRun& run, HashSet<const Font*>* fallbackFonts
     if (cacheEntry && !std::isnan(*cacheEntry))
         return *cacheEntry;
 
+    SharedWidthCacheKey sharedWidthCacheKey;
+    unsigned sharedWidthCacheHash = 0;
+    if (cacheEntry) {
+        sharedWidthCacheKey = makeSharedWidthCacheKey(*this, run);
+        sharedWidthCacheHash = computeSharedWidthCacheHash(sharedWidthCacheKey);
+        if (const float* sharedWidth = findSharedWidth(sharedWidthCacheKey, sharedWidthCacheHash)) {
+            *cacheEntry = *sharedWidth;
+            return *sharedWidth;
+        }
+    }
+
     HashSet<const Font*> localFallbackFonts;
     if (!fallbackFonts)
         fallbackFonts = &localFallbackFonts;
@@ -373,8 +479,10 @@ float FontCascade::width(const TextRun& run, HashSet<const Font*>* fallbackFonts
     else
         result = floatWidthForSimpleText(run, fallbackFonts, glyphOverflow);
 
-    if (cacheEntry && fallbackFonts->isEmpty())
+    if (cacheEntry && fallbackFonts->isEmpty()) {
         *cacheEntry = result;
+        addSharedWidth(WTF::move(sharedWidthCacheKey), sharedWidthCacheHash, result);
+    }
     return result;
 }
 
@@ -1343,7 +1451,7 @@ void FontCascade::drawGlyphBuffer(GraphicsContext& context, const TextRun& run,
                 renderingContext->drawSVGGlyphs(context, *fontData, glyphBuffer, lastFrom, nextGlyph - lastFrom, startPoint);
             else
 #endif
-                drawGlyphs(context, *fontData, glyphBuffer, lastFrom, nextGlyph - lastFrom, startPoint);
+                context.drawGlyphs(*this, *fontData, glyphBuffer, lastFrom, nextGlyph - lastFrom, startPoint);
 
             lastFrom = nextGlyph;
             fontData = nextFontData;
@@ -1362,7 +1470,7 @@ void FontCascade::drawGlyphBuffer(GraphicsContext& context, const TextRun& run,
     else
 #endif
     {
-        drawGlyphs(context, *fontData, glyphBuffer, lastFrom, nextGlyph - lastFrom, startPoint);
+        context.drawGlyphs(*this, *fontData, glyphBuffer, lastFrom, nextGlyph - lastFrom, startPoint);
         point.setX(nextX);
     }
 }
@@ -346,6 +346,13 @@ void pruneUnreferencedEntriesFromFontCascadeCache();
 void pruneSystemFallbackFonts();
 void clearWidthCaches();
 
+struct SharedWidthCacheStatistics {
+    unsigned entryCount;
+    unsigned hitCount;
+    unsigned missCount;
+};
+SharedWidthCacheStatistics sharedWidthCacheStatistics();
+
 inline const Font& FontCascade::primaryFont() const
 {
     ASSERT(m_fonts);
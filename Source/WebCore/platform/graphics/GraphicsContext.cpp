@@ -28,6 +28,7 @@
 
 #include "BidiResolver.h"
 #include "BitmapImage.h"
+#include "DisplayListRecorder.h"
 #include "FloatRoundedRect.h"
 #include "Gradient.h"
 #include "ImageBuffer.h"
@@ -112,6 +113,14 @@ GraphicsContext::~GraphicsContext()
     platformDestroy();
 }
 
+void GraphicsContext::setDisplayListRecorder(DisplayList::Recorder* recorder)
+{
+    // Only a context that can't paint anywhere else records.
+    ASSERT(!platformContext());
+    m_displayListRecorder = recorder;
+    setPaintingDisabled(!recorder);
+}
+
 void GraphicsContext::save()
 {
     if (paintingDisabled())
@@ -119,6 +128,11 @@ void GraphicsContext::save()
 
     m_stack.append(m_state);
 
+    if (isRecording()) {
+        m_displayListRecorder->save();
+        return;
+    }
+
     savePlatformState();
 }
 
@@ -139,6 +153,11 @@ void GraphicsContext::restore()
     if (m_stack.isEmpty())
         m_stack.clear();
 
+    if (isRecording()) {
+        m_displayListRecorder->restore();
+        return;
+    }
+
     restorePlatformState();
 }
 
@@ -165,12 +184,16 @@ void GraphicsContext::drawRaisedEllipse(const FloatRect& rect, const Color& elli
 void GraphicsContext::setStrokeThickness(float thickness)
 {
     m_state.strokeThickness = thickness;
+    if (isRecording())
+        return;
     setPlatformStrokeThickness(thickness);
 }
 
 void GraphicsContext::setStrokeStyle(StrokeStyle style)
 {
     m_state.strokeStyle = style;
+    if (isRecording())
+        return;
     setPlatformStrokeStyle(style);
 }
 
@@ -179,6 +202,8 @@ void GraphicsContext::setStrokeColor(const Color& color)
     m_state.strokeColor = color;
     m_state.strokeGradient = nullptr;
     m_state.strokePattern = nullptr;
+    if (isRecording())
+        return;
     setPlatformStrokeColor(color);
 }
 
@@ -187,6 +212,8 @@ void GraphicsContext::setShadow(const FloatSize& offset, float blur, const Color
     m_state.shadowOffset = offset;
     m_state.shadowBlur = blur;
     m_state.shadowColor = color;
+    if (isRecording())
+        return;
     setPlatformShadow(offset, blur, color);
 }
 
@@ -198,6 +225,8 @@ void GraphicsContext::setLegacyShadow(const FloatSize& offset, float blur, const
 #if USE(CG)
     m_state.shadowsUseLegacyRadius = true;
 #endif
+    if (isRecording())
+        return;
     setPlatformShadow(offset, blur, color);
 }
 
@@ -206,6 +235,8 @@ void GraphicsContext::clearShadow()
     m_state.shadowOffset = FloatSize();
     m_state.shadowBlur = 0;
     m_state.shadowColor = Color();
+    if (isRecording())
+        return;
     clearPlatformShadow();
 }
 
@@ -241,18 +272,24 @@ void GraphicsContext::setFillColor(const Color& color)
     m_state.fillColor = color;
     m_state.fillGradient = nullptr;
     m_state.fillPattern = nullptr;
+    if (isRecording())
+        return;
     setPlatformFillColor(color);
 }
 
 void GraphicsContext::setShouldAntialias(bool shouldAntialias)
 {
     m_state.shouldAntialias = shouldAntialias;
+    if (isRecording())
+        return;
     setPlatformShouldAntialias(shouldAntialias);
 }
 
 void GraphicsContext::setShouldSmoothFonts(bool shouldSmoothFonts)
 {
     m_state.shouldSmoothFonts = shouldSmoothFonts;
+    if (isRecording())
+        return;
     setPlatformShouldSmoothFonts(shouldSmoothFonts);
 }
 
@@ -260,7 +297,7 @@ void GraphicsContext::setImageInterpolationQuality(InterpolationQuality imageInt
 {
     m_state.imageInterpolationQuality = imageInterpolationQuality;
 
-    if (paintingDisabled())
+    if (paintingDisabled() || isRecording())
         return;
 
     setPlatformImageInterpolationQuality(imageInterpolationQuality);
@@ -297,13 +334,19 @@ void GraphicsContext::setFillGradient(Ref<Gradient>&& gradient)
 
 void GraphicsContext::beginTransparencyLayer(float opacity)
 {
-    beginPlatformTransparencyLayer(opacity);
+    if (isRecording())
+        m_displayListRecorder->beginTransparencyLayer(opacity);
+    else
+        beginPlatformTransparencyLayer(opacity);
     ++m_transparencyCount;
 }
 
 void GraphicsContext::endTransparencyLayer()
 {
-    endPlatformTransparencyLayer();
+    if (isRecording())
+        m_displayListRecorder->endTransparencyLayer();
+    else
+        endPlatformTransparencyLayer();
     ASSERT(m_transparencyCount > 0);
     --m_transparencyCount;
 }
@@ -327,6 +370,11 @@ void GraphicsContext::drawGlyphs(const FontCascade& fontCascade, const Font& fon
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawGlyphs(fontCascade, font, buffer, from, numGlyphs, point);
+        return;
+    }
+
     fontCascade.drawGlyphs(*this, font, buffer, from, numGlyphs, point);
 }
 
@@ -393,6 +441,11 @@ void GraphicsContext::drawImage(Image& image, const FloatRect& destination, cons
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawImage(image, destination, source, imagePaintingOptions);
+        return;
+    }
+
     // FIXME (49002): Should be InterpolationLow
     InterpolationQualityMaintainer interpolationQualityForThisScope(*this, imagePaintingOptions.m_useLowQualityScale ? InterpolationNone : imageInterpolationQuality());
     image.draw(*this, destination, source, imagePaintingOptions.m_compositeOperator, imagePaintingOptions.m_blendMode, imagePaintingOptions.m_orientationDescription);
@@ -403,6 +456,11 @@ void GraphicsContext::drawTiledImage(Image& image, const FloatRect& destination,
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        m_displayListRecorder->drawTiledImage(image, destination, source, tileSize, spacing, imagePaintingOptions);
+        return;
+    }
+
     InterpolationQualityMaintainer interpolationQualityForThisScope(*this, imagePaintingOptions.m_useLowQualityScale ? InterpolationLow : imageInterpolationQuality());
     image.drawTiled(*this, destination, source, tileSize, spacing, imagePaintingOptions.m_compositeOperator, imagePaintingOptions.m_blendMode);
 }
@@ -419,6 +477,11 @@ void GraphicsContext::drawTiledImage(Image& image, const FloatRect& destination,
         return;
     }
 
+    if (isRecording()) {
+        m_displayListRecorder->drawTiledImage(image, destination, source, tileScaleFactor, hRule, vRule, imagePaintingOptions);
+        return;
+    }
+
     InterpolationQualityMaintainer interpolationQualityForThisScope(*this, imagePaintingOptions.m_useLowQualityScale ? InterpolationLow : imageInterpolationQuality());
     image.drawTiled(*this, destination, source, tileScaleFactor, hRule, vRule, imagePaintingOptions.m_compositeOperator);
 }
@@ -438,6 +501,13 @@ void GraphicsContext::drawImageBuffer(ImageBuffer& image, const FloatRect& desti
     if (paintingDisabled())
         return;
 
+    if (isRecording()) {
+        // The buffer keeps changing after this, so record a copy of its current contents.
+        if (RefPtr<Image> copy = image.copyImage(CopyBackingStore))
+            m_displayListRecorder->drawImage(*copy, destination, source, imagePaintingOptions);
+        return;
+    }
+
     // FIXME (49002): Should be InterpolationLow
     InterpolationQualityMaintainer interpolationQualityForThisScope(*this, imagePaintingOptions.m_useLowQualityScale ? InterpolationNone : imageInterpolationQuality());
     image.draw(*this, destination, source, imagePaintingOptions.m_compositeOperator, imagePaintingOptions.m_blendMode, imagePaintingOptions.m_useLowQualityScale);
@@ -477,6 +547,13 @@ void GraphicsContext::clipToImageBuffer(ImageBuffer& buffer, const FloatRect& re
 {
     if (paintingDisabled())
         return;
+
+    if (isRecording()) {
+        if (RefPtr<Image> copy = buffer.copyImage(CopyBackingStore))
+            m_displayListRecorder->clipToImage(*copy, rect);
+        return;
+    }
+
     buffer.clip(*this, rect);
 }
 
@@ -491,7 +568,7 @@ IntRect GraphicsContext::clipBounds() const
 void GraphicsContext::setTextDrawingMode(TextDrawingModeFlags mode)
 {
     m_state.textDrawingMode = mode;
-    if (paintingDisabled())
+    if (paintingDisabled() || isRecording())
         return;
     setPlatformTextDrawingMode(mode);
 }
@@ -500,6 +577,12 @@ void GraphicsContext::fillRect(const FloatRect& rect, Gradient& gradient)
 {
     if (paintingDisabled())
         return;
+
+    if (isRecording()) {
+        m_displayListRecorder->fillRect(rect, gradient);
+        return;
+    }
+
     gradient.fill(this, rect);
 }
 
@@ -554,6 +637,8 @@ void GraphicsContext::fillRectWithRoundedHole(const IntRect& rect, const FloatRo
 void GraphicsContext::setAlpha(float alpha)
 {
     m_state.alpha = alpha;
+    if (isRecording())
+        return;
     setPlatformAlpha(alpha);
 }
 
@@ -561,6 +646,8 @@ void GraphicsContext::setCompositeOperation(CompositeOperator compositeOperation
 {
     m_state.compositeOperator = compositeOperation;
     m_state.blendMode = blendMode;
+    if (isRecording())
+        return;
     setPlatformCompositeOperation(compositeOperation, blendMode);
 }
 
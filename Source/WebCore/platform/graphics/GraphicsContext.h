@@ -84,6 +84,10 @@ class GraphicsContext3D;
 class TextRun;
 class TransformationMatrix;
 
+namespace DisplayList {
+class Recorder;
+}
+
 enum TextDrawingMode {
     TextModeFill = 1 << 0,
     TextModeStroke = 1 << 1,
@@ -362,9 +366,17 @@ public:
     void setPaintingDisabled(bool paintingDisabled) { m_state.paintingDisabled = paintingDisabled; }
     bool paintingDisabled() const { return m_state.paintingDisabled; }
 
+    // Whether the drawing is recorded into a display list rather than painted; see DisplayList::Recorder.
+    bool isRecording() const { return m_displayListRecorder; }
+
     void setUpdatingControlTints(bool);
     bool updatingControlTints() const { return m_updatingControlTints; }
 
+    // Whether images may be left unpainted while they are decoded in the background. Only set
+    // when painting to the screen, where the image is repainted once its frame is decoded.
+    void setAllowsAsynchronousImageDecoding(bool allows) { m_allowsAsynchronousImageDecoding = allows; }
+    bool allowsAsynchronousImageDecoding() const { return m_allowsAsynchronousImageDecoding; }
+
     WEBCORE_EXPORT void beginTransparencyLayer(float opacity);
     WEBCORE_EXPORT void endTransparencyLayer();
     bool isInTransparencyLayer() const { return (m_transparencyCount > 0) && supportsTransparencyLayers(); }
@@ -510,6 +522,9 @@ public:
     static void adjustLineToPixelBoundaries(FloatPoint& p1, FloatPoint& p2, float strokeWidth, StrokeStyle);
 
 private:
+    friend class DisplayList::Recorder;
+    void setDisplayListRecorder(DisplayList::Recorder*);
+
     void platformInit(PlatformGraphicsContext*);
     void platformDestroy();
 
@@ -553,10 +568,12 @@ private:
     FloatRect computeLineBoundsAndAntialiasingModeForText(const FloatPoint&, float width, bool printing, bool& shouldAntialias, Color&);
 
     GraphicsContextPlatformPrivate* m_data;
+    DisplayList::Recorder* m_displayListRecorder { nullptr };
 
     GraphicsContextState m_state;
     Vector<GraphicsContextState, 1> m_stack;
     bool m_updatingControlTints;
+    bool m_allowsAsynchronousImageDecoding { false };
     unsigned m_transparencyCount;
 };
 
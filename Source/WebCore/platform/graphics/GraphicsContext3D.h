@@ -1430,13 +1430,23 @@ private:
             : boundFBO(0)
             , activeTexture(GraphicsContext3D::TEXTURE0)
             , boundTexture0(0)
+            , currentProgram(0)
+            , knownCapabilities(0)
+            , enabledCapabilities(0)
         { }
 
         GC3Duint boundFBO;
         GC3Denum activeTexture;
         GC3Duint boundTexture0;
+
+        // Used to drop redundant state changes when rendering offscreen, where nothing else issues GL calls on our context.
+        GC3Duint currentProgram;
+        unsigned knownCapabilities;
+        unsigned enabledCapabilities;
     };
 
+    bool filtersRedundantStateChanges() const { return m_renderStyle == RenderOffscreen; }
+
     GraphicsContext3DState m_state;
 
     // For multisampling
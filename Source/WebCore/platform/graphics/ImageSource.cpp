@@ -35,6 +35,7 @@
 
 #include "ImageOrientation.h"
 #include "NotImplemented.h"
+#include <wtf/MathExtras.h>
 
 namespace WebCore {
 
@@ -96,9 +97,18 @@ String ImageSource::filenameExtension() const
     return m_decoder ? m_decoder->filenameExtension() : String();
 }
 
-SubsamplingLevel ImageSource::subsamplingLevelForScale(float) const
+SubsamplingLevel ImageSource::subsamplingLevelForScale(float scale) const
 {
-    return 0;
+    // Animated images would have to decode every frame again whenever the painted size changes.
+    if (!m_decoder || !m_decoder->canDecodeSubsampled() || m_decoder->frameCount() != 1)
+        return 0;
+
+    // Levels 0 to 3 decode at 1, 1/2, 1/4 and 1/8 of the image size. Round toward the larger
+    // size so that the frame is never stretched when it is painted.
+    const SubsamplingLevel maxSubsamplingLevel = 3;
+    if (!(scale > 0) || scale >= 1)
+        return 0;
+    return std::min<SubsamplingLevel>(maxSubsamplingLevel, floorf(log2f(1 / scale)));
 }
 
 bool ImageSource::allowSubsamplingOfFrameAtIndex(size_t) const
@@ -148,11 +158,25 @@ size_t ImageSource::frameCount() const
     return m_decoder ? m_decoder->frameCount() : 0;
 }
 
-PassNativeImagePtr ImageSource::createFrameAtIndex(size_t index, SubsamplingLevel)
+PassNativeImagePtr ImageSource::createFrameAtIndex(size_t index, SubsamplingLevel subsamplingLevel)
 {
     if (!m_decoder)
         return 0;
 
+    if (subsamplingLevel != m_decoder->subsamplingLevel() && m_decoder->canDecodeSubsampled()) {
+        // A decoder only decodes at the size it started with, so start over with a new one.
+        RefPtr<SharedBuffer> data = m_decoder->data();
+        if (!data)
+            return 0;
+        bool allDataReceived = m_decoder->isAllDataReceived();
+        delete m_decoder;
+        m_decoder = 0;
+        setData(data.get(), allDataReceived);
+        if (!m_decoder)
+            return 0;
+        m_decoder->setSubsamplingLevel(subsamplingLevel);
+    }
+
     ImageFrame* buffer = m_decoder->frameBufferAtIndex(index);
     if (!buffer || buffer->status() == ImageFrame::FrameEmpty)
         return 0;
@@ -167,23 +191,18 @@ PassNativeImagePtr ImageSource::createFrameAtIndex(size_t index, SubsamplingLeve
     return buffer->asNewNativeImage();
 }
 
-float ImageSource::frameDurationAtIndex(size_t index)
+PassNativeImagePtr ImageSource::createDecodedFrameAtIndex(size_t index, SubsamplingLevel subsamplingLevel)
 {
-    if (!m_decoder)
-        return 0;
-
-    ImageFrame* buffer = m_decoder->frameBufferAtIndex(index);
-    if (!buffer || buffer->status() == ImageFrame::FrameEmpty)
-        return 0;
+    // The frame is decoded by a source that goes away once it is handed over, so it must not
+    // keep pointing into the decoder's buffer the way createFrameAtIndex() does.
+    if (!createFrameAtIndex(index, subsamplingLevel))
+        return nullptr;
+    return m_decoder->frameBufferAtIndex(index)->copyAsNewNativeImage();
+}
 
-    // Many annoying ads specify a 0 duration to make an image flash as quickly as possible.
-    // We follow Firefox's behavior and use a duration of 100 ms for any frames that specify
-    // a duration of <= 10 ms. See <rdar://problem/7689300> and <http://webkit.org/b/36082>
-    // for more information.
-    const float duration = buffer->duration() / 1000.0f;
-    if (duration < 0.011f)
-        return 0.100f;
-    return duration;
+float ImageSource::frameDurationAtIndex(size_t index)
+{
+    return m_decoder ? m_decoder->frameDurationAtIndex(index) : 0;
 }
 
 ImageOrientation ImageSource::orientationAtIndex(size_t) const
@@ -200,11 +219,7 @@ bool ImageSource::frameHasAlphaAtIndex(size_t index)
 
 bool ImageSource::frameIsCompleteAtIndex(size_t index)
 {
-    if (!m_decoder)
-        return false;
-
-    ImageFrame* buffer = m_decoder->frameBufferAtIndex(index);
-    return buffer && buffer->status() == ImageFrame::FrameComplete;
+    return m_decoder && m_decoder->frameIsCompleteAtIndex(index);
 }
 
 unsigned ImageSource::frameBytesAtIndex(size_t index, SubsamplingLevel) const
@@ -147,6 +147,9 @@ public:
     // Callers should not call this after calling clear() with a higher index;
     // see comments on clear() above.
     PassNativeImagePtr createFrameAtIndex(size_t, SubsamplingLevel = 0);
+    // Like createFrameAtIndex(), but the pixels are decoded before it returns rather than when
+    // the frame is first drawn. Used to decode frames off the main thread.
+    PassNativeImagePtr createDecodedFrameAtIndex(size_t, SubsamplingLevel = 0);
 
     float frameDurationAtIndex(size_t);
     bool frameHasAlphaAtIndex(size_t); // Whether or not the frame actually used any alpha.
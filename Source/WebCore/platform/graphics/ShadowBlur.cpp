@@ -36,6 +36,7 @@
 #include "ImageBuffer.h"
 #include "Timer.h"
 #include <wtf/MathExtras.h>
+#include <wtf/NeverDestroyed.h>
 #include <wtf/Noncopyable.h>
 
 namespace WebCore {
@@ -159,6 +160,92 @@ ScratchBuffer& ScratchBuffer::singleton()
     return scratchBuffer;
 }
 
+// The tiled rect and inset shadow paths blur a small nine-patch template rather than the whole
+// shadow. The template only depends on the blur radius, the color and the corner radii, not on the
+// size of the shadowed rect, so boxes that share a shadow can share its template too. Keep the
+// recently used ones around, up to a memory budget, instead of re-blurring them on every paint.
+class ShadowTemplateCache {
+    WTF_MAKE_NONCOPYABLE(ShadowTemplateCache); WTF_MAKE_FAST_ALLOCATED;
+public:
+    struct Key {
+        bool inset;
+        IntSize templateSize;
+        FloatSize blurRadius;
+        Color color;
+        FloatRoundedRect::Radii radii;
+        bool shadowsIgnoreTransforms;
+
+        bool operator==(const Key& other) const
+        {
+            return inset == other.inset
+                && templateSize == other.templateSize
+                && blurRadius == other.blurRadius
+                && color == other.color
+                && radii == other.radii
+                && shadowsIgnoreTransforms == other.shadowsIgnoreTransforms;
+        }
+    };
+
+    ShadowTemplateCache() = default;
+
+    static ShadowTemplateCache& singleton();
+
+    ImageBuffer* get(const Key& key)
+    {
+        for (size_t i = m_entries.size(); i--;) {
+            if (!(m_entries[i].key == key))
+                continue;
+            // Move the entry to the back, which holds the most recently used templates.
+            if (i != m_entries.size() - 1) {
+                Entry entry = WTF::move(m_entries[i]);
+                m_entries.remove(i);
+                m_entries.append(WTF::move(entry));
+            }
+            return m_entries.last().image.get();
+        }
+        return nullptr;
+    }
+
+    ImageBuffer* add(const Key& key, std::unique_ptr<ImageBuffer> image)
+    {
+        size_t cost = imageCost(key.templateSize);
+        m_entries.append({ key, WTF::move(image) });
+        m_totalCost += cost;
+
+        // Always keep the template that was just added, even if it alone is over budget.
+        while (m_totalCost > maximumTotalCost && m_entries.size() > 1) {
+            m_totalCost -= imageCost(m_entries.first().key.templateSize);
+            m_entries.remove(0);
+        }
+        return m_entries.last().image.get();
+    }
+
+    void clear()
+    {
+        m_entries.clear();
+        m_totalCost = 0;
+    }
+
+private:
+    static const size_t maximumTotalCost = 4 * 1024 * 1024;
+
+    static size_t imageCost(const IntSize& size) { return size.area() * 4; }
+
+    struct Entry {
+        Key key;
+        std::unique_ptr<ImageBuffer> image;
+    };
+
+    Vector<Entry> m_entries;
+    size_t m_totalCost { 0 };
+};
+
+ShadowTemplateCache& ShadowTemplateCache::singleton()
+{
+    static NeverDestroyed<ShadowTemplateCache> cache;
+    return cache;
+}
+
 static const int templateSideLength = 1;
 
 #if USE(CG)
@@ -666,21 +753,21 @@ void ShadowBlur::drawInsetShadowWithoutTiling(GraphicsContext& graphicsContext,
 
 void ShadowBlur::drawInsetShadowWithTiling(GraphicsContext& graphicsContext, const FloatRect& rect, const FloatRoundedRect& holeRect, const IntSize& templateSize, const IntSize& edgeSize)
 {
-    m_layerImage = ScratchBuffer::singleton().getScratchBuffer(templateSize);
-    if (!m_layerImage)
-        return;
+    auto& templateCache = ShadowTemplateCache::singleton();
+    ShadowTemplateCache::Key templateKey { true, templateSize, m_blurRadius, m_color, holeRect.radii(), m_shadowsIgnoreTransforms };
+    m_layerImage = templateCache.get(templateKey);
+    if (!m_layerImage) {
+        std::unique_ptr<ImageBuffer> templateImage = ImageBuffer::create(templateSize, Unaccelerated, 1);
+        if (!templateImage)
+            return;
+        m_layerImage = templateImage.get();
+
+        // Draw the rectangle with hole.
+        FloatRect templateBounds(0, 0, templateSize.width(), templateSize.height());
+        FloatRect templateHole = FloatRect(edgeSize.width(), edgeSize.height(), templateSize.width() - 2 * edgeSize.width(), templateSize.height() - 2 * edgeSize.height());
 
-    // Draw the rectangle with hole.
-    FloatRect templateBounds(0, 0, templateSize.width(), templateSize.height());
-    FloatRect templateHole = FloatRect(edgeSize.width(), edgeSize.height(), templateSize.width() - 2 * edgeSize.width(), templateSize.height() - 2 * edgeSize.height());
-
-    // Only redraw in the scratch buffer if its cached contents don't match our needs
-    bool redrawNeeded = ScratchBuffer::singleton().setCachedInsetShadowValues(m_blurRadius, m_color, templateBounds, templateHole, holeRect.radii());
-    if (redrawNeeded) {
-        // Draw shadow into a new ImageBuffer.
         GraphicsContext& shadowContext = m_layerImage->context();
         GraphicsContextStateSaver shadowStateSaver(shadowContext);
-        shadowContext.clearRect(templateBounds);
         shadowContext.setFillRule(RULE_EVENODD);
         shadowContext.setFillColor(Color::black);
 
@@ -694,7 +781,9 @@ void ShadowBlur::drawInsetShadowWithTiling(GraphicsContext& graphicsContext, con
         shadowContext.fillPath(path);
 
         blurAndColorShadowBuffer(templateSize);
+        m_layerImage = templateCache.add(templateKey, WTF::move(templateImage));
     }
+
     FloatSize offset = m_offset;
     if (shadowsIgnoreTransforms()) {
         AffineTransform transform = graphicsContext.getCTM();
@@ -726,26 +815,24 @@ void ShadowBlur::drawInsetShadowWithTiling(GraphicsContext& graphicsContext, con
     drawLayerPieces(graphicsContext, destHoleBounds, holeRect.radii(), edgeSize, templateSize, InnerShadow);
 
     m_layerImage = nullptr;
-    ScratchBuffer::singleton().scheduleScratchBufferPurge();
 }
 
 void ShadowBlur::drawRectShadowWithTiling(GraphicsContext& graphicsContext, const FloatRoundedRect& shadowedRect, const IntSize& templateSize, const IntSize& edgeSize)
 {
-    auto& scratchBuffer = ScratchBuffer::singleton();
-    m_layerImage = scratchBuffer.getScratchBuffer(templateSize);
-    if (!m_layerImage)
-        return;
+    auto& templateCache = ShadowTemplateCache::singleton();
+    ShadowTemplateCache::Key templateKey { false, templateSize, m_blurRadius, m_color, shadowedRect.radii(), m_shadowsIgnoreTransforms };
+    m_layerImage = templateCache.get(templateKey);
+    if (!m_layerImage) {
+        std::unique_ptr<ImageBuffer> templateImage = ImageBuffer::create(templateSize, Unaccelerated, 1);
+        if (!templateImage)
+            return;
+        m_layerImage = templateImage.get();
 
-    FloatRect templateShadow = FloatRect(edgeSize.width(), edgeSize.height(), templateSize.width() - 2 * edgeSize.width(), templateSize.height() - 2 * edgeSize.height());
+        FloatRect templateShadow = FloatRect(edgeSize.width(), edgeSize.height(), templateSize.width() - 2 * edgeSize.width(), templateSize.height() - 2 * edgeSize.height());
 
-    // Only redraw in the scratch buffer if its cached contents don't match our needs
-    bool redrawNeeded = scratchBuffer.setCachedShadowValues(m_blurRadius, m_color, templateShadow, shadowedRect.radii(), m_layerSize);
-    if (redrawNeeded) {
         // Draw shadow into the ImageBuffer.
         GraphicsContext& shadowContext = m_layerImage->context();
         GraphicsContextStateSaver shadowStateSaver(shadowContext);
-
-        shadowContext.clearRect(FloatRect(0, 0, templateSize.width(), templateSize.height()));
         shadowContext.setFillColor(Color::black);
         
         if (shadowedRect.radii().isZero())
@@ -757,7 +844,9 @@ void ShadowBlur::drawRectShadowWithTiling(GraphicsContext& graphicsContext, cons
         }
 
         blurAndColorShadowBuffer(templateSize);
+        m_layerImage = templateCache.add(templateKey, WTF::move(templateImage));
     }
+
     FloatSize offset = m_offset;
     if (shadowsIgnoreTransforms()) {
         AffineTransform transform = graphicsContext.getCTM();
@@ -772,7 +861,6 @@ void ShadowBlur::drawRectShadowWithTiling(GraphicsContext& graphicsContext, cons
     drawLayerPieces(graphicsContext, shadowBounds, shadowedRect.radii(), edgeSize, templateSize, OuterShadow);
 
     m_layerImage = nullptr;
-    ScratchBuffer::singleton().scheduleScratchBufferPurge();
 }
 
 void ShadowBlur::drawLayerPieces(GraphicsContext& graphicsContext, const FloatRect& shadowBounds, const FloatRoundedRect::Radii& radii, const IntSize& bufferPadding, const IntSize& templateSize, ShadowDirection direction)
@@ -915,4 +1003,9 @@ void ShadowBlur::endShadowLayer(GraphicsContext& context)
     ScratchBuffer::singleton().scheduleScratchBufferPurge();
 }
 
+void ShadowBlur::clearTemplateCache()
+{
+    ShadowTemplateCache::singleton().clear();
+}
+
 } // namespace WebCore
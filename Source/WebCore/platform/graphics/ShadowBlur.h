@@ -72,6 +72,9 @@ public:
 
     ShadowType type() const { return m_type; }
 
+    // Drops the blurred templates kept for the tiled rect and inset shadow paths.
+    static void clearTemplateCache();
+
 private:
     void updateShadowBlurValues();
 
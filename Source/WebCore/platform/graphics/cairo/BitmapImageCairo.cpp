@@ -30,6 +30,7 @@
 
 #if USE(CAIRO)
 
+#include "AffineTransform.h"
 #include "CairoUtilities.h"
 #include "ImageObserver.h"
 #include "PlatformContextCairo.h"
@@ -72,7 +73,19 @@ void BitmapImage::draw(GraphicsContext& context, const FloatRect& dst, const Flo
 
     startAnimation();
 
-    RefPtr<cairo_surface_t> surface = frameAtIndex(m_currentFrame);
+    // Decode no more pixels than end up on the screen, except for vector surfaces (e.g. when
+    // printing), which keep the image at full resolution.
+    float subsamplingScale = 1;
+    cairo_surface_type_t targetType = cairo_surface_get_type(cairo_get_target(context.platformContext()->cr()));
+    if (targetType != CAIRO_SURFACE_TYPE_PDF && targetType != CAIRO_SURFACE_TYPE_PS && targetType != CAIRO_SURFACE_TYPE_SVG) {
+        FloatRect transformedDestinationRect = context.getCTM().mapRect(dst);
+        subsamplingScale = std::min<float>(1, std::max(transformedDestinationRect.width() / src.width(), transformedDestinationRect.height() / src.height()));
+    }
+
+    if (context.allowsAsynchronousImageDecoding() && decodeFrameAsynchronouslyIfNeeded(m_currentFrame, subsamplingScale))
+        return;
+
+    RefPtr<cairo_surface_t> surface = frameAtIndex(m_currentFrame, subsamplingScale);
     if (!surface) // If it's too early we won't have an image yet.
         return;
 
@@ -89,12 +102,9 @@ void BitmapImage::draw(GraphicsContext& context, const FloatRect& dst, const Flo
     else
         context.setCompositeOperation(op, blendMode);
 
-#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING)
+    // The frame may have been decoded at a fraction of the image size.
     IntSize scaledSize = cairoSurfaceSize(surface.get());
     FloatRect adjustedSrcRect = adjustSourceRectForDownSampling(src, scaledSize);
-#else
-    FloatRect adjustedSrcRect(src);
-#endif
 
     ImageOrientation frameOrientation(description.imageOrientation());
     if (description.respectImageOrientation() == RespectImageOrientation)
@@ -124,7 +134,9 @@ void BitmapImage::draw(GraphicsContext& context, const FloatRect& dst, const Flo
 
 void BitmapImage::determineMinimumSubsamplingLevel() const
 {
-    m_minimumSubsamplingLevel = 0;
+    // Frames are decoded at the painted size, down to 1/8 of the image size, but only for
+    // images that allow it; see ImageSource::subsamplingLevelForScale().
+    m_minimumSubsamplingLevel = m_allowSubsampling ? 3 : 0;
 }
 
 void BitmapImage::checkForSolidColor()
@@ -219,6 +219,9 @@ void BitmapImage::draw(GraphicsContext& ctxt, const FloatRect& destRect, const F
         CGRect transformedDestinationRect = CGRectApplyAffineTransform(destRect, CGContextGetCTM(ctxt.platformContext()));
         float subsamplingScale = std::min<float>(1, std::max(transformedDestinationRect.size.width / srcRect.width(), transformedDestinationRect.size.height / srcRect.height()));
 
+        if (ctxt.allowsAsynchronousImageDecoding() && decodeFrameAsynchronouslyIfNeeded(m_currentFrame, subsamplingScale))
+            return;
+
         image = frameAtIndex(m_currentFrame, subsamplingScale);
     }
 
@@ -67,9 +67,18 @@ size_t sharedBufferGetBytesAtPosition(void* info, void* buffer, off_t position,
     if (position >= sourceSize)
         return 0;
 
-    const char* source = sharedBuffer->data() + position;
+    // Copy out of the segments directly rather than asking for data(), which would flatten the buffer.
     size_t amount = std::min<size_t>(count, sourceSize - position);
-    memcpy(buffer, source, amount);
+    char* destination = static_cast<char*>(buffer);
+    size_t copied = 0;
+    while (copied < amount) {
+        const char* segment;
+        unsigned length = sharedBuffer->getSomeData(segment, position + copied);
+        ASSERT(length);
+        size_t bytesToCopy = std::min<size_t>(length, amount - copied);
+        memcpy(destination + copied, segment, bytesToCopy);
+        copied += bytesToCopy;
+    }
     return amount;
 }
 
@@ -387,6 +396,22 @@ CGImageRef ImageSource::createFrameAtIndex(size_t index, SubsamplingLevel subsam
     return maskedImage.leakRef();
 }
 
+CGImageRef ImageSource::createDecodedFrameAtIndex(size_t index, SubsamplingLevel subsamplingLevel)
+{
+    RetainPtr<CGImageRef> image = adoptCF(createFrameAtIndex(index, subsamplingLevel));
+    if (!image)
+        return nullptr;
+
+    // CG decodes lazily. The frame is created with kCGImageSourceShouldCache, so drawing it
+    // once decodes it and keeps the pixels with the image.
+    RetainPtr<CGColorSpaceRef> colorSpace = adoptCF(CGColorSpaceCreateDeviceRGB());
+    RetainPtr<CGContextRef> context = adoptCF(CGBitmapContextCreate(nullptr, 1, 1, 8, 4, colorSpace.get(), kCGImageAlphaPremultipliedFirst));
+    if (context)
+        CGContextDrawImage(context.get(), CGRectMake(0, 0, 1, 1), image.get());
+
+    return image.leakRef();
+}
+
 bool ImageSource::frameIsCompleteAtIndex(size_t index)
 {
     ASSERT(frameCount());
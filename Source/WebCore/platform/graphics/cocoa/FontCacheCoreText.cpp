@@ -31,6 +31,7 @@
 
 #include <CoreText/SFNTLayoutTypes.h>
 
+#include <wtf/HashMap.h>
 #include <wtf/HashSet.h>
 #include <wtf/MainThread.h>
 #include <wtf/NeverDestroyed.h>
@@ -568,6 +569,19 @@ Vector<FontTraitsMask> FontCache::getTraitsInFamily(const AtomicString& familyNa
     return traitsMasks;
 }
 
+// Fallback lookups only depend on the face of the original font, not on its size, so remember the
+// descriptor CoreText picked for each (face, weight, character) and instantiate it at the requested size.
+// Descriptors are cheap to keep around; the cache is bounded and dropped whenever the set of installed
+// fonts changes.
+typedef HashMap<std::pair<String, unsigned>, RetainPtr<CTFontDescriptorRef>> FallbackDescriptorCache;
+static const unsigned maxFallbackDescriptorCacheSize = 1024;
+
+static FallbackDescriptorCache& fallbackDescriptorCache()
+{
+    static NeverDestroyed<FallbackDescriptorCache> cache;
+    return cache.get();
+}
+
 static void invalidateFontCache()
 {
     if (!isMainThread()) {
@@ -577,6 +591,8 @@ static void invalidateFontCache()
         return;
     }
 
+    fallbackDescriptorCache().clear();
+
     FontCache::singleton().invalidate();
 
     platformInvalidateFontCache();
@@ -773,6 +789,38 @@ void FontCache::platformPurgeInactiveFontData()
         fallbackDedupSet().remove(font);
 }
 
+static RetainPtr<CTFontRef> lookupFallbackFont(CTFontRef font, FontWeight weight, const UChar* characters, unsigned length)
+{
+    UChar32 character = 0;
+    if (length == 1 && !U16_IS_SURROGATE(characters[0]))
+        character = characters[0];
+    else if (length == 2 && U16_IS_LEAD(characters[0]) && U16_IS_TRAIL(characters[1]))
+        character = U16_GET_SUPPLEMENTARY(characters[0], characters[1]);
+
+    // FIXME: Should pass in the locale instead of nullAtom.
+    if (!font || !character)
+        return platformLookupFallbackFont(font, weight, nullAtom, characters, length);
+
+    RetainPtr<CFStringRef> postScriptName = adoptCF(CTFontCopyPostScriptName(font));
+    // Code points fit in 21 bits, which leaves the upper bits for the weight.
+    auto key = std::make_pair(String(postScriptName.get()), static_cast<unsigned>(weight) << 21 | static_cast<unsigned>(character));
+    auto it = fallbackDescriptorCache().find(key);
+    if (it != fallbackDescriptorCache().end()) {
+        if (!it->value)
+            return nullptr;
+        return adoptCF(CTFontCreateWithFontDescriptor(it->value.get(), CTFontGetSize(font), nullptr));
+    }
+
+    RetainPtr<CTFontRef> result = platformLookupFallbackFont(font, weight, nullAtom, characters, length);
+    if (fallbackDescriptorCache().size() >= maxFallbackDescriptorCacheSize)
+        fallbackDescriptorCache().clear();
+    RetainPtr<CTFontDescriptorRef> descriptor;
+    if (result)
+        descriptor = adoptCF(CTFontCopyFontDescriptor(result.get()));
+    fallbackDescriptorCache().add(WTF::move(key), WTF::move(descriptor));
+    return result;
+}
+
 RefPtr<Font> FontCache::systemFallbackForCharacters(const FontDescription& description, const Font* originalFontData, bool isPlatformFont, const UChar* characters, unsigned length)
 {
 #if PLATFORM(IOS)
@@ -785,8 +833,7 @@ RefPtr<Font> FontCache::systemFallbackForCharacters(const FontDescription& descr
 #endif
 
     const FontPlatformData& platformData = originalFontData->platformData();
-    // FIXME: Should pass in the locale instead of nullAtom.
-    RetainPtr<CTFontRef> result = platformLookupFallbackFont(platformData.font(), description.weight(), nullAtom, characters, length);
+    RetainPtr<CTFontRef> result = lookupFallbackFont(platformData.font(), description.weight(), characters, length);
     result = preparePlatformFont(result.get(), description.textRenderingMode(), nullptr, nullptr, description.featureSettings(), description.variantSettings());
     if (!result)
         return lastResortFallbackFont(description);
@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "DisplayList.h"
+
+namespace WebCore {
+namespace DisplayList {
+
+FloatRect DisplayList::bounds() const
+{
+    FloatRect bounds;
+    for (auto& item : m_list) {
+        if (item->isDrawingItem())
+            bounds.unite(static_cast<const DrawingItem&>(item.get()).extent());
+    }
+    return bounds;
+}
+
+static bool setsStateUsableOnAnyThread(const SetState& item)
+{
+    const GraphicsContextState& state = item.state();
+    if ((item.changes() & SetState::StrokeColorChange) && (state.strokeGradient || state.strokePattern))
+        return false;
+    if ((item.changes() & SetState::FillColorChange) && (state.fillGradient || state.fillPattern))
+        return false;
+    if ((item.changes() & SetState::ShadowChange) && state.shadowColor.isValid())
+        return false;
+    return true;
+}
+
+bool DisplayList::canBeReplayedOnAnyThread() const
+{
+    for (auto& item : m_list) {
+        switch (item->type()) {
+        case ItemType::SetState:
+            if (!setsStateUsableOnAnyThread(static_cast<const SetState&>(item.get())))
+                return false;
+            break;
+        case ItemType::ClipToImage:
+        case ItemType::DrawImage:
+        case ItemType::DrawTiledImage:
+        case ItemType::DrawTiledScaledImage:
+        case ItemType::DrawPattern:
+        case ItemType::FillRectWithGradient:
+            return false;
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+} // namespace DisplayList
+} // namespace WebCore
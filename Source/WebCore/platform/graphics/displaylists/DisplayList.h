@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DisplayList_h
+#define DisplayList_h
+
+#include "DisplayListItems.h"
+#include <wtf/Noncopyable.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+namespace DisplayList {
+
+// The drawing commands issued to a recording GraphicsContext, in order. A list is filled by a
+// DisplayList::Recorder and can then be played back any number of times by a DisplayList::Replayer,
+// entirely or only for the part of the recorded area that needs painting, e.g. one tile of a layer.
+//
+// Items keep references to the images, fonts and gradients they draw, so a list has to be destroyed
+// on the thread that recorded it.
+class DisplayList {
+    WTF_MAKE_NONCOPYABLE(DisplayList); WTF_MAKE_FAST_ALLOCATED;
+    friend class Recorder;
+public:
+    DisplayList() { }
+    DisplayList(DisplayList&&) = default;
+    DisplayList& operator=(DisplayList&&) = default;
+
+    void clear() { m_list.clear(); }
+    bool isEmpty() const { return m_list.isEmpty(); }
+    size_t itemCount() const { return m_list.size(); }
+
+    const Item& itemAt(size_t index) const { return m_list[index].get(); }
+
+    // The union of the extents of the items that paint.
+    FloatRect bounds() const;
+
+    // Whether the list can be played back on a thread other than the one that recorded it. Images,
+    // patterns and gradients cache their platform data lazily and shadows share a scratch buffer, so
+    // lists using any of them have to be replayed on the recording thread.
+    bool canBeReplayedOnAnyThread() const;
+
+private:
+    void append(Ref<Item>&& item) { m_list.append(WTF::move(item)); }
+    Item& lastItem() { return m_list.last().get(); }
+    void removeLastItem() { m_list.removeLast(); }
+
+    Vector<Ref<Item>> m_list;
+};
+
+} // namespace DisplayList
+} // namespace WebCore
+
+#endif // DisplayList_h
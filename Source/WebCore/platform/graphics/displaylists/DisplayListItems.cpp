@@ -0,0 +1,351 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "DisplayListItems.h"
+
+#include "ImageBuffer.h"
+
+namespace WebCore {
+namespace DisplayList {
+
+void Save::apply(GraphicsContext& context) const
+{
+    context.save();
+}
+
+void Restore::apply(GraphicsContext& context) const
+{
+    context.restore();
+}
+
+void Translate::apply(GraphicsContext& context) const
+{
+    context.translate(m_x, m_y);
+}
+
+void Rotate::apply(GraphicsContext& context) const
+{
+    context.rotate(m_angle);
+}
+
+void Scale::apply(GraphicsContext& context) const
+{
+    context.scale(m_size);
+}
+
+void ConcatenateCTM::apply(GraphicsContext& context) const
+{
+    context.concatCTM(m_transform);
+}
+
+void SetCTM::apply(GraphicsContext&) const
+{
+    // Replayer::replay() applies this item relative to the transform it started with.
+    ASSERT_NOT_REACHED();
+}
+
+SetState::ChangeFlags SetState::changesBetween(const GraphicsContextState& a, const GraphicsContextState& b)
+{
+    ChangeFlags changes = 0;
+
+    if (a.strokeThickness != b.strokeThickness)
+        changes |= StrokeThicknessChange;
+    if (a.strokeStyle != b.strokeStyle)
+        changes |= StrokeStyleChange;
+    if (a.strokeColor != b.strokeColor || a.strokeGradient != b.strokeGradient || a.strokePattern != b.strokePattern)
+        changes |= StrokeColorChange;
+    if (a.fillColor != b.fillColor || a.fillGradient != b.fillGradient || a.fillPattern != b.fillPattern)
+        changes |= FillColorChange;
+    if (a.fillRule != b.fillRule)
+        changes |= FillRuleChange;
+    if (a.shadowOffset != b.shadowOffset || a.shadowBlur != b.shadowBlur || a.shadowColor != b.shadowColor || a.shadowsIgnoreTransforms != b.shadowsIgnoreTransforms)
+        changes |= ShadowChange;
+    if (a.alpha != b.alpha)
+        changes |= AlphaChange;
+    if (a.compositeOperator != b.compositeOperator || a.blendMode != b.blendMode)
+        changes |= CompositeOperationChange;
+    if (a.imageInterpolationQuality != b.imageInterpolationQuality)
+        changes |= ImageInterpolationQualityChange;
+    if (a.textDrawingMode != b.textDrawingMode)
+        changes |= TextDrawingModeChange;
+    if (a.shouldAntialias != b.shouldAntialias)
+        changes |= ShouldAntialiasChange;
+    if (a.shouldSmoothFonts != b.shouldSmoothFonts)
+        changes |= ShouldSmoothFontsChange;
+    if (a.antialiasedFontDilationEnabled != b.antialiasedFontDilationEnabled)
+        changes |= AntialiasedFontDilationEnabledChange;
+    if (a.shouldSubpixelQuantizeFonts != b.shouldSubpixelQuantizeFonts)
+        changes |= ShouldSubpixelQuantizeFontsChange;
+    if (a.drawLuminanceMask != b.drawLuminanceMask)
+        changes |= DrawLuminanceMaskChange;
+
+    return changes;
+}
+
+void SetState::apply(GraphicsContext& context) const
+{
+    if (m_changes & StrokeThicknessChange)
+        context.setStrokeThickness(m_state.strokeThickness);
+    if (m_changes & StrokeStyleChange)
+        context.setStrokeStyle(m_state.strokeStyle);
+    if (m_changes & StrokeColorChange) {
+        // Setting the color clears the gradient and the pattern, so it has to come first.
+        context.setStrokeColor(m_state.strokeColor);
+        if (m_state.strokeGradient)
+            context.setStrokeGradient(*m_state.strokeGradient);
+        else if (m_state.strokePattern)
+            context.setStrokePattern(*m_state.strokePattern);
+    }
+    if (m_changes & FillColorChange) {
+        context.setFillColor(m_state.fillColor);
+        if (m_state.fillGradient)
+            context.setFillGradient(*m_state.fillGradient);
+        else if (m_state.fillPattern)
+            context.setFillPattern(*m_state.fillPattern);
+    }
+    if (m_changes & FillRuleChange)
+        context.setFillRule(m_state.fillRule);
+    if (m_changes & ShadowChange) {
+        context.setShadowsIgnoreTransforms(m_state.shadowsIgnoreTransforms);
+        if (m_state.shadowColor.isValid())
+            context.setShadow(m_state.shadowOffset, m_state.shadowBlur, m_state.shadowColor);
+        else
+            context.clearShadow();
+    }
+    if (m_changes & AlphaChange)
+        context.setAlpha(m_state.alpha);
+    if (m_changes & CompositeOperationChange)
+        context.setCompositeOperation(m_state.compositeOperator, m_state.blendMode);
+    if (m_changes & ImageInterpolationQualityChange)
+        context.setImageInterpolationQuality(m_state.imageInterpolationQuality);
+    if (m_changes & TextDrawingModeChange)
+        context.setTextDrawingMode(m_state.textDrawingMode);
+    if (m_changes & ShouldAntialiasChange)
+        context.setShouldAntialias(m_state.shouldAntialias);
+    if (m_changes & ShouldSmoothFontsChange)
+        context.setShouldSmoothFonts(m_state.shouldSmoothFonts);
+    if (m_changes & AntialiasedFontDilationEnabledChange)
+        context.setAntialiasedFontDilationEnabled(m_state.antialiasedFontDilationEnabled);
+    if (m_changes & ShouldSubpixelQuantizeFontsChange)
+        context.setShouldSubpixelQuantizeFonts(m_state.shouldSubpixelQuantizeFonts);
+    if (m_changes & DrawLuminanceMaskChange)
+        context.setDrawLuminanceMask(m_state.drawLuminanceMask);
+}
+
+void SetLineCap::apply(GraphicsContext& context) const
+{
+    context.setLineCap(m_lineCap);
+}
+
+void SetLineDash::apply(GraphicsContext& context) const
+{
+    context.setLineDash(m_dashArray, m_dashOffset);
+}
+
+void SetLineJoin::apply(GraphicsContext& context) const
+{
+    context.setLineJoin(m_lineJoin);
+}
+
+void SetMiterLimit::apply(GraphicsContext& context) const
+{
+    context.setMiterLimit(m_miterLimit);
+}
+
+void Clip::apply(GraphicsContext& context) const
+{
+    context.clip(m_rect);
+}
+
+void ClipOut::apply(GraphicsContext& context) const
+{
+    context.clipOut(m_rect);
+}
+
+void ClipOutToPath::apply(GraphicsContext& context) const
+{
+    context.clipOut(m_path);
+}
+
+void ClipPath::apply(GraphicsContext& context) const
+{
+    context.clipPath(m_path, m_windRule);
+}
+
+void ClipConvexPolygon::apply(GraphicsContext& context) const
+{
+    context.clipConvexPolygon(m_points.size(), m_points.data(), m_antialiased);
+}
+
+void ClipToImage::apply(GraphicsContext& context) const
+{
+    std::unique_ptr<ImageBuffer> mask = ImageBuffer::create(m_image->size(), Unaccelerated);
+    if (!mask)
+        return;
+
+    mask->context().drawImage(m_image.get(), FloatPoint());
+    context.clipToImageBuffer(*mask, m_destination);
+}
+
+void BeginTransparencyLayer::apply(GraphicsContext& context) const
+{
+    context.beginTransparencyLayer(m_opacity);
+}
+
+void EndTransparencyLayer::apply(GraphicsContext& context) const
+{
+    context.endTransparencyLayer();
+}
+
+DrawGlyphs::DrawGlyphs(const FontCascade& fontCascade, const Font& font, const GlyphBuffer& glyphBuffer, int from, int numGlyphs, const FloatPoint& point)
+    : DrawingItem(ItemType::DrawGlyphs)
+    , m_fontCascade(fontCascade)
+    , m_font(const_cast<Font&>(font))
+    , m_point(point)
+{
+    m_glyphs.reserveInitialCapacity(numGlyphs);
+    m_advances.reserveInitialCapacity(numGlyphs);
+    for (int i = 0; i < numGlyphs; ++i) {
+        m_glyphs.uncheckedAppend(glyphBuffer.glyphAt(from + i));
+        m_advances.uncheckedAppend(glyphBuffer.advanceAt(from + i));
+    }
+}
+
+void DrawGlyphs::apply(GraphicsContext& context) const
+{
+    GlyphBuffer glyphBuffer;
+    for (size_t i = 0; i < m_glyphs.size(); ++i)
+        glyphBuffer.add(m_glyphs[i], m_font.ptr(), m_advances[i]);
+    context.drawGlyphs(m_fontCascade, m_font.get(), glyphBuffer, 0, glyphBuffer.size(), m_point);
+}
+
+void DrawImage::apply(GraphicsContext& context) const
+{
+    context.drawImage(m_image.get(), m_destination, m_source, m_options);
+}
+
+void DrawTiledImage::apply(GraphicsContext& context) const
+{
+    context.drawTiledImage(m_image.get(), m_destination, m_source, m_tileSize, m_spacing, m_options);
+}
+
+void DrawTiledScaledImage::apply(GraphicsContext& context) const
+{
+    context.drawTiledImage(m_image.get(), m_destination, m_source, m_tileScaleFactor, m_hRule, m_vRule, m_options);
+}
+
+void DrawPattern::apply(GraphicsContext& context) const
+{
+    context.drawPattern(m_image.get(), m_tileRect, m_patternTransform, m_phase, m_spacing, m_op, m_destRect, m_blendMode);
+}
+
+void DrawRect::apply(GraphicsContext& context) const
+{
+    context.drawRect(m_rect, m_borderThickness);
+}
+
+void DrawLine::apply(GraphicsContext& context) const
+{
+    context.drawLine(m_point1, m_point2);
+}
+
+void DrawLinesForText::apply(GraphicsContext& context) const
+{
+    context.drawLinesForText(m_point, m_widths, m_printing, m_doubleLines);
+}
+
+void DrawLineForDocumentMarker::apply(GraphicsContext& context) const
+{
+    context.drawLineForDocumentMarker(m_point, m_width, m_style);
+}
+
+void DrawEllipse::apply(GraphicsContext& context) const
+{
+    context.drawEllipse(m_rect);
+}
+
+void DrawConvexPolygon::apply(GraphicsContext& context) const
+{
+    context.drawConvexPolygon(m_points.size(), m_points.data(), m_antialiased);
+}
+
+void DrawFocusRingPath::apply(GraphicsContext& context) const
+{
+    context.drawFocusRing(m_path, m_width, m_offset, m_color);
+}
+
+void DrawFocusRingRects::apply(GraphicsContext& context) const
+{
+    context.drawFocusRing(m_rects, m_width, m_offset, m_color);
+}
+
+void FillRect::apply(GraphicsContext& context) const
+{
+    context.fillRect(m_rect);
+}
+
+void FillRectWithColor::apply(GraphicsContext& context) const
+{
+    context.fillRect(m_rect, m_color);
+}
+
+void FillRectWithGradient::apply(GraphicsContext& context) const
+{
+    context.fillRect(m_rect, m_gradient.get());
+}
+
+void FillRoundedRect::apply(GraphicsContext& context) const
+{
+    context.fillRoundedRect(m_rect, m_color, context.blendModeOperation());
+}
+
+void FillRectWithRoundedHole::apply(GraphicsContext& context) const
+{
+    context.fillRectWithRoundedHole(m_rect, m_roundedHoleRect, m_color);
+}
+
+void FillPath::apply(GraphicsContext& context) const
+{
+    context.fillPath(m_path);
+}
+
+void StrokeRect::apply(GraphicsContext& context) const
+{
+    context.strokeRect(m_rect, m_lineWidth);
+}
+
+void StrokePath::apply(GraphicsContext& context) const
+{
+    context.strokePath(m_path);
+}
+
+void ClearRect::apply(GraphicsContext& context) const
+{
+    context.clearRect(m_rect);
+}
+
+} // namespace DisplayList
+} // namespace WebCore
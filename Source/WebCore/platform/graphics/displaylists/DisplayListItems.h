@@ -0,0 +1,941 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DisplayListItems_h
+#define DisplayListItems_h
+
+#include "FloatRoundedRect.h"
+#include "FontCascade.h"
+#include "GlyphBuffer.h"
+#include "GraphicsContext.h"
+#include "Image.h"
+#include <wtf/RefCounted.h>
+
+namespace WebCore {
+
+namespace DisplayList {
+
+enum class ItemType {
+    Save,
+    Restore,
+    Translate,
+    Rotate,
+    Scale,
+    ConcatenateCTM,
+    SetCTM,
+    SetState,
+    SetLineCap,
+    SetLineDash,
+    SetLineJoin,
+    SetMiterLimit,
+    Clip,
+    ClipOut,
+    ClipOutToPath,
+    ClipPath,
+    ClipConvexPolygon,
+    ClipToImage,
+    BeginTransparencyLayer,
+    EndTransparencyLayer,
+    DrawGlyphs,
+    DrawImage,
+    DrawTiledImage,
+    DrawTiledScaledImage,
+    DrawPattern,
+    DrawRect,
+    DrawLine,
+    DrawLinesForText,
+    DrawLineForDocumentMarker,
+    DrawEllipse,
+    DrawConvexPolygon,
+    DrawFocusRingPath,
+    DrawFocusRingRects,
+    FillRect,
+    FillRectWithColor,
+    FillRectWithGradient,
+    FillRoundedRect,
+    FillRectWithRoundedHole,
+    FillPath,
+    StrokeRect,
+    StrokePath,
+    ClearRect,
+};
+
+class Item : public RefCounted<Item> {
+public:
+    virtual ~Item() { }
+
+    ItemType type() const { return m_type; }
+    virtual bool isDrawingItem() const { return false; }
+
+    virtual void apply(GraphicsContext&) const = 0;
+
+protected:
+    explicit Item(ItemType type)
+        : m_type(type)
+    {
+    }
+
+private:
+    ItemType m_type;
+};
+
+// An item that paints. Its extent is the area it can touch, in the coordinate space recording started
+// in, already clipped to the clip in effect when it was recorded; replaying part of a list skips the
+// items whose extent is outside of that part.
+class DrawingItem : public Item {
+public:
+    const FloatRect& extent() const { return m_extent; }
+    void setExtent(const FloatRect& extent) { m_extent = extent; }
+
+protected:
+    explicit DrawingItem(ItemType type)
+        : Item(type)
+    {
+    }
+
+private:
+    bool isDrawingItem() const override { return true; }
+
+    FloatRect m_extent;
+};
+
+class Save : public Item {
+public:
+    static Ref<Save> create() { return adoptRef(*new Save); }
+
+private:
+    Save()
+        : Item(ItemType::Save)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+};
+
+class Restore : public Item {
+public:
+    static Ref<Restore> create() { return adoptRef(*new Restore); }
+
+private:
+    Restore()
+        : Item(ItemType::Restore)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+};
+
+class Translate : public Item {
+public:
+    static Ref<Translate> create(float x, float y) { return adoptRef(*new Translate(x, y)); }
+
+private:
+    Translate(float x, float y)
+        : Item(ItemType::Translate)
+        , m_x(x)
+        , m_y(y)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    float m_x;
+    float m_y;
+};
+
+class Rotate : public Item {
+public:
+    static Ref<Rotate> create(float angleInRadians) { return adoptRef(*new Rotate(angleInRadians)); }
+
+private:
+    explicit Rotate(float angle)
+        : Item(ItemType::Rotate)
+        , m_angle(angle)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    float m_angle;
+};
+
+class Scale : public Item {
+public:
+    static Ref<Scale> create(const FloatSize& size) { return adoptRef(*new Scale(size)); }
+
+private:
+    explicit Scale(const FloatSize& size)
+        : Item(ItemType::Scale)
+        , m_size(size)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    FloatSize m_size;
+};
+
+class ConcatenateCTM : public Item {
+public:
+    static Ref<ConcatenateCTM> create(const AffineTransform& transform) { return adoptRef(*new ConcatenateCTM(transform)); }
+
+private:
+    explicit ConcatenateCTM(const AffineTransform& transform)
+        : Item(ItemType::ConcatenateCTM)
+        , m_transform(transform)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    AffineTransform m_transform;
+};
+
+// The transform is relative to the one recording started with; the replayer maps it onto the one
+// replaying started with, so it can't be applied on its own.
+class SetCTM : public Item {
+public:
+    static Ref<SetCTM> create(const AffineTransform& transform) { return adoptRef(*new SetCTM(transform)); }
+
+    const AffineTransform& transform() const { return m_transform; }
+
+private:
+    explicit SetCTM(const AffineTransform& transform)
+        : Item(ItemType::SetCTM)
+        , m_transform(transform)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    AffineTransform m_transform;
+};
+
+// The GraphicsContextState changes made since the previous drawing item. Recorded lazily, right before
+// the next item that paints, so a run of setters collapses into one item and unused changes cost nothing.
+class SetState : public Item {
+public:
+    enum Change {
+        StrokeThicknessChange = 1 << 0,
+        StrokeStyleChange = 1 << 1,
+        StrokeColorChange = 1 << 2,
+        FillColorChange = 1 << 3,
+        FillRuleChange = 1 << 4,
+        ShadowChange = 1 << 5,
+        AlphaChange = 1 << 6,
+        CompositeOperationChange = 1 << 7,
+        ImageInterpolationQualityChange = 1 << 8,
+        TextDrawingModeChange = 1 << 9,
+        ShouldAntialiasChange = 1 << 10,
+        ShouldSmoothFontsChange = 1 << 11,
+        AntialiasedFontDilationEnabledChange = 1 << 12,
+        ShouldSubpixelQuantizeFontsChange = 1 << 13,
+        DrawLuminanceMaskChange = 1 << 14,
+        AllChanges = (1 << 15) - 1
+    };
+    typedef unsigned ChangeFlags;
+
+    static ChangeFlags changesBetween(const GraphicsContextState&, const GraphicsContextState&);
+
+    static Ref<SetState> create(const GraphicsContextState& state, ChangeFlags changes) { return adoptRef(*new SetState(state, changes)); }
+
+    const GraphicsContextState& state() const { return m_state; }
+    ChangeFlags changes() const { return m_changes; }
+
+private:
+    SetState(const GraphicsContextState& state, ChangeFlags changes)
+        : Item(ItemType::SetState)
+        , m_state(state)
+        , m_changes(changes)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    GraphicsContextState m_state;
+    ChangeFlags m_changes;
+};
+
+class SetLineCap : public Item {
+public:
+    static Ref<SetLineCap> create(LineCap lineCap) { return adoptRef(*new SetLineCap(lineCap)); }
+
+private:
+    explicit SetLineCap(LineCap lineCap)
+        : Item(ItemType::SetLineCap)
+        , m_lineCap(lineCap)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    LineCap m_lineCap;
+};
+
+class SetLineDash : public Item {
+public:
+    static Ref<SetLineDash> create(const DashArray& dashArray, float dashOffset) { return adoptRef(*new SetLineDash(dashArray, dashOffset)); }
+
+private:
+    SetLineDash(const DashArray& dashArray, float dashOffset)
+        : Item(ItemType::SetLineDash)
+        , m_dashArray(dashArray)
+        , m_dashOffset(dashOffset)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    DashArray m_dashArray;
+    float m_dashOffset;
+};
+
+class SetLineJoin : public Item {
+public:
+    static Ref<SetLineJoin> create(LineJoin lineJoin) { return adoptRef(*new SetLineJoin(lineJoin)); }
+
+private:
+    explicit SetLineJoin(LineJoin lineJoin)
+        : Item(ItemType::SetLineJoin)
+        , m_lineJoin(lineJoin)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    LineJoin m_lineJoin;
+};
+
+class SetMiterLimit : public Item {
+public:
+    static Ref<SetMiterLimit> create(float miterLimit) { return adoptRef(*new SetMiterLimit(miterLimit)); }
+
+private:
+    explicit SetMiterLimit(float miterLimit)
+        : Item(ItemType::SetMiterLimit)
+        , m_miterLimit(miterLimit)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    float m_miterLimit;
+};
+
+class Clip : public Item {
+public:
+    static Ref<Clip> create(const FloatRect& rect) { return adoptRef(*new Clip(rect)); }
+
+private:
+    explicit Clip(const FloatRect& rect)
+        : Item(ItemType::Clip)
+        , m_rect(rect)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    FloatRect m_rect;
+};
+
+class ClipOut : public Item {
+public:
+    static Ref<ClipOut> create(const FloatRect& rect) { return adoptRef(*new ClipOut(rect)); }
+
+private:
+    explicit ClipOut(const FloatRect& rect)
+        : Item(ItemType::ClipOut)
+        , m_rect(rect)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    FloatRect m_rect;
+};
+
+class ClipOutToPath : public Item {
+public:
+    static Ref<ClipOutToPath> create(const Path& path) { return adoptRef(*new ClipOutToPath(path)); }
+
+private:
+    explicit ClipOutToPath(const Path& path)
+        : Item(ItemType::ClipOutToPath)
+        , m_path(path)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    Path m_path;
+};
+
+class ClipPath : public Item {
+public:
+    static Ref<ClipPath> create(const Path& path, WindRule windRule) { return adoptRef(*new ClipPath(path, windRule)); }
+
+private:
+    ClipPath(const Path& path, WindRule windRule)
+        : Item(ItemType::ClipPath)
+        , m_path(path)
+        , m_windRule(windRule)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    Path m_path;
+    WindRule m_windRule;
+};
+
+class ClipConvexPolygon : public Item {
+public:
+    static Ref<ClipConvexPolygon> create(size_t numPoints, const FloatPoint* points, bool antialiased) { return adoptRef(*new ClipConvexPolygon(numPoints, points, antialiased)); }
+
+private:
+    ClipConvexPolygon(size_t numPoints, const FloatPoint* points, bool antialiased)
+        : Item(ItemType::ClipConvexPolygon)
+        , m_points(points, numPoints)
+        , m_antialiased(antialiased)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    Vector<FloatPoint> m_points;
+    bool m_antialiased;
+};
+
+// Holds a copy of the mask, since the ImageBuffer it came from keeps changing after recording.
+class ClipToImage : public Item {
+public:
+    static Ref<ClipToImage> create(Image& image, const FloatRect& destination) { return adoptRef(*new ClipToImage(image, destination)); }
+
+private:
+    ClipToImage(Image& image, const FloatRect& destination)
+        : Item(ItemType::ClipToImage)
+        , m_image(image)
+        , m_destination(destination)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    Ref<Image> m_image;
+    FloatRect m_destination;
+};
+
+class BeginTransparencyLayer : public Item {
+public:
+    static Ref<BeginTransparencyLayer> create(float opacity) { return adoptRef(*new BeginTransparencyLayer(opacity)); }
+
+private:
+    explicit BeginTransparencyLayer(float opacity)
+        : Item(ItemType::BeginTransparencyLayer)
+        , m_opacity(opacity)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    float m_opacity;
+};
+
+class EndTransparencyLayer : public Item {
+public:
+    static Ref<EndTransparencyLayer> create() { return adoptRef(*new EndTransparencyLayer); }
+
+private:
+    EndTransparencyLayer()
+        : Item(ItemType::EndTransparencyLayer)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+};
+
+class DrawGlyphs : public DrawingItem {
+public:
+    static Ref<DrawGlyphs> create(const FontCascade& fontCascade, const Font& font, const GlyphBuffer& glyphBuffer, int from, int numGlyphs, const FloatPoint& point)
+    {
+        return adoptRef(*new DrawGlyphs(fontCascade, font, glyphBuffer, from, numGlyphs, point));
+    }
+
+private:
+    DrawGlyphs(const FontCascade&, const Font&, const GlyphBuffer&, int from, int numGlyphs, const FloatPoint&);
+
+    void apply(GraphicsContext&) const override;
+
+    FontCascade m_fontCascade;
+    Ref<Font> m_font;
+    Vector<Glyph> m_glyphs;
+    Vector<GlyphBufferAdvance> m_advances;
+    FloatPoint m_point;
+};
+
+class DrawImage : public DrawingItem {
+public:
+    static Ref<DrawImage> create(Image& image, const FloatRect& destination, const FloatRect& source, const ImagePaintingOptions& options)
+    {
+        return adoptRef(*new DrawImage(image, destination, source, options));
+    }
+
+private:
+    DrawImage(Image& image, const FloatRect& destination, const FloatRect& source, const ImagePaintingOptions& options)
+        : DrawingItem(ItemType::DrawImage)
+        , m_image(image)
+        , m_destination(destination)
+        , m_source(source)
+        , m_options(options)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    Ref<Image> m_image;
+    FloatRect m_destination;
+    FloatRect m_source;
+    ImagePaintingOptions m_options;
+};
+
+class DrawTiledImage : public DrawingItem {
+public:
+    static Ref<DrawTiledImage> create(Image& image, const FloatRect& destination, const FloatPoint& source, const FloatSize& tileSize, const FloatSize& spacing, const ImagePaintingOptions& options)
+    {
+        return adoptRef(*new DrawTiledImage(image, destination, source, tileSize, spacing, options));
+    }
+
+private:
+    DrawTiledImage(Image& image, const FloatRect& destination, const FloatPoint& source, const FloatSize& tileSize, const FloatSize& spacing, const ImagePaintingOptions& options)
+        : DrawingItem(ItemType::DrawTiledImage)
+        , m_image(image)
+        , m_destination(destination)
+        , m_source(source)
+        , m_tileSize(tileSize)
+        , m_spacing(spacing)
+        , m_options(options)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    Ref<Image> m_image;
+    FloatRect m_destination;
+    FloatPoint m_source;
+    FloatSize m_tileSize;
+    FloatSize m_spacing;
+    ImagePaintingOptions m_options;
+};
+
+class DrawTiledScaledImage : public DrawingItem {
+public:
+    static Ref<DrawTiledScaledImage> create(Image& image, const FloatRect& destination, const FloatRect& source, const FloatSize& tileScaleFactor, Image::TileRule hRule, Image::TileRule vRule, const ImagePaintingOptions& options)
+    {
+        return adoptRef(*new DrawTiledScaledImage(image, destination, source, tileScaleFactor, hRule, vRule, options));
+    }
+
+private:
+    DrawTiledScaledImage(Image& image, const FloatRect& destination, const FloatRect& source, const FloatSize& tileScaleFactor, Image::TileRule hRule, Image::TileRule vRule, const ImagePaintingOptions& options)
+        : DrawingItem(ItemType::DrawTiledScaledImage)
+        , m_image(image)
+        , m_destination(destination)
+        , m_source(source)
+        , m_tileScaleFactor(tileScaleFactor)
+        , m_hRule(hRule)
+        , m_vRule(vRule)
+        , m_options(options)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    Ref<Image> m_image;
+    FloatRect m_destination;
+    FloatRect m_source;
+    FloatSize m_tileScaleFactor;
+    Image::TileRule m_hRule;
+    Image::TileRule m_vRule;
+    ImagePaintingOptions m_options;
+};
+
+class DrawPattern : public DrawingItem {
+public:
+    static Ref<DrawPattern> create(Image& image, const FloatRect& tileRect, const AffineTransform& patternTransform, const FloatPoint& phase, const FloatSize& spacing, CompositeOperator op, const FloatRect& destRect, BlendMode blendMode)
+    {
+        return adoptRef(*new DrawPattern(image, tileRect, patternTransform, phase, spacing, op, destRect, blendMode));
+    }
+
+private:
+    DrawPattern(Image& image, const FloatRect& tileRect, const AffineTransform& patternTransform, const FloatPoint& phase, const FloatSize& spacing, CompositeOperator op, const FloatRect& destRect, BlendMode blendMode)
+        : DrawingItem(ItemType::DrawPattern)
+        , m_image(image)
+        , m_tileRect(tileRect)
+        , m_patternTransform(patternTransform)
+        , m_phase(phase)
+        , m_spacing(spacing)
+        , m_op(op)
+        , m_destRect(destRect)
+        , m_blendMode(blendMode)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    Ref<Image> m_image;
+    FloatRect m_tileRect;
+    AffineTransform m_patternTransform;
+    FloatPoint m_phase;
+    FloatSize m_spacing;
+    CompositeOperator m_op;
+    FloatRect m_destRect;
+    BlendMode m_blendMode;
+};
+
+class DrawRect : public DrawingItem {
+public:
+    static Ref<DrawRect> create(const FloatRect& rect, float borderThickness) { return adoptRef(*new DrawRect(rect, borderThickness)); }
+
+private:
+    DrawRect(const FloatRect& rect, float borderThickness)
+        : DrawingItem(ItemType::DrawRect)
+        , m_rect(rect)
+        , m_borderThickness(borderThickness)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    FloatRect m_rect;
+    float m_borderThickness;
+};
+
+class DrawLine : public DrawingItem {
+public:
+    static Ref<DrawLine> create(const FloatPoint& point1, const FloatPoint& point2) { return adoptRef(*new DrawLine(point1, point2)); }
+
+private:
+    DrawLine(const FloatPoint& point1, const FloatPoint& point2)
+        : DrawingItem(ItemType::DrawLine)
+        , m_point1(point1)
+        , m_point2(point2)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    FloatPoint m_point1;
+    FloatPoint m_point2;
+};
+
+class DrawLinesForText : public DrawingItem {
+public:
+    static Ref<DrawLinesForText> create(const FloatPoint& point, const DashArray& widths, bool printing, bool doubleLines)
+    {
+        return adoptRef(*new DrawLinesForText(point, widths, printing, doubleLines));
+    }
+
+private:
+    DrawLinesForText(const FloatPoint& point, const DashArray& widths, bool printing, bool doubleLines)
+        : DrawingItem(ItemType::DrawLinesForText)
+        , m_point(point)
+        , m_widths(widths)
+        , m_printing(printing)
+        , m_doubleLines(doubleLines)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    FloatPoint m_point;
+    DashArray m_widths;
+    bool m_printing;
+    bool m_doubleLines;
+};
+
+class DrawLineForDocumentMarker : public DrawingItem {
+public:
+    static Ref<DrawLineForDocumentMarker> create(const FloatPoint& point, float width, GraphicsContext::DocumentMarkerLineStyle style)
+    {
+        return adoptRef(*new DrawLineForDocumentMarker(point, width, style));
+    }
+
+private:
+    DrawLineForDocumentMarker(const FloatPoint& point, float width, GraphicsContext::DocumentMarkerLineStyle style)
+        : DrawingItem(ItemType::DrawLineForDocumentMarker)
+        , m_point(point)
+        , m_width(width)
+        , m_style(style)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    FloatPoint m_point;
+    float m_width;
+    GraphicsContext::DocumentMarkerLineStyle m_style;
+};
+
+class DrawEllipse : public DrawingItem {
+public:
+    static Ref<DrawEllipse> create(const FloatRect& rect) { return adoptRef(*new DrawEllipse(rect)); }
+
+private:
+    explicit DrawEllipse(const FloatRect& rect)
+        : DrawingItem(ItemType::DrawEllipse)
+        , m_rect(rect)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    FloatRect m_rect;
+};
+
+class DrawConvexPolygon : public DrawingItem {
+public:
+    static Ref<DrawConvexPolygon> create(size_t numPoints, const FloatPoint* points, bool antialiased) { return adoptRef(*new DrawConvexPolygon(numPoints, points, antialiased)); }
+
+private:
+    DrawConvexPolygon(size_t numPoints, const FloatPoint* points, bool antialiased)
+        : DrawingItem(ItemType::DrawConvexPolygon)
+        , m_points(points, numPoints)
+        , m_antialiased(antialiased)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    Vector<FloatPoint> m_points;
+    bool m_antialiased;
+};
+
+class DrawFocusRingPath : public DrawingItem {
+public:
+    static Ref<DrawFocusRingPath> create(const Path& path, int width, int offset, const Color& color) { return adoptRef(*new DrawFocusRingPath(path, width, offset, color)); }
+
+private:
+    DrawFocusRingPath(const Path& path, int width, int offset, const Color& color)
+        : DrawingItem(ItemType::DrawFocusRingPath)
+        , m_path(path)
+        , m_width(width)
+        , m_offset(offset)
+        , m_color(color)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    Path m_path;
+    int m_width;
+    int m_offset;
+    Color m_color;
+};
+
+class DrawFocusRingRects : public DrawingItem {
+public:
+    static Ref<DrawFocusRingRects> create(const Vector<IntRect>& rects, int width, int offset, const Color& color) { return adoptRef(*new DrawFocusRingRects(rects, width, offset, color)); }
+
+private:
+    DrawFocusRingRects(const Vector<IntRect>& rects, int width, int offset, const Color& color)
+        : DrawingItem(ItemType::DrawFocusRingRects)
+        , m_rects(rects)
+        , m_width(width)
+        , m_offset(offset)
+        , m_color(color)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    Vector<IntRect> m_rects;
+    int m_width;
+    int m_offset;
+    Color m_color;
+};
+
+class FillRect : public DrawingItem {
+public:
+    static Ref<FillRect> create(const FloatRect& rect) { return adoptRef(*new FillRect(rect)); }
+
+private:
+    explicit FillRect(const FloatRect& rect)
+        : DrawingItem(ItemType::FillRect)
+        , m_rect(rect)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    FloatRect m_rect;
+};
+
+class FillRectWithColor : public DrawingItem {
+public:
+    static Ref<FillRectWithColor> create(const FloatRect& rect, const Color& color) { return adoptRef(*new FillRectWithColor(rect, color)); }
+
+private:
+    FillRectWithColor(const FloatRect& rect, const Color& color)
+        : DrawingItem(ItemType::FillRectWithColor)
+        , m_rect(rect)
+        , m_color(color)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    FloatRect m_rect;
+    Color m_color;
+};
+
+class FillRectWithGradient : public DrawingItem {
+public:
+    static Ref<FillRectWithGradient> create(const FloatRect& rect, Gradient& gradient) { return adoptRef(*new FillRectWithGradient(rect, gradient)); }
+
+private:
+    FillRectWithGradient(const FloatRect& rect, Gradient& gradient)
+        : DrawingItem(ItemType::FillRectWithGradient)
+        , m_rect(rect)
+        , m_gradient(gradient)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    FloatRect m_rect;
+    Ref<Gradient> m_gradient;
+};
+
+// The blend mode is part of the recorded state; see GraphicsContext::fillRoundedRect().
+class FillRoundedRect : public DrawingItem {
+public:
+    static Ref<FillRoundedRect> create(const FloatRoundedRect& rect, const Color& color) { return adoptRef(*new FillRoundedRect(rect, color)); }
+
+private:
+    FillRoundedRect(const FloatRoundedRect& rect, const Color& color)
+        : DrawingItem(ItemType::FillRoundedRect)
+        , m_rect(rect)
+        , m_color(color)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    FloatRoundedRect m_rect;
+    Color m_color;
+};
+
+class FillRectWithRoundedHole : public DrawingItem {
+public:
+    static Ref<FillRectWithRoundedHole> create(const FloatRect& rect, const FloatRoundedRect& roundedHoleRect, const Color& color)
+    {
+        return adoptRef(*new FillRectWithRoundedHole(rect, roundedHoleRect, color));
+    }
+
+private:
+    FillRectWithRoundedHole(const FloatRect& rect, const FloatRoundedRect& roundedHoleRect, const Color& color)
+        : DrawingItem(ItemType::FillRectWithRoundedHole)
+        , m_rect(rect)
+        , m_roundedHoleRect(roundedHoleRect)
+        , m_color(color)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    FloatRect m_rect;
+    FloatRoundedRect m_roundedHoleRect;
+    Color m_color;
+};
+
+class FillPath : public DrawingItem {
+public:
+    static Ref<FillPath> create(const Path& path) { return adoptRef(*new FillPath(path)); }
+
+private:
+    explicit FillPath(const Path& path)
+        : DrawingItem(ItemType::FillPath)
+        , m_path(path)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    Path m_path;
+};
+
+class StrokeRect : public DrawingItem {
+public:
+    static Ref<StrokeRect> create(const FloatRect& rect, float lineWidth) { return adoptRef(*new StrokeRect(rect, lineWidth)); }
+
+private:
+    StrokeRect(const FloatRect& rect, float lineWidth)
+        : DrawingItem(ItemType::StrokeRect)
+        , m_rect(rect)
+        , m_lineWidth(lineWidth)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    FloatRect m_rect;
+    float m_lineWidth;
+};
+
+class StrokePath : public DrawingItem {
+public:
+    static Ref<StrokePath> create(const Path& path) { return adoptRef(*new StrokePath(path)); }
+
+private:
+    explicit StrokePath(const Path& path)
+        : DrawingItem(ItemType::StrokePath)
+        , m_path(path)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    Path m_path;
+};
+
+class ClearRect : public DrawingItem {
+public:
+    static Ref<ClearRect> create(const FloatRect& rect) { return adoptRef(*new ClearRect(rect)); }
+
+private:
+    explicit ClearRect(const FloatRect& rect)
+        : DrawingItem(ItemType::ClearRect)
+        , m_rect(rect)
+    {
+    }
+
+    void apply(GraphicsContext&) const override;
+
+    FloatRect m_rect;
+};
+
+} // namespace DisplayList
+} // namespace WebCore
+
+#endif // DisplayListItems_h
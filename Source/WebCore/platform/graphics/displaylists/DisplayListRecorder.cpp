@@ -0,0 +1,508 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "DisplayListRecorder.h"
+
+#include "Font.h"
+#include "GlyphBuffer.h"
+#include <wtf/MathExtras.h>
+
+namespace WebCore {
+namespace DisplayList {
+
+Recorder::Recorder(GraphicsContext& context, DisplayList& displayList, const FloatRect& initialClip, const AffineTransform& baseCTM)
+    : m_graphicsContext(context)
+    , m_displayList(displayList)
+    , m_baseCTM(baseCTM)
+{
+    ContextState state;
+    state.clipBounds = initialClip;
+    m_stateStack.append(state);
+
+    m_graphicsContext.setDisplayListRecorder(this);
+}
+
+Recorder::~Recorder()
+{
+    ASSERT(m_stateStack.size() == 1);
+    m_graphicsContext.setDisplayListRecorder(nullptr);
+}
+
+void Recorder::save()
+{
+    appendItem(Save::create());
+
+    ContextState state = currentState();
+    m_stateStack.append(state);
+}
+
+void Recorder::restore()
+{
+    ASSERT(m_stateStack.size() > 1);
+    if (m_stateStack.size() == 1)
+        return;
+    m_stateStack.removeLast();
+
+    // Nothing happened since the matching save(), so both can go.
+    if (!m_displayList.isEmpty() && m_displayList.lastItem().type() == ItemType::Save) {
+        m_displayList.removeLastItem();
+        return;
+    }
+
+    appendItem(Restore::create());
+}
+
+void Recorder::translate(float x, float y)
+{
+    currentState().ctm.translate(x, y);
+    appendItem(Translate::create(x, y));
+}
+
+void Recorder::rotate(float angleInRadians)
+{
+    currentState().ctm.rotate(rad2deg(angleInRadians));
+    appendItem(Rotate::create(angleInRadians));
+}
+
+void Recorder::scale(const FloatSize& size)
+{
+    currentState().ctm.scaleNonUniform(size.width(), size.height());
+    appendItem(Scale::create(size));
+}
+
+void Recorder::concatCTM(const AffineTransform& transform)
+{
+    currentState().ctm.multiply(transform);
+    appendItem(ConcatenateCTM::create(transform));
+}
+
+void Recorder::setCTM(const AffineTransform& transform)
+{
+    // Keep the transform relative to the base one, so the list can be replayed with a different one.
+    AffineTransform ctm = m_baseCTM.inverse();
+    ctm.multiply(transform);
+
+    currentState().ctm = ctm;
+    appendItem(SetCTM::create(ctm));
+}
+
+AffineTransform Recorder::ctm() const
+{
+    AffineTransform ctm = m_baseCTM;
+    ctm.multiply(currentState().ctm);
+    return ctm;
+}
+
+void Recorder::setLineCap(LineCap lineCap)
+{
+    appendItem(SetLineCap::create(lineCap));
+}
+
+void Recorder::setLineDash(const DashArray& dashArray, float dashOffset)
+{
+    appendItem(SetLineDash::create(dashArray, dashOffset));
+}
+
+void Recorder::setLineJoin(LineJoin lineJoin)
+{
+    currentState().lineJoin = lineJoin;
+    appendItem(SetLineJoin::create(lineJoin));
+}
+
+void Recorder::setMiterLimit(float miterLimit)
+{
+    currentState().miterLimit = miterLimit;
+    appendItem(SetMiterLimit::create(miterLimit));
+}
+
+void Recorder::clip(const FloatRect& rect)
+{
+    ContextState& state = currentState();
+    state.clipBounds.intersect(state.ctm.mapRect(rect));
+    appendItem(Clip::create(rect));
+}
+
+void Recorder::clipOut(const FloatRect& rect)
+{
+    appendItem(ClipOut::create(rect));
+}
+
+void Recorder::clipOut(const Path& path)
+{
+    appendItem(ClipOutToPath::create(path));
+}
+
+void Recorder::clipPath(const Path& path, WindRule windRule)
+{
+    ContextState& state = currentState();
+    state.clipBounds.intersect(state.ctm.mapRect(path.fastBoundingRect()));
+    appendItem(ClipPath::create(path, windRule));
+}
+
+void Recorder::clipConvexPolygon(size_t numPoints, const FloatPoint* points, bool antialiased)
+{
+    if (numPoints <= 1)
+        return;
+
+    FloatRect bounds(points[0], FloatSize());
+    for (size_t i = 1; i < numPoints; ++i)
+        bounds.extend(points[i]);
+
+    ContextState& state = currentState();
+    state.clipBounds.intersect(state.ctm.mapRect(bounds));
+    appendItem(ClipConvexPolygon::create(numPoints, points, antialiased));
+}
+
+void Recorder::clipToImage(Image& image, const FloatRect& destination)
+{
+    ContextState& state = currentState();
+    state.clipBounds.intersect(state.ctm.mapRect(destination));
+    appendItem(ClipToImage::create(image, destination));
+}
+
+FloatRect Recorder::clipBounds() const
+{
+    const ContextState& state = currentState();
+    if (!state.ctm.isInvertible())
+        return FloatRect();
+    return state.ctm.inverse().mapRect(state.clipBounds);
+}
+
+void Recorder::beginTransparencyLayer(float opacity)
+{
+    // The layer is composited with the state in effect when it ends, but the items drawn into it
+    // use the state from before it began.
+    appendStateChangeIfNeeded();
+    appendItem(BeginTransparencyLayer::create(opacity));
+}
+
+void Recorder::endTransparencyLayer()
+{
+    appendStateChangeIfNeeded();
+    appendItem(EndTransparencyLayer::create());
+}
+
+void Recorder::drawGlyphs(const FontCascade& fontCascade, const Font& font, const GlyphBuffer& glyphBuffer, int from, int numGlyphs, const FloatPoint& point)
+{
+    if (numGlyphs <= 0)
+        return;
+
+    float width = 0;
+    for (int i = from; i < from + numGlyphs; ++i)
+        width += glyphBuffer.advanceAt(i).width();
+
+    const FontMetrics& metrics = font.fontMetrics();
+    FloatRect bounds(point.x(), point.y() - metrics.floatAscent(), width, metrics.floatAscent() + metrics.floatDescent());
+    // Glyphs can draw outside of the font's ascent, descent and their advance, e.g. italics and diacritics.
+    bounds.inflate(font.platformData().size() / 2);
+    if (m_graphicsContext.textDrawingMode() & TextModeStroke)
+        bounds.inflate(strokeOutset());
+
+    FloatRect extent = extentFromLocalBounds(bounds);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(DrawGlyphs::create(fontCascade, font, glyphBuffer, from, numGlyphs, point), extent);
+}
+
+void Recorder::drawImage(Image& image, const FloatRect& destination, const FloatRect& source, const ImagePaintingOptions& options)
+{
+    FloatRect extent = extentFromLocalBounds(destination);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(DrawImage::create(image, destination, source, options), extent);
+}
+
+void Recorder::drawTiledImage(Image& image, const FloatRect& destination, const FloatPoint& source, const FloatSize& tileSize, const FloatSize& spacing, const ImagePaintingOptions& options)
+{
+    FloatRect extent = extentFromLocalBounds(destination);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(DrawTiledImage::create(image, destination, source, tileSize, spacing, options), extent);
+}
+
+void Recorder::drawTiledImage(Image& image, const FloatRect& destination, const FloatRect& source, const FloatSize& tileScaleFactor, Image::TileRule hRule, Image::TileRule vRule, const ImagePaintingOptions& options)
+{
+    FloatRect extent = extentFromLocalBounds(destination);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(DrawTiledScaledImage::create(image, destination, source, tileScaleFactor, hRule, vRule, options), extent);
+}
+
+void Recorder::drawPattern(Image& image, const FloatRect& tileRect, const AffineTransform& patternTransform, const FloatPoint& phase, const FloatSize& spacing, CompositeOperator op, const FloatRect& destRect, BlendMode blendMode)
+{
+    FloatRect extent = extentFromLocalBounds(destRect);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(DrawPattern::create(image, tileRect, patternTransform, phase, spacing, op, destRect, blendMode), extent);
+}
+
+void Recorder::drawRect(const FloatRect& rect, float borderThickness)
+{
+    // The border is drawn inside of the rect.
+    FloatRect extent = extentFromLocalBounds(rect);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(DrawRect::create(rect, borderThickness), extent);
+}
+
+void Recorder::drawLine(const FloatPoint& point1, const FloatPoint& point2)
+{
+    if (m_graphicsContext.strokeStyle() == NoStroke)
+        return;
+
+    FloatRect bounds;
+    bounds.fitToPoints(point1, point2);
+    bounds.inflate(m_graphicsContext.strokeThickness());
+
+    FloatRect extent = extentFromLocalBounds(bounds);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(DrawLine::create(point1, point2), extent);
+}
+
+void Recorder::drawLinesForText(const FloatPoint& point, const DashArray& widths, bool printing, bool doubleLines)
+{
+    if (widths.isEmpty())
+        return;
+
+    FloatRect bounds = m_graphicsContext.computeLineBoundsForText(point, widths.last(), printing);
+    if (doubleLines)
+        bounds.setHeight(3 * bounds.height());
+
+    FloatRect extent = extentFromLocalBounds(bounds);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(DrawLinesForText::create(point, widths, printing, doubleLines), extent);
+}
+
+void Recorder::drawLineForDocumentMarker(const FloatPoint& point, float width, GraphicsContext::DocumentMarkerLineStyle style)
+{
+    FloatRect bounds(point, FloatSize(width, cMisspellingLineThickness));
+    bounds.inflate(1);
+
+    FloatRect extent = extentFromLocalBounds(bounds);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(DrawLineForDocumentMarker::create(point, width, style), extent);
+}
+
+void Recorder::drawEllipse(const FloatRect& rect)
+{
+    FloatRect bounds = rect;
+    bounds.inflate(strokeOutset());
+
+    FloatRect extent = extentFromLocalBounds(bounds);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(DrawEllipse::create(rect), extent);
+}
+
+void Recorder::drawConvexPolygon(size_t numPoints, const FloatPoint* points, bool antialiased)
+{
+    if (numPoints <= 1)
+        return;
+
+    FloatRect bounds(points[0], FloatSize());
+    for (size_t i = 1; i < numPoints; ++i)
+        bounds.extend(points[i]);
+    bounds.inflate(strokeOutset());
+
+    FloatRect extent = extentFromLocalBounds(bounds);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(DrawConvexPolygon::create(numPoints, points, antialiased), extent);
+}
+
+void Recorder::drawFocusRing(const Path& path, int width, int offset, const Color& color)
+{
+    FloatRect bounds = path.fastBoundingRect();
+    bounds.inflate(width + offset);
+
+    FloatRect extent = extentFromLocalBounds(bounds);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(DrawFocusRingPath::create(path, width, offset, color), extent);
+}
+
+void Recorder::drawFocusRing(const Vector<IntRect>& rects, int width, int offset, const Color& color)
+{
+    FloatRect bounds;
+    for (auto& rect : rects)
+        bounds.unite(rect);
+    bounds.inflate(width + offset);
+
+    FloatRect extent = extentFromLocalBounds(bounds);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(DrawFocusRingRects::create(rects, width, offset, color), extent);
+}
+
+void Recorder::fillRect(const FloatRect& rect)
+{
+    FloatRect extent = extentFromLocalBounds(rect);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(FillRect::create(rect), extent);
+}
+
+void Recorder::fillRect(const FloatRect& rect, const Color& color)
+{
+    FloatRect extent = extentFromLocalBounds(rect);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(FillRectWithColor::create(rect, color), extent);
+}
+
+void Recorder::fillRect(const FloatRect& rect, Gradient& gradient)
+{
+    FloatRect extent = extentFromLocalBounds(rect);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(FillRectWithGradient::create(rect, gradient), extent);
+}
+
+void Recorder::fillRoundedRect(const FloatRoundedRect& rect, const Color& color)
+{
+    FloatRect extent = extentFromLocalBounds(rect.rect());
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(FillRoundedRect::create(rect, color), extent);
+}
+
+void Recorder::fillRectWithRoundedHole(const FloatRect& rect, const FloatRoundedRect& roundedHoleRect, const Color& color)
+{
+    FloatRect extent = extentFromLocalBounds(rect);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(FillRectWithRoundedHole::create(rect, roundedHoleRect, color), extent);
+}
+
+void Recorder::fillPath(const Path& path)
+{
+    FloatRect extent = extentFromLocalBounds(path.fastBoundingRect());
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(FillPath::create(path), extent);
+}
+
+void Recorder::strokeRect(const FloatRect& rect, float lineWidth)
+{
+    FloatRect bounds = rect;
+    bounds.inflate(lineWidth / 2);
+
+    FloatRect extent = extentFromLocalBounds(bounds);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(StrokeRect::create(rect, lineWidth), extent);
+}
+
+void Recorder::strokePath(const Path& path)
+{
+    FloatRect bounds = path.fastBoundingRect();
+    bounds.inflate(strokeOutset());
+
+    FloatRect extent = extentFromLocalBounds(bounds);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(StrokePath::create(path), extent);
+}
+
+void Recorder::clearRect(const FloatRect& rect)
+{
+    FloatRect extent = extentFromLocalBounds(rect);
+    if (extent.isEmpty())
+        return;
+    appendDrawingItem(ClearRect::create(rect), extent);
+}
+
+FloatRect Recorder::extentFromLocalBounds(const FloatRect& bounds) const
+{
+    const ContextState& state = currentState();
+    const GraphicsContextState& contextState = m_graphicsContext.state();
+
+    switch (contextState.compositeOperator) {
+    case CompositeCopy:
+    case CompositeSourceIn:
+    case CompositeSourceOut:
+    case CompositeDestinationIn:
+    case CompositeDestinationAtop:
+        // These also change the destination outside of what is drawn.
+        return state.clipBounds;
+    default:
+        break;
+    }
+
+    FloatRect extent = state.ctm.mapRect(bounds);
+
+    if (m_graphicsContext.hasShadow()) {
+        float scale = contextState.shadowsIgnoreTransforms ? 1 : std::max(state.ctm.xScale(), state.ctm.yScale());
+        float shadowOutset = std::abs(contextState.shadowOffset.width()) + std::abs(contextState.shadowOffset.height()) + 2 * contextState.shadowBlur;
+        extent.inflate(shadowOutset * scale);
+    }
+
+    extent.intersect(state.clipBounds);
+    return extent;
+}
+
+float Recorder::strokeOutset() const
+{
+    // Square caps reach sqrt(2) times half of the thickness away from the path, miter joins up to
+    // the miter limit times half of the thickness.
+    float outsetFactor = sqrtOfTwoFloat;
+    if (currentState().lineJoin == MiterJoin)
+        outsetFactor = std::max(outsetFactor, currentState().miterLimit);
+    return outsetFactor * m_graphicsContext.strokeThickness() / 2;
+}
+
+void Recorder::appendItem(Ref<Item>&& item)
+{
+    m_displayList.append(WTF::move(item));
+}
+
+void Recorder::appendDrawingItem(Ref<DrawingItem>&& item, const FloatRect& extent)
+{
+    appendStateChangeIfNeeded();
+
+    item->setExtent(extent);
+    m_displayList.append(WTF::move(item));
+}
+
+void Recorder::appendStateChangeIfNeeded()
+{
+    ContextState& state = currentState();
+    const GraphicsContextState& contextState = m_graphicsContext.state();
+
+    SetState::ChangeFlags changes = state.hasRecordedState ? SetState::changesBetween(state.lastRecordedState, contextState) : SetState::AllChanges;
+    if (!changes)
+        return;
+
+    m_displayList.append(SetState::create(contextState, changes));
+    state.lastRecordedState = contextState;
+    state.hasRecordedState = true;
+}
+
+} // namespace DisplayList
+} // namespace WebCore
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DisplayListRecorder_h
+#define DisplayListRecorder_h
+
+#include "AffineTransform.h"
+#include "DisplayList.h"
+#include "GraphicsContext.h"
+#include <wtf/Noncopyable.h>
+
+namespace WebCore {
+namespace DisplayList {
+
+// Turns a GraphicsContext without a platform context into one that records into a DisplayList for as
+// long as the recorder lives. The context's drawing functions forward to the recorder instead of
+// painting; so far the shared GraphicsContext code and the Cairo backend, which TextureMapper paints
+// with, do so.
+//
+// The recorder keeps track of the transform and a conservative bound of the clip, so it can answer
+// getCTM() and clipBounds() for the painting code, give each drawing item its extent, and drop the
+// drawing done entirely outside of the clip.
+class Recorder {
+    WTF_MAKE_NONCOPYABLE(Recorder); WTF_MAKE_FAST_ALLOCATED;
+public:
+    // The initial clip is in the coordinate space of the recording, which the extents of the items
+    // are expressed in too. The base transform is what the context reports as its CTM before any
+    // drawing, e.g. the device scale factor; it is not recorded.
+    Recorder(GraphicsContext&, DisplayList&, const FloatRect& initialClip, const AffineTransform& baseCTM = AffineTransform());
+    ~Recorder();
+
+    void save();
+    void restore();
+
+    void translate(float x, float y);
+    void rotate(float angleInRadians);
+    void scale(const FloatSize&);
+    void concatCTM(const AffineTransform&);
+    void setCTM(const AffineTransform&);
+    AffineTransform ctm() const;
+
+    void setLineCap(LineCap);
+    void setLineDash(const DashArray&, float dashOffset);
+    void setLineJoin(LineJoin);
+    void setMiterLimit(float);
+
+    void clip(const FloatRect&);
+    void clipOut(const FloatRect&);
+    void clipOut(const Path&);
+    void clipPath(const Path&, WindRule);
+    void clipConvexPolygon(size_t numPoints, const FloatPoint*, bool antialiased);
+    void clipToImage(Image&, const FloatRect&);
+    FloatRect clipBounds() const;
+
+    void beginTransparencyLayer(float opacity);
+    void endTransparencyLayer();
+
+    void drawGlyphs(const FontCascade&, const Font&, const GlyphBuffer&, int from, int numGlyphs, const FloatPoint&);
+    void drawImage(Image&, const FloatRect& destination, const FloatRect& source, const ImagePaintingOptions&);
+    void drawTiledImage(Image&, const FloatRect& destination, const FloatPoint& source, const FloatSize& tileSize, const FloatSize& spacing, const ImagePaintingOptions&);
+    void drawTiledImage(Image&, const FloatRect& destination, const FloatRect& source, const FloatSize& tileScaleFactor, Image::TileRule hRule, Image::TileRule vRule, const ImagePaintingOptions&);
+    void drawPattern(Image&, const FloatRect& tileRect, const AffineTransform&, const FloatPoint& phase, const FloatSize& spacing, CompositeOperator, const FloatRect& destRect, BlendMode);
+
+    void drawRect(const FloatRect&, float borderThickness);
+    void drawLine(const FloatPoint&, const FloatPoint&);
+    void drawLinesForText(const FloatPoint&, const DashArray& widths, bool printing, bool doubleLines);
+    void drawLineForDocumentMarker(const FloatPoint&, float width, GraphicsContext::DocumentMarkerLineStyle);
+    void drawEllipse(const FloatRect&);
+    void drawConvexPolygon(size_t numPoints, const FloatPoint*, bool antialiased);
+    void drawFocusRing(const Path&, int width, int offset, const Color&);
+    void drawFocusRing(const Vector<IntRect>&, int width, int offset, const Color&);
+
+    void fillRect(const FloatRect&);
+    void fillRect(const FloatRect&, const Color&);
+    void fillRect(const FloatRect&, Gradient&);
+    void fillRoundedRect(const FloatRoundedRect&, const Color&);
+    void fillRectWithRoundedHole(const FloatRect&, const FloatRoundedRect& roundedHoleRect, const Color&);
+    void fillPath(const Path&);
+    void strokeRect(const FloatRect&, float lineWidth);
+    void strokePath(const Path&);
+    void clearRect(const FloatRect&);
+
+private:
+    struct ContextState {
+        AffineTransform ctm;
+        FloatRect clipBounds;
+        LineJoin lineJoin { MiterJoin };
+        float miterLimit { 10 };
+
+        // The state the replaying context will be in once the items recorded so far have been applied.
+        GraphicsContextState lastRecordedState;
+        bool hasRecordedState { false };
+    };
+
+    ContextState& currentState() { return m_stateStack.last(); }
+    const ContextState& currentState() const { return m_stateStack.last(); }
+
+    // Returns an empty rect when the drawing can't be seen.
+    FloatRect extentFromLocalBounds(const FloatRect&) const;
+    float strokeOutset() const;
+
+    void appendItem(Ref<Item>&&);
+    void appendDrawingItem(Ref<DrawingItem>&&, const FloatRect& extent);
+    void appendStateChangeIfNeeded();
+
+    GraphicsContext& m_graphicsContext;
+    DisplayList& m_displayList;
+    AffineTransform m_baseCTM;
+    Vector<ContextState, 4> m_stateStack;
+};
+
+} // namespace DisplayList
+} // namespace WebCore
+
+#endif // DisplayListRecorder_h
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef DisplayListReplayer_h
+#define DisplayListReplayer_h
+
+#include "AffineTransform.h"
+#include <wtf/Noncopyable.h>
+
+namespace WebCore {
+
+class FloatRect;
+class GraphicsContext;
+
+namespace DisplayList {
+
+class DisplayList;
+
+// Plays a DisplayList back into a context, e.g. the one of a tile whose transform maps the recorded
+// coordinate space onto the tile. The context's state is the same after replaying as before.
+class Replayer {
+    WTF_MAKE_NONCOPYABLE(Replayer);
+public:
+    Replayer(GraphicsContext&, const DisplayList&);
+
+    void replay();
+    // Only replays the items that can paint inside of the rect, which is in the coordinate space
+    // the list was recorded in. Clipping the context to it is up to the caller.
+    void replay(const FloatRect&);
+
+    // Replays the items without restoring the context afterwards, leaving it in the state the recording
+    // context was in at the end of the recording. This hands the recording over to the context it stood
+    // in for, whose base transform is the one the Recorder was given.
+    void replayAndKeepState(const AffineTransform& baseCTM);
+
+private:
+    void replay(const FloatRect*, const AffineTransform& baseCTM);
+
+    GraphicsContext& m_context;
+    const DisplayList& m_displayList;
+};
+
+} // namespace DisplayList
+} // namespace WebCore
+
+#endif // DisplayListReplayer_h
@@ -31,6 +31,12 @@
 #include <wtf/ParallelJobs.h>
 #include <wtf/Vector.h>
 
+#if CPU(X86_64)
+#include <emmintrin.h>
+#elif HAVE(ARM_NEON_INTRINSICS)
+#include <arm_neon.h>
+#endif
+
 namespace WebCore {
 
 FEMorphology::FEMorphology(Filter& filter, MorphologyOperatorType type, float radiusX, float radiusY)
@@ -83,80 +89,89 @@ void FEMorphology::determineAbsolutePaintRect()
     setAbsolutePaintRect(enclosingIntRect(paintRect));
 }
 
-static inline bool shouldSupersedeExtremum(unsigned char newValue, unsigned char currentValue, MorphologyOperatorType type)
+template<MorphologyOperatorType type>
+static inline uint32_t pixelExtremum(uint32_t a, uint32_t b)
 {
-    return (type == FEMORPHOLOGY_OPERATOR_ERODE && newValue < currentValue)
-        || (type == FEMORPHOLOGY_OPERATOR_DILATE && newValue > currentValue);
+    uint32_t result = 0;
+    for (unsigned shift = 0; shift < 32; shift += 8) {
+        unsigned char channelA = a >> shift;
+        unsigned char channelB = b >> shift;
+        unsigned char channel = type == FEMORPHOLOGY_OPERATOR_ERODE ? std::min(channelA, channelB) : std::max(channelA, channelB);
+        result |= static_cast<uint32_t>(channel) << shift;
+    }
+    return result;
 }
 
-static inline int pixelArrayIndex(int x, int y, int width, int colorChannel)
+// Stores the channel-wise extrema of two runs of pixels into |destination|, which may be |first|.
+// Both passes below are made of these, so this is the part that is vectorized.
+template<MorphologyOperatorType type>
+static void combineExtrema(uint32_t* destination, const uint32_t* first, const uint32_t* second, int length)
 {
-    return (y * width + x) * 4 + colorChannel;
+    int i = 0;
+#if CPU(X86_64)
+    for (; i + 4 <= length; i += 4) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(first + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(second + i));
+        __m128i extremum = type == FEMORPHOLOGY_OPERATOR_ERODE ? _mm_min_epu8(a, b) : _mm_max_epu8(a, b);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), extremum);
+    }
+#elif HAVE(ARM_NEON_INTRINSICS)
+    for (; i + 4 <= length; i += 4) {
+        uint8x16_t a = vld1q_u8(reinterpret_cast<const uint8_t*>(first + i));
+        uint8x16_t b = vld1q_u8(reinterpret_cast<const uint8_t*>(second + i));
+        uint8x16_t extremum = type == FEMORPHOLOGY_OPERATOR_ERODE ? vminq_u8(a, b) : vmaxq_u8(a, b);
+        vst1q_u8(reinterpret_cast<uint8_t*>(destination + i), extremum);
+    }
+#endif
+    for (; i < length; ++i)
+        destination[i] = pixelExtremum<type>(first[i], second[i]);
 }
 
-static inline unsigned char columnExtremum(const Uint8ClampedArray* srcPixelArray, int x, int yStart, int yEnd, int width, unsigned colorChannel, MorphologyOperatorType type)
+// The extremum over the kernel rectangle is the extremum over its rows of the extrema over its columns,
+// so the kernel is applied as a horizontal pass over the rows the vertical pass needs, followed by the
+// vertical pass. Each pass costs one combineExtrema() per kernel offset instead of one per pixel.
+template<MorphologyOperatorType type>
+static void applyMorphology(const FEMorphology::PaintingData& paintingData, int yStart, int yEnd)
 {
-    unsigned char extremum = srcPixelArray->item(pixelArrayIndex(x, yStart, width, colorChannel));
-    for (int y = yStart + 1; y < yEnd; ++y) {
-        unsigned char pixel = srcPixelArray->item(pixelArrayIndex(x, y, width, colorChannel));
-        if (shouldSupersedeExtremum(pixel, extremum, type))
-            extremum = pixel;
+    const uint32_t* source = reinterpret_cast<const uint32_t*>(paintingData.srcPixelArray->data());
+    uint32_t* destination = reinterpret_cast<uint32_t*>(paintingData.dstPixelArray->data());
+    const int width = paintingData.width;
+    const int radiusX = std::min(paintingData.radiusX, width - 1);
+    const int radiusY = paintingData.radiusY;
+
+    int firstRow = std::max(0, yStart - radiusY);
+    int lastRow = std::min(paintingData.height - 1, yEnd - 1 + radiusY);
+    Vector<uint32_t> rowExtrema((lastRow - firstRow + 1) * width);
+
+    for (int y = firstRow; y <= lastRow; ++y) {
+        const uint32_t* sourceRow = source + y * width;
+        uint32_t* row = rowExtrema.data() + (y - firstRow) * width;
+        memcpy(row, sourceRow, width * sizeof(uint32_t));
+        for (int offset = 1; offset <= radiusX; ++offset) {
+            combineExtrema<type>(row + offset, row + offset, sourceRow, width - offset);
+            combineExtrema<type>(row, row, sourceRow + offset, width - offset);
+        }
     }
-    return extremum;
-}
 
-static inline unsigned char kernelExtremum(const Vector<unsigned char>& kernel, MorphologyOperatorType type)
-{
-    Vector<unsigned char>::const_iterator iter = kernel.begin();
-    unsigned char extremum = *iter;
-    for (Vector<unsigned char>::const_iterator end = kernel.end(); ++iter != end; ) {
-        if (shouldSupersedeExtremum(*iter, extremum, type))
-            extremum = *iter;
+    for (int y = yStart; y < yEnd; ++y) {
+        uint32_t* destinationRow = destination + y * width;
+        int kernelTop = std::max(firstRow, y - radiusY);
+        int kernelBottom = std::min(lastRow, y + radiusY);
+        memcpy(destinationRow, rowExtrema.data() + (kernelTop - firstRow) * width, width * sizeof(uint32_t));
+        for (int kernelY = kernelTop + 1; kernelY <= kernelBottom; ++kernelY)
+            combineExtrema<type>(destinationRow, destinationRow, rowExtrema.data() + (kernelY - firstRow) * width, width);
     }
-    return extremum;
 }
 
 void FEMorphology::platformApplyGeneric(PaintingData* paintingData, int yStart, int yEnd)
 {
-    Uint8ClampedArray* srcPixelArray = paintingData->srcPixelArray;
-    Uint8ClampedArray* dstPixelArray = paintingData->dstPixelArray;
-    const int radiusX = paintingData->radiusX;
-    const int radiusY = paintingData->radiusY;
-    const int width = paintingData->width;
-    const int height = paintingData->height;
-
-    ASSERT(radiusX <= width || radiusY <= height);
-    ASSERT(yStart >= 0 && yEnd <= height && yStart < yEnd);
+    ASSERT(paintingData->radiusX <= paintingData->width || paintingData->radiusY <= paintingData->height);
+    ASSERT(yStart >= 0 && yEnd <= paintingData->height && yStart < yEnd);
 
-    Vector<unsigned char> extrema;
-    for (int y = yStart; y < yEnd; ++y) {
-        int yStartExtrema = std::max(0, y - radiusY);
-        int yEndExtrema = std::min(height - 1, y + radiusY);
-
-        for (unsigned colorChannel = 0; colorChannel < 4; ++colorChannel) {
-            extrema.clear();
-            // Compute extremas for each columns
-            for (int x = 0; x < radiusX; ++x)
-                extrema.append(columnExtremum(srcPixelArray, x, yStartExtrema, yEndExtrema, width, colorChannel, m_type));
-
-            // Kernel is filled, get extrema of next column
-            for (int x = 0; x < width; ++x) {
-                if (x < width - radiusX) {
-                    int xEnd = std::min(x + radiusX, width - 1);
-                    extrema.append(columnExtremum(srcPixelArray, xEnd, yStartExtrema, yEndExtrema + 1, width, colorChannel, m_type));
-                }
-
-                if (x > radiusX)
-                    extrema.remove(0);
-
-                // The extrema original size = radiusX.
-                // Number of new addition = width - radiusX.
-                // Number of removals = width - radiusX - 1.
-                ASSERT(extrema.size() >= static_cast<size_t>(radiusX + 1));
-                dstPixelArray->set(pixelArrayIndex(x, y, width, colorChannel), kernelExtremum(extrema, m_type));
-            }
-        }
-    }
+    if (m_type == FEMORPHOLOGY_OPERATOR_ERODE)
+        applyMorphology<FEMORPHOLOGY_OPERATOR_ERODE>(*paintingData, yStart, yEnd);
+    else
+        applyMorphology<FEMORPHOLOGY_OPERATOR_DILATE>(*paintingData, yStart, yEnd);
 }
 
 void FEMorphology::platformApplyWorker(PlatformApplyParameters* param)
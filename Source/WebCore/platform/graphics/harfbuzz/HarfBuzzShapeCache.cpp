@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "HarfBuzzShapeCache.h"
+
+#include <wtf/StringHasher.h>
+
+namespace WebCore {
+
+static const size_t maxMemoryCost = 2 * 1024 * 1024;
+
+HarfBuzzShapeCache::Key::Key(const Font* font, unsigned featuresHash, hb_script_t script, hb_direction_t direction, String&& text)
+    : font(font)
+    , featuresHash(featuresHash)
+    , script(script)
+    , direction(direction)
+    , text(WTF::move(text))
+{
+}
+
+bool HarfBuzzShapeCache::Key::operator==(const Key& other) const
+{
+    return font == other.font
+        && featuresHash == other.featuresHash
+        && script == other.script
+        && direction == other.direction
+        && text == other.text;
+}
+
+unsigned HarfBuzzShapeCache::KeyHash::hash(const Key& key)
+{
+    unsigned hashCodes[] = {
+        PtrHash<const Font*>::hash(key.font),
+        key.featuresHash,
+        static_cast<unsigned>(key.script),
+        static_cast<unsigned>(key.direction),
+        key.text.impl() ? key.text.impl()->hash() : 0
+    };
+    return StringHasher::hashMemory<sizeof(hashCodes)>(hashCodes);
+}
+
+static size_t memoryCostForEntry(const HarfBuzzShapeCache::Key& key, const HarfBuzzShapeCache::Entry& entry)
+{
+    return sizeof(HarfBuzzShapeCache::Key) + sizeof(HarfBuzzShapeCache::Entry)
+        + key.text.length() * sizeof(UChar)
+        + entry.glyphInfos.size() * (sizeof(hb_glyph_info_t) + sizeof(hb_glyph_position_t));
+}
+
+HarfBuzzShapeCache& HarfBuzzShapeCache::singleton()
+{
+    static NeverDestroyed<HarfBuzzShapeCache> cache;
+    return cache;
+}
+
+const HarfBuzzShapeCache::Entry* HarfBuzzShapeCache::find(const Key& key)
+{
+    auto it = m_entries.find(key);
+    if (it == m_entries.end()) {
+        ++m_missCount;
+        return nullptr;
+    }
+
+    ++m_hitCount;
+    m_recentlyUsedKeys.appendOrMoveToLast(key);
+    return &it->value;
+}
+
+void HarfBuzzShapeCache::add(Key&& key, hb_buffer_t* harfBuzzBuffer)
+{
+    ASSERT(!m_entries.contains(key));
+
+    unsigned numGlyphs = hb_buffer_get_length(harfBuzzBuffer);
+    Entry entry;
+    entry.glyphInfos.append(hb_buffer_get_glyph_infos(harfBuzzBuffer, 0), numGlyphs);
+    entry.glyphPositions.append(hb_buffer_get_glyph_positions(harfBuzzBuffer, 0), numGlyphs);
+
+    size_t cost = memoryCostForEntry(key, entry);
+    if (cost > maxMemoryCost)
+        return;
+    pruneToSize(maxMemoryCost - cost);
+
+    m_memoryCost += cost;
+    ++m_entryCountPerFont.add(key.font, 0).iterator->value;
+    m_recentlyUsedKeys.add(key);
+    m_entries.add(WTF::move(key), WTF::move(entry));
+}
+
+void HarfBuzzShapeCache::removeEntry(const Key& key)
+{
+    auto it = m_entries.find(key);
+    ASSERT(it != m_entries.end());
+
+    m_memoryCost -= memoryCostForEntry(it->key, it->value);
+
+    auto countIterator = m_entryCountPerFont.find(key.font);
+    ASSERT(countIterator != m_entryCountPerFont.end());
+    if (!--countIterator->value)
+        m_entryCountPerFont.remove(countIterator);
+
+    m_recentlyUsedKeys.remove(key);
+    m_entries.remove(it);
+}
+
+void HarfBuzzShapeCache::pruneToSize(size_t size)
+{
+    while (m_memoryCost > size && !m_recentlyUsedKeys.isEmpty()) {
+        Key leastRecentlyUsedKey = m_recentlyUsedKeys.first();
+        removeEntry(leastRecentlyUsedKey);
+    }
+}
+
+void HarfBuzzShapeCache::removeEntriesForFont(const Font* font)
+{
+    if (!m_entryCountPerFont.contains(font))
+        return;
+
+    Vector<Key> keysToRemove;
+    for (auto& key : m_entries.keys()) {
+        if (key.font == font)
+            keysToRemove.append(key);
+    }
+    for (auto& key : keysToRemove)
+        removeEntry(key);
+}
+
+void HarfBuzzShapeCache::clear()
+{
+    m_entries.clear();
+    m_recentlyUsedKeys.clear();
+    m_entryCountPerFont.clear();
+    m_memoryCost = 0;
+}
+
+} // namespace WebCore
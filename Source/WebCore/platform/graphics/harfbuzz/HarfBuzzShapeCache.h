@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef HarfBuzzShapeCache_h
+#define HarfBuzzShapeCache_h
+
+#include "hb.h"
+#include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/Vector.h>
+#include <wtf/text/WTFString.h>
+
+namespace WebCore {
+
+class Font;
+
+// Remembers the glyphs and positions HarfBuzz produced for a run, keyed by the font, the enabled
+// features, the script, the direction and the text of the run, so identical runs are shaped only once.
+// Entries are evicted in least recently used order once the cache grows past its memory budget.
+class HarfBuzzShapeCache {
+    WTF_MAKE_NONCOPYABLE(HarfBuzzShapeCache); WTF_MAKE_FAST_ALLOCATED;
+    friend class NeverDestroyed<HarfBuzzShapeCache>;
+public:
+    struct Key {
+        Key() { }
+        Key(const Font*, unsigned featuresHash, hb_script_t, hb_direction_t, String&& text);
+        Key(WTF::HashTableDeletedValueType) : font(reinterpret_cast<const Font*>(-1)) { }
+        bool isHashTableDeletedValue() const { return font == reinterpret_cast<const Font*>(-1); }
+
+        bool operator==(const Key&) const;
+
+        const Font* font { nullptr };
+        unsigned featuresHash { 0 };
+        hb_script_t script { HB_SCRIPT_INVALID };
+        hb_direction_t direction { HB_DIRECTION_INVALID };
+        String text;
+    };
+
+    struct KeyHash {
+        static unsigned hash(const Key&);
+        static bool equal(const Key& a, const Key& b) { return a == b; }
+        static const bool safeToCompareToEmptyOrDeleted = true;
+    };
+
+    struct Entry {
+        Vector<hb_glyph_info_t> glyphInfos;
+        Vector<hb_glyph_position_t> glyphPositions;
+    };
+
+    static HarfBuzzShapeCache& singleton();
+
+    // The returned entry is only valid until the cache is next modified.
+    const Entry* find(const Key&);
+    void add(Key&&, hb_buffer_t*);
+
+    void removeEntriesForFont(const Font*);
+    void clear();
+
+    unsigned hitCount() const { return m_hitCount; }
+    unsigned missCount() const { return m_missCount; }
+    size_t memoryCost() const { return m_memoryCost; }
+
+private:
+    HarfBuzzShapeCache() { }
+
+    void removeEntry(const Key&);
+    void pruneToSize(size_t);
+
+    typedef HashMap<Key, Entry, KeyHash, WTF::SimpleClassHashTraits<Key>> EntryMap;
+    EntryMap m_entries;
+    ListHashSet<Key, KeyHash> m_recentlyUsedKeys;
+    HashMap<const Font*, unsigned> m_entryCountPerFont;
+    size_t m_memoryCost { 0 };
+    unsigned m_hitCount { 0 };
+    unsigned m_missCount { 0 };
+};
+
+} // namespace WebCore
+
+#endif // HarfBuzzShapeCache_h
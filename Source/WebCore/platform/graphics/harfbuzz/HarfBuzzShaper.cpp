@@ -33,6 +33,7 @@
 
 #include "FontCascade.h"
 #include "HarfBuzzFace.h"
+#include "HarfBuzzShapeCache.h"
 #include "SurrogatePairAwareTextIterator.h"
 #include <hb-icu.h>
 #include <unicode/normlzr.h>
@@ -81,9 +82,9 @@ HarfBuzzShaper::HarfBuzzRun::HarfBuzzRun(const Font* fontData, unsigned startInd
 {
 }
 
-void HarfBuzzShaper::HarfBuzzRun::applyShapeResult(hb_buffer_t* harfBuzzBuffer)
+void HarfBuzzShaper::HarfBuzzRun::applyShapeResult(unsigned numGlyphs)
 {
-    m_numGlyphs = hb_buffer_get_length(harfBuzzBuffer);
+    m_numGlyphs = numGlyphs;
     m_glyphs.resize(m_numGlyphs);
     m_advances.resize(m_numGlyphs);
     m_glyphToCharacterIndexes.resize(m_numGlyphs);
@@ -192,6 +193,7 @@ HarfBuzzShaper::HarfBuzzShaper(const FontCascade* font, const TextRun& run)
     , m_padPerWordBreak(0)
     , m_padError(0)
     , m_letterSpacing(font->letterSpacing())
+    , m_featuresHash(0)
 {
     m_normalizedBuffer = std::make_unique<UChar[]>(m_run.length() + 1);
     m_normalizedBufferLength = m_run.length();
@@ -364,6 +366,8 @@ void HarfBuzzShaper::setFontFeatures()
         feature.end = static_cast<unsigned>(-1);
         m_features.append(feature);
     }
+
+    m_featuresHash = StringHasher::hashMemory(m_features.data(), m_features.size() * sizeof(hb_feature_t));
 }
 
 bool HarfBuzzShaper::shape(GlyphBuffer* glyphBuffer)
@@ -469,9 +473,27 @@ bool HarfBuzzShaper::shapeHarfBuzzRuns(bool shouldSetDirection)
         if (currentFontData->isSVGFont())
             return false;
 
+        String runText(m_normalizedBuffer.get() + currentRun->startIndex(), currentRun->numCharacters());
+        if (m_font->isSmallCaps() && u_islower(runText[0])) {
+            runText = runText.upper();
+            currentFontData = m_font->glyphDataForCharacter(runText[0], false, SmallCapsVariant).font;
+        }
+
+        // When the direction is left to HarfBuzz it is guessed from the script, which is already part of the key.
+        hb_direction_t direction = HB_DIRECTION_INVALID;
+        if (shouldSetDirection)
+            direction = currentRun->rtl() ? HB_DIRECTION_RTL : HB_DIRECTION_LTR;
+
+        HarfBuzzShapeCache::Key cacheKey(currentFontData, m_featuresHash, currentRun->script(), direction, String(runText));
+        if (auto* cachedResult = HarfBuzzShapeCache::singleton().find(cacheKey)) {
+            currentRun->applyShapeResult(cachedResult->glyphInfos.size());
+            setGlyphPositionsForHarfBuzzRun(currentRun, cachedResult->glyphInfos.data(), cachedResult->glyphPositions.data());
+            continue;
+        }
+
         hb_buffer_set_script(harfBuzzBuffer.get(), currentRun->script());
         if (shouldSetDirection)
-            hb_buffer_set_direction(harfBuzzBuffer.get(), currentRun->rtl() ? HB_DIRECTION_RTL : HB_DIRECTION_LTR);
+            hb_buffer_set_direction(harfBuzzBuffer.get(), direction);
         else
             // Leaving direction to HarfBuzz to guess is *really* bad, but will do for now.
             hb_buffer_guess_segment_properties(harfBuzzBuffer.get());
@@ -481,13 +503,8 @@ bool HarfBuzzShaper::shapeHarfBuzzRuns(bool shouldSetDirection)
         static const uint16_t preContext = ' ';
         hb_buffer_add_utf16(harfBuzzBuffer.get(), &preContext, 1, 1, 0);
 
-        if (m_font->isSmallCaps() && u_islower(m_normalizedBuffer[currentRun->startIndex()])) {
-            String upperText = String(m_normalizedBuffer.get() + currentRun->startIndex(), currentRun->numCharacters()).upper();
-            currentFontData = m_font->glyphDataForCharacter(upperText[0], false, SmallCapsVariant).font;
-            const UChar* characters = StringView(upperText).upconvertedCharacters();
-            hb_buffer_add_utf16(harfBuzzBuffer.get(), reinterpret_cast<const uint16_t*>(characters), currentRun->numCharacters(), 0, currentRun->numCharacters());
-        } else
-            hb_buffer_add_utf16(harfBuzzBuffer.get(), reinterpret_cast<const uint16_t*>(m_normalizedBuffer.get() + currentRun->startIndex()), currentRun->numCharacters(), 0, currentRun->numCharacters());
+        auto characters = StringView(runText).upconvertedCharacters();
+        hb_buffer_add_utf16(harfBuzzBuffer.get(), reinterpret_cast<const uint16_t*>(characters.get()), currentRun->numCharacters(), 0, currentRun->numCharacters());
 
         FontPlatformData* platformData = const_cast<FontPlatformData*>(&currentFontData->platformData());
         HarfBuzzFace* face = platformData->harfBuzzFace();
@@ -501,8 +518,9 @@ bool HarfBuzzShaper::shapeHarfBuzzRuns(bool shouldSetDirection)
 
         hb_shape(harfBuzzFont.get(), harfBuzzBuffer.get(), m_features.isEmpty() ? 0 : m_features.data(), m_features.size());
 
-        currentRun->applyShapeResult(harfBuzzBuffer.get());
-        setGlyphPositionsForHarfBuzzRun(currentRun, harfBuzzBuffer.get());
+        currentRun->applyShapeResult(hb_buffer_get_length(harfBuzzBuffer.get()));
+        setGlyphPositionsForHarfBuzzRun(currentRun, hb_buffer_get_glyph_infos(harfBuzzBuffer.get(), 0), hb_buffer_get_glyph_positions(harfBuzzBuffer.get(), 0));
+        HarfBuzzShapeCache::singleton().add(WTF::move(cacheKey), harfBuzzBuffer.get());
 
         hb_buffer_reset(harfBuzzBuffer.get());
     }
@@ -510,11 +528,9 @@ bool HarfBuzzShaper::shapeHarfBuzzRuns(bool shouldSetDirection)
     return true;
 }
 
-void HarfBuzzShaper::setGlyphPositionsForHarfBuzzRun(HarfBuzzRun* currentRun, hb_buffer_t* harfBuzzBuffer)
+void HarfBuzzShaper::setGlyphPositionsForHarfBuzzRun(HarfBuzzRun* currentRun, const hb_glyph_info_t* glyphInfos, const hb_glyph_position_t* glyphPositions)
 {
     const Font* currentFontData = currentRun->fontData();
-    hb_glyph_info_t* glyphInfos = hb_buffer_get_glyph_infos(harfBuzzBuffer, 0);
-    hb_glyph_position_t* glyphPositions = hb_buffer_get_glyph_positions(harfBuzzBuffer, 0);
 
     unsigned numGlyphs = currentRun->numGlyphs();
     uint16_t* glyphToCharacterIndexes = currentRun->glyphToCharacterIndexes();
@@ -430,6 +430,9 @@ IntSize GraphicsContext3D::getInternalFramebufferSize() const
 
 void GraphicsContext3D::activeTexture(GC3Denum texture)
 {
+    if (filtersRedundantStateChanges() && texture == m_state.activeTexture)
+        return;
+
     makeContextCurrent();
     m_state.activeTexture = texture;
     ::glActiveTexture(texture);
@@ -681,8 +684,42 @@ void GraphicsContext3D::detachShader(Platform3DObject program, Platform3DObject
     ::glDetachShader(program, shader);
 }
 
+static unsigned capabilityBit(GC3Denum cap)
+{
+    switch (cap) {
+    case GraphicsContext3D::BLEND:
+        return 1 << 0;
+    case GraphicsContext3D::CULL_FACE:
+        return 1 << 1;
+    case GraphicsContext3D::DEPTH_TEST:
+        return 1 << 2;
+    case GraphicsContext3D::DITHER:
+        return 1 << 3;
+    case GraphicsContext3D::POLYGON_OFFSET_FILL:
+        return 1 << 4;
+    case GraphicsContext3D::SAMPLE_ALPHA_TO_COVERAGE:
+        return 1 << 5;
+    case GraphicsContext3D::SAMPLE_COVERAGE:
+        return 1 << 6;
+    case GraphicsContext3D::SCISSOR_TEST:
+        return 1 << 7;
+    case GraphicsContext3D::STENCIL_TEST:
+        return 1 << 8;
+    default:
+        return 0;
+    }
+}
+
 void GraphicsContext3D::disable(GC3Denum cap)
 {
+    if (filtersRedundantStateChanges()) {
+        unsigned bit = capabilityBit(cap);
+        if ((m_state.knownCapabilities & bit) && !(m_state.enabledCapabilities & bit))
+            return;
+        m_state.knownCapabilities |= bit;
+        m_state.enabledCapabilities &= ~bit;
+    }
+
     makeContextCurrent();
     ::glDisable(cap);
 }
@@ -709,6 +746,14 @@ void GraphicsContext3D::drawElements(GC3Denum mode, GC3Dsizei count, GC3Denum ty
 
 void GraphicsContext3D::enable(GC3Denum cap)
 {
+    if (filtersRedundantStateChanges()) {
+        unsigned bit = capabilityBit(cap);
+        if (m_state.knownCapabilities & m_state.enabledCapabilities & bit)
+            return;
+        m_state.knownCapabilities |= bit;
+        m_state.enabledCapabilities |= bit;
+    }
+
     makeContextCurrent();
     ::glEnable(cap);
 }
@@ -1297,7 +1342,11 @@ void GraphicsContext3D::uniformMatrix4fv(GC3Dint location, GC3Dsizei size, GC3Db
 
 void GraphicsContext3D::useProgram(Platform3DObject program)
 {
+    if (filtersRedundantStateChanges() && program == m_state.currentProgram)
+        return;
+
     makeContextCurrent();
+    m_state.currentProgram = program;
     ::glUseProgram(program);
 }
 
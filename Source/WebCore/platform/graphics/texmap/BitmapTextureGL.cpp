@@ -242,6 +242,32 @@ PassRefPtr<BitmapTexture> BitmapTextureGL::applyFilters(TextureMapper* textureMa
         RefPtr<FilterOperation> filter = filters.operations()[i];
         ASSERT(filter);
 
+        // Consecutive color matrix and component transfer filters are folded into one pass.
+        TextureMapperGL::ColorMatrix colorMatrix;
+        size_t lastFolded = i;
+        if (TextureMapperGL::colorMatrixForFilter(*filter, colorMatrix)) {
+            TextureMapperGL::ColorMatrix nextMatrix;
+            while (lastFolded + 1 < filters.size() && TextureMapperGL::colorMatrixForFilter(*filters.operations()[lastFolded + 1], nextMatrix)) {
+                TextureMapperGL::concatenateColorMatrix(colorMatrix, nextMatrix);
+                ++lastFolded;
+            }
+        }
+
+        if (lastFolded > i) {
+            if (lastFolded == filters.size() - 1) {
+                toBitmapTextureGL(resultSurface.get())->m_filterInfo = BitmapTextureGL::FilterInfo(colorMatrix);
+                break;
+            }
+
+            if (!intermediateSurface)
+                intermediateSurface = texmapGL->acquireTextureFromPool(contentSize());
+            texmapGL->bindSurface(intermediateSurface.get());
+            texmapGL->drawFiltered(*resultSurface.get(), colorMatrix);
+            std::swap(resultSurface, intermediateSurface);
+            i = lastFolded;
+            continue;
+        }
+
         int numPasses = getPassesRequiredForFilter(filter->type());
         for (int j = 0; j < numPasses; ++j) {
             bool last = (i == filters.size() - 1) && (j == numPasses - 1);
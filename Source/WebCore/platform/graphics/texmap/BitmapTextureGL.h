@@ -59,12 +59,20 @@ public:
         RefPtr<FilterOperation> filter;
         unsigned pass;
         RefPtr<BitmapTexture> contentTexture;
+        bool hasColorMatrix { false };
+        TextureMapperGL::ColorMatrix colorMatrix;
 
         FilterInfo(PassRefPtr<FilterOperation> f = 0, unsigned p = 0, PassRefPtr<BitmapTexture> t = 0)
             : filter(f)
             , pass(p)
             , contentTexture(t)
             { }
+
+        explicit FilterInfo(const TextureMapperGL::ColorMatrix& m)
+            : pass(0)
+            , hasColorMatrix(true)
+            , colorMatrix(m)
+            { }
     };
     const FilterInfo* filterInfo() const { return &m_filterInfo; }
     TextureMapperGL::ClipStack& clipStack() { return m_clipStack; }
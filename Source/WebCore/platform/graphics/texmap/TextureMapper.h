@@ -96,6 +96,9 @@ public:
     virtual void beginPainting(PaintFlags = 0) { }
     virtual void endPainting() { }
 
+    // The number of draw calls issued since beginPainting().
+    virtual unsigned drawCallCount() const { return 0; }
+
     void setMaskMode(bool m) { m_isMaskMode = m; }
 
     virtual IntSize maxTextureSize() const = 0;
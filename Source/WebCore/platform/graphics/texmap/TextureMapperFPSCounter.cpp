@@ -36,6 +36,8 @@ TextureMapperFPSCounter::TextureMapperFPSCounter()
     , m_fpsTimestamp(0)
     , m_lastFPS(0)
     , m_frameCount(0)
+    , m_lastDrawCallsPerFrame(0)
+    , m_drawCallCount(0)
 {
     String showFPSEnvironment = getenv("WEBKIT_SHOW_FPS");
     bool ok = false;
@@ -52,14 +54,21 @@ void TextureMapperFPSCounter::updateFPSAndDisplay(TextureMapper* textureMapper,
         return;
 
     m_frameCount++;
+    m_drawCallCount += textureMapper->drawCallCount();
     double delta = monotonicallyIncreasingTime() - m_fpsTimestamp;
     if (delta >= m_fpsInterval) {
         m_lastFPS = int(m_frameCount / delta);
+        m_lastDrawCallsPerFrame = m_drawCallCount / m_frameCount;
         m_frameCount = 0;
+        m_drawCallCount = 0;
         m_fpsTimestamp += delta;
     }
 
     textureMapper->drawNumber(m_lastFPS, Color::black, location, matrix);
+
+    // Texture mappers that don't count their draw calls report none.
+    if (m_lastDrawCallsPerFrame)
+        textureMapper->drawNumber(m_lastDrawCallsPerFrame, Color::darkGray, location + FloatSize(0, drawCallsOffset), matrix);
 }
 
 } // namespace WebCore
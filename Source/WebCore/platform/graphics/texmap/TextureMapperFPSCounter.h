@@ -43,6 +43,11 @@ private:
     double m_fpsTimestamp;
     int m_lastFPS;
     int m_frameCount;
+
+    // Draw calls per frame over the same interval, shown below the frame rate.
+    static const int drawCallsOffset = 14;
+    unsigned m_lastDrawCallsPerFrame;
+    unsigned m_drawCallCount;
 };
 
 } // namespace WebCore
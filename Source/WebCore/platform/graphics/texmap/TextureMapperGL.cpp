@@ -35,6 +35,7 @@
 #include "TextureMapperShaderProgram.h"
 #include "Timer.h"
 #include <wtf/HashMap.h>
+#include <wtf/MathExtras.h>
 #include <wtf/PassRefPtr.h>
 #include <wtf/RefCounted.h>
 #include <wtf/TemporaryChange.h>
@@ -124,6 +125,10 @@ public:
         , previousDepthState(0)
         , sharedData(TextureMapperGLData::SharedGLData::currentSharedGLData(this->context))
         , filterInfo(0)
+        , currentProgram(0)
+        , projectionMatrixSerial(1)
+        , blendMode(BlendMode::Unknown)
+        , drawCallCount(0)
     { }
 
     ~TextureMapperGLData();
@@ -143,8 +148,44 @@ public:
     RefPtr<BitmapTexture> currentSurface;
     HashMap<const void*, Platform3DObject> vbos;
     const BitmapTextureGL::FilterInfo* filterInfo;
+
+    // GL state left by previous draws of the current painting, to skip redundant state changes.
+    // Uniforms are kept per program, so each program remembers which projection matrix it was
+    // last given; projectionMatrixSerial changes whenever the bound surface does.
+    enum class BlendMode { Unknown, None, SourceOver, Mask };
+    void setBlendMode(BlendMode);
+    Platform3DObject currentProgram;
+    unsigned projectionMatrixSerial;
+    HashMap<Platform3DObject, unsigned> programProjectionMatrixSerials;
+    BlendMode blendMode;
+
+    unsigned drawCallCount;
 };
 
+void TextureMapperGLData::setBlendMode(BlendMode mode)
+{
+    if (mode == blendMode)
+        return;
+
+    switch (mode) {
+    case BlendMode::Unknown:
+        ASSERT_NOT_REACHED();
+        break;
+    case BlendMode::None:
+        context->disable(GraphicsContext3D::BLEND);
+        break;
+    case BlendMode::SourceOver:
+        context->blendFunc(GraphicsContext3D::ONE, GraphicsContext3D::ONE_MINUS_SRC_ALPHA);
+        context->enable(GraphicsContext3D::BLEND);
+        break;
+    case BlendMode::Mask:
+        context->blendFunc(GraphicsContext3D::ZERO, GraphicsContext3D::SRC_ALPHA);
+        context->enable(GraphicsContext3D::BLEND);
+        break;
+    }
+    blendMode = mode;
+}
+
 Platform3DObject TextureMapperGLData::getStaticVBO(GC3Denum target, GC3Dsizeiptr size, const void* data)
 {
     HashMap<const void*, Platform3DObject>::AddResult result = vbos.add(data, 0);
@@ -269,6 +310,10 @@ void TextureMapperGL::beginPainting(PaintFlags flags)
     m_clipStack.reset(IntRect(0, 0, data().viewport[2], data().viewport[3]), ClipStack::InvertedYAxis);
     m_context3D->getIntegerv(GraphicsContext3D::FRAMEBUFFER_BINDING, &data().targetFrameBuffer);
     data().PaintFlags = flags;
+    data().currentProgram = 0;
+    data().programProjectionMatrixSerials.clear();
+    data().blendMode = TextureMapperGLData::BlendMode::Unknown;
+    data().drawCallCount = 0;
     bindSurface(0);
 }
 
@@ -280,6 +325,10 @@ void TextureMapperGL::endPainting()
     }
 
     m_context3D->useProgram(data().previousProgram);
+    data().currentProgram = 0;
+
+    // Leave blending the way each draw used to leave it.
+    data().setBlendMode(TextureMapperGLData::BlendMode::SourceOver);
 
     m_context3D->scissor(data().previousScissor[0], data().previousScissor[1], data().previousScissor[2], data().previousScissor[3]);
     if (data().previousScissorState)
@@ -299,7 +348,7 @@ void TextureMapperGL::drawBorder(const Color& color, float width, const FloatRec
         return;
 
     RefPtr<TextureMapperShaderProgram> program = data().sharedGLData().getShaderProgram(TextureMapperShaderProgram::SolidColor);
-    m_context3D->useProgram(program->programID());
+    useProgram(*program);
 
     float r, g, b, a;
     Color(premultipliedARGBFromColor(color)).getRGBA(r, g, b, a);
@@ -387,6 +436,141 @@ static TextureMapperShaderProgram::Options optionsForFilterType(FilterOperation:
     }
 }
 
+bool TextureMapperGL::colorMatrixForFilter(const FilterOperation& operation, ColorMatrix& matrix)
+{
+    // These match the per-filter appliers in TextureMapperShaderProgram.
+    float amount;
+    switch (operation.type()) {
+    case FilterOperation::GRAYSCALE:
+    case FilterOperation::SEPIA:
+    case FilterOperation::SATURATE:
+    case FilterOperation::HUE_ROTATE:
+        amount = static_cast<const BasicColorMatrixFilterOperation&>(operation).amount();
+        break;
+    case FilterOperation::INVERT:
+    case FilterOperation::BRIGHTNESS:
+    case FilterOperation::CONTRAST:
+    case FilterOperation::OPACITY:
+        amount = static_cast<const BasicComponentTransferFilterOperation&>(operation).amount();
+        break;
+    default:
+        return false;
+    }
+
+    matrix = {{
+        1, 0, 0, 0, 0,
+        0, 1, 0, 0, 0,
+        0, 0, 1, 0, 0,
+        0, 0, 0, 1, 0
+    }};
+
+    switch (operation.type()) {
+    case FilterOperation::GRAYSCALE: {
+        float oneMinusAmount = 1 - amount;
+        matrix[0] = 0.2126 + 0.7874 * oneMinusAmount;
+        matrix[1] = 0.7152 - 0.7152 * oneMinusAmount;
+        matrix[2] = 0.0722 - 0.0722 * oneMinusAmount;
+        matrix[5] = 0.2126 - 0.2126 * oneMinusAmount;
+        matrix[6] = 0.7152 + 0.2848 * oneMinusAmount;
+        matrix[7] = 0.0722 - 0.0722 * oneMinusAmount;
+        matrix[10] = 0.2126 - 0.2126 * oneMinusAmount;
+        matrix[11] = 0.7152 - 0.7152 * oneMinusAmount;
+        matrix[12] = 0.0722 + 0.9278 * oneMinusAmount;
+        break;
+    }
+    case FilterOperation::SEPIA: {
+        float oneMinusAmount = 1 - amount;
+        matrix[0] = 0.393 + 0.607 * oneMinusAmount;
+        matrix[1] = 0.769 - 0.769 * oneMinusAmount;
+        matrix[2] = 0.189 - 0.189 * oneMinusAmount;
+        matrix[5] = 0.349 - 0.349 * oneMinusAmount;
+        matrix[6] = 0.686 + 0.314 * oneMinusAmount;
+        matrix[7] = 0.168 - 0.168 * oneMinusAmount;
+        matrix[10] = 0.272 - 0.272 * oneMinusAmount;
+        matrix[11] = 0.534 - 0.534 * oneMinusAmount;
+        matrix[12] = 0.131 + 0.869 * oneMinusAmount;
+        break;
+    }
+    case FilterOperation::SATURATE:
+        matrix[0] = 0.213 + 0.787 * amount;
+        matrix[1] = 0.715 - 0.715 * amount;
+        matrix[2] = 0.072 - 0.072 * amount;
+        matrix[5] = 0.213 - 0.213 * amount;
+        matrix[6] = 0.715 + 0.285 * amount;
+        matrix[7] = 0.072 - 0.072 * amount;
+        matrix[10] = 0.213 - 0.213 * amount;
+        matrix[11] = 0.715 - 0.715 * amount;
+        matrix[12] = 0.072 + 0.928 * amount;
+        break;
+    case FilterOperation::HUE_ROTATE: {
+        float c = cos(deg2rad(amount));
+        float s = sin(deg2rad(amount));
+        matrix[0] = 0.213 + c * 0.787 - s * 0.213;
+        matrix[1] = 0.715 - c * 0.715 - s * 0.715;
+        matrix[2] = 0.072 - c * 0.072 + s * 0.928;
+        matrix[5] = 0.213 - c * 0.213 + s * 0.143;
+        matrix[6] = 0.715 + c * 0.285 + s * 0.140;
+        matrix[7] = 0.072 - c * 0.072 - s * 0.283;
+        matrix[10] = 0.213 - c * 0.213 - s * 0.787;
+        matrix[11] = 0.715 - c * 0.715 + s * 0.715;
+        matrix[12] = 0.072 + c * 0.928 + s * 0.072;
+        break;
+    }
+    case FilterOperation::INVERT:
+        matrix[0] = matrix[6] = matrix[12] = 1 - 2 * amount;
+        matrix[4] = matrix[9] = matrix[14] = amount;
+        break;
+    case FilterOperation::BRIGHTNESS:
+        matrix[0] = matrix[6] = matrix[12] = amount;
+        break;
+    case FilterOperation::CONTRAST:
+        matrix[0] = matrix[6] = matrix[12] = amount;
+        matrix[4] = matrix[9] = matrix[14] = 0.5 * (1 - amount);
+        break;
+    case FilterOperation::OPACITY:
+        matrix[18] = amount;
+        break;
+    default:
+        ASSERT_NOT_REACHED();
+        break;
+    }
+    return true;
+}
+
+void TextureMapperGL::concatenateColorMatrix(ColorMatrix& matrix, const ColorMatrix& next)
+{
+    ColorMatrix result;
+    for (unsigned row = 0; row < 4; ++row) {
+        for (unsigned column = 0; column < 5; ++column) {
+            float value = column == 4 ? next[row * 5 + 4] : 0;
+            for (unsigned i = 0; i < 4; ++i)
+                value += next[row * 5 + i] * matrix[i * 5 + column];
+            result[row * 5 + column] = value;
+        }
+    }
+    matrix = result;
+}
+
+static bool colorMatrixAffectsOpacity(const TextureMapperGL::ColorMatrix& matrix)
+{
+    return matrix[15] || matrix[16] || matrix[17] || matrix[18] != 1 || matrix[19];
+}
+
+static void prepareColorMatrixProgram(TextureMapperShaderProgram* program, const TextureMapperGL::ColorMatrix& matrix)
+{
+    RefPtr<GraphicsContext3D> context = program->context();
+    context->useProgram(program->programID());
+
+    // GLSL matrices are column-major.
+    GC3Dfloat matrixAsFloats[16];
+    for (unsigned row = 0; row < 4; ++row) {
+        for (unsigned column = 0; column < 4; ++column)
+            matrixAsFloats[column * 4 + row] = matrix[row * 5 + column];
+    }
+    context->uniformMatrix4fv(program->colorMatrixLocation(), 1, false, matrixAsFloats);
+    context->uniform4f(program->colorMatrixOffsetLocation(), matrix[4], matrix[9], matrix[14], matrix[19]);
+}
+
 // Create a normal distribution of 21 values between -2 and 2.
 static const unsigned GaussianKernelHalfWidth = 11;
 static const float GaussianKernelStep = 0.2;
@@ -522,6 +706,13 @@ void TextureMapperGL::drawTexture(Platform3DObject texture, Flags flags, const I
             flags |= ShouldBlend;
     }
 
+    bool hasColorMatrix = data().filterInfo && data().filterInfo->hasColorMatrix;
+    if (hasColorMatrix) {
+        options |= TextureMapperShaderProgram::ColorMatrixFilter;
+        if (colorMatrixAffectsOpacity(data().filterInfo->colorMatrix))
+            flags |= ShouldBlend;
+    }
+
     if (useAntialiasing || opacity < 1)
         flags |= ShouldBlend;
 
@@ -530,6 +721,8 @@ void TextureMapperGL::drawTexture(Platform3DObject texture, Flags flags, const I
 
     if (filter)
         prepareFilterProgram(program.get(), *filter.get(), data().filterInfo->pass, textureSize, filterContentTextureID);
+    else if (hasColorMatrix)
+        prepareColorMatrixProgram(program.get(), data().filterInfo->colorMatrix);
 
     drawTexturedQuadWithProgram(program.get(), texture, flags, textureSize, targetRect, modelViewMatrix, opacity);
 }
@@ -544,7 +737,7 @@ void TextureMapperGL::drawSolidColor(const FloatRect& rect, const Transformation
     }
 
     RefPtr<TextureMapperShaderProgram> program = data().sharedGLData().getShaderProgram(options);
-    m_context3D->useProgram(program->programID());
+    useProgram(*program);
 
     float r, g, b, a;
     Color(premultipliedARGBFromColor(color)).getRGBA(r, g, b, a);
@@ -582,6 +775,7 @@ void TextureMapperGL::drawEdgeTriangles(TextureMapperShaderProgram* program)
     m_context3D->bindBuffer(GraphicsContext3D::ARRAY_BUFFER, vbo);
     m_context3D->vertexAttribPointer(program->vertexLocation(), 4, GraphicsContext3D::FLOAT, false, 0, 0);
     m_context3D->drawArrays(GraphicsContext3D::TRIANGLES, 0, 12);
+    ++data().drawCallCount;
     m_context3D->bindBuffer(GraphicsContext3D::ARRAY_BUFFER, 0);
 }
 
@@ -592,6 +786,7 @@ void TextureMapperGL::drawUnitRect(TextureMapperShaderProgram* program, GC3Denum
     m_context3D->bindBuffer(GraphicsContext3D::ARRAY_BUFFER, vbo);
     m_context3D->vertexAttribPointer(program->vertexLocation(), 2, GraphicsContext3D::FLOAT, false, 0, 0);
     m_context3D->drawArrays(drawingMode, 0, 4);
+    ++data().drawCallCount;
     m_context3D->bindBuffer(GraphicsContext3D::ARRAY_BUFFER, 0);
 }
 
@@ -602,32 +797,42 @@ void TextureMapperGL::draw(const FloatRect& rect, const TransformationMatrix& mo
 
     m_context3D->enableVertexAttribArray(shaderProgram->vertexLocation());
     shaderProgram->setMatrix(shaderProgram->modelViewMatrixLocation(), matrix);
-    shaderProgram->setMatrix(shaderProgram->projectionMatrixLocation(), data().projectionMatrix);
-
-    if (isInMaskMode()) {
-        m_context3D->blendFunc(GraphicsContext3D::ZERO, GraphicsContext3D::SRC_ALPHA);
-        m_context3D->enable(GraphicsContext3D::BLEND);
-    } else {
-        if (flags & ShouldBlend) {
-            m_context3D->blendFunc(GraphicsContext3D::ONE, GraphicsContext3D::ONE_MINUS_SRC_ALPHA);
-            m_context3D->enable(GraphicsContext3D::BLEND);
-        } else
-            m_context3D->disable(GraphicsContext3D::BLEND);
+
+    unsigned& projectionMatrixSerial = data().programProjectionMatrixSerials.add(shaderProgram->programID(), 0).iterator->value;
+    if (projectionMatrixSerial != data().projectionMatrixSerial) {
+        shaderProgram->setMatrix(shaderProgram->projectionMatrixLocation(), data().projectionMatrix);
+        projectionMatrixSerial = data().projectionMatrixSerial;
     }
 
+    if (isInMaskMode())
+        data().setBlendMode(TextureMapperGLData::BlendMode::Mask);
+    else
+        data().setBlendMode(flags & ShouldBlend ? TextureMapperGLData::BlendMode::SourceOver : TextureMapperGLData::BlendMode::None);
+
     if (flags & ShouldAntialias)
         drawEdgeTriangles(shaderProgram);
     else
         drawUnitRect(shaderProgram, drawingMode);
 
     m_context3D->disableVertexAttribArray(shaderProgram->vertexLocation());
-    m_context3D->blendFunc(GraphicsContext3D::ONE, GraphicsContext3D::ONE_MINUS_SRC_ALPHA);
-    m_context3D->enable(GraphicsContext3D::BLEND);
+}
+
+void TextureMapperGL::useProgram(TextureMapperShaderProgram& program)
+{
+    if (data().currentProgram == program.programID())
+        return;
+    m_context3D->useProgram(program.programID());
+    data().currentProgram = program.programID();
+}
+
+unsigned TextureMapperGL::drawCallCount() const
+{
+    return m_data->drawCallCount;
 }
 
 void TextureMapperGL::drawTexturedQuadWithProgram(TextureMapperShaderProgram* program, uint32_t texture, Flags flags, const IntSize& size, const FloatRect& rect, const TransformationMatrix& modelViewMatrix, float opacity)
 {
-    m_context3D->useProgram(program->programID());
+    useProgram(*program);
     m_context3D->activeTexture(GraphicsContext3D::TEXTURE0);
     GC3Denum target = flags & ShouldUseARBTextureRect ? GC3Denum(Extensions3D::TEXTURE_RECTANGLE_ARB) : GC3Denum(GraphicsContext3D::TEXTURE_2D);
     m_context3D->bindTexture(target, texture);
@@ -652,8 +857,10 @@ void TextureMapperGL::drawTexturedQuadWithProgram(TextureMapperShaderProgram* pr
         flags |= ShouldBlend;
 
     draw(rect, modelViewMatrix, program, GraphicsContext3D::TRIANGLE_FAN, flags);
-    m_context3D->texParameteri(GraphicsContext3D::TEXTURE_2D, GraphicsContext3D::TEXTURE_WRAP_S, GraphicsContext3D::CLAMP_TO_EDGE);
-    m_context3D->texParameteri(GraphicsContext3D::TEXTURE_2D, GraphicsContext3D::TEXTURE_WRAP_T, GraphicsContext3D::CLAMP_TO_EDGE);
+    if (wrapMode() == RepeatWrap) {
+        m_context3D->texParameteri(GraphicsContext3D::TEXTURE_2D, GraphicsContext3D::TEXTURE_WRAP_S, GraphicsContext3D::CLAMP_TO_EDGE);
+        m_context3D->texParameteri(GraphicsContext3D::TEXTURE_2D, GraphicsContext3D::TEXTURE_WRAP_T, GraphicsContext3D::CLAMP_TO_EDGE);
+    }
 }
 
 void TextureMapperGL::drawFiltered(const BitmapTexture& sampler, const BitmapTexture* contentTexture, const FilterOperation& filter, int pass)
@@ -668,6 +875,16 @@ void TextureMapperGL::drawFiltered(const BitmapTexture& sampler, const BitmapTex
     drawTexturedQuadWithProgram(program.get(), static_cast<const BitmapTextureGL&>(sampler).id(), 0, IntSize(1, 1), targetRect, TransformationMatrix(), 1);
 }
 
+void TextureMapperGL::drawFiltered(const BitmapTexture& sampler, const ColorMatrix& colorMatrix)
+{
+    RefPtr<TextureMapperShaderProgram> program = data().sharedGLData().getShaderProgram(TextureMapperShaderProgram::Texture | TextureMapperShaderProgram::ColorMatrixFilter);
+    ASSERT(program);
+
+    prepareColorMatrixProgram(program.get(), colorMatrix);
+    FloatRect targetRect(IntPoint::zero(), sampler.contentSize());
+    drawTexturedQuadWithProgram(program.get(), static_cast<const BitmapTextureGL&>(sampler).id(), 0, IntSize(1, 1), targetRect, TransformationMatrix(), 1);
+}
+
 static inline TransformationMatrix createProjectionMatrix(const IntSize& size, bool mirrored)
 {
     const float nearValue = 9999999;
@@ -689,6 +906,7 @@ void TextureMapperGL::bindDefaultSurface()
     m_context3D->bindFramebuffer(GraphicsContext3D::FRAMEBUFFER, data().targetFrameBuffer);
     IntSize viewportSize(data().viewport[2], data().viewport[3]);
     data().projectionMatrix = createProjectionMatrix(viewportSize, data().PaintFlags & PaintingMirrored);
+    ++data().projectionMatrixSerial;
     m_context3D->viewport(data().viewport[0], data().viewport[1], viewportSize.width(), viewportSize.height());
     m_clipStack.apply(m_context3D.get());
     data().currentSurface = nullptr;
@@ -703,6 +921,7 @@ void TextureMapperGL::bindSurface(BitmapTexture *surface)
 
     static_cast<BitmapTextureGL*>(surface)->bindAsSurface(m_context3D.get());
     data().projectionMatrix = createProjectionMatrix(surface->size(), true /* mirrored */);
+    ++data().projectionMatrixSerial;
     data().currentSurface = surface;
 }
 
@@ -740,7 +959,7 @@ void TextureMapperGL::beginClip(const TransformationMatrix& modelViewMatrix, con
 
     RefPtr<TextureMapperShaderProgram> program = data().sharedGLData().getShaderProgram(TextureMapperShaderProgram::SolidColor);
 
-    m_context3D->useProgram(program->programID());
+    useProgram(*program);
     m_context3D->enableVertexAttribArray(program->vertexLocation());
     const GC3Dfloat unitRect[] = {0, 0, 1, 0, 1, 1, 0, 1};
     m_context3D->vertexAttribPointer(program->vertexLocation(), 2, GraphicsContext3D::FLOAT, false, 0, GC3Dintptr(unitRect));
@@ -771,6 +990,7 @@ void TextureMapperGL::beginClip(const TransformationMatrix& modelViewMatrix, con
     program->setMatrix(program->projectionMatrixLocation(), data().projectionMatrix);
     program->setMatrix(program->modelViewMatrixLocation(), matrix);
     m_context3D->drawArrays(GraphicsContext3D::TRIANGLE_FAN, 0, 4);
+    data().drawCallCount += 2;
 
     // Clear the state.
     m_context3D->disableVertexAttribArray(program->vertexLocation());
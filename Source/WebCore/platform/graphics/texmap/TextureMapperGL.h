@@ -29,6 +29,7 @@
 #include "IntSize.h"
 #include "TextureMapper.h"
 #include "TransformationMatrix.h"
+#include <array>
 
 namespace WebCore {
 
@@ -117,12 +118,23 @@ public:
 
     void drawFiltered(const BitmapTexture& sourceTexture, const BitmapTexture* contentTexture, const FilterOperation&, int pass);
 
+    // A 4x5 row-major matrix applied to premultiplied colors, the last column being the offset.
+    // The color matrix and component transfer filters all reduce to one, so runs of them are
+    // drawn in a single pass.
+    typedef std::array<float, 20> ColorMatrix;
+    static bool colorMatrixForFilter(const FilterOperation&, ColorMatrix&);
+    static void concatenateColorMatrix(ColorMatrix&, const ColorMatrix& next);
+    void drawFiltered(const BitmapTexture& sourceTexture, const ColorMatrix&);
+
     void setEnableEdgeDistanceAntialiasing(bool enabled) { m_enableEdgeDistanceAntialiasing = enabled; }
 
+    virtual unsigned drawCallCount() const override;
+
 private:
     void drawTexturedQuadWithProgram(TextureMapperShaderProgram*, uint32_t texture, Flags, const IntSize&, const FloatRect&, const TransformationMatrix& modelViewMatrix, float opacity);
     void draw(const FloatRect&, const TransformationMatrix& modelViewMatrix, TextureMapperShaderProgram*, GC3Denum drawingMode, Flags);
 
+    void useProgram(TextureMapperShaderProgram&);
     void drawUnitRect(TextureMapperShaderProgram*, GC3Denum drawingMode);
     void drawEdgeTriangles(TextureMapperShaderProgram*);
 
@@ -233,6 +233,8 @@ static const char* fragmentTemplate =
         uniform vec2 u_blurRadius;
         uniform vec2 u_shadowOffset;
         uniform vec4 u_color;
+        uniform mat4 u_colorMatrix;
+        uniform vec4 u_colorMatrixOffset;
         uniform float u_gaussianKernel[GAUSSIAN_KERNEL_HALF_WIDTH];
 
         void noop(inout vec4 dummyParameter) { }
@@ -311,6 +313,11 @@ static const char* fragmentTemplate =
             color = vec4(color.r, color.g, color.b, color.a * u_filterAmount);
         }
 
+        void applyColorMatrixFilter(inout vec4 color)
+        {
+            color = u_colorMatrix * color + u_colorMatrixOffset;
+        }
+
         vec4 sampleColorAtRadius(float radius, vec2 texCoord)
         {
             vec2 coord = texCoord + radius * u_blurRadius;
@@ -371,6 +378,7 @@ static const char* fragmentTemplate =
             applyBrightnessFilterIfNeeded(color);
             applyContrastFilterIfNeeded(color);
             applyOpacityFilterIfNeeded(color);
+            applyColorMatrixFilterIfNeeded(color);
             applyBlurFilterIfNeeded(color, texCoord);
             applyAlphaBlurIfNeeded(color, texCoord);
             applyContentTextureIfNeeded(color, texCoord);
@@ -398,6 +406,7 @@ PassRefPtr<TextureMapperShaderProgram> TextureMapperShaderProgram::create(PassRe
     SET_APPLIER_FROM_OPTIONS(ContrastFilter);
     SET_APPLIER_FROM_OPTIONS(InvertFilter);
     SET_APPLIER_FROM_OPTIONS(OpacityFilter);
+    SET_APPLIER_FROM_OPTIONS(ColorMatrixFilter);
     SET_APPLIER_FROM_OPTIONS(BlurFilter);
     SET_APPLIER_FROM_OPTIONS(AlphaBlur);
     SET_APPLIER_FROM_OPTIONS(ContentTexture);
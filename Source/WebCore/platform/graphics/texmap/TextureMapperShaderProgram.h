@@ -53,7 +53,8 @@ public:
         OpacityFilter    = 1L << 13,
         BlurFilter       = 1L << 14,
         AlphaBlur        = 1L << 15,
-        ContentTexture   = 1L << 16
+        ContentTexture   = 1L << 16,
+        ColorMatrixFilter = 1L << 17
     };
 
     typedef unsigned Options;
@@ -78,6 +79,8 @@ public:
     TEXMAP_DECLARE_UNIFORM(gaussianKernel)
     TEXMAP_DECLARE_UNIFORM(blurRadius)
     TEXMAP_DECLARE_UNIFORM(shadowOffset)
+    TEXMAP_DECLARE_UNIFORM(colorMatrix)
+    TEXMAP_DECLARE_UNIFORM(colorMatrixOffset)
     TEXMAP_DECLARE_SAMPLER(contentTexture)
 
     void setMatrix(GC3Duint, const TransformationMatrix&);
@@ -288,6 +288,11 @@ FloatRect CompositingCoordinator::visibleContentsRect() const
     return m_visibleContentsRect;
 }
 
+bool CompositingCoordinator::usesThreadedTileRasterization() const
+{
+    return m_page->settings().threadedTileRasterizationEnabled();
+}
+
 CoordinatedGraphicsLayer* CompositingCoordinator::mainContentsLayer()
 {
     if (!m_rootCompositingLayer)
@@ -107,6 +107,7 @@ private:
     virtual PassRefPtr<CoordinatedImageBacking> createImageBackingIfNeeded(Image*) override;
     virtual void detachLayer(CoordinatedGraphicsLayer*) override;
     virtual bool paintToSurface(const WebCore::IntSize&, WebCore::CoordinatedSurface::Flags, uint32_t& /* atlasID */, WebCore::IntPoint&, WebCore::CoordinatedSurface::Client*) override;
+    virtual bool usesThreadedTileRasterization() const override;
     virtual void syncLayerState(CoordinatedLayerID, CoordinatedGraphicsLayerState&) override;
 
     // UpdateAtlas::Client
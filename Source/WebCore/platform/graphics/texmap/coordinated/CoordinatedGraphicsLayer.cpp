@@ -867,6 +867,7 @@ void CoordinatedGraphicsLayer::createBackingStore()
 {
     m_mainBackingStore = std::make_unique<TiledBackingStore>(this, effectiveContentsScale());
     m_mainBackingStore->setSupportsAlpha(!contentsOpaque());
+    m_mainBackingStore->setUsesThreadedRasterization(m_coordinator->usesThreadedTileRasterization());
 }
 
 void CoordinatedGraphicsLayer::tiledBackingStorePaint(GraphicsContext& context, const IntRect& rect)
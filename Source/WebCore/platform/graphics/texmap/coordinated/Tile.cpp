@@ -27,10 +27,13 @@
 #include "Tile.h"
 
 #if USE(COORDINATED_GRAPHICS)
+#include "DisplayListRecorder.h"
+#include "DisplayListReplayer.h"
 #include "GraphicsContext.h"
 #include "SurfaceUpdateInfo.h"
 #include "TiledBackingStore.h"
 #include "TiledBackingStoreClient.h"
+#include <wtf/MainThread.h>
 
 namespace WebCore {
 
@@ -72,7 +75,13 @@ bool Tile::updateBackBuffer()
 
     SurfaceUpdateInfo updateInfo;
 
-    if (!m_tiledBackingStore.client()->paintToSurface(m_dirtyRect.size(), updateInfo.atlasID, updateInfo.surfaceOffset, this))
+    bool didPaint = m_tiledBackingStore.client()->paintToSurface(m_dirtyRect.size(), updateInfo.atlasID, updateInfo.surfaceOffset, this);
+
+    // A recording has to be destroyed on the main thread, and is outdated by the next invalidation anyway.
+    m_recordedContents = nullptr;
+    m_rasterizedContents = nullptr;
+
+    if (!didPaint)
         return false;
 
     updateInfo.updateRect = m_dirtyRect;
@@ -94,12 +103,53 @@ bool Tile::updateBackBuffer()
 }
 
 void Tile::paintToSurfaceContext(GraphicsContext& context)
+{
+    if (m_rasterizedContents) {
+        context.drawImageBuffer(*m_rasterizedContents, FloatPoint(), ImagePaintingOptions(CompositeCopy));
+        return;
+    }
+
+    if (m_recordedContents) {
+        DisplayList::Replayer(context, *m_recordedContents).replay();
+        return;
+    }
+
+    paintDirtyContents(context);
+}
+
+void Tile::paintDirtyContents(GraphicsContext& context)
 {
     context.translate(-m_dirtyRect.x(), -m_dirtyRect.y());
     context.scale(FloatSize(m_tiledBackingStore.contentsScale(), m_tiledBackingStore.contentsScale()));
     m_tiledBackingStore.client()->tiledBackingStorePaint(context, m_tiledBackingStore.mapToContents(m_dirtyRect));
 }
 
+void Tile::recordDirtyContents()
+{
+    ASSERT(isMainThread());
+    ASSERT(isDirty());
+
+    m_recordedContents = std::make_unique<DisplayList::DisplayList>();
+    m_rasterizedContents = nullptr;
+
+    {
+        GraphicsContext context(static_cast<PlatformGraphicsContext*>(nullptr));
+        DisplayList::Recorder recorder(context, *m_recordedContents, FloatRect(FloatPoint(), m_dirtyRect.size()));
+        paintDirtyContents(context);
+    }
+
+    // The buffer is created here because only the rasterization itself may happen on another thread.
+    if (!m_recordedContents->isEmpty() && m_recordedContents->canBeReplayedOnAnyThread())
+        m_rasterizedContents = ImageBuffer::create(m_dirtyRect.size(), Unaccelerated);
+}
+
+void Tile::rasterizeRecordedContents()
+{
+    ASSERT(m_recordedContents);
+    ASSERT(m_rasterizedContents);
+    DisplayList::Replayer(m_rasterizedContents->context(), *m_recordedContents).replay();
+}
+
 bool Tile::isReadyToPaint() const
 {
     return m_ID != InvalidTileID;
@@ -28,6 +28,8 @@
 
 #if USE(COORDINATED_GRAPHICS)
 #include "CoordinatedSurface.h"
+#include "DisplayList.h"
+#include "ImageBuffer.h"
 #include "IntPoint.h"
 #include "IntPointHash.h"
 #include "IntRect.h"
@@ -50,6 +52,14 @@ public:
     bool updateBackBuffer();
     bool isReadyToPaint() const;
 
+    // With threaded rasterization, the contents of the dirty rect are recorded on the main thread
+    // before updating the back buffer, and the recordings that allow it are rasterized into a buffer
+    // by worker threads. updateBackBuffer() then copies the buffer into the surface, or replays the
+    // recording if it had to stay on the main thread.
+    void recordDirtyContents();
+    bool hasContentsToRasterize() const { return !!m_rasterizedContents; }
+    void rasterizeRecordedContents();
+
     const Coordinate& coordinate() const { return m_coordinate; }
     const IntRect& rect() const { return m_rect; }
     void resize(const IntSize&);
@@ -57,12 +67,17 @@ public:
     virtual void paintToSurfaceContext(GraphicsContext&) override;
 
 private:
+    void paintDirtyContents(GraphicsContext&);
+
     TiledBackingStore& m_tiledBackingStore;
     Coordinate m_coordinate;
     IntRect m_rect;
 
     uint32_t m_ID;
     IntRect m_dirtyRect;
+
+    std::unique_ptr<DisplayList::DisplayList> m_recordedContents;
+    std::unique_ptr<ImageBuffer> m_rasterizedContents;
 };
 
 } // namespace WebCore
@@ -23,6 +23,7 @@
 #if USE(COORDINATED_GRAPHICS)
 #include "GraphicsContext.h"
 #include "TiledBackingStoreClient.h"
+#include <wtf/ParallelJobs.h>
 
 namespace WebCore {
 
@@ -41,6 +42,7 @@ TiledBackingStore::TiledBackingStore(TiledBackingStoreClient* client, float cont
     , m_contentsScale(contentsScale)
     , m_supportsAlpha(false)
     , m_pendingTileCreation(false)
+    , m_usesThreadedRasterization(false)
 {
 }
 
@@ -87,23 +89,92 @@ void TiledBackingStore::invalidate(const IntRect& contentsDirtyRect)
     }
 }
 
+struct TileRasterizationParameters {
+    Tile* const* tiles;
+    size_t tileCount;
+    size_t firstTile;
+    size_t tileStride;
+};
+
+static void rasterizeTilesWorker(TileRasterizationParameters* parameters)
+{
+    for (size_t i = parameters->firstTile; i < parameters->tileCount; i += parameters->tileStride)
+        parameters->tiles[i]->rasterizeRecordedContents();
+}
+
+void TiledBackingStore::rasterizeTilesInParallel(const Vector<Tile*>& dirtyTiles)
+{
+    // Painting the layer contents has to happen on the main thread, so it is only recorded there.
+    Vector<Tile*> tilesToRasterize;
+    for (auto* tile : dirtyTiles) {
+        tile->recordDirtyContents();
+        if (tile->hasContentsToRasterize())
+            tilesToRasterize.append(tile);
+    }
+
+    if (tilesToRasterize.isEmpty())
+        return;
+
+    // The jobs take the tiles in turns so that the most urgent ones are rasterized first by all of them.
+    ParallelJobs<TileRasterizationParameters> parallelJobs(&rasterizeTilesWorker, tilesToRasterize.size());
+    size_t jobCount = parallelJobs.numberOfJobs();
+    for (size_t job = 0; job < jobCount; ++job) {
+        TileRasterizationParameters& parameters = parallelJobs.parameter(job);
+        parameters.tiles = tilesToRasterize.data();
+        parameters.tileCount = tilesToRasterize.size();
+        parameters.firstTile = job;
+        parameters.tileStride = jobCount;
+    }
+    parallelJobs.execute();
+}
+
 void TiledBackingStore::updateTileBuffers()
 {
-    // FIXME: In single threaded case, tile back buffers could be updated asynchronously 
-    // one by one and then swapped to front in one go. This would minimize the time spent
-    // blocking on tile updates.
-    bool updated = false;
+    Vector<std::pair<double, Tile*>> tilesByPriority;
     for (auto& tile : m_tiles.values()) {
-        if (!tile->isDirty())
-            continue;
+        if (tile->isDirty())
+            tilesByPriority.append(std::make_pair(tilePriority(tile->coordinate()), tile.get()));
+    }
+
+    if (tilesByPriority.isEmpty())
+        return;
+
+    // Update the tiles in the viewport first, then the ones we are scrolling towards, so that those
+    // are not the ones left out when the update atlases run out of room.
+    std::stable_sort(tilesByPriority.begin(), tilesByPriority.end(), [](const std::pair<double, Tile*>& a, const std::pair<double, Tile*>& b) {
+        return a.first < b.first;
+    });
+
+    Vector<Tile*> dirtyTiles;
+    dirtyTiles.reserveInitialCapacity(tilesByPriority.size());
+    for (auto& tile : tilesByPriority)
+        dirtyTiles.uncheckedAppend(tile.second);
 
+    if (m_usesThreadedRasterization)
+        rasterizeTilesInParallel(dirtyTiles);
+
+    bool updated = false;
+    for (auto* tile : dirtyTiles)
         updated |= tile->updateBackBuffer();
-    }
 
     if (updated)
         m_client->didUpdateTileBuffers();
 }
 
+double TiledBackingStore::tilePriority(const Tile::Coordinate& tileCoordinate) const
+{
+    double distance = tileDistance(m_visibleRect, tileCoordinate);
+    if (!distance || m_trajectoryVector == FloatPoint())
+        return distance;
+
+    // Between tiles as far from the viewport, the ones lying in the direction of the scroll come first.
+    FloatPoint viewCenter = m_visibleRect.center();
+    FloatPoint tileCenter = tileRectForCoordinate(tileCoordinate).center();
+    FloatPoint direction(tileCenter.x() - viewCenter.x(), tileCenter.y() - viewCenter.y());
+    direction.normalize();
+    return distance - direction.dot(m_trajectoryVector) / 2;
+}
+
 double TiledBackingStore::tileDistance(const IntRect& viewport, const Tile::Coordinate& tileCoordinate) const
 {
     if (viewport.intersects(tileRectForCoordinate(tileCoordinate)))
@@ -29,6 +29,7 @@
 #include "Timer.h"
 #include <wtf/Assertions.h>
 #include <wtf/HashMap.h>
+#include <wtf/Vector.h>
 
 namespace WebCore {
 
@@ -65,6 +66,9 @@ public:
 
     void setSupportsAlpha(bool);
 
+    // Rasterizes the tiles with worker threads when the recording of their contents allows it.
+    void setUsesThreadedRasterization(bool usesThreadedRasterization) { m_usesThreadedRasterization = usesThreadedRasterization; }
+
 private:
     void createTiles(const IntRect& visibleRect, const IntRect& scaledContentsRect);
     void computeCoverAndKeepRect(const IntRect& visibleRect, IntRect& coverRect, IntRect& keepRect) const;
@@ -78,6 +82,9 @@ private:
 
     void paintCheckerPattern(GraphicsContext*, const IntRect&, const Tile::Coordinate&);
 
+    double tilePriority(const Tile::Coordinate&) const;
+    void rasterizeTilesInParallel(const Vector<Tile*>&);
+
 private:
     TiledBackingStoreClient* m_client;
 
@@ -99,6 +106,7 @@ private:
 
     bool m_supportsAlpha;
     bool m_pendingTileCreation;
+    bool m_usesThreadedRasterization;
 
     friend class Tile;
 };
@@ -35,6 +35,12 @@
 #include <algorithm>
 #include <cmath>
 
+#if CPU(X86_64)
+#include <emmintrin.h>
+#elif HAVE(ARM_NEON_INTRINSICS) && !CPU(BIG_ENDIAN)
+#include <arm_neon.h>
+#endif
+
 using namespace std;
 
 namespace WebCore {
@@ -229,6 +235,122 @@ void ImageFrame::setStatus(FrameStatus status)
     m_status = status;
 }
 
+#if CPU(X86_64)
+
+// Turns four pixels with R, G and B in their three low bytes into PixelData.
+static inline __m128i opaquePixelsFromRGBX(__m128i rgbx)
+{
+    __m128i red = _mm_slli_epi32(_mm_and_si128(rgbx, _mm_set1_epi32(0xFF)), 16);
+    __m128i green = _mm_and_si128(rgbx, _mm_set1_epi32(0xFF00));
+    __m128i blue = _mm_and_si128(_mm_srli_epi32(rgbx, 16), _mm_set1_epi32(0xFF));
+    return _mm_or_si128(_mm_or_si128(red, green), _mm_or_si128(blue, _mm_set1_epi32(0xFF000000)));
+}
+
+// Multiplies the color of two pixels, unpacked to 16 bits per channel, by their alpha. Like
+// setRGBA(), this rounds down: (x + 1 + ((x + 1) >> 8)) >> 8 is x / 255 for every x = c * a.
+static inline __m128i premultiplyUnpackedPixels(__m128i pixels)
+{
+    __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    __m128i product = _mm_add_epi16(_mm_mullo_epi16(pixels, alpha), _mm_set1_epi16(1));
+    return _mm_srli_epi16(_mm_add_epi16(product, _mm_srli_epi16(product, 8)), 8);
+}
+
+#elif HAVE(ARM_NEON_INTRINSICS) && !CPU(BIG_ENDIAN)
+
+// Rounds down like setRGBA(): (x + 1 + ((x + 1) >> 8)) >> 8 is x / 255 for every x = c * a.
+static inline uint8x8_t premultiplyChannel(uint8x8_t channel, uint8x8_t alpha)
+{
+    uint16x8_t product = vaddq_u16(vmull_u8(channel, alpha), vdupq_n_u16(1));
+    return vshrn_n_u16(vaddq_u16(product, vshrq_n_u16(product, 8)), 8);
+}
+
+#endif
+
+void ImageFrame::setRGBRow(PixelData* dest, const unsigned char* rgb, unsigned width)
+{
+    unsigned x = 0;
+#if CPU(X86_64)
+    // Each 16 byte load holds four pixels in its first 12 bytes; shift pixel i up by i bytes
+    // to line it up with its 32-bit lane.
+    const __m128i lane0 = _mm_set_epi32(0, 0, 0, -1);
+    const __m128i lane1 = _mm_set_epi32(0, 0, -1, 0);
+    const __m128i lane2 = _mm_set_epi32(0, -1, 0, 0);
+    const __m128i lane3 = _mm_set_epi32(-1, 0, 0, 0);
+    for (; x + 6 <= width; x += 4) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgb + x * 3));
+        __m128i rgbx = _mm_or_si128(
+            _mm_or_si128(_mm_and_si128(bytes, lane0), _mm_and_si128(_mm_slli_si128(bytes, 1), lane1)),
+            _mm_or_si128(_mm_and_si128(_mm_slli_si128(bytes, 2), lane2), _mm_and_si128(_mm_slli_si128(bytes, 3), lane3)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + x), opaquePixelsFromRGBX(rgbx));
+    }
+#elif HAVE(ARM_NEON_INTRINSICS) && !CPU(BIG_ENDIAN)
+    const uint8x16_t opaque = vdupq_n_u8(0xFF);
+    for (; x + 16 <= width; x += 16) {
+        uint8x16x3_t source = vld3q_u8(rgb + x * 3);
+        uint8x16x4_t pixels = { { source.val[2], source.val[1], source.val[0], opaque } };
+        vst4q_u8(reinterpret_cast<uint8_t*>(dest + x), pixels);
+    }
+#endif
+    for (; x < width; ++x) {
+        const unsigned char* pixel = rgb + x * 3;
+        dest[x] = 0xFF000000U | pixel[0] << 16 | pixel[1] << 8 | pixel[2];
+    }
+}
+
+bool ImageFrame::setRGBARow(PixelData* dest, const unsigned char* rgba, unsigned width)
+{
+    unsigned x = 0;
+    unsigned alphaMask = 0xFF;
+#if CPU(X86_64)
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaChannel = _mm_set1_epi32(0xFF000000);
+    __m128i alphaAccumulator = alphaChannel;
+    for (; x + 4 <= width; x += 4) {
+        __m128i source = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + x * 4));
+        // Swap R and B to get PixelData.
+        __m128i redAndBlue = _mm_and_si128(source, _mm_set1_epi32(0x00FF00FF));
+        __m128i pixels = _mm_or_si128(_mm_and_si128(source, _mm_set1_epi32(0xFF00FF00)),
+            _mm_or_si128(_mm_slli_epi32(redAndBlue, 16), _mm_srli_epi32(redAndBlue, 16)));
+        alphaAccumulator = _mm_and_si128(alphaAccumulator, pixels);
+        if (m_premultiplyAlpha) {
+            __m128i premultiplied = _mm_packus_epi16(premultiplyUnpackedPixels(_mm_unpacklo_epi8(pixels, zero)), premultiplyUnpackedPixels(_mm_unpackhi_epi8(pixels, zero)));
+            pixels = _mm_or_si128(_mm_andnot_si128(alphaChannel, premultiplied), _mm_and_si128(pixels, alphaChannel));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + x), pixels);
+    }
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(alphaAccumulator, alphaChannel)) != 0xFFFF)
+        alphaMask = 0;
+#elif HAVE(ARM_NEON_INTRINSICS) && !CPU(BIG_ENDIAN)
+    uint8x8_t alphaAccumulator = vdup_n_u8(0xFF);
+    for (; x + 8 <= width; x += 8) {
+        uint8x8x4_t source = vld4_u8(rgba + x * 4);
+        uint8x8_t alpha = source.val[3];
+        alphaAccumulator = vand_u8(alphaAccumulator, alpha);
+        uint8x8x4_t pixels;
+        if (m_premultiplyAlpha) {
+            pixels.val[0] = premultiplyChannel(source.val[2], alpha);
+            pixels.val[1] = premultiplyChannel(source.val[1], alpha);
+            pixels.val[2] = premultiplyChannel(source.val[0], alpha);
+        } else {
+            pixels.val[0] = source.val[2];
+            pixels.val[1] = source.val[1];
+            pixels.val[2] = source.val[0];
+        }
+        pixels.val[3] = alpha;
+        vst4_u8(reinterpret_cast<uint8_t*>(dest + x), pixels);
+    }
+    if (vget_lane_u64(vreinterpret_u64_u8(alphaAccumulator), 0) != ~0ULL)
+        alphaMask = 0;
+#endif
+    for (; x < width; ++x) {
+        const unsigned char* pixel = rgba + x * 4;
+        unsigned alpha = pixel[3];
+        alphaMask &= alpha;
+        setRGBA(dest + x, pixel[0], pixel[1], pixel[2], alpha);
+    }
+    return alphaMask != 0xFF;
+}
+
 namespace {
 
 enum MatchType {
@@ -279,12 +401,38 @@ bool ImageDecoder::frameHasAlphaAtIndex(size_t index) const
     return true;
 }
 
+bool ImageDecoder::frameIsCompleteAtIndex(size_t index)
+{
+    ImageFrame* buffer = frameBufferAtIndex(index);
+    return buffer && buffer->status() == ImageFrame::FrameComplete;
+}
+
+float ImageDecoder::frameDurationAtIndex(size_t index)
+{
+    ImageFrame* buffer = frameBufferAtIndex(index);
+    if (!buffer || buffer->status() == ImageFrame::FrameEmpty)
+        return 0;
+    return normalizedFrameDuration(buffer->duration());
+}
+
+float ImageDecoder::normalizedFrameDuration(unsigned milliseconds)
+{
+    // Many annoying ads specify a 0 duration to make an image flash as quickly as possible.
+    // We follow Firefox's behavior and use a duration of 100 ms for any frames that specify
+    // a duration of <= 10 ms. See <rdar://problem/7689300> and <http://webkit.org/b/36082>
+    // for more information.
+    const float duration = milliseconds / 1000.0f;
+    if (duration < 0.011f)
+        return 0.100f;
+    return duration;
+}
+
 unsigned ImageDecoder::frameBytesAtIndex(size_t index) const
 {
     if (m_frameBufferCache.size() <= index)
         return 0;
     // FIXME: Use the dimension of the requested frame.
-    return m_size.area() * sizeof(ImageFrame::PixelData);
+    return scaledSize().area() * sizeof(ImageFrame::PixelData);
 }
 
 void ImageDecoder::prepareScaleDataIfNecessary()
@@ -296,15 +444,33 @@ void ImageDecoder::prepareScaleDataIfNecessary()
     int width = size().width();
     int height = size().height();
     int numPixels = height * width;
-    if (m_maxNumPixels <= 0 || numPixels <= m_maxNumPixels)
+    double scale = 1.0 / (1 << m_subsamplingLevel);
+    if (m_maxNumPixels > 0 && numPixels > m_maxNumPixels)
+        scale = std::min(scale, sqrt(m_maxNumPixels / (double)numPixels));
+    if (scale >= 1)
         return;
 
     m_scaled = true;
-    double scale = sqrt(m_maxNumPixels / (double)numPixels);
     fillScaledValues(m_scaledColumns, scale, width);
     fillScaledValues(m_scaledRows, scale, height);
 }
 
+void ImageDecoder::setScaledSizeDecodedByLibrary(const IntSize& decodedSize)
+{
+    m_scaledColumns.clear();
+    m_scaledRows.clear();
+    m_scaled = decodedSize != size();
+    if (!m_scaled)
+        return;
+
+    m_scaledColumns.reserveInitialCapacity(decodedSize.width());
+    for (int x = 0; x < decodedSize.width(); ++x)
+        m_scaledColumns.uncheckedAppend(x);
+    m_scaledRows.reserveInitialCapacity(decodedSize.height());
+    for (int y = 0; y < decodedSize.height(); ++y)
+        m_scaledRows.uncheckedAppend(y);
+}
+
 int ImageDecoder::upperBoundScaledX(int origX, int searchStart)
 {
     return getScaledValue<UpperBound>(m_scaledColumns, origX, searchStart);
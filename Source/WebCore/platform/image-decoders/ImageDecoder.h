@@ -109,6 +109,10 @@ namespace WebCore {
         // FrameData::clear()).
         PassNativeImagePtr asNewNativeImage() const;
 
+        // Like asNewNativeImage(), but the native image owns a copy of the
+        // pixel data, so it stays valid after the decoder is destroyed.
+        PassNativeImagePtr copyAsNewNativeImage() const;
+
         bool hasAlpha() const;
         const IntRect& originalFrameRect() const { return m_originalFrameRect; }
         FrameStatus status() const { return m_status; }
@@ -165,6 +169,13 @@ namespace WebCore {
             *dest = (a << 24 | r << 16 | g << 8 | b);
         }
 
+        // Row versions of setRGBA() for the packed RGB and RGBA rows decoding
+        // libraries produce; these use SIMD where available. |rgba| may be the
+        // same memory as |dest|. setRGBARow() returns whether any pixel has
+        // an alpha below 255.
+        void setRGBRow(PixelData* dest, const unsigned char* rgb, unsigned width);
+        bool setRGBARow(PixelData* dest, const unsigned char* rgba, unsigned width);
+
 #if ENABLE(APNG)
         static inline unsigned divide255(unsigned a)
         {
@@ -240,6 +251,11 @@ namespace WebCore {
     // ENABLE(IMAGE_DECODER_DOWN_SAMPLING) allows image decoders to downsample
     // at decode time.  Image decoders will downsample any images larger than
     // |m_maxNumPixels|.  FIXME: Not yet supported by all decoders.
+    //
+    // Decoders that canDecodeSubsampled() can also be asked to decode at
+    // 1/2, 1/4 or 1/8 of the image size with setSubsamplingLevel(), so that
+    // images painted much smaller than their natural size are never decoded
+    // at full size.
     class ImageDecoder {
         WTF_MAKE_NONCOPYABLE(ImageDecoder); WTF_MAKE_FAST_ALLOCATED;
     public:
@@ -249,6 +265,7 @@ namespace WebCore {
             , m_ignoreGammaAndColorProfile(gammaAndColorProfileOption == ImageSource::GammaAndColorProfileIgnored)
             , m_sizeAvailable(false)
             , m_maxNumPixels(-1)
+            , m_subsamplingLevel(0)
             , m_isAllDataReceived(false)
             , m_failed(false) { }
 
@@ -262,6 +279,7 @@ namespace WebCore {
         virtual String filenameExtension() const = 0;
 
         bool isAllDataReceived() const { return m_isAllDataReceived; }
+        SharedBuffer* data() const { return m_data.get(); }
 
         virtual void setData(SharedBuffer* data, bool allDataReceived)
         {
@@ -322,6 +340,12 @@ namespace WebCore {
         // Make the best effort guess to check if the requested frame has alpha channel.
         virtual bool frameHasAlphaAtIndex(size_t) const;
 
+        // Whether all the data for the frame has been received, and its
+        // duration in seconds. These decode the frame unless the decoder can
+        // answer without doing so.
+        virtual bool frameIsCompleteAtIndex(size_t);
+        virtual float frameDurationAtIndex(size_t);
+
         // Number of bytes in the decoded frame requested. Return 0 if not yet decoded.
         virtual unsigned frameBytesAtIndex(size_t) const;
 
@@ -399,11 +423,29 @@ namespace WebCore {
         void setMaxNumPixels(int m) { m_maxNumPixels = m; }
 #endif
 
+        // Whether the decoder honors setSubsamplingLevel().
+        virtual bool canDecodeSubsampled() const { return false; }
+
+        // Must be called before the size is decoded; the level of a decoder
+        // that has started decoding cannot change.
+        void setSubsamplingLevel(SubsamplingLevel level)
+        {
+            ASSERT(canDecodeSubsampled() || !level);
+            m_subsamplingLevel = level;
+        }
+        SubsamplingLevel subsamplingLevel() const { return m_subsamplingLevel; }
+
+        // For libraries that scale while decoding (e.g. libjpeg): the rows and
+        // columns the library outputs map one to one onto the frame buffer.
+        void setScaledSizeDecodedByLibrary(const IntSize&);
+
         // If the image has a cursor hot-spot, stores it in the argument
         // and returns true. Otherwise returns false.
         virtual bool hotSpot(IntPoint&) const { return false; }
 
     protected:
+        static float normalizedFrameDuration(unsigned milliseconds);
+
         void prepareScaleDataIfNecessary();
         int upperBoundScaledX(int origX, int searchStart = 0);
         int lowerBoundScaledX(int origX, int searchStart = 0);
@@ -435,6 +477,7 @@ namespace WebCore {
         IntSize m_size;
         bool m_sizeAvailable;
         int m_maxNumPixels;
+        SubsamplingLevel m_subsamplingLevel;
         bool m_isAllDataReceived;
         bool m_failed;
     };
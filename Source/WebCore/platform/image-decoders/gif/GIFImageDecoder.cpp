@@ -117,11 +117,51 @@ ImageFrame* GIFImageDecoder::frameBufferAtIndex(size_t index)
         return 0;
 
     ImageFrame& frame = m_frameBufferCache[index];
-    if (frame.status() != ImageFrame::FrameComplete)
+    if (frame.status() != ImageFrame::FrameComplete) {
+        // Frames before |index| may have been cleared to save memory. Rather
+        // than replaying the animation from its first frame, start at the
+        // earliest frame |index| depends on that can be drawn over a frame we
+        // still have, or over nothing at all.
+        if (m_reader) {
+            size_t startFrame = index;
+            for (size_t previous = requiredPreviousFrameIndex(index); previous != notFound && m_frameBufferCache[previous].status() != ImageFrame::FrameComplete; previous = requiredPreviousFrameIndex(previous))
+                startFrame = previous;
+
+            size_t currentFrame = m_reader->currentDecodingFrame();
+            if (startFrame != currentFrame) {
+                if (currentFrame < m_frameBufferCache.size() && m_frameBufferCache[currentFrame].status() == ImageFrame::FramePartial)
+                    m_frameBufferCache[currentFrame].clearPixelData();
+                m_reader->setCurrentDecodingFrame(startFrame);
+            }
+        }
         decode(index + 1, GIFFullQuery);
+    }
     return &frame;
 }
 
+bool GIFImageDecoder::frameIsCompleteAtIndex(size_t index)
+{
+    if (index >= frameCount())
+        return false;
+
+    // The reader knows when all the data of a frame has arrived, so there is
+    // no need to decode the frame to answer.
+    if (m_frameBufferCache[index].status() == ImageFrame::FrameComplete)
+        return true;
+    const GIFFrameContext* frameContext = m_reader ? m_reader->frameContextAtIndex(index) : 0;
+    return frameContext && frameContext->isComplete();
+}
+
+float GIFImageDecoder::frameDurationAtIndex(size_t index)
+{
+    if (index >= frameCount())
+        return 0;
+
+    if (const GIFFrameContext* frameContext = m_reader ? m_reader->frameContextAtIndex(index) : 0)
+        return normalizedFrameDuration(frameContext->delayTime);
+    return ImageDecoder::frameDurationAtIndex(index);
+}
+
 bool GIFImageDecoder::setFailed()
 {
     m_reader = nullptr;
@@ -258,29 +298,27 @@ bool GIFImageDecoder::frameComplete(unsigned frameIndex, unsigned frameDuration,
         // resulting buffer was non-transparent, and we can setHasAlpha(false).
         if (buffer.originalFrameRect().contains(IntRect(IntPoint(), scaledSize())))
             buffer.setHasAlpha(false);
-        else if (frameIndex) {
+        else {
             // Tricky case.  This frame does not have alpha only if everywhere
             // outside its rect doesn't have alpha.  To know whether this is
             // true, we check the start state of the frame -- if it doesn't have
             // alpha, we're safe.
             //
-            // First skip over prior DisposeOverwritePrevious frames (since they
-            // don't affect the start state of this frame) the same way we do in
-            // initFrameBuffer().
-            const ImageFrame* prevBuffer = &m_frameBufferCache[--frameIndex];
-            while (frameIndex && (prevBuffer->disposalMethod() == ImageFrame::DisposeOverwritePrevious))
-                prevBuffer = &m_frameBufferCache[--frameIndex];
-
-            // Now, if we're at a DisposeNotSpecified or DisposeKeep frame, then
-            // we can say we have no alpha if that frame had no alpha.  But
+            // The start state is the frame initFrameBuffer() drew this one
+            // over.  If that is a DisposeNotSpecified or DisposeKeep frame,
+            // then we can say we have no alpha if that frame had no alpha.  But
             // since in initFrameBuffer() we already copied that frame's alpha
             // state into the current frame's, we need do nothing at all here.
             //
             // The only remaining case is a DisposeOverwriteBgcolor frame.  If
             // it had no alpha, and its rect is contained in the current frame's
             // rect, we know the current frame has no alpha.
-            if ((prevBuffer->disposalMethod() == ImageFrame::DisposeOverwriteBgcolor) && !prevBuffer->hasAlpha() && buffer.originalFrameRect().contains(prevBuffer->originalFrameRect()))
-                buffer.setHasAlpha(false);
+            size_t requiredPreviousFrameIndex = this->requiredPreviousFrameIndex(frameIndex);
+            if (requiredPreviousFrameIndex != notFound) {
+                const ImageFrame& prevBuffer = m_frameBufferCache[requiredPreviousFrameIndex];
+                if ((prevBuffer.disposalMethod() == ImageFrame::DisposeOverwriteBgcolor) && !prevBuffer.hasAlpha() && buffer.originalFrameRect().contains(prevBuffer.originalFrameRect()))
+                    buffer.setHasAlpha(false);
+            }
         }
     }
 
@@ -355,48 +393,23 @@ bool GIFImageDecoder::initFrameBuffer(unsigned frameIndex)
     int bottom = lowerBoundScaledY(frameRect.maxY(), top);
     buffer->setOriginalFrameRect(IntRect(left, top, right - left, bottom - top));
 
-    if (!frameIndex) {
-        // This is the first frame, so we're not relying on any previous data.
+    size_t requiredPreviousFrameIndex = this->requiredPreviousFrameIndex(frameIndex);
+    if (requiredPreviousFrameIndex == notFound) {
+        // We're not relying on any previous data.
         if (!buffer->setSize(scaledSize().width(), scaledSize().height()))
             return setFailed();
     } else {
-        // The starting state for this frame depends on the previous frame's
-        // disposal method.
-        //
-        // Frames that use the DisposeOverwritePrevious method are effectively
-        // no-ops in terms of changing the starting state of a frame compared to
-        // the starting state of the previous frame, so skip over them.  (If the
-        // first frame specifies this method, it will get treated like
-        // DisposeOverwriteBgcolor below and reset to a completely empty image.)
-        const ImageFrame* prevBuffer = &m_frameBufferCache[--frameIndex];
-        ImageFrame::FrameDisposalMethod prevMethod = prevBuffer->disposalMethod();
-        while (frameIndex && (prevMethod == ImageFrame::DisposeOverwritePrevious)) {
-            prevBuffer = &m_frameBufferCache[--frameIndex];
-            prevMethod = prevBuffer->disposalMethod();
-        }
+        const ImageFrame* prevBuffer = &m_frameBufferCache[requiredPreviousFrameIndex];
         ASSERT(prevBuffer->status() == ImageFrame::FrameComplete);
 
-        if ((prevMethod == ImageFrame::DisposeNotSpecified) || (prevMethod == ImageFrame::DisposeKeep)) {
-            // Preserve the last frame as the starting state for this frame.
-            if (!buffer->copyBitmapData(*prevBuffer))
-                return setFailed();
-        } else {
-            // We want to clear the previous frame to transparent, without
-            // affecting pixels in the image outside of the frame.
-            const IntRect& prevRect = prevBuffer->originalFrameRect();
-            const IntSize& bufferSize = scaledSize();
-            if (!frameIndex || prevRect.contains(IntRect(IntPoint(), scaledSize()))) {
-                // Clearing the first frame, or a frame the size of the whole
-                // image, results in a completely empty image.
-                if (!buffer->setSize(bufferSize.width(), bufferSize.height()))
-                    return setFailed();
-            } else {
-                // Copy the whole previous buffer, then clear just its frame.
-                if (!buffer->copyBitmapData(*prevBuffer))
-                    return setFailed();
-                buffer->zeroFillFrameRect(prevRect);
-            }
-        }
+        // Preserve the previous frame as the starting state for this frame.
+        if (!buffer->copyBitmapData(*prevBuffer))
+            return setFailed();
+
+        // If it is to be cleared to transparent, do so without affecting
+        // pixels in the image outside of the frame.
+        if (prevBuffer->disposalMethod() == ImageFrame::DisposeOverwriteBgcolor)
+            buffer->zeroFillFrameRect(prevBuffer->originalFrameRect());
     }
 
     // Update our status to be partially complete.
@@ -407,4 +420,39 @@ bool GIFImageDecoder::initFrameBuffer(unsigned frameIndex)
     return true;
 }
 
+size_t GIFImageDecoder::requiredPreviousFrameIndex(size_t frameIndex) const
+{
+    ASSERT(m_reader);
+
+    // The starting state for a frame depends on the previous frame's disposal
+    // method.
+    //
+    // Frames that use the DisposeOverwritePrevious method are effectively
+    // no-ops in terms of changing the starting state of a frame compared to
+    // the starting state of the previous frame, so skip over them.  (If the
+    // first frame specifies this method, it gets treated like
+    // DisposeOverwriteBgcolor and reset to a completely empty image.)
+    while (frameIndex--) {
+        const GIFFrameContext* previousFrame = m_reader->frameContextAtIndex(frameIndex);
+        switch (previousFrame->disposalMethod) {
+        case ImageFrame::DisposeNotSpecified:
+        case ImageFrame::DisposeKeep:
+            return frameIndex;
+        case ImageFrame::DisposeOverwritePrevious:
+            if (frameIndex)
+                continue;
+            FALLTHROUGH;
+        case ImageFrame::DisposeOverwriteBgcolor: {
+            // Clearing the first frame, or a frame the size of the whole image,
+            // results in a completely empty image.
+            IntRect previousRect(previousFrame->xOffset, previousFrame->yOffset, previousFrame->width, previousFrame->height);
+            if (!frameIndex || previousRect.contains(IntRect(IntPoint(), size())))
+                return notFound;
+            return frameIndex;
+        }
+        }
+    }
+    return notFound;
+}
+
 } // namespace WebCore
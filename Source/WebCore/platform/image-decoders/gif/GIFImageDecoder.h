@@ -48,6 +48,8 @@ namespace WebCore {
         virtual size_t frameCount();
         virtual int repetitionCount() const;
         virtual ImageFrame* frameBufferAtIndex(size_t index);
+        virtual bool frameIsCompleteAtIndex(size_t);
+        virtual float frameDurationAtIndex(size_t);
         // CAUTION: setFailed() deletes |m_reader|.  Be careful to avoid
         // accessing deleted memory, especially when calling this from inside
         // GIFImageReader!
@@ -71,6 +73,12 @@ namespace WebCore {
         // failure, this will mark the image as failed.
         bool initFrameBuffer(unsigned frameIndex);
 
+        // Returns the index of the frame whose pixels |frameIndex| is drawn
+        // over, or notFound if it starts from a transparent image. Decoding can
+        // start at any frame whose required previous frame is still cached, so
+        // a long animation never has to be replayed from its first frame.
+        size_t requiredPreviousFrameIndex(size_t frameIndex) const;
+
         bool m_currentBufferSawAlpha;
         mutable int m_repetitionCount;
         std::unique_ptr<GIFImageReader> m_reader;
@@ -203,6 +203,11 @@ public:
 
     bool isComplete() const { return m_isComplete; }
     void setComplete() { m_isComplete = true; }
+    void resetDecodeState()
+    {
+        m_lzwContext = nullptr;
+        m_currentLzwBlock = 0;
+    }
     bool isHeaderDefined() const { return m_isHeaderDefined; }
     void setHeaderDefined() { m_isHeaderDefined = true; }
     bool isDataSizeDefined() const { return m_isDataSizeDefined; }
@@ -285,6 +290,25 @@ public:
         return m_currentDecodingFrame < m_frames.size() ? m_frames[m_currentDecodingFrame].get() : 0;
     }
 
+    const GIFFrameContext* frameContextAtIndex(size_t index) const
+    {
+        return index < m_frames.size() ? m_frames[index].get() : 0;
+    }
+
+    size_t currentDecodingFrame() const { return m_currentDecodingFrame; }
+
+    // Makes the next GIFFullQuery start decoding at |frameIndex| instead of
+    // where the last one stopped. The client must still have the frame that
+    // |frameIndex| is drawn over, if any.
+    void setCurrentDecodingFrame(size_t frameIndex)
+    {
+        if (GIFFrameContext* frame = m_currentDecodingFrame < m_frames.size() ? m_frames[m_currentDecodingFrame].get() : 0)
+            frame->resetDecodeState();
+        if (frameIndex < m_frames.size())
+            m_frames[frameIndex]->resetDecodeState();
+        m_currentDecodingFrame = frameIndex;
+    }
+
 private:
     bool parse(size_t dataPosition, size_t len, bool parseSizeOnly);
     void setRemainingBytes(size_t);
@@ -368,7 +368,7 @@ public:
 
             m_decoder->setOrientation(readImageOrientation(info()));
 
-#if ENABLE(IMAGE_DECODER_DOWN_SAMPLING) && defined(TURBO_JPEG_RGB_SWIZZLE)
+#if defined(TURBO_JPEG_RGB_SWIZZLE)
             // There's no point swizzle decoding if image down sampling will
             // be applied. Revert to using JSC_RGB in that case.
             if (m_decoder->willDownSample() && turboSwizzled(m_info.out_color_space))
@@ -393,9 +393,20 @@ public:
             // image is a sequential JPEG.
             m_info.buffered_image = jpeg_has_multiple_scans(&m_info);
 
+            // Let libjpeg drop the high frequency DCT coefficients when decoding
+            // at 1/2, 1/4 or 1/8 of the size; this is much cheaper than decoding
+            // every pixel and throwing most of them away.
+            if (SubsamplingLevel subsamplingLevel = m_decoder->subsamplingLevel()) {
+                m_info.scale_num = 1;
+                m_info.scale_denom = 1 << subsamplingLevel;
+            }
+
             // Used to set up image size so arrays can be allocated.
             jpeg_calc_output_dimensions(&m_info);
 
+            if (m_decoder->subsamplingLevel())
+                m_decoder->setScaledSizeDecodedByLibrary(IntSize(m_info.output_width, m_info.output_height));
+
             // Make a one-row-high sample array that will go away when done with
             // image. Always make it big enough to hold an RGB row. Since this
             // uses the IJG memory manager, it must be allocated before the call
@@ -685,6 +696,10 @@ bool JPEGImageDecoder::outputScanlines(ImageFrame& buffer)
 #endif
 
         ImageFrame::PixelData* currentAddress = buffer.getAddr(0, destY);
+        if (colorSpace == JCS_RGB && !isScaled) {
+            buffer.setRGBRow(currentAddress, *samples, width);
+            continue;
+        }
         for (int x = 0; x < width; ++x) {
             setPixel<colorSpace>(buffer, currentAddress, samples, isScaled ? m_scaledColumns[x] : x);
             ++currentAddress;
@@ -48,6 +48,7 @@ namespace WebCore {
         virtual String filenameExtension() const { return "jpg"; }
         virtual bool isSizeAvailable();
         virtual bool setSize(unsigned width, unsigned height);
+        virtual bool canDecodeSubsampled() const { return true; }
         virtual ImageFrame* frameBufferAtIndex(size_t index);
         // CAUTION: setFailed() deletes |m_reader|.  Be careful to avoid
         // accessing deleted memory, especially when calling this from inside
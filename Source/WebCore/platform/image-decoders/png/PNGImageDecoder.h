@@ -49,6 +49,7 @@ namespace WebCore {
 #endif
         virtual bool isSizeAvailable() override;
         virtual bool setSize(unsigned width, unsigned height) override;
+        virtual bool canDecodeSubsampled() const override { return true; }
         virtual ImageFrame* frameBufferAtIndex(size_t index) override;
         // CAUTION: setFailed() deletes |m_reader|.  Be careful to avoid
         // accessing deleted memory, especially when calling this from inside
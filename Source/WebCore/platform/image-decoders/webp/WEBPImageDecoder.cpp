@@ -92,6 +92,15 @@ bool WEBPImageDecoder::isSizeAvailable()
     return ImageDecoder::isSizeAvailable();
 }
 
+bool WEBPImageDecoder::setSize(unsigned width, unsigned height)
+{
+    if (!ImageDecoder::setSize(width, height))
+        return false;
+
+    prepareScaleDataIfNecessary();
+    return true;
+}
+
 ImageFrame* WEBPImageDecoder::frameBufferAtIndex(size_t index)
 {
     if (index)
@@ -186,9 +195,7 @@ void WEBPImageDecoder::applyColorProfile(const uint8_t* data, size_t size, Image
         uint8_t* row = reinterpret_cast<uint8_t*>(buffer.getAddr(0, y));
         if (qcms_transform* transform = colorTransform())
             qcms_transform_data_type(transform, row, row, width, QCMS_OUTPUT_RGBX);
-        uint8_t* pixel = row;
-        for (int x = 0; x < width; ++x, pixel += 4)
-            buffer.setRGBA(x, y, pixel[0], pixel[1], pixel[2], pixel[3]);
+        buffer.setRGBARow(buffer.getAddr(0, y), row, width);
     }
 
     m_decodedHeight = decodedHeight;
@@ -250,7 +257,7 @@ bool WEBPImageDecoder::decode(bool onlySize)
     ASSERT(buffer.status() != ImageFrame::FrameComplete);
 
     if (buffer.status() == ImageFrame::FrameEmpty) {
-        if (!buffer.setSize(size().width(), size().height()))
+        if (!buffer.setSize(scaledSize().width(), scaledSize().height()))
             return setFailed();
         buffer.setStatus(ImageFrame::FramePartial);
         buffer.setHasAlpha(m_hasAlpha);
@@ -263,10 +270,24 @@ bool WEBPImageDecoder::decode(bool onlySize)
             mode = outputMode(false);
         if ((m_formatFlags & ICCP_FLAG) && !ignoresGammaAndColorProfile())
             mode = MODE_RGBA; // Decode to RGBA for input to libqcms.
-        int rowStride = size().width() * sizeof(ImageFrame::PixelData);
+        int rowStride = scaledSize().width() * sizeof(ImageFrame::PixelData);
         uint8_t* output = reinterpret_cast<uint8_t*>(buffer.getAddr(0, 0));
-        int outputSize = size().height() * rowStride;
-        m_decoder = WebPINewRGB(mode, output, outputSize, rowStride);
+        int outputSize = scaledSize().height() * rowStride;
+        if (m_scaled) {
+            // libwebp scales the rows as they are decoded, so only the scaled
+            // frame is ever allocated.
+            WebPInitDecoderConfig(&m_decoderConfig);
+            m_decoderConfig.options.use_scaling = 1;
+            m_decoderConfig.options.scaled_width = scaledSize().width();
+            m_decoderConfig.options.scaled_height = scaledSize().height();
+            m_decoderConfig.output.colorspace = mode;
+            m_decoderConfig.output.is_external_memory = 1;
+            m_decoderConfig.output.u.RGBA.rgba = output;
+            m_decoderConfig.output.u.RGBA.stride = rowStride;
+            m_decoderConfig.output.u.RGBA.size = outputSize;
+            m_decoder = WebPIDecode(0, 0, &m_decoderConfig);
+        } else
+            m_decoder = WebPINewRGB(mode, output, outputSize, rowStride);
         if (!m_decoder)
             return setFailed();
     }
@@ -47,12 +47,16 @@ public:
 
     virtual String filenameExtension() const { return "webp"; }
     virtual bool isSizeAvailable();
+    virtual bool setSize(unsigned width, unsigned height);
+    virtual bool canDecodeSubsampled() const { return true; }
     virtual ImageFrame* frameBufferAtIndex(size_t index);
 
 private:
     bool decode(bool onlySize);
 
     WebPIDecoder* m_decoder;
+    // The incremental decoder keeps pointers into this while decoding a scaled frame.
+    WebPDecoderConfig m_decoderConfig;
     bool m_hasAlpha;
     int m_formatFlags;
 
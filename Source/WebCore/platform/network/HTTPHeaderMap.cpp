@@ -64,8 +64,9 @@ void HTTPHeaderMap::adopt(std::unique_ptr<CrossThreadHTTPHeaderMapData> data)
     m_commonHeaders.clear();
     m_uncommonHeaders.clear();
 
+    m_commonHeaders.reserveInitialCapacity(data->commonHeaders.size());
     for (auto& header : data->commonHeaders)
-        m_commonHeaders.add(header.first, WTF::move(header.second));
+        m_commonHeaders.uncheckedAppend({ header.first, WTF::move(header.second) });
 
     for (auto& header : data->uncommonHeaders)
         m_uncommonHeaders.add(WTF::move(header.first), WTF::move(header.second));
@@ -76,7 +77,7 @@ String HTTPHeaderMap::get(const String& name) const
     HTTPHeaderName headerName;
     if (!findHTTPHeaderName(name, headerName))
         return m_uncommonHeaders.get(name);
-    return m_commonHeaders.get(headerName);
+    return get(headerName);
 }
 
 void HTTPHeaderMap::set(const String& name, const String& value)
@@ -86,7 +87,7 @@ void HTTPHeaderMap::set(const String& name, const String& value)
         m_uncommonHeaders.set(name, value);
         return;
     }
-    m_commonHeaders.set(headerName, value);
+    set(headerName, value);
 }
 
 void HTTPHeaderMap::add(const String& name, const String& value)
@@ -103,29 +104,40 @@ void HTTPHeaderMap::add(const String& name, const String& value)
 
 String HTTPHeaderMap::get(HTTPHeaderName name) const
 {
-    return m_commonHeaders.get(name);
+    auto* header = findCommonHeader(name);
+    return header ? header->value : String();
 }
 
 void HTTPHeaderMap::set(HTTPHeaderName name, const String& value)
 {
-    m_commonHeaders.set(name, value);
+    if (auto* header = findCommonHeader(name)) {
+        header->value = value;
+        return;
+    }
+    m_commonHeaders.append({ name, value });
 }
 
 bool HTTPHeaderMap::contains(HTTPHeaderName name) const
 {
-    return m_commonHeaders.contains(name);
+    return findCommonHeader(name);
 }
 
 bool HTTPHeaderMap::remove(HTTPHeaderName name)
 {
-    return m_commonHeaders.remove(name);
+    auto* header = findCommonHeader(name);
+    if (!header)
+        return false;
+    m_commonHeaders.remove(header - m_commonHeaders.begin());
+    return true;
 }
 
 void HTTPHeaderMap::add(HTTPHeaderName name, const String& value)
 {
-    auto result = m_commonHeaders.add(name, value);
-    if (!result.isNewEntry)
-        result.iterator->value = result.iterator->value + ", " + value;
+    if (auto* header = findCommonHeader(name)) {
+        header->value = header->value + ", " + value;
+        return;
+    }
+    m_commonHeaders.append({ name, value });
 }
 
 } // namespace WebCore
@@ -47,12 +47,20 @@ struct CrossThreadHTTPHeaderMapData {
 
 class HTTPHeaderMap {
 public:
-    typedef HashMap<HTTPHeaderName, String, WTF::IntHash<HTTPHeaderName>, WTF::StrongEnumHashTraits<HTTPHeaderName>> CommonHeadersHashMap;
+    // Requests and responses carry a handful of common headers, so they are kept in a flat vector
+    // and found by a linear scan, which is cheaper to build, copy and search than a hash table.
+    struct CommonHeader {
+        HTTPHeaderName key;
+        String value;
+
+        bool operator==(const CommonHeader& other) const { return key == other.key && value == other.value; }
+    };
+    typedef Vector<CommonHeader> CommonHeadersVector;
     typedef HashMap<String, String, CaseFoldingHash> UncommonHeadersHashMap;
 
     class HTTPHeaderMapConstIterator {
     public:
-        HTTPHeaderMapConstIterator(const HTTPHeaderMap& table, CommonHeadersHashMap::const_iterator commonHeadersIt, UncommonHeadersHashMap::const_iterator uncommonHeadersIt)
+        HTTPHeaderMapConstIterator(const HTTPHeaderMap& table, CommonHeadersVector::const_iterator commonHeadersIt, UncommonHeadersHashMap::const_iterator uncommonHeadersIt)
             : m_table(table)
             , m_commonHeadersIt(commonHeadersIt)
             , m_uncommonHeadersIt(uncommonHeadersIt)
@@ -94,7 +102,7 @@ public:
         }
 
     private:
-        bool updateKeyValue(CommonHeadersHashMap::const_iterator it)
+        bool updateKeyValue(CommonHeadersVector::const_iterator it)
         {
             if (it == m_table.commonHeaders().end())
                 return false;
@@ -114,7 +122,7 @@ public:
         }
 
         const HTTPHeaderMap& m_table;
-        CommonHeadersHashMap::const_iterator m_commonHeadersIt;
+        CommonHeadersVector::const_iterator m_commonHeadersIt;
         UncommonHeadersHashMap::const_iterator m_uncommonHeadersIt;
         KeyValue m_keyValue;
     };
@@ -152,9 +160,9 @@ public:
     template<size_t length> bool contains(const char (&)[length]) = delete;
     template<size_t length> bool remove(const char (&)[length]) = delete;
 
-    const CommonHeadersHashMap& commonHeaders() const { return m_commonHeaders; }
+    const CommonHeadersVector& commonHeaders() const { return m_commonHeaders; }
     const UncommonHeadersHashMap& uncommonHeaders() const { return m_uncommonHeaders; }
-    CommonHeadersHashMap& commonHeaders() { return m_commonHeaders; }
+    CommonHeadersVector& commonHeaders() { return m_commonHeaders; }
     UncommonHeadersHashMap& uncommonHeaders() { return m_uncommonHeaders; }
 
     const_iterator begin() const { return const_iterator(*this, m_commonHeaders.begin(), m_uncommonHeaders.begin()); }
@@ -162,7 +170,15 @@ public:
 
     friend bool operator==(const HTTPHeaderMap& a, const HTTPHeaderMap& b)
     {
-        return a.m_commonHeaders == b.m_commonHeaders && a.m_uncommonHeaders == b.m_uncommonHeaders;
+        if (a.m_commonHeaders.size() != b.m_commonHeaders.size() || a.m_uncommonHeaders != b.m_uncommonHeaders)
+            return false;
+        // Common headers are unique by name, so the maps are equal if every header of one is found in the other.
+        for (auto& header : a.m_commonHeaders) {
+            auto* otherHeader = b.findCommonHeader(header.key);
+            if (!otherHeader || otherHeader->value != header.value)
+                return false;
+        }
+        return true;
     }
 
     friend bool operator!=(const HTTPHeaderMap& a, const HTTPHeaderMap& b)
@@ -174,7 +190,10 @@ public:
     template <class Decoder> static bool decode(Decoder&, HTTPHeaderMap&);
 
 private:
-    CommonHeadersHashMap m_commonHeaders;
+    const CommonHeader* findCommonHeader(HTTPHeaderName) const;
+    CommonHeader* findCommonHeader(HTTPHeaderName);
+
+    CommonHeadersVector m_commonHeaders;
     UncommonHeadersHashMap m_uncommonHeaders;
 };
 
@@ -203,7 +222,7 @@ bool HTTPHeaderMap::decode(Decoder& decoder, HTTPHeaderMap& headerMap)
         String value;
         if (!decoder.decode(value))
             return false;
-        headerMap.m_commonHeaders.add(name, value);
+        headerMap.add(name, value);
     }
 
     if (!decoder.decode(headerMap.m_uncommonHeaders))
@@ -212,6 +231,20 @@ bool HTTPHeaderMap::decode(Decoder& decoder, HTTPHeaderMap& headerMap)
     return true;
 }
 
+inline auto HTTPHeaderMap::findCommonHeader(HTTPHeaderName name) const -> const CommonHeader*
+{
+    for (auto& header : m_commonHeaders) {
+        if (header.key == name)
+            return &header;
+    }
+    return nullptr;
+}
+
+inline auto HTTPHeaderMap::findCommonHeader(HTTPHeaderName name) -> CommonHeader*
+{
+    return const_cast<CommonHeader*>(const_cast<const HTTPHeaderMap&>(*this).findCommonHeader(name));
+}
+
 } // namespace WebCore
 
 #endif // HTTPHeaderMap_h
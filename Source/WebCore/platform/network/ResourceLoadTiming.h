@@ -39,6 +39,7 @@ public:
         , requestStart(0)
         , responseStart(0)
         , secureConnectionStart(-1)
+        , queueingDelay(-1)
     {
     }
     
@@ -50,6 +51,7 @@ public:
         , requestStart(other.requestStart)
         , responseStart(other.responseStart)
         , secureConnectionStart(other.secureConnectionStart)
+        , queueingDelay(other.queueingDelay)
     {
     }
     
@@ -62,6 +64,7 @@ public:
         requestStart = other.requestStart;
         responseStart = other.responseStart;
         secureConnectionStart = other.secureConnectionStart;
+        queueingDelay = other.queueingDelay;
         return *this;
     }
     
@@ -73,7 +76,8 @@ public:
             && connectEnd == other.connectEnd
             && requestStart == other.requestStart
             && responseStart == other.responseStart
-            && secureConnectionStart == other.secureConnectionStart;
+            && secureConnectionStart == other.secureConnectionStart
+            && queueingDelay == other.queueingDelay;
     }
 
     bool operator!=(const ResourceLoadTiming& other) const
@@ -92,6 +96,9 @@ public:
     int requestStart;
     int responseStart;
     int secureConnectionStart;
+
+    // Milliseconds the load waited in the ResourceLoadScheduler before it started, -1 if it wasn't queued.
+    int queueingDelay;
 };
 
 template<class Encoder>
@@ -104,6 +111,7 @@ void ResourceLoadTiming::encode(Encoder& encoder) const
     encoder << requestStart;
     encoder << responseStart;
     encoder << secureConnectionStart;
+    encoder << queueingDelay;
 }
 
 template<class Decoder>
@@ -115,7 +123,8 @@ bool ResourceLoadTiming::decode(Decoder& decoder, ResourceLoadTiming& timing)
         && decoder.decode(timing.connectEnd)
         && decoder.decode(timing.requestStart)
         && decoder.decode(timing.responseStart)
-        && decoder.decode(timing.secureConnectionStart);
+        && decoder.decode(timing.secureConnectionStart)
+        && decoder.decode(timing.queueingDelay);
 }
 
 }
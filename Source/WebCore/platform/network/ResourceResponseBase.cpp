@@ -276,6 +276,10 @@ void ResourceResponseBase::updateHeaderParsedState(HTTPHeaderName name)
         m_haveParsedLastModifiedHeader = false;
         break;
 
+    case HTTPHeaderName::ContentType:
+        m_haveParsedContentTypeHeader = false;
+        break;
+
     default:
         break;
     }
@@ -323,6 +327,16 @@ const HTTPHeaderMap& ResourceResponseBase::httpHeaderFields() const
     return m_httpHeaderFields;
 }
 
+const String& ResourceResponseBase::contentTypeHeaderMIMEType() const
+{
+    if (!m_haveParsedContentTypeHeader) {
+        lazyInit(CommonFieldsOnly);
+        m_contentTypeHeaderMIMEType = extractMIMETypeFromMediaType(m_httpHeaderFields.get(HTTPHeaderName::ContentType));
+        m_haveParsedContentTypeHeader = true;
+    }
+    return m_contentTypeHeaderMIMEType;
+}
+
 void ResourceResponseBase::parseCacheControlDirectives() const
 {
     ASSERT(!m_haveParsedCacheControlHeader);
@@ -106,6 +106,8 @@ public:
     WEBCORE_EXPORT Optional<std::chrono::microseconds> age() const;
     WEBCORE_EXPORT Optional<std::chrono::system_clock::time_point> expires() const;
     WEBCORE_EXPORT Optional<std::chrono::system_clock::time_point> lastModified() const;
+    // The MIME type from the Content-Type header as received, before any content sniffing.
+    WEBCORE_EXPORT const String& contentTypeHeaderMIMEType() const;
 
     // This is primarily for testing support. It is not necessarily accurate in all scenarios.
     enum class Source { Unknown, Network, DiskCache, DiskCacheAfterValidation, MemoryCache, MemoryCacheAfterValidation };
@@ -171,12 +173,14 @@ private:
     mutable Optional<std::chrono::system_clock::time_point> m_expires;
     mutable Optional<std::chrono::system_clock::time_point> m_lastModified;
     mutable CacheControlDirectives m_cacheControlDirectives;
+    mutable String m_contentTypeHeaderMIMEType;
 
     mutable bool m_haveParsedCacheControlHeader { false };
     mutable bool m_haveParsedAgeHeader { false };
     mutable bool m_haveParsedDateHeader { false };
     mutable bool m_haveParsedExpiresHeader { false };
     mutable bool m_haveParsedLastModifiedHeader { false };
+    mutable bool m_haveParsedContentTypeHeader { false };
 
     Source m_source { Source::Unknown };
 };
@@ -34,6 +34,7 @@
 #include <mutex>
 #include <sqlite3.h>
 #include <thread>
+#include <wtf/StdLibExtras.h>
 #include <wtf/Threading.h>
 #include <wtf/text/CString.h>
 #include <wtf/text/WTFString.h>
@@ -42,6 +43,8 @@ namespace WebCore {
 
 static const char notOpenErrorMessage[] = "database is not open";
 
+static const unsigned maximumCachedStatementCount = 32;
+
 static void unauthorizedSQLFunction(sqlite3_context *context, int, sqlite3_value **)
 {
     const char* functionName = (const char*)sqlite3_user_data(context);
@@ -136,6 +139,10 @@ void SQLiteDatabase::close()
     if (m_db) {
         // FIXME: This is being called on the main thread during JS GC. <rdar://problem/5739818>
         // ASSERT(currentThread() == m_openingThread);
+
+        // The connection can't be closed while it still has prepared statements.
+        clearStatementCache();
+
         sqlite3* db = m_db;
         {
             LockHolder locker(m_databaseClosingMutex);
@@ -467,6 +474,9 @@ void SQLiteDatabase::setAuthorizer(PassRefPtr<DatabaseAuthorizer> auth)
     m_authorizer = auth;
     
     enableAuthorizer(true);
+
+    // Statements prepared so far were never seen by the authorizer.
+    clearStatementCache();
 }
 
 void SQLiteDatabase::enableAuthorizer(bool enable)
@@ -526,13 +536,121 @@ static int callCollationFunction(void* arg, int aLength, const void* a, int bLen
 
 void SQLiteDatabase::setCollationFunction(const String& collationName, std::function<int(int, const void*, int, const void*)> collationFunction)
 {
+    clearStatementCache();
+
     auto functionObject = new std::function<int(int, const void*, int, const void*)>(collationFunction);
     sqlite3_create_collation_v2(m_db, collationName.utf8().data(), SQLITE_UTF8, functionObject, callCollationFunction, destroyCollationFunction);
 }
 
 void SQLiteDatabase::removeCollationFunction(const String& collationName)
 {
+    clearStatementCache();
+
     sqlite3_create_collation_v2(m_db, collationName.utf8().data(), SQLITE_UTF8, nullptr, nullptr, nullptr);
 }
 
+sqlite3_stmt* SQLiteDatabase::takeCachedStatement(const String& query)
+{
+    LockHolder locker(m_statementCacheLock);
+
+    if (m_authorizer)
+        return nullptr;
+
+    return m_cachedStatements.take(query);
+}
+
+bool SQLiteDatabase::cacheStatement(const String& query, sqlite3_stmt* statement)
+{
+    ASSERT(statement);
+
+    if (!m_db || m_authorizer)
+        return false;
+
+    // Resetting also reports an error from the last step, in which case the caller finalizes the statement to get it.
+    if (sqlite3_reset(statement) != SQLITE_OK)
+        return false;
+    sqlite3_clear_bindings(statement);
+
+    LockHolder locker(m_statementCacheLock);
+
+    if (m_cachedStatements.size() >= maximumCachedStatementCount)
+        return false;
+
+    return m_cachedStatements.add(query, statement).isNewEntry;
+}
+
+void SQLiteDatabase::clearStatementCache()
+{
+    HashMap<String, sqlite3_stmt*> cachedStatements;
+    {
+        LockHolder locker(m_statementCacheLock);
+        std::swap(cachedStatements, m_cachedStatements);
+    }
+
+    for (auto* statement : cachedStatements.values())
+        sqlite3_finalize(statement);
+}
+
+void SQLiteDatabase::setCollectsStatementStatistics(bool collectsStatementStatistics)
+{
+    LockHolder locker(m_statementStatisticsLock);
+
+    m_collectsStatementStatistics = collectsStatementStatistics;
+    if (!collectsStatementStatistics)
+        m_statementStatistics.clear();
+}
+
+void SQLiteDatabase::didPrepareStatement(const String& query, double duration, bool fromCache)
+{
+    LockHolder locker(m_statementStatisticsLock);
+
+    if (!m_collectsStatementStatistics)
+        return;
+
+    auto& statistics = m_statementStatistics.add(query, StatementStatistics()).iterator->value;
+    ++statistics.prepareCount;
+    if (fromCache)
+        ++statistics.cachedPrepareCount;
+    statistics.prepareTime += duration;
+}
+
+void SQLiteDatabase::didStepStatement(const String& query, double duration)
+{
+    LockHolder locker(m_statementStatisticsLock);
+
+    if (!m_collectsStatementStatistics)
+        return;
+
+    auto& statistics = m_statementStatistics.add(query, StatementStatistics()).iterator->value;
+    ++statistics.stepCount;
+    statistics.stepTime += duration;
+}
+
+HashMap<String, SQLiteDatabase::StatementStatistics> SQLiteDatabase::statementStatistics()
+{
+    LockHolder locker(m_statementStatisticsLock);
+    return m_statementStatistics;
+}
+
+void SQLiteDatabase::dumpStatementStatistics()
+{
+    auto statistics = statementStatistics();
+
+    Vector<std::pair<String, StatementStatistics>> sortedStatistics;
+    sortedStatistics.reserveInitialCapacity(statistics.size());
+    for (auto& entry : statistics)
+        sortedStatistics.uncheckedAppend(std::make_pair(entry.key, entry.value));
+
+    std::sort(sortedStatistics.begin(), sortedStatistics.end(), [](const std::pair<String, StatementStatistics>& a, const std::pair<String, StatementStatistics>& b) {
+        return a.second.prepareTime + a.second.stepTime > b.second.prepareTime + b.second.stepTime;
+    });
+
+    WTFLogAlways("SQLite statement statistics (%zu statements):", sortedStatistics.size());
+    for (auto& entry : sortedStatistics) {
+        const auto& statistics = entry.second;
+        WTFLogAlways("  %u prepares (%u from cache) %.3fms, %u steps %.3fms - %s", statistics.prepareCount, statistics.cachedPrepareCount, statistics.prepareTime * 1000,
+            statistics.stepCount, statistics.stepTime * 1000, entry.first.utf8().data());
+    }
+}
+
 } // namespace WebCore
@@ -29,6 +29,7 @@
 
 #include <functional>
 #include <sqlite3.h>
+#include <wtf/HashMap.h>
 #include <wtf/Lock.h>
 #include <wtf/Threading.h>
 #include <wtf/text/CString.h>
@@ -125,6 +126,29 @@ public:
     WEBCORE_EXPORT void setCollationFunction(const String& collationName, std::function<int(int, const void*, int, const void*)>);
     void removeCollationFunction(const String& collationName);
 
+    // A finalized SQLiteStatement leaves its prepared statement here, keyed by its SQL, for the next SQLiteStatement
+    // with the same SQL to reuse instead of preparing it again. Nothing is cached while an authorizer is set, because
+    // the authorizer only sees statements as they are prepared.
+    sqlite3_stmt* takeCachedStatement(const String& query);
+    bool cacheStatement(const String& query, sqlite3_stmt*);
+    WEBCORE_EXPORT void clearStatementCache();
+
+    struct StatementStatistics {
+        unsigned prepareCount { 0 };
+        unsigned cachedPrepareCount { 0 };
+        unsigned stepCount { 0 };
+        double prepareTime { 0 };
+        double stepTime { 0 };
+    };
+
+    // Statistics are kept per SQL text, and only while collecting is turned on.
+    WEBCORE_EXPORT void setCollectsStatementStatistics(bool);
+    bool collectsStatementStatistics() const { return m_collectsStatementStatistics; }
+    void didPrepareStatement(const String& query, double duration, bool fromCache);
+    void didStepStatement(const String& query, double duration);
+    WEBCORE_EXPORT HashMap<String, StatementStatistics> statementStatistics();
+    WEBCORE_EXPORT void dumpStatementStatistics();
+
     // Set this flag to allow access from multiple threads.  Not all multi-threaded accesses are safe!
     // See http://www.sqlite.org/cvstrac/wiki?p=MultiThreading for more info.
 #ifndef NDEBUG
@@ -160,6 +184,13 @@ private:
     CString m_openErrorMessage;
 
     int m_lastChangesCount;
+
+    Lock m_statementCacheLock;
+    HashMap<String, sqlite3_stmt*> m_cachedStatements;
+
+    Lock m_statementStatisticsLock;
+    bool m_collectsStatementStatistics { false };
+    HashMap<String, StatementStatistics> m_statementStatistics;
 };
 
 } // namespace WebCore
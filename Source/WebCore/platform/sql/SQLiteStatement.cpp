@@ -30,6 +30,7 @@
 #include "SQLValue.h"
 #include <sqlite3.h>
 #include <wtf/Assertions.h>
+#include <wtf/CurrentTime.h>
 #include <wtf/text/StringView.h>
 
 // SQLite 3.6.16 makes sqlite3_prepare_v2 automatically retry preparing the statement
@@ -61,6 +62,20 @@ int SQLiteStatement::prepare()
 
     LockHolder databaseLock(m_database.databaseMutex());
 
+    bool collectsStatistics = m_database.collectsStatementStatistics();
+    double startTime = collectsStatistics ? monotonicallyIncreasingTime() : 0;
+
+    if ((m_statement = m_database.takeCachedStatement(m_query))) {
+        LOG(SQLDatabase, "SQL - prepare (cached) - %s", m_query.ascii().data());
+        m_statementIsCacheable = true;
+#ifndef NDEBUG
+        m_isPrepared = true;
+#endif
+        if (collectsStatistics)
+            m_database.didPrepareStatement(m_query, monotonicallyIncreasingTime() - startTime, true);
+        return SQLITE_OK;
+    }
+
     CString query = m_query.stripWhiteSpace().utf8();
     
     LOG(SQLDatabase, "SQL - prepare - %s", query.data());
@@ -78,6 +93,12 @@ int SQLiteStatement::prepare()
     if (tail && *tail)
         error = SQLITE_ERROR;
 
+    // Only a statement that compiled the whole query can be handed to the next SQLiteStatement with the same SQL.
+    m_statementIsCacheable = error == SQLITE_OK;
+
+    if (collectsStatistics)
+        m_database.didPrepareStatement(m_query, monotonicallyIncreasingTime() - startTime, false);
+
 #ifndef NDEBUG
     m_isPrepared = error == SQLITE_OK;
 #endif
@@ -96,7 +117,11 @@ int SQLiteStatement::step()
     m_database.updateLastChangesCount();
 
     LOG(SQLDatabase, "SQL - step - %s", m_query.ascii().data());
+    bool collectsStatistics = m_database.collectsStatementStatistics();
+    double startTime = collectsStatistics ? monotonicallyIncreasingTime() : 0;
     int error = sqlite3_step(m_statement);
+    if (collectsStatistics)
+        m_database.didStepStatement(m_query, monotonicallyIncreasingTime() - startTime);
     if (error != SQLITE_DONE && error != SQLITE_ROW) {
         LOG(SQLDatabase, "sqlite3_step failed (%i)\nQuery - %s\nError - %s", 
             error, m_query.ascii().data(), sqlite3_errmsg(m_database.sqlite3Handle()));
@@ -113,6 +138,12 @@ int SQLiteStatement::finalize()
     if (!m_statement)
         return SQLITE_OK;
     LOG(SQLDatabase, "SQL - finalize - %s", m_query.ascii().data());
+    bool statementIsCacheable = m_statementIsCacheable;
+    m_statementIsCacheable = false;
+    if (statementIsCacheable && m_database.cacheStatement(m_query, m_statement)) {
+        m_statement = 0;
+        return SQLITE_OK;
+    }
     int result = sqlite3_finalize(m_statement);
     m_statement = 0;
     return result;
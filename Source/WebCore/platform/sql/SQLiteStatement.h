@@ -98,6 +98,7 @@ private:
     SQLiteDatabase& m_database;
     String m_query;
     sqlite3_stmt* m_statement;
+    bool m_statementIsCacheable { false };
 #ifndef NDEBUG
     bool m_isPrepared;
 #endif
@@ -20,8 +20,15 @@
 #include "config.h"
 #include "SegmentedString.h"
 
+#include <wtf/ASCIICType.h>
 #include <wtf/text/TextPosition.h>
 
+#if CPU(X86_64)
+#include <emmintrin.h>
+#elif CPU(ARM64) && COMPILER(GCC_OR_CLANG)
+#include <arm_neon.h>
+#endif
+
 namespace WebCore {
 
 SegmentedString::SegmentedString(const SegmentedString& other)
@@ -341,6 +348,123 @@ void SegmentedString::advanceEmpty()
     m_currentChar = 0;
 }
 
+static inline bool isRunStopCharacter(UChar character, UChar stopCharacter1, UChar stopCharacter2)
+{
+    return character == '\r' || !character || character == stopCharacter1 || character == stopCharacter2;
+}
+
+template<typename CharacterType>
+static unsigned lengthOfRun(const CharacterType* characters, unsigned length, UChar stopCharacter1, UChar stopCharacter2)
+{
+    unsigned i = 0;
+
+#if CPU(X86_64) || (CPU(ARM64) && COMPILER(GCC_OR_CLANG))
+    // Compare 16 bytes at a time against all four stop characters, and find the exact
+    // position with the scalar loop below once a vector contains one of them.
+    const unsigned charactersPerVector = 16 / sizeof(CharacterType);
+    for (; i + charactersPerVector <= length; i += charactersPerVector) {
+        const CharacterType* vector = characters + i;
+#if CPU(X86_64)
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(vector));
+        __m128i matches;
+        if (sizeof(CharacterType) == 1) {
+            matches = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8('\r')), _mm_cmpeq_epi8(chunk, _mm_setzero_si128())),
+                _mm_or_si128(_mm_cmpeq_epi8(chunk, _mm_set1_epi8(static_cast<char>(stopCharacter1))), _mm_cmpeq_epi8(chunk, _mm_set1_epi8(static_cast<char>(stopCharacter2)))));
+        } else {
+            matches = _mm_or_si128(
+                _mm_or_si128(_mm_cmpeq_epi16(chunk, _mm_set1_epi16('\r')), _mm_cmpeq_epi16(chunk, _mm_setzero_si128())),
+                _mm_or_si128(_mm_cmpeq_epi16(chunk, _mm_set1_epi16(stopCharacter1)), _mm_cmpeq_epi16(chunk, _mm_set1_epi16(stopCharacter2))));
+        }
+        if (_mm_movemask_epi8(matches))
+            break;
+#else
+        bool hasMatch;
+        if (sizeof(CharacterType) == 1) {
+            uint8x16_t chunk = vld1q_u8(reinterpret_cast<const uint8_t*>(vector));
+            uint8x16_t matches = vorrq_u8(
+                vorrq_u8(vceqq_u8(chunk, vdupq_n_u8('\r')), vceqq_u8(chunk, vdupq_n_u8(0))),
+                vorrq_u8(vceqq_u8(chunk, vdupq_n_u8(static_cast<uint8_t>(stopCharacter1))), vceqq_u8(chunk, vdupq_n_u8(static_cast<uint8_t>(stopCharacter2)))));
+            hasMatch = vmaxvq_u8(matches);
+        } else {
+            uint16x8_t chunk = vld1q_u16(reinterpret_cast<const uint16_t*>(vector));
+            uint16x8_t matches = vorrq_u16(
+                vorrq_u16(vceqq_u16(chunk, vdupq_n_u16('\r')), vceqq_u16(chunk, vdupq_n_u16(0))),
+                vorrq_u16(vceqq_u16(chunk, vdupq_n_u16(stopCharacter1)), vceqq_u16(chunk, vdupq_n_u16(stopCharacter2))));
+            hasMatch = vmaxvq_u16(matches);
+        }
+        if (hasMatch)
+            break;
+#endif
+    }
+#endif
+
+    for (; i < length; ++i) {
+        if (isRunStopCharacter(characters[i], stopCharacter1, stopCharacter2))
+            return i;
+    }
+    return length;
+}
+
+unsigned SegmentedString::lengthOfRunBefore(UChar stopCharacter1, UChar stopCharacter2) const
+{
+    // Callers only use ASCII stop characters, which keeps the 8-bit comparisons exact.
+    ASSERT(isASCII(stopCharacter1) && isASCII(stopCharacter2));
+
+    if (m_pushedChar1 || m_currentString.m_length < 2)
+        return 0;
+
+    // Leave the last character, so that advancing past it moves on to the next substring as usual.
+    unsigned length = m_currentString.m_length - 1;
+    if (m_currentString.is8Bit())
+        return lengthOfRun(m_currentString.m_data.string8Ptr, length, stopCharacter1, stopCharacter2);
+    return lengthOfRun(m_currentString.m_data.string16Ptr, length, stopCharacter1, stopCharacter2);
+}
+
+template<typename CharacterType>
+static unsigned countNewlines(const CharacterType* characters, unsigned length, unsigned& lastNewlineIndex)
+{
+    unsigned count = 0;
+    for (unsigned i = 0; i < length; ++i) {
+        if (characters[i] == '\n') {
+            ++count;
+            lastNewlineIndex = i;
+        }
+    }
+    return count;
+}
+
+void SegmentedString::advancePastRun(unsigned length)
+{
+    if (!length)
+        return;
+
+    ASSERT(!m_pushedChar1);
+    ASSERT(length < static_cast<unsigned>(m_currentString.m_length));
+
+    bool is8Bit = m_currentString.is8Bit();
+    if (m_currentString.doNotExcludeLineNumbers()) {
+        unsigned lastNewlineIndex = 0;
+        unsigned newlines = is8Bit
+            ? countNewlines(m_currentString.m_data.string8Ptr, length, lastNewlineIndex)
+            : countNewlines(m_currentString.m_data.string16Ptr, length, lastNewlineIndex);
+        if (newlines) {
+            m_currentLine += newlines;
+            m_numberOfCharactersConsumedPriorToCurrentLine = m_numberOfCharactersConsumedPriorToCurrentString + m_currentString.numberOfCharactersConsumed() + lastNewlineIndex + 1;
+        }
+    }
+
+    if (is8Bit)
+        m_currentString.m_data.string8Ptr += length;
+    else
+        m_currentString.m_data.string16Ptr += length;
+    m_currentString.m_length -= length;
+    m_currentChar = m_currentString.getCurrentChar();
+
+    if (m_currentString.m_length == 1)
+        updateSlowCaseFunctionPointers();
+}
+
 void SegmentedString::updateSlowCaseFunctionPointers()
 {
     m_fastPathFlags = NoFastPath;
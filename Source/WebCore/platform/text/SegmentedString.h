@@ -56,7 +56,7 @@ public:
 
     void clear() { m_length = 0; m_data.string16Ptr = 0; m_is8Bit = false;}
     
-    bool is8Bit() { return m_is8Bit; }
+    bool is8Bit() const { return m_is8Bit; }
     
     bool excludeLineNumbers() const { return !m_doNotExcludeLineNumbers; }
     bool doNotExcludeLineNumbers() const { return m_doNotExcludeLineNumbers; }
@@ -276,6 +276,16 @@ public:
         return m_numberOfCharactersConsumedPriorToCurrentString + m_currentString.numberOfCharactersConsumed() - numberOfPushedCharacters;
     }
 
+    // For tokenizers that consume runs of ordinary characters in bulk instead of one at a time.
+    // The run starts at the current character and ends before the first '\r', '\0', stopCharacter1
+    // or stopCharacter2. It stays within the current substring and never includes its last
+    // character, so it can be empty. It is empty whenever characters have been pushed back.
+    unsigned lengthOfRunBefore(UChar stopCharacter1, UChar stopCharacter2) const;
+    bool runIs8Bit() const { return m_currentString.is8Bit(); }
+    const LChar* runCharacters8() const { ASSERT(runIs8Bit()); return m_currentString.m_data.string8Ptr; }
+    const UChar* runCharacters16() const { ASSERT(!runIs8Bit()); return m_currentString.m_data.string16Ptr; }
+    void advancePastRun(unsigned length);
+
     String toString() const;
 
     UChar currentChar() const { return m_currentChar; }    
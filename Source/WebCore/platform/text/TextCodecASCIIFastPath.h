@@ -27,6 +27,7 @@
 #ifndef TextCodecASCIIFastPath_h
 #define TextCodecASCIIFastPath_h
 
+#include <wtf/ASCIICType.h>
 #include <wtf/text/ASCIIFastPath.h>
 
 namespace WebCore {
@@ -75,6 +76,43 @@ inline void copyASCIIMachineWord(UChar* destination, const uint8_t* source)
     UCharByteFiller<sizeof(WTF::MachineWord)>::copy(destination, source);
 }
 
+// Copies the run of ASCII bytes at the start of source, looking at no more than length bytes,
+// and returns the length of that run. Unlike the machine word loops above, this does not
+// need source to be aligned, so a run is not broken up into single bytes by a misaligned start.
+inline size_t copyASCIIPrefix(LChar* destination, const uint8_t* source, size_t length)
+{
+    size_t i = 0;
+
+#if CPU(X86_64)
+    for (; i + 16 <= length; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        if (_mm_movemask_epi8(chunk))
+            break;
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i), chunk);
+    }
+#elif CPU(ARM64) && COMPILER(GCC_OR_CLANG)
+    for (; i + 16 <= length; i += 16) {
+        uint8x16_t chunk = vld1q_u8(source + i);
+        if (vmaxvq_u8(chunk) & 0x80)
+            break;
+        vst1q_u8(destination + i, chunk);
+    }
+#endif
+
+    for (; i + sizeof(WTF::MachineWord) <= length; i += sizeof(WTF::MachineWord)) {
+        WTF::MachineWord chunk;
+        memcpy(&chunk, source + i, sizeof(chunk));
+        if (!WTF::isAllASCII<LChar>(chunk))
+            break;
+        memcpy(destination + i, &chunk, sizeof(chunk));
+    }
+
+    for (; i < length && isASCII(source[i]); ++i)
+        destination[i] = source[i];
+
+    return i;
+}
+
 } // namespace WebCore
 
 #endif // TextCodecASCIIFastPath_h
@@ -132,36 +132,16 @@ String TextCodecLatin1::decode(const char* bytes, size_t length, bool, bool, boo
     while (source < end) {
         if (isASCII(*source)) {
             // Fast path for ASCII. Most Latin-1 text will be ASCII.
-            if (isAlignedToMachineWord(source)) {
-                while (source < alignedEnd) {
-                    MachineWord chunk = *reinterpret_cast_ptr<const MachineWord*>(source);
-
-                    if (!isAllASCII<LChar>(chunk))
-                        goto useLookupTable;
-
-                    copyASCIIMachineWord(destination, source);
-                    source += sizeof(MachineWord);
-                    destination += sizeof(MachineWord);
-                }
-
-                if (source == end)
-                    break;
-
-                // *source may not be ASCII anymore if source moves inside the loop of the fast code path
-                if (!isASCII(*source))
-                    goto useLookupTable;
-            }
-            *destination = *source;
-        } else {
-useLookupTable:
-            if (table[*source] > 0xff)
-                goto upConvertTo16Bit;
-
-            *destination = table[*source];
+            size_t asciiLength = copyASCIIPrefix(destination, source, end - source);
+            source += asciiLength;
+            destination += asciiLength;
+            continue;
         }
 
-        ++source;
-        ++destination;
+        if (table[*source] > 0xff)
+            goto upConvertTo16Bit;
+
+        *destination++ = table[*source++];
     }
 
     return result;
@@ -34,6 +34,7 @@ AutoTableLayout::AutoTableLayout(RenderTable* table)
     : TableLayout(table)
     , m_hasPercent(false)
     , m_effectiveLogicalWidthDirty(true)
+    , m_layoutStructIsValid(false)
 {
 }
 
@@ -108,7 +109,7 @@ void AutoTableLayout::recalcColumn(unsigned effCol)
                         }
                         break;
                     case Percent:
-                        m_hasPercent = true;
+                        columnLayout.hasPercentCells = true;
                         if (cellLogicalWidth.isPositive() && (!columnLayout.logicalWidth.isPercent() || cellLogicalWidth.percent() > columnLayout.logicalWidth.percent()))
                             columnLayout.logicalWidth = cellLogicalWidth;
                         break;
@@ -121,6 +122,7 @@ void AutoTableLayout::recalcColumn(unsigned effCol)
                     default:
                         break;
                     }
+                    cell->clearPreferredLogicalWidthsComputedSinceColumnRecalc();
                 } else if (!effCol || section.primaryCellAt(i, effCol - 1) != cell) {
                     // This spanning cell originates in this column. Insert the cell into spanning cells list.
                     insertSpanCell(cell);
@@ -176,8 +178,63 @@ void AutoTableLayout::fullRecalc()
             groupLogicalWidth = Length();
     }
 
-    for (unsigned i = 0; i < nEffCols; i++)
+    m_layoutStructFromColumns = m_layoutStruct;
+    for (unsigned i = 0; i < nEffCols; i++) {
         recalcColumn(i);
+        m_hasPercent |= m_layoutStruct[i].hasPercentCells;
+    }
+
+    m_cellStructureVersion = m_table->cellStructureVersion();
+    m_layoutStructIsValid = true;
+}
+
+// Recomputes only the columns with a cell whose preferred widths changed since the last recalc. Returns false
+// if that isn't enough: the cells or columns were rearranged, a <col> changed, or there are spanning cells,
+// which contribute to several columns.
+bool AutoTableLayout::recalcDirtyColumns()
+{
+    unsigned nEffCols = m_table->numEffCols();
+    if (!m_layoutStructIsValid || m_cellStructureVersion != m_table->cellStructureVersion() || m_layoutStruct.size() != nEffCols)
+        return false;
+    if (!m_spanCells.isEmpty() && m_spanCells[0])
+        return false;
+
+    Vector<bool> dirtyColumns(nEffCols, false);
+    bool hasDirtyColumn = false;
+    for (RenderObject* child = m_table->firstChild(); child; child = child->nextSibling()) {
+        if (is<RenderTableCol>(*child)) {
+            if (child->preferredLogicalWidthsDirty())
+                return false;
+            continue;
+        }
+        if (!is<RenderTableSection>(*child))
+            continue;
+        RenderTableSection& section = downcast<RenderTableSection>(*child);
+        unsigned numRows = section.numRows();
+        for (unsigned row = 0; row < numRows; ++row) {
+            for (unsigned effCol = 0; effCol < nEffCols; ++effCol) {
+                RenderTableCell* cell = section.primaryCellAt(row, effCol);
+                if (cell && (cell->preferredLogicalWidthsDirty() || cell->preferredLogicalWidthsComputedSinceColumnRecalc())) {
+                    dirtyColumns[effCol] = true;
+                    hasDirtyColumn = true;
+                }
+            }
+        }
+    }
+
+    if (!hasDirtyColumn)
+        return true;
+
+    m_hasPercent = false;
+    for (unsigned effCol = 0; effCol < nEffCols; ++effCol) {
+        if (dirtyColumns[effCol]) {
+            m_layoutStruct[effCol] = m_layoutStructFromColumns[effCol];
+            recalcColumn(effCol);
+        }
+        m_hasPercent |= m_layoutStruct[effCol].hasPercentCells;
+    }
+    m_effectiveLogicalWidthDirty = true;
+    return true;
 }
 
 // FIXME: This needs to be adapted for vertical writing modes.
@@ -212,7 +269,8 @@ static bool shouldScaleColumns(RenderTable* table)
 
 void AutoTableLayout::computeIntrinsicLogicalWidths(LayoutUnit& minWidth, LayoutUnit& maxWidth)
 {
-    fullRecalc();
+    if (!recalcDirtyColumns())
+        fullRecalc();
 
     float spanMaxLogicalWidth = calcEffectiveLogicalWidth();
     minWidth = 0;
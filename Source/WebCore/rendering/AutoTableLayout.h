@@ -43,6 +43,7 @@ public:
 private:
     void fullRecalc();
     void recalcColumn(unsigned effCol);
+    bool recalcDirtyColumns();
 
     float calcEffectiveLogicalWidth();
 
@@ -57,12 +58,17 @@ private:
         float effectiveMaxLogicalWidth { 0 };
         float computedLogicalWidth { 0 };
         bool emptyCellsOnly { true };
+        bool hasPercentCells { false };
     };
 
     Vector<Layout, 4> m_layoutStruct;
+    // What m_layoutStruct held before the cells were looked at, so that a single column can be recomputed.
+    Vector<Layout, 4> m_layoutStructFromColumns;
     Vector<RenderTableCell*, 4> m_spanCells;
+    unsigned m_cellStructureVersion { 0 };
     bool m_hasPercent : 1;
     mutable bool m_effectiveLogicalWidthDirty : 1;
+    bool m_layoutStructIsValid : 1;
 };
 
 } // namespace WebCore
@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "LayerSpatialIndex.h"
+
+#include <wtf/HashSet.h>
+
+namespace WebCore {
+
+int LayerSpatialIndex::cellForCoordinate(int coordinate)
+{
+    // Round towards negative infinity so that cells don't straddle the origin.
+    if (coordinate >= 0)
+        return coordinate >> cellSizeShift;
+    return -((-(coordinate + 1)) >> cellSizeShift) - 1;
+}
+
+IntRect LayerSpatialIndex::cellsForRect(const LayoutRect& rect)
+{
+    int minX = cellForCoordinate(rect.x().floor());
+    int minY = cellForCoordinate(rect.y().floor());
+    int maxX = cellForCoordinate(rect.maxX().ceil());
+    int maxY = cellForCoordinate(rect.maxY().ceil());
+    return IntRect(minX, minY, maxX - minX + 1, maxY - minY + 1);
+}
+
+void LayerSpatialIndex::add(const LayoutRect& rect)
+{
+    m_rects.append(rect);
+    m_boundingBox.unite(rect);
+
+    if (m_rects.size() == minimumSizeForGrid) {
+        for (unsigned i = 0; i < m_rects.size(); ++i)
+            addToGrid(i);
+    } else if (m_rects.size() > minimumSizeForGrid)
+        addToGrid(m_rects.size() - 1);
+}
+
+void LayerSpatialIndex::add(const LayerSpatialIndex& other)
+{
+    for (auto& rect : other.m_rects)
+        add(rect);
+}
+
+void LayerSpatialIndex::addToGrid(unsigned index)
+{
+    const LayoutRect& rect = m_rects[index];
+    if (rect.isEmpty())
+        return;
+
+    IntRect cells = cellsForRect(rect);
+    if (static_cast<uint64_t>(cells.width()) * cells.height() > maximumCellsPerRect) {
+        m_rectsOutsideGrid.append(index);
+        return;
+    }
+
+    for (int y = cells.y(); y < cells.maxY(); ++y) {
+        for (int x = cells.x(); x < cells.maxX(); ++x)
+            m_cells.add(IntPoint(x, y), Vector<unsigned, 4>()).iterator->value.append(index);
+    }
+}
+
+template<typename Functor>
+bool LayerSpatialIndex::forEachCandidate(const LayoutRect& rect, const Functor& functor) const
+{
+    if (!rect.intersects(m_boundingBox))
+        return false;
+
+    if (m_rects.size() < minimumSizeForGrid) {
+        for (unsigned i = 0; i < m_rects.size(); ++i) {
+            if (functor(i))
+                return true;
+        }
+        return false;
+    }
+
+    for (unsigned index : m_rectsOutsideGrid) {
+        if (functor(index))
+            return true;
+    }
+
+    IntRect cells = cellsForRect(intersection(rect, m_boundingBox));
+    for (int y = cells.y(); y < cells.maxY(); ++y) {
+        for (int x = cells.x(); x < cells.maxX(); ++x) {
+            auto it = m_cells.find(IntPoint(x, y));
+            if (it == m_cells.end())
+                continue;
+            for (unsigned index : it->value) {
+                if (functor(index))
+                    return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool LayerSpatialIndex::intersectsAny(const LayoutRect& rect) const
+{
+    return forEachCandidate(rect, [&] (unsigned index) {
+        return m_rects[index].intersects(rect);
+    });
+}
+
+void LayerSpatialIndex::collectIntersecting(const LayoutRect& rect, Vector<unsigned>& indexes) const
+{
+    ASSERT(indexes.isEmpty());
+    // A rect spanning several cells is found once per cell.
+    HashSet<unsigned, IntHash<unsigned>, WTF::UnsignedWithZeroKeyHashTraits<unsigned>> found;
+    forEachCandidate(rect, [&] (unsigned index) {
+        if (m_rects[index].intersects(rect) && found.add(index).isNewEntry)
+            indexes.append(index);
+        return false;
+    });
+    std::sort(indexes.begin(), indexes.end());
+}
+
+} // namespace WebCore
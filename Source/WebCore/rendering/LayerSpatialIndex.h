@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef LayerSpatialIndex_h
+#define LayerSpatialIndex_h
+
+#include "IntPointHash.h"
+#include "LayoutRect.h"
+#include <wtf/HashMap.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// A list of layer bounds that can answer which of them intersect a rect without testing them all.
+// Rects are numbered in the order they were added. Once there are enough of them they are also
+// bucketed into a uniform grid; rects too large for the grid are always treated as candidates.
+class LayerSpatialIndex {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    void add(const LayoutRect&);
+    void add(const LayerSpatialIndex&);
+
+    unsigned size() const { return m_rects.size(); }
+    const LayoutRect& boundingBox() const { return m_boundingBox; }
+
+    bool intersectsAny(const LayoutRect&) const;
+    // Fills indexes with the numbers of the rects intersecting the given one, in the order they were added.
+    void collectIntersecting(const LayoutRect&, Vector<unsigned>& indexes) const;
+
+private:
+    static const unsigned minimumSizeForGrid = 32;
+    static const int cellSizeShift = 8;
+    static const unsigned maximumCellsPerRect = 64;
+
+    static int cellForCoordinate(int);
+    static IntRect cellsForRect(const LayoutRect&);
+
+    void addToGrid(unsigned index);
+    template<typename Functor> bool forEachCandidate(const LayoutRect&, const Functor&) const;
+
+    Vector<LayoutRect> m_rects;
+    LayoutRect m_boundingBox;
+    HashMap<IntPoint, Vector<unsigned, 4>> m_cells;
+    Vector<unsigned> m_rectsOutsideGrid;
+};
+
+} // namespace WebCore
+
+#endif // LayerSpatialIndex_h
@@ -1929,10 +1929,25 @@ bool RenderBlockFlow::matchedEndLine(LineLayoutState& layoutState, const InlineB
         return checkPaginationAndFloatsAtEndLine(layoutState);
     }
 
+    // Clean lines that break before the current position within the same renderer can't be matched
+    // anymore. Drop them, so that an edit moving the breaks by more than the handful of lines checked
+    // below can still match up with the clean lines further down instead of laying out the rest of
+    // the block.
+    RootInlineBox* originalEndLine = layoutState.endLine();
+    if (!originalEndLine)
+        return false;
+    RootInlineBox* firstMatchableLine = originalEndLine;
+    while (firstMatchableLine->nextRootBox() && firstMatchableLine->lineBreakObj() == resolver.position().renderer() && firstMatchableLine->lineBreakPos() < resolver.position().offset())
+        firstMatchableLine = firstMatchableLine->nextRootBox();
+    if (firstMatchableLine != originalEndLine) {
+        deleteLineRange(layoutState, originalEndLine, firstMatchableLine);
+        layoutState.setEndLine(firstMatchableLine);
+        originalEndLine = firstMatchableLine;
+    }
+
     // The first clean line doesn't match, but we can check a handful of following lines to try
     // to match back up.
     static const int numLines = 8; // The # of lines we're willing to match against.
-    RootInlineBox* originalEndLine = layoutState.endLine();
     RootInlineBox* line = originalEndLine;
     for (int i = 0; i < numLines && line; i++, line = line->nextRootBox()) {
         if (line->lineBreakObj() == resolver.position().renderer() && line->lineBreakPos() == resolver.position().offset() && !line->hasAnonymousInlineBlock()) {
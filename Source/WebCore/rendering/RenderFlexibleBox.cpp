@@ -32,6 +32,7 @@
 #include "RenderFlexibleBox.h"
 
 #include "LayoutRepainter.h"
+#include "Logging.h"
 #include "RenderLayer.h"
 #include "RenderView.h"
 #include <limits>
@@ -259,6 +260,7 @@ void RenderFlexibleBox::layoutBlock(bool relayoutChildren, LayoutUnit)
     preparePaginationBeforeBlockLayout(relayoutChildren);
 
     m_numberOfInFlowChildrenOnFirstLine = -1;
+    m_childLayoutCount = 0;
 
     beginUpdateScrollInfoAfterLayoutTransaction();
 
@@ -294,9 +296,18 @@ void RenderFlexibleBox::layoutBlock(bool relayoutChildren, LayoutUnit)
 
     repainter.repaintAfterLayout();
 
+    LOG(Layout, "RenderFlexibleBox %p laid out its children %u times", this, m_childLayoutCount);
+
     clearNeedsLayout();
 }
 
+void RenderFlexibleBox::removeChild(RenderObject& child)
+{
+    if (is<RenderBox>(child))
+        m_intrinsicLogicalHeights.remove(&downcast<RenderBox>(child));
+    RenderBlock::removeChild(child);
+}
+
 void RenderFlexibleBox::appendChildFrameRects(ChildFrameRects& childFrameRects)
 {
     for (RenderBox* child = m_orderIterator.first(); child; child = m_orderIterator.next()) {
@@ -1076,6 +1087,12 @@ bool RenderFlexibleBox::needToStretchChild(RenderBox& child)
     return crossAxisLength.isAuto();
 }
 
+bool RenderFlexibleBox::canCacheIntrinsicLogicalHeight(RenderBox& child)
+{
+    // The cross size is only the logical height of the child in row flows.
+    return !isColumnFlow() && !hasOrthogonalFlow(child) && !hasAutoMarginsInCrossAxis(child);
+}
+
 void RenderFlexibleBox::resetAutoMarginsAndLogicalTopInCrossAxis(RenderBox& child)
 {
     if (hasAutoMarginsInCrossAxis(child))
@@ -1117,15 +1134,36 @@ void RenderFlexibleBox::layoutAndPlaceChildren(LayoutUnit& crossAxisOffset, cons
 
         LayoutUnit childPreferredSize = childSizes[i] + mainAxisBorderAndPaddingExtentForChild(child);
         setLogicalOverrideSize(child, childPreferredSize);
-        // FIXME: Can avoid laying out here in some cases. See https://webkit.org/b/87905.
-        if (needToStretchChild(child) || childPreferredSize != mainAxisExtentForChild(child))
+        bool childNeedsStretch = needToStretchChild(child);
+        bool canCacheIntrinsicHeight = childNeedsStretch && canCacheIntrinsicLogicalHeight(child);
+        if (childPreferredSize != mainAxisExtentForChild(child) || (childNeedsStretch && !canCacheIntrinsicHeight))
             child.setChildNeedsLayout(MarkOnlyThis);
         else {
             // To avoid double applying margin changes in updateAutoMarginsInCrossAxis, we reset the margins here.
             resetAutoMarginsAndLogicalTopInCrossAxis(child);
         }
         updateBlockChildDirtyBitsBeforeLayout(relayoutChildren, child);
-        child.layoutIfNeeded();
+
+        // A child that gets stretched has to be measured at its unstretched height, which used to mean laying it out
+        // again on every pass. If nothing about it changed, the height from the last time is still right. The child
+        // keeps its stretched layout, and its override height, until alignChildren() decides whether to stretch it again.
+        Optional<LayoutUnit> intrinsicLogicalHeight;
+        if (canCacheIntrinsicHeight && !child.needsLayout()) {
+            auto cachedHeight = m_intrinsicLogicalHeights.find(&child);
+            if (cachedHeight != m_intrinsicLogicalHeights.end()) {
+                intrinsicLogicalHeight = cachedHeight->value;
+                if (child.logicalHeight() != cachedHeight->value)
+                    child.setOverrideLogicalContentHeight(child.logicalHeight() - child.borderAndPaddingLogicalHeight());
+            } else
+                child.setChildNeedsLayout(MarkOnlyThis);
+        }
+
+        if (child.needsLayout()) {
+            ++m_childLayoutCount;
+            child.layoutIfNeeded();
+            if (canCacheIntrinsicHeight)
+                m_intrinsicLogicalHeights.set(&child, child.logicalHeight());
+        }
 
         updateAutoMarginsInMainAxis(child, autoMarginOffset);
 
@@ -1139,7 +1177,7 @@ void RenderFlexibleBox::layoutAndPlaceChildren(LayoutUnit& crossAxisOffset, cons
 
             childCrossAxisMarginBoxExtent = maxAscent + maxDescent;
         } else
-            childCrossAxisMarginBoxExtent = crossAxisExtentForChild(child) + crossAxisMarginExtentForChild(child);
+            childCrossAxisMarginBoxExtent = intrinsicLogicalHeight.valueOr(crossAxisExtentForChild(child)) + crossAxisMarginExtentForChild(child);
         if (!isColumnFlow())
             setLogicalHeight(std::max(logicalHeight(), crossAxisOffset + flowAwareBorderAfter() + flowAwarePaddingAfter() + childCrossAxisMarginBoxExtent + crossAxisScrollbarExtent()));
         maxChildCrossAxisExtent = std::max(maxChildCrossAxisExtent, childCrossAxisMarginBoxExtent);
@@ -1377,6 +1415,7 @@ void RenderFlexibleBox::applyStretchAlignmentToChild(RenderBox& child, LayoutUni
                 child.setOverrideLogicalContentHeight(desiredLogicalHeight - child.borderAndPaddingLogicalHeight());
                 child.setLogicalHeight(0);
                 child.setChildNeedsLayout(MarkOnlyThis);
+                ++m_childLayoutCount;
                 child.layout();
             }
         }
@@ -1389,6 +1428,7 @@ void RenderFlexibleBox::applyStretchAlignmentToChild(RenderBox& child, LayoutUni
             if (childWidth != child.logicalWidth()) {
                 child.setOverrideLogicalContentWidth(childWidth - child.borderAndPaddingLogicalWidth());
                 child.setChildNeedsLayout(MarkOnlyThis);
+                ++m_childLayoutCount;
                 child.layout();
             }
         }
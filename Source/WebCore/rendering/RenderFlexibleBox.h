@@ -44,6 +44,8 @@ public:
 
     virtual const char* renderName() const override;
 
+    virtual void removeChild(RenderObject&) override;
+
     virtual bool avoidsFloats() const override final { return true; }
     virtual bool canDropAnonymousBlockChild() const override final { return false; }
     virtual void layoutBlock(bool relayoutChildren, LayoutUnit pageLogicalHeight = 0) override final;
@@ -147,6 +149,7 @@ private:
 
     void resetAutoMarginsAndLogicalTopInCrossAxis(RenderBox&);
     bool needToStretchChild(RenderBox&);
+    bool canCacheIntrinsicLogicalHeight(RenderBox&);
     void setLogicalOverrideSize(RenderBox& child, LayoutUnit childPreferredSize);
     void prepareChildForPositionedLayout(RenderBox& child, LayoutUnit mainAxisOffset, LayoutUnit crossAxisOffset, PositionedLayoutMode);
     size_t numberOfInFlowPositionedChildren(const OrderedFlexItemList&) const;
@@ -165,6 +168,10 @@ private:
 
     mutable OrderIterator m_orderIterator;
     int m_numberOfInFlowChildrenOnFirstLine;
+
+    // The logical heights stretched children had the last time they were laid out without being stretched.
+    HashMap<const RenderBox*, LayoutUnit> m_intrinsicLogicalHeights;
+    unsigned m_childLayoutCount { 0 };
 };
 
 } // namespace WebCore
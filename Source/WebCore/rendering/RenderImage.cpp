@@ -380,6 +380,14 @@ void RenderImage::paintReplaced(PaintInfo& paintInfo, const LayoutPoint& paintOf
 
     Page* page = frame().page();
 
+    // An image being painted is visible, load it ahead of the ones that aren't.
+    if (paintInfo.phase == PaintPhaseForeground) {
+        if (auto* cachedImage = imageResource().cachedImage()) {
+            if (cachedImage->isLoading())
+                cachedImage->raiseLoadPriority(ResourceLoadPriority::Medium);
+        }
+    }
+
     if (!imageResource().hasImage() || imageResource().errorOccurred()) {
         if (paintInfo.phase == PaintPhaseSelection)
             return;
@@ -78,6 +78,7 @@
 #include "HitTestingTransformState.h"
 #include "HitTestRequest.h"
 #include "HitTestResult.h"
+#include "LayerSpatialIndex.h"
 #include "OverflowEvent.h"
 #include "OverlapTestRequestClient.h"
 #include "Page.h"
@@ -462,6 +463,8 @@ void RenderLayer::updateLayerPositionsAfterLayout(const RenderLayer* rootLayer,
 
 void RenderLayer::updateLayerPositions(RenderGeometryMap* geometryMap, UpdateLayerPositionsFlags flags)
 {
+    renderer().view().layerGeometryDidChange();
+
     updateLayerPosition(); // For relpositioned layers or non-positioned layers,
                            // we need to keep in sync, since we may have shifted relative
                            // to our parent layer.
@@ -825,6 +828,8 @@ void RenderLayer::updateLayerPositionsAfterOverflowScroll()
 
 void RenderLayer::updateLayerPositionsAfterScroll(RenderGeometryMap* geometryMap, UpdateLayerPositionsAfterScrollFlags flags)
 {
+    renderer().view().layerGeometryDidChange();
+
     // FIXME: This shouldn't be needed, but there are some corner cases where
     // these flags are still dirty. Update so that the check below is valid.
     updateDescendantDependentFlags();
@@ -942,6 +947,8 @@ void RenderLayer::dirtyAncestorChainHasBlendingDescendants()
 
 void RenderLayer::updateTransform()
 {
+    renderer().view().layerGeometryDidChange();
+
     bool hasTransform = renderer().hasTransform();
     bool had3DTransform = has3DTransform();
 
@@ -5336,9 +5343,23 @@ RenderLayer* RenderLayer::hitTestList(Vector<RenderLayer*>* list, RenderLayer* r
     if (!hasSelfPaintingLayerDescendant())
         return nullptr;
 
+    // Layers in 3D rendering contexts, fragmented layers and clipping that is ignored make the bounds in the index unreliable.
+    const LayerSpatialIndex* index = nullptr;
+    Vector<unsigned> candidates;
+    if (!transformState && !depthSortDescendants && !request.ignoreClipping() && !enclosingPaginationLayer(IncludeCompositedPaginatedLayers)
+        && renderer().flowThreadState() == RenderObject::NotInsideFlowThread && renderer().frame().settings().layerHitTestIndexEnabled()) {
+        index = hitTestIndexForList(*list);
+        if (index) {
+            LayoutRect hitTestBounds = hitTestLocation.boundingBox();
+            hitTestBounds.move(-offsetFromAncestor(rootLayer));
+            index->collectIntersecting(hitTestBounds, candidates);
+        }
+    }
+
     RenderLayer* resultLayer = nullptr;
-    for (int i = list->size() - 1; i >= 0; --i) {
-        RenderLayer* childLayer = list->at(i);
+    int layerCount = index ? candidates.size() : list->size();
+    for (int i = layerCount - 1; i >= 0; --i) {
+        RenderLayer* childLayer = list->at(index ? candidates[i] : i);
         if (childLayer->isFlowThreadCollectingGraphicsLayersUnderRegions())
             continue;
         RenderLayer* hitLayer = nullptr;
@@ -5362,6 +5383,41 @@ RenderLayer* RenderLayer::hitTestList(Vector<RenderLayer*>* list, RenderLayer* r
     return resultLayer;
 }
 
+struct RenderLayer::HitTestIndexes {
+    unsigned layerGeometryVersion;
+    HashMap<const Vector<RenderLayer*>*, std::unique_ptr<LayerSpatialIndex>> indexes;
+};
+
+const LayerSpatialIndex* RenderLayer::hitTestIndexForList(const Vector<RenderLayer*>& list)
+{
+    // Below this, testing every layer is about as fast as finding the bounds of the ones that could be hit.
+    static const unsigned minimumLayerCountForHitTestIndex = 64;
+    if (list.size() < minimumLayerCountForHitTestIndex)
+        return nullptr;
+
+    unsigned layerGeometryVersion = renderer().view().layerGeometryVersion();
+    if (!m_hitTestIndexes || m_hitTestIndexes->layerGeometryVersion != layerGeometryVersion) {
+        m_hitTestIndexes = std::make_unique<HitTestIndexes>();
+        m_hitTestIndexes->layerGeometryVersion = layerGeometryVersion;
+    }
+
+    auto& index = m_hitTestIndexes->indexes.add(&list, nullptr).iterator->value;
+    if (index)
+        return index.get();
+
+    // Don't trust the local clip rects: descendants that escape the clip can still be hit.
+    CalculateLayerBoundsFlags boundsFlags = (DefaultCalculateLayerBoundsFlags & ~UseLocalClipRectIfPossible) | IncludeCompositedDescendants;
+    index = std::make_unique<LayerSpatialIndex>();
+    for (auto* layer : list) {
+        // Layers that aren't self-painting have no bounds of their own, but their descendants can still be hit.
+        if (!layer->isSelfPaintingLayer() || layer->enclosingPaginationLayer(IncludeCompositedPaginatedLayers))
+            index->add(LayoutRect::infiniteRect());
+        else
+            index->add(layer->calculateLayerBounds(this, layer->offsetFromAncestor(this), boundsFlags));
+    }
+    return index.get();
+}
+
 void RenderLayer::updateClipRects(const ClipRectsContext& clipRectsContext)
 {
     ClipRectsType clipRectsType = clipRectsContext.clipRectsType;
@@ -6215,6 +6271,7 @@ void RenderLayer::dirtyZOrderLists()
     m_zOrderListsDirty = true;
 
     if (!renderer().documentBeingDestroyed()) {
+        renderer().view().layerGeometryDidChange();
         if (isFlowThreadCollectingGraphicsLayersUnderRegions())
             downcast<RenderFlowThread>(renderer()).setNeedsLayerToRegionMappingsUpdate();
         compositor().setCompositingLayersNeedRebuild();
@@ -6239,6 +6296,7 @@ void RenderLayer::dirtyNormalFlowList()
     m_normalFlowListDirty = true;
 
     if (!renderer().documentBeingDestroyed()) {
+        renderer().view().layerGeometryDidChange();
         if (isFlowThreadCollectingGraphicsLayersUnderRegions())
             downcast<RenderFlowThread>(renderer()).setNeedsLayerToRegionMappingsUpdate();
         compositor().setCompositingLayersNeedRebuild();
@@ -6680,6 +6738,8 @@ void RenderLayer::updateOutOfFlowPositioned(const RenderStyle* oldStyle)
 
 void RenderLayer::styleChanged(StyleDifference diff, const RenderStyle* oldStyle)
 {
+    renderer().view().layerGeometryDidChange();
+
     bool isNormalFlowOnly = shouldBeNormalFlowOnly();
     if (isNormalFlowOnly != m_isNormalFlowOnly) {
         m_isNormalFlowOnly = isNormalFlowOnly;
@@ -63,6 +63,7 @@ class FilterOperations;
 class HitTestRequest;
 class HitTestResult;
 class HitTestingTransformState;
+class LayerSpatialIndex;
 class RenderFlowThread;
 class RenderGeometryMap;
 class RenderLayerBacking;
@@ -816,6 +817,7 @@ private:
         const LayoutRect& hitTestRect, const HitTestLocation&,
         const HitTestingTransformState*, double* zOffsetForDescendants, double* zOffset,
         const HitTestingTransformState* unflattenedTransformState, bool depthSortDescendants);
+    const LayerSpatialIndex* hitTestIndexForList(const Vector<RenderLayer*>&);
 
     RenderLayer* hitTestFixedLayersInNamedFlows(RenderLayer* rootLayer,
         const HitTestRequest&, HitTestResult&,
@@ -1111,6 +1113,10 @@ private:
     // overflow layers, but that may change in the future.
     std::unique_ptr<Vector<RenderLayer*>> m_normalFlowList;
 
+    // Bounds of the layers in our large lists, relative to us, used to skip the layers a hit test can't reach.
+    struct HitTestIndexes;
+    std::unique_ptr<HitTestIndexes> m_hitTestIndexes;
+
     std::unique_ptr<ClipRectsCache> m_clipRectsCache;
     
     IntPoint m_cachedOverlayScrollbarOffset;
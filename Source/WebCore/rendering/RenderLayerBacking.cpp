@@ -28,6 +28,7 @@
 #include "RenderLayerBacking.h"
 
 #include "AnimationController.h"
+#include "BitmapImage.h"
 #include "CanvasRenderingContext.h"
 #include "CSSPropertyNames.h"
 #include "CachedImage.h"
@@ -2337,9 +2338,15 @@ void RenderLayerBacking::paintContents(const GraphicsLayer* graphicsLayer, Graph
         if (!(paintingPhase & GraphicsLayerPaintOverflowContents))
             dirtyRect.intersect(enclosingIntRect(compositedBoundsIncludingMargin()));
 
+        // Layer contents are repainted once the images in them are decoded.
+        bool wasAllowingAsynchronousImageDecoding = context.allowsAsynchronousImageDecoding();
+        context.setAllowsAsynchronousImageDecoding(BitmapImage::asynchronousDecodingEnabled());
+
         // We have to use the same root as for hit testing, because both methods can compute and cache clipRects.
         paintIntoLayer(graphicsLayer, context, dirtyRect, PaintBehaviorNormal, paintingPhase);
 
+        context.setAllowsAsynchronousImageDecoding(wasAllowingAsynchronousImageDecoding);
+
         InspectorInstrumentation::didPaint(&renderer(), dirtyRect);
     } else if (graphicsLayer == layerForHorizontalScrollbar()) {
         paintScrollbar(m_owningLayer.horizontalScrollbar(), context, dirtyRect);
@@ -41,6 +41,7 @@
 #include "HTMLNames.h"
 #include "HitTestResult.h"
 #include "InspectorInstrumentation.h"
+#include "LayerSpatialIndex.h"
 #include "Logging.h"
 #include "MainFrame.h"
 #include "NodeList.h"
@@ -104,32 +105,27 @@ class OverlapMapContainer {
 public:
     void add(const LayoutRect& bounds)
     {
-        m_layerRects.append(bounds);
-        m_boundingBox.unite(bounds);
+        m_layerRects.add(bounds);
     }
 
     bool overlapsLayers(const LayoutRect& bounds) const
     {
-        // Checking with the bounding box will quickly reject cases when
-        // layers are created for lists of items going in one direction and
-        // never overlap with each other.
-        if (!bounds.intersects(m_boundingBox))
-            return false;
-        for (const auto& layerRect : m_layerRects) {
-            if (layerRect.intersects(bounds))
-                return true;
-        }
-        return false;
+        // The index rejects bounds outside the bounding box of all the layers
+        // first, which is quick when layers are created for lists of items
+        // going in one direction and never overlap with each other.
+        return m_layerRects.intersectsAny(bounds);
     }
 
-    void unite(const OverlapMapContainer& otherContainer)
+    void unite(OverlapMapContainer&& otherContainer)
     {
-        m_layerRects.appendVector(otherContainer.m_layerRects);
-        m_boundingBox.unite(otherContainer.m_boundingBox);
+        // Always add the smaller set of rects to the larger one, so that each rect is
+        // only indexed again a logarithmic number of times as containers are popped.
+        if (otherContainer.m_layerRects.size() > m_layerRects.size())
+            std::swap(m_layerRects, otherContainer.m_layerRects);
+        m_layerRects.add(otherContainer.m_layerRects);
     }
 private:
-    Vector<LayoutRect> m_layerRects;
-    LayoutRect m_boundingBox;
+    LayerSpatialIndex m_layerRects;
 };
 
 class RenderLayerCompositor::OverlapMap {
@@ -171,7 +167,7 @@ public:
 
     void popCompositingContainer()
     {
-        m_overlapStack[m_overlapStack.size() - 2].unite(m_overlapStack.last());
+        m_overlapStack[m_overlapStack.size() - 2].unite(WTF::move(m_overlapStack.last()));
         m_overlapStack.removeLast();
     }
 
@@ -733,6 +729,7 @@ bool RenderLayerCompositor::updateCompositingLayers(CompositingUpdateType update
 
 #if !LOG_DISABLED
     double startTime = 0;
+    double compositingRequirementsTime = 0;
     if (compositingLogEnabled()) {
         ++m_rootLayerUpdateCount;
         startTime = monotonicallyIncreasingTime();
@@ -748,7 +745,14 @@ bool RenderLayerCompositor::updateCompositingLayers(CompositingUpdateType update
         bool layersChanged = false;
         bool saw3DTransform = false;
         OverlapMap overlapTestRequestMap;
+#if !LOG_DISABLED
+        double compositingRequirementsStartTime = compositingLogEnabled() ? monotonicallyIncreasingTime() : 0;
+#endif
         computeCompositingRequirements(nullptr, *updateRoot, overlapTestRequestMap, compState, layersChanged, saw3DTransform);
+#if !LOG_DISABLED
+        if (compositingLogEnabled())
+            compositingRequirementsTime = monotonicallyIncreasingTime() - compositingRequirementsStartTime;
+#endif
         needHierarchyUpdate |= layersChanged;
     }
 
@@ -792,11 +796,12 @@ bool RenderLayerCompositor::updateCompositingLayers(CompositingUpdateType update
 #if !LOG_DISABLED
     if (compositingLogEnabled() && isFullUpdate && (needHierarchyUpdate || needGeometryUpdate)) {
         double endTime = monotonicallyIncreasingTime();
-        LOG(Compositing, "Total layers   primary   secondary   obligatory backing (KB)   secondary backing(KB)   total backing (KB)  update time (ms)\n");
+        LOG(Compositing, "Total layers   primary   secondary   obligatory backing (KB)   secondary backing(KB)   total backing (KB)  update time (ms)  requirements time (ms)\n");
 
-        LOG(Compositing, "%8d %11d %9d %20.2f %22.2f %22.2f %18.2f\n",
+        LOG(Compositing, "%8d %11d %9d %20.2f %22.2f %22.2f %18.2f %23.2f\n",
             m_obligateCompositedLayerCount + m_secondaryCompositedLayerCount, m_obligateCompositedLayerCount,
-            m_secondaryCompositedLayerCount, m_obligatoryBackingStoreBytes / 1024, m_secondaryBackingStoreBytes / 1024, (m_obligatoryBackingStoreBytes + m_secondaryBackingStoreBytes) / 1024, 1000.0 * (endTime - startTime));
+            m_secondaryCompositedLayerCount, m_obligatoryBackingStoreBytes / 1024, m_secondaryBackingStoreBytes / 1024, (m_obligatoryBackingStoreBytes + m_secondaryBackingStoreBytes) / 1024, 1000.0 * (endTime - startTime),
+            1000.0 * compositingRequirementsTime);
     }
 #endif
     ASSERT(updateRoot || !m_compositingLayersNeedRebuild);
@@ -141,7 +141,7 @@ struct AnnotatedRegionValue {
 
 // Base class for all rendering tree objects.
 class RenderObject : public CachedImageClient {
-    WTF_MAKE_FAST_ALLOCATED;
+    WTF_MAKE_ISOLATED_ALLOCATED(RenderObjects);
     friend class RenderBlock;
     friend class RenderBlockFlow;
     friend class RenderElement;
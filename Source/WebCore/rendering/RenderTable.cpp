@@ -241,6 +241,7 @@ void RenderTable::invalidateCachedColumns()
     m_columnRenderersValid = false;
     m_columnRenderers.resize(0);
     m_effectiveColumnIndexMap.clear();
+    ++m_cellStructureVersion;
 }
 
 void RenderTable::invalidateCachedColumnOffsets()
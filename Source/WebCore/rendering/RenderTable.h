@@ -226,9 +226,13 @@ public:
         if (documentBeingDestroyed())
             return;
         m_needsSectionRecalc = true;
+        ++m_cellStructureVersion;
         setNeedsLayout();
     }
 
+    // Changes whenever cells, rows, sections or columns may have been added, removed or moved.
+    unsigned cellStructureVersion() const { return m_cellStructureVersion; }
+
     RenderTableSection* sectionAbove(const RenderTableSection*, SkipEmptySectionsValue = DoNotSkipEmptySections) const;
     RenderTableSection* sectionBelow(const RenderTableSection*, SkipEmptySectionsValue = DoNotSkipEmptySections) const;
 
@@ -366,6 +370,7 @@ private:
     LayoutUnit m_borderEnd;
     mutable LayoutUnit m_columnOffsetTop;
     mutable LayoutUnit m_columnOffsetHeight;
+    unsigned m_cellStructureVersion { 0 };
 };
 
 inline RenderTableSection* RenderTable::topSection() const
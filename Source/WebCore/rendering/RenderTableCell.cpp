@@ -58,6 +58,7 @@ RenderTableCell::RenderTableCell(Element& element, Ref<RenderStyle>&& style)
     : RenderBlockFlow(element, WTF::move(style))
     , m_column(unsetColumnIndex)
     , m_cellWidthChanged(false)
+    , m_preferredLogicalWidthsComputedSinceColumnRecalc(true)
     , m_hasColSpan(false)
     , m_hasRowSpan(false)
     , m_hasEmptyCollapsedBeforeBorder(false)
@@ -74,6 +75,7 @@ RenderTableCell::RenderTableCell(Document& document, Ref<RenderStyle>&& style)
     : RenderBlockFlow(document, WTF::move(style))
     , m_column(unsetColumnIndex)
     , m_cellWidthChanged(false)
+    , m_preferredLogicalWidthsComputedSinceColumnRecalc(true)
     , m_hasColSpan(false)
     , m_hasRowSpan(false)
     , m_hasEmptyCollapsedBeforeBorder(false)
@@ -183,6 +185,7 @@ void RenderTableCell::computePreferredLogicalWidths()
     table()->recalcSectionsIfNeeded();
 
     RenderBlockFlow::computePreferredLogicalWidths();
+    m_preferredLogicalWidthsComputedSinceColumnRecalc = true;
     if (!element() || !style().autoWrap() || !element()->fastHasAttribute(nowrapAttr))
         return;
 
@@ -32,8 +32,8 @@
 namespace WebCore {
 
 // These is limited by the size of RenderTableCell::m_column bitfield.
-static const unsigned unsetColumnIndex = 0x1FFFFFF;
-static const unsigned maxColumnIndex = 0x1FFFFFE; // 33554430
+static const unsigned unsetColumnIndex = 0xFFFFFF;
+static const unsigned maxColumnIndex = 0xFFFFFE; // 16777214
 
 enum IncludeBorderColorOrNot { DoNotIncludeBorderColor, IncludeBorderColor };
 
@@ -109,6 +109,10 @@ public:
     bool cellWidthChanged() const { return m_cellWidthChanged; }
     void setCellWidthChanged(bool b = true) { m_cellWidthChanged = b; }
 
+    // Lets AutoTableLayout find the columns it needs to recompute, even if something else asked for the new widths first.
+    bool preferredLogicalWidthsComputedSinceColumnRecalc() const { return m_preferredLogicalWidthsComputedSinceColumnRecalc; }
+    void clearPreferredLogicalWidthsComputedSinceColumnRecalc() { m_preferredLogicalWidthsComputedSinceColumnRecalc = false; }
+
     static RenderTableCell* createAnonymousWithParentRenderer(const RenderObject*);
     virtual RenderBox* createAnonymousBoxWithSameTypeAs(const RenderObject* parent) const override { return createAnonymousWithParentRenderer(parent); }
 
@@ -198,8 +202,9 @@ private:
     void previousSibling() const = delete;
 
     // Note MSVC will only pack members if they have identical types, hence we use unsigned instead of bool here.
-    unsigned m_column : 25;
+    unsigned m_column : 24;
     unsigned m_cellWidthChanged : 1;
+    unsigned m_preferredLogicalWidthsComputedSinceColumnRecalc : 1;
     unsigned m_hasColSpan: 1;
     unsigned m_hasRowSpan: 1;
     mutable unsigned m_hasEmptyCollapsedBeforeBorder: 1;
@@ -41,6 +41,7 @@
 #include "RenderLayer.h"
 #include "RenderView.h"
 #include "Settings.h"
+#include "SimpleLineLayoutBreakOpportunities.h"
 #include "SimpleLineLayoutFunctions.h"
 #include "Text.h"
 #include "TextBreakIterator.h"
@@ -282,6 +283,7 @@ void RenderText::removeAndDestroyTextBoxes()
 void RenderText::willBeDestroyed()
 {
     secureTextTimers().remove(this);
+    SimpleLineLayout::BreakOpportunities::rendererWillBeDestroyed(*this);
 
     removeAndDestroyTextBoxes();
     RenderObject::willBeDestroyed();
@@ -1143,6 +1145,9 @@ void RenderText::setText(const String& text, bool force)
     setNeedsLayoutAndPrefWidthsRecalc();
     m_knownToHaveNoOverflowAndNoFallbackFonts = false;
 
+    if (frame().settings().backgroundLineBreakingEnabled())
+        SimpleLineLayout::BreakOpportunities::textDidChange(*this);
+
     if (is<RenderBlockFlow>(*parent()))
         downcast<RenderBlockFlow>(*parent()).invalidateLineLayoutPath();
     
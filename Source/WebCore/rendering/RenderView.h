@@ -225,6 +225,10 @@ public:
     void setHasSoftwareFilters(bool hasSoftwareFilters) { m_hasSoftwareFilters = hasSoftwareFilters; }
     bool hasSoftwareFilters() const { return m_hasSoftwareFilters; }
 
+    // Bumped whenever a layer moves, is transformed or changes its z-order lists, to invalidate data derived from layer geometry.
+    unsigned layerGeometryVersion() const { return m_layerGeometryVersion; }
+    void layerGeometryDidChange() { ++m_layerGeometryVersion; }
+
     uint64_t rendererCount() const { return m_rendererCount; }
     void didCreateRenderer() { ++m_rendererCount; }
     void didDestroyRenderer() { --m_rendererCount; }
@@ -371,6 +375,7 @@ private:
 
     RenderQuote* m_renderQuoteHead;
     unsigned m_renderCounterCount;
+    unsigned m_layerGeometryVersion { 0 };
 
     bool m_selectionWasCaret;
     bool m_hasSoftwareFilters;
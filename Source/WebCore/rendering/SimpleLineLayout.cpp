@@ -26,6 +26,7 @@
 #include "config.h"
 #include "SimpleLineLayout.h"
 
+#include "Document.h"
 #include "FontCache.h"
 #include "Frame.h"
 #include "GraphicsContext.h"
@@ -38,6 +39,7 @@
 #include "PaintInfo.h"
 #include "RenderBlockFlow.h"
 #include "RenderChildIterator.h"
+#include "RenderInline.h"
 #include "RenderLineBreak.h"
 #include "RenderStyle.h"
 #include "RenderText.h"
@@ -53,12 +55,27 @@
 namespace WebCore {
 namespace SimpleLineLayout {
 
+#ifndef NDEBUG
+#define SET_REASON_AND_RETURN_IF_NEEDED(reason, reasons, includeReasons) { \
+        reasons |= reason; \
+        if (includeReasons == IncludeReasons::First) \
+            return reasons; \
+    }
+#else
+#define SET_REASON_AND_RETURN_IF_NEEDED(reason, reasons, includeReasons) { \
+        ASSERT_UNUSED(includeReasons, includeReasons == IncludeReasons::First); \
+        reasons |= reason; \
+        return reasons; \
+    }
+#endif
+
 template <typename CharacterType>
-static bool canUseForText(const CharacterType* text, unsigned length, const Font& font)
+static AvoidanceReasonFlags canUseForText(const CharacterType* text, unsigned length, const Font& font, IncludeReasons includeReasons)
 {
+    AvoidanceReasonFlags reasons = { };
     // FIXME: <textarea maxlength=0> generates empty text node.
     if (!length)
-        return false;
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowTextIsEmpty, reasons, includeReasons);
     for (unsigned i = 0; i < length; ++i) {
         UChar character = text[i];
         if (character == ' ')
@@ -66,36 +83,88 @@ static bool canUseForText(const CharacterType* text, unsigned length, const Font
 
         // These would be easy to support.
         if (character == noBreakSpace)
-            return false;
+            SET_REASON_AND_RETURN_IF_NEEDED(FlowTextHasNoBreakSpace, reasons, includeReasons);
         if (character == softHyphen)
-            return false;
+            SET_REASON_AND_RETURN_IF_NEEDED(FlowTextHasSoftHyphen, reasons, includeReasons);
 
         UCharDirection direction = u_charDirection(character);
         if (direction == U_RIGHT_TO_LEFT || direction == U_RIGHT_TO_LEFT_ARABIC
             || direction == U_RIGHT_TO_LEFT_EMBEDDING || direction == U_RIGHT_TO_LEFT_OVERRIDE
             || direction == U_LEFT_TO_RIGHT_EMBEDDING || direction == U_LEFT_TO_RIGHT_OVERRIDE
             || direction == U_POP_DIRECTIONAL_FORMAT || direction == U_BOUNDARY_NEUTRAL)
-            return false;
+            SET_REASON_AND_RETURN_IF_NEEDED(FlowTextHasDirectionCharacter, reasons, includeReasons);
 
         if (!font.glyphForCharacter(character))
-            return false;
+            SET_REASON_AND_RETURN_IF_NEEDED(FlowFontIsMissingGlyph, reasons, includeReasons);
     }
-    return true;
+    return reasons;
 }
 
-static bool canUseForText(const RenderText& textRenderer, const Font& font)
+static AvoidanceReasonFlags canUseForText(const RenderText& textRenderer, const Font& font, IncludeReasons includeReasons)
 {
     if (textRenderer.is8Bit())
-        return canUseForText(textRenderer.characters8(), textRenderer.textLength(), font);
-    return canUseForText(textRenderer.characters16(), textRenderer.textLength(), font);
+        return canUseForText(textRenderer.characters8(), textRenderer.textLength(), font, includeReasons);
+    return canUseForText(textRenderer.characters16(), textRenderer.textLength(), font, includeReasons);
 }
 
-bool canUseFor(const RenderBlockFlow& flow)
+static AvoidanceReasonFlags canUseForStyle(const RenderStyle& style, IncludeReasons includeReasons)
 {
+    AvoidanceReasonFlags reasons = { };
+    if (style.textDecorationsInEffect() != TextDecorationNone)
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasTextDecoration, reasons, includeReasons);
+    if (style.textAlign() == JUSTIFY)
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasJustifiedAlignment, reasons, includeReasons);
+    // Non-visible overflow should be pretty easy to support.
+    if (style.overflowX() != OVISIBLE || style.overflowY() != OVISIBLE)
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasOverflowNotVisible, reasons, includeReasons);
+    if (!style.textIndent().isZero())
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasTextIndent, reasons, includeReasons);
+    if (!style.wordSpacing().isZero() || style.letterSpacing())
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasWordOrLetterSpacing, reasons, includeReasons);
+    if (!style.isLeftToRightDirection())
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowIsNotLTR, reasons, includeReasons);
+    if (style.lineBoxContain() != RenderStyle::initialLineBoxContain())
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasLineBoxContainProperty, reasons, includeReasons);
+    if (style.writingMode() != TopToBottomWritingMode)
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowIsNotTopToBottom, reasons, includeReasons);
+    if (style.lineBreak() != LineBreakAuto)
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasLineBreak, reasons, includeReasons);
+    if (style.wordBreak() != NormalWordBreak)
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasWordBreak, reasons, includeReasons);
+    if (style.unicodeBidi() != UBNormal || style.rtlOrdering() != LogicalOrder)
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasNonNormalUnicodeBiDi, reasons, includeReasons);
+    if (style.lineAlign() != LineAlignNone || style.lineSnap() != LineSnapNone)
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasLineAlignEdges, reasons, includeReasons);
+    if (style.hyphens() == HyphensAuto)
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasHyphensAuto, reasons, includeReasons);
+    if (style.textEmphasisFill() != TextEmphasisFillFilled || style.textEmphasisMark() != TextEmphasisMarkNone)
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasTextEmphasisFillOrMark, reasons, includeReasons);
+    if (style.textShadow())
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasTextShadow, reasons, includeReasons);
+    if (style.hasPseudoStyle(FIRST_LINE))
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasPseudoFirstLine, reasons, includeReasons);
+    if (style.hasPseudoStyle(FIRST_LETTER))
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasPseudoFirstLetter, reasons, includeReasons);
+    if (style.hasTextCombine())
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasTextCombine, reasons, includeReasons);
+    if (style.backgroundClip() == TextFillBox)
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasTextFillBox, reasons, includeReasons);
+    if (style.borderFit() == BorderFitLines)
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasBorderFitLines, reasons, includeReasons);
+#if ENABLE(CSS_TRAILING_WORD)
+    if (style.trailingWord() != TrailingWord::Auto)
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasTrailingWord, reasons, includeReasons);
+#endif
+    return reasons;
+}
+
+AvoidanceReasonFlags canUseForWithReason(const RenderBlockFlow& flow, IncludeReasons includeReasons)
+{
+    AvoidanceReasonFlags reasons = { };
     if (!flow.frame().settings().simpleLineLayoutEnabled())
-        return false;
+        SET_REASON_AND_RETURN_IF_NEEDED(FeatureIsDisabled, reasons, includeReasons);
     if (!flow.firstChild())
-        return false;
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasNoChild, reasons, includeReasons);
     // This currently covers <blockflow>#text</blockflow>, <blockflow>#text<br></blockflow> and mutiple (sibling) RenderText cases.
     // The <blockflow><inline>#text</inline></blockflow> case is also popular and should be relatively easy to cover.
     for (const auto& renderer : childrenOfType<RenderObject>(flow)) {
@@ -103,77 +172,37 @@ bool canUseFor(const RenderBlockFlow& flow)
             continue;
         if (is<RenderLineBreak>(renderer) && !downcast<RenderLineBreak>(renderer).isWBR() && renderer.style().clear() == CNONE)
             continue;
-        return false;
+        AvoidanceReason childReason = renderer.isFloating() ? FlowHasFloatingChild : is<RenderInline>(renderer) ? FlowHasInlineChild : FlowHasNonSupportedChild;
+        SET_REASON_AND_RETURN_IF_NEEDED(childReason, reasons, includeReasons);
+        break;
     }
     if (!flow.isHorizontalWritingMode())
-        return false;
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowIsNotTopToBottom, reasons, includeReasons);
     if (flow.flowThreadState() != RenderObject::NotInsideFlowThread)
-        return false;
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowIsInsideRegion, reasons, includeReasons);
     // Printing does pagination without a flow thread.
     if (flow.document().paginated())
-        return false;
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowIsPaginated, reasons, includeReasons);
     if (flow.hasOutline())
-        return false;
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasOutline, reasons, includeReasons);
     if (flow.isRubyText() || flow.isRubyBase())
-        return false;
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowIsRuby, reasons, includeReasons);
     if (flow.parent()->isDeprecatedFlexibleBox())
-        return false;
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowIsDeprecatedFlexBox, reasons, includeReasons);
     // FIXME: Implementation of wrap=hard looks into lineboxes.
     if (flow.parent()->isTextArea() && flow.parent()->element()->fastHasAttribute(HTMLNames::wrapAttr))
-        return false;
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowParentIsTextAreaWithWrapping, reasons, includeReasons);
     // FIXME: Placeholders do something strange.
     if (is<RenderTextControl>(*flow.parent()) && downcast<RenderTextControl>(*flow.parent()).textFormControlElement().placeholderElement())
-        return false;
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowParentIsPlaceholderElement, reasons, includeReasons);
     const RenderStyle& style = flow.style();
-    if (style.textDecorationsInEffect() != TextDecorationNone)
-        return false;
-    if (style.textAlign() == JUSTIFY)
-        return false;
-    // Non-visible overflow should be pretty easy to support.
-    if (style.overflowX() != OVISIBLE || style.overflowY() != OVISIBLE)
-        return false;
-    if (!style.textIndent().isZero())
-        return false;
-    if (!style.wordSpacing().isZero() || style.letterSpacing())
-        return false;
-    if (!style.isLeftToRightDirection())
-        return false;
-    if (style.lineBoxContain() != RenderStyle::initialLineBoxContain())
-        return false;
-    if (style.writingMode() != TopToBottomWritingMode)
-        return false;
-    if (style.lineBreak() != LineBreakAuto)
-        return false;
-    if (style.wordBreak() != NormalWordBreak)
-        return false;
-    if (style.unicodeBidi() != UBNormal || style.rtlOrdering() != LogicalOrder)
-        return false;
-    if (style.lineAlign() != LineAlignNone || style.lineSnap() != LineSnapNone)
-        return false;
-    if (style.hyphens() == HyphensAuto)
-        return false;
-    if (style.textEmphasisFill() != TextEmphasisFillFilled || style.textEmphasisMark() != TextEmphasisMarkNone)
-        return false;
-    if (style.textShadow())
-        return false;
+    reasons |= canUseForStyle(style, includeReasons);
+    if (reasons && includeReasons == IncludeReasons::First)
+        return reasons;
     if (style.textOverflow() || (flow.isAnonymousBlock() && flow.parent()->style().textOverflow()))
-        return false;
-    if (style.hasPseudoStyle(FIRST_LINE) || style.hasPseudoStyle(FIRST_LETTER))
-        return false;
-    else if (flow.isAnonymous() && flow.firstLineBlock())
-        return false;
-    if (style.hasTextCombine())
-        return false;
-    if (style.backgroundClip() == TextFillBox)
-        return false;
-    if (style.borderFit() == BorderFitLines)
-        return false;
-    if (style.lineBreak() != LineBreakAuto)
-        return false;
-#if ENABLE(CSS_TRAILING_WORD)
-    if (style.trailingWord() != TrailingWord::Auto)
-        return false;
-#endif
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasTextOverflow, reasons, includeReasons);
+    if (flow.isAnonymous() && flow.firstLineBlock())
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowHasPseudoFirstLine, reasons, includeReasons);
 
     // We can't use the code path if any lines would need to be shifted below floats. This is because we don't keep per-line y coordinates.
     if (flow.containsFloats()) {
@@ -187,32 +216,130 @@ bool canUseFor(const RenderBlockFlow& flow)
                 // if a float has a shape, we cannot tell if content will need to be shifted until after we lay it out,
                 // since the amount of space is not uniform for the height of the float.
                 if (floatingObject->renderer().shapeOutsideInfo())
-                    return false;
+                    SET_REASON_AND_RETURN_IF_NEEDED(FlowHasUnsupportedFloat, reasons, includeReasons);
 #endif
                 float availableWidth = flow.availableLogicalWidthForLine(floatingObject->y(), false);
                 if (availableWidth < minimumWidthNeeded)
-                    return false;
+                    SET_REASON_AND_RETURN_IF_NEEDED(FlowHasUnsupportedFloat, reasons, includeReasons);
             }
         }
     }
     if (style.fontCascade().primaryFont().isSVGFont())
-        return false;
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowFontIsSVGFont, reasons, includeReasons);
     // We assume that all lines have metrics based purely on the primary font.
     auto& primaryFont = style.fontCascade().primaryFont();
     if (primaryFont.isLoading())
-        return false;
+        SET_REASON_AND_RETURN_IF_NEEDED(FlowPrimaryFontIsLoading, reasons, includeReasons);
     for (const auto& textRenderer : childrenOfType<RenderText>(flow)) {
         if (textRenderer.isCombineText() || textRenderer.isCounter() || textRenderer.isQuote() || textRenderer.isTextFragment()
             || textRenderer.isSVGInlineText())
-            return false;
+            SET_REASON_AND_RETURN_IF_NEEDED(FlowTextIsRenderTextSubclass, reasons, includeReasons);
         if (style.fontCascade().codePath(TextRun(textRenderer.text())) != FontCascade::Simple)
-            return false;
-        if (!canUseForText(textRenderer, primaryFont))
-            return false;
+            SET_REASON_AND_RETURN_IF_NEEDED(FlowFontIsNotSimple, reasons, includeReasons);
+        reasons |= canUseForText(textRenderer, primaryFont, includeReasons);
+        if (reasons && includeReasons == IncludeReasons::First)
+            return reasons;
     }
-    return true;
+    return reasons;
 }
 
+bool canUseFor(const RenderBlockFlow& flow)
+{
+    return !canUseForWithReason(flow, IncludeReasons::First);
+}
+
+#ifndef NDEBUG
+static void printReason(AvoidanceReason reason)
+{
+    switch (reason) {
+    case FlowIsInsideRegion: fprintf(stderr, "flow is inside region"); break;
+    case FlowHasNonSupportedChild: fprintf(stderr, "flow has unsupported child renderer"); break;
+    case FlowHasInlineChild: fprintf(stderr, "flow has inline child renderer"); break;
+    case FlowHasFloatingChild: fprintf(stderr, "flow has floating child renderer"); break;
+    case FlowHasUnsupportedFloat: fprintf(stderr, "flow has complicated floats"); break;
+    case FlowHasTextDecoration: fprintf(stderr, "text-decoration"); break;
+    case FlowHasJustifiedAlignment: fprintf(stderr, "text-align: justify"); break;
+    case FlowHasOverflowNotVisible: fprintf(stderr, "overflow is not visible"); break;
+    case FlowHasTextIndent: fprintf(stderr, "text-indent"); break;
+    case FlowHasWordOrLetterSpacing: fprintf(stderr, "word-spacing or letter-spacing"); break;
+    case FlowIsNotLTR: fprintf(stderr, "direction is not ltr"); break;
+    case FlowHasLineBoxContainProperty: fprintf(stderr, "-webkit-line-box-contain"); break;
+    case FlowIsNotTopToBottom: fprintf(stderr, "writing mode is not horizontal-tb"); break;
+    case FlowHasLineBreak: fprintf(stderr, "line-break"); break;
+    case FlowHasWordBreak: fprintf(stderr, "word-break"); break;
+    case FlowHasNonNormalUnicodeBiDi: fprintf(stderr, "unicode-bidi or -webkit-rtl-ordering"); break;
+    case FlowHasLineAlignEdges: fprintf(stderr, "-webkit-line-align or -webkit-line-snap"); break;
+    case FlowHasHyphensAuto: fprintf(stderr, "hyphens: auto"); break;
+    case FlowHasTextEmphasisFillOrMark: fprintf(stderr, "text-emphasis"); break;
+    case FlowHasTextShadow: fprintf(stderr, "text-shadow"); break;
+    case FlowHasPseudoFirstLine: fprintf(stderr, "::first-line"); break;
+    case FlowHasPseudoFirstLetter: fprintf(stderr, "::first-letter"); break;
+    case FlowHasTextCombine: fprintf(stderr, "text-combine"); break;
+    case FlowHasTextFillBox: fprintf(stderr, "background-clip: text"); break;
+    case FlowHasBorderFitLines: fprintf(stderr, "-webkit-border-fit"); break;
+    case FlowHasTrailingWord: fprintf(stderr, "-apple-trailing-word"); break;
+    case FlowHasTextOverflow: fprintf(stderr, "text-overflow"); break;
+    case FlowIsPaginated: fprintf(stderr, "flow is paginated"); break;
+    case FlowHasOutline: fprintf(stderr, "outline"); break;
+    case FlowIsRuby: fprintf(stderr, "ruby"); break;
+    case FlowIsDeprecatedFlexBox: fprintf(stderr, "parent is a deprecated flexbox"); break;
+    case FlowParentIsPlaceholderElement: fprintf(stderr, "placeholder element"); break;
+    case FlowParentIsTextAreaWithWrapping: fprintf(stderr, "<textarea wrap>"); break;
+    case FlowHasNoChild: fprintf(stderr, "flow has no child"); break;
+    case FlowPrimaryFontIsLoading: fprintf(stderr, "primary font is loading"); break;
+    case FlowFontIsSVGFont: fprintf(stderr, "SVG font"); break;
+    case FlowFontIsNotSimple: fprintf(stderr, "font needs the complex text code path"); break;
+    case FlowFontIsMissingGlyph: fprintf(stderr, "font is missing a glyph"); break;
+    case FlowTextIsEmpty: fprintf(stderr, "text is empty"); break;
+    case FlowTextIsRenderTextSubclass: fprintf(stderr, "text is a RenderText subclass"); break;
+    case FlowTextHasNoBreakSpace: fprintf(stderr, "text has a no-break space"); break;
+    case FlowTextHasSoftHyphen: fprintf(stderr, "text has a soft hyphen"); break;
+    case FlowTextHasDirectionCharacter: fprintf(stderr, "text has bidi characters"); break;
+    case FeatureIsDisabled: fprintf(stderr, "simple line layout is disabled"); break;
+    case EndOfReasons: break;
+    }
+}
+
+// Call from the debugger to see why blocks with inline content take the line box path.
+void printSimpleLineLayoutCoverage()
+{
+    const unsigned reasonCount = 64;
+    unsigned flowCountByReason[reasonCount] = { };
+    unsigned leafFlowCount = 0;
+    unsigned simpleFlowCount = 0;
+    for (auto* document : Document::allDocuments()) {
+        if (!document->renderView())
+            continue;
+        for (RenderObject* renderer = document->renderView(); renderer; renderer = renderer->nextInPreOrder()) {
+            if (!is<RenderBlockFlow>(*renderer))
+                continue;
+            auto& flow = downcast<RenderBlockFlow>(*renderer);
+            if (!flow.childrenInline() || !flow.firstChild())
+                continue;
+            ++leafFlowCount;
+            AvoidanceReasonFlags reasons = canUseForWithReason(flow, IncludeReasons::All);
+            if (!reasons) {
+                ++simpleFlowCount;
+                continue;
+            }
+            for (unsigned i = 0; i < reasonCount; ++i) {
+                if (reasons & (1LLU << i))
+                    ++flowCountByReason[i];
+            }
+        }
+    }
+
+    fprintf(stderr, "Simple line layout coverage: %u of %u blocks with inline content\n", simpleFlowCount, leafFlowCount);
+    for (unsigned i = 0; i < reasonCount; ++i) {
+        if (!flowCountByReason[i])
+            continue;
+        fprintf(stderr, "  %u blocks: ", flowCountByReason[i]);
+        printReason(static_cast<AvoidanceReason>(1LLU << i));
+        fprintf(stderr, "\n");
+    }
+}
+#endif
+
 static float computeLineLeft(ETextAlign textAlign, float availableWidth, float committedWidth, float logicalLeftOffset)
 {
     float remainingWidth = availableWidth - committedWidth;
@@ -40,7 +40,65 @@ class RenderBlockFlow;
 
 namespace SimpleLineLayout {
 
+// Why a block can't use the simple line layout path. Debug builds collect all of them to measure
+// coverage (see printSimpleLineLayoutCoverage()); release builds stop at the first one.
+enum AvoidanceReason : uint64_t {
+    FlowIsInsideRegion                    = 1LLU  << 0,
+    FlowHasNonSupportedChild              = 1LLU  << 1,
+    FlowHasInlineChild                    = 1LLU  << 2,
+    FlowHasFloatingChild                  = 1LLU  << 3,
+    FlowHasUnsupportedFloat               = 1LLU  << 4,
+    FlowHasTextDecoration                 = 1LLU  << 5,
+    FlowHasJustifiedAlignment             = 1LLU  << 6,
+    FlowHasOverflowNotVisible             = 1LLU  << 7,
+    FlowHasTextIndent                     = 1LLU  << 8,
+    FlowHasWordOrLetterSpacing            = 1LLU  << 9,
+    FlowIsNotLTR                          = 1LLU  << 10,
+    FlowHasLineBoxContainProperty         = 1LLU  << 11,
+    FlowIsNotTopToBottom                  = 1LLU  << 12,
+    FlowHasLineBreak                      = 1LLU  << 13,
+    FlowHasWordBreak                      = 1LLU  << 14,
+    FlowHasNonNormalUnicodeBiDi           = 1LLU  << 15,
+    FlowHasLineAlignEdges                 = 1LLU  << 16,
+    FlowHasHyphensAuto                    = 1LLU  << 17,
+    FlowHasTextEmphasisFillOrMark         = 1LLU  << 18,
+    FlowHasTextShadow                     = 1LLU  << 19,
+    FlowHasPseudoFirstLine                = 1LLU  << 20,
+    FlowHasPseudoFirstLetter              = 1LLU  << 21,
+    FlowHasTextCombine                    = 1LLU  << 22,
+    FlowHasTextFillBox                    = 1LLU  << 23,
+    FlowHasBorderFitLines                 = 1LLU  << 24,
+    FlowHasTrailingWord                   = 1LLU  << 25,
+    FlowHasTextOverflow                   = 1LLU  << 26,
+    FlowIsPaginated                       = 1LLU  << 27,
+    FlowHasOutline                        = 1LLU  << 28,
+    FlowIsRuby                            = 1LLU  << 29,
+    FlowIsDeprecatedFlexBox               = 1LLU  << 30,
+    FlowParentIsPlaceholderElement        = 1LLU  << 31,
+    FlowParentIsTextAreaWithWrapping      = 1LLU  << 32,
+    FlowHasNoChild                        = 1LLU  << 33,
+    FlowPrimaryFontIsLoading              = 1LLU  << 34,
+    FlowFontIsSVGFont                     = 1LLU  << 35,
+    FlowFontIsNotSimple                   = 1LLU  << 36,
+    FlowFontIsMissingGlyph                = 1LLU  << 37,
+    FlowTextIsEmpty                       = 1LLU  << 38,
+    FlowTextIsRenderTextSubclass          = 1LLU  << 39,
+    FlowTextHasNoBreakSpace               = 1LLU  << 40,
+    FlowTextHasSoftHyphen                 = 1LLU  << 41,
+    FlowTextHasDirectionCharacter         = 1LLU  << 42,
+    FeatureIsDisabled                     = 1LLU  << 43,
+    EndOfReasons                          = 1LLU  << 44
+};
+typedef uint64_t AvoidanceReasonFlags;
+
+enum class IncludeReasons { First , All };
+
 bool canUseFor(const RenderBlockFlow&);
+AvoidanceReasonFlags canUseForWithReason(const RenderBlockFlow&, IncludeReasons);
+
+#ifndef NDEBUG
+void printSimpleLineLayoutCoverage();
+#endif
 
 struct Run {
 #if COMPILER(MSVC)
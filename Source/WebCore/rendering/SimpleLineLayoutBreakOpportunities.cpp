@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "SimpleLineLayoutBreakOpportunities.h"
+
+#include "RenderText.h"
+#include "TextBreakIterator.h"
+#include "break_lines.h"
+#include <wtf/HashMap.h>
+#include <wtf/MainThread.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/WorkQueue.h>
+
+namespace WebCore {
+namespace SimpleLineLayout {
+
+struct BreakOpportunitiesEntry {
+    // The text the opportunities are (or are being) computed for. Only touched on the main thread.
+    RefPtr<StringImpl> text;
+    std::unique_ptr<BreakOpportunities> opportunities;
+};
+
+typedef HashMap<const RenderObject*, BreakOpportunitiesEntry> BreakOpportunitiesMap;
+
+static BreakOpportunitiesMap& breakOpportunitiesMap()
+{
+    static NeverDestroyed<BreakOpportunitiesMap> map;
+    return map;
+}
+
+static WorkQueue& lineBreakingQueue()
+{
+    static auto& queue = WorkQueue::create("org.webkit.LineBreaking", WorkQueue::Type::Serial, WorkQueue::QOS::UserInitiated).leakRef();
+    return queue;
+}
+
+struct BreakOpportunitiesTask {
+    // Only touched on the main thread.
+    const RenderText* renderer;
+    RefPtr<StringImpl> text;
+    AtomicString locale;
+
+    // Only touched on the line breaking queue until the task is handed back.
+    String isolatedText;
+    String isolatedLocale;
+    Vector<unsigned> positions;
+};
+
+template<typename CharacterType>
+static void computeBreakOpportunities(const CharacterType* characters, unsigned length, LazyLineBreakIterator& iterator, Vector<unsigned>& positions)
+{
+    for (unsigned position = 0; position < length; ) {
+        unsigned next = nextBreakablePositionNonLoosely<CharacterType, NBSPBehavior::IgnoreNBSP>(iterator, characters, length, position);
+        if (next >= length)
+            break;
+        positions.append(next);
+        position = next + 1;
+    }
+    positions.shrinkToFit();
+}
+
+void BreakOpportunities::textDidChange(const RenderText& renderer)
+{
+    ASSERT(isMainThread());
+    const String& text = renderer.text();
+    if (text.length() < minimumTextLength) {
+        rendererWillBeDestroyed(renderer);
+        return;
+    }
+
+    auto& entry = breakOpportunitiesMap().add(&renderer, BreakOpportunitiesEntry()).iterator->value;
+    entry.text = text.impl();
+    entry.opportunities = nullptr;
+
+    // Only isolated copies of the text and locale are handed to the queue.
+    auto* task = new BreakOpportunitiesTask { &renderer, text.impl(), renderer.style().locale(), text.isolatedCopy(), renderer.style().locale().string().isolatedCopy(), Vector<unsigned>() };
+
+    lineBreakingQueue().dispatch([task] {
+        LazyLineBreakIterator iterator(task->isolatedText, AtomicString(task->isolatedLocale));
+        unsigned length = task->isolatedText.length();
+        if (task->isolatedText.is8Bit())
+            computeBreakOpportunities(task->isolatedText.characters8(), length, iterator, task->positions);
+        else
+            computeBreakOpportunities(task->isolatedText.characters16(), length, iterator, task->positions);
+        iterator.resetStringAndReleaseIterator(String(), AtomicString(), LineBreakIteratorModeUAX14);
+        task->isolatedText = String();
+        task->isolatedLocale = String();
+
+        callOnMainThread([task] {
+            std::unique_ptr<BreakOpportunitiesTask> completedTask(task);
+            // The renderer may be gone, or its text may have changed again, while we were running.
+            auto it = breakOpportunitiesMap().find(completedTask->renderer);
+            if (it == breakOpportunitiesMap().end() || it->value.text != completedTask->text)
+                return;
+            it->value.opportunities = std::make_unique<BreakOpportunities>(completedTask->locale, WTF::move(completedTask->positions));
+        });
+    });
+}
+
+void BreakOpportunities::rendererWillBeDestroyed(const RenderText& renderer)
+{
+    breakOpportunitiesMap().remove(&renderer);
+}
+
+const BreakOpportunities* BreakOpportunities::find(const RenderObject& renderer, const String& text, const AtomicString& locale)
+{
+    auto& map = breakOpportunitiesMap();
+    if (map.isEmpty())
+        return nullptr;
+    auto it = map.find(&renderer);
+    if (it == map.end() || it->value.text != text.impl() || !it->value.opportunities)
+        return nullptr;
+    auto& opportunities = *it->value.opportunities;
+    if (opportunities.m_locale != locale)
+        return nullptr;
+    return &opportunities;
+}
+
+BreakOpportunities::BreakOpportunities(const AtomicString& locale, Vector<unsigned>&& positions)
+    : m_locale(locale)
+    , m_positions(WTF::move(positions))
+{
+}
+
+unsigned BreakOpportunities::nextBreakablePosition(unsigned position, unsigned textLength) const
+{
+    ASSERT(canUseAtPosition(position));
+    auto it = std::lower_bound(m_positions.begin(), m_positions.end(), position);
+    return it == m_positions.end() ? textLength : *it;
+}
+
+}
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef SimpleLineLayoutBreakOpportunities_h
+#define SimpleLineLayoutBreakOpportunities_h
+
+#include <wtf/Vector.h>
+#include <wtf/text/AtomicString.h>
+
+namespace WebCore {
+
+class RenderObject;
+class RenderText;
+
+namespace SimpleLineLayout {
+
+// The line break opportunities of a long RenderText, found on a background queue after its text changes, so
+// that laying out multi-megabyte preformatted text does not run the break iterator over all of it again.
+// Widths are still measured during layout since fonts can only be used on the main thread.
+class BreakOpportunities {
+    WTF_MAKE_NONCOPYABLE(BreakOpportunities); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static const unsigned minimumTextLength = 64 * 1024;
+
+    static void textDidChange(const RenderText&);
+    static void rendererWillBeDestroyed(const RenderText&);
+
+    // Returns null unless the opportunities for exactly this text and locale have arrived.
+    static const BreakOpportunities* find(const RenderObject&, const String& text, const AtomicString& locale);
+
+    BreakOpportunities(const AtomicString& locale, Vector<unsigned>&& positions);
+
+    // Same as nextBreakablePositionNonLoosely<CharacterType, NBSPBehavior::IgnoreNBSP>() for positions far
+    // enough into the text that the text preceding it in the flow does not matter.
+    static bool canUseAtPosition(unsigned position) { return position >= 2; }
+    unsigned nextBreakablePosition(unsigned position, unsigned textLength) const;
+
+private:
+    AtomicString m_locale;
+    Vector<unsigned> m_positions;
+};
+
+}
+}
+
+#endif
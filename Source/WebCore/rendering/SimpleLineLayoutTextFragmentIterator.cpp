@@ -28,6 +28,7 @@
 
 #include "RenderBlockFlow.h"
 #include "RenderChildIterator.h"
+#include "SimpleLineLayoutBreakOpportunities.h"
 #include "SimpleLineLayoutFlowContents.h"
 
 namespace WebCore {
@@ -113,6 +114,11 @@ template <typename CharacterType>
 unsigned TextFragmentIterator::nextBreakablePosition(const FlowContents::Segment& segment, unsigned startPosition)
 {
     ASSERT(startPosition < segment.end);
+    unsigned segmentPosition = startPosition - segment.start;
+    if (BreakOpportunities::canUseAtPosition(segmentPosition)) {
+        if (auto* opportunities = BreakOpportunities::find(segment.renderer, segment.text, m_style.locale))
+            return segment.start + opportunities->nextBreakablePosition(segmentPosition, segment.end - segment.start);
+    }
     if (segment.text.impl() != m_lineBreakIterator.string().impl()) {
         const String& currentText = m_lineBreakIterator.string();
         unsigned textLength = currentText.length();
@@ -123,7 +129,6 @@ unsigned TextFragmentIterator::nextBreakablePosition(const FlowContents::Segment
     }
     const auto* characters = segment.text.characters<CharacterType>();
     unsigned segmentLength = segment.end - segment.start;
-    unsigned segmentPosition = startPosition - segment.start;
     return segment.start + nextBreakablePositionNonLoosely<CharacterType, NBSPBehavior::IgnoreNBSP>(m_lineBreakIterator, characters, segmentLength, segmentPosition);
 }
 
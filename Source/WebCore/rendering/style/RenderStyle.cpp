@@ -38,6 +38,7 @@
 #include "ScaleTransformOperation.h"
 #include "ShadowData.h"
 #include "StyleImage.h"
+#include "StyleDataInterner.h"
 #include "StyleInheritedData.h"
 #include "StyleResolver.h"
 #include "StyleScrollSnapPoints.h"
@@ -275,6 +276,21 @@ void RenderStyle::copyNonInheritedFrom(const RenderStyle* other)
     ASSERT(zoom() == initialZoom());
 }
 
+void RenderStyle::shareRareDataWithEquivalentStyles()
+{
+    // The initial groups are already shared by every style that doesn't set a rare property.
+    if (rareNonInheritedData.get() != defaultStyle().rareNonInheritedData.get())
+        StyleDataInterner<StyleRareNonInheritedData>::singleton().intern(rareNonInheritedData);
+    if (rareInheritedData.get() != defaultStyle().rareInheritedData.get())
+        StyleDataInterner<StyleRareInheritedData>::singleton().intern(rareInheritedData);
+}
+
+void RenderStyle::clearSharedRareData()
+{
+    StyleDataInterner<StyleRareNonInheritedData>::singleton().clear();
+    StyleDataInterner<StyleRareInheritedData>::singleton().clear();
+}
+
 bool RenderStyle::operator==(const RenderStyle& o) const
 {
     // compare everything except the pseudoStyle pointer
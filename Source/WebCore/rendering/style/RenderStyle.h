@@ -506,6 +506,10 @@ public:
     void inheritFrom(const RenderStyle* inheritParent, IsAtShadowBoundary = NotAtShadowBoundary);
     void copyNonInheritedFrom(const RenderStyle*);
 
+    // Replaces the rare data groups with equal ones already used by other styles in the process, if any.
+    void shareRareDataWithEquivalentStyles();
+    static void clearSharedRareData();
+
     PseudoId styleType() const { return noninherited_flags.styleType(); }
     void setStyleType(PseudoId styleType) { noninherited_flags.setStyleType(styleType); }
 
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef StyleDataInterner_h
+#define StyleDataInterner_h
+
+#include "DataRef.h"
+#include <wtf/HashMap.h>
+#include <wtf/NeverDestroyed.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+// A process-wide table of RenderStyle data groups, used to make equal groups computed for different
+// elements (or in different documents) share one copy. The table holds a reference to every entry,
+// so DataRef::access() always copies an interned group before it is modified. Entries nobody else
+// refers to are swept periodically, and the table stops growing at maximumSize entries.
+// T must provide operator== and a hashForSharing() that is consistent with it.
+template<typename T> class StyleDataInterner {
+    WTF_MAKE_NONCOPYABLE(StyleDataInterner); WTF_MAKE_FAST_ALLOCATED;
+public:
+    static StyleDataInterner& singleton()
+    {
+        static NeverDestroyed<StyleDataInterner> interner;
+        return interner;
+    }
+
+    void intern(DataRef<T>&);
+    void clear();
+
+private:
+    friend class NeverDestroyed<StyleDataInterner>;
+    StyleDataInterner() { }
+
+    void sweep();
+
+    static const unsigned maximumSize = 2048;
+    static const unsigned additionsBetweenSweeps = 256;
+
+    HashMap<unsigned, Vector<Ref<T>, 1>> m_entries;
+    unsigned m_size { 0 };
+    unsigned m_additionsSinceLastSweep { 0 };
+};
+
+template<typename T> void StyleDataInterner<T>::intern(DataRef<T>& data)
+{
+    unsigned hash = data->hashForSharing();
+
+    auto it = m_entries.find(hash);
+    if (it != m_entries.end()) {
+        for (auto& entry : it->value) {
+            if (entry.ptr() == data.get())
+                return;
+            if (entry.get() == *data) {
+                data = DataRef<T>(entry.copyRef());
+                return;
+            }
+        }
+    }
+
+    if (++m_additionsSinceLastSweep >= additionsBetweenSweeps || m_size >= maximumSize)
+        sweep();
+    if (m_size >= maximumSize)
+        return;
+
+    m_entries.add(hash, Vector<Ref<T>, 1>()).iterator->value.append(const_cast<T&>(*data));
+    ++m_size;
+}
+
+template<typename T> void StyleDataInterner<T>::sweep()
+{
+    // Remove the entries only the table refers to.
+    Vector<unsigned, 16> emptyBuckets;
+    for (auto& bucket : m_entries) {
+        m_size -= bucket.value.removeAllMatching([] (const Ref<T>& entry) {
+            return entry->hasOneRef();
+        });
+        if (bucket.value.isEmpty())
+            emptyBuckets.append(bucket.key);
+    }
+    for (auto key : emptyBuckets)
+        m_entries.remove(key);
+
+    m_additionsSinceLastSweep = 0;
+}
+
+template<typename T> void StyleDataInterner<T>::clear()
+{
+    m_entries.clear();
+    m_size = 0;
+    m_additionsSinceLastSweep = 0;
+}
+
+} // namespace WebCore
+
+#endif // StyleDataInterner_h
@@ -30,7 +30,9 @@
 #include "ShadowData.h"
 #include "StyleCustomPropertyData.h"
 #include "StyleImage.h"
+#include <wtf/Hasher.h>
 #include <wtf/PointerComparison.h>
+#include <wtf/StdLibExtras.h>
 
 namespace WebCore {
 
@@ -317,4 +319,19 @@ bool StyleRareInheritedData::operator==(const StyleRareInheritedData& o) const
         && arePointingToEqualData(listStyleImage, o.listStyleImage);
 }
 
+unsigned StyleRareInheritedData::hashForSharing() const
+{
+    // Only a few cheap members are hashed; operator== compares the rest.
+    unsigned hashCodes[] = {
+        textStrokeColor.rgb(),
+        bitwise_cast<unsigned>(textStrokeWidth),
+        textFillColor.rgb(),
+        textEmphasisColor.rgb(),
+        bitwise_cast<unsigned>(m_effectiveZoom),
+        static_cast<unsigned>(widows),
+        static_cast<unsigned>(orphans),
+    };
+    return StringHasher::hashMemory<sizeof(hashCodes)>(hashCodes);
+}
+
 } // namespace WebCore
@@ -59,6 +59,9 @@ public:
         return !(*this == o);
     }
 
+    // Consistent with operator==, for StyleDataInterner.
+    unsigned hashForSharing() const;
+
     RefPtr<StyleImage> listStyleImage;
 
     Color textStrokeColor;
@@ -31,8 +31,10 @@
 #include "StyleImage.h"
 #include "StyleResolver.h"
 #include "StyleScrollSnapPoints.h"
+#include <wtf/Hasher.h>
 #include <wtf/PointerComparison.h>
 #include <wtf/RefPtr.h>
+#include <wtf/StdLibExtras.h>
 
 namespace WebCore {
 
@@ -242,6 +244,7 @@ bool StyleRareNonInheritedData::operator==(const StyleRareNonInheritedData& o) c
 #endif
         && contentDataEquivalent(o)
         && arePointingToEqualData(m_counterDirectives, o.m_counterDirectives)
+        && m_altText == o.m_altText
         && arePointingToEqualData(m_boxShadow, o.m_boxShadow)
         && arePointingToEqualData(m_willChange, o.m_willChange)
         && arePointingToEqualData(m_boxReflect, o.m_boxReflect)
@@ -303,6 +306,20 @@ bool StyleRareNonInheritedData::operator==(const StyleRareNonInheritedData& o) c
         && m_objectFit == o.m_objectFit;
 }
 
+unsigned StyleRareNonInheritedData::hashForSharing() const
+{
+    // Only a few cheap members are hashed; operator== compares the rest.
+    unsigned hashCodes[] = {
+        bitwise_cast<unsigned>(opacity),
+        bitwise_cast<unsigned>(m_perspective),
+        static_cast<unsigned>(m_order),
+        m_textDecorationColor.rgb(),
+        m_appearance,
+        m_objectFit,
+    };
+    return StringHasher::hashMemory<sizeof(hashCodes)>(hashCodes);
+}
+
 bool StyleRareNonInheritedData::contentDataEquivalent(const StyleRareNonInheritedData& o) const
 {
     ContentData* a = m_content.get();
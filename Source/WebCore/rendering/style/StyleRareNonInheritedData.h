@@ -91,6 +91,9 @@ public:
     bool operator==(const StyleRareNonInheritedData&) const;
     bool operator!=(const StyleRareNonInheritedData& o) const { return !(*this == o); }
 
+    // Consistent with operator==, for StyleDataInterner.
+    unsigned hashForSharing() const;
+
     bool contentDataEquivalent(const StyleRareNonInheritedData&) const;
 
     bool hasFilters() const;
@@ -83,7 +83,7 @@ static void updatePathFromLineElement(SVGElement* element, Path& path)
 
 static void updatePathFromPathElement(SVGElement* element, Path& path)
 {
-    buildPathFromByteStream(downcast<SVGPathElement>(element)->pathByteStream(), path);
+    path = downcast<SVGPathElement>(element)->path();
 }
 
 static void updatePathFromPolygonElement(SVGElement* element, Path& path)
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "ClassChangeInvalidation.h"
+
+#include "Document.h"
+#include "Element.h"
+#include "Logging.h"
+#include "SpaceSplitString.h"
+#include "StyleInvalidationAnalysis.h"
+#include "StyleResolver.h"
+#include <wtf/BitVector.h>
+
+namespace WebCore {
+namespace Style {
+
+typedef Vector<AtomicStringImpl*, 4> ClassChangeVector;
+
+static ClassChangeVector computeClassChange(const SpaceSplitString& oldClasses, const SpaceSplitString& newClasses)
+{
+    unsigned oldSize = oldClasses.size();
+    unsigned newSize = newClasses.size();
+
+    ClassChangeVector changedClasses;
+    BitVector remainingClassBits;
+    remainingClassBits.ensureSize(oldSize);
+    // Class vectors tend to be very short. This is faster than using a hash table.
+    for (unsigned i = 0; i < newSize; ++i) {
+        bool foundFromBoth = false;
+        for (unsigned j = 0; j < oldSize; ++j) {
+            if (newClasses[i] == oldClasses[j]) {
+                remainingClassBits.quickSet(j);
+                foundFromBoth = true;
+            }
+        }
+        if (!foundFromBoth)
+            changedClasses.append(newClasses[i].impl());
+    }
+    for (unsigned i = 0; i < oldSize; ++i) {
+        // If the bit is not set the corresponding class has been removed.
+        if (!remainingClassBits.quickGet(i))
+            changedClasses.append(oldClasses[i].impl());
+    }
+    return changedClasses;
+}
+
+ClassChangeInvalidation::ClassChangeInvalidation(Element& element, const SpaceSplitString& oldClasses, const SpaceSplitString& newClasses)
+    : m_element(element)
+{
+    if (!element.inRenderedDocument() || !element.document().styleResolverIfExists())
+        return;
+    if (element.styleChangeType() >= FullStyleChange)
+        return;
+    computeInvalidation(oldClasses, newClasses);
+    invalidateDescendantStyle();
+}
+
+ClassChangeInvalidation::~ClassChangeInvalidation()
+{
+    if (!m_descendantInvalidation)
+        return;
+    invalidateDescendantStyle();
+
+    LOG(StyleInvalidation, "Class change on element %p invalidated %u descendants", &m_element, m_descendantInvalidation->invalidatedElementCount());
+}
+
+void ClassChangeInvalidation::computeInvalidation(const SpaceSplitString& oldClasses, const SpaceSplitString& newClasses)
+{
+    auto& features = m_element.document().styleResolverIfExists()->ruleSets().features();
+
+    bool mayAffectStyle = false;
+    Vector<RuleFeature> descendantRules;
+    for (auto* changedClass : computeClassChange(oldClasses, newClasses)) {
+        if (!features.classesInRules.contains(changedClass))
+            continue;
+        // Shadow trees are styled by their own resolvers, which the rule features here don't describe.
+        if (features.classesRequiringSubtreeInvalidation.contains(changedClass) || m_element.shadowRoot() || m_element.isInShadowTree()) {
+            LOG(StyleInvalidation, "Class change on element %p invalidated its subtree", &m_element);
+            m_element.setNeedsStyleRecalc();
+            return;
+        }
+        mayAffectStyle = true;
+        if (auto* rules = features.ancestorClassRules.get(changedClass))
+            descendantRules.appendVector(*rules);
+    }
+    if (!mayAffectStyle)
+        return;
+
+    m_element.setNeedsStyleRecalc(InlineStyleChange);
+
+    if (!descendantRules.isEmpty())
+        m_descendantInvalidation = std::make_unique<StyleInvalidationAnalysis>(descendantRules);
+}
+
+void ClassChangeInvalidation::invalidateDescendantStyle()
+{
+    if (!m_descendantInvalidation)
+        return;
+    m_descendantInvalidation->invalidateDescendantStyle(m_element);
+}
+
+}
+}
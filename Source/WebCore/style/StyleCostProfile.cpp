@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "StyleCostProfile.h"
+
+#include "Element.h"
+#include "StyleRule.h"
+#include <algorithm>
+
+namespace WebCore {
+namespace Style {
+
+void CostProfile::didMatchRule(const StyleRule& rule, bool matched)
+{
+    RuleCost& cost = m_ruleCosts.add(const_cast<StyleRule*>(&rule), RuleCost()).iterator->value;
+    ++cost.matchAttempts;
+    if (matched)
+        ++cost.matches;
+}
+
+void CostProfile::didTimeRuleMatch(const StyleRule& rule, double seconds)
+{
+    auto it = m_ruleCosts.find(const_cast<StyleRule*>(&rule));
+    ASSERT(it != m_ruleCosts.end());
+    ++it->value.timedMatchAttempts;
+    it->value.timedMatchSeconds += seconds;
+}
+
+void CostProfile::didResolveElement(Element& element)
+{
+    ++m_elementResolveCounts.add(&element, 0).iterator->value;
+    ++m_resolvedElementCount;
+}
+
+Vector<std::pair<RefPtr<StyleRule>, CostProfile::RuleCost>> CostProfile::costliestRules(unsigned maximumCount) const
+{
+    Vector<std::pair<RefPtr<StyleRule>, RuleCost>> rules;
+    rules.reserveInitialCapacity(m_ruleCosts.size());
+    for (auto& entry : m_ruleCosts)
+        rules.uncheckedAppend(std::make_pair(entry.key, entry.value));
+
+    std::sort(rules.begin(), rules.end(), [] (const std::pair<RefPtr<StyleRule>, RuleCost>& a, const std::pair<RefPtr<StyleRule>, RuleCost>& b) {
+        double aSeconds = a.second.estimatedMatchSeconds();
+        double bSeconds = b.second.estimatedMatchSeconds();
+        if (aSeconds != bSeconds)
+            return aSeconds > bSeconds;
+        return a.second.matchAttempts > b.second.matchAttempts;
+    });
+    if (rules.size() > maximumCount)
+        rules.shrink(maximumCount);
+    return rules;
+}
+
+Vector<std::pair<RefPtr<Element>, unsigned>> CostProfile::mostResolvedElements(unsigned maximumCount) const
+{
+    Vector<std::pair<RefPtr<Element>, unsigned>> elements;
+    elements.reserveInitialCapacity(m_elementResolveCounts.size());
+    for (auto& entry : m_elementResolveCounts)
+        elements.uncheckedAppend(std::make_pair(entry.key, entry.value));
+
+    std::sort(elements.begin(), elements.end(), [] (const std::pair<RefPtr<Element>, unsigned>& a, const std::pair<RefPtr<Element>, unsigned>& b) {
+        return a.second > b.second;
+    });
+    if (elements.size() > maximumCount)
+        elements.shrink(maximumCount);
+    return elements;
+}
+
+}
+}
@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef StyleCostProfile_h
+#define StyleCostProfile_h
+
+#include <wtf/HashMap.h>
+#include <wtf/RefPtr.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+
+class Element;
+class StyleRule;
+
+namespace Style {
+
+// Attributes the cost of a style recalc to the rules that were tried and the elements that were
+// resolved. A Document only has one while the Web Inspector timeline is recording, so the style
+// code only pays a null check otherwise. Timing every selector match would cost more than most
+// matches do, so only one attempt in timeSampleInterval is timed and the total is extrapolated.
+class CostProfile {
+    WTF_MAKE_NONCOPYABLE(CostProfile); WTF_MAKE_FAST_ALLOCATED;
+public:
+    CostProfile() { }
+
+    struct RuleCost {
+        unsigned matchAttempts { 0 };
+        unsigned matches { 0 };
+        unsigned timedMatchAttempts { 0 };
+        double timedMatchSeconds { 0 };
+
+        double estimatedMatchSeconds() const { return timedMatchAttempts ? timedMatchSeconds * matchAttempts / timedMatchAttempts : 0; }
+    };
+
+    bool shouldTimeNextRuleMatch() { return !(m_ruleMatchAttemptCount++ % timeSampleInterval); }
+    void didMatchRule(const StyleRule&, bool matched);
+    void didTimeRuleMatch(const StyleRule&, double seconds);
+
+    void didResolveElement(Element&);
+
+    Vector<std::pair<RefPtr<StyleRule>, RuleCost>> costliestRules(unsigned maximumCount) const;
+    Vector<std::pair<RefPtr<Element>, unsigned>> mostResolvedElements(unsigned maximumCount) const;
+    unsigned resolvedElementCount() const { return m_resolvedElementCount; }
+
+private:
+    static const unsigned timeSampleInterval = 16;
+
+    HashMap<RefPtr<StyleRule>, RuleCost> m_ruleCosts;
+    HashMap<RefPtr<Element>, unsigned> m_elementResolveCounts;
+    unsigned m_ruleMatchAttemptCount { 0 };
+    unsigned m_resolvedElementCount { 0 };
+};
+
+}
+}
+
+#endif
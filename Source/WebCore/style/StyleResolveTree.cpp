@@ -906,6 +906,11 @@ void resolveTree(Document& document, Change change)
     renderView.setUsesFirstLineRules(renderView.usesFirstLineRules() || styleResolved.usesFirstLineRules());
     renderView.setUsesFirstLetterRules(renderView.usesFirstLetterRules() || styleResolved.usesFirstLetterRules());
 
+    // FIXME: Sibling subtrees are independent as far as inheritance goes, but they can't be resolved
+    // concurrently yet. Computing a style is interleaved with building the render tree, selector
+    // matching records affectedBy flags on the elements it visits, StyleResolver keeps its per-element
+    // State and SelectorFilter in one shared instance, and RenderStyle, CSSValue and AtomicString are
+    // not thread-safe. Each of these needs to be split out before subtrees can go to worker threads.
     RenderTreePosition renderTreePosition(renderView);
     resolveTree(*documentElement, *document.renderStyle(), renderTreePosition, change);
 
@@ -222,6 +222,7 @@ bool SVGPathElement::isSupportedAttribute(const QualifiedName& attrName)
 void SVGPathElement::parseAttribute(const QualifiedName& name, const AtomicString& value)
 {
     if (name == SVGNames::dAttr) {
+        invalidateCachedPath();
         if (!buildSVGPathByteStreamFromString(value, m_pathByteStream, UnalteredParsing))
             document().accessSVGExtensions().reportError("Problem parsing d=\"" + value + "\"");
         return;
@@ -304,6 +305,24 @@ const SVGPathByteStream& SVGPathElement::pathByteStream() const
     return *animatedPathByteStream;
 }
 
+Path SVGPathElement::path() const
+{
+    const SVGPathByteStream& byteStream = pathByteStream();
+
+    // Animated values change on every frame, so only the base value is cached.
+    if (&byteStream != &m_pathByteStream) {
+        Path path;
+        buildPathFromByteStream(byteStream, path);
+        return path;
+    }
+
+    if (!m_cachedPath) {
+        m_cachedPath = std::make_unique<Path>();
+        buildPathFromByteStream(m_pathByteStream, *m_cachedPath);
+    }
+    return *m_cachedPath;
+}
+
 Ref<SVGAnimatedProperty> SVGPathElement::lookupOrCreateDWrapper(SVGElement* contextElement)
 {
     ASSERT(contextElement);
@@ -360,6 +379,7 @@ void SVGPathElement::pathSegListChanged(SVGPathSegRole role, ListModification li
         // FIXME: https://bugs.webkit.org/show_bug.cgi?id=15412 - Implement normalized path segment lists!
         break;
     case PathSegUnalteredRole:
+        invalidateCachedPath();
         if (listModification == ListModificationAppend) {
             ASSERT(!m_pathSegList.value.isEmpty());
             appendSVGPathByteStreamFromSVGPathSeg(m_pathSegList.value.last().copyRef(), m_pathByteStream, UnalteredParsing);
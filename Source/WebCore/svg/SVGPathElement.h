@@ -25,6 +25,7 @@
 #include "SVGAnimatedNumber.h"
 #include "SVGExternalResourcesRequired.h"
 #include "SVGGraphicsElement.h"
+#include "Path.h"
 #include "SVGNames.h"
 #include "SVGPathByteStream.h"
 #include "SVGPathSegList.h"
@@ -89,6 +90,10 @@ public:
 
     const SVGPathByteStream& pathByteStream() const;
 
+    // The Path built from pathByteStream(). The one for the base value is kept until 'd' changes,
+    // so that relayouts and style changes don't parse the byte stream again.
+    Path path() const;
+
     void pathSegListChanged(SVGPathSegRole, ListModification = ListModificationUnknown);
 
     virtual FloatRect getBBox(StyleUpdateStrategy = AllowStyleUpdate) override;
@@ -122,9 +127,11 @@ private:
     virtual void removedFrom(ContainerNode&) override;
 
     void invalidateMPathDependencies();
+    void invalidateCachedPath() { m_cachedPath = nullptr; }
 
 private:
     SVGPathByteStream m_pathByteStream;
+    mutable std::unique_ptr<Path> m_cachedPath;
     mutable SVGSynchronizableAnimatedProperty<SVGPathSegList> m_pathSegList;
     bool m_isAnimValObserved;
 };
@@ -84,6 +84,7 @@
 #include "MicroTask.h"
 #include "MicroTaskTest.h"
 #include "MockPageOverlayClient.h"
+#include "MutationObserver.h"
 #include "Page.h"
 #include "PageCache.h"
 #include "PageOverlay.h"
@@ -1783,6 +1784,24 @@ unsigned Internals::numberOfLiveDocuments() const
     return Document::allDocuments().size();
 }
 
+unsigned long long Internals::numberOfMutationRecordsCreated() const
+{
+    return MutationObserver::createdRecordCount();
+}
+
+unsigned long long Internals::numberOfMutationRecordsDelivered() const
+{
+    return MutationObserver::deliveredRecordCount();
+}
+
+unsigned long long Internals::elementDataBytesSavedBySharing() const
+{
+    Document* document = contextDocument();
+    if (!document)
+        return 0;
+    return document->elementDataBytesSavedBySharing();
+}
+
 RefPtr<DOMWindow> Internals::openDummyInspectorFrontend(const String& url)
 {
     Page* inspectedPage = contextDocument()->frame()->page();
@@ -260,6 +260,9 @@ public:
 
     unsigned numberOfLiveNodes() const;
     unsigned numberOfLiveDocuments() const;
+    unsigned long long numberOfMutationRecordsCreated() const;
+    unsigned long long numberOfMutationRecordsDelivered() const;
+    unsigned long long elementDataBytesSavedBySharing() const;
 
     RefPtr<DOMWindow> openDummyInspectorFrontend(const String& url);
     void closeDummyInspectorFrontend();
@@ -67,7 +67,7 @@ namespace WebCore {
 WorkerGlobalScope::WorkerGlobalScope(const URL& url, const String& userAgent, WorkerThread& thread, PassRefPtr<SecurityOrigin> topOrigin)
     : m_url(url)
     , m_userAgent(userAgent)
-    , m_script(std::make_unique<WorkerScriptController>(this))
+    , m_script(std::make_unique<WorkerScriptController>(this, thread.takePrewarmedVM()))
     , m_thread(thread)
     , m_workerInspectorController(std::make_unique<WorkerInspectorController>(*this))
     , m_closing(false)
@@ -38,6 +38,7 @@
 #include "EventNames.h"
 #include "ExceptionCode.h"
 #include "InspectorInstrumentation.h"
+#include "Logging.h"
 #include "MessageEvent.h"
 #include "PageGroup.h"
 #include "ScriptExecutionContext.h"
@@ -47,6 +48,7 @@
 #include <inspector/InspectorAgentBase.h>
 #include <inspector/ScriptCallStack.h>
 #include <runtime/ConsoleTypes.h>
+#include <wtf/CurrentTime.h>
 #include <wtf/MainThread.h>
 
 namespace WebCore {
@@ -64,6 +66,7 @@ WorkerMessagingProxy::WorkerMessagingProxy(Worker* workerObject)
     , m_workerThreadHadPendingActivity(false)
     , m_askedToTerminate(false)
     , m_pageInspector(nullptr)
+    , m_startTime(0)
 {
     ASSERT(m_workerObject);
     ASSERT((is<Document>(*m_scriptExecutionContext) && isMainThread())
@@ -84,6 +87,7 @@ void WorkerMessagingProxy::startWorkerGlobalScope(const URL& scriptURL, const St
     Document& document = downcast<Document>(*m_scriptExecutionContext);
     RefPtr<DedicatedWorkerThread> thread = DedicatedWorkerThread::create(scriptURL, userAgent, sourceCode, *this, *this, startMode, document.contentSecurityPolicy()->deprecatedHeader(), document.contentSecurityPolicy()->deprecatedHeaderType(), document.topOrigin());
     workerThreadCreated(thread);
+    m_startTime = monotonicallyIncreasingTime();
     thread->start();
     InspectorInstrumentation::didStartWorkerGlobalScope(m_scriptExecutionContext.get(), this, scriptURL);
 }
@@ -96,6 +100,11 @@ void WorkerMessagingProxy::postMessageToWorkerObject(PassRefPtr<SerializedScript
         if (!workerObject || askedToTerminate())
             return;
 
+        if (m_startTime) {
+            LOG(Threading, "Worker %p delivered its first message %.2fms after it was started", workerObject, (monotonicallyIncreasingTime() - m_startTime) * 1000);
+            m_startTime = 0;
+        }
+
         std::unique_ptr<MessagePortArray> ports = MessagePort::entanglePorts(context, std::unique_ptr<MessagePortChannelArray>(channelsPtr));
         workerObject->dispatchEvent(MessageEvent::create(WTF::move(ports), message));
     });
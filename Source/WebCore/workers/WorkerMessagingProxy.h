@@ -110,6 +110,8 @@ namespace WebCore {
 
         Vector<std::unique_ptr<ScriptExecutionContext::Task>> m_queuedEarlyTasks; // Tasks are queued here until there's a thread object created.
         WorkerGlobalScopeProxy::PageInspector* m_pageInspector;
+
+        double m_startTime; // Cleared once the first message from the worker is delivered.
     };
 
 } // namespace WebCore
@@ -34,7 +34,11 @@
 #include "SecurityOrigin.h"
 #include "ThreadGlobalData.h"
 #include "URL.h"
+#include <runtime/JSLock.h>
+#include <runtime/VM.h>
 #include <utility>
+#include <wtf/Condition.h>
+#include <wtf/CurrentTime.h>
 #include <wtf/Lock.h>
 #include <wtf/NeverDestroyed.h>
 #include <wtf/Noncopyable.h>
@@ -56,6 +60,26 @@ static HashSet<WorkerThread*>& workerThreads()
     return workerThreads;
 }
 
+// Threads that finished running a worker wait here, with a VM already created, so that the next
+// worker skips thread and VM creation. Each worker still gets a VM of its own.
+static const unsigned maximumIdleWorkerThreadCount = 4;
+static const double idleWorkerThreadTimeout = 30;
+
+struct IdleWorkerThread {
+    ThreadIdentifier threadID;
+    WorkerThread* workerThread;
+};
+
+static StaticLock idleWorkerThreadsMutex;
+static StaticCondition idleWorkerThreadsCondition;
+
+static Vector<IdleWorkerThread*>& idleWorkerThreads()
+{
+    static NeverDestroyed<Vector<IdleWorkerThread*>> idleWorkerThreads;
+
+    return idleWorkerThreads;
+}
+
 unsigned WorkerThread::workerThreadCount()
 {
     std::lock_guard<StaticLock> lock(threadSetMutex);
@@ -118,6 +142,17 @@ bool WorkerThread::start()
     if (m_threadID)
         return true;
 
+    {
+        std::lock_guard<StaticLock> lock(idleWorkerThreadsMutex);
+        if (!idleWorkerThreads().isEmpty()) {
+            IdleWorkerThread* idleThread = idleWorkerThreads().takeLast();
+            idleThread->workerThread = this;
+            m_threadID = idleThread->threadID;
+            idleWorkerThreadsCondition.notifyAll();
+            return true;
+        }
+    }
+
     m_threadID = createThread(WorkerThread::workerThreadStart, this, "WebCore: Worker");
 
     return m_threadID;
@@ -125,7 +160,54 @@ bool WorkerThread::start()
 
 void WorkerThread::workerThreadStart(void* thread)
 {
-    static_cast<WorkerThread*>(thread)->workerThread();
+    for (auto* workerThread = static_cast<WorkerThread*>(thread); workerThread; workerThread = waitForNextWorkerThread())
+        workerThread->workerThread();
+
+    // Clean up WebCore::ThreadGlobalData before WTF::WTFThreadData goes away!
+    threadGlobalData().destroy();
+
+    detachThread(currentThread());
+}
+
+WorkerThread* WorkerThread::waitForNextWorkerThread()
+{
+    {
+        std::lock_guard<StaticLock> lock(idleWorkerThreadsMutex);
+        if (idleWorkerThreads().size() >= maximumIdleWorkerThreadCount)
+            return nullptr;
+    }
+
+    RefPtr<JSC::VM> vm = JSC::VM::create();
+
+    IdleWorkerThread idleThread { currentThread(), nullptr };
+    {
+        std::unique_lock<StaticLock> lock(idleWorkerThreadsMutex);
+        idleWorkerThreads().append(&idleThread);
+
+        double deadline = monotonicallyIncreasingTime() + idleWorkerThreadTimeout;
+        while (!idleThread.workerThread) {
+            if (!idleWorkerThreadsCondition.waitUntilMonotonicClockSeconds(lock, deadline))
+                break;
+        }
+
+        if (!idleThread.workerThread)
+            idleWorkerThreads().removeFirst(&idleThread);
+    }
+
+    if (idleThread.workerThread) {
+        // Only this thread touches the prewarmed VM, from createWorkerGlobalScope().
+        idleThread.workerThread->m_prewarmedVM = WTF::move(vm);
+        return idleThread.workerThread;
+    }
+
+    JSC::JSLockHolder lock(*vm);
+    vm = nullptr;
+    return nullptr;
+}
+
+RefPtr<JSC::VM> WorkerThread::takePrewarmedVM()
+{
+    return WTF::move(m_prewarmedVM);
 }
 
 void WorkerThread::workerThread()
@@ -156,19 +238,13 @@ void WorkerThread::workerThread()
 
     runEventLoop();
 
-    ThreadIdentifier threadID = m_threadID;
-
     ASSERT(m_workerGlobalScope->hasOneRef());
 
     // The below assignment will destroy the context, which will in turn notify messaging proxy.
     // We cannot let any objects survive past thread exit, because no other thread will run GC or otherwise destroy them.
     m_workerGlobalScope = nullptr;
 
-    // Clean up WebCore::ThreadGlobalData before WTF::WTFThreadData goes away!
-    threadGlobalData().destroy();
-
     // The thread object may be already destroyed from notification now, don't try to access "this".
-    detachThread(threadID);
 }
 
 void WorkerThread::runEventLoop()
@@ -33,6 +33,11 @@
 #include <wtf/Forward.h>
 #include <wtf/PassRefPtr.h>
 #include <wtf/RefCounted.h>
+#include <wtf/RefPtr.h>
+
+namespace JSC {
+class VM;
+}
 
 namespace WebCore {
 
@@ -58,6 +63,9 @@ namespace WebCore {
         WorkerLoaderProxy& workerLoaderProxy() const { return m_workerLoaderProxy; }
         WorkerReportingProxy& workerReportingProxy() const { return m_workerReportingProxy; }
 
+        // The VM created by a pooled thread while it was waiting for a worker to run, if any.
+        RefPtr<JSC::VM> takePrewarmedVM();
+
         // Number of active worker threads.
         WEBCORE_EXPORT static unsigned workerThreadCount();
         static void releaseFastMallocFreeMemoryInAllThreads();
@@ -83,6 +91,10 @@ namespace WebCore {
         static void workerThreadStart(void*);
         void workerThread();
 
+        // Called on a thread that finished running a worker. Returns the next worker to run on it,
+        // or null if the thread should exit.
+        static WorkerThread* waitForNextWorkerThread();
+
         ThreadIdentifier m_threadID;
         WorkerRunLoop m_runLoop;
         WorkerLoaderProxy& m_workerLoaderProxy;
@@ -92,6 +104,7 @@ namespace WebCore {
         Lock m_threadCreationMutex;
 
         std::unique_ptr<WorkerThreadStartupData> m_startupData;
+        RefPtr<JSC::VM> m_prewarmedVM;
 
 #if ENABLE(NOTIFICATIONS) || ENABLE(LEGACY_NOTIFICATIONS)
         NotificationClient* m_notificationClient;
@@ -67,7 +67,7 @@ void StorageThread::threadEntryPoint()
 {
     ASSERT(!isMainThread());
 
-    while (auto function = m_queue.waitForMessage()) {
+    while (auto function = m_queue.dequeue()) {
         AutodrainedPool pool;
         (*function)();
     }
@@ -77,7 +77,7 @@ void StorageThread::dispatch(const std::function<void ()>& function)
 {
     ASSERT(isMainThread());
     ASSERT(!m_queue.killed() && m_threadID);
-    m_queue.append(std::make_unique<std::function<void ()>>(function));
+    m_queue.enqueue(function);
 }
 
 void StorageThread::terminate()
@@ -89,7 +89,7 @@ void StorageThread::terminate()
     if (!m_threadID)
         return;
 
-    m_queue.append(std::make_unique<std::function<void ()>>([this] {
+    m_queue.enqueue(std::function<void ()>([this] {
         performTerminate();
     }));
     waitForThreadCompletion(m_threadID);
@@ -28,7 +28,7 @@
 
 #include <functional>
 #include <wtf/HashSet.h>
-#include <wtf/MessageQueue.h>
+#include <wtf/LockFreeQueue.h>
 #include <wtf/PassRefPtr.h>
 #include <wtf/Threading.h>
 
@@ -59,7 +59,7 @@ private:
     void performTerminate();
 
     ThreadIdentifier m_threadID;
-    MessageQueue<std::function<void()>> m_queue;
+    MPSCQueue<std::function<void()>> m_queue;
 };
 
 } // namespace WebCore
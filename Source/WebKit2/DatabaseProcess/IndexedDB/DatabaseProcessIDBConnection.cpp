@@ -343,18 +343,26 @@ void DatabaseProcessIDBConnection::cursorAdvance(uint64_t requestID, int64_t cur
     });
 }
 
-void DatabaseProcessIDBConnection::cursorIterate(uint64_t requestID, int64_t cursorID, const IDBKeyData& key)
+void DatabaseProcessIDBConnection::cursorIterate(uint64_t requestID, int64_t cursorID, const IDBKeyData& key, uint64_t prefetchCount)
 {
     ASSERT(m_uniqueIDBDatabase);
 
-    LOG(IDB, "DatabaseProcess cursorIterate request ID %" PRIu64 ", cursor id %" PRIi64, requestID, cursorID);
+    LOG(IDB, "DatabaseProcess cursorIterate request ID %" PRIu64 ", cursor id %" PRIi64 ", prefetch count %" PRIu64, requestID, cursorID, prefetchCount);
     RefPtr<DatabaseProcessIDBConnection> connection(this);
-    m_uniqueIDBDatabase->cursorIterate(IDBIdentifier(*this, cursorID), key, [connection, requestID](const IDBKeyData& resultKey, const IDBKeyData& primaryKey, PassRefPtr<SharedBuffer> value, uint32_t errorCode, const String& errorMessage) {
+    m_uniqueIDBDatabase->cursorIterate(IDBIdentifier(*this, cursorID), key, prefetchCount, [connection, requestID](const IDBKeyData& resultKey, const IDBKeyData& primaryKey, PassRefPtr<SharedBuffer> value, const Vector<IDBKeyData>& prefetchedKeys, const Vector<IDBKeyData>& prefetchedPrimaryKeys, const Vector<Vector<uint8_t>>& prefetchedValueBuffers, uint32_t errorCode, const String& errorMessage) {
         IPC::DataReference data = value ? IPC::DataReference(reinterpret_cast<const uint8_t*>(value->data()), value->size()) : IPC::DataReference();
-        connection->send(Messages::WebIDBServerConnection::DidIterateCursor(requestID, resultKey, primaryKey, data, errorCode, errorMessage));
+        connection->send(Messages::WebIDBServerConnection::DidIterateCursor(requestID, resultKey, primaryKey, data, prefetchedKeys, prefetchedPrimaryKeys, prefetchedValueBuffers, errorCode, errorMessage));
     });
 }
 
+void DatabaseProcessIDBConnection::cursorPrefetchReset(int64_t cursorID, uint64_t usedPrefetchCount)
+{
+    ASSERT(m_uniqueIDBDatabase);
+
+    LOG(IDB, "DatabaseProcess cursorPrefetchReset cursor id %" PRIi64 ", used prefetch count %" PRIu64, cursorID, usedPrefetchCount);
+    m_uniqueIDBDatabase->cursorPrefetchReset(IDBIdentifier(*this, cursorID), usedPrefetchCount);
+}
+
 void DatabaseProcessIDBConnection::close()
 {
     LOG(IDB, "DatabaseProcessIDBConnection close");
@@ -645,25 +645,35 @@ void UniqueIDBDatabase::cursorAdvance(const IDBIdentifier& cursorIdentifier, uin
     postDatabaseTask(createCrossThreadTask(*this, &UniqueIDBDatabase::advanceCursorInBackingStore, requestID, cursorIdentifier, count));
 }
 
-void UniqueIDBDatabase::cursorIterate(const IDBIdentifier& cursorIdentifier, const IDBKeyData& key, std::function<void (const IDBKeyData&, const IDBKeyData&, PassRefPtr<SharedBuffer>, uint32_t, const String&)> callback)
+void UniqueIDBDatabase::cursorIterate(const IDBIdentifier& cursorIdentifier, const IDBKeyData& key, uint64_t prefetchCount, std::function<void (const IDBKeyData&, const IDBKeyData&, PassRefPtr<SharedBuffer>, const Vector<IDBKeyData>&, const Vector<IDBKeyData>&, const Vector<Vector<uint8_t>>&, uint32_t, const String&)> callback)
 {
     ASSERT(RunLoop::isMain());
 
     if (!m_acceptingNewRequests) {
-        callback(nullptr, nullptr, nullptr, INVALID_STATE_ERR, "Unable to iterate cursor in database because it has shut down");
+        callback(nullptr, nullptr, nullptr, { }, { }, { }, INVALID_STATE_ERR, "Unable to iterate cursor in database because it has shut down");
         return;
     }
 
-    RefPtr<AsyncRequest> request = AsyncRequestImpl<IDBKeyData, IDBKeyData, PassRefPtr<SharedBuffer>, uint32_t, String>::create([this, callback](const IDBKeyData& key, const IDBKeyData& primaryKey, PassRefPtr<SharedBuffer> value, uint32_t errorCode, const String& errorMessage) {
-        callback(key, primaryKey, value, errorCode, errorMessage);
+    RefPtr<AsyncRequest> request = AsyncRequestImpl<IDBKeyData, IDBKeyData, PassRefPtr<SharedBuffer>, Vector<IDBKeyData>, Vector<IDBKeyData>, Vector<Vector<uint8_t>>, uint32_t, String>::create([this, callback](const IDBKeyData& key, const IDBKeyData& primaryKey, PassRefPtr<SharedBuffer> value, const Vector<IDBKeyData>& prefetchedKeys, const Vector<IDBKeyData>& prefetchedPrimaryKeys, const Vector<Vector<uint8_t>>& prefetchedValueBuffers, uint32_t errorCode, const String& errorMessage) {
+        callback(key, primaryKey, value, prefetchedKeys, prefetchedPrimaryKeys, prefetchedValueBuffers, errorCode, errorMessage);
     }, [this, callback] {
-        callback(nullptr, nullptr, nullptr, INVALID_STATE_ERR, "Unable to iterate cursor in database");
+        callback(nullptr, nullptr, nullptr, { }, { }, { }, INVALID_STATE_ERR, "Unable to iterate cursor in database");
     });
 
     uint64_t requestID = request->requestID();
     m_pendingDatabaseTasks.add(requestID, request.release());
 
-    postDatabaseTask(createCrossThreadTask(*this, &UniqueIDBDatabase::iterateCursorInBackingStore, requestID, cursorIdentifier, key));
+    postDatabaseTask(createCrossThreadTask(*this, &UniqueIDBDatabase::iterateCursorInBackingStore, requestID, cursorIdentifier, key, prefetchCount));
+}
+
+void UniqueIDBDatabase::cursorPrefetchReset(const IDBIdentifier& cursorIdentifier, uint64_t usedPrefetchCount)
+{
+    ASSERT(RunLoop::isMain());
+
+    if (!m_acceptingNewRequests)
+        return;
+
+    postDatabaseTask(createCrossThreadTask(*this, &UniqueIDBDatabase::resetCursorPrefetchInBackingStore, cursorIdentifier, usedPrefetchCount));
 }
 
 void UniqueIDBDatabase::count(const IDBIdentifier& transactionIdentifier, int64_t objectStoreID, int64_t indexID, const IDBKeyRangeData& keyRangeData, std::function<void (int64_t, uint32_t, const String&)> callback)
@@ -996,11 +1006,14 @@ void UniqueIDBDatabase::didAdvanceCursorInBackingStore(uint64_t requestID, const
     m_pendingDatabaseTasks.take(requestID).get().completeRequest(key, primaryKey, SharedBuffer::create(valueBuffer.data(), valueBuffer.size()), errorCode, errorMessage);
 }
 
-void UniqueIDBDatabase::iterateCursorInBackingStore(uint64_t requestID, const IDBIdentifier& cursorIdentifier, const IDBKeyData& iterateKey)
+void UniqueIDBDatabase::iterateCursorInBackingStore(uint64_t requestID, const IDBIdentifier& cursorIdentifier, const IDBKeyData& iterateKey, uint64_t prefetchCount)
 {
     IDBKeyData key;
     IDBKeyData primaryKey;
     Vector<uint8_t> valueBuffer;
+    Vector<IDBKeyData> prefetchedKeys;
+    Vector<IDBKeyData> prefetchedPrimaryKeys;
+    Vector<Vector<uint8_t>> prefetchedValueBuffers;
     int32_t errorCode = 0;
     String errorMessage;
     bool success = m_backingStore->iterateCursor(cursorIdentifier, iterateKey, key, primaryKey, valueBuffer);
@@ -1008,14 +1021,20 @@ void UniqueIDBDatabase::iterateCursorInBackingStore(uint64_t requestID, const ID
     if (!success) {
         errorCode = IDBDatabaseException::UnknownError;
         errorMessage = ASCIILiteral("Unknown error iterating cursor in backing store");
-    }
+    } else if (prefetchCount && !key.isNull())
+        m_backingStore->prefetchCursor(cursorIdentifier, prefetchCount, prefetchedKeys, prefetchedPrimaryKeys, prefetchedValueBuffers);
 
-    postMainThreadTask(createCrossThreadTask(*this, &UniqueIDBDatabase::didIterateCursorInBackingStore, requestID, key, primaryKey, valueBuffer, errorCode, errorMessage));
+    postMainThreadTask(createCrossThreadTask(*this, &UniqueIDBDatabase::didIterateCursorInBackingStore, requestID, key, primaryKey, valueBuffer, prefetchedKeys, prefetchedPrimaryKeys, prefetchedValueBuffers, errorCode, errorMessage));
 }
 
-void UniqueIDBDatabase::didIterateCursorInBackingStore(uint64_t requestID, const IDBKeyData& key, const IDBKeyData& primaryKey, const Vector<uint8_t>& valueBuffer, uint32_t errorCode, const String& errorMessage)
+void UniqueIDBDatabase::resetCursorPrefetchInBackingStore(const IDBIdentifier& cursorIdentifier, uint64_t usedPrefetchCount)
 {
-    m_pendingDatabaseTasks.take(requestID).get().completeRequest(key, primaryKey, SharedBuffer::create(valueBuffer.data(), valueBuffer.size()), errorCode, errorMessage);
+    m_backingStore->resetCursorPrefetch(cursorIdentifier, usedPrefetchCount);
+}
+
+void UniqueIDBDatabase::didIterateCursorInBackingStore(uint64_t requestID, const IDBKeyData& key, const IDBKeyData& primaryKey, const Vector<uint8_t>& valueBuffer, const Vector<IDBKeyData>& prefetchedKeys, const Vector<IDBKeyData>& prefetchedPrimaryKeys, const Vector<Vector<uint8_t>>& prefetchedValueBuffers, uint32_t errorCode, const String& errorMessage)
+{
+    m_pendingDatabaseTasks.take(requestID).get().completeRequest(key, primaryKey, SharedBuffer::create(valueBuffer.data(), valueBuffer.size()), prefetchedKeys, prefetchedPrimaryKeys, prefetchedValueBuffers, errorCode, errorMessage);
 }
 
 void UniqueIDBDatabase::countInBackingStore(uint64_t requestID, const IDBIdentifier& transactionIdentifier, int64_t objectStoreID, int64_t indexID, const IDBKeyRangeData& keyRangeData)
@@ -360,6 +360,60 @@ SQLiteIDBCursor::AdvanceResult SQLiteIDBCursor::internalAdvanceOnce()
     return AdvanceResult::Success;
 }
 
+bool SQLiteIDBCursor::prefetch(uint64_t count, Vector<IDBKeyData>& keys, Vector<IDBKeyData>& primaryKeys, Vector<Vector<uint8_t>>& valueBuffers)
+{
+    ASSERT(m_transaction->sqliteTransaction());
+    ASSERT(m_statement);
+
+    m_prefetchPositions.clear();
+
+    // resetPrefetch() finds its way back by rebinding the statement to a key, which only lands on the right record
+    // if no two records this cursor visits share a key. That is not true of index cursors that visit duplicates.
+    bool isUnique = m_cursorDirection == IndexedDB::CursorDirection::NextNoDuplicate || m_cursorDirection == IndexedDB::CursorDirection::PrevNoDuplicate;
+    if (m_indexID != IDBIndexMetadata::InvalidId && !isUnique)
+        return false;
+
+    if (m_completed || m_currentKey.isNull())
+        return false;
+
+    m_prefetchPositions.append({ m_currentKey, m_currentPrimaryKey, m_currentRecordID });
+
+    for (uint64_t i = 0; i < count && !m_completed; ++i) {
+        // If advancing fails the cursor is left errored, and the client's next real iteration reports that.
+        if (!advance(1))
+            break;
+
+        keys.append(m_currentKey);
+        primaryKeys.append(m_currentPrimaryKey);
+        valueBuffers.append(m_currentValueBuffer);
+
+        if (!m_completed)
+            m_prefetchPositions.append({ m_currentKey, m_currentPrimaryKey, m_currentRecordID });
+    }
+
+    return !keys.isEmpty();
+}
+
+void SQLiteIDBCursor::resetPrefetch(uint64_t usedPrefetchCount)
+{
+    if (usedPrefetchCount >= m_prefetchPositions.size()) {
+        LOG_ERROR("Attempt to reset cursor prefetch past the records that were prefetched");
+        return;
+    }
+
+    const Position& position = m_prefetchPositions[usedPrefetchCount];
+    m_currentKey = position.key;
+    m_currentPrimaryKey = position.primaryKey;
+    m_currentRecordID = position.recordID;
+    m_currentValueBuffer.clear();
+    m_completed = false;
+
+    m_prefetchPositions.clear();
+
+    // Rebinding the statement to the current key picks up right after the record the client is on.
+    m_statementNeedsReset = true;
+}
+
 bool SQLiteIDBCursor::iterate(const WebCore::IDBKeyData& targetKey)
 {
     ASSERT(m_transaction->sqliteTransaction());
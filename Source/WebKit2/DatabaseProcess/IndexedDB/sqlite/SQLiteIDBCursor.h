@@ -65,6 +65,12 @@ public:
     bool advance(uint64_t count);
     bool iterate(const WebCore::IDBKeyData& targetKey);
 
+    // Reads up to count records past the current one without the client having asked for them yet.
+    // A record without a key marks the end of the cursor.
+    bool prefetch(uint64_t count, Vector<WebCore::IDBKeyData>& keys, Vector<WebCore::IDBKeyData>& primaryKeys, Vector<Vector<uint8_t>>& valueBuffers);
+    // Moves the cursor back to the record the client actually reached after using some of the prefetched records.
+    void resetPrefetch(uint64_t usedPrefetchCount);
+
     bool didError() const { return m_errored; }
 
     void objectStoreRecordsChanged();
@@ -109,6 +115,13 @@ private:
 
     bool m_completed;
     bool m_errored;
+
+    struct Position {
+        WebCore::IDBKeyData key;
+        WebCore::IDBKeyData primaryKey;
+        int64_t recordID;
+    };
+    Vector<Position> m_prefetchPositions;
 };
 
 } // namespace WebKit
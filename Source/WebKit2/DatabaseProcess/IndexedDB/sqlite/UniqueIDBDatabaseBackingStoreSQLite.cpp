@@ -1408,6 +1408,44 @@ bool UniqueIDBDatabaseBackingStoreSQLite::iterateCursor(const IDBIdentifier& cur
     return true;
 }
 
+bool UniqueIDBDatabaseBackingStoreSQLite::prefetchCursor(const IDBIdentifier& cursorIdentifier, uint64_t count, Vector<IDBKeyData>& keys, Vector<IDBKeyData>& primaryKeys, Vector<Vector<uint8_t>>& valueBuffers)
+{
+    ASSERT(!RunLoop::isMain());
+    ASSERT(m_sqliteDB);
+    ASSERT(m_sqliteDB->isOpen());
+
+    SQLiteIDBCursor* cursor = m_cursors.get(cursorIdentifier);
+    if (!cursor) {
+        LOG_ERROR("Attempt to prefetch from a cursor that doesn't exist");
+        return false;
+    }
+    if (!cursor->transaction() || !cursor->transaction()->inProgress()) {
+        LOG_ERROR("Attempt to prefetch from a cursor without an established, in-progress transaction");
+        return false;
+    }
+
+    return cursor->prefetch(count, keys, primaryKeys, valueBuffers);
+}
+
+void UniqueIDBDatabaseBackingStoreSQLite::resetCursorPrefetch(const IDBIdentifier& cursorIdentifier, uint64_t usedPrefetchCount)
+{
+    ASSERT(!RunLoop::isMain());
+    ASSERT(m_sqliteDB);
+    ASSERT(m_sqliteDB->isOpen());
+
+    SQLiteIDBCursor* cursor = m_cursors.get(cursorIdentifier);
+    if (!cursor) {
+        LOG_ERROR("Attempt to reset the prefetch of a cursor that doesn't exist");
+        return;
+    }
+    if (!cursor->transaction() || !cursor->transaction()->inProgress()) {
+        LOG_ERROR("Attempt to reset the prefetch of a cursor without an established, in-progress transaction");
+        return;
+    }
+
+    cursor->resetPrefetch(usedPrefetchCount);
+}
+
 void UniqueIDBDatabaseBackingStoreSQLite::notifyCursorsOfChanges(const IDBIdentifier& transactionIdentifier, int64_t objectStoreID)
 {
     ASSERT(!RunLoop::isMain());
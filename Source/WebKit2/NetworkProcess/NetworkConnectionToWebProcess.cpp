@@ -57,6 +57,10 @@ Ref<NetworkConnectionToWebProcess> NetworkConnectionToWebProcess::create(IPC::Co
 NetworkConnectionToWebProcess::NetworkConnectionToWebProcess(IPC::Connection::Identifier connectionIdentifier)
 {
     m_connection = IPC::Connection::createServerConnection(connectionIdentifier, *this);
+#if USE(UNIX_DOMAIN_SOCKETS)
+    // Resource loads send the web process several messages for every chunk of data.
+    m_connection->setShouldUseSharedMemoryRing();
+#endif
     m_connection->open();
 }
 
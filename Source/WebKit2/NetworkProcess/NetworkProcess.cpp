@@ -146,6 +146,10 @@ void NetworkProcess::didReceiveSyncMessage(IPC::Connection& connection, IPC::Mes
 
 void NetworkProcess::didClose(IPC::Connection&)
 {
+#if ENABLE(NETWORK_CACHE)
+    NetworkCache::singleton().writeContentsFilters();
+#endif
+
     // The UIProcess just exited.
     RunLoop::current().stop();
 }
@@ -178,6 +182,9 @@ AuthenticationManager& NetworkProcess::downloadsAuthenticationManager()
 void NetworkProcess::lowMemoryHandler(Critical critical)
 {
     platformLowMemoryHandler(critical);
+#if ENABLE(NETWORK_CACHE)
+    NetworkCache::singleton().handleMemoryPressure(critical);
+#endif
     WTF::releaseFastMallocFreeMemory();
 }
 
@@ -502,6 +509,9 @@ void NetworkProcess::logDiagnosticMessageWithValue(uint64_t webPageID, const Str
 
 void NetworkProcess::terminate()
 {
+#if ENABLE(NETWORK_CACHE)
+    NetworkCache::singleton().writeContentsFilters();
+#endif
     platformTerminate();
     ChildProcess::terminate();
 }
@@ -515,6 +525,9 @@ void NetworkProcess::processWillSuspendImminently(bool& handled)
 void NetworkProcess::prepareToSuspend()
 {
     lowMemoryHandler(Critical::Yes);
+#if ENABLE(NETWORK_CACHE)
+    NetworkCache::singleton().writeContentsFilters();
+#endif
     parentProcessConnection()->send(Messages::NetworkProcessProxy::ProcessReadyToSuspend(), 0);
 }
 
@@ -428,13 +428,13 @@ void NetworkResourceLoader::bufferingTimerFired()
     if (m_bufferedData->isEmpty())
         return;
 
-    IPC::SharedBufferDataReference dataReference(m_bufferedData.get());
+    RefPtr<SharedBuffer> data = WTF::move(m_bufferedData);
     size_t encodedLength = m_bufferedDataEncodedDataLength;
 
     m_bufferedData = SharedBuffer::create();
     m_bufferedDataEncodedDataLength = 0;
 
-    sendAbortingOnFailure(Messages::WebResourceLoader::DidReceiveData(dataReference, encodedLength));
+    sendDataAbortingOnFailure(*data, encodedLength);
 }
 
 bool NetworkResourceLoader::sendBufferMaybeAborting(SharedBuffer& buffer, size_t encodedDataLength)
@@ -451,6 +451,44 @@ bool NetworkResourceLoader::sendBufferMaybeAborting(SharedBuffer& buffer, size_t
     }
 #endif
 
+    return sendDataAbortingOnFailure(buffer, encodedDataLength);
+}
+
+#if ENABLE(SHAREABLE_RESOURCE)
+// Chunks at least this large are copied once into shared memory and mapped by the WebProcess, instead of
+// being serialized into the message and copied out of it again on the other side.
+static const size_t minimumSharedDataChunkSize = 64 * 1024;
+
+static bool tryCreateShareableHandleForChunk(ShareableResource::Handle& handle, const SharedBuffer& buffer)
+{
+    if (buffer.size() < minimumSharedDataChunkSize)
+        return false;
+
+    RefPtr<SharedMemory> sharedMemory = SharedMemory::allocate(buffer.size());
+    if (!sharedMemory)
+        return false;
+
+    char* destination = static_cast<char*>(sharedMemory->data());
+    const char* segment;
+    unsigned position = 0;
+    while (unsigned length = buffer.getSomeData(segment, position)) {
+        memcpy(destination + position, segment, length);
+        position += length;
+    }
+
+    Ref<ShareableResource> shareableResource = ShareableResource::create(sharedMemory.release(), 0, buffer.size());
+    return shareableResource->createHandle(handle);
+}
+#endif
+
+bool NetworkResourceLoader::sendDataAbortingOnFailure(SharedBuffer& buffer, size_t encodedDataLength)
+{
+#if ENABLE(SHAREABLE_RESOURCE)
+    ShareableResource::Handle handle;
+    if (tryCreateShareableHandleForChunk(handle, buffer))
+        return sendAbortingOnFailure(Messages::WebResourceLoader::DidReceiveSharedData(handle, encodedDataLength));
+#endif
+
     IPC::SharedBufferDataReference dataReference(&buffer);
     return sendAbortingOnFailure(Messages::WebResourceLoader::DidReceiveData(dataReference, encodedDataLength));
 }
@@ -129,6 +129,7 @@ private:
     void startBufferingTimerIfNeeded();
     void bufferingTimerFired();
     bool sendBufferMaybeAborting(WebCore::SharedBuffer&, size_t encodedDataLength);
+    bool sendDataAbortingOnFailure(WebCore::SharedBuffer&, size_t encodedDataLength);
 
     void consumeSandboxExtensions();
     void invalidateSandboxExtensions();
@@ -35,6 +35,7 @@
 #include <WebCore/CacheValidation.h>
 #include <WebCore/FileSystem.h>
 #include <WebCore/HTTPHeaderNames.h>
+#include <WebCore/MemoryPressureHandler.h>
 #include <WebCore/NetworkStorageSession.h>
 #include <WebCore/PlatformCookieJar.h>
 #include <WebCore/ResourceRequest.h>
@@ -343,6 +344,21 @@ static StoreDecision makeStoreDecision(const WebCore::ResourceRequest& originalR
     return StoreDecision::Yes;
 }
 
+static UseDecision prepareEntryForUse(std::unique_ptr<Entry>& entry, const WebCore::ResourceRequest& request)
+{
+    auto useDecision = entry ? makeUseDecision(*entry, request) : UseDecision::NoDueToDecodeFailure;
+    switch (useDecision) {
+    case UseDecision::Use:
+        break;
+    case UseDecision::Validate:
+        entry->setNeedsValidation();
+        break;
+    default:
+        entry = nullptr;
+    };
+    return useDecision;
+}
+
 void Cache::retrieve(const WebCore::ResourceRequest& originalRequest, const GlobalFrameID& frameID, std::function<void (std::unique_ptr<Entry>)> completionHandler)
 {
     ASSERT(isEnabled());
@@ -383,6 +399,23 @@ void Cache::retrieve(const WebCore::ResourceRequest& originalRequest, const Glob
         return;
 #endif
 
+    if (auto entry = m_hotEntryCache.get(storageKey)) {
+        LOG(NetworkCache, "(NetworkProcess) found in hot entry cache");
+
+        if (m_statistics)
+            m_statistics->recordHotEntryCacheLookup(true);
+
+        auto useDecision = prepareEntryForUse(entry, originalRequest);
+        completionHandler(WTF::move(entry));
+
+        if (m_statistics)
+            m_statistics->recordRetrievedCachedEntry(frameID.first, storageKey, originalRequest, useDecision);
+        return;
+    }
+
+    if (m_statistics)
+        m_statistics->recordHotEntryCacheLookup(false);
+
     auto startTime = std::chrono::system_clock::now();
     auto priority = static_cast<unsigned>(originalRequest.priority());
 
@@ -400,17 +433,10 @@ void Cache::retrieve(const WebCore::ResourceRequest& originalRequest, const Glob
         ASSERT(record->key == storageKey);
 
         auto entry = Entry::decodeStorageRecord(*record);
+        if (entry)
+            m_hotEntryCache.add(*entry);
 
-        auto useDecision = entry ? makeUseDecision(*entry, originalRequest) : UseDecision::NoDueToDecodeFailure;
-        switch (useDecision) {
-        case UseDecision::Use:
-            break;
-        case UseDecision::Validate:
-            entry->setNeedsValidation();
-            break;
-        default:
-            entry = nullptr;
-        };
+        auto useDecision = prepareEntryForUse(entry, originalRequest);
 
 #if !LOG_DISABLED
         auto elapsedMS = static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - startTime).count());
@@ -457,6 +483,8 @@ std::unique_ptr<Entry> Cache::store(const WebCore::ResourceRequest& originalRequ
 
     std::unique_ptr<Entry> cacheEntry = std::make_unique<Entry>(makeCacheKey(originalRequest), response, WTF::move(responseData), collectVaryingRequestHeaders(originalRequest, response));
 
+    m_hotEntryCache.remove(cacheEntry->key());
+
     auto record = cacheEntry->encodeAsStorageRecord();
 
     m_storage->store(record, [completionHandler](const Data& bodyData) {
@@ -486,6 +514,7 @@ std::unique_ptr<Entry> Cache::update(const WebCore::ResourceRequest& originalReq
     auto updateEntry = std::make_unique<Entry>(existingEntry.key(), response, existingEntry.buffer(), collectVaryingRequestHeaders(originalRequest, response));
     auto updateRecord = updateEntry->encodeAsStorageRecord();
 
+    m_hotEntryCache.remove(existingEntry.key());
     m_storage->store(updateRecord, { });
 
     if (m_statistics)
@@ -498,6 +527,7 @@ void Cache::remove(const Key& key)
 {
     ASSERT(isEnabled());
 
+    m_hotEntryCache.remove(key);
     m_storage->remove(key);
 }
 
@@ -601,6 +631,8 @@ void Cache::clear(std::chrono::system_clock::time_point modifiedSince, std::func
     if (m_statistics)
         m_statistics->clear();
 
+    m_hotEntryCache.clear();
+
     if (!m_storage) {
         RunLoop::main().dispatch(completionHandler);
         return;
@@ -616,6 +648,17 @@ void Cache::clear()
     clear(std::chrono::system_clock::time_point::min(), nullptr);
 }
 
+void Cache::handleMemoryPressure(WebCore::Critical critical)
+{
+    m_hotEntryCache.handleMemoryPressure(critical);
+}
+
+void Cache::writeContentsFilters()
+{
+    if (m_storage)
+        m_storage->writeContentsFiltersSynchronously();
+}
+
 String Cache::recordsPath() const
 {
     return m_storage ? m_storage->recordsPath() : String();
@@ -29,6 +29,7 @@
 #if ENABLE(NETWORK_CACHE)
 
 #include "NetworkCacheEntry.h"
+#include "NetworkCacheHotEntryCache.h"
 #include "NetworkCacheStorage.h"
 #include "ShareableResource.h"
 #include <WebCore/ResourceResponse.h>
@@ -115,6 +116,10 @@ public:
 
     void dumpContentsToFile();
 
+    void handleMemoryPressure(WebCore::Critical);
+    // Call before the process exits or suspends so the next launch can skip waiting for synchronization.
+    void writeContentsFilters();
+
     String recordsPath() const;
 
 private:
@@ -125,6 +130,7 @@ private:
     void deleteDumpFile();
 
     std::unique_ptr<Storage> m_storage;
+    HotEntryCache m_hotEntryCache;
 #if ENABLE(NETWORK_CACHE_SPECULATIVE_REVALIDATION)
     std::unique_ptr<SpeculativeLoadManager> m_speculativeLoadManager;
 #endif
@@ -108,6 +108,8 @@ public:
 
     static Data empty();
     static Data adoptMap(void* map, size_t, int fd);
+    // Takes ownership of a buffer allocated with fastMalloc.
+    static Data adoptFastMallocBuffer(uint8_t*, size_t);
 
 #if PLATFORM(COCOA)
     enum class Backing { Buffer, Map };
@@ -54,6 +54,14 @@ Data Data::empty()
     return { DispatchPtr<dispatch_data_t>(dispatch_data_empty) };
 }
 
+Data Data::adoptFastMallocBuffer(uint8_t* data, size_t size)
+{
+    auto destructor = ^{
+        fastFree(data);
+    };
+    return { adoptDispatch(dispatch_data_create(data, size, nullptr, destructor)) };
+}
+
 const uint8_t* Data::data() const
 {
     if (!m_data && m_dispatchData) {
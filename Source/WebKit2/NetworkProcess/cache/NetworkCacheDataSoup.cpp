@@ -60,6 +60,12 @@ Data Data::empty()
     return { WTF::move(buffer) };
 }
 
+Data Data::adoptFastMallocBuffer(uint8_t* data, size_t size)
+{
+    GRefPtr<SoupBuffer> buffer = adoptGRef(soup_buffer_new_with_owner(data, size, data, fastFree));
+    return { WTF::move(buffer) };
+}
+
 const uint8_t* Data::data() const
 {
     return m_buffer ? reinterpret_cast<const uint8_t*>(m_buffer->data) : nullptr;
@@ -81,8 +81,16 @@ Storage::Record Entry::encodeAsStorageRecord() const
 
     Data header(encoder.buffer(), encoder.bufferSize());
     Data body;
-    if (m_buffer)
-        body = { reinterpret_cast<const uint8_t*>(m_buffer->data()), m_buffer->size() };
+    if (m_buffer) {
+        // Copy the body straight out of the segments instead of flattening m_buffer first.
+        uint8_t* bodyData = static_cast<uint8_t*>(fastMalloc(m_buffer->size()));
+        size_t position = 0;
+        m_buffer->forEachSegment([bodyData, &position](const char* segment, unsigned length) {
+            memcpy(bodyData + position, segment, length);
+            position += length;
+        });
+        body = Data::adoptFastMallocBuffer(bodyData, m_buffer->size());
+    }
 
     return { m_key, m_timeStamp, header, body };
 }
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "NetworkCacheHotEntryCache.h"
+
+#if ENABLE(NETWORK_CACHE)
+
+#include "Logging.h"
+#include "NetworkCacheEntry.h"
+#include <WebCore/MemoryPressureHandler.h>
+#include <wtf/RunLoop.h>
+
+namespace WebKit {
+namespace NetworkCache {
+
+static const size_t maximumSize = 8 * 1024 * 1024;
+static const size_t maximumProbationarySize = maximumSize / 4;
+static const size_t maximumProtectedSize = maximumSize - maximumProbationarySize;
+static const size_t maximumEntrySize = maximumSize / 16;
+
+static size_t entrySize(const Entry& entry)
+{
+    auto& record = entry.sourceStorageRecord();
+    return record.header.size() + record.body.size();
+}
+
+std::unique_ptr<Entry> HotEntryCache::get(const Key& key)
+{
+    ASSERT(RunLoop::isMain());
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return nullptr;
+
+    auto& cachedEntry = it->value;
+    auto entry = std::make_unique<Entry>(*cachedEntry.entry);
+
+    if (cachedEntry.isProtected) {
+        m_protectedKeys.appendOrMoveToLast(key);
+        return entry;
+    }
+
+    // Retrieved again, move it to the main list.
+    m_probationaryKeys.remove(key);
+    m_probationarySize -= cachedEntry.size;
+    cachedEntry.isProtected = true;
+    m_protectedKeys.add(key);
+    m_protectedSize += cachedEntry.size;
+
+    shrink(maximumProbationarySize, maximumProtectedSize);
+
+    return entry;
+}
+
+void HotEntryCache::add(const Entry& entry)
+{
+    ASSERT(RunLoop::isMain());
+
+    remove(entry.key());
+
+    size_t size = entrySize(entry);
+    if (size > maximumEntrySize)
+        return;
+
+    m_entries.add(entry.key(), CachedEntry { std::make_unique<Entry>(entry), size, false });
+    m_probationaryKeys.add(entry.key());
+    m_probationarySize += size;
+
+    shrink(maximumProbationarySize, maximumProtectedSize);
+}
+
+void HotEntryCache::remove(const Key& key)
+{
+    ASSERT(RunLoop::isMain());
+
+    auto it = m_entries.find(key);
+    if (it == m_entries.end())
+        return;
+
+    if (it->value.isProtected) {
+        m_protectedKeys.remove(key);
+        m_protectedSize -= it->value.size;
+    } else {
+        m_probationaryKeys.remove(key);
+        m_probationarySize -= it->value.size;
+    }
+    m_entries.remove(it);
+}
+
+void HotEntryCache::clear()
+{
+    ASSERT(RunLoop::isMain());
+
+    m_entries.clear();
+    m_probationaryKeys.clear();
+    m_protectedKeys.clear();
+    m_probationarySize = 0;
+    m_protectedSize = 0;
+}
+
+void HotEntryCache::handleMemoryPressure(WebCore::Critical critical)
+{
+    ASSERT(RunLoop::isMain());
+
+    LOG(NetworkCache, "(NetworkProcess) hot entry cache memory pressure, critical=%d size=%zu", critical == WebCore::Critical::Yes, size());
+
+    if (critical == WebCore::Critical::Yes) {
+        clear();
+        return;
+    }
+    // Entries retrieved only once are the least likely to be needed again.
+    shrink(0, m_protectedSize / 2);
+}
+
+void HotEntryCache::shrink(size_t probationaryLimit, size_t protectedLimit)
+{
+    shrinkList(m_probationaryKeys, m_probationarySize, probationaryLimit);
+    shrinkList(m_protectedKeys, m_protectedSize, protectedLimit);
+}
+
+void HotEntryCache::shrinkList(ListHashSet<Key>& keys, size_t& listSize, size_t limit)
+{
+    while (listSize > limit) {
+        ASSERT(!keys.isEmpty());
+        listSize -= m_entries.take(keys.takeFirst()).size;
+    }
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef NetworkCacheHotEntryCache_h
+#define NetworkCacheHotEntryCache_h
+
+#if ENABLE(NETWORK_CACHE)
+
+#include "NetworkCacheKey.h"
+#include <wtf/HashMap.h>
+#include <wtf/ListHashSet.h>
+#include <wtf/Noncopyable.h>
+
+namespace WebCore {
+enum class Critical;
+}
+
+namespace WebKit {
+namespace NetworkCache {
+
+class Entry;
+
+// Keeps recently retrieved entries decoded in memory so that retrieving them again doesn't go to the disk storage.
+// Entries use a 2Q policy: an entry enters a small probationary FIFO and only moves to the main LRU list when it
+// is retrieved again. This keeps resources loaded once from pushing out the ones shared between pages.
+class HotEntryCache {
+    WTF_MAKE_NONCOPYABLE(HotEntryCache);
+public:
+    HotEntryCache() = default;
+
+    // Returns a copy the caller is free to modify.
+    std::unique_ptr<Entry> get(const Key&);
+    void add(const Entry&);
+    void remove(const Key&);
+    void clear();
+
+    void handleMemoryPressure(WebCore::Critical);
+
+    size_t size() const { return m_probationarySize + m_protectedSize; }
+
+private:
+    struct CachedEntry {
+        std::unique_ptr<Entry> entry;
+        size_t size;
+        bool isProtected;
+    };
+
+    void shrink(size_t probationaryLimit, size_t protectedLimit);
+    void shrinkList(ListHashSet<Key>&, size_t& listSize, size_t limit);
+
+    HashMap<Key, CachedEntry> m_entries;
+    // Oldest first.
+    ListHashSet<Key> m_probationaryKeys;
+    // Least recently used first.
+    ListHashSet<Key> m_protectedKeys;
+    size_t m_probationarySize { 0 };
+    size_t m_protectedSize { 0 };
+};
+
+}
+}
+
+#endif
+#endif
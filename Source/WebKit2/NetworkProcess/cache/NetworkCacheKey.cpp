@@ -99,11 +99,11 @@ Key::HashType Key::computeHash() const
     return hash;
 }
 
-String Key::hashAsString() const
+String Key::hashAsString(const HashType& hash)
 {
     StringBuilder builder;
     builder.reserveCapacity(hashStringLength());
-    for (auto byte : m_hash) {
+    for (auto byte : hash) {
         builder.append(upperNibbleToASCIIHexDigit(byte));
         builder.append(lowerNibbleToASCIIHexDigit(byte));
     }
@@ -64,7 +64,8 @@ public:
     static bool stringToHash(const String&, HashType&);
 
     static size_t hashStringLength() { return 2 * sizeof(m_hash); }
-    String hashAsString() const;
+    String hashAsString() const { return hashAsString(m_hash); }
+    static String hashAsString(const HashType&);
 
     void encode(Encoder&) const;
     static bool decode(Decoder&, Key&);
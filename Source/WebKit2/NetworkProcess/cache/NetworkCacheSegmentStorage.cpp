@@ -0,0 +1,526 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "config.h"
+#include "NetworkCacheSegmentStorage.h"
+
+#if ENABLE(NETWORK_CACHE)
+
+#include "Logging.h"
+#include "NetworkCacheCoders.h"
+#include <WebCore/FileSystem.h>
+#include <algorithm>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <wtf/PageBlock.h>
+#include <wtf/RunLoop.h>
+
+namespace WebKit {
+namespace NetworkCache {
+
+static const uint32_t segmentFrameMagic = 0x4e435347;
+static const uint64_t maximumSegmentSize = 4 * 1024 * 1024;
+
+// Each record is stored in a frame made of this header followed by the record bytes.
+struct SegmentFrameHeader {
+    Key::HashType hash;
+    bool isTombstone;
+    std::chrono::milliseconds epochRelativeCreationTime;
+    std::chrono::milliseconds epochRelativeAccessTime;
+    uint64_t recordSize;
+};
+
+static std::chrono::milliseconds epochRelativeTime(std::chrono::system_clock::time_point time)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(time.time_since_epoch());
+}
+
+static Data encodeFrameHeader(const SegmentFrameHeader& header)
+{
+    Encoder encoder;
+
+    encoder << segmentFrameMagic;
+    encoder << header.hash;
+    encoder << header.isTombstone;
+    encoder << header.epochRelativeCreationTime;
+    encoder << header.epochRelativeAccessTime;
+    encoder << header.recordSize;
+
+    encoder.encodeChecksum();
+
+    return Data(encoder.buffer(), encoder.bufferSize());
+}
+
+static bool decodeFrameHeader(const uint8_t* data, size_t size, SegmentFrameHeader& header, size_t& headerSize)
+{
+    Decoder decoder(data, size);
+    uint32_t magic;
+    if (!decoder.decode(magic) || magic != segmentFrameMagic)
+        return false;
+    if (!decoder.decode(header.hash))
+        return false;
+    if (!decoder.decode(header.isTombstone))
+        return false;
+    if (!decoder.decode(header.epochRelativeCreationTime))
+        return false;
+    if (!decoder.decode(header.epochRelativeAccessTime))
+        return false;
+    if (!decoder.decode(header.recordSize))
+        return false;
+    if (!decoder.verifyChecksum())
+        return false;
+    headerSize = decoder.currentOffset();
+    return true;
+}
+
+// Returns the size taken by the complete frames. Anything past them is left over from an interrupted write.
+static uint64_t traverseFrames(const Data& segmentData, const std::function<void (const SegmentFrameHeader&, uint64_t frameOffset, uint64_t frameSize)>& function)
+{
+    if (segmentData.isNull() || segmentData.isEmpty())
+        return 0;
+
+    const uint8_t* data = segmentData.data();
+    uint64_t size = segmentData.size();
+    uint64_t offset = 0;
+    while (offset < size) {
+        SegmentFrameHeader header;
+        size_t headerSize;
+        if (!decodeFrameHeader(data + offset, size - offset, header, headerSize))
+            break;
+        if (header.recordSize > size - offset - headerSize)
+            break;
+        uint64_t frameSize = headerSize + header.recordSize;
+        function(header, offset, frameSize);
+        offset += frameSize;
+    }
+    return offset;
+}
+
+static bool writeData(int fd, const Data& data)
+{
+    bool success = true;
+    data.apply([fd, &success](const uint8_t* bytes, size_t size) {
+        while (size) {
+            ssize_t writtenSize = write(fd, bytes, size);
+            if (writtenSize < 0) {
+                if (errno == EINTR)
+                    continue;
+                success = false;
+                return false;
+            }
+            bytes += writtenSize;
+            size -= writtenSize;
+        }
+        return true;
+    });
+    return success;
+}
+
+// The index is keyed by the leading bytes of the hash. Lookups check the full hash.
+static uint64_t indexKeyForHash(const Key::HashType& hash)
+{
+    uint64_t key;
+    memcpy(&key, hash.data(), sizeof(key));
+    // Stay clear of the empty and deleted values of the hash table.
+    return std::max<uint64_t>(std::min(key, std::numeric_limits<uint64_t>::max() - 1), 1);
+}
+
+SegmentStorage::SegmentStorage(const String& segmentDirectoryPath)
+    : m_segmentDirectoryPath(segmentDirectoryPath)
+{
+}
+
+SegmentStorage::~SegmentStorage()
+{
+    closeActiveSegment();
+}
+
+String SegmentStorage::segmentDirectoryPath() const
+{
+    return m_segmentDirectoryPath.isolatedCopy();
+}
+
+String SegmentStorage::segmentPath(unsigned segmentNumber) const
+{
+    return WebCore::pathByAppendingComponent(segmentDirectoryPath(), String::number(segmentNumber));
+}
+
+bool SegmentStorage::openActiveSegment(size_t frameSize)
+{
+    if (m_activeSegmentFileDescriptor >= 0) {
+        auto& activeSegment = m_segments.find(m_activeSegmentNumber)->value;
+        if (!activeSegment.size || activeSegment.size + frameSize <= maximumSegmentSize)
+            return true;
+        closeActiveSegment();
+    }
+
+    unsigned segmentNumber = m_nextSegmentNumber++;
+    auto path = WebCore::fileSystemRepresentation(segmentPath(segmentNumber));
+    int fd = open(path.data(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+        return false;
+
+    m_activeSegmentNumber = segmentNumber;
+    m_activeSegmentFileDescriptor = fd;
+    m_segments.add(segmentNumber, Segment());
+    return true;
+}
+
+void SegmentStorage::closeActiveSegment()
+{
+    if (m_activeSegmentFileDescriptor >= 0)
+        close(m_activeSegmentFileDescriptor);
+    m_activeSegmentFileDescriptor = -1;
+    m_activeSegmentNumber = 0;
+}
+
+bool SegmentStorage::appendFrame(const SegmentFrameHeader& header, const Data& record, Location& location)
+{
+    ASSERT(m_lock.isLocked());
+    ASSERT(header.recordSize == record.size());
+
+    auto headerData = encodeFrameHeader(header);
+    uint64_t frameSize = headerData.size() + record.size();
+    if (!openActiveSegment(frameSize))
+        return false;
+
+    auto& activeSegment = m_segments.find(m_activeSegmentNumber)->value;
+    if (!writeData(m_activeSegmentFileDescriptor, headerData) || !writeData(m_activeSegmentFileDescriptor, record)) {
+        // Cut off the partial frame, and don't append to this segment anymore in case that failed too.
+        ftruncate(m_activeSegmentFileDescriptor, activeSegment.size);
+        closeActiveSegment();
+        return false;
+    }
+
+    location = {
+        header.hash,
+        m_activeSegmentNumber,
+        activeSegment.size,
+        frameSize,
+        header.recordSize,
+        std::chrono::system_clock::time_point(header.epochRelativeCreationTime),
+        std::chrono::system_clock::time_point(header.epochRelativeAccessTime)
+    };
+    activeSegment.size += frameSize;
+    return true;
+}
+
+void SegmentStorage::addToIndex(const Location& location)
+{
+    ASSERT(m_lock.isLocked());
+
+    auto indexKey = indexKeyForHash(location.hash);
+    removeFromIndex(indexKey);
+
+    m_index.add(indexKey, location);
+    m_segments.find(location.segmentNumber)->value.liveSize += location.frameSize;
+    m_approximateSize += location.frameSize;
+}
+
+void SegmentStorage::removeFromIndex(uint64_t indexKey)
+{
+    ASSERT(m_lock.isLocked());
+
+    auto it = m_index.find(indexKey);
+    if (it == m_index.end())
+        return;
+
+    auto segmentIt = m_segments.find(it->value.segmentNumber);
+    if (segmentIt != m_segments.end())
+        segmentIt->value.liveSize -= it->value.frameSize;
+    m_approximateSize -= it->value.frameSize;
+    m_index.remove(it);
+}
+
+bool SegmentStorage::add(const Key::HashType& hash, const Data& record)
+{
+    ASSERT(!RunLoop::isMain());
+
+    auto now = epochRelativeTime(std::chrono::system_clock::now());
+    SegmentFrameHeader header { hash, false, now, now, record.size() };
+
+    std::lock_guard<Lock> lock(m_lock);
+    Location location;
+    if (!appendFrame(header, record, location))
+        return false;
+    addToIndex(location);
+    return true;
+}
+
+Data SegmentStorage::get(const Key::HashType& hash)
+{
+    ASSERT(!RunLoop::isMain());
+
+    // Compaction may move the record, and delete its segment, between the lookup and the open, so look again if that fails.
+    const unsigned maximumAttemptCount = 2;
+    for (unsigned attempt = 0; attempt < maximumAttemptCount; ++attempt) {
+        Location location;
+        {
+            std::lock_guard<Lock> lock(m_lock);
+            auto it = m_index.find(indexKeyForHash(hash));
+            if (it == m_index.end() || it->value.hash != hash)
+                return { };
+            location = it->value;
+        }
+
+        auto path = WebCore::fileSystemRepresentation(segmentPath(location.segmentNumber));
+        int fd = open(path.data(), O_RDONLY, 0);
+        if (fd < 0)
+            continue;
+
+        // Maps have to start at a page boundary.
+        uint64_t recordOffset = location.frameOffset + location.frameSize - location.recordSize;
+        uint64_t mapOffset = recordOffset - recordOffset % pageSize();
+        auto mappedData = adoptAndMapFile(fd, mapOffset, recordOffset - mapOffset + location.recordSize);
+        if (mappedData.isNull())
+            return { };
+        return mappedData.subrange(recordOffset - mapOffset, location.recordSize);
+    }
+    return { };
+}
+
+void SegmentStorage::remove(const Key::HashType& hash)
+{
+    ASSERT(!RunLoop::isMain());
+
+    std::lock_guard<Lock> lock(m_lock);
+
+    auto indexKey = indexKeyForHash(hash);
+    auto it = m_index.find(indexKey);
+    if (it == m_index.end() || it->value.hash != hash)
+        return;
+    removeFromIndex(indexKey);
+
+    // The record stays in its segment until that gets compacted. Make sure it isn't indexed again by the next synchronization.
+    auto now = epochRelativeTime(std::chrono::system_clock::now());
+    SegmentFrameHeader tombstone { hash, true, now, now, 0 };
+    Location location;
+    appendFrame(tombstone, Data::empty(), location);
+}
+
+void SegmentStorage::markAccessed(const Key::HashType& hash)
+{
+    ASSERT(!RunLoop::isMain());
+
+    std::lock_guard<Lock> lock(m_lock);
+
+    auto it = m_index.find(indexKeyForHash(hash));
+    if (it == m_index.end() || it->value.hash != hash)
+        return;
+    it->value.accessTime = std::chrono::system_clock::now();
+}
+
+void SegmentStorage::clear()
+{
+    ASSERT(!RunLoop::isMain());
+
+    std::lock_guard<Lock> lock(m_lock);
+
+    closeActiveSegment();
+    m_index.clear();
+    m_segments.clear();
+    m_nextSegmentNumber = 1;
+    m_approximateSize = 0;
+
+    auto directoryPath = segmentDirectoryPath();
+    deleteDirectoryRecursively(directoryPath);
+    WebCore::makeAllDirectories(directoryPath);
+}
+
+Vector<SegmentStorage::RecordInfo> SegmentStorage::records() const
+{
+    std::lock_guard<Lock> lock(m_lock);
+
+    Vector<RecordInfo> records;
+    records.reserveInitialCapacity(m_index.size());
+    for (auto& location : m_index.values())
+        records.uncheckedAppend({ location.hash, static_cast<size_t>(location.recordSize), { location.creationTime, location.accessTime } });
+    return records;
+}
+
+void SegmentStorage::synchronize()
+{
+    ASSERT(!RunLoop::isMain());
+
+    auto directoryPath = segmentDirectoryPath();
+    WebCore::makeAllDirectories(directoryPath);
+
+    std::lock_guard<Lock> lock(m_lock);
+
+    closeActiveSegment();
+    auto previousIndex = WTF::move(m_index);
+    m_index.clear();
+    m_segments.clear();
+    m_approximateSize = 0;
+
+    Vector<unsigned> segmentNumbers;
+    traverseDirectory(directoryPath, [&directoryPath, &segmentNumbers](const String& fileName, DirectoryEntryType type) {
+        if (type != DirectoryEntryType::File)
+            return;
+        bool success;
+        unsigned segmentNumber = fileName.toUIntStrict(&success);
+        if (!success || !segmentNumber) {
+            WebCore::deleteFile(WebCore::pathByAppendingComponent(directoryPath, fileName));
+            return;
+        }
+        segmentNumbers.append(segmentNumber);
+    });
+    std::sort(segmentNumbers.begin(), segmentNumbers.end());
+
+    // Later frames replace or remove the records of earlier ones.
+    for (auto segmentNumber : segmentNumbers) {
+        auto path = WebCore::fileSystemRepresentation(segmentPath(segmentNumber));
+        auto segmentData = mapFile(path.data());
+        if (segmentData.isNull())
+            continue;
+
+        m_segments.add(segmentNumber, Segment());
+        auto size = traverseFrames(segmentData, [this, segmentNumber](const SegmentFrameHeader& header, uint64_t frameOffset, uint64_t frameSize) {
+            if (header.isTombstone) {
+                removeFromIndex(indexKeyForHash(header.hash));
+                return;
+            }
+            addToIndex({
+                header.hash,
+                segmentNumber,
+                frameOffset,
+                frameSize,
+                header.recordSize,
+                std::chrono::system_clock::time_point(header.epochRelativeCreationTime),
+                std::chrono::system_clock::time_point(header.epochRelativeAccessTime)
+            });
+        });
+        if (size < segmentData.size())
+            truncate(path.data(), size);
+        m_segments.find(segmentNumber)->value.size = size;
+        m_nextSegmentNumber = segmentNumber + 1;
+    }
+
+    // Retrieval times that haven't been written out yet would be lost otherwise.
+    for (auto& keyValue : m_index) {
+        auto it = previousIndex.find(keyValue.key);
+        if (it != previousIndex.end() && it->value.hash == keyValue.value.hash)
+            keyValue.value.accessTime = std::max(keyValue.value.accessTime, it->value.accessTime);
+    }
+
+    // Keep appending to the last segment while it has room.
+    if (!segmentNumbers.isEmpty()) {
+        unsigned lastSegmentNumber = segmentNumbers.last();
+        auto segmentIt = m_segments.find(lastSegmentNumber);
+        if (segmentIt != m_segments.end() && segmentIt->value.size < maximumSegmentSize) {
+            auto path = WebCore::fileSystemRepresentation(segmentPath(lastSegmentNumber));
+            int fd = open(path.data(), O_WRONLY | O_APPEND, 0);
+            if (fd >= 0) {
+                m_activeSegmentNumber = lastSegmentNumber;
+                m_activeSegmentFileDescriptor = fd;
+            }
+        }
+    }
+
+    LOG(NetworkCacheStorage, "(NetworkProcess) segment synchronization completed segments=%u records=%u approximateSize=%zu", m_segments.size(), m_index.size(), approximateSize());
+}
+
+void SegmentStorage::compactIfNeeded()
+{
+    ASSERT(!RunLoop::isMain());
+
+    // Compact the segments that are mostly taken by removed and replaced records, oldest first.
+    Vector<unsigned> segmentNumbers;
+    {
+        std::lock_guard<Lock> lock(m_lock);
+        for (auto& keyValue : m_segments) {
+            if (keyValue.key == m_activeSegmentNumber)
+                continue;
+            if (keyValue.value.liveSize * 2 < keyValue.value.size)
+                segmentNumbers.append(keyValue.key);
+        }
+    }
+    std::sort(segmentNumbers.begin(), segmentNumbers.end());
+
+    // Let reads and writes through between segments.
+    for (auto segmentNumber : segmentNumbers) {
+        std::lock_guard<Lock> lock(m_lock);
+        if (m_segments.contains(segmentNumber) && segmentNumber != m_activeSegmentNumber)
+            compactSegment(segmentNumber);
+    }
+}
+
+void SegmentStorage::compactSegment(unsigned segmentNumber)
+{
+    ASSERT(m_lock.isLocked());
+    ASSERT(segmentNumber != m_activeSegmentNumber);
+
+    auto path = WebCore::fileSystemRepresentation(segmentPath(segmentNumber));
+    auto segmentData = mapFile(path.data());
+    if (segmentData.isNull())
+        return;
+
+    bool hasOlderSegment = false;
+    for (auto otherSegmentNumber : m_segments.keys())
+        hasOlderSegment |= otherSegmentNumber < segmentNumber;
+
+    bool success = true;
+    traverseFrames(segmentData, [this, segmentNumber, hasOlderSegment, &segmentData, &success](const SegmentFrameHeader& header, uint64_t frameOffset, uint64_t frameSize) {
+        if (!success)
+            return;
+
+        auto it = m_index.find(indexKeyForHash(header.hash));
+        Location location;
+        if (header.isTombstone) {
+            // An older segment may still hold the removed record.
+            if (hasOlderSegment && it == m_index.end())
+                success = appendFrame(header, Data::empty(), location);
+            return;
+        }
+
+        bool isLive = it != m_index.end() && it->value.segmentNumber == segmentNumber && it->value.frameOffset == frameOffset;
+        if (!isLive)
+            return;
+
+        // Moving the record is a chance to store the time it was last retrieved.
+        SegmentFrameHeader movedHeader = header;
+        movedHeader.epochRelativeAccessTime = epochRelativeTime(it->value.accessTime);
+        auto record = segmentData.subrange(frameOffset + frameSize - header.recordSize, header.recordSize);
+        success = appendFrame(movedHeader, record, location);
+        if (success)
+            addToIndex(location);
+    });
+
+    // Records that couldn't be moved are still in the segment.
+    if (!success)
+        return;
+
+    m_segments.remove(segmentNumber);
+    unlink(path.data());
+
+    LOG(NetworkCacheStorage, "(NetworkProcess) compacted segment %u", segmentNumber);
+}
+
+}
+}
+
+#endif
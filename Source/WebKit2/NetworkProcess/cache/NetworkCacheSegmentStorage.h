@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. AND ITS CONTRIBUTORS ``AS IS''
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL APPLE INC. OR ITS CONTRIBUTORS
+ * BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef NetworkCacheSegmentStorage_h
+#define NetworkCacheSegmentStorage_h
+
+#if ENABLE(NETWORK_CACHE)
+
+#include "NetworkCacheData.h"
+#include "NetworkCacheFileSystem.h"
+#include "NetworkCacheKey.h"
+#include <wtf/HashMap.h>
+#include <wtf/Lock.h>
+#include <wtf/Vector.h>
+
+namespace WebKit {
+namespace NetworkCache {
+
+struct SegmentFrameHeader;
+
+// SegmentStorage packs the records into a few append-only segment files instead of giving each its
+// own file. Records are found through an in-memory index that is rebuilt by scanning the segments on
+// synchronization. Removing a record appends a tombstone for it; the space taken by removed and
+// replaced records is reclaimed by compaction, which moves the live records of mostly dead segments
+// to the end of the active one.
+class SegmentStorage {
+    WTF_MAKE_NONCOPYABLE(SegmentStorage);
+public:
+    SegmentStorage(const String& segmentDirectoryPath);
+    ~SegmentStorage();
+
+    struct RecordInfo {
+        Key::HashType hash;
+        size_t size;
+        // Creation is when the record was stored, modification when it was last retrieved.
+        FileTimes times;
+    };
+
+    // These are all synchronous and should not be used from the main thread.
+    bool add(const Key::HashType&, const Data&);
+    // The record is mapped from its segment.
+    Data get(const Key::HashType&);
+    void remove(const Key::HashType&);
+    void markAccessed(const Key::HashType&);
+    void clear();
+
+    Vector<RecordInfo> records() const;
+
+    void synchronize();
+    void compactIfNeeded();
+
+    size_t approximateSize() const { return m_approximateSize; }
+
+private:
+    struct Location {
+        Key::HashType hash;
+        unsigned segmentNumber;
+        uint64_t frameOffset;
+        uint64_t frameSize;
+        // The record ends the frame.
+        uint64_t recordSize;
+        std::chrono::system_clock::time_point creationTime;
+        std::chrono::system_clock::time_point accessTime;
+    };
+
+    struct Segment {
+        uint64_t size { 0 };
+        // Bytes taken by the frames of the indexed records.
+        uint64_t liveSize { 0 };
+    };
+
+    String segmentDirectoryPath() const;
+    String segmentPath(unsigned segmentNumber) const;
+
+    bool openActiveSegment(size_t frameSize);
+    void closeActiveSegment();
+    bool appendFrame(const SegmentFrameHeader&, const Data& record, Location&);
+    void addToIndex(const Location&);
+    void removeFromIndex(uint64_t indexKey);
+    void compactSegment(unsigned segmentNumber);
+
+    const String m_segmentDirectoryPath;
+
+    mutable Lock m_lock;
+    HashMap<uint64_t, Location> m_index;
+    // Segment numbers start from 1.
+    HashMap<unsigned, Segment> m_segments;
+    unsigned m_activeSegmentNumber { 0 };
+    int m_activeSegmentFileDescriptor { -1 };
+    unsigned m_nextSegmentNumber { 1 };
+
+    std::atomic<size_t> m_approximateSize { 0 };
+};
+
+}
+}
+
+#endif
+#endif
@@ -47,8 +47,7 @@ SpeculativeLoad::SpeculativeLoad(const GlobalFrameID& frameID, const ResourceReq
     , m_bufferedDataForCache(SharedBuffer::create())
     , m_cacheEntryForValidation(WTF::move(cacheEntryForValidation))
 {
-    ASSERT(m_cacheEntryForValidation);
-    ASSERT(m_cacheEntryForValidation->needsValidation());
+    ASSERT(!m_cacheEntryForValidation || m_cacheEntryForValidation->needsValidation());
 
     NetworkLoadParameters parameters;
     parameters.sessionID = SessionID::defaultSessionID();
@@ -75,9 +74,7 @@ auto SpeculativeLoad::didReceiveResponse(const ResourceResponse& receivedRespons
     if (m_response.isMultipart())
         m_bufferedDataForCache = nullptr;
 
-    ASSERT(m_cacheEntryForValidation);
-
-    bool validationSucceeded = m_response.httpStatusCode() == 304; // 304 Not Modified
+    bool validationSucceeded = m_cacheEntryForValidation && m_response.httpStatusCode() == 304; // 304 Not Modified
     if (validationSucceeded) {
         m_cacheEntryForValidation = NetworkCache::singleton().update(m_originalRequest, m_frameID, *m_cacheEntryForValidation, m_response);
         didComplete();
@@ -32,7 +32,9 @@
 #include "NetworkCacheEntry.h"
 #include "NetworkCacheSpeculativeLoad.h"
 #include "NetworkCacheSubresourcesEntry.h"
+#include <WebCore/DNS.h>
 #include <WebCore/HysteresisActivity.h>
+#include <wtf/HashSet.h>
 #include <wtf/NeverDestroyed.h>
 #include <wtf/RunLoop.h>
 
@@ -56,6 +58,11 @@ static inline Key makeSubresourcesKey(const Key& resourceKey)
     return Key(resourceKey.partition(), subresourcesType(), resourceKey.range(), resourceKey.identifier());
 }
 
+static inline String hostForKey(const Key& key)
+{
+    return URL(ParsedURLString, key.identifier()).host();
+}
+
 static inline ResourceRequest constructRevalidationRequest(const Entry& entry)
 {
     ResourceRequest revalidationRequest(entry.key().identifier());
@@ -114,34 +121,74 @@ class SpeculativeLoadManager::PendingFrameLoad {
 public:
     PendingFrameLoad(const Key& mainResourceKey, std::function<void()>&& completionHandler)
         : m_mainResourceKey(mainResourceKey)
+        , m_mainResourceHost(hostForKey(mainResourceKey))
         , m_completionHandler(WTF::move(completionHandler))
         , m_loadHysteresisActivity([this](HysteresisState state) { if (state == HysteresisState::Stopped) m_completionHandler(); })
     { }
 
-    void registerSubresource(const Key& subresourceKey)
+    const Key& mainResourceKey() const { return m_mainResourceKey; }
+    const String& mainResourceHost() const { return m_mainResourceHost; }
+
+    // Hosts whose DNS was prefetched for this load, and the hosts subresources ended up coming from.
+    const HashSet<String>& predictedHosts() const { return m_predictedHosts; }
+    const HashSet<String>& requestedHosts() const { return m_requestedHosts; }
+    void setPredictedHosts(HashSet<String>&& hosts) { m_predictedHosts = WTF::move(hosts); }
+
+    void registerSubresource(const Key& subresourceKey, ResourceLoadPriority priority, bool isPreloadHint)
     {
         ASSERT(RunLoop::isMain());
-        m_subresourceKeys.add(subresourceKey);
+        String host = hostForKey(subresourceKey);
+        if (host != m_mainResourceHost)
+            m_requestedHosts.add(host);
+        auto addResult = m_subresources.add(subresourceKey, SubresourceInfo(subresourceKey, priority, isPreloadHint));
+        if (!addResult.isNewEntry) {
+            // A preloaded resource is requested again when the page actually uses it.
+            auto& existing = addResult.iterator->value;
+            existing = SubresourceInfo(subresourceKey, std::max(existing.priority(), priority), existing.isPreloadHint() || isPreloadHint);
+        }
         m_loadHysteresisActivity.impulse();
     }
 
+    void setPreviousSubresourcesEntry(std::unique_ptr<SubresourcesEntry> entry)
+    {
+        ASSERT(RunLoop::isMain());
+        m_previousSubresourcesEntry = WTF::move(entry);
+    }
+
     Optional<Storage::Record> encodeAsSubresourcesRecord()
     {
         ASSERT(RunLoop::isMain());
-        if (m_subresourceKeys.isEmpty())
+        if (m_subresources.isEmpty())
             return { };
 
         auto subresourcesStorageKey = makeSubresourcesKey(m_mainResourceKey);
-        Vector<Key> subresourceKeys;
-        copyToVector(m_subresourceKeys, subresourceKeys);
+        Vector<SubresourceInfo> subresources;
+
+        // Score the list we speculated from against what this load actually requested.
+        if (m_previousSubresourcesEntry) {
+            for (auto& previousSubresource : m_previousSubresourcesEntry->subresources()) {
+                auto it = m_subresources.find(previousSubresource.key());
+                if (it != m_subresources.end()) {
+                    it->value.mergeCountsFrom(previousSubresource);
+                    it->value.recordHit();
+                    continue;
+                }
+                SubresourceInfo missedSubresource = previousSubresource;
+                missedSubresource.recordMiss();
+                if (!missedSubresource.shouldBeForgotten())
+                    subresources.append(WTF::move(missedSubresource));
+            }
+        }
+        for (auto& subresource : m_subresources.values())
+            subresources.append(subresource);
 
 #if !LOG_DISABLED
         LOG(NetworkCacheSpeculativePreloading, "(NetworkProcess) Saving to disk list of subresources for '%s':", m_mainResourceKey.identifier().utf8().data());
-        for (auto& subresourceKey : subresourceKeys)
-            LOG(NetworkCacheSpeculativePreloading, "(NetworkProcess) * Subresource: '%s'.", subresourceKey.identifier().utf8().data());
+        for (auto& subresource : subresources)
+            LOG(NetworkCacheSpeculativePreloading, "(NetworkProcess) * Subresource: '%s' priority %d%s, used %u, missed %u.", subresource.key().identifier().utf8().data(), static_cast<int>(subresource.priority()), subresource.isPreloadHint() ? " (preload hint)" : "", subresource.hitCount(), subresource.missCount());
 #endif
 
-        return SubresourcesEntry(subresourcesStorageKey, WTF::move(subresourceKeys)).encodeAsStorageRecord();
+        return SubresourcesEntry(subresourcesStorageKey, WTF::move(subresources)).encodeAsStorageRecord();
     }
 
     void markAsCompleted()
@@ -152,7 +199,11 @@ public:
 
 private:
     Key m_mainResourceKey;
-    HashSet<Key> m_subresourceKeys;
+    String m_mainResourceHost;
+    HashMap<Key, SubresourceInfo> m_subresources;
+    HashSet<String> m_predictedHosts;
+    HashSet<String> m_requestedHosts;
+    std::unique_ptr<SubresourcesEntry> m_previousSubresourcesEntry;
     std::function<void()> m_completionHandler;
     HysteresisActivity m_loadHysteresisActivity;
 };
@@ -205,6 +256,7 @@ void SpeculativeLoadManager::registerLoad(const GlobalFrameID& frameID, const Re
         // Start tracking loads in this frame.
         m_pendingFrameLoads.add(frameID, std::make_unique<PendingFrameLoad>(resourceKey, [this, frameID]() {
             auto frameLoad = m_pendingFrameLoads.take(frameID);
+            recordHostPredictionAccuracy(*frameLoad);
             auto optionalRecord = frameLoad->encodeAsSubresourcesRecord();
             if (!optionalRecord)
                 return;
@@ -214,7 +266,31 @@ void SpeculativeLoadManager::registerLoad(const GlobalFrameID& frameID, const Re
     }
 
     if (auto* pendingFrameLoad = m_pendingFrameLoads.get(frameID))
-        pendingFrameLoad->registerSubresource(resourceKey);
+        pendingFrameLoad->registerSubresource(resourceKey, request.priority(), request.requester() == ResourceRequest::Requester::Preload);
+}
+
+void SpeculativeLoadManager::recordHostPredictionAccuracy(const PendingFrameLoad& frameLoad)
+{
+    auto& predictedHosts = frameLoad.predictedHosts();
+    if (predictedHosts.isEmpty())
+        return;
+
+    auto& requestedHosts = frameLoad.requestedHosts();
+    unsigned usedCount = 0;
+    for (auto& host : predictedHosts) {
+        if (requestedHosts.contains(host))
+            ++usedCount;
+    }
+    unsigned unpredictedCount = requestedHosts.size() - usedCount;
+
+    m_predictedHostCount += predictedHosts.size();
+    m_usedPredictedHostCount += usedCount;
+    m_unpredictedHostCount += unpredictedCount;
+
+    LOG(NetworkCacheSpeculativePreloading, "(NetworkProcess) DNS prefetch for '%s': %u of %u predicted hosts used, %u hosts not predicted. Overall precision %u%%, recall %u%%.",
+        frameLoad.mainResourceKey().identifier().utf8().data(), usedCount, predictedHosts.size(), unpredictedCount,
+        100 * m_usedPredictedHostCount / m_predictedHostCount,
+        m_usedPredictedHostCount + m_unpredictedHostCount ? 100 * m_usedPredictedHostCount / (m_usedPredictedHostCount + m_unpredictedHostCount) : 100);
 }
 
 void SpeculativeLoadManager::addPreloadedEntry(std::unique_ptr<Entry> entry)
@@ -227,9 +303,9 @@ void SpeculativeLoadManager::addPreloadedEntry(std::unique_ptr<Entry> entry)
     }));
 }
 
-void SpeculativeLoadManager::retrieveEntryFromStorage(const Key& key, const RetrieveCompletionHandler& completionHandler)
+void SpeculativeLoadManager::retrieveEntryFromStorage(const Key& key, ResourceLoadPriority priority, const RetrieveCompletionHandler& completionHandler)
 {
-    m_storage.retrieve(key, static_cast<unsigned>(ResourceLoadPriority::Medium), [completionHandler](std::unique_ptr<Storage::Record> record) {
+    m_storage.retrieve(key, static_cast<unsigned>(priority), [completionHandler](std::unique_ptr<Storage::Record> record) {
         if (!record) {
             completionHandler(nullptr);
             return false;
@@ -241,13 +317,14 @@ void SpeculativeLoadManager::retrieveEntryFromStorage(const Key& key, const Retr
         }
 
         auto& response = entry->response();
-        if (!response.hasCacheValidatorFields()) {
-            completionHandler(nullptr);
-            return true;
-        }
-
-        if (responseNeedsRevalidation(response, entry->timeStamp()))
+        if (responseNeedsRevalidation(response, entry->timeStamp())) {
+            // Without validators, the entry is no use and the resource has to be fetched again.
+            if (!response.hasCacheValidatorFields()) {
+                completionHandler(nullptr);
+                return true;
+            }
             entry->setNeedsValidation();
+        }
 
         completionHandler(WTF::move(entry));
         return true;
@@ -273,30 +350,70 @@ void SpeculativeLoadManager::revalidateEntry(std::unique_ptr<Entry> entry, const
 
     auto key = entry->key();
     LOG(NetworkCacheSpeculativePreloading, "(NetworkProcess) Speculatively revalidating '%s':", key.identifier().utf8().data());
-    auto revalidator = std::make_unique<SpeculativeLoad>(frameID, constructRevalidationRequest(*entry), WTF::move(entry), [this, key](std::unique_ptr<Entry> revalidatedEntry) {
-        ASSERT(!revalidatedEntry || !revalidatedEntry->needsValidation());
-        auto protectRevalidator = m_pendingPreloads.take(key);
-        LOG(NetworkCacheSpeculativePreloading, "(NetworkProcess) Speculative revalidation completed for '%s':", key.identifier().utf8().data());
+    auto revalidationRequest = constructRevalidationRequest(*entry);
+    startSpeculativeLoad(key, revalidationRequest, WTF::move(entry), frameID);
+}
+
+void SpeculativeLoadManager::fetchEntry(const SubresourceInfo& subresource, const GlobalFrameID& frameID, const URL& firstPartyForCookies)
+{
+    auto& key = subresource.key();
+    LOG(NetworkCacheSpeculativePreloading, "(NetworkProcess) Speculatively fetching '%s':", key.identifier().utf8().data());
+
+    ResourceRequest request(key.identifier());
+    request.setFirstPartyForCookies(firstPartyForCookies);
+    request.setPriority(subresource.priority());
+    startSpeculativeLoad(key, request, nullptr, frameID);
+}
+
+void SpeculativeLoadManager::startSpeculativeLoad(const Key& key, const ResourceRequest& request, std::unique_ptr<Entry> entryToValidate, const GlobalFrameID& frameID)
+{
+    auto speculativeLoad = std::make_unique<SpeculativeLoad>(frameID, request, WTF::move(entryToValidate), [this, key](std::unique_ptr<Entry> loadedEntry) {
+        ASSERT(!loadedEntry || !loadedEntry->needsValidation());
+        auto protectSpeculativeLoad = m_pendingPreloads.take(key);
+        LOG(NetworkCacheSpeculativePreloading, "(NetworkProcess) Speculative load completed for '%s':", key.identifier().utf8().data());
 
-        if (satisfyPendingRequests(key, revalidatedEntry.get()))
+        if (satisfyPendingRequests(key, loadedEntry.get()))
             return;
 
-        if (revalidatedEntry)
-            addPreloadedEntry(WTF::move(revalidatedEntry));
+        if (loadedEntry)
+            addPreloadedEntry(WTF::move(loadedEntry));
     });
-    m_pendingPreloads.add(key, WTF::move(revalidator));
+    m_pendingPreloads.add(key, WTF::move(speculativeLoad));
+}
+
+static bool canFetchSpeculatively(const SubresourceInfo& subresource)
+{
+    // Only resources the preload scanner found are worth a network load ahead of the page,
+    // and only while they keep being used.
+    if (!subresource.isPreloadHint() || !subresource.isLikelyToBeUsed())
+        return false;
+
+    // We can't reconstruct partitioned or range requests from the key, so the response
+    // would be stored under a different key than the one the page will look up.
+    auto& key = subresource.key();
+    return key.partition() == "No partition" && key.range().isEmpty();
 }
 
-void SpeculativeLoadManager::preloadEntry(const Key& key, const GlobalFrameID& frameID)
+void SpeculativeLoadManager::preloadEntry(const SubresourceInfo& subresource, const GlobalFrameID& frameID, const URL& firstPartyForCookies)
 {
+    auto& key = subresource.key();
+    if (m_pendingPreloads.contains(key) || m_preloadedEntries.contains(key))
+        return;
+
     m_pendingPreloads.add(key, nullptr);
-    retrieveEntryFromStorage(key, [this, key, frameID](std::unique_ptr<Entry> entry) {
+    retrieveEntryFromStorage(key, subresource.priority(), [this, subresource, frameID, firstPartyForCookies](std::unique_ptr<Entry> entry) {
+        auto& key = subresource.key();
         m_pendingPreloads.remove(key);
 
-        if (satisfyPendingRequests(key, entry.get()))
+        if (!entry) {
+            if (canFetchSpeculatively(subresource))
+                fetchEntry(subresource, frameID, firstPartyForCookies);
+            else
+                satisfyPendingRequests(key, nullptr);
             return;
+        }
 
-        if (!entry)
+        if (satisfyPendingRequests(key, entry.get()))
             return;
 
         if (entry->needsValidation())
@@ -312,8 +429,9 @@ void SpeculativeLoadManager::startSpeculativeRevalidation(const ResourceRequest&
         return;
 
     auto subresourcesStorageKey = makeSubresourcesKey(storageKey);
+    URL firstPartyForCookies = originalRequest.firstPartyForCookies();
 
-    m_storage.retrieve(subresourcesStorageKey, static_cast<unsigned>(ResourceLoadPriority::Medium), [this, frameID](std::unique_ptr<Storage::Record> record) {
+    m_storage.retrieve(subresourcesStorageKey, static_cast<unsigned>(ResourceLoadPriority::Medium), [this, frameID, storageKey, firstPartyForCookies](std::unique_ptr<Storage::Record> record) {
         if (!record)
             return false;
 
@@ -321,8 +439,40 @@ void SpeculativeLoadManager::startSpeculativeRevalidation(const ResourceRequest&
         if (!subresourcesEntry)
             return false;
 
-        for (auto& subresourceKey : subresourcesEntry->subresourceKeys())
-            preloadEntry(subresourceKey, frameID);
+        // Start the loads the page needs first, first.
+        Vector<SubresourceInfo> subresources = subresourcesEntry->subresources();
+        std::stable_sort(subresources.begin(), subresources.end(), [](const SubresourceInfo& a, const SubresourceInfo& b) {
+            return a.priority() > b.priority();
+        });
+
+        // Resolve the other hosts the page is expected to load from while the main resource is still loading,
+        // so the subresource loads that miss the cache do not wait on DNS.
+        String mainResourceHost = hostForKey(storageKey);
+        HashSet<String> predictedHosts;
+        for (auto& subresource : subresources) {
+            if (!subresource.isLikelyToBeUsed())
+                continue;
+            String host = hostForKey(subresource.key());
+            if (host.isEmpty() || host == mainResourceHost || !predictedHosts.add(host).isNewEntry)
+                continue;
+            LOG(NetworkCacheSpeculativePreloading, "(NetworkProcess) Prefetching DNS for '%s'.", host.utf8().data());
+            prefetchDNS(host);
+        }
+
+        for (auto& subresource : subresources) {
+            if (!subresource.isLikelyToBeUsed()) {
+                LOG(NetworkCacheSpeculativePreloading, "(NetworkProcess) Not preloading '%s', it was used by %u of the last %u loads.", subresource.key().identifier().utf8().data(), subresource.hitCount(), subresource.hitCount() + subresource.missCount());
+                continue;
+            }
+            preloadEntry(subresource, frameID, firstPartyForCookies);
+        }
+
+        // The frame load scores this list, and the hosts predicted from it, against what it ends up requesting.
+        auto* pendingFrameLoad = m_pendingFrameLoads.get(frameID);
+        if (pendingFrameLoad && pendingFrameLoad->mainResourceKey() == storageKey) {
+            pendingFrameLoad->setPreviousSubresourcesEntry(WTF::move(subresourcesEntry));
+            pendingFrameLoad->setPredictedHosts(WTF::move(predictedHosts));
+        }
 
         return true;
     });
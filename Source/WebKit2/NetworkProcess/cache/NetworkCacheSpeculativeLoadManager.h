@@ -40,6 +40,7 @@ namespace NetworkCache {
 
 class Entry;
 class SpeculativeLoad;
+class SubresourceInfo;
 
 class SpeculativeLoadManager {
 public:
@@ -55,14 +56,18 @@ public:
 
 private:
     void addPreloadedEntry(std::unique_ptr<Entry>);
-    void preloadEntry(const Key&, const GlobalFrameID&);
-    void retrieveEntryFromStorage(const Key&, const RetrieveCompletionHandler&);
+    void preloadEntry(const SubresourceInfo&, const GlobalFrameID&, const WebCore::URL& firstPartyForCookies);
+    void retrieveEntryFromStorage(const Key&, WebCore::ResourceLoadPriority, const RetrieveCompletionHandler&);
     void revalidateEntry(std::unique_ptr<Entry>, const GlobalFrameID&);
+    void fetchEntry(const SubresourceInfo&, const GlobalFrameID&, const WebCore::URL& firstPartyForCookies);
+    void startSpeculativeLoad(const Key&, const WebCore::ResourceRequest&, std::unique_ptr<Entry> entryToValidate, const GlobalFrameID&);
     bool satisfyPendingRequests(const Key&, Entry*);
 
+    class PendingFrameLoad;
+    void recordHostPredictionAccuracy(const PendingFrameLoad&);
+
     Storage& m_storage;
 
-    class PendingFrameLoad;
     HashMap<GlobalFrameID, std::unique_ptr<PendingFrameLoad>> m_pendingFrameLoads;
 
     HashMap<Key, std::unique_ptr<SpeculativeLoad>> m_pendingPreloads;
@@ -70,6 +75,11 @@ private:
 
     class PreloadedEntry;
     HashMap<Key, std::unique_ptr<PreloadedEntry>> m_preloadedEntries;
+
+    // Totals of hosts whose DNS was prefetched, how many of those were used, and used hosts that were not predicted.
+    unsigned m_predictedHostCount { 0 };
+    unsigned m_usedPredictedHostCount { 0 };
+    unsigned m_unpredictedHostCount { 0 };
 };
 
 } // namespace NetworkCache
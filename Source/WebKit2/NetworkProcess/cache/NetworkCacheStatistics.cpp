@@ -30,6 +30,7 @@
 
 #include "Logging.h"
 #include "NetworkCache.h"
+#include "NetworkCacheEntry.h"
 #include "NetworkCacheFileSystem.h"
 #include "NetworkProcess.h"
 #include <WebCore/DiagnosticLoggingKeys.h>
@@ -95,8 +96,7 @@ void Statistics::initialize(const String& databasePath)
     auto startTime = std::chrono::system_clock::now();
 
     StringCapture databasePathCapture(databasePath);
-    StringCapture networkCachePathCapture(singleton().recordsPath());
-    serialBackgroundIOQueue().dispatch([this, databasePathCapture, networkCachePathCapture, startTime] {
+    serialBackgroundIOQueue().dispatch([this, databasePathCapture, startTime] {
         WebCore::SQLiteTransactionInProgressAutoCounter transactionCounter;
 
         String databasePath = databasePathCapture.string();
@@ -128,40 +128,42 @@ void Statistics::initialize(const String& databasePath)
         LOG(NetworkCache, "(NetworkProcess) Network cache statistics database load complete, entries=%lu time=%" PRIi64 "ms", static_cast<size_t>(m_approximateEntryCount), elapsedMS);
 
         if (!m_approximateEntryCount) {
-            bootstrapFromNetworkCache(networkCachePathCapture.string());
-#if !LOG_DISABLED
-            elapsedMS = static_cast<int64_t>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now() - startTime).count());
-#endif
-            LOG(NetworkCache, "(NetworkProcess) Network cache statistics database bootstrapping complete, entries=%lu time=%" PRIi64 "ms", static_cast<size_t>(m_approximateEntryCount), elapsedMS);
+            RunLoop::main().dispatch([this] {
+                bootstrapFromNetworkCache();
+            });
         }
     });
 }
 
-void Statistics::bootstrapFromNetworkCache(const String& networkCachePath)
+void Statistics::bootstrapFromNetworkCache()
 {
-    ASSERT(!RunLoop::isMain());
+    ASSERT(RunLoop::isMain());
+
+    if (!singleton().isEnabled())
+        return;
 
     LOG(NetworkCache, "(NetworkProcess) Bootstrapping the network cache statistics database from the network cache...");
 
+    // Records are packed in cache segments so the hashes have to come from the cache itself.
     Vector<StringCapture> hashes;
-    traverseRecordsFiles(networkCachePath, ASCIILiteral("resource"), [&hashes](const String& fileName, const String& hashString, const String& type, bool isBodyBlob, const String& recordDirectoryPath) {
-        if (isBodyBlob)
-            return;
-
-        Key::HashType hash;
-        if (!Key::stringToHash(hashString, hash))
+    singleton().traverse([this, hashes](const Entry* entry) mutable {
+        if (entry) {
+            hashes.append(entry->key().hashAsString());
             return;
+        }
 
-        hashes.append(hashString);
-    });
+        serialBackgroundIOQueue().dispatch([this, hashes] {
+            WebCore::SQLiteTransactionInProgressAutoCounter transactionCounter;
+            WebCore::SQLiteTransaction writeTransaction(m_database);
+            writeTransaction.begin();
 
-    WebCore::SQLiteTransactionInProgressAutoCounter transactionCounter;
-    WebCore::SQLiteTransaction writeTransaction(m_database);
-    writeTransaction.begin();
+            addHashesToDatabase(hashes);
 
-    addHashesToDatabase(hashes);
+            writeTransaction.commit();
 
-    writeTransaction.commit();
+            LOG(NetworkCache, "(NetworkProcess) Network cache statistics database bootstrapping complete, entries=%lu", static_cast<size_t>(m_approximateEntryCount));
+        });
+    });
 }
 
 void Statistics::shrinkIfNeeded()
@@ -176,11 +178,7 @@ void Statistics::shrinkIfNeeded()
 
     clear();
 
-    StringCapture networkCachePathCapture(singleton().recordsPath());
-    serialBackgroundIOQueue().dispatch([this, networkCachePathCapture] {
-        bootstrapFromNetworkCache(networkCachePathCapture.string());
-        LOG(NetworkCache, "(NetworkProcess) statistics cache shrink completed m_approximateEntryCount=%lu", static_cast<size_t>(m_approximateEntryCount));
-    });
+    bootstrapFromNetworkCache();
 }
 
 void Statistics::recordRetrievalRequest(uint64_t webPageID)
@@ -317,6 +315,21 @@ void Statistics::recordRevalidationSuccess(uint64_t webPageID, const Key& key, c
     NetworkProcess::singleton().logDiagnosticMessageWithResult(webPageID, WebCore::DiagnosticLoggingKeys::networkCacheKey(), WebCore::DiagnosticLoggingKeys::revalidatingKey(), WebCore::DiagnosticLoggingResultPass, WebCore::ShouldSample::Yes);
 }
 
+void Statistics::recordHotEntryCacheLookup(bool isHit)
+{
+    ASSERT(RunLoop::isMain());
+
+    ++m_hotEntryCacheLookupCount;
+    if (isHit)
+        ++m_hotEntryCacheHitCount;
+
+    const unsigned lookupCountBetweenReports = 100;
+    if (m_hotEntryCacheLookupCount % lookupCountBetweenReports)
+        return;
+
+    LOG(NetworkCache, "(NetworkProcess) hot entry cache hit rate %u%% (%u of %u lookups)", 100 * m_hotEntryCacheHitCount / m_hotEntryCacheLookupCount, m_hotEntryCacheHitCount, m_hotEntryCacheLookupCount);
+}
+
 void Statistics::markAsRequested(const String& hash)
 {
     ASSERT(RunLoop::isMain());
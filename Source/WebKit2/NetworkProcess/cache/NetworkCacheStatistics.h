@@ -53,6 +53,7 @@ public:
     void recordRetrievalFailure(uint64_t webPageID, const Key&, const WebCore::ResourceRequest&);
     void recordRetrievedCachedEntry(uint64_t webPageID, const Key&, const WebCore::ResourceRequest&, UseDecision);
     void recordRevalidationSuccess(uint64_t webPageID, const Key&, const WebCore::ResourceRequest&);
+    void recordHotEntryCacheLookup(bool isHit);
 
 private:
     explicit Statistics(const String& databasePath);
@@ -60,7 +61,7 @@ private:
     WorkQueue& serialBackgroundIOQueue() { return m_serialBackgroundIOQueue.get(); }
 
     void initialize(const String& databasePath);
-    void bootstrapFromNetworkCache(const String& networkCachePath);
+    void bootstrapFromNetworkCache();
     void shrinkIfNeeded();
 
     void addHashesToDatabase(const Vector<StringCapture>& hashes);
@@ -80,6 +81,9 @@ private:
 
     std::atomic<size_t> m_approximateEntryCount { 0 };
 
+    unsigned m_hotEntryCacheLookupCount { 0 };
+    unsigned m_hotEntryCacheHitCount { 0 };
+
     mutable Ref<WorkQueue> m_serialBackgroundIOQueue;
     mutable HashSet<std::unique_ptr<const EverRequestedQuery>> m_activeQueries;
     WebCore::SQLiteDatabase m_database;
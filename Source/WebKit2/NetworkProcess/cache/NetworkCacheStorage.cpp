@@ -31,8 +31,11 @@
 #include "Logging.h"
 #include "NetworkCacheCoders.h"
 #include "NetworkCacheFileSystem.h"
-#include "NetworkCacheIOChannel.h"
+#include <cstdio>
+#include <fcntl.h>
 #include <mutex>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <wtf/Condition.h>
 #include <wtf/Lock.h>
 #include <wtf/RandomNumber.h>
@@ -46,7 +49,9 @@ namespace NetworkCache {
 static const char versionDirectoryPrefix[] = "Version ";
 static const char recordsDirectoryName[] = "Records";
 static const char blobsDirectoryName[] = "Blobs";
+static const char segmentsDirectoryName[] = "Segments";
 static const char blobSuffix[] = "-blob";
+static const char contentsFiltersFileName[] = "ContentsFilters";
 
 static double computeRecordWorth(FileTimes);
 
@@ -153,50 +158,9 @@ static String makeBlobDirectoryPath(const String& baseDirectoryPath)
     return WebCore::pathByAppendingComponent(makeVersionedDirectoryPath(baseDirectoryPath), blobsDirectoryName);
 }
 
-void traverseRecordsFiles(const String& recordsPath, const String& expectedType, const std::function<void (const String& fileName, const String& hashString, const String& type, bool isBlob, const String& recordDirectoryPath)>& function)
+static String makeSegmentsDirectoryPath(const String& baseDirectoryPath)
 {
-    traverseDirectory(recordsPath, [&recordsPath, &function, &expectedType](const String& partitionName, DirectoryEntryType entryType) {
-        if (entryType != DirectoryEntryType::Directory)
-            return;
-        String partitionPath = WebCore::pathByAppendingComponent(recordsPath, partitionName);
-        traverseDirectory(partitionPath, [&function, &partitionPath, &expectedType](const String& actualType, DirectoryEntryType entryType) {
-            if (entryType != DirectoryEntryType::Directory)
-                return;
-            if (!expectedType.isEmpty() && expectedType != actualType)
-                return;
-            String recordDirectoryPath = WebCore::pathByAppendingComponent(partitionPath, actualType);
-            traverseDirectory(recordDirectoryPath, [&function, &recordDirectoryPath, &actualType](const String& fileName, DirectoryEntryType entryType) {
-                if (entryType != DirectoryEntryType::File || fileName.length() < Key::hashStringLength())
-                    return;
-
-                String hashString = fileName.substring(0, Key::hashStringLength());
-                auto isBlob = fileName.length() > Key::hashStringLength() && fileName.endsWith(blobSuffix);
-                function(fileName, hashString, actualType, isBlob, recordDirectoryPath);
-            });
-        });
-    });
-}
-
-static void deleteEmptyRecordsDirectories(const String& recordsPath)
-{
-    traverseDirectory(recordsPath, [&recordsPath](const String& partitionName, DirectoryEntryType type) {
-        if (type != DirectoryEntryType::Directory)
-            return;
-
-        // Delete [type] sub-folders.
-        String partitionPath = WebCore::pathByAppendingComponent(recordsPath, partitionName);
-        traverseDirectory(partitionPath, [&partitionPath](const String& subdirName, DirectoryEntryType entryType) {
-            if (entryType != DirectoryEntryType::Directory)
-                return;
-
-            // Let system figure out if it is really empty.
-            WebCore::deleteEmptyDirectory(WebCore::pathByAppendingComponent(partitionPath, subdirName));
-        });
-
-        // Delete [Partition] folders.
-        // Let system figure out if it is really empty.
-        WebCore::deleteEmptyDirectory(WebCore::pathByAppendingComponent(recordsPath, partitionName));
-    });
+    return WebCore::pathByAppendingComponent(makeVersionedDirectoryPath(baseDirectoryPath), segmentsDirectoryName);
 }
 
 Storage::Storage(const String& baseDirectoryPath)
@@ -204,10 +168,12 @@ Storage::Storage(const String& baseDirectoryPath)
     , m_recordsPath(makeRecordsDirectoryPath(baseDirectoryPath))
     , m_readOperationTimeoutTimer(*this, &Storage::cancelAllReadOperations)
     , m_writeOperationDispatchTimer(*this, &Storage::dispatchPendingWriteOperations)
+    , m_writeContentsFiltersTimer(*this, &Storage::writeContentsFilters)
     , m_ioQueue(WorkQueue::create("com.apple.WebKit.Cache.Storage", WorkQueue::Type::Concurrent))
     , m_backgroundIOQueue(WorkQueue::create("com.apple.WebKit.Cache.Storage.background", WorkQueue::Type::Concurrent, WorkQueue::QOS::Background))
     , m_serialBackgroundIOQueue(WorkQueue::create("com.apple.WebKit.Cache.Storage.serialBackground", WorkQueue::Type::Serial, WorkQueue::QOS::Background))
     , m_blobStorage(makeBlobDirectoryPath(baseDirectoryPath))
+    , m_segmentStorage(makeSegmentsDirectoryPath(baseDirectoryPath))
 {
     deleteOldVersions();
     synchronize();
@@ -232,9 +198,158 @@ String Storage::recordsPath() const
     return m_recordsPath.isolatedCopy();
 }
 
+String Storage::contentsFiltersPath() const
+{
+    return WebCore::pathByAppendingComponent(versionPath(), contentsFiltersFileName);
+}
+
 size_t Storage::approximateSize() const
 {
-    return m_approximateRecordsSize + m_blobStorage.approximateSize();
+    return std::max(m_segmentStorage.approximateSize() + m_blobStorage.approximateSize(), m_persistedApproximateSize);
+}
+
+Data Storage::encodeContentsFilters() const
+{
+    ASSERT(RunLoop::isMain());
+
+    if (!m_recordFilter || !m_blobFilter)
+        return { };
+
+    Encoder encoder;
+    encoder << static_cast<uint64_t>(approximateSize());
+    encoder.encodeFixedLengthData(m_recordFilter->data(), ContentsFilter::dataSize);
+    encoder.encodeFixedLengthData(m_blobFilter->data(), ContentsFilter::dataSize);
+    encoder.encodeChecksum();
+
+    return Data(encoder.buffer(), encoder.bufferSize());
+}
+
+static bool decodeContentsFilters(const Data& fileData, Storage::ContentsFilter& recordFilter, Storage::ContentsFilter& blobFilter, uint64_t& approximateSize)
+{
+    bool success = false;
+    fileData.apply([&](const uint8_t* data, size_t size) {
+        Decoder decoder(data, size);
+        if (!decoder.decode(approximateSize))
+            return false;
+        if (!decoder.decodeFixedLengthData(recordFilter.data(), Storage::ContentsFilter::dataSize))
+            return false;
+        if (!decoder.decodeFixedLengthData(blobFilter.data(), Storage::ContentsFilter::dataSize))
+            return false;
+        if (!decoder.verifyChecksum())
+            return false;
+        success = true;
+        return false;
+    });
+    return success;
+}
+
+static void writeFileAtomically(const String& path, const Data& data)
+{
+    // Write to a temporary file and rename it over the old one so a reader never sees a partial file.
+    static std::atomic<unsigned> temporaryFileCount;
+    auto temporaryPath = WebCore::fileSystemRepresentation(path + ".tmp" + String::number(++temporaryFileCount));
+    int fd = open(temporaryPath.data(), O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+        return;
+
+    bool success = true;
+    data.apply([fd, &success](const uint8_t* bytes, size_t size) {
+        while (size) {
+            ssize_t writtenSize = write(fd, bytes, size);
+            if (writtenSize < 0) {
+                if (errno == EINTR)
+                    continue;
+                success = false;
+                return false;
+            }
+            bytes += writtenSize;
+            size -= writtenSize;
+        }
+        return true;
+    });
+    close(fd);
+
+    if (!success || rename(temporaryPath.data(), WebCore::fileSystemRepresentation(path).data()) < 0)
+        unlink(temporaryPath.data());
+}
+
+void Storage::writeContentsFilters()
+{
+    ASSERT(RunLoop::isMain());
+
+    m_writeContentsFiltersTimer.stop();
+
+    auto contentsFiltersData = encodeContentsFilters();
+    if (contentsFiltersData.isNull())
+        return;
+
+    StringCapture pathCapture(contentsFiltersPath());
+    serialBackgroundIOQueue().dispatch([pathCapture, contentsFiltersData] {
+        writeFileAtomically(pathCapture.string(), contentsFiltersData);
+    });
+}
+
+void Storage::writeContentsFiltersSynchronously()
+{
+    ASSERT(RunLoop::isMain());
+
+    m_writeContentsFiltersTimer.stop();
+
+    auto contentsFiltersData = encodeContentsFilters();
+    if (contentsFiltersData.isNull())
+        return;
+
+    writeFileAtomically(contentsFiltersPath(), contentsFiltersData);
+}
+
+void Storage::contentsFiltersChanged()
+{
+    ASSERT(RunLoop::isMain());
+
+    if (m_writeContentsFiltersTimer.isActive())
+        return;
+    static const auto contentsFiltersWriteDelay = 60_s;
+    m_writeContentsFiltersTimer.startOneShot(contentsFiltersWriteDelay);
+}
+
+void Storage::loadContentsFilters()
+{
+    ASSERT(!RunLoop::isMain());
+
+    auto contentsFiltersData = mapFile(WebCore::fileSystemRepresentation(contentsFiltersPath()).data());
+    if (contentsFiltersData.isNull())
+        return;
+
+    auto recordFilter = std::make_unique<ContentsFilter>();
+    auto blobFilter = std::make_unique<ContentsFilter>();
+    uint64_t approximateSize;
+    if (!decodeContentsFilters(contentsFiltersData, *recordFilter, *blobFilter, approximateSize)) {
+        LOG(NetworkCacheStorage, "(NetworkProcess) contents filters decode failure");
+        return;
+    }
+
+    auto* recordFilterPtr = recordFilter.release();
+    auto* blobFilterPtr = blobFilter.release();
+    RunLoop::main().dispatch([this, recordFilterPtr, blobFilterPtr, approximateSize] {
+        auto recordFilter = std::unique_ptr<ContentsFilter>(recordFilterPtr);
+        auto blobFilter = std::unique_ptr<ContentsFilter>(blobFilterPtr);
+
+        // Synchronization may have completed first.
+        if (m_recordFilter)
+            return;
+
+        // These stay in the lists for the filters synchronization is building.
+        for (auto& hash : m_recordFilterHashesAddedDuringSynchronization)
+            recordFilter->add(hash);
+        for (auto& hash : m_blobFilterHashesAddedDuringSynchronization)
+            blobFilter->add(hash);
+
+        m_recordFilter = WTF::move(recordFilter);
+        m_blobFilter = WTF::move(blobFilter);
+        m_persistedApproximateSize = approximateSize;
+
+        LOG(NetworkCacheStorage, "(NetworkProcess) loaded contents filters approximateSize=%zu", m_persistedApproximateSize);
+    });
 }
 
 void Storage::synchronize()
@@ -247,40 +362,41 @@ void Storage::synchronize()
 
     LOG(NetworkCacheStorage, "(NetworkProcess) synchronizing cache");
 
-    backgroundIOQueue().dispatch([this] {
+    // Until the full traversal has rebuilt the filters, use the ones written out last time.
+    bool shouldLoadContentsFilters = !m_recordFilter;
+
+    backgroundIOQueue().dispatch([this, shouldLoadContentsFilters] {
+        if (shouldLoadContentsFilters)
+            loadContentsFilters();
+
+        m_segmentStorage.synchronize();
+
         auto recordFilter = std::make_unique<ContentsFilter>();
         auto blobFilter = std::make_unique<ContentsFilter>();
-        size_t recordsSize = 0;
-        unsigned count = 0;
-        String anyType;
-        traverseRecordsFiles(recordsPath(), anyType, [&recordFilter, &blobFilter, &recordsSize, &count](const String& fileName, const String& hashString, const String& type, bool isBlob, const String& recordDirectoryPath) {
-            auto filePath = WebCore::pathByAppendingComponent(recordDirectoryPath, fileName);
 
-            Key::HashType hash;
-            if (!Key::stringToHash(hashString, hash)) {
-                WebCore::deleteFile(filePath);
-                return;
-            }
-            long long fileSize = 0;
-            WebCore::getFileSize(filePath, fileSize);
-            if (!fileSize) {
-                WebCore::deleteFile(filePath);
+        auto records = m_segmentStorage.records();
+        for (auto& recordInfo : records)
+            recordFilter->add(recordInfo.hash);
+
+        // The records directory only holds the links to the body blobs.
+        auto recordsPath = this->recordsPath();
+        traverseDirectory(recordsPath, [&recordsPath, &blobFilter](const String& fileName, DirectoryEntryType type) {
+            if (type != DirectoryEntryType::File)
                 return;
-            }
+            auto filePath = WebCore::pathByAppendingComponent(recordsPath, fileName);
 
-            if (isBlob) {
-                blobFilter->add(hash);
+            Key::HashType hash;
+            bool isBlob = fileName.length() > Key::hashStringLength() && fileName.endsWith(blobSuffix);
+            if (!isBlob || !Key::stringToHash(fileName.substring(0, Key::hashStringLength()), hash)) {
+                WebCore::deleteFile(filePath);
                 return;
             }
-
-            recordFilter->add(hash);
-            recordsSize += fileSize;
-            ++count;
+            blobFilter->add(hash);
         });
 
         auto* recordFilterPtr = recordFilter.release();
         auto* blobFilterPtr = blobFilter.release();
-        RunLoop::main().dispatch([this, recordFilterPtr, blobFilterPtr, recordsSize] {
+        RunLoop::main().dispatch([this, recordFilterPtr, blobFilterPtr] {
             auto recordFilter = std::unique_ptr<ContentsFilter>(recordFilterPtr);
             auto blobFilter = std::unique_ptr<ContentsFilter>(blobFilterPtr);
 
@@ -294,15 +410,19 @@ void Storage::synchronize()
 
             m_recordFilter = WTF::move(recordFilter);
             m_blobFilter = WTF::move(blobFilter);
-            m_approximateRecordsSize = recordsSize;
             m_synchronizationInProgress = false;
         });
 
         m_blobStorage.synchronize();
 
-        deleteEmptyRecordsDirectories(recordsPath());
+        m_segmentStorage.compactIfNeeded();
+
+        RunLoop::main().dispatch([this] {
+            m_persistedApproximateSize = 0;
+            writeContentsFilters();
+        });
 
-        LOG(NetworkCacheStorage, "(NetworkProcess) cache synchronization completed size=%zu count=%u", recordsSize, count);
+        LOG(NetworkCacheStorage, "(NetworkProcess) cache synchronization completed size=%zu count=%zu", m_segmentStorage.approximateSize(), records.size());
     });
 }
 
@@ -310,8 +430,10 @@ void Storage::addToRecordFilter(const Key& key)
 {
     ASSERT(RunLoop::isMain());
 
-    if (m_recordFilter)
+    if (m_recordFilter) {
         m_recordFilter->add(key.hash());
+        contentsFiltersChanged();
+    }
 
     // If we get new entries during filter synchronization take care to add them to the new filter as well.
     if (m_synchronizationInProgress)
@@ -330,26 +452,9 @@ bool Storage::mayContainBlob(const Key& key) const
     return !m_blobFilter || m_blobFilter->mayContain(key.hash());
 }
 
-String Storage::recordDirectoryPathForKey(const Key& key) const
-{
-    ASSERT(!key.partition().isEmpty());
-    ASSERT(!key.type().isEmpty());
-    return WebCore::pathByAppendingComponent(WebCore::pathByAppendingComponent(recordsPath(), key.partition()), key.type());
-}
-
-String Storage::recordPathForKey(const Key& key) const
+String Storage::blobPathForHash(const Key::HashType& hash) const
 {
-    return WebCore::pathByAppendingComponent(recordDirectoryPathForKey(key), key.hashAsString());
-}
-
-static String blobPathForRecordPath(const String& recordPath)
-{
-    return recordPath + blobSuffix;
-}
-
-String Storage::blobPathForKey(const Key& key) const
-{
-    return blobPathForRecordPath(recordPathForKey(key));
+    return WebCore::pathByAppendingComponent(recordsPath(), Key::hashAsString(hash) + blobSuffix);
 }
 
 struct RecordMetaData {
@@ -479,7 +584,7 @@ static Data encodeRecordMetaData(const RecordMetaData& metaData)
 
 Optional<BlobStorage::Blob> Storage::storeBodyAsBlob(WriteOperation& writeOperation)
 {
-    auto blobPath = blobPathForKey(writeOperation.record.key);
+    auto blobPath = blobPathForHash(writeOperation.record.key.hash());
 
     // Store the body.
     auto blob = m_blobStorage.add(blobPath, writeOperation.record.body);
@@ -489,8 +594,10 @@ Optional<BlobStorage::Blob> Storage::storeBodyAsBlob(WriteOperation& writeOperat
     ++writeOperation.activeCount;
 
     RunLoop::main().dispatch([this, blob, &writeOperation] {
-        if (m_blobFilter)
+        if (m_blobFilter) {
             m_blobFilter->add(writeOperation.record.key.hash());
+            contentsFiltersChanged();
+        }
         if (m_synchronizationInProgress)
             m_blobFilterHashesAddedDuringSynchronization.append(writeOperation.record.key.hash());
 
@@ -543,22 +650,22 @@ void Storage::remove(const Key& key)
         return;
 
     // We can't remove the key from the Bloom filter (but some false positives are expected anyway).
-    // For simplicity we also don't reduce m_approximateSize on removals.
     // The next synchronization will update everything.
 
     removeFromPendingWriteOperations(key);
 
-    serialBackgroundIOQueue().dispatch([this, key] {
-        WebCore::deleteFile(recordPathForKey(key));
-        m_blobStorage.remove(blobPathForKey(key));
+    auto hash = key.hash();
+    serialBackgroundIOQueue().dispatch([this, hash] {
+        m_segmentStorage.remove(hash);
+        m_blobStorage.remove(blobPathForHash(hash));
     });
 }
 
-void Storage::updateFileModificationTime(const String& path)
+void Storage::updateAccessTime(const Key& key)
 {
-    StringCapture filePathCapture(path);
-    serialBackgroundIOQueue().dispatch([filePathCapture] {
-        updateFileModificationTimeIfNeeded(filePathCapture.string());
+    auto hash = key.hash();
+    serialBackgroundIOQueue().dispatch([this, hash] {
+        m_segmentStorage.markAccessed(hash);
     });
 }
 
@@ -576,25 +683,16 @@ void Storage::dispatchReadOperation(std::unique_ptr<ReadOperation> readOperation
     bool shouldGetBodyBlob = mayContainBlob(readOperation.key);
 
     ioQueue().dispatch([this, &readOperation, shouldGetBodyBlob] {
-        auto recordPath = recordPathForKey(readOperation.key);
-
         ++readOperation.activeCount;
-        if (shouldGetBodyBlob)
-            ++readOperation.activeCount;
-
-        auto channel = IOChannel::open(recordPath, IOChannel::Type::Read);
-        channel->read(0, std::numeric_limits<size_t>::max(), &ioQueue(), [this, &readOperation](const Data& fileData, int error) {
-            if (!error)
-                readRecord(readOperation, fileData);
-            finishReadOperation(readOperation);
-        });
 
-        if (shouldGetBodyBlob) {
-            // Read the blob in parallel with the record read.
-            auto blobPath = blobPathForKey(readOperation.key);
-            readOperation.resultBodyBlob = m_blobStorage.get(blobPath);
-            finishReadOperation(readOperation);
-        }
+        auto recordData = m_segmentStorage.get(readOperation.key.hash());
+        if (!recordData.isNull())
+            readRecord(readOperation, recordData);
+
+        if (shouldGetBodyBlob && readOperation.resultRecord)
+            readOperation.resultBodyBlob = m_blobStorage.get(blobPathForHash(readOperation.key.hash()));
+
+        finishReadOperation(readOperation);
     });
 }
 
@@ -608,7 +706,7 @@ void Storage::finishReadOperation(ReadOperation& readOperation)
     RunLoop::main().dispatch([this, &readOperation] {
         bool success = readOperation.finish();
         if (success)
-            updateFileModificationTime(recordPathForKey(readOperation.key));
+            updateAccessTime(readOperation.key);
         else if (!readOperation.isCanceled)
             remove(readOperation.key);
 
@@ -708,26 +806,23 @@ void Storage::dispatchWriteOperation(std::unique_ptr<WriteOperation> writeOperat
     addToRecordFilter(writeOperation.record.key);
 
     backgroundIOQueue().dispatch([this, &writeOperation] {
-        auto recordDirectorPath = recordDirectoryPathForKey(writeOperation.record.key);
-        auto recordPath = recordPathForKey(writeOperation.record.key);
-
-        WebCore::makeAllDirectories(recordDirectorPath);
-
         ++writeOperation.activeCount;
 
         bool shouldStoreAsBlob = shouldStoreBodyAsBlob(writeOperation.record.body);
+        if (shouldStoreAsBlob)
+            WebCore::makeAllDirectories(recordsPath());
         auto blob = shouldStoreAsBlob ? storeBodyAsBlob(writeOperation) : Nullopt;
 
         auto recordData = encodeRecord(writeOperation.record, blob);
 
-        auto channel = IOChannel::open(recordPath, IOChannel::Type::Create);
-        size_t recordSize = recordData.size();
-        channel->write(0, recordData, nullptr, [this, &writeOperation, recordSize](int error) {
-            // On error the entry still stays in the contents filter until next synchronization.
-            m_approximateRecordsSize += recordSize;
+        // On failure the entry still stays in the contents filter until next synchronization.
+        if (!m_segmentStorage.add(writeOperation.record.key.hash(), recordData))
+            LOG(NetworkCacheStorage, "(NetworkProcess) write failed");
+
+        RunLoop::main().dispatch([this, &writeOperation] {
             finishWriteOperation(writeOperation);
 
-            LOG(NetworkCacheStorage, "(NetworkProcess) write complete error=%d", error);
+            LOG(NetworkCacheStorage, "(NetworkProcess) write complete");
         });
     });
 }
@@ -808,28 +903,27 @@ void Storage::traverse(const String& type, TraverseFlags flags, TraverseHandler&
     m_activeTraverseOperations.add(WTF::move(traverseOperationPtr));
 
     ioQueue().dispatch([this, &traverseOperation] {
-        traverseRecordsFiles(recordsPath(), traverseOperation.type, [this, &traverseOperation](const String& fileName, const String& hashString, const String& type, bool isBlob, const String& recordDirectoryPath) {
-            ASSERT(type == traverseOperation.type);
-            if (isBlob)
-                return;
-
-            auto recordPath = WebCore::pathByAppendingComponent(recordDirectoryPath, fileName);
-
+        auto records = m_segmentStorage.records();
+        for (auto& recordInfo : records) {
             double worth = -1;
             if (traverseOperation.flags & TraverseFlag::ComputeWorth)
-                worth = computeRecordWorth(fileTimes(recordPath));
+                worth = computeRecordWorth(recordInfo.times);
             unsigned bodyShareCount = 0;
             if (traverseOperation.flags & TraverseFlag::ShareCount)
-                bodyShareCount = m_blobStorage.shareCount(blobPathForRecordPath(recordPath));
+                bodyShareCount = m_blobStorage.shareCount(blobPathForHash(recordInfo.hash));
+
+            auto recordData = m_segmentStorage.get(recordInfo.hash);
+            if (recordData.isNull())
+                continue;
 
             std::unique_lock<Lock> lock(traverseOperation.activeMutex);
             ++traverseOperation.activeCount;
 
-            auto channel = IOChannel::open(recordPath, IOChannel::Type::Read);
-            channel->read(0, std::numeric_limits<size_t>::max(), nullptr, [this, &traverseOperation, worth, bodyShareCount](Data& fileData, int) {
+            RunLoop::main().dispatch([&traverseOperation, recordData, worth, bodyShareCount] {
                 RecordMetaData metaData;
                 Data headerData;
-                if (decodeRecordHeader(fileData, metaData, headerData)) {
+                // Records of all types share the segments.
+                if (decodeRecordHeader(recordData, metaData, headerData) && (traverseOperation.type.isEmpty() || metaData.key.type() == traverseOperation.type)) {
                     Record record {
                         metaData.key,
                         std::chrono::system_clock::time_point(metaData.epochRelativeTimeStamp),
@@ -854,7 +948,7 @@ void Storage::traverse(const String& type, TraverseFlags flags, TraverseHandler&
             traverseOperation.activeCondition.wait(lock, [&traverseOperation] {
                 return traverseOperation.activeCount <= maximumParallelReadCount;
             });
-        });
+        }
         // Wait for all reads to finish.
         std::unique_lock<Lock> lock(traverseOperation.activeMutex);
         traverseOperation.activeCondition.wait(lock, [&traverseOperation] {
@@ -894,24 +988,36 @@ void Storage::clear(const String& type, std::chrono::system_clock::time_point mo
         m_recordFilter->clear();
     if (m_blobFilter)
         m_blobFilter->clear();
-    m_approximateRecordsSize = 0;
+    contentsFiltersChanged();
 
     // Avoid non-thread safe std::function copies.
     auto* completionHandlerPtr = completionHandler ? new std::function<void ()>(WTF::move(completionHandler)) : nullptr;
     StringCapture typeCapture(type);
     ioQueue().dispatch([this, modifiedSinceTime, completionHandlerPtr, typeCapture] {
-        auto recordsPath = this->recordsPath();
-        traverseRecordsFiles(recordsPath, typeCapture.string(), [modifiedSinceTime](const String& fileName, const String& hashString, const String& type, bool isBlob, const String& recordDirectoryPath) {
-            auto filePath = WebCore::pathByAppendingComponent(recordDirectoryPath, fileName);
-            if (modifiedSinceTime > std::chrono::system_clock::time_point::min()) {
-                auto times = fileTimes(filePath);
-                if (times.modification < modifiedSinceTime)
-                    return;
+        auto type = typeCapture.string();
+        if (type.isEmpty() && modifiedSinceTime == std::chrono::system_clock::time_point::min()) {
+            m_segmentStorage.clear();
+
+            auto recordsPath = this->recordsPath();
+            traverseDirectory(recordsPath, [&recordsPath](const String& fileName, DirectoryEntryType entryType) {
+                if (entryType == DirectoryEntryType::File)
+                    WebCore::deleteFile(WebCore::pathByAppendingComponent(recordsPath, fileName));
+            });
+        } else {
+            for (auto& recordInfo : m_segmentStorage.records()) {
+                if (recordInfo.times.modification < modifiedSinceTime)
+                    continue;
+                if (!type.isEmpty()) {
+                    RecordMetaData metaData;
+                    Data headerData;
+                    if (decodeRecordHeader(m_segmentStorage.get(recordInfo.hash), metaData, headerData) && metaData.key.type() != type)
+                        continue;
+                }
+                m_segmentStorage.remove(recordInfo.hash);
+                m_blobStorage.remove(blobPathForHash(recordInfo.hash));
             }
-            WebCore::deleteFile(filePath);
-        });
-
-        deleteEmptyRecordsDirectories(recordsPath);
+            m_segmentStorage.compactIfNeeded();
+        }
 
         // This cleans unreferenced blobs.
         m_blobStorage.synchronize();
@@ -929,7 +1035,7 @@ static double computeRecordWorth(FileTimes times)
 {
     using namespace std::chrono;
     auto age = system_clock::now() - times.creation;
-    // File modification time is updated manually on cache read. We don't use access time since OS may update it automatically.
+    // The modification time is the last time the record was retrieved, as tracked by the segment storage.
     auto accessAge = times.modification - times.creation;
 
     // For sanity.
@@ -978,32 +1084,26 @@ void Storage::shrink()
     LOG(NetworkCacheStorage, "(NetworkProcess) shrinking cache approximateSize=%zu capacity=%zu", approximateSize(), m_capacity);
 
     backgroundIOQueue().dispatch([this] {
-        auto recordsPath = this->recordsPath();
-        String anyType;
-        traverseRecordsFiles(recordsPath, anyType, [this](const String& fileName, const String& hashString, const String& type, bool isBlob, const String& recordDirectoryPath) {
-            if (isBlob)
-                return;
-
-            auto recordPath = WebCore::pathByAppendingComponent(recordDirectoryPath, fileName);
-            auto blobPath = blobPathForRecordPath(recordPath);
+        for (auto& recordInfo : m_segmentStorage.records()) {
+            auto blobPath = blobPathForHash(recordInfo.hash);
 
-            auto times = fileTimes(recordPath);
             unsigned bodyShareCount = m_blobStorage.shareCount(blobPath);
-            auto probability = deletionProbability(times, bodyShareCount);
+            auto probability = deletionProbability(recordInfo.times, bodyShareCount);
 
             bool shouldDelete = randomNumber() < probability;
 
             LOG(NetworkCacheStorage, "Deletion probability=%f bodyLinkCount=%d shouldDelete=%d", probability, bodyShareCount, shouldDelete);
 
             if (shouldDelete) {
-                WebCore::deleteFile(recordPath);
+                m_segmentStorage.remove(recordInfo.hash);
                 m_blobStorage.remove(blobPath);
             }
-        });
+        }
 
         RunLoop::main().dispatch([this] {
             m_shrinkInProgress = false;
             // We could synchronize during the shrink traversal. However this is fast and it is better to have just one code path.
+            // Synchronization also compacts the segments the removed records leave behind.
             synchronize();
         });
 
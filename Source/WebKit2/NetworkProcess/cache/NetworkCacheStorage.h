@@ -31,6 +31,7 @@
 #include "NetworkCacheBlobStorage.h"
 #include "NetworkCacheData.h"
 #include "NetworkCacheKey.h"
+#include "NetworkCacheSegmentStorage.h"
 #include <WebCore/Timer.h>
 #include <wtf/BloomFilter.h>
 #include <wtf/Deque.h>
@@ -42,8 +43,6 @@
 namespace WebKit {
 namespace NetworkCache {
 
-class IOChannel;
-
 class Storage {
     WTF_MAKE_NONCOPYABLE(Storage);
 public:
@@ -86,7 +85,14 @@ public:
     size_t capacity() const { return m_capacity; }
     size_t approximateSize() const;
 
-    static const unsigned version = 5;
+    // 2^18 bit filter can support up to 26000 entries with false positive rate < 1%.
+    using ContentsFilter = BloomFilter<18>;
+
+    // The contents filters are also written periodically and after synchronization.
+    void writeContentsFilters();
+    void writeContentsFiltersSynchronously();
+
+    static const unsigned version = 7;
 
     String basePath() const;
     String versionPath() const;
@@ -97,11 +103,13 @@ public:
 private:
     Storage(const String& directoryPath);
 
-    String recordDirectoryPathForKey(const Key&) const;
-    String recordPathForKey(const Key&) const;
-    String blobPathForKey(const Key&) const;
+    String blobPathForHash(const Key::HashType&) const;
+    String contentsFiltersPath() const;
 
     void synchronize();
+    void loadContentsFilters();
+    Data encodeContentsFilters() const;
+    void contentsFiltersChanged();
     void deleteOldVersions();
     void shrinkIfNeeded();
     void shrink();
@@ -121,7 +129,7 @@ private:
     Data encodeRecord(const Record&, Optional<BlobStorage::Blob>);
     void readRecord(ReadOperation&, const Data&);
 
-    void updateFileModificationTime(const String& path);
+    void updateAccessTime(const Key&);
     bool removeFromPendingWriteOperations(const Key&);
 
     WorkQueue& ioQueue() { return m_ioQueue.get(); }
@@ -137,10 +145,9 @@ private:
     const String m_recordsPath;
 
     size_t m_capacity { std::numeric_limits<size_t>::max() };
-    size_t m_approximateRecordsSize { 0 };
+    // Size stored with the contents filters, used until the first synchronization completes.
+    size_t m_persistedApproximateSize { 0 };
 
-    // 2^18 bit filter can support up to 26000 entries with false positive rate < 1%.
-    using ContentsFilter = BloomFilter<18>;
     std::unique_ptr<ContentsFilter> m_recordFilter;
     std::unique_ptr<ContentsFilter> m_blobFilter;
 
@@ -159,6 +166,8 @@ private:
     HashSet<std::unique_ptr<WriteOperation>> m_activeWriteOperations;
     WebCore::Timer m_writeOperationDispatchTimer;
 
+    WebCore::Timer m_writeContentsFiltersTimer;
+
     struct TraverseOperation;
     HashSet<std::unique_ptr<TraverseOperation>> m_activeTraverseOperations;
 
@@ -167,11 +176,9 @@ private:
     Ref<WorkQueue> m_serialBackgroundIOQueue;
 
     BlobStorage m_blobStorage;
+    SegmentStorage m_segmentStorage;
 };
 
-// FIXME: Remove, used by NetworkCacheStatistics only.
-void traverseRecordsFiles(const String& recordsPath, const String& type, const std::function<void (const String& fileName, const String& hashString, const String& type, bool isBodyBlob, const String& recordDirectoryPath)>&);
-
 }
 }
 #endif
@@ -36,10 +36,70 @@
 namespace WebKit {
 namespace NetworkCache {
 
+// Counts are halved once either reaches this, so that old history fades out.
+static const unsigned maximumUseCount = 16;
+// A subresource that missed this many more page loads than it was used by is dropped from the list.
+static const unsigned missCountToForget = 3;
+
+void SubresourceInfo::encode(Encoder& encoder) const
+{
+    encoder << m_key;
+    encoder.encodeEnum(m_priority);
+    encoder << m_isPreloadHint;
+    encoder << m_hitCount;
+    encoder << m_missCount;
+}
+
+bool SubresourceInfo::decode(Decoder& decoder, SubresourceInfo& info)
+{
+    if (!decoder.decode(info.m_key))
+        return false;
+    if (!decoder.decodeEnum(info.m_priority))
+        return false;
+    if (!decoder.decode(info.m_isPreloadHint))
+        return false;
+    if (!decoder.decode(info.m_hitCount))
+        return false;
+    if (!decoder.decode(info.m_missCount))
+        return false;
+    return true;
+}
+
+static void decayCountsIfNeeded(unsigned& hitCount, unsigned& missCount)
+{
+    if (hitCount < maximumUseCount && missCount < maximumUseCount)
+        return;
+    hitCount /= 2;
+    missCount /= 2;
+}
+
+void SubresourceInfo::recordHit()
+{
+    ++m_hitCount;
+    decayCountsIfNeeded(m_hitCount, m_missCount);
+}
+
+void SubresourceInfo::recordMiss()
+{
+    ++m_missCount;
+    decayCountsIfNeeded(m_hitCount, m_missCount);
+}
+
+void SubresourceInfo::mergeCountsFrom(const SubresourceInfo& other)
+{
+    m_hitCount = other.m_hitCount;
+    m_missCount = other.m_missCount;
+}
+
+bool SubresourceInfo::shouldBeForgotten() const
+{
+    return m_missCount >= m_hitCount + missCountToForget;
+}
+
 Storage::Record SubresourcesEntry::encodeAsStorageRecord() const
 {
     Encoder encoder;
-    encoder << m_subresourceKeys;
+    encoder << m_subresources;
 
     encoder.encodeChecksum();
 
@@ -51,7 +111,7 @@ std::unique_ptr<SubresourcesEntry> SubresourcesEntry::decodeStorageRecord(const
     auto entry = std::make_unique<SubresourcesEntry>(storageEntry);
 
     Decoder decoder(storageEntry.header.data(), storageEntry.header.size());
-    if (!decoder.decode(entry->m_subresourceKeys))
+    if (!decoder.decode(entry->m_subresources))
         return nullptr;
 
     if (!decoder.verifyChecksum()) {
@@ -69,10 +129,10 @@ SubresourcesEntry::SubresourcesEntry(const Storage::Record& storageEntry)
     ASSERT(m_key.type() == "subresources");
 }
 
-SubresourcesEntry::SubresourcesEntry(const Key& key, Vector<Key>&& subresourceKeys)
+SubresourcesEntry::SubresourcesEntry(const Key& key, Vector<SubresourceInfo>&& subresources)
     : m_key(key)
     , m_timeStamp(std::chrono::system_clock::now())
-    , m_subresourceKeys(WTF::move(subresourceKeys))
+    , m_subresources(WTF::move(subresources))
 {
     ASSERT(m_key.type() == "subresources");
 }
@@ -29,14 +29,53 @@
 #if ENABLE(NETWORK_CACHE_SPECULATIVE_REVALIDATION)
 
 #include "NetworkCacheStorage.h"
+#include <WebCore/ResourceLoadPriority.h>
 
 namespace WebKit {
 namespace NetworkCache {
 
+class SubresourceInfo {
+    WTF_MAKE_FAST_ALLOCATED;
+public:
+    SubresourceInfo() = default;
+    SubresourceInfo(const Key& key, WebCore::ResourceLoadPriority priority, bool isPreloadHint)
+        : m_key(key)
+        , m_priority(priority)
+        , m_isPreloadHint(isPreloadHint)
+    {
+    }
+
+    void encode(Encoder&) const;
+    static bool decode(Decoder&, SubresourceInfo&);
+
+    const Key& key() const { return m_key; }
+    WebCore::ResourceLoadPriority priority() const { return m_priority; }
+    // Whether the HTML or CSS preload scanner discovered this subresource, as opposed to it being
+    // requested later on by layout or script. These are the loads worth fetching ahead of the page.
+    bool isPreloadHint() const { return m_isPreloadHint; }
+
+    // How often this subresource was, or was not, requested again by a load of the same page.
+    unsigned hitCount() const { return m_hitCount; }
+    unsigned missCount() const { return m_missCount; }
+    void recordHit();
+    void recordMiss();
+    void mergeCountsFrom(const SubresourceInfo&);
+
+    bool isLikelyToBeUsed() const { return m_missCount <= m_hitCount; }
+    bool shouldBeForgotten() const;
+
+private:
+    Key m_key;
+    WebCore::ResourceLoadPriority m_priority { WebCore::ResourceLoadPriority::Medium };
+    bool m_isPreloadHint { false };
+    unsigned m_hitCount { 0 };
+    unsigned m_missCount { 0 };
+};
+
 class SubresourcesEntry {
     WTF_MAKE_NONCOPYABLE(SubresourcesEntry); WTF_MAKE_FAST_ALLOCATED;
 public:
-    SubresourcesEntry(const Key&, Vector<Key>&& subresourceKeys);
+    SubresourcesEntry(const Key&, Vector<SubresourceInfo>&& subresources);
     explicit SubresourcesEntry(const Storage::Record&);
 
     Storage::Record encodeAsStorageRecord() const;
@@ -44,13 +83,13 @@ public:
 
     const Key& key() const { return m_key; }
     std::chrono::system_clock::time_point timeStamp() const { return m_timeStamp; }
-    const Vector<Key>& subresourceKeys() const { return m_subresourceKeys; }
+    const Vector<SubresourceInfo>& subresources() const { return m_subresources; }
 
 private:
     Key m_key;
     std::chrono::system_clock::time_point m_timeStamp;
     Storage::Record m_sourceStorageRecord;
-    Vector<Key> m_subresourceKeys;
+    Vector<SubresourceInfo> m_subresources;
 };
 
 } // namespace WebKit
@@ -104,6 +104,10 @@ private:
     uint8_t* m_bufferPos;
     uint8_t* m_bufferEnd;
 
+    // Most messages are small enough to be decoded without a heap copy. Declared as uint64_t so that
+    // it has the alignment the decoding code expects from its buffer.
+    uint64_t m_inlineBuffer[64];
+
     Vector<Attachment> m_attachments;
 };
 
@@ -29,6 +29,7 @@
 #include "DataReference.h"
 #include <algorithm>
 #include <stdio.h>
+#include <wtf/Lock.h>
 
 #if OS(DARWIN)
 #include <sys/mman.h>
@@ -58,6 +59,52 @@ static inline void freeBuffer(void* addr, size_t size)
 #endif
 }
 
+// Messages that outgrow the inline buffer, like layer tree commits and resource data, are frequent
+// enough that their buffers are kept around for the next one instead of being freed. The pool is
+// shared by the whole process because encoders are created before the connection is known.
+static const size_t maximumPooledBufferCapacity = 256 * 1024;
+static const size_t maximumPooledBufferCount = 8;
+
+struct PooledBuffer {
+    uint8_t* buffer;
+    size_t capacity;
+};
+
+static StaticLock bufferPoolMutex;
+static PooledBuffer bufferPool[maximumPooledBufferCount];
+static size_t bufferPoolSize;
+
+static uint8_t* takePooledBuffer(size_t& capacity)
+{
+    std::lock_guard<StaticLock> lock(bufferPoolMutex);
+
+    size_t bestFit = notFound;
+    for (size_t i = 0; i < bufferPoolSize; ++i) {
+        if (bufferPool[i].capacity >= capacity && (bestFit == notFound || bufferPool[i].capacity < bufferPool[bestFit].capacity))
+            bestFit = i;
+    }
+    if (bestFit == notFound)
+        return nullptr;
+
+    uint8_t* buffer = bufferPool[bestFit].buffer;
+    capacity = bufferPool[bestFit].capacity;
+    bufferPool[bestFit] = bufferPool[--bufferPoolSize];
+    return buffer;
+}
+
+static void returnBuffer(uint8_t* buffer, size_t capacity)
+{
+    if (capacity <= maximumPooledBufferCapacity) {
+        std::lock_guard<StaticLock> lock(bufferPoolMutex);
+        if (bufferPoolSize < maximumPooledBufferCount) {
+            bufferPool[bufferPoolSize++] = { buffer, capacity };
+            return;
+        }
+    }
+
+    freeBuffer(buffer, capacity);
+}
+
 ArgumentEncoder::ArgumentEncoder()
     : m_buffer(m_inlineBuffer)
     , m_bufferPointer(m_inlineBuffer)
@@ -69,7 +116,7 @@ ArgumentEncoder::ArgumentEncoder()
 ArgumentEncoder::~ArgumentEncoder()
 {
     if (m_buffer != m_inlineBuffer)
-        freeBuffer(m_buffer, m_bufferCapacity);
+        returnBuffer(m_buffer, m_bufferCapacity);
     // FIXME: We need to dispose of the attachments in cases of failure.
 }
 
@@ -87,14 +134,14 @@ void ArgumentEncoder::reserve(size_t size)
     while (newCapacity < size)
         newCapacity *= 2;
 
-    uint8_t* newBuffer;
-    if (!allocBuffer(newBuffer, newCapacity))
+    uint8_t* newBuffer = takePooledBuffer(newCapacity);
+    if (!newBuffer && !allocBuffer(newBuffer, newCapacity))
         CRASH();
 
     memcpy(newBuffer, m_buffer, m_bufferSize);
 
     if (m_buffer != m_inlineBuffer)
-        freeBuffer(m_buffer, m_bufferCapacity);
+        returnBuffer(m_buffer, m_bufferCapacity);
 
     m_buffer = newBuffer;
     m_bufferCapacity = newCapacity;
@@ -31,6 +31,7 @@
 #include <wtf/HashSet.h>
 #include <wtf/NeverDestroyed.h>
 #include <wtf/RunLoop.h>
+#include <wtf/TraceEvent.h>
 #include <wtf/text/WTFString.h>
 #include <wtf/threads/BinarySemaphore.h>
 
@@ -370,12 +371,34 @@ bool Connection::sendMessage(std::unique_ptr<MessageEncoder> encoder, unsigned m
     UNUSED_PARAM(alreadyRecordedMessage);
 #endif
 
+    bool needsToScheduleSend;
     {
         std::lock_guard<Lock> lock(m_outgoingMessagesMutex);
+
+        if (messageSendFlags & ReplacePendingMessageOfSameKind && !encoder->isSyncMessage()) {
+            auto supersededMessage = m_outgoingMessages.findIf([&encoder](const std::unique_ptr<MessageEncoder>& pendingMessage) {
+                return pendingMessage->messageReceiverName() == encoder->messageReceiverName()
+                    && pendingMessage->messageName() == encoder->messageName()
+                    && pendingMessage->destinationID() == encoder->destinationID();
+            });
+            if (supersededMessage != m_outgoingMessages.end()) {
+#if HAVE(DTRACE)
+                MessageRecorder::recordSupersededMessage(*this, **supersededMessage);
+#endif
+                m_outgoingMessages.remove(supersededMessage);
+            }
+        }
+
         m_outgoingMessages.append(WTF::move(encoder));
+
+        // Messages sent in a burst are all written by the same task on the connection queue.
+        needsToScheduleSend = !m_hasScheduledSendOfOutgoingMessages;
+        m_hasScheduledSendOfOutgoingMessages = true;
     }
-    
-    // FIXME: We should add a boolean flag so we don't call this when work has already been scheduled.
+
+    if (!needsToScheduleSend)
+        return true;
+
     RefPtr<Connection> protectedThis(this);
     m_connectionQueue->dispatch([protectedThis] {
         protectedThis->sendOutgoingMessages();
@@ -807,6 +830,12 @@ bool Connection::canSendOutgoingMessages() const
 
 void Connection::sendOutgoingMessages()
 {
+    {
+        // Any message queued from now on needs another task to be sent, since this one may already be past it.
+        std::lock_guard<Lock> lock(m_outgoingMessagesMutex);
+        m_hasScheduledSendOfOutgoingMessages = false;
+    }
+
     if (!canSendOutgoingMessages())
         return;
 
@@ -902,6 +931,8 @@ void Connection::dispatchMessage(MessageDecoder& decoder)
 
 void Connection::dispatchMessage(std::unique_ptr<MessageDecoder> message)
 {
+    TraceScope traceScope(TraceCategory::IPC, "IPC::Connection::dispatchMessage");
+
 #if HAVE(DTRACE)
     MessageRecorder::recordIncomingMessage(*this, *message);
 #endif
@@ -56,14 +56,26 @@
 #include "GSocketMonitor.h"
 #endif
 
+#if USE(UNIX_DOMAIN_SOCKETS)
+#include "SharedMemory.h"
+#endif
+
 namespace IPC {
 
 struct WaitForMessageState;
+#if USE(UNIX_DOMAIN_SOCKETS)
+class MessageInfo;
+#endif
 
 enum MessageSendFlags {
     // Whether this message should be dispatched when waiting for a sync reply.
     // This is the default for synchronous messages.
     DispatchMessageEvenWhenWaitingForSyncReply = 1 << 0,
+
+    // Whether this message supersedes a message of the same kind, to the same destination, that is
+    // still waiting to be sent. The older message is dropped. Only use this for messages that carry
+    // a complete state, so that nothing is lost when an earlier one is skipped.
+    ReplacePendingMessageOfSameKind = 1 << 1,
 };
 
 enum SyncMessageSendFlags {
@@ -119,6 +131,11 @@ public:
     };
 
     static Connection::SocketPair createPlatformConnection(unsigned options = SetCloexecOnClient | SetCloexecOnServer);
+
+    // Sends messages that have no attachments and a small body through a ring buffer in shared memory,
+    // and only writes to the socket to wake up the other end when the ring stops being empty.
+    // Must be called before the connection is opened. The other end doesn't need to be configured.
+    void setShouldUseSharedMemoryRing() { m_shouldUseSharedMemoryRing = true; }
 #elif OS(DARWIN)
     struct Identifier {
         Identifier()
@@ -274,6 +291,7 @@ private:
     // Outgoing messages.
     Lock m_outgoingMessagesMutex;
     Deque<std::unique_ptr<MessageEncoder>> m_outgoingMessages;
+    bool m_hasScheduledSendOfOutgoingMessages { false };
     
     Condition m_waitForMessageCondition;
     Lock m_waitForMessageMutex;
@@ -330,12 +348,24 @@ private:
     // Called on the connection queue.
     void readyReadHandler();
     bool processMessage();
+    bool sendMessageOverSocket(MessageInfo&, const Vector<Attachment>&, const uint8_t* body);
+    bool setUpOutgoingRing();
+    bool writeToOutgoingRing(uint32_t recordType, const uint8_t* body, size_t bodySize);
+    void processIncomingRingRecords();
 
     Vector<uint8_t> m_readBuffer;
     size_t m_readBufferSize;
     Vector<int> m_fileDescriptors;
     size_t m_fileDescriptorsSize;
     int m_socketDescriptor;
+
+    bool m_shouldUseSharedMemoryRing { false };
+    RefPtr<WebKit::SharedMemory> m_outgoingRing;
+    uint64_t m_outgoingRingWritePosition { 0 };
+    RefPtr<WebKit::SharedMemory> m_incomingRing;
+    uint64_t m_incomingRingReadPosition { 0 };
+    // Messages that came through the socket but were sent after ring messages that haven't been processed yet.
+    Deque<std::unique_ptr<MessageDecoder>> m_messagesWaitingForIncomingRing;
 #if PLATFORM(GTK)
     GSocketMonitor m_socketMonitor;
 #endif
@@ -39,11 +39,8 @@ bool MessageRecorder::isEnabled()
     return WEBKITMESSAGERECORDER_MESSAGE_RECEIVED_ENABLED() || WEBKITMESSAGERECORDER_MESSAGE_SENT_ENABLED();
 }
 
-std::unique_ptr<MessageRecorder::MessageProcessingToken> MessageRecorder::recordOutgoingMessage(Connection& connection, MessageEncoder& encoder)
+static WebKitMessageRecord outgoingMessageRecord(Connection& connection, MessageEncoder& encoder)
 {
-    if (!isEnabled() || !connection.isValid())
-        return nullptr;
-
     WebKitMessageRecord record;
     record.sourceProcessType = static_cast<uint64_t>(connection.client()->localProcessType());
     record.destinationProcessType = static_cast<uint64_t>(connection.client()->remoteProcessType());
@@ -64,7 +61,26 @@ std::unique_ptr<MessageRecorder::MessageProcessingToken> MessageRecorder::record
 
     uuid_copy(record.UUID, encoder.UUID());
 
-    return std::make_unique<MessageProcessingToken>(WTF::move(record));
+    return record;
+}
+
+std::unique_ptr<MessageRecorder::MessageProcessingToken> MessageRecorder::recordOutgoingMessage(Connection& connection, MessageEncoder& encoder)
+{
+    if (!isEnabled() || !connection.isValid())
+        return nullptr;
+
+    return std::make_unique<MessageProcessingToken>(outgoingMessageRecord(connection, encoder));
+}
+
+void MessageRecorder::recordSupersededMessage(Connection& connection, MessageEncoder& encoder)
+{
+    if (!WEBKITMESSAGERECORDER_MESSAGE_SUPERSEDED_ENABLED() || !connection.isValid())
+        return;
+
+    WebKitMessageRecord record = outgoingMessageRecord(connection, encoder);
+    record.startTime = monotonicallyIncreasingTime();
+    record.endTime = record.startTime;
+    WEBKITMESSAGERECORDER_MESSAGE_SUPERSEDED(&record);
 }
 
 void MessageRecorder::recordIncomingMessage(Connection& connection, MessageDecoder& decoder)
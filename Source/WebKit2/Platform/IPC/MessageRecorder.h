@@ -79,6 +79,8 @@ public:
 
     static std::unique_ptr<MessageRecorder::MessageProcessingToken> recordOutgoingMessage(IPC::Connection&, IPC::MessageEncoder&);
     static void recordIncomingMessage(IPC::Connection&, IPC::MessageDecoder&);
+    // Records an outgoing message that was dropped before being sent because a newer one of the same kind replaced it.
+    static void recordSupersededMessage(IPC::Connection&, IPC::MessageEncoder&);
 
 private:
     explicit MessageRecorder() { }
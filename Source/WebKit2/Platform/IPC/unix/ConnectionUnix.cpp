@@ -62,6 +62,59 @@ enum {
     MessageBodyIsOutOfLine = 1U << 31
 };
 
+enum class MessageKind : uint32_t {
+    Message,
+    // A message that the sender also recorded in its ring, with a marker, because ring records were
+    // sent before it. It is processed when the receiver reaches the marker.
+    MessageOrderedAfterRing,
+    // Carries the memory of the sender's ring as an attachment.
+    RingSetup,
+    // Sent when the sender wrote a record to a ring that the receiver had emptied.
+    RingDoorbell,
+};
+
+// A ring is a RingHeader followed by ringDataSize bytes of records. A record is a RingRecordHeader
+// followed by the message body, padded to a multiple of 8 bytes, and never wraps around the end of
+// the data: a padding record fills the space left when the next record doesn't fit.
+static const size_t ringDataOffset = 128;
+static const size_t ringDataSize = 256 * 1024;
+// Bigger messages go through the socket, with their body out of line if needed.
+static const size_t ringMaxMessageBodySize = 16 * 1024;
+
+struct RingHeader {
+    std::atomic<uint64_t> writePosition { 0 };
+    uint8_t padding[64 - sizeof(std::atomic<uint64_t>)];
+    std::atomic<uint64_t> readPosition { 0 };
+};
+
+COMPILE_ASSERT(sizeof(RingHeader) <= ringDataOffset, RingHeaderFitsBeforeRingData);
+
+enum RingRecordType : uint32_t {
+    RingRecordMessage,
+    RingRecordSocketMessageMarker,
+    RingRecordPadding,
+};
+
+struct RingRecordHeader {
+    uint32_t type;
+    uint32_t bodySize;
+};
+
+static inline RingHeader& ringHeader(WebKit::SharedMemory& ring)
+{
+    return *static_cast<RingHeader*>(ring.data());
+}
+
+static inline uint8_t* ringData(WebKit::SharedMemory& ring)
+{
+    return static_cast<uint8_t*>(ring.data()) + ringDataOffset;
+}
+
+static inline size_t ringRecordSize(size_t bodySize)
+{
+    return roundUpToMultipleOf<8>(sizeof(RingRecordHeader) + bodySize);
+}
+
 class MessageInfo {
 public:
     MessageInfo() { }
@@ -70,9 +123,13 @@ public:
         : m_bodySize(bodySize)
         , m_attachmentCount(initialAttachmentCount)
         , m_isMessageBodyOutOfLine(false)
+        , m_kind(MessageKind::Message)
     {
     }
 
+    void setKind(MessageKind kind) { m_kind = kind; }
+    MessageKind kind() const { return m_kind; }
+
     void setMessageBodyIsOutOfLine()
     {
         ASSERT(!isMessageBodyIsOutOfLine());
@@ -91,6 +148,7 @@ private:
     size_t m_bodySize;
     size_t m_attachmentCount;
     bool m_isMessageBodyOutOfLine;
+    MessageKind m_kind;
 };
 
 class AttachmentInfo {
@@ -155,6 +213,65 @@ void Connection::platformInvalidate()
 
     m_socketDescriptor = -1;
     m_isConnected = false;
+
+    m_outgoingRing = nullptr;
+    m_incomingRing = nullptr;
+    m_messagesWaitingForIncomingRing.clear();
+}
+
+void Connection::processIncomingRingRecords()
+{
+    if (!m_incomingRing)
+        return;
+
+    RingHeader& header = ringHeader(*m_incomingRing);
+    uint8_t* data = ringData(*m_incomingRing);
+
+    // The read position is published after every record so that the sender can reuse the space, and
+    // the write position is loaded again afterwards. Together with the sender storing its write position
+    // before loading the read position, this guarantees that either we see the new record or the sender
+    // sees an empty ring and rings the doorbell.
+    while (true) {
+        uint64_t writePosition = header.writePosition.load();
+        if (m_incomingRingReadPosition == writePosition)
+            return;
+
+        if (writePosition - m_incomingRingReadPosition > ringDataSize) {
+            ASSERT_NOT_REACHED();
+            return;
+        }
+
+        size_t offset = m_incomingRingReadPosition % ringDataSize;
+        RingRecordHeader recordHeader;
+        memcpy(&recordHeader, data + offset, sizeof(recordHeader));
+
+        size_t recordSize = recordHeader.type == RingRecordPadding ? ringDataSize - offset : ringRecordSize(recordHeader.bodySize);
+        if (offset + recordSize > ringDataSize || recordSize > writePosition - m_incomingRingReadPosition) {
+            ASSERT_NOT_REACHED();
+            return;
+        }
+
+        switch (recordHeader.type) {
+        case RingRecordMessage:
+            processIncomingMessage(std::make_unique<MessageDecoder>(DataReference(data + offset + sizeof(recordHeader), recordHeader.bodySize), Vector<Attachment>()));
+            break;
+        case RingRecordSocketMessageMarker:
+            // The sender writes the marker before the message, so we may get here first. Reading the
+            // message from the socket resumes processing.
+            if (m_messagesWaitingForIncomingRing.isEmpty())
+                return;
+            processIncomingMessage(m_messagesWaitingForIncomingRing.takeFirst());
+            break;
+        case RingRecordPadding:
+            break;
+        default:
+            ASSERT_NOT_REACHED();
+            return;
+        }
+
+        m_incomingRingReadPosition += recordSize;
+        header.readPosition.store(m_incomingRingReadPosition);
+    }
 }
 
 bool Connection::processMessage()
@@ -245,9 +362,38 @@ bool Connection::processMessage()
     if (messageInfo.isMessageBodyIsOutOfLine())
         messageBody = reinterpret_cast<uint8_t*>(oolMessageBody->data());
 
-    auto decoder = std::make_unique<MessageDecoder>(DataReference(messageBody, messageInfo.bodySize()), WTF::move(attachments));
-
-    processIncomingMessage(WTF::move(decoder));
+    switch (messageInfo.kind()) {
+    case MessageKind::Message:
+        processIncomingMessage(std::make_unique<MessageDecoder>(DataReference(messageBody, messageInfo.bodySize()), WTF::move(attachments)));
+        break;
+    case MessageKind::MessageOrderedAfterRing:
+        if (!m_incomingRing) {
+            ASSERT_NOT_REACHED();
+            break;
+        }
+        m_messagesWaitingForIncomingRing.append(std::make_unique<MessageDecoder>(DataReference(messageBody, messageInfo.bodySize()), WTF::move(attachments)));
+        processIncomingRingRecords();
+        break;
+    case MessageKind::RingSetup: {
+        if (attachments.size() != 1 || attachments[0].type() != Attachment::MappedMemoryType) {
+            ASSERT_NOT_REACHED();
+            break;
+        }
+        WebKit::SharedMemory::Handle handle;
+        handle.adoptAttachment(WTF::move(attachments[0]));
+        RefPtr<WebKit::SharedMemory> ring = WebKit::SharedMemory::map(handle, WebKit::SharedMemory::Protection::ReadWrite);
+        if (!ring || ring->size() < ringDataOffset + ringDataSize) {
+            ASSERT_NOT_REACHED();
+            break;
+        }
+        m_incomingRing = WTF::move(ring);
+        m_incomingRingReadPosition = 0;
+        break;
+    }
+    case MessageKind::RingDoorbell:
+        processIncomingRingRecords();
+        break;
+    }
 
     if (m_readBufferSize > messageLength) {
         memmove(m_readBuffer.data(), m_readBuffer.data() + messageLength, m_readBufferSize - messageLength);
@@ -415,12 +561,20 @@ bool Connection::sendOutgoingMessage(std::unique_ptr<MessageEncoder> encoder)
 {
     COMPILE_ASSERT(sizeof(MessageInfo) + attachmentMaxAmount * sizeof(size_t) <= messageMaxSize, AttachmentsFitToMessageInline);
 
+    if (m_shouldUseSharedMemoryRing && !m_outgoingRing && !setUpOutgoingRing()) {
+        // Keep sending everything through the socket.
+        m_shouldUseSharedMemoryRing = false;
+    }
+
     Vector<Attachment> attachments = encoder->releaseAttachments();
     if (attachments.size() > (attachmentMaxAmount - 1)) {
         ASSERT_NOT_REACHED();
         return false;
     }
 
+    if (m_outgoingRing && attachments.isEmpty() && encoder->bufferSize() <= ringMaxMessageBodySize)
+        return writeToOutgoingRing(RingRecordMessage, encoder->buffer(), encoder->bufferSize());
+
     MessageInfo messageInfo(encoder->bufferSize(), attachments.size());
     size_t messageSizeWithBodyInline = sizeof(messageInfo) + (attachments.size() * sizeof(AttachmentInfo)) + encoder->bufferSize();
     if (messageSizeWithBodyInline > messageMaxSize && encoder->bufferSize()) {
@@ -439,6 +593,91 @@ bool Connection::sendOutgoingMessage(std::unique_ptr<MessageEncoder> encoder)
         attachments.append(handle.releaseAttachment());
     }
 
+    if (m_outgoingRing) {
+        messageInfo.setKind(MessageKind::MessageOrderedAfterRing);
+        if (!writeToOutgoingRing(RingRecordSocketMessageMarker, nullptr, 0))
+            return false;
+    }
+
+    return sendMessageOverSocket(messageInfo, attachments, encoder->buffer());
+}
+
+bool Connection::setUpOutgoingRing()
+{
+    RefPtr<WebKit::SharedMemory> ring = WebKit::SharedMemory::allocate(ringDataOffset + ringDataSize);
+    if (!ring)
+        return false;
+
+    WebKit::SharedMemory::Handle handle;
+    if (!ring->createHandle(handle, WebKit::SharedMemory::Protection::ReadWrite))
+        return false;
+
+    new (NotNull, ring->data()) RingHeader;
+
+    MessageInfo messageInfo(0, 1);
+    messageInfo.setKind(MessageKind::RingSetup);
+    Vector<Attachment> attachments;
+    attachments.append(handle.releaseAttachment());
+    if (!sendMessageOverSocket(messageInfo, attachments, nullptr))
+        return false;
+
+    m_outgoingRing = WTF::move(ring);
+    m_outgoingRingWritePosition = 0;
+    return true;
+}
+
+bool Connection::writeToOutgoingRing(uint32_t recordType, const uint8_t* body, size_t bodySize)
+{
+    RingHeader& header = ringHeader(*m_outgoingRing);
+    uint8_t* data = ringData(*m_outgoingRing);
+
+    uint64_t previousWritePosition = m_outgoingRingWritePosition;
+    size_t offset = previousWritePosition % ringDataSize;
+    size_t recordSize = ringRecordSize(bodySize);
+    size_t paddingSize = offset + recordSize > ringDataSize ? ringDataSize - offset : 0;
+
+    // Wait for the receiver to make room, the same way a full socket makes us wait for POLLOUT.
+    while (previousWritePosition + paddingSize + recordSize - header.readPosition.load() > ringDataSize) {
+        struct pollfd pollfd;
+        pollfd.fd = m_socketDescriptor;
+        pollfd.events = 0;
+        pollfd.revents = 0;
+        if (poll(&pollfd, 1, 1) > 0 && pollfd.revents & (POLLHUP | POLLERR | POLLNVAL))
+            return false;
+    }
+
+    uint64_t writePosition = previousWritePosition;
+    if (paddingSize) {
+        RingRecordHeader paddingHeader = { RingRecordPadding, 0 };
+        memcpy(data + offset, &paddingHeader, sizeof(paddingHeader));
+        writePosition += paddingSize;
+        offset = 0;
+    }
+
+    RingRecordHeader recordHeader = { recordType, static_cast<uint32_t>(bodySize) };
+    memcpy(data + offset, &recordHeader, sizeof(recordHeader));
+    if (bodySize)
+        memcpy(data + offset + sizeof(recordHeader), body, bodySize);
+    writePosition += recordSize;
+
+    m_outgoingRingWritePosition = writePosition;
+    header.writePosition.store(writePosition);
+
+    // The message that follows a marker wakes up the receiver on its own.
+    if (recordType == RingRecordSocketMessageMarker)
+        return true;
+
+    // The receiver is still processing records unless it has consumed everything written before this one.
+    if (header.readPosition.load() != previousWritePosition)
+        return true;
+
+    MessageInfo doorbell(0, 0);
+    doorbell.setKind(MessageKind::RingDoorbell);
+    return sendMessageOverSocket(doorbell, Vector<Attachment>(), nullptr);
+}
+
+bool Connection::sendMessageOverSocket(MessageInfo& messageInfo, const Vector<Attachment>& attachments, const uint8_t* body)
+{
     struct msghdr message;
     memset(&message, 0, sizeof(message));
 
@@ -504,9 +743,9 @@ bool Connection::sendOutgoingMessage(std::unique_ptr<MessageEncoder> encoder)
         ++iovLength;
     }
 
-    if (!messageInfo.isMessageBodyIsOutOfLine() && encoder->bufferSize()) {
-        iov[iovLength].iov_base = reinterpret_cast<void*>(encoder->buffer());
-        iov[iovLength].iov_len = encoder->bufferSize();
+    if (!messageInfo.isMessageBodyIsOutOfLine() && messageInfo.bodySize()) {
+        iov[iovLength].iov_base = const_cast<uint8_t*>(body);
+        iov[iovLength].iov_len = messageInfo.bodySize();
         ++iovLength;
     }
 
@@ -149,6 +149,10 @@ void ChildProcessProxy::didFinishLaunching(ProcessLauncher*, IPC::Connection::Id
 #if PLATFORM(MAC) && __MAC_OS_X_VERSION_MIN_REQUIRED <= 101000
     m_connection->setShouldCloseConnectionOnMachExceptions();
 #endif
+#if USE(UNIX_DOMAIN_SOCKETS)
+    // Input events are sent to child processes at a high rate.
+    m_connection->setShouldUseSharedMemoryRing();
+#endif
 
     connectionWillOpen(*m_connection);
     m_connection->open();
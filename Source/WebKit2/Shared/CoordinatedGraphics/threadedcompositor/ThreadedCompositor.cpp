@@ -28,6 +28,7 @@
 #if USE(COORDINATED_GRAPHICS_THREADED)
 #include "ThreadedCompositor.h"
 
+#include <WebCore/PlatformWheelEvent.h>
 #include <WebCore/TransformationMatrix.h>
 #include <wtf/CurrentTime.h>
 #include <wtf/RunLoop.h>
@@ -184,6 +185,41 @@ void ThreadedCompositor::scrollBy(const IntSize& delta)
     });
 }
 
+void ThreadedCompositor::setScrollingState(const Region& nonFastScrollableRegion, bool mustScrollOnMainThread)
+{
+    ASSERT(isMainThread());
+
+    LockHolder locker(m_scrollingStateLock);
+    m_nonFastScrollableRegion = nonFastScrollableRegion;
+    m_mustScrollOnMainThread = mustScrollOnMainThread;
+}
+
+bool ThreadedCompositor::tryToScrollForWheelEvent(const PlatformWheelEvent& event)
+{
+    // Line and page scrolling, and the modifiers that turn wheel events into zooming or horizontal
+    // scrolling, are up to the event handler.
+    if (event.granularity() != ScrollByPixelWheelEvent || event.modifiers())
+        return false;
+
+    IntSize scrollOffset;
+    {
+        LockHolder locker(m_scrollingStateLock);
+        if (m_mustScrollOnMainThread)
+            return false;
+
+        FloatPoint contentsPosition = event.position();
+        contentsPosition.scale(1 / m_pageScaleFactor, 1 / m_pageScaleFactor);
+        contentsPosition.moveBy(m_visibleContentsRect.location());
+        if (m_nonFastScrollableRegion.contains(roundedIntPoint(contentsPosition)))
+            return false;
+
+        scrollOffset = roundedIntSize(FloatSize(-event.deltaX() / m_pageScaleFactor, -event.deltaY() / m_pageScaleFactor));
+    }
+
+    scrollBy(scrollOffset);
+    return true;
+}
+
 void ThreadedCompositor::purgeBackingStores()
 {
     m_client->purgeBackingStores();
@@ -243,6 +279,13 @@ void ThreadedCompositor::didChangeVisibleRect()
 {
     FloatRect visibleRect = viewportController()->visibleContentsRect();
     float scale = viewportController()->pageScaleFactor();
+
+    {
+        LockHolder locker(m_scrollingStateLock);
+        m_visibleContentsRect = visibleRect;
+        m_pageScaleFactor = scale;
+    }
+
     callOnMainThread([=] {
         m_client->setVisibleContentsRect(visibleRect, FloatPoint::zero(), scale);
     });
@@ -32,14 +32,17 @@
 #include "SimpleViewportController.h"
 #include <WebCore/GLContext.h>
 #include <WebCore/IntSize.h>
+#include <WebCore/Region.h>
 #include <WebCore/TransformationMatrix.h>
 #include <wtf/Condition.h>
 #include <wtf/FastMalloc.h>
+#include <wtf/Lock.h>
 #include <wtf/Noncopyable.h>
 #include <wtf/ThreadSafeRefCounted.h>
 #include <wtf/Threading.h>
 
 namespace WebCore {
+class PlatformWheelEvent;
 struct CoordinatedGraphicsState;
 }
 
@@ -76,6 +79,15 @@ public:
     void scrollTo(const WebCore::IntPoint&);
     void scrollBy(const WebCore::IntSize&);
 
+    // The main thread keeps the compositor up to date with the parts of the contents that need to see
+    // the wheel events, and whether anything else prevents scrolling without it.
+    void setScrollingState(const WebCore::Region& nonFastScrollableRegion, bool mustScrollOnMainThread);
+
+    // Can be called from any thread. Scrolls the viewport on the compositing thread and returns true, or
+    // returns false if the event has to be handled on the main thread. The main thread learns about the
+    // new scroll position through Client::setVisibleContentsRect() as with any other scroll.
+    bool tryToScrollForWheelEvent(const WebCore::PlatformWheelEvent&);
+
 private:
     ThreadedCompositor(Client*);
 
@@ -115,6 +127,12 @@ private:
     Lock m_initializeRunLoopConditionMutex;
     Condition m_terminateRunLoopCondition;
     Lock m_terminateRunLoopConditionMutex;
+
+    Lock m_scrollingStateLock;
+    WebCore::Region m_nonFastScrollableRegion;
+    bool m_mustScrollOnMainThread { true };
+    WebCore::FloatRect m_visibleContentsRect;
+    float m_pageScaleFactor { 1 };
 };
 
 } // namespace WebKit
@@ -27,15 +27,71 @@
 #include "VisitedLinkTable.h"
 
 #include "SharedMemory.h"
+#include <wtf/Vector.h>
 
 using namespace WebCore;
 
 namespace WebKit {
 
+// The hash table is kept at least half empty.
+static const unsigned hashTableMaxLoad = 2;
+
+static const unsigned cuckooFilterBucketSize = 4;
+static const unsigned cuckooFilterMaxLoadPercentage = 90;
+static const unsigned cuckooFilterMaxRelocationCount = 500;
+
+static unsigned nextPowerOf2(unsigned v)
+{
+    // Taken from http://www.cs.utk.edu/~vose/c-stuff/bithacks.html
+    // Devised by Sean Anderson, Sepember 14, 2001
+
+    v--;
+    v |= v >> 1;
+    v |= v >> 2;
+    v |= v >> 4;
+    v |= v >> 8;
+    v |= v >> 16;
+    v++;
+
+    return v;
+}
+
+size_t VisitedLinkTable::sizeForLinkCount(Format format, unsigned linkCount)
+{
+    size_t size;
+    switch (format) {
+    case Format::HashTable:
+        size = nextPowerOf2(linkCount * hashTableMaxLoad) * sizeof(LinkHash);
+        break;
+    case Format::CuckooFilter: {
+        unsigned slotCount = (static_cast<uint64_t>(linkCount) * 100 + cuckooFilterMaxLoadPercentage - 1) / cuckooFilterMaxLoadPercentage;
+        size = nextPowerOf2(std::max(slotCount, cuckooFilterBucketSize)) * sizeof(uint16_t);
+        break;
+    }
+    }
+
+    // Ensure that the table size is at least the size of a page.
+    return std::max(size, SharedMemory::systemPageSize());
+}
+
+unsigned VisitedLinkTable::capacity(Format format, size_t size)
+{
+    switch (format) {
+    case Format::HashTable:
+        return size / sizeof(LinkHash) / hashTableMaxLoad;
+    case Format::CuckooFilter:
+        return static_cast<uint64_t>(size / sizeof(uint16_t)) * cuckooFilterMaxLoadPercentage / 100;
+    }
+    ASSERT_NOT_REACHED();
+    return 0;
+}
+
 VisitedLinkTable::VisitedLinkTable()
-    : m_tableSize(0)
+    : m_format(Format::HashTable)
+    , m_tableSize(0)
     , m_tableSizeMask(0)
     , m_table(nullptr)
+    , m_fingerprints(nullptr)
 {
 }
 
@@ -52,17 +108,29 @@ static inline bool isPowerOf2(unsigned v)
 }
 #endif
 
-void VisitedLinkTable::setSharedMemory(PassRefPtr<SharedMemory> sharedMemory)
+void VisitedLinkTable::setSharedMemory(PassRefPtr<SharedMemory> sharedMemory, Format format)
 {
     m_sharedMemory = sharedMemory;
-    
+    m_format = format;
+
     ASSERT(m_sharedMemory);
-    ASSERT(!(m_sharedMemory->size() % sizeof(LinkHash)));
 
-    m_table = static_cast<LinkHash*>(m_sharedMemory->data());
-    m_tableSize = m_sharedMemory->size() / sizeof(LinkHash);
+    switch (m_format) {
+    case Format::HashTable:
+        ASSERT(!(m_sharedMemory->size() % sizeof(LinkHash)));
+        m_table = static_cast<LinkHash*>(m_sharedMemory->data());
+        m_fingerprints = nullptr;
+        m_tableSize = m_sharedMemory->size() / sizeof(LinkHash);
+        break;
+    case Format::CuckooFilter:
+        ASSERT(!(m_sharedMemory->size() % (cuckooFilterBucketSize * sizeof(uint16_t))));
+        m_table = nullptr;
+        m_fingerprints = static_cast<uint16_t*>(m_sharedMemory->data());
+        m_tableSize = m_sharedMemory->size() / (cuckooFilterBucketSize * sizeof(uint16_t));
+        break;
+    }
     ASSERT(isPowerOf2(m_tableSize));
-    
+
     m_tableSizeMask = m_tableSize - 1;
 }
 
@@ -76,10 +144,37 @@ static inline unsigned doubleHash(unsigned key)
     return key;
 }
     
-bool VisitedLinkTable::addLinkHash(LinkHash linkHash)
+VisitedLinkTable::AddResult VisitedLinkTable::addLinkHash(LinkHash linkHash)
 {
     ASSERT(m_sharedMemory);
 
+    switch (m_format) {
+    case Format::HashTable:
+        return addLinkHashToHashTable(linkHash);
+    case Format::CuckooFilter:
+        return addLinkHashToCuckooFilter(linkHash);
+    }
+    ASSERT_NOT_REACHED();
+    return AddResult::TableFull;
+}
+
+bool VisitedLinkTable::isLinkVisited(LinkHash linkHash) const
+{
+    if (!m_sharedMemory)
+        return false;
+
+    switch (m_format) {
+    case Format::HashTable:
+        return hashTableContains(linkHash);
+    case Format::CuckooFilter:
+        return cuckooFilterContains(linkHash);
+    }
+    ASSERT_NOT_REACHED();
+    return false;
+}
+
+VisitedLinkTable::AddResult VisitedLinkTable::addLinkHashToHashTable(LinkHash linkHash)
+{
     int k = 0;
     LinkHash* table = m_table;
     int sizeMask = m_tableSizeMask;
@@ -96,7 +191,7 @@ bool VisitedLinkTable::addLinkHash(LinkHash linkHash)
 
         // Check if the same link hash is in the table already.
         if (*entry == linkHash)
-            return false;
+            return AddResult::AlreadyPresent;
 
         if (!k)
             k = 1 | doubleHash(h);
@@ -104,14 +199,11 @@ bool VisitedLinkTable::addLinkHash(LinkHash linkHash)
     }
 
     *entry = linkHash;
-    return true;
+    return AddResult::Added;
 }
 
-bool VisitedLinkTable::isLinkVisited(LinkHash linkHash) const
+bool VisitedLinkTable::hashTableContains(LinkHash linkHash) const
 {
-    if (!m_sharedMemory)
-        return false;
-
     int k = 0;
     LinkHash* table = m_table;
     int sizeMask = m_tableSizeMask;
@@ -137,10 +229,95 @@ bool VisitedLinkTable::isLinkVisited(LinkHash linkHash) const
     return false;
 }
 
+// A link hash maps to a fingerprint made of its high bits, which is never zero since that marks an
+// empty slot, and to two buckets: one given by its low bits, and one derived from the first bucket and
+// the fingerprint alone, so that an entry can be moved to its other bucket without the link hash.
+static inline uint16_t fingerprintForLinkHash(LinkHash linkHash)
+{
+    uint16_t fingerprint = static_cast<uint16_t>(linkHash >> 48);
+    return fingerprint ? fingerprint : 1;
+}
+
+static inline unsigned alternateBucket(unsigned bucket, uint16_t fingerprint, unsigned sizeMask)
+{
+    return (bucket ^ doubleHash(fingerprint)) & sizeMask;
+}
+
+static inline bool bucketContains(const uint16_t* bucket, uint16_t fingerprint)
+{
+    for (unsigned i = 0; i < cuckooFilterBucketSize; ++i) {
+        if (bucket[i] == fingerprint)
+            return true;
+    }
+    return false;
+}
+
+static inline bool insertIntoBucket(uint16_t* bucket, uint16_t fingerprint)
+{
+    for (unsigned i = 0; i < cuckooFilterBucketSize; ++i) {
+        if (!bucket[i]) {
+            bucket[i] = fingerprint;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool VisitedLinkTable::cuckooFilterContains(LinkHash linkHash) const
+{
+    uint16_t fingerprint = fingerprintForLinkHash(linkHash);
+    unsigned bucket = static_cast<unsigned>(linkHash) & m_tableSizeMask;
+    if (bucketContains(m_fingerprints + bucket * cuckooFilterBucketSize, fingerprint))
+        return true;
+
+    bucket = alternateBucket(bucket, fingerprint, m_tableSizeMask);
+    return bucketContains(m_fingerprints + bucket * cuckooFilterBucketSize, fingerprint);
+}
+
+VisitedLinkTable::AddResult VisitedLinkTable::addLinkHashToCuckooFilter(LinkHash linkHash)
+{
+    // A fingerprint matching in either bucket may be a false positive, but the link would then be
+    // reported as visited anyway.
+    if (cuckooFilterContains(linkHash))
+        return AddResult::AlreadyPresent;
+
+    uint16_t fingerprint = fingerprintForLinkHash(linkHash);
+    unsigned bucket = static_cast<unsigned>(linkHash) & m_tableSizeMask;
+    if (insertIntoBucket(m_fingerprints + bucket * cuckooFilterBucketSize, fingerprint))
+        return AddResult::Added;
+
+    bucket = alternateBucket(bucket, fingerprint, m_tableSizeMask);
+    if (insertIntoBucket(m_fingerprints + bucket * cuckooFilterBucketSize, fingerprint))
+        return AddResult::Added;
+
+    // Both buckets are full: evict entries to their alternate bucket until one of them finds room,
+    // remembering the slots we swapped so they can be put back if none does.
+    Vector<unsigned, 32> swappedSlots;
+    unsigned slotSelector = static_cast<unsigned>(linkHash >> 32);
+    for (unsigned relocation = 0; relocation < cuckooFilterMaxRelocationCount; ++relocation) {
+        slotSelector = doubleHash(slotSelector);
+        unsigned slot = bucket * cuckooFilterBucketSize + slotSelector % cuckooFilterBucketSize;
+        std::swap(fingerprint, m_fingerprints[slot]);
+        swappedSlots.append(slot);
+
+        bucket = alternateBucket(bucket, fingerprint, m_tableSizeMask);
+        if (insertIntoBucket(m_fingerprints + bucket * cuckooFilterBucketSize, fingerprint))
+            return AddResult::Added;
+    }
+
+    for (size_t i = swappedSlots.size(); i; --i)
+        std::swap(fingerprint, m_fingerprints[swappedSlots[i - 1]]);
+    ASSERT(fingerprint == fingerprintForLinkHash(linkHash));
+
+    return AddResult::TableFull;
+}
+
 void VisitedLinkTable::clear()
 {
     m_tableSize = 0;
     m_tableSizeMask = 0;
+    m_table = nullptr;
+    m_fingerprints = nullptr;
     m_sharedMemory = nullptr;
 }
 
@@ -36,25 +36,56 @@ class SharedMemory;
 
 class VisitedLinkTable {
 public:
+    // A hash table stores the link hashes themselves. A cuckoo filter only stores 16-bit fingerprints
+    // of them in buckets of four, so it takes a fifth of the memory for the same number of links, but
+    // reports about one link in 8000 that was never visited as visited.
+    enum class Format : uint32_t {
+        HashTable,
+        CuckooFilter,
+    };
+
+    static bool isValidFormat(uint32_t format) { return format <= static_cast<uint32_t>(Format::CuckooFilter); }
+
+    // The memory size of a table holding the given number of links, and the number of links a table
+    // of that size can take.
+    static size_t sizeForLinkCount(Format, unsigned linkCount);
+    static unsigned capacity(Format, size_t size);
+
     VisitedLinkTable();
     ~VisitedLinkTable();
 
-    void setSharedMemory(PassRefPtr<SharedMemory>);
+    void setSharedMemory(PassRefPtr<SharedMemory>, Format = Format::HashTable);
 
     // This should only be called from the UI process.
-    bool addLinkHash(WebCore::LinkHash);
+    enum class AddResult {
+        Added,
+        AlreadyPresent,
+        // A cuckoo filter can run out of room before reaching its capacity, in which case it is left unchanged.
+        TableFull,
+    };
+    AddResult addLinkHash(WebCore::LinkHash);
 
     bool isLinkVisited(WebCore::LinkHash) const;
 
+    Format format() const { return m_format; }
     SharedMemory* sharedMemory() const { return m_sharedMemory.get(); }
     void clear();
 
 private:
+    AddResult addLinkHashToHashTable(WebCore::LinkHash);
+    bool hashTableContains(WebCore::LinkHash) const;
+
+    AddResult addLinkHashToCuckooFilter(WebCore::LinkHash);
+    bool cuckooFilterContains(WebCore::LinkHash) const;
+
     RefPtr<SharedMemory> m_sharedMemory;
+    Format m_format;
 
+    // In link hashes for a hash table, in buckets for a cuckoo filter.
     unsigned m_tableSize;
     unsigned m_tableSizeMask;
     WebCore::LinkHash* m_table;
+    uint16_t* m_fingerprints;
 };
 
 }
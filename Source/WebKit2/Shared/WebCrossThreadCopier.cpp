@@ -67,6 +67,26 @@ Vector<uint8_t> CrossThreadCopierBase<false, false, Vector<uint8_t>>::copy(const
     return result;
 }
 
+Vector<Vector<uint8_t>> CrossThreadCopierBase<false, false, Vector<Vector<uint8_t>>>::copy(const Vector<Vector<uint8_t>>& vector)
+{
+    Vector<Vector<uint8_t>> result;
+    result.reserveInitialCapacity(vector.size());
+    for (const auto& bytes : vector)
+        result.uncheckedAppend(bytes);
+
+    return result;
+}
+
+Vector<IDBKeyData> CrossThreadCopierBase<false, false, Vector<IDBKeyData>>::copy(const Vector<IDBKeyData>& vector)
+{
+    Vector<IDBKeyData> result;
+    result.reserveInitialCapacity(vector.size());
+    for (const auto& key : vector)
+        result.uncheckedAppend(WebCore::CrossThreadCopier<IDBKeyData>::copy(key));
+
+    return result;
+}
+
 Vector<Vector<IDBKeyData>> CrossThreadCopierBase<false, false, Vector<Vector<IDBKeyData>>>::copy(const Vector<Vector<IDBKeyData>>& vector)
 {
     Vector<Vector<IDBKeyData>> result;
@@ -80,6 +80,14 @@ template<> struct CrossThreadCopierBase<false, false, Vector<uint8_t>> {
     static Vector<uint8_t> copy(const Vector<uint8_t>&);
 };
 
+template<> struct CrossThreadCopierBase<false, false, Vector<Vector<uint8_t>>> {
+    static Vector<Vector<uint8_t>> copy(const Vector<Vector<uint8_t>>&);
+};
+
+template<> struct CrossThreadCopierBase<false, false, Vector<IDBKeyData>> {
+    static Vector<IDBKeyData> copy(const Vector<IDBKeyData>&);
+};
+
 template<> struct CrossThreadCopierBase<false, false, Vector<Vector<IDBKeyData>>> {
     static Vector<Vector<IDBKeyData>> copy(const Vector<Vector<IDBKeyData>>&);
 };
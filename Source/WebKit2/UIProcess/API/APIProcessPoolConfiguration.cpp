@@ -77,6 +77,9 @@ Ref<ProcessPoolConfiguration> ProcessPoolConfiguration::copy()
     copy->m_processModel = this->m_processModel;
     copy->m_useNetworkProcess = this->m_useNetworkProcess;
     copy->m_maximumProcessCount = this->m_maximumProcessCount;
+    copy->m_prewarmedProcessCount = this->m_prewarmedProcessCount;
+    copy->m_webProcessMemoryBudget = this->m_webProcessMemoryBudget;
+    copy->m_usesCompactVisitedLinkTable = this->m_usesCompactVisitedLinkTable;
     copy->m_cacheModel = this->m_cacheModel;
     copy->m_diskCacheSizeOverride = this->m_diskCacheSizeOverride;
     copy->m_applicationCacheDirectory = this->m_applicationCacheDirectory;
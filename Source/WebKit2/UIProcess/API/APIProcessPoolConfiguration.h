@@ -57,6 +57,19 @@ public:
     unsigned maximumProcessCount() const { return m_maximumProcessCount; }
     void setMaximumProcessCount(unsigned maximumProcessCount) { m_maximumProcessCount = maximumProcessCount; } 
 
+    // The number of initialized web processes kept ready for new pages, once the first one has been used.
+    unsigned prewarmedProcessCount() const { return m_prewarmedProcessCount; }
+    void setPrewarmedProcessCount(unsigned prewarmedProcessCount) { m_prewarmedProcessCount = prewarmedProcessCount; }
+
+    // The memory all web processes together should stay under, in bytes. Zero means no budget.
+    uint64_t webProcessMemoryBudget() const { return m_webProcessMemoryBudget; }
+    void setWebProcessMemoryBudget(uint64_t webProcessMemoryBudget) { m_webProcessMemoryBudget = webProcessMemoryBudget; }
+
+    // Whether visited links are shared with web processes as a cuckoo filter, which is much smaller than
+    // a hash table but reports a few links that were never visited as visited.
+    bool usesCompactVisitedLinkTable() const { return m_usesCompactVisitedLinkTable; }
+    void setUsesCompactVisitedLinkTable(bool usesCompactVisitedLinkTable) { m_usesCompactVisitedLinkTable = usesCompactVisitedLinkTable; }
+
     WebKit::CacheModel cacheModel() const { return m_cacheModel; }
     void setCacheModel(WebKit::CacheModel cacheModel) { m_cacheModel = cacheModel; }
 
@@ -99,6 +112,9 @@ private:
     WebKit::ProcessModel m_processModel { WebKit::ProcessModelMultipleSecondaryProcesses };
     bool m_useNetworkProcess { true };
     unsigned m_maximumProcessCount { 0 };
+    unsigned m_prewarmedProcessCount { 0 };
+    uint64_t m_webProcessMemoryBudget { 0 };
+    bool m_usesCompactVisitedLinkTable { false };
     WebKit::CacheModel m_cacheModel { WebKit::CacheModelPrimaryWebBrowser };
     int64_t m_diskCacheSizeOverride { -1 };
 
@@ -37,6 +37,7 @@
 #include "WebCompiledContentExtension.h"
 #include <WebCore/ContentExtensionCompiler.h>
 #include <WebCore/ContentExtensionError.h>
+#include <WebCore/DFACache.h>
 #include <string>
 #include <wtf/NeverDestroyed.h>
 #include <wtf/RunLoop.h>
@@ -74,6 +75,26 @@ UserContentExtensionStore::~UserContentExtensionStore()
 {
 }
 
+std::unique_ptr<WebCore::ContentExtensions::DFACache> UserContentExtensionStore::takeDFACache(const WTF::String& identifier)
+{
+    LockHolder locker(m_dfaCachesLock);
+    if (auto cache = m_dfaCaches.take(identifier))
+        return cache;
+    return std::make_unique<WebCore::ContentExtensions::DFACache>();
+}
+
+void UserContentExtensionStore::setDFACache(const WTF::String& identifier, std::unique_ptr<WebCore::ContentExtensions::DFACache> cache)
+{
+    LockHolder locker(m_dfaCachesLock);
+    m_dfaCaches.set(identifier, WTF::move(cache));
+}
+
+void UserContentExtensionStore::removeDFACache(const WTF::String& identifier)
+{
+    LockHolder locker(m_dfaCachesLock);
+    m_dfaCaches.remove(identifier);
+}
+
 static String constructedPath(const String& base, const String& identifier)
 {
     return WebCore::pathByAppendingComponent(base, "ContentExtension-" + WebCore::encodeForFileName(identifier));
@@ -163,7 +184,7 @@ static bool writeDataToFile(const Data& fileData, WebCore::PlatformFileHandle fd
     return success;
 }
 
-static std::error_code compiledToFile(String&& json, const String& finalFilePath, ContentExtensionMetaData& metaData, Data& mappedData)
+static std::error_code compiledToFile(String&& json, const String& finalFilePath, ContentExtensionMetaData& metaData, Data& mappedData, WebCore::ContentExtensions::DFACache* dfaCache)
 {
     using namespace WebCore::ContentExtensions;
 
@@ -260,7 +281,7 @@ static std::error_code compiledToFile(String&& json, const String& finalFilePath
 
     CompilationClient compilationClient(temporaryFileHandle, metaData);
     
-    if (auto compilerError = compileRuleList(compilationClient, WTF::move(json))) {
+    if (auto compilerError = compileRuleList(compilationClient, WTF::move(json), dfaCache)) {
         WebCore::closeFile(temporaryFileHandle);
         return compilerError;
     }
@@ -348,13 +369,16 @@ void UserContentExtensionStore::compileContentExtension(const WTF::String& ident
 
         ContentExtensionMetaData metaData;
         Data fileData;
-        auto error = compiledToFile(jsonCapture.releaseString(), path, metaData, fileData);
+        // A content extension being compiled concurrently with itself gets an empty cache.
+        auto dfaCache = self->takeDFACache(identifierCapture.string());
+        auto error = compiledToFile(jsonCapture.releaseString(), path, metaData, fileData, dfaCache.get());
         if (error) {
             RunLoop::main().dispatch([self, error, completionHandler] {
                 completionHandler(nullptr, error);
             });
             return;
         }
+        self->setDFACache(identifierCapture.string(), WTF::move(dfaCache));
 
         RunLoop::main().dispatch([self, identifierCapture, fileData, metaData, completionHandler] {
             RefPtr<API::UserContentExtension> userContentExtension = createExtension(identifierCapture.string(), metaData, fileData);
@@ -365,6 +389,8 @@ void UserContentExtensionStore::compileContentExtension(const WTF::String& ident
 
 void UserContentExtensionStore::removeContentExtension(const WTF::String& identifier, std::function<void(std::error_code)> completionHandler)
 {
+    removeDFACache(identifier);
+
     RefPtr<UserContentExtensionStore> self(this);
     StringCapture identifierCapture(identifier);
     StringCapture pathCapture(m_storePath);
@@ -387,6 +413,11 @@ void UserContentExtensionStore::removeContentExtension(const WTF::String& identi
 
 void UserContentExtensionStore::synchronousRemoveAllContentExtensions()
 {
+    {
+        LockHolder locker(m_dfaCachesLock);
+        m_dfaCaches.clear();
+    }
+
     for (const auto& path : WebCore::listDirectory(m_storePath, "*"))
         WebCore::deleteFile(path);
 }
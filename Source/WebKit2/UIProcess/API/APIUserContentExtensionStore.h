@@ -30,12 +30,21 @@
 
 #include "APIObject.h"
 #include <system_error>
+#include <wtf/HashMap.h>
+#include <wtf/Lock.h>
+#include <wtf/text/StringHash.h>
 #include <wtf/text/WTFString.h>
 
 namespace WTF {
 class WorkQueue;
 }
 
+namespace WebCore {
+namespace ContentExtensions {
+class DFACache;
+}
+}
+
 namespace API {
 
 class UserContentExtension;
@@ -51,7 +60,7 @@ public:
     
     // This should be incremented every time a functional change is made to the bytecode, file format, etc.
     // to prevent crashing while loading old data.
-    const static uint32_t CurrentContentExtensionFileVersion = 7;
+    const static uint32_t CurrentContentExtensionFileVersion = 8;
 
     static UserContentExtensionStore& defaultStore();
     static Ref<UserContentExtensionStore> storeWithPath(const WTF::String& storePath);
@@ -70,10 +79,18 @@ public:
 private:
     WTF::String defaultStorePath();
 
+    std::unique_ptr<WebCore::ContentExtensions::DFACache> takeDFACache(const WTF::String& identifier);
+    void setDFACache(const WTF::String& identifier, std::unique_ptr<WebCore::ContentExtensions::DFACache>);
+    void removeDFACache(const WTF::String& identifier);
+
     const WTF::String m_storePath;
     Ref<WTF::WorkQueue> m_compileQueue;
     Ref<WTF::WorkQueue> m_readQueue;
     Ref<WTF::WorkQueue> m_removeQueue;
+
+    // The DFAs built for the last compilation of each content extension, reused when it is compiled again.
+    Lock m_dfaCachesLock;
+    HashMap<WTF::String, std::unique_ptr<WebCore::ContentExtensions::DFACache>> m_dfaCaches;
 };
 
 const std::error_category& userContentExtensionStoreErrorCategory();
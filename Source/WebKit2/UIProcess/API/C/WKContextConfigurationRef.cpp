@@ -112,6 +112,36 @@ void WKContextConfigurationSetMediaKeysStorageDirectory(WKContextConfigurationRe
     toImpl(configuration)->setMediaKeysStorageDirectory(toImpl(mediaKeysStorageDirectory)->string());
 }
 
+unsigned WKContextConfigurationPrewarmedProcessCount(WKContextConfigurationRef configuration)
+{
+    return toImpl(configuration)->prewarmedProcessCount();
+}
+
+void WKContextConfigurationSetPrewarmedProcessCount(WKContextConfigurationRef configuration, unsigned prewarmedProcessCount)
+{
+    toImpl(configuration)->setPrewarmedProcessCount(prewarmedProcessCount);
+}
+
+uint64_t WKContextConfigurationWebProcessMemoryBudget(WKContextConfigurationRef configuration)
+{
+    return toImpl(configuration)->webProcessMemoryBudget();
+}
+
+void WKContextConfigurationSetWebProcessMemoryBudget(WKContextConfigurationRef configuration, uint64_t webProcessMemoryBudget)
+{
+    toImpl(configuration)->setWebProcessMemoryBudget(webProcessMemoryBudget);
+}
+
+bool WKContextConfigurationUsesCompactVisitedLinkTable(WKContextConfigurationRef configuration)
+{
+    return toImpl(configuration)->usesCompactVisitedLinkTable();
+}
+
+void WKContextConfigurationSetUsesCompactVisitedLinkTable(WKContextConfigurationRef configuration, bool usesCompactVisitedLinkTable)
+{
+    toImpl(configuration)->setUsesCompactVisitedLinkTable(usesCompactVisitedLinkTable);
+}
+
 bool WKContextConfigurationFullySynchronousModeIsAllowedForTesting(WKContextConfigurationRef configuration)
 {
     return toImpl(configuration)->fullySynchronousModeIsAllowedForTesting();
@@ -55,6 +55,15 @@ WK_EXPORT void WKContextConfigurationSetWebSQLDatabaseDirectory(WKContextConfigu
 WK_EXPORT WKStringRef WKContextConfigurationCopyMediaKeysStorageDirectory(WKContextConfigurationRef configuration);
 WK_EXPORT void WKContextConfigurationSetMediaKeysStorageDirectory(WKContextConfigurationRef configuration, WKStringRef mediaKeysStorageDirectory);
 
+WK_EXPORT unsigned WKContextConfigurationPrewarmedProcessCount(WKContextConfigurationRef configuration);
+WK_EXPORT void WKContextConfigurationSetPrewarmedProcessCount(WKContextConfigurationRef configuration, unsigned prewarmedProcessCount);
+
+WK_EXPORT uint64_t WKContextConfigurationWebProcessMemoryBudget(WKContextConfigurationRef configuration);
+WK_EXPORT void WKContextConfigurationSetWebProcessMemoryBudget(WKContextConfigurationRef configuration, uint64_t webProcessMemoryBudget);
+
+WK_EXPORT bool WKContextConfigurationUsesCompactVisitedLinkTable(WKContextConfigurationRef configuration);
+WK_EXPORT void WKContextConfigurationSetUsesCompactVisitedLinkTable(WKContextConfigurationRef configuration, bool usesCompactVisitedLinkTable);
+
 WK_EXPORT bool WKContextConfigurationFullySynchronousModeIsAllowedForTesting(WKContextConfigurationRef configuration);
 WK_EXPORT void WKContextConfigurationSetFullySynchronousModeIsAllowedForTesting(WKContextConfigurationRef configuration, bool allowed);
 
@@ -56,7 +56,8 @@ void BackingStore::incorporateUpdate(const UpdateInfo& updateInfo)
 #if !ASSERT_DISABLED
     IntSize updateSize = updateInfo.updateRectBounds.size();
     updateSize.scale(m_deviceScaleFactor);
-    ASSERT(bitmap->size() == updateSize);
+    // The web process may paint updates at the top left of a bitmap as big as the view, which it reuses.
+    ASSERT(IntRect(IntPoint(), bitmap->size()).contains(IntRect(IntPoint(), updateSize)));
 #endif
     
     incorporateUpdate(bitmap.get(), updateInfo);
@@ -38,7 +38,7 @@ using namespace WebCore;
 
 namespace WebKit {
 
-static const int visitedLinkTableMaxLoad = 2;
+static const size_t maximumTableSegmentCount = 4;
 
 static uint64_t generateIdentifier()
 {
@@ -62,8 +62,9 @@ VisitedLinkStore::~VisitedLinkStore()
 
 VisitedLinkStore::VisitedLinkStore()
     : m_identifier(generateIdentifier())
+    , m_tableFormat(VisitedLinkTable::Format::HashTable)
     , m_keyCount(0)
-    , m_tableSize(0)
+    , m_lastTableKeyCount(0)
     , m_pendingVisitedLinksTimer(RunLoop::main(), this, &VisitedLinkStore::pendingVisitedLinksTimerFired)
 {
 }
@@ -77,12 +78,8 @@ void VisitedLinkStore::addProcess(WebProcessProxy& process)
 
     process.addMessageReceiver(Messages::VisitedLinkStore::messageReceiverName(), m_identifier, *this);
 
-    if (!m_keyCount)
-        return;
-
-    ASSERT(m_table.sharedMemory());
-
-    sendTable(process);
+    for (size_t i = 0; i < m_tables.size(); ++i)
+        sendTable(process, i);
 }
 
 void VisitedLinkStore::removeProcess(WebProcessProxy& process)
@@ -106,8 +103,9 @@ void VisitedLinkStore::removeAll()
     m_pendingVisitedLinksTimer.stop();
     m_pendingVisitedLinks.clear();
     m_keyCount = 0;
-    m_tableSize = 0;
-    m_table.clear();
+    m_tables.clear();
+    m_lastTableKeyCount = 0;
+    m_linkHashes.clear();
 
     for (WebProcessProxy* process : m_processes) {
         ASSERT(process->processPool().processes().contains(process));
@@ -115,6 +113,14 @@ void VisitedLinkStore::removeAll()
     }
 }
 
+void VisitedLinkStore::setTableFormat(VisitedLinkTable::Format format)
+{
+    ASSERT(!m_keyCount);
+    ASSERT(m_tables.isEmpty());
+
+    m_tableFormat = format;
+}
+
 void VisitedLinkStore::webProcessWillOpenConnection(WebProcessProxy&, IPC::Connection&)
 {
     // FIXME: Implement.
@@ -135,58 +141,87 @@ void VisitedLinkStore::addVisitedLinkHashFromPage(uint64_t pageID, LinkHash link
     addVisitedLinkHash(linkHash);
 }
 
-static unsigned nextPowerOf2(unsigned v)
+static bool createTable(VisitedLinkTable& table, VisitedLinkTable::Format format, unsigned capacity, const Vector<LinkHash>& linkHashes, unsigned& keyCount)
 {
-    // Taken from http://www.cs.utk.edu/~vose/c-stuff/bithacks.html
-    // Devised by Sean Anderson, Sepember 14, 2001
-    
-    v--;
-    v |= v >> 1;
-    v |= v >> 2;
-    v |= v >> 4;
-    v |= v >> 8;
-    v |= v >> 16;
-    v++;
-    
-    return v;
+    RefPtr<SharedMemory> tableMemory = SharedMemory::allocate(VisitedLinkTable::sizeForLinkCount(format, capacity));
+
+    if (!tableMemory) {
+        LOG_ERROR("Could not allocate shared memory for visited link table");
+        return false;
+    }
+
+    memset(tableMemory->data(), 0, tableMemory->size());
+    table.setSharedMemory(tableMemory.release(), format);
+
+    keyCount = 0;
+    for (auto& linkHash : linkHashes) {
+        switch (table.addLinkHash(linkHash)) {
+        case VisitedLinkTable::AddResult::Added:
+            ++keyCount;
+            break;
+        case VisitedLinkTable::AddResult::AlreadyPresent:
+            break;
+        case VisitedLinkTable::AddResult::TableFull:
+            return false;
+        }
+    }
+
+    return true;
 }
 
-static unsigned tableSizeForKeyCount(unsigned keyCount)
+bool VisitedLinkStore::containsLinkHash(LinkHash linkHash) const
 {
-    // We want the table to be at least half empty.
-    unsigned tableSize = nextPowerOf2(keyCount * visitedLinkTableMaxLoad);
-
-    // Ensure that the table size is at least the size of a page.
-    size_t minimumTableSize = SharedMemory::systemPageSize() / sizeof(LinkHash);
-    if (tableSize < minimumTableSize)
-        return minimumTableSize;
-    
-    return tableSize;
+    for (auto& table : m_tables) {
+        if (table.isLinkVisited(linkHash))
+            return true;
+    }
+    return false;
 }
 
 void VisitedLinkStore::pendingVisitedLinksTimerFired()
 {
-    unsigned currentTableSize = m_tableSize;
-    unsigned newTableSize = tableSizeForKeyCount(m_keyCount + m_pendingVisitedLinks.size());
+    Vector<WebCore::LinkHash> addedVisitedLinks;
+    Vector<WebCore::LinkHash> overflowingVisitedLinks;
 
-    newTableSize = std::max(currentTableSize, newTableSize);
+    for (auto& linkHash : m_pendingVisitedLinks) {
+        if (m_tableFormat == VisitedLinkTable::Format::CuckooFilter) {
+            if (!m_linkHashes.add(linkHash).isNewEntry)
+                continue;
+        } else if (containsLinkHash(linkHash))
+            continue;
 
-    if (currentTableSize != newTableSize) {
-        resizeTable(newTableSize);
-        return;
-    }
+        ++m_keyCount;
 
-    Vector<WebCore::LinkHash> addedVisitedLinks;
+        if (m_tables.isEmpty() || m_lastTableKeyCount >= VisitedLinkTable::capacity(m_tableFormat, m_tables.last().sharedMemory()->size())) {
+            overflowingVisitedLinks.append(linkHash);
+            continue;
+        }
 
-    for (auto& linkHash : m_pendingVisitedLinks) {
-        if (m_table.addLinkHash(linkHash)) {
+        switch (m_tables.last().addLinkHash(linkHash)) {
+        case VisitedLinkTable::AddResult::Added:
             addedVisitedLinks.append(linkHash);
-            ++m_keyCount;
+            ++m_lastTableKeyCount;
+            break;
+        case VisitedLinkTable::AddResult::AlreadyPresent:
+            // A false positive of the cuckoo filter; the link is already reported as visited.
+            break;
+        case VisitedLinkTable::AddResult::TableFull:
+            overflowingVisitedLinks.append(linkHash);
+            break;
         }
     }
 
     m_pendingVisitedLinks.clear();
 
+    if (!overflowingVisitedLinks.isEmpty()) {
+        if (m_tables.isEmpty() || m_tables.size() > maximumTableSegmentCount || !appendTableSegment(overflowingVisitedLinks)) {
+            // Web processes restyle all links when they get a new table.
+            rebuildTables(overflowingVisitedLinks);
+            return;
+        }
+        addedVisitedLinks.appendVector(overflowingVisitedLinks);
+    }
+
     if (addedVisitedLinks.isEmpty())
         return;
 
@@ -200,60 +235,80 @@ void VisitedLinkStore::pendingVisitedLinksTimerFired()
     }
 }
 
-void VisitedLinkStore::resizeTable(unsigned newTableSize)
+bool VisitedLinkStore::appendTableSegment(const Vector<LinkHash>& linkHashes)
 {
-    RefPtr<SharedMemory> newTableMemory = SharedMemory::allocate(newTableSize * sizeof(LinkHash));
-
-    if (!newTableMemory) {
-        LOG_ERROR("Could not allocate shared memory for visited link table");
-        return;
-    }
-
-    memset(newTableMemory->data(), 0, newTableMemory->size());
-
-    RefPtr<SharedMemory> currentTableMemory = m_table.sharedMemory();
-    unsigned currentTableSize = m_tableSize;
+    // Size segments after the links we already have, so that their number grows with the logarithm of the link count.
+    unsigned capacity = std::max<unsigned>(linkHashes.size(), m_keyCount / 2);
 
-    m_table.setSharedMemory(newTableMemory);
-    m_tableSize = newTableSize;
+    VisitedLinkTable segment;
+    unsigned keyCount;
+    if (!createTable(segment, m_tableFormat, capacity, linkHashes, keyCount))
+        return false;
 
-    if (currentTableMemory) {
-        ASSERT_UNUSED(currentTableSize, currentTableMemory->size() == currentTableSize * sizeof(LinkHash));
+    m_tables.append(segment);
+    m_lastTableKeyCount = keyCount;
 
-        // Go through the current hash table and re-add all entries to the new hash table.
-        const LinkHash* currentLinkHashes = static_cast<const LinkHash*>(currentTableMemory->data());
-        for (unsigned i = 0; i < currentTableSize; ++i) {
-            LinkHash linkHash = currentLinkHashes[i];
-
-            if (!linkHash)
-                continue;
+    for (WebProcessProxy* process : m_processes)
+        sendTable(*process, m_tables.size() - 1);
 
-            bool didAddLinkHash = m_table.addLinkHash(linkHash);
+    return true;
+}
 
-            // It should always be possible to add the link hash to a new table.
-            ASSERT_UNUSED(didAddLinkHash, didAddLinkHash);
+void VisitedLinkStore::rebuildTables(const Vector<LinkHash>& linkHashesNotInTables)
+{
+    Vector<LinkHash> linkHashes;
+    if (m_tableFormat == VisitedLinkTable::Format::CuckooFilter)
+        copyToVector(m_linkHashes, linkHashes);
+    else {
+        linkHashes.reserveInitialCapacity(m_keyCount);
+
+        // Go through the current hash tables and re-add all entries to the new hash table.
+        for (auto& table : m_tables) {
+            const LinkHash* currentLinkHashes = static_cast<const LinkHash*>(table.sharedMemory()->data());
+            size_t currentTableSize = table.sharedMemory()->size() / sizeof(LinkHash);
+            for (size_t i = 0; i < currentTableSize; ++i) {
+                if (LinkHash linkHash = currentLinkHashes[i])
+                    linkHashes.append(linkHash);
+            }
         }
+        linkHashes.appendVector(linkHashesNotInTables);
     }
 
-    for (auto& linkHash : m_pendingVisitedLinks) {
-        if (m_table.addLinkHash(linkHash))
-            m_keyCount++;
+    VisitedLinkTable table;
+    unsigned capacity = linkHashes.size();
+    unsigned keyCount;
+    while (!createTable(table, m_tableFormat, capacity, linkHashes, keyCount)) {
+        if (!table.sharedMemory())
+            return;
+
+        // A cuckoo filter can run out of room before reaching its capacity; try again with a bigger one.
+        // It should always be possible to add the link hashes to a new hash table.
+        ASSERT(m_tableFormat == VisitedLinkTable::Format::CuckooFilter);
+        table.clear();
+        capacity *= 2;
     }
-    m_pendingVisitedLinks.clear();
+
+    m_tables.clear();
+    m_tables.append(table);
+    m_lastTableKeyCount = keyCount;
 
     for (WebProcessProxy* process : m_processes)
-        sendTable(*process);
+        sendTable(*process, 0);
 }
 
-void VisitedLinkStore::sendTable(WebProcessProxy& process)
+void VisitedLinkStore::sendTable(WebProcessProxy& process, size_t tableIndex)
 {
     ASSERT(process.processPool().processes().contains(&process));
 
     SharedMemory::Handle handle;
-    if (!m_table.sharedMemory()->createHandle(handle, SharedMemory::Protection::ReadOnly))
+    if (!m_tables[tableIndex].sharedMemory()->createHandle(handle, SharedMemory::Protection::ReadOnly))
         return;
 
-    process.connection()->send(Messages::VisitedLinkTableController::SetVisitedLinkTable(handle), m_identifier);
+    uint32_t format = static_cast<uint32_t>(m_tableFormat);
+    if (!tableIndex)
+        process.connection()->send(Messages::VisitedLinkTableController::SetVisitedLinkTable(handle, format), m_identifier);
+    else
+        process.connection()->send(Messages::VisitedLinkTableController::AddVisitedLinkTableSegment(handle, format), m_identifier);
 }
 
 } // namespace WebKit
@@ -56,6 +56,9 @@ public:
     void addVisitedLinkHash(WebCore::LinkHash);
     void removeAll();
 
+    // This must be called before any visited link is added.
+    void setTableFormat(VisitedLinkTable::Format);
+
 private:
     // IPC::MessageReceiver
     virtual void didReceiveMessage(IPC::Connection&, IPC::MessageDecoder&) override;
@@ -68,16 +71,26 @@ private:
 
     void pendingVisitedLinksTimerFired();
 
-    void resizeTable(unsigned newTableSize);
-    void sendTable(WebProcessProxy&);
+    bool containsLinkHash(WebCore::LinkHash) const;
+    bool appendTableSegment(const Vector<WebCore::LinkHash>&);
+    void rebuildTables(const Vector<WebCore::LinkHash>& linkHashesNotInTables);
+    void sendTable(WebProcessProxy&, size_t tableIndex);
 
     HashSet<WebProcessProxy*> m_processes;
 
     uint64_t m_identifier;
 
+    VisitedLinkTable::Format m_tableFormat;
     unsigned m_keyCount;
-    unsigned m_tableSize;
-    VisitedLinkTable m_table;
+
+    // The first table is shared with web processes as is, the following ones as segments added to it. Only the
+    // last one still takes new links; when it is full we append a new segment rather than resending everything,
+    // until there are too many of them and we rebuild a single table.
+    Vector<VisitedLinkTable> m_tables;
+    unsigned m_lastTableKeyCount;
+
+    // A cuckoo filter cannot be resized from its fingerprints alone, so we keep the link hashes around to rebuild it.
+    HashSet<WebCore::LinkHash, WebCore::LinkHashHash> m_linkHashes;
 
     HashSet<WebCore::LinkHash, WebCore::LinkHashHash> m_pendingVisitedLinks;
     RunLoop::Timer<VisitedLinkStore> m_pendingVisitedLinksTimer;
@@ -4483,6 +4483,16 @@ void WebPageProxy::setCursorHiddenUntilMouseMoves(bool hiddenUntilMouseMoves)
     m_pageClient.setCursorHiddenUntilMouseMoves(hiddenUntilMouseMoves);
 }
 
+void WebPageProxy::didReportWheelEventLatency(double averageLatency, double maximumLatency, uint64_t receivedEventCount, uint64_t dispatchedEventCount)
+{
+    MESSAGE_CHECK(dispatchedEventCount && dispatchedEventCount <= receivedEventCount);
+
+    m_wheelEventLatency.averageLatency = averageLatency;
+    m_wheelEventLatency.maximumLatency = maximumLatency;
+    m_wheelEventLatency.receivedEventCount = receivedEventCount;
+    m_wheelEventLatency.dispatchedEventCount = dispatchedEventCount;
+}
+
 void WebPageProxy::didReceiveEvent(uint32_t opaqueType, bool handled)
 {
     WebEvent::Type type = static_cast<WebEvent::Type>(opaqueType);
@@ -607,6 +607,16 @@ public:
 
     void handleMouseEvent(const NativeWebMouseEvent&);
     void handleWheelEvent(const NativeWebWheelEvent&);
+
+    // How long wheel events waited for the main thread of the web process over the last interval it
+    // reported, and how many of them it coalesced while that thread was busy.
+    struct WheelEventLatency {
+        double averageLatency { 0 };
+        double maximumLatency { 0 };
+        uint64_t receivedEventCount { 0 };
+        uint64_t dispatchedEventCount { 0 };
+    };
+    const WheelEventLatency& wheelEventLatency() const { return m_wheelEventLatency; }
     void handleKeyboardEvent(const NativeWebKeyboardEvent&);
 
 #if ENABLE(MAC_GESTURE_EVENTS)
@@ -1324,6 +1334,7 @@ private:
     void setCursorHiddenUntilMouseMoves(bool);
 
     void didReceiveEvent(uint32_t opaqueType, bool handled);
+    void didReportWheelEventLatency(double averageLatency, double maximumLatency, uint64_t receivedEventCount, uint64_t dispatchedEventCount);
     void stopResponsivenessTimer();
 
     void voidCallback(uint64_t);
@@ -1638,6 +1649,7 @@ private:
 
     Deque<NativeWebKeyboardEvent> m_keyEventQueue;
     Deque<NativeWebWheelEvent> m_wheelEventQueue;
+    WheelEventLatency m_wheelEventLatency;
     Deque<std::unique_ptr<Vector<NativeWebWheelEvent>>> m_currentlyProcessedWheelEvents;
 #if ENABLE(MAC_GESTURE_EVENTS)
     Deque<NativeWebGestureEvent> m_gestureEventQueue;
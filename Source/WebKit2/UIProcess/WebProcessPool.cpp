@@ -106,6 +106,7 @@ using namespace WebKit;
 namespace WebKit {
 
 static const double sharedSecondaryProcessShutdownTimeout = 60;
+static const double memoryBudgetCheckInterval = 10;
 
 DEFINE_DEBUG_ONLY_GLOBAL(WTF::RefCountedLeakCounter, processPoolCounter, ("WebProcessPool"));
 
@@ -141,7 +142,6 @@ static WebsiteDataStore::Configuration legacyWebsiteDataStoreConfiguration(API::
 
 WebProcessPool::WebProcessPool(API::ProcessPoolConfiguration& configuration)
     : m_configuration(configuration.copy())
-    , m_haveInitialEmptyProcess(false)
     , m_processWithPageCache(0)
     , m_defaultPageGroup(WebPageGroup::createNonNull())
     , m_downloadClient(std::make_unique<API::DownloadClient>())
@@ -169,6 +169,7 @@ WebProcessPool::WebProcessPool(API::ProcessPoolConfiguration& configuration)
     , m_memoryCacheDisabled(false)
     , m_userObservablePageCounter([this](bool) { updateProcessSuppressionState(); })
     , m_processSuppressionDisabledForPageCounter([this](bool) { updateProcessSuppressionState(); })
+    , m_memoryBudgetTimer(RunLoop::main(), this, &WebProcessPool::memoryBudgetTimerFired)
 {
 #if ENABLE(CACHE_PARTITIONING)
     for (const auto& urlScheme : m_configuration->cachePartitionedURLSchemes())
@@ -177,6 +178,12 @@ WebProcessPool::WebProcessPool(API::ProcessPoolConfiguration& configuration)
 
     platformInitialize();
 
+    if (m_configuration->usesCompactVisitedLinkTable())
+        m_visitedLinkStore->setTableFormat(VisitedLinkTable::Format::CuckooFilter);
+
+    if (m_configuration->webProcessMemoryBudget())
+        m_memoryBudgetTimer.startRepeating(memoryBudgetCheckInterval);
+
     addMessageReceiver(Messages::WebProcessPool::messageReceiverName(), *this);
 
     // NOTE: These sub-objects must be initialized after m_messageReceiverMap..
@@ -726,16 +733,72 @@ WebProcessProxy& WebProcessPool::createNewWebProcess()
 
 void WebProcessPool::warmInitialProcess()  
 {
-    if (m_haveInitialEmptyProcess) {
-        ASSERT(!m_processes.isEmpty());
-        return;
+    prewarmProcesses(std::max(1u, m_configuration->prewarmedProcessCount()));
+}
+
+void WebProcessPool::prewarmProcesses(unsigned count)
+{
+    while (m_prewarmedProcesses.size() < count && m_processes.size() < maximumNumberOfProcesses()) {
+        WebProcessProxy& process = createNewWebProcess();
+        process.send(Messages::WebProcess::Prewarm(), 0);
+        m_prewarmedProcesses.append(&process);
     }
+}
 
-    if (m_processes.size() >= maximumNumberOfProcesses())
-        return;
+static bool isShowingPage(const WebProcessProxy& process)
+{
+    for (auto& page : process.pages()) {
+        if (page->isViewVisible())
+            return true;
+    }
+    return false;
+}
 
-    createNewWebProcess();
-    m_haveInitialEmptyProcess = true;
+void WebProcessPool::memoryBudgetTimerFired()
+{
+    // Act on the footprints reported since the last check, then ask for new ones. Each check that finds
+    // the processes over budget moves one step further in releaseWebProcessMemory().
+    uint64_t totalFootprint = 0;
+    for (auto& process : m_processes)
+        totalFootprint += process->memoryFootprint();
+
+    uint64_t budget = m_configuration->webProcessMemoryBudget();
+    if (totalFootprint > budget)
+        releaseWebProcessMemory(m_memoryReleaseLevel++);
+    else if (totalFootprint < budget - budget / 4) {
+        // Wait for some headroom before starting over, so that we don't go back and forth around the budget.
+        m_memoryReleaseLevel = 0;
+    }
+
+    for (auto& process : m_processes)
+        process->send(Messages::WebProcess::ReportMemoryFootprint(), 0);
+}
+
+void WebProcessPool::releaseWebProcessMemory(unsigned releaseLevel)
+{
+    // Processes that aren't showing a page give up their caches, then their decoded images, then
+    // their JIT code. Processes showing a page are only asked for their caches after that.
+    for (auto& process : m_processes) {
+        if (isShowingPage(*process)) {
+            if (releaseLevel >= 3)
+                process->send(Messages::WebProcess::ReleaseCachedMemory(), 0);
+            continue;
+        }
+
+        switch (releaseLevel) {
+        case 0:
+            process->send(Messages::WebProcess::ReleaseCachedMemory(), 0);
+            break;
+        case 1:
+            process->send(Messages::WebProcess::ReleaseDecodedImageData(), 0);
+            break;
+        case 2:
+            process->send(Messages::WebProcess::DiscardJITCode(), 0);
+            break;
+        default:
+            break;
+        }
+    }
 }
 
 void WebProcessPool::enableProcessTermination()
@@ -793,8 +856,7 @@ void WebProcessPool::disconnectProcess(WebProcessProxy* process)
 {
     ASSERT(m_processes.contains(process));
 
-    if (m_haveInitialEmptyProcess && process == m_processes.last())
-        m_haveInitialEmptyProcess = false;
+    m_prewarmedProcesses.removeFirst(process);
 
     // FIXME (Multi-WebProcess): <rdar://problem/12239765> Some of the invalidation calls below are still necessary in multi-process mode, but they should only affect data structures pertaining to the process being disconnected.
     // Clearing everything causes assertion failures, so it's less trouble to skip that for now.
@@ -854,9 +916,16 @@ Ref<WebPageProxy> WebProcessPool::createWebPage(PageClient& pageClient, Ref<API:
     if (processModel() == ProcessModelSharedSecondaryProcess) {
         process = &ensureSharedWebProcess();
     } else {
-        if (m_haveInitialEmptyProcess) {
-            process = m_processes.last();
-            m_haveInitialEmptyProcess = false;
+        if (!m_prewarmedProcesses.isEmpty()) {
+            process = m_prewarmedProcesses.takeLast();
+
+            // Replace it once the page has been created, so that it doesn't delay this one.
+            if (m_configuration->prewarmedProcessCount()) {
+                RefPtr<WebProcessPool> protectedThis(this);
+                RunLoop::main().dispatch([protectedThis] {
+                    protectedThis->prewarmProcesses(protectedThis->m_configuration->prewarmedProcessCount());
+                });
+            }
         } else if (pageConfiguration->relatedPage()) {
             // Sharing processes, e.g. when creating the page via window.open().
             process = &pageConfiguration->relatedPage()->process();
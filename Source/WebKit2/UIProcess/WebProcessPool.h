@@ -52,6 +52,7 @@
 #include <wtf/PassRefPtr.h>
 #include <wtf/RefCounter.h>
 #include <wtf/RefPtr.h>
+#include <wtf/RunLoop.h>
 #include <wtf/text/StringHash.h>
 #include <wtf/text/WTFString.h>
 
@@ -256,6 +257,10 @@ public:
     WebProcessProxy& ensureSharedWebProcess();
     WebProcessProxy& createNewWebProcessRespectingProcessCountLimit(); // Will return an existing one if limit is met.
     void warmInitialProcess();
+    void prewarmProcesses(unsigned count);
+
+    void memoryBudgetTimerFired();
+    void releaseWebProcessMemory(unsigned releaseLevel);
 
     bool shouldTerminate(WebProcessProxy*);
 
@@ -428,7 +433,12 @@ private:
     IPC::MessageReceiverMap m_messageReceiverMap;
 
     Vector<RefPtr<WebProcessProxy>> m_processes;
-    bool m_haveInitialEmptyProcess;
+    // Initialized processes without pages, handed out to new pages before any other process.
+    Vector<RefPtr<WebProcessProxy>> m_prewarmedProcesses;
+
+    // Checks the footprints web processes report against the configured memory budget.
+    RunLoop::Timer<WebProcessPool> m_memoryBudgetTimer;
+    unsigned m_memoryReleaseLevel { 0 };
 
     WebProcessProxy* m_processWithPageCache;
 
@@ -640,7 +650,7 @@ void WebProcessPool::sendToOneProcess(T&& message)
 
     if (!messageSent && processModel() == ProcessModelMultipleSecondaryProcesses) {
         warmInitialProcess();
-        RefPtr<WebProcessProxy> process = m_processes.last();
+        RefPtr<WebProcessProxy> process = m_prewarmedProcesses.isEmpty() ? m_processes.last() : m_prewarmedProcesses.last();
         if (process->canSendMessage())
             process->send(std::forward<T>(message), 0);
     }
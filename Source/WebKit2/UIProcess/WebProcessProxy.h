@@ -149,6 +149,10 @@ public:
 
     void setIsHoldingLockedFiles(bool);
 
+    // The last footprint the process reported, in bytes.
+    uint64_t memoryFootprint() const { return m_memoryFootprint; }
+    void didReportMemoryFootprint(uint64_t footprint) { m_memoryFootprint = footprint; }
+
     ProcessThrottler& throttler() { return m_throttler; }
 
 #if ENABLE(NETWORK_PROCESS)
@@ -258,6 +262,8 @@ private:
 #endif
 
     HashMap<String, uint64_t> m_pageURLRetainCountMap;
+
+    uint64_t m_memoryFootprint { 0 };
 };
 
 } // namespace WebKit
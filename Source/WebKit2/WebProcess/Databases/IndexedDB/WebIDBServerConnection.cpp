@@ -495,17 +495,24 @@ void WebIDBServerConnection::didAdvanceCursor(uint64_t requestID, const IDBKeyDa
     serverRequest->completeRequest(key.maybeCreateIDBKey(), primaryKey.maybeCreateIDBKey(), value.release(), errorCode ? IDBDatabaseError::create(errorCode, errorMessage) : nullptr);
 }
 
-void WebIDBServerConnection::didIterateCursor(uint64_t requestID, const IDBKeyData& key, const IDBKeyData& primaryKey, const IPC::DataReference& valueData, uint32_t errorCode, const String& errorMessage)
+void WebIDBServerConnection::didIterateCursor(uint64_t requestID, const IDBKeyData& key, const IDBKeyData& primaryKey, const IPC::DataReference& valueData, const Vector<IDBKeyData>& prefetchedKeys, const Vector<IDBKeyData>& prefetchedPrimaryKeys, const Vector<Vector<uint8_t>>& prefetchedValues, uint32_t errorCode, const String& errorMessage)
 {
-    LOG(IDB, "WebProcess didIterateCursor request ID %" PRIu64 " (error - %s)", requestID, errorMessage.utf8().data());
+    LOG(IDB, "WebProcess didIterateCursor request ID %" PRIu64 ", %zu prefetched records (error - %s)", requestID, prefetchedKeys.size(), errorMessage.utf8().data());
 
     RefPtr<AsyncRequest> serverRequest = m_serverRequests.take(requestID);
 
     if (!serverRequest)
         return;
 
+    Vector<IDBCursorBackend::PrefetchedRecord> prefetchedRecords;
+    if (prefetchedPrimaryKeys.size() == prefetchedKeys.size() && prefetchedValues.size() == prefetchedKeys.size()) {
+        prefetchedRecords.reserveInitialCapacity(prefetchedKeys.size());
+        for (size_t i = 0; i < prefetchedKeys.size(); ++i)
+            prefetchedRecords.uncheckedAppend({ prefetchedKeys[i].maybeCreateIDBKey(), prefetchedPrimaryKeys[i].maybeCreateIDBKey(), SharedBuffer::create(prefetchedValues[i].data(), prefetchedValues[i].size()) });
+    }
+
     RefPtr<SharedBuffer> value = SharedBuffer::create(valueData.data(), valueData.size());
-    serverRequest->completeRequest(key.maybeCreateIDBKey(), primaryKey.maybeCreateIDBKey(), value.release(), errorCode ? IDBDatabaseError::create(errorCode, errorMessage) : nullptr);
+    serverRequest->completeRequest(key.maybeCreateIDBKey(), primaryKey.maybeCreateIDBKey(), value.release(), WTF::move(prefetchedRecords), errorCode ? IDBDatabaseError::create(errorCode, errorMessage) : nullptr);
 }
 
 void WebIDBServerConnection::count(IDBTransactionBackend& transaction, const CountOperation& operation, std::function<void (int64_t, PassRefPtr<IDBDatabaseError>)> completionCallback)
@@ -687,9 +694,14 @@ void WebIDBServerConnection::cursorAdvance(IDBCursorBackend&, const CursorAdvanc
     send(Messages::DatabaseProcessIDBConnection::CursorAdvance(requestID, operation.cursorID(), operation.count()));
 }
 
-void WebIDBServerConnection::cursorIterate(IDBCursorBackend&, const CursorIterationOperation& operation, std::function<void (PassRefPtr<IDBKey>, PassRefPtr<IDBKey>, PassRefPtr<SharedBuffer>, PassRefPtr<IDBDatabaseError>)> completionCallback)
+void WebIDBServerConnection::cursorIterate(IDBCursorBackend& cursor, const CursorIterationOperation& operation, std::function<void (PassRefPtr<IDBKey>, PassRefPtr<IDBKey>, PassRefPtr<SharedBuffer>, PassRefPtr<IDBDatabaseError>)> completionCallback)
 {
-    RefPtr<AsyncRequest> serverRequest = AsyncRequestImpl<PassRefPtr<IDBKey>, PassRefPtr<IDBKey>, PassRefPtr<SharedBuffer>, PassRefPtr<IDBDatabaseError>>::create(completionCallback);
+    RefPtr<IDBCursorBackend> protectedCursor(&cursor);
+    RefPtr<AsyncRequest> serverRequest = AsyncRequestImpl<PassRefPtr<IDBKey>, PassRefPtr<IDBKey>, PassRefPtr<SharedBuffer>, Vector<IDBCursorBackend::PrefetchedRecord>, PassRefPtr<IDBDatabaseError>>::create([protectedCursor, completionCallback](PassRefPtr<IDBKey> key, PassRefPtr<IDBKey> primaryKey, PassRefPtr<SharedBuffer> value, const Vector<IDBCursorBackend::PrefetchedRecord>& prefetchedRecords, PassRefPtr<IDBDatabaseError> error) {
+        if (!prefetchedRecords.isEmpty())
+            protectedCursor->didPrefetchRecords(prefetchedRecords);
+        completionCallback(key, primaryKey, value, error);
+    });
 
     serverRequest->setAbortHandler([completionCallback] {
         completionCallback(nullptr, nullptr, nullptr, IDBDatabaseError::create(IDBDatabaseException::UnknownError, "Unknown error occured iterating database cursor"));
@@ -699,9 +711,16 @@ void WebIDBServerConnection::cursorIterate(IDBCursorBackend&, const CursorIterat
     ASSERT(!m_serverRequests.contains(requestID));
     m_serverRequests.add(requestID, serverRequest.release());
 
-    LOG(IDB, "WebProcess cursorIterate request ID %" PRIu64, requestID);
+    LOG(IDB, "WebProcess cursorIterate request ID %" PRIu64 ", prefetch count %u", requestID, operation.prefetchCount());
+
+    send(Messages::DatabaseProcessIDBConnection::CursorIterate(requestID, operation.cursorID(), operation.key(), operation.prefetchCount()));
+}
+
+void WebIDBServerConnection::cursorPrefetchReset(IDBCursorBackend& cursor, unsigned usedPrefetchCount)
+{
+    LOG(IDB, "WebProcess cursorPrefetchReset cursor ID %" PRIi64 ", used prefetch count %u", cursor.id(), usedPrefetchCount);
 
-    send(Messages::DatabaseProcessIDBConnection::CursorIterate(requestID, operation.cursorID(), operation.key()));
+    send(Messages::DatabaseProcessIDBConnection::CursorPrefetchReset(cursor.id(), usedPrefetchCount));
 }
 
 IPC::Connection* WebIDBServerConnection::messageSenderConnection()
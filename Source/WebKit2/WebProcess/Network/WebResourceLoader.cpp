@@ -204,6 +204,27 @@ void WebResourceLoader::didReceiveResource(const ShareableResource::Handle& hand
 
     m_coreLoader->didFinishLoading(finishTime);
 }
+
+void WebResourceLoader::didReceiveSharedData(const ShareableResource::Handle& handle, int64_t encodedDataLength)
+{
+    LOG(Network, "(WebProcess) WebResourceLoader::didReceiveSharedData of size %u for '%s'", handle.size(), m_coreLoader->url().string().utf8().data());
+
+    // The buffer wraps the mapped memory, so the chunk is not copied again before it reaches the loader.
+    RefPtr<SharedBuffer> buffer = handle.tryWrapInSharedBuffer();
+    if (!buffer) {
+        LOG_ERROR("Unable to create buffer from shared data chunk sent from the network process.");
+        m_coreLoader->didFail(internalError(m_coreLoader->request().url()));
+        return;
+    }
+
+#if USE(QUICK_LOOK)
+    if (QuickLookHandle* quickLookHandle = m_coreLoader->documentLoader()->quickLookHandle()) {
+        if (quickLookHandle->didReceiveData(buffer->existingCFData()))
+            return;
+    }
+#endif
+    m_coreLoader->didReceiveBuffer(buffer.release(), encodedDataLength, DataPayloadBytes);
+}
 #endif
 
 #if USE(PROTECTION_SPACE_AUTH_CALLBACK)
@@ -83,6 +83,7 @@ private:
     void didFailResourceLoad(const WebCore::ResourceError&);
 #if ENABLE(SHAREABLE_RESOURCE)
     void didReceiveResource(const ShareableResource::Handle&, double finishTime);
+    void didReceiveSharedData(const ShareableResource::Handle&, int64_t encodedDataLength);
 #endif
 
 #if USE(PROTECTION_SPACE_AUTH_CALLBACK)
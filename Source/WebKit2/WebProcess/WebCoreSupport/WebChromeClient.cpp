@@ -30,6 +30,7 @@
 #include "APIArray.h"
 #include "APISecurityOrigin.h"
 #include "DrawingArea.h"
+#include "EventDispatcher.h"
 #include "HangDetectionDisabler.h"
 #include "InjectedBundleNavigationAction.h"
 #include "InjectedBundleNodeHandle.h"
@@ -825,6 +826,11 @@ RefPtr<WebCore::DisplayRefreshMonitor> WebChromeClient::createDisplayRefreshMoni
 }
 #endif
 
+bool WebChromeClient::hasPendingUserInput() const
+{
+    return WebProcess::singleton().eventDispatcher().hasEventsPendingOnMainThread();
+}
+
 void WebChromeClient::attachRootGraphicsLayer(Frame*, GraphicsLayer* layer)
 {
     if (layer)
@@ -633,7 +633,7 @@ void WebFrameLoaderClient::dispatchDidLayout()
 
     if (m_frame == m_frame->page()->mainWebFrame()) {
         // FIXME: Remove at the soonest possible time.
-        webPage->send(Messages::WebPageProxy::SetRenderTreeSize(webPage->renderTreeSize()));
+        webPage->send(Messages::WebPageProxy::SetRenderTreeSize(webPage->renderTreeSize()), webPage->pageID(), IPC::ReplacePendingMessageOfSameKind);
         webPage->mainFrameDidLayout();
     }
 }
@@ -33,8 +33,10 @@
 
 #include "DrawingAreaImpl.h"
 #include "NotImplemented.h"
+#include "EventDispatcher.h"
 #include "ThreadSafeCoordinatedSurface.h"
 #include "WebPage.h"
+#include "WebProcess.h"
 #include <WebCore/CoordinatedGraphicsLayer.h>
 #include <WebCore/CoordinatedGraphicsState.h>
 #include <WebCore/Frame.h>
@@ -42,6 +44,7 @@
 #include <WebCore/GraphicsContext.h>
 #include <WebCore/MainFrame.h>
 #include <WebCore/Page.h>
+#include <WebCore/ScrollingCoordinatorCoordinatedGraphics.h>
 #include <wtf/CurrentTime.h>
 
 using namespace WebCore;
@@ -55,6 +58,7 @@ Ref<ThreadedCoordinatedLayerTreeHost> ThreadedCoordinatedLayerTreeHost::create(W
 
 ThreadedCoordinatedLayerTreeHost::~ThreadedCoordinatedLayerTreeHost()
 {
+    WebProcess::singleton().eventDispatcher().removeThreadedCompositorForPage(m_webPage->pageID());
 }
 
 ThreadedCoordinatedLayerTreeHost::ThreadedCoordinatedLayerTreeHost(WebPage* webPage)
@@ -75,6 +79,7 @@ ThreadedCoordinatedLayerTreeHost::ThreadedCoordinatedLayerTreeHost(WebPage* webP
     CoordinatedSurface::setFactory(createCoordinatedSurface);
 
     m_compositor = ThreadedCompositor::create(this);
+    WebProcess::singleton().eventDispatcher().addThreadedCompositorForPage(m_webPage->pageID(), *m_compositor);
     scheduleLayerFlush();
 }
 
@@ -256,6 +261,7 @@ void ThreadedCoordinatedLayerTreeHost::performScheduledLayerFlush()
 
     m_coordinator->syncDisplayState();
     bool didSync = m_coordinator->flushPendingLayerChanges();
+    updateScrollingState();
 
     if (m_notifyAfterScheduledLayerFlush && didSync) {
         compositorDidFlushLayers();
@@ -263,6 +269,18 @@ void ThreadedCoordinatedLayerTreeHost::performScheduledLayerFlush()
     }
 }
 
+void ThreadedCoordinatedLayerTreeHost::updateScrollingState()
+{
+    ScrollingCoordinator* scrollingCoordinator = m_webPage->corePage()->scrollingCoordinator();
+    if (!scrollingCoordinator)
+        return;
+
+    Region nonFastScrollableRegion;
+    bool mustScrollOnMainThread;
+    if (static_cast<ScrollingCoordinatorCoordinatedGraphics*>(scrollingCoordinator)->updateThreadedScrollingState(nonFastScrollableRegion, mustScrollOnMainThread))
+        m_compositor->setScrollingState(nonFastScrollableRegion, mustScrollOnMainThread);
+}
+
 void ThreadedCoordinatedLayerTreeHost::purgeBackingStores()
 {
     m_coordinator->purgeBackingStores();
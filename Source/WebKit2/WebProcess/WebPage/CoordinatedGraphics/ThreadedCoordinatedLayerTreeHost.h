@@ -112,6 +112,7 @@ private:
 
     void cancelPendingLayerFlush();
     void performScheduledLayerFlush();
+    void updateScrollingState();
 
     WebCore::GraphicsLayer* rootLayer() { return m_coordinator->rootLayer(); }
 
@@ -441,6 +441,7 @@ void DrawingAreaImpl::suspendPainting()
 
     m_isPaintingSuspended = true;
     m_displayTimer.stop();
+    m_updateBitmap = nullptr;
 }
 
 void DrawingAreaImpl::resumePainting()
@@ -469,6 +470,7 @@ void DrawingAreaImpl::enterAcceleratedCompositingMode(GraphicsLayer* graphicsLay
 
     ASSERT(!m_layerTreeHost);
 
+    m_updateBitmap = nullptr;
     m_layerTreeHost = LayerTreeHost::create(&m_webPage);
 #if USE(TEXTURE_MAPPER) && PLATFORM(GTK)
     if (m_nativeSurfaceHandleForCompositing)
@@ -585,7 +587,7 @@ void DrawingAreaImpl::display()
     }
 
     UpdateInfo updateInfo;
-    display(updateInfo);
+    display(updateInfo, UpdateBitmapPolicy::ReuseUpdateBitmap);
 
     if (m_layerTreeHost) {
         // The call to update caused layout which turned on accelerated compositing.
@@ -597,6 +599,40 @@ void DrawingAreaImpl::display()
     m_isWaitingForDidUpdate = true;
 }
 
+// Damage is tracked per tile of this size: every damaged tile gets painted from the bounds of the damage
+// inside it, so sparse damage never repaints much more than what changed.
+static const int damageTileSize = 256;
+
+static Vector<IntRect> damagedTileRects(const Region& dirtyRegion)
+{
+    IntRect bounds = dirtyRegion.bounds();
+    Vector<IntRect> rects;
+
+    for (int tileY = bounds.y() - bounds.y() % damageTileSize; tileY < bounds.maxY(); tileY += damageTileSize) {
+        // Merge damage that continues from one tile to the next along the row, so that large damaged
+        // areas are still painted in few passes.
+        IntRect rowRect;
+        for (int tileX = bounds.x() - bounds.x() % damageTileSize; tileX < bounds.maxX(); tileX += damageTileSize) {
+            IntRect damage = intersect(dirtyRegion, Region(IntRect(tileX, tileY, damageTileSize, damageTileSize))).bounds();
+            if (damage.isEmpty())
+                continue;
+
+            if (!rowRect.isEmpty() && rowRect.maxX() == damage.x() && rowRect.y() == damage.y() && rowRect.maxY() == damage.maxY()) {
+                rowRect.unite(damage);
+                continue;
+            }
+
+            if (!rowRect.isEmpty())
+                rects.append(rowRect);
+            rowRect = damage;
+        }
+        if (!rowRect.isEmpty())
+            rects.append(rowRect);
+    }
+
+    return rects;
+}
+
 static bool shouldPaintBoundsRect(const IntRect& bounds, const Vector<IntRect>& rects)
 {
     const size_t rectThreshold = 10;
@@ -618,7 +654,7 @@ static bool shouldPaintBoundsRect(const IntRect& bounds, const Vector<IntRect>&
     return wastedSpace <= wastedSpaceThreshold;
 }
 
-void DrawingAreaImpl::display(UpdateInfo& updateInfo)
+void DrawingAreaImpl::display(UpdateInfo& updateInfo, UpdateBitmapPolicy updateBitmapPolicy)
 {
     ASSERT(!m_isPaintingSuspended);
     ASSERT(!m_layerTreeHost);
@@ -637,17 +673,26 @@ void DrawingAreaImpl::display(UpdateInfo& updateInfo)
     IntRect bounds = m_dirtyRegion.bounds();
     ASSERT(m_webPage.bounds().contains(bounds));
 
-    IntSize bitmapSize = bounds.size();
     float deviceScaleFactor = m_webPage.corePage()->deviceScaleFactor();
-    bitmapSize.scale(deviceScaleFactor);
-    RefPtr<ShareableBitmap> bitmap = ShareableBitmap::createShareable(bitmapSize, ShareableBitmap::SupportsAlpha);
+    RefPtr<ShareableBitmap> bitmap;
+    if (updateBitmapPolicy == UpdateBitmapPolicy::ReuseUpdateBitmap) {
+        IntSize viewBitmapSize = m_webPage.bounds().size();
+        viewBitmapSize.scale(deviceScaleFactor);
+        if (!m_updateBitmap || m_updateBitmap->size() != viewBitmapSize)
+            m_updateBitmap = ShareableBitmap::createShareable(viewBitmapSize, ShareableBitmap::SupportsAlpha);
+        bitmap = m_updateBitmap;
+    } else {
+        IntSize bitmapSize = bounds.size();
+        bitmapSize.scale(deviceScaleFactor);
+        bitmap = ShareableBitmap::createShareable(bitmapSize, ShareableBitmap::SupportsAlpha);
+    }
     if (!bitmap)
         return;
 
     if (!bitmap->createHandle(updateInfo.bitmapHandle))
         return;
 
-    Vector<IntRect> rects = m_dirtyRegion.rects();
+    Vector<IntRect> rects = damagedTileRects(m_dirtyRegion);
 
     if (shouldPaintBoundsRect(bounds, rects)) {
         rects.clear();
@@ -669,6 +714,9 @@ void DrawingAreaImpl::display(UpdateInfo& updateInfo)
     graphicsContext->translate(-bounds.x(), -bounds.y());
 
     for (const auto& rect : rects) {
+        // A reused bitmap still has the contents of earlier updates.
+        if (bitmap == m_updateBitmap)
+            graphicsContext->clearRect(rect);
         m_webPage.drawRect(*graphicsContext, rect);
         updateInfo.updateRects.append(rect);
     }
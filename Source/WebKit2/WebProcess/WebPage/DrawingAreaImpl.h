@@ -94,7 +94,11 @@ private:
     void scheduleDisplay();
     void displayTimerFired();
     void display();
-    void display(UpdateInfo&);
+
+    // The bitmap of an Update message can be painted into again once the UI process sends DidUpdate.
+    // Other messages that carry an UpdateInfo aren't acknowledged, so they need a bitmap of their own.
+    enum class UpdateBitmapPolicy { ReuseUpdateBitmap, AllocateNewBitmap };
+    void display(UpdateInfo&, UpdateBitmapPolicy = UpdateBitmapPolicy::AllocateNewBitmap);
 
     uint64_t m_backingStoreStateID;
 
@@ -139,6 +143,10 @@ private:
 
     // The layer tree host that handles accelerated compositing.
     RefPtr<LayerTreeHost> m_layerTreeHost;
+
+    // Kept across Update messages, and as big as the view, so that it only needs to be replaced when the view
+    // gets bigger or the device scale factor changes.
+    RefPtr<ShareableBitmap> m_updateBitmap;
 };
 
 } // namespace WebKit
@@ -34,6 +34,7 @@
 #include "WebProcess.h"
 #include <WebCore/Page.h>
 #include <WebCore/WheelEventTestTrigger.h>
+#include <wtf/CurrentTime.h>
 #include <wtf/MainThread.h>
 #include <wtf/RunLoop.h>
 
@@ -43,6 +44,10 @@
 #include <WebCore/ThreadedScrollingTree.h>
 #endif
 
+#if USE(COORDINATED_GRAPHICS_THREADED)
+#include "ThreadedCompositor.h"
+#endif
+
 using namespace WebCore;
 
 namespace WebKit {
@@ -83,6 +88,58 @@ void EventDispatcher::removeScrollingTreeForPage(WebPage* webPage)
 }
 #endif
 
+#if USE(COORDINATED_GRAPHICS_THREADED)
+void EventDispatcher::addThreadedCompositorForPage(uint64_t pageID, ThreadedCompositor& compositor)
+{
+    LockHolder locker(m_threadedCompositorsMutex);
+    ASSERT(!m_threadedCompositors.contains(pageID));
+
+    m_threadedCompositors.set(pageID, &compositor);
+}
+
+void EventDispatcher::removeThreadedCompositorForPage(uint64_t pageID)
+{
+    LockHolder locker(m_threadedCompositorsMutex);
+    ASSERT(m_threadedCompositors.contains(pageID));
+
+    m_threadedCompositors.remove(pageID);
+}
+#endif
+
+static bool canCoalesce(const WebWheelEvent& a, const WebWheelEvent& b)
+{
+    if (a.modifiers() != b.modifiers())
+        return false;
+    if (a.granularity() != b.granularity())
+        return false;
+#if PLATFORM(COCOA)
+    if (a.phase() != b.phase())
+        return false;
+    if (a.momentumPhase() != b.momentumPhase())
+        return false;
+    if (a.hasPreciseScrollingDeltas() != b.hasPreciseScrollingDeltas())
+        return false;
+#endif
+
+    return true;
+}
+
+static WebWheelEvent coalesce(const WebWheelEvent& a, const WebWheelEvent& b)
+{
+    ASSERT(canCoalesce(a, b));
+
+    FloatSize mergedDelta = a.delta() + b.delta();
+    FloatSize mergedWheelTicks = a.wheelTicks() + b.wheelTicks();
+
+#if PLATFORM(COCOA)
+    FloatSize mergedUnacceleratedScrollingDelta = a.unacceleratedScrollingDelta() + b.unacceleratedScrollingDelta();
+
+    return WebWheelEvent(WebEvent::Wheel, b.position(), b.globalPosition(), mergedDelta, mergedWheelTicks, b.granularity(), b.directionInvertedFromDevice(), b.phase(), b.momentumPhase(), b.hasPreciseScrollingDeltas(), b.scrollCount(), mergedUnacceleratedScrollingDelta, b.modifiers(), b.timestamp());
+#else
+    return WebWheelEvent(WebEvent::Wheel, b.position(), b.globalPosition(), mergedDelta, mergedWheelTicks, b.granularity(), b.modifiers(), b.timestamp());
+#endif
+}
+
 void EventDispatcher::initializeConnection(IPC::Connection* connection)
 {
     connection->addWorkQueueMessageReceiver(Messages::EventDispatcher::messageReceiverName(), &m_queue.get(), this);
@@ -138,9 +195,38 @@ void EventDispatcher::wheelEvent(uint64_t pageID, const WebWheelEvent& wheelEven
     UNUSED_PARAM(canRubberBandAtBottom);
 #endif
 
+#if USE(COORDINATED_GRAPHICS_THREADED)
+    {
+        LockHolder locker(m_threadedCompositorsMutex);
+        if (RefPtr<ThreadedCompositor> compositor = m_threadedCompositors.get(pageID)) {
+            if (compositor->tryToScrollForWheelEvent(platformWheelEvent)) {
+                sendDidReceiveEvent(pageID, wheelEvent, true);
+                return;
+            }
+        }
+    }
+#endif
+
+    {
+        LockHolder locker(m_pendingWheelEventsLock);
+        Deque<PendingWheelEvent>& pendingEvents = m_pendingWheelEvents.add(pageID, Deque<PendingWheelEvent>()).iterator->value;
+
+        // While the main thread is busy, fold the event into the last one still waiting for it instead
+        // of making it go through a backlog of stale events.
+        if (!pendingEvents.isEmpty() && canCoalesce(pendingEvents.last().event, wheelEvent)) {
+            PendingWheelEvent& pendingEvent = pendingEvents.last();
+            pendingEvent.event = coalesce(pendingEvent.event, wheelEvent);
+            ++pendingEvent.coalescedEventCount;
+            return;
+        }
+
+        pendingEvents.append(PendingWheelEvent { wheelEvent, 1, monotonicallyIncreasingTime() });
+    }
+
     RefPtr<EventDispatcher> eventDispatcher = this;
-    RunLoop::main().dispatch([eventDispatcher, pageID, wheelEvent] {
-        eventDispatcher->dispatchWheelEvent(pageID, wheelEvent);
+    ++m_eventsPendingOnMainThread;
+    RunLoop::main().dispatch([eventDispatcher, pageID] {
+        eventDispatcher->dispatchWheelEvent(pageID);
     }); 
 }
 
@@ -148,6 +234,7 @@ void EventDispatcher::wheelEvent(uint64_t pageID, const WebWheelEvent& wheelEven
 void EventDispatcher::gestureEvent(uint64_t pageID, const WebKit::WebGestureEvent& gestureEvent)
 {
     RefPtr<EventDispatcher> eventDispatcher = this;
+    ++m_eventsPendingOnMainThread;
     RunLoop::main().dispatch([eventDispatcher, pageID, gestureEvent] {
         eventDispatcher->dispatchGestureEvent(pageID, gestureEvent);
     });
@@ -192,6 +279,7 @@ void EventDispatcher::touchEvent(uint64_t pageID, const WebKit::WebTouchEvent& t
 
     if (updateListWasEmpty) {
         RefPtr<EventDispatcher> eventDispatcher = this;
+        ++m_eventsPendingOnMainThread;
         RunLoop::main().dispatch([eventDispatcher] {
             eventDispatcher->dispatchTouchEvents();
         });
@@ -205,6 +293,7 @@ void EventDispatcher::dispatchTouchEvents()
         LockHolder locker(&m_touchEventsLock);
         localCopy.swap(m_touchEvents);
     }
+    --m_eventsPendingOnMainThread;
 
     for (auto& slot : localCopy) {
         if (WebPage* webPage = WebProcess::singleton().webPage(slot.key))
@@ -213,15 +302,60 @@ void EventDispatcher::dispatchTouchEvents()
 }
 #endif
 
-void EventDispatcher::dispatchWheelEvent(uint64_t pageID, const WebWheelEvent& wheelEvent)
+EventDispatcher::PendingWheelEvent EventDispatcher::takeNextPendingWheelEvent(uint64_t pageID)
+{
+    LockHolder locker(m_pendingWheelEventsLock);
+
+    auto it = m_pendingWheelEvents.find(pageID);
+    ASSERT(it != m_pendingWheelEvents.end());
+    ASSERT(!it->value.isEmpty());
+
+    PendingWheelEvent pendingEvent = it->value.takeFirst();
+    if (it->value.isEmpty())
+        m_pendingWheelEvents.remove(it);
+    return pendingEvent;
+}
+
+void EventDispatcher::dispatchWheelEvent(uint64_t pageID)
 {
     ASSERT(RunLoop::isMain());
 
+    --m_eventsPendingOnMainThread;
+
+    PendingWheelEvent pendingEvent = takeNextPendingWheelEvent(pageID);
+
     WebPage* webPage = WebProcess::singleton().webPage(pageID);
-    if (!webPage)
+    if (!webPage) {
+        m_wheelEventLatencies.remove(pageID);
+        return;
+    }
+
+    recordWheelEventLatency(*webPage, pendingEvent);
+    webPage->wheelEvent(pendingEvent.event, pendingEvent.coalescedEventCount);
+}
+
+void EventDispatcher::recordWheelEventLatency(WebPage& webPage, const PendingWheelEvent& pendingEvent)
+{
+    static const double latencyReportInterval = 1;
+
+    double now = monotonicallyIncreasingTime();
+    double latency = now - pendingEvent.receiveTime;
+
+    auto addResult = m_wheelEventLatencies.add(webPage.pageID(), WheelEventLatency());
+    WheelEventLatency& latencies = addResult.iterator->value;
+    if (addResult.isNewEntry)
+        latencies.intervalStartTime = now;
+
+    ++latencies.dispatchedEventCount;
+    latencies.receivedEventCount += pendingEvent.coalescedEventCount;
+    latencies.totalLatency += latency;
+    latencies.maximumLatency = std::max(latencies.maximumLatency, latency);
+
+    if (now - latencies.intervalStartTime < latencyReportInterval)
         return;
 
-    webPage->wheelEvent(wheelEvent);
+    webPage.send(Messages::WebPageProxy::DidReportWheelEventLatency(latencies.totalLatency / latencies.dispatchedEventCount, latencies.maximumLatency, latencies.receivedEventCount, latencies.dispatchedEventCount));
+    m_wheelEventLatencies.remove(addResult.iterator);
 }
 
 #if ENABLE(MAC_GESTURE_EVENTS)
@@ -229,6 +363,8 @@ void EventDispatcher::dispatchGestureEvent(uint64_t pageID, const WebGestureEven
 {
     ASSERT(RunLoop::isMain());
 
+    --m_eventsPendingOnMainThread;
+
     WebPage* webPage = WebProcess::singleton().webPage(pageID);
     if (!webPage)
         return;
@@ -237,7 +373,7 @@ void EventDispatcher::dispatchGestureEvent(uint64_t pageID, const WebGestureEven
 }
 #endif
 
-#if ENABLE(ASYNC_SCROLLING)
+#if ENABLE(ASYNC_SCROLLING) || USE(COORDINATED_GRAPHICS_THREADED)
 void EventDispatcher::sendDidReceiveEvent(uint64_t pageID, const WebEvent& event, bool didHandleEvent)
 {
     WebProcess::singleton().parentProcessConnection()->send(Messages::WebPageProxy::DidReceiveEvent(static_cast<uint32_t>(event.type()), didHandleEvent), pageID);
@@ -30,7 +30,9 @@
 
 #include "WebEvent.h"
 #include <WebCore/WheelEventDeltaFilter.h>
+#include <atomic>
 #include <memory>
+#include <wtf/Deque.h>
 #include <wtf/HashMap.h>
 #include <wtf/Lock.h>
 #include <wtf/Noncopyable.h>
@@ -47,6 +49,9 @@ class ThreadedScrollingTree;
 
 namespace WebKit {
 
+#if USE(COORDINATED_GRAPHICS_THREADED)
+class ThreadedCompositor;
+#endif
 class WebEvent;
 class WebPage;
 class WebWheelEvent;
@@ -61,6 +66,11 @@ public:
     void removeScrollingTreeForPage(WebPage*);
 #endif
 
+#if USE(COORDINATED_GRAPHICS_THREADED)
+    void addThreadedCompositorForPage(uint64_t pageID, ThreadedCompositor&);
+    void removeThreadedCompositorForPage(uint64_t pageID);
+#endif
+
 #if ENABLE(IOS_TOUCH_EVENTS)
     typedef Vector<WebTouchEvent, 1> TouchEventQueue;
 
@@ -70,6 +80,11 @@ public:
 
     void initializeConnection(IPC::Connection*);
 
+    // True while input events received on the event dispatcher queue are still waiting to be
+    // handled on the main thread. Long running main thread work, like parsing, can use this to
+    // yield early.
+    bool hasEventsPendingOnMainThread() const { return m_eventsPendingOnMainThread.load(std::memory_order_relaxed); }
+
 private:
     EventDispatcher();
 
@@ -86,8 +101,18 @@ private:
 #endif
 
 
+    // A wheel event waiting for the main thread, along with the ones received after it that were
+    // coalesced into it. The UI process expects a reply for each of them.
+    struct PendingWheelEvent {
+        WebWheelEvent event;
+        unsigned coalescedEventCount;
+        double receiveTime;
+    };
+    PendingWheelEvent takeNextPendingWheelEvent(uint64_t pageID);
+
     // This is called on the main thread.
-    void dispatchWheelEvent(uint64_t pageID, const WebWheelEvent&);
+    void dispatchWheelEvent(uint64_t pageID);
+    void recordWheelEventLatency(WebPage&, const PendingWheelEvent&);
 #if ENABLE(IOS_TOUCH_EVENTS)
     void dispatchTouchEvents();
 #endif
@@ -95,15 +120,34 @@ private:
     void dispatchGestureEvent(uint64_t pageID, const WebGestureEvent&);
 #endif
 
-#if ENABLE(ASYNC_SCROLLING)
+#if ENABLE(ASYNC_SCROLLING) || USE(COORDINATED_GRAPHICS_THREADED)
     void sendDidReceiveEvent(uint64_t pageID, const WebEvent&, bool didHandleEvent);
 #endif
 
     Ref<WorkQueue> m_queue;
+    std::atomic<unsigned> m_eventsPendingOnMainThread { 0 };
+
+    Lock m_pendingWheelEventsLock;
+    HashMap<uint64_t, Deque<PendingWheelEvent>> m_pendingWheelEvents;
+
+    // How long wheel events wait for the main thread, gathered on the main thread and reported to the
+    // UI process about once a second.
+    struct WheelEventLatency {
+        double intervalStartTime { 0 };
+        double totalLatency { 0 };
+        double maximumLatency { 0 };
+        uint64_t receivedEventCount { 0 };
+        uint64_t dispatchedEventCount { 0 };
+    };
+    HashMap<uint64_t, WheelEventLatency> m_wheelEventLatencies;
 
 #if ENABLE(ASYNC_SCROLLING)
     Lock m_scrollingTreesMutex;
     HashMap<uint64_t, RefPtr<WebCore::ThreadedScrollingTree>> m_scrollingTrees;
+#endif
+#if USE(COORDINATED_GRAPHICS_THREADED)
+    Lock m_threadedCompositorsMutex;
+    HashMap<uint64_t, RefPtr<ThreadedCompositor>> m_threadedCompositors;
 #endif
     std::unique_ptr<WebCore::WheelEventDeltaFilter> m_recentWheelEventDeltaFilter;
 #if ENABLE(IOS_TOUCH_EVENTS)
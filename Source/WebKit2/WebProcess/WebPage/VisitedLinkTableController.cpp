@@ -73,12 +73,24 @@ VisitedLinkTableController::~VisitedLinkTableController()
 
 bool VisitedLinkTableController::isLinkVisited(Page&, LinkHash linkHash, const URL&, const AtomicString&)
 {
-    return m_visitedLinkTable.isLinkVisited(linkHash);
+    return containsLinkHash(linkHash);
 }
 
-void VisitedLinkTableController::addVisitedLink(Page& page, LinkHash linkHash)
+bool VisitedLinkTableController::containsLinkHash(LinkHash linkHash) const
 {
     if (m_visitedLinkTable.isLinkVisited(linkHash))
+        return true;
+
+    for (auto& segment : m_visitedLinkTableSegments) {
+        if (segment.isLinkVisited(linkHash))
+            return true;
+    }
+    return false;
+}
+
+void VisitedLinkTableController::addVisitedLink(Page& page, LinkHash linkHash)
+{
+    if (containsLinkHash(linkHash))
         return;
 
     WebPage* webPage = WebPage::fromCorePage(&page);
@@ -88,18 +100,38 @@ void VisitedLinkTableController::addVisitedLink(Page& page, LinkHash linkHash)
     WebProcess::singleton().parentProcessConnection()->send(Messages::VisitedLinkStore::AddVisitedLinkHashFromPage(webPage->pageID(), linkHash), m_identifier);
 }
 
-void VisitedLinkTableController::setVisitedLinkTable(const SharedMemory::Handle& handle)
+void VisitedLinkTableController::setVisitedLinkTable(const SharedMemory::Handle& handle, uint32_t format)
 {
+    if (!VisitedLinkTable::isValidFormat(format))
+        return;
+
     RefPtr<SharedMemory> sharedMemory = SharedMemory::map(handle, SharedMemory::Protection::ReadOnly);
     if (!sharedMemory)
         return;
 
-    m_visitedLinkTable.setSharedMemory(sharedMemory.release());
+    m_visitedLinkTable.setSharedMemory(sharedMemory.release(), static_cast<VisitedLinkTable::Format>(format));
+    m_visitedLinkTableSegments.clear();
 
     invalidateStylesForAllLinks();
     PageCache::singleton().markPagesForVisitedLinkStyleRecalc();
 }
 
+void VisitedLinkTableController::addVisitedLinkTableSegment(const SharedMemory::Handle& handle, uint32_t format)
+{
+    if (!VisitedLinkTable::isValidFormat(format))
+        return;
+
+    RefPtr<SharedMemory> sharedMemory = SharedMemory::map(handle, SharedMemory::Protection::ReadOnly);
+    if (!sharedMemory)
+        return;
+
+    VisitedLinkTable segment;
+    segment.setSharedMemory(sharedMemory.release(), static_cast<VisitedLinkTable::Format>(format));
+    m_visitedLinkTableSegments.append(segment);
+
+    // The UI process follows up with the links that were added to the segment, so there is nothing to invalidate yet.
+}
+
 void VisitedLinkTableController::visitedLinkStateChanged(const Vector<WebCore::LinkHash>& linkHashes)
 {
     for (auto linkHash : linkHashes)
@@ -116,6 +148,7 @@ void VisitedLinkTableController::allVisitedLinkStateChanged()
 void VisitedLinkTableController::removeAllVisitedLinks()
 {
     m_visitedLinkTable.clear();
+    m_visitedLinkTableSegments.clear();
 
     invalidateStylesForAllLinks();
     PageCache::singleton().markPagesForVisitedLinkStyleRecalc();
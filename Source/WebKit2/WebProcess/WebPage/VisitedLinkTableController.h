@@ -48,13 +48,17 @@ private:
     // IPC::MessageReceiver.
     virtual void didReceiveMessage(IPC::Connection&, IPC::MessageDecoder&) override;
 
-    void setVisitedLinkTable(const SharedMemory::Handle&);
+    bool containsLinkHash(WebCore::LinkHash) const;
+
+    void setVisitedLinkTable(const SharedMemory::Handle&, uint32_t format);
+    void addVisitedLinkTableSegment(const SharedMemory::Handle&, uint32_t format);
     void visitedLinkStateChanged(const Vector<WebCore::LinkHash>&);
     void allVisitedLinkStateChanged();
     void removeAllVisitedLinks();
 
     uint64_t m_identifier;
     VisitedLinkTable m_visitedLinkTable;
+    Vector<VisitedLinkTable> m_visitedLinkTableSegments;
 };
 
 } // namespace WebKit
@@ -1871,7 +1871,7 @@ void WebPage::pageDidScroll()
 
     m_pageScrolledHysteresis.impulse();
 
-    send(Messages::WebPageProxy::PageDidScroll());
+    send(Messages::WebPageProxy::PageDidScroll(), m_pageID, IPC::ReplacePendingMessageOfSameKind);
 }
 
 void WebPage::pageStoppedScrolling()
@@ -2084,7 +2084,7 @@ static bool handleWheelEvent(const WebWheelEvent& wheelEvent, Page* page)
     return page->userInputBridge().handleWheelEvent(platformWheelEvent);
 }
 
-void WebPage::wheelEvent(const WebWheelEvent& wheelEvent)
+void WebPage::wheelEvent(const WebWheelEvent& wheelEvent, unsigned coalescedEventCount)
 {
     m_page->pageThrottler().didReceiveUserInput();
 
@@ -2095,7 +2095,9 @@ void WebPage::wheelEvent(const WebWheelEvent& wheelEvent)
 
         handled = handleWheelEvent(wheelEvent, m_page.get());
     }
-    send(Messages::WebPageProxy::DidReceiveEvent(static_cast<uint32_t>(wheelEvent.type()), handled));
+
+    for (unsigned i = 0; i < coalescedEventCount; ++i)
+        send(Messages::WebPageProxy::DidReceiveEvent(static_cast<uint32_t>(wheelEvent.type()), handled));
 }
 
 static bool handleKeyEvent(const WebKeyboardEvent& keyboardEvent, Page* page)
@@ -3489,7 +3491,7 @@ void WebPage::updateMainFrameScrollOffsetPinning()
     bool isPinnedToBottomSide = (scrollPosition.y() >= maximumScrollPosition.y());
 
     if (isPinnedToLeftSide != m_cachedMainFrameIsPinnedToLeftSide || isPinnedToRightSide != m_cachedMainFrameIsPinnedToRightSide || isPinnedToTopSide != m_cachedMainFrameIsPinnedToTopSide || isPinnedToBottomSide != m_cachedMainFrameIsPinnedToBottomSide) {
-        send(Messages::WebPageProxy::DidChangeScrollOffsetPinningForMainFrame(isPinnedToLeftSide, isPinnedToRightSide, isPinnedToTopSide, isPinnedToBottomSide));
+        send(Messages::WebPageProxy::DidChangeScrollOffsetPinningForMainFrame(isPinnedToLeftSide, isPinnedToRightSide, isPinnedToTopSide, isPinnedToBottomSide), m_pageID, IPC::ReplacePendingMessageOfSameKind);
         
         m_cachedMainFrameIsPinnedToLeftSide = isPinnedToLeftSide;
         m_cachedMainFrameIsPinnedToRightSide = isPinnedToRightSide;
@@ -4399,14 +4401,14 @@ void WebPage::confirmComposition(const String& compositionString, int64_t select
 {
     Frame* targetFrame = targetFrameForEditing(this);
     if (!targetFrame) {
-        send(Messages::WebPageProxy::EditorStateChanged(editorState()));
+        send(Messages::WebPageProxy::EditorStateChanged(editorState()), m_pageID, IPC::ReplacePendingMessageOfSameKind);
         return;
     }
 
     targetFrame->editor().confirmComposition(compositionString);
 
     if (selectionStart == -1) {
-        send(Messages::WebPageProxy::EditorStateChanged(editorState()));
+        send(Messages::WebPageProxy::EditorStateChanged(editorState()), m_pageID, IPC::ReplacePendingMessageOfSameKind);
         return;
     }
 
@@ -4418,14 +4420,14 @@ void WebPage::confirmComposition(const String& compositionString, int64_t select
         VisibleSelection selection(*selectionRange, SEL_DEFAULT_AFFINITY);
         targetFrame->selection().setSelection(selection);
     }
-    send(Messages::WebPageProxy::EditorStateChanged(editorState()));
+    send(Messages::WebPageProxy::EditorStateChanged(editorState()), m_pageID, IPC::ReplacePendingMessageOfSameKind);
 }
 
 void WebPage::setComposition(const String& text, const Vector<CompositionUnderline>& underlines, uint64_t selectionStart, uint64_t selectionLength, uint64_t replacementStart, uint64_t replacementLength)
 {
     Frame* targetFrame = targetFrameForEditing(this);
     if (!targetFrame || !targetFrame->selection().selection().isContentEditable()) {
-        send(Messages::WebPageProxy::EditorStateChanged(editorState()));
+        send(Messages::WebPageProxy::EditorStateChanged(editorState()), m_pageID, IPC::ReplacePendingMessageOfSameKind);
         return;
     }
 
@@ -4441,14 +4443,14 @@ void WebPage::setComposition(const String& text, const Vector<CompositionUnderli
     }
 
     targetFrame->editor().setComposition(text, underlines, selectionStart, selectionStart + selectionLength);
-    send(Messages::WebPageProxy::EditorStateChanged(editorState()));
+    send(Messages::WebPageProxy::EditorStateChanged(editorState()), m_pageID, IPC::ReplacePendingMessageOfSameKind);
 }
 
 void WebPage::cancelComposition()
 {
     if (Frame* targetFrame = targetFrameForEditing(this))
         targetFrame->editor().cancelComposition();
-    send(Messages::WebPageProxy::EditorStateChanged(editorState()));
+    send(Messages::WebPageProxy::EditorStateChanged(editorState()), m_pageID, IPC::ReplacePendingMessageOfSameKind);
 }
 #endif
 
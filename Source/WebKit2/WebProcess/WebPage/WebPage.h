@@ -793,7 +793,8 @@ public:
     void contextMenuShowing() { m_isShowingContextMenu = true; }
 #endif
 
-    void wheelEvent(const WebWheelEvent&);
+    // The event may stand for several ones the EventDispatcher coalesced, each of which gets a reply.
+    void wheelEvent(const WebWheelEvent&, unsigned coalescedEventCount = 1);
 
     void wheelEventHandlersChanged(bool);
     void recomputeShortCircuitHorizontalWheelEventsState();
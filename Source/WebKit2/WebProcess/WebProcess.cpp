@@ -67,6 +67,7 @@
 #include <WebCore/AXObjectCache.h>
 #include <WebCore/ApplicationCacheStorage.h>
 #include <WebCore/AuthenticationChallenge.h>
+#include <WebCore/CSSDefaultStyleSheets.h>
 #include <WebCore/CrossOriginPreflightResultCache.h>
 #include <WebCore/DNS.h>
 #include <WebCore/FontCache.h>
@@ -1175,6 +1176,37 @@ void WebProcess::releasePageCache()
     PageCache::singleton().pruneToSizeNow(0, PruningReason::MemoryPressure);
 }
 
+void WebProcess::prewarm()
+{
+    // Do the work that the first page load would otherwise pay for, while no page is waiting.
+    CSSDefaultStyleSheets::loadFullDefaultStyleIfNeeded();
+    JSDOMWindow::commonVM();
+    FontCache::singleton().lastResortFallbackFont(FontDescription());
+}
+
+void WebProcess::reportMemoryFootprint()
+{
+    WTF::FastMallocStatistics fastMallocStatistics = WTF::fastMallocStatistics();
+    uint64_t footprint = fastMallocStatistics.committedVMBytes - fastMallocStatistics.freeListBytes + JSDOMWindow::commonVM().heap.capacity();
+    parentProcessConnection()->send(Messages::WebProcessProxy::DidReportMemoryFootprint(footprint), 0);
+}
+
+void WebProcess::releaseCachedMemory()
+{
+    PageCache::singleton().pruneToSizeNow(0, PruningReason::MemoryPressure);
+    MemoryPressureHandler::singleton().releaseMemory(Critical::No);
+}
+
+void WebProcess::releaseDecodedImageData()
+{
+    MemoryCache::singleton().pruneLiveResourcesToSize(0, true);
+}
+
+void WebProcess::discardJITCode()
+{
+    GCController::singleton().deleteAllCode();
+}
+
 void WebProcess::fetchWebsiteData(WebCore::SessionID sessionID, uint64_t websiteDataTypes, uint64_t callbackID)
 {
     WebsiteData websiteData;
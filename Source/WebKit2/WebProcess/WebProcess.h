@@ -273,6 +273,12 @@ private:
     void setJavaScriptGarbageCollectorTimerEnabled(bool flag);
 
     void releasePageCache();
+    void prewarm();
+
+    void reportMemoryFootprint();
+    void releaseCachedMemory();
+    void releaseDecodedImageData();
+    void discardJITCode();
 
     void fetchWebsiteData(WebCore::SessionID, uint64_t websiteDataTypes, uint64_t callbackID);
     void deleteWebsiteData(WebCore::SessionID, uint64_t websiteDataTypes, std::chrono::system_clock::time_point modifiedSince, uint64_t callbackID);
@@ -29,7 +29,6 @@
 #include "Heap.h"
 #include "LargeChunk.h"
 #include "LargeObject.h"
-#include "PerProcess.h"
 #include "Sizes.h"
 #include <algorithm>
 #include <cstdlib>
@@ -39,8 +38,11 @@ using namespace std;
 namespace bmalloc {
 
 Allocator::Allocator(Heap* heap, Deallocator& deallocator)
-    : m_isBmallocEnabled(heap->environment().isBmallocEnabled())
+    : m_heap(heap)
+    , m_isBmallocEnabled(heap->environment().isBmallocEnabled())
     , m_deallocator(deallocator)
+    , m_bumpRangeCacheRefillCount(0)
+    , m_heapRefillCount(0)
 {
     for (unsigned short size = alignment; size <= mediumMax; size += alignment)
         m_bumpAllocators[sizeClass(size)].init(size);
@@ -60,8 +62,8 @@ void* Allocator::tryAllocate(size_t size)
         return allocate(size);
 
     if (size <= xLargeMax) {
-        std::lock_guard<StaticMutex> lock(PerProcess<Heap>::mutex());
-        return PerProcess<Heap>::getFastCase()->tryAllocateXLarge(lock, superChunkSize, roundUpToMultipleOf<xLargeAlignment>(size));
+        std::lock_guard<StaticMutex> lock(m_heap->mutex());
+        return m_heap->tryAllocateXLarge(lock, superChunkSize, roundUpToMultipleOf<xLargeAlignment>(size));
     }
 
     return nullptr;
@@ -102,16 +104,16 @@ void* Allocator::allocate(size_t alignment, size_t size)
         alignment = roundUpToMultipleOf<largeAlignment>(alignment);
         size_t unalignedSize = largeMin + alignment + size;
         if (unalignedSize <= largeMax && alignment <= largeChunkSize / 2) {
-            std::lock_guard<StaticMutex> lock(PerProcess<Heap>::mutex());
-            return PerProcess<Heap>::getFastCase()->allocateLarge(lock, alignment, size, unalignedSize);
+            std::lock_guard<StaticMutex> lock(m_heap->mutex());
+            return m_heap->allocateLarge(lock, alignment, size, unalignedSize);
         }
     }
 
     if (size <= xLargeMax && alignment <= xLargeMax) {
         size = roundUpToMultipleOf<xLargeAlignment>(size);
         alignment = std::max(superChunkSize, alignment);
-        std::lock_guard<StaticMutex> lock(PerProcess<Heap>::mutex());
-        return PerProcess<Heap>::getFastCase()->allocateXLarge(lock, alignment, size);
+        std::lock_guard<StaticMutex> lock(m_heap->mutex());
+        return m_heap->allocateXLarge(lock, alignment, size);
     }
 
     BCRASH();
@@ -136,7 +138,7 @@ void* Allocator::reallocate(void* object, size_t newSize)
         break;
     }
     case Large: {
-        std::unique_lock<StaticMutex> lock(PerProcess<Heap>::mutex());
+        std::unique_lock<StaticMutex> lock(m_heap->mutex());
         LargeObject largeObject(object);
         oldSize = largeObject.size();
 
@@ -158,8 +160,8 @@ void* Allocator::reallocate(void* object, size_t newSize)
         if (!object)
             break;
 
-        std::unique_lock<StaticMutex> lock(PerProcess<Heap>::mutex());
-        Range& range = PerProcess<Heap>::getFastCase()->findXLarge(lock, object);
+        std::unique_lock<StaticMutex> lock(m_heap->mutex());
+        Range& range = m_heap->findXLarge(lock, object);
         oldSize = range.size();
 
         if (newSize < oldSize && newSize > largeMax) {
@@ -203,15 +205,32 @@ void Allocator::scavenge()
     }
 }
 
+void Allocator::collectStatistics(ThreadCacheStatistics& statistics)
+{
+    for (unsigned short size = alignment; size <= mediumMax; size += alignment) {
+        BumpAllocator& allocator = m_bumpAllocators[sizeClass(size)];
+        statistics.bumpAllocatorBytes += allocator.remaining() * size;
+
+        for (auto& bumpRange : m_bumpRangeCaches[sizeClass(size)])
+            statistics.bumpRangeCacheBytes += bumpRange.objectCount * size;
+    }
+
+    statistics.bumpRangeCacheRefills += m_bumpRangeCacheRefillCount;
+    statistics.heapRefills += m_heapRefillCount;
+}
+
 NO_INLINE void Allocator::refillAllocatorSlowCase(BumpAllocator& allocator, size_t sizeClass)
 {
     BumpRangeCache& bumpRangeCache = m_bumpRangeCaches[sizeClass];
 
-    std::lock_guard<StaticMutex> lock(PerProcess<Heap>::mutex());
-    if (sizeClass <= bmalloc::sizeClass(smallMax))
-        PerProcess<Heap>::getFastCase()->allocateSmallBumpRanges(lock, sizeClass, allocator, bumpRangeCache);
+    ++m_heapRefillCount;
+
+    std::lock_guard<StaticMutex> lock(m_heap->mutex());
+    m_heap->processDeferredObjectLogs(lock);
+    if (sizeClass <= bmalloc::sizeClass(m_heap->smallSizeLimit(lock)))
+        m_heap->allocateSmallBumpRanges(lock, sizeClass, allocator, bumpRangeCache);
     else
-        PerProcess<Heap>::getFastCase()->allocateMediumBumpRanges(lock, sizeClass, allocator, bumpRangeCache);
+        m_heap->allocateMediumBumpRanges(lock, sizeClass, allocator, bumpRangeCache);
 }
 
 INLINE void Allocator::refillAllocator(BumpAllocator& allocator, size_t sizeClass)
@@ -219,21 +238,22 @@ INLINE void Allocator::refillAllocator(BumpAllocator& allocator, size_t sizeClas
     BumpRangeCache& bumpRangeCache = m_bumpRangeCaches[sizeClass];
     if (!bumpRangeCache.size())
         return refillAllocatorSlowCase(allocator, sizeClass);
+    ++m_bumpRangeCacheRefillCount;
     return allocator.refill(bumpRangeCache.pop());
 }
 
 NO_INLINE void* Allocator::allocateLarge(size_t size)
 {
     size = roundUpToMultipleOf<largeAlignment>(size);
-    std::lock_guard<StaticMutex> lock(PerProcess<Heap>::mutex());
-    return PerProcess<Heap>::getFastCase()->allocateLarge(lock, size);
+    std::lock_guard<StaticMutex> lock(m_heap->mutex());
+    return m_heap->allocateLarge(lock, size);
 }
 
 NO_INLINE void* Allocator::allocateXLarge(size_t size)
 {
     size = roundUpToMultipleOf<xLargeAlignment>(size);
-    std::lock_guard<StaticMutex> lock(PerProcess<Heap>::mutex());
-    return PerProcess<Heap>::getFastCase()->allocateXLarge(lock, size);
+    std::lock_guard<StaticMutex> lock(m_heap->mutex());
+    return m_heap->allocateXLarge(lock, size);
 }
 
 void* Allocator::allocateSlowCase(size_t size)
@@ -27,6 +27,7 @@
 #define Allocator_h
 
 #include "BumpAllocator.h"
+#include "Statistics.h"
 #include <array>
 
 namespace bmalloc {
@@ -48,6 +49,8 @@ public:
 
     void scavenge();
 
+    void collectStatistics(ThreadCacheStatistics&);
+
 private:
     bool allocateFastCase(size_t, void*&);
     void* allocateSlowCase(size_t);
@@ -62,8 +65,12 @@ private:
     std::array<BumpAllocator, mediumMax / alignment> m_bumpAllocators;
     std::array<BumpRangeCache, mediumMax / alignment> m_bumpRangeCaches;
 
+    Heap* m_heap;
     bool m_isBmallocEnabled;
     Deallocator& m_deallocator;
+
+    size_t m_bumpRangeCacheRefillCount;
+    size_t m_heapRefillCount;
 };
 
 inline bool Allocator::allocateFastCase(size_t size, void*& object)
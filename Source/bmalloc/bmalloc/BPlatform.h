@@ -47,4 +47,8 @@
 #define BOS_UNIX 1
 #endif
 
+#ifdef __linux__
+#define BOS_LINUX 1
+#endif
+
 #endif // BPlatform_h
@@ -40,6 +40,7 @@ public:
     void init(size_t);
     
     size_t size() { return m_size; }
+    size_t remaining() { return m_remaining; }
     
     bool isNull() { return !m_ptr; }
     void clear();
@@ -75,7 +76,8 @@ inline void BumpAllocator::validate(void* ptr)
 {
     UNUSED(ptr);
     if (m_size <= smallMax) {
-        BASSERT(isSmall(ptr));
+        // The small / medium boundary is tunable, so sizes up to smallMax may be either.
+        BASSERT(isSmallOrMedium(ptr));
         return;
     }
     
@@ -50,9 +50,24 @@ void Cache::scavenge()
     cache->deallocator().scavenge();
 }
 
+void Cache::collectStatistics(ThreadCacheStatistics& statistics)
+{
+    Cache* cache = PerThread<Cache>::getFastCase();
+    if (!cache)
+        return;
+
+    cache->allocator().collectStatistics(statistics);
+    cache->deallocator().collectStatistics(statistics);
+}
+
 Cache::Cache()
-    : m_deallocator(PerProcess<Heap>::get())
-    , m_allocator(PerProcess<Heap>::get(), m_deallocator)
+    : Cache(PerProcess<Heap>::get())
+{
+}
+
+Cache::Cache(Heap* heap)
+    : m_deallocator(heap)
+    , m_allocator(heap, m_deallocator)
 {
 }
 
@@ -32,7 +32,8 @@
 
 namespace bmalloc {
 
-// Per-thread allocation / deallocation cache, backed by a per-process Heap.
+// Per-thread allocation / deallocation cache, backed by a per-process Heap. The
+// static functions use the primary heap's cache.
 
 class Cache {
 public:
@@ -46,8 +47,10 @@ public:
     static void* reallocate(void*, size_t);
 
     static void scavenge();
+    static void collectStatistics(ThreadCacheStatistics&);
 
     Cache();
+    explicit Cache(Heap*);
 
     Allocator& allocator() { return m_allocator; }
     Deallocator& deallocator() { return m_deallocator; }
@@ -51,6 +51,10 @@ public:
     Line* lines() { return m_lines; }
     Page* pages() { return m_pages; }
 
+    // The VMHeap node free list this chunk's pages return to.
+    unsigned node() { return m_node; }
+    void setNode(unsigned node) { m_node = node; }
+
 private:
     static_assert(!(vmPageSize % lineSize), "vmPageSize must be an even multiple of line size");
     static_assert(!(chunkSize % lineSize), "chunk size must be an even multiple of line size");
@@ -60,6 +64,7 @@ private:
 
     Line m_lines[lineCount];
     Page m_pages[pageCount];
+    unsigned char m_node;
 
     // Align to vmPageSize to avoid sharing physical pages with metadata.
     // Otherwise, we'll confuse the scavenger into trying to scavenge metadata.
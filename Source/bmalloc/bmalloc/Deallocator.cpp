@@ -28,7 +28,6 @@
 #include "Deallocator.h"
 #include "Heap.h"
 #include "Inline.h"
-#include "PerProcess.h"
 #include "SmallChunk.h"
 #include <algorithm>
 #include <cstdlib>
@@ -39,8 +38,13 @@ using namespace std;
 namespace bmalloc {
 
 Deallocator::Deallocator(Heap* heap)
-    : m_isBmallocEnabled(heap->environment().isBmallocEnabled())
+    : m_heap(heap)
+    , m_isBmallocEnabled(heap->environment().isBmallocEnabled())
+    , m_objectLogFlushCount(0)
 {
+    for (auto& log : m_deferredObjectLogs)
+        log.isPending.store(false, std::memory_order_relaxed);
+
     if (!m_isBmallocEnabled) {
         // Fill the object log in order to disable the fast path.
         while (m_objectLog.size() != m_objectLog.capacity())
@@ -55,39 +59,76 @@ Deallocator::~Deallocator()
     
 void Deallocator::scavenge()
 {
-    if (m_isBmallocEnabled)
-        processObjectLog();
+    if (!m_isBmallocEnabled)
+        return;
+
+    // Wait for the lock, so that our deferred logs are processed too.
+    std::lock_guard<StaticMutex> lock(m_heap->mutex());
+    processObjectLog(lock);
+}
+
+void Deallocator::collectStatistics(ThreadCacheStatistics& statistics)
+{
+    if (!m_isBmallocEnabled)
+        return;
+
+    statistics.objectLogSize += m_objectLog.size();
+    statistics.objectLogFlushes += m_objectLogFlushCount;
 }
 
 void Deallocator::deallocateLarge(void* object)
 {
-    std::lock_guard<StaticMutex> lock(PerProcess<Heap>::mutex());
-    PerProcess<Heap>::getFastCase()->deallocateLarge(lock, object);
+    std::lock_guard<StaticMutex> lock(m_heap->mutex());
+    m_heap->deallocateLarge(lock, object);
 }
 
 void Deallocator::deallocateXLarge(void* object)
 {
-    std::unique_lock<StaticMutex> lock(PerProcess<Heap>::mutex());
-    PerProcess<Heap>::getFastCase()->deallocateXLarge(lock, object);
+    std::unique_lock<StaticMutex> lock(m_heap->mutex());
+    m_heap->deallocateXLarge(lock, object);
+}
+
+bool Deallocator::deferObjectLog()
+{
+    for (auto& log : m_deferredObjectLogs) {
+        if (log.isPending.load(std::memory_order_acquire))
+            continue;
+
+        log.objects.push(m_objectLog.begin(), m_objectLog.end());
+        log.isPending.store(true, std::memory_order_relaxed);
+        m_heap->deferObjectLog(&log);
+        m_objectLog.clear();
+        return true;
+    }
+
+    return false;
 }
 
 void Deallocator::processObjectLog()
 {
-    std::lock_guard<StaticMutex> lock(PerProcess<Heap>::mutex());
-    Heap* heap = PerProcess<Heap>::getFastCase();
-    
-    for (auto* object : m_objectLog) {
-        if (isSmall(object)) {
-            SmallLine* line = SmallLine::get(object);
-            heap->derefSmallLine(lock, line);
-        } else {
-            BASSERT(isMedium(object));
-            MediumLine* line = MediumLine::get(object);
-            heap->derefMediumLine(lock, line);
-        }
+    // Frees from threads that don't own the heap lock are common, for example when
+    // objects are freed on a different thread than the one that allocated them. Rather
+    // than wait for the lock, hand our log to whoever holds it.
+    StaticMutex& mutex = m_heap->mutex();
+    if (!mutex.try_lock()) {
+        if (deferObjectLog())
+            return;
+        mutex.lock();
     }
+
+    std::lock_guard<StaticMutex> lock(mutex, std::adopt_lock);
+    processObjectLog(lock);
+}
+
+void Deallocator::processObjectLog(std::lock_guard<StaticMutex>& lock)
+{
+    m_heap->didFlushObjectLog(lock);
+    ++m_objectLogFlushCount;
     
+    m_heap->derefObjects(lock, m_objectLog);
     m_objectLog.clear();
+
+    m_heap->processDeferredObjectLogs(lock);
 }
 
 void Deallocator::deallocateSlowCase(void* object)
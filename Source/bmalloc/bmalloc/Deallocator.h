@@ -27,11 +27,26 @@
 #define Deallocator_h
 
 #include "FixedVector.h"
+#include "Statistics.h"
+#include "StaticMutex.h"
+#include <array>
+#include <atomic>
+#include <mutex>
 
 namespace bmalloc {
 
 class Heap;
 
+// A full object log that a deallocator handed to the heap instead of waiting for the
+// heap lock. The next thread to take the heap lock for allocation or deallocation
+// processes it on the deallocator's behalf.
+
+struct DeferredObjectLog {
+    DeferredObjectLog* next;
+    std::atomic<bool> isPending;
+    FixedVector<void*, deallocatorLogCapacity> objects;
+};
+
 // Per-cache object deallocator.
 
 class Deallocator {
@@ -41,6 +56,8 @@ public:
 
     void deallocate(void*);
     void scavenge();
+
+    void collectStatistics(ThreadCacheStatistics&);
     
 private:
     bool deallocateFastCase(void*);
@@ -49,9 +66,14 @@ private:
     void deallocateLarge(void*);
     void deallocateXLarge(void*);
     void processObjectLog();
+    void processObjectLog(std::lock_guard<StaticMutex>&);
+    bool deferObjectLog();
 
     FixedVector<void*, deallocatorLogCapacity> m_objectLog;
+    std::array<DeferredObjectLog, 2> m_deferredObjectLogs;
+    Heap* m_heap;
     bool m_isBmallocEnabled;
+    size_t m_objectLogFlushCount;
 };
 
 inline bool Deallocator::deallocateFastCase(void* object)
@@ -75,6 +75,12 @@ static bool isLibgmallocEnabled()
     return true;
 }
 
+static bool isEnvironmentVariableEnabled(const char* name)
+{
+    const char* variable = getenv(name);
+    return variable && !strcmp(variable, "1");
+}
+
 static bool isASanEnabled()
 {
 #if BOS(DARWIN)
@@ -101,6 +107,10 @@ static bool isASanEnabled()
 
 Environment::Environment()
     : m_isBmallocEnabled(computeIsBmallocEnabled())
+    , m_smallSizeLimit(computeSmallSizeLimit())
+    , m_usesHugePages(isEnvironmentVariableEnabled("BMALLOC_HUGE_PAGES"))
+    , m_isNUMAAware(isEnvironmentVariableEnabled("BMALLOC_NUMA"))
+    , m_footprintTarget(computeFootprintTarget())
 {
 }
 
@@ -115,4 +125,20 @@ bool Environment::computeIsBmallocEnabled()
     return true;
 }
 
+size_t Environment::computeSmallSizeLimit()
+{
+    const char* variable = getenv("BMALLOC_SMALL_SIZE_LIMIT");
+    if (!variable)
+        return 0;
+    return strtoul(variable, nullptr, 10);
+}
+
+size_t Environment::computeFootprintTarget()
+{
+    const char* variable = getenv("BMALLOC_FOOTPRINT_TARGET");
+    if (!variable)
+        return 0;
+    return strtoul(variable, nullptr, 10);
+}
+
 } // namespace bmalloc
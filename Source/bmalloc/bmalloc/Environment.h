@@ -26,6 +26,8 @@
 #ifndef Environment_h
 #define Environment_h
 
+#include <cstddef>
+
 namespace bmalloc {
 
 class Environment {
@@ -34,10 +36,28 @@ public:
     
     bool isBmallocEnabled() { return m_isBmallocEnabled; }
 
+    // The small / medium boundary requested with BMALLOC_SMALL_SIZE_LIMIT, or 0 if none was.
+    size_t smallSizeLimit() { return m_smallSizeLimit; }
+
+    // Set with BMALLOC_HUGE_PAGES=1. Backs new super chunks with transparent huge pages.
+    bool usesHugePages() { return m_usesHugePages; }
+
+    // Set with BMALLOC_NUMA=1. Keeps fresh VM pages on the allocating thread's NUMA node.
+    bool isNUMAAware() { return m_isNUMAAware; }
+
+    // The footprint in bytes requested with BMALLOC_FOOTPRINT_TARGET, or 0 if none was.
+    size_t footprintTarget() { return m_footprintTarget; }
+
 private:
     bool computeIsBmallocEnabled();
+    size_t computeSmallSizeLimit();
+    size_t computeFootprintTarget();
 
     bool m_isBmallocEnabled;
+    size_t m_smallSizeLimit;
+    bool m_usesHugePages;
+    bool m_isNUMAAware;
+    size_t m_footprintTarget;
 };
 
 } // namespace bmalloc
@@ -25,6 +25,7 @@
 
 #include "Heap.h"
 #include "BumpAllocator.h"
+#include "Deallocator.h"
 #include "LargeChunk.h"
 #include "LargeObject.h"
 #include "Line.h"
@@ -36,12 +37,23 @@
 
 namespace bmalloc {
 
-Heap::Heap(std::lock_guard<StaticMutex>&)
-    : m_largeObjects(Owner::Heap)
+Heap::Heap(std::lock_guard<StaticMutex>& lock, StaticMutex& mutex)
+    : m_mutex(mutex)
+    , m_largeObjects(Owner::Heap)
     , m_isAllocatingPages(false)
     , m_scavenger(*this, &Heap::concurrentScavenge)
+    , m_vmHeap(m_environment)
+    , m_smallSizeLimit(Sizes::smallMax)
+    , m_footprint(0)
+    , m_footprintTarget(m_environment.footprintTarget())
+    , m_isUnderMemoryPressure(false)
+    , m_deferredObjectLogs(nullptr)
+    , m_statistics()
 {
     initializeLineMetadata();
+
+    if (size_t environmentSmallSizeLimit = m_environment.smallSizeLimit())
+        setSmallSizeLimit(lock, environmentSmallSizeLimit);
 }
 
 void Heap::initializeLineMetadata()
@@ -62,7 +74,8 @@ void Heap::initializeLineMetadata()
         m_smallLineMetadata[sizeClass(size)][SmallPage::lineCount - 1] = { startOffset, objectCount };
     }
 
-    for (unsigned short size = smallMax + alignment; size <= mediumMax; size += alignment) {
+    // Medium pages can hold every size class, since the small / medium boundary is tunable.
+    for (unsigned short size = alignment; size <= mediumMax; size += alignment) {
         unsigned short startOffset = 0;
         for (size_t lineNumber = 0; lineNumber < MediumPage::lineCount - 1; ++lineNumber) {
             unsigned short objectCount;
@@ -79,42 +92,131 @@ void Heap::initializeLineMetadata()
     }
 }
 
+void Heap::setSmallSizeLimit(std::lock_guard<StaticMutex>&, size_t size)
+{
+    m_smallSizeLimit = std::max(alignment, std::min(roundUpToMultipleOf<alignment>(size), Sizes::smallMax));
+}
+
+HeapStatistics Heap::statistics(std::lock_guard<StaticMutex>&)
+{
+    HeapStatistics statistics = m_statistics;
+    statistics.lockAcquisitions = m_mutex.acquisitionCount();
+    statistics.contendedLockAcquisitions = m_mutex.contendedAcquisitionCount();
+    statistics.footprint = m_footprint;
+    return statistics;
+}
+
+void Heap::derefObjects(std::lock_guard<StaticMutex>& lock, const FixedVector<void*, deallocatorLogCapacity>& objects)
+{
+    for (auto* object : objects) {
+        if (isSmall(object)) {
+            SmallLine* line = SmallLine::get(object);
+            derefSmallLine(lock, line);
+        } else {
+            BASSERT(isMedium(object));
+            MediumLine* line = MediumLine::get(object);
+            derefMediumLine(lock, line);
+        }
+    }
+}
+
+void Heap::deferObjectLog(DeferredObjectLog* log)
+{
+    DeferredObjectLog* next = m_deferredObjectLogs.load(std::memory_order_relaxed);
+    do {
+        log->next = next;
+    } while (!m_deferredObjectLogs.compare_exchange_weak(next, log, std::memory_order_release, std::memory_order_relaxed));
+}
+
+void Heap::processDeferredObjectLogs(std::lock_guard<StaticMutex>& lock)
+{
+    // Only lock holders take logs, and they take all of them at once, so the stack is safe from ABA.
+    DeferredObjectLog* log = m_deferredObjectLogs.exchange(nullptr, std::memory_order_acquire);
+    while (log) {
+        DeferredObjectLog* next = log->next;
+        ++m_statistics.deferredObjectLogs;
+        derefObjects(lock, log->objects);
+        log->objects.clear();
+        log->isPending.store(false, std::memory_order_release);
+        log = next;
+    }
+}
+
+void Heap::setFootprintTarget(std::lock_guard<StaticMutex>&, size_t footprintTarget)
+{
+    m_footprintTarget = footprintTarget;
+    m_scavenger.run();
+}
+
+void Heap::setIsUnderMemoryPressure(std::lock_guard<StaticMutex>&, bool isUnderMemoryPressure)
+{
+    m_isUnderMemoryPressure = isUnderMemoryPressure;
+    if (m_isUnderMemoryPressure)
+        m_scavenger.run();
+}
+
 void Heap::concurrentScavenge()
 {
-    std::unique_lock<StaticMutex> lock(PerProcess<Heap>::mutex());
-    scavenge(lock, scavengeSleepDuration);
+    std::unique_lock<StaticMutex> lock(m_mutex);
+
+    // Under memory pressure, don't wait for allocation to quiesce before releasing pages.
+    scavenge(lock, m_isUnderMemoryPressure ? std::chrono::milliseconds(0) : scavengeSleepDuration);
 }
 
 void Heap::scavenge(std::unique_lock<StaticMutex>& lock, std::chrono::milliseconds sleepDuration)
 {
     waitUntilFalse(lock, sleepDuration, m_isAllocatingPages);
 
-    scavengeSmallPages(lock, sleepDuration);
-    scavengeMediumPages(lock, sleepDuration);
-    scavengeLargeObjects(lock, sleepDuration);
+    size_t footprintTarget = m_footprintTarget;
+    if (sleepDuration == std::chrono::milliseconds(0) || m_isUnderMemoryPressure)
+        footprintTarget = 0;
+
+    scavengeSmallPages(lock, sleepDuration, footprintTarget);
+    scavengeMediumPages(lock, sleepDuration, footprintTarget);
+    scavengeLargeObjects(lock, sleepDuration, footprintTarget);
 
     sleep(lock, sleepDuration);
 }
 
-void Heap::scavengeSmallPages(std::unique_lock<StaticMutex>& lock, std::chrono::milliseconds sleepDuration)
+void Heap::scavengeSmallPages(std::unique_lock<StaticMutex>& lock, std::chrono::milliseconds sleepDuration, size_t footprintTarget)
 {
-    while (m_smallPages.size()) {
-        m_vmHeap.deallocateSmallPage(lock, m_smallPages.pop());
+    while (m_smallPages.size() && m_footprint > footprintTarget) {
+        FixedVector<SmallPage*, scavengeBatchSize> pages;
+        while (m_smallPages.size() && m_footprint > footprintTarget && pages.size() < pages.capacity()) {
+            pages.push(m_smallPages.pop());
+            m_footprint -= vmPageSize;
+        }
+
+        m_statistics.scavengedBytes += pages.size() * vmPageSize;
+        m_vmHeap.deallocateSmallPages(lock, pages);
         waitUntilFalse(lock, sleepDuration, m_isAllocatingPages);
     }
 }
 
-void Heap::scavengeMediumPages(std::unique_lock<StaticMutex>& lock, std::chrono::milliseconds sleepDuration)
+void Heap::scavengeMediumPages(std::unique_lock<StaticMutex>& lock, std::chrono::milliseconds sleepDuration, size_t footprintTarget)
 {
-    while (m_mediumPages.size()) {
-        m_vmHeap.deallocateMediumPage(lock, m_mediumPages.pop());
+    while (m_mediumPages.size() && m_footprint > footprintTarget) {
+        FixedVector<MediumPage*, scavengeBatchSize> pages;
+        while (m_mediumPages.size() && m_footprint > footprintTarget && pages.size() < pages.capacity()) {
+            pages.push(m_mediumPages.pop());
+            m_footprint -= vmPageSize;
+        }
+
+        m_statistics.scavengedBytes += pages.size() * vmPageSize;
+        m_vmHeap.deallocateMediumPages(lock, pages);
         waitUntilFalse(lock, sleepDuration, m_isAllocatingPages);
     }
 }
 
-void Heap::scavengeLargeObjects(std::unique_lock<StaticMutex>& lock, std::chrono::milliseconds sleepDuration)
+void Heap::scavengeLargeObjects(std::unique_lock<StaticMutex>& lock, std::chrono::milliseconds sleepDuration, size_t footprintTarget)
 {
-    while (LargeObject largeObject = m_largeObjects.takeGreedy()) {
+    while (m_footprint > footprintTarget) {
+        LargeObject largeObject = m_largeObjects.takeGreedy();
+        if (!largeObject)
+            break;
+
+        m_footprint -= std::min(m_footprint, largeObject.size());
+        m_statistics.scavengedBytes += largeObject.size();
         m_vmHeap.deallocateLargeObject(lock, largeObject);
         waitUntilFalse(lock, sleepDuration, m_isAllocatingPages);
     }
@@ -123,6 +225,7 @@ void Heap::scavengeLargeObjects(std::unique_lock<StaticMutex>& lock, std::chrono
 void Heap::allocateSmallBumpRanges(std::lock_guard<StaticMutex>& lock, size_t sizeClass, BumpAllocator& allocator, BumpRangeCache& rangeCache)
 {
     BASSERT(!rangeCache.size());
+    ++m_statistics.bumpRangeRefills;
     SmallPage* page = allocateSmallPage(lock, sizeClass);
     SmallLine* lines = page->begin();
 
@@ -168,6 +271,7 @@ void Heap::allocateSmallBumpRanges(std::lock_guard<StaticMutex>& lock, size_t si
 
 void Heap::allocateMediumBumpRanges(std::lock_guard<StaticMutex>& lock, size_t sizeClass, BumpAllocator& allocator, BumpRangeCache& rangeCache)
 {
+    ++m_statistics.bumpRangeRefills;
     MediumPage* page = allocateMediumPage(lock, sizeClass);
     BASSERT(!rangeCache.size());
     MediumLine* lines = page->begin();
@@ -227,6 +331,7 @@ SmallPage* Heap::allocateSmallPage(std::lock_guard<StaticMutex>& lock, size_t si
             return m_smallPages.pop();
 
         m_isAllocatingPages = true;
+        m_footprint += vmPageSize;
         return m_vmHeap.allocateSmallPage();
     }();
 
@@ -249,6 +354,7 @@ MediumPage* Heap::allocateMediumPage(std::lock_guard<StaticMutex>& lock, size_t
             return m_mediumPages.pop();
 
         m_isAllocatingPages = true;
+        m_footprint += vmPageSize;
         return m_vmHeap.allocateMediumPage();
     }();
 
@@ -370,6 +476,7 @@ void* Heap::allocateLarge(std::lock_guard<StaticMutex>& lock, size_t size)
     if (!largeObject) {
         m_isAllocatingPages = true;
         largeObject = m_vmHeap.allocateLargeObject(size);
+        m_footprint += largeObject.size();
     }
 
     return allocateLarge(lock, largeObject, size);
@@ -391,6 +498,7 @@ void* Heap::allocateLarge(std::lock_guard<StaticMutex>& lock, size_t alignment,
     if (!largeObject) {
         m_isAllocatingPages = true;
         largeObject = m_vmHeap.allocateLargeObject(alignment, size, unalignedSize);
+        m_footprint += largeObject.size();
     }
 
     size_t alignmentMask = alignment - 1;
@@ -28,15 +28,18 @@
 
 #include "BumpRange.h"
 #include "Environment.h"
+#include "FixedVector.h"
 #include "LineMetadata.h"
 #include "MediumChunk.h"
 #include "MediumLine.h"
 #include "MediumPage.h"
 #include "Mutex.h"
+#include "PerProcess.h"
 #include "SegregatedFreeList.h"
 #include "SmallChunk.h"
 #include "SmallLine.h"
 #include "SmallPage.h"
+#include "Statistics.h"
 #include "VMHeap.h"
 #include "Vector.h"
 #include <array>
@@ -47,13 +50,35 @@ namespace bmalloc {
 class BeginTag;
 class BumpAllocator;
 class EndTag;
+struct DeferredObjectLog;
 
 class Heap {
 public:
-    Heap(std::lock_guard<StaticMutex>&);
+    // The heap is guarded by the mutex the lock holds: PerProcess<Heap>::mutex() for the
+    // primary heap, or the isolated heap's own mutex.
+    Heap(std::lock_guard<StaticMutex>&, StaticMutex& = PerProcess<Heap>::mutex());
     
+    StaticMutex& mutex() { return m_mutex; }
     Environment& environment() { return m_environment; }
 
+    // Requests up to smallSizeLimit(lock) bytes use small pages, and larger requests up to
+    // mediumMax use medium pages. The boundary can be lowered from its default of
+    // Sizes::smallMax at any time. Already allocated objects, and ranges already handed to
+    // thread caches, are unaffected.
+    size_t smallSizeLimit(std::lock_guard<StaticMutex>&) { return m_smallSizeLimit; }
+    void setSmallSizeLimit(std::lock_guard<StaticMutex>&, size_t);
+
+    void didFlushObjectLog(std::lock_guard<StaticMutex>&) { ++m_statistics.objectLogFlushes; }
+
+    // Releases a deallocator's logged small and medium objects.
+    void derefObjects(std::lock_guard<StaticMutex>&, const FixedVector<void*, deallocatorLogCapacity>&);
+
+    // Deferring an object log does not take the heap lock. Deferred logs are processed
+    // by the next caller of processDeferredObjectLogs.
+    void deferObjectLog(DeferredObjectLog*);
+    void processDeferredObjectLogs(std::lock_guard<StaticMutex>&);
+    HeapStatistics statistics(std::lock_guard<StaticMutex>&);
+
     void allocateSmallBumpRanges(std::lock_guard<StaticMutex>&, size_t sizeClass, BumpAllocator&, BumpRangeCache&);
     void derefSmallLine(std::lock_guard<StaticMutex>&, SmallLine*);
 
@@ -70,8 +95,15 @@ public:
     Range& findXLarge(std::unique_lock<StaticMutex>&, void*);
     void deallocateXLarge(std::unique_lock<StaticMutex>&, void*);
 
+    // An explicit scavenge, with a sleep duration of 0, releases all free pages. The
+    // background scavenger only releases free pages while the footprint is above the
+    // footprint target, or all of them while the process is under memory pressure.
     void scavenge(std::unique_lock<StaticMutex>&, std::chrono::milliseconds sleepDuration);
 
+    size_t footprintTarget(std::lock_guard<StaticMutex>&) { return m_footprintTarget; }
+    void setFootprintTarget(std::lock_guard<StaticMutex>&, size_t);
+    void setIsUnderMemoryPressure(std::lock_guard<StaticMutex>&, bool);
+
 private:
     ~Heap() = delete;
     
@@ -92,9 +124,11 @@ private:
     void mergeLargeRight(EndTag*&, BeginTag*&, Range&, bool& inVMHeap);
     
     void concurrentScavenge();
-    void scavengeSmallPages(std::unique_lock<StaticMutex>&, std::chrono::milliseconds);
-    void scavengeMediumPages(std::unique_lock<StaticMutex>&, std::chrono::milliseconds);
-    void scavengeLargeObjects(std::unique_lock<StaticMutex>&, std::chrono::milliseconds);
+    void scavengeSmallPages(std::unique_lock<StaticMutex>&, std::chrono::milliseconds, size_t footprintTarget);
+    void scavengeMediumPages(std::unique_lock<StaticMutex>&, std::chrono::milliseconds, size_t footprintTarget);
+    void scavengeLargeObjects(std::unique_lock<StaticMutex>&, std::chrono::milliseconds, size_t footprintTarget);
+
+    StaticMutex& m_mutex;
 
     std::array<std::array<LineMetadata, SmallPage::lineCount>, smallMax / alignment> m_smallLineMetadata;
     std::array<std::array<LineMetadata, MediumPage::lineCount>, mediumMax / alignment> m_mediumLineMetadata;
@@ -114,6 +148,13 @@ private:
     Environment m_environment;
 
     VMHeap m_vmHeap;
+
+    size_t m_smallSizeLimit;
+    size_t m_footprint;
+    size_t m_footprintTarget;
+    bool m_isUnderMemoryPressure;
+    std::atomic<DeferredObjectLog*> m_deferredObjectLogs;
+    HeapStatistics m_statistics;
 };
 
 inline void Heap::derefSmallLine(std::lock_guard<StaticMutex>& lock, SmallLine* line)
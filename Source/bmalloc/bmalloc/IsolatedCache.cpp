@@ -0,0 +1,77 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "IsolatedCache.h"
+#include "Heap.h"
+#include "Inline.h"
+#include "IsolatedHeaps.h"
+#include "PerProcess.h"
+
+namespace bmalloc {
+
+void* IsolatedCache::operator new(size_t size)
+{
+    return vmAllocate(vmSize(size));
+}
+
+void IsolatedCache::operator delete(void* p, size_t size)
+{
+    vmDeallocate(p, vmSize(size));
+}
+
+IsolatedCache::IsolatedCache()
+{
+    m_caches.fill(nullptr);
+}
+
+IsolatedCache::~IsolatedCache()
+{
+    for (Cache* cache : m_caches)
+        delete cache;
+}
+
+void IsolatedCache::scavenge()
+{
+    IsolatedCache* isolatedCache = PerThread<IsolatedCache>::getFastCase();
+    if (!isolatedCache)
+        return;
+
+    for (Cache* cache : isolatedCache->m_caches) {
+        if (!cache)
+            continue;
+        cache->allocator().scavenge();
+        cache->deallocator().scavenge();
+    }
+}
+
+NO_INLINE Cache* IsolatedCache::cacheSlowCase(size_t heap)
+{
+    IsolatedCache* isolatedCache = PerThread<IsolatedCache>::get();
+    if (!isolatedCache->m_caches[heap])
+        isolatedCache->m_caches[heap] = new Cache(PerProcess<IsolatedHeaps>::get()->heap(heap));
+    return isolatedCache->m_caches[heap];
+}
+
+} // namespace bmalloc
@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef IsolatedCache_h
+#define IsolatedCache_h
+
+#include "Cache.h"
+#include "PerThread.h"
+#include "Sizes.h"
+#include <array>
+
+namespace bmalloc {
+
+// Per-thread allocation / deallocation caches for the isolated heaps, created on
+// first use of each heap. Memory must be deallocated through the heap it came from.
+
+class IsolatedCache {
+public:
+    void* operator new(size_t);
+    void operator delete(void*, size_t);
+
+    static void* tryAllocate(size_t heap, size_t);
+    static void* allocate(size_t heap, size_t);
+    static void deallocate(size_t heap, void*);
+
+    static void scavenge();
+
+    IsolatedCache();
+    ~IsolatedCache();
+
+private:
+    static Cache* cache(size_t heap);
+    static Cache* cacheSlowCase(size_t heap);
+
+    std::array<Cache*, isolatedHeapCount> m_caches;
+};
+
+inline Cache* IsolatedCache::cache(size_t heap)
+{
+    BASSERT(heap < isolatedHeapCount);
+    IsolatedCache* isolatedCache = PerThread<IsolatedCache>::getFastCase();
+    if (!isolatedCache || !isolatedCache->m_caches[heap])
+        return cacheSlowCase(heap);
+    return isolatedCache->m_caches[heap];
+}
+
+inline void* IsolatedCache::tryAllocate(size_t heap, size_t size)
+{
+    return cache(heap)->allocator().tryAllocate(size);
+}
+
+inline void* IsolatedCache::allocate(size_t heap, size_t size)
+{
+    return cache(heap)->allocator().allocate(size);
+}
+
+inline void IsolatedCache::deallocate(size_t heap, void* object)
+{
+    cache(heap)->deallocator().deallocate(object);
+}
+
+} // namespace bmalloc
+
+#endif // IsolatedCache_h
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef IsolatedHeaps_h
+#define IsolatedHeaps_h
+
+#include "Mutex.h"
+#include "Sizes.h"
+#include <array>
+#include <atomic>
+#include <mutex>
+
+namespace bmalloc {
+
+class Heap;
+
+// Heaps that are isolated from the primary heap and from each other. Each one has
+// its own VM, pages and scavenger, so objects from one heap never share a page with
+// objects from another, and each heap can be scavenged and measured on its own.
+// Isolated heaps are identified by index and created on first use.
+
+class IsolatedHeaps {
+public:
+    IsolatedHeaps(std::lock_guard<StaticMutex>&);
+
+    Heap* heap(size_t index);
+    Heap* heapIfExists(size_t index);
+
+private:
+    Heap* heapSlowCase(size_t index);
+
+    std::array<Mutex, isolatedHeapCount> m_mutexes;
+    std::array<std::atomic<Heap*>, isolatedHeapCount> m_heaps;
+};
+
+inline Heap* IsolatedHeaps::heapIfExists(size_t index)
+{
+    BASSERT(index < isolatedHeapCount);
+    return m_heaps[index].load(std::memory_order_consume);
+}
+
+inline Heap* IsolatedHeaps::heap(size_t index)
+{
+    Heap* heap = heapIfExists(index);
+    if (!heap)
+        return heapSlowCase(index);
+    return heap;
+}
+
+} // namespace bmalloc
+
+#endif // IsolatedHeaps_h
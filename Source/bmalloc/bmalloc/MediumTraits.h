@@ -41,7 +41,7 @@ struct MediumTraits {
     typedef Page<MediumTraits> PageType;
 
     static const size_t lineSize = mediumLineSize;
-    static const size_t minimumObjectSize = smallMax + alignment;
+    static const size_t minimumObjectSize = alignment; // The small / medium boundary is tunable.
     static const size_t chunkSize = mediumChunkSize;
     static const size_t chunkOffset = mediumChunkOffset;
     static const uintptr_t chunkMask = mediumChunkMask;
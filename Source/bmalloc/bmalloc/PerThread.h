@@ -61,10 +61,12 @@ private:
 #if HAVE_PTHREAD_MACHDEP_H
 
 class Cache;
+class IsolatedCache;
+class TraceThread;
 template<typename T> struct PerThreadStorage;
 
-// For now, we only support PerThread<Cache>. We can expand to other types by
-// using more keys.
+// For now, we only support PerThread<Cache>, PerThread<IsolatedCache> and, in tracing
+// builds, PerThread<TraceThread>. We can expand to other types by using more keys.
 template<> struct PerThreadStorage<Cache> {
     static const pthread_key_t key = __PTK_FRAMEWORK_JAVASCRIPTCORE_KEY0;
 
@@ -80,6 +82,36 @@ template<> struct PerThreadStorage<Cache> {
     }
 };
 
+template<> struct PerThreadStorage<IsolatedCache> {
+    static const pthread_key_t key = __PTK_FRAMEWORK_JAVASCRIPTCORE_KEY1;
+
+    static void* get()
+    {
+        return _pthread_getspecific_direct(key);
+    }
+
+    static void init(void* object, void (*destructor)(void*))
+    {
+        _pthread_setspecific_direct(key, object);
+        pthread_key_init_np(key, destructor);
+    }
+};
+
+template<> struct PerThreadStorage<TraceThread> {
+    static const pthread_key_t key = __PTK_FRAMEWORK_JAVASCRIPTCORE_KEY2;
+
+    static void* get()
+    {
+        return _pthread_getspecific_direct(key);
+    }
+
+    static void init(void* object, void (*destructor)(void*))
+    {
+        _pthread_setspecific_direct(key, object);
+        pthread_key_init_np(key, destructor);
+    }
+};
+
 #else
 
 template<typename T> struct PerThreadStorage {
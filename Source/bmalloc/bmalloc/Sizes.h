@@ -52,8 +52,10 @@ namespace Sizes {
     static const size_t vmPageSize = 4 * kB;
 #endif
     static const size_t vmPageMask = ~(vmPageSize - 1);
+    static const size_t vmNodeLimit = 16; // Higher NUMA nodes share free lists with lower ones.
     
     static const size_t superChunkSize = 4 * MB;
+    static const size_t superChunkMask = ~(superChunkSize - 1ul);
 
     static const size_t smallMax = 256;
     static const size_t smallLineSize = 256;
@@ -93,9 +95,11 @@ namespace Sizes {
     static const uintptr_t smallOrMediumSmallTypeMask = smallType ^ mediumType; // Only valid if object is known to be small or medium.
 
     static const size_t deallocatorLogCapacity = 256;
+    static const size_t isolatedHeapCount = 8;
     static const size_t bumpRangeCacheCapacity = 3;
     
     static const std::chrono::milliseconds scavengeSleepDuration = std::chrono::milliseconds(512);
+    static const size_t scavengeBatchSize = 16; // Pages decommitted each time the scavenger drops the heap lock.
 
     inline size_t sizeClass(size_t size)
     {
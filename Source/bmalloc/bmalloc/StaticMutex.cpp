@@ -32,6 +32,7 @@ void StaticMutex::lockSlowCase()
 {
     while (!try_lock())
         std::this_thread::yield();
+    ++m_contendedAcquisitionCount;
 }
 
 } // namespace bmalloc
@@ -28,6 +28,7 @@
 
 #include "BAssert.h"
 #include <atomic>
+#include <cstddef>
 #include <mutex>
 #include <thread>
 
@@ -48,10 +49,16 @@ public:
     bool try_lock();
     void unlock();
 
+    // These counts may only be read while holding the lock.
+    size_t acquisitionCount() const { return m_acquisitionCount; }
+    size_t contendedAcquisitionCount() const { return m_contendedAcquisitionCount; }
+
 private:
     void lockSlowCase();
 
     std::atomic_flag m_flag;
+    size_t m_acquisitionCount;
+    size_t m_contendedAcquisitionCount;
 };
 
 static inline void sleep(
@@ -78,6 +85,8 @@ static inline void waitUntilFalse(
 inline void StaticMutex::init()
 {
     m_flag.clear();
+    m_acquisitionCount = 0;
+    m_contendedAcquisitionCount = 0;
 }
 
 inline bool StaticMutex::try_lock()
@@ -89,6 +98,7 @@ inline void StaticMutex::lock()
 {
     if (!try_lock())
         lockSlowCase();
+    ++m_acquisitionCount;
 }
 
 inline void StaticMutex::unlock()
@@ -0,0 +1,57 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef Statistics_h
+#define Statistics_h
+
+#include <cstddef>
+
+namespace bmalloc {
+
+// Counters for tuning the allocator. Heap statistics cover the whole process, while
+// thread cache statistics only describe the calling thread's cache.
+
+struct HeapStatistics {
+    size_t lockAcquisitions;
+    size_t contendedLockAcquisitions;
+    size_t bumpRangeRefills; // Refills of a thread cache's bump allocators that had to come from the heap.
+    size_t objectLogFlushes;
+    size_t deferredObjectLogs; // Object logs that were flushed without waiting for the heap lock.
+    size_t scavengedBytes;
+    size_t footprint; // Committed bytes in small, medium and large pages, whether in use or free.
+};
+
+struct ThreadCacheStatistics {
+    size_t bumpAllocatorBytes; // Free bytes left in this thread's bump allocators.
+    size_t bumpRangeCacheBytes; // Free bytes held in this thread's bump range caches.
+    size_t bumpRangeCacheRefills; // Refills served by the bump range cache without taking the heap lock.
+    size_t heapRefills;
+    size_t objectLogSize;
+    size_t objectLogFlushes;
+};
+
+} // namespace bmalloc
+
+#endif // Statistics_h
@@ -34,7 +34,10 @@ namespace bmalloc {
 
 class SuperChunk {
 public:
-    static SuperChunk* create();
+    static SuperChunk* create(unsigned node);
+    static SuperChunk* get(void*);
+
+    unsigned node();
 
     SmallChunk* smallChunk();
     MediumChunk* mediumChunk();
@@ -44,10 +47,22 @@ private:
     SuperChunk();
 };
 
-inline SuperChunk* SuperChunk::create()
+inline SuperChunk* SuperChunk::create(unsigned node)
 {
     void* result = static_cast<char*>(vmAllocate(superChunkSize, superChunkSize));
-    return new (result) SuperChunk;
+    SuperChunk* superChunk = new (result) SuperChunk;
+    superChunk->smallChunk()->setNode(node);
+    return superChunk;
+}
+
+inline SuperChunk* SuperChunk::get(void* object)
+{
+    return static_cast<SuperChunk*>(mask(object, superChunkMask));
+}
+
+inline unsigned SuperChunk::node()
+{
+    return smallChunk()->node();
 }
 
 inline SuperChunk::SuperChunk()
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "Trace.h"
+#include "VMAllocate.h"
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace bmalloc {
+
+void* TraceThread::operator new(size_t size)
+{
+    return vmAllocate(vmSize(size));
+}
+
+void TraceThread::operator delete(void* p, size_t size)
+{
+    vmDeallocate(p, vmSize(size));
+}
+
+TraceThread::TraceThread()
+    : m_index(PerProcess<Trace>::get()->m_threadCount++)
+{
+}
+
+Trace::Trace(std::lock_guard<StaticMutex>&)
+    : m_fd(-1)
+    , m_threadCount(0)
+{
+    const char* fileName = getenv("BMALLOC_TRACE_FILE");
+    if (!fileName)
+        return;
+
+    m_fd = open(fileName, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (m_fd == -1)
+        return;
+
+    if (write(m_fd, traceMagic, sizeof(traceMagic)) != sizeof(traceMagic)) {
+        close(m_fd);
+        m_fd = -1;
+        return;
+    }
+
+    atexit(flushAtExit);
+}
+
+void Trace::append(std::lock_guard<StaticMutex>& lock, const TraceRecord& record)
+{
+    if (m_fd == -1)
+        return;
+
+    m_records.push(record);
+    if (m_records.size() == m_records.capacity())
+        flush(lock);
+}
+
+void Trace::flush(std::lock_guard<StaticMutex>&)
+{
+    const char* data = reinterpret_cast<const char*>(m_records.begin());
+    size_t size = m_records.size() * sizeof(TraceRecord);
+    while (size) {
+        ssize_t written = write(m_fd, data, size);
+        if (written == -1 && errno == EINTR)
+            continue;
+        if (written <= 0) {
+            // Stop recording rather than write a trace with holes in it.
+            close(m_fd);
+            m_fd = -1;
+            break;
+        }
+        data += written;
+        size -= written;
+    }
+
+    m_records.clear();
+}
+
+void Trace::flushAtExit()
+{
+    Trace* trace = PerProcess<Trace>::get();
+    std::lock_guard<StaticMutex> lock(PerProcess<Trace>::mutex());
+    if (trace->m_fd == -1)
+        return;
+
+    trace->flush(lock);
+    if (trace->m_fd != -1)
+        fsync(trace->m_fd);
+}
+
+} // namespace bmalloc
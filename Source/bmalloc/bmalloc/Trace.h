@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#ifndef Trace_h
+#define Trace_h
+
+#include "FixedVector.h"
+#include "PerProcess.h"
+#include "PerThread.h"
+#include "StaticMutex.h"
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+// Builds that define BMALLOC_TRACE to 1 record every bmalloc::api allocation and
+// deallocation to the file named by the BMALLOC_TRACE_FILE environment variable, so
+// that MallocBench's Interpreter can replay a real workload. Recording serializes
+// allocation, so it is only meant for capturing traces.
+#ifndef BMALLOC_TRACE
+#define BMALLOC_TRACE 0
+#endif
+
+namespace bmalloc {
+
+// A trace file is traceMagic followed by TraceRecords in the order they happened.
+// Keep this layout in sync with MallocBench's Interpreter.
+
+static const char traceMagic[8] = { 'b', 'm', 't', 'r', 'a', 'c', 'e', '1' };
+
+struct TraceRecord {
+    enum Opcode : uint32_t { Malloc, Free, Realloc };
+
+    uint32_t opcode;
+    uint32_t thread; // Numbered in order of each thread's first allocation or deallocation.
+    uint64_t size;
+    uint64_t object; // The result of Malloc and Realloc, or the argument to Free.
+    uint64_t oldObject; // The argument to Realloc.
+};
+
+class TraceThread {
+public:
+    void* operator new(size_t);
+    void operator delete(void*, size_t);
+
+    TraceThread();
+
+    uint32_t index() { return m_index; }
+
+private:
+    uint32_t m_index;
+};
+
+class Trace {
+public:
+    Trace(std::lock_guard<StaticMutex>&);
+
+    static void recordMalloc(void* object, size_t);
+    static void recordFree(void* object);
+
+    // Reallocates while holding the trace lock, so no other thread can record an
+    // allocation that reuses the old object before the reallocation is recorded.
+    template<typename Function> static void* reallocate(void* oldObject, size_t, Function);
+
+private:
+    friend class TraceThread;
+
+    static uint32_t currentThread();
+
+    void append(std::lock_guard<StaticMutex>&, const TraceRecord&);
+    void flush(std::lock_guard<StaticMutex>&);
+    static void flushAtExit();
+
+    int m_fd;
+    std::atomic<uint32_t> m_threadCount;
+    FixedVector<TraceRecord, 4096> m_records;
+};
+
+inline uint32_t Trace::currentThread()
+{
+    return PerThread<TraceThread>::get()->index();
+}
+
+inline void Trace::recordMalloc(void* object, size_t size)
+{
+    uint32_t thread = currentThread();
+    Trace* trace = PerProcess<Trace>::get();
+    std::lock_guard<StaticMutex> lock(PerProcess<Trace>::mutex());
+    trace->append(lock, { TraceRecord::Malloc, thread, size, reinterpret_cast<uintptr_t>(object), 0 });
+}
+
+inline void Trace::recordFree(void* object)
+{
+    uint32_t thread = currentThread();
+    Trace* trace = PerProcess<Trace>::get();
+    std::lock_guard<StaticMutex> lock(PerProcess<Trace>::mutex());
+    trace->append(lock, { TraceRecord::Free, thread, 0, reinterpret_cast<uintptr_t>(object), 0 });
+}
+
+template<typename Function>
+inline void* Trace::reallocate(void* oldObject, size_t size, Function function)
+{
+    uint32_t thread = currentThread();
+    Trace* trace = PerProcess<Trace>::get();
+    std::lock_guard<StaticMutex> lock(PerProcess<Trace>::mutex());
+    void* object = function(oldObject, size);
+    trace->append(lock, { TraceRecord::Realloc, thread, size, reinterpret_cast<uintptr_t>(object), reinterpret_cast<uintptr_t>(oldObject) });
+    return object;
+}
+
+} // namespace bmalloc
+
+#endif // Trace_h
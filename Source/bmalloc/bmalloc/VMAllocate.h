@@ -34,6 +34,11 @@
 #include <sys/mman.h>
 #include <unistd.h>
 
+#if BOS(LINUX)
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#endif
+
 #if BOS(DARWIN)
 #include <mach/vm_statistics.h>
 #endif
@@ -148,6 +153,50 @@ inline void vmAllocatePhysicalPages(void* p, size_t vmSize)
 #endif
 }
 
+// Asks the OS to back [p, p + vmSize) with transparent huge pages. Splitting a
+// huge page by deallocating part of it returns the region to small pages.
+inline void vmAllocateHugePages(void* p, size_t vmSize)
+{
+    vmValidate(p, vmSize);
+#if BOS(LINUX) && defined(MADV_HUGEPAGE)
+    madvise(p, vmSize, MADV_HUGEPAGE);
+#else
+    UNUSED(p);
+#endif
+}
+
+// Prefers physical pages from NUMA node |node| when faulting in [p, p + vmSize).
+inline void vmBindToNode(void* p, size_t vmSize, unsigned node)
+{
+    vmValidate(p, vmSize);
+#if BOS(LINUX) && defined(SYS_mbind)
+    if (node >= vmNodeLimit)
+        return;
+
+    const size_t bitsPerLong = sizeof(unsigned long) * 8;
+    unsigned long nodeMask[vmNodeLimit / bitsPerLong + 1] = { };
+    nodeMask[node / bitsPerLong] = 1ul << (node % bitsPerLong);
+    syscall(SYS_mbind, p, vmSize, MPOL_PREFERRED, nodeMask, vmNodeLimit + 1, 0);
+#else
+    UNUSED(p);
+    UNUSED(node);
+#endif
+}
+
+// Returns the NUMA node of the CPU the calling thread is running on, or 0 if unknown.
+inline unsigned vmCurrentNode()
+{
+#if BOS(LINUX) && defined(SYS_getcpu)
+    unsigned cpu;
+    unsigned node;
+    if (syscall(SYS_getcpu, &cpu, &node, nullptr) == -1)
+        return 0;
+    return node;
+#else
+    return 0;
+#endif
+}
+
 // Trims requests that are un-page-aligned.
 inline void vmDeallocatePhysicalPagesSloppy(void* p, size_t size)
 {
@@ -23,6 +23,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
  */
 
+#include "Environment.h"
 #include "LargeObject.h"
 #include "Line.h"
 #include "PerProcess.h"
@@ -32,28 +33,45 @@
 
 namespace bmalloc {
 
-VMHeap::VMHeap()
-    : m_largeObjects(Owner::VMHeap)
+VMHeap::Node::Node()
+    : largeObjects(Owner::VMHeap)
 {
 }
 
-void VMHeap::grow()
+VMHeap::VMHeap(Environment& environment)
+    : m_usesHugePages(environment.usesHugePages())
+    , m_isNUMAAware(environment.isNUMAAware())
 {
-    SuperChunk* superChunk = SuperChunk::create();
+}
+
+void VMHeap::grow(unsigned node)
+{
+    SuperChunk* superChunk = SuperChunk::create(node);
 #if BOS(DARWIN)
     m_zone.addSuperChunk(superChunk);
 #endif
 
+    // Super chunks are aligned to their size, which is a multiple of the 2MB
+    // huge page size, so the whole chunk can be huge page backed.
+    if (m_usesHugePages)
+        vmAllocateHugePages(superChunk, superChunkSize);
+
+    // Linux places pages on the node that first touches them, but pages we
+    // scavenge are faulted back in by whichever thread touches them next.
+    // Binding keeps them on the node whose free lists they return to.
+    if (m_isNUMAAware)
+        vmBindToNode(superChunk, superChunkSize, node);
+
     SmallChunk* smallChunk = superChunk->smallChunk();
     for (auto* it = smallChunk->begin(); it != smallChunk->end(); ++it)
-        m_smallPages.push(it);
+        m_nodes[node].smallPages.push(it);
 
     MediumChunk* mediumChunk = superChunk->mediumChunk();
     for (auto* it = mediumChunk->begin(); it != mediumChunk->end(); ++it)
-        m_mediumPages.push(it);
+        m_nodes[node].mediumPages.push(it);
 
     LargeChunk* largeChunk = superChunk->largeChunk();
-    m_largeObjects.insert(LargeObject(LargeObject::init(largeChunk).begin()));
+    m_nodes[node].largeObjects.insert(LargeObject(LargeObject::init(largeChunk).begin()));
 }
 
 } // namespace bmalloc
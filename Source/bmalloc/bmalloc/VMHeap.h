@@ -34,7 +34,9 @@
 #include "Range.h"
 #include "SegregatedFreeList.h"
 #include "SmallChunk.h"
+#include "SuperChunk.h"
 #include "Vector.h"
+#include <array>
 #if BOS(DARWIN)
 #include "Zone.h"
 #endif
@@ -43,62 +45,82 @@ namespace bmalloc {
 
 class BeginTag;
 class EndTag;
+class Environment;
 class Heap;
-class SuperChunk;
 
 class VMHeap {
 public:
-    VMHeap();
+    VMHeap(Environment&);
 
     SmallPage* allocateSmallPage();
     MediumPage* allocateMediumPage();
     LargeObject allocateLargeObject(size_t);
     LargeObject allocateLargeObject(size_t alignment, size_t, size_t unalignedSize);
 
-    void deallocateSmallPage(std::unique_lock<StaticMutex>&, SmallPage*);
-    void deallocateMediumPage(std::unique_lock<StaticMutex>&, MediumPage*);
+    void deallocateSmallPages(std::unique_lock<StaticMutex>&, FixedVector<SmallPage*, scavengeBatchSize>&);
+    void deallocateMediumPages(std::unique_lock<StaticMutex>&, FixedVector<MediumPage*, scavengeBatchSize>&);
     void deallocateLargeObject(std::unique_lock<StaticMutex>&, LargeObject&);
 
 private:
-    LargeObject allocateLargeObject(LargeObject&, size_t);
-    void grow();
-
-    Vector<SmallPage*> m_smallPages;
-    Vector<MediumPage*> m_mediumPages;
-    SegregatedFreeList m_largeObjects;
+    // Pages and large objects carved from super chunks that were grown on one
+    // NUMA node. Without NUMA awareness, everything lives in node 0.
+    struct Node {
+        Node();
+
+        Vector<SmallPage*> smallPages;
+        Vector<MediumPage*> mediumPages;
+        SegregatedFreeList largeObjects;
+    };
+
+    unsigned currentNode();
+    LargeObject allocateLargeObject(Node&, LargeObject&, size_t);
+    void grow(unsigned node);
+
+    bool m_usesHugePages;
+    bool m_isNUMAAware;
+    std::array<Node, vmNodeLimit> m_nodes;
 #if BOS(DARWIN)
     Zone m_zone;
 #endif
 };
 
+inline unsigned VMHeap::currentNode()
+{
+    if (!m_isNUMAAware)
+        return 0;
+    return vmCurrentNode() % vmNodeLimit;
+}
+
 inline SmallPage* VMHeap::allocateSmallPage()
 {
-    if (!m_smallPages.size())
-        grow();
+    unsigned node = currentNode();
+    if (!m_nodes[node].smallPages.size())
+        grow(node);
 
-    SmallPage* page = m_smallPages.pop();
+    SmallPage* page = m_nodes[node].smallPages.pop();
     vmAllocatePhysicalPages(page->begin()->begin(), vmPageSize);
     return page;
 }
 
 inline MediumPage* VMHeap::allocateMediumPage()
 {
-    if (!m_mediumPages.size())
-        grow();
+    unsigned node = currentNode();
+    if (!m_nodes[node].mediumPages.size())
+        grow(node);
 
-    MediumPage* page = m_mediumPages.pop();
+    MediumPage* page = m_nodes[node].mediumPages.pop();
     vmAllocatePhysicalPages(page->begin()->begin(), vmPageSize);
     return page;
 }
 
-inline LargeObject VMHeap::allocateLargeObject(LargeObject& largeObject, size_t size)
+inline LargeObject VMHeap::allocateLargeObject(Node& node, LargeObject& largeObject, size_t size)
 {
     BASSERT(largeObject.isFree());
 
     if (largeObject.size() - size > largeMin) {
         std::pair<LargeObject, LargeObject> split = largeObject.split(size);
         largeObject = split.first;
-        m_largeObjects.insert(split.second);
+        node.largeObjects.insert(split.second);
     }
 
     vmAllocatePhysicalPagesSloppy(largeObject.begin(), largeObject.size());
@@ -108,47 +130,53 @@ inline LargeObject VMHeap::allocateLargeObject(LargeObject& largeObject, size_t
 
 inline LargeObject VMHeap::allocateLargeObject(size_t size)
 {
-    LargeObject largeObject = m_largeObjects.take(size);
+    unsigned node = currentNode();
+    LargeObject largeObject = m_nodes[node].largeObjects.take(size);
     if (!largeObject) {
-        grow();
-        largeObject = m_largeObjects.take(size);
+        grow(node);
+        largeObject = m_nodes[node].largeObjects.take(size);
         BASSERT(largeObject);
     }
 
-    return allocateLargeObject(largeObject, size);
+    return allocateLargeObject(m_nodes[node], largeObject, size);
 }
 
 inline LargeObject VMHeap::allocateLargeObject(size_t alignment, size_t size, size_t unalignedSize)
 {
-    LargeObject largeObject = m_largeObjects.take(alignment, size, unalignedSize);
+    unsigned node = currentNode();
+    LargeObject largeObject = m_nodes[node].largeObjects.take(alignment, size, unalignedSize);
     if (!largeObject) {
-        grow();
-        largeObject = m_largeObjects.take(alignment, size, unalignedSize);
+        grow(node);
+        largeObject = m_nodes[node].largeObjects.take(alignment, size, unalignedSize);
         BASSERT(largeObject);
     }
 
     size_t alignmentMask = alignment - 1;
     if (test(largeObject.begin(), alignmentMask))
-        return allocateLargeObject(largeObject, unalignedSize);
-    return allocateLargeObject(largeObject, size);
+        return allocateLargeObject(m_nodes[node], largeObject, unalignedSize);
+    return allocateLargeObject(m_nodes[node], largeObject, size);
 }
 
-inline void VMHeap::deallocateSmallPage(std::unique_lock<StaticMutex>& lock, SmallPage* page)
+inline void VMHeap::deallocateSmallPages(std::unique_lock<StaticMutex>& lock, FixedVector<SmallPage*, scavengeBatchSize>& pages)
 {
     lock.unlock();
-    vmDeallocatePhysicalPages(page->begin()->begin(), vmPageSize);
+    for (SmallPage* page : pages)
+        vmDeallocatePhysicalPages(page->begin()->begin(), vmPageSize);
     lock.lock();
     
-    m_smallPages.push(page);
+    for (SmallPage* page : pages)
+        m_nodes[SuperChunk::get(page)->node()].smallPages.push(page);
 }
 
-inline void VMHeap::deallocateMediumPage(std::unique_lock<StaticMutex>& lock, MediumPage* page)
+inline void VMHeap::deallocateMediumPages(std::unique_lock<StaticMutex>& lock, FixedVector<MediumPage*, scavengeBatchSize>& pages)
 {
     lock.unlock();
-    vmDeallocatePhysicalPages(page->begin()->begin(), vmPageSize);
+    for (MediumPage* page : pages)
+        vmDeallocatePhysicalPages(page->begin()->begin(), vmPageSize);
     lock.lock();
     
-    m_mediumPages.push(page);
+    for (MediumPage* page : pages)
+        m_nodes[SuperChunk::get(page)->node()].mediumPages.push(page);
 }
 
 inline void VMHeap::deallocateLargeObject(std::unique_lock<StaticMutex>& lock, LargeObject& largeObject)
@@ -169,7 +197,7 @@ inline void VMHeap::deallocateLargeObject(std::unique_lock<StaticMutex>& lock, L
 
     merged.setFree(true);
 
-    m_largeObjects.insert(merged);
+    m_nodes[SuperChunk::get(merged.begin())->node()].largeObjects.insert(merged);
 }
 
 } // namespace bmalloc
@@ -25,8 +25,11 @@
 
 #include "Cache.h"
 #include "Heap.h"
+#include "IsolatedCache.h"
+#include "IsolatedHeaps.h"
 #include "PerProcess.h"
 #include "StaticMutex.h"
+#include "Trace.h"
 
 namespace bmalloc {
 namespace api {
@@ -34,43 +37,183 @@ namespace api {
 // Returns null on failure.
 inline void* tryMalloc(size_t size)
 {
-    return Cache::tryAllocate(size);
+    void* object = Cache::tryAllocate(size);
+#if BMALLOC_TRACE
+    if (object)
+        Trace::recordMalloc(object, size);
+#endif
+    return object;
 }
 
 // Crashes on failure.
 inline void* malloc(size_t size)
 {
-    return Cache::allocate(size);
+    void* object = Cache::allocate(size);
+#if BMALLOC_TRACE
+    Trace::recordMalloc(object, size);
+#endif
+    return object;
 }
 
 // Crashes on failure.
 inline void* memalign(size_t alignment, size_t size)
 {
-    return Cache::allocate(alignment, size);
+    void* object = Cache::allocate(alignment, size);
+#if BMALLOC_TRACE
+    Trace::recordMalloc(object, size);
+#endif
+    return object;
 }
 
 // Crashes on failure.
 inline void* realloc(void* object, size_t newSize)
 {
+#if BMALLOC_TRACE
+    return Trace::reallocate(object, newSize, [](void* object, size_t newSize) {
+        return Cache::reallocate(object, newSize);
+    });
+#else
     return Cache::reallocate(object, newSize);
+#endif
 }
 
 inline void free(void* object)
 {
+#if BMALLOC_TRACE
+    // Record before freeing, so the free is ordered before any reuse of the object.
+    if (object)
+        Trace::recordFree(object);
+#endif
     Cache::deallocate(object);
 }
 
+// Isolated heaps keep their own pages and thread caches, so a family of objects
+// allocated from one stays dense and can be scavenged and measured separately.
+// Memory from an isolated heap must be freed with isolatedFree on the same heap.
+// Heaps are numbered from 0 to isolatedHeapCount - 1.
+
+// Returns null on failure.
+inline void* tryIsolatedMalloc(size_t heap, size_t size)
+{
+    void* object = IsolatedCache::tryAllocate(heap, size);
+#if BMALLOC_TRACE
+    if (object)
+        Trace::recordMalloc(object, size);
+#endif
+    return object;
+}
+
+// Crashes on failure.
+inline void* isolatedMalloc(size_t heap, size_t size)
+{
+    void* object = IsolatedCache::allocate(heap, size);
+#if BMALLOC_TRACE
+    Trace::recordMalloc(object, size);
+#endif
+    return object;
+}
+
+inline void isolatedFree(size_t heap, void* object)
+{
+#if BMALLOC_TRACE
+    if (object)
+        Trace::recordFree(object);
+#endif
+    IsolatedCache::deallocate(heap, object);
+}
+
 inline void scavengeThisThread()
 {
     Cache::scavenge();
+    IsolatedCache::scavenge();
 }
 
 inline void scavenge()
 {
     scavengeThisThread();
 
-    std::unique_lock<StaticMutex> lock(PerProcess<Heap>::mutex());
-    PerProcess<Heap>::get()->scavenge(lock, std::chrono::milliseconds(0));
+    {
+        std::unique_lock<StaticMutex> lock(PerProcess<Heap>::mutex());
+        PerProcess<Heap>::get()->scavenge(lock, std::chrono::milliseconds(0));
+    }
+
+    IsolatedHeaps* isolatedHeaps = PerProcess<IsolatedHeaps>::get();
+    for (size_t i = 0; i < isolatedHeapCount; ++i) {
+        Heap* heap = isolatedHeaps->heapIfExists(i);
+        if (!heap)
+            continue;
+        std::unique_lock<StaticMutex> lock(heap->mutex());
+        heap->scavenge(lock, std::chrono::milliseconds(0));
+    }
+}
+
+inline HeapStatistics heapStatistics()
+{
+    Heap* heap = PerProcess<Heap>::get();
+    std::lock_guard<StaticMutex> lock(PerProcess<Heap>::mutex());
+    return heap->statistics(lock);
+}
+
+// Returns all zeroes for an isolated heap that has not been used yet.
+inline HeapStatistics isolatedHeapStatistics(size_t index)
+{
+    Heap* heap = PerProcess<IsolatedHeaps>::get()->heapIfExists(index);
+    if (!heap)
+        return HeapStatistics();
+    std::lock_guard<StaticMutex> lock(heap->mutex());
+    return heap->statistics(lock);
+}
+
+inline ThreadCacheStatistics threadCacheStatistics()
+{
+    ThreadCacheStatistics statistics = ThreadCacheStatistics();
+    Cache::collectStatistics(statistics);
+    return statistics;
+}
+
+inline size_t smallSizeLimit()
+{
+    Heap* heap = PerProcess<Heap>::get();
+    std::lock_guard<StaticMutex> lock(PerProcess<Heap>::mutex());
+    return heap->smallSizeLimit(lock);
+}
+
+// Sets the largest request size that is served from small pages. Sizes are rounded to the
+// allocation granularity and clamped to Sizes::smallMax.
+inline void setSmallSizeLimit(size_t size)
+{
+    Heap* heap = PerProcess<Heap>::get();
+    std::lock_guard<StaticMutex> lock(PerProcess<Heap>::mutex());
+    heap->setSmallSizeLimit(lock, size);
+}
+
+// Sets the footprint the background scavenger decommits free pages down to. A target of 0,
+// the default, releases all free pages. Explicit scavenges always release all free pages.
+inline void setFootprintTarget(size_t footprintTarget)
+{
+    Heap* heap = PerProcess<Heap>::get();
+    std::lock_guard<StaticMutex> lock(PerProcess<Heap>::mutex());
+    heap->setFootprintTarget(lock, footprintTarget);
+}
+
+// While under memory pressure, the background scavengers ignore the footprint target and
+// release free pages without waiting for allocation to quiesce.
+inline void setIsUnderMemoryPressure(bool isUnderMemoryPressure)
+{
+    {
+        Heap* heap = PerProcess<Heap>::get();
+        std::lock_guard<StaticMutex> lock(PerProcess<Heap>::mutex());
+        heap->setIsUnderMemoryPressure(lock, isUnderMemoryPressure);
+    }
+
+    IsolatedHeaps* isolatedHeaps = PerProcess<IsolatedHeaps>::get();
+    for (size_t i = 0; i < isolatedHeapCount; ++i) {
+        Heap* heap = isolatedHeaps->heapIfExists(i);
+        if (!heap)
+            continue;
+        std::lock_guard<StaticMutex> lock(heap->mutex());
+        heap->setIsUnderMemoryPressure(lock, isUnderMemoryPressure);
+    }
 }
 
 } // namespace api
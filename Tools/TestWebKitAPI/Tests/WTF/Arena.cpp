@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+#include "config.h"
+
+#include <wtf/Arena.h>
+#include <wtf/HashMap.h>
+#include <wtf/HashSet.h>
+#include <wtf/Vector.h>
+
+namespace TestWebKitAPI {
+
+TEST(WTF_Arena, Allocate)
+{
+    Arena arena(256);
+    EXPECT_EQ(0u, arena.bytesReserved());
+
+    char* a = static_cast<char*>(arena.allocate(10));
+    char* b = static_cast<char*>(arena.allocate(10));
+    EXPECT_FALSE(reinterpret_cast<uintptr_t>(a) % Arena::alignment);
+    EXPECT_FALSE(reinterpret_cast<uintptr_t>(b) % Arena::alignment);
+    EXPECT_GE(b, a + 10);
+    memset(a, 'a', 10);
+    memset(b, 'b', 10);
+    EXPECT_EQ('a', a[9]);
+
+    size_t reserved = arena.bytesReserved();
+    EXPECT_LE(reserved, 256u);
+
+    // Large allocations get their own chunk.
+    char* large = static_cast<char*>(arena.allocate(1000));
+    memset(large, 'l', 1000);
+    EXPECT_GE(arena.bytesReserved(), reserved + 1000);
+
+    // The current chunk is still used for small allocations.
+    char* c = static_cast<char*>(arena.allocate(10));
+    EXPECT_GE(c, b + 10);
+    EXPECT_LT(c, a + 256);
+
+    arena.clear();
+    EXPECT_EQ(0u, arena.bytesReserved());
+}
+
+TEST(WTF_Arena, DeallocateLast)
+{
+    Arena arena;
+    void* a = arena.allocate(16);
+    void* b = arena.allocate(16);
+    arena.deallocate(a);
+    EXPECT_NE(a, arena.allocate(16));
+    void* c = arena.allocate(16);
+    arena.deallocate(c);
+    EXPECT_EQ(c, arena.allocate(16));
+    EXPECT_NE(b, c);
+}
+
+TEST(WTF_Arena, Reallocate)
+{
+    Arena arena;
+    char* a = static_cast<char*>(arena.reallocate(nullptr, 8));
+    memcpy(a, "abcdefg", 8);
+
+    // The last allocation grows in place.
+    EXPECT_EQ(a, arena.reallocate(a, 64));
+    EXPECT_STREQ("abcdefg", a);
+
+    char* b = static_cast<char*>(arena.allocate(8));
+    char* moved = static_cast<char*>(arena.reallocate(a, 128));
+    EXPECT_NE(a, moved);
+    EXPECT_NE(b, moved);
+    EXPECT_STREQ("abcdefg", moved);
+
+    // Growing past the end of the chunk moves the allocation.
+    char* grown = static_cast<char*>(arena.reallocate(moved, 10 * Arena::defaultChunkSize));
+    EXPECT_STREQ("abcdefg", grown);
+}
+
+TEST(WTF_Arena, Scope)
+{
+    EXPECT_EQ(nullptr, Arena::current());
+    Arena outer;
+    {
+        Arena::Scope outerScope(outer);
+        EXPECT_EQ(&outer, Arena::current());
+        Arena inner;
+        {
+            Arena::Scope innerScope(inner);
+            EXPECT_EQ(&inner, Arena::current());
+        }
+        EXPECT_EQ(&outer, Arena::current());
+    }
+    EXPECT_EQ(nullptr, Arena::current());
+}
+
+TEST(WTF_Arena, Vector)
+{
+    Arena arena;
+    Arena::Scope scope(arena);
+
+    Vector<unsigned, 0, WTF::CrashOnOverflow, 16, ArenaMalloc> vector;
+    for (unsigned i = 0; i < 1000; ++i)
+        vector.append(i);
+    EXPECT_EQ(1000u, vector.size());
+    for (unsigned i = 0; i < 1000; ++i)
+        EXPECT_EQ(i, vector[i]);
+    EXPECT_NE(0u, arena.bytesReserved());
+
+    Vector<unsigned, 4, WTF::CrashOnOverflow, 16, ArenaMalloc> inlineVector;
+    for (unsigned i = 0; i < 100; ++i)
+        inlineVector.append(i);
+    EXPECT_EQ(99u, inlineVector.last());
+
+    Vector<unsigned> copy(vector);
+    EXPECT_EQ(1000u, copy.size());
+    EXPECT_EQ(999u, copy.last());
+}
+
+TEST(WTF_Arena, HashMap)
+{
+    Arena arena;
+    Arena::Scope scope(arena);
+
+    HashMap<unsigned, unsigned, DefaultHash<unsigned>::Hash, HashTraits<unsigned>, HashTraits<unsigned>, ArenaMalloc> map;
+    for (unsigned i = 1; i <= 1000; ++i)
+        map.add(i, i * 2);
+    EXPECT_EQ(1000u, map.size());
+    for (unsigned i = 1; i <= 1000; ++i)
+        EXPECT_EQ(i * 2, map.get(i));
+    map.remove(1);
+    EXPECT_FALSE(map.contains(1));
+
+    HashSet<unsigned, DefaultHash<unsigned>::Hash, HashTraits<unsigned>, ArenaMalloc> set;
+    for (unsigned i = 1; i <= 1000; ++i)
+        set.add(i);
+    EXPECT_EQ(1000u, set.size());
+    EXPECT_TRUE(set.contains(500));
+}
+
+} // namespace TestWebKitAPI
@@ -24,9 +24,13 @@
  */
 
 #include "config.h"
+#include <atomic>
 #include <wtf/Lock.h>
+#include <wtf/RWLock.h>
+#include <wtf/SeqLock.h>
 #include <wtf/Threading.h>
 #include <wtf/ThreadingPrimitives.h>
+#include <wtf/Vector.h>
 #include <wtf/WordLock.h>
 
 using namespace WTF;
@@ -186,4 +190,148 @@ TEST(WTF_Lock, SectionAddressCollision)
     runLockTest<Lock>(4, 2, 10000, 2000);
 }
 
+TEST(WTF_RWLock, UncontendedShortSection)
+{
+    runLockTest<RWLock>(1, 1, 1, 10000000);
+}
+
+TEST(WTF_RWLock, ContendedShortSection)
+{
+    if (skipSlow())
+        return;
+    runLockTest<RWLock>(1, 10, 1, 5000000);
+}
+
+TEST(WTF_RWLock, ManyContendedLongSections)
+{
+    if (skipSlow())
+        return;
+    runLockTest<RWLock>(10, 10, 10000, 500);
+}
+
+// Writers keep both words equal. Readers must never see them differ.
+void runRWLockReadersTest(unsigned numReaders, unsigned numWriters, unsigned numIterations)
+{
+    RWLock lock;
+    uint64_t first = 0;
+    uint64_t second = 0;
+    std::atomic<bool> sawTornValue { false };
+
+    Vector<ThreadIdentifier> threads;
+    for (unsigned i = numReaders; i--;) {
+        threads.append(createThread(
+            "RWLock reader thread",
+            [&] () {
+                for (unsigned j = numIterations; j--;) {
+                    ReadLockHolder locker(lock);
+                    EXPECT_FALSE(lock.isWriteHeld());
+                    if (first != second)
+                        sawTornValue.store(true);
+                }
+            }));
+    }
+    for (unsigned i = numWriters; i--;) {
+        threads.append(createThread(
+            "RWLock writer thread",
+            [&] () {
+                for (unsigned j = numIterations / 10; j--;) {
+                    WriteLockHolder locker(lock);
+                    first++;
+                    second++;
+                }
+            }));
+    }
+
+    for (ThreadIdentifier thread : threads)
+        waitForThreadCompletion(thread);
+
+    EXPECT_FALSE(sawTornValue.load());
+    EXPECT_EQ(static_cast<uint64_t>(numWriters) * (numIterations / 10), first);
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(true, LockInspector::isFullyReset(lock));
+}
+
+TEST(WTF_RWLock, TryLock)
+{
+    RWLock lock;
+    EXPECT_TRUE(lock.tryLockShared());
+    EXPECT_TRUE(lock.tryLockShared());
+    EXPECT_FALSE(lock.tryLock());
+    lock.unlockShared();
+    lock.unlockShared();
+    EXPECT_TRUE(lock.tryLock());
+    EXPECT_TRUE(lock.isWriteHeld());
+    EXPECT_FALSE(lock.tryLockShared());
+    lock.unlock();
+    EXPECT_FALSE(lock.isHeld());
+    EXPECT_EQ(true, LockInspector::isFullyReset(lock));
+}
+
+TEST(WTF_RWLock, ManyReadersFewWriters)
+{
+    if (skipSlow())
+        return;
+    runRWLockReadersTest(10, 2, 100000);
+}
+
+TEST(WTF_RWLock, ManyReadersManyWriters)
+{
+    if (skipSlow())
+        return;
+    runRWLockReadersTest(10, 10, 100000);
+}
+
+TEST(WTF_SeqLock, ReadersNeverSeeTornValues)
+{
+    if (skipSlow())
+        return;
+
+    struct Pair {
+        uint64_t first;
+        uint64_t second;
+    };
+    SeqLock<Pair> pair(Pair { 0, 0 });
+    std::atomic<bool> sawTornValue { false };
+    const unsigned numIterations = 100000;
+    const unsigned numWriters = 2;
+
+    Vector<ThreadIdentifier> threads;
+    for (unsigned i = 8; i--;) {
+        threads.append(createThread(
+            "SeqLock reader thread",
+            [&] () {
+                for (unsigned j = numIterations; j--;) {
+                    Pair value = pair.load();
+                    if (value.first != value.second)
+                        sawTornValue.store(true);
+                }
+            }));
+    }
+    for (unsigned i = numWriters; i--;) {
+        threads.append(createThread(
+            "SeqLock writer thread",
+            [&] () {
+                for (unsigned j = numIterations; j--;) {
+                    pair.update(
+                        [] (Pair& value) {
+                            value.first++;
+                            value.second++;
+                        });
+                }
+            }));
+    }
+
+    for (ThreadIdentifier thread : threads)
+        waitForThreadCompletion(thread);
+
+    EXPECT_FALSE(sawTornValue.load());
+    Pair value = pair.load();
+    EXPECT_EQ(static_cast<uint64_t>(numWriters) * numIterations, value.first);
+    EXPECT_EQ(value.first, value.second);
+
+    pair.store(Pair { 42, 43 });
+    EXPECT_EQ(42u, pair.load().first);
+    EXPECT_EQ(43u, pair.load().second);
+}
+
 } // namespace TestWebKitAPI
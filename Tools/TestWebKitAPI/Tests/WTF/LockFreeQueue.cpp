@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+#include "config.h"
+
+#include "MoveOnly.h"
+#include <wtf/LockFreeQueue.h>
+#include <wtf/Threading.h>
+#include <wtf/Vector.h>
+
+namespace TestWebKitAPI {
+
+template<typename QueueType>
+void testSingleThreaded(QueueType& queue)
+{
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_FALSE(queue.tryDequeue());
+
+    for (unsigned i = 0; i < 3; ++i)
+        EXPECT_TRUE(queue.tryEnqueue(MoveOnly(i)));
+
+    for (unsigned i = 0; i < 3; ++i) {
+        Optional<MoveOnly> value = queue.tryDequeue();
+        EXPECT_TRUE(!!value);
+        EXPECT_EQ(i, value->value());
+    }
+    EXPECT_TRUE(queue.isEmpty());
+}
+
+TEST(WTF_LockFreeQueue, MPSCSingleThreaded)
+{
+    MPSCQueue<MoveOnly> queue;
+    EXPECT_TRUE(queue.isEmpty());
+    EXPECT_FALSE(queue.tryDequeue());
+
+    for (unsigned i = 0; i < 100; ++i)
+        queue.enqueue(MoveOnly(i));
+    for (unsigned i = 0; i < 100; ++i)
+        EXPECT_EQ(i, queue.dequeue()->value());
+    EXPECT_TRUE(queue.isEmpty());
+
+    // Values that are still queued get destroyed with the queue.
+    queue.enqueue(MoveOnly(42));
+}
+
+TEST(WTF_LockFreeQueue, BoundedSingleThreaded)
+{
+    BoundedSPSCQueue<MoveOnly> spscQueue(3);
+    EXPECT_EQ(4u, spscQueue.capacity());
+    testSingleThreaded(spscQueue);
+
+    BoundedMPSCQueue<MoveOnly> mpscQueue(3);
+    EXPECT_EQ(4u, mpscQueue.capacity());
+    testSingleThreaded(mpscQueue);
+}
+
+template<typename QueueType>
+void testFull(QueueType& queue)
+{
+    for (unsigned round = 0; round < 3; ++round) {
+        for (unsigned i = 0; i < queue.capacity(); ++i)
+            EXPECT_TRUE(queue.tryEnqueue(MoveOnly(i)));
+        MoveOnly extra(100);
+        EXPECT_FALSE(queue.tryEnqueue(WTF::move(extra)));
+        EXPECT_EQ(100u, extra.value());
+
+        for (unsigned i = 0; i < queue.capacity(); ++i)
+            EXPECT_EQ(i, queue.tryDequeue()->value());
+        EXPECT_FALSE(queue.tryDequeue());
+    }
+}
+
+TEST(WTF_LockFreeQueue, BoundedFull)
+{
+    BoundedSPSCQueue<MoveOnly> spscQueue(8);
+    testFull(spscQueue);
+
+    BoundedMPSCQueue<MoveOnly> mpscQueue(8);
+    testFull(mpscQueue);
+}
+
+TEST(WTF_LockFreeQueue, KillWakesConsumer)
+{
+    MPSCQueue<unsigned> queue;
+    ThreadIdentifier thread = createThread(
+        "Lock-free queue test thread",
+        [&] () {
+            EXPECT_FALSE(queue.dequeue());
+        });
+    queue.kill();
+    waitForThreadCompletion(thread);
+    EXPECT_TRUE(queue.killed());
+
+    BoundedSPSCQueue<unsigned> boundedQueue(1);
+    EXPECT_TRUE(boundedQueue.enqueue(1u));
+    thread = createThread(
+        "Lock-free queue test thread",
+        [&] () {
+            // The queue is full, so this waits until the queue gets killed.
+            EXPECT_FALSE(boundedQueue.enqueue(2u));
+        });
+    boundedQueue.kill();
+    waitForThreadCompletion(thread);
+}
+
+// Every producer enqueues its own increasing sequence. The consumer checks that nothing got lost,
+// duplicated or reordered within a producer.
+template<typename QueueType, typename EnqueueFunctor>
+void testProducersAndConsumer(QueueType& queue, unsigned numberOfProducers, unsigned numberOfValues, const EnqueueFunctor& enqueue)
+{
+    Vector<ThreadIdentifier> producers;
+    for (unsigned producer = 0; producer < numberOfProducers; ++producer) {
+        producers.append(createThread(
+            "Lock-free queue producer thread",
+            [&, producer] () {
+                for (unsigned i = 0; i < numberOfValues; ++i)
+                    enqueue(queue, producer * numberOfValues + i);
+            }));
+    }
+
+    Vector<unsigned> nextValues(numberOfProducers, 0);
+    for (unsigned i = 0; i < numberOfProducers * numberOfValues; ++i) {
+        Optional<unsigned> value = queue.dequeue();
+        ASSERT_TRUE(!!value);
+        unsigned producer = *value / numberOfValues;
+        ASSERT_LT(producer, numberOfProducers);
+        EXPECT_EQ(nextValues[producer], *value % numberOfValues);
+        nextValues[producer]++;
+    }
+    EXPECT_TRUE(queue.isEmpty());
+
+    for (ThreadIdentifier producer : producers)
+        waitForThreadCompletion(producer);
+    for (unsigned producer = 0; producer < numberOfProducers; ++producer)
+        EXPECT_EQ(numberOfValues, nextValues[producer]);
+}
+
+TEST(WTF_LockFreeQueue, MPSCManyProducers)
+{
+    MPSCQueue<unsigned> queue;
+    testProducersAndConsumer(queue, 8, 20000, [] (MPSCQueue<unsigned>& queue, unsigned value) {
+        queue.enqueue(value);
+    });
+}
+
+TEST(WTF_LockFreeQueue, BoundedSPSCOneProducer)
+{
+    BoundedSPSCQueue<unsigned> queue(64);
+    testProducersAndConsumer(queue, 1, 100000, [] (BoundedSPSCQueue<unsigned>& queue, unsigned value) {
+        EXPECT_TRUE(queue.enqueue(value));
+    });
+}
+
+TEST(WTF_LockFreeQueue, BoundedMPSCManyProducers)
+{
+    BoundedMPSCQueue<unsigned> queue(64);
+    testProducersAndConsumer(queue, 8, 20000, [] (BoundedMPSCQueue<unsigned>& queue, unsigned value) {
+        EXPECT_TRUE(queue.enqueue(value));
+    });
+}
+
+} // namespace TestWebKitAPI
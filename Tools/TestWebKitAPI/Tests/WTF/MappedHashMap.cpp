@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+#include "config.h"
+
+#include <wtf/HashMap.h>
+#include <wtf/MappedHashMap.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace TestWebKitAPI {
+
+struct Entry {
+    uint32_t a;
+    uint16_t b;
+};
+
+TEST(WTF_MappedHashMap, Basic)
+{
+    MappedHashMapBuilder<Entry> builder;
+    builder.add(String("accept"), { 1, 10 });
+    builder.add(String("content-type"), { 2, 20 });
+    builder.add(String(""), { 3, 30 });
+    Vector<uint8_t> data = builder.build();
+    ASSERT_FALSE(data.isEmpty());
+
+    MappedHashMap<Entry> map(data.data(), data.size());
+    ASSERT_TRUE(map.isValid());
+    EXPECT_EQ(3u, map.size());
+
+    const Entry* entry = map.get("content-type");
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(2u, entry->a);
+    EXPECT_EQ(20u, entry->b);
+
+    entry = map.get("accept", 6);
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(1u, entry->a);
+
+    entry = map.get("");
+    ASSERT_TRUE(entry);
+    EXPECT_EQ(3u, entry->a);
+
+    EXPECT_FALSE(map.get("Accept"));
+    EXPECT_FALSE(map.get("accep"));
+    EXPECT_FALSE(map.contains(String("cookie")));
+}
+
+TEST(WTF_MappedHashMap, Empty)
+{
+    MappedHashMapBuilder<unsigned> builder;
+    Vector<uint8_t> data = builder.build();
+    MappedHashMap<unsigned> map(data.data(), data.size());
+    ASSERT_TRUE(map.isValid());
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_FALSE(map.get("a"));
+}
+
+TEST(WTF_MappedHashMap, DuplicateKeys)
+{
+    MappedHashMapBuilder<unsigned> builder;
+    builder.add(String("a"), 1);
+    builder.add(String("b"), 2);
+    builder.add(String("a"), 3);
+    EXPECT_TRUE(builder.build().isEmpty());
+}
+
+TEST(WTF_MappedHashMap, Invalid)
+{
+    MappedHashMapBuilder<unsigned> builder;
+    builder.add(String("a"), 1);
+    Vector<uint8_t> data = builder.build();
+
+    EXPECT_FALSE(MappedHashMap<unsigned>(nullptr, 0).isValid());
+    EXPECT_FALSE(MappedHashMap<unsigned>(data.data(), data.size() - 1).isValid());
+    EXPECT_FALSE(MappedHashMap<uint64_t>(data.data(), data.size()).isValid());
+
+    Vector<uint8_t> corrupted = data;
+    corrupted[0] ^= 1;
+    EXPECT_FALSE(MappedHashMap<unsigned>(corrupted.data(), corrupted.size()).isValid());
+
+    MappedHashMap<unsigned> invalid(corrupted.data(), corrupted.size());
+    EXPECT_FALSE(invalid.get("a"));
+}
+
+TEST(WTF_MappedHashMap, PositionIndependent)
+{
+    HashMap<String, unsigned> source;
+    for (unsigned i = 0; i < 1000; ++i)
+        source.add(String::number(i * 7), i);
+
+    MappedHashMapBuilder<unsigned> builder;
+    builder.addAll(source);
+    Vector<uint8_t> data = builder.build();
+
+    // A copy at a different address behaves the same, as a mapped file would.
+    Vector<uint8_t> copy = data;
+    data.fill(0);
+    MappedHashMap<unsigned> map(copy.data(), copy.size());
+    ASSERT_TRUE(map.isValid());
+    EXPECT_EQ(1000u, map.size());
+    for (auto& entry : source) {
+        const unsigned* value = map.get(entry.key);
+        ASSERT_TRUE(value);
+        EXPECT_EQ(entry.value, *value);
+    }
+    for (unsigned i = 0; i < 1000; ++i)
+        EXPECT_FALSE(map.contains(String::number(i * 7 + 1)));
+}
+
+TEST(WTF_MappedHashMap, NonASCII)
+{
+    const UChar characters[] = { 'c', 0xe9, 0x263a };
+    String key16(characters, WTF_ARRAY_LENGTH(characters));
+    const LChar latin1Characters[] = { 'c', 0xe9 };
+    String key8(latin1Characters, WTF_ARRAY_LENGTH(latin1Characters));
+
+    MappedHashMapBuilder<unsigned> builder;
+    builder.add(key16, 16);
+    builder.add(key8, 8);
+    Vector<uint8_t> data = builder.build();
+    MappedHashMap<unsigned> map(data.data(), data.size());
+
+    ASSERT_TRUE(map.get(key16));
+    EXPECT_EQ(16u, *map.get(key16));
+    ASSERT_TRUE(map.get(key8));
+    EXPECT_EQ(8u, *map.get(key8));
+
+    // The 8-bit key matches its 16-bit spelling, since keys are compared as UTF-8.
+    String key8As16(characters, 2);
+    ASSERT_FALSE(key8As16.is8Bit());
+    ASSERT_TRUE(map.get(key8As16));
+    EXPECT_EQ(8u, *map.get(key8As16));
+}
+
+} // namespace TestWebKitAPI
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+
+#include "config.h"
+
+#include "MoveOnly.h"
+#include <wtf/HashMap.h>
+#include <wtf/SwissHashMap.h>
+#include <wtf/SwissHashSet.h>
+#include <wtf/text/StringHash.h>
+#include <wtf/text/WTFString.h>
+
+namespace TestWebKitAPI {
+
+TEST(WTF_SwissHashMap, Empty)
+{
+    SwissHashMap<int, int> map;
+    EXPECT_TRUE(map.isEmpty());
+    EXPECT_EQ(0u, map.capacity());
+    EXPECT_TRUE(map.begin() == map.end());
+    EXPECT_FALSE(map.contains(1));
+    EXPECT_FALSE(map.remove(1));
+    EXPECT_EQ(0, map.get(1));
+}
+
+TEST(WTF_SwissHashMap, AddSetAndGet)
+{
+    SwissHashMap<int, int> map;
+
+    auto addResult = map.add(1, 10);
+    EXPECT_TRUE(addResult.isNewEntry);
+    EXPECT_EQ(1, addResult.iterator->key);
+    EXPECT_EQ(10, addResult.iterator->value);
+
+    addResult = map.add(1, 20);
+    EXPECT_FALSE(addResult.isNewEntry);
+    EXPECT_EQ(10, map.get(1));
+
+    addResult = map.set(1, 30);
+    EXPECT_FALSE(addResult.isNewEntry);
+    EXPECT_EQ(30, map.get(1));
+    EXPECT_EQ(1u, map.size());
+}
+
+// Compares against HashMap through enough additions and removals to grow the table several times and
+// to reuse deleted buckets.
+TEST(WTF_SwissHashMap, MatchesHashMap)
+{
+    SwissHashMap<unsigned, unsigned> map;
+    HashMap<unsigned, unsigned> expected;
+
+    unsigned state = 1;
+    for (unsigned i = 0; i < 100000; ++i) {
+        state = state * 1103515245 + 12345;
+        unsigned key = (state >> 8) % 3000 + 1;
+        switch (state % 3) {
+        case 0:
+        case 1:
+            EXPECT_EQ(expected.add(key, i).isNewEntry, map.add(key, i).isNewEntry);
+            break;
+        case 2:
+            EXPECT_EQ(expected.remove(key), map.remove(key));
+            break;
+        }
+        EXPECT_EQ(expected.size(), map.size());
+    }
+
+    unsigned count = 0;
+    for (auto& entry : map) {
+        EXPECT_EQ(expected.get(entry.key), entry.value);
+        ++count;
+    }
+    EXPECT_EQ(expected.size(), count);
+    for (auto& entry : expected)
+        EXPECT_TRUE(map.contains(entry.key));
+}
+
+TEST(WTF_SwissHashMap, MoveOnlyValues)
+{
+    SwissHashMap<unsigned, MoveOnly> map;
+    for (unsigned i = 1; i <= 1000; ++i)
+        map.add(i, MoveOnly(i));
+
+    for (unsigned i = 1; i <= 1000; i += 2)
+        EXPECT_EQ(i, map.take(i).value());
+
+    EXPECT_EQ(500u, map.size());
+    for (unsigned i = 1; i <= 1000; ++i)
+        EXPECT_EQ(!(i % 2), map.contains(i));
+}
+
+TEST(WTF_SwissHashMap, StringKeys)
+{
+    SwissHashMap<String, unsigned> map;
+    for (unsigned i = 0; i < 1000; ++i)
+        map.add(String::number(i), i);
+
+    SwissHashMap<String, unsigned> copy = map;
+    map.clear();
+    EXPECT_TRUE(map.isEmpty());
+
+    EXPECT_EQ(1000u, copy.size());
+    for (unsigned i = 0; i < 1000; ++i)
+        EXPECT_EQ(i, copy.get(String::number(i)));
+    EXPECT_FALSE(copy.contains("1000"));
+}
+
+TEST(WTF_SwissHashSet, Basic)
+{
+    SwissHashSet<int> set { 1, 2, 3 };
+    EXPECT_EQ(3u, set.size());
+    EXPECT_TRUE(set.contains(2));
+    EXPECT_FALSE(set.add(2).isNewEntry);
+    EXPECT_TRUE(set.add(4).isNewEntry);
+    EXPECT_TRUE(set.remove(1));
+    EXPECT_FALSE(set.contains(1));
+    EXPECT_EQ(3u, set.size());
+}
+
+} // namespace TestWebKitAPI
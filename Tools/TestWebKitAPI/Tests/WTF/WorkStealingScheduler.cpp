@@ -0,0 +1,171 @@
+/*
+ * Copyright (C) 2015 Apple Inc. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions
+ * are met:
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY APPLE INC. ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED.  IN NO EVENT SHALL APPLE INC. OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY
+ * OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE. 
+ */
+#include "config.h"
+
+#include <atomic>
+#include <wtf/Vector.h>
+#include <wtf/WorkStealingScheduler.h>
+
+namespace TestWebKitAPI {
+
+TEST(WTF_WorkStealingDeque, PushPopIsLastInFirstOut)
+{
+    WorkStealingDeque<int> deque(2);
+    int values[100];
+    EXPECT_TRUE(deque.isEmpty());
+    EXPECT_EQ(nullptr, deque.pop());
+    EXPECT_EQ(nullptr, deque.steal());
+
+    for (int i = 0; i < 100; ++i)
+        deque.push(values + i);
+    EXPECT_FALSE(deque.isEmpty());
+
+    EXPECT_EQ(values, deque.steal());
+    for (int i = 100; i-- > 1;)
+        EXPECT_EQ(values + i, deque.pop());
+    EXPECT_EQ(nullptr, deque.pop());
+    EXPECT_TRUE(deque.isEmpty());
+}
+
+TEST(WTF_WorkStealingDeque, ConcurrentSteal)
+{
+    static const unsigned numberOfItems = 100000;
+    static const unsigned numberOfThieves = 4;
+
+    Vector<unsigned> items(numberOfItems);
+    for (unsigned i = 0; i < numberOfItems; ++i)
+        items[i] = i;
+
+    WorkStealingDeque<unsigned> deque;
+    std::atomic<unsigned> numberTaken { 0 };
+    std::atomic<uint64_t> sum { 0 };
+    std::atomic<bool> isDone { false };
+
+    Vector<ThreadIdentifier> thieves;
+    for (unsigned i = 0; i < numberOfThieves; ++i) {
+        thieves.append(createThread(
+            "Work Stealing Deque Test Thread",
+            [&] () {
+                while (!isDone.load()) {
+                    if (unsigned* item = deque.steal()) {
+                        sum.fetch_add(*item);
+                        numberTaken.fetch_add(1);
+                    }
+                }
+            }));
+    }
+
+    for (unsigned i = 0; i < numberOfItems; ++i) {
+        deque.push(&items[i]);
+        if (i % 3) {
+            if (unsigned* item = deque.pop()) {
+                sum.fetch_add(*item);
+                numberTaken.fetch_add(1);
+            }
+        }
+    }
+    while (unsigned* item = deque.pop()) {
+        sum.fetch_add(*item);
+        numberTaken.fetch_add(1);
+    }
+
+    isDone.store(true);
+    for (ThreadIdentifier thread : thieves)
+        waitForThreadCompletion(thread);
+
+    EXPECT_EQ(numberOfItems, numberTaken.load());
+    EXPECT_EQ(static_cast<uint64_t>(numberOfItems) * (numberOfItems - 1) / 2, sum.load());
+}
+
+TEST(WTF_WorkStealingScheduler, RunsEveryTask)
+{
+    Ref<WorkStealingScheduler> scheduler = WorkStealingScheduler::create(4);
+    EXPECT_EQ(4u, scheduler->numberOfWorkers());
+
+    std::atomic<unsigned> count { 0 };
+    WorkStealingTaskGroup group(scheduler.get());
+    for (unsigned i = 0; i < 10000; ++i) {
+        group.scheduleFunction(
+            [&] () {
+                count.fetch_add(1);
+            },
+            static_cast<WorkStealingScheduler::Priority>(i % WorkStealingScheduler::numberOfPriorities));
+    }
+    group.wait();
+    EXPECT_EQ(10000u, count.load());
+
+    // Groups can be reused.
+    group.scheduleFunction([&] () { count.fetch_add(1); });
+    group.wait();
+    EXPECT_EQ(10001u, count.load());
+}
+
+TEST(WTF_WorkStealingScheduler, NestedGroups)
+{
+    Ref<WorkStealingScheduler> scheduler = WorkStealingScheduler::create(2);
+
+    std::atomic<unsigned> count { 0 };
+    WorkStealingTaskGroup outer(scheduler.get());
+    for (unsigned i = 0; i < 50; ++i) {
+        outer.scheduleFunction(
+            [&] () {
+                WorkStealingTaskGroup inner(scheduler.get());
+                for (unsigned j = 0; j < 50; ++j) {
+                    inner.scheduleFunction(
+                        [&] () {
+                            count.fetch_add(1);
+                        });
+                }
+                inner.wait();
+                count.fetch_add(1);
+            });
+    }
+    outer.wait();
+    EXPECT_EQ(50u * 51u, count.load());
+}
+
+TEST(WTF_WorkStealingScheduler, RunsUngroupedTasksBeforeDying)
+{
+    std::atomic<unsigned> count { 0 };
+    {
+        Ref<WorkStealingScheduler> scheduler = WorkStealingScheduler::create(3);
+        for (unsigned i = 0; i < 1000; ++i)
+            scheduler->scheduleFunction([&] () { count.fetch_add(1); });
+    }
+    EXPECT_EQ(1000u, count.load());
+}
+
+TEST(WTF_WorkStealingScheduler, Shared)
+{
+    std::atomic<unsigned> count { 0 };
+    WorkStealingTaskGroup group;
+    EXPECT_EQ(&WorkStealingScheduler::shared(), &group.scheduler());
+    for (unsigned i = 0; i < 100; ++i)
+        group.scheduleFunction([&] () { count.fetch_add(1); }, WorkStealingScheduler::Priority::High);
+    group.wait();
+    EXPECT_EQ(100u, count.load());
+}
+
+} // namespace TestWebKitAPI